@@ -33,6 +33,7 @@ ldmx() {
   docker run \
     -i -v ${LDMX_BASE}:${LDMX_BASE} -e LDMX_BASE \
     -e LDMX_NUM_EVENTS -e LDMX_RUN_NUMBER \
+    -e LDMX_LOG_PERFORMANCE -e LDMX_OVERLAY_INTERACTIONS \
     -u $(id -u $USER):$(id -g $USER) \
     ${LDMX_DOCKER_TAG} $(pwd) $@
   return $?
@@ -0,0 +1,66 @@
+#!/bin/bash
+
+set -e
+
+###############################################################################
+# perf.sh
+#   Run the perf action.
+#
+#   Assumptions
+#     - see assumptions of 'common.sh' environment script
+#     - name of sample is given as first argument on command line
+#     - 'true' is given as the second argument to record a new baseline
+#     - ldmx-sw install we should run is installed in $GITHUB_WORKSPACE/install
+#       as is done with setup action
+###############################################################################
+
+source ${GITHUB_ACTION_PATH}/../common.sh
+
+__main__() {
+  start_group Input Deduction
+  local _sample="$1"
+  local _record="$2"
+  cd ${GITHUB_WORKSPACE}/.github/validation_samples/${_sample} || return $?
+  local _sample_dir="$(pwd)"
+  local _baseline="${_sample_dir}/perf_baseline.json"
+  echo "Sample Name: ${_sample}"
+  echo "Sample Dir: ${_sample_dir}"
+  echo "Recording Baseline? ${_record}"
+  end_group
+
+  start_group Sample-Specific Initialization
+  if [[ -f init.sh ]]; then
+    . init.sh
+  else
+    echo "No 'init.sh' file in ${_sample_dir}."
+  fi
+  end_group
+
+  # the sample configs turn on the performance tracking when this is set
+  export LDMX_LOG_PERFORMANCE=1
+
+  start_group Run config.py
+  ldmx fire config.py | tee output.log || return $?
+  end_group
+
+  # run from the source of the Validation package so it can be imported
+  cd ${GITHUB_WORKSPACE}/Validation/src || return $?
+  if [[ "${_record}" == "true" ]]; then
+    start_group Record Performance Baseline
+    ldmx python3 -m Validation.regression record ${_sample_dir}/hist.root \
+      --sample ${_sample} --baseline ${_baseline} || return $?
+    end_group
+  else
+    start_group Compare to Performance Baseline
+    ldmx python3 -m Validation.regression compare ${_sample_dir}/hist.root \
+      --sample ${_sample} --baseline ${_baseline} || return $?
+    end_group
+  fi
+
+  start_group Share Paths to Outputs
+  set_output hists ${_sample_dir}/hist.root
+  set_output baseline ${_baseline}
+  end_group
+}
+
+__main__ $@
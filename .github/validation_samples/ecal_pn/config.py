@@ -205,3 +205,9 @@ p.sequence.extend([
 #        seed_recoil_dqm,
         recoil_dqm,
         ] + dqm.all_dqm)
+
+# the performance regression suite sets LDMX_LOG_PERFORMANCE to record the time
+#   and resources used by each processor (see Validation.regression)
+if 'LDMX_LOG_PERFORMANCE' in os.environ :
+    p.logPerformance = True
+    p.logResourceUsage = True
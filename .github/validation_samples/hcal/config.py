@@ -64,3 +64,9 @@ p.sequence.extend([
         hcal_digi.HcalRecProducer(),
         dqm.SimObjects(), dqm.HCalDQM()
         ])
+
+# the performance regression suite sets LDMX_LOG_PERFORMANCE to record the time
+#   and resources used by each processor (see Validation.regression)
+if 'LDMX_LOG_PERFORMANCE' in os.environ :
+    p.logPerformance = True
+    p.logResourceUsage = True
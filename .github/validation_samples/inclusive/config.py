@@ -66,3 +66,9 @@ p.sequence.extend([
         count, TriggerProcessor('trigger', 8000.),
         dqm.PhotoNuclearDQM(verbose=False),
         ] + dqm.all_dqm)
+
+# the performance regression suite sets LDMX_LOG_PERFORMANCE to record the time
+#   and resources used by each processor (see Validation.regression)
+if 'LDMX_LOG_PERFORMANCE' in os.environ :
+    p.logPerformance = True
+    p.logResourceUsage = True
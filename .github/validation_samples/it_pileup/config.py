@@ -21,7 +21,7 @@ from LDMX.Recon.overlay import OverlayProducer
 overlay=OverlayProducer('pileup.root')
 overlay.passName = simPassName                  #sim input event pass name
 overlay.overlayPassName = pileupFilePassName    #pileup input event pass name
-overlay.totalNumberOfInteractions = 2.
+overlay.totalNumberOfInteractions = float(os.environ.get('LDMX_OVERLAY_INTERACTIONS', 2.))
 overlay.doPoissonIntime = False
 overlay.doPoissonOutoftime = False
 overlay.nEarlierBunchesToSample = 0
@@ -106,3 +106,9 @@ p.sequence.extend([
 p.inputFiles = ['ecal_pn.root']
 p.outputFiles= ['events.root']
 p.histogramFile = 'hist.root'
+
+# the performance regression suite sets LDMX_LOG_PERFORMANCE to record the time
+#   and resources used by each processor (see Validation.regression)
+if 'LDMX_LOG_PERFORMANCE' in os.environ :
+    p.logPerformance = True
+    p.logResourceUsage = True
@@ -76,3 +76,9 @@ p.sequence.extend([
         trigScintTrack, 
         count, TriggerProcessor('trigger', 4000.),
        ] + dqm.ecal_dqm)
+
+# the performance regression suite sets LDMX_LOG_PERFORMANCE to record the time
+#   and resources used by each processor (see Validation.regression)
+if 'LDMX_LOG_PERFORMANCE' in os.environ :
+    p.logPerformance = True
+    p.logResourceUsage = True
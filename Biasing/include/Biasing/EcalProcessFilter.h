@@ -52,6 +52,15 @@ class EcalProcessFilter : public simcore::UserAction {
       const G4Track* aTrack,
       const G4ClassificationOfNewTrack& currentTrackClass) final override;
 
+  /**
+   * Only the primaries and the brem candidates are needed to decide if
+   * the event is kept, the rest can wait when killing early.
+   *
+   * @param track new track being classified
+   * @return true if the track is a primary or a brem candidate
+   */
+  bool neededForDecision(const G4Track* track) const final override;
+
   /// Retrieve the type of actions this class defines
   std::vector<simcore::TYPE> getTypes() final override {
     return {simcore::TYPE::STACKING, simcore::TYPE::STEPPING};
@@ -64,6 +73,9 @@ class EcalProcessFilter : public simcore::UserAction {
   /// Process to filter
   std::string process_{""};
 
+  /// Tags of the names of the calorimeter region and of the hcal volume
+  int calorimeterRegion_, hcalVolume_;
+
   /// Enable logging
   enableLogging("EcalProcessFilter")
 
@@ -60,6 +60,12 @@ class NonFiducialFilter : public simcore::UserAction {
             simcore::TYPE::STEPPING};
   }
 
+  /// Only step the primary electron
+  simcore::Selection getSelection(simcore::TYPE type) const final override {
+    if (type != simcore::TYPE::STEPPING) return {};
+    return {{}, {11}, true};
+  }
+
  private:
   /// Recoil electron threshold.
   double recoil_max_p_{1500};  // MeV
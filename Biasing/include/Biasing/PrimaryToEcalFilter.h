@@ -54,10 +54,18 @@ class PrimaryToEcalFilter : public simcore::UserAction {
     return {simcore::TYPE::STEPPING};
   }
 
+  /// Only step the primary particle
+  simcore::Selection getSelection(simcore::TYPE) const final override {
+    return {{}, {}, true};
+  }
+
  private:
   /// Energy [MeV] below which a primary should be vetoed.
   double threshold_;
 
+  /// Tag of the name of the calorimeter region
+  int calorimeterRegion_;
+
 };  // PrimaryToEcalFilter
 
 }  // namespace biasing
@@ -68,6 +68,12 @@ class TaggerVetoFilter : public simcore::UserAction {
     return {simcore::TYPE::STEPPING, simcore::TYPE::EVENT};
   }
 
+  /// Only step the primary electron in the tagger region
+  simcore::Selection getSelection(simcore::TYPE type) const final override {
+    if (type != simcore::TYPE::STEPPING) return {};
+    return {{"tagger"}, {11}, true};
+  }
+
  private:
   /**
    * Did the primary particle enter the tagger region? Reset at the start of
@@ -54,12 +54,27 @@ class TargetBremFilter : public simcore::UserAction {
       const G4Track* aTrack,
       const G4ClassificationOfNewTrack& currentTrackClass) final override;
 
+  /**
+   * Only the primary electron is needed to decide if the event is kept,
+   * its secondaries can wait when killing early.
+   *
+   * @param track new track being classified
+   * @return true if the track is the primary
+   */
+  bool neededForDecision(const G4Track* track) const final override;
+
   /// Retrieve the type of actions this class defines
   std::vector<simcore::TYPE> getTypes() final override {
     return {simcore::TYPE::EVENT, simcore::TYPE::STACKING,
             simcore::TYPE::STEPPING};
   }
 
+  /// Only step the primary electron in the target region
+  simcore::Selection getSelection(simcore::TYPE type) const final override {
+    if (type != simcore::TYPE::STEPPING) return {};
+    return {{"target"}, {11}, true};
+  }
+
  private:
   /// Recoil electron threshold.
   double recoilMaxPThreshold_{1500};  // MeV
@@ -70,6 +85,12 @@ class TargetBremFilter : public simcore::UserAction {
   /// Flag indicating if the recoil electron track should be killed
   bool killRecoil_{false};
 
+  /// Tags of the names of the volumes after the target
+  int recoilVolume_, worldVolume_;
+
+  /// Tag of the name of the brem process
+  int eBrem_;
+
 };  // TargetBremFilter
 }  // namespace biasing
 
@@ -46,6 +46,12 @@ class TargetENProcessFilter : public simcore::UserAction {
     return {simcore::TYPE::EVENT, simcore::TYPE::STEPPING};
   }
 
+  /// Only step the primary electron
+  simcore::Selection getSelection(simcore::TYPE type) const final override {
+    if (type != simcore::TYPE::STEPPING) return {};
+    return {{}, {11}, true};
+  }
+
  private:
   /**
    * The volume name of the LDMX target
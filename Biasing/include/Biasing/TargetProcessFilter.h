@@ -70,6 +70,9 @@ class TargetProcessFilter : public simcore::UserAction {
 
   /// The process to bias
   std::string process_{""};
+
+  /// Tags of the names of the target region and of the volumes after it
+  int targetRegion_, recoilVolume_, worldVolume_;
 };
 
 }  // namespace biasing
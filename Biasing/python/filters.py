@@ -27,6 +27,9 @@ class TargetBremFilter(simcfg.UserAction):
     ----------
     kill_recoil_track : bool
         Should we kill the recoil electron track for a worst case scenario?
+    kill_early : bool
+        Hold the secondaries of the primary electron back until the filter
+        has decided so rejected events are aborted before they are simulated
     """
 
     def __init__(self,recoil_max_p = 1500.,brem_min_e = 2500.) :
@@ -38,6 +41,7 @@ class TargetBremFilter(simcfg.UserAction):
         self.recoil_max_p_threshold = recoil_max_p
         self.brem_min_energy_threshold = brem_min_e
         self.kill_recoil_track = False
+        self.kill_early = False
 
 class NonFiducialFilter(simcfg.UserAction):
     """ Configuration for rejecting events that are fiducial.
@@ -66,6 +70,13 @@ class EcalProcessFilter(simcfg.UserAction):
     ----------
     process : str
         Geant4 process to look for in the ecal
+
+    Attributes
+    ----------
+    kill_early : bool
+        Hold back the tracks that are neither primaries nor brem candidates
+        until the filter has decided so rejected events are aborted before
+        they are simulated
     """
 
     def __init__(self,process = 'photonNuclear') :
@@ -75,6 +86,7 @@ class EcalProcessFilter(simcfg.UserAction):
         include.library()
 
         self.process = process
+        self.kill_early = False
         
 class DeepEcalProcessFilter(simcfg.UserAction):
     """ Configuration for keeping events where the pn happens deep in the ECAL.
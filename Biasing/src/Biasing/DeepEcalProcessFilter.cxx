@@ -122,7 +122,7 @@ void DeepEcalProcessFilter::NewStage() {
     ldmx_log(debug) << "> -----------------------------------------";
   } else {
     //    ldmx_log(debug) << "> -----------------------------------------";
-    G4RunManager::GetRunManager()->AbortEvent();
+    abortEvent("NewStage");
   }
 }
 }  // namespace biasing
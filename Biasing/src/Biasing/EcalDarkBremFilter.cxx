@@ -138,7 +138,7 @@ void EcalDarkBremFilter::AbortEvent(const std::string& reason) const {
                      ->GetEventID()
               << ") " << reason << " Aborting event." << std::endl;
   }
-  G4RunManager::GetRunManager()->AbortEvent();
+  abortEvent(reason);
   return;
 }
 }  // namespace biasing
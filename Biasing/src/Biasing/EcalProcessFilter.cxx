@@ -12,6 +12,7 @@
 /*~~~~~~~~~~~~~*/
 /*   SimCore   */
 /*~~~~~~~~~~~~~*/
+#include "SimCore/NameTags.h"
 #include "SimCore/UserTrackInformation.h"
 
 namespace biasing {
@@ -20,6 +21,10 @@ EcalProcessFilter::EcalProcessFilter(const std::string& name,
                                      framework::config::Parameters& parameters)
     : simcore::UserAction(name, parameters) {
   process_ = parameters.getParameter<std::string>("process");
+
+  auto& tags{simcore::NameTags::get()};
+  calorimeterRegion_ = tags.tag("CalorimeterRegion");
+  hcalVolume_ = tags.tag("hcal_PV");
 }
 
 EcalProcessFilter::~EcalProcessFilter() {}
@@ -62,9 +67,9 @@ void EcalProcessFilter::stepping(const G4Step* step) {
 
   // Get the region the particle is currently in.  Continue processing
   // the particle only if it's in the calorimeter region.
-  if (auto region{
-          track->GetVolume()->GetLogicalVolume()->GetRegion()->GetName()};
-      region.compareTo("CalorimeterRegion") != 0) {
+  auto& tags{simcore::NameTags::get()};
+  if (tags.region(track->GetVolume()->GetLogicalVolume()->GetRegion()) !=
+      calorimeterRegion_) {
     // If secondaries were produced outside of the volume of interest,
     // and there aren't additional brems to process, abort the
     // event.  Otherwise, suspend the track and move on to the next
@@ -79,7 +84,7 @@ void EcalProcessFilter::stepping(const G4Step* step) {
       if (getEventInfo()->bremCandidateCount() == 1) {
         // std::cout << "aborting the event." << std::endl;
         track->SetTrackStatus(fKillTrackAndSecondaries);
-        G4RunManager::GetRunManager()->AbortEvent();
+        abortEvent("secondaries outside ECal");
         currentTrack_ = nullptr;
       } else {
         /*
@@ -107,8 +112,7 @@ void EcalProcessFilter::stepping(const G4Step* step) {
      * hcal parent volume and so it will break if the hcal parent volume
      * changes its name.
      */
-    if (auto volume{track->GetNextVolume()->GetName()};
-        volume.compareTo("hcal_PV") == 0) {
+    if (tags.volume(track->GetNextVolume()) == hcalVolume_) {
       /*
       std::cout << "[ EcalProcessFilter ]: "
             <<
@@ -118,7 +122,7 @@ void EcalProcessFilter::stepping(const G4Step* step) {
       if (getEventInfo()->bremCandidateCount() == 1) {
         // std::cout << "aborting the event." << std::endl;
         track->SetTrackStatus(fKillTrackAndSecondaries);
-        G4RunManager::GetRunManager()->AbortEvent();
+        abortEvent("no secondaries leaving ECal");
         currentTrack_ = nullptr;
       } else {
         /*
@@ -137,7 +141,8 @@ void EcalProcessFilter::stepping(const G4Step* step) {
   } else {
     // If the brem gamma interacts and produces secondaries, get the
     // process used to create them.
-    auto processName{secondaries->at(0)->GetCreatorProcess()->GetProcessName()};
+    const auto& processName{
+        secondaries->at(0)->GetCreatorProcess()->GetProcessName()};
 
     // Only record the process that is being biased
     if (!processName.contains(process_)) {
@@ -150,7 +155,7 @@ void EcalProcessFilter::stepping(const G4Step* step) {
       if (getEventInfo()->bremCandidateCount() == 1) {
         // std::cout << "aborting the event." << std::endl;
         track->SetTrackStatus(fKillTrackAndSecondaries);
-        G4RunManager::GetRunManager()->AbortEvent();
+        abortEvent("not the biased process");
         currentTrack_ = nullptr;
       } else {
         /*
@@ -176,8 +181,17 @@ void EcalProcessFilter::stepping(const G4Step* step) {
     trackInfo->setSaveFlag(true);
     trackInfo->tagPNGamma();
     getEventInfo()->decBremCandidateCount();
+    passed();
   }
 }
+
+bool EcalProcessFilter::neededForDecision(const G4Track* track) const {
+  // the primaries and the brem candidates decide
+  if (track->GetParentID() == 0) return true;
+  auto track_info{
+      dynamic_cast<simcore::UserTrackInformation*>(track->GetUserInformation())};
+  return track_info and track_info->isBremCandidate();
+}
 }  // namespace biasing
 
 DECLARE_ACTION(biasing, EcalProcessFilter)
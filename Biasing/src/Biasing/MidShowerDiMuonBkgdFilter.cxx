@@ -109,7 +109,7 @@ void MidShowerDiMuonBkgdFilter::AbortEvent(const std::string& reason) const {
                      ->GetEventID()
               << ") " << reason << " Aborting event." << std::endl;
   }
-  G4RunManager::GetRunManager()->AbortEvent();
+  abortEvent(reason);
   return;
 }
 }  // namespace biasing
@@ -107,7 +107,7 @@ void MidShowerNuclearBkgdFilter::AbortEvent(const std::string& reason) const {
                      ->GetEventID()
               << ") " << reason << " Aborting event." << std::endl;
   }
-  G4RunManager::GetRunManager()->AbortEvent();
+  abortEvent(reason);
   return;
 }
 }  // namespace biasing
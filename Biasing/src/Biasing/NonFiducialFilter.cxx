@@ -27,21 +27,10 @@ NonFiducialFilter::NonFiducialFilter(const std::string& name,
 }
 
 void NonFiducialFilter::stepping(const G4Step* step) {
-  // Get the track associated with this step.
+  // Get the track associated with this step, the primary electron (see
+  // getSelection).
   auto track{step->GetTrack()};
 
-  // Get the PDG ID of the track and make sure it's an electron.
-  if (auto pdgID{track->GetParticleDefinition()->GetPDGEncoding()};
-      pdgID != 11) {
-    return;
-  }
-
-  // Only process the primary electron track
-  int parentID{step->GetTrack()->GetParentID()};
-  if (parentID != 0) {
-    return;
-  }
-
   // Check in which volume the electron is currently
   auto volume{track->GetVolume()->GetLogicalVolume()
                   ? track->GetVolume()->GetLogicalVolume()->GetName()
@@ -53,7 +42,7 @@ void NonFiducialFilter::stepping(const G4Step* step) {
     if (track->GetMomentum().mag() > recoil_max_p_) {
       // Kill the track if its momemntum is too high
       track->SetTrackStatus(fKillTrackAndSecondaries);
-      G4RunManager::GetRunManager()->AbortEvent();
+      abortEvent("stepping");
       ldmx_log(debug) << " Recoil track momentum is too high, expected to be "
                          "fiducial, exiting\n";
       return;
@@ -73,7 +62,7 @@ void NonFiducialFilter::stepping(const G4Step* step) {
     // https://github.com/LDMX-Software/ldmx-sw/issues/1286
     if (abort_fiducial_ && isInEcal) {
       track->SetTrackStatus(fKillTrackAndSecondaries);
-      G4RunManager::GetRunManager()->AbortEvent();
+      abortEvent("stepping");
       ldmx_log(debug) << ">> This event is fiducial, exiting";
       nonFiducial_ = false;
       return;
@@ -66,7 +66,7 @@ void PhotoNuclearProductsFilter::stepping(const G4Step* step) {
   // the event.
   if (!productFound) {
     track->SetTrackStatus(fKillTrackAndSecondaries);
-    G4RunManager::GetRunManager()->AbortEvent();
+    abortEvent("stepping");
     return;
   }
 
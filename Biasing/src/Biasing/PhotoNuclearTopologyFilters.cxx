@@ -65,7 +65,7 @@ void PhotoNuclearTopologyFilter::stepping(const G4Step* step) {
 
   if (rejectEvent(*secondaries)) {
     track->SetTrackStatus(fKillTrackAndSecondaries);
-    G4RunManager::GetRunManager()->AbortEvent();
+    abortEvent("stepping");
   }
 
   // Once the PN gamma has been procesed, untag it so its not reprocessed
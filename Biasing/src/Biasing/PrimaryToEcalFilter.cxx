@@ -8,29 +8,30 @@
 #include "G4RunManager.hh"
 #include "G4Step.hh"
 
+/*~~~~~~~~~~~~~*/
+/*   SimCore   */
+/*~~~~~~~~~~~~~*/
+#include "SimCore/NameTags.h"
+
 namespace biasing {
 
 PrimaryToEcalFilter::PrimaryToEcalFilter(
     const std::string& name, framework::config::Parameters& parameters)
     : simcore::UserAction(name, parameters) {
   threshold_ = parameters.getParameter<double>("threshold");
+  calorimeterRegion_ = simcore::NameTags::get().tag("CalorimeterRegion");
 }
 
 void PrimaryToEcalFilter::stepping(const G4Step* step) {
-  // Only process the primary electron track
-  if (int parentID{step->GetTrack()->GetParentID()}; parentID != 0) return;
-
+  // Only the primary electron track is processed (see getSelection)
   if (G4EventManager::GetEventManager()->GetConstCurrentEvent()->IsAborted())
     return;
 
   // Get the region the particle is currently in.  Continue processing
   // the particle only if it's NOT in the calorimeter region
-  if (auto region{step->GetTrack()
-                      ->GetVolume()
-                      ->GetLogicalVolume()
-                      ->GetRegion()
-                      ->GetName()};
-      region.compareTo("CalorimeterRegion") == 0)
+  if (simcore::NameTags::get().region(
+          step->GetTrack()->GetVolume()->GetLogicalVolume()->GetRegion()) ==
+      calorimeterRegion_)
     return;
 
   // If the energy of the particle fell below threshold, stop processing the
@@ -44,7 +45,7 @@ void PrimaryToEcalFilter::stepping(const G4Step* step) {
     std::endl;
     */
     step->GetTrack()->SetTrackStatus(fKillTrackAndSecondaries);
-    G4RunManager::GetRunManager()->AbortEvent();
+    abortEvent("stepping");
     return;
   }
 }
@@ -10,6 +10,7 @@
 /*~~~~~~~~~~~~~*/
 /*   SimCore   */
 /*~~~~~~~~~~~~~*/
+#include "SimCore/NameTags.h"
 #include "SimCore/UserEventInformation.h"
 #include "SimCore/UserTrackInformation.h"
 
@@ -23,6 +24,11 @@ TargetBremFilter::TargetBremFilter(const std::string& name,
   bremEnergyThreshold_ =
       parameters.getParameter<double>("brem_min_energy_threshold");
   killRecoil_ = parameters.getParameter<bool>("kill_recoil_track");
+
+  auto& tags{simcore::NameTags::get()};
+  recoilVolume_ = tags.tag("recoil_PV");
+  worldVolume_ = tags.tag("World_PV");
+  eBrem_ = tags.tag("eBrem");
 }
 
 TargetBremFilter::~TargetBremFilter() {}
@@ -47,23 +53,10 @@ G4ClassificationOfNewTrack TargetBremFilter::ClassifyNewTrack(
 }
 
 void TargetBremFilter::stepping(const G4Step* step) {
-  // Get the track associated with this step.
+  // Get the track associated with this step, the primary electron in the
+  // target region (see getSelection).
   auto track{step->GetTrack()};
-
-  // Only process the primary electron track
-  if (track->GetParentID() != 0) return;
-
-  // Get the PDG ID of the track and make sure it's an electron. If
-  // another particle type is found, thrown an exception.
-  if (auto pdgID{track->GetParticleDefinition()->GetPDGEncoding()}; pdgID != 11)
-    return;
-
-  // Get the region the particle is currently in.  Continue processing
-  // the particle only if it's in the target region.
-  if (auto region{
-          track->GetVolume()->GetLogicalVolume()->GetRegion()->GetName()};
-      region.compareTo("target") != 0)
-    return;
+  auto& tags{simcore::NameTags::get()};
 
   /*
   std::cout << "[TargetBremFilter] : Stepping primary electron in 'target'
@@ -84,12 +77,12 @@ void TargetBremFilter::stepping(const G4Step* step) {
    * We also check if the next volume is World_PV because in some geometries
    * (e.g. v14), there is a air-gap between the target region and the recoil.
    */
-  if (auto volume{track->GetNextVolume()->GetName()};
-      volume.compareTo("recoil_PV") == 0 or volume.compareTo("World_PV") == 0) {
+  if (auto volume{tags.volume(track->GetNextVolume())};
+      volume == recoilVolume_ or volume == worldVolume_) {
     // If the recoil electron
     if (track->GetMomentum().mag() >= recoilMaxPThreshold_) {
       track->SetTrackStatus(fKillTrackAndSecondaries);
-      G4RunManager::GetRunManager()->AbortEvent();
+      abortEvent("recoil above threshold");
       return;
     }
 
@@ -97,14 +90,11 @@ void TargetBremFilter::stepping(const G4Step* step) {
     bool hasBremCandidate = false;
     if (auto secondaries = step->GetSecondary(); secondaries->size() == 0) {
       track->SetTrackStatus(fKillTrackAndSecondaries);
-      G4RunManager::GetRunManager()->AbortEvent();
+      abortEvent("no secondaries");
       return;
     } else {
       for (auto& secondary_track : *secondaries) {
-        G4String processName =
-            secondary_track->GetCreatorProcess()->GetProcessName();
-
-        if (processName.compareTo("eBrem") == 0 &&
+        if (tags.process(secondary_track->GetCreatorProcess()) == eBrem_ &&
             secondary_track->GetKineticEnergy() > bremEnergyThreshold_) {
           auto trackInfo{simcore::UserTrackInformation::get(secondary_track)};
           trackInfo->tagBremCandidate();
@@ -118,13 +108,14 @@ void TargetBremFilter::stepping(const G4Step* step) {
 
     if (!hasBremCandidate) {
       track->SetTrackStatus(fKillTrackAndSecondaries);
-      G4RunManager::GetRunManager()->AbortEvent();
+      abortEvent("no brem candidate");
       return;
     }
 
     /*
     std::cout << "[TargetBremFilter] : Found brem candidate" << std::endl;
      */
+    passed();
 
     // Check if the recoil electron should be killed.  If not, postpone
     // its processing until the brem gamma has been processed.
@@ -135,11 +126,16 @@ void TargetBremFilter::stepping(const G4Step* step) {
 
   } else if (step->GetPostStepPoint()->GetKineticEnergy() == 0) {
     track->SetTrackStatus(fKillTrackAndSecondaries);
-    G4RunManager::GetRunManager()->AbortEvent();
+    abortEvent("stopped in target");
     return;
   }
 }
 
+bool TargetBremFilter::neededForDecision(const G4Track* track) const {
+  // only the primary electron decides
+  return track->GetParentID() == 0;
+}
+
 void TargetBremFilter::EndOfEventAction(const G4Event*) {}
 }  // namespace biasing
 
@@ -134,7 +134,7 @@ void TargetDarkBremFilter::AbortEvent(const std::string& reason) const {
                      ->GetEventID()
               << ") " << reason << " Aborting event." << std::endl;
   }
-  G4RunManager::GetRunManager()->AbortEvent();
+  abortEvent(reason);
   return;
 }
 }  // namespace biasing
@@ -25,18 +25,10 @@ TargetENProcessFilter::~TargetENProcessFilter() {}
 void TargetENProcessFilter::stepping(const G4Step* step) {
   if (reactionOccurred_) return;
 
-  // Get the track associated with this step.
+  // Get the track associated with this step, the primary electron (see
+  // getSelection).
   G4Track* track = step->GetTrack();
 
-  // Only process tracks whose parent is the primary particle
-  if (track->GetParentID() != 0) return;
-
-  // get the PDGID of the track.
-  G4int pdgID = track->GetParticleDefinition()->GetPDGEncoding();
-
-  // Make sure that the particle being processed is an electron.
-  if (pdgID != 11) return;  // Throw an exception
-
   // Get the volume the particle is in.
   G4VPhysicalVolume* volume = track->GetVolume();
   G4String volumeName = volume->GetName();
@@ -50,7 +42,7 @@ void TargetENProcessFilter::stepping(const G4Step* step) {
 
   if (track->GetMomentum().mag() > recoilEnergyThreshold_) {
     track->SetTrackStatus(fKillTrackAndSecondaries);
-    G4RunManager::GetRunManager()->AbortEvent();
+    abortEvent("stepping");
     return;
   }
 
@@ -66,7 +58,7 @@ void TargetENProcessFilter::stepping(const G4Step* step) {
                 << std::endl;*/
 
     track->SetTrackStatus(fKillTrackAndSecondaries);
-    G4RunManager::GetRunManager()->AbortEvent();
+    abortEvent("stepping");
     return;
   } else {
     G4String processName =
@@ -85,7 +77,7 @@ void TargetENProcessFilter::stepping(const G4Step* step) {
                 << std::endl;*/
 
       track->SetTrackStatus(fKillTrackAndSecondaries);
-      G4RunManager::GetRunManager()->AbortEvent();
+      abortEvent("stepping");
       return;
     }
 
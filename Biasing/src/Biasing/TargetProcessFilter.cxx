@@ -18,6 +18,7 @@
 /*~~~~~~~~~~~~~*/
 /*   SimCore   */
 /*~~~~~~~~~~~~~*/
+#include "SimCore/NameTags.h"
 #include "SimCore/UserTrackInformation.h"
 
 namespace biasing {
@@ -26,6 +27,11 @@ TargetProcessFilter::TargetProcessFilter(
     const std::string& name, framework::config::Parameters& parameters)
     : simcore::UserAction(name, parameters) {
   process_ = parameters.getParameter<std::string>("process");
+
+  auto& tags{simcore::NameTags::get()};
+  targetRegion_ = tags.tag("target");
+  recoilVolume_ = tags.tag("recoil_PV");
+  worldVolume_ = tags.tag("World_PV");
 }
 
 TargetProcessFilter::~TargetProcessFilter() {}
@@ -62,16 +68,16 @@ void TargetProcessFilter::stepping(const G4Step* step) {
 
   // Get the region the particle is currently in. Continue processing
   // the particle only if it's in the target region.
-  if (auto region{
-          track->GetVolume()->GetLogicalVolume()->GetRegion()->GetName()};
-      region.compareTo("target") != 0) {
+  auto& tags{simcore::NameTags::get()};
+  if (tags.region(track->GetVolume()->GetLogicalVolume()->GetRegion()) !=
+      targetRegion_) {
     // If secondaries were produced outside of the volume of interest,
     // and there aren't additional brems to process, abort the event.
     // Otherwise, suspend the track and move on to the next brem.
     if (secondaries->size() != 0) {
       if (getEventInfo()->bremCandidateCount() == 1) {
         track->SetTrackStatus(fKillTrackAndSecondaries);
-        G4RunManager::GetRunManager()->AbortEvent();
+        abortEvent("stepping");
         currentTrack_ = nullptr;
       } else {
         currentTrack_ = track;
@@ -99,12 +105,11 @@ void TargetProcessFilter::stepping(const G4Step* step) {
      * We also check for 'World_PV' because in later geometries, there is
      * an air gap between the target region and the recoil tracker.
      */
-    if (auto volume{track->GetNextVolume()->GetName()};
-        volume.compareTo("recoil_PV") == 0 or
-        volume.compareTo("World_PV") == 0) {
+    if (auto volume{tags.volume(track->GetNextVolume())};
+        volume == recoilVolume_ or volume == worldVolume_) {
       if (getEventInfo()->bremCandidateCount() == 1) {
         track->SetTrackStatus(fKillTrackAndSecondaries);
-        G4RunManager::GetRunManager()->AbortEvent();
+        abortEvent("stepping");
         currentTrack_ = nullptr;
       } else {
         currentTrack_ = track;
@@ -117,14 +122,14 @@ void TargetProcessFilter::stepping(const G4Step* step) {
   } else {
     // If the brem gamma interacts and produced secondaries, get the
     // process used to create them.
-    G4String processName =
-        secondaries->at(0)->GetCreatorProcess()->GetProcessName();
+    const G4String& processName{
+        secondaries->at(0)->GetCreatorProcess()->GetProcessName()};
 
     // Only record the process that is being biased
     if (!processName.contains(process_)) {
       if (getEventInfo()->bremCandidateCount() == 1) {
         track->SetTrackStatus(fKillTrackAndSecondaries);
-        G4RunManager::GetRunManager()->AbortEvent();
+        abortEvent("stepping");
         currentTrack_ = nullptr;
       } else {
         currentTrack_ = track;
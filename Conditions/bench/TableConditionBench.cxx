@@ -0,0 +1,83 @@
+/**
+ * @file TableConditionBench.cxx
+ * @brief Benchmark looking up the rows of a conditions table
+ */
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "Conditions/SimpleTableCondition.h"
+#include "DetDescr/EcalID.h"
+
+namespace conditions {
+namespace bench {
+
+/// Table with findKey exposed so we can time it on its own
+class Table : public DoubleTableCondition {
+ public:
+  Table() : DoubleTableCondition("BenchTable", {"ADC_PEDESTAL", "ADC_GAIN"}) {}
+  using DoubleTableCondition::findKey;
+};
+
+/// Fill the table with a row for every channel of the ECal
+static void fill(Table& table) {
+  std::vector<unsigned int> ids;
+  std::vector<double> values;
+  for (int layer{0}; layer < 34; layer++) {
+    for (int module{0}; module < 7; module++) {
+      for (int cell{0}; cell < 432; cell++) {
+        ids.push_back(ldmx::EcalID(layer, module, cell).raw());
+        values.push_back(50.);
+        values.push_back(0.3125);
+      }
+    }
+  }
+  table.addRows(ids, values);
+}
+
+/**
+ * The channels hit in a few events
+ *
+ * They are drawn from a fixed seed, so every run and every build
+ * looks up the same channels.
+ */
+static std::vector<unsigned int> recordedChannels() {
+  std::mt19937 rng(23);
+  std::uniform_int_distribution<int> layer(0, 33), module(0, 6), cell(0, 431);
+  std::vector<unsigned int> channels;
+  for (int i{0}; i < 10000; i++)
+    channels.push_back(ldmx::EcalID(layer(rng), module(rng), cell(rng)).raw());
+  return channels;
+}
+
+}  // namespace bench
+}  // namespace conditions
+
+/// Find the rows of the recorded channels
+static void BM_BaseTableCondition_findKey(benchmark::State& state) {
+  using namespace conditions;
+  bench::Table table;
+  bench::fill(table);
+  const auto channels{bench::recordedChannels()};
+  for (auto _ : state) {
+    for (unsigned int id : channels)
+      benchmark::DoNotOptimize(table.findKey(id));
+  }
+  state.SetItemsProcessed(state.iterations() * channels.size());
+}
+BENCHMARK(BM_BaseTableCondition_findKey);
+
+/// Get a value of the recorded channels, the usual way conditions are used
+static void BM_HomogenousTableCondition_get(benchmark::State& state) {
+  using namespace conditions;
+  bench::Table table;
+  bench::fill(table);
+  const auto channels{bench::recordedChannels()};
+  for (auto _ : state) {
+    for (unsigned int id : channels)
+      benchmark::DoNotOptimize(table.get(id, 1));
+  }
+  state.SetItemsProcessed(state.iterations() * channels.size());
+}
+BENCHMARK(BM_HomogenousTableCondition_get);
@@ -0,0 +1,134 @@
+/**
+ * @file SharedTableCache
+ * @brief Node-local cache of conditions tables shared between processes
+ */
+#ifndef CONDITIONS_SHAREDTABLECACHE_H_
+#define CONDITIONS_SHAREDTABLECACHE_H_
+
+#include <istream>
+#include <string>
+
+#include "Conditions/SimpleTableCondition.h"
+
+namespace conditions {
+
+/**
+ * @class Cache of conditions tables in files that are mapped into memory
+ *
+ * Many processes running on the same node each load the same tables,
+ * so they each spend the time downloading and parsing them and each
+ * keep their own copy. The first process to load a table publishes its
+ * contents into a file in the cache directory, and the others map that
+ * file into their memory instead of loading the table. The kernel then
+ * keeps a single copy of the table in memory for all of them.
+ *
+ * A directory on a memory-backed file system (e.g. /dev/shm/ldmx-conditions)
+ * is best, but any node-local directory works.
+ *
+ * The table is identified by a key which should contain everything that
+ * determines its contents (e.g. the URL after expanding the tag and the
+ * names of the columns). A file is written under a temporary name and
+ * then renamed, so processes never see a partially written table.
+ */
+class SharedTableCache {
+ public:
+  /**
+   * Use the input directory for the cache
+   *
+   * The directory is created if it doesn't exist yet.
+   *
+   * @param[in] directory path to the cache directory
+   */
+  SharedTableCache(const std::string& directory);
+
+  /**
+   * Attach a table to the shared copy of its contents
+   *
+   * The table is filled with the contents of the shared copy. Its columns
+   * need to already be defined and match the shared copy. The table cannot
+   * be changed afterwards, except by clearing it.
+   *
+   * @param[in] key identifier of the table contents
+   * @param[in,out] table to attach
+   * @return true if a shared copy was found and attached
+   */
+  bool attach(const std::string& key, IntegerTableCondition& table) const;
+  bool attach(const std::string& key, DoubleTableCondition& table) const;
+
+  /**
+   * Publish the contents of a table so other processes can attach to it
+   *
+   * Failing to publish is not an error, the other processes will
+   * load the table themselves.
+   *
+   * @param[in] key identifier of the table contents
+   * @param[in] table to publish
+   * @return true if the table was published
+   */
+  bool publish(const std::string& key,
+               const IntegerTableCondition& table) const;
+  bool publish(const std::string& key,
+               const DoubleTableCondition& table) const;
+
+  /**
+   * Map a file in the format of the cache into memory as a table
+   *
+   * The files can also be written on their own as snapshots of tables,
+   * which are then loaded without any parsing.
+   *
+   * @param[in] file_path path to the file
+   * @param[in] key identifier of the table contents, which the file has
+   * to have been written with
+   * @param[in,out] table to attach, its columns need to match the file
+   * @return true if the file exists and matches the key and the table
+   */
+  template <class T>
+  static bool map(const std::string& file_path, const std::string& key,
+                  HomogenousTableCondition<T>& table);
+
+  /**
+   * Read a table in the format of the cache from a stream
+   *
+   * Unlike map, the table gets its own copy of the contents.
+   *
+   * @see map
+   */
+  template <class T>
+  static bool read(std::istream& is, const std::string& key,
+                   HomogenousTableCondition<T>& table);
+
+  /**
+   * Write a table into a file in the format of the cache
+   *
+   * The file is written under a temporary name and then renamed.
+   *
+   * @param[in] file_path path to the file
+   * @param[in] key identifier of the table contents
+   * @param[in] table to write
+   * @return true if the file was written
+   */
+  template <class T>
+  static bool write(const std::string& file_path, const std::string& key,
+                    const HomogenousTableCondition<T>& table);
+
+ private:
+  /// attach to a table of any type
+  template <class T>
+  bool attachT(const std::string& key,
+               HomogenousTableCondition<T>& table) const;
+
+  /// publish a table of any type
+  template <class T>
+  bool publishT(const std::string& key,
+                const HomogenousTableCondition<T>& table) const;
+
+  /// get the path to the file for the input key
+  std::string path(const std::string& key) const;
+
+  /// the directory of cache files
+  std::string directory_;
+};
+
+}  // namespace conditions
+
+#endif
@@ -7,6 +7,9 @@
 #ifndef CONDITIONS_SIMPLECSVTABLEPROVIDER_H_
 #define CONDITIONS_SIMPLECSVTABLEPROVIDER_H_
 
+#include <memory>
+
+#include "Conditions/SharedTableCache.h"
 #include "Framework/ConditionsObjectProvider.h"
 
 namespace conditions {
@@ -56,6 +59,19 @@ namespace conditions {
  *  the parameter 'conditions_baseURL' set in the python configuration.
  *  * ${LDMX_CONDITION_TAG} will be replaced with the
  *  tagname provided in the constructor.
+ *
+ * If the "sharedCacheDir" parameter is set, the tables loaded from URLs
+ * are shared with the other processes on the node through a
+ * SharedTableCache in that directory.
+ *
+ * If the "urlCacheDir" parameter is set, the tables downloaded from
+ * http(s) URLs are kept in that directory and reused by later jobs for
+ * "urlCacheTTL" seconds before they are revalidated with the server.
+ *
+ * A URL starting with bin:// or ending with .bin is loaded as a binary
+ * snapshot of the table (see SimpleTableStreamerBinary and the
+ * convert-conditions-table tool) instead of a CSV file. Local snapshots
+ * are mapped into memory.
  */
 class SimpleCSVTableProvider : public framework::ConditionsObjectProvider {
  public:
@@ -74,6 +90,10 @@ class SimpleCSVTableProvider : public framework::ConditionsObjectProvider {
   std::vector<std::string> columns_;
   std::string entriesURL_;
   std::string conditions_baseURL_;
+  /// directory of the local cache of downloaded tables, none if empty
+  std::string urlCacheDir_;
+  /// seconds a downloaded table is used before revalidating it
+  int urlCacheTTL_;
 
   void entriesFromPython(std::vector<framework::config::Parameters>&);
   void entriesFromCSV();
@@ -89,6 +109,16 @@ class SimpleCSVTableProvider : public framework::ConditionsObjectProvider {
 
   std::vector<Entry> entries_;
 
+  /// Cache of tables shared with other processes, null if not sharing
+  std::unique_ptr<SharedTableCache> sharedCache_;
+
+  /**
+   * Load a table from a URL, as a binary snapshot if the URL starts with
+   * bin:// or ends with .bin and as CSV otherwise
+   */
+  template <class T>
+  void loadTable(const std::string& url, T& table) const;
+
   /**
    * Utility for expanding environment variables
    */
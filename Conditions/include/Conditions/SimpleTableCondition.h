@@ -6,6 +6,8 @@
 #ifndef FRAMEWORK_SIMPLETABLECONDITION_H_
 #define FRAMEWORK_SIMPLETABLECONDITION_H_
 
+#include <algorithm>
+#include <memory>
 #include <ostream>
 #include <vector>
 
@@ -14,6 +16,8 @@
 
 namespace conditions {
 
+class SharedTableCache;
+
 /**
  * @class Base type for conditions objects which are tables indexed by raw
  * detector id values
@@ -62,7 +66,7 @@ class BaseTableCondition : public framework::ConditionsObject {
       EXCEPTION_RAISE("ConditionsException",
                       "Row out of range: " + std::to_string(irow));
     }
-    return keys_[irow];
+    return keyData()[irow];
   }
 
   /**
@@ -73,7 +77,17 @@ class BaseTableCondition : public framework::ConditionsObject {
   /**
    * Get the number of rows
    */
-  std::size_t getRowCount() const { return keys_.size(); }
+  std::size_t getRowCount() const {
+    return sharedKeys_ ? sharedRowCount_ : keys_.size();
+  }
+
+  /**
+   * Check if the contents of this table are in memory shared with other
+   * processes, in which case they cannot be changed.
+   *
+   * @see SharedTableCache
+   */
+  bool isShared() const { return sharedKeys_ != nullptr; }
 
   /**
    * Set an AND mask to be applied to the id.  Typically used to "flatten" a
@@ -91,7 +105,7 @@ class BaseTableCondition : public framework::ConditionsObject {
    * Streams a given row of this table
    */
   virtual std::ostream& streamRow(std::ostream& s, int irow) const {
-    return s << keys_[irow];
+    return s << keyData()[irow];
   }
 
  protected:
@@ -99,10 +113,56 @@ class BaseTableCondition : public framework::ConditionsObject {
 
   std::size_t findKeyInsert(unsigned int id) const;
 
+  /// Get the keys, either our own or the shared ones
+  const uint32_t* keyData() const {
+    return sharedKeys_ ? sharedKeys_ : keys_.data();
+  }
+
   std::vector<std::string> columns_;
   unsigned int columnCount_;
   std::vector<uint32_t> keys_;
   unsigned int idMask_;
+
+  /// Keys in memory shared with other processes, null if we own our keys
+  const uint32_t* sharedKeys_{nullptr};
+  /// Number of rows in the shared memory
+  std::size_t sharedRowCount_{0};
+  /// Keeps the shared memory around as long as we are using it
+  std::shared_ptr<const void> sharedRegion_;
+
+  friend class SharedTableCache;
+};
+
+/**
+ * @class View of the values of one row of a table
+ *
+ * The values of a row are found once and then read by column number,
+ * instead of looking up the id again for every column. The view is
+ * only valid as long as the table (or the columns) it points into.
+ */
+template <class T>
+class TableRow {
+ public:
+  /**
+   * View of values which are stride apart
+   *
+   * @param[in] values the value of the first column
+   * @param[in] stride distance between the values of consecutive columns
+   */
+  TableRow(const T* values, std::size_t stride)
+      : values_{values}, stride_{stride} {}
+
+  /**
+   * Get the value of a column, which is not checked against the column
+   * count of the table
+   */
+  T operator[](unsigned int col) const { return values_[col * stride_]; }
+
+ private:
+  /// the value of the first column
+  const T* values_;
+  /// distance between the values of consecutive columns
+  std::size_t stride_;
 };
 
 template <class T>
@@ -120,10 +180,19 @@ class HomogenousTableCondition : public BaseTableCondition {
   void clear() {
     keys_.clear();
     values_.clear();
+    sharedKeys_ = nullptr;
+    sharedValues_ = nullptr;
+    sharedRowCount_ = 0;
+    sharedRegion_.reset();
   }
 
   /** Add an entry to the table */
   void add(unsigned int id, const std::vector<T>& values) {
+    if (isShared()) {
+      EXCEPTION_RAISE("ConditionsException",
+                      "Attempted to add a row to " + getName() +
+                          " which is shared with other processes");
+    }
     if (values.size() != columnCount_) {
       EXCEPTION_RAISE("ConditionsException",
                       getName() + ": Attempted to insert a row with " +
@@ -146,6 +215,57 @@ class HomogenousTableCondition : public BaseTableCondition {
                    values.end());
   }
 
+  /**
+   * Add many entries to the table at once
+   *
+   * The rows are sorted by id once rather than inserted one at a time,
+   * which matters for tables with many rows.
+   *
+   * @param ids the id of each row
+   * @param values the values of the rows one after the other
+   */
+  void addRows(const std::vector<unsigned int>& ids,
+               const std::vector<T>& values) {
+    if (values.size() != ids.size() * columnCount_) {
+      EXCEPTION_RAISE("ConditionsException",
+                      getName() + ": Attempted to insert " +
+                          std::to_string(values.size()) + " values in " +
+                          std::to_string(ids.size()) +
+                          " rows into a table with " +
+                          std::to_string(columnCount_) + " columns");
+    }
+    if (getRowCount() > 0 || isShared() || idMask_ != 0xFFFFFFFFu) {
+      // merging with existing rows or masking the ids, go through add
+      std::vector<T> row(columnCount_);
+      for (std::size_t i = 0; i < ids.size(); i++) {
+        std::copy(values.begin() + i * columnCount_,
+                  values.begin() + (i + 1) * columnCount_, row.begin());
+        add(ids[i], row);
+      }
+      return;
+    }
+    std::vector<std::size_t> order(ids.size());
+    for (std::size_t i = 0; i < order.size(); i++) order[i] = i;
+    if (!std::is_sorted(ids.begin(), ids.end())) {
+      std::stable_sort(order.begin(), order.end(),
+                       [&ids](std::size_t a, std::size_t b) {
+                         return ids[a] < ids[b];
+                       });
+    }
+    keys_.reserve(ids.size());
+    values_.reserve(values.size());
+    for (auto i : order) {
+      if (!keys_.empty() && keys_.back() == ids[i]) {
+        EXCEPTION_RAISE("ConditionsException",
+                        "Attempted to add condition in " + getName() +
+                            " for existing id " + std::to_string(ids[i]));
+      }
+      keys_.push_back(ids[i]);
+      values_.insert(values_.end(), values.begin() + i * columnCount_,
+                     values.begin() + (i + 1) * columnCount_);
+    }
+  }
+
   /**
    * Get an entry by DetectorId and number.
    * Throws an exception when id is unavailble
@@ -157,7 +277,21 @@ class HomogenousTableCondition : public BaseTableCondition {
                       "No such column " + std::to_string(col) + " or id " +
                           std::to_string(id));
     }
-    return values_[irow * columnCount_ + col];
+    return valueData()[irow * columnCount_ + col];
+  }
+
+  /**
+   * Get a view of the values of a row by DetectorId, to read several
+   * columns with a single search for the id.
+   * Throws an exception when id is unavailble
+   */
+  TableRow<T> row(unsigned int id) const {
+    std::size_t irow = findKey(id);
+    if (irow == getRowCount()) {  // raise exception
+      EXCEPTION_RAISE("ConditionsException",
+                      "No such id " + std::to_string(id));
+    }
+    return TableRow<T>(valueData() + irow * columnCount_, 1);
   }
 
   /**
@@ -169,9 +303,9 @@ class HomogenousTableCondition : public BaseTableCondition {
       EXCEPTION_RAISE("ConditionsException",
                       "Row out of range: " + std::to_string(irow));
     }
-    std::vector<T> rv(&(values_[irow * columnCount_]),
-                      &(values_[(irow + 1) * columnCount_]));
-    return std::pair<unsigned int, std::vector<T> >(keys_[irow], rv);
+    std::vector<T> rv(valueData() + irow * columnCount_,
+                      valueData() + (irow + 1) * columnCount_);
+    return std::pair<unsigned int, std::vector<T> >(keyData()[irow], rv);
   }
 
   /**
@@ -192,14 +326,24 @@ class HomogenousTableCondition : public BaseTableCondition {
       EXCEPTION_RAISE("ConditionsException",
                       "Row out of range: " + std::to_string(irow));
     }
-    s << keys_[irow];
+    s << keyData()[irow];
     for (int i = 0; i < columnCount_; i++)
-      s << ',' << values_[irow * columnCount_ + i];
+      s << ',' << valueData()[irow * columnCount_ + i];
     return s << std::endl;
   }
 
  private:
+  /// Get the values, either our own or the shared ones
+  const T* valueData() const {
+    return sharedValues_ ? sharedValues_ : values_.data();
+  }
+
   std::vector<T> values_;  // unrolled array
+
+  /// Values in memory shared with other processes, null if we own them
+  const T* sharedValues_{nullptr};
+
+  friend class SharedTableCache;
 };
 
 /**
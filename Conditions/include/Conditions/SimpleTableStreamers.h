@@ -7,6 +7,7 @@
 #define FRAMEWORK_SIMPLETABLESTREAMERS_H_
 
 #include <iostream>
+#include <string>
 
 #include "Conditions/SimpleTableCondition.h"
 
@@ -37,6 +38,36 @@ class SimpleTableStreamerCSV {
   static void load(IntegerTableCondition&, std::istream&);
   static void load(conditions::DoubleTableCondition&, std::istream&);
 };
+
+/**
+ * @class Converts a simple table to/from a binary snapshot
+ *
+ * The snapshot holds the sorted ids and the values of the table as they
+ * are in memory (in the format of the SharedTableCache), so it is loaded
+ * without any parsing. A snapshot in a local file is mapped into memory
+ * rather than read. The columns of the table loading a snapshot need to
+ * be the ones it was stored with, in the same order.
+ */
+class SimpleTableStreamerBinary {
+ public:
+  /**
+   * Write the table into a snapshot file
+   */
+  static void store(const IntegerTableCondition&, const std::string& filename);
+  static void store(const conditions::DoubleTableCondition&,
+                    const std::string& filename);
+  /**
+   * Load the table from a snapshot file, mapping it into memory
+   */
+  static void load(IntegerTableCondition&, const std::string& filename);
+  static void load(conditions::DoubleTableCondition&,
+                   const std::string& filename);
+  /**
+   * Load the table from a snapshot in a stream
+   */
+  static void load(IntegerTableCondition&, std::istream&);
+  static void load(conditions::DoubleTableCondition&, std::istream&);
+};
 }  // namespace utility
 }  // namespace conditions
 
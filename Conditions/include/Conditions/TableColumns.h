@@ -0,0 +1,189 @@
+/**
+ * @file TableColumns.h
+ * @brief Columns of a table condition indexed by a dense channel index
+ */
+
+#ifndef CONDITIONS_TABLECOLUMNS_H_
+#define CONDITIONS_TABLECOLUMNS_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "Conditions/SimpleTableCondition.h"
+
+namespace conditions {
+
+/**
+ * @class TableColumns
+ * @brief The columns of a HomogenousTableCondition laid out one after the other
+ *
+ * Getting a value from a table condition is a binary search over its keys,
+ * which is done again for every column of every channel. Here the table is
+ * copied once into one contiguous array per column and the channels are
+ * given a dense index computed from the fields of their ID, so a value is
+ * read without any search.
+ *
+ * The ID is split into an inner field (the low inner_bits bits, e.g. the
+ * strip of an HCal bar or the cell of an ECal module), an outer field (the
+ * next outer_bits bits) and the remaining high bits, which have to be the
+ * same for every key of the table. The channels of one outer value take
+ * consecutive indices up to the largest inner value in the table. If the
+ * keys of the table do not fit this layout, no columns are made and every
+ * value is taken from the table, as are values of IDs that are not in it,
+ * so the exceptions raised are the ones of HomogenousTableCondition::get.
+ *
+ * The table has to outlive the columns.
+ */
+template <class T>
+class TableColumns {
+ public:
+  /// index returned for a channel that is not in the columns
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  /**
+   * Copy the input table into columns
+   *
+   * @param[in] table the table to copy
+   * @param[in] inner_bits number of bits in the inner field of the ID
+   * @param[in] outer_bits number of bits in the outer field of the ID
+   */
+  TableColumns(const HomogenousTableCondition<T>& table,
+               unsigned int inner_bits, unsigned int outer_bits)
+      : table_{table},
+        id_mask_{table.getIdMask()},
+        inner_bits_{inner_bits},
+        high_shift_{inner_bits + outer_bits},
+        inner_mask_{(uint64_t(1) << inner_bits) - 1},
+        outer_mask_{(uint64_t(1) << outer_bits) - 1},
+        n_cols_{table.getColumnCount()} {
+    std::size_t n_rows{table.getRowCount()};
+    if (n_rows == 0) return;
+
+    high_ = uint64_t(table.getRowId(0) & id_mask_) >> high_shift_;
+    std::vector<std::size_t> group_size(outer_mask_ + 1, 0);
+    for (std::size_t irow{0}; irow < n_rows; irow++) {
+      uint64_t key{table.getRowId(irow) & id_mask_};
+      // keys we can't place, read everything from the table
+      if ((key >> high_shift_) != high_) return;
+      std::size_t& size{group_size[(key >> inner_bits_) & outer_mask_]};
+      size = std::max<std::size_t>(size, (key & inner_mask_) + 1);
+    }
+
+    group_start_.resize(group_size.size());
+    group_end_.resize(group_size.size());
+    for (std::size_t g{0}; g < group_size.size(); g++) {
+      group_start_[g] = n_;
+      n_ += group_size[g];
+      group_end_[g] = n_;
+    }
+
+    values_.assign(n_cols_ * n_, T());
+    present_.assign(n_, false);
+    for (std::size_t irow{0}; irow < n_rows; irow++) {
+      auto [key, row] = table.getRow(irow);
+      std::size_t i{dense(key & id_mask_)};
+      present_[i] = true;
+      for (std::size_t col{0}; col < n_cols_; col++)
+        values_[col * n_ + i] = row[col];
+    }
+  }
+
+  /**
+   * Get the dense index of a channel
+   *
+   * @param[in] id raw ID of the channel
+   * @return index into the columns or npos if the channel is not in them
+   */
+  std::size_t index(unsigned int id) const {
+    if (n_ == 0) return npos;
+    uint64_t effid{id & id_mask_};
+    if ((effid >> high_shift_) != high_) return npos;
+    std::size_t g{(effid >> inner_bits_) & outer_mask_};
+    std::size_t i{group_start_[g] + (effid & inner_mask_)};
+    if (i >= group_end_[g] or not present_[i]) return npos;
+    return i;
+  }
+
+  /**
+   * Get an entry by ID and column number
+   *
+   * Falls back to the table if the channel is not in the columns.
+   *
+   * @param[in] id raw ID of the channel
+   * @param[in] col column number
+   * @return the value in that column for that channel
+   */
+  T get(unsigned int id, unsigned int col) const {
+    std::size_t i{index(id)};
+    if (i == npos or col >= n_cols_) return table_.get(id, col);
+    return values_[col * n_ + i];
+  }
+
+  /**
+   * Get a view of all the columns of a channel
+   *
+   * Falls back to the table if the channel is not in the columns.
+   *
+   * @param[in] id raw ID of the channel
+   * @return the values of the channel, by column number
+   */
+  TableRow<T> row(unsigned int id) const {
+    std::size_t i{index(id)};
+    if (i == npos) return table_.row(id);
+    return TableRow<T>(values_.data() + i, n_);
+  }
+
+  /**
+   * Get the start of a column
+   *
+   * The value of the channel with dense index i is at position i, where
+   * positions of channels not in the table hold a default-constructed T.
+   *
+   * @param[in] col column number, must be less than the column count
+   * @return pointer to size() values of the column
+   */
+  const T* column(unsigned int col) const { return values_.data() + col * n_; }
+
+  /// @return length of each column
+  std::size_t size() const { return n_; }
+
+ private:
+  /// dense index of a key we know is in the layout
+  std::size_t dense(uint64_t key) const {
+    return group_start_[(key >> inner_bits_) & outer_mask_] +
+           (key & inner_mask_);
+  }
+
+ private:
+  /// the table we were built from
+  const HomogenousTableCondition<T>& table_;
+  /// mask applied to the IDs by the table
+  unsigned int id_mask_;
+  /// number of bits in the inner field of the ID
+  unsigned int inner_bits_;
+  /// shift to the high bits of the ID
+  unsigned int high_shift_;
+  /// mask of the inner field after shifting
+  uint64_t inner_mask_;
+  /// mask of the outer field after shifting
+  uint64_t outer_mask_;
+  /// high bits shared by all the keys of the table
+  uint64_t high_{0};
+  /// number of columns in the table
+  std::size_t n_cols_;
+  /// length of each column
+  std::size_t n_{0};
+  /// dense index of the first channel of each outer value
+  std::vector<std::size_t> group_start_;
+  /// dense index after the last channel of each outer value
+  std::vector<std::size_t> group_end_;
+  /// the columns one after the other
+  std::vector<T> values_;
+  /// whether each dense index is a channel in the table
+  std::vector<bool> present_;
+};
+
+}  // namespace conditions
+
+#endif  // CONDITIONS_TABLECOLUMNS_H_
@@ -14,14 +14,35 @@ namespace conditions {
  * urlstream loads the defined url as an istream if possible.
  * Raises an exception if it is unable to open the file, URL, etc or if the url
  * isn't understood
+ *
+ * If a cache directory is given, the contents of http:// and https:// URLs
+ * are kept in that directory and reused by later calls, also from other
+ * processes and jobs. A cached copy younger than the time-to-live is used
+ * without contacting the server, an older one is revalidated with the
+ * ETag and Last-Modified headers the server sent with it. If the server
+ * can't be reached, a stale copy is used rather than failing.
+ *
+ * @param url location to load
+ * @param cacheDir directory of the local cache, no caching if empty
+ * @param cacheTTL seconds a cached copy is used without revalidating it
  */
-std::unique_ptr<std::istream> urlstream(const std::string& url);
+std::unique_ptr<std::istream> urlstream(const std::string& url,
+                                        const std::string& cacheDir = "",
+                                        int cacheTTL = 0);
 
 /**
  * returns various statistics useful mostly for unit testing.
  */
 void urlstatistics(unsigned int& http_requests, unsigned int& http_failures);
 
+/**
+ * returns various statistics useful mostly for unit testing, including
+ * the number of http(s) URLs served from the cache (hits) and fetched
+ * into it (misses).
+ */
+void urlstatistics(unsigned int& http_requests, unsigned int& http_failures,
+                   unsigned int& cache_hits, unsigned int& cache_misses);
+
 }  // namespace conditions
 
 #endif
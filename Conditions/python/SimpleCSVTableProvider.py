@@ -74,6 +74,14 @@ class SimpleCSVTableProvider(ldmxcfg.ConditionsObjectProvider):
         Base location for URLs, filling the LDMX_CONDITION_BASEURL parameter inside any table's URL
     entriesURL : str
         URL to a CSV table mapping tables to specific intervals of validity.  Optional.
+    sharedCacheDir : str
+        Node-local directory (e.g. '/dev/shm/ldmx-conditions') to share the loaded tables
+        through with the other processes on the same node. Optional.
+    urlCacheDir : str
+        Directory to keep the tables downloaded from http(s) URLs in, so later jobs
+        reuse them instead of downloading them again. Optional.
+    urlCacheTTL : int
+        Seconds a downloaded table is used before it is revalidated with the server
     """
 
     def __init__(self,objName,dataType, columns):
@@ -83,6 +91,9 @@ class SimpleCSVTableProvider(ldmxcfg.ConditionsObjectProvider):
         self.entries=[]
         self.conditions_baseURL=''
         self.entriesURL=''
+        self.sharedCacheDir=''
+        self.urlCacheDir=''
+        self.urlCacheTTL=3600
 
     def validForever(self, url):
         """Add an entry to this provider that is valid forever and for all run types (data or MC)
@@ -22,19 +22,20 @@ namespace conditions {
 
 std::size_t BaseTableCondition::findKey(unsigned int id) const {
   unsigned int effid = id & idMask_;
-  std::vector<unsigned int>::const_iterator ptr =
-      std::lower_bound(keys_.begin(), keys_.end(), effid);
-  if (ptr == keys_.end() || *ptr != effid)
-    return keys_.size();
+  const uint32_t* begin = keyData();
+  const uint32_t* end = begin + getRowCount();
+  const uint32_t* ptr = std::lower_bound(begin, end, effid);
+  if (ptr == end || *ptr != effid)
+    return getRowCount();
   else
-    return std::distance(keys_.begin(), ptr);
+    return std::distance(begin, ptr);
 }
 
 std::size_t BaseTableCondition::findKeyInsert(unsigned int id) const {
   unsigned int effid = id & idMask_;
-  std::vector<unsigned int>::const_iterator ptr =
-      std::lower_bound(keys_.begin(), keys_.end(), effid);
-  return std::distance(keys_.begin(), ptr);
+  const uint32_t* begin = keyData();
+  const uint32_t* ptr = std::lower_bound(begin, begin + getRowCount(), effid);
+  return std::distance(begin, ptr);
 }
 
 }  // namespace conditions
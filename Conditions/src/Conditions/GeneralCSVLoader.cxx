@@ -3,14 +3,64 @@
 #include <string.h>
 #include <wordexp.h>
 
+#include <algorithm>
+#include <cctype>
 #include <fstream>
 #include <iostream>
 
 #include "Framework/Exception/Exception.h"
-#include "boost/tokenizer.hpp"
 
 namespace conditions {
 
+/**
+ * Split a line into fields separated by commas, where quotation marks
+ * are dropped and protect the commas between them and a backslash
+ * escapes a quotation mark, a backslash or 'n' for a new line (like
+ * boost::escaped_list_separator).
+ *
+ * The strings already in fields are reused so that their memory is kept
+ * from one row to the next.
+ *
+ * @param[in] line line to split
+ * @param[out] fields the fields of the line
+ */
+static void splitEscapedList(const std::string& line,
+                             std::vector<std::string>& fields) {
+  std::size_t n = 0;
+  auto nextField = [&]() {
+    if (n == fields.size()) fields.emplace_back();
+    fields[n++].clear();
+  };
+  nextField();
+  bool inquote = false;
+  for (std::size_t i = 0; i < line.size(); i++) {
+    char chr = line[i];
+    if (chr == '\\') {
+      if (++i == line.size()) {
+        EXCEPTION_RAISE("CSVBadEscape",
+                        "Reading CSV found a line ending in an escape");
+      }
+      chr = line[i];
+      if (chr == 'n') {
+        fields[n - 1] += '\n';
+      } else if (chr == '\\' || chr == '"') {
+        fields[n - 1] += chr;
+      } else {
+        EXCEPTION_RAISE("CSVBadEscape",
+                        std::string("Reading CSV found unknown escape \\") +
+                            chr);
+      }
+    } else if (chr == ',' && !inquote) {
+      nextField();
+    } else if (chr == '"') {
+      inquote = !inquote;
+    } else {
+      fields[n - 1] += chr;
+    }
+  }
+  fields.resize(n);
+}
+
 const std::string& GeneralCSVLoader::get(const std::string& colname,
                                          bool ignore_case) const {
   size_t i;
@@ -37,27 +87,21 @@ bool GeneralCSVLoader::nextRow() {
     if (line.empty()) return false;
     // it's a comment!
     if (line[0] == '#') continue;
-    // split into pieces
-    std::vector<std::string> line_split;
     // explicitly erase trailing white space
     line.erase(std::find_if(line.rbegin(), line.rend(),
                             [](unsigned char c) { return !std::isspace(c); })
                    .base(),
                line.end());
-    boost::tokenizer<boost::escaped_list_separator<char>> tok(line);
-    for (auto chunk : tok) {
-      line_split.push_back(chunk);
-    }
+    // split into pieces, reusing the strings of the previous row
     if (colNames_.empty()) {
-      colNames_.swap(line_split);
+      splitEscapedList(line, colNames_);
       continue;
     }
-    if (line_split.size() == colNames_.size())
-      rowData_.swap(line_split);
-    else {
+    splitEscapedList(line, rowData_);
+    if (rowData_.size() != colNames_.size()) {
       EXCEPTION_RAISE("CSVLineMismatch",
                       "Reading CSV found line with " +
-                          std::to_string(line_split.size()) + " in CSV with " +
+                          std::to_string(rowData_.size()) + " in CSV with " +
                           std::to_string(colNames_.size()) + " columns");
     }
 
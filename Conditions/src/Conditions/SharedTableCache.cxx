@@ -0,0 +1,234 @@
+#include "Conditions/SharedTableCache.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+namespace conditions {
+
+namespace {
+
+/**
+ * Layout of the start of a cache file
+ *
+ * The header is followed by the key, the row keys and the values,
+ * each starting on an 8-byte boundary.
+ */
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t valueSize;
+  uint32_t keyLength;
+  uint32_t idMask;
+  uint64_t rowCount;
+  uint64_t columnCount;
+};
+
+static_assert(sizeof(Header) % 8 == 0, "header needs to keep the alignment");
+
+const char MAGIC[8] = "LDMXTBL";
+const uint32_t VERSION = 1;
+
+/// round up to the next 8-byte boundary
+std::size_t pad(std::size_t n) { return (n + 7) & ~std::size_t(7); }
+
+/**
+ * Check that a table file in memory holds the input key and fits a table
+ *
+ * @param[in] data contents of the file
+ * @param[in] size size of the file
+ * @param[in] key identifier of the table contents
+ * @param[in] table to fill from the file
+ * @param[out] header header of the file
+ * @param[out] keys_at offset of the row keys
+ * @param[out] values_at offset of the values
+ * @return true if the file can be used for the table
+ */
+template <class T>
+bool check(const char* data, std::size_t size, const std::string& key,
+           const HomogenousTableCondition<T>& table, Header& header,
+           std::size_t& keys_at, std::size_t& values_at) {
+  if (size < sizeof(Header)) return false;
+  std::memcpy(&header, data, sizeof(Header));
+  keys_at = pad(sizeof(Header) + header.keyLength);
+  values_at = keys_at + pad(header.rowCount * sizeof(uint32_t));
+  return std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 and
+         header.version == VERSION and header.valueSize == sizeof(T) and
+         header.columnCount == table.getColumnCount() and
+         header.keyLength == key.size() and
+         values_at + header.rowCount * header.columnCount * sizeof(T) ==
+             size and
+         key.compare(0, key.size(), data + sizeof(Header),
+                     header.keyLength) == 0;
+}
+
+}  // namespace
+
+SharedTableCache::SharedTableCache(const std::string& directory)
+    : directory_{directory} {
+  // may already exist, which is fine, otherwise publishing will fail
+  mkdir(directory_.c_str(), 0777);
+}
+
+bool SharedTableCache::attach(const std::string& key,
+                              IntegerTableCondition& table) const {
+  return attachT(key, table);
+}
+
+bool SharedTableCache::attach(const std::string& key,
+                              DoubleTableCondition& table) const {
+  return attachT(key, table);
+}
+
+bool SharedTableCache::publish(const std::string& key,
+                               const IntegerTableCondition& table) const {
+  return publishT(key, table);
+}
+
+bool SharedTableCache::publish(const std::string& key,
+                               const DoubleTableCondition& table) const {
+  return publishT(key, table);
+}
+
+std::string SharedTableCache::path(const std::string& key) const {
+  std::stringstream ss;
+  ss << directory_ << "/" << std::hex << std::hash<std::string>{}(key)
+     << ".table";
+  return ss.str();
+}
+
+template <class T>
+bool SharedTableCache::attachT(const std::string& key,
+                               HomogenousTableCondition<T>& table) const {
+  // fails on a hash collision or a file from a different version,
+  // the caller then loads the table itself
+  return map(path(key), key, table);
+}
+
+template <class T>
+bool SharedTableCache::publishT(
+    const std::string& key, const HomogenousTableCondition<T>& table) const {
+  return write(path(key), key, table);
+}
+
+template <class T>
+bool SharedTableCache::map(const std::string& file_path, const std::string& key,
+                           HomogenousTableCondition<T>& table) {
+  int fd = open(file_path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0 or std::size_t(st.st_size) < sizeof(Header)) {
+    close(fd);
+    return false;
+  }
+  std::size_t size = st.st_size;
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);  // the mapping stays valid
+  if (addr == MAP_FAILED) return false;
+  std::shared_ptr<const void> region(
+      addr, [size](const void* p) { munmap(const_cast<void*>(p), size); });
+
+  const char* data = static_cast<const char*>(addr);
+  Header header;
+  std::size_t keys_at, values_at;
+  if (not check(data, size, key, table, header, keys_at, values_at))
+    return false;
+
+  table.clear();
+  table.sharedKeys_ = reinterpret_cast<const uint32_t*>(data + keys_at);
+  table.sharedValues_ = reinterpret_cast<const T*>(data + values_at);
+  table.sharedRowCount_ = header.rowCount;
+  table.sharedRegion_ = region;
+  table.setIdMask(header.idMask);
+  return true;
+}
+
+template <class T>
+bool SharedTableCache::read(std::istream& is, const std::string& key,
+                            HomogenousTableCondition<T>& table) {
+  std::string buffer;
+  {
+    std::ostringstream ss;
+    ss << is.rdbuf();
+    buffer = ss.str();
+  }
+  Header header;
+  std::size_t keys_at, values_at;
+  if (not check(buffer.data(), buffer.size(), key, table, header, keys_at,
+                values_at))
+    return false;
+
+  table.clear();
+  table.keys_.resize(header.rowCount);
+  std::memcpy(table.keys_.data(), buffer.data() + keys_at,
+              header.rowCount * sizeof(uint32_t));
+  table.values_.resize(header.rowCount * header.columnCount);
+  std::memcpy(table.values_.data(), buffer.data() + values_at,
+              table.values_.size() * sizeof(T));
+  table.setIdMask(header.idMask);
+  return true;
+}
+
+template <class T>
+bool SharedTableCache::write(const std::string& final_path,
+                             const std::string& key,
+                             const HomogenousTableCondition<T>& table) {
+  std::string tmp_path{final_path + ".tmp" + std::to_string(getpid())};
+  {
+    std::ofstream file(tmp_path, std::ios::binary);
+    if (not file) return false;
+
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.valueSize = sizeof(T);
+    header.keyLength = key.size();
+    header.idMask = table.getIdMask();
+    header.rowCount = table.getRowCount();
+    header.columnCount = table.getColumnCount();
+
+    const char zeros[8] = {0};
+    auto write_padded = [&](const void* p, std::size_t n) {
+      file.write(static_cast<const char*>(p), n);
+      file.write(zeros, pad(n) - n);
+    };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    write_padded(key.data(), key.size());
+    write_padded(table.keyData(), header.rowCount * sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(table.valueData()),
+               header.rowCount * header.columnCount * sizeof(T));
+    if (not file) {
+      file.close();
+      std::remove(tmp_path.c_str());
+      return false;
+    }
+  }
+  // replace atomically so others either see nothing or the whole table
+  if (std::rename(tmp_path.c_str(), final_path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+template bool SharedTableCache::map(const std::string&, const std::string&,
+                                    HomogenousTableCondition<int>&);
+template bool SharedTableCache::map(const std::string&, const std::string&,
+                                    HomogenousTableCondition<double>&);
+template bool SharedTableCache::read(std::istream&, const std::string&,
+                                     HomogenousTableCondition<int>&);
+template bool SharedTableCache::read(std::istream&, const std::string&,
+                                     HomogenousTableCondition<double>&);
+template bool SharedTableCache::write(const std::string&, const std::string&,
+                                      const HomogenousTableCondition<int>&);
+template bool SharedTableCache::write(const std::string&, const std::string&,
+                                      const HomogenousTableCondition<double>&);
+
+}  // namespace conditions
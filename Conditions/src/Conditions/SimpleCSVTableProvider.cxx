@@ -1,5 +1,7 @@
 #include "Conditions/SimpleCSVTableProvider.h"
 
+#include <string.h>
+
 #include "Conditions/GeneralCSVLoader.h"
 #include "Conditions/SimpleTableStreamers.h"
 #include "Conditions/URLStreamer.h"
@@ -24,6 +26,8 @@ SimpleCSVTableProvider::SimpleCSVTableProvider(
 
   conditions_baseURL_ =
       parameters.getParameter<std::string>("conditions_baseURL");
+  urlCacheDir_ = parameters.getParameter<std::string>("urlCacheDir", "");
+  urlCacheTTL_ = parameters.getParameter<int>("urlCacheTTL", 3600);
 
   if (parameters.exists("entries")) {
     std::vector<framework::config::Parameters> plist =
@@ -34,6 +38,10 @@ SimpleCSVTableProvider::SimpleCSVTableProvider(
 
   entriesURL_ = parameters.getParameter<std::string>("entriesURL");
   if (!entriesURL_.empty()) entriesFromCSV();
+
+  auto cache_dir{parameters.getParameter<std::string>("sharedCacheDir", "")};
+  if (!cache_dir.empty())
+    sharedCache_ = std::make_unique<SharedTableCache>(cache_dir);
 }
 
 void SimpleCSVTableProvider::entriesFromPython(
@@ -87,7 +95,8 @@ void SimpleCSVTableProvider::entriesFromPython(
 
 void SimpleCSVTableProvider::entriesFromCSV() {
   std::string csvurl = expandEnv(entriesURL_);
-  std::unique_ptr<std::istream> pstr = urlstream(csvurl);
+  std::unique_ptr<std::istream> pstr =
+      urlstream(csvurl, urlCacheDir_, urlCacheTTL_);
 
   StreamCSVLoader loader(*(pstr.get()));
 
@@ -154,6 +163,36 @@ std::string SimpleCSVTableProvider::expandEnv(const std::string& s) const {
   return retval;
 }
 
+template <class T>
+void SimpleCSVTableProvider::loadTable(const std::string& url,
+                                       T& table) const {
+  std::string location = url;
+  bool binary = false;
+  if (location.find("bin://") == 0) {
+    location = location.substr(strlen("bin://"));
+    binary = true;
+  } else if (location.size() >= 4 &&
+             location.compare(location.size() - 4, 4, ".bin") == 0) {
+    binary = true;
+  }
+  if (!binary) {
+    std::unique_ptr<std::istream> stream =
+        urlstream(location, urlCacheDir_, urlCacheTTL_);
+    conditions::utility::SimpleTableStreamerCSV::load(table, *(stream.get()));
+  } else if (location.find("file://") == 0 ||
+             (!location.empty() && location[0] == '/')) {
+    // local snapshots are mapped into memory
+    if (location.find("file://") == 0)
+      location = location.substr(strlen("file://"));
+    conditions::utility::SimpleTableStreamerBinary::load(table, location);
+  } else {
+    std::unique_ptr<std::istream> stream =
+        urlstream(location, urlCacheDir_, urlCacheTTL_);
+    conditions::utility::SimpleTableStreamerBinary::load(table,
+                                                         *(stream.get()));
+  }
+}
+
 std::pair<const framework::ConditionsObject*, framework::ConditionsIOV>
 SimpleCSVTableProvider::getCondition(const ldmx::EventHeader& context) {
   for (auto tabledef : entries_) {
@@ -181,21 +220,30 @@ SimpleCSVTableProvider::getCondition(const ldmx::EventHeader& context) {
                            framework::ConditionsIOV>(table, tabledef.iov_);
         }
       } else {
-        std::unique_ptr<std::istream> stream = urlstream(expurl);
+        // everything that determines the contents of the table
+        std::string key = expurl;
+        for (auto column : columns_) key += "," + column;
 
         if (objectType_ == OBJ_int) {
           IntegerTableCondition* table =
               new IntegerTableCondition(getConditionObjectName(), columns_);
-          conditions::utility::SimpleTableStreamerCSV::load(*table,
-                                                            *(stream.get()));
+          if (!sharedCache_ || !sharedCache_->attach("int:" + key, *table)) {
+            loadTable(expurl, *table);
+            if (sharedCache_ && !table->isShared())
+              sharedCache_->publish("int:" + key, *table);
+          }
           return std::pair<const framework::ConditionsObject*,
                            framework::ConditionsIOV>(table, tabledef.iov_);
         } else if (objectType_ == OBJ_double) {
           conditions::DoubleTableCondition* table =
               new conditions::DoubleTableCondition(getConditionObjectName(),
                                                    columns_);
-          conditions::utility::SimpleTableStreamerCSV::load(*table,
-                                                            *(stream.get()));
+          if (!sharedCache_ ||
+              !sharedCache_->attach("double:" + key, *table)) {
+            loadTable(expurl, *table);
+            if (sharedCache_ && !table->isShared())
+              sharedCache_->publish("double:" + key, *table);
+          }
           return std::pair<const framework::ConditionsObject*,
                            framework::ConditionsIOV>(table, tabledef.iov_);
         }
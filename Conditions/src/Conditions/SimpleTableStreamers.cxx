@@ -1,8 +1,12 @@
 #include "Conditions/SimpleTableStreamers.h"
 
 #include <algorithm>
+#include <charconv>
 #include <iomanip>
+#include <sstream>
+#include <string_view>
 
+#include "Conditions/SharedTableCache.h"
 #include "DetDescr/DetectorIDInterpreter.h"
 #include "boost/format.hpp"
 
@@ -29,13 +33,14 @@ void storeT(const T& t, std::ostream& s, bool expandIds) {
     s << ",\"" << name << "\"";
   }
   s << std::endl;
-  // write the data rows
+  // write the data rows, reusing the interpreter for all of them
+  ldmx::DetectorIDInterpreter did;
   for (unsigned int irow = 0; irow < t.getRowCount(); irow++) {
     std::pair<unsigned int, std::vector<V> > row = t.getRow(irow);
     // write the id in hex
     s << boost::format("0x%08x") % row.first;
     if (expandIds) {
-      ldmx::DetectorIDInterpreter did(row.first);
+      did.setRawValue(row.first);
 
       for (int i = 0; i < did.getFieldCount(); i++)
         s << ',' << std::setprecision(10) << did.getFieldValue(i);
@@ -53,79 +58,147 @@ void SimpleTableStreamerCSV::store(const conditions::DoubleTableCondition& t,
   storeT<conditions::DoubleTableCondition, double>(t, s, expandIds);
 }
 
-static int convert(const std::string& s, int dummy) {
-  return strtol(s.c_str(), 0, 0);
+/**
+ * Convert a field like strtol with base 0, which the DetIDs are written in
+ * hexadecimal and the values may be written in
+ */
+template <class V>
+static V convertInteger(std::string_view s) {
+  bool negative = false;
+  if (!s.empty() && (s[0] == '-' || s[0] == '+')) {
+    negative = s[0] == '-';
+    s.remove_prefix(1);
+  }
+  int base = 10;
+  if (s.size() > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+    base = 16;
+    s.remove_prefix(2);
+  } else if (s.size() > 1 && s[0] == '0') {
+    base = 8;
+  }
+  V value = 0;
+  std::from_chars(s.data(), s.data() + s.size(), value, base);
+  return negative ? -value : value;
 }
 
-static double convert(const std::string& s, double dummy) {
-  return atof(s.c_str());
+static int convert(std::string_view s, int dummy) {
+  return convertInteger<int>(s);
 }
 
-static std::vector<std::string> splitCSV(const std::string& s) {
-  std::vector<std::string> rv;
-  std::string field;
+static double convert(std::string_view s, double dummy) {
+  // like atof, which doesn't mind a plus sign
+  if (!s.empty() && s[0] == '+') s.remove_prefix(1);
+  double value = 0;
+  std::from_chars(s.data(), s.data() + s.size(), value);
+  return value;
+}
+
+/**
+ * Split a line of a CSV file into its non-empty fields
+ *
+ * Quotation marks and white space outside of them are dropped, and
+ * anything following a '#' outside of quotation marks is a comment. The
+ * line is modified to hold the fields without what was dropped, so the
+ * fields can point into it without any copies.
+ *
+ * @param[in,out] begin first character of the line
+ * @param[in,out] end one past the last character of the line
+ * @param[out] fields the fields of the line
+ */
+static void splitCSV(char* begin, char* end,
+                     std::vector<std::string_view>& fields) {
+  fields.clear();
+  char* field = begin;
+  char* write = begin;
   bool inquote = false;
-  for (auto chr : s) {
+  for (char* read = begin; read != end; read++) {
+    char chr = *read;
     if (chr == '"') {
       inquote = !inquote;
     } else if ((chr == ',' || chr == '\t') && !inquote) {
-      if (!field.empty()) {
-        //			std::cout << "Field: '" << field << "'\n";
-        rv.push_back(field);
-      }
-      field.clear();
+      if (write != field) fields.emplace_back(field, write - field);
+      field = write;
     } else if (isspace(chr) && !inquote) {  // do not add spaces
     } else if (chr == '#' && !inquote) {
       break;  // comment
     } else {
-      field += chr;
+      *write++ = chr;
     }
   }
-  if (!field.empty()) {
-    rv.push_back(field);
-    //		std::cout << "Field: '" << field << "'\n";
-  }
-  return rv;
+  if (write != field) fields.emplace_back(field, write - field);
 }
-static std::vector<std::string>::const_iterator find(
-    const std::vector<std::string>& v, const std::string& a) {
+
+static std::vector<std::string_view>::const_iterator find(
+    const std::vector<std::string_view>& v, const std::string& a) {
   for (auto i = v.begin(); i != v.end(); i++) {
     if ((*i) == a) return i;
   }
   return v.end();
 }
 
+/// read the rest of a stream into memory
+static std::string readAll(std::istream& is) {
+  std::string buffer;
+  auto pos = is.tellg();
+  if (pos >= 0 && is.seekg(0, std::ios::end)) {
+    auto size = is.tellg() - pos;
+    is.seekg(pos);
+    buffer.resize(size);
+    is.read(buffer.data(), size);
+    buffer.resize(is.gcount());
+  } else {
+    is.clear();
+    std::ostringstream ss;
+    ss << is.rdbuf();
+    buffer = ss.str();
+  }
+  return buffer;
+}
+
 template <class T, class V>
 void loadT(T& table, std::istream& is) {
   table.clear();
+  // the whole table is parsed in place, it is small compared to the table
+  std::string buffer = readAll(is);
+  char* const begin = buffer.data();
+  char* const bufend = begin + buffer.size();
+  char* line = begin;
+  // the end of the line and the start of the next
+  auto nextLine = [&]() {
+    char* eol = std::find(line, bufend, '\n');
+    char* next = eol == bufend ? bufend : eol + 1;
+    return std::make_pair(eol, next);
+  };
+
   // first work with the header line
-  std::string line;
-  std::vector<std::string> split;
+  std::vector<std::string_view> split;
   int iDetID = -1;
   int iline = 0;
   size_t ncolin;
 
-  while (!is.eof()) {
+  while (true) {
+    if (line == bufend) {
+      EXCEPTION_RAISE("ConditionsException", "CSV file has no valid header");
+    }
     iline++;
-    std::getline(is, line);
-    split = splitCSV(line);
+    auto [eol, next] = nextLine();
+    splitCSV(line, eol, split);
+    line = next;
     if (split.size() < 1) {
-      split.clear();
       continue;  // need at least an id column and as many columns as requested
     }
     if (find(split, "DetID") == split.end() &&
         find(split, "subdetector") == split.end()) {
       EXCEPTION_RAISE("ConditionsException",
                       "Malformed CSV file with no DetId or subdetector column");
-    } else {
-      break;
     }
-  }
-  if (is.eof()) {
-    EXCEPTION_RAISE("ConditionsException", "CSV file has no valid header");
+    if (eol == bufend) {
+      EXCEPTION_RAISE("ConditionsException", "CSV file has no valid header");
+    }
+    break;
   }
   // ok, we have a header line.  Do we have a DetID column?
-  std::vector<std::string>::const_iterator id = find(split, "DetID");
+  auto id = find(split, "DetID");
   if (id != split.end()) {
     // good this is simpler...
     iDetID = int(id - split.begin());
@@ -136,7 +209,7 @@ void loadT(T& table, std::istream& is) {
   }
   ncolin = split.size();
   // check for columns which match all those requested in the table
-  std::map<unsigned int, int> table_to_csv;
+  std::vector<int> table_to_csv(table.getColumnCount());
   for (unsigned int ic = 0; ic != table.getColumnCount(); ic++) {
     auto fc = find(split, table.getColumnName(ic));
     if (fc == split.end()) {
@@ -147,11 +220,20 @@ void loadT(T& table, std::istream& is) {
     table_to_csv[ic] = int(fc - split.begin());
   }
 
+  // at most one row per remaining line
+  std::size_t nlines = std::count(line, bufend, '\n') + 1;
+  std::vector<unsigned int> ids;
+  std::vector<V> values;
+  ids.reserve(nlines);
+  values.reserve(nlines * table_to_csv.size());
+
   // processing additional lines
-  while (!is.eof()) {
+  V dummy(0);
+  while (line != bufend) {
     iline++;
-    std::getline(is, line);
-    split = splitCSV(line);
+    auto [eol, next] = nextLine();
+    splitCSV(line, eol, split);
+    line = next;
     if (split.size() == 0) continue;  // ignore comment lines
     if (split.size() != ncolin) {
       EXCEPTION_RAISE("ConditionsException", "Mismatched number of columns (" +
@@ -161,16 +243,14 @@ void loadT(T& table, std::istream& is) {
                                                  std::to_string(iline));
     }
     unsigned int id(0);
-    std::vector<V> values(table_to_csv.size(), 0);
-    if (iDetID >= 0) id = strtoul(split[iDetID].c_str(), 0, 0);
-    V dummy(0);
-    for (auto icopy : table_to_csv) {
-      values[icopy.first] = convert(split[icopy.second], dummy);
-    }
+    if (iDetID >= 0) id = convertInteger<unsigned int>(split[iDetID]);
     if (id != 0) {
-      table.add(id, values);
+      ids.push_back(id);
+      for (auto icsv : table_to_csv)
+        values.push_back(convert(split[icsv], dummy));
     }
   }
+  table.addRows(ids, values);
 }
 
 void SimpleTableStreamerCSV::load(IntegerTableCondition& table,
@@ -182,5 +262,69 @@ void SimpleTableStreamerCSV::load(conditions::DoubleTableCondition& table,
                                   std::istream& is) {
   loadT<conditions::DoubleTableCondition, double>(table, is);
 }
+/// identifies a snapshot by the columns of the table
+static std::string snapshotKey(const BaseTableCondition& table) {
+  std::string key = "snapshot";
+  for (auto& name : table.getColumnNames()) key += "," + name;
+  return key;
+}
+
+template <class T>
+static void storeBinaryT(const T& table, const std::string& filename) {
+  if (!SharedTableCache::write(filename, snapshotKey(table), table)) {
+    EXCEPTION_RAISE("ConditionsException",
+                    "Unable to write the snapshot of " + table.getName() +
+                        " to '" + filename + "'");
+  }
+}
+
+template <class T>
+static void loadBinaryT(T& table, const std::string& filename) {
+  if (!SharedTableCache::map(filename, snapshotKey(table), table)) {
+    EXCEPTION_RAISE("ConditionsException",
+                    "'" + filename + "' is not a snapshot of a table with "
+                    "the columns of " + table.getName());
+  }
+}
+
+template <class T>
+static void loadBinaryT(T& table, std::istream& is) {
+  if (!SharedTableCache::read(is, snapshotKey(table), table)) {
+    EXCEPTION_RAISE("ConditionsException",
+                    "The stream is not a snapshot of a table with the "
+                    "columns of " + table.getName());
+  }
+}
+
+void SimpleTableStreamerBinary::store(const IntegerTableCondition& table,
+                                      const std::string& filename) {
+  storeBinaryT(table, filename);
+}
+
+void SimpleTableStreamerBinary::store(
+    const conditions::DoubleTableCondition& table,
+    const std::string& filename) {
+  storeBinaryT(table, filename);
+}
+
+void SimpleTableStreamerBinary::load(IntegerTableCondition& table,
+                                     const std::string& filename) {
+  loadBinaryT(table, filename);
+}
+
+void SimpleTableStreamerBinary::load(conditions::DoubleTableCondition& table,
+                                     const std::string& filename) {
+  loadBinaryT(table, filename);
+}
+
+void SimpleTableStreamerBinary::load(IntegerTableCondition& table,
+                                     std::istream& is) {
+  loadBinaryT(table, is);
+}
+
+void SimpleTableStreamerBinary::load(conditions::DoubleTableCondition& table,
+                                     std::istream& is) {
+  loadBinaryT(table, is);
+}
 }  // namespace utility
 }  // namespace conditions
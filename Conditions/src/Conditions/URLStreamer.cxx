@@ -1,27 +1,207 @@
 #include "Conditions/URLStreamer.h"
 
 #include <string.h>
+#include <sys/stat.h>
 #include <sys/wait.h>
 #include <unistd.h>
+#include <utime.h>
 
+#include <atomic>
+#include <ctime>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "Framework/Exception/Exception.h"
 
 namespace conditions {
 
-static unsigned int http_requests_ = 0;
-static unsigned int http_failures_ = 0;
+// the conditions may be loaded on several threads
+static std::atomic<unsigned int> http_requests_ = 0;
+static std::atomic<unsigned int> http_failures_ = 0;
+static std::atomic<unsigned int> cache_hits_ = 0;
+static std::atomic<unsigned int> cache_misses_ = 0;
+static std::atomic<int> istream_ = 0;
 
 void urlstatistics(unsigned int& http_requests, unsigned int& http_failures) {
   http_requests = http_requests_;
   http_failures = http_failures_;
 }
 
-std::unique_ptr<std::istream> urlstream(const std::string& url) {
+void urlstatistics(unsigned int& http_requests, unsigned int& http_failures,
+                   unsigned int& cache_hits, unsigned int& cache_misses) {
+  urlstatistics(http_requests, http_failures);
+  cache_hits = cache_hits_;
+  cache_misses = cache_misses_;
+}
+
+namespace {
+
+/**
+ * Download a URL into a file with wget, writing the response headers
+ * of the server into a log file
+ *
+ * @return exit status of wget, -1 if it didn't exit normally
+ */
+int wget(const std::string& url, const std::string& fname,
+         const std::string& log, const std::vector<std::string>& headers) {
+  std::vector<std::string> args = {"wget", "-q", "-S", "--no-check-certificate",
+                                   "-O",   fname, "-o", log};
+  for (auto& header : headers) args.push_back("--header=" + header);
+  args.push_back(url);
+  std::vector<char*> argv;
+  for (auto& arg : args) argv.push_back(const_cast<char*>(arg.c_str()));
+  argv.push_back(nullptr);
+  pid_t apid = fork();
+  if (apid == 0) {  // child
+    execv("/usr/bin/wget", argv.data());
+    _exit(127);
+  }
+  int wstatus;
+  if (apid < 0 || waitpid(apid, &wstatus, 0) != apid || !WIFEXITED(wstatus))
+    return -1;
+  return WEXITSTATUS(wstatus);
+}
+
+/**
+ * Find the status code and validators of the last response in a wget log
+ *
+ * @return HTTP status code, 0 if there was no response
+ */
+int response(const std::string& log, std::string& etag,
+             std::string& lastModified) {
+  int code = 0;
+  std::ifstream ifs(log);
+  std::string line;
+  while (std::getline(ifs, line)) {
+    line.erase(0, line.find_first_not_of(" \t"));
+    if (line.compare(0, 5, "HTTP/") == 0) {
+      // a new response (e.g. after a redirect), forget the previous one
+      std::istringstream(line.substr(line.find(' ') + 1)) >> code;
+      etag.clear();
+      lastModified.clear();
+    } else if (strncasecmp(line.c_str(), "ETag: ", 6) == 0) {
+      etag = line.substr(6);
+    } else if (strncasecmp(line.c_str(), "Last-Modified: ", 15) == 0) {
+      lastModified = line.substr(15);
+    }
+  }
+  return code;
+}
+
+/// the contents of a file in memory
+std::unique_ptr<std::istream> readfile(const std::string& fname) {
+  std::ifstream ib(fname);
+  if (!ib.good()) return nullptr;
+  std::stringstream* ss = new std::stringstream();
+  (*ss) << ib.rdbuf();
+  return std::unique_ptr<std::istream>(ss);
+}
+
+/**
+ * Load an http(s) URL through the cache in a directory
+ *
+ * The cached contents of a URL are in a file named after the hash of the
+ * URL, next to a file with the URL itself (to catch hash collisions) and
+ * the ETag and Last-Modified headers of the response. Both are written to
+ * temporary files which are renamed into place, so other processes never
+ * see a partial file.
+ */
+std::unique_ptr<std::istream> cachedstream(const std::string& url,
+                                           const std::string& cacheDir,
+                                           int cacheTTL) {
+  mkdir(cacheDir.c_str(), 0777);
+  std::stringstream ss;
+  ss << cacheDir << "/" << std::hex << std::hash<std::string>{}(url);
+  const std::string data = ss.str() + ".csv", meta = ss.str() + ".meta";
+
+  struct stat info;
+  bool cached = stat(data.c_str(), &info) == 0;
+  std::string cachedURL, etag, lastModified;
+  if (cached) {
+    std::ifstream ifs(meta);
+    cached = std::getline(ifs, cachedURL) && cachedURL == url;
+    std::getline(ifs, etag);
+    std::getline(ifs, lastModified);
+  }
+
+  if (cached && std::difftime(std::time(nullptr), info.st_mtime) < cacheTTL) {
+    auto stream = readfile(data);
+    if (stream) {
+      cache_hits_++;
+      return stream;
+    }
+    cached = false;
+  }
+
+  std::vector<std::string> headers;
+  if (cached && !etag.empty()) headers.push_back("If-None-Match: " + etag);
+  if (cached && !lastModified.empty())
+    headers.push_back("If-Modified-Since: " + lastModified);
+
+  const std::string tmp = ss.str() + "." + std::to_string(getpid()) + "_" +
+                          std::to_string(istream_++) + ".tmp";
+  const std::string log = tmp + ".log";
+  http_requests_++;
+  int status = wget(url, tmp, log, headers);
+  std::string newETag, newLastModified;
+  int code = response(log, newETag, newLastModified);
+  std::remove(log.c_str());
+
+  if (cached && code == 304) {
+    // not modified, the cached copy is good for another TTL
+    std::remove(tmp.c_str());
+    utime(data.c_str(), nullptr);
+    auto stream = readfile(data);
+    if (stream) {
+      cache_hits_++;
+      return stream;
+    }
+  }
+
+  if (status != 0 || code == 304) {
+    http_failures_++;
+    std::remove(tmp.c_str());
+    // keep going with the cached copy if the server is unreachable
+    if (cached && (code == 0 || code >= 500)) {
+      auto stream = readfile(data);
+      if (stream) {
+        std::cerr << "[ URLStreamer ] : Unable to revalidate URL '" << url
+                  << "', using the cached copy " << data << std::endl;
+        cache_hits_++;
+        return stream;
+      }
+    }
+    EXCEPTION_RAISE("ConditionsException", "Wget error " +
+                                               std::to_string(status) +
+                                               " retreiving URL '" + url + "'");
+  }
+
+  auto stream = readfile(tmp);
+  if (!stream) {
+    http_failures_++;
+    std::remove(tmp.c_str());
+    EXCEPTION_RAISE("ConditionsException",
+                    "Bad/empty file retreiving URL '" + url + "'");
+  }
+  cache_misses_++;
+  {
+    std::ofstream ofs(tmp + ".meta");
+    ofs << url << '\n' << newETag << '\n' << newLastModified << '\n';
+  }
+  std::rename(tmp.c_str(), data.c_str());
+  std::rename((tmp + ".meta").c_str(), meta.c_str());
+  return stream;
+}
+
+}  // namespace
+
+std::unique_ptr<std::istream> urlstream(const std::string& url,
+                                        const std::string& cacheDir,
+                                        int cacheTTL) {
   if (url.find("file://") == 0 || url.length() > 0 && url[0] == '/') {
     std::string fname = url;
     if (fname.find("file://") == 0)
@@ -36,11 +216,11 @@ std::unique_ptr<std::istream> urlstream(const std::string& url) {
   }
   if ((url.find("http://") != std::string::npos) ||
       (url.find("https://") != std::string::npos)) {
+    if (!cacheDir.empty()) return cachedstream(url, cacheDir, cacheTTL);
     http_requests_++;
     // this implementation uses wget to handle the SSL processes
-    static int istream = 0;
     char fname[250];
-    snprintf(fname, 250, "/tmp/httpstream_%d_%d.csv ", getpid(), istream++);
+    snprintf(fname, 250, "/tmp/httpstream_%d_%d.csv ", getpid(), istream_++);
     pid_t apid = fork();
     if (apid == 0) {  // child
       execl("/usr/bin/wget", "wget", "-q", "--no-check-certificate", "-O",
@@ -0,0 +1,64 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Conditions/SimpleTableCondition.h"
+#include "Conditions/SimpleTableStreamers.h"
+#include "Framework/Exception/Exception.h"
+
+/**
+ * @app convert-conditions-table
+ *
+ * Converts a CSV conditions table into the binary snapshot that the
+ * SimpleCSVTableProvider maps into memory instead of parsing. The
+ * columns are the ones the provider of the table is configured with,
+ * in the same order.
+ *
+ * Usage: convert-conditions-table <int|double> <csv table> <binary table>
+ *          <column> [<column> ...]
+ */
+template <class T>
+static std::size_t convert(const std::string& csv, const std::string& binary,
+                           const std::vector<std::string>& columns) {
+  T table(csv, columns);
+  std::ifstream is(csv);
+  if (!is) {
+    EXCEPTION_RAISE("ConditionsException",
+                    "Unable to open CSV file '" + csv + "'");
+  }
+  conditions::utility::SimpleTableStreamerCSV::load(table, is);
+  conditions::utility::SimpleTableStreamerBinary::store(table, binary);
+  return table.getRowCount();
+}
+
+int main(int argc, char** argv) {
+  if (argc < 5) {
+    std::cerr << "Usage: " << argv[0]
+              << " <int|double> <csv table> <binary table> <column> "
+                 "[<column> ...]"
+              << std::endl;
+    return 1;
+  }
+
+  std::string type{argv[1]}, csv{argv[2]}, binary{argv[3]};
+  std::vector<std::string> columns(argv + 4, argv + argc);
+  try {
+    std::size_t rows;
+    if (type == "int" || type == "integer") {
+      rows = convert<conditions::IntegerTableCondition>(csv, binary, columns);
+    } else if (type == "double" || type == "float") {
+      rows = convert<conditions::DoubleTableCondition>(csv, binary, columns);
+    } else {
+      std::cerr << "Unknown table type '" << type
+                << "', it is either int or double." << std::endl;
+      return 1;
+    }
+    std::cout << "Wrote the " << rows << " rows of '" << csv << "' to '"
+              << binary << "'" << std::endl;
+  } catch (const framework::exception::Exception& e) {
+    std::cerr << "[" << e.name() << "] " << e.message() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -6,9 +6,11 @@
 #include <sstream>
 
 #include "Conditions/GeneralCSVLoader.h"
+#include "Conditions/SharedTableCache.h"
 #include "Conditions/SimpleCSVTableProvider.h"
 #include "Conditions/SimpleTableCondition.h"
 #include "Conditions/SimpleTableStreamers.h"
+#include "Conditions/TableColumns.h"
 #include "Conditions/URLStreamer.h"
 #include "DetDescr/EcalID.h"
 #include "DetDescr/HcalID.h"
@@ -134,6 +136,42 @@ TEST_CASE("Conditions", "[Conditions]") {
     CHECK(image == expected);
   }
 
+  SECTION("Testing table columns") {
+    // cell is the inner field of the EcalID, module and layer the outer one
+    TableColumns<int> icols(itable, 12, 11);
+    REQUIRE(icols.size() == 101);
+    for (int key = 100; key > 0; key -= 10) {
+      ldmx::EcalID id(1, 1, key);
+      REQUIRE(icols.index(id.raw()) != TableColumns<int>::npos);
+      auto irow{itable.row(id.raw())}, crow{icols.row(id.raw())};
+      for (unsigned int col = 0; col < 3; col++) {
+        CHECK(icols.get(id.raw(), col) == itable.get(id.raw(), col));
+        CHECK(irow[col] == itable.get(id.raw(), col));
+        CHECK(crow[col] == itable.get(id.raw(), col));
+      }
+      CHECK(icols.column(2)[icols.index(id.raw())] == key * key);
+    }
+
+    // channels not in the table fall back to it and its exceptions
+    ldmx::EcalID missing(1, 1, 15), other_module(1, 2, 20);
+    CHECK(icols.index(missing.raw()) == TableColumns<int>::npos);
+    CHECK(icols.index(other_module.raw()) == TableColumns<int>::npos);
+    REQUIRE_THROWS_WITH(icols.get(missing.raw(), 0),
+                        ContainsSubstring("No such column"));
+    REQUIRE_THROWS_WITH(icols.row(missing.raw()),
+                        ContainsSubstring("No such id"));
+    REQUIRE_THROWS_WITH(icols.get(ldmx::EcalID(1, 1, 20).raw(), 3),
+                        ContainsSubstring("No such column"));
+
+    // strip is the inner field of the HcalID
+    TableColumns<double> dcols(dtable, 8, 12);
+    for (int key = 1; key < 8; key += 2) {
+      ldmx::HcalID id(1, 1, key);
+      CHECK(dcols.get(id.raw(), 0) == dtable.get(id.raw(), 0));
+      CHECK(dcols.get(id.raw(), 2) == dtable.get(id.raw(), 2));
+    }
+  }
+
   SECTION("Testing CSV IO") {
     std::stringstream ss;
     conditions::utility::SimpleTableStreamerCSV::store(itable, ss, true);
@@ -185,6 +223,80 @@ TEST_CASE("Conditions", "[Conditions]") {
     REQUIRE_THROWS_WITH(
         conditions::utility::SimpleTableStreamerCSV::load(itable2, ss_read4),
         ContainsSubstring("Mismatched number of columns (3!=4) on line 3"));
+
+    // rows out of order, with comments, quotes and spaces
+    std::string image5(
+        "# reversed\nDetID,V,\"A\",Q\n0x14021064, 10000,200,50\n"
+        "\n0x1402105a,8100,180,45 # last but one\n0x1402100a,\"100\",20,5\n");
+    std::stringstream ss_read5(image5);
+    conditions::utility::SimpleTableStreamerCSV::load(itable2, ss_read5);
+    REQUIRE(itable2.getRowCount() == 3);
+    CHECK(itable2.getRowId(0) == 0x1402100a);
+    CHECK(itable2.getRowId(2) == 0x14021064);
+    CHECK(itable2.get(0x1402105a, 0) == 180);
+    CHECK(itable2.get(0x1402105a, 2) == 8100);
+
+    // repeated id example
+    std::string image6("DetID,A,Q,V\n0x1402100a,20,5,100\n0x1402100a,1,2,3\n");
+    std::stringstream ss_read6(image6);
+    REQUIRE_THROWS_WITH(
+        conditions::utility::SimpleTableStreamerCSV::load(itable2, ss_read6),
+        ContainsSubstring("existing id"));
+  }
+
+  SECTION("Testing shared table cache") {
+    char dir_template[] = "/tmp/test_cond_cacheXXXXXX";
+    std::string dir = mkdtemp(dir_template);
+    SharedTableCache cache(dir);
+
+    IntegerTableCondition ishared("ITable", columns);
+    REQUIRE_FALSE(cache.attach("itable", ishared));
+    REQUIRE(cache.publish("itable", itable));
+    REQUIRE(cache.attach("itable", ishared));
+    CHECK(ishared.isShared());
+    matchesAll(itable, ishared);
+    REQUIRE_THROWS_WITH(ishared.add(1, std::vector<int>(3)),
+                        ContainsSubstring("shared with other processes"));
+
+    // a different type is not attached, even with the same key
+    DoubleTableCondition dshared("DTable", columnsd);
+    REQUIRE_FALSE(cache.attach("itable", dshared));
+    REQUIRE(cache.publish("dtable", dtable));
+    REQUIRE(cache.attach("dtable", dshared));
+    matchesAll(dtable, dshared);
+
+    ishared.clear();
+    CHECK_FALSE(ishared.isShared());
+    CHECK(ishared.getRowCount() == 0);
+  }
+
+  SECTION("Testing binary snapshot") {
+    std::string fname = "/tmp/test_cond_snapshot.bin";
+    conditions::utility::SimpleTableStreamerBinary::store(dtable, fname);
+
+    // mapped from the file
+    DoubleTableCondition dmapped("DTable", columnsd);
+    conditions::utility::SimpleTableStreamerBinary::load(dmapped, fname);
+    CHECK(dmapped.isShared());
+    matchesAll(dtable, dmapped);
+
+    // read from a stream
+    std::ifstream fs(fname, std::ios::binary);
+    DoubleTableCondition dread("DTable", columnsd);
+    conditions::utility::SimpleTableStreamerBinary::load(dread, fs);
+    CHECK_FALSE(dread.isShared());
+    matchesAll(dtable, dread);
+
+    // the columns and the type need to match
+    IntegerTableCondition iwrong("ITable", columnsd);
+    REQUIRE_THROWS_WITH(
+        conditions::utility::SimpleTableStreamerBinary::load(iwrong, fname),
+        ContainsSubstring("is not a snapshot"));
+    DoubleTableCondition dwrong("DTable", columns);
+    REQUIRE_THROWS_WITH(
+        conditions::utility::SimpleTableStreamerBinary::load(dwrong, fname),
+        ContainsSubstring("is not a snapshot"));
+    std::remove(fname.c_str());
   }
 
   SECTION("Testing python static") {
@@ -280,6 +392,30 @@ TEST_CASE("Conditions", "[Conditions]") {
     matchesAll(httpTable, itable);
   }
 
+  SECTION("Testing HTTP cache") {
+    const std::string url =
+        "http://www-users.cse.umn.edu/~jmmans/test_table.csv";
+    const std::string cacheDir = "/tmp/test_cond_urlcache";
+    system(("rm -rf " + cacheDir).c_str());
+
+    unsigned int http_requests[2], http_failures[2], cache_hits[2],
+        cache_misses[2];
+    urlstatistics(http_requests[0], http_failures[0], cache_hits[0],
+                  cache_misses[0]);
+
+    std::stringstream first, second;
+    first << urlstream(url, cacheDir, 3600)->rdbuf();
+    second << urlstream(url, cacheDir, 3600)->rdbuf();
+    CHECK(first.str() == second.str());
+
+    urlstatistics(http_requests[1], http_failures[1], cache_hits[1],
+                  cache_misses[1]);
+    CHECK(http_requests[1] - http_requests[0] == 1);
+    CHECK(http_failures[1] - http_failures[0] == 0);
+    CHECK(cache_misses[1] - cache_misses[0] == 1);
+    CHECK(cache_hits[1] - cache_hits[0] == 1);
+  }
+
   SECTION("Testing CSV metatable") {
     const char* cfg =
         "#!/usr/bin/python3\n\nimport sys\n\nfrom LDMX.Framework "
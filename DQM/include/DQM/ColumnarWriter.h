@@ -0,0 +1,158 @@
+#ifndef DQM_COLUMNARWRITER_H
+#define DQM_COLUMNARWRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// LDMX Framework
+#include "Framework/Configure/Parameters.h"
+#include "Framework/EventProcessor.h"
+
+namespace dqm {
+
+/**
+ * @class ColumnarWriter
+ * @brief Write selected fields of event collections as flat columns
+ *
+ * Each selected field of a collection is written to its own NumPy .npy
+ * file in the output directory, holding the values of that field for all
+ * of the entries of the collection in all of the events, one after the
+ * other. The number of entries of each collection in each event is kept
+ * in a column of offsets, the same layout as an Arrow list array, so the
+ * columns can be memory mapped with numpy.load(..., mmap_mode='r') and
+ * split into events with awkward.unflatten without a conversion pass.
+ *
+ *   <output_dir>/event.npy                 event number of each event
+ *   <output_dir>/run.npy                   run number of each event
+ *   <output_dir>/<collection>.offsets.npy  n_events+1 offsets (int64)
+ *   <output_dir>/<collection>.<field>.npy  values of the field
+ *
+ * The fields are the names of the data members of the class of the
+ * collection (e.g. energy_ for ldmx::EcalHit), which are found with the
+ * ROOT dictionary of the class, so any field of basic type can be chosen
+ * without changing this processor. Only the collection types listed in
+ * ColumnarWriter.cxx can be written.
+ *
+ * The values of each column are buffered and written to its file in
+ * batches of batch_size values.
+ */
+class ColumnarWriter : public framework::Analyzer {
+ public:
+  ColumnarWriter(const std::string& name, framework::Process& process)
+      : framework::Analyzer(name, process) {}
+
+  /**
+   * Input python configuration parameters
+   */
+  void configure(framework::config::Parameters& ps) final override;
+
+  /**
+   * Open the column files
+   */
+  void onProcessStart() final override;
+
+  /**
+   * Append the selected fields of the event to the columns
+   */
+  void analyze(const framework::Event& event) final override;
+
+  /**
+   * Write what is left in the buffers and close the column files
+   */
+  void onProcessEnd() final override;
+
+ private:
+  /**
+   * One column of values written to a .npy file
+   *
+   * The header is written with the number of values when the column is
+   * closed, the values are appended in between.
+   */
+  class Column {
+   public:
+    /**
+     * Open the file of a column
+     *
+     * @param[in] path path to the .npy file
+     * @param[in] descr numpy type string of the values, e.g. '<f4'
+     * @param[in] width size of a value [bytes]
+     * @param[in] batch number of values buffered before writing them
+     */
+    Column(const std::string& path, const std::string& descr,
+           std::size_t width, std::size_t batch);
+
+    /**
+     * Append a value
+     *
+     * @param[in] value pointer to the width bytes of the value
+     */
+    void append(const void* value);
+
+    /// write the buffered values to the file
+    void flush();
+
+    /// flush and write the header with the final number of values
+    void close();
+
+   private:
+    /// write the .npy header at the start of the file
+    void writeHeader();
+
+    std::ofstream file_;
+    std::string path_;
+    std::string descr_;
+    std::size_t width_;
+    std::size_t batch_;
+    std::size_t rows_{0};
+    std::vector<char> buffer_;
+  };
+
+  /// A field of a collection and its column
+  struct Field {
+    std::string name;
+    /// offset of the field in an entry [bytes]
+    std::size_t offset;
+    /// numpy type string and size of the field
+    std::string descr;
+    std::size_t width;
+    std::unique_ptr<Column> column;
+  };
+
+  /// A collection and the columns of its fields
+  struct Collection {
+    std::string name;
+    std::string pass;
+    /// get the entries of the collection in an event and their number
+    std::function<std::pair<const char*, std::size_t>(
+        const framework::Event&)>
+        get;
+    /// distance between two entries [bytes]
+    std::size_t stride;
+    /// number of entries written so far
+    std::int64_t n_entries{0};
+    std::unique_ptr<Column> offsets;
+    std::vector<Field> fields;
+  };
+
+  /// Directory to write the columns into
+  std::string output_dir_;
+
+  /// Number of values buffered per column before writing them
+  int batch_size_;
+
+  /// The collections to write
+  std::vector<Collection> collections_;
+
+  /// Event and run number of each event
+  std::unique_ptr<Column> event_, run_;
+};
+
+}  // namespace dqm
+
+#endif /* DQM_COLUMNARWRITER_H */
@@ -26,6 +26,11 @@ class EcalShowerFeatures : public framework::Analyzer {
    */
   virtual void configure(framework::config::Parameters& ps);
 
+  /**
+   * Get the IDs of the histograms we fill
+   */
+  virtual void onProcessStart();
+
   /**
    * Fills histograms
    */
@@ -37,6 +42,12 @@ class EcalShowerFeatures : public framework::Analyzer {
 
   /// Pass Name for veto object
   std::string ecal_veto_pass_;
+
+  /// IDs of the histograms we fill, so they don't need to be looked up
+  framework::HistogramHelper::ID deepest_layer_hit_, num_readout_hits_,
+      summed_det_, summed_iso_, summed_back_, max_cell_dep_, shower_rms_,
+      x_std_, y_std_, avg_layer_hit_, std_layer_hit_, e_containment_energy_,
+      ph_containment_energy_, out_containment_energy_;
 };
 }  // namespace dqm
 
@@ -7,6 +7,7 @@
 #include "Framework/Configure/Parameters.h"
 #include "Framework/EventProcessor.h"
 #include "SimCore/Event/SimParticle.h"
+#include "Tools/SimParticleIndex.h"
 namespace dqm {
 
 // Forward declarations within the ldmx workspace
@@ -92,7 +93,7 @@ class PhotoNuclearDQM : public framework::Analyzer {
    *
    * Find all daughter particles of a parent. Particles are included if they>
    *
-   * - Are in the particle map,
+   * - Are in the particle index,
    * - Are not photons or nuclear fragment, and
    * - Are not a light ion (Z < 4) if the \ref count_light_ions_ parameter is
        set to false
@@ -101,8 +102,7 @@ class PhotoNuclearDQM : public framework::Analyzer {
    *
    **/
   std::vector<const ldmx::SimParticle *> findDaughters(
-      const std::map<int, ldmx::SimParticle> &particleMap,
-      const ldmx::SimParticle *parent) const;
+      const ldmx::SimParticleIndex &particles, int parent) const;
 
   /**
    *
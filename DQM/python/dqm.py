@@ -403,6 +403,70 @@ class NtuplizeTrigScintQIEDigis(ldmxcfg.Analyzer) :
         self.input_name = input_name
         self.input_pass = input_pass
 
+class ColumnarWriterCollection :
+    """A collection written by the ColumnarWriter
+
+    Attributes
+    ----------
+    name : str
+        Name of the collection
+    type : str
+        Class of the entries of the collection without namespace, e.g. 'EcalHit'
+    fields : list[str]
+        Data members of the class to write, e.g. ['energy_', 'xpos_']
+    pass : str
+        Pass of the collection, empty for any pass
+    """
+
+    def __init__(self, name, type, fields, pass_name = '') :
+        self.name = name
+        self.type = type
+        self.fields = fields
+        setattr(self, 'pass', pass_name)
+
+class ColumnarWriter(ldmxcfg.Analyzer) :
+    """Write selected fields of collections to flat NumPy columns
+
+    Each field is written to <output_dir>/<collection>.<field>.npy with
+    the values of all of the entries of all of the events, the number of
+    entries in each event is in <output_dir>/<collection>.offsets.npy.
+    The event and run numbers are in event.npy and run.npy.
+
+    Attributes
+    ----------
+    output_dir : str
+        Directory to write the columns into, created if missing
+    batch_size : int
+        Number of values buffered per column before writing them
+    collections : list[ColumnarWriterCollection]
+        The collections to write
+
+    Examples
+    --------
+        from LDMX.DQM import dqm
+        columns = dqm.ColumnarWriter('ml_columns')
+        columns.add('EcalRecHits', 'EcalHit', ['energy_', 'xpos_', 'ypos_', 'zpos_'])
+        p.sequence.append(columns)
+
+    The columns are read back without a conversion pass with
+
+        import numpy as np, awkward as ak
+        offsets = np.load('ml_columns/EcalRecHits.offsets.npy')
+        energy = np.load('ml_columns/EcalRecHits.energy_.npy', mmap_mode='r')
+        energy = ak.unflatten(energy, np.diff(offsets))
+    """
+
+    def __init__(self, output_dir, name = 'columnar_writer') :
+        super().__init__(name,'dqm::ColumnarWriter','DQM')
+        self.output_dir = output_dir
+        self.batch_size = 65536
+        self.collections = []
+
+    def add(self, name, type, fields, pass_name = '') :
+        """Add a collection to write"""
+        self.collections.append(
+                ColumnarWriterCollection(name, type, fields, pass_name))
+
 class PhotoNuclearDQM(ldmxcfg.Analyzer) :
     """Configured PhotoNuclearDQM python object
     
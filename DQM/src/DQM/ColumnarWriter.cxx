@@ -0,0 +1,278 @@
+#include "DQM/ColumnarWriter.h"
+
+#include <filesystem>
+#include <map>
+
+#include "Ecal/Event/EcalCluster.h"
+#include "Ecal/Event/EcalHit.h"
+#include "Hcal/Event/HcalCluster.h"
+#include "Hcal/Event/HcalHit.h"
+#include "Recon/Event/CaloCluster.h"
+#include "Recon/Event/CalorimeterHit.h"
+#include "Recon/Event/PFCandidate.h"
+#include "SimCore/Event/SimTrackerHit.h"
+#include "TClass.h"
+#include "TDataMember.h"
+#include "TDataType.h"
+#include "TRealData.h"
+#include "TrigScint/Event/TrigScintCluster.h"
+#include "TrigScint/Event/TrigScintHit.h"
+#include "TrigScint/Event/TrigScintTrack.h"
+#include "Tracking/Event/Track.h"
+
+namespace dqm {
+
+namespace {
+
+/// A type of collection that can be written
+struct CollectionType {
+  /// ROOT class of the entries
+  TClass* cls;
+  /// size of an entry [bytes]
+  std::size_t stride;
+  /// get the entries of a collection, none if it isn't in the event
+  std::function<std::pair<const char*, std::size_t>(
+      const framework::Event&, const std::string&, const std::string&)>
+      get;
+};
+
+template <typename T>
+CollectionType collectionType() {
+  return {TClass::GetClass(typeid(T)), sizeof(T),
+          [](const framework::Event& event, const std::string& name,
+             const std::string& pass) -> std::pair<const char*, std::size_t> {
+            if (not event.exists(name, pass)) return {nullptr, 0};
+            const auto& entries{event.getCollection<T>(name, pass)};
+            return {reinterpret_cast<const char*>(entries.data()),
+                    entries.size()};
+          }};
+}
+
+/// The types of collections that can be written, by class name
+const std::map<std::string, CollectionType>& collectionTypes() {
+  static const std::map<std::string, CollectionType> types{
+      {"CaloCluster", collectionType<ldmx::CaloCluster>()},
+      {"CalorimeterHit", collectionType<ldmx::CalorimeterHit>()},
+      {"EcalCluster", collectionType<ldmx::EcalCluster>()},
+      {"EcalHit", collectionType<ldmx::EcalHit>()},
+      {"HcalCluster", collectionType<ldmx::HcalCluster>()},
+      {"HcalHit", collectionType<ldmx::HcalHit>()},
+      {"PFCandidate", collectionType<ldmx::PFCandidate>()},
+      {"SimTrackerHit", collectionType<ldmx::SimTrackerHit>()},
+      {"Track", collectionType<ldmx::Track>()},
+      {"TrigScintCluster", collectionType<ldmx::TrigScintCluster>()},
+      {"TrigScintHit", collectionType<ldmx::TrigScintHit>()},
+      {"TrigScintTrack", collectionType<ldmx::TrigScintTrack>()}};
+  return types;
+}
+
+/**
+ * Get the numpy type string of a basic ROOT type
+ *
+ * Values are written as they are in memory, which is little endian on all
+ * of the platforms we run on.
+ *
+ * @return type string, empty if the type isn't supported
+ */
+std::string numpyType(const TDataType* type) {
+  switch (type->GetType()) {
+    case kBool_t:
+      return "|b1";
+    case kChar_t:
+      return "|i1";
+    case kUChar_t:
+      return "|u1";
+    case kShort_t:
+      return "<i2";
+    case kUShort_t:
+      return "<u2";
+    case kInt_t:
+      return "<i4";
+    case kUInt_t:
+      return "<u4";
+    case kLong_t:
+    case kLong64_t:
+      return "<i" + std::to_string(type->Size());
+    case kULong_t:
+    case kULong64_t:
+      return "<u" + std::to_string(type->Size());
+    case kFloat_t:
+    case kFloat16_t:
+      return "<f4";
+    case kDouble_t:
+    case kDouble32_t:
+      return "<f8";
+    default:
+      return "";
+  }
+}
+
+}  // namespace
+
+ColumnarWriter::Column::Column(const std::string& path,
+                               const std::string& descr, std::size_t width,
+                               std::size_t batch)
+    : file_{path, std::ios::binary | std::ios::trunc},
+      path_{path},
+      descr_{descr},
+      width_{width},
+      batch_{batch} {
+  if (not file_.is_open()) {
+    EXCEPTION_RAISE("FileError",
+                    "Unable to open column file '" + path + "' for writing.");
+  }
+  writeHeader();
+  buffer_.reserve(batch_ * width_);
+}
+
+void ColumnarWriter::Column::append(const void* value) {
+  const char* bytes{static_cast<const char*>(value)};
+  buffer_.insert(buffer_.end(), bytes, bytes + width_);
+  rows_++;
+  if (buffer_.size() >= batch_ * width_) flush();
+}
+
+void ColumnarWriter::Column::flush() {
+  file_.write(buffer_.data(), buffer_.size());
+  buffer_.clear();
+  if (not file_) {
+    EXCEPTION_RAISE("FileError", "Unable to write to column file '" + path_ +
+                                     "'.");
+  }
+}
+
+void ColumnarWriter::Column::close() {
+  flush();
+  file_.seekp(0);
+  writeHeader();
+  file_.close();
+}
+
+void ColumnarWriter::Column::writeHeader() {
+  // the header has a fixed size so it can be rewritten with the final
+  // shape, 128 bytes is enough for any number of rows and keeps the data
+  // aligned for memory mapping
+  static const std::size_t header_size{128};
+  std::string dict{"{'descr': '" + descr_ +
+                   "', 'fortran_order': False, 'shape': (" +
+                   std::to_string(rows_) + ",), }"};
+  dict.resize(header_size - 11, ' ');
+  dict += '\n';
+  const std::uint16_t dict_size = dict.size();
+  file_.write("\x93NUMPY\x01\x00", 8);
+  const char dict_size_le[2] = {static_cast<char>(dict_size & 0xff),
+                                static_cast<char>(dict_size >> 8)};
+  file_.write(dict_size_le, 2);
+  file_ << dict;
+}
+
+void ColumnarWriter::configure(framework::config::Parameters& ps) {
+  output_dir_ = ps.getParameter<std::string>("output_dir");
+  batch_size_ = ps.getParameter<int>("batch_size", 65536);
+  if (batch_size_ < 1) {
+    EXCEPTION_RAISE("InvalidConfig", "The batch_size has to be positive.");
+  }
+
+  collections_.clear();
+  for (const auto& coll_ps :
+       ps.getParameter<std::vector<framework::config::Parameters>>(
+           "collections")) {
+    Collection coll;
+    coll.name = coll_ps.getParameter<std::string>("name");
+    coll.pass = coll_ps.getParameter<std::string>("pass", "");
+    auto type_name{coll_ps.getParameter<std::string>("type")};
+
+    auto type{collectionTypes().find(type_name)};
+    if (type == collectionTypes().end()) {
+      std::string known;
+      for (const auto& [name, _type] : collectionTypes()) known += " " + name;
+      EXCEPTION_RAISE("InvalidConfig", "Collection '" + coll.name +
+                                           "' has type '" + type_name +
+                                           "' which can't be written, the "
+                                           "types that can are:" +
+                                           known);
+    }
+    coll.stride = type->second.stride;
+    coll.get = [get = type->second.get, name = coll.name,
+                pass = coll.pass](const framework::Event& event) {
+      return get(event, name, pass);
+    };
+
+    TClass* cls{type->second.cls};
+    for (const auto& field_name :
+         coll_ps.getParameter<std::vector<std::string>>("fields")) {
+      TRealData* real{cls ? cls->GetRealData(field_name.c_str()) : nullptr};
+      TDataMember* member{real ? real->GetDataMember() : nullptr};
+      if (not member or not member->IsBasic() or member->IsaPointer() or
+          member->GetArrayDim() != 0 or
+          numpyType(member->GetDataType()).empty()) {
+        EXCEPTION_RAISE("InvalidConfig",
+                        "Field '" + field_name + "' of collection '" +
+                            coll.name + "' is not a data member of " +
+                            type_name + " with a basic type.");
+      }
+      Field field;
+      field.name = field_name;
+      field.offset = real->GetThisOffset();
+      field.descr = numpyType(member->GetDataType());
+      field.width = member->GetDataType()->Size();
+      coll.fields.push_back(std::move(field));
+    }
+    collections_.push_back(std::move(coll));
+  }
+}
+
+void ColumnarWriter::onProcessStart() {
+  std::filesystem::create_directories(output_dir_);
+  auto path = [&](const std::string& column) {
+    return (std::filesystem::path(output_dir_) / (column + ".npy")).string();
+  };
+
+  event_ = std::make_unique<Column>(path("event"), "<i4", 4, batch_size_);
+  run_ = std::make_unique<Column>(path("run"), "<i4", 4, batch_size_);
+  for (auto& coll : collections_) {
+    coll.n_entries = 0;
+    coll.offsets = std::make_unique<Column>(path(coll.name + ".offsets"),
+                                            "<i8", 8, batch_size_);
+    coll.offsets->append(&coll.n_entries);
+    for (auto& field : coll.fields) {
+      field.column =
+          std::make_unique<Column>(path(coll.name + "." + field.name),
+                                   field.descr, field.width, batch_size_);
+    }
+  }
+}
+
+void ColumnarWriter::analyze(const framework::Event& event) {
+  std::int32_t event_number{event.getEventNumber()};
+  std::int32_t run{event.getEventHeader().getRun()};
+  event_->append(&event_number);
+  run_->append(&run);
+
+  for (auto& coll : collections_) {
+    auto [first, size] = coll.get(event);
+    // fill one column at a time so each buffer stays in cache
+    for (auto& field : coll.fields) {
+      if (size == 0) break;
+      const char* value{first + field.offset};
+      for (std::size_t i{0}; i < size; i++, value += coll.stride) {
+        field.column->append(value);
+      }
+    }
+    coll.n_entries += size;
+    coll.offsets->append(&coll.n_entries);
+  }
+}
+
+void ColumnarWriter::onProcessEnd() {
+  event_->close();
+  run_->close();
+  for (auto& coll : collections_) {
+    coll.offsets->close();
+    for (auto& field : coll.fields) field.column->close();
+  }
+}
+
+}  // namespace dqm
+
+DECLARE_ANALYZER_NS(dqm, ColumnarWriter)
@@ -12,29 +12,46 @@ void EcalShowerFeatures::configure(framework::config::Parameters &ps) {
   return;
 }
 
+void EcalShowerFeatures::onProcessStart() {
+  deepest_layer_hit_ = histograms_.id("deepest_layer_hit");
+  num_readout_hits_ = histograms_.id("num_readout_hits");
+  summed_det_ = histograms_.id("summed_det");
+  summed_iso_ = histograms_.id("summed_iso");
+  summed_back_ = histograms_.id("summed_back");
+  max_cell_dep_ = histograms_.id("max_cell_dep");
+  shower_rms_ = histograms_.id("shower_rms");
+  x_std_ = histograms_.id("x_std");
+  y_std_ = histograms_.id("y_std");
+  avg_layer_hit_ = histograms_.id("avg_layer_hit");
+  std_layer_hit_ = histograms_.id("std_layer_hit");
+  e_containment_energy_ = histograms_.id("e_containment_energy");
+  ph_containment_energy_ = histograms_.id("ph_containment_energy");
+  out_containment_energy_ = histograms_.id("out_containment_energy");
+}
+
 void EcalShowerFeatures::analyze(const framework::Event &event) {
   auto veto{
       event.getObject<ldmx::EcalVetoResult>(ecal_veto_name_, ecal_veto_pass_)};
 
-  histograms_.fill("deepest_layer_hit", veto.getDeepestLayerHit());
-  histograms_.fill("num_readout_hits", veto.getNReadoutHits());
-  histograms_.fill("summed_det", veto.getSummedDet());
-  histograms_.fill("summed_iso", veto.getSummedTightIso());
-  histograms_.fill("summed_back", veto.getEcalBackEnergy());
-  histograms_.fill("max_cell_dep", veto.getMaxCellDep());
-  histograms_.fill("shower_rms", veto.getShowerRMS());
-  histograms_.fill("x_std", veto.getXStd());
-  histograms_.fill("y_std", veto.getYStd());
-  histograms_.fill("avg_layer_hit", veto.getAvgLayerHit());
-  histograms_.fill("std_layer_hit", veto.getStdLayerHit());
+  histograms_.fill(deepest_layer_hit_, veto.getDeepestLayerHit());
+  histograms_.fill(num_readout_hits_, veto.getNReadoutHits());
+  histograms_.fill(summed_det_, veto.getSummedDet());
+  histograms_.fill(summed_iso_, veto.getSummedTightIso());
+  histograms_.fill(summed_back_, veto.getEcalBackEnergy());
+  histograms_.fill(max_cell_dep_, veto.getMaxCellDep());
+  histograms_.fill(shower_rms_, veto.getShowerRMS());
+  histograms_.fill(x_std_, veto.getXStd());
+  histograms_.fill(y_std_, veto.getYStd());
+  histograms_.fill(avg_layer_hit_, veto.getAvgLayerHit());
+  histograms_.fill(std_layer_hit_, veto.getStdLayerHit());
   for (const auto &energy : veto.getElectronContainmentEnergy()) {
-    histograms_.fill("e_containment_energy", energy);
+    histograms_.fill(e_containment_energy_, energy);
   }
   for (const auto &energy : veto.getPhotonContainmentEnergy()) {
-    histograms_.fill("ph_containment_energy", energy);
+    histograms_.fill(ph_containment_energy_, energy);
   }
   for (const auto &energy : veto.getOutsideContainmentEnergy()) {
-    histograms_.fill("out_containment_energy", energy);
+    histograms_.fill(out_containment_energy_, energy);
   }
 
   return;
@@ -46,10 +46,9 @@ void HCalDQM::analyzeSimHits(const std::vector<ldmx::SimCalorimeterHit> &hits) {
     const auto orientation{geometry.getScintillatorOrientation(id)};
     const auto layer{id.layer()};
     const auto strip{id.strip()};
-    const auto pos{hit.getPosition()};
-    const auto x{pos[0]};
-    const auto y{pos[1]};
-    const auto z{pos[2]};
+    const auto x{hit.getX()};
+    const auto y{hit.getY()};
+    const auto z{hit.getZ()};
     const auto t{hit.getTime()};
     hitMultiplicity++;
     histograms_.fill("sim_hit_time", t);
@@ -70,8 +70,9 @@ bool HcalGeometryVerifier::hit_ok(const ldmx::HcalID id,
   const auto &geometry = getCondition<ldmx::HcalGeometry>(
       ldmx::HcalGeometry::CONDITIONS_OBJECT_NAME);
   auto [index_along, index_across, index_through]{determine_indices(id)};
-  const auto center{geometry.getStripCenterPosition(id)};
-  const auto length{geometry.getScintillatorLength(id)};
+  const auto &strip{geometry.getStrip(id)};
+  const auto &center{strip.center};
+  const auto length{strip.length};
   bool outside_bounds_along{
       std::abs(position[index_along] - center[index_along]) >
       length / 2 + tolerance};
@@ -94,11 +94,12 @@ void NtuplizeHgcrocDigiCollection::analyze(const framework::Event& event) {
 
   auto const& digis{
       event.getObject<ldmx::HgcrocDigiCollection>(input_name_, input_pass_)};
+  auto const& decoded{digis.decoded()};
   for (std::size_t i_digi{0}; i_digi < digis.size(); i_digi++) {
-    auto d{digis.getDigi(i_digi)};
-    raw_id_ = static_cast<int>(d.id());
+    unsigned int id{digis.getDigiID(i_digi)};
+    raw_id_ = static_cast<int>(id);
     if (using_eid_) {
-      ldmx::HcalElectronicsID eid(d.id());
+      ldmx::HcalElectronicsID eid(id);
       ldmx::HcalDigiID detid = detmap.get(eid);
       fpga_ = eid.fiber();
       link_ = eid.elink();
@@ -106,7 +107,7 @@ void NtuplizeHgcrocDigiCollection::analyze(const framework::Event& event) {
       channel_ = eid.channel();
       index_ = eid.index();
     } else {
-      ldmx::HcalDigiID detid(d.id());
+      ldmx::HcalDigiID detid(id);
       ldmx::HcalElectronicsID eid = detmap.get(detid);
       int link = eid.elink();
       good_link_ = (good_bxheader.at(link) and good_trailer.at(link));
@@ -116,14 +117,16 @@ void NtuplizeHgcrocDigiCollection::analyze(const framework::Event& event) {
       end_ = detid.end();
     }
 
+    int pedestal = pedestal_table.get(id, 0);
     for (i_sample_ = 0; i_sample_ < digis.getNumSamplesPerDigi(); i_sample_++) {
-      tot_prog_ = d.at(i_sample_).isTOTinProgress();
-      tot_comp_ = d.at(i_sample_).isTOTComplete();
-      tot_ = d.at(i_sample_).tot();
-      toa_ = d.at(i_sample_).toa();
-      int adc_t = d.at(i_sample_).adc_t();
+      std::size_t i{decoded.index(i_digi, i_sample_)};
+      tot_prog_ = decoded.tot_progress[i];
+      tot_comp_ = decoded.tot_complete[i];
+      tot_ = decoded.tot[i];
+      toa_ = decoded.toa[i];
+      int adc_t = decoded.adc_t[i];
       raw_adc_ = adc_t;
-      adc_ = adc_t - pedestal_table.get(d.id(), 0);
+      adc_ = adc_t - pedestal;
       flat_tree_->Fill();
     }
   }
@@ -28,16 +28,11 @@ PhotoNuclearDQM::PhotoNuclearDQM(const std::string &name,
 
 PhotoNuclearDQM::~PhotoNuclearDQM() {}
 std::vector<const ldmx::SimParticle *> PhotoNuclearDQM::findDaughters(
-    const std::map<int, ldmx::SimParticle> &particleMap,
-    const ldmx::SimParticle *parent) const {
+    const ldmx::SimParticleIndex &particles, int parent) const {
   std::vector<const ldmx::SimParticle *> pnDaughters;
-  for (const auto &daughterTrackID : parent->getDaughters()) {
-    // skip daughters that weren't saved
-    if (particleMap.count(daughterTrackID) == 0) {
-      continue;
-    }
-
-    auto daughter{&(particleMap.at(daughterTrackID))};
+  // only the daughters that were saved are in the index
+  for (int daughterSlot : particles.daughters(parent)) {
+    auto daughter{&particles.particle(daughterSlot)};
 
     // Get the PDG ID
     auto pdgID{daughter->getPdgID()};
@@ -252,28 +247,32 @@ void PhotoNuclearDQM::configure(framework::config::Parameters &parameters) {
 }
 
 void PhotoNuclearDQM::analyze(const framework::Event &event) {
-  // Get the particle map from the event.  If the particle map is empty,
+  // Get the particle index of the event.  If there are no particles,
   // don't process the event.
-  auto particleMap{event.getMap<int, ldmx::SimParticle>("SimParticles")};
-  if (particleMap.size() == 0) {
+  const auto &particles{ldmx::SimParticleIndex::get(event)};
+  if (particles.size() == 0) {
     return;
   }
 
   // Get the recoil electron
-  auto [trackID, recoil] = Analysis::getRecoil(particleMap);
+  auto [recoilSlot, recoil] = Analysis::getRecoil(particles);
+  if (recoil == nullptr) {
+    EXCEPTION_RAISE("BadEvent", "Unable to find the recoil electron.");
+  }
   findRecoilProperties(recoil);
 
   // Use the recoil electron to retrieve the gamma that underwent a
   // photo-nuclear reaction.
-  auto pnGamma{Analysis::getPNGamma(particleMap, recoil, 2500.)};
-  if (pnGamma == nullptr) {
+  auto pnGammaSlot{Analysis::getPNGamma(particles, recoilSlot, 2500.)};
+  if (pnGammaSlot == ldmx::SimParticleIndex::NOT_FOUND) {
     if (verbose_) {
       std::cout << "[ PhotoNuclearDQM ]: PN Daughter is lost, skipping."
                 << std::endl;
     }
     return;
   }
-  const auto pnDaughters{findDaughters(particleMap, pnGamma)};
+  auto pnGamma{&particles.particle(pnGammaSlot)};
+  const auto pnDaughters{findDaughters(particles, pnGammaSlot)};
   findParticleKinematics(pnDaughters);
 
   histograms_.fill("pn_particle_mult", pnGamma->getDaughters().size());
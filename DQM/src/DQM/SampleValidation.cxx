@@ -7,78 +7,63 @@
 #include "Framework/NtupleManager.h"
 #include "SimCore/Event/SimParticle.h"
 #include "SimCore/Event/SimTrackerHit.h"
+#include "Tools/SimParticleIndex.h"
 
 namespace dqm {
 
 void SampleValidation::configure(framework::config::Parameters& ps) { return; }
 
 void SampleValidation::analyze(const framework::Event& event) {
-  // Grab the SimParticle Map and Target Scoring Plane Hits
+  // Grab the SimParticles and Target Scoring Plane Hits
   auto targetSPHits(
       event.getCollection<ldmx::SimTrackerHit>("TargetScoringPlaneHits"));
-  auto particle_map{event.getMap<int, ldmx::SimParticle>("SimParticles")};
+  const auto& particles{ldmx::SimParticleIndex::get(event)};
 
-  std::vector<int> primary_daughters;
+  int primary{ldmx::SimParticleIndex::NOT_FOUND};
 
   double hard_thresh;
 
-  // Loop over all SimParticles
-  for (auto const& it : particle_map) {
-    ldmx::SimParticle p = it.second;
-    int pdgid = p.getPdgID();
+  // Loop over the primary SimParticles
+  for (int i : particles.primaries()) {
+    const ldmx::SimParticle& p{particles.particle(i)};
     std::vector<double> vertex = p.getVertex();
     double energy = p.getEnergy();
-    std::vector<int> parents_track_ids = p.getParents();
-    std::vector<int> daughters = p.getDaughters();
-
-    for (auto const& parent_track_id : parents_track_ids) {
-      if (parent_track_id == 0) {
-        histograms_.fill("pdgid_primaries", pdgid_label(pdgid));
-        histograms_.fill("energy_primaries", energy);
-        hard_thresh = (2500. / 4000.) * energy;
-        primary_daughters = daughters;
-        for (const ldmx::SimTrackerHit& sphit : targetSPHits) {
-          if (sphit.getTrackID() == it.first && sphit.getPosition()[2] < 0) {
-            histograms_.fill("beam_smear", vertex[0], vertex[1]);
-          }
-        }
+    histograms_.fill("pdgid_primaries", pdgid_label(p.getPdgID()));
+    histograms_.fill("energy_primaries", energy);
+    hard_thresh = (2500. / 4000.) * energy;
+    primary = i;
+    for (const ldmx::SimTrackerHit& sphit : targetSPHits) {
+      if (sphit.getTrackID() == particles.trackID(i) &&
+          sphit.getPosition()[2] < 0) {
+        histograms_.fill("beam_smear", vertex[0], vertex[1]);
       }
     }
   }
 
-  std::vector<std::vector<int>> hardbrem_daughters;
-
-  for (auto const& it : particle_map) {
-    int trackid = it.first;
-    ldmx::SimParticle p = it.second;
-    for (auto const& primary_daughter : primary_daughters) {
-      if (trackid == primary_daughter) {
-        histograms_.fill("pdgid_primarydaughters", pdgid_label(p.getPdgID()));
-        if (p.getPdgID() == 22) {
-          histograms_.fill("energy_daughterphoton", p.getEnergy());
-        }
-        if (p.getEnergy() >= hard_thresh) {
-          histograms_.fill("pdgid_harddaughters", pdgid_label(p.getPdgID()));
-          histograms_.fill("startZ_hardbrem", p.getVertex()[2]);
-          histograms_.fill("endZ_hardbrem", p.getEndPoint()[2]);
-          histograms_.fill("energy_hardbrem", p.getEnergy());
-          hardbrem_daughters.push_back(p.getDaughters());
-        }
+  std::vector<int> hardbrems;
+
+  if (primary != ldmx::SimParticleIndex::NOT_FOUND) {
+    for (int i : particles.daughters(primary)) {
+      const ldmx::SimParticle& p{particles.particle(i)};
+      histograms_.fill("pdgid_primarydaughters", pdgid_label(p.getPdgID()));
+      if (p.getPdgID() == 22) {
+        histograms_.fill("energy_daughterphoton", p.getEnergy());
+      }
+      if (p.getEnergy() >= hard_thresh) {
+        histograms_.fill("pdgid_harddaughters", pdgid_label(p.getPdgID()));
+        histograms_.fill("startZ_hardbrem", p.getVertex()[2]);
+        histograms_.fill("endZ_hardbrem", p.getEndPoint()[2]);
+        histograms_.fill("energy_hardbrem", p.getEnergy());
+        hardbrems.push_back(i);
       }
     }
   }
 
-  for (auto const& it : particle_map) {
-    int trackid = it.first;
-    ldmx::SimParticle p = it.second;
-    for (const std::vector<int>& daughter_track_id : hardbrem_daughters) {
-      for (const int& daughter_id : daughter_track_id) {
-        if (trackid == daughter_id) {
-          histograms_.fill("pdgid_hardbremdaughters",
-                           pdgid_label(p.getPdgID()));
-          histograms_.fill("startZ_hardbremdaughters", p.getVertex()[2]);
-        }
-      }
+  for (int hardbrem : hardbrems) {
+    for (int i : particles.daughters(hardbrem)) {
+      const ldmx::SimParticle& p{particles.particle(i)};
+      histograms_.fill("pdgid_hardbremdaughters", pdgid_label(p.getPdgID()));
+      histograms_.fill("startZ_hardbremdaughters", p.getVertex()[2]);
     }
   }
 
@@ -150,17 +150,15 @@ void SimObjects::analyze(const framework::Event& event) {
   auto const& particle_map{
       event.getMap<int, ldmx::SimParticle>("SimParticles")};
   for (auto const& [track_id, particle] : particle_map) {
-    auto const& momentum{particle.getMomentum()};
-    auto const& vertex{particle.getVertex()};
     histograms_.fill("SimParticles.E", particle.getEnergy());
-    histograms_.fill("SimParticles.px", momentum.at(0));
-    histograms_.fill("SimParticles.py", momentum.at(1));
-    histograms_.fill("SimParticles.pz", momentum.at(2));
+    histograms_.fill("SimParticles.px", particle.getPx());
+    histograms_.fill("SimParticles.py", particle.getPy());
+    histograms_.fill("SimParticles.pz", particle.getPz());
     histograms_.fill("SimParticles.time", particle.getTime());
     histograms_.fill("SimParticles.pdg", particle.getPdgID());
-    histograms_.fill("SimParticles.x", vertex.at(0));
-    histograms_.fill("SimParticles.y", vertex.at(1));
-    histograms_.fill("SimParticles.z", vertex.at(2));
+    histograms_.fill("SimParticles.x", particle.getVertexX());
+    histograms_.fill("SimParticles.y", particle.getVertexY());
+    histograms_.fill("SimParticles.z", particle.getVertexZ());
     histograms_.fill("SimParticles.process", particle.getProcessType());
     histograms_.fill("SimParticles.track_id", track_id);
     for (auto const& parent : particle.getParents())
@@ -172,14 +170,14 @@ void SimObjects::analyze(const framework::Event& event) {
     if (particle.getProcessType() ==
         ldmx::SimParticle::ProcessType::photonNuclear) {
       histograms_.fill("pn_child.E", particle.getEnergy());
-      histograms_.fill("pn_child.px", momentum.at(0));
-      histograms_.fill("pn_child.py", momentum.at(1));
-      histograms_.fill("pn_child.pz", momentum.at(2));
+      histograms_.fill("pn_child.px", particle.getPx());
+      histograms_.fill("pn_child.py", particle.getPy());
+      histograms_.fill("pn_child.pz", particle.getPz());
       histograms_.fill("pn_child.time", particle.getTime());
       histograms_.fill("pn_child.pdg", particle.getPdgID());
-      histograms_.fill("pn_child.x", vertex.at(0));
-      histograms_.fill("pn_child.y", vertex.at(1));
-      histograms_.fill("pn_child.z", vertex.at(2));
+      histograms_.fill("pn_child.x", particle.getVertexX());
+      histograms_.fill("pn_child.y", particle.getVertexY());
+      histograms_.fill("pn_child.z", particle.getVertexZ());
       histograms_.fill("pn_child.track_id", track_id);
       for (auto const& parent : particle.getParents())
         histograms_.fill("pn_child.parent", parent);
@@ -202,10 +200,9 @@ void SimObjects::analyze(const framework::Event& event) {
       }
 
       histograms_.fill(pt.name() + ".edep", hit.getEdep());
-      auto pos{hit.getPosition()};
-      histograms_.fill(pt.name() + ".x", pos.at(0));
-      histograms_.fill(pt.name() + ".y", pos.at(1));
-      histograms_.fill(pt.name() + ".z", pos.at(2));
+      histograms_.fill(pt.name() + ".x", hit.getX());
+      histograms_.fill(pt.name() + ".y", hit.getY());
+      histograms_.fill(pt.name() + ".z", hit.getZ());
       histograms_.fill(pt.name() + ".time", hit.getTime());
     }  // loop over hits in the calorimeter collection
   }    // loop over different calorimeter hit collections
@@ -215,16 +212,14 @@ void SimObjects::analyze(const framework::Event& event) {
         event.getCollection<ldmx::SimTrackerHit>(pt.name(), sim_pass_)};
     for (auto const& hit : coll) {
       histograms_.fill(pt.name() + ".particle_E", hit.getEnergy());
-      auto momentum{hit.getMomentum()};
-      histograms_.fill(pt.name() + ".particle_px", momentum.at(0));
-      histograms_.fill(pt.name() + ".particle_py", momentum.at(1));
-      histograms_.fill(pt.name() + ".particle_pz", momentum.at(2));
+      histograms_.fill(pt.name() + ".particle_px", hit.getPx());
+      histograms_.fill(pt.name() + ".particle_py", hit.getPy());
+      histograms_.fill(pt.name() + ".particle_pz", hit.getPz());
       histograms_.fill(pt.name() + ".edep", hit.getEdep());
       histograms_.fill(pt.name() + ".time", hit.getTime());
-      auto pos{hit.getPosition()};
-      histograms_.fill(pt.name() + ".x", pos.at(0));
-      histograms_.fill(pt.name() + ".y", pos.at(1));
-      histograms_.fill(pt.name() + ".z", pos.at(2));
+      histograms_.fill(pt.name() + ".x", hit.getX());
+      histograms_.fill(pt.name() + ".y", hit.getY());
+      histograms_.fill(pt.name() + ".z", hit.getZ());
       histograms_.fill(pt.name() + ".track", hit.getTrackID());
       histograms_.fill(pt.name() + ".pdg", hit.getPdgID());
     }  // loop over hits in the tracker collection
@@ -0,0 +1,134 @@
+/**
+ * @file EcalGeometryBench.cxx
+ * @brief Benchmark the cell lookups of the EcalGeometry
+ */
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "DetDescr/EcalGeometry.h"
+#include "Framework/Configure/Parameters.h"
+#include "Framework/Exception/Exception.h"
+
+namespace ldmx {
+namespace bench {
+
+/// Make the EcalGeometry of the v14 detector
+static std::unique_ptr<EcalGeometry> makeGeometry() {
+  framework::config::Parameters params;
+  params.addParameter(
+      "layerZPositions",
+      std::vector<double>{
+          7.932,   14.532,  32.146,  40.746,  58.110,  67.710,  86.574,
+          96.774,  115.638, 125.838, 144.702, 154.902, 173.766, 183.966,
+          202.830, 213.030, 231.894, 242.094, 260.958, 271.158, 290.022,
+          300.222, 319.086, 329.286, 351.650, 365.250, 387.614, 401.214,
+          423.578, 437.178, 459.542, 473.142, 495.506, 509.106});
+  params.addParameter("ecalFrontZ", 240.);
+  params.addParameter("moduleMinR", 85.0);
+  params.addParameter("nCellRHeight", 35.3);
+  params.addParameter("gap", 1.5);
+  params.addParameter("cornersSideUp", true);
+  params.addParameter("layer_shift_x", 2 * 85.0 / 35.3);
+  params.addParameter("layer_shift_y", 0.);
+  params.addParameter("layer_shift_odd", true);
+  params.addParameter("layer_shift_odd_bilayer", false);
+  params.addParameter("verbose", 0);
+  return std::unique_ptr<EcalGeometry>(EcalGeometry::debugMake(params));
+}
+
+/**
+ * The IDs of the cells hit in a few events
+ *
+ * They are drawn from a fixed seed, so every run and every build
+ * looks up the same cells.
+ */
+static std::vector<EcalID> recordedCells(const EcalGeometry& geometry) {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> layer(0, geometry.getNumLayers() - 1),
+      module(0, geometry.getNumModulesPerLayer() - 1),
+      cell(0, geometry.getNumCellsPerModule() - 1);
+  std::vector<EcalID> cells;
+  for (int i{0}; i < 10000; i++)
+    cells.emplace_back(layer(rng), module(rng), cell(rng));
+  return cells;
+}
+
+/**
+ * The positions of the hits in those cells
+ *
+ * The hits are spread around the cell centers, staying within the cells.
+ */
+static std::vector<std::tuple<double, double, double>> recordedPositions(
+    const EcalGeometry& geometry, const std::vector<EcalID>& cells) {
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<double> jitter(-0.5, 0.5);
+  std::vector<std::tuple<double, double, double>> positions;
+  for (const auto& id : cells) {
+    auto [x, y, z] = geometry.getPosition(id);
+    double dx{jitter(rng)}, dy{jitter(rng)};
+    try {
+      // cells at the module edges can be smaller than the spread
+      if (geometry.getID(x + dx, y + dy, id.layer()) != id) dx = dy = 0.;
+    } catch (const framework::exception::Exception&) {
+      dx = dy = 0.;
+    }
+    positions.emplace_back(x + dx, y + dy, z);
+  }
+  return positions;
+}
+
+}  // namespace bench
+}  // namespace ldmx
+
+/// Find the cells of the recorded hit positions
+static void BM_EcalGeometry_getID(benchmark::State& state) {
+  using namespace ldmx;
+  auto geometry{bench::makeGeometry()};
+  const auto cells{bench::recordedCells(*geometry)};
+  const auto positions{bench::recordedPositions(*geometry, cells)};
+  for (auto _ : state) {
+    for (const auto& [x, y, z] : positions)
+      benchmark::DoNotOptimize(geometry->getID(x, y, z));
+  }
+  state.SetItemsProcessed(state.iterations() * positions.size());
+}
+BENCHMARK(BM_EcalGeometry_getID);
+
+/// Find the cells of the recorded hit positions, knowing their layers
+static void BM_EcalGeometry_getID_layer(benchmark::State& state) {
+  using namespace ldmx;
+  auto geometry{bench::makeGeometry()};
+  const auto cells{bench::recordedCells(*geometry)};
+  const auto positions{bench::recordedPositions(*geometry, cells)};
+  for (auto _ : state) {
+    for (std::size_t i{0}; i < positions.size(); i++) {
+      const auto& [x, y, z] = positions[i];
+      benchmark::DoNotOptimize(geometry->getID(x, y, cells[i].layer()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * positions.size());
+}
+BENCHMARK(BM_EcalGeometry_getID_layer);
+
+/// Go through the nearest neighbors of the recorded cells
+static void BM_EcalGeometry_getNN(benchmark::State& state) {
+  using namespace ldmx;
+  auto geometry{bench::makeGeometry()};
+  const auto cells{bench::recordedCells(*geometry)};
+  for (auto _ : state) {
+    int n_neighbors{0};
+    for (const auto& id : cells) {
+      for (EcalID neighbor : geometry->getNN(id)) {
+        benchmark::DoNotOptimize(neighbor);
+        n_neighbors++;
+      }
+    }
+    benchmark::DoNotOptimize(n_neighbors);
+  }
+  state.SetItemsProcessed(state.iterations() * cells.size());
+}
+BENCHMARK(BM_EcalGeometry_getNN);
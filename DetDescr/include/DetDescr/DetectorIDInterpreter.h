@@ -148,11 +148,6 @@ class DetectorIDInterpreter {
    */
   FieldValueList fieldValues_;
 
-  struct SubdetectorIDFields {
-    IDField::IDFieldMap fieldMap_;
-    IDField::IDFieldList fieldList_;
-  };
-
   struct IDSignature {
     unsigned int mask_;
     unsigned int comparison_;
@@ -161,6 +156,31 @@ class DetectorIDInterpreter {
     }
   };
 
+  /// where a field is, copied out of its IDField when registered
+  struct FieldDecoder {
+    /// index of the field value
+    unsigned index_;
+    /// start bit of the field
+    unsigned shift_;
+    /// bit mask of the field
+    unsigned mask_;
+  };
+
+  struct SubdetectorIDFields {
+    IDField::IDFieldMap fieldMap_;
+    IDField::IDFieldList fieldList_;
+    /// the IDs these fields are for
+    IDSignature signature_;
+    /// decoders of the fields, in the order of fieldList_
+    std::vector<FieldDecoder> decoders_;
+  };
+
+  /**
+   * Create the fields of a signature and add them to the rosetta stone
+   */
+  static void registerFields(const IDSignature& sig,
+                             const IDField::IDFieldList& fieldList);
+
   static std::map<IDSignature, const SubdetectorIDFields*> g_rosettaStone;
 
   /**
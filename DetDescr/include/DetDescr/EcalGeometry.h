@@ -21,7 +21,11 @@
 #include "Framework/Exception/Exception.h"
 
 // STL
+#include <array>
+#include <cstddef>
+#include <iterator>
 #include <map>
+#include <vector>
 
 // ROOT
 #include "TH2Poly.h"
@@ -101,6 +105,9 @@ class EcalGeometry : public framework::ConditionsObject {
  public:
   static constexpr const char* CONDITIONS_OBJECT_NAME{"EcalGeometry"};
 
+  /// number of modules in each layer, see getNumModulesPerLayer
+  static constexpr int MODULES_PER_LAYER{7};
+
   /**
    * Class destructor.
    *
@@ -157,7 +164,10 @@ class EcalGeometry : public framework::ConditionsObject {
    * auto [x,y,z] = geometry.getPosition(id);
    * ```
    */
-  std::tuple<double, double, double> getPosition(EcalID id) const;
+  std::tuple<double, double, double> getPosition(EcalID id) const {
+    std::size_t i{getCellIndex(id)};
+    return std::make_tuple(cell_x_[i], cell_y_[i], cell_z_[i]);
+  }
 
   /**
    * Get a cell's position within a module
@@ -193,7 +203,7 @@ class EcalGeometry : public framework::ConditionsObject {
    *
    * @returns number of modules
    */
-  int getNumModulesPerLayer() const { return 7; }
+  int getNumModulesPerLayer() const { return MODULES_PER_LAYER; }
 
   /**
    * Get the number of cells in each module of the Ecal Geometry
@@ -205,17 +215,136 @@ class EcalGeometry : public framework::ConditionsObject {
     return cell_id_in_module_.GetNumberOfBins();
   }
 
+  /**
+   * Get the total number of cells in the Ecal Geometry
+   *
+   * @returns number of layers * modules per layer * cells per module
+   */
+  std::size_t getNumCells() const { return cell_x_.size(); }
+
+  /**
+   * Index of a cell within a layer, counting from zero
+   *
+   * @throws Exception if the module or cell is not in the geometry
+   * @param[in] id cell, the layer is ignored
+   * @return module * (cells per module) + cell
+   */
+  std::size_t getCellInLayerIndex(EcalID id) const {
+    if (std::size_t(id.module()) >= n_modules_ or
+        std::size_t(id.cell()) >= n_cells_) {
+      EXCEPTION_RAISE("BadID", "Module " + std::to_string(id.module()) +
+                                   " cell " + std::to_string(id.cell()) +
+                                   " is not in the ECal geometry.");
+    }
+    return std::size_t(id.module()) * n_cells_ + id.cell();
+  }
+
+  /**
+   * Index of a cell in the whole ECal, counting from zero
+   *
+   * This is the index of the cell in the dense tables and can be used
+   * for arrays over all of the cells (see getNumCells).
+   *
+   * @throws Exception if the cell is not in the geometry
+   * @param[in] id cell to look up
+   * @return layer * (cells per layer) + index of cell within layer
+   */
+  std::size_t getCellIndex(EcalID id) const {
+    if (std::size_t(id.layer()) >= n_layers_) {
+      EXCEPTION_RAISE("BadID", "Layer " + std::to_string(id.layer()) +
+                                   " is not in the ECal geometry.");
+    }
+    return std::size_t(id.layer()) * n_modules_ * n_cells_ +
+           getCellInLayerIndex(id);
+  }
+
+  /**
+   * View of the neighbors of a cell in one of the neighbor tables
+   *
+   * The tables only hold the module and cell of the neighbors since they
+   * are the same in every layer, so the iterator puts each neighbor into
+   * the layer of the cell we asked about as it goes. Nothing is allocated
+   * or copied, so this can be used in the loops over the hits.
+   * ```cpp
+   * for (ldmx::EcalID neighbor : geometry.getNN(id)) { ... }
+   * ```
+   */
+  class Neighbors {
+   public:
+    /// iterator over the neighbors, dereferencing to an EcalID value
+    class iterator {
+     public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = EcalID;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const EcalID*;
+      using reference = EcalID;
+
+      iterator(const EcalID* flat, int layer) : flat_{flat}, layer_{layer} {}
+      EcalID operator*() const {
+        return EcalID(layer_, flat_->module(), flat_->cell());
+      }
+      iterator& operator++() {
+        ++flat_;
+        return *this;
+      }
+      bool operator==(const iterator& other) const {
+        return flat_ == other.flat_;
+      }
+      bool operator!=(const iterator& other) const {
+        return flat_ != other.flat_;
+      }
+
+     private:
+      /// current entry in the table (layer set to zero)
+      const EcalID* flat_;
+      /// layer to put the neighbors in
+      int layer_;
+    };
+
+    Neighbors(const EcalID* flat, std::size_t size, int layer)
+        : flat_{flat}, size_{size}, layer_{layer} {}
+    iterator begin() const { return iterator(flat_, layer_); }
+    iterator end() const { return iterator(flat_ + size_, layer_); }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    EcalID operator[](std::size_t i) const {
+      return EcalID(layer_, flat_[i].module(), flat_[i].cell());
+    }
+
+    /**
+     * Check if the probe is one of the neighbors
+     *
+     * @param[in] probe id to look for
+     * @return true if the probe is in the same layer and one of the neighbors
+     */
+    bool contains(EcalID probe) const {
+      if (probe.layer() != layer_) return false;
+      EcalID flat_probe(0, probe.module(), probe.cell());
+      for (std::size_t i{0}; i < size_; i++) {
+        if (flat_[i] == flat_probe) return true;
+      }
+      return false;
+    }
+
+   private:
+    /// first neighbor in the table
+    const EcalID* flat_;
+    /// number of neighbors
+    std::size_t size_;
+    /// layer of the cell whose neighbors these are
+    int layer_;
+  };
+
   /**
    * Get the Nearest Neighbors of the input ID
    *
    * @param id id to get
-   * @return list of EcalID that are the inputs nearest neighbors
+   * @return view of the EcalIDs that are the inputs nearest neighbors
    */
-  std::vector<EcalID> getNN(EcalID id) const {
-    auto list = NNMap_.at(EcalID(0, id.module(), id.cell()));
-    for (auto& flat : list)
-      flat = EcalID(id.layer(), flat.module(), flat.cell());
-    return list;
+  Neighbors getNN(EcalID id) const {
+    std::size_t i{getCellInLayerIndex(id)};
+    return Neighbors(&nn_table_[i * nn_width_], nn_size_[i], id.layer());
   }
 
   /**
@@ -226,23 +355,18 @@ class EcalGeometry : public framework::ConditionsObject {
    * @return true if probe ID is a nearest neighbor of the centroid
    */
   bool isNN(EcalID centroid, EcalID probe) const {
-    for (auto& id : getNN(centroid)) {
-      if (id == probe) return true;
-    }
-    return false;
+    return getNN(centroid).contains(probe);
   }
 
   /**
    * Get the Next-to-Nearest Neighbors of the input ID
    *
    * @param id id to get
-   * @return list of EcalID that are the inputs next-to-nearest neighbors
+   * @return view of the EcalIDs that are the inputs next-to-nearest neighbors
    */
-  std::vector<EcalID> getNNN(EcalID id) const {
-    auto list = NNNMap_.at(EcalID(0, id.module(), id.cell()));
-    for (auto& flat : list)
-      flat = EcalID(id.layer(), flat.module(), flat.cell());
-    return list;
+  Neighbors getNNN(EcalID id) const {
+    std::size_t i{getCellInLayerIndex(id)};
+    return Neighbors(&nnn_table_[i * nnn_width_], nnn_size_[i], id.layer());
   }
 
   /**
@@ -254,10 +378,7 @@ class EcalGeometry : public framework::ConditionsObject {
    * @return true if probe ID is a next-to-nearest neighbor of the centroid
    */
   bool isNNN(EcalID centroid, EcalID probe) const {
-    for (auto& id : getNNN(centroid)) {
-      if (id == probe) return true;
-    }
-    return false;
+    return getNNN(centroid).contains(probe);
   }
 
   /**
@@ -364,6 +485,9 @@ class EcalGeometry : public framework::ConditionsObject {
    * a small space un-covered by the tiling, so the vertices adjacent to the
    * external vertex are projected onto the module edge.
    *
+   * The cells that are full hexagons of the honeycomb are also put in
+   * cell_in_grid_ so cellInModule can find them without the polygons.
+   *
    * @param[in] cellr_ the center-to-flat cell radius
    * @param[in] cellR_ the center-to-corner cell radius
    * @param[in] moduler_ the center-to-flat module radius
@@ -403,10 +527,10 @@ class EcalGeometry : public framework::ConditionsObject {
    *
    * @param[in] cellModulePostionMap_ map of cells to cell centers relative to
    * ecal
-   * @param[out] NNMap_ map of cell IDs to list of cell IDs that are its nearest
-   * neighbors
-   * @param[out] NNNMap_ map of cell IDs to list of cell IDs that are its
-   * next-to-nearest neighbors
+   * @param[out] nn_table_ table of cell IDs that are the nearest neighbors
+   * of each cell
+   * @param[out] nnn_table_ table of cell IDs that are the next-to-nearest
+   * neighbors of each cell
    */
   void buildNeighborMaps();
 
@@ -449,6 +573,36 @@ class EcalGeometry : public framework::ConditionsObject {
    */
   bool isInside(double normX, double normY) const;
 
+  /**
+   * Get the module a point is in
+   *
+   * The point is rounded to the nearest module center on the hexagonal
+   * lattice of the centers and then checked to be inside that module.
+   *
+   * @param[in] p x-coordinate relative to the center of the layer [mm]
+   * @param[in] q y-coordinate relative to the center of the layer [mm]
+   * @return module ID or -1 if the point is not inside a module
+   */
+  int moduleInLayer(double p, double q) const;
+
+  /**
+   * Get the cell a point is in
+   *
+   * The point is rounded to the hexagon of the honeycomb built in
+   * buildCellMap containing it. If that hexagon is a full cell, this is its
+   * ID. Otherwise the point is on the edge of the module where the cells
+   * are clipped or stretched and the cell is found from the polygons in
+   * cell_id_in_module_.
+   *
+   * @note This function is in p,q space so any rotations need to be performed
+   * before calling this function.
+   *
+   * @param[in] p p-coordinate relative to the center of the module [mm]
+   * @param[in] q q-coordinate relative to the center of the module [mm]
+   * @return cell ID or a negative number if the point is outside the module
+   */
+  int cellInModule(double p, double q) const;
+
  private:
   /// Gap between module flat sides [mm]
   double gap_;
@@ -538,6 +692,17 @@ class EcalGeometry : public framework::ConditionsObject {
    */
   std::map<int, std::pair<double, double>> module_pos_xy_;
 
+  /// Center-to-corner radius of the hexagons of the lattice of module centers
+  double module_lattice_R_{0};
+
+  /**
+   * Module IDs on the lattice of module centers
+   *
+   * Indexed by 3 * (a + 1) + (b + 1) with (a,b) the axial coordinates of the
+   * module center on the lattice, -1 where there is no module.
+   */
+  std::array<int, 9> module_in_lattice_;
+
   /**
    * Position of cell centers relative to center of module in
    * p,q space.
@@ -546,6 +711,20 @@ class EcalGeometry : public framework::ConditionsObject {
    */
   std::map<int, std::pair<double, double>> cell_pos_in_module_;
 
+  /// Center of the first hexagon of the honeycomb in p,q space [mm]
+  double cell_grid_p_{0}, cell_grid_q_{0};
+
+  /// Number of rows and of hexagons in the even rows of the honeycomb
+  int cell_grid_rows_{0}, cell_grid_cols_{0};
+
+  /**
+   * Cell IDs of the hexagons of the honeycomb
+   *
+   * Indexed by row * cell_grid_cols_ + column, -1 for the hexagons that are
+   * not full cells inside the module.
+   */
+  std::vector<int> cell_in_grid_;
+
   /**
    * Position of cell centers relative to center of layer in world
    * coordinates.
@@ -557,6 +736,15 @@ class EcalGeometry : public framework::ConditionsObject {
    */
   std::map<EcalID, std::pair<double, double>> cell_pos_in_layer_;
 
+  /// number of layers in the dense tables
+  std::size_t n_layers_{0};
+
+  /// number of modules per layer in the dense tables
+  std::size_t n_modules_{0};
+
+  /// number of cells per module in the dense tables
+  std::size_t n_cells_{0};
+
   /**
    * Position of cell centers relative to world geometry
    *
@@ -564,23 +752,37 @@ class EcalGeometry : public framework::ConditionsObject {
    * by calculating the z-location as well as including rotations and
    * shifts when converting from p,q to x,y.
    *
-   * The key is the full EcalID and the value is the x,y,z tuple.
+   * The coordinates are stored in separate arrays indexed by getCellIndex.
    */
-  std::map<EcalID, std::tuple<double, double, double>> cell_global_pos_;
+  std::vector<double> cell_x_, cell_y_, cell_z_;
 
   /**
-   * Map of cell ID to neighboring cells
+   * Table of the nearest neighbors of each cell
    *
-   * The EcalID's in this map all have layer ID set to zero.
+   * Each cell (indexed by getCellInLayerIndex) has nn_width_ entries of
+   * which the first nn_size_ are its neighbors. The EcalID's in this
+   * table all have layer ID set to zero.
    */
-  std::map<EcalID, std::vector<EcalID>> NNMap_;
+  std::vector<EcalID> nn_table_;
+
+  /// number of entries per cell in the nearest neighbor table
+  std::size_t nn_width_{0};
+
+  /// number of nearest neighbors of each cell
+  std::vector<unsigned char> nn_size_;
 
   /**
-   * Map of cell ID to neighbors of neighbor cells
+   * Table of the next-to-nearest neighbors of each cell
    *
-   * The EcalID's in this map all have layer ID set to zero.
+   * Laid out the same way as nn_table_.
    */
-  std::map<EcalID, std::vector<EcalID>> NNNMap_;
+  std::vector<EcalID> nnn_table_;
+
+  /// number of entries per cell in the next-to-nearest neighbor table
+  std::size_t nnn_width_{0};
+
+  /// number of next-to-nearest neighbors of each cell
+  std::vector<unsigned char> nnn_size_;
 
   /**
    * Honeycomb Binning from ROOT
@@ -9,6 +9,7 @@
 
 // LDMX
 #include "DetDescr/EcalAbstractID.h"
+#include "DetDescr/IDBitField.h"
 
 namespace ldmx {
 
@@ -26,6 +27,13 @@ class EcalID : public EcalAbstractID {
   static const RawValue CELL_MASK{0xFFF};  // space for 4096 cells/module (!)
   static const RawValue CELL_SHIFT{0};
 
+  /// the layer field
+  typedef IDBitField<LAYER_SHIFT, LAYER_MASK> LayerField;
+  /// the module field
+  typedef IDBitField<MODULE_SHIFT, MODULE_MASK> ModuleField;
+  /// the cell field
+  typedef IDBitField<CELL_SHIFT, CELL_MASK> CellField;
+
   /**
    * Empty ECAL id (but not null!)
    */
@@ -62,9 +70,9 @@ class EcalID : public EcalAbstractID {
    */
   EcalID(unsigned int layer, unsigned int module, unsigned int cell)
       : EcalAbstractID(PrecisionGlobal, 0) {
-    id_ |= (layer & LAYER_MASK) << LAYER_SHIFT;
-    id_ |= (module & MODULE_MASK) << MODULE_SHIFT;
-    id_ |= (cell & CELL_MASK) << CELL_SHIFT;
+    id_ |= LayerField::pack(layer);
+    id_ |= ModuleField::pack(module);
+    id_ |= CellField::pack(cell);
   }
 
   /**
@@ -84,37 +92,37 @@ class EcalID : public EcalAbstractID {
    * Get the value of the module field from the ID.
    * @return The value of the module field.
    */
-  int module() const { return (id_ >> MODULE_SHIFT) & MODULE_MASK; }
+  int module() const { return ModuleField::get(id_); }
 
   /**
    * Get the value of the module field from the ID.
    * @return The value of the module field.
    */
-  int getModuleID() const { return (id_ >> MODULE_SHIFT) & MODULE_MASK; }
+  int getModuleID() const { return ModuleField::get(id_); }
 
   /**
    * Get the value of the layer field from the ID.
    * @return The value of the layer field.
    */
-  int layer() const { return (id_ >> LAYER_SHIFT) & LAYER_MASK; }
+  int layer() const { return LayerField::get(id_); }
 
   /**
    * Get the value of the layer field from the ID.
    * @return The value of the layer field.
    */
-  int getLayerID() const { return (id_ >> LAYER_SHIFT) & LAYER_MASK; }
+  int getLayerID() const { return LayerField::get(id_); }
 
   /**
    * Get the value of the cell field from the ID.
    * @return The value of the cell field.
    */
-  int cell() const { return (id_ >> CELL_SHIFT) & CELL_MASK; }
+  int cell() const { return CellField::get(id_); }
 
   /**
    * Get the value of the cell field from the ID.
    * @return The value of the cell field.
    */
-  int getCellID() const { return (id_ >> CELL_SHIFT) & CELL_MASK; }
+  int getCellID() const { return CellField::get(id_); }
 
   /**
    * Get the cell u,v index assuming a CMS-standard 432-cell sensor
@@ -122,6 +130,24 @@ class EcalID : public EcalAbstractID {
    */
   std::pair<unsigned int, unsigned int> getCellUV() const;
 
+  /**
+   * Decode the layer, module and cell of many raw IDs at once into one
+   * array per field. The IDs are not checked to be EcalIDs.
+   *
+   * @param[in] raw raw IDs
+   * @param[out] layers layer of each ID
+   * @param[out] modules module of each ID
+   * @param[out] cells cell of each ID
+   */
+  static void decode(const std::vector<RawValue>& raw,
+                     std::vector<unsigned int>& layers,
+                     std::vector<unsigned int>& modules,
+                     std::vector<unsigned int>& cells) {
+    LayerField::decode(raw, layers);
+    ModuleField::decode(raw, modules);
+    CellField::decode(raw, cells);
+  }
+
   static void createInterpreters();
 };
 
@@ -0,0 +1,109 @@
+/**
+ * @file EcalLayout.h
+ * @brief Shape of the ECal readout with compile-time bounds for the
+ * detector versions we run most
+ */
+
+#ifndef DETDESCR_ECALLAYOUT_H_
+#define DETDESCR_ECALLAYOUT_H_
+
+#include <cstddef>
+
+#include "DetDescr/EcalGeometry.h"
+
+namespace ldmx {
+
+/**
+ * @struct FixedEcalLayout
+ * @brief Shape of the ECal readout known at compile time
+ *
+ * The shape is the number of layers, of modules in each layer and of cells
+ * in each module. A loop over the cells written against a layout has
+ * constant bounds when it is given a FixedEcalLayout, so the compiler can
+ * unroll and vectorize it, and the same loop still runs with a
+ * DynamicEcalLayout for the other geometries.
+ *
+ * @see visitEcalLayout for choosing the layout from the geometry
+ */
+template <int LAYERS, int MODULES, int CELLS>
+struct FixedEcalLayout {
+  /// @return number of layers
+  static constexpr int layers() { return LAYERS; }
+  /// @return number of modules in each layer
+  static constexpr int modules() { return MODULES; }
+  /// @return number of cells in each module
+  static constexpr int cells() { return CELLS; }
+  /// @return number of cells in the ECal
+  static constexpr std::size_t size() {
+    return std::size_t(LAYERS) * MODULES * CELLS;
+  }
+  /// @return true, the bounds are constants
+  static constexpr bool fixed() { return true; }
+};
+
+/**
+ * @struct DynamicEcalLayout
+ * @brief Shape of the ECal readout only known at run time
+ */
+struct DynamicEcalLayout {
+  /// number of layers
+  int n_layers;
+  /// number of modules in each layer
+  int n_modules;
+  /// number of cells in each module
+  int n_cells;
+
+  int layers() const { return n_layers; }
+  int modules() const { return n_modules; }
+  int cells() const { return n_cells; }
+  std::size_t size() const {
+    return std::size_t(n_layers) * n_modules * n_cells;
+  }
+  static constexpr bool fixed() { return false; }
+};
+
+/// ECal of ldmx-det-v14 and ldmx-det-v14-8gev (and of v9 to v13)
+using EcalLayoutV14 =
+    FixedEcalLayout<34, EcalGeometry::MODULES_PER_LAYER, 432>;
+
+/// ECal of ldmx-reduced-v1
+using EcalLayoutReduced =
+    FixedEcalLayout<6, EcalGeometry::MODULES_PER_LAYER, 432>;
+
+/**
+ * Call a function with the layout of the geometry
+ *
+ * The shape of the geometry is compared to each of the fixed layouts and
+ * the function is called with the first that matches, or with a
+ * DynamicEcalLayout if none does. The function is usually a generic lambda
+ * so a version of it is compiled for each layout,
+ * ```cpp
+ * ldmx::visitEcalLayout(geometry, [&](auto layout) {
+ *   for (int layer{0}; layer < layout.layers(); layer++) ...
+ * });
+ * ```
+ * The shape is checked at run time, so a geometry with a fixed layout's
+ * number of layers but other cells still gets the dynamic one.
+ *
+ * @param[in] geometry ECal geometry to take the shape from
+ * @param[in] f function taking a layout
+ * @return what f returns, it must be the same for all of the layouts
+ */
+template <class F>
+decltype(auto) visitEcalLayout(const EcalGeometry& geometry, F&& f) {
+  DynamicEcalLayout shape{geometry.getNumLayers(),
+                          geometry.getNumModulesPerLayer(),
+                          geometry.getNumCellsPerModule()};
+  auto matches = [&shape](auto layout) {
+    return layout.layers() == shape.layers() and
+           layout.modules() == shape.modules() and
+           layout.cells() == shape.cells();
+  };
+  if (matches(EcalLayoutV14{})) return f(EcalLayoutV14{});
+  if (matches(EcalLayoutReduced{})) return f(EcalLayoutReduced{});
+  return f(shape);
+}
+
+}  // namespace ldmx
+
+#endif  // DETDESCR_ECALLAYOUT_H_
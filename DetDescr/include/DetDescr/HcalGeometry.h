@@ -16,7 +16,10 @@
 #include "TVector3.h"
 
 // STL
+#include <array>
 #include <map>
+#include <stdexcept>
+#include <vector>
 
 namespace hcal {
 class HcalGeometryProvider;
@@ -53,6 +56,24 @@ class HcalGeometry : public framework::ConditionsObject {
     depth = 2
   };
 
+  /**
+   * Everything about a single strip that depends only on its ID
+   *
+   * These are computed once when the geometry is built and kept in one
+   * contiguous table, so looking them up does not search a map or make
+   * any objects.
+   */
+  struct Strip {
+    /// X, Y and Z position of the center of the strip [mm]
+    std::array<double, 3> center;
+    /// half total width of the layer the strip is in [mm]
+    double half_total_width;
+    /// length of the strip [mm]
+    double length;
+    /// direction the length of the strip is along
+    ScintillatorOrientation orientation;
+  };
+
   /**
    * Class destructor.
    *
@@ -72,16 +93,38 @@ class HcalGeometry : public framework::ConditionsObject {
    * @return A TVector3 with the X, Y and Z position of the center of the bar.
    */
   TVector3 getStripCenterPosition(ldmx::HcalID id) const {
-    return strip_position_map_.at(id);
+    const auto &center{getStrip(id).center};
+    return TVector3(center[0], center[1], center[2]);
   }
 
   /**
-   * Get the strip position map
+   * Get the precomputed information about a strip
+   *
+   * @throw std::out_of_range if HcalID is not in the geometry.
+   *
+   * @param id HcalID of the strip
+   * @return reference to the strip in the table
    */
-  std::map<ldmx::HcalID, TVector3> getStripPositionMap() const {
-    return strip_position_map_;
+  const Strip &getStrip(ldmx::HcalID id) const {
+    auto layer_index = id.layer() - 1;
+    if (id.section() < 0 or id.section() >= int(first_strip_.size()) or
+        layer_index < 0 or
+        layer_index >= int(first_strip_[id.section()].size()) or
+        id.strip() < 0 or
+        id.strip() >= num_strips_[id.section()][layer_index]) {
+      throw std::out_of_range("HcalGeometry::getStrip");
+    }
+    return strips_[first_strip_[id.section()][layer_index] + id.strip()];
   }
 
+  /**
+   * Get the strip position map
+   *
+   * This is built from the strip table on every call, prefer
+   * getStrip or getStripCenterPosition for single strips.
+   */
+  std::map<ldmx::HcalID, TVector3> getStripPositionMap() const;
+
   /** Check whether a given layer corresponds to a horizontal (scintillator
    * length along the x-axis) or vertical layer in the back HCal. See the
    * back_horizontal_parity_ member for details.
@@ -205,8 +248,8 @@ class HcalGeometry : public framework::ConditionsObject {
   friend class hcal::HcalGeometryProvider;
 
   /**
-   * Map builder of HcalID and position.
-   * To build the map we loop over the number of Hcal sections, layers and
+   * Table builder of HcalID and position.
+   * To build the table we loop over the number of Hcal sections, layers and
    * strips. The Hcal sections range from 0 to 4. (We hard-code the number of
    * sections as seen in HcalID) The Hcal layers range from 1 to
    * NumLayers_[section]. The Hcal strips range from 0 to NumStrips_[section].
@@ -217,14 +260,14 @@ class HcalGeometry : public framework::ConditionsObject {
   void buildStripPositionMap();
   /**
    * Debugging utility, prints out the HcalID and corresponding value of all
-   * entries in the strip_position_map_ for a given section.
+   * entries in the strip table for a given section.
    *
    * @param section The section number to print, see HcalID for details.
    */
   void printPositionMap(int section) const;
   /**
    * Debugging utility, prints out the HcalID and corresponding value of all
-   * entries in the strip_position_map_. For printing only one of the sections,
+   * entries in the strip table. For printing only one of the sections,
    * see the overloaded version of this function taking a section parameter.
    *
    */
@@ -284,10 +327,14 @@ class HcalGeometry : public framework::ConditionsObject {
   bool is_prototype_{};
 
   /**
-   Map of the HcalID position of strip centers relative to world geometry.
-   The map is not configurable and is calculated by buildStripPositionMap().
+   Table of the strips, with their centers relative to world geometry.
+   The table is not configurable and is calculated by buildStripPositionMap().
+   The strips are ordered by section, layer and then strip.
    */
-  std::map<ldmx::HcalID, TVector3> strip_position_map_;
+  std::vector<Strip> strips_;
+
+  /// Index in strips_ of strip 0 of each section and each layer
+  std::vector<std::vector<int>> first_strip_;
 };
 
 }  // namespace ldmx
@@ -9,6 +9,7 @@
 
 // LDMX
 #include "DetDescr/HcalAbstractID.h"
+#include "DetDescr/IDBitField.h"
 
 namespace ldmx {
 
@@ -30,6 +31,13 @@ class HcalID : public HcalAbstractID {
   static const RawValue STRIP_MASK{0xFF};  // space for 255 strips/layer
   static const RawValue STRIP_SHIFT{0};
 
+  /// the section field
+  typedef IDBitField<SECTION_SHIFT, SECTION_MASK> SectionField;
+  /// the layer field
+  typedef IDBitField<LAYER_SHIFT, LAYER_MASK> LayerField;
+  /// the strip field
+  typedef IDBitField<STRIP_SHIFT, STRIP_MASK> StripField;
+
   /**
    * Empty HCAL id (but not null!)
    */
@@ -64,9 +72,9 @@ class HcalID : public HcalAbstractID {
    */
   HcalID(unsigned int section, unsigned int layer, unsigned int strip)
       : HcalAbstractID(Global, 0) {
-    id_ |= (section & SECTION_MASK) << SECTION_SHIFT;
-    id_ |= (layer & LAYER_MASK) << LAYER_SHIFT;
-    id_ |= (strip & STRIP_MASK) << STRIP_SHIFT;
+    id_ |= SectionField::pack(section);
+    id_ |= LayerField::pack(layer);
+    id_ |= StripField::pack(strip);
   }
 
   /*
@@ -74,38 +82,56 @@ class HcalID : public HcalAbstractID {
    * @return The value of the 'strip' field.
    */
   unsigned int getSection() const {
-    return (id_ >> SECTION_SHIFT) & SECTION_MASK;
+    return SectionField::get(id_);
   }
 
   /*
    * Get the value of the 'section' field from the ID.
    * @return The value of the 'strip' field.
    */
-  unsigned int section() const { return (id_ >> SECTION_SHIFT) & SECTION_MASK; }
+  unsigned int section() const { return SectionField::get(id_); }
 
   /**
    * Get the value of the layer field from the ID.
    * @return The value of the layer field.
    */
-  unsigned int layer() const { return (id_ >> LAYER_SHIFT) & LAYER_MASK; }
+  unsigned int layer() const { return LayerField::get(id_); }
 
   /**
    * Get the value of the layer field from the ID.
    * @return The value of the layer field.
    */
-  unsigned int getLayerID() const { return (id_ >> LAYER_SHIFT) & LAYER_MASK; }
+  unsigned int getLayerID() const { return LayerField::get(id_); }
 
   /**
    * Get the value of the 'strip' field from the ID.
    * @return The value of 'strip' field.
    */
-  unsigned int getStrip() const { return (id_ >> STRIP_SHIFT) & STRIP_MASK; }
+  unsigned int getStrip() const { return StripField::get(id_); }
 
   /**
    * Get the value of the 'strip' field from the ID.
    * @return The value of 'strip' field.
    */
-  unsigned int strip() const { return (id_ >> STRIP_SHIFT) & STRIP_MASK; }
+  unsigned int strip() const { return StripField::get(id_); }
+
+  /**
+   * Decode the section, layer and strip of many raw IDs at once into one
+   * array per field. The IDs are not checked to be HcalIDs.
+   *
+   * @param[in] raw raw IDs
+   * @param[out] sections section of each ID
+   * @param[out] layers layer of each ID
+   * @param[out] strips strip of each ID
+   */
+  static void decode(const std::vector<RawValue>& raw,
+                     std::vector<unsigned int>& sections,
+                     std::vector<unsigned int>& layers,
+                     std::vector<unsigned int>& strips) {
+    SectionField::decode(raw, sections);
+    LayerField::decode(raw, layers);
+    StripField::decode(raw, strips);
+  }
 
   static void createInterpreters();
 };
@@ -0,0 +1,79 @@
+/**
+ * @file IDBitField.h
+ * @brief Compile-time description of a field of a DetectorID
+ */
+
+#ifndef DETDESCR_IDBITFIELD_H_
+#define DETDESCR_IDBITFIELD_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "DetDescr/DetectorID.h"
+
+namespace ldmx {
+
+/**
+ * @class IDBitField
+ * @brief A field of a DetectorID whose position is known at compile time
+ *
+ * Unlike IDField, which describes a field at run time for introspection,
+ * the shift and mask are template parameters so decoding a field is a
+ * shift and an AND with constants. Decoding the field of many raw IDs at
+ * once is a simple loop over contiguous arrays which the compiler can
+ * vectorize.
+ *
+ * @tparam SHIFT position of the lowest bit of the field
+ * @tparam MASK mask of the field after shifting it down
+ */
+template <DetectorID::RawValue SHIFT, DetectorID::RawValue MASK>
+struct IDBitField {
+  /// position of the lowest bit of the field
+  static constexpr DetectorID::RawValue shift{SHIFT};
+  /// mask of the field after shifting it down
+  static constexpr DetectorID::RawValue mask{MASK};
+
+  /**
+   * Get the value of the field from a raw ID
+   * @param[in] raw raw ID
+   * @return value of the field
+   */
+  static constexpr DetectorID::RawValue get(DetectorID::RawValue raw) {
+    return (raw >> SHIFT) & MASK;
+  }
+
+  /**
+   * Put a value into the bits of the field
+   * @param[in] value value of the field, truncated to the field
+   * @return the value shifted into position, to be OR'ed into a raw ID
+   */
+  static constexpr DetectorID::RawValue pack(DetectorID::RawValue value) {
+    return (value & MASK) << SHIFT;
+  }
+
+  /**
+   * Decode the field of many raw IDs at once
+   * @param[in] raw raw IDs
+   * @param[in] n number of raw IDs
+   * @param[out] values value of the field of each ID, has space for n
+   */
+  static void decode(const DetectorID::RawValue* raw, std::size_t n,
+                     unsigned int* values) {
+    for (std::size_t i = 0; i < n; i++) values[i] = get(raw[i]);
+  }
+
+  /**
+   * Decode the field of many raw IDs at once
+   * @param[in] raw raw IDs
+   * @param[out] values value of the field of each ID, resized to match
+   */
+  static void decode(const std::vector<DetectorID::RawValue>& raw,
+                     std::vector<unsigned int>& values) {
+    values.resize(raw.size());
+    decode(raw.data(), raw.size(), values.data());
+  }
+};
+
+}  // namespace ldmx
+
+#endif  // DETDESCR_IDBITFIELD_H_
@@ -0,0 +1,421 @@
+/**
+ * @file IDMap.h
+ * @brief Hash containers keyed by detector IDs
+ */
+
+#ifndef DETDESCR_IDMAP_H_
+#define DETDESCR_IDMAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DetDescr/DetectorID.h"
+
+namespace ldmx {
+
+/**
+ * @class IDMap
+ * @brief Map from detector IDs to values in an open-addressing hash table
+ *
+ * The raw IDs and the values are kept in two flat arrays. An ID is looked
+ * for by probing the slots linearly from the Fibonacci hash of its raw
+ * value and the table is kept at most half full, so the probes stay short.
+ * The null ID (raw value zero) marks an empty slot and can't be a key.
+ *
+ * forEach visits the entries in the order of the table, which depends on
+ * its size. Where the order matters, e.g. when it sets the order of an
+ * output collection or of the random numbers drawn, use forEachSorted,
+ * which visits them by increasing raw ID like a std::map does.
+ *
+ * clear keeps the table and the values, so a map reused for every event
+ * doesn't allocate once it is large enough. A value is reset to T() when
+ * its ID is inserted again.
+ *
+ * @tparam ID class of detector ID
+ * @tparam T class of value, it must be default constructible
+ */
+template <class ID, class T>
+class IDMap {
+ public:
+  using RawValue = DetectorID::RawValue;
+
+  IDMap() = default;
+
+  /**
+   * Make a map with room for the input number of entries
+   */
+  explicit IDMap(std::size_t n) { reserve(n); }
+
+  /// @return number of entries
+  std::size_t size() const { return size_; }
+
+  /// @return true if there are no entries
+  bool empty() const { return size_ == 0; }
+
+  /**
+   * Make room for the input number of entries so inserting them
+   * doesn't grow the table
+   */
+  void reserve(std::size_t n) {
+    std::size_t capacity{MIN_CAPACITY};
+    while (capacity < 2 * n) capacity *= 2;
+    if (capacity > keys_.size()) rehash(capacity);
+  }
+
+  /**
+   * Remove all of the entries, keeping the memory
+   */
+  void clear() {
+    std::fill(keys_.begin(), keys_.end(), 0);
+    size_ = 0;
+  }
+
+  /**
+   * Find the value of an ID
+   * @return pointer to the value, nullptr if the ID isn't in the map
+   */
+  T* find(ID id) {
+    std::size_t slot{probe(id.raw())};
+    return slot == NONE || keys_[slot] == 0 ? nullptr : &values_[slot];
+  }
+
+  /// @see find
+  const T* find(ID id) const {
+    std::size_t slot{probe(id.raw())};
+    return slot == NONE || keys_[slot] == 0 ? nullptr : &values_[slot];
+  }
+
+  /// @return true if the ID is in the map
+  bool contains(ID id) const { return find(id) != nullptr; }
+
+  /**
+   * Get the value of an ID, inserting T() if it isn't in the map
+   */
+  T& operator[](ID id) { return *emplace(id).first; }
+
+  /**
+   * Insert an ID with the value made from the input arguments,
+   * unless the ID is already in the map
+   *
+   * @return pointer to the value of the ID and true if it was inserted
+   */
+  template <class... Args>
+  std::pair<T*, bool> emplace(ID id, Args&&... args) {
+    RawValue raw{id.raw()};
+    if (raw == 0) {
+      EXCEPTION_RAISE("IDMap", "The null detector ID can't be a key.");
+    }
+    if (2 * (size_ + 1) > keys_.size())
+      rehash(std::max(MIN_CAPACITY, 2 * keys_.size()));
+    std::size_t slot{probe(raw)};
+    if (keys_[slot] == raw) return {&values_[slot], false};
+    keys_[slot] = raw;
+    values_[slot] = T(std::forward<Args>(args)...);
+    size_++;
+    return {&values_[slot], true};
+  }
+
+  /**
+   * Remove an ID from the map
+   *
+   * The entries after it in its probe sequence are shifted back, so
+   * erasing leaves no tombstones behind.
+   *
+   * @return true if the ID was in the map
+   */
+  bool erase(ID id) {
+    std::size_t hole{probe(id.raw())};
+    if (hole == NONE || keys_[hole] == 0) return false;
+    std::size_t mask{keys_.size() - 1};
+    for (std::size_t j{(hole + 1) & mask}; keys_[j] != 0; j = (j + 1) & mask) {
+      // the entry in j can fill the hole if its home slot isn't
+      // cyclically in (hole, j]
+      std::size_t home{slotOf(keys_[j])};
+      bool stays{hole < j ? (hole < home && home <= j)
+                          : (hole < home || home <= j)};
+      if (stays) continue;
+      keys_[hole] = keys_[j];
+      values_[hole] = std::move(values_[j]);
+      hole = j;
+    }
+    keys_[hole] = 0;
+    size_--;
+    return true;
+  }
+
+  /**
+   * Call f(ID, T&) for each entry in the order of the table
+   */
+  template <class F>
+  void forEach(F&& f) {
+    for (std::size_t i{0}; i < keys_.size(); i++)
+      if (keys_[i] != 0) f(ID(keys_[i]), values_[i]);
+  }
+
+  /// @see forEach
+  template <class F>
+  void forEach(F&& f) const {
+    for (std::size_t i{0}; i < keys_.size(); i++)
+      if (keys_[i] != 0) f(ID(keys_[i]), values_[i]);
+  }
+
+  /**
+   * Call f(ID, T&) for each entry by increasing raw ID
+   */
+  template <class F>
+  void forEachSorted(F&& f) {
+    for (std::size_t i : sortedSlots()) f(ID(keys_[i]), values_[i]);
+  }
+
+  /// @see forEachSorted
+  template <class F>
+  void forEachSorted(F&& f) const {
+    for (std::size_t i : sortedSlots()) f(ID(keys_[i]), values_[i]);
+  }
+
+ private:
+  /// smallest number of slots of the table
+  static constexpr std::size_t MIN_CAPACITY{16};
+  /// slot returned by probe when there is no table
+  static constexpr std::size_t NONE{~std::size_t(0)};
+
+  /**
+   * Home slot of a raw ID
+   *
+   * Fibonacci hashing takes the top bits of the product, which depend on
+   * all of the fields of the ID and not just the ones in its low bits.
+   */
+  std::size_t slotOf(RawValue raw) const {
+    return std::size_t((raw * UINT64_C(0x9E3779B97F4A7C15)) >> shift_);
+  }
+
+  /**
+   * Find the slot holding a raw ID or, if it isn't in the table, the
+   * empty slot where it would be inserted
+   */
+  std::size_t probe(RawValue raw) const {
+    if (keys_.empty() || raw == 0) return NONE;
+    std::size_t mask{keys_.size() - 1};
+    std::size_t slot{slotOf(raw)};
+    while (keys_[slot] != 0 && keys_[slot] != raw) slot = (slot + 1) & mask;
+    return slot;
+  }
+
+  /// move the entries into a table of the input number of slots
+  void rehash(std::size_t capacity) {
+    std::vector<RawValue> keys(capacity, 0);
+    std::vector<T> values(capacity);
+    keys.swap(keys_);
+    values.swap(values_);
+    shift_ = 64;
+    for (std::size_t c{capacity}; c > 1; c /= 2) shift_--;
+    std::size_t mask{capacity - 1};
+    for (std::size_t i{0}; i < keys.size(); i++) {
+      if (keys[i] == 0) continue;
+      std::size_t slot{slotOf(keys[i])};
+      while (keys_[slot] != 0) slot = (slot + 1) & mask;
+      keys_[slot] = keys[i];
+      values_[slot] = std::move(values[i]);
+    }
+  }
+
+  /// the occupied slots by increasing raw ID
+  std::vector<std::size_t> sortedSlots() const {
+    std::vector<std::size_t> slots;
+    slots.reserve(size_);
+    for (std::size_t i{0}; i < keys_.size(); i++)
+      if (keys_[i] != 0) slots.push_back(i);
+    std::sort(slots.begin(), slots.end(), [this](std::size_t a, std::size_t b) {
+      return keys_[a] < keys_[b];
+    });
+    return slots;
+  }
+
+  /// raw ID in each slot, zero for an empty slot
+  std::vector<RawValue> keys_;
+  /// value of the ID in the same slot of keys_
+  std::vector<T> values_;
+  /// number of entries
+  std::size_t size_{0};
+  /// shift of the hash product down to the bits of a slot
+  int shift_{64};
+};
+
+/**
+ * @class IDSet
+ * @brief Set of detector IDs in an open-addressing hash table
+ *
+ * @see IDMap for the layout and the iteration order
+ *
+ * @tparam ID class of detector ID
+ */
+template <class ID>
+class IDSet {
+ public:
+  IDSet() = default;
+
+  /**
+   * Make a set with room for the input number of IDs
+   */
+  explicit IDSet(std::size_t n) : ids_(n) {}
+
+  /// @return number of IDs
+  std::size_t size() const { return ids_.size(); }
+
+  /// @return true if there are no IDs
+  bool empty() const { return ids_.empty(); }
+
+  /// Make room for the input number of IDs
+  void reserve(std::size_t n) { ids_.reserve(n); }
+
+  /// Remove all of the IDs, keeping the memory
+  void clear() { ids_.clear(); }
+
+  /**
+   * Insert an ID
+   * @return true if it wasn't in the set already
+   */
+  bool insert(ID id) { return ids_.emplace(id).second; }
+
+  /// @return true if the ID is in the set
+  bool contains(ID id) const { return ids_.contains(id); }
+
+  /**
+   * Remove an ID
+   * @return true if it was in the set
+   */
+  bool erase(ID id) { return ids_.erase(id); }
+
+  /// Call f(ID) for each ID in the order of the table
+  template <class F>
+  void forEach(F&& f) const {
+    ids_.forEach([&f](ID id, char) { f(id); });
+  }
+
+  /// Call f(ID) for each ID by increasing raw ID
+  template <class F>
+  void forEachSorted(F&& f) const {
+    ids_.forEachSorted([&f](ID id, char) { f(id); });
+  }
+
+ private:
+  /// the IDs with a dummy value
+  IDMap<ID, char> ids_;
+};
+
+/**
+ * @class DenseIDMap
+ * @brief Map from the IDs with a PackedIndex to values in a flat array
+ *
+ * IDs like EcalElectronicsID pack their fields into an index smaller than
+ * ID::MAX_INDEX, so their values can be kept in an array indexed by it
+ * without any hashing. The array is made once and the indices that are
+ * filled are listed, so clearing and iterating only touch the entries.
+ *
+ * @tparam ID class of detector ID with MAX_INDEX, index() and
+ * idFromIndex(index)
+ * @tparam T class of value, it must be default constructible
+ */
+template <class ID, class T>
+class DenseIDMap {
+ public:
+  DenseIDMap() : values_(ID::MAX_INDEX), filled_(ID::MAX_INDEX, false) {}
+
+  /// @return number of entries
+  std::size_t size() const { return indices_.size(); }
+
+  /// @return true if there are no entries
+  bool empty() const { return indices_.empty(); }
+
+  /// Remove all of the entries, keeping the memory
+  void clear() {
+    for (unsigned int index : indices_) filled_[index] = false;
+    indices_.clear();
+  }
+
+  /**
+   * Find the value of an ID
+   * @return pointer to the value, nullptr if the ID isn't in the map
+   */
+  T* find(ID id) {
+    unsigned int index{id.index()};
+    return index < filled_.size() && filled_[index] ? &values_[index]
+                                                    : nullptr;
+  }
+
+  /// @see find
+  const T* find(ID id) const {
+    unsigned int index{id.index()};
+    return index < filled_.size() && filled_[index] ? &values_[index]
+                                                    : nullptr;
+  }
+
+  /// @return true if the ID is in the map
+  bool contains(ID id) const { return find(id) != nullptr; }
+
+  /**
+   * Get the value of an ID, inserting T() if it isn't in the map
+   */
+  T& operator[](ID id) { return *emplace(id).first; }
+
+  /**
+   * Insert an ID with the value made from the input arguments,
+   * unless the ID is already in the map
+   *
+   * @return pointer to the value of the ID and true if it was inserted
+   */
+  template <class... Args>
+  std::pair<T*, bool> emplace(ID id, Args&&... args) {
+    unsigned int index{id.index()};
+    if (index >= filled_.size()) {
+      EXCEPTION_RAISE("IDMap", "Index " + std::to_string(index) +
+                                   " is beyond the end of the dense map.");
+    }
+    if (filled_[index]) return {&values_[index], false};
+    filled_[index] = true;
+    indices_.push_back(index);
+    values_[index] = T(std::forward<Args>(args)...);
+    return {&values_[index], true};
+  }
+
+  /**
+   * Call f(ID, T&) for each entry in the order they were inserted
+   */
+  template <class F>
+  void forEach(F&& f) {
+    for (unsigned int index : indices_)
+      f(ID::idFromIndex(index), values_[index]);
+  }
+
+  /// @see forEach
+  template <class F>
+  void forEach(F&& f) const {
+    for (unsigned int index : indices_)
+      f(ID::idFromIndex(index), values_[index]);
+  }
+
+  /**
+   * Call f(ID, T&) for each entry by increasing index
+   */
+  template <class F>
+  void forEachSorted(F&& f) {
+    std::sort(indices_.begin(), indices_.end());
+    forEach(f);
+  }
+
+ private:
+  /// value of each index
+  std::vector<T> values_;
+  /// true for the indices in the map
+  std::vector<bool> filled_;
+  /// the indices in the map
+  std::vector<unsigned int> indices_;
+};
+
+}  // namespace ldmx
+
+#endif  // DETDESCR_IDMAP_H_
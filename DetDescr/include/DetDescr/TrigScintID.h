@@ -5,6 +5,7 @@
 /*   DetDescr   */
 /*~~~~~~~~~~~~~~*/
 #include "DetDescr/DetectorID.h"
+#include "DetDescr/IDBitField.h"
 
 namespace ldmx {
 
@@ -18,6 +19,11 @@ class TrigScintID : public DetectorID {
   static const RawValue BAR_MASK{0xFF};
   static const RawValue BAR_SHIFT{0};
 
+  /// the module field
+  typedef IDBitField<MODULE_SHIFT, MODULE_MASK> ModuleField;
+  /// the bar field
+  typedef IDBitField<BAR_SHIFT, BAR_MASK> BarField;
+
   /// Constructor
   TrigScintID() : DetectorID(SD_TRIGGER_SCINT, 0) {}
 
@@ -38,8 +44,8 @@ class TrigScintID : public DetectorID {
    */
   TrigScintID(unsigned int module, unsigned int bar)
       : DetectorID(SD_TRIGGER_SCINT, 0) {
-    id_ |= (module & MODULE_MASK) << MODULE_SHIFT;
-    id_ |= (bar & BAR_MASK) << BAR_SHIFT;
+    id_ |= ModuleField::pack(module);
+    id_ |= BarField::pack(bar);
   }
 
   /// Destructor
@@ -49,25 +55,40 @@ class TrigScintID : public DetectorID {
    * Get the value of the module field from the ID.
    * @return The value of the module field.
    */
-  int module() const { return (id_ >> MODULE_SHIFT) & MODULE_MASK; }
+  int module() const { return ModuleField::get(id_); }
 
   /**
    * Get the value of the module field from the ID.
    * @return The value of the module field.
    */
-  int getModule() const { return (id_ >> MODULE_SHIFT) & MODULE_MASK; }
+  int getModule() const { return ModuleField::get(id_); }
 
   /**
    * Get the value of the bar field from the ID.
    * @return The value of the bar field.
    */
-  int bar() const { return (id_ >> BAR_SHIFT) & BAR_MASK; }
+  int bar() const { return BarField::get(id_); }
   /**
    * Get the bar ID.
    *
    * @return The bar ID.
    */
-  int getBarID() const { return (id_ >> BAR_SHIFT) & BAR_MASK; }
+  int getBarID() const { return BarField::get(id_); }
+
+  /**
+   * Decode the module and bar of many raw IDs at once into one array per
+   * field. The IDs are not checked to be TrigScintIDs.
+   *
+   * @param[in] raw raw IDs
+   * @param[out] modules module of each ID
+   * @param[out] bars bar of each ID
+   */
+  static void decode(const std::vector<RawValue>& raw,
+                     std::vector<unsigned int>& modules,
+                     std::vector<unsigned int>& bars) {
+    ModuleField::decode(raw, modules);
+    BarField::decode(raw, bars);
+  }
 
   static void createInterpreters();
 };  // TrigScintID
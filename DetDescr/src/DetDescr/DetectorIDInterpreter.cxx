@@ -33,27 +33,24 @@ void DetectorIDInterpreter::setRawValue(DetectorID rawValue) {
 void DetectorIDInterpreter::unpack() {
   std::fill(fieldValues_.begin(), fieldValues_.end(), 0);
   if (!p_fieldInfo_) return;
-  for (auto field : p_fieldInfo_->fieldList_) {
-    unsigned result = (field->getBitMask() & id_.raw()) >> field->getStartBit();
-    this->fieldValues_[field->getIndex()] = result;
+  for (const auto& field : p_fieldInfo_->decoders_) {
+    fieldValues_[field.index_] = (field.mask_ & id_.raw()) >> field.shift_;
   }
 }
 
 void DetectorIDInterpreter::pack() {
   DetectorID::RawValue rawValue = 0;
-  for (auto field : p_fieldInfo_->fieldList_) {
-    unsigned fieldValue = fieldValues_[field->getIndex()];
-    rawValue =
-        rawValue | ((fieldValue << field->getStartBit()) & field->getBitMask());
+  for (const auto& field : p_fieldInfo_->decoders_) {
+    unsigned fieldValue = fieldValues_[field.index_];
+    rawValue = rawValue | ((fieldValue << field.shift_) & field.mask_);
   }
   id_.setRawValue(rawValue);
 }
 
 DetectorIDInterpreter::FieldValue DetectorIDInterpreter::getFieldValue(
     int i) const {
-  IDField* field = p_fieldInfo_->fieldList_.at(i);
-  unsigned result = (field->getBitMask() & id_.raw()) >> field->getStartBit();
-  return result;
+  const FieldDecoder& field = p_fieldInfo_->decoders_.at(i);
+  return (field.mask_ & id_.raw()) >> field.shift_;
 }
 
 void DetectorIDInterpreter::setFieldValue(int i, FieldValue val) {
@@ -85,9 +82,18 @@ DetectorIDInterpreter::FieldValue DetectorIDInterpreter::getFieldValue(
 void DetectorIDInterpreter::init() {
   if (g_rosettaStone.empty()) loadStandardInterpreters();
 
-  p_fieldInfo_ = 0;
+  if (id_.null()) {
+    p_fieldInfo_ = 0;
+    return;
+  }
 
-  if (id_.null()) return;
+  // consecutive IDs are usually of the same kind, the signatures of
+  // different kinds of IDs don't overlap so there's no need to search
+  if (p_fieldInfo_ && (id_.raw() & p_fieldInfo_->signature_.mask_) ==
+                          p_fieldInfo_->signature_.comparison_)
+    return;
+
+  p_fieldInfo_ = 0;
 
   for (auto ptr : g_rosettaStone) {
     if ((id_.raw() & ptr.first.mask_) == ptr.first.comparison_) {
@@ -117,10 +123,7 @@ void DetectorIDInterpreter::registerInterpreter(
                     "Attempted to replace interpreter for subdetector " +
                         std::to_string(idtype));
   }
-  SubdetectorIDFields* fields = new SubdetectorIDFields();
-  fields->fieldList_ = fieldList;
-  for (auto it : fieldList) fields->fieldMap_[it->getFieldName()] = it;
-  g_rosettaStone[sig] = fields;
+  registerFields(sig, fieldList);
 }
 
 void DetectorIDInterpreter::registerInterpreter(
@@ -138,9 +141,19 @@ void DetectorIDInterpreter::registerInterpreter(
                         std::to_string(mask) + " equality " +
                         std::to_string(equality));
   }
+  registerFields(sig, fieldList);
+}
+
+void DetectorIDInterpreter::registerFields(
+    const IDSignature& sig, const IDField::IDFieldList& fieldList) {
   SubdetectorIDFields* fields = new SubdetectorIDFields();
   fields->fieldList_ = fieldList;
-  for (auto it : fieldList) fields->fieldMap_[it->getFieldName()] = it;
+  fields->signature_ = sig;
+  for (auto it : fieldList) {
+    fields->fieldMap_[it->getFieldName()] = it;
+    fields->decoders_.push_back(
+        {it->getIndex(), it->getStartBit(), it->getBitMask()});
+  }
   g_rosettaStone[sig] = fields;
 }
 
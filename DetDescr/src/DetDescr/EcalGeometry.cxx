@@ -2,6 +2,8 @@
 
 #include <assert.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 
@@ -47,6 +49,23 @@ static void unrotate(double& p, double& q) {
   q = -tmp;
 }
 
+/**
+ * Round fractional axial hexagon coordinates (a,b) to the ones of the
+ * hexagon containing them, rounding the cube coordinates (a, b, -a-b)
+ * and fixing the one that moved the most
+ */
+static void hexRound(double& a, double& b) {
+  double c{-a - b};
+  double ra{std::round(a)}, rb{std::round(b)}, rc{std::round(c)};
+  double da{std::abs(ra - a)}, db{std::abs(rb - b)}, dc{std::abs(rc - c)};
+  if (da > db and da > dc)
+    ra = -rb - rc;
+  else if (db > dc)
+    rb = -ra - rc;
+  a = ra;
+  b = rb;
+}
+
 EcalGeometry::EcalGeometry(const framework::config::Parameters& ps)
     : framework::ConditionsObject(EcalGeometry::CONDITIONS_OBJECT_NAME) {
   layerZPositions_ = ps.getParameter<std::vector<double>>("layerZPositions");
@@ -115,18 +134,7 @@ EcalID EcalGeometry::getID(double x, double y, int layer_id) const {
       q{y - std::get<1>(layer_pos_xy_.at(layer_id))};
 
   // deduce module ID
-  //    there are only 7 modules so we just loop through them
-  //    all and pick out the module ID that we are inside of
-
-  int module_id{-1};
-  for (auto const& [mid, module_xy] : module_pos_xy_) {
-    double probe_x{p - module_xy.first}, probe_y{q - module_xy.second};
-    if (cornersSideUp_) rotate(probe_x, probe_y);
-    if (isInside(probe_x / moduleR_, probe_y / moduleR_)) {
-      module_id = mid;
-      break;
-    }
-  }
+  int module_id{moduleInLayer(p, q)};
 
   if (module_id < 0) {
     EXCEPTION_RAISE(
@@ -155,7 +163,7 @@ EcalID EcalGeometry::getID(double x, double y, int layer_id,
   if (cornersSideUp_) rotate(p, q);
 
   // deduce cell ID
-  int cell_id = cell_id_in_module_.FindBin(p, q) - 1;
+  int cell_id = cellInModule(p, q);
 
   if (cell_id < 0) {
     EXCEPTION_RAISE(
@@ -171,8 +179,43 @@ EcalID EcalGeometry::getID(double x, double y, int layer_id,
   return EcalID(layer_id, module_id, cell_id);
 }
 
-std::tuple<double, double, double> EcalGeometry::getPosition(EcalID id) const {
-  return cell_global_pos_.at(id);
+int EcalGeometry::moduleInLayer(double p, double q) const {
+  if (cornersSideUp_) rotate(p, q);
+
+  // the module centers are on a lattice of hexagons oriented like the
+  //  modules whose center-to-flat radius is half the distance between centers
+  double a{(2. / 3.) * p / module_lattice_R_},
+      b{(-p / 3. + q / sqrt(3.)) / module_lattice_R_};
+  hexRound(a, b);
+  if (std::abs(a) > 1 or std::abs(b) > 1) return -1;
+  int module_id{module_in_lattice_[int(a + 1) * 3 + int(b + 1)]};
+  if (module_id < 0) return -1;
+
+  // the lattice hexagon contains the module and half of the gap around it
+  double probe_p{module_pos_xy_.at(module_id).first},
+      probe_q{module_pos_xy_.at(module_id).second};
+  if (cornersSideUp_) rotate(probe_p, probe_q);
+  probe_p = p - probe_p;
+  probe_q = q - probe_q;
+  return isInside(probe_p / moduleR_, probe_q / moduleR_) ? module_id : -1;
+}
+
+int EcalGeometry::cellInModule(double p, double q) const {
+  // axial coordinates with respect to the first hexagon of the honeycomb
+  double dp{p - cell_grid_p_}, dq{q - cell_grid_q_};
+  double a{(dp / sqrt(3.) - dq / 3.) / cellR_}, b{(2. / 3.) * dq / cellR_};
+  hexRound(a, b);
+  // odd rows of the honeycomb are shifted by half a cell towards positive p
+  int row{int(b)}, col{int(a) + (row - (row & 1)) / 2};
+  if (row >= 0 and row < cell_grid_rows_ and col >= 0 and
+      col < cell_grid_cols_) {
+    int cell_id{cell_in_grid_[row * cell_grid_cols_ + col]};
+    if (cell_id >= 0) return cell_id;
+  }
+
+  // the cells on the module edge are clipped or stretched to it, so the
+  //  points that are not in a full hexagon are left to the polygons
+  return cell_id_in_module_.FindBin(p, q) - 1;
 }
 
 std::pair<double, double> EcalGeometry::getPositionInModule(int cell_id) const {
@@ -252,6 +295,18 @@ void EcalGeometry::buildModuleMap() {
       std::cout << "    Module " << id << " is centered at (x,y) = "
                 << "(" << x << ", " << y << ") mm" << std::endl;
   }
+
+  // place the modules on the lattice of their centers for moduleInLayer
+  module_lattice_R_ = (2. * moduler_ + gap_) / sqrt(3.);
+  module_in_lattice_.fill(-1);
+  for (auto const& [mid, module_xy] : module_pos_xy_) {
+    double p{module_xy.first}, q{module_xy.second};
+    if (cornersSideUp_) rotate(p, q);
+    double a{(2. / 3.) * p / module_lattice_R_},
+        b{(-p / 3. + q / sqrt(3.)) / module_lattice_R_};
+    hexRound(a, b);
+    module_in_lattice_[int(a + 1) * 3 + int(b + 1)] = mid;
+  }
 }
 
 void EcalGeometry::buildCellMap() {
@@ -303,6 +358,14 @@ void EcalGeometry::buildCellMap() {
 
   gridMap.Honeycomb(gridMinP, gridMinQ, cellR_, numPCells, numQCells);
 
+  // the first hexagon of the honeycomb is the one cellInModule counts from,
+  //  the odd rows have one hexagon less than the even ones
+  cell_grid_p_ = gridMinP + cellr_;
+  cell_grid_q_ = gridMinQ + cellR_;
+  cell_grid_rows_ = numQCells;
+  cell_grid_cols_ = numPCells;
+  cell_in_grid_.assign(cell_grid_rows_ * cell_grid_cols_, -1);
+
   if (verbose_ > 0) {
     std::cout << std::setprecision(2)
               << "[EcalGeometry::buildCellMap] cell rmin: " << cellr_
@@ -464,6 +527,16 @@ void EcalGeometry::buildCellMap() {
        */
       double p = (polyBin->GetXMax() + polyBin->GetXMin()) / 2.;
       double q = (polyBin->GetYMax() + polyBin->GetYMin()) / 2.;
+
+      // only the cells that are full hexagons can be found by rounding
+      if (numVerticesInside == 6) {
+        double dp{p - cell_grid_p_}, dq{q - cell_grid_q_};
+        double a{(dp / sqrt(3.) - dq / 3.) / cellR_},
+            b{(2. / 3.) * dq / cellR_};
+        hexRound(a, b);
+        int row{int(b)}, col{int(a) + (row - (row & 1)) / 2};
+        cell_in_grid_[row * cell_grid_cols_ + col] = cell_id;
+      }
       if (verbose_ > 1) {
         std::cout << "    Copying poly with ID " << polyBin->GetBinNumber()
                   << " and (p,q) (" << std::setprecision(2) << p << "," << q
@@ -501,21 +574,33 @@ void EcalGeometry::buildCellModuleMap() {
     }
   }
 
-  /// construct map of global cell centers relative to target center
+  /// size the dense tables, the IDs are counted from zero
+  n_layers_ = layer_pos_xy_.empty() ? 0 : layer_pos_xy_.rbegin()->first + 1;
+  n_modules_ =
+      module_pos_xy_.empty() ? 0 : module_pos_xy_.rbegin()->first + 1;
+  n_cells_ = cell_pos_in_module_.empty()
+                 ? 0
+                 : cell_pos_in_module_.rbegin()->first + 1;
+
+  /// construct table of global cell centers relative to target center
+  std::size_t n_entries{n_layers_ * n_modules_ * n_cells_};
+  cell_x_.assign(n_entries, 0.);
+  cell_y_.assign(n_entries, 0.);
+  cell_z_.assign(n_entries, 0.);
   for (auto const& [layer_id, layer_xyz] : layer_pos_xy_) {
     for (auto const& [flat_id, rel_to_layer] : cell_pos_in_layer_) {
       // now add the layer-center values to get the global position
       // of the cell
-      cell_global_pos_[EcalID(layer_id, flat_id.module(), flat_id.cell())] =
-          std::make_tuple(rel_to_layer.first + std::get<0>(layer_xyz),
-                          rel_to_layer.second + std::get<1>(layer_xyz),
-                          std::get<2>(layer_xyz));
+      std::size_t i{
+          getCellIndex(EcalID(layer_id, flat_id.module(), flat_id.cell()))};
+      cell_x_[i] = rel_to_layer.first + std::get<0>(layer_xyz);
+      cell_y_[i] = rel_to_layer.second + std::get<1>(layer_xyz);
+      cell_z_[i] = std::get<2>(layer_xyz);
     }
   }
 
   if (verbose_ > 0)
-    std::cout << "  contained " << cell_global_pos_.size() << " entries. "
-              << std::endl;
+    std::cout << "  contained " << n_entries << " entries. " << std::endl;
   return;
 }
 
@@ -537,23 +622,40 @@ void EcalGeometry::buildNeighborMaps() {
     std::cout << "[EcalGeometry::buildNeighborMaps] : "
               << "Building Nearest and Next-Nearest Neighbor maps" << std::endl;
 
-  NNMap_.clear();
-  NNNMap_.clear();
+  std::map<EcalID, std::vector<EcalID>> nn_map, nnn_map;
   for (auto const& [center_id, center_xyz] : cell_pos_in_layer_) {
     for (auto const& [probe_id, probe_xyz] : cell_pos_in_layer_) {
       /// do distance calculation
       double dist = distance(probe_xyz, center_xyz);
       if (dist > 1 * cellr_ && dist <= 3. * cellr_) {
-        NNMap_[center_id].push_back(probe_id);
+        nn_map[center_id].push_back(probe_id);
       } else if (dist > 3. * cellr_ && dist <= 4.5 * cellr_) {
-        NNNMap_[center_id].push_back(probe_id);
+        nnn_map[center_id].push_back(probe_id);
       }
     }
     if (verbose_ > 1)
-      std::cout << "  Found " << NNMap_[center_id].size() << " NN and "
-                << NNNMap_[center_id].size() << " NNN for cell " << center_id
+      std::cout << "  Found " << nn_map[center_id].size() << " NN and "
+                << nnn_map[center_id].size() << " NNN for cell " << center_id
                 << std::endl;
   }
+
+  /// flatten the lists into tables with a fixed number of entries per cell
+  auto flatten = [this](const std::map<EcalID, std::vector<EcalID>>& lists,
+                        std::vector<EcalID>& table, std::size_t& width,
+                        std::vector<unsigned char>& sizes) {
+    width = 0;
+    for (auto const& [center_id, list] : lists)
+      width = std::max(width, list.size());
+    table.assign(n_modules_ * n_cells_ * width, EcalID());
+    sizes.assign(n_modules_ * n_cells_, 0);
+    for (auto const& [center_id, list] : lists) {
+      std::size_t i{getCellInLayerIndex(center_id)};
+      std::copy(list.begin(), list.end(), table.begin() + i * width);
+      sizes[i] = list.size();
+    }
+  };
+  flatten(nn_map, nn_table_, nn_width_, nn_size_);
+  flatten(nnn_map, nnn_table_, nnn_width_, nnn_size_);
   /*
    * DEBUG CHECK HERE
    *  this is double checking that NN and NNN can cross modules
@@ -566,14 +668,14 @@ void EcalGeometry::buildNeighborMaps() {
     std::cout << "The neighbors of the bin in the upper-right corner of the "
                  "center module, with cellModuleID "
               << specialCellModuleID << " include " << std::endl;
-    for (auto centerNN : NNMap_.at(specialCellModuleID)) {
+    for (auto centerNN : getNN(specialCellModuleID)) {
       std::cout << " NN " << centerNN
                 << TString::Format(" (x,y) (%.2f, %.2f)",
                                    getCellCenterAbsolute(centerNN).first,
                                    getCellCenterAbsolute(centerNN).second)
                 << std::endl;
     }
-    for (auto centerNNN : NNNMap_.at(specialCellModuleID)) {
+    for (auto centerNNN : getNNN(specialCellModuleID)) {
       std::cout << " NNN " << centerNNN
                 << TString::Format(" (x,y) (%.2f, %.2f)",
                                    getCellCenterAbsolute(centerNNN).first,
@@ -159,10 +159,26 @@ void HcalGeometry::printPositionMap(int section) const {
   }
 }
 
+std::map<ldmx::HcalID, TVector3> HcalGeometry::getStripPositionMap() const {
+  std::map<ldmx::HcalID, TVector3> strip_position_map;
+  for (int section = 0; section < num_sections_; section++) {
+    for (int layer = 1; layer <= num_layers_[section]; layer++) {
+      for (int strip = 0; strip < getNumStrips(section, layer); strip++) {
+        ldmx::HcalID id(section, layer, strip);
+        strip_position_map[id] = getStripCenterPosition(id);
+      }
+    }
+  }
+  return strip_position_map;
+}
+
 void HcalGeometry::buildStripPositionMap() {
+  strips_.clear();
+  first_strip_.assign(num_sections_, {});
   // We hard-code the number of sections as seen in HcalID
   for (unsigned int section = 0; section < num_sections_; section++) {
     for (unsigned int layer = 1; layer <= num_layers_[section]; layer++) {
+      first_strip_[section].push_back(strips_.size());
       for (unsigned int strip = 0; strip < getNumStrips(section, layer);
            strip++) {
         // initialize values
@@ -311,12 +327,13 @@ void HcalGeometry::buildStripPositionMap() {
         }
 
         y += y_offset_;
-        TVector3 pos;
-        pos.SetXYZ(x, y, z);
-        strip_position_map_[ldmx::HcalID(section, layer, strip)] = pos;
+        strips_.push_back({{x, y, z},
+                           getHalfTotalWidth(section, layer),
+                           getScintillatorLength(id),
+                           orientation});
       }  // loop over strips
     }    // loop over layers
   }      // loop over sections
-}  // strip position map
+}  // strip table
 
 }  // namespace ldmx
@@ -235,4 +235,46 @@ TEST_CASE("DetectorID", "[DetDescr][functionality]") {
     CHECK(dii.getFieldValue("subtype") == 1);
     CHECK(dii.getFieldValue("payload") == 3210);
   }
+  SECTION("Bulk decoding") {
+    std::vector<DetectorID::RawValue> ecal_raw, hcal_raw, ts_raw;
+    for (unsigned int i = 0; i < 37; i++) {
+      ecal_raw.push_back(EcalID(i % 34, i % 7, 13 * i).raw());
+      hcal_raw.push_back(HcalID(i % 5, i, 2 * i).raw());
+      ts_raw.push_back(TrigScintID(i % 3, i + 100).raw());
+    }
+
+    std::vector<unsigned int> layers, modules, cells;
+    EcalID::decode(ecal_raw, layers, modules, cells);
+    REQUIRE(layers.size() == ecal_raw.size());
+    std::vector<unsigned int> sections, hcal_layers, strips;
+    HcalID::decode(hcal_raw, sections, hcal_layers, strips);
+    REQUIRE(strips.size() == hcal_raw.size());
+    std::vector<unsigned int> ts_modules, bars;
+    TrigScintID::decode(ts_raw, ts_modules, bars);
+    REQUIRE(bars.size() == ts_raw.size());
+
+    DetectorIDInterpreter dii;
+    for (std::size_t i = 0; i < ecal_raw.size(); i++) {
+      EcalID eid(ecal_raw[i]);
+      CHECK(layers[i] == eid.layer());
+      CHECK(modules[i] == eid.module());
+      CHECK(cells[i] == eid.cell());
+      HcalID hid(hcal_raw[i]);
+      CHECK(sections[i] == hid.section());
+      CHECK(hcal_layers[i] == hid.layer());
+      CHECK(strips[i] == hid.strip());
+      TrigScintID tid(ts_raw[i]);
+      CHECK(ts_modules[i] == tid.module());
+      CHECK(bars[i] == tid.bar());
+
+      // one interpreter going back and forth between kinds of IDs
+      dii.setRawValue(eid);
+      CHECK(dii.getFieldValue("cell") == eid.cell());
+      dii.setRawValue(hid);
+      CHECK(dii.getFieldValue("strip") == hid.strip());
+    }
+
+    static_assert(EcalID::LayerField::get(0x1464f1f4) == 50);
+    static_assert(EcalID::CellField::pack(500) == 500);
+  }
 }
@@ -0,0 +1,132 @@
+/**
+ * @file EcalGeometryTest.cxx
+ * @brief Test the cell lookup of the EcalGeometry
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <tuple>
+
+#include "DetDescr/EcalGeometry.h"
+#include "DetDescr/EcalLayout.h"
+#include "Framework/Configure/Parameters.h"
+
+namespace ldmx {
+namespace test {
+
+/**
+ * Make an EcalGeometry, by default with a single layer
+ *
+ * @param[in] n_cell_r_height number of cell radii across a module
+ * @param[in] corners_side_up orientation of the flower
+ * @param[in] n_layers number of layers
+ */
+static std::unique_ptr<EcalGeometry> makeGeometry(double n_cell_r_height,
+                                                  bool corners_side_up,
+                                                  int n_layers = 1) {
+  std::vector<double> layer_z;
+  for (int layer{0}; layer < n_layers; layer++)
+    layer_z.push_back(7.85 + 10. * layer);
+  framework::config::Parameters params;
+  params.addParameter("layerZPositions", layer_z);
+  params.addParameter("ecalFrontZ", 240.);
+  params.addParameter("moduleMinR", 85.0);
+  params.addParameter("nCellRHeight", n_cell_r_height);
+  params.addParameter("gap", 1.5);
+  params.addParameter("cornersSideUp", corners_side_up);
+  params.addParameter("layer_shift_x", 0.);
+  params.addParameter("layer_shift_y", 0.);
+  params.addParameter("layer_shift_odd", false);
+  params.addParameter("layer_shift_odd_bilayer", false);
+  params.addParameter("verbose", 0);
+  return std::unique_ptr<EcalGeometry>(EcalGeometry::debugMake(params));
+}
+
+}  // namespace test
+}  // namespace ldmx
+
+/**
+ * Test that the module and cell found by rounding in the hexagonal grids
+ * are the ones of the TH2Poly polygons, for points all over the modules
+ * of both orientations of the flower and both cell sizes.
+ */
+TEST_CASE("EcalGeometry", "[DetDescr][functionality]") {
+  using namespace ldmx;
+  auto [n_cell_r_height, corners_side_up] =
+      GENERATE(std::make_pair(35.3, false), std::make_pair(35.3, true),
+               std::make_pair(23.32, true));
+  auto geometry{test::makeGeometry(n_cell_r_height, corners_side_up)};
+  TH2Poly* polygons{geometry->getCellPolyMap()};
+
+  double moduleR{geometry->getModuleMaxR()}, moduler{geometry->getModuleMinR()};
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> p_dist(-moduleR, moduleR),
+      q_dist(-moduler, moduler);
+  for (int module_id{0}; module_id < geometry->getNumModulesPerLayer();
+       module_id++) {
+    // the module center is a cell center minus its position in the module
+    auto [cell_x, cell_y, cell_z] =
+        geometry->getPosition(EcalID(0, module_id, 0));
+    auto [cell_p, cell_q] = geometry->getPositionInModule(0);
+    double module_x{cell_x - cell_p}, module_y{cell_y - cell_q};
+
+    for (int i{0}; i < 20000; i++) {
+      double p{p_dist(rng)}, q{q_dist(rng)};
+      // stay off the module edges, the point is only in this module
+      if (std::abs(q) > 0.999 * moduler or
+          std::sqrt(3.) * std::abs(p) + std::abs(q) >
+              0.999 * std::sqrt(3.) * moduleR)
+        continue;
+      int expected{polygons->FindBin(p, q) - 1};
+      REQUIRE(expected >= 0);
+
+      // from p,q to x,y
+      double x{p}, y{q};
+      if (corners_side_up) {
+        x = q;
+        y = -p;
+      }
+      x += module_x;
+      y += module_y;
+
+      EcalID id{geometry->getID(x, y, 0)};
+      CHECK(id.module() == module_id);
+      CHECK(id.cell() == expected);
+      CHECK(geometry->getID(x, y, 0, module_id).cell() == expected);
+    }
+  }
+
+  // the gap between the center module and the next one
+  double gap_r{moduler + 0.75};
+  double gap_x{corners_side_up ? gap_r : 0.},
+      gap_y{corners_side_up ? 0. : gap_r};
+  CHECK_THROWS(geometry->getID(gap_x, gap_y, 0));
+}
+
+/**
+ * Test that the geometries of the fixed layouts get them and the others
+ * get the dynamic layout with their own shape
+ */
+TEST_CASE("EcalLayout", "[DetDescr][functionality]") {
+  using namespace ldmx;
+  auto [n_layers, n_cell_r_height, fixed] =
+      GENERATE(std::make_tuple(34, 35.3, true), std::make_tuple(6, 35.3, true),
+               std::make_tuple(1, 35.3, false),
+               std::make_tuple(34, 23.32, false));
+  auto geometry{test::makeGeometry(n_cell_r_height, true, n_layers)};
+  std::size_t n_visited{0};
+  bool was_fixed = visitEcalLayout(*geometry, [&](auto layout) {
+    CHECK(layout.layers() == geometry->getNumLayers());
+    CHECK(layout.modules() == geometry->getNumModulesPerLayer());
+    CHECK(layout.cells() == geometry->getNumCellsPerModule());
+    CHECK(layout.size() == geometry->getNumCells());
+    for (int layer{0}; layer < layout.layers(); layer++)
+      for (int module{0}; module < layout.modules(); module++)
+        for (int cell{0}; cell < layout.cells(); cell++) n_visited++;
+    return layout.fixed();
+  });
+  CHECK(was_fixed == fixed);
+  CHECK(n_visited == geometry->getNumCells());
+}
@@ -0,0 +1,105 @@
+/**
+ * @file IDMapTest.cxx
+ * @brief Test the hash containers keyed by detector IDs
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <map>
+#include <random>
+#include <set>
+
+#include "DetDescr/EcalElectronicsID.h"
+#include "DetDescr/EcalID.h"
+#include "DetDescr/IDMap.h"
+
+/**
+ * Test IDMap and IDSet against std::map and std::set
+ *
+ * The IDs only differ in their layer and module, which are in the high
+ * bits of the raw value, so a hash of the low bits would collide.
+ */
+TEST_CASE("IDMap", "[DetDescr][functionality]") {
+  using namespace ldmx;
+
+  IDMap<EcalID, int> map;
+  IDSet<EcalID> set;
+  std::map<EcalID, int> ref;
+
+  CHECK(map.empty());
+  CHECK(map.find(EcalID(1, 1, 1)) == nullptr);
+  IDSet<DetectorID> raw_ids;
+  CHECK_THROWS(raw_ids.insert(DetectorID()));
+
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> layer(0, 33), module(0, 6), op(0, 2);
+  for (int i{0}; i < 20000; i++) {
+    EcalID id(layer(rng), module(rng), 12);
+    switch (op(rng)) {
+      case 0:
+        map[id] += i;
+        ref[id] += i;
+        set.insert(id);
+        break;
+      case 1:
+        CHECK(map.erase(id) == (ref.erase(id) == 1));
+        set.erase(id);
+        break;
+      default:
+        if (ref.count(id)) {
+          REQUIRE(map.find(id) != nullptr);
+          CHECK(*map.find(id) == ref.at(id));
+        } else {
+          CHECK(map.find(id) == nullptr);
+        }
+        CHECK(set.contains(id) == (ref.count(id) == 1));
+    }
+    REQUIRE(map.size() == ref.size());
+    REQUIRE(set.size() == ref.size());
+  }
+
+  SECTION("sorted iteration matches std::map") {
+    auto it{ref.begin()};
+    map.forEachSorted([&](EcalID id, int value) {
+      REQUIRE(it != ref.end());
+      CHECK(id == it->first);
+      CHECK(value == it->second);
+      ++it;
+    });
+    CHECK(it == ref.end());
+
+    std::set<EcalID> ids;
+    set.forEach([&](EcalID id) { ids.insert(id); });
+    CHECK(ids.size() == ref.size());
+  }
+
+  SECTION("clear keeps nothing") {
+    map.clear();
+    CHECK(map.empty());
+    for (const auto& [id, value] : ref) CHECK_FALSE(map.contains(id));
+    CHECK(map[ref.begin()->first] == 0);
+  }
+}
+
+/**
+ * Test DenseIDMap
+ */
+TEST_CASE("DenseIDMap", "[DetDescr][functionality]") {
+  using namespace ldmx;
+
+  DenseIDMap<EcalElectronicsID, double> map;
+  EcalElectronicsID a(3, 2, 1), b(1, 2, 3);
+  map[b] = 2.;
+  map[a] = 1.;
+  CHECK(map.size() == 2);
+  CHECK(*map.find(a) == 1.);
+  CHECK(map.find(EcalElectronicsID(0, 0, 0)) == nullptr);
+  CHECK_FALSE(map.emplace(a, 5.).second);
+
+  std::vector<EcalElectronicsID> order;
+  map.forEachSorted([&](EcalElectronicsID id, double) { order.push_back(id); });
+  REQUIRE(order.size() == 2);
+  CHECK(order[0].index() < order[1].index());
+
+  map.clear();
+  CHECK(map.empty());
+  CHECK_FALSE(map.contains(a));
+}
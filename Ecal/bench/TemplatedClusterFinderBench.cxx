@@ -0,0 +1,134 @@
+/**
+ * @file TemplatedClusterFinderBench.cxx
+ * @brief Benchmark the clustering of the ECal hits
+ */
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "DetDescr/EcalGeometry.h"
+#include "Ecal/Event/EcalHit.h"
+#include "Ecal/MyClusterWeight.h"
+#include "Ecal/TemplatedClusterFinder.h"
+#include "Framework/Configure/Parameters.h"
+
+namespace ecal {
+namespace bench {
+
+/// Make the EcalGeometry of the v14 detector
+static std::unique_ptr<ldmx::EcalGeometry> makeGeometry() {
+  framework::config::Parameters params;
+  params.addParameter(
+      "layerZPositions",
+      std::vector<double>{
+          7.932,   14.532,  32.146,  40.746,  58.110,  67.710,  86.574,
+          96.774,  115.638, 125.838, 144.702, 154.902, 173.766, 183.966,
+          202.830, 213.030, 231.894, 242.094, 260.958, 271.158, 290.022,
+          300.222, 319.086, 329.286, 351.650, 365.250, 387.614, 401.214,
+          423.578, 437.178, 459.542, 473.142, 495.506, 509.106});
+  params.addParameter("ecalFrontZ", 240.);
+  params.addParameter("moduleMinR", 85.0);
+  params.addParameter("nCellRHeight", 35.3);
+  params.addParameter("gap", 1.5);
+  params.addParameter("cornersSideUp", true);
+  params.addParameter("layer_shift_x", 2 * 85.0 / 35.3);
+  params.addParameter("layer_shift_y", 0.);
+  params.addParameter("layer_shift_odd", true);
+  params.addParameter("layer_shift_odd_bilayer", false);
+  params.addParameter("verbose", 0);
+  return std::unique_ptr<ldmx::EcalGeometry>(
+      ldmx::EcalGeometry::debugMake(params));
+}
+
+/**
+ * The hits of an event with a few showers
+ *
+ * Each shower deposits most of its energy in a cell and its nearest
+ * neighbors of consecutive layers, with the energy falling off with
+ * depth, and the rest of the hits are spread over the ECal. They are
+ * drawn from a fixed seed, so every run and every build clusters the
+ * same hits.
+ *
+ * @param[in] geometry the ECal geometry
+ * @param[in] n_hits number of hits in the event
+ */
+static std::vector<ldmx::EcalHit> recordedHits(
+    const ldmx::EcalGeometry& geometry, int n_hits) {
+  std::mt19937 rng(13);
+  std::uniform_int_distribution<int> layer(0, geometry.getNumLayers() - 1),
+      module(0, geometry.getNumModulesPerLayer() - 1),
+      cell(0, geometry.getNumCellsPerModule() - 1);
+  std::exponential_distribution<double> energy(1. / 5.);
+
+  std::vector<ldmx::EcalHit> hits;
+  auto add = [&](ldmx::EcalID id, double e) {
+    ldmx::EcalHit hit;
+    hit.setID(id.raw());
+    hit.setEnergy(e);
+    hits.push_back(hit);
+  };
+
+  // three showers starting at the front of the ECal with a quarter
+  //  of the hits each
+  for (int i_shower{0}; i_shower < 3; i_shower++) {
+    ldmx::EcalID seed(0, module(rng), cell(rng));
+    int shower_end{(i_shower + 1) * n_hits / 4};
+    for (int i_layer{0};
+         i_layer < geometry.getNumLayers() and int(hits.size()) < shower_end;
+         i_layer++) {
+      ldmx::EcalID center(i_layer, seed.module(), seed.cell());
+      double scale{std::exp(-0.15 * i_layer)};
+      add(center, 100. * scale);
+      for (ldmx::EcalID neighbor : geometry.getNN(center))
+        add(neighbor, energy(rng) * scale);
+    }
+  }
+
+  // the rest spread over the ECal
+  while (int(hits.size()) < n_hits)
+    add(ldmx::EcalID(layer(rng), module(rng), cell(rng)), energy(rng));
+  return hits;
+}
+
+}  // namespace bench
+}  // namespace ecal
+
+/**
+ * Cluster the recorded hits of an event, merging the clusters one
+ * pair at a time
+ */
+static void BM_TemplatedClusterFinder_cluster(benchmark::State& state) {
+  using namespace ecal;
+  auto geometry{bench::makeGeometry()};
+  const auto hits{bench::recordedHits(*geometry, state.range(0))};
+  for (auto _ : state) {
+    TemplatedClusterFinder<MyClusterWeight> cf;
+    for (const auto& hit : hits) cf.add(&hit, *geometry);
+    cf.cluster(100., 10.);
+    benchmark::DoNotOptimize(cf);
+  }
+  state.SetItemsProcessed(state.iterations() * hits.size());
+}
+BENCHMARK(BM_TemplatedClusterFinder_cluster)->Arg(100)->Arg(300);
+
+/**
+ * Cluster the recorded hits of an event, merging the clusters in order
+ * of their weights kept in a queue
+ */
+static void BM_TemplatedClusterFinder_clusterWithQueue(
+    benchmark::State& state) {
+  using namespace ecal;
+  auto geometry{bench::makeGeometry()};
+  const auto hits{bench::recordedHits(*geometry, state.range(0))};
+  for (auto _ : state) {
+    TemplatedClusterFinder<MyClusterWeight> cf;
+    for (const auto& hit : hits) cf.add(&hit, *geometry);
+    cf.clusterWithQueue(100., 10.);
+    benchmark::DoNotOptimize(cf);
+  }
+  state.SetItemsProcessed(state.iterations() * hits.size());
+}
+BENCHMARK(BM_TemplatedClusterFinder_clusterWithQueue)->Arg(100)->Arg(300);
@@ -8,6 +8,10 @@
 #ifndef EVENTPROC_DNNECALVETOPROCESSOR_H_
 #define EVENTPROC_DNNECALVETOPROCESSOR_H_
 
+// STL
+#include <map>
+#include <utility>
+
 // LDMX
 #include "DetDescr/EcalGeometry.h"
 #include "Ecal/Event/EcalHit.h"
@@ -28,39 +32,106 @@ class DNNEcalVetoProcessor : public framework::Producer {
   DNNEcalVetoProcessor(const std::string& name, framework::Process& process);
   virtual ~DNNEcalVetoProcessor() {}
   void configure(framework::config::Parameters& parameters) final override;
+  /// Load the model into an ONNX session
+  void onProcessStart() final override;
   void produce(framework::Event& event);
+  /// Run the DNN once over all of the events of the batch
+  void produceBatch(
+      const std::vector<framework::Event*>& events) final override;
 
  private:
+  /**
+   * Store the veto result of the input discriminator value in an event.
+   * @param event The event to store the result in.
+   * @param disc The DNN discriminator value (-99 if it was not run).
+   */
+  void add_result(framework::Event& event, float disc);
+
+  /**
+   * Get the binding for a batch size and number of points.
+   *
+   * The bindings are kept for the following events, so the arrays are
+   * only allocated the first time a shape is used.
+   * @param batch_size The number of events in the batch.
+   * @param n_points The number of points of each event.
+   * @return The binding of that shape.
+   */
+  ldmx::Ort::ONNXRuntime::Binding& binding(std::size_t batch_size,
+                                           unsigned int n_points);
+
+  /**
+   * Get the number of points to give the DNN for a number of hits.
+   *
+   * This is max_num_hits_ unless the model takes a dynamic number of
+   * points, then it is the number of hits rounded up to a multiple of
+   * point_step_ so only a few shapes are bound.
+   * @param nhits The largest number of hits of the events to run on.
+   * @return The number of points of each event.
+   */
+  unsigned int num_points(std::size_t nhits) const;
+
   /**
    * Make inputs to the DNN from ECAL RecHits.
    * @param ecalRecHits The EcalHit collection.
+   * @param binding The bound inputs to write into.
+   * @param i_event The index of the event in the batch of the binding.
+   * @param n_points The number of points of each event in the binding.
    */
   void make_inputs(const ldmx::EcalGeometry& geom,
-                   const std::vector<ldmx::EcalHit>& ecalRecHits);
+                   const std::vector<ldmx::EcalHit>& ecalRecHits,
+                   ldmx::Ort::ONNXRuntime::Binding& binding,
+                   std::size_t i_event, unsigned int n_points);
+
+  /**
+   * Zero the inputs of an event in a binding.
+   * @param binding The bound inputs to clear.
+   * @param i_event The index of the event in the batch of the binding.
+   * @param n_points The number of points of each event in the binding.
+   */
+  void clear_inputs(ldmx::Ort::ONNXRuntime::Binding& binding,
+                    std::size_t i_event, unsigned int n_points);
 
  private:
   /** Maximum number of hits allowed in ECAL. Events with more hits will be
    * marked as BKG directly without running the DNN. */
   constexpr static unsigned int max_num_hits_ = 50;
 
+  /** Step the number of points is rounded up to with dynamic points. */
+  constexpr static unsigned int point_step_ = 10;
+
+  /**
+   * The inputs of an event have the layout (dim, point), so each
+   * coordinate and feature takes n_points entries one after the other.
+   */
   constexpr static unsigned int n_coordinate_dim_ = 3;
   constexpr static unsigned int coordinate_x_offset_ = 0;
-  constexpr static unsigned int coordinate_y_offset_ = max_num_hits_;
-  constexpr static unsigned int coordinate_z_offset_ = 2 * max_num_hits_;
+  constexpr static unsigned int coordinate_y_offset_ = 1;
+  constexpr static unsigned int coordinate_z_offset_ = 2;
 
   constexpr static unsigned int n_feature_dim_ = 5;
   constexpr static unsigned int feature_x_offset_ = 0;
-  constexpr static unsigned int feature_y_offset_ = max_num_hits_;
-  constexpr static unsigned int feature_z_offset_ = 2 * max_num_hits_;
-  constexpr static unsigned int feature_layerid_offset_ = 3 * max_num_hits_;
-  constexpr static unsigned int feature_energy_offset_ = 4 * max_num_hits_;
+  constexpr static unsigned int feature_y_offset_ = 1;
+  constexpr static unsigned int feature_z_offset_ = 2;
+  constexpr static unsigned int feature_layerid_offset_ = 3;
+  constexpr static unsigned int feature_energy_offset_ = 4;
 
   const static std::vector<std::string> input_names_;
-  const static std::vector<unsigned int> input_sizes_;
+  /** Number of dimensions of each input, the size is that times points. */
+  const static std::vector<unsigned int> input_dims_;
 
   float disc_cut_ = -99;
-  std::vector<std::vector<float>> data_;
-  std::unique_ptr<ldmx::Ort::ONNXRuntime> rt_;
+  /** Path to the ONNX model file, loaded in onProcessStart. */
+  std::string model_path_;
+  /** Threads, optimizations and execution provider of the ONNX session. */
+  ldmx::Ort::ONNXRuntime::Options onnx_options_;
+  /** The session of the model, shared with the other users of the model. */
+  std::shared_ptr<const ldmx::Ort::ONNXRuntime> rt_;
+  /** Does the model take a dynamic number of points? */
+  bool dynamic_points_{false};
+  /** Inputs and outputs of the DNN bound by batch size and points. */
+  std::map<std::pair<std::size_t, unsigned int>,
+           std::unique_ptr<ldmx::Ort::ONNXRuntime::Binding>>
+      bindings_;
 
   /** Name of the collection which will containt the results. */
   std::string collectionName_{"DNNEcalVeto"};
@@ -60,6 +60,8 @@ class EcalClusterProducer : public framework::Producer {
  private:
   double seedThreshold_{0};
   double cutoff_{0};
+  /// Find the merges with a queue instead of scanning all the pairs
+  bool useMergeQueue_{true};
   std::string digisPassName_;
   std::string algoCollName_;
   std::string clusterCollName_;
@@ -24,6 +24,8 @@
 #include "Recon/Event/EventConstants.h"
 #include "Recon/Event/HgcrocDigiCollection.h"
 #include "SimCore/Event/SimCalorimeterHit.h"
+#include "SimCore/Event/SimCalorimeterHitCollection.h"
+#include "Tools/EmptyChannelSampler.h"
 #include "Tools/HgcrocEmulator.h"
 #include "Tools/NoiseGenerator.h"
 
@@ -69,6 +71,9 @@ class EcalDigiProducer : public framework::Producer {
   /// input pass name
   std::string inputPassName_;
 
+  /// are the input hits a SimCalorimeterHitCollection
+  bool packedSimHits_;
+
   /// output hit collection name
   std::string digiCollName_;
 
@@ -98,6 +103,20 @@ class EcalDigiProducer : public framework::Producer {
    */
   bool zero_suppression_;
 
+  /**
+   * Should we pack the DIGIs before putting them into the event?
+   *
+   * @see ldmx::HgcrocDigiCollection::pack
+   * They take much less room on disk and read the same afterwards.
+   */
+  bool pack_digis_;
+
+  /// Number of threads digitizing the hit channels of an event
+  int n_digi_threads_;
+
+  /// Draw the noise of each hit channel from a stream of its own
+  bool channel_noise_streams_;
+
   ///////////////////////////////////////////////////////////////////////////////////////
   // Other member variables
 
@@ -108,6 +127,12 @@ class EcalDigiProducer : public framework::Producer {
   /// Hgcroc Emulator to digitize analog voltage signals
   std::unique_ptr<ldmx::HgcrocEmulator> hgcroc_;
 
+  /// Conditions, noise generator and buffers of the emulator
+  std::unique_ptr<ldmx::HgcrocEmulator::Context> hgcrocContext_;
+
+  /// Pulses of the hit channels of an event, digitized together
+  ldmx::HgcrocEmulator::Batch hgcrocBatch_;
+
   /// Total number of channels in the ECal
   int nTotalChannels_;
 
@@ -119,6 +144,9 @@ class EcalDigiProducer : public framework::Producer {
 
   /// Generates Gaussian noise on top of real hits
   std::unique_ptr<TRandom3> noiseInjector_;
+
+  /// Draws the empty channels to put the noise hits in
+  std::unique_ptr<ldmx::EmptyChannelSampler> noiseChannels_;
 };
 }  // namespace ecal
 
@@ -0,0 +1,119 @@
+/**
+ * @file EcalHitGrid.h
+ * @brief Dense per-event map of the ECal cells that were hit
+ */
+
+#ifndef ECAL_ECALHITGRID_H_
+#define ECAL_ECALHITGRID_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "DetDescr/EcalGeometry.h"
+#include "DetDescr/EcalID.h"
+#include "Ecal/Event/EcalHit.h"
+
+namespace ecal {
+
+/**
+ * Dense map from the ECal cells to the energy deposited in them
+ *
+ * This is an array over all of the cells of the geometry (indexed by
+ * EcalGeometry::getCellIndex) so looking up a cell is a single load
+ * instead of the walk down a tree a std::map<EcalID,float> does. The
+ * cells that were hit are also kept in a list so that clearing the grid
+ * between events only touches those cells and not the whole array.
+ *
+ * ```cpp
+ * grid.reset(geometry);
+ * grid.fill(hits);
+ * for (ldmx::EcalID neighbor : geometry.getNN(id)) {
+ *   if (grid.has(neighbor)) { ... }
+ * }
+ * ```
+ */
+class EcalHitGrid {
+ public:
+  /**
+   * Prepare the grid for a new event
+   *
+   * The grid is sized to the input geometry if it hasn't been already
+   * and otherwise only the cells hit in the last event are cleared.
+   *
+   * @param[in] geometry geometry of the ECal the hits are in
+   */
+  void reset(const ldmx::EcalGeometry& geometry);
+
+  /**
+   * Put a cell into the grid
+   *
+   * Like std::map::emplace, nothing is changed if the cell is already
+   * in the grid.
+   *
+   * @param[in] id cell that was hit
+   * @param[in] energy energy deposited in the cell
+   * @return true if the cell was put into the grid
+   */
+  bool insert(ldmx::EcalID id, float energy) {
+    std::size_t i{geometry_->getCellIndex(id)};
+    if (hit_[i]) return false;
+    hit_[i] = true;
+    energy_[i] = energy;
+    ids_.push_back(id);
+    return true;
+  }
+
+  /**
+   * Put all of the input hits into the grid
+   *
+   * @param[in] hits the hits of the event
+   */
+  void fill(const std::vector<ldmx::EcalHit>& hits);
+
+  /**
+   * Check if a cell is in the grid
+   *
+   * @param[in] id cell to check
+   * @return true if the cell was put into the grid
+   */
+  bool has(ldmx::EcalID id) const {
+    return hit_[geometry_->getCellIndex(id)];
+  }
+
+  /**
+   * Get the energy deposited in a cell
+   *
+   * @param[in] id cell to look up
+   * @return energy in the cell, zero if it is not in the grid
+   */
+  float energy(ldmx::EcalID id) const {
+    return energy_[geometry_->getCellIndex(id)];
+  }
+
+  /**
+   * Get the cells in the grid, in the order they were put in
+   *
+   * @return list of the cells that were hit
+   */
+  const std::vector<ldmx::EcalID>& ids() const { return ids_; }
+
+  /// @return number of cells in the grid
+  std::size_t size() const { return ids_.size(); }
+
+  /// @return true if no cells are in the grid
+  bool empty() const { return ids_.empty(); }
+
+ private:
+  /// geometry used to index the cells
+  const ldmx::EcalGeometry* geometry_{nullptr};
+  /// energy in each cell of the ECal
+  std::vector<float> energy_;
+  /// true for each cell that was hit
+  std::vector<char> hit_;
+  /// the cells that were hit, so we only clear those
+  std::vector<ldmx::EcalID> ids_;
+};
+
+}  // namespace ecal
+
+#endif  // ECAL_ECALHITGRID_H_
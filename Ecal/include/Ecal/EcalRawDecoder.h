@@ -6,6 +6,8 @@
 //----------//
 #include "Framework/EventProcessor.h"
 
+#include <vector>
+
 namespace ecal {
 
 /**
@@ -43,6 +45,19 @@ class EcalRawDecoder : public framework::Producer {
   int roc_version_;
   /// should we translate electronic IDs to detector IDs
   bool translate_eid_;
+
+  /**
+   * Position in channels_ of each electronics ID index, -1 if it was
+   * not read out in this event
+   *
+   * This is sized to EcalElectronicsID::MAX_INDEX once and only the
+   * entries of the channels read out are reset after each event.
+   */
+  std::vector<int> channel_of_index_;
+  /// electronics ID indices read out in this event, in order of appearance
+  std::vector<unsigned int> channels_;
+  /// the channel and the word of each sample, in the order they were read
+  std::vector<std::pair<int, uint32_t>> samples_;
 };
 }  // namespace ecal
 
@@ -1,6 +1,9 @@
 #ifndef ECAL_ECALRAWENCODER_H_
 #define ECAL_ECALRAWENCODER_H_
 
+#include <cstdint>
+#include <vector>
+
 //----------//
 //   LDMX   //
 //----------//
@@ -10,6 +13,15 @@ namespace ecal {
 
 /**
  * @class EcalRawEncoder
+ *
+ * Encode the ECal digis into the DAQ format, one FPGA packet after another
+ * for each bunch (sample).
+ *
+ * The digis are put in electronics order by a counting sort over the
+ * links of the dense electronics index, so the lengths of all of the
+ * packets are known before anything is written. The words are then
+ * written into a buffer of the final size in one pass, with the
+ * checksums calculated along the way.
  */
 class EcalRawEncoder : public framework::Producer {
  public:
@@ -40,6 +52,30 @@ class EcalRawEncoder : public framework::Producer {
   std::string output_name_;
   /// version of HGC ROC we are decoding
   int roc_version_;
+
+  /// A link with digis in the event, in electronics order
+  struct Link {
+    /// fiber (FPGA) and elink of the link
+    uint32_t fiber, elink;
+    /// channels read out on the link, including the ROC header and CRC
+    uint64_t ro_map;
+    /// number of digis on the link
+    uint32_t n_digis;
+  };
+
+  /// links with digis in this event, in electronics order
+  std::vector<Link> links_;
+  /// number of digis on each link of the electronics index, zero between
+  /// events
+  std::vector<uint32_t> link_count_;
+  /// links of the electronics index that have digis in this event
+  std::vector<uint32_t> touched_;
+  /// electronics index of each digi
+  std::vector<unsigned int> digi_index_;
+  /// digis grouped by link
+  std::vector<uint32_t> by_link_;
+  /// sample words of the digis in electronics order, one bunch after another
+  std::vector<uint32_t> samples_;
 };
 }  // namespace ecal
 
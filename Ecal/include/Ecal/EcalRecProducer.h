@@ -19,6 +19,7 @@
 //----------//
 #include "DetDescr/DetectorID.h"
 #include "DetDescr/EcalID.h"
+#include "Ecal/EcalReconConditions.h"
 #include "Framework/EventProcessor.h"
 
 namespace ecal {
@@ -70,6 +71,9 @@ class EcalRecProducer : public framework::Producer {
   /// simhit pass name
   std::string simHitPassName_;
 
+  /// are the sim hits a SimCalorimeterHitCollection
+  bool packedSimHits_;
+
   /// output hit collection name
   std::string recHitCollName_;
 
@@ -101,6 +105,16 @@ class EcalRecProducer : public framework::Producer {
    * of a calibration number.
    */
   double secondOrderEnergyCorrection_;
+
+  /// copy the conditions table into columns when it is loaded
+  bool columnar_;
+
+  /// handle to the table the reconstruction conditions are built from
+  framework::ConditionsHandle conditions_handle_{
+      EcalReconConditions::CONDITIONS_NAME};
+
+  /// reconstruction conditions, kept until the table changes
+  std::unique_ptr<EcalReconConditions> conditions_;
 };
 }  // namespace ecal
 
@@ -2,7 +2,10 @@
 #ifndef ECAL_ECALRECONCONDTIONS_H_
 #define ECAL_ECALRECONCONDTIONS_H_
 
+#include <memory>
+
 #include "Conditions/SimpleTableCondition.h"
+#include "Conditions/TableColumns.h"
 #include "DetDescr/EcalID.h"
 
 namespace ecal {
@@ -43,9 +46,12 @@ class EcalReconConditions {
    *
    * @param[in] table double table of reconstruction conditions
    * @param[in] validate true if you want to check the columns
+   * @param[in] columnar true if you want to copy the table into columns
+   * indexed by cell and module (see conditions::TableColumns) so that
+   * the accessors below do not search the table keys
    */
   EcalReconConditions(const conditions::DoubleTableCondition& table,
-                      bool validate = true);
+                      bool validate = true, bool columnar = false);
 
   /**
    * get the ADC pedestal
@@ -54,6 +60,7 @@ class EcalReconConditions {
    * @returns the ADC pedestal for that chip in counts
    */
   double adcPedestal(const ldmx::EcalID& id) const {
+    if (columns_) return columns_->get(id.raw(), IADC_PEDESTAL);
     return the_table_.get(id.raw(), IADC_PEDESTAL);
   }
 
@@ -68,6 +75,7 @@ class EcalReconConditions {
    * @returns the ADC threshold for that chip in fC/counts
    */
   double adcGain(const ldmx::EcalID& id) const {
+    if (columns_) return columns_->get(id.raw(), IADC_GAIN);
     return the_table_.get(id.raw(), IADC_GAIN);
   }
 
@@ -78,6 +86,7 @@ class EcalReconConditions {
    * @returns the TOT pedestal for that chip in counts
    */
   double totPedestal(const ldmx::EcalID& id) const {
+    if (columns_) return columns_->get(id.raw(), ITOT_PEDESTAL);
     return the_table_.get(id.raw(), ITOT_PEDESTAL);
   }
 
@@ -92,12 +101,29 @@ class EcalReconConditions {
    * @returns the TOT gain for that chip in fC/counts
    */
   double totGain(const ldmx::EcalID& id) const {
+    if (columns_) return columns_->get(id.raw(), ITOT_GAIN);
     return the_table_.get(id.raw(), ITOT_GAIN);
   }
 
+  /**
+   * get all the conditions of a chip at once
+   *
+   * The chip is only looked up once, the conditions are then read
+   * with the column indices above.
+   *
+   * @param[in] id ECal ID for specific chip
+   * @returns view of the conditions for that chip
+   */
+  conditions::TableRow<double> row(const ldmx::EcalID& id) const {
+    if (columns_) return columns_->row(id.raw());
+    return the_table_.row(id.raw());
+  }
+
  private:
   /// reference to the table of conditions storing the chip conditions
   const conditions::DoubleTableCondition& the_table_;
+  /// the table copied into columns, null if not columnar
+  std::unique_ptr<const conditions::TableColumns<double>> columns_;
 };  // EcalReconConditions
 
 }  // namespace ecal
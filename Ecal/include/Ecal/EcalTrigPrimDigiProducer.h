@@ -12,6 +12,8 @@
 //----------------//
 #include "Framework/EventProcessor.h"
 
+#include <vector>
+
 namespace ecal {
 
 /**
@@ -54,6 +56,18 @@ class EcalTrigPrimDigiProducer : public framework::Producer {
 
   /** Conditions object for the calibration information */
   std::string condObjName_;
+
+  /**
+   * Linear charge summed into each trigger cell of the event
+   *
+   * Indexed by the layer, module and cell fields of the trigger ID so it
+   * is ordered like the raw IDs. It only grows to the largest index seen
+   * and the entries are zeroed again after each event.
+   */
+  std::vector<unsigned int> linearCharge_;
+
+  /** Raw IDs of the trigger cells with charge in this event */
+  std::vector<unsigned int> filled_;
 };
 }  // namespace ecal
 
@@ -14,7 +14,7 @@
 #include "Framework/ConditionsObject.h"
 
 // STL
-#include <map>
+#include <tuple>
 #include <vector>
 
 namespace ldmx {
@@ -41,6 +41,17 @@ class EcalTriggerGeometry : public framework::ConditionsObject {
   std::vector<ldmx::EcalID> contentsOfTriggerCell(
       ldmx::EcalTriggerID triggerCell) const;
 
+  /**
+   * Returns the in-module cell numbers of the precision cells associated
+   * with the given trigger cell number, which are the same for all modules
+   * and layers. The center cell is the fifth one. Empty if there is no
+   * such trigger cell.
+   *
+   * This avoids building the full IDs of contentsOfTriggerCell when only
+   * the cells are needed.
+   */
+  const std::vector<int>& cellsInTriggerCell(int triggerCell) const;
+
   /**
    * Returns the set of precision (full-granularity/DAQ) cell which is the
    * center of the given trigger cell.
@@ -83,12 +94,14 @@ class EcalTriggerGeometry : public framework::ConditionsObject {
   int symmetry_;
   /** Reference to the Ecal geometry used for trigger geometry information */
   const ldmx::EcalGeometry* ecalGeometry_;
-  /** Map of precision cells to trigger cells, under symmetry assumptions
+  /** Trigger cell of each in-module precision cell number (-1 if none),
+   * under symmetry assumptions
    */
-  std::map<ldmx::EcalID, ldmx::EcalTriggerID> precision2trigger_;
-  /** Map of trigger cells to precision cells, under symmetry assumptions
+  std::vector<int> cell2trigger_;
+  /** In-module precision cell numbers of each trigger cell number, under
+   * symmetry assumptions
    */
-  std::map<ldmx::EcalTriggerID, std::vector<ldmx::EcalID> > trigger2precision_;
+  std::vector<std::vector<int> > trigger2cells_;
 };
 
 }  // namespace ecal
@@ -10,6 +10,7 @@
 // LDMX
 #include "DetDescr/EcalGeometry.h"
 #include "DetDescr/EcalID.h"
+#include "Ecal/EcalHitGrid.h"
 #include "Ecal/Event/EcalHit.h"
 #include "Ecal/Event/EcalVetoResult.h"
 #include "Framework/Configure/Parameters.h"
@@ -49,6 +50,10 @@ class EcalVetoProcessor : public framework::Producer {
 
   void produce(framework::Event& event);
 
+  /// Run the BDT once over all of the events of the batch
+  void produceBatch(
+      const std::vector<framework::Event*>& events) final override;
+
   // MIP tracking:  Class for storing hit information for tracking in a
   // convenient way
   struct HitData {
@@ -59,20 +64,50 @@ class EcalVetoProcessor : public framework::Producer {
  private:
   void clearProcessor();
 
+  /**
+   * Compute the veto variables of an event and set them on the result
+   *
+   * @param[in] event the event to compute the variables of
+   * @param[out] result the veto result to set the variables of
+   * @return true if the recoil electron projects inside of the ECal face
+   */
+  bool computeVariables(framework::Event& event, ldmx::EcalVetoResult& result);
+
+  /**
+   * Write the BDT features of a result into the bound BDT input
+   *
+   * @param[in] result the veto result with the variables set
+   * @param[in,out] binding the bound BDT arrays
+   * @param[in] i_event index of the event in the batch of the binding
+   */
+  void setBDTFeatures(const ldmx::EcalVetoResult& result,
+                      ldmx::Ort::ONNXRuntime::Binding& binding,
+                      std::size_t i_event);
+
+  /**
+   * Set the veto decision on a result and add it to its event
+   *
+   * @param[in] event the event to add the result to
+   * @param[in] result the veto result with the variables set
+   * @param[in] inside true if the recoil electron projects inside the ECal
+   * @param[in] pred BDT prediction of the event (unused without the BDT)
+   */
+  void addResult(framework::Event& event, ldmx::EcalVetoResult& result,
+                 bool inside, float pred);
+
   /* Function to calculate the energy weighted shower centroid */
   ldmx::EcalID GetShowerCentroidIDAndRMS(
       const std::vector<ldmx::EcalHit>& ecalRecHits, double& showerRMS);
 
   /* Function to load up empty vector of hit maps */
   void fillHitMap(const std::vector<ldmx::EcalHit>& ecalRecHits,
-                  std::map<ldmx::EcalID, float>& cellMap_);
+                  EcalHitGrid& cellMap_);
 
   /* Function to take loaded hit maps and find isolated hits in them */
   void fillIsolatedHitMap(const std::vector<ldmx::EcalHit>& ecalRecHits,
                           ldmx::EcalID globalCentroid,
-                          std::map<ldmx::EcalID, float>& cellMap_,
-                          std::map<ldmx::EcalID, float>& cellMapIso_,
-                          bool doTight = false);
+                          const EcalHitGrid& cellMap_,
+                          EcalHitGrid& cellMapIso_, bool doTight = false);
 
   std::vector<XYCoords> getTrajectory(std::vector<double> momentum,
                                       std::vector<float> position);
@@ -90,7 +125,8 @@ class EcalVetoProcessor : public framework::Producer {
    * @param[in] w2 A second, distinct point on line w
    * @returns Closest distance of approach of lines u and v
    */
-  float distTwoLines(TVector3 v1, TVector3 v2, TVector3 w1, TVector3 w2);
+  float distTwoLines(const TVector3& v1, const TVector3& v2,
+                     const TVector3& w1, const TVector3& w2);
   /**
    * Return the minimum distance between the point h1 and the line passing
    * through points p1 and p2.
@@ -100,11 +136,35 @@ class EcalVetoProcessor : public framework::Producer {
    * @param[in] p2 A second, distinct point on the line
    * @returns Minimum distance between h1 and the line
    */
-  float distPtToLine(TVector3 h1, TVector3 p1, TVector3 p2);
+  float distPtToLine(const TVector3& h1, const TVector3& p1,
+                     const TVector3& p2);
 
  private:
-  std::map<ldmx::EcalID, float> cellMap_;
-  std::map<ldmx::EcalID, float> cellMapTightIso_;
+  EcalHitGrid cellMap_;
+  EcalHitGrid cellMapTightIso_;
+
+  /**
+   * Where each rec hit is relative to the trajectories
+   *
+   * This is filled once per event, with one entry per rec hit, so that the
+   * longitudinal segment and containment region sums are plain loops
+   * over these arrays.
+   */
+  struct ContainmentHits {
+    /// global position of the hit
+    std::vector<double> x, y;
+    /// distance from the electron and photon trajectories, -1 if missing
+    std::vector<float> distEle, distPhoton;
+    /// longitudinal segment of the hit, number of segments if none
+    std::vector<unsigned char> segment;
+    /// electron and photon containment region, number of regions if none
+    std::vector<unsigned char> eleRegion, photonRegion;
+    /// bit i is set if the hit is outside of region i of both trajectories
+    std::vector<unsigned char> outside;
+    /// empty all the arrays (but keep their memory)
+    void clear();
+  };
+  ContainmentHits containmentHits_;
 
   std::vector<float> ecalLayerEdepRaw_;
   std::vector<float> ecalLayerEdepReadout_;
@@ -165,10 +225,21 @@ class EcalVetoProcessor : public framework::Producer {
   std::string rec_pass_name_;
   std::string rec_coll_name_;
 
+  /// Handles to the products we read every event
+  framework::ProductHandle sim_particles_handle_;
+  framework::ProductHandle ecal_sp_hits_handle_;
+  framework::ProductHandle target_sp_hits_handle_;
+  framework::ProductHandle rec_hits_handle_;
+
   /** Name of the collection which will containt the results. */
   std::string collectionName_{"EcalVeto"};
 
-  std::unique_ptr<ldmx::Ort::ONNXRuntime> rt_;
+  /// session of the BDT, shared with the other users of the model
+  std::shared_ptr<const ldmx::Ort::ONNXRuntime> rt_;
+  /// BDT input and output bound for a single event
+  std::unique_ptr<ldmx::Ort::ONNXRuntime::Binding> binding_;
+  /// BDT input and output bound for the last batch size
+  std::unique_ptr<ldmx::Ort::ONNXRuntime::Binding> batchBinding_;
 
   /// handle to current geometry (to share with member functions)
   const ldmx::EcalGeometry* geometry_;
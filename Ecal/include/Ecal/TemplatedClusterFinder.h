@@ -7,7 +7,12 @@
 
 #include <math.h>
 
+#include <algorithm>
+#include <functional>
 #include <map>
+#include <queue>
+#include <tuple>
+#include <vector>
 
 #include "Ecal/WorkingCluster.h"
 #include "TH2F.h"
@@ -82,6 +87,107 @@ class TemplatedClusterFinder {
     finalwgt_ = minwgt;
   }
 
+  /**
+   * Cluster with a queue of the candidate merges
+   *
+   * This makes the same merges, in the same order, as cluster but
+   * keeps the weights of the candidate pairs in a priority queue
+   * instead of re-computing all of them for each merge. When two
+   * clusters merge, the pairs with either of them are invalidated
+   * (lazily, when they reach the top of the queue) and only the
+   * pairs with the merged cluster are re-computed. This takes
+   * O(n^2 log n) instead of O(n^3) in the number of hits.
+   *
+   * As in cluster, only the seeds before the first cluster below
+   * the seed threshold (in the initial energy order) can be the first
+   * cluster of a pair and equal weights are broken by the order of
+   * the clusters.
+   */
+  void clusterWithQueue(double seed_threshold, double cutoff) {
+    int ncluster = clusters_.size();
+    double minwgt = cutoff;
+
+    std::sort(clusters_.begin(), clusters_.end(), compClusters);
+
+    // number of times each cluster has changed, to invalidate the pairs
+    std::vector<unsigned int> version(clusters_.size(), 0);
+    std::priority_queue<Merge, std::vector<Merge>, std::greater<Merge>> merges;
+    auto push = [&](std::size_t i, std::size_t j) {
+      merges.push(
+          {wgt_(clusters_[i], clusters_[j]), i, j, version[i], version[j]});
+    };
+
+    // the clusters before first_nonseed that are not empty are seeds
+    // this only moves forward since a cluster below the seed threshold
+    // can only be merged away, not into
+    std::size_t first_nonseed = 0;
+    int nseeds = 0;
+    auto advance = [&]() {
+      for (; first_nonseed < clusters_.size(); first_nonseed++) {
+        const auto& seed = clusters_[first_nonseed];
+        if (seed.empty()) continue;
+        if (seed.centroid().E() < seed_threshold) break;
+        nseeds++;
+        for (std::size_t j = first_nonseed + 1; j < clusters_.size(); j++) {
+          if (!clusters_[j].empty()) push(first_nonseed, j);
+        }
+      }
+    };
+    advance();
+
+    do {
+      bool any = false;
+      std::size_t mi(0), mj(0);
+      while (!merges.empty()) {
+        const Merge& top = merges.top();
+        if (top.version_i == version[top.i] &&
+            top.version_j == version[top.j]) {
+          any = true;
+          minwgt = top.wgt;
+          mi = top.i;
+          mj = top.j;
+          break;
+        }
+        merges.pop();
+      }
+
+      nseeds_ = nseeds;
+      transitionWeights_.insert(std::pair<int, double>(ncluster, minwgt));
+
+      // there are no pairs left to merge
+      if (!any) break;
+
+      if (minwgt < cutoff) {
+        merges.pop();
+        // put the bigger one in mi
+        if (clusters_[mi].centroid().E() < clusters_[mj].centroid().E()) {
+          std::swap(mi, mj);
+        }
+        // now we have the smallest, merge
+        clusters_[mi].add(clusters_[mj]);
+        clusters_[mj].clear();
+        version[mi]++;
+        version[mj]++;
+        if (mj < first_nonseed) nseeds--;
+        // decrement cluster count
+        ncluster--;
+
+        // re-compute the pairs with the merged cluster
+        for (std::size_t i = 0; i < std::min(mi, first_nonseed); i++) {
+          if (!clusters_[i].empty()) push(i, mi);
+        }
+        if (mi < first_nonseed) {
+          for (std::size_t j = mi + 1; j < clusters_.size(); j++) {
+            if (!clusters_[j].empty()) push(mi, j);
+          }
+        }
+        advance();
+      }
+
+    } while (minwgt < cutoff && ncluster > 1);
+    finalwgt_ = minwgt;
+  }
+
   double getYMax() const { return finalwgt_; }
 
   int getNSeeds() const { return nseeds_; }
@@ -91,6 +197,17 @@ class TemplatedClusterFinder {
   std::vector<WorkingCluster> getClusters() const { return clusters_; }
 
  private:
+  /// A candidate merge of the clusters i < j, ordered by weight then index
+  struct Merge {
+    double wgt;
+    std::size_t i, j;
+    /// versions of the clusters when the weight was computed
+    unsigned int version_i, version_j;
+    bool operator>(const Merge& other) const {
+      return std::tie(wgt, i, j) > std::tie(other.wgt, other.i, other.j);
+    }
+  };
+
   WeightClass wgt_;
   double finalwgt_;
   int nseeds_;
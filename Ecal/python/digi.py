@@ -67,8 +67,16 @@ class EcalDigiProducer(Producer) :
         Name of simulated ecal hits to digitize
     inputPassName : str
         Name of pass to digitize
+    packed_sim_hits : bool
+        Are the sim hits a SimCalorimeterHitCollection (EcalSD.packHitContribs)?
     digiCollName : str
         Output name of digis put into event bus
+    n_digi_threads : int
+        Number of threads digitizing the hit channels of an event, more
+        than one needs channel_noise_streams
+    channel_noise_streams : bool
+        Draw the noise of each hit channel from a stream of its own, so the
+        digis don't depend on n_digi_threads
     """
 
     def __init__(self, instance_name = 'ecalDigis', si_thickness = 0.3) :
@@ -93,11 +101,19 @@ class EcalDigiProducer(Producer) :
         # Should we suppress noise "hits" below readout threshold?
         self.zero_suppression = True
 
+        # Should we pack the digis so they take less room on disk?
+        self.pack_digis = False
+
         # input and output collection name parameters
         self.inputCollName = 'EcalSimHits'
         self.inputPassName = ''
+        self.packed_sim_hits = False
         self.digiCollName = 'EcalDigis'
 
+        # digitize the hit channels on several threads
+        self.n_digi_threads = 1
+        self.channel_noise_streams = False
+
 
 class EcalRecProducer(Producer) :
     """Configuration for the EcalRecProducer
@@ -123,12 +139,17 @@ class EcalRecProducer(Producer) :
         Name of sim collection to check for pure noise hits
     simHitPassName : str
         Name of sim pass
+    packed_sim_hits : bool
+        Are the sim hits a SimCalorimeterHitCollection (EcalSD.packHitContribs)?
     recHitCollName : str
         Name of output collection 
     secondOrderEnergyCorrection : float
         Correction to weighted energy
     layerWeights : list of floats
         Weighting factors depending on layer index
+    columnar : bool
+        Copy the reconstruction conditions into contiguous columns
+        when they are loaded so they are read without searching the table
     """
 
     def __init__(self, instance_name = 'ecalRecon') : 
@@ -142,7 +163,9 @@ class EcalRecProducer(Producer) :
         self.digiPassName = ''
         self.simHitCollName = 'EcalSimHits'
         self.simHitPassName = ''
+        self.packed_sim_hits = False
         self.recHitCollName = 'EcalRecHits'
+        self.columnar = True
         
         # geometry dependent settings
         # use helper functions to set these
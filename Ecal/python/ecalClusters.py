@@ -17,6 +17,10 @@ class EcalClusterProducer(ldmxcfg.Producer) :
         self.cutoff = 10.
         self.seedThreshold = 100.0 #MeV
 
+        # Keep the candidate merges in a queue instead of re-scanning
+        # all pairs of clusters for each merge (same clusters, faster)
+        self.useMergeQueue = True
+
         # Pass name for ecal digis
         self.digisPassName = "recon"
 
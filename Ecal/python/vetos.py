@@ -19,6 +19,15 @@ class EcalVetoProcessor(ldmxcfg.Producer) :
         self.do_bdt = True
         self.feature_list_name = "input"
         self.bdt_file = makeBDTPath( "segmip" )
+        # threads of the ONNX session running the BDT
+        self.intra_op_threads = 1
+        self.inter_op_threads = 1
+        # graph optimizations: 'disable', 'basic', 'extended' or 'all'
+        self.optimization_level = 'all'
+        # file to keep the optimized BDT in for the next runs, none if empty
+        self.optimized_model_path = ''
+        # 'cpu', 'cuda', 'openvino' or 'dnnl' (oneDNN)
+        self.execution_provider = 'cpu'
         self.roc_file = makeRoCPath( 'RoC_v14_8gev' )
         self.beam_energy = 8000.0  # in MeV
         self.cellxy_file = makeCellXYPath()
@@ -41,6 +50,18 @@ class DNNEcalVetoProcessor(ldmxcfg.Producer) :
         self.debug = False
         from LDMX.Ecal.makePath import makeBDTPath
         self.model_path = makeBDTPath("particle-net_ecal_v9")
+        # threads of the ONNX session running the DNN
+        self.intra_op_threads = 1
+        self.inter_op_threads = 1
+        # graph optimizations: 'disable', 'basic', 'extended' or 'all'
+        self.optimization_level = 'all'
+        # file to keep the optimized DNN in for the next runs, none if empty
+        self.optimized_model_path = ''
+        # 'cpu', 'cuda', 'openvino' or 'dnnl' (oneDNN)
+        self.execution_provider = 'cpu'
+        # the model takes a dynamic number of points (exported with a dynamic
+        # axis), so only the occupied points are given instead of 50
+        self.dynamic_points = False
         self.disc_cut = -1.
         self.collection_name = "EcalVetoDNN"
 
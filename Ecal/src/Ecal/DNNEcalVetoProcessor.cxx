@@ -9,22 +9,33 @@ namespace ecal {
 
 const std::vector<std::string> DNNEcalVetoProcessor::input_names_{"coordinates",
                                                                   "features"};
-const std::vector<unsigned int> DNNEcalVetoProcessor::input_sizes_{
-    n_coordinate_dim_ * max_num_hits_, n_feature_dim_* max_num_hits_};
+const std::vector<unsigned int> DNNEcalVetoProcessor::input_dims_{
+    n_coordinate_dim_, n_feature_dim_};
 
 DNNEcalVetoProcessor::DNNEcalVetoProcessor(const std::string& name,
                                            framework::Process& process)
-    : Producer(name, process) {
-  for (const auto& s : input_sizes_) {
-    data_.emplace_back(s, 0);
-  }
-}
+    : Producer(name, process) {}
 
 void DNNEcalVetoProcessor::configure(
     framework::config::Parameters& parameters) {
   disc_cut_ = parameters.getParameter<double>("disc_cut");
-  rt_ = std::make_unique<ldmx::Ort::ONNXRuntime>(
-      parameters.getParameter<std::string>("model_path"));
+  model_path_ = parameters.getParameter<std::string>("model_path");
+  onnx_options_.intra_op_threads =
+      parameters.getParameter<int>("intra_op_threads", 1);
+  onnx_options_.inter_op_threads =
+      parameters.getParameter<int>("inter_op_threads", 1);
+  onnx_options_.optimization_level =
+      parameters.getParameter<std::string>("optimization_level", "all");
+  onnx_options_.optimized_model_path =
+      parameters.getParameter<std::string>("optimized_model_path", "");
+  onnx_options_.execution_provider =
+      parameters.getParameter<std::string>("execution_provider", "cpu");
+  dynamic_points_ = parameters.getParameter<bool>("dynamic_points", false);
+  // the ONNX session is created on its own, so it can be done in
+  // parallel with the start of the other processors
+  declareIndependentStart();
+  // the DNN is run on all of the events of a batch at once
+  declareBatchProduce();
 
   // debug mode
   debug_ = parameters.getParameter<bool>("debug");
@@ -33,29 +44,107 @@ void DNNEcalVetoProcessor::configure(
   collectionName_ = parameters.getParameter<std::string>("collection_name");
 }
 
-void DNNEcalVetoProcessor::produce(framework::Event& event) {
-  ldmx::EcalVetoResult result;
+void DNNEcalVetoProcessor::onProcessStart() {
+  rt_ = ldmx::Ort::ONNXRuntime::get(model_path_, onnx_options_);
+  // bind the single event shape of a fixed model now, so a model that
+  // can't be bound fails at the start
+  if (not dynamic_points_) binding(1, max_num_hits_);
+}
 
+ldmx::Ort::ONNXRuntime::Binding& DNNEcalVetoProcessor::binding(
+    std::size_t batch_size, unsigned int n_points) {
+  auto& bound{bindings_[{batch_size, n_points}]};
+  if (!bound) {
+    bound = rt_->bind(batch_size, {}, dynamic_points_ ? n_points : -1);
+  }
+  return *bound;
+}
+
+unsigned int DNNEcalVetoProcessor::num_points(std::size_t nhits) const {
+  if (not dynamic_points_) return max_num_hits_;
+  unsigned int n_steps = (nhits + point_step_ - 1) / point_step_;
+  return std::max(n_steps, 1u) * point_step_;
+}
+
+void DNNEcalVetoProcessor::produce(framework::Event& event) {
   // Get the Ecal Geometry
   const auto& ecal_geometry = getCondition<ldmx::EcalGeometry>(
       ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME);
 
   // Get the collection of digitized Ecal hits from the event.
-  const auto ecalRecHits = event.getCollection<ldmx::EcalHit>("EcalRecHits");
-  auto nhits = std::count_if(
+  const auto& ecalRecHits = event.getCollection<ldmx::EcalHit>("EcalRecHits");
+  std::size_t nhits = std::count_if(
       ecalRecHits.begin(), ecalRecHits.end(),
       [](const ldmx::EcalHit& hit) { return hit.getEnergy() > 0; });
 
+  float disc = -99;
   if (nhits < max_num_hits_) {
+    unsigned int n_points = num_points(nhits);
+    auto& bound{binding(1, n_points)};
     // make inputs
-    make_inputs(ecal_geometry, ecalRecHits);
+    make_inputs(ecal_geometry, ecalRecHits, bound, 0, n_points);
     // run the DNN
-    auto outputs = rt_->run(input_names_, data_)[0];
-    result.setDiscValue(outputs.at(1));
-  } else {
-    result.setDiscValue(-99);
+    rt_->run(bound);
+    disc = bound.output(rt_->getOutputNames()[0]).at(1);
+  }
+
+  add_result(event, disc);
+}
+
+void DNNEcalVetoProcessor::produceBatch(
+    const std::vector<framework::Event*>& events) {
+  const auto& ecal_geometry = getCondition<ldmx::EcalGeometry>(
+      ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME);
+
+  // count the hits first, the events of the batch share a number of points
+  std::vector<bool> in_batch(events.size(), false);
+  std::size_t max_nhits{0};
+  for (std::size_t i_event = 0; i_event < events.size(); ++i_event) {
+    const auto& ecalRecHits =
+        events[i_event]->getCollection<ldmx::EcalHit>("EcalRecHits");
+    std::size_t nhits = std::count_if(
+        ecalRecHits.begin(), ecalRecHits.end(),
+        [](const ldmx::EcalHit& hit) { return hit.getEnergy() > 0; });
+    in_batch[i_event] = nhits < max_num_hits_;
+    if (in_batch[i_event]) max_nhits = std::max(max_nhits, nhits);
+  }
+  unsigned int n_points = num_points(max_nhits);
+  auto& bound{binding(events.size(), n_points)};
+
+  // the inputs of the events are placed one after the other, the events
+  // with too many hits are left as zeros and their outputs are ignored
+  for (std::size_t i_event = 0; i_event < events.size(); ++i_event) {
+    if (in_batch[i_event]) {
+      make_inputs(ecal_geometry,
+                  events[i_event]->getCollection<ldmx::EcalHit>("EcalRecHits"),
+                  bound, i_event, n_points);
+    } else {
+      clear_inputs(bound, i_event, n_points);
+    }
   }
 
+  std::vector<float> disc(events.size(), -99);
+  if (std::find(in_batch.begin(), in_batch.end(), true) != in_batch.end()) {
+    rt_->run(bound);
+    // the outputs of each event are also one after the other
+    const auto& outputs = bound.output(rt_->getOutputNames()[0]);
+    std::size_t n_outputs = outputs.size() / events.size();
+    for (std::size_t i_event = 0; i_event < events.size(); ++i_event) {
+      if (in_batch[i_event]) {
+        disc[i_event] = outputs.at(i_event * n_outputs + 1);
+      }
+    }
+  }
+
+  for (std::size_t i_event = 0; i_event < events.size(); ++i_event) {
+    add_result(*events[i_event], disc[i_event]);
+  }
+}
+
+void DNNEcalVetoProcessor::add_result(framework::Event& event, float disc) {
+  ldmx::EcalVetoResult result;
+  result.setDiscValue(disc);
+
   if (debug_) {
     std::cout << "... disc_val = " << result.getDisc() << std::endl;
   }
@@ -64,37 +153,53 @@ void DNNEcalVetoProcessor::produce(framework::Event& event) {
 
   // If the event passes the veto, keep it. Otherwise, drop the event.
   if (result.passesVeto()) {
-    setStorageHint(framework::hint_shouldKeep);
+    setStorageHint(event, framework::hint_shouldKeep);
   } else {
-    setStorageHint(framework::hint_shouldDrop);
+    setStorageHint(event, framework::hint_shouldDrop);
   }
 
   event.add(collectionName_, result);
 }
 
+void DNNEcalVetoProcessor::clear_inputs(
+    ldmx::Ort::ONNXRuntime::Binding& binding, std::size_t i_event,
+    unsigned int n_points) {
+  for (unsigned iname = 0; iname < input_names_.size(); ++iname) {
+    std::size_t input_size = input_dims_[iname] * n_points;
+    auto begin =
+        binding.input(input_names_[iname]).begin() + i_event * input_size;
+    std::fill(begin, begin + input_size, 0);
+  }
+}
+
 void DNNEcalVetoProcessor::make_inputs(
     const ldmx::EcalGeometry& geom,
-    const std::vector<ldmx::EcalHit>& ecalRecHits) {
-  // clear data
-  for (auto& v : data_) {
-    std::fill(v.begin(), v.end(), 0);
-  }
+    const std::vector<ldmx::EcalHit>& ecalRecHits,
+    ldmx::Ort::ONNXRuntime::Binding& binding, std::size_t i_event,
+    unsigned int n_points) {
+  clear_inputs(binding, i_event, n_points);
 
+  auto& coordinates = binding.input(input_names_[0]);
+  auto& features = binding.input(input_names_[1]);
   unsigned idx = 0;
+  std::size_t coordinate_idx = i_event * input_dims_[0] * n_points;
+  std::size_t feature_idx = i_event * input_dims_[1] * n_points;
   for (const auto& hit : ecalRecHits) {
     if (hit.getEnergy() <= 0) continue;
     ldmx::EcalID id(hit.getID());
     auto [x, y, z] = geom.getPosition(id);
 
-    data_[0].at(coordinate_x_offset_ + idx) = x;
-    data_[0].at(coordinate_y_offset_ + idx) = y;
-    data_[0].at(coordinate_z_offset_ + idx) = z;
+    coordinates.at(coordinate_idx + coordinate_x_offset_ * n_points + idx) = x;
+    coordinates.at(coordinate_idx + coordinate_y_offset_ * n_points + idx) = y;
+    coordinates.at(coordinate_idx + coordinate_z_offset_ * n_points + idx) = z;
 
-    data_[1].at(feature_x_offset_ + idx) = x;
-    data_[1].at(feature_y_offset_ + idx) = y;
-    data_[1].at(feature_z_offset_ + idx) = z;
-    data_[1].at(feature_layerid_offset_ + idx) = id.layer();
-    data_[1].at(feature_energy_offset_ + idx) = std::log(hit.getEnergy());
+    features.at(feature_idx + feature_x_offset_ * n_points + idx) = x;
+    features.at(feature_idx + feature_y_offset_ * n_points + idx) = y;
+    features.at(feature_idx + feature_z_offset_ * n_points + idx) = z;
+    features.at(feature_idx + feature_layerid_offset_ * n_points + idx) =
+        id.layer();
+    features.at(feature_idx + feature_energy_offset_ * n_points + idx) =
+        std::log(hit.getEnergy());
 
     ++idx;
   }
@@ -102,9 +207,11 @@ void DNNEcalVetoProcessor::make_inputs(
   if (debug_) {
     for (unsigned iname = 0; iname < input_names_.size(); ++iname) {
       std::cout << "=== " << input_names_[iname] << " ===" << std::endl;
-      for (unsigned i = 0; i < input_sizes_[iname]; ++i) {
-        std::cout << data_[iname].at(i) << ", ";
-        if ((i + 1) % max_num_hits_ == 0) {
+      const auto& input = binding.input(input_names_[iname]);
+      std::size_t input_size = input_dims_[iname] * n_points;
+      for (unsigned i = 0; i < input_size; ++i) {
+        std::cout << input.at(i_event * input_size + i) << ", ";
+        if ((i + 1) % n_points == 0) {
           std::cout << std::endl;
         }
       }
@@ -17,6 +17,7 @@ EcalClusterProducer::~EcalClusterProducer() {}
 void EcalClusterProducer::configure(framework::config::Parameters& parameters) {
   cutoff_ = parameters.getParameter<double>("cutoff");
   seedThreshold_ = parameters.getParameter<double>("seedThreshold");
+  useMergeQueue_ = parameters.getParameter<bool>("useMergeQueue", true);
   digisPassName_ = parameters.getParameter<std::string>("digisPassName");
   algoCollName_ = parameters.getParameter<std::string>("algoCollName");
   algoName_ = parameters.getParameter<std::string>("algoName");
@@ -48,7 +49,11 @@ void EcalClusterProducer::produce(framework::Event& event) {
     cf.add(&hit, geometry);
   }
 
-  cf.cluster(seedThreshold_, cutoff_);
+  if (useMergeQueue_) {
+    cf.clusterWithQueue(seedThreshold_, cutoff_);
+  } else {
+    cf.cluster(seedThreshold_, cutoff_);
+  }
   std::vector<WorkingCluster> wcVec = cf.getClusters();
 
   std::map<int, double> cWeights = cf.getWeights();
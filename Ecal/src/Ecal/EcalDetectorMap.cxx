@@ -29,9 +29,8 @@ class EcalDetectorMapLoader : public framework::ConditionsObjectProvider {
                                      want_d2e_);
     }
 
-    return std::make_pair(
-        the_map_, framework::ConditionsIOV(context.getRun(), context.getRun(),
-                                           true, true));
+    // the map is built once from the configured tables, valid for all runs
+    return std::make_pair(the_map_, framework::ConditionsIOV(true, true));
   }
 
   /**
@@ -7,6 +7,7 @@
 
 #include "Ecal/EcalDigiProducer.h"
 #include "DetDescr/EcalGeometry.h"
+#include "DetDescr/EcalLayout.h"
 #include "Framework/RandomNumberSeedService.h"
 #include <iostream>
 #include <fstream>
@@ -39,9 +40,19 @@ void EcalDigiProducer::configure(framework::config::Parameters& ps) {
   // collection names
   inputCollName_ = ps.getParameter<std::string>("inputCollName");
   inputPassName_ = ps.getParameter<std::string>("inputPassName");
+  packedSimHits_ = ps.getParameter<bool>("packed_sim_hits", false);
   digiCollName_ = ps.getParameter<std::string>("digiCollName");
 
   zero_suppression_ = ps.getParameter<bool>("zero_suppression");
+  pack_digis_ = ps.getParameter<bool>("pack_digis", false);
+  n_digi_threads_ = ps.getParameter<int>("n_digi_threads", 1);
+  channel_noise_streams_ =
+      ps.getParameter<bool>("channel_noise_streams", false);
+  if (n_digi_threads_ > 1 and not channel_noise_streams_) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "Digitizing on several threads needs the noise drawn "
+                    "from a stream per channel (channel_noise_streams).");
+  }
 
   // physical constants
   //  used to calculate unit conversions
@@ -98,21 +109,34 @@ void EcalDigiProducer::produce(framework::Event& event) {
     noiseInjector_ = std::make_unique<TRandom3>(
         rseed.getSeed("EcalDigiProducer::NoiseInjector"));
   }
-  if (!hgcroc_->hasSeed()) {
+  if (!hgcrocContext_) {
     const auto& rseed = getCondition<framework::RandomNumberSeedService>(
         framework::RandomNumberSeedService::CONDITIONS_OBJECT_NAME);
-    hgcroc_->seedGenerator(rseed.getSeed("EcalDigiProducer::HgcrocEmulator"));
+    hgcrocContext_ = std::make_unique<ldmx::HgcrocEmulator::Context>(
+        rseed.getSeed("EcalDigiProducer::HgcrocEmulator"));
   }
 
-  hgcroc_->condition(getCondition<conditions::DoubleTableCondition>("EcalHgcrocConditions"));
+  hgcrocContext_->condition(
+      getCondition<conditions::DoubleTableCondition>("EcalHgcrocConditions"));
+  if (channel_noise_streams_) {
+    // the streams of the channels are keyed by the event, so they don't
+    //  depend on which events were digitized before
+    const auto& rseed = getCondition<framework::RandomNumberSeedService>(
+        framework::RandomNumberSeedService::CONDITIONS_OBJECT_NAME);
+    auto stream{rseed.getStream("EcalDigiProducer::HgcrocEmulator",
+                                event.getEventHeader())};
+    uint64_t seed{stream()};
+    hgcrocContext_->channelStreams(seed << 32 | stream());
+  }
 
   // Empty collection to be filled
   ldmx::HgcrocDigiCollection ecalDigis;
   ecalDigis.setNumSamplesPerDigi(nADCs_);
   ecalDigis.setSampleOfInterestIndex(iSOI_);
 
-  std::set<unsigned int>
-      filledDetIDs;  // detector IDs that already have a hit in them
+  // detector IDs that already have a hit in them
+  //  only needed during this event, so it goes in the arena
+  std::pmr::set<unsigned int> filledDetIDs{event.getMemoryResource()};
 
   /******************************************************************************************
    * HGCROC Emulation on Simulated Hits
@@ -123,20 +147,41 @@ void EcalDigiProducer::produce(framework::Event& event) {
   //  from G4CalorimeterHits to SimCalorimeterHits this class ensures that only
   //  one SimCalorimeterHit is generated per cell, but multiple "contributions"
   //  are still handled within SimCalorimeterHit
-  auto ecalSimHits{event.getCollection<ldmx::SimCalorimeterHit>(
-      inputCollName_, inputPassName_)};
-
   /* debug printout
   std::cout << "Energy to Voltage Conversion: " << MeV_ << " mV/MeV" <<
   std::endl;
    */
 
-  for (auto const& simHit : ecalSimHits) {
-    std::vector<std::pair<double,double>> pulses_at_chip;
-    for (int iContrib = 0; iContrib < simHit.getNumberOfContribs();
-         iContrib++) {
+  // the sim hits are read in place, either as a list of hits each with its
+  // own contributions or as a collection with all of them packed together
+  const ldmx::SimCalorimeterHitCollection* packedSimHits{nullptr};
+  const std::vector<ldmx::SimCalorimeterHit>* ecalSimHits{nullptr};
+  std::size_t nSimHits;
+  if (packedSimHits_) {
+    packedSimHits = &event.getObject<ldmx::SimCalorimeterHitCollection>(
+        inputCollName_, inputPassName_);
+    nSimHits = packedSimHits->size();
+  } else {
+    ecalSimHits = &event.getCollection<ldmx::SimCalorimeterHit>(
+        inputCollName_, inputPassName_);
+    nSimHits = ecalSimHits->size();
+  }
+
+  hgcrocBatch_.clear();
+  for (std::size_t iHit = 0; iHit < nSimHits; iHit++) {
+    const auto& simHit{packedSimHits ? packedSimHits->getHit(iHit)
+                                     : ecalSimHits->at(iHit)};
+    unsigned int nContribs{packedSimHits
+                               ? packedSimHits->getNumberOfContribs(iHit)
+                               : simHit.getNumberOfContribs()};
+    unsigned int hitID = simHit.getID();
+    filledDetIDs.insert(hitID);
+    hgcrocBatch_.addChannel(hitID);
+    for (unsigned int iContrib = 0; iContrib < nContribs; iContrib++) {
+      auto contrib{packedSimHits ? packedSimHits->getContrib(iHit, iContrib)
+                                 : simHit.getContrib(iContrib)};
       /* debug printout
-      std::cout << simHit.getContrib(iContrib).edep << " MeV" << std::endl;
+      std::cout << contrib.edep << " MeV" << std::endl;
        */
       /**
        * HACK ALERT
@@ -144,32 +189,28 @@ void EcalDigiProducer::produce(framework::Event& event) {
        * In reality, each chip has a set time phase that it samples at (relative
        * to target), so the time shifting should be at the emulator level.
        */
-      pulses_at_chip.emplace_back(
-        simHit.getContrib(iContrib).edep * MeV_,
-        simHit.getContrib(iContrib).time  // global time (t=0ns at target)
-          - simHit.getPosition().at(2) /
+      hgcrocBatch_.addPulse(
+        contrib.edep * MeV_,
+        contrib.time  // global time (t=0ns at target)
+          - simHit.getZ() /
                 299.702547  // shift light-speed particle traveling along z
       );
     }
 
-    unsigned int hitID = simHit.getID();
-    filledDetIDs.insert(hitID);
-
     /* debug printout
     std::cout << hitID << " "
         << simHit.getEdep() 
         << " MeV at "
-        << simHit.getTime() - simHit.getPosition().at(2)/299.702547
+        << simHit.getTime() - simHit.getZ()/299.702547
         << std::endl;
      */
-    // container emulator uses to write out samples and
-    // transfer samples into the digi collection
-    std::vector<ldmx::HgcrocDigiCollection::Sample> digiToAdd;
-    if (hgcroc_->digitize(hitID, pulses_at_chip, digiToAdd)) {
-      ecalDigis.addDigi(hitID, digiToAdd);
-    }
   }
 
+  // digitize the hit channels together, the digis are added in the order
+  //  of the sim hits
+  hgcroc_->digitize(*hgcrocContext_, hgcrocBatch_, ecalDigis,
+                    n_digi_threads_);
+
   /******************************************************************************************
    * Noise Simulation on Empty Channels
    *****************************************************************************************/
@@ -200,30 +241,36 @@ void EcalDigiProducer::produce(framework::Event& event) {
       saveNumberOfHits(noiseHitAmplitudes.size(),"/home/ananda/ldmx-results/noiseHitCountNormal.csv" );
 
 
-      std::vector<std::pair<double,double>> fake_pulse(1,{0.,0.});
-//      std::cout << " [Number of empty channels]: " << numEmptyChannels <<std::endl;
-//      std::cout << " noise Amps: " << noiseHitAmplitudes <<std::endl;
-      for (double noiseHit : noiseHitAmplitudes) {
-        // generate detector ID for noise hit
-        // making sure that it is in an empty channel
-        unsigned int noiseID;
-        do {
-          int layerID = noiseInjector_->Integer(nEcalLayers);
-          int moduleID = noiseInjector_->Integer(nModulesPerLayer);
-          int cellID = noiseInjector_->Integer(nCellsPerModule);
-          auto detID = ldmx::EcalID(layerID, moduleID, cellID);
-          noiseID = detID.raw();
-        } while (filledDetIDs.find(noiseID) != filledDetIDs.end());
-        filledDetIDs.insert(noiseID);
+      // all channels of the ECal, listed once
+      if (not noiseChannels_) {
+        std::vector<unsigned int> channels;
+        ldmx::visitEcalLayout(geom, [&channels](auto layout) {
+          channels.reserve(layout.size());
+          for (int layer{0}; layer < layout.layers(); layer++)
+            for (int module{0}; module < layout.modules(); module++)
+              for (int cell{0}; cell < layout.cells(); cell++)
+                channels.push_back(ldmx::EcalID(layer, module, cell).raw());
+        });
+        noiseChannels_ =
+            std::make_unique<ldmx::EmptyChannelSampler>(std::move(channels));
+      }
+
+      // distinct empty channels for the noise hits, drawn in one go
+      const auto& noiseIDs{noiseChannels_->sample(
+          filledDetIDs, noiseHitAmplitudes.size(), *noiseInjector_)};
+      ecalDigis.reserve(ecalDigis.getNumDigis() + noiseIDs.size());
+      for (std::size_t iNoise{0}; iNoise < noiseIDs.size(); iNoise++) {
+        unsigned int noiseID{noiseIDs[iNoise]};
 
         // noise generator gives the amplitude above the readout threshold
         //  we need to convert it to the amplitude above the pedestal
-        noiseHit +=
-            hgcroc_->gain(noiseID) *
-            (hgcroc_->readoutThreshold(noiseID) - hgcroc_->pedestal(noiseID));
-//        std::cout << "Number of hits" << noiseHit;
-        // create a digi as put it into the collection
-        ecalDigis.addDigi(noiseID, hgcroc_->noiseDigi(noiseID, noiseHit));
+        double noiseHit{noiseHitAmplitudes[iNoise] +
+                        hgcrocContext_->gain(noiseID) *
+                            (hgcrocContext_->readoutThreshold(noiseID) -
+                             hgcrocContext_->pedestal(noiseID))};
+        // create a digi in the collection and fill it with noise
+        hgcroc_->noiseDigi(*hgcrocContext_, noiseID,
+                           ecalDigis.addDigi(noiseID), noiseHit);
       }  // loop over noise amplitudes
 
     } else {
@@ -231,22 +278,35 @@ void EcalDigiProducer::produce(framework::Event& event) {
 
         // no zero suppression, put some noise emulation in **all** empty channels
       // loop through all channels
-      for (int layer{0}; layer < nEcalLayers; layer++) {
-        for (int module{0}; module < nModulesPerLayer; module++) {
-          for (int cell{0}; cell < nCellsPerModule; cell++) {
-            unsigned int channel{ldmx::EcalID(layer,module,cell).raw()};
-            // check if channel already has a (real) hit in it
-            if (filledDetIDs.find(channel) != filledDetIDs.end())
-              continue;
-            // create a digi as put it into the collection
-            ecalDigis.addDigi(channel, hgcroc_->noiseDigi(channel));
-          }  // cells in each module
-        }    // modules in each layer
-      }      // layers in ECal
-    }        // yes or no zero suppression
+      //  the channel IDs increase along this loop, so we walk along the
+      //  (sorted) filled IDs instead of searching them and the noise
+      //  samples are written directly into the collection
+      ecalDigis.reserve(ecalDigis.getNumDigis() + numEmptyChannels);
+      auto next_filled{filledDetIDs.begin()};
+      ldmx::visitEcalLayout(geom, [&](auto layout) {
+        for (int layer{0}; layer < layout.layers(); layer++) {
+          for (int module{0}; module < layout.modules(); module++) {
+            for (int cell{0}; cell < layout.cells(); cell++) {
+              unsigned int channel{ldmx::EcalID(layer, module, cell).raw()};
+              // check if channel already has a (real) hit in it
+              while (next_filled != filledDetIDs.end() and
+                     *next_filled < channel)
+                ++next_filled;
+              if (next_filled != filledDetIDs.end() and
+                  *next_filled == channel)
+                continue;
+              // create a digi in the collection and fill it with noise
+              hgcroc_->noiseDigi(*hgcrocContext_, channel,
+                                 ecalDigis.addDigi(channel));
+            }  // cells in each module
+          }    // modules in each layer
+        }      // layers in ECal
+      });
+    }  // yes or no zero suppression
   }          // if we should do the noise
 
-  event.add(digiCollName_, ecalDigis);
+  if (pack_digis_) ecalDigis.pack();
+  event.add(digiCollName_, std::move(ecalDigis));
 
   return;
 }  // produce
@@ -30,9 +30,9 @@ class EcalGeometryProvider : public framework::ConditionsObjectProvider {
 
   /**
    * Provides access to the EcalGeometry or EcalTriggerGeometry
-   * @note Currently, these are assumed to be valid for all time, but this
-   * behavior could be changed.  Users should not cache the pointer between
-   * events
+   * @note The geometry is built once for the detector of the job and is
+   * valid for all runs.  Users should still not cache the pointer between
+   * events, but request it through the conditions system.
    */
   virtual std::pair<const framework::ConditionsObject*,
                     framework::ConditionsIOV>
@@ -133,9 +133,9 @@ EcalGeometryProvider::getCondition(const ldmx::EventHeader& context) {
     }
   }
 
-  return std::make_pair(
-      ecalGeometry_,
-      framework::ConditionsIOV(context.getRun(), context.getRun(), true, true));
+  // the geometry of a job can't change, so it is valid for every run and
+  // isn't requested again (and rebuilt downstream) when the run changes
+  return std::make_pair(ecalGeometry_, framework::ConditionsIOV(true, true));
 }
 
 }  // namespace ecal
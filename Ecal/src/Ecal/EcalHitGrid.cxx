@@ -0,0 +1,27 @@
+#include "Ecal/EcalHitGrid.h"
+
+namespace ecal {
+
+void EcalHitGrid::reset(const ldmx::EcalGeometry& geometry) {
+  if (geometry_ != &geometry or energy_.size() != geometry.getNumCells()) {
+    geometry_ = &geometry;
+    energy_.assign(geometry.getNumCells(), 0.);
+    hit_.assign(geometry.getNumCells(), false);
+    ids_.clear();
+    return;
+  }
+  for (ldmx::EcalID id : ids_) {
+    std::size_t i{geometry_->getCellIndex(id)};
+    energy_[i] = 0.;
+    hit_[i] = false;
+  }
+  ids_.clear();
+}
+
+void EcalHitGrid::fill(const std::vector<ldmx::EcalHit>& hits) {
+  for (const ldmx::EcalHit& hit : hits) {
+    insert(ldmx::EcalID(hit.getID()), hit.getEnergy());
+  }
+}
+
+}  // namespace ecal
@@ -1,7 +1,9 @@
 #include "Ecal/EcalRawDecoder.h"
 
+#include <algorithm>
 #include <bitset>
 #include <iomanip>
+#include <numeric>
 #include <optional>
 
 #include "DetDescr/EcalElectronicsID.h"
@@ -42,11 +44,18 @@ void EcalRawDecoder::produce(framework::Event& event) {
    * The readout cip streams the data off of it, so it doesn't
    * have time to re-group the signals across multiple bunches (samples)
    * by their channel ID. We need to do that here.
+   *
+   * While reading, we only note the channel of each sample word
+   * (using a table indexed by the packed **electronic** ID) and
+   * the words are grouped by channel afterwards.
    */
-  // fill map of **electronic** IDs to the digis that were read out
-  std::map<ldmx::EcalElectronicsID,
-           std::vector<ldmx::HgcrocDigiCollection::Sample>>
-      eid_to_samples;
+  if (channel_of_index_.empty()) {
+    channel_of_index_.resize(ldmx::EcalElectronicsID::MAX_INDEX, -1);
+  }
+  // reset the table from the last event
+  for (unsigned int index : channels_) channel_of_index_[index] = -1;
+  channels_.clear();
+  samples_.clear();
   while (reader >> head1 >> head2) {
     /// are we reading a buffer from multi-sample per event?
     if (head1 == 0x11111111 and head2 == 0xbeef2021) {
@@ -98,7 +107,7 @@ void EcalRawDecoder::produce(framework::Event& event) {
      */
     packing::utility::CRC fpga_crc;
     fpga_crc << head1;
-    std::cout << hex(head1) << " : ";
+    // std::cout << hex(head1) << " : ";
     uint32_t version = (head1 >> 28) & packing::utility::mask<4>;
     // std::cout << "version " << version << std::flush;
     uint32_t one{1};
@@ -248,8 +257,17 @@ void EcalRawDecoder::produce(framework::Event& event) {
           ldmx::EcalElectronicsID eid(fpga - 1, roc_id - 256, channel_id);
           // std::cout << eid.index();
 
-          // copy data into EID->sample map
-          eid_to_samples[eid].emplace_back(w);
+          // note which channel this data word belongs to
+          if (eid.index() >= channel_of_index_.size()) {
+            // bad data can have fields outside of the expected ranges
+            channel_of_index_.resize(eid.index() + 1, -1);
+          }
+          int& channel{channel_of_index_[eid.index()]};
+          if (channel < 0) {
+            channel = channels_.size();
+            channels_.push_back(eid.index());
+          }
+          samples_.emplace_back(channel, w);
         }  // type of channel
         // std::cout << std::endl;
       }  // loop over channels (j in Table 4)
@@ -273,11 +291,47 @@ void EcalRawDecoder::produce(framework::Event& event) {
     */
   }
 
+  /**
+   * Group the sample words by channel
+   *
+   * The channels are ordered by electronic ID and the samples of
+   * each channel keep the order they were read in, so this is a
+   * counting sort of the sample words into one contiguous array.
+   */
+  std::vector<unsigned int> n_samples(channels_.size(), 0);
+  for (auto const& [channel, word] : samples_) n_samples[channel]++;
+  std::vector<int> order(channels_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&](int a, int b) { return channels_[a] < channels_[b]; });
+  // the samples of each channel start after those of the channels before it
+  std::vector<std::size_t> offset(channels_.size(), 0);
+  std::size_t next_offset{0};
+  for (int channel : order) {
+    offset[channel] = next_offset;
+    next_offset += n_samples[channel];
+  }
+  std::vector<uint32_t> words(samples_.size());
+  std::vector<std::size_t> filled(offset);
+  for (auto const& [channel, word] : samples_) words[filled[channel]++] = word;
+
   ldmx::HgcrocDigiCollection digis;
   // assume all channels have same number of samples
-  digis.setNumSamplesPerDigi(eid_to_samples.begin()->second.size());
+  digis.setNumSamplesPerDigi(order.empty() ? 0 : n_samples[order.front()]);
   digis.setSampleOfInterestIndex(0);  // TODO configurable
   digis.setVersion(roc_version_);
+  digis.reserve(order.size());
+  // add the digi of a channel, writing its samples in place
+  auto add_digi = [&](uint32_t id, int channel) {
+    auto begin{words.begin() + offset[channel]};
+    if (n_samples[channel] == digis.getNumSamplesPerDigi()) {
+      std::copy(begin, begin + n_samples[channel], digis.addDigi(id));
+    } else {
+      // let the collection warn about the mismatched number of samples
+      digis.addDigi(id,
+                    std::vector<uint32_t>(begin, begin + n_samples[channel]));
+    }
+  };
   if (translate_eid_) {
     /**
      * Translation
@@ -286,16 +340,17 @@ void EcalRawDecoder::produce(framework::Event& event) {
      * unpacking of individual samples; however, we still need
      * to translate electronic IDs into detector IDs.
      */
-    auto detmap{
+    const auto& detmap{
         getCondition<EcalDetectorMap>(EcalDetectorMap::CONDITIONS_OBJECT_NAME)};
-    for (auto const& [eid, digi] : eid_to_samples) {
+    for (int channel : order) {
+      auto eid{ldmx::EcalElectronicsID::idFromIndex(channels_[channel])};
       // The electronics map returns an empty ID of the correct
       // type when the electronics ID is not found.
       //  need to check if the electronics ID exists
       //  TODO: do we want to end processing if this happens?
       if (detmap.exists(eid)) {
         uint32_t did_raw = detmap.get(eid).raw();
-        digis.addDigi(did_raw, digi);
+        add_digi(did_raw, channel);
       } else {
         /** DO NOTHING
          *  skip hits where the EID aren't in the detector mapping
@@ -316,8 +371,9 @@ void EcalRawDecoder::produce(framework::Event& event) {
      *       the decoding stage without translating the EID
      *       into a detector ID to avoid confusion in recon
      */
-    for (auto const& [eid, digi] : eid_to_samples) {
-      digis.addDigi(eid.raw(), digi);
+    for (int channel : order) {
+      add_digi(ldmx::EcalElectronicsID::idFromIndex(channels_[channel]).raw(),
+               channel);
     }
   }
 
@@ -1,6 +1,6 @@
 #include "Ecal/EcalRawEncoder.h"
 
-#include <bitset>
+#include <algorithm>
 
 #include "DetDescr/EcalElectronicsID.h"
 #include "DetDescr/EcalID.h"
@@ -12,6 +12,17 @@
 
 namespace ecal {
 
+namespace {
+
+/// number of channels on a link, field 0 of the EcalElectronicsID index
+constexpr uint32_t CHANNELS_PER_LINK{38};
+
+/// number of links in the electronics index
+constexpr uint32_t MAX_LINKS{ldmx::EcalElectronicsID::MAX_INDEX /
+                             CHANNELS_PER_LINK};
+
+}  // namespace
+
 EcalRawEncoder::EcalRawEncoder(const std::string& name,
                                framework::Process& process)
     : Producer(name, process) {}
@@ -26,20 +37,10 @@ void EcalRawEncoder::configure(framework::config::Parameters& ps) {
 }
 
 void EcalRawEncoder::produce(framework::Event& event) {
-  /**
-   * Static parameters depending on ROC version
-   */
-  static const unsigned int common_mode_channel = roc_version_ == 2 ? 19 : 1;
-
-  auto digis{
+  const auto& digis{
       event.getObject<ldmx::HgcrocDigiCollection>(input_name_, input_pass_)};
-  std::vector<std::map<
-      uint16_t, std::map<uint16_t, std::map<uint32_t, uint32_t>  // channel to
-                                                                 // sample
-                         >                                       // links
-      >                                                          // fpgas
-              >                                                  // bunches
-      sorted_samples(digis.getNumSamplesPerDigi());
+  const uint32_t n_digis{digis.getNumDigis()};
+  const uint32_t n_samples{digis.getNumSamplesPerDigi()};
 
   /**
    * Translation
@@ -48,33 +49,118 @@ void EcalRawEncoder::produce(framework::Event& event) {
    * unpacking of individual samples; however, we still need
    * to translate detector IDs into electronics ID and resort
    * the data into grouped by bunch.
+   *
+   * The digis are counted on each link of the dense electronics
+   * index and then placed in order of their links, so only the
+   * links that have digis are visited.
    */
-  auto detmap{
+  const auto& detmap{
       getCondition<EcalDetectorMap>(EcalDetectorMap::CONDITIONS_OBJECT_NAME)};
-  for (auto digi : digis) {
-    ldmx::EcalID detid{digi.id()};
-    ldmx::EcalElectronicsID eid{detmap.get(detid)};
+  if (link_count_.empty()) link_count_.resize(MAX_LINKS, 0);
+  digi_index_.resize(n_digis);
+  touched_.clear();
+  for (uint32_t i_digi{0}; i_digi < n_digis; i_digi++) {
+    ldmx::EcalID detid{digis.getDigiID(i_digi)};
+    unsigned int index{detmap.get(detid).index()};
+    digi_index_[i_digi] = index;
+    if (link_count_[index / CHANNELS_PER_LINK]++ == 0)
+      touched_.push_back(index / CHANNELS_PER_LINK);
+  }
+  std::sort(touched_.begin(), touched_.end());
+
+  // the counts become the start of each link in by_link_
+  uint32_t n_before{0};
+  for (uint32_t link : touched_) {
+    uint32_t n{link_count_[link]};
+    link_count_[link] = n_before;
+    n_before += n;
+  }
+  by_link_.resize(n_digis);
+  for (uint32_t i_digi{0}; i_digi < n_digis; i_digi++) {
+    by_link_[link_count_[digi_index_[i_digi] / CHANNELS_PER_LINK]++] = i_digi;
+  }
+
+  // the channels of each link in order, a later digi of the same channel
+  // replaces an earlier one
+  links_.clear();
+  samples_.resize(std::size_t(n_samples) * n_digis);
+  uint32_t n_sorted{0}, link_begin{0};
+  for (uint32_t link : touched_) {
+    uint32_t link_end{link_count_[link]};
+    link_count_[link] = 0;
+    int digi_of_channel[CHANNELS_PER_LINK];
+    std::fill(digi_of_channel, digi_of_channel + CHANNELS_PER_LINK, -1);
+    for (uint32_t i{link_begin}; i < link_end; i++) {
+      uint32_t i_digi{by_link_[i]};
+      digi_of_channel[digi_index_[i_digi] % CHANNELS_PER_LINK] = i_digi;
+    }
+    link_begin = link_end;
 
-    for (std::size_t i_bx{0}; i_bx < digis.getNumSamplesPerDigi(); i_bx++) {
-      sorted_samples[i_bx][eid.fiber()][eid.elink()][eid.channel()] =
-          digi.at(i_bx).raw();
+    ldmx::EcalElectronicsID eid{
+        ldmx::EcalElectronicsID::idFromIndex(link * CHANNELS_PER_LINK)};
+    Link l{uint32_t(eid.fiber()), uint32_t(eid.elink()), 0, 0};
+    l.ro_map |= uint64_t(1);       // special "header" word from ROC
+    l.ro_map |= uint64_t(1) << 39;  // trailing checksum from ROC
+    for (uint32_t channel{0}; channel < CHANNELS_PER_LINK; channel++) {
+      if (digi_of_channel[channel] < 0) continue;
+      l.ro_map |= uint64_t(1) << channel;
+      const auto digi{digis.getDigi(digi_of_channel[channel])};
+      for (uint32_t i_bx{0}; i_bx < n_samples; i_bx++) {
+        samples_[std::size_t(i_bx) * n_digis + n_sorted] = digi.at(i_bx).raw();
+      }
+      n_sorted++;
+      l.n_digis++;
     }
+    links_.push_back(l);
+  }
+
+  /**
+   * Calculate lengths of link sub-packets
+   *
+   * Table 4 of ECal DAQ Specifications.
+   *
+   * Each ROC link has 3 header words, a common mode channel, and
+   * a trailing CRC checksum word. The 3 header words contain a readout map
+   * of which channels are included in the DAQ packet, so we end up with.
+   *
+   *  len of link = 3 + 1 + channels.size() + 1;
+   *
+   * The total FPGA packet includes at least 2 header words, a trailing
+   * checksum word, and a single word for each four links.
+   *
+   *  n_linkwords = (nlinks/4+(nlinks%4!=0))
+   *  total_length = 2 + n_linkwords + subpacket_total + 1;
+   *
+   * The common mode channel and the trailing FPGA checksum are not
+   * written yet, so a bunch takes up two fewer words per FPGA packet
+   * and one fewer per link than these lengths.
+   */
+  auto link_length = [](const Link& l) { return 3 + 1 + l.n_digis + 1; };
+  std::size_t bunch_size{0};
+  for (std::size_t i_link{0}; i_link < links_.size();) {
+    std::size_t end_link{i_link};
+    while (end_link < links_.size() and
+           links_[end_link].fiber == links_[i_link].fiber)
+      end_link++;
+    uint32_t n_links = end_link - i_link;
+    bunch_size += 2 + n_links / 4 + (n_links % 4 != 0);
+    for (; i_link < end_link; i_link++)
+      bunch_size += 3 + links_[i_link].n_digis + 1;
   }
 
   /**
    * Encoding
    *
-   * Now that the samples are sorted into per-bunch groupings,
-   * we can start writing this data into the encoded data format
-   * documented in the ECal DAQ specifications. Since the class
-   * HgcrocDigiCollection::Sample handles the encoding and decoding
-   * of specific sample words, we "only" need to actually encode
-   * the header information the calculate the CRC checksums.
+   * Now that the samples are sorted into electronics order, we can
+   * write this data into the encoded data format documented in the
+   * ECal DAQ specifications. Since the class HgcrocDigiCollection::Sample
+   * handles the encoding and decoding of specific sample words, we "only"
+   * need to actually encode the header information the calculate the CRC
+   * checksums.
    */
-  std::vector<uint32_t> buffer;
-  static uint32_t word;  // word to use for constructing buffer
-  uint32_t i_bx{0};
-  for (auto const& bunch : sorted_samples) {
+  std::vector<uint32_t> buffer(bunch_size * n_samples);
+  uint32_t* out{buffer.data()};
+  for (uint32_t i_bx{0}; i_bx < n_samples; i_bx++) {
     /**TODO calculate bunch ID, read request, and orbit from sample ID, event
      * number, and run number placeholder: bunch ID = event number read request
      * = sample ID orbit = run number
@@ -82,43 +168,20 @@ void EcalRawEncoder::produce(framework::Event& event) {
     uint32_t bunch_id = event.getEventNumber();
     uint32_t rreq = i_bx;
     uint32_t orbit = event.getEventHeader().getRun();
+    const uint32_t* sample{samples_.data() + std::size_t(i_bx) * n_digis};
 
-    // bunch lists the fpgs, links, and channels with their corresponding sample
-    for (auto const& [fpga_id, links] : bunch) {
-      /**
-       * Calculate lengths of link sub-packets
-       *
-       * Table 4 of ECal DAQ Specifications.
-       *
-       * Each ROC link has 3 header words, a common mode channel, and
-       * a trailing CRC checksum word. The 3 header words contain a readout map
-       * of which channels are included in the DAQ packet, so we end up with.
-       *
-       *  len of link = 3 + 1 + channels.size() + 1;
-       */
-      std::vector<uint32_t> link_lengths;
-      for (auto const& [link_id, channels] : links) {
-        link_lengths.push_back(3 + 1 + channels.size() + 1);
-      }
-
-      /**
-       * The total FPGA packet includes at least 2 header words, a trailing
-       * checksum word, and a single word for each four links.
-       *
-       * This means we add up the subpacket lengths into subpacket_total
-       * and then
-       *
-       *  n_linkwords = (nlinks/4+(nlinks%4!=0))
-       *  total_length = 2 + n_linkwords + subpacket_total + 1;
-       */
-      uint32_t n_linkwords =
-          link_lengths.size() / 4 + (link_lengths.size() % 4 != 0);
+    for (std::size_t i_link{0}; i_link < links_.size();) {
+      std::size_t end_link{i_link};
+      while (end_link < links_.size() and
+             links_[end_link].fiber == links_[i_link].fiber)
+        end_link++;
+      uint32_t fpga_id{links_[i_link].fiber};
+      uint32_t n_links = end_link - i_link;
+      uint32_t n_linkwords = n_links / 4 + (n_links % 4 != 0);
       uint32_t total_length{2 + n_linkwords + 1};
-      for (uint32_t const& link_len : link_lengths) {
-        total_length += link_len;
-      }
+      for (std::size_t j{i_link}; j < end_link; j++)
+        total_length += link_length(links_[j]);
 
-      packing::utility::CRC fpga_crc;
       /** Encode Bunch Header
        * We have a few words of header material before the actual data.
        * This header material is assumed to be encoded as in Table 3
@@ -134,20 +197,18 @@ void EcalRawEncoder::produce(framework::Event& event) {
        *  RID ok (1) | CDC ok (1) | LEN0 (6)
        * ... other listing of links ...
        */
-      word = 0;
-      word |= (1 << 12 + 1 + 6 + 8);                                 // version
-      word |= (fpga_id & packing::utility::mask<8>) << 12 + 1 + 6;   // FPGA
-      word |= (links.size() & packing::utility::mask<6>) << 12 + 1;  // NLINKS
-      word |= (total_length & packing::utility::mask<12>);           // LEN TODO
-      buffer.push_back(word);
-      fpga_crc << word;
+      uint32_t word{0};
+      word |= (1 << 12 + 1 + 6 + 8);                                // version
+      word |= (fpga_id & packing::utility::mask<8>) << 12 + 1 + 6;  // FPGA
+      word |= (n_links & packing::utility::mask<6>) << 12 + 1;      // NLINKS
+      word |= (total_length & packing::utility::mask<12>);          // LEN TODO
+      *out++ = word;
 
       word = 0;
       word |= (bunch_id & packing::utility::mask<12>) << 20;  // BX ID
       word |= (rreq & packing::utility::mask<10>) << 10;      // RREQ
       word |= (orbit & packing::utility::mask<10>);           // OR
-      buffer.push_back(word);
-      fpga_crc << word;
+      *out++ = word;
 
       /**
        * Encode lengths of link subpackets
@@ -155,31 +216,19 @@ void EcalRawEncoder::produce(framework::Event& event) {
       for (uint32_t i_linkword{0}; i_linkword < n_linkwords; i_linkword++) {
         word = 0;
         for (uint32_t i_linklen{0}; i_linklen < 4; i_linklen++) {
-          uint32_t i_link = 4 * i_linkword + i_linklen;
-          if (i_link <= link_lengths.size()) {
+          uint32_t i = 4 * i_linkword + i_linklen;
+          if (i < n_links) {
             // we have a link
-            word |= (((0b11 << 6) +
-                      (link_lengths.at(i_link) & packing::utility::mask<6>))
+            word |= (((0b11 << 6) + (link_length(links_[i_link + i]) &
+                                     packing::utility::mask<6>))
                      << 8 * i_linklen);
           }  // do we have a link for this linklen subword?
         }    // loop through subwords in this word
-        buffer.push_back(word);
-        fpga_crc << word;
+        *out++ = word;
       }  // loop through words
 
-      // fpga lists the links and channels with their corresponding sample
-      for (auto const& [link_id, channels] : links) {
-        /**
-         * Prepare RO Map bitset
-         */
-        std::bitset<40> ro_map;  // starts as all 0s
-        ro_map.set(0);           // special "header" word from ROC
-        ro_map.set(39);          // trailing checksum from ROC
-        // each link maps the channels that were readout to their sample
-        for (auto const& [channel, sample] : channels) {
-          ro_map.set(channel);
-        }
-
+      for (; i_link < end_link; i_link++) {
+        const Link& l{links_[i_link]};
         packing::utility::CRC link_crc;
         /** Encode Each Link in Sequence
          * Now we should be decoding each link serially
@@ -189,21 +238,17 @@ void EcalRawEncoder::produce(framework::Event& event) {
          * ROC_ID (16) | CRC ok (1) | 00000 | RO Map (8)
          * RO Map (32)
          */
-
         word = 0;
-        word |= (link_id & packing::utility::mask<16>) << 16;
+        word |= (l.elink & packing::utility::mask<16>) << 16;
         word |= 1 << 15;
         // put first 8bits of RO Map in first header word
-        word |= (ro_map >> 32).to_ulong();
-
-        buffer.push_back(word);
-        fpga_crc << word;
+        word |= (l.ro_map >> 32) & packing::utility::mask<8>;
+        *out++ = word;
         link_crc << word;
 
         // next header word is end of RO map
-        word = (ro_map.to_ulong() & 0xFFFFFFFF);
-        buffer.push_back(word);
-        fpga_crc << word;
+        word = (l.ro_map & 0xFFFFFFFF);
+        *out++ = word;
         link_crc << word;
 
         // special "header" word from ROC
@@ -215,8 +260,7 @@ void EcalRawEncoder::produce(framework::Event& event) {
         // skipping hamming error bits because we will set them all to false
         // here
         word |= 0b0101;
-        buffer.push_back(word);
-        fpga_crc << word;
+        *out++ = word;
         link_crc << word;
 
         /**
@@ -228,16 +272,13 @@ void EcalRawEncoder::produce(framework::Event& event) {
          */
 
         // put samples into buffer
-        for (auto const& [channel, sample] : channels) {
-          buffer.push_back(sample);
-          fpga_crc << sample;
-          link_crc << sample;
+        for (uint32_t i_digi{0}; i_digi < l.n_digis; i_digi++) {
+          *out++ = *sample;
+          link_crc << *sample++;
         }
-        buffer.push_back(link_crc.get());
-        fpga_crc << link_crc.get();
+        *out++ = link_crc.get();
       }
     }
-    i_bx++;
   }
 
   event.add(output_name_, buffer);
@@ -11,6 +11,7 @@
 #include "Ecal/Event/EcalHit.h"
 #include "Recon/Event/HgcrocDigiCollection.h"
 #include "SimCore/Event/SimCalorimeterHit.h"
+#include "SimCore/Event/SimCalorimeterHitCollection.h"
 
 namespace ecal {
 
@@ -26,6 +27,7 @@ void EcalRecProducer::configure(framework::config::Parameters& ps) {
   digiPassName_ = ps.getParameter<std::string>("digiPassName");
   simHitCollName_ = ps.getParameter<std::string>("simHitCollName");
   simHitPassName_ = ps.getParameter<std::string>("simHitPassName");
+  packedSimHits_ = ps.getParameter<bool>("packed_sim_hits", false);
   recHitCollName_ = ps.getParameter<std::string>("recHitCollName");
 
   layerWeights_ = ps.getParameter<std::vector<double>>("layerWeights");
@@ -35,6 +37,8 @@ void EcalRecProducer::configure(framework::config::Parameters& ps) {
   mip_si_energy_ = ps.getParameter<double>("mip_si_energy");
   clock_cycle_ = ps.getParameter<double>("clock_cycle");
   charge_per_mip_ = ps.getParameter<double>("charge_per_mip");
+
+  columnar_ = ps.getParameter<bool>("columnar", false);
 }
 
 void EcalRecProducer::produce(framework::Event& event) {
@@ -42,26 +46,33 @@ void EcalRecProducer::produce(framework::Event& event) {
   const auto& geometry = getCondition<ldmx::EcalGeometry>(
       ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME);
 
-  // Get the reconstruction parameters
-  EcalReconConditions the_conditions(
-      getCondition<conditions::DoubleTableCondition>(
-          EcalReconConditions::CONDITIONS_NAME));
+  // Get the reconstruction parameters, only wrapping the table again
+  // when it has been reloaded
+  const auto& table =
+      getCondition<conditions::DoubleTableCondition>(conditions_handle_);
+  if (conditions_handle_.changed()) {
+    conditions_ = std::make_unique<EcalReconConditions>(table, true, columnar_);
+  }
+  const EcalReconConditions& the_conditions{*conditions_};
 
   std::vector<ldmx::EcalHit> ecalRecHits;
-  auto ecalDigis =
+  const auto& ecalDigis =
       event.getObject<ldmx::HgcrocDigiCollection>(digiCollName_, digiPassName_);
+  // the samples decoded once for all of the processors reading them
+  const auto& decoded{ecalDigis.decoded()};
   // loop through digis
-  for (auto digi : ecalDigis) {
+  for (unsigned int i_digi{0}; i_digi < ecalDigis.getNumDigis(); i_digi++) {
     // ID from first digi sample
     //  assuming rest of samples have same ID
-    ldmx::EcalID id(digi.id());
+    ldmx::EcalID id(ecalDigis.getDigiID(i_digi));
+    std::size_t soi{decoded.soi(i_digi)};
 
     // ID to real space position
     auto [x, y, z] = geometry.getPosition(id);
 
     // TOA is the time of arrival with respect to the 25ns clock window
     //  TODO what to do if hit NOT in first clock cycle?
-    double timeRelClock25 = digi.soi().toa() * (clock_cycle_ / 1024);  // ns
+    double timeRelClock25 = decoded.toa[soi] * (clock_cycle_ / 1024);  // ns
     double hitTime = timeRelClock25;
 
     // get the estimated charge deposited from digi samples
@@ -72,7 +83,7 @@ void EcalRecProducer::produce(framework::Event& event) {
         << "ID: " << id << ", "
         << "TOA: " << hitTime << "ns } ";
         */
-    if (digi.isTOT()) {
+    if (decoded.isTOT(i_digi)) {
       // TOT - number of clock ticks that pulse was over threshold
       //  this is related to the amplitude of the pulse approximately through a
       //  linear drain rate the amplitude of the pulse is related to the energy
@@ -81,11 +92,14 @@ void EcalRecProducer::produce(framework::Event& event) {
       // convert the time over threshold into a total energy deposited in the
       // silicon
       //  (time over threshold [ns] - pedestal) * gain
-      charge = (digi.tot() - the_conditions.totPedestal(id)) *
-               the_conditions.totGain(id);
+      auto chip{the_conditions.row(id)};
+      charge = (decoded.digiTOT(i_digi) -
+                chip[EcalReconConditions::ITOT_PEDESTAL]) *
+               chip[EcalReconConditions::ITOT_GAIN];
 
       /* debug printout
-      std::cout << "TOT Mode -> " << digi.tot() << "TDC -> " << charge << " fC";
+      std::cout << "TOT Mode -> " << decoded.digiTOT(i_digi) << "TDC -> "
+                << charge << " fC";
        */
     } else {
       // ADC mode of readout
@@ -104,8 +118,9 @@ void EcalRecProducer::produce(framework::Event& event) {
       // available. For now, we simply take the measurement of the SOI as the
       // peak amplitude.
 
-      charge = (digi.soi().adc_t() - the_conditions.adcPedestal(id)) *
-               the_conditions.adcGain(id);
+      auto chip{the_conditions.row(id)};
+      charge = (decoded.adc_t[soi] - chip[EcalReconConditions::IADC_PEDESTAL]) *
+               chip[EcalReconConditions::IADC_GAIN];
 
       /* debug printout
       std::cout << "ADC Mode -> " << charge << " fC";
@@ -159,16 +174,24 @@ void EcalRecProducer::produce(framework::Event& event) {
   if (event.exists(simHitCollName_, simHitPassName_)) {
     // ecal sim hits exist ==> label which hits are real and which are pure
     // noise
-    auto ecalSimHits{event.getCollection<ldmx::SimCalorimeterHit>(
-        simHitCollName_, simHitPassName_)};
     std::set<int> real_hits;
-    for (auto const& sim_hit : ecalSimHits) real_hits.insert(sim_hit.getID());
+    if (packedSimHits_) {
+      const auto& ecalSimHits{
+          event.getObject<ldmx::SimCalorimeterHitCollection>(
+              simHitCollName_, simHitPassName_)};
+      for (std::size_t i = 0; i < ecalSimHits.size(); i++)
+        real_hits.insert(ecalSimHits.getHit(i).getID());
+    } else {
+      const auto& ecalSimHits{event.getCollection<ldmx::SimCalorimeterHit>(
+          simHitCollName_, simHitPassName_)};
+      for (auto const& sim_hit : ecalSimHits) real_hits.insert(sim_hit.getID());
+    }
     for (auto& hit : ecalRecHits)
       hit.setNoise(real_hits.find(hit.getID()) == real_hits.end());
   }
 
   // add collection to event bus
-  event.add(recHitCollName_, ecalRecHits);
+  event.add(recHitCollName_, std::move(ecalRecHits));
 }
 
 }  // namespace ecal
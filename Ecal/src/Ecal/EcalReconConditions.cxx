@@ -12,8 +12,15 @@ const std::vector<std::string> EcalReconConditions::EXPECTED_COLUMNS = {
     "ADC_PEDESTAL", "ADC_GAIN", "TOT_PEDESTAL", "TOT_GAIN"};
 
 EcalReconConditions::EcalReconConditions(
-    const conditions::DoubleTableCondition& table, bool validate)
+    const conditions::DoubleTableCondition& table, bool validate,
+    bool columnar)
     : the_table_{table} {
+  // the cell is the inner field of the EcalID, the module and layer the outer
+  if (columnar) {
+    columns_ =
+        std::make_unique<const conditions::TableColumns<double>>(table, 12, 11);
+  }
+
   // leave early if we don't want to validate
   if (!validate) return;
 
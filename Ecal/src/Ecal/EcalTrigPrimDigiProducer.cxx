@@ -1,5 +1,7 @@
 #include "Ecal/EcalTrigPrimDigiProducer.h"
 
+#include <algorithm>
+
 #include "Ecal/EcalTriggerGeometry.h"
 #include "Recon/Event/HgcrocDigiCollection.h"
 #include "Recon/Event/HgcrocTrigDigi.h"
@@ -28,10 +30,16 @@ void EcalTrigPrimDigiProducer::produce(framework::Event& event) {
   const conditions::IntegerTableCondition& conditions =
       getCondition<conditions::IntegerTableCondition>(condObjName_);
 
-  // construct the calculator...
-  ldmx::HgcrocTriggerCalculations calc(conditions);
+  // the conditions are validated once, then looked up per channel
+  ldmx::HgcrocTriggerConditions tconds(conditions);
+
+  // trigger IDs only differ in their layer, module and cell fields
+  static const unsigned int index_mask =
+      (ldmx::EcalTriggerID::LAYER_MASK << ldmx::EcalTriggerID::LAYER_SHIFT) |
+      (ldmx::EcalTriggerID::MODULE_MASK << ldmx::EcalTriggerID::MODULE_SHIFT) |
+      (ldmx::EcalTriggerID::CELL_MASK << ldmx::EcalTriggerID::CELL_SHIFT);
 
-  // Loop over the digis
+  // Loop over the digis, summing the charge into the trigger cells
   for (unsigned int ix = 0; ix < ecalDigis.getNumDigis(); ix++) {
     const ldmx::HgcrocDigiCollection::HgcrocDigi pdigi = ecalDigis.getDigi(ix);
     // std::cout << EcalID(pdigi.id()) << pdigi << std::endl;
@@ -41,23 +49,39 @@ void EcalTrigPrimDigiProducer::produce(framework::Event& event) {
     if (!tid.null()) {
       int tot = 0;
       if (pdigi.soi().isTOTComplete()) tot = pdigi.soi().tot();
-      calc.addDigi(pdigi.id(), tid.raw(), pdigi.soi().adc_t(), tot);
+      unsigned int id = pdigi.id();
+      unsigned int charge =
+          ldmx::HgcrocTriggerCalculations::singleChannelCharge(
+              pdigi.soi().adc_t(), tot, tconds.adcPedestal(id),
+              tconds.adcThreshold(id), tconds.totPedestal(id),
+              tconds.totThreshold(id), tconds.totGain(id));
+      if (charge > 0) {
+        unsigned int index = tid.raw() & index_mask;
+        if (index >= linearCharge_.size()) linearCharge_.resize(index + 1, 0);
+        if (linearCharge_[index] == 0) filled_.push_back(tid.raw());
+        linearCharge_[index] += charge;
+      }
     }
   }
 
-  // Now, we compress the digis
-  calc.compressDigis(9);  // 9 is the number for Ecal...
+  // Now, we compress the digis in order of trigger ID
+  // 9 is the number for Ecal...
+  int shift = ldmx::HgcrocTriggerCalculations::compressionShift(9);
+  std::sort(filled_.begin(), filled_.end());
 
-  const std::map<unsigned int, uint8_t>& results = calc.compressedEnergies();
   ldmx::HgcrocTrigDigiCollection tdigis;
-
-  for (auto result : results) {
-    if (result.second > 0) {
-      tdigis.push_back(ldmx::HgcrocTrigDigi(result.first, result.second));
-      // std::cout << EcalTriggerID(result.first) << "  " << tdigis.back() <<
+  tdigis.reserve(filled_.size());
+  for (unsigned int tid : filled_) {
+    unsigned int& lcharge = linearCharge_[tid & index_mask];
+    uint8_t ccharge = ldmx::HgcrocTrigDigi::linear2Compressed(lcharge >> shift);
+    lcharge = 0;
+    if (ccharge > 0) {
+      tdigis.push_back(ldmx::HgcrocTrigDigi(tid, ccharge));
+      // std::cout << EcalTriggerID(tid) << "  " << tdigis.back() <<
       // std::endl;
     }
   }
+  filled_.clear();
 
   // std::cout << ecalDigis.size() << " " << tdigis.size() << std::endl;
   event.add(getName(), tdigis);
@@ -22,38 +22,37 @@ EcalTriggerGeometry::EcalTriggerGeometry(int symmetry,
       symmetry_{symmetry},
       ecalGeometry_{ecalGeom} {
   if ((symmetry_ & MODULES_MASK) == INPLANE_IDENTICAL) {
+    // associate a precision cell with the trigger cell being built
+    auto add = [this](int tcell, const ldmx::EcalID& pid) {
+      if (pid.cell() >= int(cell2trigger_.size()))
+        cell2trigger_.resize(pid.cell() + 1, -1);
+      cell2trigger_[pid.cell()] = tcell;
+      trigger2cells_[tcell].push_back(pid.cell());
+    };
     // first set is the same regardless of alignment...
     int tcell = 0;
     /// lower left-sector
     for (int v = 1; v <= 10; v += 3) {
       for (int u = 1; u <= 10; u += 3) {
-        ldmx::EcalTriggerID tid(0, 0, tcell);
-        std::vector<ldmx::EcalID> pids;
+        trigger2cells_.emplace_back();
         for (int du = -1; du <= 1; du++) {
           for (int dv = -1; dv <= 1; dv++) {
-            ldmx::EcalID pid(0, 0, u + du, v + dv);
-            precision2trigger_[pid] = tid;
-            pids.push_back(pid);
+            add(tcell, ldmx::EcalID(0, 0, u + du, v + dv));
           }
         }
-        trigger2precision_[tid] = pids;
         tcell++;
       }
     }
     /// upper-left sector
     for (int v = 13; v <= 22; v += 3) {
       for (int u = v - 10; u <= v; u += 3) {
-        ldmx::EcalTriggerID tid(0, 0, tcell);
-        std::vector<ldmx::EcalID> pids;
+        trigger2cells_.emplace_back();
         for (int dv = -1; dv <= 1; dv++) {
           for (int du = -1; du <= 1; du++) {
-            ldmx::EcalID pid(0, 0, u + du + dv,
-                             v + dv);  // changes directions here
-            precision2trigger_[pid] = tid;
-            pids.push_back(pid);
+            add(tcell, ldmx::EcalID(0, 0, u + du + dv,
+                                    v + dv));  // changes directions here
           }
         }
-        trigger2precision_[tid] = pids;
         tcell++;
       }
     }
@@ -62,38 +61,38 @@ EcalTriggerGeometry::EcalTriggerGeometry(int symmetry,
       int irow = (v - 2) / 3;
       for (int icol = 0; icol <= std::min(irow, 3); icol++) {
         if (irow - icol >= 4) continue;
-        ldmx::EcalTriggerID tid(0, 0, tcell);
-        std::vector<ldmx::EcalID> pids;
+        trigger2cells_.emplace_back();
         int u = 13 + 3 * icol;
         for (int dv = -1; dv <= 1; dv++) {
           for (int du = -1; du <= 1; du++) {
-            ldmx::EcalID pid(0, 0, u + du, v + du + dv);
-            precision2trigger_[pid] = tid;
-            pids.push_back(pid);
+            add(tcell, ldmx::EcalID(0, 0, u + du, v + du + dv));
           }
         }
-        trigger2precision_[tid] = pids;
         tcell++;
       }
     }
-
   } else {
     // raise an exception...
   }
 }
 
+const std::vector<int>& EcalTriggerGeometry::cellsInTriggerCell(
+    int triggerCell) const {
+  static const std::vector<int> none;
+  if (triggerCell < 0 or triggerCell >= int(trigger2cells_.size()))
+    return none;
+  return trigger2cells_[triggerCell];
+}
+
 std::vector<ldmx::EcalID> EcalTriggerGeometry::contentsOfTriggerCell(
     ldmx::EcalTriggerID triggerCell) const {
-  ldmx::EcalTriggerID effId;
   std::vector<ldmx::EcalID> retval;
   if ((symmetry_ & MODULES_MASK) == INPLANE_IDENTICAL) {
-    effId = ldmx::EcalTriggerID(0, 0, triggerCell.triggercell());
-  }
-  auto ptr = trigger2precision_.find(effId);
-  if (ptr != trigger2precision_.end()) {
-    for (auto idz : ptr->second) {
+    const auto& cells{cellsInTriggerCell(triggerCell.triggercell())};
+    retval.reserve(cells.size());
+    for (int cell : cells) {
       retval.push_back(
-          ldmx::EcalID(triggerCell.layer(), triggerCell.module(), idz.cell()));
+          ldmx::EcalID(triggerCell.layer(), triggerCell.module(), cell));
     }
   }
   return retval;
@@ -101,34 +100,27 @@ std::vector<ldmx::EcalID> EcalTriggerGeometry::contentsOfTriggerCell(
 
 ldmx::EcalID EcalTriggerGeometry::centerInTriggerCell(
     ldmx::EcalTriggerID triggerCell) const {
-  ldmx::EcalTriggerID effId;
-  if ((symmetry_ & MODULES_MASK) == INPLANE_IDENTICAL) {
-    effId = ldmx::EcalTriggerID(0, 0, triggerCell.triggercell());
-  }
-  auto ptr = trigger2precision_.find(effId);
-  if (ptr == trigger2precision_.end()) {
+  const auto& cells{cellsInTriggerCell(triggerCell.triggercell())};
+  if ((symmetry_ & MODULES_MASK) != INPLANE_IDENTICAL or cells.empty()) {
     std::stringstream ss;
     ss << "Unable to find trigger cell " << triggerCell;
     EXCEPTION_RAISE("EcalGeometryException", ss.str());
   }
 
-  return ldmx::EcalID(triggerCell.layer(), triggerCell.module(),
-                      ptr->second[4].cell());
+  return ldmx::EcalID(triggerCell.layer(), triggerCell.module(), cells[4]);
 }
 
 ldmx::EcalTriggerID EcalTriggerGeometry::belongsTo(
     ldmx::EcalID precisionCell) const {
-  ldmx::EcalID effId;
   if ((symmetry_ & MODULES_MASK) == INPLANE_IDENTICAL) {
-    effId = ldmx::EcalID(0, 0, precisionCell.cell());
-  }
-  auto ptr = precision2trigger_.find(effId);
-  if (ptr == precision2trigger_.end()) {
-    return ldmx::EcalTriggerID(0, 0, 0);  // not ideal
-  } else {
-    return ldmx::EcalTriggerID(precisionCell.layer(), precisionCell.module(),
-                               ptr->second.triggercell());
+    int cell{precisionCell.cell()};
+    if (cell >= 0 and cell < int(cell2trigger_.size()) and
+        cell2trigger_[cell] >= 0) {
+      return ldmx::EcalTriggerID(precisionCell.layer(), precisionCell.module(),
+                                 cell2trigger_[cell]);
+    }
   }
+  return ldmx::EcalTriggerID(0, 0, 0);  // not ideal
 }
 
 // as it happens, the fifth precision cell in the list is the center cell
@@ -167,9 +159,9 @@ class EcalTriggerGeometryProvider : public framework::ConditionsObjectProvider {
 
   /**
    * Provides access to the EcalGeometry or EcalTriggerGeometry
-   * @note Currently, these are assumed to be valid for all time, but this
-   * behavior could be changed.  Users should not cache the pointer between
-   * events
+   * @note The trigger geometry is built once and is valid for all runs.
+   * Users should still not cache the pointer between events, but request
+   * it through the conditions system.
    */
   virtual std::pair<const framework::ConditionsObject*,
                     framework::ConditionsIOV>
@@ -183,9 +175,8 @@ class EcalTriggerGeometryProvider : public framework::ConditionsObjectProvider {
       ecalTriggerGeometry_ = new EcalTriggerGeometry(
           INPLANE_IDENTICAL | LAYERS_IDENTICAL, ecalgeom);
     }
-    return std::make_pair(ecalTriggerGeometry_,
-                          framework::ConditionsIOV(
-                              context.getRun(), context.getRun(), true, true));
+    // built from the geometry, which is valid for all runs
+    return std::make_pair(ecalTriggerGeometry_, framework::ConditionsIOV(true, true));
   }
 
   /**
@@ -3,6 +3,7 @@
 // LDMX
 #include "DetDescr/SimSpecialID.h"
 #include "Ecal/Event/EcalHit.h"
+#include "Framework/Performance/Profile.h"
 #include "Recon/Event/EventConstants.h"
 #include "SimCore/Event/SimParticle.h"
 #include "SimCore/Event/SimTrackerHit.h"
@@ -26,8 +27,60 @@
 
 namespace ecal {
 
+namespace {
+/**
+ * Distance between two hit positions
+ *
+ * This is the same as (a - b).Mag() but without making a TVector3
+ * for the difference.
+ */
+double hitDistance(const TVector3 &a, const TVector3 &b) {
+  double dx{a.X() - b.X()}, dy{a.Y() - b.Y()}, dz{a.Z() - b.Z()};
+  return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+/**
+ * Find the containment region a hit is in
+ *
+ * Region i is the annulus from i to (i+1) times the radius around
+ * the trajectory.
+ *
+ * @param[in] distance distance of the hit from the trajectory, -1 if missing
+ * @param[in] radius containment radius in the layer of the hit
+ * @param[in] n_regions number of regions
+ * @return index of the region, n_regions if it is in none of them
+ */
+unsigned char containmentRegion(float distance, double radius,
+                                unsigned int n_regions) {
+  for (unsigned int ireg = 0; ireg < n_regions; ireg++) {
+    if (distance >= ireg * radius && distance < (ireg + 1) * radius)
+      return ireg;
+  }
+  return n_regions;
+}
+
+/**
+ * Find the regions a hit is outside of for both trajectories
+ *
+ * @return mask with bit i set if the hit is further than (i+1) times the
+ * radius from both the electron and the photon trajectory
+ */
+unsigned char outsideRegions(float distance_ele, double ele_radius,
+                             float distance_photon, double photon_radius,
+                             unsigned int n_regions) {
+  unsigned char mask{0};
+  for (unsigned int ireg = 0; ireg < n_regions; ireg++) {
+    if (distance_ele > (ireg + 1) * ele_radius &&
+        distance_photon > (ireg + 1) * photon_radius)
+      mask |= (1 << ireg);
+  }
+  return mask;
+}
+}  // namespace
+
 void EcalVetoProcessor::buildBDTFeatureVector(
     const ldmx::EcalVetoResult &result) {
+  LDMX_PROFILE_SCOPE("EcalVeto::buildBDTFeatureVector");
   // Base variables
   bdtFeatures_.push_back(result.getNReadoutHits());
   bdtFeatures_.push_back(result.getSummedDet());
@@ -88,8 +141,22 @@ void EcalVetoProcessor::configure(framework::config::Parameters &parameters) {
   doBdt_ = parameters.getParameter<bool>("do_bdt");
   featureListName_ = parameters.getParameter<std::string>("feature_list_name");
   if (doBdt_) {
-    rt_ = std::make_unique<ldmx::Ort::ONNXRuntime>(
-        parameters.getParameter<std::string>("bdt_file"));
+    ldmx::Ort::ONNXRuntime::Options onnx_options;
+    onnx_options.intra_op_threads =
+        parameters.getParameter<int>("intra_op_threads", 1);
+    onnx_options.inter_op_threads =
+        parameters.getParameter<int>("inter_op_threads", 1);
+    onnx_options.optimization_level =
+        parameters.getParameter<std::string>("optimization_level", "all");
+    onnx_options.optimized_model_path =
+        parameters.getParameter<std::string>("optimized_model_path", "");
+    onnx_options.execution_provider =
+        parameters.getParameter<std::string>("execution_provider", "cpu");
+    rt_ = ldmx::Ort::ONNXRuntime::get(
+        parameters.getParameter<std::string>("bdt_file"), onnx_options);
+    binding_ = rt_->bind(1, {"probabilities"});
+    // the BDT is run on all of the events of a batch at once
+    declareBatchProduce();
   }
 
   cellFileNamexy_ = parameters.getParameter<std::string>("cellxy_file");
@@ -147,11 +214,28 @@ void EcalVetoProcessor::configure(framework::config::Parameters &parameters) {
   collectionName_ = parameters.getParameter<std::string>("collection_name");
   rec_pass_name_ = parameters.getParameter<std::string>("rec_pass_name");
   rec_coll_name_ = parameters.getParameter<std::string>("rec_coll_name");
+
+  // intern the products we read so we don't look them up by name each event
+  sim_particles_handle_ = framework::Event::getHandle("SimParticles");
+  ecal_sp_hits_handle_ = framework::Event::getHandle("EcalScoringPlaneHits");
+  target_sp_hits_handle_ =
+      framework::Event::getHandle("TargetScoringPlaneHits");
+  rec_hits_handle_ =
+      framework::Event::getHandle(rec_coll_name_, rec_pass_name_);
+}
+
+void EcalVetoProcessor::ContainmentHits::clear() {
+  x.clear();
+  y.clear();
+  distEle.clear();
+  distPhoton.clear();
+  segment.clear();
+  eleRegion.clear();
+  photonRegion.clear();
+  outside.clear();
 }
 
 void EcalVetoProcessor::clearProcessor() {
-  cellMap_.clear();
-  cellMapTightIso_.clear();
   bdtFeatures_.clear();
 
   nReadoutHits_ = 0;
@@ -181,12 +265,99 @@ void EcalVetoProcessor::clearProcessor() {
 }
 
 void EcalVetoProcessor::produce(framework::Event &event) {
+  ldmx::EcalVetoResult result;
+  bool inside = computeVariables(event, result);
+
+  float pred{0};
+  if (doBdt_) {
+    LDMX_PROFILE_SCOPE("EcalVeto::bdt");
+    setBDTFeatures(result, *binding_, 0);
+    rt_->run(*binding_);
+    pred = binding_->output("probabilities").at(1);
+  }
+
+  addResult(event, result, inside, pred);
+}
+
+void EcalVetoProcessor::produceBatch(
+    const std::vector<framework::Event *> &events) {
+  // the bound arrays are kept for the following batches of the same size
+  if (!batchBinding_ || batchBinding_->batchSize() != (int64_t)events.size()) {
+    batchBinding_ = rt_->bind(events.size(), {"probabilities"});
+  }
+
+  // the features of the events are placed one after the other
+  std::vector<ldmx::EcalVetoResult> results(events.size());
+  std::vector<bool> inside(events.size());
+  for (std::size_t i_event = 0; i_event < events.size(); i_event++) {
+    inside[i_event] = computeVariables(*events[i_event], results[i_event]);
+    setBDTFeatures(results[i_event], *batchBinding_, i_event);
+  }
+
+  rt_->run(*batchBinding_);
+
+  // the outputs of each event are also one after the other
+  const auto &outputs = batchBinding_->output("probabilities");
+  std::size_t n_outputs = outputs.size() / events.size();
+  for (std::size_t i_event = 0; i_event < events.size(); i_event++) {
+    addResult(*events[i_event], results[i_event], inside[i_event],
+              outputs.at(i_event * n_outputs + 1));
+  }
+}
+
+void EcalVetoProcessor::setBDTFeatures(
+    const ldmx::EcalVetoResult &result,
+    ldmx::Ort::ONNXRuntime::Binding &binding, std::size_t i_event) {
+  buildBDTFeatureVector(result);
+  auto &input = binding.input(featureListName_);
+  std::size_t n_features = input.size() / binding.batchSize();
+  if (bdtFeatures_.size() != n_features) {
+    EXCEPTION_RAISE("EcalVetoProcessor",
+                    "The BDT takes " + std::to_string(n_features) +
+                        " features but " +
+                        std::to_string(bdtFeatures_.size()) + " were built.");
+  }
+  std::copy(bdtFeatures_.begin(), bdtFeatures_.end(),
+            input.begin() + i_event * n_features);
+}
+
+void EcalVetoProcessor::addResult(framework::Event &event,
+                                  ldmx::EcalVetoResult &result, bool inside,
+                                  float pred) {
+  if (doBdt_) {
+    // Removing electron-photon separation step, near photon step due to lower
+    // v12 performance; may reconsider
+    bool passesTrackingVeto = (result.getNStraightTracks() < 3) &&
+                              (result.getNLinRegTracks() == 0);
+    //&&  //Commenting the remainder for now
+    //(firstNearPhLayer_ >= 6); //&& (epAng_ > 3.0 || epSep_ > 10.0);
+    result.setVetoResult(pred > bdtCutVal_ && passesTrackingVeto);
+    result.setDiscValue(pred);
+    ldmx_log(debug) << "  The pred > bdtCutVal = " << (pred > bdtCutVal_);
+
+    // If the event passes the veto, keep it. Otherwise,
+    // drop the event.
+    if (result.passesVeto() && inside) {
+      setStorageHint(event, framework::hint_shouldKeep);
+    } else {
+      setStorageHint(event, framework::hint_shouldDrop);
+    }
+  }
+
+  if (inside) {
+    setStorageHint(event, framework::hint_shouldKeep);
+  } else {
+    setStorageHint(event, framework::hint_shouldDrop);
+  }
+  event.add(collectionName_, result);
+}
+
+bool EcalVetoProcessor::computeVariables(framework::Event &event,
+                                         ldmx::EcalVetoResult &result) {
   // Get the Ecal Geometry
   geometry_ = &getCondition<ldmx::EcalGeometry>(
       ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME);
 
-  ldmx::EcalVetoResult result;
-
   clearProcessor();
 
   // Get the collection of Ecal scoring plane hits. If it doesn't exist,
@@ -197,29 +368,29 @@ void EcalVetoProcessor::produce(framework::Event &event) {
   std::vector<double> recoilPAtTarget;
   std::vector<float> recoilPosAtTarget;
 
-  if (event.exists("EcalScoringPlaneHits")) {
+  if (event.exists(ecal_sp_hits_handle_)) {
     //
     // Loop through all of the sim particles and find the recoil electron.
     //
 
     // Get the collection of simulated particles from the event
-    auto particleMap{event.getMap<int, ldmx::SimParticle>("SimParticles")};
+    const auto &particleMap{
+        event.getMap<int, ldmx::SimParticle>(sim_particles_handle_)};
 
     // Search for the recoil electron
     auto [recoilTrackID, recoilElectron] = Analysis::getRecoil(particleMap);
 
     // Find ECAL SP hit for recoil electron
-    auto ecalSpHits{
-        event.getCollection<ldmx::SimTrackerHit>("EcalScoringPlaneHits")};
+    const auto &ecalSpHits{
+        event.getCollection<ldmx::SimTrackerHit>(ecal_sp_hits_handle_)};
     float pmax = 0;
-    for (ldmx::SimTrackerHit &spHit : ecalSpHits) {
+    for (const ldmx::SimTrackerHit &spHit : ecalSpHits) {
       ldmx::SimSpecialID hit_id(spHit.getID());
-      if (hit_id.plane() != 31 || spHit.getMomentum()[2] <= 0) continue;
+      if (hit_id.plane() != 31 || spHit.getPz() <= 0) continue;
 
       if (spHit.getTrackID() == recoilTrackID) {
-        if (sqrt(pow(spHit.getMomentum()[0], 2) +
-                 pow(spHit.getMomentum()[1], 2) +
-                 pow(spHit.getMomentum()[2], 2)) > pmax) {
+        if (sqrt(pow(spHit.getPx(), 2) + pow(spHit.getPy(), 2) +
+                 pow(spHit.getPz(), 2)) > pmax) {
           recoilP = spHit.getMomentum();
           recoilPos = spHit.getPosition();
           pmax = sqrt(pow(recoilP[0], 2) + pow(recoilP[1], 2) +
@@ -229,18 +400,17 @@ void EcalVetoProcessor::produce(framework::Event &event) {
     }
 
     // Find target SP hit for recoil electron
-    if (event.exists("TargetScoringPlaneHits")) {
-      std::vector<ldmx::SimTrackerHit> targetSpHits =
-          event.getCollection<ldmx::SimTrackerHit>("TargetScoringPlaneHits");
+    if (event.exists(target_sp_hits_handle_)) {
+      const auto &targetSpHits{
+          event.getCollection<ldmx::SimTrackerHit>(target_sp_hits_handle_)};
       pmax = 0;
-      for (ldmx::SimTrackerHit &spHit : targetSpHits) {
+      for (const ldmx::SimTrackerHit &spHit : targetSpHits) {
         ldmx::SimSpecialID hit_id(spHit.getID());
-        if (hit_id.plane() != 1 || spHit.getMomentum()[2] <= 0) continue;
+        if (hit_id.plane() != 1 || spHit.getPz() <= 0) continue;
 
         if (spHit.getTrackID() == recoilTrackID) {
-          if (sqrt(pow(spHit.getMomentum()[0], 2) +
-                   pow(spHit.getMomentum()[1], 2) +
-                   pow(spHit.getMomentum()[2], 2)) > pmax) {
+          if (sqrt(pow(spHit.getPx(), 2) + pow(spHit.getPy(), 2) +
+                   pow(spHit.getPz(), 2)) > pmax) {
             recoilPAtTarget = spHit.getMomentum();
             recoilPosAtTarget = spHit.getPosition();
             pmax =
@@ -309,12 +479,14 @@ void EcalVetoProcessor::produce(framework::Event &event) {
   std::vector<double> photon_radii = roc_values_bin0;
 
   // Get the collection of digitized Ecal hits from the event.
-  const std::vector<ldmx::EcalHit> ecalRecHits =
-      event.getCollection<ldmx::EcalHit>(rec_coll_name_, rec_pass_name_);
+  const std::vector<ldmx::EcalHit> &ecalRecHits =
+      event.getCollection<ldmx::EcalHit>(rec_hits_handle_);
 
   ldmx::EcalID globalCentroid =
       GetShowerCentroidIDAndRMS(ecalRecHits, showerRMS_);
   /* ~~ Fill the hit map ~~ O(n)  */
+  cellMap_.reset(*geometry_);
+  cellMapTightIso_.reset(*geometry_);
   fillHitMap(ecalRecHits, cellMap_);
   bool doTight = true;
   /* ~~ Fill the isolated hit maps ~~ O(n)  */
@@ -379,12 +551,55 @@ void EcalVetoProcessor::produce(framework::Event &event) {
   std::vector<std::vector<float>> oContLayerStd(
       nregions, std::vector<float>(nsegments, 0.0));
 
+  // Classify the hits into the longitudinal segments and containment regions
+  // once, so that both passes over the hits below are simple array loops
+  ContainmentHits &hits{containmentHits_};
+  hits.clear();
+  for (const ldmx::EcalHit &hit : ecalRecHits) {
+    ldmx::EcalID id(hit.getID());
+    auto [x, y, z] = geometry_->getPosition(id);
+    XYCoords xy_pair = std::make_pair(x, y);
+    float distance_ele_trajectory =
+        ele_trajectory.size()
+            ? sqrt(pow((xy_pair.first - ele_trajectory[id.layer()].first), 2) +
+                   pow((xy_pair.second - ele_trajectory[id.layer()].second), 2))
+            : -1.0;
+    float distance_photon_trajectory =
+        photon_trajectory.size()
+            ? sqrt(pow((xy_pair.first - photon_trajectory[id.layer()].first),
+                       2) +
+                   pow((xy_pair.second - photon_trajectory[id.layer()].second),
+                       2))
+            : -1.0;
+    unsigned char segment = nsegments;
+    for (unsigned int iseg = 0; iseg < nsegments; iseg++) {
+      if (id.layer() >= segLayers[iseg] &&
+          id.layer() <= segLayers[iseg + 1] - 1) {
+        segment = iseg;
+        break;
+      }
+    }
+    hits.x.push_back(x);
+    hits.y.push_back(y);
+    hits.distEle.push_back(distance_ele_trajectory);
+    hits.distPhoton.push_back(distance_photon_trajectory);
+    hits.segment.push_back(segment);
+    hits.eleRegion.push_back(containmentRegion(
+        distance_ele_trajectory, ele_radii[id.layer()], nregions));
+    hits.photonRegion.push_back(containmentRegion(
+        distance_photon_trajectory, photon_radii[id.layer()], nregions));
+    hits.outside.push_back(outsideRegions(
+        distance_ele_trajectory, ele_radii[id.layer()],
+        distance_photon_trajectory, photon_radii[id.layer()], nregions));
+  }
+
   // MIP tracking:  vector of hits to be used in the MIP tracking algorithm. All
   // hits inside the electron ROC (or all hits in the ECal if the event is
   // missing an electron) will be included.
   std::vector<HitData> trackingHitList;
 
-  for (const ldmx::EcalHit &hit : ecalRecHits) {
+  for (std::size_t i_hit = 0; i_hit < ecalRecHits.size(); i_hit++) {
+    const ldmx::EcalHit &hit{ecalRecHits[i_hit]};
     // Layer-wise quantities
     ldmx::EcalID id(hit.getID());
     ecalLayerEdepRaw_[id.layer()] =
@@ -395,7 +610,7 @@ void EcalVetoProcessor::produce(framework::Event &event) {
       nReadoutHits_++;
       ecalLayerEdepReadout_[id.layer()] += hit.getEnergy();
       ecalLayerTime_[id.layer()] += (hit.getEnergy()) * hit.getTime();
-      auto [x, y, z] = geometry_->getPosition(id);
+      double x{hits.x[i_hit]}, y{hits.y[i_hit]};
       xMean += x * hit.getEnergy();
       yMean += y * hit.getEnergy();
       avgLayerHit_ += id.layer();
@@ -404,76 +619,51 @@ void EcalVetoProcessor::produce(framework::Event &event) {
         deepestLayerHit_ = id.layer();
       }
       XYCoords xy_pair = std::make_pair(x, y);
-      float distance_ele_trajectory =
-          ele_trajectory.size()
-              ? sqrt(
-                    pow((xy_pair.first - ele_trajectory[id.layer()].first), 2) +
-                    pow((xy_pair.second - ele_trajectory[id.layer()].second),
-                        2))
-              : -1.0;
-      float distance_photon_trajectory =
-          photon_trajectory.size()
-              ? sqrt(
-                    pow((xy_pair.first - photon_trajectory[id.layer()].first),
-                        2) +
-                    pow((xy_pair.second - photon_trajectory[id.layer()].second),
-                        2))
-              : -1.0;
-
-      // Decide which longitudinal segment the hit is in and add to sums
-      for (unsigned int iseg = 0; iseg < nsegments; iseg++) {
-        if (id.layer() >= segLayers[iseg] &&
-            id.layer() <= segLayers[iseg + 1] - 1) {
-          energySeg[iseg] += hit.getEnergy();
-          xMeanSeg[iseg] += xy_pair.first * hit.getEnergy();
-          yMeanSeg[iseg] += xy_pair.second * hit.getEnergy();
-          layerMeanSeg[iseg] += id.layer() * hit.getEnergy();
-
-          // Decide which containment region the hit is in and add to sums
-          for (unsigned int ireg = 0; ireg < nregions; ireg++) {
-            if (distance_ele_trajectory >= ireg * ele_radii[id.layer()] &&
-                distance_ele_trajectory < (ireg + 1) * ele_radii[id.layer()]) {
-              eContEnergy[ireg][iseg] += hit.getEnergy();
-              eContXMean[ireg][iseg] += xy_pair.first * hit.getEnergy();
-              eContYMean[ireg][iseg] += xy_pair.second * hit.getEnergy();
-            }
-            if (distance_photon_trajectory >= ireg * photon_radii[id.layer()] &&
-                distance_photon_trajectory <
-                    (ireg + 1) * photon_radii[id.layer()]) {
-              gContEnergy[ireg][iseg] += hit.getEnergy();
-              gContNHits[ireg][iseg] += 1;
-              gContXMean[ireg][iseg] += xy_pair.first * hit.getEnergy();
-              gContYMean[ireg][iseg] += xy_pair.second * hit.getEnergy();
-            }
-            if (distance_ele_trajectory > (ireg + 1) * ele_radii[id.layer()] &&
-                distance_photon_trajectory >
-                    (ireg + 1) * photon_radii[id.layer()]) {
-              oContEnergy[ireg][iseg] += hit.getEnergy();
-              oContNHits[ireg][iseg] += 1;
-              oContXMean[ireg][iseg] += xy_pair.first * hit.getEnergy();
-              oContYMean[ireg][iseg] += xy_pair.second * hit.getEnergy();
-              oContLayerMean[ireg][iseg] += id.layer() * hit.getEnergy();
-            }
-          }
+      float distance_ele_trajectory = hits.distEle[i_hit];
+
+      // Add to the sums of the longitudinal segment the hit is in
+      unsigned int iseg = hits.segment[i_hit];
+      if (iseg < nsegments) {
+        energySeg[iseg] += hit.getEnergy();
+        xMeanSeg[iseg] += xy_pair.first * hit.getEnergy();
+        yMeanSeg[iseg] += xy_pair.second * hit.getEnergy();
+        layerMeanSeg[iseg] += id.layer() * hit.getEnergy();
+
+        // Add to the sums of the containment regions the hit is in
+        unsigned int ireg = hits.eleRegion[i_hit];
+        if (ireg < nregions) {
+          eContEnergy[ireg][iseg] += hit.getEnergy();
+          eContXMean[ireg][iseg] += xy_pair.first * hit.getEnergy();
+          eContYMean[ireg][iseg] += xy_pair.second * hit.getEnergy();
+        }
+        ireg = hits.photonRegion[i_hit];
+        if (ireg < nregions) {
+          gContEnergy[ireg][iseg] += hit.getEnergy();
+          gContNHits[ireg][iseg] += 1;
+          gContXMean[ireg][iseg] += xy_pair.first * hit.getEnergy();
+          gContYMean[ireg][iseg] += xy_pair.second * hit.getEnergy();
+        }
+        for (ireg = 0; ireg < nregions; ireg++) {
+          if (not(hits.outside[i_hit] & (1 << ireg))) continue;
+          oContEnergy[ireg][iseg] += hit.getEnergy();
+          oContNHits[ireg][iseg] += 1;
+          oContXMean[ireg][iseg] += xy_pair.first * hit.getEnergy();
+          oContYMean[ireg][iseg] += xy_pair.second * hit.getEnergy();
+          oContLayerMean[ireg][iseg] += id.layer() * hit.getEnergy();
         }
       }
 
-      // Decide which containment region the hit is in and add to sums
+      // Add to the sums of the containment regions the hit is in
+      if (hits.eleRegion[i_hit] < nregions)
+        electronContainmentEnergy[hits.eleRegion[i_hit]] += hit.getEnergy();
+      if (hits.photonRegion[i_hit] < nregions)
+        photonContainmentEnergy[hits.photonRegion[i_hit]] += hit.getEnergy();
       for (unsigned int ireg = 0; ireg < nregions; ireg++) {
-        if (distance_ele_trajectory >= ireg * ele_radii[id.layer()] &&
-            distance_ele_trajectory < (ireg + 1) * ele_radii[id.layer()])
-          electronContainmentEnergy[ireg] += hit.getEnergy();
-        if (distance_photon_trajectory >= ireg * photon_radii[id.layer()] &&
-            distance_photon_trajectory < (ireg + 1) * photon_radii[id.layer()])
-          photonContainmentEnergy[ireg] += hit.getEnergy();
-        if (distance_ele_trajectory > (ireg + 1) * ele_radii[id.layer()] &&
-            distance_photon_trajectory >
-                (ireg + 1) * photon_radii[id.layer()]) {
-          outsideContainmentEnergy[ireg] += hit.getEnergy();
-          outsideContainmentNHits[ireg] += 1;
-          outsideContainmentXmean[ireg] += xy_pair.first * hit.getEnergy();
-          outsideContainmentYmean[ireg] += xy_pair.second * hit.getEnergy();
-        }
+        if (not(hits.outside[i_hit] & (1 << ireg))) continue;
+        outsideContainmentEnergy[ireg] += hit.getEnergy();
+        outsideContainmentNHits[ireg] += 1;
+        outsideContainmentXmean[ireg] += xy_pair.first * hit.getEnergy();
+        outsideContainmentYmean[ireg] += xy_pair.second * hit.getEnergy();
       }
 
       // MIP tracking:  Decide whether hit should be added to trackingHitList
@@ -489,7 +679,8 @@ void EcalVetoProcessor::produce(framework::Event &event) {
     }
   }
 
-  for (const auto &[id, energy] : cellMapTightIso_) {
+  for (ldmx::EcalID id : cellMapTightIso_.ids()) {
+    float energy{cellMapTightIso_.energy(id)};
     if (energy > 0) summedTightIso_ += energy;
   }
 
@@ -543,67 +734,48 @@ void EcalVetoProcessor::produce(framework::Event &event) {
   }
 
   // Loop over hits a second time to find the standard deviations.
-  for (const ldmx::EcalHit &hit : ecalRecHits) {
+  for (std::size_t i_hit = 0; i_hit < ecalRecHits.size(); i_hit++) {
+    const ldmx::EcalHit &hit{ecalRecHits[i_hit]};
     ldmx::EcalID id(hit.getID());
-    auto [x, y, z] = geometry_->getPosition(id);
+    double x{hits.x[i_hit]}, y{hits.y[i_hit]};
     if (hit.getEnergy() > 0) {
       xStd_ += pow((x - xMean), 2) * hit.getEnergy();
       yStd_ += pow((y - yMean), 2) * hit.getEnergy();
       stdLayerHit_ += pow((id.layer() - wavgLayerHit), 2) * hit.getEnergy();
     }
     XYCoords xy_pair = std::make_pair(x, y);
-    float distance_ele_trajectory =
-        ele_trajectory.size()
-            ? sqrt(pow((xy_pair.first - ele_trajectory[id.layer()].first), 2) +
-                   pow((xy_pair.second - ele_trajectory[id.layer()].second), 2))
-            : -1.0;
-    float distance_photon_trajectory =
-        photon_trajectory.size()
-            ? sqrt(pow((xy_pair.first - photon_trajectory[id.layer()].first),
-                       2) +
-                   pow((xy_pair.second - photon_trajectory[id.layer()].second),
-                       2))
-            : -1.0;
 
-    for (unsigned int iseg = 0; iseg < nsegments; iseg++) {
-      if (id.layer() >= segLayers[iseg] &&
-          id.layer() <= segLayers[iseg + 1] - 1) {
-        xStdSeg[iseg] +=
-            pow((xy_pair.first - xMeanSeg[iseg]), 2) * hit.getEnergy();
-        yStdSeg[iseg] +=
-            pow((xy_pair.second - yMeanSeg[iseg]), 2) * hit.getEnergy();
-        layerStdSeg[iseg] +=
-            pow((id.layer() - layerMeanSeg[iseg]), 2) * hit.getEnergy();
-
-        for (unsigned int ireg = 0; ireg < nregions; ireg++) {
-          if (distance_ele_trajectory > (ireg + 1) * ele_radii[id.layer()] &&
-              distance_photon_trajectory >
-                  (ireg + 1) * photon_radii[id.layer()]) {
-            oContXStd[ireg][iseg] +=
-                pow((xy_pair.first - oContXMean[ireg][iseg]), 2) *
-                hit.getEnergy();
-            oContYStd[ireg][iseg] +=
-                pow((xy_pair.second - oContYMean[ireg][iseg]), 2) *
-                hit.getEnergy();
-            oContLayerStd[ireg][iseg] +=
-                pow((id.layer() - oContLayerMean[ireg][iseg]), 2) *
-                hit.getEnergy();
-          }
-        }
-      }
-    }
+    unsigned int iseg = hits.segment[i_hit];
+    if (iseg < nsegments) {
+      xStdSeg[iseg] +=
+          pow((xy_pair.first - xMeanSeg[iseg]), 2) * hit.getEnergy();
+      yStdSeg[iseg] +=
+          pow((xy_pair.second - yMeanSeg[iseg]), 2) * hit.getEnergy();
+      layerStdSeg[iseg] +=
+          pow((id.layer() - layerMeanSeg[iseg]), 2) * hit.getEnergy();
 
-    for (unsigned int ireg = 0; ireg < nregions; ireg++) {
-      if (distance_ele_trajectory > (ireg + 1) * ele_radii[id.layer()] &&
-          distance_photon_trajectory > (ireg + 1) * photon_radii[id.layer()]) {
-        outsideContainmentXstd[ireg] +=
-            pow((xy_pair.first - outsideContainmentXmean[ireg]), 2) *
+      for (unsigned int ireg = 0; ireg < nregions; ireg++) {
+        if (not(hits.outside[i_hit] & (1 << ireg))) continue;
+        oContXStd[ireg][iseg] +=
+            pow((xy_pair.first - oContXMean[ireg][iseg]), 2) * hit.getEnergy();
+        oContYStd[ireg][iseg] +=
+            pow((xy_pair.second - oContYMean[ireg][iseg]), 2) *
             hit.getEnergy();
-        outsideContainmentYstd[ireg] +=
-            pow((xy_pair.second - outsideContainmentYmean[ireg]), 2) *
+        oContLayerStd[ireg][iseg] +=
+            pow((id.layer() - oContLayerMean[ireg][iseg]), 2) *
             hit.getEnergy();
       }
     }
+
+    for (unsigned int ireg = 0; ireg < nregions; ireg++) {
+      if (not(hits.outside[i_hit] & (1 << ireg))) continue;
+      outsideContainmentXstd[ireg] +=
+          pow((xy_pair.first - outsideContainmentXmean[ireg]), 2) *
+          hit.getEnergy();
+      outsideContainmentYstd[ireg] +=
+          pow((xy_pair.second - outsideContainmentYmean[ireg]), 2) *
+          hit.getEnergy();
+    }
   }
 
   if (nReadoutHits_ > 0) {
@@ -704,7 +876,8 @@ void EcalVetoProcessor::produce(framework::Event &event) {
     }
   }
 
-  // MIP tracking starts here
+  // MIP tracking starts here, it is timed to the end of the function
+  LDMX_PROFILE_SCOPE("EcalVeto::mip_tracking");
 
   /* Goal:  Calculate
    *  nStraightTracks (self-explanatory),
@@ -828,8 +1001,12 @@ void EcalVetoProcessor::produce(framework::Event &event) {
     // repeatedly find hits in the front two layers with same x & y positions
     // but since v14 the odd layers are offset, so we allow half a cellWidth
     // deviation and then add to track until no more hits are found
+    // The list is sorted by layer, so once we are more than two layers in
+    // front of the current hit, none of the remaining hits can be added.
     int jHit = iHit;
     while (jHit < trackingHitList.size()) {
+      if (trackingHitList[jHit].layer < trackingHitList[currenthit].layer - 2)
+        break;
       if ((trackingHitList[jHit].layer ==
                trackingHitList[currenthit].layer - 1 ||
            trackingHitList[jHit].layer ==
@@ -984,31 +1161,38 @@ void EcalVetoProcessor::produce(framework::Event &event) {
     int track[34];
     int trackLen;
     int currenthit;
-    int hitsInRegion[50];  // Hits being considered at one time
-    int nHitsInRegion;     // Number of hits under consideration
+    int nHitsInRegion;  // Number of hits under consideration
     TMatrixD svdMatrix(3, 3);
     TMatrixD Vm(3, 3);
     TMatrixD hdt(3, 3);
     TVector3 slopeVec;
     TVector3 hmean;
     TVector3 hpoint;
-    float r_corr_best;
+    float r_corr_best{0};
     int hitNums_best[3];  // Hit numbers of current best track candidate
     int hitNums[3];
 
     trackLen = 0;
     nHitsInRegion = 1;
     currenthit = iHit;
-    hitsInRegion[0] = iHit;
-    // Find all hits within 2 cells of the primary hit:
-    for (int jHit = 0; jHit < trackingHitList.size(); jHit++) {
-      float dstToHit =
-          (trackingHitList[iHit].pos - trackingHitList[jHit].pos).Mag();
-      if (dstToHit <= 2 * cellWidth) {
-        hitsInRegion[nHitsInRegion] = jHit;
-        nHitsInRegion++;
-      }
-    }
+    // Count all hits within 2 cells of the primary hit:
+    // the list is sorted by layer (and therefore z), so we only look at
+    // the hits on either side of the primary hit that are close in z
+    const TVector3 &primary{trackingHitList[iHit].pos};
+    auto close_in_z = [&](int jHit) {
+      const TVector3 &probe{trackingHitList[jHit].pos};
+      return static_cast<float>(std::abs(probe.Z() - primary.Z())) <=
+             2 * cellWidth;
+    };
+    auto count_if_near = [&](int jHit) {
+      float dstToHit = hitDistance(primary, trackingHitList[jHit].pos);
+      if (dstToHit <= 2 * cellWidth) nHitsInRegion++;
+    };
+    for (int jHit = iHit; jHit >= 0 and close_in_z(jHit); jHit--)
+      count_if_near(jHit);
+    for (int jHit = iHit + 1;
+         jHit < trackingHitList.size() and close_in_z(jHit); jHit++)
+      count_if_near(jHit);
 
     // Look at combinations of hits within the region (do not consider the same
     // combination twice):
@@ -1107,35 +1291,7 @@ void EcalVetoProcessor::produce(framework::Event &event) {
       oContXStd, oContYStd, oContLayerMean, oContLayerStd,
       ecalLayerEdepReadout_, recoilP, recoilPos);
 
-  if (doBdt_) {
-    buildBDTFeatureVector(result);
-    ldmx::Ort::FloatArrays inputs({bdtFeatures_});
-    float pred =
-        rt_->run({featureListName_}, inputs, {"probabilities"})[0].at(1);
-    // Removing electron-photon separation step, near photon step due to lower
-    // v12 performance; may reconsider
-    bool passesTrackingVeto = (nStraightTracks_ < 3) && (nLinregTracks_ == 0);
-    //&&  //Commenting the remainder for now
-    //(firstNearPhLayer_ >= 6); //&& (epAng_ > 3.0 || epSep_ > 10.0);
-    result.setVetoResult(pred > bdtCutVal_ && passesTrackingVeto);
-    result.setDiscValue(pred);
-    ldmx_log(debug) << "  The pred > bdtCutVal = " << (pred > bdtCutVal_);
-
-    // If the event passes the veto, keep it. Otherwise,
-    // drop the event.
-    if (result.passesVeto() && inside) {
-      setStorageHint(framework::hint_shouldKeep);
-    } else {
-      setStorageHint(framework::hint_shouldDrop);
-    }
-  }
-
-  if (inside) {
-    setStorageHint(framework::hint_shouldKeep);
-  } else {
-    setStorageHint(framework::hint_shouldDrop);
-  }
-  event.add(collectionName_, result);
+  return inside;
 }
 
 /* Function to calculate the energy weighted shower centroid */
@@ -1187,18 +1343,13 @@ ldmx::EcalID EcalVetoProcessor::GetShowerCentroidIDAndRMS(
  * Function to load up empty vector of hit maps
  */
 void EcalVetoProcessor::fillHitMap(
-    const std::vector<ldmx::EcalHit> &ecalRecHits,
-    std::map<ldmx::EcalID, float> &cellMap_) {
-  for (const ldmx::EcalHit &hit : ecalRecHits) {
-    ldmx::EcalID id(hit.getID());
-    cellMap_.emplace(id, hit.getEnergy());
-  }
+    const std::vector<ldmx::EcalHit> &ecalRecHits, EcalHitGrid &cellMap_) {
+  cellMap_.fill(ecalRecHits);
 }
 
 void EcalVetoProcessor::fillIsolatedHitMap(
     const std::vector<ldmx::EcalHit> &ecalRecHits, ldmx::EcalID globalCentroid,
-    std::map<ldmx::EcalID, float> &cellMap_,
-    std::map<ldmx::EcalID, float> &cellMapIso_, bool doTight) {
+    const EcalHitGrid &cellMap_, EcalHitGrid &cellMapIso_, bool doTight) {
   for (const ldmx::EcalHit &hit : ecalRecHits) {
     auto isolatedHit = std::make_pair(true, ldmx::EcalID());
     ldmx::EcalID id(hit.getID());
@@ -1215,16 +1366,11 @@ void EcalVetoProcessor::fillIsolatedHitMap(
     // Skip hits that have a readout neighbor
     // Get neighboring cell id's and try to look them up in the full cell map
     // (constant speed algo.)
-    //  these ideas are only cell/module (must ignore layer)
-    std::vector<ldmx::EcalID> cellNbrIds = geometry_->getNN(id);
-
-    for (int k = 0; k < cellNbrIds.size(); k++) {
-      // update neighbor ID to the current layer
-      cellNbrIds[k] = ldmx::EcalID(id.layer(), cellNbrIds[k].module(),
-                                   cellNbrIds[k].cell());
+    //  the neighbors are already in the layer of the hit
+    for (ldmx::EcalID cellNbrId : geometry_->getNN(id)) {
       // look in cell hit map to see if it is there
-      if (cellMap_.find(cellNbrIds[k]) != cellMap_.end()) {
-        isolatedHit = std::make_pair(false, cellNbrIds[k]);
+      if (cellMap_.has(cellNbrId)) {
+        isolatedHit = std::make_pair(false, cellNbrId);
         break;
       }
     }
@@ -1232,7 +1378,7 @@ void EcalVetoProcessor::fillIsolatedHitMap(
       continue;
     }
     // Insert isolated hit
-    cellMapIso_.emplace(id, hit.getEnergy());
+    cellMapIso_.insert(id, hit.getEnergy());
   }
 }
 
@@ -1255,8 +1401,8 @@ std::vector<std::pair<float, float>> EcalVetoProcessor::getTrajectory(
 
 // MIP tracking functions:
 
-float EcalVetoProcessor::distTwoLines(TVector3 v1, TVector3 v2, TVector3 w1,
-                                      TVector3 w2) {
+float EcalVetoProcessor::distTwoLines(const TVector3 &v1, const TVector3 &v2,
+                                      const TVector3 &w1, const TVector3 &w2) {
   TVector3 e1 = v1 - v2;
   TVector3 e2 = w1 - w2;
   TVector3 crs = e1.Cross(e2);
@@ -1268,7 +1414,8 @@ float EcalVetoProcessor::distTwoLines(TVector3 v1, TVector3 v2, TVector3 w1,
   }
 }
 
-float EcalVetoProcessor::distPtToLine(TVector3 h1, TVector3 p1, TVector3 p2) {
+float EcalVetoProcessor::distPtToLine(const TVector3 &h1, const TVector3 &p1,
+                                      const TVector3 &p2) {
   return ((h1 - p1).Cross(h1 - p2)).Mag() / (p1 - p2).Mag();
 }
 
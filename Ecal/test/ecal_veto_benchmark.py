@@ -0,0 +1,28 @@
+"""Benchmark the ECal veto on a sample of reconstructed events
+
+The veto is re-run on the input events and the time it takes per
+event is written into the performance directory of the histogram file
+(see framework::performance::Tracker). Since the output collection is
+made in a new pass, the track counts can be compared directly with the
+ones in the EcalVeto of the original reconstruction.
+
+    fire ecal_veto_benchmark.py pn_sample.root [max_events]
+"""
+
+import sys
+from LDMX.Framework import ldmxcfg
+
+p = ldmxcfg.Process('vetoBench')
+
+p.inputFiles = [sys.argv[1]]
+p.maxEvents = int(sys.argv[2]) if len(sys.argv) > 2 else -1
+p.histogramFile = 'ecal_veto_benchmark.root'
+p.logPerformance = True
+
+# Import the Ecal conditions and geometry
+from LDMX.Ecal import ecal_hardcoded_conditions
+from LDMX.Ecal import EcalGeometry
+geom = EcalGeometry.EcalGeometryProvider.getInstance()
+
+from LDMX.Ecal import vetos
+p.sequence = [vetos.EcalVetoProcessor()]
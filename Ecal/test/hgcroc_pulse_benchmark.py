@@ -0,0 +1,40 @@
+"""Benchmark the tabulated HGCROC pulse shape against the TF1 one
+
+The ECal sim hits of the input events are digitized twice, once
+evaluating the pulse shape function directly (EcalDigis) and once
+with the pulse shape tabulated (EcalDigisTabulated). Noise is turned
+off in both so that the two collections only differ by the accuracy
+of the table and can be compared sample by sample in the output file.
+The time each digitization takes per event is written into the
+performance directory of the histogram file.
+
+    fire hgcroc_pulse_benchmark.py sim_sample.root [table_step_ns] [max_events]
+"""
+
+import sys
+from LDMX.Framework import ldmxcfg
+
+p = ldmxcfg.Process('pulseBench')
+
+p.inputFiles = [sys.argv[1]]
+table_step = float(sys.argv[2]) if len(sys.argv) > 2 else 0.01
+p.maxEvents = int(sys.argv[3]) if len(sys.argv) > 3 else -1
+p.outputFiles = ['hgcroc_pulse_benchmark.root']
+p.histogramFile = 'hgcroc_pulse_benchmark_perf.root'
+p.logPerformance = True
+
+# Import the Ecal conditions and geometry
+from LDMX.Ecal import ecal_hardcoded_conditions
+from LDMX.Ecal import EcalGeometry
+geom = EcalGeometry.EcalGeometryProvider.getInstance()
+
+from LDMX.Ecal import digi
+function = digi.EcalDigiProducer('ecalDigis')
+function.hgcroc.noise = False
+
+tabulated = digi.EcalDigiProducer('ecalDigisTabulated')
+tabulated.hgcroc.noise = False
+tabulated.hgcroc.pulseTableStep = table_step
+tabulated.digiCollName = 'EcalDigisTabulated'
+
+p.sequence = [function, tabulated]
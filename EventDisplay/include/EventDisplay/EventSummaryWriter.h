@@ -0,0 +1,139 @@
+/**
+ * @file EventSummaryWriter.h
+ * @brief Export of compact event summaries for remote event displays
+ */
+
+#ifndef EVENTDISPLAY_EVENTSUMMARYWRITER_H_
+#define EVENTDISPLAY_EVENTSUMMARYWRITER_H_
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Framework/Configure/Parameters.h"
+#include "Framework/Event.h"
+#include "Framework/EventProcessor.h"
+
+namespace eventdisplay {
+
+/**
+ * @class EventSummaryWriter
+ * @brief Writes a compact JSON summary of each event for web viewers
+ *
+ * The summary of an event is one line of JSON (so a server can stream
+ * the events of a file without parsing the ones before), holding flat
+ * arrays of numbers for the objects drawn by the event display:
+ *
+ *  - "ecal_hits": [x, y, z, energy] of each ECAL rec hit, the position
+ *    being the center of its cell from the EcalGeometry
+ *  - "hcal_hits": [x, y, z, pe, orientation, length] of each HCAL rec hit
+ *    that isn't noise, the position, orientation and length being those
+ *    of its strip in the HcalGeometry
+ *  - "ecal_clusters", "hcal_clusters": [x, y, z, energy, n_hits] of each
+ *    cluster centroid
+ *  - "tracks": [x, y, z, phi, theta, qop] of each track perigee, in the
+ *    tracking frame
+ *  - "<scoring plane collection>": [x, y, z, px, py, pz, pdg] of each
+ *    scoring plane hit
+ *
+ * The first line of the file is a header with the sizes of the cells and
+ * strips, which are the same for all of the hits. When an index file is
+ * given, the event number and byte offset of each summary are written to
+ * it so a server can seek to an event directly.
+ *
+ * Collections with an empty name and collections missing from the event
+ * are left out of the summary.
+ */
+class EventSummaryWriter : public framework::Analyzer {
+ public:
+  /// Constructor
+  EventSummaryWriter(const std::string& name, framework::Process& process)
+      : framework::Analyzer(name, process) {}
+
+  /// Destructor
+  virtual ~EventSummaryWriter() = default;
+
+  /**
+   * Configure the writer
+   *
+   * @param[in] parameters the names of the output files and collections
+   */
+  void configure(framework::config::Parameters& parameters) override;
+
+  /// Open the output files
+  void onProcessStart() override;
+
+  /**
+   * Write the summary of the event
+   *
+   * @param[in] event event to summarize
+   */
+  void analyze(const framework::Event& event) override;
+
+  /// Close the output files
+  void onProcessEnd() override;
+
+ private:
+  /// Write the header line once the geometries are available
+  void writeHeader();
+
+  /**
+   * Write the key of an array of rows
+   *
+   * @param[in] key name of the array
+   */
+  void beginArray(const std::string& key);
+
+  /**
+   * Write a row of an array
+   *
+   * @param[in] values the numbers of the row
+   */
+  void row(std::initializer_list<double> values);
+
+  /// name of the summary file
+  std::string output_file_;
+
+  /// name of the index file, none if empty
+  std::string index_file_;
+
+  /// significant digits of the numbers written
+  int precision_;
+
+  /// pass of all the input collections
+  std::string input_pass_;
+
+  /// ECAL rec hits collection
+  std::string ecal_hits_;
+
+  /// HCAL rec hits collection
+  std::string hcal_hits_;
+
+  /// ECAL clusters collection
+  std::string ecal_clusters_;
+
+  /// HCAL clusters collection
+  std::string hcal_clusters_;
+
+  /// tracks collection
+  std::string tracks_;
+
+  /// scoring plane hits collections
+  std::vector<std::string> scoring_planes_;
+
+  /// summary file
+  std::ofstream output_;
+
+  /// index file
+  std::ofstream index_;
+
+  /// was the header written
+  bool wroteHeader_{false};
+
+  /// is the next row the first of its array
+  bool firstRow_{true};
+};
+
+}  // namespace eventdisplay
+
+#endif  // EVENTDISPLAY_EVENTSUMMARYWRITER_H_
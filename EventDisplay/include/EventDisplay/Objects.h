@@ -20,7 +20,9 @@
 #include "TColor.h"
 #include "TEveArrow.h"
 #include "TEveBox.h"
+#include "TEveBoxSet.h"
 #include "TEveRGBAPalette.h"
+#include "TNamed.h"
 #include "TRandom.h"
 
 namespace eventdisplay {
@@ -30,6 +32,11 @@ namespace eventdisplay {
  * @brief Drawing methods for event objects.
  *
  * Both ECAL and HCAL hits are colored by their relative energy/pe deposits.
+ *
+ * The hits of a collection are the digits of one TEveBoxSet, drawn as
+ * instances of a single hexagonal or box shape colored by a shared
+ * palette, instead of making a shape (and a color) for each hit. The box
+ * sets are kept from one event to the next and only emptied.
  */
 class Objects {
  public:
@@ -50,7 +57,8 @@ class Objects {
   }
 
   /**
-   * Defines new Eve Element Lists for the event objects.
+   * Defines new Eve Element Lists for the event objects and empties the
+   * hit sets of the previous event.
    */
   void Initialize();
 
@@ -118,6 +126,22 @@ class Objects {
   TEveElement* getRecObjects() { return rec_objects_; }
 
  private:
+  /**
+   * Get a hit set, making it the first time
+   *
+   * The set is denied destruction so it survives the destruction of the
+   * event it was drawn in. The names of its hits are owned by the set.
+   *
+   * @param[in,out] set the hit set, made if null
+   * @param[in] name name of the set
+   * @param[in] type shape of the hits
+   * @param[in] palette colors of the values of the hits
+   * @return the hit set
+   */
+  static TEveBoxSet* hitSet(TEveBoxSet*& set, const char* name,
+                            TEveBoxSet::EBoxType_e type,
+                            TEveRGBAPalette* palette);
+
   /// Eve Element containing all hits
   TEveElement* sim_objects_;
   /// Eve Element containing reco objects that aren't hits
@@ -132,6 +156,19 @@ class Objects {
 
   /// random number generator for colors if we go over the ones in
   TRandom r_;
+
+  /// ECAL rec hit energies [keV] to colors
+  TEveRGBAPalette* ecalRecPalette_{new TEveRGBAPalette(0, 500000)};
+  /// HCAL rec hit PEs to colors
+  TEveRGBAPalette* hcalRecPalette_{new TEveRGBAPalette(0, 100)};
+  /// sim hit energies [keV] to colors
+  TEveRGBAPalette* simPalette_{new TEveRGBAPalette(0, 100000)};
+
+  /// hit sets reused from one event to the next
+  TEveBoxSet* ecalRecHits_{nullptr};
+  TEveBoxSet* hcalRecHits_{nullptr};
+  TEveBoxSet* ecalSimHits_{nullptr};
+  TEveBoxSet* hcalSimHits_{nullptr};
 };
 }  // namespace eventdisplay
 
@@ -0,0 +1,43 @@
+"""Configuration for the export of event summaries to remote event displays"""
+
+from LDMX.Framework import ldmxcfg
+
+class EventSummaryWriter(ldmxcfg.Analyzer) :
+    """Write a compact JSON summary of each event
+
+    Each event is written as one line of JSON with flat arrays of the hits,
+    clusters, tracks and scoring plane hits, the hit positions being taken
+    from the ECal and HCal geometry conditions, so a web server can stream
+    the events to a viewer without the full event files.
+
+    Collections set to an empty string are left out.
+
+    Parameters
+    ----------
+    output_file : str
+        Name of the JSON lines file to write
+    index_file : str
+        Name of the file to write the byte offset of each event to, none if empty
+
+    Examples
+    --------
+        from LDMX.EventDisplay.summary import EventSummaryWriter
+        p.sequence.append( EventSummaryWriter('events.jsonl', 'events.idx') )
+    """
+
+    def __init__(self, output_file = 'event_summaries.jsonl', index_file = '',
+            name = 'event_summary_writer') :
+        super().__init__(name, 'eventdisplay::EventSummaryWriter', 'EventDisplay')
+
+        self.output_file = output_file
+        self.index_file = index_file
+        # significant digits of the numbers written
+        self.precision = 6
+        self.input_pass = ''
+        self.ecal_hits = 'EcalRecHits'
+        self.hcal_hits = 'HcalRecHits'
+        self.ecal_clusters = 'ecalClusters'
+        self.hcal_clusters = 'HcalClusters'
+        self.tracks = 'Tracks'
+        self.scoring_planes = [ 'TargetScoringPlaneHits',
+                'EcalScoringPlaneHits', 'HcalScoringPlaneHits' ]
@@ -0,0 +1,162 @@
+#include "EventDisplay/EventSummaryWriter.h"
+
+#include "DetDescr/EcalGeometry.h"
+#include "DetDescr/HcalGeometry.h"
+#include "Ecal/Event/EcalCluster.h"
+#include "Ecal/Event/EcalHit.h"
+#include "Hcal/Event/HcalCluster.h"
+#include "Hcal/Event/HcalHit.h"
+#include "SimCore/Event/SimTrackerHit.h"
+#include "Tracking/Event/Track.h"
+
+namespace eventdisplay {
+
+void EventSummaryWriter::configure(framework::config::Parameters& parameters) {
+  output_file_ = parameters.getParameter<std::string>("output_file");
+  index_file_ = parameters.getParameter<std::string>("index_file", "");
+  precision_ = parameters.getParameter<int>("precision", 6);
+  input_pass_ = parameters.getParameter<std::string>("input_pass", "");
+  ecal_hits_ = parameters.getParameter<std::string>("ecal_hits");
+  hcal_hits_ = parameters.getParameter<std::string>("hcal_hits");
+  ecal_clusters_ = parameters.getParameter<std::string>("ecal_clusters");
+  hcal_clusters_ = parameters.getParameter<std::string>("hcal_clusters");
+  tracks_ = parameters.getParameter<std::string>("tracks");
+  scoring_planes_ =
+      parameters.getParameter<std::vector<std::string>>("scoring_planes");
+}
+
+void EventSummaryWriter::onProcessStart() {
+  output_.open(output_file_);
+  if (not output_.is_open()) {
+    EXCEPTION_RAISE("FileError", "Unable to open event summary file '" +
+                                     output_file_ + "' for writing.");
+  }
+  output_.precision(precision_);
+  if (not index_file_.empty()) {
+    index_.open(index_file_);
+    if (not index_.is_open()) {
+      EXCEPTION_RAISE("FileError", "Unable to open event summary index '" +
+                                       index_file_ + "' for writing.");
+    }
+  }
+}
+
+void EventSummaryWriter::writeHeader() {
+  const auto& ecal_geometry{getCondition<ldmx::EcalGeometry>(
+      ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME)};
+  const auto& hcal_geometry{getCondition<ldmx::HcalGeometry>(
+      ldmx::HcalGeometry::CONDITIONS_OBJECT_NAME)};
+  output_ << "{\"ecal_cell_radius\":" << ecal_geometry.getCellMaxR()
+          << ",\"hcal_strip_width\":" << hcal_geometry.getScintillatorWidth()
+          << ",\"hcal_strip_thickness\":"
+          << hcal_geometry.getScintillatorThickness() << "}\n";
+  wroteHeader_ = true;
+}
+
+void EventSummaryWriter::beginArray(const std::string& key) {
+  output_ << ",\"" << key << "\":[";
+  firstRow_ = true;
+}
+
+void EventSummaryWriter::row(std::initializer_list<double> values) {
+  if (not firstRow_) output_ << ',';
+  firstRow_ = false;
+  char separator{'['};
+  for (double value : values) {
+    output_ << separator << value;
+    separator = ',';
+  }
+  output_ << ']';
+}
+
+void EventSummaryWriter::analyze(const framework::Event& event) {
+  if (not wroteHeader_) writeHeader();
+
+  if (index_.is_open()) {
+    index_ << event.getEventNumber() << ' ' << output_.tellp() << '\n';
+  }
+  output_ << "{\"run\":" << event.getEventHeader().getRun()
+          << ",\"event\":" << event.getEventNumber();
+
+  if (not ecal_hits_.empty() and event.exists(ecal_hits_, input_pass_)) {
+    const auto& geometry{getCondition<ldmx::EcalGeometry>(
+        ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME)};
+    beginArray("ecal_hits");
+    for (const auto& hit :
+         event.getCollection<ldmx::EcalHit>(ecal_hits_, input_pass_)) {
+      auto [x, y, z] = geometry.getPosition(ldmx::EcalID(hit.getID()));
+      row({x, y, z, hit.getEnergy()});
+    }
+    output_ << ']';
+  }
+
+  if (not hcal_hits_.empty() and event.exists(hcal_hits_, input_pass_)) {
+    const auto& geometry{getCondition<ldmx::HcalGeometry>(
+        ldmx::HcalGeometry::CONDITIONS_OBJECT_NAME)};
+    beginArray("hcal_hits");
+    for (const auto& hit :
+         event.getCollection<ldmx::HcalHit>(hcal_hits_, input_pass_)) {
+      if (hit.isNoise()) continue;
+      const auto& strip{geometry.getStrip(ldmx::HcalID(hit.getID()))};
+      row({strip.center[0], strip.center[1], strip.center[2], hit.getPE(),
+           double(strip.orientation), strip.length});
+    }
+    output_ << ']';
+  }
+
+  if (not ecal_clusters_.empty() and
+      event.exists(ecal_clusters_, input_pass_)) {
+    beginArray("ecal_clusters");
+    for (const auto& cluster : event.getCollection<ldmx::EcalCluster>(
+             ecal_clusters_, input_pass_)) {
+      row({cluster.getCentroidX(), cluster.getCentroidY(),
+           cluster.getCentroidZ(), cluster.getEnergy(),
+           double(cluster.getNHits())});
+    }
+    output_ << ']';
+  }
+
+  if (not hcal_clusters_.empty() and
+      event.exists(hcal_clusters_, input_pass_)) {
+    beginArray("hcal_clusters");
+    for (const auto& cluster : event.getCollection<ldmx::HcalCluster>(
+             hcal_clusters_, input_pass_)) {
+      row({cluster.getCentroidX(), cluster.getCentroidY(),
+           cluster.getCentroidZ(), cluster.getEnergy(),
+           double(cluster.getNHits())});
+    }
+    output_ << ']';
+  }
+
+  if (not tracks_.empty() and event.exists(tracks_, input_pass_)) {
+    beginArray("tracks");
+    for (const auto& track :
+         event.getCollection<ldmx::Track>(tracks_, input_pass_)) {
+      row({track.getPerigeeX(), track.getPerigeeY(), track.getPerigeeZ(),
+           track.getPhi(), track.getTheta(), track.getQoP()});
+    }
+    output_ << ']';
+  }
+
+  for (const auto& plane : scoring_planes_) {
+    if (not event.exists(plane, input_pass_)) continue;
+    beginArray(plane);
+    for (const auto& hit :
+         event.getCollection<ldmx::SimTrackerHit>(plane, input_pass_)) {
+      row({hit.getX(), hit.getY(), hit.getZ(), hit.getPx(), hit.getPy(),
+           hit.getPz(), double(hit.getPdgID())});
+    }
+    output_ << ']';
+  }
+
+  output_ << "}\n";
+}
+
+void EventSummaryWriter::onProcessEnd() {
+  output_.close();
+  if (index_.is_open()) index_.close();
+}
+
+}  // namespace eventdisplay
+
+DECLARE_ANALYZER_NS(eventdisplay, EventSummaryWriter)
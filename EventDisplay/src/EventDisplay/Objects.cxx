@@ -1,5 +1,8 @@
 #include "EventDisplay/Objects.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace eventdisplay {
 
 Objects::Objects() { Initialize(); }
@@ -8,6 +11,25 @@ void Objects::Initialize() {
   // packages of event objects to be passed to event display manager
   sim_objects_ = new TEveElementList("Simulation Objects");
   rec_objects_ = new TEveElementList("Reconstruction Objects");
+
+  for (TEveBoxSet* hits :
+       {ecalRecHits_, hcalRecHits_, ecalSimHits_, hcalSimHits_}) {
+    if (hits) hits->Reset();
+  }
+}
+
+TEveBoxSet* Objects::hitSet(TEveBoxSet*& set, const char* name,
+                            TEveBoxSet::EBoxType_e type,
+                            TEveRGBAPalette* palette) {
+  if (not set) {
+    set = new TEveBoxSet(name);
+    set->Reset(type, kFALSE, 64);
+    set->SetPalette(palette);
+    set->SetOwnIds(kTRUE);
+    set->SetPickable(kTRUE);
+    set->IncDenyDestroy();
+  }
+  return set;
 }
 
 void Objects::SetSimThresh(double simThresh) {
@@ -64,14 +86,13 @@ void Objects::ColorClusters() {
 }
 
 void Objects::draw(std::vector<ldmx::EcalHit> hits) {
-  TEveRGBAPalette* palette = new TEveRGBAPalette(0, 500.0);
-
   std::sort(hits.begin(), hits.end(),
             [](const ldmx::EcalHit& a, const ldmx::EcalHit& b) {
               return a.getEnergy() < b.getEnergy();
             });
 
-  auto ecal_hits = new TEveElementList("ECAL RecHits");
+  auto ecal_hits{hitSet(ecalRecHits_, "ECAL RecHits", TEveBoxSet::kBT_Hex,
+                        ecalRecPalette_)};
   for (const ldmx::EcalHit& hit : hits) {
     double energy = hit.getEnergy();
 
@@ -82,62 +103,52 @@ void Objects::draw(std::vector<ldmx::EcalHit> hits) {
     TString digiName;
     digiName.Form("%1.5g MeV", energy);
 
-    const UChar_t* rgb = palette->ColorFromValue(energy);
-    TColor* aColor = new TColor();
-    Int_t color = aColor->GetColor((Int_t)rgb[0], (Int_t)rgb[1], (Int_t)rgb[2]);
-
-    TEveGeoShape* ecalDigiHit = EveShapeDrawer::getInstance().drawHexPrism(
-        DetectorGeometry::getInstance().getHexPrism(ldmx::EcalID(hit.getID())),
-        0, 0, 0, color, 0, digiName);
-
-    ecal_hits->AddElement(ecalDigiHit);
+    HexPrism prism{
+        DetectorGeometry::getInstance().getHexPrism(ldmx::EcalID(hit.getID()))};
+    ecal_hits->AddHex(TEveVector(prism.x, prism.y, prism.z - prism.height / 2),
+                      prism.radius, 0, prism.height);
+    ecal_hits->DigitValue(Int_t(1000 * energy));
+    ecal_hits->DigitId(new TNamed(digiName, ""));
   }
-
-  ecal_hits->SetPickableRecursively(1);
+  ecal_hits->RefitPlex();
 
   rec_objects_->AddElement(ecal_hits);
 }
 
 void Objects::draw(std::vector<ldmx::HcalHit> hits) {
-  TEveRGBAPalette* palette = new TEveRGBAPalette(0, 100.0);
-
   std::sort(hits.begin(), hits.end(),
             [](const ldmx::HcalHit& a, const ldmx::HcalHit& b) {
               return a.getEnergy() < b.getEnergy();
             });
 
-  auto hcal_hits = new TEveElementList("HCAL Rec Hits");
+  auto hcal_hits{hitSet(hcalRecHits_, "HCAL Rec Hits",
+                        TEveBoxSet::kBT_AABox, hcalRecPalette_)};
   for (const ldmx::HcalHit& hit : hits) {
     int pe = hit.getPE();
-    if (pe == 0) {
+    if (pe == 0 or hit.isNoise()) {
       continue;
     }
 
     ldmx::HcalID id(hit.getID());
 
-    const UChar_t* rgb = palette->ColorFromValue(pe);
-    TColor* aColor = new TColor();
-    Int_t color = aColor->GetColor((Int_t)rgb[0], (Int_t)rgb[1], (Int_t)rgb[2]);
-
     TString digiName;
     digiName.Form("%d PEs, Section %d, Layer %d, Bar %d, Z %1.5g", pe,
                   id.section(), id.layer(), id.strip(), hit.getZPos());
 
     BoundingBox hcal_hit_bb =
         DetectorGeometry::getInstance().getBoundingBox(hit);
-    TEveGeoShape* hcalDigiHit = EveShapeDrawer::getInstance().drawRectPrism(
-        hcal_hit_bb, 0, 0, 0, color, 0, digiName);
-
-    if (hcalDigiHit) {
-      if (hit.isNoise()) {
-        hcalDigiHit->SetRnrSelf(0);
-      }
-      hcal_hits->AddElement(hcalDigiHit);
-    }  // successfully created hcal digi hit
-
+    hcal_hits->AddBox(
+        std::min(hcal_hit_bb[0].first, hcal_hit_bb[0].second),
+        std::min(hcal_hit_bb[1].first, hcal_hit_bb[1].second),
+        std::min(hcal_hit_bb[2].first, hcal_hit_bb[2].second),
+        std::abs(hcal_hit_bb[0].second - hcal_hit_bb[0].first),
+        std::abs(hcal_hit_bb[1].second - hcal_hit_bb[1].first),
+        std::abs(hcal_hit_bb[2].second - hcal_hit_bb[2].first));
+    hcal_hits->DigitValue(pe);
+    hcal_hits->DigitId(new TNamed(digiName, ""));
   }  // loop through sorted hit list
+  hcal_hits->RefitPlex();
 
-  hcal_hits->SetPickableRecursively(1);
   rec_objects_->AddElement(hcal_hits);
 }
 
@@ -295,8 +306,6 @@ void Objects::draw(std::vector<ldmx::SimCalorimeterHit> hits) {
   // get id for determining subdet
   ldmx::DetectorID id(hits.at(0).getID());
 
-  TEveRGBAPalette* palette = new TEveRGBAPalette(0, 100.0);
-
   std::sort(
       hits.begin(), hits.end(),
       [](const ldmx::SimCalorimeterHit& a, const ldmx::SimCalorimeterHit& b) {
@@ -304,17 +313,13 @@ void Objects::draw(std::vector<ldmx::SimCalorimeterHit> hits) {
       });
 
   if (id.subdet() == ldmx::SubdetectorIDType::SD_HCAL) {
-    auto hcal_hits = new TEveElementList("HCAL Sim Hits");
+    auto hcal_hits{hitSet(hcalSimHits_, "HCAL Sim Hits",
+                          TEveBoxSet::kBT_AABox, simPalette_)};
     for (const ldmx::SimCalorimeterHit& hit : hits) {
       ldmx::HcalID id(hit.getID());
 
       float edep = hit.getEdep();
 
-      const UChar_t* rgb = palette->ColorFromValue(edep);
-      TColor* aColor = new TColor();
-      Int_t color =
-          aColor->GetColor((Int_t)rgb[0], (Int_t)rgb[1], (Int_t)rgb[2]);
-
       auto position{hit.getPosition()};
 
       TString digiName;
@@ -322,48 +327,37 @@ void Objects::draw(std::vector<ldmx::SimCalorimeterHit> hits) {
                     hit.getEdep(), id.section(), id.layer(), id.strip(),
                     position.at(2));
 
-      TEveGeoShape* eve_hit = EveShapeDrawer::getInstance().drawRectPrism(
-          position.at(0), position.at(1), position.at(2), 50., 50., 10., 0, 0,
-          0, color, 0, digiName);
-
-      if (eve_hit) {
-        hcal_hits->AddElement(eve_hit);
-      }  // successfully created hcal digi hit
-
+      hcal_hits->AddBox(position.at(0) - 25., position.at(1) - 25.,
+                        position.at(2) - 5., 50., 50., 10.);
+      hcal_hits->DigitValue(Int_t(1000 * edep));
+      hcal_hits->DigitId(new TNamed(digiName, ""));
     }  // loop through sorted hit list
+    hcal_hits->RefitPlex();
 
-    hcal_hits->SetPickableRecursively(1);
     sim_objects_->AddElement(hcal_hits);
 
   } else if (id.subdet() == ldmx::SubdetectorIDType::SD_ECAL) {
-    auto ecal_hits = new TEveElementList("ECAL Sim Hits");
+    auto ecal_hits{hitSet(ecalSimHits_, "ECAL Sim Hits", TEveBoxSet::kBT_Hex,
+                          simPalette_)};
     for (const ldmx::SimCalorimeterHit& hit : hits) {
       ldmx::EcalID id(hit.getID());
 
       float edep = hit.getEdep();
 
-      const UChar_t* rgb = palette->ColorFromValue(edep);
-      TColor* aColor = new TColor();
-      Int_t color =
-          aColor->GetColor((Int_t)rgb[0], (Int_t)rgb[1], (Int_t)rgb[2]);
-
       TString digiName;
       digiName.Form("%.2f MeV, Module %d, Layer %d, Cell %d", hit.getEdep(),
                     id.module(), id.layer(), id.cell());
 
       auto position{hit.getPosition()};
 
-      TEveGeoShape* eve_hit = EveShapeDrawer::getInstance().drawHexPrism(
-          position.at(0), position.at(1), position.at(2), 0, 0, 0, 1., 2.,
-          color, 0, digiName);
-
-      if (eve_hit) {
-        ecal_hits->AddElement(eve_hit);
-      }  // successfully created hcal digi hit
-
+      ecal_hits->AddHex(
+          TEveVector(position.at(0), position.at(1), position.at(2) - 0.5), 2.,
+          0, 1.);
+      ecal_hits->DigitValue(Int_t(1000 * edep));
+      ecal_hits->DigitId(new TNamed(digiName, ""));
     }  // loop through sorted hit list
+    ecal_hits->RefitPlex();
 
-    ecal_hits->SetPickableRecursively(1);
     sim_objects_->AddElement(ecal_hits);
 
   } else {
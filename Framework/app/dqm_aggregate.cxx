@@ -0,0 +1,144 @@
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+//----------//
+//   ROOT   //
+//----------//
+#include "TFileMerger.h"
+
+namespace fs = std::filesystem;
+
+/**
+ * Find the chunks that are complete
+ *
+ * The jobs write their chunks under a temporary name and move them
+ * to a name ending in '.root' once they are complete.
+ */
+static std::vector<fs::path> findChunks(const fs::path &dir) {
+  std::vector<fs::path> chunks;
+  for (const auto &entry : fs::directory_iterator(dir)) {
+    if (entry.is_regular_file() and entry.path().extension() == ".root")
+      chunks.push_back(entry.path());
+  }
+  std::sort(chunks.begin(), chunks.end());
+  return chunks;
+}
+
+/// Print how to use this executable to the terminal
+static void printUsage() {
+  std::cout << "Usage: dqm-aggregate <chunk directory> <output file> "
+               "[-n <chunks>] [-t <seconds>]\n"
+               "  -n stop once this many chunks have been merged\n"
+               "  -t stop once no chunk has come in for this many seconds\n"
+               "Without either, the chunks there are merged once."
+            << std::endl;
+}
+
+/**
+ * @app dqm-aggregate
+ *
+ * Merges the histograms of many fire jobs as they finish. The jobs are
+ * configured with the same histogramAggregationDirectory and each writes
+ * its histograms there as a new file (a chunk) at the end. The chunks are
+ * merged into the output file incrementally, so only the merged histograms
+ * and one round of chunks are in memory at a time and the merged histograms
+ * are ready soon after the last job finishes instead of after a serial hadd
+ * of all of them.
+ *
+ * The chunks that have been merged are moved into the 'merged'
+ * sub-directory of the chunk directory so that they aren't merged twice.
+ *
+ * Usage: dqm-aggregate <chunk directory> <output file> [-n <chunks>]
+ *          [-t <seconds>]
+ *
+ *   -n stop once this many chunks have been merged
+ *   -t stop once no chunk has come in for this many seconds
+ *
+ * Without either, the chunks there are merged once.
+ */
+int main(int argc, char *argv[]) {
+  if (argc < 3) {
+    printUsage();
+    return 1;
+  }
+
+  fs::path dir{argv[1]};
+  std::string output{argv[2]};
+  int expected{0}, idle{0};
+  for (int i_arg{3}; i_arg < argc; i_arg++) {
+    std::string arg{argv[i_arg]};
+    if (arg == "-n" and i_arg + 1 < argc) {
+      expected = std::stoi(argv[++i_arg]);
+    } else if (arg == "-t" and i_arg + 1 < argc) {
+      idle = std::stoi(argv[++i_arg]);
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  std::error_code ec;
+  fs::path merged_dir{dir / "merged"};
+  fs::create_directories(merged_dir, ec);
+  if (ec) {
+    std::cerr << "Unable to create '" << merged_dir.string()
+              << "': " << ec.message() << std::endl;
+    return 1;
+  }
+
+  TFileMerger merger(false, false);
+  merger.SetPrintLevel(0);
+  if (not merger.OutputFile(output.c_str(), "RECREATE")) {
+    std::cerr << "Unable to open '" << output << "'" << std::endl;
+    return 1;
+  }
+
+  int n_merged{0};
+  auto last_chunk{std::chrono::steady_clock::now()};
+  while (true) {
+    std::vector<fs::path> chunks{findChunks(dir)};
+    if (not chunks.empty()) {
+      for (const auto &chunk : chunks) merger.AddFile(chunk.c_str(), false);
+      // the output stays open and is merged into by the next round
+      if (not merger.PartialMerge(TFileMerger::kAllIncremental)) {
+        std::cerr << "Unable to merge the chunks into '" << output
+                  << "', are the histograms binned the same in all jobs?"
+                  << std::endl;
+        return 2;
+      }
+      for (const auto &chunk : chunks) {
+        fs::rename(chunk, merged_dir / chunk.filename(), ec);
+        if (ec) {
+          std::cerr << "Unable to move '" << chunk.string()
+                    << "' out of the way: " << ec.message() << std::endl;
+          return 2;
+        }
+      }
+      n_merged += int(chunks.size());
+      last_chunk = std::chrono::steady_clock::now();
+      std::cout << "Merged " << n_merged << " chunks into '" << output << "'"
+                << std::endl;
+    }
+
+    if (expected > 0 and n_merged >= expected) break;
+    if (expected <= 0 and idle <= 0) break;
+    if (idle > 0 and std::chrono::steady_clock::now() - last_chunk >=
+                         std::chrono::seconds(idle)) {
+      std::cout << "No chunk has come in for " << idle << " seconds"
+                << std::endl;
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+
+  // the output file is closed along with the merger
+  return 0;
+}
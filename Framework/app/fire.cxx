@@ -8,6 +8,7 @@
 #include <unistd.h>
 
 #include <iostream>
+#include <string>
 
 //-------------//
 //   ldmx-sw   //
@@ -47,6 +48,15 @@ void printUsage();
  * We configure and run a framework::Process using the first command-line
  * argument ending in '.py' as the configu script for the framework::Process.
  * If no such argument is found, we error out.
+ *
+ * With `--serve <spool directory>` before the configuration script, the
+ * process is kept running and processes the jobs put into the directory
+ * (see framework::Process::serve) instead of running once.
+ *
+ * With `--dump-config <file>` before the configuration script, the
+ * configuration gathered from python is written to the JSON file and
+ * nothing is run. Giving that file (ending in '.json') to fire instead of
+ * a python script runs the same configuration without starting python.
  */
 int main(int argc, char* argv[]) try {
   if (argc < 2) {
@@ -54,15 +64,34 @@ int main(int argc, char* argv[]) try {
     return 1;
   }
 
+  std::string spool, dump;
   int ptrpy = 1;
-  for (ptrpy = 1; ptrpy < argc; ptrpy++) {
+  while (ptrpy < argc and (strcmp(argv[ptrpy], "--serve") == 0 or
+                           strcmp(argv[ptrpy], "--dump-config") == 0)) {
+    if (ptrpy + 1 == argc) {
+      printUsage();
+      return 1;
+    }
+    if (strcmp(argv[ptrpy], "--serve") == 0) {
+      spool = argv[ptrpy + 1];
+    } else {
+      dump = argv[ptrpy + 1];
+    }
+    ptrpy += 2;
+  }
+  bool from_json{false};
+  for (; ptrpy < argc; ptrpy++) {
     if (strstr(argv[ptrpy], ".py")) break;
+    if (strstr(argv[ptrpy], ".json")) {
+      from_json = true;
+      break;
+    }
   }
 
   if (ptrpy == argc) {
     printUsage();
-    std::cout << " ** No python configuration script provided (must end in "
-                 "'.py'). ** "
+    std::cout << " ** No configuration script provided (must end in "
+                 "'.py' or '.json'). ** "
               << std::endl;
     return 1;
   }
@@ -71,9 +100,19 @@ int main(int argc, char* argv[]) try {
 
   framework::ProcessHandle p;
   try {
-    framework::ConfigurePython cfg(argv[ptrpy], argv + ptrpy + 1,
-                                   argc - ptrpy - 1);
-    p = cfg.makeProcess();
+    if (from_json) {
+      p = framework::ConfigurePython::load(argv[ptrpy]).makeProcess();
+    } else {
+      framework::ConfigurePython cfg(argv[ptrpy], argv + ptrpy + 1,
+                                     argc - ptrpy - 1);
+      if (not dump.empty()) {
+        cfg.dump(dump);
+        std::cout << "---- LDMXSW: Configuration written to " << dump
+                  << " --------" << std::endl;
+        return 0;
+      }
+      p = cfg.makeProcess();
+    }
   } catch (const framework::exception::Exception& e) {
     // Error message currently printed twice since the stack trace code
     // sometimes crashes. Once this is fixed, the output above the stack trace
@@ -109,7 +148,11 @@ int main(int argc, char* argv[]) try {
   std::cout << "---- LDMXSW: Starting event processing --------" << std::endl;
 
   try {
-    p->run();
+    if (spool.empty()) {
+      p->run();
+    } else {
+      p->serve(spool);
+    }
   } catch (const framework::exception::Exception& e) {
     // Process::run opens up the logging using the parameters passed to it from
     // python
@@ -133,11 +176,18 @@ int main(int argc, char* argv[]) try {
 }
 
 void printUsage() {
-  std::cout << "Usage: fire {configuration_script.py} [arguments to "
-               "configuration script]"
+  std::cout << "Usage: fire [--serve spool_directory] [--dump-config file] "
+               "{configuration_script.py} [arguments to configuration script]"
+            << std::endl;
+  std::cout << "     --serve spool_directory  (optional) keep running and "
+               "process the .job files put into the directory"
+            << std::endl;
+  std::cout << "     --dump-config file       (optional) write the "
+               "configuration to the JSON file and exit"
             << std::endl;
   std::cout << "     configuration_script.py  (required) python script to "
-               "configure the processing"
+               "configure the processing, or a .json file written by "
+               "--dump-config"
             << std::endl;
   std::cout << "     arguments                (optional) passed to "
                "configuration script when run in python"
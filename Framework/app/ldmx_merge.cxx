@@ -0,0 +1,372 @@
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+//----------//
+//   ROOT   //
+//----------//
+#include "TFile.h"
+#include "TFileMerger.h"
+#include "TLeaf.h"
+#include "TROOT.h"
+#include "TTree.h"
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+
+//-------------//
+//   ldmx-sw   //
+//-------------//
+#include "Framework/EventFile.h"
+#include "Framework/RunHeader.h"
+
+namespace fs = std::filesystem;
+
+/// Name of the tree recording which input each merged entry came from
+static const char *INPUTS_TREE_NAME = "LDMX_MergeInputs";
+
+/// What is read from an input before merging
+struct Input {
+  std::string name;
+  /// entries of the event tree, zero if it has none
+  Long64_t entries{0};
+  /// the run headers of the input
+  std::vector<ldmx::RunHeader> runs;
+  /// true if the input has an event index
+  bool indexed{false};
+  /// the parent files of a friend output
+  std::vector<std::string> parents;
+};
+
+/// Print how to use this executable to the terminal
+static void printUsage() {
+  std::cout << "Usage: ldmx-merge [-j <threads>] [-t <tree>] <output file> "
+               "<input files> ...\n"
+               "  -j merge the inputs in this many groups in parallel\n"
+               "  -t name of the event tree (default LDMX_Events)"
+            << std::endl;
+}
+
+/**
+ * Read what is reconciled by hand from an input
+ *
+ * @return false if the input can't be opened
+ */
+static bool scan(const std::string &tree_name, Input &input) {
+  std::unique_ptr<TFile> file{TFile::Open(input.name.c_str())};
+  if (not file or file->IsZombie()) return false;
+
+  TTree *tree{nullptr};
+  file->GetObject(tree_name.c_str(), tree);
+  if (tree) input.entries = tree->GetEntries();
+  input.indexed = file->GetListOfKeys()->Contains(
+      framework::EventFile::INDEX_TREE_NAME);
+  std::vector<std::string> *parents{nullptr};
+  file->GetObject(framework::EventFile::PARENTS_NAME, parents);
+  if (parents) {
+    input.parents = *parents;
+    delete parents;
+  }
+  if (file->GetListOfKeys()->Contains("LDMX_Run")) {
+    TTreeReader run_tree("LDMX_Run", file.get());
+    TTreeReaderValue<ldmx::RunHeader> run_header(run_tree, "RunHeader");
+    while (run_tree.Next()) input.runs.push_back(*run_header);
+  }
+  return true;
+}
+
+/**
+ * Merge files with basket copying, leaving out what is reconciled by hand
+ *
+ * Trees are concatenated by copying their compressed baskets as they are,
+ * histograms are added and the rest is merged as hadd does.
+ *
+ * @return false if the merge failed
+ */
+static bool fastMerge(const std::vector<std::string> &inputs,
+                      const std::string &output, int compression) {
+  TFileMerger merger(false, false);
+  merger.SetPrintLevel(0);
+  merger.SetFastMethod(true);
+  if (not merger.OutputFile(output.c_str(), "RECREATE", compression))
+    return false;
+  for (const auto &input : inputs) {
+    if (not merger.AddFile(input.c_str(), false)) return false;
+  }
+  merger.AddObjectNames("LDMX_Run");
+  merger.AddObjectNames(framework::EventFile::INDEX_TREE_NAME);
+  merger.AddObjectNames(framework::EventFile::PARENTS_NAME);
+  merger.AddObjectNames(INPUTS_TREE_NAME);
+  return merger.PartialMerge(TFileMerger::kAll | TFileMerger::kRegular |
+                             TFileMerger::kSkipListed);
+}
+
+/**
+ * Combine the run headers of the inputs into one per run
+ *
+ * A run split over many inputs is kept once, starting at the earliest
+ * start and ending at the latest end, with the tries of all of its parts
+ * and the number of parts as the 'Merged Files' parameter. The event
+ * parameter names of all the parts are kept. Parts that disagree on the
+ * detector or the software are reported and the first part is kept.
+ */
+static std::map<int, ldmx::RunHeader> reconcileRuns(
+    const std::vector<Input> &inputs) {
+  std::map<int, ldmx::RunHeader> runs;
+  std::map<int, int> parts;
+  for (const auto &input : inputs) {
+    for (const auto &run : input.runs) {
+      int number{run.getRunNumber()};
+      auto [it, first] = runs.emplace(number, run);
+      parts[number]++;
+      if (first) continue;
+
+      ldmx::RunHeader &merged{it->second};
+      if (run.getDetectorName() != merged.getDetectorName() or
+          run.getSoftwareTag() != merged.getSoftwareTag()) {
+        std::cerr << "[ ldmx-merge ] : Run " << number << " of '"
+                  << input.name << "' is of detector '"
+                  << run.getDetectorName() << "' with software '"
+                  << run.getSoftwareTag() << "' while other parts are of '"
+                  << merged.getDetectorName() << "' with '"
+                  << merged.getSoftwareTag() << "', keeping the first."
+                  << std::endl;
+      }
+      merged.setRunStart(std::min(merged.getRunStart(), run.getRunStart()));
+      merged.setRunEnd(std::max(merged.getRunEnd(), run.getRunEnd()));
+      merged.setNumTries(merged.getNumTries() + run.getNumTries());
+      auto names{merged.getEventParameterNames()};
+      names.insert(run.getEventParameterNames().begin(),
+                   run.getEventParameterNames().end());
+      merged.setEventParameterNames(names);
+    }
+  }
+  for (auto &[number, run] : runs) {
+    if (parts[number] > 1) run.setIntParameter("Merged Files", parts[number]);
+  }
+  return runs;
+}
+
+/**
+ * Write the run tree, event index, parent list and list of inputs
+ *
+ * The entries of the event index are shifted by the entries of the inputs
+ * before it so they point into the merged tree. The index is only written
+ * if every input with events has one.
+ */
+static void writeReconciled(TFile &output, const std::vector<Input> &inputs) {
+  output.cd();
+
+  auto runs{reconcileRuns(inputs)};
+  if (not runs.empty()) {
+    auto run_tree{new TTree("LDMX_Run", "LDMX run header")};
+    ldmx::RunHeader *handle{nullptr};
+    run_tree->Branch("RunHeader", "ldmx::RunHeader", &handle, 32000, 3);
+    for (auto &[number, run] : runs) {
+      handle = &run;
+      run_tree->Fill();
+    }
+    run_tree->Write();
+  }
+
+  bool indexed{std::all_of(inputs.begin(), inputs.end(), [](const Input &i) {
+    return i.indexed or i.entries == 0;
+  })};
+  if (indexed) {
+    // the index holds the entry as a Long64_t, the run and event numbers
+    // as Int_t and the weight and event parameters as Double_t, each gets
+    // 8 bytes of the buffer
+    std::vector<std::pair<std::string, std::string>> branches;
+    std::vector<Long64_t> buffer;
+    TTree *index{nullptr};
+    Long64_t *entry{nullptr};
+    Long64_t offset{0};
+    for (const auto &input : inputs) {
+      if (input.entries == 0) continue;
+      std::unique_ptr<TFile> file{TFile::Open(input.name.c_str())};
+      TTree *in{nullptr};
+      file->GetObject(framework::EventFile::INDEX_TREE_NAME, in);
+      if (not index) {
+        for (auto leaf : TRangeDynCast<TLeaf>(in->GetListOfLeaves())) {
+          std::string type{leaf->GetTypeName()};
+          std::string code{type == "Long64_t" ? "L"
+                           : type == "Int_t"  ? "I"
+                                              : "D"};
+          branches.emplace_back(leaf->GetName(), code);
+        }
+        buffer.resize(branches.size());
+        output.cd();
+        index = new TTree(framework::EventFile::INDEX_TREE_NAME,
+                          "Index of the events");
+        for (std::size_t i{0}; i < branches.size(); i++) {
+          const auto &[branch, code] = branches[i];
+          index->Branch(branch.c_str(), &buffer[i],
+                        (branch + "/" + code).c_str());
+          if (branch == "entry") entry = &buffer[i];
+        }
+      }
+      for (std::size_t i{0}; i < branches.size(); i++) {
+        if (in->SetBranchAddress(branches[i].first.c_str(), &buffer[i]) < 0) {
+          std::cerr << "[ ldmx-merge ] : The event index of '" << input.name
+                    << "' doesn't have '" << branches[i].first
+                    << "', the merged index is incomplete." << std::endl;
+        }
+      }
+      for (Long64_t i{0}; i < in->GetEntries(); i++) {
+        in->GetEntry(i);
+        if (entry) *entry += offset;
+        index->Fill();
+      }
+      offset += input.entries;
+    }
+    output.cd();
+    if (index) index->Write();
+  } else {
+    std::cerr << "[ ldmx-merge ] : Not all inputs have an event index, the "
+                 "merged file won't have one."
+              << std::endl;
+  }
+
+  std::vector<std::string> parents;
+  for (const auto &input : inputs) {
+    for (const auto &parent : input.parents) {
+      if (std::find(parents.begin(), parents.end(), parent) == parents.end())
+        parents.push_back(parent);
+    }
+  }
+  if (not parents.empty())
+    output.WriteObject(&parents, framework::EventFile::PARENTS_NAME);
+
+  // the provenance of the merged entries, if there are any
+  if (std::none_of(inputs.begin(), inputs.end(),
+                   [](const Input &i) { return i.entries > 0; }))
+    return;
+  auto inputs_tree{new TTree(INPUTS_TREE_NAME, "Inputs of the merge")};
+  std::string name;
+  Long64_t first_entry{0}, entries{0};
+  inputs_tree->Branch("file", &name);
+  inputs_tree->Branch("first_entry", &first_entry);
+  inputs_tree->Branch("entries", &entries);
+  for (const auto &input : inputs) {
+    name = input.name;
+    entries = input.entries;
+    inputs_tree->Fill();
+    first_entry += entries;
+  }
+  inputs_tree->Write();
+}
+
+/**
+ * @app ldmx-merge
+ *
+ * Merges the output files of many fire jobs into one, faster than hadd
+ * and keeping what hadd gets wrong about them.
+ *
+ * The event trees are concatenated by copying their compressed baskets
+ * without decompressing them, so the output has the compression of the
+ * first input. Histogram and ntuple files are merged as well, the
+ * histograms are added and the trees concatenated.
+ *
+ * The run headers are combined into one per run, the event indices are
+ * joined with their entries shifted to the merged tree, the parents of
+ * friend outputs are kept and the LDMX_MergeInputs tree records which
+ * range of entries came from which input.
+ *
+ * With -j the inputs are split into that many groups of consecutive
+ * inputs which are merged in parallel and then into the output, so the
+ * order of the events is the order of the inputs either way.
+ *
+ * Usage: ldmx-merge [-j <threads>] [-t <tree>] <output file> <inputs> ...
+ */
+int main(int argc, char *argv[]) {
+  int n_threads{1};
+  std::string tree_name{"LDMX_Events"};
+  std::vector<std::string> files;
+  for (int i_arg{1}; i_arg < argc; i_arg++) {
+    std::string arg{argv[i_arg]};
+    if (arg == "-j" and i_arg + 1 < argc) {
+      n_threads = std::max(1, std::stoi(argv[++i_arg]));
+    } else if (arg == "-t" and i_arg + 1 < argc) {
+      tree_name = argv[++i_arg];
+    } else if (arg.front() == '-') {
+      printUsage();
+      return 1;
+    } else {
+      files.push_back(arg);
+    }
+  }
+  if (files.size() < 2) {
+    printUsage();
+    return 1;
+  }
+
+  std::string output{files.front()};
+  std::vector<Input> inputs(files.size() - 1);
+  for (std::size_t i{0}; i < inputs.size(); i++) {
+    inputs[i].name = files[i + 1];
+    if (not scan(tree_name, inputs[i])) {
+      std::cerr << "Unable to open '" << inputs[i].name << "'" << std::endl;
+      return 1;
+    }
+  }
+
+  int compression;
+  {
+    std::unique_ptr<TFile> first{TFile::Open(inputs.front().name.c_str())};
+    compression = first->GetCompressionSettings();
+  }
+
+  // consecutive inputs are merged together so the order is kept
+  std::size_t n_groups{std::min<std::size_t>(n_threads, inputs.size())};
+  std::vector<std::vector<std::string>> groups(n_groups);
+  for (std::size_t i{0}; i < inputs.size(); i++) {
+    groups[i * n_groups / inputs.size()].push_back(inputs[i].name);
+  }
+
+  bool merged{true};
+  if (n_groups == 1) {
+    merged = fastMerge(groups.front(), output, compression);
+  } else {
+    ROOT::EnableThreadSafety();
+    std::vector<std::string> parts(n_groups);
+    std::vector<char> ok(n_groups, false);
+    std::vector<std::thread> threads;
+    for (std::size_t i{0}; i < n_groups; i++) {
+      parts[i] = output + ".part" + std::to_string(i);
+      threads.emplace_back([&, i]() {
+        ok[i] = fastMerge(groups[i], parts[i], compression);
+      });
+    }
+    for (auto &thread : threads) thread.join();
+    merged = std::all_of(ok.begin(), ok.end(), [](char o) { return o; });
+    if (merged) merged = fastMerge(parts, output, compression);
+    for (const auto &part : parts) fs::remove(part);
+  }
+  if (not merged) {
+    std::cerr << "Unable to merge the inputs into '" << output << "'"
+              << std::endl;
+    return 2;
+  }
+
+  std::unique_ptr<TFile> file{TFile::Open(output.c_str(), "UPDATE")};
+  if (not file or file->IsZombie()) {
+    std::cerr << "Unable to open '" << output << "' to write the runs"
+              << std::endl;
+    return 2;
+  }
+  writeReconciled(*file, inputs);
+  file->Close();
+
+  Long64_t entries{0};
+  for (const auto &input : inputs) entries += input.entries;
+  std::cout << "Merged " << entries << " events of " << inputs.size()
+            << " files into '" << output << "'" << std::endl;
+  return 0;
+}
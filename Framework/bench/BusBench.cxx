@@ -0,0 +1,64 @@
+/**
+ * @file BusBench.cxx
+ * @brief Benchmark updating the objects on the event bus
+ */
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "Framework/Bus.h"
+
+namespace framework {
+namespace bench {
+
+/**
+ * The contents of a collection of an event
+ *
+ * They are drawn from a fixed seed (and so are not sorted yet), so every
+ * run and every build puts the same collection on the bus.
+ *
+ * @param[in] n_entries number of entries in the collection
+ */
+static std::vector<double> recordedCollection(int n_entries) {
+  std::mt19937 rng(29);
+  std::exponential_distribution<double> energy(1. / 5.);
+  std::vector<double> collection;
+  for (int i{0}; i < n_entries; i++) collection.push_back(energy(rng));
+  return collection;
+}
+
+}  // namespace bench
+}  // namespace framework
+
+/// Copy the recorded collection onto the bus and clear it, like an event
+static void BM_Bus_update(benchmark::State& state) {
+  using namespace framework;
+  const auto recorded{bench::recordedCollection(state.range(0))};
+  Bus bus;
+  bus.board<std::vector<double>>("collection");
+  for (auto _ : state) {
+    bus.update("collection", recorded);
+    benchmark::DoNotOptimize(bus.get<std::vector<double>>("collection"));
+    bus.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * recorded.size());
+}
+BENCHMARK(BM_Bus_update)->Arg(100)->Arg(10000);
+
+/// Move a copy of the recorded collection onto the bus and clear it
+static void BM_Bus_update_move(benchmark::State& state) {
+  using namespace framework;
+  const auto recorded{bench::recordedCollection(state.range(0))};
+  Bus bus;
+  bus.board<std::vector<double>>("collection");
+  for (auto _ : state) {
+    // the copy stands in for a collection a producer made
+    std::vector<double> collection{recorded};
+    bus.update("collection", std::move(collection));
+    benchmark::DoNotOptimize(bus.get<std::vector<double>>("collection"));
+    bus.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * recorded.size());
+}
+BENCHMARK(BM_Bus_update_move)->Arg(100)->Arg(10000);
@@ -5,15 +5,50 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 // ROOT
+#include "RVersion.h"
 #include "TBranchElement.h"
 #include "TTree.h"
 
+/**
+ * The RNTuple event storage is only used with a version of ROOT
+ * where its interface to reading and writing is settled enough
+ */
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 34, 0)
+#define FRAMEWORK_HAS_RNTUPLE
+#include <ROOT/REntry.hxx>
+#include <ROOT/RField.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleReader.hxx>
+#include <ROOT/RNTupleView.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+#endif
+
 namespace framework {
 
+/**
+ * Detect whether an event class can tell us the memory it holds
+ *
+ * @see Bus::Seat::bytes for where it is used
+ */
+template <typename T, typename = void>
+struct has_byte_size : std::false_type {};
+
+template <typename T>
+struct has_byte_size<
+    T, std::void_t<decltype(std::declval<const T&>().byteSize())>>
+    : std::true_type {};
+
+#ifdef FRAMEWORK_HAS_RNTUPLE
+/// shorter name for where the RNTuple classes live
+namespace rntuple = ROOT::Experimental;
+#endif
+
 /**
  * A map of bus passengers
  *
@@ -63,8 +98,10 @@ class Bus {
    */
   template <typename BaggageType>
   void board(const std::string& name) {
-    passengers_[name] = std::make_unique<Passenger<BaggageType>>();
-    passengers_[name]->clear();  // make sure 'default' state is well defined
+    auto& seat{passengers_[name]};
+    if (seat) generation_++;  // the tickets to the passenger replaced expire
+    seat = std::make_unique<Passenger<BaggageType>>();
+    seat->clear();  // make sure 'default' state is well defined
   }
 
   /**
@@ -84,6 +121,27 @@ class Bus {
     getRef<BaggageType>(name).update(obj);
   }
 
+  /**
+   * Update the object a passenger is carrying by moving the input into it
+   *
+   * This overload is only chosen for rvalues, so the caller has already
+   * given up the input object and its storage can be handed over to the
+   * passenger instead of being copied.
+   *
+   * @see update for the copying version
+   * @throws std::bad_cast if BaggageType does not match type of object
+   * passenger is carrying
+   *
+   * @tparam[in] BaggageType type of object carried by passenger
+   * @param[in] name name of passenger (corresponds to branch name)
+   * @param[in] obj update object to move into the passenger
+   */
+  template <typename BaggageType,
+            std::enable_if_t<not std::is_reference_v<BaggageType>, bool> = true>
+  void update(const std::string& name, BaggageType&& obj) {
+    getRef<BaggageType>(name).update(std::move(obj));
+  }
+
   /**
    * Attach the input tree to the object a passenger is carrying
    *
@@ -108,6 +166,45 @@ class Bus {
     return passengers_[name]->attach(tree, name, can_create);
   }
 
+  /**
+   * Get the address of the baggage of a passenger
+   *
+   * This is what a RNTuple entry is bound to when writing, so that
+   * the baggage is written without being copied. It's also how the
+   * NtupleManager sets variables without looking them up by name.
+   *
+   * @param[in] name name of passenger
+   * @returns pointer to the object the passenger is carrying
+   */
+  void* address(const std::string& name) const {
+    return passengers_.at(name)->address();
+  }
+
+#ifdef FRAMEWORK_HAS_RNTUPLE
+  /**
+   * Create a RNTuple field for the baggage of a passenger
+   *
+   * @param[in] name name of passenger (and of the field)
+   * @returns new field that can be added to a RNTuple model
+   */
+  std::unique_ptr<rntuple::RFieldBase> makeField(
+      const std::string& name) const {
+    return passengers_.at(name)->makeField(name);
+  }
+
+  /**
+   * Read the baggage of a passenger from an entry of a RNTuple
+   *
+   * @param[in] reader RNTuple to read from
+   * @param[in] name name of passenger (and of the field)
+   * @param[in] entry index of the entry to read
+   */
+  void read(rntuple::RNTupleReader& reader, const std::string& name,
+            rntuple::NTupleSize_t entry) {
+    passengers_.at(name)->read(reader, name, entry);
+  }
+#endif
+
   /**
    * Check if a passenger is on the bus
    *
@@ -137,7 +234,45 @@ class Bus {
    * @see Bus::Passenger::~Passenger for comments
    * about why you need to be careful.
    */
-  void everybodyOff() { passengers_.clear(); }
+  void everybodyOff() {
+    passengers_.clear();
+    generation_++;
+  }
+
+  /**
+   * Copy the baggage of one of our passengers onto another bus
+   *
+   * If the other bus does not have a passenger with the input name yet,
+   * an empty passenger carrying the same type of baggage is boarded first.
+   * This is how event objects are moved between the event buses of
+   * the different worker slots of a multi-threaded Process without either
+   * bus needing to know the type of the object.
+   *
+   * @throws std::bad_cast if the passenger already on the other bus
+   * is carrying a different type of object
+   *
+   * @param[in] name name of passenger to copy
+   * @param[in] other bus to copy the passenger's baggage onto
+   */
+  void copy(const std::string& name, Bus& other) const {
+    const auto& seat{passengers_.at(name)};
+    auto& other_seat{other.passengers_[name]};
+    if (not other_seat) other_seat = seat->emptyCopy();
+    other_seat->copyFrom(*seat);
+  }
+
+  /**
+   * Estimate the memory held by each passenger
+   *
+   * @see Seat::bytes for what is counted
+   *
+   * @returns name and estimated size [bytes] of each passenger
+   */
+  std::vector<std::pair<std::string, std::size_t>> sizes() const {
+    std::vector<std::pair<std::string, std::size_t>> s;
+    for (auto& [n, handle] : passengers_) s.emplace_back(n, handle->bytes());
+    return s;
+  }
 
   /**
    * Write the bus to the input ostream.
@@ -222,6 +357,58 @@ class Bus {
      */
     virtual void stream(std::ostream& s) const = 0;
 
+    /**
+     * Create a new, empty passenger carrying the same type as us
+     *
+     * @returns handle to new (cleared) passenger
+     */
+    virtual std::unique_ptr<Seat> emptyCopy() const = 0;
+
+    /**
+     * Copy the baggage carried by another passenger into ours
+     *
+     * @throws std::bad_cast if the other passenger is carrying
+     * a different type than we are
+     *
+     * @param[in] other passenger to copy baggage from
+     */
+    virtual void copyFrom(const Seat& other) = 0;
+
+    /// @returns pointer to the object we are carrying
+    virtual void* address() = 0;
+
+    /**
+     * Estimate the memory held by the object we are carrying
+     *
+     * The object itself and the entries of a vector or map are counted,
+     * along with the memory the entries hold themselves if they have a
+     * byteSize() method.
+     *
+     * @returns estimated size [bytes]
+     */
+    virtual std::size_t bytes() const = 0;
+
+#ifdef FRAMEWORK_HAS_RNTUPLE
+    /**
+     * Create a RNTuple field for the type we are carrying
+     *
+     * @param[in] name name of the field
+     * @returns new field
+     */
+    virtual std::unique_ptr<rntuple::RFieldBase> makeField(
+        const std::string& name) const = 0;
+
+    /**
+     * Read our baggage from an entry of a RNTuple
+     *
+     * @param[in] reader RNTuple to read from
+     * @param[in] name name of the field
+     * @param[in] entry index of the entry to read
+     */
+    virtual void read(rntuple::RNTupleReader& reader, const std::string& name,
+                      rntuple::NTupleSize_t entry) = 0;
+#endif
+
     /**
      * Stream this object to the output stream
      *
@@ -367,6 +554,19 @@ class Bus {
       post_update(the_type<BaggageType>());
     }
 
+    /**
+     * Update this passenger's baggage by moving the input into it.
+     *
+     * The object we carry stays the same (so any branch addresses
+     * pointing to it remain valid), only its contents are replaced.
+     *
+     * @param[in] updated_obj BaggageType to move into our object
+     */
+    void update(BaggageType&& updated_obj) {
+      *baggage_ = std::move(updated_obj);
+      post_update(the_type<BaggageType>());
+    }
+
     /**
      * Reset the object we are carrying to an undefined state.
      *
@@ -387,6 +587,62 @@ class Bus {
       stream(the_type<BaggageType>{}, s);
     }
 
+    /**
+     * Create a new passenger carrying our type of baggage
+     *
+     * The new passenger is cleared so that its 'default' state
+     * is well defined (just like Bus::board).
+     */
+    virtual std::unique_ptr<Seat> emptyCopy() const {
+      auto p{std::make_unique<Passenger<BaggageType>>()};
+      p->clear();
+      return p;
+    }
+
+    /**
+     * Copy the baggage of another passenger into ours
+     *
+     * @see update for how the copy is done
+     */
+    virtual void copyFrom(const Seat& other) {
+      update(dynamic_cast<const Passenger<BaggageType>&>(other).get());
+    }
+
+    /// @returns pointer to our baggage
+    virtual void* address() { return baggage_; }
+
+    /// @returns estimated size of our baggage [bytes]
+    virtual std::size_t bytes() const { return bytes(the_type<BaggageType>{}); }
+
+#ifdef FRAMEWORK_HAS_RNTUPLE
+    /**
+     * Create a RNTuple field for our type of baggage
+     *
+     * The classes need a ROOT dictionary just like for the TTree.
+     */
+    virtual std::unique_ptr<rntuple::RFieldBase> makeField(
+        const std::string& name) const {
+      return std::make_unique<rntuple::RField<BaggageType>>(name);
+    }
+
+    /**
+     * Read our baggage from an entry of a RNTuple
+     *
+     * The view of the field is made on the first read and kept for
+     * the reads of the later entries. A passenger is kicked off the
+     * bus before the RNTuple it was reading from is closed, so the
+     * view is never left dangling.
+     */
+    virtual void read(rntuple::RNTupleReader& reader, const std::string& name,
+                      rntuple::NTupleSize_t entry) {
+      if (not view_) {
+        view_ = std::make_unique<rntuple::RNTupleView<BaggageType>>(
+            reader.GetView<BaggageType>(name));
+      }
+      *baggage_ = (*view_)(entry);
+    }
+#endif
+
     /**
      * Stream this object to the output stream
      *
@@ -727,6 +983,52 @@ class Bus {
     }
      */
 
+   private:  // specializations of bytes
+    /**
+     * The size of one object
+     *
+     * Classes holding memory of their own (e.g. vectors of contributions)
+     * can define a byteSize() method returning their full size, the others
+     * are counted as their sizeof.
+     */
+    template <typename T>
+    static std::size_t byteSize(const T& obj) {
+      if constexpr (has_byte_size<T>::value) {
+        return obj.byteSize();
+      } else {
+        return sizeof(T);
+      }
+    }
+
+    /// the size of an object we carry
+    template <typename T>
+    std::size_t bytes(the_type<T> t) const {
+      return byteSize(*baggage_);
+    }
+
+    /// the size of a vector including what it has reserved
+    template <typename Content>
+    std::size_t bytes(the_type<std::vector<Content>> t) const {
+      std::size_t size{sizeof(std::vector<Content>) +
+                       (baggage_->capacity() - baggage_->size()) *
+                           sizeof(Content)};
+      if constexpr (has_byte_size<Content>::value) {
+        for (const Content& entry : *baggage_) size += entry.byteSize();
+      } else {
+        size += baggage_->size() * sizeof(Content);
+      }
+      return size;
+    }
+
+    /// the size of a map including its nodes (three pointers and a color)
+    template <typename Key, typename Val>
+    std::size_t bytes(the_type<std::map<Key, Val>> t) const {
+      std::size_t size{sizeof(std::map<Key, Val>) +
+                       baggage_->size() * (sizeof(Key) + 4 * sizeof(void*))};
+      for (const auto& [key, val] : *baggage_) size += byteSize(val);
+      return size;
+    }
+
    private:  // specializations of stream
     /**
      * Stream a basic type that has its own
@@ -788,8 +1090,91 @@ class Bus {
    private:
     /// A pointer to the baggage we own and created
     BaggageType* baggage_;
+
+#ifdef FRAMEWORK_HAS_RNTUPLE
+    /// View of the field we are reading our baggage from (if any)
+    std::unique_ptr<rntuple::RNTupleView<BaggageType>> view_;
+#endif
   };  // Passenger
 
+ public:
+  /**
+   * A ticket to the passenger carrying an object
+   *
+   * Getting or updating a passenger by name hashes the name to find the
+   * passenger and checks the type of its baggage with a dynamic_cast on
+   * every call. A ticket holds the passenger found, with its type checked
+   * once when the ticket is issued, so using it costs neither.
+   * ```cpp
+   * auto ticket{bus.ticket<std::vector<ldmx::SimCalorimeterHit>>(name)};
+   * // for each event, as long as the ticket is valid
+   * if (bus.valid(ticket)) for (const auto& hit : ticket.get()) { ... }
+   * ```
+   * A ticket expires when its passenger gets off the bus (at the end of
+   * an input file) or is replaced by another one boarding with its name.
+   *
+   * @tparam BaggageType type of object carried by the passenger
+   */
+  template <typename BaggageType>
+  class Ticket {
+   public:
+    /// A ticket to no passenger, never valid
+    Ticket() = default;
+
+    /// @return const reference to the object carried by the passenger
+    const BaggageType& get() const { return passenger_->get(); }
+
+    /**
+     * Update the object carried by the passenger
+     *
+     * @see Passenger::update for how we update a passenger
+     * @param[in] obj object to copy (or move) into the passenger
+     */
+    template <typename T>
+    void update(T&& obj) const {
+      passenger_->update(std::forward<T>(obj));
+    }
+
+   private:
+    friend class Bus;
+    /// Only the bus issues tickets
+    Ticket(Passenger<BaggageType>* passenger, std::size_t generation)
+        : passenger_{passenger}, generation_{generation} {}
+    /// the passenger the ticket is for
+    Passenger<BaggageType>* passenger_{nullptr};
+    /// generation of the bus the ticket was issued in
+    std::size_t generation_{0};
+  };
+
+  /**
+   * Issue a ticket to the passenger with the passed name
+   *
+   * @throws std::out_of_range if there is no passenger with the name
+   * @throws std::bad_cast if BaggageType does not match type of object
+   * passenger is carrying
+   *
+   * @tparam[in] BaggageType type of object carried by passenger
+   * @param[in] name Name of Passenger (corresponds to branch_name)
+   * @return ticket to the passenger
+   */
+  template <typename BaggageType>
+  Ticket<BaggageType> ticket(const std::string& name) {
+    return Ticket<BaggageType>(
+        &dynamic_cast<Passenger<BaggageType>&>(*passengers_.at(name)),
+        generation_);
+  }
+
+  /**
+   * Check that a ticket is still valid
+   *
+   * @param[in] ticket ticket issued by this bus
+   * @return true if the ticket's passenger is still on the bus
+   */
+  template <typename BaggageType>
+  bool valid(const Ticket<BaggageType>& ticket) const {
+    return ticket.passenger_ and ticket.generation_ == generation_;
+  }
+
  private:
   /**
    * Get a reference to a passenger on the bus
@@ -820,6 +1205,12 @@ class Bus {
    */
   std::unordered_map<std::string, std::unique_ptr<Seat>> passengers_;
 
+  /**
+   * Number of times passengers got off the bus or were replaced, the
+   * tickets issued before the latest of these are expired
+   */
+  std::size_t generation_{0};
+
 };  // Bus
 
 }  // namespace framework
@@ -35,6 +35,7 @@ namespace framework {
 class Process;
 class ConditionsObjectProvider;
 class ConditionsObject;
+class ConditionsHandle;
 
 /**
  * @class Conditions
@@ -67,6 +68,23 @@ class Conditions {
    */
   const ConditionsObject* getConditionPtr(const std::string& condition_name);
 
+  /**
+   * Request a conditions object through a handle
+   *
+   * The first request resolves the name of the condition like
+   * getConditionPtr(const std::string&) does, later requests go straight
+   * to the cache entry it found and only check that the object is still
+   * valid for the current event. The handle records whether the object
+   * changed since its previous request.
+   *
+   * @throws Exception if condition object or provider for that object is not
+   * found.
+   *
+   * @param[in,out] handle handle to the condition to retrieve
+   * @returns pointer to conditions object the handle refers to
+   */
+  const ConditionsObject* getConditionPtr(ConditionsHandle& handle);
+
   /**
    * Primary request action for a conditions object If the
    * object is in the cache and still valid (IOV), the
@@ -104,9 +122,32 @@ class Conditions {
 
   /**
    * Calls onNewRun for all ConditionsObjectProviders
+   *
+   * If prefetching is enabled, the conditions valid for the event
+   * which started the run are then loaded on several threads.
    */
   void onNewRun(ldmx::RunHeader&);
 
+  /**
+   * Set the number of threads the conditions of a new run are loaded on
+   *
+   * @param[in] n_threads number of threads, 0 to load each condition
+   * when it is first requested
+   */
+  void setPrefetchThreads(int n_threads) { prefetchThreads_ = n_threads; }
+
+  /**
+   * Load all the conditions for the input event which are not yet in
+   * the cache, calling the providers on several threads.
+   *
+   * Each provider is only called by one thread. A condition which fails
+   * to load is left to be loaded (and raise its exception) when it is
+   * requested.
+   *
+   * @param[in] context event header to load the conditions for
+   */
+  void prefetch(const ldmx::EventHeader& context);
+
   /**
    * Create a ConditionsObjectProvider given the information
    */
@@ -131,10 +172,67 @@ class Conditions {
     ConditionsObjectProvider* provider;
     /// Const pointer to the retrieved conditions object
     const ConditionsObject* obj;
+    /// Number of objects this entry has held, to notice replacements
+    unsigned long generation{1};
   };
 
   /** Conditions cache */
   std::map<std::string, CacheEntry> cache_;
+
+  /** Number of threads to load the conditions of a new run on */
+  int prefetchThreads_{0};
+
+  enableLogging("Conditions")
+
+  friend class ConditionsHandle;
+};
+
+/**
+ * @class ConditionsHandle
+ * @brief A condition which is requested in every event
+ *
+ * The handle remembers where the condition is in the cache, so requesting
+ * it again doesn't search for it by name, and whether the object changed
+ * with the last request. Anything derived from the condition (e.g. arrays
+ * of calibrations) then only needs to be rebuilt when the interval of
+ * validity of the condition ran out, instead of every event or run.
+ *
+ * @code
+ * const auto& table = getCondition<conditions::DoubleTableCondition>(handle_);
+ * if (handle_.changed()) rebuild(table);
+ * @endcode
+ */
+class ConditionsHandle {
+ public:
+  /**
+   * Create a handle for a condition
+   *
+   * @param[in] condition_name name of the condition
+   */
+  ConditionsHandle(const std::string& condition_name)
+      : name_{condition_name} {}
+
+  /// Name of the condition
+  const std::string& name() const { return name_; }
+
+  /**
+   * Did the last request return a different object than the one before it?
+   *
+   * This is true for the first request as well.
+   */
+  bool changed() const { return changed_; }
+
+ private:
+  /// name of the condition
+  std::string name_;
+  /// entry in the cache, null until the first request
+  const Conditions::CacheEntry* entry_{nullptr};
+  /// generation of the entry at the last request
+  unsigned long generation_{0};
+  /// did the last request return a different object
+  bool changed_{false};
+
+  friend class Conditions;
 };
 
 }  // namespace framework
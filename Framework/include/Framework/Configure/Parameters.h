@@ -42,6 +42,15 @@ class Parameters {
     parameters_ = parameters;
   }
 
+  /**
+   * Get the mapping of parameter names to value.
+   *
+   * @return mapping between parameter names and the corresponding value.
+   */
+  const std::map<std::string, std::any>& getParameters() const {
+    return parameters_;
+  }
+
   /**
    * Add a parameter to the parameter list.  If the parameter already
    * exists in the list, throw an exception.
@@ -70,6 +70,51 @@ class ConfigurePython {
   /// Get a handle to the configuration
   const framework::config::Parameters get() const { return configuration_; }
 
+  /**
+   * Write the configuration to a JSON file
+   *
+   * The file holds the parameters as they were gathered from python,
+   * so it can be given to load on later runs to skip python entirely.
+   * Floating point parameters are always written with a decimal point
+   * so that they are read back as doubles and not ints.
+   *
+   * @throw Exception if the file cannot be opened
+   *
+   * @param filename path to the file to write
+   */
+  void dump(const std::string& filename) const;
+
+  /**
+   * Read a configuration written by dump
+   *
+   * No python is run. The types of the parameters are deduced from the
+   * JSON values with the same rules as when reading from python, e.g. a
+   * list takes the type of its first entry and empty lists are dropped.
+   *
+   * @throw Exception if the file cannot be opened or is malformed
+   *
+   * @param filename path to the file to read
+   * @return configuration ready to make a Process
+   */
+  static ConfigurePython load(const std::string& filename);
+
+  /**
+   * Write parameters as JSON
+   *
+   * This is the format of dump. The keys are written in order, so the
+   * same parameters always give the same text.
+   *
+   * @throw Exception if a parameter is not of a type made from python
+   *
+   * @param[in] parameters parameters to write
+   * @return JSON object of the parameters
+   */
+  static std::string toJSON(const framework::config::Parameters& parameters);
+
+ private:
+  /// Empty configuration, filled by load
+  ConfigurePython() = default;
+
  private:
   /**
    * The entire configuration for this process
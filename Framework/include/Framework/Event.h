@@ -15,20 +15,46 @@
 #include "Framework/Bus.h"
 #include "Framework/EventHeader.h"
 #include "Framework/Exception/Exception.h"
+#include "Framework/Handle.h"
 #include "Framework/ProductTag.h"
 
 // STL
 #include <regex.h>
 
 #include <algorithm>
+#include <any>
 #include <iostream>
+#include <cstddef>
 #include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <sstream>
 #include <string>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace framework {
 
+/**
+ * The products used by a processor while it was processing an event
+ *
+ * @see Event::recordAccesses
+ */
+struct ProductAccesses {
+  /// names of the products it asked for
+  std::set<std::string> reads;
+  /// names of the products it added
+  std::set<std::string> writes;
+  /// true if it searched the products with a pattern
+  bool searched{false};
+};
+
 /**
  * @class Event
  * @brief Implements an event buffer system for storing event data
@@ -57,6 +83,12 @@ class Event {
    */
   ldmx::EventHeader &getEventHeader() { return eventHeader_; }
 
+  /**
+   * Get the event header of a const event.
+   * @return A const reference to the event header.
+   */
+  const ldmx::EventHeader &getEventHeader() const { return eventHeader_; }
+
   /**
    * Get the event header as a pointer
    * @return A const pointer to the event header.
@@ -134,6 +166,44 @@ class Event {
   bool exists(const std::string &name, const std::string &passName = "",
               bool unique = true) const;
 
+  /**
+   * Get the handle for a product name and pass name
+   *
+   * The pair of names is interned into a table shared by all events,
+   * so a processor can get the handles it needs once (in its constructor,
+   * configure or onProcessStart) and then pass them in place of the names
+   * to exists, getObject, getCollection, getMap and add. Each event
+   * resolves a handle into a branch name the first time it is used and
+   * keeps that until the list of products in the event changes, so these
+   * calls skip the product search and the building of the branch name
+   * for every other event.
+   *
+   * As with the name-based methods, an empty pass name matches a product
+   * from any pass as long as there is only one of them.
+   *
+   * @param collectionName name of the product
+   * @param passName name of the pass, empty for any pass
+   * @return handle to the interned names
+   */
+  static ProductHandle getHandle(const std::string &collectionName,
+                                 const std::string &passName = "");
+
+  /**
+   * Check for the existence of a unique product with the names interned
+   * in the input handle
+   *
+   * @see exists for the name-based check, this is equivalent to it with
+   * unique set to true
+   *
+   * @param handle handle from getHandle
+   * @return true if there is one and only one matching product
+   */
+  bool exists(ProductHandle handle) const {
+    auto lock{lockBus()};
+    if (accesses_) accesses_->reads.insert(getHandleTag(handle).first);
+    return not resolve(handle).empty();
+  }
+
   /**
    * Add a drop rule to the list of regex expressions to drop.
    *
@@ -171,26 +241,198 @@ class Event {
    */
   template <typename T>
   void add(const std::string &collectionName, T &obj) {
-    if (collectionName.find('_') != std::string::npos) {
-      EXCEPTION_RAISE("IllegalName",
-                      "The product name '" + collectionName +
-                          "' is illegal as it contains an underscore.");
+    add(collectionName, makeOutputBranchName(collectionName), obj);
+  }
+
+  /**
+   * Adds an object to the event bus by moving it onto the bus
+   *
+   * This overload is chosen when the object is an rvalue, e.g.
+   * ```cpp
+   * event.add("MyHits", std::move(hits));
+   * ```
+   * The storage of the object is handed over to the bus passenger instead
+   * of being copied into it, so the object should not be used afterwards.
+   *
+   * @see add for the full description
+   *
+   * @param collectionName
+   * @param obj in ROOT dictionary to move onto the bus
+   */
+  template <typename T,
+            std::enable_if_t<not std::is_lvalue_reference_v<T>, bool> = true>
+  void add(const std::string &collectionName, T &&obj) {
+    add(collectionName, makeOutputBranchName(collectionName), std::move(obj));
+  }
+
+  /**
+   * Adds an object to the event bus under the product name interned
+   * in the input handle
+   *
+   * The pass name of the handle is ignored since objects are always
+   * added with the current pass name. The branch name is only built
+   * the first time this handle is used for adding. Like the name-based
+   * versions, rvalues are moved onto the bus and lvalues are copied.
+   *
+   * @see add for the name-based version
+   *
+   * @param handle handle from getHandle
+   * @param obj in ROOT dictionary to add
+   */
+  template <typename T>
+  void add(ProductHandle handle, T &&obj) {
+    using BaggageType = std::decay_t<T>;
+
+    auto lock{lockBus()};
+    if (not handle.valid()) {
+      EXCEPTION_RAISE("InvalidHandle",
+                      "Attempting to add an object with an invalid handle.");
+    }
+    if (handle.index() >= addBranches_.size()) {
+      addBranches_.resize(handle.index() + 1);
+      addTickets_.resize(handle.index() + 1);
+    }
+    auto &branchName{addBranches_[handle.index()]};
+    const std::string &collectionName{getHandleTag(handle).first};
+    if (branchName.empty()) branchName = makeOutputBranchName(collectionName);
+
+    // once the passenger is on the bus, the object goes straight to it
+    auto &ticket{addTickets_[handle.index()]};
+    if (auto boarded{std::any_cast<Bus::Ticket<BaggageType>>(&ticket)};
+        boarded and bus_.valid(*boarded)) {
+      markFilled(collectionName, branchName);
+      boarded->update(std::forward<T>(obj));
+      return;
+    }
+    add(collectionName, branchName, std::forward<T>(obj));
+    ticket = bus_.ticket<BaggageType>(branchName);
+  }
+
+  /**
+   * Get an object from the event bus using the handle for its names
+   *
+   * After the handle has been resolved into a branch name that is on the
+   * bus, the ticket to its passenger is kept, so getting it again costs
+   * neither a look up by name nor a check of its type. Otherwise we go
+   * through the full name-based getObject (and its exceptions).
+   *
+   * @see getObject for the name-based version
+   *
+   * @tparam T type of object we should be getting
+   * @param handle handle from getHandle
+   * @return const reference to requested object
+   */
+  template <typename T>
+  const T &getObject(ProductHandle handle) const {
+    auto lock{lockBus()};
+    if (accesses_) accesses_->reads.insert(getHandleTag(handle).first);
+    if (handle.index() < getTickets_.size()) {
+      auto ticket{
+          std::any_cast<Bus::Ticket<T>>(&getTickets_[handle.index()])};
+      if (ticket and bus_.valid(*ticket)) return ticket->get();
+    }
+    const std::string &branchName{resolve(handle)};
+    if (branchName.empty() or not bus_.isOnBoard(branchName)) {
+      const auto &[collectionName, passName] = getHandleTag(handle);
+      return getObject<T>(collectionName, passName);
     }
 
-    // determine the branch name
-    std::string branchName;
-    if (collectionName == ldmx::EventHeader::BRANCH)
-      branchName = collectionName;
-    else
-      branchName = makeBranchName(collectionName);
-
-    if (branchesFilled_.find(branchName) != branchesFilled_.end()) {
-      EXCEPTION_RAISE("ProductExists",
-                      "A product named '" + collectionName +
-                          "' already exists in the event (has been loaded by a "
-                          "previous producer in this process).");
+    try {
+      auto ticket{bus_.ticket<T>(branchName)};
+      if (handle.index() >= getTickets_.size())
+        getTickets_.resize(handle.index() + 1);
+      getTickets_[handle.index()] = ticket;
+      return ticket.get();
+    } catch (const std::bad_cast &) {
+      EXCEPTION_RAISE("BadType", "Trying to get product from '" + branchName +
+                                     "' but asking for wrong type.");
     }
-    branchesFilled_.insert(branchName);
+  }
+
+  /**
+   * Get a collection (std::vector) of objects from the event bus
+   * using the handle for its names
+   *
+   * @see getObject for actual implementation
+   *
+   * @tparam ContentType type of object stored in the vector
+   * @param handle handle from getHandle
+   * @returns const reference to collection of objects on the bus
+   */
+  template <typename ContentType>
+  const std::vector<ContentType> &getCollection(ProductHandle handle) const {
+    return getObject<std::vector<ContentType> >(handle);
+  }
+
+  /**
+   * Get a map (std::map) of objects from the event bus
+   * using the handle for its names
+   *
+   * @see getObject for actual implementation
+   *
+   * @tparam KeyType type of object used as the key in the map
+   * @tparam ValType type of object used as the value in the map
+   * @param handle handle from getHandle
+   * @returns const reference to map of objects on the bus
+   */
+  template <typename KeyType, typename ValType>
+  const std::map<KeyType, ValType> &getMap(ProductHandle handle) const {
+    return getObject<std::map<KeyType, ValType> >(handle);
+  }
+
+  /**
+   * Get a read-only handle to an object on the event bus
+   *
+   * The handle refers to the object carried on the bus, so nothing is
+   * copied no matter how the result is stored by the caller. It is only
+   * valid for the current event.
+   *
+   * @see getObject for how the object is found
+   * @see Handle for how to use the result
+   *
+   * @tparam T type of object we should be getting
+   * @param collectionName name of collection you want
+   * @param passName name of pass you want
+   * @return handle to requested object
+   */
+  template <typename T>
+  Handle<T> get(const std::string &collectionName,
+                const std::string &passName = "") const {
+    return Handle<T>(getObject<T>(collectionName, passName));
+  }
+
+  /**
+   * Get a read-only handle to an object on the event bus
+   * using the product handle for its names
+   *
+   * @see get for the name-based version
+   *
+   * @tparam T type of object we should be getting
+   * @param handle handle from getHandle
+   * @return handle to requested object
+   */
+  template <typename T>
+  Handle<T> get(ProductHandle handle) const {
+    return Handle<T>(getObject<T>(handle));
+  }
+
+ private:
+  /**
+   * Adds an object to the event bus under the input branch name
+   *
+   * @see add(const std::string&, T&) for the full description
+   *
+   * @param collectionName name of the product
+   * @param branchName name of the branch for the product in this pass
+   * @param obj in ROOT dictionary to add, moved if it is an rvalue
+   */
+  template <typename T>
+  void add(const std::string &collectionName, const std::string &branchName,
+           T &&obj) {
+    using BaggageType = std::decay_t<T>;
+
+    auto lock{lockBus()};
+    markFilled(collectionName, branchName);
     // MEMORY add is leaking memory when given a vector (possible upon
     // destruction of Event?) MEMORY add is 'conditional jump or move depends on
     // uninitialised values' for all types of objects
@@ -199,7 +441,7 @@ class Event {
       // create a new branch for this collection
 
       // have type T board bus under name 'branchName'
-      bus_.board<T>(branchName);
+      bus_.board<BaggageType>(branchName);
 
       // type name (want to use branch element if possible)
       std::string tname = typeid(obj).name();
@@ -217,14 +459,16 @@ class Event {
       // check for cache entry to remove
       auto it_known{knownLookups_.find(collectionName)};
       if (it_known != knownLookups_.end()) knownLookups_.erase(it_known);
+      resolvedHandles_.clear();
+      getTickets_.clear();
 
       // add us to list of products
       products_.emplace_back(collectionName, passName_, tname);
     }
 
-    // copy input contents into bus passenger
+    // copy (or move) input contents into bus passenger
     try {
-      bus_.update(branchName, obj);
+      bus_.update(branchName, std::forward<T>(obj));
     } catch (const std::bad_cast &) {
       EXCEPTION_RAISE("TypeMismatch",
                       "Attempting to add an object whose type '" +
@@ -235,6 +479,7 @@ class Event {
     return;
   }
 
+ public:
   /**
    * Get an general object from the event bus
    *
@@ -276,41 +521,11 @@ class Event {
   template <typename T>
   const T &getObject(const std::string &collectionName,
                      const std::string &passName = "") const {
+    auto lock{lockBus()};
+    if (accesses_) accesses_->reads.insert(collectionName);
+
     // get branch name
-    std::string branchName;
-    if (collectionName == ldmx::EventHeader::BRANCH) {
-      branchName = collectionName;
-    } else if (passName.empty()) {
-      // if no passName, then find branchName by looking over known products
-      if (knownLookups_.find(collectionName) == knownLookups_.end()) {
-        // this collectionName hasn't been found before
-        //   this collection name is the whole name and not a partial name
-        //   so we search products with a full-string match required
-        auto matches = searchProducts(collectionName, "", "", true);
-        if (matches.empty()) {
-          // no matches found
-          EXCEPTION_RAISE("ProductNotFound",
-                          "No product found for name '" + collectionName + "'");
-        } else if (matches.size() > 1) {
-          // more than one branch found
-          std::stringstream names;
-          for (auto strs : matches) {
-            names << "\n" << strs;
-          }
-          EXCEPTION_RAISE("ProductAmbiguous",
-                          "Multiple products found for name '" +
-                              collectionName +
-                              "' without specified pass name :" + names.str());
-        } else {
-          // exactly one branch found -> cache for later
-          knownLookups_[collectionName] =
-              makeBranchName(collectionName, matches.at(0).passname());
-        }  // different options for number of possible branch matches
-      }    // collection not in known lookups
-      branchName = knownLookups_.at(collectionName);
-    } else {
-      branchName = makeBranchName(collectionName, passName);
-    }
+    const std::string &branchName{getBranchName(collectionName, passName)};
 
     // now we have determined the unique branch name to look for
     //  so we can start looking on the bus and the input tree
@@ -332,6 +547,10 @@ class Event {
       }
       // ooh, new branch!
       branch->SetStatus(1);  // overrides any 'ignore' rules
+      // the read cache of a file read lazily only holds the branches that
+      //  were asked for, so this one is added to it
+      if (branch->GetTree()->GetCacheSize() > 0)
+        branch->GetTree()->AddBranchToCache(branch, true);
       /**
        * Load in the current entry
        *    This is necessary because getObject is called _after_
@@ -341,8 +560,11 @@ class Event {
        *
        *    We shouldn't end up here before inputTree's read entry is unset,
        *    but we check anyways because ROOT will just seg-fault like a chump.
+       *
+       *    The branch may be on a parent tree joined as a friend, which
+       *    is at the entry of the same event rather than the same entry.
        */
-      long long int ientry{inputTree_->GetReadEntry()};
+      long long int ientry{branch->GetTree()->GetReadEntry()};
       if (ientry < 0) {
         // reached getObject without initializing inputTree's read entry
         EXCEPTION_RAISE("InTreeInit",
@@ -351,6 +573,19 @@ class Event {
                             " when attempting to get '" + branchName + "'.");
       }
       branch->GetEntry(ientry);
+#ifdef FRAMEWORK_HAS_RNTUPLE
+    } else if (not already_on_board and inputNTuple_) {
+      // same as above, but reading from the fields of a RNTuple
+      if (inputNTuple_->GetDescriptor().FindFieldId(branchName) ==
+          rntuple::kInvalidDescriptorId) {
+        EXCEPTION_RAISE("ProductNotFound", "No product found for field '" +
+                                               branchName +
+                                               "' on input ntuple.");
+      }
+      bus_.board<T>(branchName);
+      bus_.read(*inputNTuple_, branchName, inputNTupleEntry_);
+      inputFields_.push_back(branchName);
+#endif
     } else if (not already_on_board) {
       // not found in loaded branches and there is no inputTree,
       // so no hope of finding an unloaded object
@@ -415,9 +650,15 @@ class Event {
 
   /**
    * Set the output data tree.
+   *
+   * A friend output tree isn't a clone of the input tree, it only gets
+   * the products added to the event and the header, which is written
+   * so that its entries can be matched to the input ones.
+   *
    * @param tree The output data tree.
+   * @param isFriend true if the output tree is a friend of the input tree
    */
-  void setOutputTree(TTree *tree);
+  void setOutputTree(TTree *tree, bool isFriend = false);
 
   /**
    * Create the output data tree.
@@ -425,11 +666,95 @@ class Event {
    */
   TTree *createTree();
 
+#ifdef FRAMEWORK_HAS_RNTUPLE
+  /**
+   * Set the input RNTuple to read products from instead of a tree.
+   *
+   * The products are read from the fields with the same names
+   * as the branches would have.
+   *
+   * @param ntuple The input RNTuple, not owned by us.
+   */
+  void setInputNTuple(rntuple::RNTupleReader *ntuple);
+
+  /**
+   * Read an entry of the input RNTuple
+   *
+   * Only the fields that have been requested so far in this file are read,
+   * the others are read when they are first requested.
+   *
+   * @param entry index of the entry to read
+   */
+  void readNTupleEntry(rntuple::NTupleSize_t entry);
+
+  /**
+   * Get the names of the products that are written to an output RNTuple
+   * but are not in the input list yet.
+   *
+   * These are the products filled during this event that are not dropped.
+   *
+   * @param known names of the products we already know about
+   * @return names of the products that aren't known yet
+   */
+  std::vector<std::string> getNewNTupleFields(
+      const std::set<std::string> &known) const;
+
+  /**
+   * Create a RNTuple field for a product
+   *
+   * @param branchName name of the product on the bus
+   * @return new field for the product
+   */
+  std::unique_ptr<rntuple::RFieldBase> makeField(
+      const std::string &branchName) const {
+    return bus_.makeField(branchName);
+  }
+
+  /**
+   * Get the address of a product on the bus to write it from
+   *
+   * @param branchName name of the product on the bus
+   * @return pointer to the object on the bus
+   */
+  void *getAddress(const std::string &branchName) const {
+    return bus_.address(branchName);
+  }
+#endif
+
   /**
    * Get a list of the data products in the event
    */
   const std::vector<ProductTag> &getProducts() const { return products_; }
 
+  /**
+   * Estimate the memory held by the objects on the event bus
+   *
+   * @see Bus::sizes
+   * @return branch name and estimated size [bytes] of each object,
+   * largest first
+   */
+  std::vector<std::pair<std::string, std::size_t>> getProductSizes() const;
+
+  /**
+   * Record the products that are used from now on
+   *
+   * The products asked for (with getObject, exists, etc...) and the ones
+   * added are put into the input record, which is how the Process learns
+   * which processors of the sequence depend on each other.
+   *
+   * @param[in] accesses record to fill, nullptr to stop recording
+   */
+  void recordAccesses(ProductAccesses *accesses) { accesses_ = accesses; }
+
+  /**
+   * Set if several processors are working on this event at once
+   *
+   * While this is set, the accesses to the bus are guarded by a mutex.
+   *
+   * @param[in] concurrent true if processors are running concurrently
+   */
+  void setConcurrent(bool concurrent) { concurrent_ = concurrent; }
+
   /**
    * Go to the next event by retrieving the event header
    *
@@ -452,6 +777,25 @@ class Event {
    */
   void Clear();
 
+  /**
+   * Copy the products filled during this event into another event
+   *
+   * The event header and any product added to us during this event
+   * (i.e. not read from an input tree) are copied onto the bus of the
+   * other event as if they were added to it, so the other event will
+   * write them to its output tree (if it has one) following its own
+   * drop rules. This is how the events processed by the worker slots of
+   * a multi-threaded Process are put in order into the output file.
+   *
+   * @throws Exception if the other event already has a product of the
+   * same name filled during this event
+   * @throws Exception if the product type doesn't match the type the other
+   * event has stored under the same name
+   *
+   * @param[in,out] other event to copy our products into
+   */
+  void transfer(Event &other) const;
+
   /**
    * Perform end of event action (doesn't do anything right now).
    */
@@ -465,6 +809,67 @@ class Event {
    */
   void onEndOfFile();
 
+  /**
+   * Get the memory resource for scratch space that only lives during this
+   * event.
+   *
+   * This is a monotonic arena: allocating from it is little more than
+   * bumping a pointer and deallocating does nothing. All of its memory is
+   * released at once when the event is cleared after the processors are
+   * done with it, reusing the same buffer for the next event.
+   * ```cpp
+   * std::pmr::map<unsigned int, std::pmr::vector<const Hit *>> hits_by_id{
+   *     event.getMemoryResource()};
+   * ```
+   * Only use it for objects local to produce or analyze. Objects added to
+   * the bus are copied or moved into the passengers, which allocate on the
+   * heap because they are kept across events.
+   *
+   * @return pointer to the per-event arena
+   */
+  std::pmr::memory_resource *getMemoryResource() const { return &arena_; }
+
+  /**
+   * Get an object derived from the products of this event, shared by all
+   * of the processors.
+   *
+   * The object is made by the given function the first time it is asked for
+   * during an event and kept until the event is cleared, so the processors
+   * needing the same view of the products (e.g. an index of the
+   * SimParticles) only pay for building it once per event.
+   * ```cpp
+   * const auto &index{event.getDerived<MyIndex>("MyIndex", [&event]() {
+   *   return std::make_shared<MyIndex>(event.getMap<int, Thing>("Things"));
+   * })};
+   * ```
+   * The products can't change once they are on the bus, so the object
+   * stays consistent with them for the rest of the event.
+   *
+   * @throws Exception if an object of another type was made with this key
+   *
+   * @tparam T type of the derived object
+   * @tparam Make callable returning a std::shared_ptr<T> to a new object
+   * @param key name of the derived object, including anything it depends on
+   * @param make function making the object if it isn't there yet
+   * @return the derived object, valid until the end of the event
+   */
+  template <typename T, typename Make>
+  const T &getDerived(const std::string &key, Make &&make) const {
+    auto lock{lockBus()};
+    auto it{derived_.find(key)};
+    if (it == derived_.end()) {
+      std::shared_ptr<const T> made{make()};
+      it = derived_.emplace(key, std::make_pair(std::type_index(typeid(T)),
+                                                std::shared_ptr<const void>(
+                                                    std::move(made))))
+               .first;
+    } else if (it->second.first != std::type_index(typeid(T))) {
+      EXCEPTION_RAISE("BadType", "The derived object '" + key +
+                                     "' was made with another type.");
+    }
+    return *static_cast<const T *>(it->second.second.get());
+  }
+
   /**
    * Get the current/default pass name.
    * @return The current/default pass name.
@@ -494,22 +899,97 @@ class Event {
 
   /**
    * Make a branch name from a collection and pass name.
+   *
+   * The names are made once and kept for the life of the event, so
+   * asking for the same product again doesn't build a new string.
+   *
    * @param collectionName The collection name.
    * @param passName The pass name.
+   * @return reference to the branch name, valid as long as the event
    */
-  std::string makeBranchName(const std::string &collectionName,
-                             const std::string &passName) const {
-    return collectionName + "_" + passName;
-  }
+  const std::string &makeBranchName(const std::string &collectionName,
+                                    const std::string &passName) const;
 
   /**
    * Make a branch name from a collection and the default(current) pass name.
    * @param collectionName The collection name.
    */
-  std::string makeBranchName(const std::string &collectionName) const {
+  const std::string &makeBranchName(const std::string &collectionName) const {
     return makeBranchName(collectionName, passName_);
   }
 
+  /**
+   * Get the name of the branch a product is read from
+   *
+   * If the pass name is empty, the products are searched for a single
+   * one with the collection name and the result is kept until the
+   * products change.
+   *
+   * @throws Exception if no product or more than one product match
+   * the collection name when the pass name is empty
+   *
+   * @param collectionName name of the collection
+   * @param passName name of the pass, any pass if empty
+   * @return reference to the branch name
+   */
+  const std::string &getBranchName(const std::string &collectionName,
+                                   const std::string &passName) const;
+
+  /**
+   * Make the name of the branch a product is added to in this pass.
+   *
+   * @throws Exception if there is an underscore in the collection name.
+   *
+   * @param collectionName The collection name.
+   * @return branch name for adding the collection
+   */
+  const std::string &makeOutputBranchName(
+      const std::string &collectionName) const;
+
+  /**
+   * Record that a product is being added in this event
+   *
+   * @throws Exception if the product was already added in this event
+   *
+   * @param collectionName name of the product
+   * @param branchName name of the branch for the product in this pass
+   */
+  void markFilled(const std::string &collectionName,
+                  const std::string &branchName);
+
+  /**
+   * Get the names that were interned into a product handle.
+   *
+   * @throws Exception if the handle is not valid
+   *
+   * @param handle handle from getHandle
+   * @return pair of collection name and pass name
+   */
+  static const std::pair<std::string, std::string> &getHandleTag(
+      ProductHandle handle);
+
+  /**
+   * Resolve a product handle into the name of the branch it refers to.
+   *
+   * This uses the same rules as getObject, but instead of throwing
+   * an exception if there isn't a unique product, the empty string
+   * is returned. The result is cached until the list of products changes.
+   *
+   * @param handle handle from getHandle
+   * @return branch name, empty if there isn't a unique product
+   */
+  const std::string &resolve(ProductHandle handle) const;
+
+  /**
+   * Lock the bus if processors are working on this event concurrently
+   *
+   * @return lock of the bus, not holding the mutex if not concurrent
+   */
+  std::unique_lock<std::recursive_mutex> lockBus() const {
+    if (not concurrent_) return {};
+    return std::unique_lock<std::recursive_mutex>(busMutex_);
+  }
+
  private:
   /**
    * The event header object.
@@ -531,6 +1011,23 @@ class Event {
    */
   TTree *inputTree_{nullptr};
 
+  /// True if the output tree only holds the header and the new products
+  bool friendOutput_{false};
+
+  /// True if the header on the bus is attached to the friend output tree
+  bool headerOnOutput_{false};
+
+#ifdef FRAMEWORK_HAS_RNTUPLE
+  /// The input RNTuple for reading existing data, if not from a tree.
+  rntuple::RNTupleReader *inputNTuple_{nullptr};
+
+  /// The entry of the input RNTuple we are on
+  rntuple::NTupleSize_t inputNTupleEntry_{0};
+
+  /// Names of the products being read from the input RNTuple
+  mutable std::vector<std::string> inputFields_;
+#endif
+
   /// The total number of electrons in the event
   int electronCount_{1};
 
@@ -559,15 +1056,100 @@ class Event {
    */
   std::vector<regex_t> regexDropCollections_;
 
+  /**
+   * Whether a branch is dropped by its name, so the drop rules are only
+   * matched the first time a branch is added.
+   */
+  mutable std::unordered_map<std::string, bool> dropDecisions_;
+
   /**
    * Efficiency cache for empty pass name lookups.
    */
   mutable std::map<std::string, std::string> knownLookups_;
 
+  /**
+   * Branch names made from the collection and pass names, by collection
+   * and then by pass so looking them up doesn't build a key.
+   */
+  mutable std::map<std::string, std::map<std::string, std::string>>
+      branchNames_;
+
   /**
    * List of all the event products
    */
   std::vector<ProductTag> products_;
+
+  /**
+   * Branch names the product handles resolve to when getting products.
+   *
+   * Indexed by the handle index. An unset entry has not been resolved yet
+   * and an empty name means there isn't a unique product for the handle.
+   * This is cleared whenever the list of products changes.
+   */
+  mutable std::vector<std::optional<std::string>> resolvedHandles_;
+
+  /**
+   * Tickets to the passengers of the products gotten with handles.
+   *
+   * Indexed by the handle index, each is a Bus::Ticket for the type the
+   * product was gotten as. They are cleared along with resolvedHandles_
+   * and expire when the passengers get off the bus.
+   */
+  mutable std::vector<std::any> getTickets_;
+
+  /**
+   * Tickets to the passengers of the products added with handles.
+   *
+   * Indexed by the handle index, each is a Bus::Ticket for the type of
+   * the product. They expire when the passengers get off the bus.
+   */
+  std::vector<std::any> addTickets_;
+
+  /**
+   * Branch names the product handles resolve to when adding products.
+   *
+   * Indexed by the handle index. These only depend on the pass name,
+   * so they are never cleared.
+   */
+  std::vector<std::string> addBranches_;
+
+  /**
+   * Size of the buffer the per-event arena starts from [bytes]
+   *
+   * Events needing more scratch space than this get more from the heap,
+   * which is returned when the event is cleared.
+   */
+  static constexpr std::size_t ARENA_BUFFER_SIZE{1 << 20};
+
+  /**
+   * Buffer the per-event arena starts from each event
+   */
+  std::vector<std::byte> arenaBuffer_;
+
+  /**
+   * Per-event arena for scratch space
+   *
+   * @see getMemoryResource
+   */
+  mutable std::pmr::monotonic_buffer_resource arena_;
+
+  /**
+   * Objects derived from the products of this event by name
+   *
+   * Kept with their type so a mismatch is caught. Cleared with the event.
+   */
+  mutable std::map<std::string,
+                   std::pair<std::type_index, std::shared_ptr<const void>>>
+      derived_;
+
+  /// record of the products being used, null if we aren't recording
+  ProductAccesses *accesses_{nullptr};
+
+  /// true if several processors are working on this event at once
+  bool concurrent_{false};
+
+  /// guard of the bus while several processors are working on this event
+  mutable std::recursive_mutex busMutex_;
 };
 }  // namespace framework
 
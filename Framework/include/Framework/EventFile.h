@@ -2,13 +2,20 @@
 #define FRAMEWORK_EVENT_EVENTFILE_H_
 
 //---< C++ >---//
+#include <regex.h>
+
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 //---< Framework >---//
 #include "Framework/Configure/Parameters.h"
 #include "Framework/Event.h"
+#include "Framework/Performance/Trace.h"
 
 //---< ROOT >---//
 #include "TFile.h"
@@ -151,6 +158,7 @@ class EventFile {
    * is valid.
    *
    * @param parent pointer to new parent file
+   * @throw Exception if we are a friend output, which has a single parent
    */
   void updateParent(EventFile *parent);
 
@@ -191,12 +199,71 @@ class EventFile {
    */
   bool nextEvent(bool storeCurrentEvent = true);
 
+  /**
+   * Copy the branches of the kept events that come unchanged from the
+   * parent file into the output tree.
+   *
+   * Only does something for output files when fast skimming is enabled.
+   * While skimming, only the branches produced by the processors (and
+   * the EventHeader) are written each time an event is kept, the entry
+   * numbers are collected, and the unchanged branches are copied here for
+   * just those entries. This needs to be called before the parent file
+   * and the event bus are done with their current input file.
+   */
+  void copyKeptEntries();
+
+  /**
+   * Make the events written so far survive the job being killed
+   *
+   * The baskets of the output trees are flushed and their headers are
+   * written over the previous ones, so that a file that is not closed
+   * still holds all of the events filled up to here when it is recovered.
+   * The trees are not saved automatically by ROOT any more afterwards,
+   * so a recovered file holds exactly the events of the last checkpoint.
+   *
+   * Only output files written with TTrees can be checkpointed, the events
+   * that are fast skimmed are only complete once the input file is done.
+   *
+   * @return true if the file was checkpointed
+   */
+  bool checkpoint();
+
+  /**
+   * Get the position of the current entry among the entries visited
+   *
+   * This is the offset to give to skipToEvent for the current entry to be
+   * read again by the next call to nextEvent.
+   *
+   * @return position of the current entry, -1 before the first one
+   */
+  Long64_t getPosition() const { return iselected_; }
+
   /**
    * Skip events using an offset. Used in pileup overlay.
+   *
+   * The offset counts the entries visited (those in the entry range or
+   * passing the index selection), the entry is sought directly so none of
+   * the entries skipped are read.
+   *
    * @return New event number if read successfully, else -1.
    */
   int skipToEvent(int offset);
 
+  /**
+   * Read the event header and some branches of an entry without
+   * moving on to it
+   *
+   * Used to estimate how costly an entry is to process before it is
+   * handed out. The branches are read even if they are turned off and
+   * the header of the event bus is left at the entry peeked at, so the
+   * event has to be read again with nextEvent before processing it.
+   *
+   * @param[in] offset entry visited, counted as in skipToEvent
+   * @param[in] branches names of the branches to read
+   * @return number of uncompressed bytes of the branches in the entry
+   */
+  Long64_t peekEntry(int offset, const std::vector<std::string> &branches);
+
   /**
    * Write the run header into the run map
    *
@@ -217,6 +284,23 @@ class EventFile {
    */
   void writeRunTree();
 
+  /**
+   * Import the run headers of another event file into the run map
+   *
+   * This is used when resuming from a checkpoint, so that the runs of the
+   * input files finished before it end up in the output file. Runs that
+   * are already in the run map are left as they are.
+   *
+   * @param[in] filename name of the event file to import from
+   */
+  void importRunHeaders(const std::string &filename);
+
+  /// Name of the tree holding the event index
+  static const char *INDEX_TREE_NAME;
+
+  /// Name of the list of parent files of a friend output
+  static const char *PARENTS_NAME;
+
   /**
    * Update the RunHeader for a given run, if it exists in the input file.
    * @param[in] runNumber The run number.
@@ -234,6 +318,87 @@ class EventFile {
    */
   ldmx::RunHeader &getRunHeader(int runNumber);
 
+  /**
+   * Get the number of baskets the processing thread found already
+   * decompressed by the read-ahead.
+   *
+   * The read-ahead is only enabled on input files when the prefetchDepth
+   * parameter is positive.
+   *
+   * @return number of baskets read ahead in time, zero without read-ahead
+   */
+  int getPrefetchHits() const;
+
+  /**
+   * Get the number of baskets the processing thread had to wait for
+   * because the read-ahead had not decompressed them yet.
+   *
+   * @return number of baskets waited on, zero without read-ahead
+   */
+  int getPrefetchWaits() const;
+
+  /**
+   * Get the number of read calls made on an input file
+   *
+   * Each call is a round-trip when the file is read remotely. The read
+   * cache (readCacheSize or prefetchDepth) gathers the baskets of many
+   * entries into one call.
+   *
+   * @return number of read calls, zero for an output file
+   */
+  int getReadCalls() const;
+
+  /**
+   * Get the number of bytes read from an input file
+   *
+   * @return number of bytes read, zero for an output file
+   */
+  Long64_t getBytesRead() const;
+
+  /**
+   * Halve the read cache of an input file to give memory back
+   *
+   * The read-ahead (prefetchDepth) holds its entries in this cache, so it
+   * reads fewer entries ahead afterwards.
+   *
+   * @return size of the cache afterwards [bytes], zero without a cache
+   */
+  Long64_t shrinkCache();
+
+  /**
+   * Get the size of each branch of an output file
+   *
+   * The baskets still held in memory are written first so that they
+   * are included.
+   *
+   * @return name, uncompressed and compressed size [bytes] of each
+   * top-level branch, empty if this isn't an output TTree
+   */
+  std::vector<std::tuple<std::string, Long64_t, Long64_t>> getBranchSizes();
+
+  /**
+   * Get the number of entries that will be visited
+   *
+   * This is the number of entries in the event tree (or in its entry
+   * range), unless an index selection was given, then it is the number of
+   * entries it selected.
+   *
+   * @return the number of entries to read
+   */
+  Long64_t getEntries() const {
+    return hasSelection_ ? Long64_t(selected_.size()) : entries_;
+  }
+
+  /**
+   * Trace the reading and writing of events
+   *
+   * The time spent in nextEvent, along with the reading (TTree::GetEntry)
+   * and writing (TTree::Fill) inside of it, is written to the input trace.
+   *
+   * @param[in] trace trace to write to, null to stop tracing
+   */
+  void setTrace(performance::Trace *trace) { trace_ = trace; }
+
   /// @return the name of the ROOT file being managed.
   const std::string &getFileName() { return fileName_; }
 
@@ -256,8 +421,102 @@ class EventFile {
    */
   void importRunHeaders();
 
+  /**
+   * Copy the run headers of the run tree of a file into the run map
+   *
+   * @param[in] file file to read the run tree from
+   * @param[in] replace whether runs already in the run map are replaced
+   */
+  void readRunHeaders(TFile *file, bool replace);
+
+  /**
+   * Join the trees of the parent files of a friend output to a tree
+   *
+   * Each parent tree is indexed by run and event number and added as a
+   * friend, so loading an entry of the tree loads the same event of the
+   * parent even if the output was skimmed. The parents of the parents
+   * are joined to them in turn.
+   *
+   * A relative name of a parent is looked for next to the file listing
+   * it if it isn't found from the working directory.
+   *
+   * @param[in] file file that may list parent files
+   * @param[in] tree event tree of the file
+   * @throw Exception if a parent file can't be opened or has no event tree
+   */
+  void attachParents(TFile *file, TTree *tree);
+
+  /**
+   * Find the branches of the output tree that are cloned from the parent
+   * tree and disable them on the parent tree so they are only read when
+   * requested by a processor or by copyKeptEntries.
+   */
+  void deferClonedBranches();
+
+  /**
+   * Apply the per-branch settings to the branches of the output tree that
+   * have not been configured yet.
+   *
+   * Branches are added to the output tree as the processors add products
+   * to the event bus, so this is called before each fill. A branch is
+   * given the compression and basket size of the first rule whose pattern
+   * matches its name, branches not matching any rule keep the defaults.
+   */
+  void configureNewBranches();
+
+  /**
+   * Write the current event to the output RNTuple
+   *
+   * The RNTuple model needs to know about a field before it is filled,
+   * so the products that show up for the first time are added to the
+   * model (creating the writer on the first event) before filling.
+   */
+  void fillNTuple();
+
+  /**
+   * Add the current event to the event index
+   *
+   * The index tree is created on the first event stored. Each of its
+   * rows holds the entry of the event in the event tree, its run, event
+   * number and weight, along with the EventHeader parameters listed in
+   * eventIndexParameters. All of the parameters are stored as doubles
+   * (NaN if the event doesn't have it) in a branch named like the
+   * parameter, with the characters that can't be in a TTree::Draw
+   * expression replaced by underscores.
+   */
+  void fillIndex();
+
+  /**
+   * Select the entries of an input file with its event index
+   *
+   * The selection is evaluated on the index tree alone (with TTree::Draw),
+   * so the event tree is only read for the entries that pass it.
+   *
+   * @throw Exception if the file has no event index or the selection
+   * cannot be evaluated on it
+   *
+   * @param[in] selection expression of the branches of the index tree,
+   * no expression if empty
+   * @param[in] events run and event numbers of the only events to read,
+   * any event if empty; a negative run matches the event in any run
+   */
+  void selectEntries(const std::string &selection,
+                     const std::vector<std::pair<int, int>> &events = {});
+
+  /**
+   * Only visit the entries of the tree in a range
+   *
+   * With an index selection, only the selected entries in the range are
+   * visited.
+   *
+   * @param[in] range first entry and one past the last entry of the range,
+   * the last entry is the last of the tree if it is negative
+   * @throw Exception if the range isn't two entries in order
+   */
+  void selectRange(const std::vector<int> &range);
+
  private:
-  /// The number of entries in the tree.
+  /// The number of entries in the tree (in its entry range for input files)
   Long64_t entries_{-1};
 
   /// The current entry in the tree.
@@ -275,6 +534,141 @@ class EventFile {
   /// True if this is an input file with pileup overlay events */
   bool isLoopable_{false};
 
+  /**
+   * True if only the branches that are requested are read from the input.
+   *
+   * The input branches start off disabled and Event::getObject enables
+   * each one on its first request, so a single TTree::GetEntry reads
+   * only the requested branches (and those copied to the output).
+   */
+  bool lazyBranches_{false};
+
+  /**
+   * True if the unchanged branches of kept events are copied after the
+   * event loop instead of being written with each event.
+   *
+   * @see copyKeptEntries
+   */
+  bool fastSkim_{false};
+
+  /// Output branches cloned from the parent that are copied after the loop
+  std::vector<TBranch *> deferredBranches_;
+
+  /// Entries of the parent tree that were kept but not copied yet
+  std::vector<Long64_t> keptEntries_;
+
+  /**
+   * True if the output tree only holds the header and the new products of
+   * each event, the products of the parent are not copied.
+   *
+   * The names of the parent files are written next to the tree and the
+   * parent trees are joined back to it when it is read.
+   *
+   * @see attachParents
+   */
+  bool friendOutput_{false};
+
+  /// Files the output events were read from, when writing a friend output
+  std::vector<std::string> parentNames_;
+
+  /// Parent files of an input file, their trees are friends of ours
+  std::vector<std::unique_ptr<TFile>> parentFiles_;
+
+  /// Settings for the output branches with names matching a pattern
+  struct BranchSettings {
+    /// pattern the branch name is matched against
+    regex_t pattern;
+    /// compression settings (100*algorithm + level), negative for the file's
+    int compression;
+    /// size of the baskets in bytes, zero or negative for ROOT's default
+    int basketSize;
+  };
+
+  /// Rules for configuring output branches, in the order they were given
+  std::vector<BranchSettings> branchSettings_;
+
+  /**
+   * Number of events in each cluster of the output tree.
+   *
+   * Passed to TTree::SetAutoFlush, so a negative value is the number of
+   * bytes to write before flushing instead. Zero keeps ROOT's default.
+   */
+  Long64_t clusterSize_{0};
+
+  /// Number of branches of the output tree that have been configured
+  int nConfiguredBranches_{0};
+
+  /**
+   * True if the events are stored in a RNTuple instead of a TTree.
+   *
+   * For input files, this is decided by what is in the file.
+   * For output files, this is the outputBackend parameter.
+   */
+  bool isNTuple_{false};
+
+  /// Name of the event tree (or RNTuple)
+  std::string treeName_;
+
+  /// Compression settings used for the output RNTuple
+  int compressionSetting_{9};
+
+#ifdef FRAMEWORK_HAS_RNTUPLE
+  /// Reader of the input RNTuple
+  std::unique_ptr<rntuple::RNTupleReader> ntupleReader_;
+
+  /// Writer of the output RNTuple, created on the first event
+  std::unique_ptr<rntuple::RNTupleWriter> ntupleWriter_;
+
+  /// Entry of the output RNTuple, bound to the products on the bus
+  std::unique_ptr<rntuple::REntry> ntupleEntry_;
+
+  /// Names of the fields on the output RNTuple
+  std::set<std::string> ntupleFields_;
+#endif
+
+  /// True if the stored events are indexed in a tree next to the events
+  bool writeIndex_{false};
+
+  /// Names of the EventHeader parameters copied to the event index
+  std::vector<std::string> indexParameters_;
+
+  /// Index of the stored events, created with the first one
+  TTree *indexTree_{nullptr};
+
+  /// Entry in the event tree of the event being indexed
+  Long64_t indexEntry_{0};
+
+  /// Run and event number of the event being indexed
+  Int_t indexRun_{0}, indexEvent_{0};
+
+  /// Weight of the event being indexed
+  Double_t indexWeight_{0.};
+
+  /// Values of the indexed parameters, in the order they were listed
+  std::vector<Double_t> indexValues_;
+
+  /// True if only the entries selected from the event index are read
+  bool hasSelection_{false};
+
+  /// Entries of the event tree passing the index selection, in order
+  std::vector<Long64_t> selected_;
+
+  /// Position in the entries visited of the current entry
+  Long64_t iselected_{-1};
+
+  /// First entry of the entry range, the entries before it are not visited
+  Long64_t rangeBegin_{0};
+
+  /**
+   * Get the entry of the tree at a position among the entries visited
+   *
+   * @param[in] position position among the entries visited
+   * @return entry of the tree
+   */
+  Long64_t entryAt(Long64_t position) const {
+    return hasSelection_ ? selected_[position] : rangeBegin_ + position;
+  }
+
   /// The backing TFile for this EventFile.
   TFile *file_{nullptr};
 
@@ -287,6 +681,9 @@ class EventFile {
   /// The object containing the actual event data (trees and branches).
   Event *event_{nullptr};
 
+  /// Trace of the I/O, not owned by us, may be null
+  performance::Trace *trace_{nullptr};
+
   /**
    * Pre-clone rules.
    *
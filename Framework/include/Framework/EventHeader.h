@@ -13,9 +13,11 @@
 #include "TTimeStamp.h"
 
 // STL
+#include <cstdint>
 #include <iostream>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace ldmx {
 
@@ -39,7 +41,16 @@ namespace ldmx {
  * ## v2
  * This is the main version currently and has all of the ldmx-sw necessary
  * information except the number of tries it took to generate any given event.
- * This is what motivated the update to v3.
+ *
+ * ## v3
+ * The parameters are stored as flat lists of keys and values instead of maps
+ * by name, so the names are not written again into every event. The key of a
+ * parameter is a hash of its name (see EventHeader::key) and the names of the
+ * keys set in a run are stored once in its RunHeader.
+ *
+ * ### Interop with v2
+ * The maps of v2 headers are read into the (otherwise empty) legacy maps and
+ * the parameters are found there by name.
  */
 class EventHeader {
  public:
@@ -48,6 +59,46 @@ class EventHeader {
    */
   static const std::string BRANCH;
 
+  /**
+   * Key of a parameter
+   */
+  typedef uint32_t Key;
+
+  /**
+   * Get the key of a parameter name
+   *
+   * The key is a hash of the name (FNV-1a), so it is the same in every
+   * process and file. The name is remembered so it can be written into the
+   * RunHeader, and two names with the same key are an error.
+   *
+   * Processors setting a parameter on every event can get its key once
+   * and use the overloads taking a key.
+   *
+   * @throw Exception if another name has the same key
+   * @param name The name of the parameter.
+   * @return The key of the parameter.
+   */
+  static Key key(const std::string& name);
+
+  /**
+   * Get the key of a parameter name without remembering the name
+   * @param name The name of the parameter.
+   * @return The key of the parameter.
+   */
+  static Key hash(const std::string& name);
+
+  /**
+   * Get the names of the keys that were made in this process
+   * @return The names by key.
+   */
+  static std::map<Key, std::string> getParameterNames();
+
+  /**
+   * Remember the names of keys, e.g. read from a RunHeader
+   * @param names The names by key.
+   */
+  static void addParameterNames(const std::map<Key, std::string>& names);
+
   /**
    * Class constructor.
    */
@@ -159,6 +210,14 @@ class EventHeader {
    */
   int getIntParameter(const std::string& name) const;
 
+  /**
+   * Get an int parameter value.
+   * @throw Exception if parameter does not exist
+   * @param key The key of the parameter.
+   * @return The parameter value.
+   */
+  int getIntParameter(Key key) const;
+
   /**
    * Set an int parameter value.
    * @param name The name of the parameter.
@@ -166,7 +225,26 @@ class EventHeader {
    * @return The parameter value.
    */
   void setIntParameter(const std::string& name, int value) {
-    intParameters_[name] = value;
+    setIntParameter(key(name), value);
+  }
+
+  /**
+   * Set an int parameter value.
+   * @param key The key of the parameter.
+   * @param value The value of the parameter.
+   */
+  void setIntParameter(Key key, int value) {
+    set(intKeys_, intValues_, key, value);
+  }
+
+  /**
+   * Check if an int parameter is set.
+   * @param name The name of the parameter.
+   * @return True if the parameter exists.
+   */
+  bool hasIntParameter(const std::string& name) const {
+    return find(intKeys_, hash(name)) != NOT_FOUND or
+           intParameters_.find(name) != intParameters_.end();
   }
 
   /**
@@ -177,13 +255,40 @@ class EventHeader {
    */
   float getFloatParameter(const std::string& name) const;
 
+  /**
+   * Get a float parameter value.
+   * @throw Exception if parameter does not exist
+   * @param key The key of the parameter.
+   * @return value The parameter value.
+   */
+  float getFloatParameter(Key key) const;
+
   /**
    * Set a float parameter value.
    * @param name The name of the parameter.
    * @return value The parameter value.
    */
   void setFloatParameter(const std::string& name, float value) {
-    floatParameters_[name] = value;
+    setFloatParameter(key(name), value);
+  }
+
+  /**
+   * Set a float parameter value.
+   * @param key The key of the parameter.
+   * @param value The parameter value.
+   */
+  void setFloatParameter(Key key, float value) {
+    set(floatKeys_, floatValues_, key, value);
+  }
+
+  /**
+   * Check if a float parameter is set.
+   * @param name The name of the parameter.
+   * @return True if the parameter exists.
+   */
+  bool hasFloatParameter(const std::string& name) const {
+    return find(floatKeys_, hash(name)) != NOT_FOUND or
+           floatParameters_.find(name) != floatParameters_.end();
   }
 
   /**
@@ -200,7 +305,41 @@ class EventHeader {
    * @return value The parameter value.
    */
   void setStringParameter(const std::string& name, std::string value) {
-    stringParameters_[name] = value;
+    set(stringKeys_, stringValues_, key(name), std::move(value));
+  }
+
+ private:
+  /// Index of a key not in a list
+  static constexpr std::size_t NOT_FOUND{static_cast<std::size_t>(-1)};
+
+  /**
+   * Find a key in a list of keys
+   *
+   * There are only a few parameters in an event, so looking through
+   * them is faster than any lookup structure.
+   *
+   * @param[in] keys The list of keys.
+   * @param[in] key The key to find.
+   * @return The index of the key, NOT_FOUND if it isn't in the list.
+   */
+  static std::size_t find(const std::vector<Key>& keys, Key key) {
+    for (std::size_t i{0}; i < keys.size(); i++) {
+      if (keys[i] == key) return i;
+    }
+    return NOT_FOUND;
+  }
+
+  /// Set the value of a key, adding the key if it isn't in the list
+  template <typename T>
+  static void set(std::vector<Key>& keys, std::vector<T>& values, Key key,
+                  T value) {
+    std::size_t i{find(keys, key)};
+    if (i != NOT_FOUND) {
+      values[i] = std::move(value);
+    } else {
+      keys.push_back(key);
+      values.push_back(std::move(value));
+    }
   }
 
  protected:
@@ -230,24 +369,54 @@ class EventHeader {
   bool isRealData_{false};
 
   /**
-   * The int parameters.
+   * The keys of the int parameters.
+   */
+  std::vector<Key> intKeys_;
+
+  /**
+   * The int parameters, in the order of their keys.
+   */
+  std::vector<int> intValues_;
+
+  /**
+   * The keys of the float parameters.
+   */
+  std::vector<Key> floatKeys_;
+
+  /**
+   * The float parameters, in the order of their keys.
+   */
+  std::vector<float> floatValues_;
+
+  /**
+   * The keys of the string parameters.
+   */
+  std::vector<Key> stringKeys_;
+
+  /**
+   * The string parameters, in the order of their keys.
+   */
+  std::vector<std::string> stringValues_;
+
+  /**
+   * The int parameters of v2 headers.
    */
   std::map<std::string, int> intParameters_;
 
   /**
-   * The float parameters.
+   * The float parameters of v2 headers.
    */
   std::map<std::string, float> floatParameters_;
 
   /**
-   * The string parameters.
+   * The string parameters of v2 headers.
    */
   std::map<std::string, std::string> stringParameters_;
 
   /**
    * ROOT class definition.
    */
-  ClassDef(EventHeader, 2);
+  ClassDef(EventHeader, 3);
 };
 
 }  // namespace ldmx
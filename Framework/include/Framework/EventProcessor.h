@@ -24,7 +24,9 @@
 /*   C++ StdLib   */
 /*~~~~~~~~~~~~~~~~*/
 #include <any>
+#include <iosfwd>
 #include <map>
+#include <set>
 
 class TDirectory;
 
@@ -134,6 +136,26 @@ class EventProcessor {
    */
   virtual void onProcessEnd() {}
 
+  /**
+   * Callback for the EventProcessor to save the state it needs to carry
+   * on where it left off when the job is resumed from a checkpoint, such
+   * as the state of a random number engine it owns.
+   *
+   * @note Histograms and ntuples are saved by the Process.
+   * @param state stream to write the state to
+   */
+  virtual void onCheckpoint(std::ostream &state) {}
+
+  /**
+   * Callback for the EventProcessor to restore the state it saved in
+   * onCheckpoint when the job is resumed from the checkpoint. This is
+   * called right after onNewRun of the first run processed, so that the
+   * restored state replaces the one set up at the start of the run.
+   *
+   * @param state stream to read the state from
+   */
+  virtual void onResume(std::istream &state) {}
+
   /**
    * Access a conditions object for the current event
    */
@@ -142,6 +164,17 @@ class EventProcessor {
     return getConditions().getCondition<T>(condition_name);
   }
 
+  /**
+   * Access a conditions object for the current event through a handle,
+   * which skips the lookup by name and tells whether the object changed
+   *
+   * @see ConditionsHandle
+   */
+  template <class T>
+  const T &getCondition(ConditionsHandle &handle) {
+    return dynamic_cast<const T &>(*getConditions().getConditionPtr(handle));
+  }
+
   /**
    * Access/create a directory in the histogram file for this event
    * processor to create histograms and analysis tuples.
@@ -170,12 +203,33 @@ class EventProcessor {
   void setStorageHint(framework::StorageControl::Hint hint,
                       const std::string &purposeString);
 
+  /**
+   * Mark one of the events of a batch as having the given storage control
+   * hint from this module
+   *
+   * @see Producer::produceBatch
+   * @param event The event of the batch the hint is for
+   * @param controlhint The storage control hint to apply for the given event
+   * @param purposeString A purpose string which can be used in the skim control
+   * configuration
+   */
+  void setStorageHint(const Event &event,
+                      framework::StorageControl::Hint hint,
+                      const std::string &purposeString = "");
+
   /**
    * Get the current logging frequency from the process
    * @return int frequency logging should occurr
    */
   int getLogFrequency() const;
 
+  /**
+   * Get the fraction of the memory budget of the process still free
+   * @see Process::getMemoryHeadroom
+   * @return fraction of the budget left, 1 if there is no budget
+   */
+  double getMemoryHeadroom() const;
+
   /**
    * Get the run number from the process
    * @return int run number
@@ -187,6 +241,42 @@ class EventProcessor {
    */
   std::string getName() const { return name_; }
 
+  /**
+   * Check if onProcessStart can be run next to the other processors
+   *
+   * @see declareIndependentStart
+   * @return true if this processor declared an independent start
+   */
+  bool hasIndependentStart() const { return independentStart_; }
+
+  /**
+   * Check if this processor should be given batches of events
+   *
+   * @see Producer::produceBatch
+   * @return true if this processor declared it produces in batches
+   */
+  bool producesInBatches() const { return batchProduce_; }
+
+  /**
+   * Get the products this processor declared it may read
+   *
+   * @see declareInput
+   * @return names of the declared input collections
+   */
+  const std::set<std::string> &getDeclaredInputs() const {
+    return declaredInputs_;
+  }
+
+  /**
+   * Get the products this processor declared it may add
+   *
+   * @see declareOutput
+   * @return names of the declared output collections
+   */
+  const std::set<std::string> &getDeclaredOutputs() const {
+    return declaredOutputs_;
+  }
+
   /**
    * Internal function which is part of the PluginFactory machinery.
    * @param classname The class name of the processor.
@@ -204,6 +294,27 @@ class EventProcessor {
   void createHistograms(
       const std::vector<framework::config::Parameters> &histos);
 
+  /**
+   * Internal function which declares the input and output collections
+   * passed from the python configuration
+   *
+   * @see declareInput
+   * @see declareOutput
+   * @param[in] inputs names of the collections that may be read
+   * @param[in] outputs names of the collections that may be added
+   */
+  void declareCollections(const std::vector<std::string> &inputs,
+                          const std::vector<std::string> &outputs) {
+    declaredInputs_.insert(inputs.begin(), inputs.end());
+    declaredOutputs_.insert(outputs.begin(), outputs.end());
+  }
+
+  /**
+   * Internal function which fills the histograms with the values buffered
+   * by the histogram helper (if any), called before onProcessEnd
+   */
+  void flushHistograms() { histograms_.flush(); }
+
  protected:
   /**
    * Abort the event immediately.
@@ -212,6 +323,66 @@ class EventProcessor {
    */
   void abortEvent() { throw AbortEventException(); }
 
+  /**
+   * Declare that onProcessStart does not depend on the other processors
+   *
+   * When the process is configured with `parallelStart`, the processors
+   * that declared this have their onProcessStart run on their own thread,
+   * at the same time as the others. This is meant for slow and
+   * self-contained setup like loading a model or building a geometry
+   * from a file.
+   *
+   * The conditions system is started before any processor, so the
+   * conditions can be used. Do not declare this if onProcessStart creates
+   * histograms or ntuples, or uses other shared services, since those are
+   * not thread-safe.
+   *
+   * Call this in the constructor or in configure.
+   */
+  void declareIndependentStart() { independentStart_ = true; }
+
+  /**
+   * Declare that this producer implements Producer::produceBatch
+   *
+   * This only changes how the events are given to the producer when the
+   * process is configured with a `batchSize` larger than one.
+   *
+   * Call this in the constructor or in configure.
+   */
+  void declareBatchProduce() { batchProduce_ = true; }
+
+  /**
+   * Declare that this processor may read the input collection
+   *
+   * The declared collections let the Process check the order of the
+   * sequence and, with `pruneUnusedProducers`, skip the producers whose
+   * outputs are neither read nor saved.
+   *
+   * When the process is configured with `n_sequence_threads` larger than
+   * one, the products used by each processor are recorded on the first
+   * event and the processors that don't share any products are run at
+   * the same time. A product that is only read on some events (e.g.
+   * behind an `if`) may be missed by that first event, so it should be
+   * declared here.
+   *
+   * Call this in the constructor or in configure.
+   *
+   * @param[in] collectionName name of the collection that may be read
+   */
+  void declareInput(const std::string &collectionName) {
+    declaredInputs_.insert(collectionName);
+  }
+
+  /**
+   * Declare that this processor may add the output collection
+   *
+   * @see declareInput
+   * @param[in] collectionName name of the collection that may be added
+   */
+  void declareOutput(const std::string &collectionName) {
+    declaredOutputs_.insert(collectionName);
+  }
+
   /// Interface class for making and filling histograms
   HistogramHelper histograms_;
 
@@ -240,6 +411,18 @@ class EventProcessor {
 
   /** Histogram directory */
   TDirectory *histoDir_{0};
+
+  /** True if onProcessStart can run concurrently with the others */
+  bool independentStart_{false};
+
+  /** True if this producer takes batches of events */
+  bool batchProduce_{false};
+
+  /** Collections this processor declared it may read */
+  std::set<std::string> declaredInputs_;
+
+  /** Collections this processor declared it may add */
+  std::set<std::string> declaredOutputs_;
 };
 
 /**
@@ -276,6 +459,27 @@ class Producer : public EventProcessor {
    */
   virtual void produce(Event &event) = 0;
 
+  /**
+   * Process several events at once and put new data products into them.
+   *
+   * This is only called for producers that called declareBatchProduce
+   * and only when the process is configured with a `batchSize` larger than
+   * one, otherwise produce is called for each event like normal. It is meant
+   * for algorithms that are much faster on many inputs at once (e.g. the
+   * inference of a neural network).
+   *
+   * The events of a batch all belong to the same run, so the conditions
+   * are the same for all of them. The storage hints need to be given with
+   * the event they are for (EventProcessor::setStorageHint(event, hint))
+   * and aborting aborts every event of the batch.
+   *
+   * @throws Exception if the producer declared it produces in batches
+   * without overriding this method
+   *
+   * @param events The events to process, in order
+   */
+  virtual void produceBatch(const std::vector<Event *> &events);
+
   /**
    * Handle allowing producers to modify run headers before the run begins
    * @param header RunHeader for Producer to add parameters to
@@ -0,0 +1,100 @@
+/**
+ * @file Handle.h
+ * @brief Read-only view of an object carried on the event bus
+ */
+
+#ifndef FRAMEWORK_HANDLE_H_
+#define FRAMEWORK_HANDLE_H_
+
+// STL
+#include <cstddef>
+#include <utility>
+
+namespace framework {
+
+/**
+ * @class Handle
+ * @brief Read-only view of an object carried on the event bus
+ *
+ * A Handle points at the object a bus passenger is carrying, so getting
+ * one never copies the object. This is in contrast to the common
+ * ```cpp
+ * auto hits{event.getCollection<ldmx::SimCalorimeterHit>("EcalSimHits")};
+ * ```
+ * which deduces a std::vector and deep-copies the whole collection.
+ * ```cpp
+ * auto hits{event.get<std::vector<ldmx::SimCalorimeterHit>>("EcalSimHits")};
+ * for (const auto& hit : hits) { ... }
+ * ```
+ *
+ * The passenger clears its object at the end of each event and is deleted
+ * at the end of each input file, so a Handle is only valid during the
+ * event it was taken from. Do not keep one in a processor between events.
+ *
+ * The container accessors (begin, end, size, empty, and operator[]) are
+ * passed along to the object when it has them, so a Handle to a collection
+ * can be used like the collection itself.
+ *
+ * @tparam T type of object the passenger is carrying
+ */
+template <typename T>
+class Handle {
+ public:
+  /**
+   * Wrap a reference to the object on the bus
+   *
+   * @param obj object carried by a bus passenger
+   */
+  explicit Handle(const T &obj) : obj_{&obj} {}
+
+  /// @return reference to the object on the bus
+  const T &get() const { return *obj_; }
+
+  /// @return reference to the object on the bus
+  const T &operator*() const { return *obj_; }
+
+  /// @return pointer to the object on the bus
+  const T *operator->() const { return obj_; }
+
+  /// Allow the handle to be passed where a reference is expected
+  operator const T &() const { return *obj_; }
+
+  /// @return iterator to the start of the collection
+  template <typename U = T>
+  auto begin() const -> decltype(std::declval<const U &>().begin()) {
+    return obj_->begin();
+  }
+
+  /// @return iterator to the end of the collection
+  template <typename U = T>
+  auto end() const -> decltype(std::declval<const U &>().end()) {
+    return obj_->end();
+  }
+
+  /// @return number of entries in the collection
+  template <typename U = T>
+  auto size() const -> decltype(std::declval<const U &>().size()) {
+    return obj_->size();
+  }
+
+  /// @return true if the collection has no entries
+  template <typename U = T>
+  auto empty() const -> decltype(std::declval<const U &>().empty()) {
+    return obj_->empty();
+  }
+
+  /// @return entry i of the collection
+  template <typename U = T>
+  auto operator[](std::size_t i) const
+      -> decltype(std::declval<const U &>()[i]) {
+    return (*obj_)[i];
+  }
+
+ private:
+  /// object on the bus, not owned by us
+  const T *obj_;
+};
+
+}  // namespace framework
+
+#endif  // FRAMEWORK_HANDLE_H_
@@ -5,8 +5,10 @@
 //   C++ StdLib   //
 //----------------//
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 //----------//
 //   ROOT   //
@@ -77,7 +79,70 @@ class HistogramHelper {
   /// The name of the processor that this helper is assigned to
   std::string name_;
 
+  /**
+   * The histograms created by this helper
+   *
+   * The pool is keyed by the name of the processor, so several copies
+   * of the same processor (e.g. the worker slots of a multi-threaded Process)
+   * would overwrite each other's histograms in it. Keeping our own handles
+   * makes sure each copy fills the histograms it created.
+   */
+  std::unordered_map<std::string, TH1*> histograms_;
+
+  /// A histogram that has been given an ID and its buffered fills
+  struct Resolved {
+    /// the histogram
+    TH1* hist{nullptr};
+    /// the histogram if it is 2D, null otherwise
+    TH2* hist2d{nullptr};
+    /// buffered x values
+    std::vector<double> x;
+    /// buffered y values (2D only)
+    std::vector<double> y;
+    /// buffered weights
+    std::vector<double> w;
+  };
+
+  /// The histograms that have been given an ID, indexed by the ID
+  std::vector<Resolved> resolved_;
+
+  /// Number of fills to buffer for each histogram, zero to fill directly
+  std::size_t bufferSize_{0};
+
+  /// Fill a histogram with the values buffered for it
+  void flush(Resolved& r);
+
  public:
+  /**
+   * Handle to a histogram of this helper
+   *
+   * Filling by name looks up the histogram in a map on every call, which
+   * adds up for processors filling hundreds of histograms each event.
+   * An ID is resolved from the name once, usually in onProcessStart,
+   * and afterwards fills the histogram directly.
+   * ```cpp
+   * // in onProcessStart
+   * energy_id_ = histograms_.id("energy");
+   * // in analyze
+   * histograms_.fill(energy_id_, hit.getEnergy());
+   * ```
+   * An ID is only valid for the helper that gave it out, so each copy of a
+   * processor (e.g. in the worker slots of a multi-threaded Process) needs
+   * to resolve its own.
+   */
+  class ID {
+   public:
+    /// An ID that does not refer to a histogram yet
+    ID() = default;
+
+   private:
+    friend class HistogramHelper;
+    /// Only the helper gives out IDs
+    explicit ID(std::size_t index) : index_{index} {}
+    /// index into the helper's resolved histograms
+    std::size_t index_{std::numeric_limits<std::size_t>::max()};
+  };
+
   /**
    * Constructor
    *
@@ -180,12 +245,83 @@ class HistogramHelper {
     dynamic_cast<TH2F*>(this->get(name))->Fill(valx, valy, theWeight_);
   }
 
+  /**
+   * Get the ID of a histogram to fill it without looking up its name
+   *
+   * @throws Exception if there is no histogram with the input name
+   *
+   * @param name name of the histogram
+   * @return ID of that histogram
+   */
+  ID id(const std::string& name);
+
+  /**
+   * Fill a 1D histogram by its ID
+   *
+   * Uses the current setting of theWeight_.
+   *
+   * @param id ID of the histogram to fill
+   * @param val value to fill
+   */
+  void fill(ID id, double val) {
+    Resolved& r{resolved_[id.index_]};
+    if (bufferSize_ == 0) {
+      r.hist->Fill(val, theWeight_);
+      return;
+    }
+    r.x.push_back(val);
+    r.w.push_back(theWeight_);
+    if (r.x.size() >= bufferSize_) flush(r);
+  }
+
+  /**
+   * Fill a 2D histogram by its ID
+   *
+   * Uses the current setting of theWeight_.
+   *
+   * @param id ID of the histogram to fill
+   * @param valx x value to fill
+   * @param valy y value to fill
+   */
+  void fill(ID id, double valx, double valy) {
+    Resolved& r{resolved_[id.index_]};
+    if (bufferSize_ == 0) {
+      r.hist2d->Fill(valx, valy, theWeight_);
+      return;
+    }
+    r.x.push_back(valx);
+    r.y.push_back(valy);
+    r.w.push_back(theWeight_);
+    if (r.x.size() >= bufferSize_) flush(r);
+  }
+
+  /**
+   * Buffer the fills made through IDs
+   *
+   * Each histogram given an ID keeps up to the input number of fills and
+   * then fills them all at once with FillN, which keeps the histogram out
+   * of the cache in between. The helper belongs to a single copy of a
+   * processor, so the buffers are never shared between threads.
+   * The fills made by name are not buffered.
+   *
+   * The framework flushes the buffers before onProcessEnd, so processors
+   * only need to call flush when they read their histograms before that.
+   *
+   * @param n number of fills to buffer, zero fills directly (the default)
+   */
+  void setBufferSize(std::size_t n);
+
+  /// Fill the histograms with all of their buffered values
+  void flush();
+
   /**
    * Get a pointer to a histogram by name
    *
    * @param name name of the histogram to get
    */
   TH1* get(const std::string& name) {
+    auto histo{histograms_.find(name)};
+    if (histo != histograms_.end()) return histo->second;
     return HistogramPool::getInstance().get(name_ + "_" + name);
   }
 };
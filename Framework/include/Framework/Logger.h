@@ -11,7 +11,8 @@
 
 #include <boost/log/core.hpp>                 //core logging service
 #include <boost/log/expressions.hpp>          //for attributes and expressions
-#include <boost/log/sinks/sync_frontend.hpp>  //syncronous sink frontend
+#include <boost/log/sinks/async_frontend.hpp>  //asyncronous sink frontend
+#include <boost/log/sinks/sync_frontend.hpp>   //syncronous sink frontend
 #include <boost/log/sinks/text_ostream_backend.hpp>  //output stream sink backend
 #include <boost/log/sources/global_logger_storage.hpp>  //for global logger default
 #include <boost/log/sources/severity_channel_logger.hpp>  //for the severity logger
@@ -22,6 +23,17 @@
 #include <boost/log/sources/record_ostream.hpp>
 #include <boost/log/utility/setup/file.hpp>
 
+/**
+ * @macro LDMX_LOG_MIN_LEVEL
+ *
+ * Lowest level of the messages that are compiled in, messages below it
+ * are removed at compile time and cost nothing. Set with the LOG_MIN_LEVEL
+ * cmake option, e.g. to 1 to remove the debug messages from a build.
+ */
+#ifndef LDMX_LOG_MIN_LEVEL
+#define LDMX_LOG_MIN_LEVEL 0
+#endif
+
 namespace framework {
 
 namespace logging {
@@ -37,6 +49,28 @@ enum level {
   fatal       ///> 4
 };
 
+/**
+ * Lowest level printed by any of the sinks
+ *
+ * Set when the logging is opened, messages below it are skipped by
+ * ldmx_log before the message is formatted. Until then it lets all
+ * of the messages through to the (empty) logging core.
+ */
+extern level lowestLevel;
+
+/**
+ * Check if a message of a level would be printed
+ *
+ * Messages below LDMX_LOG_MIN_LEVEL are removed when compiling,
+ * the rest are compared to the lowest level of the sinks.
+ *
+ * @param[in] lvl level of the message
+ * @return true if the message should be formatted and sent to the sinks
+ */
+inline bool enabled(level lvl) {
+  return int(lvl) >= LDMX_LOG_MIN_LEVEL and lvl >= lowestLevel;
+}
+
 /**
  * Convert an integer to the severity level enum
  *
@@ -107,9 +141,11 @@ logger makeLogger(const std::string& name);
  * @param fileLevel minimum level to print to file log (everything above it is
  * also printed)
  * @param fileName name of file to print log to
+ * @param fileAsync write to the file from a separate thread, so the
+ * messages are only formatted and queued by the threads logging them
  */
 void open(const level termLevel, const level fileLevel,
-          const std::string& fileName);
+          const std::string& fileName, bool fileAsync = false);
 
 /**
  * Close up the logging
@@ -142,7 +178,16 @@ void close();
  *
  * Assumes to have access to a variable named theLog_ of type logger.
  * Input logging level (without namespace or enum).
+ *
+ * The level is checked before anything is streamed, so a message that
+ * won't be printed costs a comparison (or nothing if it is below
+ * LDMX_LOG_MIN_LEVEL). The check is a loop like BOOST_LOG_SEV so that
+ * the macro can be used as the body of an if without braces.
  */
-#define ldmx_log(lvl) BOOST_LOG_SEV(theLog_, ::framework::logging::level::lvl)
+#define ldmx_log(lvl)                                                       \
+  for (bool ldmx_log_enabled_ =                                             \
+           ::framework::logging::enabled(::framework::logging::level::lvl); \
+       ldmx_log_enabled_; ldmx_log_enabled_ = false)                        \
+  BOOST_LOG_SEV(theLog_, ::framework::logging::level::lvl)
 
 #endif  // FRAMEWORK_LOGGER_H
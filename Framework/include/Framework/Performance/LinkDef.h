@@ -10,5 +10,6 @@
 #pragma link C++ namespace framework::performance;
 
 #pragma link C++ class framework::performance::Timer + ;
+#pragma link C++ class framework::performance::Usage + ;
 
 #endif
@@ -0,0 +1,154 @@
+#ifndef FRAMEWORK_PERFORMANCE_PROFILE
+#define FRAMEWORK_PERFORMANCE_PROFILE
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+
+namespace framework::performance {
+
+class Trace;
+
+/**
+ * Time the stages inside of processors
+ *
+ * The Tracker times the callbacks of the processors as a whole. The stages
+ * inside of them are timed by placing a scope in the code,
+ * ```cpp
+ * void EcalVetoProcessor::produce(framework::Event &event) {
+ *   ...
+ *   {
+ *     LDMX_PROFILE_SCOPE("EcalVeto::mip_tracking");
+ *     ...
+ *   }
+ * }
+ * ```
+ * which is timed from where it is placed to the end of the enclosing block.
+ *
+ * Each place (site) is registered once, the first time it is reached. While
+ * profiling is disabled, a scope costs a single relaxed load of an atomic
+ * flag. While it is enabled, the time of a scope is recorded into a buffer
+ * of the calling thread, so recording takes no lock. The Tracker enables
+ * the profiling and collects the buffers: the number of calls and the total
+ * and largest time of each site are written with the other performance
+ * data and, if the Tracker is writing a trace, each call is written to the
+ * trace as a complete ("X") event in the "profile" category.
+ *
+ * Building with the ENABLE_PROFILE_SCOPES CMake option OFF defines
+ * LDMX_PROFILE_DISABLED and the scopes compile to nothing.
+ */
+class Profile {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /// Time spent at a site, summed over the threads
+  struct Stat {
+    /// number of times the site was timed
+    long int calls{0};
+    /// time summed over the calls [ms]
+    double total{0.};
+    /// longest call [ms]
+    double max{0.};
+  };
+
+  /**
+   * Register a site
+   *
+   * @param[in] name name of the site, it can be shared by several sites
+   * @return index of the site given to the scopes timing it
+   */
+  static int site(const std::string &name);
+
+  /// @return true if the scopes are recording
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * Start or stop recording
+   *
+   * @param[in] on true to record the scopes from now on
+   */
+  static void enable(bool on) { enabled_.store(on, std::memory_order_relaxed); }
+
+  /**
+   * Record a call of a site in the buffer of the calling thread
+   *
+   * @param[in] site index of the site
+   * @param[in] start time the call started
+   * @param[in] end time the call ended
+   */
+  static void record(int site, Clock::time_point start, Clock::time_point end);
+
+  /**
+   * Set the trace the calls are written to
+   *
+   * Without a trace, only the statistics of the sites are kept.
+   *
+   * @param[in] trace trace to write the calls to, null for none
+   */
+  static void setTrace(Trace *trace);
+
+  /**
+   * Write the calls buffered by the calling thread to the trace
+   *
+   * The buffers are also written by their threads when they are full.
+   */
+  static void flush();
+
+  /**
+   * Write the calls buffered by all threads to the trace and sum the
+   * statistics of each site over the threads
+   *
+   * This may only be called when no other thread is recording.
+   *
+   * @return the statistics of the sites by name
+   */
+  static std::map<std::string, Stat> collect();
+
+  /// Time a site from construction to destruction, if enabled
+  class Scope {
+   public:
+    Scope(int site) : site_{site}, active_{enabled()} {
+      if (active_) start_ = Clock::now();
+    }
+    ~Scope() {
+      if (active_) record(site_, start_, Clock::now());
+    }
+
+   private:
+    /// index of the site
+    int site_;
+    /// true if we are recording this call
+    bool active_;
+    /// time the call started
+    Clock::time_point start_;
+  };
+
+ private:
+  /// true if the scopes are recording
+  inline static std::atomic<bool> enabled_{false};
+};
+
+}  // namespace framework::performance
+
+#define LDMX_PROFILE_CONCAT_IMPL(a, b) a##b
+#define LDMX_PROFILE_CONCAT(a, b) LDMX_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef LDMX_PROFILE_DISABLED
+#define LDMX_PROFILE_SCOPE(name)
+#else
+/**
+ * Time from here to the end of the enclosing block under the input name
+ *
+ * @see framework::performance::Profile
+ */
+#define LDMX_PROFILE_SCOPE(name)                                           \
+  static const int LDMX_PROFILE_CONCAT(ldmx_profile_site_, __LINE__){      \
+      ::framework::performance::Profile::site(name)};                      \
+  const ::framework::performance::Profile::Scope LDMX_PROFILE_CONCAT(      \
+      ldmx_profile_scope_, __LINE__) {                                     \
+    LDMX_PROFILE_CONCAT(ldmx_profile_site_, __LINE__)                      \
+  }
+#endif
+
+#endif
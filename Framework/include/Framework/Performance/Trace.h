@@ -0,0 +1,124 @@
+#ifndef FRAMEWORK_PERFORMANCE_TRACE
+#define FRAMEWORK_PERFORMANCE_TRACE
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace framework::performance {
+
+/**
+ * Stream begin and end events to a file in the Chrome trace format
+ *
+ * The Tracker aggregates its measurements into ROOT objects, which hides
+ * the event-to-event variation. This writes every begin and end as it
+ * happens, so the timeline of a run can be inspected with the standard
+ * tools (e.g. https://ui.perfetto.dev or chrome://tracing).
+ *
+ * The file is a JSON array of "duration" events, along with a "complete"
+ * event (phase X, with its duration) for each call timed by the Profile.
+ * ```json
+ * [
+ * {"name":"EcalVeto","cat":"process","ph":"B","ts":1052.3,"pid":1,"tid":0},
+ * {"name":"EcalVeto","cat":"process","ph":"E","ts":1099.8,"pid":1,"tid":0},
+ * ...
+ * ]
+ * ```
+ * The time stamps are in microseconds since the trace was opened and the
+ * thread id is a small index given to each thread the first time it writes.
+ * Writing is guarded by a mutex so the trace can be shared between threads.
+ */
+class Trace {
+ public:
+  /**
+   * Open the trace file
+   *
+   * @throws Exception if the file cannot be opened for writing
+   *
+   * @param[in] filename path to the file to write (will be overwritten)
+   */
+  Trace(const std::string &filename);
+
+  /// Close the JSON array and the file
+  ~Trace();
+
+  /**
+   * Begin a duration
+   *
+   * @param[in] name name of the duration (e.g. the processor name)
+   * @param[in] category category of the duration (e.g. the callback)
+   */
+  void begin(const std::string &name, const std::string &category);
+
+  /**
+   * End a duration
+   *
+   * The name and category should match the ones given to begin.
+   *
+   * @param[in] name name of the duration
+   * @param[in] category category of the duration
+   */
+  void end(const std::string &name, const std::string &category);
+
+  /**
+   * Write a duration that has already ended as a complete ("X") event
+   *
+   * @param[in] name name of the duration
+   * @param[in] category category of the duration
+   * @param[in] start time the duration began
+   * @param[in] end time the duration ended
+   * @param[in] tid index of the thread the duration was on
+   */
+  void complete(const std::string &name, const std::string &category,
+                std::chrono::steady_clock::time_point start,
+                std::chrono::steady_clock::time_point end, int tid);
+
+  /// @return the small index of the calling thread used in the trace
+  static int threadIndex();
+
+  /**
+   * Begin a duration that ends when this object goes out of scope
+   *
+   * The trace pointer may be null, in which case nothing is recorded,
+   * so this can be placed in code that is only sometimes traced.
+   */
+  class Scope {
+   public:
+    Scope(Trace *trace, const std::string &name, const std::string &category)
+        : trace_{trace}, name_{name}, category_{category} {
+      if (trace_) trace_->begin(name_, category_);
+    }
+    ~Scope() {
+      if (trace_) trace_->end(name_, category_);
+    }
+
+   private:
+    /// trace we are writing to, may be null
+    Trace *trace_;
+    /// name of the duration
+    std::string name_;
+    /// category of the duration
+    std::string category_;
+  };
+
+ private:
+  /// write a single event with the input phase
+  void write(char phase, const std::string &name, const std::string &category);
+
+  /// write the name and category of an event under the lock
+  void writeNames(const std::string &name, const std::string &category);
+
+  /// the file we are writing
+  std::ofstream file_;
+  /// time stamps are relative to when the trace was opened
+  std::chrono::steady_clock::time_point origin_;
+  /// guard the file between threads
+  std::mutex mutex_;
+  /// true until the first event has been written (no leading comma)
+  bool first_{true};
+};
+
+}  // namespace framework::performance
+
+#endif
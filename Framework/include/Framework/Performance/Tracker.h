@@ -5,9 +5,15 @@
 #include <TTree.h>
 
 #include <map>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "Framework/Performance/Callback.h"
+#include "Framework/Performance/Profile.h"
 #include "Framework/Performance/Timer.h"
+#include "Framework/Performance/Trace.h"
+#include "Framework/Performance/Usage.h"
 
 namespace framework::performance {
 
@@ -16,6 +22,8 @@ namespace framework::performance {
  * that can eventually be written into the output histogram file.
  *
  * @see Timer for the data format of timing measurements
+ * @see Usage for the data format of resource usage measurements
+ * @see Profile for the timing of stages inside of the processors
  */
 class Tracker {
  public:
@@ -24,8 +32,15 @@ class Tracker {
    *
    * @param[in] storage_directory directory in-which to write data when closing
    * @param[in] names sequence of processor names we will be tracking
+   * @param[in] track_usage measure the resource usage alongside the timing
+   * @param[in] trace_file path to a Chrome trace file to stream the begin
+   * and end of every measurement to, empty for no trace
+   * @param[in] profile_every record the Profile scopes in one of every this
+   * many events, never if not positive
    */
-  Tracker(TDirectory *storage_directory, const std::vector<std::string> &names);
+  Tracker(TDirectory *storage_directory, const std::vector<std::string> &names,
+          bool track_usage = false, const std::string &trace_file = "",
+          int profile_every = 0);
   /**
    * Close up tracking and write all of the data collected to the storage
    * directory
@@ -41,6 +56,24 @@ class Tracker {
   void stop(Callback cb, std::size_t i_proc);
   /// inform us that we finished an event (and whether it was completed or not)
   void end_event(bool completed);
+  /// get the trace we are writing to, null if we aren't tracing
+  Trace *trace() const { return trace_; }
+  /**
+   * add the in-memory size of each product after an event
+   *
+   * @param[in] sizes branch name and estimated size [bytes] of each product
+   */
+  void product_sizes(
+      const std::vector<std::pair<std::string, std::size_t>> &sizes);
+  /**
+   * add the bytes a product took up in an output file
+   *
+   * @param[in] branch name of the branch of the product
+   * @param[in] tot_bytes uncompressed size of the branch [bytes]
+   * @param[in] zip_bytes compressed size of the branch [bytes]
+   */
+  void product_storage(const std::string &branch, long int tot_bytes,
+                       long int zip_bytes);
 
  private:
   /**
@@ -59,6 +92,10 @@ class Tracker {
 
   /// timer from the first line of Process::run to the last line
   Timer absolute_;
+  /// true if we are measuring resource usage as well as time
+  bool track_usage_;
+  /// resource usage from the first line of Process::run to the last line
+  Usage absolute_usage_;
   /**
    * a timer for each processor in the sequence and each callback
    *
@@ -70,8 +107,36 @@ class Tracker {
    * set in the constructor and then it should not be changed.
    */
   std::vector<std::vector<Timer>> processor_timers_;
+  /**
+   * resource usage for each processor in the sequence and each callback
+   *
+   * Only filled if track_usage_ is true. The same memory location
+   * rules as processor_timers_ apply.
+   */
+  std::vector<std::vector<Usage>> processor_usage_;
   /// names of the processors in the sequence for serialization
   std::vector<std::string> names_;
+  /// names of the callbacks so we don't remake them for each trace event
+  std::vector<std::string> callback_names_;
+  /// trace of the begin and end of every measurement, owned by us
+  Trace *trace_{nullptr};
+  /// record the Profile scopes in one of every this many events
+  int profile_every_;
+  /// number of events started
+  long int n_events_{0};
+  /// sizes of one product summed over the events and output files
+  struct ProductSize {
+    /// number of events the in-memory size was added for
+    long int events{0};
+    /// sum of the in-memory sizes [bytes]
+    double memory{0.};
+    /// largest in-memory size [bytes]
+    long int max_memory{0};
+    /// uncompressed and compressed sizes in the output files [bytes]
+    long int tot_bytes{0}, zip_bytes{0};
+  };
+  /// sizes of the products by branch name, written as the products tree
+  std::map<std::string, ProductSize> products_;
 };
 }  // namespace framework::performance
 
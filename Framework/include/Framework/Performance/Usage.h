@@ -0,0 +1,101 @@
+#ifndef FRAMEWORK_PERFORMANCE_USAGE
+#define FRAMEWORK_PERFORMANCE_USAGE
+
+#include <string>
+
+#include "TDirectory.h"
+#include "TObject.h"
+
+namespace framework::performance {
+
+/**
+ * Measure the resources used by a specific operation and serialize
+ * the result with ROOT
+ *
+ * This is the companion of Timer for the resources other than wall-clock
+ * time. Between start and stop we measure
+ * - the CPU time used by the calling thread
+ * - the change in the resident set size (RSS) of the program
+ * - the number of allocations made (and the bytes they requested) through
+ *   operator new by the calling thread
+ * - the hardware counters for retired instructions, cache misses and branch
+ *   misses of the calling thread, if ldmx-sw was built with
+ *   `ENABLE_PERF_COUNTERS` and the kernel allows us to open them
+ *   (see `/proc/sys/kernel/perf_event_paranoid`)
+ *
+ * Like Timer, the values at the start are marked as "transient" with `//!`
+ * so only the differences end up being written to disk. Any measurement
+ * that is not available is left at -1.
+ *
+ * @note The allocations are counted by replacing the global operator new
+ * in the Framework_Performance library, so allocations made directly with
+ * malloc (e.g. by C libraries) are not included.
+ */
+class Usage {
+  /// CPU time used by this thread at start [ns]
+  long int begin_cpu_ns_{0};  //! not serialized, just for measurement
+  /// resident set size at start [kB]
+  long int begin_rss_kb_{0};  //! not serialized, just for measurement
+  /// number of allocations made by this thread at start
+  long int begin_allocs_{0};  //! not serialized, just for measurement
+  /// bytes allocated by this thread at start
+  long int begin_alloc_bytes_{0};  //! not serialized, just for measurement
+  /// hardware counter values at start
+  long int begin_counters_[3] = {0, 0, 0};  //! not serialized
+
+  /**
+   * CPU time used by the thread during the measurement in seconds
+   *
+   * Set to -1 if the measurement was not ended
+   */
+  double cpu_time_{-1};
+
+  /**
+   * Change in resident set size of the program in kilobytes
+   *
+   * This can be negative if memory was given back to the system.
+   */
+  long int rss_delta_{0};
+
+  /// Number of calls to operator new made by the thread, -1 if not ended
+  long int n_allocs_{-1};
+
+  /// Bytes requested from operator new by the thread, -1 if not ended
+  long int alloc_bytes_{-1};
+
+  /// Retired instructions, -1 if the hardware counters are not available
+  long int instructions_{-1};
+
+  /// Cache misses, -1 if the hardware counters are not available
+  long int cache_misses_{-1};
+
+  /// Branch misses, -1 if the hardware counters are not available
+  long int branch_misses_{-1};
+
+ public:
+  /// create a measurement but don't start it yet
+  Usage() = default;
+  /// reset to un-started state
+  void reset();
+  /// start measuring
+  void start();
+  /// stop measuring
+  void stop();
+  /// retrieve the CPU time in seconds
+  double cpu_time() const;
+  /// retrieve the number of allocations
+  long int allocations() const;
+  /// get the resident set size of the program in kilobytes, 0 if unknown
+  static long int residentMemory();
+  /**
+   * Write ourselves under the input name to the input location
+   *
+   * @see Timer::write
+   */
+  void write(TDirectory* location, const std::string& name) const;
+  ClassDef(Usage, 1);
+};
+
+}  // namespace framework::performance
+
+#endif
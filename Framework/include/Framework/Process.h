@@ -16,6 +16,9 @@
 #include "Framework/StorageControl.h"
 
 // STL
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <map>
 #include <memory>
 #include <vector>
@@ -26,8 +29,11 @@ class TDirectory;
 namespace framework {
 
 class EventProcessor;
+class Producer;
+class Analyzer;
 class EventFile;
 class Event;
+struct ProductAccesses;
 
 /**
  * @class Process
@@ -64,8 +70,11 @@ class Process {
 
   /**
    * Get the pointer to the current event header, if defined
+   *
+   * When called from within a worker slot of a multi-threaded process,
+   * this is the header of the event that slot is processing.
    */
-  const ldmx::EventHeader *getEventHeader() const { return eventHeader_; }
+  const ldmx::EventHeader *getEventHeader() const;
 
   /**
    * Get the pointer to the current run header, if defined
@@ -83,11 +92,55 @@ class Process {
    */
   int getLogFrequency() const { return logFrequency_; }
 
+  /**
+   * Get the memory budget of the job
+   * @return budget for the resident memory [kB], 0 if there is none
+   */
+  long int getMemoryBudget() const { return memoryBudget_; }
+
+  /**
+   * Get the fraction of the memory budget that is still free
+   *
+   * Processors holding caches (e.g. a pool of pileup events) can check
+   * this to keep them smaller when the job is short of memory. The
+   * resident memory is measured on each call.
+   *
+   * @return one minus the resident memory over the budget (negative if
+   * the budget is exceeded), 1 if there is no budget
+   */
+  double getMemoryHeadroom() const;
+
   /**
    * Run the process.
    */
   void run();
 
+  /**
+   * Serve jobs put into a spool directory until it has a file named 'stop'
+   *
+   * The processors are started once and every job is processed with them,
+   * so the configuration, the libraries, the conditions and the geometry
+   * are only loaded once for all of the jobs. A job is a file ending in
+   * '.job' with one setting per line:
+   * ```
+   * input /path/to/input.root
+   * output /path/to/output.root
+   * run 42
+   * maxEvents 100
+   * ```
+   * The input and output lines can be repeated and are used like the
+   * inputFiles and outputFiles of the configuration, which are used if a
+   * job gives neither. The run and maxEvents default to the configured ones.
+   *
+   * The jobs are claimed in the order of their names by renaming them to
+   * '.running', so several servers can share a directory, and renamed to
+   * '.done' or '.failed' when they are finished. The histograms of all of
+   * the jobs go into the configured histogram file.
+   *
+   * @param[in] spool directory to take the jobs from
+   */
+  void serve(const std::string &spool);
+
   /**
    * Request that the processing finish with this event
    */
@@ -105,8 +158,34 @@ class Process {
 
   /**
    * Access the storage control unit for this process
+   *
+   * When called from within a worker slot of a multi-threaded process,
+   * this is the storage control unit of that slot.
    */
-  StorageControl &getStorageController() { return storageController_; }
+  StorageControl &getStorageController();
+
+  /**
+   * Access the storage control unit of the input event
+   *
+   * This is for the producers processing a batch of events, each event
+   * of the batch has its own storage control unit.
+   *
+   * @param[in] event one of the events being processed
+   * @return storage control unit for that event, the one of the calling
+   * thread if the event is not part of a batch
+   */
+  StorageControl &getStorageController(const Event &event);
+
+  /**
+   * Get the index of the worker slot the calling thread is working for
+   *
+   * The primary slot (and single-threaded processing) has index zero,
+   * the copies of the processor sequence run by the other slots of a
+   * multi-threaded process have indices 1 through n_threads-1.
+   *
+   * @return index of current worker slot
+   */
+  std::size_t getSlotIndex() const;
 
   /**
    * Set the pointer to the current event header, used only for tests
@@ -145,6 +224,507 @@ class Process {
    */
   bool process(int n, Event &event) const;
 
+  /**
+   * Process the input event through the sequence with the processors
+   * that don't depend on each other running at the same time
+   *
+   * This is only used once the dependencies between the processors have
+   * been found (see buildSequenceGraph). A processor is started as soon
+   * as all of the processors it depends on are done, so the independent
+   * branches of the sequence (e.g. the reconstruction of the different
+   * subsystems) are spread over n_sequence_threads threads.
+   *
+   * If a processor aborts the event, the processors not started yet are
+   * skipped and we wait for the ones already running before returning.
+   *
+   * @param[in,out] event reference to event we are going to process
+   * @returns true if event was full processed (false if aborted)
+   */
+  bool processConcurrently(Event &event) const;
+
+  /**
+   * Find the dependencies between the processors of the sequence from
+   * the products they used so far
+   *
+   * Processor j depends on an earlier processor i if j reads a product
+   * that i adds, j adds a product that i reads or they both add the same
+   * product. A processor that searched the products with a pattern
+   * depends on (or is depended on by) every processor that adds anything.
+   * The products declared by the processors are included along with the
+   * ones recorded while processing.
+   */
+  void buildSequenceGraph() const;
+
+  /**
+   * Check that the declared collections of the sequence make sense
+   *
+   * A processor reading a collection that is only added by a later
+   * processor is warned about since it will either not find it or find
+   * the one from an earlier pass.
+   *
+   * @throws Exception if two processors declare the same output
+   */
+  void validateSequence() const;
+
+  /**
+   * Remove the producers whose outputs are not used
+   *
+   * Going from the end of the sequence, a producer is removed if it
+   * declared its outputs, they are all dropped from the output file (by
+   * the drop rules or because there is no output file), none of the
+   * remaining processors declared them as inputs, the skim rules are not
+   * listening to it and it has no histograms configured.
+   *
+   * @param[in,out] sequence configuration of the processors, kept in
+   * step with the processors of the sequence
+   */
+  void pruneSequence(std::vector<framework::config::Parameters> &sequence);
+
+  /**
+   * Hash the configuration of each producer and of what it depends on
+   *
+   * The hash of a producer covers its parameters, the configuration of
+   * the conditions (which includes the random seeds) and the hashes of
+   * the earlier producers that add the collections it declared as
+   * inputs. A product can only be reused if the hash of its producer
+   * is the same as when it was made, so changing a producer invalidates
+   * the products of all of the producers downstream of it as well.
+   *
+   * The hashes are written into the run header by newRun.
+   *
+   * @param[in] sequence configuration of the processors
+   */
+  void hashProducers(
+      const std::vector<framework::config::Parameters> &sequence);
+
+  /**
+   * Remove the producers whose products in the input files are still valid
+   *
+   * A producer is removed if the input files recorded the same hash for
+   * it (see hashProducers) in all of their runs. It must also have declared
+   * its outputs, not have histograms configured, and not be listened to
+   * by the skim rules or by an onlyIfPassed. Its products are then read
+   * from the input files like any other.
+   *
+   * A producer the input files have an outdated hash for is run again.
+   * Its old products are ignored if they are from a pass with the same
+   * name, so that the new ones replace them.
+   *
+   * @param[in,out] sequence configuration of the processors, kept in
+   * step with the processors of the sequence
+   */
+  void reuseProducts(std::vector<framework::config::Parameters> &sequence);
+
+  /**
+   * Compile the sequence into the steps run on each event
+   *
+   * The type of each processor is resolved once here instead of on every
+   * event and the conditions of the processors (onlyIfPassed, onlyOn and
+   * skimDependent) are turned into indices, so checking them on an event
+   * is a few comparisons and a processor that is skipped costs nothing
+   * else.
+   *
+   * A skim-dependent processor is skipped once the storage decision of
+   * the event is sure to be to drop it, i.e. there is a mustDrop hint or
+   * the hints drop it and none of the processors after it are listened to.
+   *
+   * @param[in] sequence configuration of the processors
+   * @throws Exception if a processor is only run if a processor that
+   * isn't before it passed or if onlyOn isn't 'data', 'sim' or empty
+   */
+  void compileSequence(
+      const std::vector<framework::config::Parameters> &sequence);
+
+  /**
+   * Conditions on the events a processor of the sequence is run on
+   */
+  struct RunCondition {
+    /// indices in the sequence of the processors that need to keep the event
+    std::vector<std::size_t> after;
+    /// the same processors among the ones watched by the storage controller
+    std::vector<std::size_t> watched;
+    /// 1 to only run on real data, 0 only on simulation and -1 on both
+    int realData{-1};
+    /// true if it is skipped on the events already sure to be dropped
+    bool skimDependent{false};
+    /// true if the storage controller listens to the hints of the processor
+    bool listened{false};
+    /// true if a processor after it may still hint to the storage controller
+    bool hintsAfter{false};
+
+    /// true if the processor is run on all of the events
+    bool always() const {
+      return after.empty() and realData < 0 and not skimDependent;
+    }
+
+    /**
+     * Check if the processor is run on an event
+     *
+     * @param[in] event the event
+     * @param[in] storage storage controller with the hints of the event
+     * @returns true if the processor should be run
+     */
+    bool accepts(const Event &event, const StorageControl &storage) const;
+  };
+
+  /**
+   * A processor of the compiled sequence
+   */
+  struct Step {
+    /// the processor as a producer, null if it is an analyzer
+    Producer *producer{nullptr};
+    /// the processor as an analyzer, null if it is a producer
+    Analyzer *analyzer{nullptr};
+    /// conditions on the events it is run on, null if it is always run
+    const RunCondition *condition{nullptr};
+  };
+
+  /**
+   * Run a processor of the sequence on an event if its conditions allow it
+   *
+   * @param[in] i_proc index of the processor in the sequence
+   * @param[in] module the processor (or its copy in a slot)
+   * @param[in,out] event the event
+   * @param[in] storage storage controller with the hints of the event
+   * @returns true if the processor was run
+   */
+  bool runProcessor(std::size_t i_proc, EventProcessor *module, Event &event,
+                    const StorageControl &storage) const;
+
+  /**
+   * Check if a collection added in this pass will not be saved
+   *
+   * @param[in] collectionName name of the collection
+   * @returns true if the collection is dropped from the output file
+   */
+  bool isDropped(const std::string &collectionName) const;
+
+  /**
+   * A worker slot for multi-threaded processing
+   *
+   * Each slot has its own event bus, storage controller and copy of the
+   * processor sequence so that the slots can process different events at
+   * the same time without sharing any per-event state. The primary slot
+   * (index zero) runs the sequence created by the Process itself, the
+   * other slots run copies created from the same configuration.
+   */
+  struct Slot {
+    /// index of this slot
+    std::size_t index{0};
+    /// event bus for this slot
+    Event *event{nullptr};
+    /// handle to the current input file read by this slot
+    EventFile *input{nullptr};
+    /// the processors this slot runs
+    std::vector<EventProcessor *> sequence;
+    /// true if the processors are a copy owned by this slot
+    bool ownsSequence{false};
+    /// storage controller for the events processed by this slot
+    StorageControl storageController;
+    /// number of tries this slot took on its last event
+    int tries{0};
+    /// true if the last event this slot processed was completed
+    bool completed{false};
+    /// true if the last event this slot processed should be stored
+    bool keep{false};
+  };
+
+  /**
+   * Process the event of a worker slot through the slot's copy
+   * of the sequence
+   *
+   * Performance tracking is not done since the tracker is shared.
+   *
+   * @param[in] n counter for number of events processed
+   * @param[in,out] slot worker slot whose event we are processing
+   * @returns true if event was full processed (false if aborted)
+   */
+  bool process(int n, Slot &slot) const;
+
+  /**
+   * Process the events of several slots together through the sequence
+   *
+   * The producers that declared they produce in batches are given all of
+   * the events that are not aborted yet at once. The processors in between
+   * them are run on one event at a time. The completed flag of each slot
+   * is set to whether its event was fully processed.
+   *
+   * Performance tracking is not done since the processors are working on
+   * several events at once.
+   *
+   * @param[in] batch slots holding the events to process
+   * @param[in] first_event number of events processed before this batch
+   */
+  void processBatch(const std::vector<Slot *> &batch, int first_event) const;
+
+  /**
+   * Run the input work on the first n_slots worker slots at the same time
+   *
+   * The slots are spread over the threads, with the primary slot run on
+   * the calling thread. With one slot per thread (multi-threading), each
+   * slot has its own thread and with one thread (batching), the slots are
+   * all run one after another on the calling thread. We wait for all of
+   * the slots to finish before returning and then re-throw the first
+   * exception a slot threw (if any).
+   *
+   * @param[in] n_slots number of slots to run
+   * @param[in] work function doing the work for one slot
+   */
+  void runInSlots(std::size_t n_slots,
+                  const std::function<void(Slot &)> &work) const;
+
+  /**
+   * Call the input function on each of the processors in the copies of
+   * the sequence held by the worker slots other than the primary one
+   *
+   * This is done serially on the calling thread while pretending to
+   * be the slot owning the processor.
+   *
+   * @param[in] callback function to call for each processor
+   */
+  void forEachCopy(const std::function<void(EventProcessor *)> &callback) const;
+
+  /**
+   * Produce events with the worker slots until the event limit is reached
+   *
+   * The events are handed out to the slots in order and then copied into
+   * the event bus attached to the output file in order after each slot
+   * is done with its event.
+   *
+   * @param[in] outFile output file to write events to
+   * @param[in] theEvent event bus attached to the output file
+   * @param[in] event_limit number of events to produce
+   * @param[in,out] n_events_processed counter of events processed
+   * @return total number of tries taken to produce the events
+   */
+  int produceInSlots(EventFile &outFile, Event &theEvent, int event_limit,
+                     int &n_events_processed);
+
+  /**
+   * Process the events of the input file using the worker slots
+   *
+   * Each slot reads its events from its own handle to the input file.
+   * If there is output, the master file follows along with the entries
+   * handed out so the products of each slot can be copied into its event
+   * bus in order.
+   *
+   * With a schedule window, the entries of each window are handed out
+   * costliest first to whichever slot is free, the cost being estimated
+   * from the size of the costBranches of the entry. The products of the
+   * kept events wait in an event bus of their own until they are copied
+   * to the master file in order.
+   *
+   * @param[in] filename name of input file
+   * @param[in] masterFile file whose event bus is theEvent
+   * @param[in] writeOutput true if the master file is an output file
+   * @param[in] theEvent event bus attached to the master file
+   * @param[in,out] n_events_processed counter of events processed
+   * @param[in,out] wasRun the run number of the previous event
+   */
+  void processFileInSlots(const std::string &filename, EventFile &masterFile,
+                          bool writeOutput, Event &theEvent,
+                          int &n_events_processed, int &wasRun);
+
+  /**
+   * Merge the histograms created by the copies of the processors
+   * in the other worker slots into the ones created by the primary slot
+   */
+  void mergeSlotHistograms();
+
+  /**
+   * Write a snapshot of the histograms if one is due
+   *
+   * The snapshot is a copy of the histograms so far, with the ones of the
+   * other worker slots merged in, written to the snapshot file while the
+   * job keeps running. This is only called between events when no thread
+   * is filling histograms.
+   *
+   * @param[in] n_events_processed number of events processed so far
+   */
+  void snapshotHistograms(int n_events_processed);
+
+  /**
+   * Check the resident memory against the budget after an event
+   *
+   * Each time the memory is over the budget and has grown by another 10%,
+   * the read caches of the input files are halved and the largest objects
+   * on the event bus are listed in the memory dump file (or the log).
+   *
+   * @param[in] event event bus to list the objects of
+   * @param[in] input input file being read, if there is one
+   */
+  void checkMemory(const Event &event, EventFile *input);
+
+  /**
+   * Add the size of each branch of an output file to the product sizes
+   *
+   * Only done if the product sizes are logged along with the performance.
+   *
+   * @param[in] file output file that is about to be closed
+   */
+  void recordProductStorage(EventFile &file) const;
+
+  /**
+   * Hand the histograms to the aggregator
+   *
+   * The histograms are written to a new file (a chunk) in the aggregation
+   * directory once the processing is done, where dqm-aggregate merges them
+   * with the chunks of the other jobs as they come in.
+   */
+  void writeHistogramChunk();
+
+  /**
+   * Write a copy of the histograms with the ones of the other worker slots
+   * merged in
+   *
+   * The copy is written to a temporary file and then moved to the given
+   * name, so it appears all at once.
+   *
+   * @param[in] filename name of the file to write the copy to
+   * @return true if the copy was written
+   */
+  bool writeHistogramCopy(const std::string &filename);
+
+  /**
+   * Fork the workers that process the input files in parallel
+   *
+   * Each worker is a copy of this process, made after the processors are
+   * created and configured, so the start up is only paid once. The workers
+   * take the next unprocessed input file from a queue they all share, which
+   * spreads the files over the workers as they finish them. Each worker
+   * writes the output files of its input files and its own histogram file.
+   *
+   * The workers return true and carry on with the rest of run. The parent
+   * waits for all of them, merges their histogram files into the configured
+   * one (including the ntuples), and returns false.
+   *
+   * @throws Exception if a worker could not be started or failed
+   *
+   * @return true in the workers, false in the parent
+   */
+  bool forkFileWorkers();
+
+  /**
+   * Where the processing was when a checkpoint was written
+   *
+   * The checkpoint file is text, one setting per line, followed by the
+   * state of each processor that saved one as its name, its size in
+   * bytes and the bytes on the next line.
+   */
+  struct Checkpoint {
+    /// number of events processed
+    int events{0};
+    /// number of tries so far when generating events
+    int tries{0};
+    /// index of the input file being read, -1 when generating events
+    int file{-1};
+    /// position of the next entry to process in the input file
+    long long entry{0};
+    /// output file being written, empty if there is none
+    std::string output;
+    /// number of parts of the output file set aside so far
+    int outputParts{0};
+    /// number of parts of the histogram file set aside so far
+    int histogramParts{0};
+    /// state saved by each processor, by processor name
+    std::map<std::string, std::string> states;
+  };
+
+  /**
+   * Write a checkpoint if one is due
+   *
+   * The events written to the output file, the histograms and the ntuples
+   * are flushed to their files and the position in the input (or the
+   * number of events generated) is written to the checkpoint file with the
+   * state the processors save in onCheckpoint. This is only called between
+   * events, when the processing is sequential.
+   *
+   * @param[in] outFile output file being written, null if there is none
+   * @param[in] n_events_processed number of events processed so far
+   * @param[in] totalTries number of tries so far when generating events
+   * @param[in] i_file index of the input file, -1 when generating events
+   * @param[in] entry position of the next entry to process in the input file
+   */
+  void checkpoint(EventFile *outFile, int n_events_processed, int totalTries,
+                  int i_file, long long entry);
+
+  /**
+   * Write a checkpoint to the checkpoint file
+   *
+   * The checkpoint is written next to the file and moved over it once it
+   * is complete, so the job is never resumed from half of a checkpoint.
+   *
+   * @param[in] state the checkpoint to write
+   */
+  void writeCheckpoint(const Checkpoint &state) const;
+
+  /**
+   * Read the checkpoint to resume from and set the files aside
+   *
+   * The output and histogram files that were being written when the job
+   * was stopped are renamed to parts, which only hold what was saved at
+   * the last checkpoint. The processing carries on in new files which are
+   * merged with the parts once they are complete.
+   */
+  void prepareResume();
+
+  /**
+   * Merge the parts of a file set aside when resuming into the file
+   *
+   * @param[in] filename name of the file
+   * @param[in] n_parts number of parts set aside
+   * @return true if the parts were merged (or there were none)
+   */
+  bool mergeParts(const std::string &filename, int n_parts) const;
+
+  /**
+   * Get the index of the next input file to process
+   *
+   * @param[in] i_file index of the input file just processed (-1 to start)
+   * @return index of the next input file, past the end if there are none
+   */
+  int nextInputFile(int i_file) const;
+
+  /**
+   * Get the event bus ready and start the conditions and the processors
+   *
+   * @param[in] theEvent event bus of this process
+   */
+  void startProcessing(Event &theEvent);
+
+  /**
+   * Process the input files (or produce the events) into the output files
+   *
+   * @param[in] theEvent event bus of this process
+   */
+  void processFiles(Event &theEvent);
+
+  /**
+   * Run onProcessEnd of the processors and write their histograms
+   */
+  void endProcessing();
+
+  /**
+   * Run onProcessStart of the conditions and the processors
+   *
+   * The conditions are always started first. With `parallelStart`, the
+   * processors that declared an independent start are started on their
+   * own threads while the others are started in sequence order on this
+   * thread. The time each processor spent in configure and onProcessStart
+   * is reported at the info level once they are all started.
+   *
+   * @throws Exception if any of the processors fails to start
+   */
+  void startProcessors();
+
+  /**
+   * Create a processor from its configuration
+   *
+   * @param[in] proc configuration of the processor
+   * @return pointer to the new processor
+   */
+  EventProcessor *createProcessor(framework::config::Parameters proc);
+
   /**
    * Run through the processors and let them know
    * that we are starting a new run.
@@ -190,6 +770,9 @@ class Process {
   /** Name of file to print logging to */
   std::string logFileName_;
 
+  /** Write the log file from a separate thread */
+  bool logFileAsync_{false};
+
   /** Maximum number of attempts to make before giving up on an event */
   int maxTries_;
 
@@ -199,6 +782,22 @@ class Process {
   /** Ordered list of EventProcessors to execute. */
   std::vector<EventProcessor *> sequence_;
 
+  /**
+   * Worker slots for multi-threaded processing
+   *
+   * Empty if we are only using one thread.
+   */
+  std::vector<Slot *> slots_;
+
+  /**
+   * The worker slot the calling thread is working for
+   *
+   * This is only set while a thread is doing work for a slot so that
+   * the calls from processors routed through the Process (storage hints,
+   * conditions, histogram directories) end up using the state of that slot.
+   */
+  static thread_local Slot *currentSlot_;
+
   /** Set of ConditionsProviders */
   Conditions conditions_;
 
@@ -227,6 +826,24 @@ class Process {
   /** Filename for histograms and other user products */
   std::string histoFilename_;
 
+  /** Filename for snapshots of the histograms, none are written if empty */
+  std::string histoSnapshotFilename_;
+
+  /** Number of events between snapshots of the histograms, 0 for none */
+  int histoSnapshotEvents_{0};
+
+  /** Number of seconds between snapshots of the histograms, 0 for none */
+  int histoSnapshotSeconds_{0};
+
+  /** Directory to hand the histograms to the aggregator in, none if empty */
+  std::string histoAggregationDir_;
+
+  /** Number of events processed when the last snapshot was written */
+  int lastHistoSnapshotEvents_{0};
+
+  /** When the last snapshot of the histograms was written */
+  std::chrono::steady_clock::time_point lastHistoSnapshot_;
+
   /** Pointer to the current EventHeader, used for Conditions information */
   const ldmx::EventHeader *eventHeader_{0};
 
@@ -239,6 +856,96 @@ class Process {
   /** class with calls backs to track performance measurements of software */
   performance::Tracker *performance_{0};
 
+  /** File to write the checkpoints to, none are written if empty */
+  std::string checkpointFilename_;
+
+  /** Number of events between checkpoints */
+  int checkpointEvents_{0};
+
+  /** Number of events processed when the last checkpoint was written */
+  int lastCheckpointEvents_{0};
+
+  /** The checkpoint the job was resumed from */
+  Checkpoint resumeFrom_;
+
+  /** Number of parts of the output file set aside when resuming */
+  int outputParts_{0};
+
+  /** Number of parts of the histogram file set aside when resuming */
+  int histogramParts_{0};
+
+  /** States of the processors to restore at the start of the first run */
+  std::map<std::string, std::string> resumeStates_;
+
+  /** Number of worker processes to spread the input files over */
+  int nFileWorkers_{1};
+
+  /** Index of the next input file to process, shared by the file workers */
+  std::atomic<int> *fileQueue_{nullptr};
+
+  /** Start opening the next input file while the current one is processed */
+  bool asyncOpen_{false};
+
+  /** Number of read calls made on the input files so far */
+  long long inputReadCalls_{0};
+
+  /** Number of bytes read from the input files so far */
+  long long inputBytesRead_{0};
+
+  /** Process the events in batches held by the slots */
+  bool batching_{false};
+
+  /** Number of threads the work of the slots is spread over */
+  std::size_t nThreads_{1};
+
+  /** Log the in-memory and stored size of each product */
+  bool logProductSizes_{false};
+
+  /** Budget for the resident memory of the job [kB], 0 for none */
+  long int memoryBudget_{0};
+
+  /** Resident memory when the budget was last found exceeded [kB] */
+  long int memoryExceeded_{0};
+
+  /** File to list the largest event objects in when over budget */
+  std::string memoryDumpFile_;
+
+  /** Number of input entries handed out to the slots by cost, 0 for off */
+  int scheduleWindow_{0};
+
+  /** Input branches whose size is the estimated cost of an entry */
+  std::vector<std::string> costBranches_;
+
+  /** Start the processors that declared it on their own threads */
+  bool parallelStart_{false};
+
+  /** Number of threads to spread the independent processors over */
+  int nSequenceThreads_{1};
+
+  /** Products used by each processor of the sequence, while recording */
+  mutable std::vector<ProductAccesses> accesses_;
+
+  /** Number of processors each processor of the sequence waits for */
+  mutable std::vector<std::size_t> waitsFor_;
+
+  /** Processors waiting for each processor of the sequence */
+  mutable std::vector<std::vector<std::size_t>> dependents_;
+
+  /** True once the dependencies between the processors are known */
+  mutable bool sequenceGraphBuilt_{false};
+
+  /** Wall-clock time spent configuring each processor [s] */
+  std::vector<double> configureTimes_;
+
+  /** Hash of the configuration of each producer by name, in hex */
+  std::map<std::string, std::string> productHashes_;
+
+  /** Conditions on the events each processor of the sequence is run on */
+  std::vector<RunCondition> runConditions_;
+
+  /** The sequence compiled into the steps run on each event */
+  std::vector<Step> steps_;
+
   /// Turn on logging for our process
   enableLogging("Process");
 };
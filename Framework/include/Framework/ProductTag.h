@@ -11,6 +11,8 @@
 #include <ostream>
 
 // STL
+#include <cstddef>
+#include <limits>
 #include <string>
 
 namespace framework {
@@ -19,6 +21,9 @@ namespace framework {
  * @class ProductTag
  * @brief Defines the identity of a product and can be used for searches
  *
+ * The names are interned: they are kept once for the whole program and
+ * the tags only point to them, so copying a tag (e.g. into the results
+ * of a search) doesn't copy any string.
  */
 class ProductTag {
  public:
@@ -34,38 +39,90 @@ class ProductTag {
    */
   ProductTag(const std::string& name, const std::string& pass,
              const std::string& type)
-      : name_{name}, passname_{pass}, typename_{type} {}
+      : name_{&intern(name)},
+        passname_{&intern(pass)},
+        typename_{&intern(type)} {}
 
   /**
    * Get the product name
    */
-  const std::string& name() const { return name_; }
+  const std::string& name() const { return *name_; }
 
   /**
    * Get the product pass name
    */
-  const std::string& passname() const { return passname_; }
+  const std::string& passname() const { return *passname_; }
 
   /**
    * Get the product type name
    */
-  const std::string& type() const { return typename_; }
+  const std::string& type() const { return *typename_; }
 
  private:
+  /**
+   * Get the copy of a string kept for the whole program
+   *
+   * The interned strings are never removed, so the references stay valid.
+   *
+   * @param[in] str string to intern
+   * @return reference to the interned copy
+   */
+  static const std::string& intern(const std::string& str);
+
   /**
    * Name given to the product
    */
-  std::string name_;
+  const std::string* name_;
 
   /**
    * Passname given when product was written
    */
-  std::string passname_;
+  const std::string* passname_;
 
   /**
    * Typename of the product
    */
-  std::string typename_;
+  const std::string* typename_;
+};
+
+/**
+ * @class ProductHandle
+ * @brief Integer handle to a product name and pass interned by the Event
+ *
+ * @see Event::getHandle for how to get one of these
+ */
+class ProductHandle {
+ public:
+  /**
+   * Default handle that doesn't refer to any product
+   */
+  ProductHandle() = default;
+
+  /**
+   * Check if this handle was made by Event::getHandle
+   */
+  bool valid() const {
+    return index_ != std::numeric_limits<std::size_t>::max();
+  }
+
+  /**
+   * Get the index of this handle in the table of interned products
+   */
+  std::size_t index() const { return index_; }
+
+ private:
+  /// only the Event can make valid handles
+  friend class Event;
+
+  /**
+   * Wrap an index into the table of interned products
+   */
+  explicit ProductHandle(std::size_t index) : index_{index} {}
+
+  /**
+   * Index into the table of interned products
+   */
+  std::size_t index_{std::numeric_limits<std::size_t>::max()};
 };
 
 }  // namespace framework
@@ -12,6 +12,12 @@
 /*~~~~~~~~~~~~~~~*/
 #include "Framework/ConditionsObject.h"
 #include "Framework/ConditionsObjectProvider.h"
+#include "Framework/RandomStream.h"
+
+/*~~~~~~~~~~~~~~~~*/
+/*   C++ StdLib   */
+/*~~~~~~~~~~~~~~~~*/
+#include <mutex>
 
 namespace framework {
 
@@ -73,11 +79,44 @@ class RandomNumberSeedService : public ConditionsObject,
    * it generates the seed for that name by combining
    * the master seed with a hash of the name.
    *
+   * When called from a worker slot other than the primary one
+   * in a multi-threaded process, the slot index is appended to
+   * the name so that the copies of a processor get distinct seeds.
+   *
    * @param[in] name Name of seed
    * @return seed derived from master seed using the input name
    */
   uint64_t getSeed(const std::string& name) const;
 
+  /**
+   * Get the random number stream of an event
+   *
+   * The stream is keyed by the master seed and the input name and
+   * counts from the run and event numbers, so it is the same whatever
+   * the order of the events and whichever worker slot processes them.
+   * Unlike getSeed, the slot is not part of the name.
+   *
+   * @see RandomStream
+   * @param[in] name Name of stream (e.g. the processor name)
+   * @param[in] run run number
+   * @param[in] event event number
+   * @return stream of the event
+   */
+  RandomStream getStream(const std::string& name, int run, int event) const {
+    return RandomStream(RandomStream::key(masterSeed_, name), run, event);
+  }
+
+  /**
+   * Get the random number stream of an event
+   *
+   * @see getStream
+   * @param[in] name Name of stream (e.g. the processor name)
+   * @param[in] header header of the event
+   * @return stream of the event
+   */
+  RandomStream getStream(const std::string& name,
+                         const ldmx::EventHeader& header) const;
+
   /**
    * Get a list of all the known seeds
    *
@@ -147,6 +186,9 @@ class RandomNumberSeedService : public ConditionsObject,
 
   /// cache of seeds by name
   mutable std::map<std::string, uint64_t> seeds_;
+
+  /// lock on the cache of seeds, shared by the worker slots of the process
+  mutable std::mutex seeds_mutex_;
 };
 
 }  // namespace framework
@@ -0,0 +1,161 @@
+/**
+ * @file RandomStream.h
+ * @brief Counter-based random number streams
+ */
+
+#ifndef FRAMEWORK_RANDOMSTREAM_H_
+#define FRAMEWORK_RANDOMSTREAM_H_
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace framework {
+
+/**
+ * @class RandomStream
+ * Stream of random numbers computed from a key and a counter
+ *
+ * The numbers are the output of the Philox4x32-10 generator (Salmon et al.,
+ * "Parallel random numbers: as easy as 1, 2, 3", SC11), which encrypts a
+ * 128-bit counter with a 64-bit key. There is no state other than the
+ * counter, so a stream for any (key, run, event) is made directly, without
+ * drawing through the streams of the events before it. An event gets the
+ * same random numbers whatever the order the events are processed in and
+ * whichever thread processes it.
+ *
+ * The counter holds the run and event numbers and the position in the
+ * stream, so the streams of different events never overlap.
+ *
+ * The stream is a UniformRandomBitGenerator, so it can be given to the
+ * distributions of the standard library.
+ * ```cpp
+ * auto stream{seeds.getStream("MyProcessor", event.getEventHeader())};
+ * std::normal_distribution<double> noise(0., 1.);
+ * double x{noise(stream)};
+ * ```
+ */
+class RandomStream {
+ public:
+  /// type of the numbers drawn
+  using result_type = uint32_t;
+
+  /// a block of the output of the generator
+  using Block = std::array<uint32_t, 4>;
+
+  /// the key of the generator
+  using Key = std::array<uint32_t, 2>;
+
+  /**
+   * Make the stream of an event
+   *
+   * @param[in] key key of the stream, e.g. from RandomStream::key
+   * @param[in] run run number
+   * @param[in] event event number
+   */
+  RandomStream(uint64_t key, int run, int event)
+      : key_{uint32_t(key), uint32_t(key >> 32)},
+        counter_{0, uint32_t(event), uint32_t(run), 0} {}
+
+  /**
+   * Make a key from the master seed and a name
+   *
+   * The name is hashed (FNV-1a) and mixed with the master seed (splitmix64)
+   * so that similar names and seeds give unrelated keys.
+   *
+   * @param[in] master_seed master seed of the process
+   * @param[in] name name of the stream, e.g. the processor name
+   * @return the key
+   */
+  static uint64_t key(uint64_t master_seed, const std::string& name) {
+    uint64_t hash{0xcbf29ce484222325ull};
+    for (unsigned char c : name) {
+      hash ^= c;
+      hash *= 0x100000001b3ull;
+    }
+    return mix(mix(master_seed) ^ hash);
+  }
+
+  /**
+   * The Philox4x32-10 generator
+   *
+   * @param[in] counter the counter to encrypt
+   * @param[in] key the key to encrypt with
+   * @return the encrypted counter
+   */
+  static Block philox(Block counter, Key key) {
+    for (int round{0}; round < 10; round++) {
+      if (round > 0) {
+        key[0] += 0x9E3779B9u;
+        key[1] += 0xBB67AE85u;
+      }
+      uint64_t p0{uint64_t(0xD2511F53u) * counter[0]};
+      uint64_t p1{uint64_t(0xCD9E8D57u) * counter[2]};
+      counter = {uint32_t(p1 >> 32) ^ counter[1] ^ key[0], uint32_t(p1),
+                 uint32_t(p0 >> 32) ^ counter[3] ^ key[1], uint32_t(p0)};
+    }
+    return counter;
+  }
+
+  /// smallest number drawn
+  static constexpr result_type min() { return 0; }
+
+  /// largest number drawn
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  /// draw the next number of the stream
+  result_type operator()() {
+    if (i_word_ == 4) next();
+    return block_[i_word_++];
+  }
+
+  /// draw a number uniformly distributed in (0,1) with 53 random bits
+  double uniform() {
+    uint64_t bits{(uint64_t((*this)()) << 32) | (*this)()};
+    return ((bits >> 11) + 0.5) * (1. / 9007199254740992.);
+  }
+
+  /// skip numbers of the stream
+  void discard(unsigned long long n) {
+    for (; n > 0 and i_word_ < 4; n--) i_word_++;
+    uint64_t position{(uint64_t(counter_[3]) << 32 | counter_[0]) + n / 4};
+    counter_[0] = uint32_t(position);
+    counter_[3] = uint32_t(position >> 32);
+    if (n % 4 != 0) {
+      next();
+      i_word_ = n % 4;
+    }
+  }
+
+ private:
+  /// splitmix64 finalizer
+  static uint64_t mix(uint64_t z) {
+    z += 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  }
+
+  /// compute the next block and move the position in the stream past it
+  void next() {
+    block_ = philox(counter_, key_);
+    if (++counter_[0] == 0) counter_[3]++;
+    i_word_ = 0;
+  }
+
+  /// the key of the stream
+  Key key_;
+  /// position in the stream (low and high words), event and run
+  Block counter_;
+  /// the current block of numbers
+  Block block_{};
+  /// the next number of the block to return, 4 when it is used up
+  unsigned int i_word_{4};
+};
+
+}  // namespace framework
+
+#endif  // FRAMEWORK_RANDOMSTREAM_H_
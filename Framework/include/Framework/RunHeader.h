@@ -9,6 +9,7 @@
 /*~~~~~~~~~~~~~~~~*/
 /*   C++ StdLib   */
 /*~~~~~~~~~~~~~~~~*/
+#include <cstdint>
 #include <map>
 #include <string>
 
@@ -50,6 +51,10 @@ namespace ldmx {
  * the user somehow gets into the situation of reading a v4 RunHeader with v3
  * software, the numTries_ member is quietly ignored, maintaining the format of
  * the v3 RunHeader in the resulting output file.
+ *
+ * ## v5
+ * Add the eventParameterNames_ member variable holding the names of the keys
+ * of the EventHeader parameters (v3 EventHeader) set in the run.
  */
 class RunHeader {
  public:
@@ -215,6 +220,20 @@ class RunHeader {
     stringParameters_[name] = value;
   }
 
+  /// Get the names of the keys of the EventHeader parameters
+  const std::map<uint32_t, std::string> &getEventParameterNames() const {
+    return eventParameterNames_;
+  }
+
+  /**
+   * Set the names of the keys of the EventHeader parameters
+   *
+   * @param names The names by key.
+   */
+  void setEventParameterNames(const std::map<uint32_t, std::string> &names) {
+    eventParameterNames_ = names;
+  }
+
   /**
    * Stream this object into the input ostream
    *
@@ -290,7 +309,10 @@ class RunHeader {
   /** Map of string parameters. */
   std::map<std::string, std::string> stringParameters_;
 
-  ClassDef(RunHeader, 4);
+  /** Names of the keys of the EventHeader parameters set in the run. */
+  std::map<uint32_t, std::string> eventParameterNames_;
+
+  ClassDef(RunHeader, 5);
 
 };  // RunHeader
 
@@ -9,6 +9,7 @@
 
 #include <regex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace framework {
@@ -61,6 +62,9 @@ class StorageControl {
    * ignore it by not adding it to our internal cache that will be used later
    * when deciding to keep the event.
    *
+   * The rules are only matched the first time a processor name and purpose
+   * are seen, after that the decision is looked up.
+   *
    * @param processor_name Name of the event processor
    * @param controlhint The storage control hint to apply for the given event
    * @param purposeString A purpose string which can be used in the skim control
@@ -99,7 +103,69 @@ class StorageControl {
    */
   bool keepEvent(bool event_completed) const;
 
+  /**
+   * Check if the current event is already sure to be dropped
+   *
+   * A mustDrop hint always drops the event. Otherwise, the event is only
+   * sure to be dropped if there can't be any more hints we listen to and
+   * the hints so far drop it.
+   *
+   * @param[in] more_hints true if processors we listen to may still hint
+   * @returns true if the event will be dropped whatever comes after
+   */
+  bool dropped(bool more_hints) const;
+
+  /**
+   * Check if the hints from the input processor could be listened to
+   *
+   * @param[in] processor_name name of the processor to check
+   * @returns true if one of the listening rules matches the processor name
+   */
+  bool listensTo(const std::string& processor_name) const;
+
+  /**
+   * Keep the last hint of a processor in each event, whether it is
+   * listened to or not, so the processors after it can be run only on
+   * the events it wants to keep
+   *
+   * @param[in] processor_name name of the processor
+   * @returns index of the processor among the ones watched
+   */
+  std::size_t watch(const std::string& processor_name);
+
+  /**
+   * Check if a watched processor hinted to keep the current event
+   *
+   * @param[in] watched index of the processor returned by watch
+   * @returns true if its last hint in the event was to keep it
+   */
+  bool kept(std::size_t watched) const {
+    return watchedHints_[watched] == Hint::ShouldKeep or
+           watchedHints_[watched] == Hint::MustKeep;
+  }
+
  private:
+  /**
+   * Decisions of the rules on the hints of a processor
+   */
+  struct Listening {
+    /// rules whose processor pattern matches the processor name
+    std::vector<std::size_t> rules;
+    /// whether a hint is listened to by its purpose string
+    std::unordered_map<std::string, bool> byPurpose;
+    /// index of the processor among the watched ones, negative if it isn't
+    int watched{-1};
+  };
+
+  /**
+   * Get the decisions on the hints of a processor, matching the
+   * processor patterns of the rules the first time it is asked for
+   *
+   * @param[in] processor_name name of the processor
+   * @returns the decisions on its hints
+   */
+  Listening& listening(const std::string& processor_name) const;
+
   /**
    * Default state for storage control
    */
@@ -125,6 +191,20 @@ class StorageControl {
    *    from all processors with a specific purpose
    */
   std::vector<std::pair<std::regex, std::regex>> rules_;
+
+  /**
+   * The decisions of the rules by processor name
+   *
+   * The rules are fixed once the process is configured, so the regex
+   * matching is only done once per processor and purpose.
+   */
+  mutable std::unordered_map<std::string, Listening> decisions_;
+
+  /// Index of the watched processors by name
+  std::unordered_map<std::string, std::size_t> watched_;
+
+  /// Last hint of each watched processor in the current event
+  std::vector<Hint> watchedHints_;
 };
 
 /**
@@ -18,6 +18,19 @@ Examples
         event.SimParticles # can ignore pass name if only one collection
     #loop over events
 
+Looping through the events materializes the C++ objects of every branch
+that is read, so it helps to only read the branches that are used.
+
+    event_tree = EventTree.EventTree('my_events.root', branches = ['EcalRecHits'])
+
+For quick analyses of flat quantities it is much faster to not loop in
+python at all and read the columns in bulk into numpy arrays, one chunk
+of events at a time. The columns are ROOT expressions of the branches,
+which can also leave out the pass name.
+
+    for chunk in event_tree.arrays(['EcalRecHits.energy_'], chunk_size = 10000) :
+        energies = chunk['EcalRecHits.energy_'] # one array per event
+
 """
 
 import ROOT
@@ -49,9 +62,15 @@ class EventTree :
     ----------
     event_file : str
         Full path to event file with events to load
+    branches : list of str, optional
+        Names of the branches to read when looping (pass optional if
+        only one branch), all of them if not given. The EventHeader is
+        always read.
 
     Attributes
     ----------
+    __file_name : str
+        path to the event file
     __file : ROOT.TFile
         loaded in, read-only file
     __tree : ROOT.TTree
@@ -64,7 +83,8 @@ class EventTree :
         Dictionary of short names to full branch names that are cached
     """
 
-    def __init__(self, event_file) :
+    def __init__(self, event_file, branches = None) :
+        self.__file_name = event_file
         self.__file = ROOT.TFile(event_file)
         self.__tree = self.__file.Get("LDMX_Events")
         self.__index = 0
@@ -72,6 +92,13 @@ class EventTree :
         self.__unclaimed_branches = [b.GetName() for b in self.__tree.GetListOfBranches()]
         self.__claimed_branches = { 'EventHeader' : 'EventHeader' }
 
+        if branches is not None :
+            # only the selected branches (and their sub-branches) are read
+            self.__tree.SetBranchStatus('*', 0)
+            self.__tree.SetBranchStatus('EventHeader*', 1)
+            for name in branches :
+                self.__tree.SetBranchStatus(self.__full_name(name)+'*', 1)
+
     def __iter__(self) :
         """The Tree is it's own iterator"""
         return self
@@ -85,9 +112,80 @@ class EventTree :
 
         raise StopIteration
 
-    def __getattr_claimed__(self, name) :
-        """Internal function for getting a branch without checking"""
-        return getattr(self.__tree, self.__claimed_branches[name])
+    def __len__(self) :
+        """Number of events in the tree"""
+        return self.__tree.GetEntries()
+
+    def arrays(self, columns, chunk_size = 100000, entry_start = 0, entry_stop = None) :
+        """Read columns of the events in bulk into numpy arrays
+
+        The columns are read with ROOT's RDataFrame, without going
+        through python for each event. Only the branches the columns
+        use are read. Each chunk is a dictionary of the input column
+        names to numpy arrays with one entry per event, the entries of
+        collections are arrays themselves.
+
+        Parameters
+        ----------
+        columns : list of str
+            ROOT expressions of the columns to read. They start with the
+            name of a branch (pass optional if only one branch), e.g.
+            'EcalRecHits.energy_' or 'EventHeader.eventNumber_'.
+        chunk_size : int
+            Number of events read into memory at once
+        entry_start : int
+            First event to read
+        entry_stop : int, optional
+            Event to stop reading before, the end of the tree if not given
+
+        Yields
+        ------
+        dict of str to numpy.ndarray
+            The columns of the events of one chunk
+        """
+
+        if entry_stop is None or entry_stop > len(self) :
+            entry_stop = len(self)
+
+        # replace the short branch names with the full ones
+        full_columns = {}
+        for column in columns :
+            branch, dot, rest = column.partition('.')
+            full_columns[column] = self.__full_name(branch) + dot + rest
+
+        for start in range(entry_start, entry_stop, chunk_size) :
+            # a data frame can only be run over a range once
+            frame = ROOT.RDataFrame('LDMX_Events', self.__file_name)
+            frame = frame.Range(start, min(start + chunk_size, entry_stop))
+            aliases = []
+            for i, full in enumerate(full_columns.values()) :
+                aliases.append(f'column_{i}')
+                frame = frame.Define(aliases[-1], full)
+            chunk = frame.AsNumpy(aliases)
+            yield { column : chunk[alias] for column, alias in zip(full_columns, aliases) }
+
+    def __full_name(self, name) :
+        """Get the full name of the branch the input name claims
+
+        See __getattr__ for how the names are matched.
+        """
+
+        if name in self.__claimed_branches :
+            return self.__claimed_branches[name]
+
+        found=False
+        for candidate in self.__unclaimed_branches :
+            if name in candidate:
+                if found :
+                    raise AttributeError(f'More than one branch matching \'{name}\'.')
+                found=True
+                self.__claimed_branches[name] = candidate
+
+        if found :
+            self.__unclaimed_branches.remove(self.__claimed_branches[name])
+            return self.__claimed_branches[name]
+        else :
+            raise AttributeError(f'No branch matching \'{name}\'.')
 
     def __getattr__(self, name) :
         """Get an event object
@@ -114,22 +212,6 @@ class EventTree :
             Name of branch (pass optional if only one branch)
         """
 
-        # check for cached name -> full name first
-        #   EventHeader is put into this dictionary in __init__
-        if name in self.__claimed_branches :
-            return self.__getattr_claimed__(name)
-
-        found=False
-        for candidate in self.__unclaimed_branches :
-            if name in candidate:
-                if found :
-                    raise AttributeError(f'More than one branch matching \'{name}\'.')
-                found=True
-                self.__claimed_branches[name] = candidate
-
-        if found :
-            self.__unclaimed_branches.remove(self.__claimed_branches[name])
-            return self.__getattr_claimed__(name)
-        else :
-            raise AttributeError(f'No branch matching \'{name}\'.')
+        # EventHeader is put into the claimed names in __init__
+        return getattr(self.__tree, self.__full_name(name))
 
@@ -27,6 +27,22 @@ class EventProcessor:
     ----------
     histograms : list of histogram1D objects
         List of histogram configure objects for the HistogramPool to make for this processor
+    inputs : list of str
+        Names of the collections this processor may read, added to the ones
+        the C++ class declares with declareInput
+    outputs : list of str
+        Names of the collections this processor may add, added to the ones
+        the C++ class declares with declareOutput
+    onlyIfPassed : list of str
+        Names of processors earlier in the sequence that all need to have hinted to
+        keep the event (e.g. a trigger) for this processor to be run on it
+    onlyOn : str
+        Only run this processor on 'data' or on 'sim' events, both if empty
+    skimDependent : bool
+        Skip this processor on the events that the skim rules of the Process are
+        already sure to drop, i.e. after a mustDrop hint or once the hints drop the
+        event and no processor after this one is listened to. Leave it off for the
+        analyzers that need to see every event.
 
     See Also
     --------
@@ -39,6 +55,11 @@ class EventProcessor:
         self.instanceName=instanceName
         self.className=className
         self.histograms=[]
+        self.inputs=[]
+        self.outputs=[]
+        self.onlyIfPassed=[]
+        self.onlyOn=''
+        self.skimDependent=False
 
         if moduleName.endswith('.so'):
             # assume user passed full path to library
@@ -425,6 +446,28 @@ class RandomNumberSeedService(ConditionsObjectProvider):
         """Set master random seed based off of time"""
         self.seedMode = 'time'
     
+class BranchSettings:
+    """Settings for the output branches with names matching a pattern
+
+    Parameters
+    ----------
+    pattern : str
+        Pattern for the branch names to match
+    compressionSetting : int
+        Compression settings (100*algorithm + level), negative for the settings of the file
+    basketSize : int
+        Size of the baskets in bytes, zero for the default
+
+    See Also
+    --------
+    Process.setBranchCompression
+    """
+
+    def __init__(self, pattern, compressionSetting=-1, basketSize=0):
+        self.pattern = pattern
+        self.compressionSetting = compressionSetting
+        self.basketSize = basketSize
+
 class Process:
     """Process configuration object
 
@@ -477,12 +520,186 @@ class Process:
         Minimum severity of log messages to print to file: 0 (debug) - 4 (fatal)
     logFileName : str
         File to print log messages to, won't setup file logging if this parameter is not set
+    logFileAsync : bool
+        Write the log file from a separate thread, so logging to it holds up the processing
+        less. Messages still queued when the job crashes are lost.
     conditionsGlobalTag : str
         Global tag for the current generation of conditions
     conditionsObjectProviders : list of ConditionsObjectProviders
         List of the sources of calibration and conditions information
     randomNumberSeedService : RandomNumberSeedService
         conditions object that provides random number seeds in a deterministic way
+    n_threads : int
+        Number of events to process at the same time.
+        Each thread gets its own event bus and copy of the processors in the sequence,
+        the conditions are shared between them. The histograms made by the copies are
+        merged at the end of processing, but processors keeping other results (e.g.
+        counters or ntuples) are better run with only one thread.
+        The Simulator can only be run with one thread.
+    scheduleWindow : int
+        Number of input entries the threads share at a time. The entries of a window
+        are handed out costliest first to whichever thread is free, so one slow event
+        only holds up the others at the end of the window rather than after every
+        n_threads events. The output is still written in input order, so the products
+        of the events wait in memory until the events before them are done.
+        0 hands out one entry per thread at a time. Only used with more than one thread.
+    memoryBudget : int
+        Budget for the resident memory of the job in MB, 0 for none. The memory is
+        checked after each event and each time it is over the budget by another 10%,
+        the read caches of the input files are halved and the largest objects on the
+        event bus are listed. Processors holding caches can ask for the headroom left
+        with getMemoryHeadroom (e.g. the OverlayProducer fills a smaller pool).
+    memoryDumpFile : str
+        File to list the largest objects on the event bus in when the memory is over
+        budget. They are printed as a warning if empty.
+    costBranches : list of str
+        Names of the input branches (e.g. 'EcalSimHits_sim') whose size in an entry is
+        used as the estimate of how costly the entry is to process. They are read
+        for the whole window before it is processed.
+    lazyBranches : bool
+        Only read the branches of the input files that are requested by the processors
+        (or that are copied to the output file). The rest of the branches are never
+        decompressed, which helps when the processors look at a few of many collections.
+    prefetchDepth : int
+        Number of entries of the input files to read and decompress ahead of time
+        in the background. The number of times the processing had to wait on the
+        read-ahead is printed when each input file is closed. Zero turns it off.
+    readCacheSize : int
+        Size of the read cache of each input file [MB], 0 for none unless prefetchDepth asks
+        for one (the larger of the two is used). The cache reads the baskets of the entries
+        ahead in few large reads, which matters most when the files are read remotely.
+        The number of read calls and bytes read is printed when each input file is closed
+        and for all of them at the end of the processing.
+    cacheLearnEntries : int
+        Number of entries the read cache watches to learn which branches are read,
+        0 for ROOT's default (100). With lazyBranches, each branch is also added to the
+        cache when it is first requested.
+    readaheadSize : int
+        Size of the read-ahead of the input files [MB] (for XRootD, the vector reads the
+        cache is filled with), 0 for ROOT's default.
+    asyncOpen : bool
+        Start opening the next input file while the current one is processed, so the
+        open of a remote file overlaps the processing. Not used with file workers.
+    fastSkim : bool
+        Only write the new products of each kept event during the processing and copy
+        the products that come unchanged from the input file for the kept events after
+        each input file is processed. The unchanged products are then never read for
+        the events that are skimmed away, which makes skims keeping a small fraction
+        of the events cheaper.
+    friendOutput : bool
+        Only write the event header and the new products of each event to the output
+        files, along with the name of the input file they were read from. When the
+        output file is read, the input file is joined back to it by run and event
+        number, so its products can be used as if they had been copied. Each output
+        file has a single input file, which needs to stay where it was (or next to
+        the output file if its name is relative).
+    branchSettings : list of BranchSettings
+        Compression and basket size of the output branches matching a pattern,
+        use setBranchCompression to add to this list
+    clusterSize : int
+        Number of events to write in each cluster of the output event tree (zero
+        for the ROOT default). A negative number is the number of bytes instead.
+    ntupleClusterSize : int
+        Number of entries the ntuples made with the NtupleManager write out together
+        (zero for the ROOT default). A negative number is the number of bytes instead.
+    outputBackend : str
+        How the events are stored in the output file: 'TTree' (default) or 'RNTuple'
+        RNTuple output is only supported when producing events (no input files) and
+        requires a version of ROOT where it is available (6.34 or newer). Input files
+        storing their events in a RNTuple are recognized automatically, but cannot
+        be written to an output event file.
+    eventIndex : bool
+        Write a small index of the stored events next to the event tree of the output
+        files, the 'LDMX_EventIndex' tree. Each of its rows has the entry of the event
+        in the event tree, its run, event number and weight and the EventHeader
+        parameters listed in eventIndexParameters.
+    eventIndexParameters : list of strings
+        Names of the int or float EventHeader parameters to copy into the event index,
+        e.g. the ones set by the EventIndexSummary producer of Recon. They are stored as
+        doubles (NaN for the events without them) in branches named like the parameters
+        with any character other than letters and digits replaced by an underscore.
+    indexSelection : str
+        Only read the entries of the input files passing this selection on their event
+        index (a TTree::Draw expression of its branches, e.g. 'EcalVetoPass && run == 1').
+        The selection is evaluated on the index alone, so the events that don't pass it
+        are never read. The input files need to have been written with eventIndex.
+    inputEntryRange : tuple of two ints
+        Only read the entries from start up to (not including) stop of each input file,
+        (start, stop), with a negative stop to read up to the end of the file. The
+        entries are sought directly, so a large file can be split over several jobs
+        without any of them reading the entries of the others.
+    indexEvents : list of objects with run and event attributes
+        Only read the entries of the input files with these run and event numbers,
+        found with their event index (a negative run matches the event number in any
+        run). It is combined with indexSelection if both are given. The input files
+        need to have been written with eventIndex.
+    n_file_workers : int
+        Number of worker processes to spread the input files over.
+        Each worker takes the next input file that has not been processed yet, so
+        this is meant for many input files each with its own output file. Their
+        histogram files are merged into histogramFile at the end and maxEvents
+        applies to each worker. Cannot be used with more than one thread.
+    parallelStart : bool
+        Run onProcessStart of the processors that declared an independent start
+        (e.g. loading a model) on their own threads, next to the others. The
+        conditions are started before any processor. The time each processor
+        spends in configure and onProcessStart is logged at the info level.
+    batchSize : int
+        Number of events to read and process together. The producers that support
+        it (e.g. DNNEcalVetoProcessor) are given all the events of a batch at once,
+        the other processors are run on one event at a time like normal. Cannot be
+        used with more than one thread.
+    pruneUnusedProducers : bool
+        Remove the producers from the sequence whose declared outputs are all dropped
+        from the output file and not declared as an input by any later processor.
+        Producers that didn't declare their outputs, have histograms configured or
+        are listened to by the skim rules are always kept.
+    reuseProducts : bool
+        Reuse the products in the input files whose producers have not changed.
+        The hash of the parameters of each producer, of the conditions and of the
+        producers of its declared inputs is recorded in the run header. Producers
+        the input files recorded the same hash for are removed from the sequence
+        and their products are read from the input files instead. The others are
+        run again, so changing a producer re-makes its products and those of the
+        producers downstream of it. Producers that didn't declare their outputs,
+        have histograms configured or are listened to (skim rules, onlyIfPassed)
+        are always run.
+    n_sequence_threads : int
+        Number of threads to spread the processors of the sequence over within an
+        event. The products each processor uses are recorded on the first event and
+        afterwards the processors that don't depend on each other (e.g. the
+        reconstruction of different subsystems) are run at the same time.
+        Processors using products only on some events should declare them with
+        declareInput and declareOutput. Cannot be used with more than one thread
+        or in batches.
+    conditionsPrefetchThreads : int
+        Number of threads to load the conditions on at the start of each run.
+        All the conditions the providers have for the first event of the run are
+        loaded (e.g. downloaded and parsed) at the same time instead of one after the
+        other when they are first requested. 0 loads each condition when requested.
+
+    histogramSnapshotFile : str
+        File to write a snapshot of the histograms to while the job runs (e.g. for
+        live monitoring), the histograms of all threads are merged in. The snapshot
+        is replaced as a whole so it can be read at any time. No snapshots if empty.
+    histogramSnapshotEvents : int
+        Number of events between snapshots of the histograms, 0 for none.
+    histogramSnapshotSeconds : int
+        Number of seconds between snapshots of the histograms, 0 for none.
+    histogramAggregationDirectory : str
+        Directory shared by many jobs to write the histograms to at the end of the
+        job, each job in a new file. dqm-aggregate merges these files as they come
+        in, so the merged histograms are ready soon after the last job finishes.
+        The histograms are still written to histogramFile as well.
+    checkpointFile : str
+        File to write checkpoints to, so that a job that is stopped can be resumed.
+        None are written if empty. Only for jobs processing one event at a time.
+    checkpointEvents : int
+        Number of events between checkpoints.
+    resume : bool
+        Carry on from the checkpoint in checkpointFile if there is one. What was
+        written after the checkpoint is dropped, and the files written before it
+        are merged with the rest at the end.
 
     See Also
     --------
@@ -512,16 +729,59 @@ class Process:
         self.termLogLevel=2 #warnings and above
         self.fileLogLevel=0 #print all messages
         self.logFileName='' #won't setup log file
+        self.logFileAsync=False
         self.compressionSetting=9
         self.histogramFile=''
         self.conditionsGlobalTag='Default'
         self.conditionsObjectProviders=[]
         self.tree_name = 'LDMX_Events'
+        self.n_threads = 1
+        self.scheduleWindow = 0
+        self.costBranches = []
+        self.memoryBudget = 0
+        self.memoryDumpFile = ''
+        self.prefetchDepth = 0
+        self.lazyBranches = False
+        self.readCacheSize = 0
+        self.cacheLearnEntries = 0
+        self.readaheadSize = 0
+        self.asyncOpen = False
+        self.n_file_workers = 1
+        self.fastSkim = False
+        self.friendOutput = False
+        self.branchSettings = []
+        self.clusterSize = 0
+        self.ntupleClusterSize = 0
+        self.outputBackend = 'TTree'
+        self.eventIndex = False
+        self.eventIndexParameters = []
+        self.indexSelection = ''
+        self.indexEvents = []
+        self.inputEntryRange = []
+        self.parallelStart = False
+        self.batchSize = 1
+        self.pruneUnusedProducers = False
+        self.reuseProducts = False
+        self.n_sequence_threads = 1
+        self.conditionsPrefetchThreads = 0
+        self.histogramSnapshotFile = ''
+        self.histogramSnapshotEvents = 0
+        self.histogramSnapshotSeconds = 0
+        self.histogramAggregationDirectory = ''
+        self.checkpointFile = ''
+        self.checkpointEvents = 1000
+        self.resume = False
         Process.lastProcess=self
 
         # needs lastProcess defined to self-register
         self.randomNumberSeedService=RandomNumberSeedService()
 
+    def __setattr__(self, name, value) :
+        # tuples are not passed on to C++, so the range is kept as a list
+        if name == 'inputEntryRange' :
+            value = list(value)
+        super().__setattr__(name, value)
+
     def addLibrary(lib) :
         """Add a library to the list of dynamically loaded libraries
 
@@ -715,6 +975,38 @@ class Process:
 
         self.compressionSetting = algorithm*100 + level
 
+    def setBranchCompression(self,namePat,algorithm=None,level=9,basketSize=0):
+        """set the compression settings and basket size of some output branches
+
+        The branches are matched in the order that the rules are given
+        and the first matching rule is applied. Branches that don't match
+        any rule use the compression settings of the file.
+
+        For example, use a fast compression for the large collections
+        in an intermediate file while keeping the rest at the default.
+
+            p.setBranchCompression('.*SimHits.*', 4, 1, basketSize=256000)
+
+        Parameters
+        ----------
+        namePat : str
+            Pattern for the branch names to match (e.g. 'EcalSimHits.*')
+        algorithm : int
+            flag for the algorithm to use, see setCompression,
+            None to keep the compression settings of the file
+        level : int
+            flag for the level of compression to use
+        basketSize : int
+            size of the baskets in bytes, zero for the default
+
+        See Also
+        --------
+        setCompression
+        """
+
+        self.branchSettings.append(BranchSettings(namePat,
+            -1 if algorithm is None else algorithm*100 + level, basketSize))
+
     def inputDir(self, indir) :
         """Scan the input directory and make a list of input root files to read from it
 
@@ -788,6 +1080,10 @@ class Process:
         if (self.run>0): msg += "\n using run number %d"%(self.run)
         if (self.maxEvents>0): msg += "\n Maximum events to process: %d"%(self.maxEvents)
         else: msg += "\n No limit on maximum events to process"
+        if (self.n_threads>1): msg += "\n Processing events with %d threads"%(self.n_threads)
+        if (self.n_file_workers>1): msg += "\n Processing input files with %d workers"%(self.n_file_workers)
+        if (self.batchSize>1): msg += "\n Processing events in batches of %d"%(self.batchSize)
+        if (self.n_sequence_threads>1): msg += "\n Running the sequence with %d threads"%(self.n_sequence_threads)
         if (len(self.conditionsObjectProviders)>0):
             msg += "\n conditionsObjectProviders:\n";
             for cop in self.conditionsObjectProviders:
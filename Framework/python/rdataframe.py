@@ -0,0 +1,164 @@
+"""Module for multi-threaded analyses of event files with ROOT's RDataFrame
+
+Many analyses only read a few fields of the event objects and fill
+histograms, which does not need the whole event loop of fire. An
+RDataFrame over the event tree reads only the branches that are used and
+can spread the events over all of the cores with ROOT's implicit
+multi-threading.
+
+The event dictionaries are loaded through 'libFramework.so' like in the
+EventTree module, so the event objects are columns of their own types
+and their methods can be called in the expressions. Each branch is also
+given an alias without its pass name if only one pass has it.
+
+A few helper functions for the columns that are hard to use in a single
+expression are declared in the 'ldmx::rdf' namespace. They are listed in
+the C++ code below.
+
+Examples
+--------
+
+    from LDMX.Framework import rdataframe
+
+    df = rdataframe.frame(['events_0.root', 'events_1.root'], threads = 0)
+    h = (df.Filter('EcalVeto.passesVeto() and HcalVeto.passesVeto()')
+           .Define('n_neutrons', 'ldmx::rdf::trackIDs(SimParticles, 2112).size()')
+           .Histo1D(('n_neutrons', ';neutrons;events', 10, 0, 10), 'n_neutrons'))
+    h.Draw()
+
+"""
+
+import ROOT
+
+if ROOT.gSystem.Load('libFramework.so') < 0 :
+    print('[ WARN ] : Could not import event dictionary!')
+    print('           Using the event objects in data frames may not work.')
+
+__helpers = """
+#include <map>
+#include "ROOT/RVec.hxx"
+
+namespace ldmx::rdf {
+
+/// The particle with the input track ID, nullptr if it wasn't kept
+inline const ldmx::SimParticle* particle(
+    const std::map<int, ldmx::SimParticle>& particles, int track_id) {
+  auto it{particles.find(track_id)};
+  return it == particles.end() ? nullptr : &it->second;
+}
+
+/// The track IDs of the particles with the input PDG ID
+inline ROOT::RVec<int> trackIDs(
+    const std::map<int, ldmx::SimParticle>& particles, int pdg_id) {
+  ROOT::RVec<int> ids;
+  for (const auto& [id, particle] : particles)
+    if (particle.getPdgID() == pdg_id) ids.push_back(id);
+  return ids;
+}
+
+/// The energies of the particles with the input PDG ID [MeV]
+inline ROOT::RVec<double> energies(
+    const std::map<int, ldmx::SimParticle>& particles, int pdg_id) {
+  ROOT::RVec<double> e;
+  for (const auto& [id, particle] : particles)
+    if (particle.getPdgID() == pdg_id) e.push_back(particle.getEnergy());
+  return e;
+}
+
+/// The energy of the primary with the input PDG ID, 0 if there isn't one
+inline double primaryEnergy(
+    const std::map<int, ldmx::SimParticle>& particles, int pdg_id) {
+  for (const auto& [id, particle] : particles) {
+    if (particle.getPdgID() == pdg_id and particle.getParents().size() == 1 and
+        particle.getParents().front() == 0)
+      return particle.getEnergy();
+  }
+  return 0.;
+}
+
+/// The algorithm variables of a trigger result
+inline ROOT::RVec<double> algoVars(const ldmx::TriggerResult& result) {
+  ROOT::RVec<double> vars(result.getNAlgoVars());
+  for (int i = 0; i < result.getNAlgoVars(); i++)
+    vars[i] = result.getAlgoVar(i);
+  return vars;
+}
+
+}  // namespace ldmx::rdf
+"""
+
+__declared = False
+
+def declare_helpers() :
+    """Declare the helper functions to the interpreter
+
+    This is only done once, no matter how many times it is called,
+    and is done by frame so it is only needed for data frames made
+    without it.
+    """
+
+    global __declared
+    if __declared :
+        return
+
+    # make sure the classes the helpers use are loaded from the dictionaries
+    ROOT.ldmx.SimParticle
+    ROOT.ldmx.TriggerResult
+    if not ROOT.gInterpreter.Declare(__helpers) :
+        raise RuntimeError('Could not declare the ldmx::rdf helpers.')
+    __declared = True
+
+def frame(files, threads = None, tree_name = 'LDMX_Events') :
+    """Make a data frame over the events of the input files
+
+    Parameters
+    ----------
+    files : str or list of str
+        Event files to read, ROOT globs like 'events_*.root' are allowed
+    threads : int, optional
+        Number of threads to spread the events over, 0 for all of the
+        cores. Implicit multi-threading is left as it is if not given.
+        ROOT only allows to enable it before the data frame is made and
+        it then applies to all of the data frames of the program.
+    tree_name : str
+        Name of the event tree
+
+    Returns
+    -------
+    ROOT.RDF.RNode
+        Data frame with an alias for each branch without its pass name
+        if only one pass has it
+    """
+
+    if threads is not None :
+        ROOT.EnableImplicitMT(threads)
+
+    declare_helpers()
+
+    if isinstance(files, str) :
+        files = [files]
+
+    # find the branch names from the first file, all of the files of
+    # a run of fire have the same ones
+    chain = ROOT.TChain(tree_name)
+    for f in files :
+        chain.Add(f)
+    if chain.GetNtrees() == 0 :
+        raise RuntimeError(f'No files with a \'{tree_name}\' tree in {files}.')
+    chain.LoadTree(0)
+    branches = [b.GetName() for b in chain.GetTree().GetListOfBranches()]
+
+    df = ROOT.RDF.AsRNode(ROOT.RDataFrame(tree_name, files))
+
+    # the branches are named '<collection>_<pass>', the pass names don't
+    # have underscores but the collection names can
+    passes = {}
+    for branch in branches :
+        collection, _, pass_name = branch.rpartition('_')
+        if collection :
+            passes.setdefault(collection, []).append(branch)
+    for collection, full_names in passes.items() :
+        if len(full_names) == 1 and collection not in branches :
+            df = df.Alias(collection, full_names[0])
+
+    return df
@@ -1,12 +1,30 @@
 #include "Framework/Conditions.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include "Framework/PluginFactory.h"
 #include "Framework/Process.h"
 
 namespace framework {
 
+/**
+ * Lock guarding the conditions cache
+ *
+ * The worker slots of a multi-threaded Process share the conditions
+ * system, so lookups (which may update the cache) need to be serialized.
+ * It is recursive since providers request their parent conditions while
+ * we are looking up the child.
+ * This lives here rather than as a member so that Conditions (and
+ * therefore Process) remains copyable.
+ */
+static std::recursive_mutex cache_mutex;
+
 Conditions::Conditions(Process& p) : process_{p} {}
 
 void Conditions::createConditionsObjectProvider(
@@ -42,6 +60,70 @@ void Conditions::onProcessEnd() {
 
 void Conditions::onNewRun(ldmx::RunHeader& rh) {
   for (auto ptr : providerMap_) ptr.second->onNewRun(rh);
+  if (prefetchThreads_ > 0 && process_.getEventHeader())
+    prefetch(*process_.getEventHeader());
+}
+
+void Conditions::prefetch(const ldmx::EventHeader& context) {
+  // what needs to be loaded, the providers may request conditions
+  // themselves so we can't hold the lock while they are called
+  struct Load {
+    std::string name;
+    ConditionsObjectProvider* provider;
+    std::pair<const ConditionsObject*, ConditionsIOV> cond{nullptr, {}};
+    std::exception_ptr error;
+  };
+  std::vector<Load> loads;
+  {
+    std::lock_guard<std::recursive_mutex> lock(cache_mutex);
+    for (auto& [name, provider] : providerMap_) {
+      auto cacheptr = cache_.find(name);
+      if (cacheptr == cache_.end() ||
+          !cacheptr->second.iov.validForEvent(context))
+        loads.push_back({name, provider});
+    }
+  }
+  if (loads.empty()) return;
+
+  std::atomic<std::size_t> next{0};
+  auto work = [&]() {
+    for (std::size_t i = next++; i < loads.size(); i = next++) {
+      try {
+        loads[i].cond = loads[i].provider->getCondition(context);
+      } catch (...) {
+        loads[i].error = std::current_exception();
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  int n_threads = std::min<int>(prefetchThreads_, loads.size());
+  for (int i = 0; i < n_threads; i++) threads.emplace_back(work);
+  for (auto& thread : threads) thread.join();
+
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex);
+  for (auto& load : loads) {
+    if (load.error || !load.cond.first) {
+      ldmx_log(warn) << "Unable to prefetch condition '" << load.name
+                     << "', it will be loaded when it is requested.";
+      continue;
+    }
+    auto cacheptr = cache_.find(load.name);
+    if (cacheptr != cache_.end()) {
+      if (cacheptr->second.iov.validForEvent(context)) {
+        // another provider requested it while we were loading
+        load.provider->releaseConditionsObject(load.cond.first);
+        continue;
+      }
+      cacheptr->second.provider->releaseConditionsObject(cacheptr->second.obj);
+    }
+    CacheEntry& ce = cache_[load.name];
+    ce.iov = load.cond.second;
+    ce.obj = load.cond.first;
+    ce.provider = load.provider;
+    ce.generation++;
+  }
+  ldmx_log(debug) << "Prefetched " << loads.size() << " conditions for run "
+                  << context.getRun() << " on " << n_threads << " threads";
 }
 
 ConditionsIOV Conditions::getConditionIOV(
@@ -55,6 +137,7 @@ ConditionsIOV Conditions::getConditionIOV(
 
 const ConditionsObject* Conditions::getConditionPtr(
     const std::string& condition_name) {
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex);
   const ldmx::EventHeader& context = *(process_.getEventHeader());
   auto cacheptr = cache_.find(condition_name);
 
@@ -107,9 +190,27 @@ const ConditionsObject* Conditions::getConditionPtr(
       }
       cacheptr->second.iov = cond.second;
       cacheptr->second.obj = cond.first;
+      cacheptr->second.generation++;
       return cond.first;
     }
   }
 }
 
+const ConditionsObject* Conditions::getConditionPtr(ConditionsHandle& handle) {
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex);
+  const ConditionsObject* obj{nullptr};
+  if (handle.entry_ &&
+      handle.entry_->iov.validForEvent(*(process_.getEventHeader()))) {
+    obj = handle.entry_->obj;
+  } else {
+    // first request or out of date, update the cache the usual way
+    obj = getConditionPtr(handle.name_);
+    // the entries of the cache stay where they are once they exist
+    handle.entry_ = &cache_.find(handle.name_)->second;
+  }
+  handle.changed_ = handle.entry_->generation != handle.generation_;
+  handle.generation_ = handle.entry_->generation;
+  return obj;
+}
+
 }  // namespace framework
@@ -10,8 +10,15 @@
 /*   C++ StdLib   */
 /*~~~~~~~~~~~~~~~~*/
 #include <any>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -384,6 +391,377 @@ ConfigurePython::ConfigurePython(const std::string& pythonScript, char* args[],
   }
 }
 
+/**
+ * Write a string as a JSON string, escaping the characters that need it.
+ *
+ * @param[in] o stream to write to
+ * @param[in] str string to write
+ */
+static void writeJSON(std::ostream& o, const std::string& str) {
+  o << '"';
+  for (unsigned char c : str) {
+    switch (c) {
+      case '"':
+        o << "\\\"";
+        break;
+      case '\\':
+        o << "\\\\";
+        break;
+      case '\n':
+        o << "\\n";
+        break;
+      case '\t':
+        o << "\\t";
+        break;
+      case '\r':
+        o << "\\r";
+        break;
+      default:
+        if (c < 0x20) {
+          char buf[8];
+          std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+          o << buf;
+        } else {
+          o << c;
+        }
+    }
+  }
+  o << '"';
+}
+
+static void writeJSON(std::ostream& o, bool val) {
+  o << (val ? "true" : "false");
+}
+
+static void writeJSON(std::ostream& o, int val) { o << val; }
+
+/**
+ * Write a double so that it is read back as a double.
+ *
+ * The infinities and NaN are written as python's json module does.
+ */
+static void writeJSON(std::ostream& o, double val) {
+  if (std::isnan(val)) {
+    o << "NaN";
+  } else if (std::isinf(val)) {
+    o << (val > 0 ? "Infinity" : "-Infinity");
+  } else {
+    std::ostringstream ss;
+    ss.precision(std::numeric_limits<double>::max_digits10);
+    ss << val;
+    std::string str{ss.str()};
+    if (str.find_first_of(".e") == std::string::npos) str += ".0";
+    o << str;
+  }
+}
+
+static void writeJSON(std::ostream& o, const config::Parameters& params);
+
+template <typename T>
+static void writeJSON(std::ostream& o, const std::vector<T>& vals) {
+  o << '[';
+  for (std::size_t i{0}; i < vals.size(); i++) {
+    if (i > 0) o << ',';
+    writeJSON(o, vals[i]);
+  }
+  o << ']';
+}
+
+/**
+ * Write a parameter of any of the types made by getMembers.
+ *
+ * @return false if the type of the parameter is not one of them
+ */
+template <typename T, typename... Others>
+static bool writeAnyJSON(std::ostream& o, const std::any& val) {
+  if (auto ptr{std::any_cast<T>(&val)}) {
+    writeJSON(o, *ptr);
+    return true;
+  }
+  if constexpr (sizeof...(Others) > 0) {
+    return writeAnyJSON<Others...>(o, val);
+  }
+  return false;
+}
+
+static void writeJSON(std::ostream& o, const config::Parameters& params) {
+  o << '{';
+  bool first{true};
+  for (const auto& [key, val] : params.getParameters()) {
+    if (not first) o << ',';
+    first = false;
+    writeJSON(o, key);
+    o << ':';
+    if (not writeAnyJSON<bool, int, double, std::string, config::Parameters,
+                         std::vector<int>, std::vector<double>,
+                         std::vector<std::string>,
+                         std::vector<config::Parameters>,
+                         std::vector<std::vector<int>>,
+                         std::vector<std::vector<double>>,
+                         std::vector<std::vector<std::string>>,
+                         std::vector<std::vector<config::Parameters>>>(o,
+                                                                       val)) {
+      EXCEPTION_RAISE("ConfigureError", "Parameter '" + key + "' of type '" +
+                                            val.type().name() +
+                                            "' cannot be written to JSON.");
+    }
+  }
+  o << '}';
+}
+
+/**
+ * Reader of the JSON written by writeJSON
+ *
+ * The values are converted into the same C++ types as getMembers
+ * converts the python objects into, with lists taking the type
+ * of their first entry and empty lists being left without a value
+ * so they are dropped from the parameters.
+ */
+class JSONReader {
+ public:
+  /**
+   * @param[in] text JSON to read
+   * @param[in] filename name of file the JSON was read from, for errors
+   */
+  JSONReader(std::string text, std::string filename)
+      : text_{std::move(text)}, filename_{std::move(filename)} {}
+
+  /// Read the JSON as an object, checking nothing follows it
+  config::Parameters read() {
+    auto val{value()};
+    skip();
+    auto params{std::any_cast<config::Parameters>(&val)};
+    if (params == nullptr or pos_ != text_.size()) fail("expected one object");
+    return *params;
+  }
+
+ private:
+  [[noreturn]] void fail(const std::string& what) const {
+    EXCEPTION_RAISE("ConfigureError", "Malformed configuration '" +
+                                          filename_ + "' at character " +
+                                          std::to_string(pos_) + ": " + what);
+  }
+
+  void skip() {
+    while (pos_ < text_.size() and std::isspace((unsigned char)text_[pos_]))
+      pos_++;
+  }
+
+  char peek() {
+    skip();
+    if (pos_ == text_.size()) fail("unexpected end of file");
+    return text_[pos_];
+  }
+
+  void expect(char c) {
+    if (peek() != c) fail(std::string("expected '") + c + "'");
+    pos_++;
+  }
+
+  bool consume(const std::string& word) {
+    if (text_.compare(pos_, word.size(), word) != 0) return false;
+    pos_ += word.size();
+    return true;
+  }
+
+  std::any value() {
+    char c{peek()};
+    if (c == '{') return object();
+    if (c == '[') return list();
+    if (c == '"') return string();
+    if (consume("true")) return true;
+    if (consume("false")) return false;
+    if (consume("NaN")) return std::numeric_limits<double>::quiet_NaN();
+    if (consume("Infinity")) return std::numeric_limits<double>::infinity();
+    if (consume("-Infinity")) return -std::numeric_limits<double>::infinity();
+    return number();
+  }
+
+  config::Parameters object() {
+    std::map<std::string, std::any> params;
+    expect('{');
+    for (bool first{true}; peek() != '}'; first = false) {
+      if (not first) expect(',');
+      std::string key{string()};
+      expect(':');
+      auto val{value()};
+      if (val.has_value()) params[key] = std::move(val);
+    }
+    expect('}');
+    config::Parameters obj;
+    obj.setParameters(params);
+    return obj;
+  }
+
+  std::string string() {
+    expect('"');
+    std::string str;
+    while (pos_ < text_.size() and text_[pos_] != '"') {
+      char c{text_[pos_++]};
+      if (c != '\\') {
+        str += c;
+        continue;
+      }
+      if (pos_ == text_.size()) break;
+      c = text_[pos_++];
+      switch (c) {
+        case 'n':
+          str += '\n';
+          break;
+        case 't':
+          str += '\t';
+          break;
+        case 'r':
+          str += '\r';
+          break;
+        case 'b':
+          str += '\b';
+          break;
+        case 'f':
+          str += '\f';
+          break;
+        case 'u': {
+          if (pos_ + 4 > text_.size()) fail("truncated \\u escape");
+          unsigned long code{
+              std::strtoul(text_.substr(pos_, 4).c_str(), nullptr, 16)};
+          pos_ += 4;
+          // encode the code point in UTF-8
+          if (code < 0x80) {
+            str += char(code);
+          } else if (code < 0x800) {
+            str += char(0xc0 | (code >> 6));
+            str += char(0x80 | (code & 0x3f));
+          } else {
+            str += char(0xe0 | (code >> 12));
+            str += char(0x80 | ((code >> 6) & 0x3f));
+            str += char(0x80 | (code & 0x3f));
+          }
+          break;
+        }
+        default:
+          str += c;
+      }
+    }
+    expect('"');
+    return str;
+  }
+
+  std::any number() {
+    const char* begin{text_.c_str() + pos_};
+    char* end{nullptr};
+    std::size_t len{std::strspn(begin, "+-0123456789.eE")};
+    if (len == 0) fail("unexpected character");
+    if (std::string(begin, len).find_first_of(".eE") == std::string::npos) {
+      long val{std::strtol(begin, &end, 10)};
+      pos_ += end - begin;
+      return int(val);
+    }
+    double val{std::strtod(begin, &end)};
+    pos_ += end - begin;
+    return val;
+  }
+
+  /// convert the entries of a list to the type of its first entry
+  template <typename T>
+  std::vector<T> convert(const std::vector<std::any>& entries) {
+    std::vector<T> vals;
+    vals.reserve(entries.size());
+    for (const auto& entry : entries) {
+      if (auto ptr{std::any_cast<T>(&entry)}) {
+        vals.push_back(*ptr);
+      } else if constexpr (std::is_same_v<T, double>) {
+        if (auto i{std::any_cast<int>(&entry)}) {
+          vals.push_back(*i);
+        } else {
+          fail("list of doubles with a non-number entry");
+        }
+      } else if constexpr (std::is_same_v<T, int>) {
+        if (auto b{std::any_cast<bool>(&entry)}) {
+          vals.push_back(*b);
+        } else {
+          fail("list of ints with a non-int entry");
+        }
+      } else if (not entry.has_value()) {
+        // empty list in a list of lists
+        vals.emplace_back();
+      } else {
+        fail("list with entries of different types");
+      }
+    }
+    return vals;
+  }
+
+  std::any list() {
+    std::vector<std::any> entries;
+    expect('[');
+    while (peek() != ']') {
+      if (not entries.empty()) expect(',');
+      entries.push_back(value());
+    }
+    expect(']');
+
+    if (entries.empty()) return {};
+    const auto& first{entries.front()};
+    if (first.type() == typeid(int) or first.type() == typeid(bool))
+      return convert<int>(entries);
+    if (first.type() == typeid(double)) return convert<double>(entries);
+    if (first.type() == typeid(std::string))
+      return convert<std::string>(entries);
+    if (first.type() == typeid(config::Parameters))
+      return convert<config::Parameters>(entries);
+    if (first.type() == typeid(std::vector<int>))
+      return convert<std::vector<int>>(entries);
+    if (first.type() == typeid(std::vector<double>))
+      return convert<std::vector<double>>(entries);
+    if (first.type() == typeid(std::vector<std::string>))
+      return convert<std::vector<std::string>>(entries);
+    if (first.type() == typeid(std::vector<config::Parameters>))
+      return convert<std::vector<config::Parameters>>(entries);
+    if (not first.has_value()) return {};
+    fail("a list with dimension greater than 2 is not supported");
+  }
+
+ private:
+  /// the JSON being read
+  std::string text_;
+  /// name of the file, for errors
+  std::string filename_;
+  /// current position in the text
+  std::size_t pos_{0};
+};
+
+void ConfigurePython::dump(const std::string& filename) const {
+  std::ofstream file(filename);
+  if (not file.is_open()) {
+    EXCEPTION_RAISE("ConfigureError", "Unable to open configuration file '" +
+                                          filename + "' for writing.");
+  }
+  writeJSON(file, configuration_);
+  file << '\n';
+}
+
+std::string ConfigurePython::toJSON(const config::Parameters& parameters) {
+  std::ostringstream o;
+  writeJSON(o, parameters);
+  return o.str();
+}
+
+ConfigurePython ConfigurePython::load(const std::string& filename) {
+  std::ifstream file(filename);
+  if (not file.is_open()) {
+    EXCEPTION_RAISE("ConfigDNE",
+                    "Passed configuration '" + filename +
+                        "' is not accessible.\n"
+                        "    Did you make a typo in the path to the file?");
+  }
+  std::stringstream text;
+  text << file.rdbuf();
+
+  ConfigurePython cfg;
+  cfg.configuration_ = JSONReader(text.str(), filename).read();
+  return cfg;
+}
+
 ProcessHandle ConfigurePython::makeProcess() {
   // no python nonsense happens in here,
   // this just takes the parameters determined earlier
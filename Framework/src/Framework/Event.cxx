@@ -1,10 +1,43 @@
 #include "Framework/Event.h"
 
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+
 #include "TBranchElement.h"
+#include "TFriendElement.h"
 
 namespace framework {
 
-Event::Event(const std::string& thePassName) : passName_(thePassName) {}
+namespace {
+
+/**
+ * Table of the names interned into product handles
+ *
+ * This is shared by all the events in the program, so it is guarded
+ * by a mutex for the worker slots of a multi-threaded Process.
+ * The names are kept in a deque so references to them stay valid
+ * while new handles are being made.
+ */
+struct HandleTable {
+  std::mutex mutex;
+  std::deque<std::pair<std::string, std::string>> tags;
+  std::map<std::pair<std::string, std::string>, std::size_t> indices;
+};
+
+HandleTable &handleTable() {
+  static HandleTable the_table;
+  return the_table;
+}
+
+}  // namespace
+
+Event::Event(const std::string& thePassName)
+    : passName_(thePassName),
+      arenaBuffer_(ARENA_BUFFER_SIZE),
+      arena_(arenaBuffer_.data(), arenaBuffer_.size()) {}
 
 Event::~Event() {
   for (regex_t& reg : regexDropCollections_) {
@@ -22,6 +55,7 @@ void Event::addDrop(const std::string& exp) {
   regex_t reg;
   if (!regcomp(&reg, exp.c_str(), REG_EXTENDED | REG_ICASE | REG_NOSUB)) {
     regexDropCollections_.push_back(reg);
+    dropDecisions_.clear();
   } else {
     EXCEPTION_RAISE("InvalidRegex", "The passed drop rule regex '" + exp +
                                         "' is not a valid regex.");
@@ -67,6 +101,14 @@ std::vector<ProductTag> Event::searchProducts(const std::string& namematch,
                                               const std::string& passmatch,
                                               const std::string& typematch,
                                               bool full_string_match) const {
+  auto lock{lockBus()};
+  if (accesses_) {
+    // a search by a pattern could match any product
+    if (full_string_match and not namematch.empty())
+      accesses_->reads.insert(namematch);
+    else
+      accesses_->searched = true;
+  }
   std::vector<ProductTag> retval;
   regex_t reg_name{construct_regex(namematch, full_string_match)},
       reg_pass{construct_regex(passmatch, full_string_match)},
@@ -99,13 +141,135 @@ bool Event::exists(const std::string& name, const std::string& passName,
     return (matches.size() > 0);
 }
 
+ProductHandle Event::getHandle(const std::string& collectionName,
+                               const std::string& passName) {
+  auto& table{handleTable()};
+  std::lock_guard<std::mutex> lock(table.mutex);
+  auto key{std::make_pair(collectionName, passName)};
+  auto it{table.indices.find(key)};
+  if (it != table.indices.end()) return ProductHandle(it->second);
+  table.tags.push_back(key);
+  table.indices[key] = table.tags.size() - 1;
+  return ProductHandle(table.tags.size() - 1);
+}
+
+const std::pair<std::string, std::string>& Event::getHandleTag(
+    ProductHandle handle) {
+  auto& table{handleTable()};
+  std::lock_guard<std::mutex> lock(table.mutex);
+  if (not handle.valid() or handle.index() >= table.tags.size()) {
+    EXCEPTION_RAISE("InvalidHandle",
+                    "Attempting to use a product handle that was not made "
+                    "by Event::getHandle.");
+  }
+  return table.tags[handle.index()];
+}
+
+const std::string& Event::resolve(ProductHandle handle) const {
+  if (not handle.valid()) {
+    EXCEPTION_RAISE("InvalidHandle",
+                    "Attempting to use a product handle that was not made "
+                    "by Event::getHandle.");
+  }
+  if (handle.index() >= resolvedHandles_.size())
+    resolvedHandles_.resize(handle.index() + 1);
+  auto& resolved{resolvedHandles_[handle.index()]};
+  if (resolved) return *resolved;
+
+  // first use of this handle since the products changed, look it up
+  const auto& [collectionName, passName] = getHandleTag(handle);
+  if (collectionName == ldmx::EventHeader::BRANCH) {
+    resolved = collectionName;
+  } else {
+    static const bool require_full_string_match = true;
+    auto matches{searchProducts(collectionName, passName, "",
+                                require_full_string_match)};
+    if (matches.size() == 1)
+      resolved = makeBranchName(collectionName, matches.at(0).passname());
+    else
+      resolved = "";
+  }
+  return *resolved;
+}
+
+const std::string& Event::makeBranchName(const std::string& collectionName,
+                                         const std::string& passName) const {
+  auto lock{lockBus()};
+  auto& by_pass{branchNames_[collectionName]};
+  auto it{by_pass.find(passName)};
+  if (it == by_pass.end())
+    it = by_pass.emplace(passName, collectionName + "_" + passName).first;
+  return it->second;
+}
+
+const std::string& Event::getBranchName(const std::string& collectionName,
+                                        const std::string& passName) const {
+  if (collectionName == ldmx::EventHeader::BRANCH) return collectionName;
+  if (not passName.empty()) return makeBranchName(collectionName, passName);
+
+  // if no passName, then find branchName by looking over known products
+  auto known{knownLookups_.find(collectionName)};
+  if (known != knownLookups_.end()) return known->second;
+
+  // this collectionName hasn't been found before
+  //   this collection name is the whole name and not a partial name
+  //   so we search products with a full-string match required
+  auto matches = searchProducts(collectionName, "", "", true);
+  if (matches.empty()) {
+    // no matches found
+    EXCEPTION_RAISE("ProductNotFound",
+                    "No product found for name '" + collectionName + "'");
+  } else if (matches.size() > 1) {
+    // more than one branch found
+    std::stringstream names;
+    for (auto strs : matches) {
+      names << "\n" << strs;
+    }
+    EXCEPTION_RAISE("ProductAmbiguous",
+                    "Multiple products found for name '" + collectionName +
+                        "' without specified pass name :" + names.str());
+  }
+  // exactly one branch found -> cache for later
+  return knownLookups_
+      .emplace(collectionName,
+               makeBranchName(collectionName, matches.at(0).passname()))
+      .first->second;
+}
+
+const std::string& Event::makeOutputBranchName(
+    const std::string& collectionName) const {
+  if (collectionName.find('_') != std::string::npos) {
+    EXCEPTION_RAISE("IllegalName",
+                    "The product name '" + collectionName +
+                        "' is illegal as it contains an underscore.");
+  }
+
+  if (collectionName == ldmx::EventHeader::BRANCH) return collectionName;
+  return makeBranchName(collectionName);
+}
+
+void Event::markFilled(const std::string& collectionName,
+                       const std::string& branchName) {
+  if (accesses_) accesses_->writes.insert(collectionName);
+  if (not branchesFilled_.insert(branchName).second) {
+    EXCEPTION_RAISE("ProductExists",
+                    "A product named '" + collectionName +
+                        "' already exists in the event (has been loaded by a "
+                        "previous producer in this process).");
+  }
+}
+
 TTree* Event::createTree() {
   outputTree_ = new TTree("LDMX_Events", "LDMX Events");
 
   return outputTree_;
 }
 
-void Event::setOutputTree(TTree* tree) { outputTree_ = tree; }
+void Event::setOutputTree(TTree* tree, bool isFriend) {
+  outputTree_ = tree;
+  friendOutput_ = isFriend;
+  headerOnOutput_ = false;
+}
 
 void Event::setInputTree(TTree* tree) {
   inputTree_ = tree;
@@ -114,16 +278,21 @@ void Event::setInputTree(TTree* tree) {
   // so reset branch listing before starting
   products_.clear();
   knownLookups_.clear();  // reset caching of empty pass requests
+  resolvedHandles_.clear();
   bus_.everybodyOff();
+  headerOnOutput_ = false;
 
   // put in EventHeader (only one without pass name)
   products_.emplace_back(ldmx::EventHeader::BRANCH, "", "ldmx::EventHeader");
 
-  // find the names of all the existing branches
-  TObjArray* branches = inputTree_->GetListOfBranches();
-  for (int i = 0; i < branches->GetEntriesFast(); i++) {
-    std::string brname = branches->At(i)->GetName();
-    if (brname != ldmx::EventHeader::BRANCH) {
+  // find the names of all the existing branches, including those of
+  //  the parent trees joined to the input tree as friends
+  std::set<std::string> listed{ldmx::EventHeader::BRANCH};
+  std::function<void(TTree*)> list_branches = [&](TTree* tree) {
+    TObjArray* branches = tree->GetListOfBranches();
+    for (int i = 0; i < branches->GetEntriesFast(); i++) {
+      std::string brname = branches->At(i)->GetName();
+      if (not listed.insert(brname).second) continue;
       size_t j = brname.find("_");
       auto br = dynamic_cast<TBranchElement*>(branches->At(i));
       // can't determine type if branch isn't
@@ -135,8 +304,52 @@ void Event::setInputTree(TTree* tree) {
           brname.substr(j + 1),  // pass name is after
           br ? br->GetClassName() : "BSILFD");
     }
+    if (not tree->GetListOfFriends()) return;
+    for (auto obj : *tree->GetListOfFriends())
+      list_branches(static_cast<TFriendElement*>(obj)->GetTree());
+  };
+  list_branches(inputTree_);
+}
+
+#ifdef FRAMEWORK_HAS_RNTUPLE
+void Event::setInputNTuple(rntuple::RNTupleReader* ntuple) {
+  inputTree_ = nullptr;
+  inputNTuple_ = ntuple;
+
+  products_.clear();
+  knownLookups_.clear();
+  resolvedHandles_.clear();
+  inputFields_.clear();
+  bus_.everybodyOff();
+
+  // the same listing as the tree, but from the top-level fields
+  products_.emplace_back(ldmx::EventHeader::BRANCH, "", "ldmx::EventHeader");
+  const auto& descriptor{inputNTuple_->GetDescriptor()};
+  for (const auto& field : descriptor.GetTopLevelFields()) {
+    std::string name{field.GetFieldName()};
+    if (name == ldmx::EventHeader::BRANCH) continue;
+    size_t j = name.find("_");
+    products_.emplace_back(name.substr(0, j), name.substr(j + 1),
+                           field.GetTypeName());
+  }
+}
+
+void Event::readNTupleEntry(rntuple::NTupleSize_t entry) {
+  inputNTupleEntry_ = entry;
+  for (const std::string& name : inputFields_)
+    bus_.read(*inputNTuple_, name, entry);
+}
+
+std::vector<std::string> Event::getNewNTupleFields(
+    const std::set<std::string>& known) const {
+  std::vector<std::string> fields;
+  for (const std::string& branchName : branchesFilled_) {
+    if (known.find(branchName) == known.end() and not shouldDrop(branchName))
+      fields.push_back(branchName);
   }
+  return fields;
 }
+#endif
 
 bool Event::nextEvent() {
   eventHeader_ = getObject<ldmx::EventHeader>(ldmx::EventHeader::BRANCH);
@@ -149,12 +362,80 @@ void Event::beforeFill() {
     // Event Header not copied from input and hasn't been added yet, need to put
     // it in
     add(ldmx::EventHeader::BRANCH, eventHeader_);
+  } else if (friendOutput_ and not headerOnOutput_ and
+             bus_.isOnBoard(ldmx::EventHeader::BRANCH)) {
+    // the header read from the input is written along with the new
+    //  products so the output can be joined back to the input
+    bus_.attach(outputTree_, ldmx::EventHeader::BRANCH, true);
+    headerOnOutput_ = true;
   }
 }
 
 void Event::Clear() {
   branchesFilled_.clear();  // forget names of branches we filled
   bus_.clear();  // clear the event objects individually but leave them on bus
+  derived_.clear();  // the derived objects refer to the cleared products
+  arena_.release();  // start the scratch space over for the next event
+}
+
+void Event::transfer(Event& other) const {
+  other.eventHeader_ = eventHeader_;
+  for (const std::string& branchName : branchesFilled_) {
+    if (branchName == ldmx::EventHeader::BRANCH) continue;
+
+    if (other.branchesFilled_.find(branchName) !=
+        other.branchesFilled_.end()) {
+      EXCEPTION_RAISE("ProductExists",
+                      "A product named '" + branchName +
+                          "' already exists in the event being copied into.");
+    }
+    other.branchesFilled_.insert(branchName);
+
+    bool already_on_board{other.bus_.isOnBoard(branchName)};
+    try {
+      bus_.copy(branchName, other.bus_);
+    } catch (const std::bad_cast&) {
+      EXCEPTION_RAISE("TypeMismatch",
+                      "Attempting to copy '" + branchName +
+                          "' into an event whose collection under that name "
+                          "has a different type.");
+    }
+
+    if (not already_on_board) {
+      // new passenger on the other bus, do the same book-keeping as add
+      std::string collectionName{branchName.substr(0, branchName.find('_'))};
+      std::string tname;
+      for (const ProductTag& tag : products_) {
+        if (tag.name() == collectionName and tag.passname() == passName_) {
+          tname = tag.type();
+          break;
+        }
+      }
+
+      if (other.outputTree_ and not other.shouldDrop(branchName)) {
+        TBranch* outBranch =
+            other.bus_.attach(other.outputTree_, branchName, true);
+        std::string class_name{outBranch->GetClassName()};
+        if (not class_name.empty()) tname = class_name;
+      }
+
+      auto it_known{other.knownLookups_.find(collectionName)};
+      if (it_known != other.knownLookups_.end())
+        other.knownLookups_.erase(it_known);
+      other.resolvedHandles_.clear();
+      other.getTickets_.clear();
+
+      other.products_.emplace_back(collectionName, other.passName_, tname);
+    }
+  }
+}
+
+std::vector<std::pair<std::string, std::size_t>> Event::getProductSizes()
+    const {
+  auto sizes{bus_.sizes()};
+  std::sort(sizes.begin(), sizes.end(),
+            [](const auto &a, const auto &b) { return a.second > b.second; });
+  return sizes;
 }
 
 void Event::onEndOfEvent() {}
@@ -164,15 +445,28 @@ void Event::onEndOfFile() {
     outputTree_->ResetBranchAddresses();  // reset addresses for output branch
   if (inputTree_)
     inputTree_ = nullptr;  // detach old inputTree (owned by EventFile)
+#ifdef FRAMEWORK_HAS_RNTUPLE
+  inputNTuple_ = nullptr;  // same for the RNTuple
+  inputFields_.clear();
+#endif
   knownLookups_.clear();   // reset caching of empty pass requests
+  resolvedHandles_.clear();
   bus_.everybodyOff();     // delete buffer objects
 }
 
 bool Event::shouldDrop(const std::string& branchName) const {
+  if (regexDropCollections_.empty()) return false;
+  auto it{dropDecisions_.find(branchName)};
+  if (it != dropDecisions_.end()) return it->second;
+  bool drop{false};
   for (const regex_t& exp : regexDropCollections_) {
-    if (!regexec(&exp, branchName.c_str(), 0, 0, 0)) return true;
+    if (!regexec(&exp, branchName.c_str(), 0, 0, 0)) {
+      drop = true;
+      break;
+    }
   }
-  return false;
+  dropDecisions_.emplace(branchName, drop);
+  return drop;
 }
 
 }  // namespace framework
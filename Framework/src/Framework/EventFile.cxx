@@ -1,5 +1,11 @@
+#include <algorithm>
+#include <cctype>
+#include <cmath>
 #include <ctime>
+#include <limits>
 
+#include "TTreeCacheUnzip.h"
+#include "TTreeFormula.h"
 #include "TTreeReader.h"
 
 // LDMX
@@ -10,6 +16,9 @@
 
 namespace framework {
 
+const char *EventFile::INDEX_TREE_NAME = "LDMX_EventIndex";
+const char *EventFile::PARENTS_NAME = "LDMX_Parents";
+
 EventFile::EventFile(const framework::config::Parameters &params,
                      const std::string &filename, EventFile *parent,
                      bool isOutputFile, bool isSingleOutput, bool isLoopable)
@@ -17,7 +26,10 @@ EventFile::EventFile(const framework::config::Parameters &params,
       parent_(parent),
       isOutputFile_(isOutputFile),
       isSingleOutput_(isSingleOutput),
-      isLoopable_(isLoopable) {
+      isLoopable_(isLoopable),
+      lazyBranches_(params.getParameter<bool>("lazyBranches", false)),
+      fastSkim_(params.getParameter<bool>("fastSkim", false)),
+      friendOutput_(params.getParameter<bool>("friendOutput", false)) {
   if (isOutputFile_) {
     // we are writting out so open the file and make sure it is writable
     file_ = new TFile(fileName_.c_str(), "RECREATE");
@@ -30,10 +42,64 @@ EventFile::EventFile(const framework::config::Parameters &params,
     //  Check out the TFile constructor for explanation of how this integer is
     //  built Short Reference: setting = 100*algorithem + level algorithm = 0
     //  ==> use global default
-    file_->SetCompressionSettings(
-        params.getParameter<int>("compressionSetting", 9));
+    compressionSetting_ = params.getParameter<int>("compressionSetting", 9);
+    file_->SetCompressionSettings(compressionSetting_);
+
+    auto backend{params.getParameter<std::string>("outputBackend", "TTree")};
+    if (backend == "RNTuple") {
+#ifndef FRAMEWORK_HAS_RNTUPLE
+      EXCEPTION_RAISE("InvalidConfig",
+                      "RNTuple output was requested, but the version of ROOT "
+                      "ldmx-sw was built with does not support it.");
+#endif
+      if (parent_) {
+        EXCEPTION_RAISE("InvalidConfig",
+                        "RNTuple output is only supported when producing "
+                        "events, use the TTree output when reading input "
+                        "files.");
+      }
+      isNTuple_ = true;
+      treeName_ = params.getParameter<std::string>("tree_name", "LDMX_Events");
+    } else if (backend != "TTree") {
+      EXCEPTION_RAISE("InvalidConfig",
+                      "Unknown output backend '" + backend +
+                          "', it should be 'TTree' or 'RNTuple'.");
+    }
+    if (parent_ and parent_->isNTuple_) {
+      EXCEPTION_RAISE("InvalidConfig",
+                      "Events read from a RNTuple cannot be written to an "
+                      "output event file.");
+    }
 
-    if (parent_) {
+    // the branches are configured as they show up on the output tree
+    for (const auto &settings :
+         params.getParameter<std::vector<framework::config::Parameters>>(
+             "branchSettings", {})) {
+      auto pattern{settings.getParameter<std::string>("pattern")};
+      BranchSettings rule;
+      if (regcomp(&rule.pattern, pattern.c_str(),
+                  REG_EXTENDED | REG_ICASE | REG_NOSUB)) {
+        EXCEPTION_RAISE("InvalidRegex", "The branch settings pattern '" +
+                                            pattern +
+                                            "' is not a valid regex.");
+      }
+      rule.compression = settings.getParameter<int>("compressionSetting", -1);
+      rule.basketSize = settings.getParameter<int>("basketSize", 0);
+      branchSettings_.push_back(rule);
+    }
+    clusterSize_ = params.getParameter<int>("clusterSize", 0);
+
+    writeIndex_ = params.getParameter<bool>("eventIndex", false);
+    indexParameters_ = params.getParameter<std::vector<std::string>>(
+        "eventIndexParameters", {});
+
+    if (parent_ and friendOutput_ and fastSkim_) {
+      EXCEPTION_RAISE("InvalidConfig",
+                      "The products of the input files are not copied to a "
+                      "friend output, so there is nothing to skim fast.");
+    }
+
+    if (parent_ and not friendOutput_) {
       // output file when there are input files
       //  might be drop/keep rules, so we should have these rules to make sure
       //  it works
@@ -50,23 +116,94 @@ EventFile::EventFile(const framework::config::Parameters &params,
       reactivateRules_.push_back("*");
     }
   } else {
-    // open file with only reading enabled
-    file_ = new TFile(fileName_.c_str());
+    // the read-ahead of the files (for XRootD, a vector read of the baskets
+    //  the read cache asks for) is the same for all files opened from now on
+    auto readahead_size{params.getParameter<int>("readaheadSize", 0)};
+    if (readahead_size > 0) TFile::SetReadaheadSize(readahead_size << 20);
+
+    // open file with only reading enabled, TFile::Open picks the plugin for
+    //  remote files and takes over an asynchronous open of the file if one
+    //  was started (asyncOpen)
+    file_ = TFile::Open(fileName_.c_str());
     // double check that file is open
-    if (!file_->IsOpen()) {
+    if (!file_ or !file_->IsOpen()) {
       EXCEPTION_RAISE("FileError", "Input file '" + fileName_ +
                                        "' is not readable or does not exist.");
     }
 
     // Get the tree name from the configuration
-    auto tree_name{params.getParameter<std::string>("tree_name")};
-    tree_ = static_cast<TTree *>(file_->Get(tree_name.c_str()));
-    if (!tree_) {
-      EXCEPTION_RAISE("FileError", "File '" + fileName_ +
-                                       "' does not have a TTree named '" +
-                                       tree_name + "' in it.");
+    treeName_ = params.getParameter<std::string>("tree_name");
+    auto key{file_->GetKey(treeName_.c_str())};
+    isNTuple_ = key and std::string(key->GetClassName()).find("RNTuple") !=
+                            std::string::npos;
+    if (isNTuple_) {
+#ifdef FRAMEWORK_HAS_RNTUPLE
+      ntupleReader_ = rntuple::RNTupleReader::Open(treeName_, fileName_);
+      entries_ = ntupleReader_->GetNEntries();
+#else
+      EXCEPTION_RAISE("FileError",
+                      "File '" + fileName_ +
+                          "' stores its events in a RNTuple, which the "
+                          "version of ROOT ldmx-sw was built with cannot "
+                          "read.");
+#endif
+    } else {
+      tree_ = static_cast<TTree *>(file_->Get(treeName_.c_str()));
+      if (!tree_) {
+        EXCEPTION_RAISE("FileError", "File '" + fileName_ +
+                                         "' does not have a TTree named '" +
+                                         treeName_ + "' in it.");
+      }
+      entries_ = tree_->GetEntriesFast();
+      attachParents(file_, tree_);
+
+      if (lazyBranches_) {
+        // only read what is asked for, Event::getObject turns on each branch
+        // the first time it is requested and then it stays on for this file
+        tree_->SetBranchStatus("*", false);
+        tree_->SetBranchStatus("EventHeader*", true);
+      }
+
+      // each basket missing from the read cache is a read call of its own,
+      //  which is a round-trip when the file is read remotely
+      Long64_t cache_size{
+          Long64_t(params.getParameter<int>("readCacheSize", 0)) << 20};
+      auto prefetch_depth{params.getParameter<int>("prefetchDepth", 0)};
+      if (prefetch_depth > 0 and entries_ > 0) {
+        // size the read cache to hold the next prefetch_depth entries and
+        // let ROOT decompress the baskets in it off the processing thread
+        // this needs to be enabled before the cache is created
+        TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+        auto bytes_per_entry{tree_->GetZipBytes() / entries_ + 1};
+        cache_size = std::max(cache_size, bytes_per_entry * prefetch_depth);
+      }
+      if (cache_size > 0) {
+        auto learn_entries{params.getParameter<int>("cacheLearnEntries", 0)};
+        if (learn_entries > 0) tree_->SetCacheLearnEntries(learn_entries);
+        tree_->SetCacheSize(cache_size);
+        // when reading lazily, Event::getObject adds each branch to the
+        // cache as it turns it on
+        if (not lazyBranches_) tree_->AddBranchToCache("*", true);
+      }
+    }
+
+    auto selection{params.getParameter<std::string>("indexSelection", "")};
+    std::vector<std::pair<int, int>> events;
+    for (const auto &run_event :
+         params.getParameter<std::vector<framework::config::Parameters>>(
+             "indexEvents", {})) {
+      events.emplace_back(run_event.getParameter<int>("run"),
+                          run_event.getParameter<int>("event"));
+    }
+    if (not selection.empty() or not events.empty())
+      selectEntries(selection, events);
+
+    // only the entries in the range are visited, they are sought directly
+    //  so splitting a file over several jobs doesn't read it several times
+    if (not isLoopable_) {
+      auto range{params.getParameter<std::vector<int>>("inputEntryRange", {})};
+      if (not range.empty()) selectRange(range);
     }
-    entries_ = tree_->GetEntriesFast();
   }
 
   importRunHeaders();
@@ -90,11 +227,21 @@ EventFile::~EventFile() {
   if (isOutputFile_) {
     // make sure we are in output file before writing
     file_->cd();
-    tree_->Write();
+#ifdef FRAMEWORK_HAS_RNTUPLE
+    // the writer commits the RNTuple to the file when it is destroyed
+    ntupleEntry_.reset();
+    ntupleWriter_.reset();
+#endif
+    if (tree_) tree_->Write();
+    if (indexTree_) indexTree_->Write();
+    if (not parentNames_.empty())
+      file_->WriteObject(&parentNames_, PARENTS_NAME);
   }
 
   // Close the file
   file_->Close();
+
+  for (auto &rule : branchSettings_) regfree(&rule.pattern);
 }
 
 void EventFile::addDrop(const std::string &rule) {
@@ -157,6 +304,7 @@ void EventFile::addDrop(const std::string &rule) {
 }
 
 bool EventFile::nextEvent(bool storeCurrentEvent) {
+  performance::Trace::Scope trace_next(trace_, "nextEvent", "io");
   if (ientry_ < 0) {
     // first entry of this file
     if (parent_) {
@@ -168,7 +316,14 @@ bool EventFile::nextEvent(bool storeCurrentEvent) {
       // Only clone parent tree if either
       //  1) There is no tree setup yet (first input file)
       //  2) This is not single output (new input file --> new output file)
-      if (!tree_ or !isSingleOutput_) {
+      if (friendOutput_ and (!tree_ or !isSingleOutput_)) {
+        // only the header and the new products are written, the
+        //  products of the parent are joined back when reading
+        file_->cd();
+        tree_ = new TTree(parent_->tree_->GetName(),
+                          parent_->tree_->GetTitle());
+        parentNames_ = {parent_->fileName_};
+      } else if (!tree_ or !isSingleOutput_) {
         // clones parent_->tree_ to our tree_ keeping drop/keep rules in mind
         // clone tree (only copies over branches that are active on input tree)
 
@@ -181,18 +336,42 @@ bool EventFile::nextEvent(bool storeCurrentEvent) {
         tree_ = parent_->tree_->CloneTree(0);
 
         // reactivate any drop branches (drop) on input tree
-        for (auto const &rule : reactivateRules_)
-          parent_->tree_->SetBranchStatus(rule.c_str(), 1);
+        //  unless we are reading lazily, then only the branches
+        //  copied to the output stay on and the rest are left for
+        //  Event::getObject to turn on when requested
+        if (not lazyBranches_) {
+          for (auto const &rule : reactivateRules_)
+            parent_->tree_->SetBranchStatus(rule.c_str(), 1);
+        }
+        if (fastSkim_) deferClonedBranches();
       }
       event_->setInputTree(parent_->tree_);
-      event_->setOutputTree(tree_);
+      event_->setOutputTree(tree_, friendOutput_);
     }  // we have a parent file
   } else {
     // later than first entry of file
     if (isOutputFile_) {
       event_->beforeFill();
-      if (storeCurrentEvent)  // we should store before moving on
-        tree_->Fill();        // fill the clones...
+      if (not isNTuple_) configureNewBranches();
+      if (storeCurrentEvent and isNTuple_) {
+        performance::Trace::Scope trace_fill(trace_, "Fill", "io");
+        fillNTuple();
+      } else if (storeCurrentEvent and fastSkim_ and parent_) {
+        // only write what is new, the rest is copied later
+        performance::Trace::Scope trace_fill(trace_, "Fill", "io");
+        TObjArray *branches = tree_->GetListOfBranches();
+        for (int i = 0; i < branches->GetEntriesFast(); i++) {
+          auto branch{static_cast<TBranch *>(branches->At(i))};
+          if (std::find(deferredBranches_.begin(), deferredBranches_.end(),
+                        branch) == deferredBranches_.end())
+            branch->Fill();
+        }
+        keptEntries_.push_back(ientry_);
+      } else if (storeCurrentEvent) {  // we should store before moving on
+        performance::Trace::Scope trace_fill(trace_, "Fill", "io");
+        tree_->Fill();  // fill the clones...
+      }
+      if (storeCurrentEvent and writeIndex_) fillIndex();
     }                         // we are an output file
 
     // the event bus may not be defined
@@ -222,15 +401,25 @@ bool EventFile::nextEvent(bool storeCurrentEvent) {
     // we don't have a parent and
     //  we aren't an output file
     // try to load another entry from our tree
-    if (ientry_ + 1 >= entries_) {
-      if (isLoopable_) {
+    //  with an index selection, we step through the selected entries
+    //  the entries in the range or the selection are stepped through
+    if (iselected_ + 1 >= getEntries()) {
+      if (isLoopable_ and getEntries() > 0) {
         // reset the event counter: reuse events from start of pileup tree
-        ientry_ = -1;
+        iselected_ = -1;
       } else
         return false;
     }
-    ientry_++;
-    tree_->GetEntry(ientry_);
+    iselected_++;
+    ientry_ = entryAt(iselected_);
+    performance::Trace::Scope trace_read(trace_, "GetEntry", "io");
+    if (not isNTuple_) {
+      tree_->GetEntry(ientry_);
+    } else if (event_) {
+#ifdef FRAMEWORK_HAS_RNTUPLE
+      event_->readNTupleEntry(ientry_);
+#endif
+    }
   }
 
   // if we have an event_
@@ -242,7 +431,7 @@ void EventFile::setupEvent(Event *evt) {
   event_ = evt;
   if (isOutputFile_) {
     // we are an output file
-    if (!tree_ && !parent_) {
+    if (!tree_ && !parent_ && !isNTuple_) {
       // we don't have a tree and we don't have a parent
       //  ==> *Production Mode* create a new tree
       tree_ = event_->createTree();
@@ -262,17 +451,319 @@ void EventFile::setupEvent(Event *evt) {
   } else {
     // we are an input file
     //  so give our tree to the event as input tree
-    event_->setInputTree(tree_);
+    if (not isNTuple_) {
+      event_->setInputTree(tree_);
+    } else {
+#ifdef FRAMEWORK_HAS_RNTUPLE
+      event_->setInputNTuple(ntupleReader_.get());
+#endif
+    }
   }  // output or input file
 }
 
+void EventFile::copyKeptEntries() {
+  if (not isOutputFile_ or not parent_ or keptEntries_.empty()) return;
+  performance::Trace::Scope trace_copy(trace_, "copyKeptEntries", "io");
+
+  // pair up the input and output branches and turn the input ones
+  // back on (including their sub-branches)
+  std::vector<std::pair<TBranch *, TBranch *>> branches;
+  for (TBranch *out : deferredBranches_) {
+    TBranch *in{parent_->tree_->GetBranch(out->GetName())};
+    if (not in) continue;
+    parent_->tree_->SetBranchStatus((std::string(out->GetName()) + "*").c_str(),
+                                    true);
+    branches.emplace_back(in, out);
+  }
+
+  // the output branches share the address of the input branches, so
+  // reading an entry of the input branch puts it in the output branch
+  for (Long64_t entry : keptEntries_) {
+    for (auto &[in, out] : branches) {
+      in->GetEntry(entry);
+      out->Fill();
+    }
+  }
+  keptEntries_.clear();
+
+  // the branches were filled separately, so the tree needs to catch up
+  tree_->SetEntries(-1);
+}
+
+void EventFile::deferClonedBranches() {
+  deferredBranches_.clear();
+  TObjArray *branches = tree_->GetListOfBranches();
+  for (int i = 0; i < branches->GetEntriesFast(); i++) {
+    auto branch{static_cast<TBranch *>(branches->At(i))};
+    std::string name = branch->GetName();
+    // processors are allowed to update the header, so keep writing it
+    if (name.find("EventHeader") == 0) continue;
+    deferredBranches_.push_back(branch);
+    // Event::getObject turns this back on if a processor asks for it
+    parent_->tree_->SetBranchStatus((name + "*").c_str(), false);
+  }
+}
+
+void EventFile::configureNewBranches() {
+  if (nConfiguredBranches_ == 0 and clusterSize_ != 0)
+    tree_->SetAutoFlush(clusterSize_);
+  TObjArray *branches = tree_->GetListOfBranches();
+  for (int i = nConfiguredBranches_; i < branches->GetEntriesFast(); i++) {
+    auto branch{static_cast<TBranch *>(branches->At(i))};
+    for (const auto &rule : branchSettings_) {
+      if (regexec(&rule.pattern, branch->GetName(), 0, 0, 0) != 0) continue;
+      // both of these are passed down to the sub-branches by ROOT
+      if (rule.compression >= 0)
+        branch->SetCompressionSettings(rule.compression);
+      if (rule.basketSize > 0) branch->SetBasketSize(rule.basketSize);
+      break;
+    }
+  }
+  nConfiguredBranches_ = branches->GetEntriesFast();
+}
+
+void EventFile::fillNTuple() {
+#ifdef FRAMEWORK_HAS_RNTUPLE
+  auto new_fields{event_->getNewNTupleFields(ntupleFields_)};
+  if (not new_fields.empty()) {
+    if (not ntupleWriter_) {
+      auto model{rntuple::RNTupleModel::CreateBare()};
+      for (const auto &name : new_fields)
+        model->AddField(event_->makeField(name));
+      rntuple::RNTupleWriteOptions options;
+      options.SetCompression(compressionSetting_);
+      ntupleWriter_ = rntuple::RNTupleWriter::Append(
+          std::move(model), treeName_, *file_, options);
+    } else {
+      // products showing up after the first event extend the model,
+      // the earlier entries read back as default constructed objects
+      auto updater{ntupleWriter_->CreateModelUpdater()};
+      updater->BeginUpdate();
+      for (const auto &name : new_fields)
+        updater->AddField(event_->makeField(name));
+      updater->CommitUpdate();
+    }
+    ntupleFields_.insert(new_fields.begin(), new_fields.end());
+    // bind a new entry to the objects on the bus so they aren't copied
+    ntupleEntry_ = ntupleWriter_->CreateEntry();
+    for (const auto &name : ntupleFields_)
+      ntupleEntry_->BindRawPtr(name, event_->getAddress(name));
+  }
+  if (ntupleWriter_) ntupleWriter_->Fill(*ntupleEntry_);
+#endif
+}
+
+void EventFile::fillIndex() {
+  if (not indexTree_) {
+    file_->cd();
+    indexTree_ = new TTree(INDEX_TREE_NAME, "Index of the events");
+    indexTree_->Branch("entry", &indexEntry_);
+    indexTree_->Branch("run", &indexRun_);
+    indexTree_->Branch("event", &indexEvent_);
+    indexTree_->Branch("weight", &indexWeight_);
+    indexValues_.resize(indexParameters_.size());
+    for (std::size_t i{0}; i < indexParameters_.size(); i++) {
+      std::string branch{indexParameters_[i]};
+      for (char &c : branch) {
+        if (not std::isalnum(static_cast<unsigned char>(c))) c = '_';
+      }
+      indexTree_->Branch(branch.c_str(), &indexValues_[i]);
+    }
+  }
+
+  const auto &header{event_->getEventHeader()};
+  indexRun_ = header.getRun();
+  indexEvent_ = header.getEventNumber();
+  indexWeight_ = header.getWeight();
+  for (std::size_t i{0}; i < indexParameters_.size(); i++) {
+    const auto &name{indexParameters_[i]};
+    if (header.hasIntParameter(name))
+      indexValues_[i] = header.getIntParameter(name);
+    else if (header.hasFloatParameter(name))
+      indexValues_[i] = header.getFloatParameter(name);
+    else
+      indexValues_[i] = std::numeric_limits<double>::quiet_NaN();
+  }
+  indexTree_->Fill();
+  indexEntry_++;
+}
+
+void EventFile::selectEntries(const std::string &selection,
+                              const std::vector<std::pair<int, int>> &events) {
+  std::unique_ptr<TTree> index{
+      static_cast<TTree *>(file_->Get(INDEX_TREE_NAME))};
+  if (!index) {
+    EXCEPTION_RAISE("FileError",
+                    "File '" + fileName_ +
+                        "' does not have an event index to apply the index "
+                        "selection to, it needs to be written with the "
+                        "eventIndex parameter enabled.");
+  }
+
+  // the index is small, so it is read in full and the selection is
+  //  evaluated on each of its rows
+  std::unique_ptr<TTreeFormula> formula;
+  if (not selection.empty()) {
+    formula = std::make_unique<TTreeFormula>("indexSelection",
+                                             selection.c_str(), index.get());
+    if (formula->GetNdim() == 0) {
+      EXCEPTION_RAISE("InvalidConfig",
+                      "The index selection '" + selection +
+                          "' cannot be evaluated on the event index of '" +
+                          fileName_ + "'.");
+    }
+  }
+
+  // events listed with a negative run match the event number in any run
+  std::set<std::pair<int, int>> run_events;
+  std::set<int> any_run_events;
+  for (const auto &[run, event] : events) {
+    if (run < 0)
+      any_run_events.insert(event);
+    else
+      run_events.emplace(run, event);
+  }
+
+  Long64_t entry{0};
+  Int_t run{0}, event{0};
+  index->SetBranchAddress("entry", &entry);
+  index->SetBranchAddress("run", &run);
+  index->SetBranchAddress("event", &event);
+  selected_.clear();
+  for (Long64_t i{0}; i < index->GetEntries(); i++) {
+    index->GetEntry(i);
+    if (entry < 0 or entry >= entries_) continue;
+    if (not events.empty() and any_run_events.count(event) == 0 and
+        run_events.count({run, event}) == 0)
+      continue;
+    if (formula) {
+      formula->GetNdata();
+      if (formula->EvalInstance() == 0.) continue;
+    }
+    selected_.push_back(entry);
+  }
+  std::sort(selected_.begin(), selected_.end());
+  selected_.erase(std::unique(selected_.begin(), selected_.end()),
+                  selected_.end());
+  hasSelection_ = true;
+}
+
+void EventFile::selectRange(const std::vector<int> &range) {
+  if (range.size() != 2 or range[0] < 0 or
+      (range[1] >= 0 and range[1] < range[0])) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The input entry range should be two entries (start, "
+                    "stop) with 0 <= start <= stop, or stop < 0 to read up "
+                    "to the end of the file.");
+  }
+  Long64_t begin{std::min<Long64_t>(range[0], entries_)};
+  Long64_t end{range[1] < 0 ? entries_
+                            : std::min<Long64_t>(range[1], entries_)};
+  if (hasSelection_) {
+    selected_.erase(std::remove_if(selected_.begin(), selected_.end(),
+                                   [&](Long64_t entry) {
+                                     return entry < begin or entry >= end;
+                                   }),
+                    selected_.end());
+    return;
+  }
+  rangeBegin_ = begin;
+  entries_ = end - begin;
+  // the read-ahead stays within the range
+  if (tree_ and tree_->GetReadCache(file_))
+    tree_->SetCacheEntryRange(begin, end);
+}
+
+int EventFile::getPrefetchHits() const {
+  auto cache{dynamic_cast<TTreeCacheUnzip *>(
+      tree_ and file_ ? tree_->GetReadCache(file_) : nullptr)};
+  return cache ? cache->GetNFound() : 0;
+}
+
+int EventFile::getPrefetchWaits() const {
+  auto cache{dynamic_cast<TTreeCacheUnzip *>(
+      tree_ and file_ ? tree_->GetReadCache(file_) : nullptr)};
+  return cache ? cache->GetNMissed() : 0;
+}
+
+int EventFile::getReadCalls() const {
+  return isOutputFile_ or not file_ ? 0 : file_->GetReadCalls();
+}
+
+Long64_t EventFile::getBytesRead() const {
+  return isOutputFile_ or not file_ ? 0 : file_->GetBytesRead();
+}
+
+Long64_t EventFile::shrinkCache() {
+  if (isOutputFile_ or isNTuple_ or not tree_) return 0;
+  Long64_t size{tree_->GetCacheSize() / 2};
+  if (size > 0) tree_->SetCacheSize(size);
+  return size;
+}
+
+std::vector<std::tuple<std::string, Long64_t, Long64_t>>
+EventFile::getBranchSizes() {
+  std::vector<std::tuple<std::string, Long64_t, Long64_t>> sizes;
+  if (not isOutputFile_ or isNTuple_ or not tree_) return sizes;
+  tree_->FlushBaskets();
+  TObjArray *branches = tree_->GetListOfBranches();
+  for (int i = 0; i < branches->GetEntriesFast(); i++) {
+    auto branch{static_cast<TBranch *>(branches->At(i))};
+    sizes.emplace_back(branch->GetName(), branch->GetTotBytes("*"),
+                       branch->GetZipBytes("*"));
+  }
+  return sizes;
+}
+
+bool EventFile::checkpoint() {
+  if (not isOutputFile_ or isNTuple_ or fastSkim_ or not tree_) return false;
+  performance::Trace::Scope trace_save(trace_, "checkpoint", "io");
+  file_->cd();
+  // the trees are only saved here from now on, so that what is
+  //  recovered from the file matches the checkpoint
+  tree_->SetAutoSave(0);
+  tree_->AutoSave("SaveSelf");
+  if (indexTree_) {
+    indexTree_->SetAutoSave(0);
+    indexTree_->AutoSave("SaveSelf");
+  }
+  return true;
+}
+
 int EventFile::skipToEvent(int offset) {
-  // make sure the event number exists
-  ientry_ = offset % entries_ - 1;
-  return ientry_;
+  // the offset counts the entries visited, make sure the event number exists
+  if (getEntries() <= 0) return -1;
+  iselected_ = offset % getEntries() - 1;
+  ientry_ = iselected_ < 0 ? -1 : entryAt(iselected_);
+  return iselected_;
+}
+
+Long64_t EventFile::peekEntry(int offset,
+                              const std::vector<std::string> &branches) {
+  if (isNTuple_ or not tree_ or getEntries() <= 0) return 0;
+  // load the entry so the parents joined as friends follow along
+  Long64_t ientry{entryAt(offset % getEntries())};
+  tree_->LoadTree(ientry);
+  Long64_t bytes{0};
+  for (const std::string &name : branches) {
+    TBranch *branch{tree_->GetBranch(name.c_str())};
+    if (not branch) continue;
+    bytes += branch->GetEntry(branch->GetTree()->GetReadEntry(), 1);
+  }
+  if (event_) {
+    TBranch *header{tree_->GetBranch(ldmx::EventHeader::BRANCH.c_str())};
+    if (header) header->GetEntry(header->GetTree()->GetReadEntry(), 1);
+    event_->nextEvent();
+  }
+  return bytes;
 }
 
 void EventFile::updateParent(EventFile *parent) {
+  if (friendOutput_) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "A friend output is joined to a single input file, give "
+                    "an output file for each input file.");
+  }
   parent_ = parent;
 
   // we can assume parent_->tree_ is valid
@@ -291,8 +782,11 @@ void EventFile::updateParent(EventFile *parent) {
   parent_->tree_->CopyAddresses(tree_);
 
   // and reactivate any dropping rules
-  for (auto const &rule : reactivateRules_)
-    parent_->tree_->SetBranchStatus(rule.c_str(), 1);
+  if (not lazyBranches_) {
+    for (auto const &rule : reactivateRules_)
+      parent_->tree_->SetBranchStatus(rule.c_str(), 1);
+  }
+  if (fastSkim_) deferClonedBranches();
 
   // Reset the entry index with the new parent index
   ientry_ = parent_->ientry_;
@@ -338,8 +832,12 @@ void EventFile::writeRunTree() {
   runTree->Branch("RunHeader", "ldmx::RunHeader", &theHandle, 32000, 3);
 
   // copy over the run headers into the tree
+  //  the runs made here get the names of the event parameter keys
+  auto parameterNames{ldmx::EventHeader::getParameterNames()};
   for (auto &[num, header_pair] : runMap_) {
     theHandle = header_pair.second;
+    if (not header_pair.first)
+      theHandle->setEventParameterNames(parameterNames);
     runTree->Fill();
     if (header_pair.first) delete header_pair.second;
   }
@@ -384,18 +882,65 @@ void EventFile::importRunHeaders() {
   else if (isOutputFile_)
     return;  // output file, no input parent to read from
 
-  if (theImportFile) {
-    // the file exist
-    TTreeReader oldRunTree("LDMX_Run", theImportFile);
-    TTreeReaderValue<ldmx::RunHeader> oldRunHeader(oldRunTree, "RunHeader");
-    // TODO check that setup went correctly
-    while (oldRunTree.Next()) {
-      // copy input run tree into run map
-      runMap_[oldRunHeader->getRunNumber()] =
-          std::make_pair(true, new ldmx::RunHeader(*oldRunHeader));
+  if (theImportFile) readRunHeaders(theImportFile, true);
+
+  return;
+}
+
+void EventFile::importRunHeaders(const std::string &filename) {
+  std::unique_ptr<TFile> file{TFile::Open(filename.c_str())};
+  if (not file or file->IsZombie()) {
+    EXCEPTION_RAISE("FileError",
+                    "Unable to open '" + filename + "' to read its runs.");
+  }
+  readRunHeaders(file.get(), false);
+}
+
+void EventFile::attachParents(TFile *file, TTree *tree) {
+  std::vector<std::string> *names{nullptr};
+  file->GetObject(PARENTS_NAME, names);
+  if (not names) return;
+  std::unique_ptr<std::vector<std::string>> own_names{names};
+
+  std::string name{file->GetName()};
+  std::string directory{name.substr(0, name.rfind('/') + 1)};
+  for (const auto &parent_name : *names) {
+    std::unique_ptr<TFile> parent{TFile::Open(parent_name.c_str())};
+    if ((not parent or parent->IsZombie()) and parent_name.front() != '/' and
+        not directory.empty())
+      parent.reset(TFile::Open((directory + parent_name).c_str()));
+    if (not parent or parent->IsZombie()) {
+      EXCEPTION_RAISE("FileError", "Unable to open '" + parent_name +
+                                       "', the parent file of '" + name +
+                                       "'.");
+    }
+    TTree *parent_tree{nullptr};
+    parent->GetObject(tree->GetName(), parent_tree);
+    if (not parent_tree) {
+      EXCEPTION_RAISE("FileError", "The parent file '" + parent_name +
+                                       "' of '" + name +
+                                       "' does not have a TTree named '" +
+                                       tree->GetName() + "' in it.");
     }
+    // the entries are matched by the header, which both trees have
+    parent_tree->BuildIndex("EventHeader.run_", "EventHeader.eventNumber_");
+    tree->AddFriend(parent_tree, "parent");
+    parentFiles_.push_back(std::move(parent));
+    attachParents(parentFiles_.back().get(), parent_tree);
   }
+}
 
-  return;
+void EventFile::readRunHeaders(TFile *file, bool replace) {
+  TTreeReader oldRunTree("LDMX_Run", file);
+  TTreeReaderValue<ldmx::RunHeader> oldRunHeader(oldRunTree, "RunHeader");
+  // TODO check that setup went correctly
+  while (oldRunTree.Next()) {
+    int run{oldRunHeader->getRunNumber()};
+    if (not replace and runMap_.find(run) != runMap_.end()) continue;
+    // copy input run tree into run map
+    runMap_[run] = std::make_pair(true, new ldmx::RunHeader(*oldRunHeader));
+    ldmx::EventHeader::addParameterNames(
+        oldRunHeader->getEventParameterNames());
+  }
 }
 }  // namespace framework
@@ -1,6 +1,8 @@
 
 #include "Framework/EventHeader.h"
 
+#include <mutex>
+
 #include "Framework/Exception/Exception.h"
 
 ClassImp(ldmx::EventHeader);
@@ -8,12 +10,57 @@ ClassImp(ldmx::EventHeader);
 namespace ldmx {
 const std::string EventHeader::BRANCH = "EventHeader";
 
+namespace {
+
+/// the names of the keys known to this process
+std::map<EventHeader::Key, std::string> parameterNames;
+/// guard of the names, keys may be made by processors on several threads
+std::mutex parameterNamesMutex;
+
+}  // namespace
+
+EventHeader::Key EventHeader::hash(const std::string& name) {
+  Key hash{0x811c9dc5u};
+  for (unsigned char c : name) {
+    hash ^= c;
+    hash *= 0x01000193u;
+  }
+  return hash;
+}
+
+EventHeader::Key EventHeader::key(const std::string& name) {
+  Key k{hash(name)};
+  std::lock_guard<std::mutex> lock(parameterNamesMutex);
+  auto [it, inserted] = parameterNames.emplace(k, name);
+  if (not inserted and it->second != name) {
+    EXCEPTION_RAISE("ParamKey", "Parameters '" + name + "' and '" + it->second +
+                                    "' have the same key, rename one of them.");
+  }
+  return k;
+}
+
+std::map<EventHeader::Key, std::string> EventHeader::getParameterNames() {
+  std::lock_guard<std::mutex> lock(parameterNamesMutex);
+  return parameterNames;
+}
+
+void EventHeader::addParameterNames(const std::map<Key, std::string>& names) {
+  std::lock_guard<std::mutex> lock(parameterNamesMutex);
+  parameterNames.insert(names.begin(), names.end());
+}
+
 void EventHeader::Clear(Option_t*) {
   eventNumber_ = -1;
   run_ = -1;
   timestamp_ = TTimeStamp(0, 0);
   weight_ = 1.0;
   isRealData_ = false;
+  intKeys_.clear();
+  intValues_.clear();
+  floatKeys_.clear();
+  floatValues_.clear();
+  stringKeys_.clear();
+  stringValues_.clear();
   intParameters_.clear();
   floatParameters_.clear();
   stringParameters_.clear();
@@ -31,6 +78,8 @@ void EventHeader::Print(Option_t*) const {
 }
 
 int EventHeader::getIntParameter(const std::string& name) const {
+  std::size_t i{find(intKeys_, hash(name))};
+  if (i != NOT_FOUND) return intValues_[i];
   if (intParameters_.find(name) == intParameters_.end()) {
     EXCEPTION_RAISE("NoParam", "Parameter '" + name +
                                    "' does not exist in the int parameters.");
@@ -38,7 +87,18 @@ int EventHeader::getIntParameter(const std::string& name) const {
   return intParameters_.at(name);
 }
 
+int EventHeader::getIntParameter(Key key) const {
+  std::size_t i{find(intKeys_, key)};
+  if (i == NOT_FOUND) {
+    EXCEPTION_RAISE("NoParam", "Parameter with key " + std::to_string(key) +
+                                   " does not exist in the int parameters.");
+  }
+  return intValues_[i];
+}
+
 float EventHeader::getFloatParameter(const std::string& name) const {
+  std::size_t i{find(floatKeys_, hash(name))};
+  if (i != NOT_FOUND) return floatValues_[i];
   if (floatParameters_.find(name) == floatParameters_.end()) {
     EXCEPTION_RAISE("NoParam", "Parameter '" + name +
                                    "' does not exist in the float parameters.");
@@ -46,7 +106,18 @@ float EventHeader::getFloatParameter(const std::string& name) const {
   return floatParameters_.at(name);
 }
 
+float EventHeader::getFloatParameter(Key key) const {
+  std::size_t i{find(floatKeys_, key)};
+  if (i == NOT_FOUND) {
+    EXCEPTION_RAISE("NoParam", "Parameter with key " + std::to_string(key) +
+                                   " does not exist in the float parameters.");
+  }
+  return floatValues_[i];
+}
+
 std::string EventHeader::getStringParameter(const std::string& name) const {
+  std::size_t i{find(stringKeys_, hash(name))};
+  if (i != NOT_FOUND) return stringValues_[i];
   if (stringParameters_.find(name) == stringParameters_.end()) {
     EXCEPTION_RAISE(
         "NoParam",
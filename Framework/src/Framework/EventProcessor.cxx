@@ -1,5 +1,7 @@
 #include "Framework/EventProcessor.h"
 
+#include <mutex>
+
 // LDMX
 #include "Framework/PluginFactory.h"
 #include "Framework/Process.h"
@@ -8,6 +10,11 @@
 
 namespace framework {
 
+namespace {
+/// guard of the storage controllers, processors may run concurrently
+std::mutex storage_hint_mutex;
+}  // namespace
+
 EventProcessor::EventProcessor(const std::string &name, Process &process)
     : process_{process},
       name_{name},
@@ -32,13 +39,25 @@ TDirectory *EventProcessor::getHistoDirectory() {
 
 void EventProcessor::setStorageHint(framework::StorageControl::Hint hint,
                                     const std::string &purposeString) {
+  std::lock_guard<std::mutex> lock(storage_hint_mutex);
   process_.getStorageController().addHint(name_, hint, purposeString);
 }
 
+void EventProcessor::setStorageHint(const Event &event,
+                                    framework::StorageControl::Hint hint,
+                                    const std::string &purposeString) {
+  std::lock_guard<std::mutex> lock(storage_hint_mutex);
+  process_.getStorageController(event).addHint(name_, hint, purposeString);
+}
+
 int EventProcessor::getLogFrequency() const {
   return process_.getLogFrequency();
 }
 
+double EventProcessor::getMemoryHeadroom() const {
+  return process_.getMemoryHeadroom();
+}
+
 int EventProcessor::getRunNumber() const { return process_.getRunNumber(); }
 
 void EventProcessor::declare(const std::string &classname, int classtype,
@@ -68,6 +87,13 @@ void EventProcessor::createHistograms(
 Producer::Producer(const std::string &name, Process &process)
     : EventProcessor(name, process) {}
 
+void Producer::produceBatch(const std::vector<Event *> &events) {
+  EXCEPTION_RAISE("NotImplemented",
+                  "The producer '" + getName() +
+                      "' declared that it produces in batches, but it does "
+                      "not implement produceBatch.");
+}
+
 Analyzer::Analyzer(const std::string &name, Process &process)
     : EventProcessor(name, process) {}
 }  // namespace framework
@@ -69,6 +69,7 @@ void HistogramHelper::create(const std::string& name, const std::string& xLabel,
 
   // Insert it into the pool of histograms for later use
   HistogramPool::getInstance().insert(fullName, hist);
+  histograms_[name] = hist;
 }
 
 void HistogramHelper::create(const std::string& name, const std::string& xLabel,
@@ -94,6 +95,7 @@ void HistogramHelper::create(const std::string& name, const std::string& xLabel,
 
   // Insert it into the pool of histograms for later use
   HistogramPool::getInstance().insert(fullName, hist);
+  histograms_[name] = hist;
 }
 
 void HistogramHelper::create(const std::string& name, const std::string& xLabel,
@@ -120,6 +122,7 @@ void HistogramHelper::create(const std::string& name, const std::string& xLabel,
 
   // Insert it into the pool of histograms for later use
   HistogramPool::getInstance().insert(fullName, hist);
+  histograms_[name] = hist;
 }
 
 void HistogramHelper::create(const std::string& name, const std::string& xLabel,
@@ -158,5 +161,45 @@ void HistogramHelper::create(const std::string& name, const std::string& xLabel,
 
   // Insert it into the pool of histograms for later use
   HistogramPool::getInstance().insert(fullName, hist);
+  histograms_[name] = hist;
+}
+
+HistogramHelper::ID HistogramHelper::id(const std::string& name) {
+  TH1* hist{get(name)};
+  for (std::size_t i{0}; i < resolved_.size(); i++) {
+    if (resolved_[i].hist == hist) return ID(i);
+  }
+  Resolved r;
+  r.hist = hist;
+  r.hist2d = dynamic_cast<TH2*>(hist);
+  resolved_.push_back(r);
+  return ID(resolved_.size() - 1);
+}
+
+void HistogramHelper::setBufferSize(std::size_t n) {
+  // don't leave behind fills made with the old size
+  flush();
+  bufferSize_ = n;
+  for (auto& r : resolved_) {
+    r.x.reserve(n);
+    if (r.hist2d) r.y.reserve(n);
+    r.w.reserve(n);
+  }
+}
+
+void HistogramHelper::flush() {
+  for (auto& r : resolved_) flush(r);
+}
+
+void HistogramHelper::flush(Resolved& r) {
+  if (r.x.empty()) return;
+  if (r.hist2d) {
+    r.hist2d->FillN(r.x.size(), r.x.data(), r.y.data(), r.w.data());
+  } else {
+    r.hist->FillN(r.x.size(), r.x.data(), r.w.data());
+  }
+  r.x.clear();
+  r.y.clear();
+  r.w.clear();
 }
 }  // namespace framework
@@ -1,6 +1,7 @@
 #include "Framework/Logger.h"
 
 // STL
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <ostream>
@@ -13,6 +14,12 @@ namespace framework {
 
 namespace logging {
 
+level lowestLevel{debug};
+
+/// the asynchronous file sink, if there is one, to flush it when closing
+static boost::shared_ptr<sinks::asynchronous_sink<sinks::text_ostream_backend>>
+    asyncFileSink;
+
 level convertLevel(int &iLvl) {
   if (iLvl < 0)
     iLvl = 0;
@@ -27,10 +34,14 @@ logger makeLogger(const std::string &name) {
 }
 
 void open(const level termLevel, const level fileLevel,
-          const std::string &fileName) {
+          const std::string &fileName, bool fileAsync) {
   // some helpful types
   typedef sinks::text_ostream_backend ourSinkBack_t;
   typedef sinks::synchronous_sink<ourSinkBack_t> ourSinkFront_t;
+  typedef sinks::asynchronous_sink<ourSinkBack_t> ourAsyncSinkFront_t;
+
+  // messages below all of the sinks are skipped before they are formatted
+  lowestLevel = fileName.empty() ? termLevel : std::min(termLevel, fileLevel);
 
   // allow our logs to access common attributes, the ones availabe are
   //  "LineID"    : counter increments for each record being made (terminal or
@@ -49,18 +60,11 @@ void open(const level termLevel, const level fileLevel,
         boost::make_shared<ourSinkBack_t>();
     fileBack->add_stream(boost::make_shared<std::ofstream>(fileName));
 
-    boost::shared_ptr<ourSinkFront_t> fileSink =
-        boost::make_shared<ourSinkFront_t>(fileBack);
-
-    // this is where the logging level is set
-    fileSink->set_filter(log::expressions::attr<level>("Severity") >=
-                         fileLevel);
-
     // TODO change format to something helpful
     // Currently:
     //  [ Channel ] int severity : message
-    fileSink->set_formatter([](const log::record_view &view,
-                               log::formatting_ostream &os) {
+    auto formatter = [](const log::record_view &view,
+                        log::formatting_ostream &os) {
       os
           //                            <<
           //                            log::extract<boost::date_time::int_adapter>(
@@ -68,9 +72,25 @@ void open(const level termLevel, const level fileLevel,
           << " [ " << log::extract<std::string>("Channel", view) << " ] "
           << /*humanReadableLevel.at*/ (log::extract<level>("Severity", view))
           << " : " << view[log::expressions::smessage];
-    });
-
-    core->add_sink(fileSink);
+    };
+
+    if (fileAsync) {
+      // the records are queued and written by a dedicated thread
+      asyncFileSink = boost::make_shared<ourAsyncSinkFront_t>(fileBack);
+      // this is where the logging level is set
+      asyncFileSink->set_filter(log::expressions::attr<level>("Severity") >=
+                                fileLevel);
+      asyncFileSink->set_formatter(formatter);
+      core->add_sink(asyncFileSink);
+    } else {
+      boost::shared_ptr<ourSinkFront_t> fileSink =
+          boost::make_shared<ourSinkFront_t>(fileBack);
+      // this is where the logging level is set
+      fileSink->set_filter(log::expressions::attr<level>("Severity") >=
+                           fileLevel);
+      fileSink->set_formatter(formatter);
+      core->add_sink(fileSink);
+    }
   }  // file set to pass something
 
   // terminal sink is always created
@@ -110,6 +130,14 @@ void open(const level termLevel, const level fileLevel,
 }  // open
 
 void close() {
+  // write out what is still queued before the file is closed
+  if (asyncFileSink) {
+    log::core::get()->remove_sink(asyncFileSink);
+    asyncFileSink->stop();
+    asyncFileSink->flush();
+    asyncFileSink.reset();
+  }
+
   // prevents crashes on some systems when logging to a file
   log::core::get()->remove_all_sinks();
 
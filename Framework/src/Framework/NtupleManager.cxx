@@ -20,6 +20,7 @@ void NtupleManager::create(const std::string& name) {
 
   // Create a tree with the given name and add it to the list of trees.
   trees_[name] = new TTree{name.c_str(), name.c_str()};
+  if (clusterSize_ != 0) trees_[name]->SetAutoFlush(clusterSize_);
 }
 
 void NtupleManager::fill() {
@@ -29,6 +30,13 @@ void NtupleManager::fill() {
 
 void NtupleManager::clear() { bus_.clear(); }
 
+void NtupleManager::checkpoint() {
+  for (const auto& [name, tree] : trees_) {
+    tree->SetAutoSave(0);
+    tree->AutoSave("SaveSelf");
+  }
+}
+
 void NtupleManager::reset() {
   // we assume that ROOT handles clean-up
   //  of the TTrees when they are written to the output histogram file
@@ -0,0 +1,111 @@
+#include "Framework/Performance/Profile.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Framework/Performance/Trace.h"
+
+namespace framework::performance {
+
+namespace {
+
+/// one call of a site
+struct Call {
+  int site;
+  Profile::Clock::time_point start, end;
+};
+
+/// the calls and statistics recorded by one thread
+struct Buffer {
+  /// index of the thread in the trace
+  int tid;
+  /// statistics by site index
+  std::vector<Profile::Stat> stats;
+  /// calls not written to the trace yet
+  std::vector<Call> calls;
+};
+
+/// number of calls a thread buffers before writing them to the trace
+constexpr std::size_t MAX_CALLS{4096};
+
+/// guard for the site names and the list of buffers
+std::mutex registry_mutex;
+/// names of the sites by index
+std::vector<std::string> site_names;
+/// buffers of all of the threads that have recorded, never removed
+std::vector<std::unique_ptr<Buffer>> buffers;
+/// trace the calls are written to, may be null
+std::atomic<Trace *> trace{nullptr};
+
+/// get the buffer of the calling thread, registering it the first time
+Buffer &local_buffer() {
+  thread_local Buffer *buffer{nullptr};
+  if (not buffer) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    buffers.push_back(std::make_unique<Buffer>());
+    buffer = buffers.back().get();
+    buffer->tid = Trace::threadIndex();
+    buffer->calls.reserve(MAX_CALLS);
+  }
+  return *buffer;
+}
+
+/// write the calls of a buffer to the trace, if there is one, and clear them
+void write(Buffer &buffer) {
+  Trace *t{trace.load()};
+  if (t and not buffer.calls.empty()) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (const Call &call : buffer.calls) {
+      t->complete(site_names[call.site], "profile", call.start, call.end,
+                  buffer.tid);
+    }
+  }
+  buffer.calls.clear();
+}
+
+}  // namespace
+
+int Profile::site(const std::string &name) {
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  site_names.push_back(name);
+  return site_names.size() - 1;
+}
+
+void Profile::record(int site, Clock::time_point start, Clock::time_point end) {
+  Buffer &buffer{local_buffer()};
+  if (buffer.stats.size() <= std::size_t(site)) buffer.stats.resize(site + 1);
+  double ms{std::chrono::duration<double, std::milli>(end - start).count()};
+  Stat &stat{buffer.stats[site]};
+  stat.calls++;
+  stat.total += ms;
+  stat.max = std::max(stat.max, ms);
+  if (trace.load(std::memory_order_relaxed)) {
+    buffer.calls.push_back({site, start, end});
+    if (buffer.calls.size() >= MAX_CALLS) write(buffer);
+  }
+}
+
+void Profile::setTrace(Trace *t) { trace.store(t); }
+
+void Profile::flush() { write(local_buffer()); }
+
+std::map<std::string, Profile::Stat> Profile::collect() {
+  for (auto &buffer : buffers) write(*buffer);
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  std::map<std::string, Stat> stats;
+  for (const auto &buffer : buffers) {
+    for (std::size_t i{0}; i < buffer->stats.size(); i++) {
+      const Stat &from{buffer->stats[i]};
+      if (from.calls == 0) continue;
+      Stat &to{stats[site_names[i]]};
+      to.calls += from.calls;
+      to.total += from.total;
+      to.max = std::max(to.max, from.max);
+    }
+  }
+  return stats;
+}
+
+}  // namespace framework::performance
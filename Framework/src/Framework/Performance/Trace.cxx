@@ -0,0 +1,82 @@
+#include "Framework/Performance/Trace.h"
+
+#include <atomic>
+
+#include "Framework/Exception/Exception.h"
+
+namespace framework::performance {
+
+namespace {
+
+/// write the input string escaped for JSON
+void write_escaped(std::ostream &s, const std::string &str) {
+  for (char c : str) {
+    if (c == '"' or c == '\\') s << '\\';
+    s << c;
+  }
+}
+
+}  // namespace
+
+int Trace::threadIndex() {
+  static std::atomic<int> n_threads{0};
+  thread_local int index{n_threads++};
+  return index;
+}
+
+Trace::Trace(const std::string &filename)
+    : file_{filename}, origin_{std::chrono::steady_clock::now()} {
+  if (not file_.is_open()) {
+    EXCEPTION_RAISE("FileError", "Unable to open trace file '" + filename +
+                                     "' for writing.");
+  }
+  file_ << "[\n";
+}
+
+Trace::~Trace() {
+  file_ << "\n]\n";
+  file_.close();
+}
+
+void Trace::begin(const std::string &name, const std::string &category) {
+  write('B', name, category);
+}
+
+void Trace::end(const std::string &name, const std::string &category) {
+  write('E', name, category);
+}
+
+void Trace::write(char phase, const std::string &name,
+                  const std::string &category) {
+  double ts{std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - origin_)
+                .count()};
+  int tid{threadIndex()};
+  std::lock_guard<std::mutex> lock(mutex_);
+  writeNames(name, category);
+  file_ << ",\"ph\":\"" << phase << "\",\"ts\":" << std::fixed << ts
+        << ",\"pid\":1,\"tid\":" << tid << "}";
+}
+
+void Trace::complete(const std::string &name, const std::string &category,
+                     std::chrono::steady_clock::time_point start,
+                     std::chrono::steady_clock::time_point end, int tid) {
+  double ts{std::chrono::duration<double, std::micro>(start - origin_).count()};
+  double dur{std::chrono::duration<double, std::micro>(end - start).count()};
+  std::lock_guard<std::mutex> lock(mutex_);
+  writeNames(name, category);
+  file_ << ",\"ph\":\"X\",\"ts\":" << std::fixed << ts
+        << ",\"dur\":" << dur << ",\"pid\":1,\"tid\":" << tid << "}";
+}
+
+void Trace::writeNames(const std::string &name, const std::string &category) {
+  if (not first_) file_ << ",\n";
+  first_ = false;
+  file_ << "{\"name\":\"";
+  write_escaped(file_, name);
+  file_ << "\",\"cat\":\"";
+  write_escaped(file_, category);
+  file_ << "\"";
+}
+
+}  // namespace framework::performance
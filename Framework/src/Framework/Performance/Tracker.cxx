@@ -1,12 +1,17 @@
 #include "Framework/Performance/Tracker.h"
 
+#include <algorithm>
+
 namespace framework::performance {
 
 const std::string Tracker::ALL = "__ALL__";
 
 Tracker::Tracker(TDirectory* storage_directory,
-                 const std::vector<std::string>& names)
-    : storage_directory_{storage_directory} {
+                 const std::vector<std::string>& names, bool track_usage,
+                 const std::string& trace_file, int profile_every)
+    : storage_directory_{storage_directory},
+      track_usage_{track_usage},
+      profile_every_{profile_every} {
   /**
    * Create the event-by-event data TTree while within
    * the storage directory. This means the event data TTree
@@ -36,6 +41,21 @@ Tracker::Tracker(TDirectory* storage_directory,
   for (std::vector<Timer>& timer_set : processor_timers_) {
     timer_set.resize(names_.size());
   }
+  for (std::size_t i_cb{0}; i_cb < processor_timers_.size(); i_cb++) {
+    callback_names_.push_back(to_name(static_cast<Callback>(i_cb)));
+  }
+  if (not trace_file.empty()) trace_ = new Trace(trace_file);
+  if (profile_every_ > 0) {
+    Profile::setTrace(trace_);
+    // when sampling every event, also record outside of the event callbacks
+    Profile::enable(profile_every_ == 1);
+  }
+  if (track_usage_) {
+    processor_usage_.resize(processor_timers_.size());
+    for (std::vector<Usage>& usage_set : processor_usage_) {
+      usage_set.resize(names_.size());
+    }
+  }
 
   /**
    * Attach the processor timers to the event-by-event data
@@ -58,12 +78,25 @@ Tracker::Tracker(TDirectory* storage_directory,
   for (std::size_t i{0}; i < names_.size(); i++) {
     event_data_->Branch((names_[i] + ".").c_str(),
                         &(processor_timers_[to_index(Callback::process)][i]));
+    if (track_usage_) {
+      event_data_->Branch(
+          (names_[i] + "_usage.").c_str(),
+          &(processor_usage_[to_index(Callback::process)][i]));
+    }
   }
 }
 
 Tracker::~Tracker() {
+  std::map<std::string, Profile::Stat> profile;
+  if (profile_every_ > 0) {
+    Profile::enable(false);
+    profile = Profile::collect();
+    Profile::setTrace(nullptr);
+  }
+  if (trace_) delete trace_;
   storage_directory_->cd();
   absolute_.write(storage_directory_, "absolute");
+  if (track_usage_) absolute_usage_.write(storage_directory_, "absolute_usage");
 
   /**
    * Write the non-event callbacks in their own directories,
@@ -79,23 +112,120 @@ Tracker::~Tracker() {
     for (std::size_t i_proc{0}; i_proc < names_.size(); i_proc++) {
       processor_timers_[to_index(callback)][i_proc].write(callback_d,
                                                           names_[i_proc]);
+      if (track_usage_) {
+        processor_usage_[to_index(callback)][i_proc].write(
+            callback_d, names_[i_proc] + "_usage");
+      }
     }
   }
+
+  /**
+   * Write the sizes of the products as one entry per product so they
+   * can be sorted and compared directly
+   */
+  if (not products_.empty()) {
+    storage_directory_->cd();
+    TTree products("products", "products");
+    std::string name;
+    Long64_t events, max_memory, tot_bytes, zip_bytes;
+    double mean_memory;
+    products.Branch("name", &name);
+    products.Branch("events", &events);
+    products.Branch("mean_memory", &mean_memory);
+    products.Branch("max_memory", &max_memory);
+    products.Branch("tot_bytes", &tot_bytes);
+    products.Branch("zip_bytes", &zip_bytes);
+    for (const auto& [branch, size] : products_) {
+      name = branch;
+      events = size.events;
+      mean_memory = size.events > 0 ? size.memory / size.events : 0.;
+      max_memory = size.max_memory;
+      tot_bytes = size.tot_bytes;
+      zip_bytes = size.zip_bytes;
+      products.Fill();
+    }
+    products.Write();
+  }
+
+  /**
+   * Write the time of the Profile sites, one entry per site, with the
+   * total, mean and longest time of their calls in ms
+   */
+  if (not profile.empty()) {
+    storage_directory_->cd();
+    TTree sites("profile", "profile");
+    std::string name;
+    Long64_t calls;
+    double total, mean, max;
+    sites.Branch("name", &name);
+    sites.Branch("calls", &calls);
+    sites.Branch("total", &total);
+    sites.Branch("mean", &mean);
+    sites.Branch("max", &max);
+    for (const auto& [site, stat] : profile) {
+      name = site;
+      calls = stat.calls;
+      total = stat.total;
+      mean = stat.total / stat.calls;
+      max = stat.max;
+      sites.Fill();
+    }
+    sites.Write();
+  }
 }
 
-void Tracker::absolute_start() { absolute_.start(); }
+void Tracker::absolute_start() {
+  if (trace_) trace_->begin("run", "absolute");
+  absolute_.start();
+  if (track_usage_) absolute_usage_.start();
+}
 
-void Tracker::absolute_stop() { absolute_.stop(); }
+void Tracker::absolute_stop() {
+  if (track_usage_) absolute_usage_.stop();
+  absolute_.stop();
+  if (trace_) trace_->end("run", "absolute");
+}
 
 void Tracker::start(Callback callback, std::size_t i_proc) {
+  if (callback == Callback::process and i_proc == 0) {
+    // sample the events the Profile scopes are recorded in
+    if (profile_every_ > 1) Profile::enable(n_events_ % profile_every_ == 0);
+    n_events_++;
+  }
+  if (trace_)
+    trace_->begin(names_[i_proc], callback_names_[to_index(callback)]);
   processor_timers_[to_index(callback)][i_proc].start();
+  // start measuring usage last (and stop it first) so that it
+  // doesn't include the timer
+  if (track_usage_) processor_usage_[to_index(callback)][i_proc].start();
 }
 
 void Tracker::stop(Callback callback, std::size_t i_proc) {
+  if (track_usage_) processor_usage_[to_index(callback)][i_proc].stop();
   processor_timers_[to_index(callback)][i_proc].stop();
+  if (trace_)
+    trace_->end(names_[i_proc], callback_names_[to_index(callback)]);
+}
+
+void Tracker::product_sizes(
+    const std::vector<std::pair<std::string, std::size_t>>& sizes) {
+  for (const auto& [branch, bytes] : sizes) {
+    ProductSize& size{products_[branch]};
+    size.events++;
+    size.memory += bytes;
+    size.max_memory = std::max<long int>(size.max_memory, bytes);
+  }
+}
+
+void Tracker::product_storage(const std::string& branch, long int tot_bytes,
+                              long int zip_bytes) {
+  ProductSize& size{products_[branch]};
+  size.tot_bytes += tot_bytes;
+  size.zip_bytes += zip_bytes;
 }
 
 void Tracker::end_event(bool completed) {
+  if (profile_every_ > 0) Profile::flush();
   event_completed_ = completed;
   event_data_->Fill();
   /**
@@ -105,6 +235,8 @@ void Tracker::end_event(bool completed) {
    */
   for (std::size_t i_proc{0}; i_proc < names_.size(); i_proc++) {
     processor_timers_[to_index(Callback::process)][i_proc].reset();
+    if (track_usage_)
+      processor_usage_[to_index(Callback::process)][i_proc].reset();
   }
 }
 
@@ -0,0 +1,189 @@
+#include "Framework/Performance/Usage.h"
+
+#include <time.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef LDMX_PERF_COUNTERS
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+ClassImp(framework::performance::Usage);
+
+namespace {
+
+/**
+ * Allocations made through operator new by this thread
+ *
+ * These are plain thread-local integers so counting costs next to
+ * nothing and the worker threads don't contend on them.
+ */
+thread_local long int n_allocs_by_thread{0};
+thread_local long int alloc_bytes_by_thread{0};
+
+/// get the CPU time used by this thread so far in nanoseconds
+long int thread_cpu_ns() {
+  timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) return 0;
+  return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+/// get the resident set size of the program in kilobytes
+long int rss_kb() {
+  static const long int page_kb{sysconf(_SC_PAGESIZE) / 1024};
+  long int size{0}, resident{0};
+  FILE* statm = std::fopen("/proc/self/statm", "r");
+  if (not statm) return 0;
+  if (std::fscanf(statm, "%ld %ld", &size, &resident) != 2) resident = 0;
+  std::fclose(statm);
+  return resident * page_kb;
+}
+
+#ifdef LDMX_PERF_COUNTERS
+/**
+ * The hardware counters of the thread that first used them
+ *
+ * They are opened as a group so that they are scheduled onto the
+ * PMU together and read with one system call.
+ */
+class HardwareCounters {
+ public:
+  static HardwareCounters& get() {
+    static HardwareCounters the_counters;
+    return the_counters;
+  }
+
+  /// @return true if we were able to open the counters
+  bool available() const { return fds_[0] >= 0; }
+
+  /// read the counters into the input array
+  bool read(long int values[3]) const {
+    // layout of PERF_FORMAT_GROUP reads: nr followed by the values
+    struct {
+      uint64_t nr;
+      uint64_t values[3];
+    } data;
+    if (not available() or ::read(fds_[0], &data, sizeof(data)) < 0 or
+        data.nr != 3)
+      return false;
+    for (int i{0}; i < 3; i++) values[i] = data.values[i];
+    return true;
+  }
+
+ private:
+  HardwareCounters() {
+    const uint64_t configs[3] = {PERF_COUNT_HW_INSTRUCTIONS,
+                                 PERF_COUNT_HW_CACHE_MISSES,
+                                 PERF_COUNT_HW_BRANCH_MISSES};
+    for (int i{0}; i < 3; i++) {
+      perf_event_attr attr{};
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = configs[i];
+      attr.disabled = (i == 0);
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP;
+      fds_[i] = syscall(__NR_perf_event_open, &attr, 0, -1,
+                        i == 0 ? -1 : fds_[0], 0);
+      if (fds_[i] < 0) {
+        close_all();
+        return;
+      }
+    }
+    ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+
+  ~HardwareCounters() { close_all(); }
+
+  void close_all() {
+    for (int& fd : fds_) {
+      if (fd >= 0) close(fd);
+      fd = -1;
+    }
+  }
+
+  int fds_[3] = {-1, -1, -1};
+};
+#endif
+
+}  // namespace
+
+/**
+ * Replacements of the global operator new and delete so we can count
+ * the allocations made by each thread
+ *
+ * The aligned and nothrow versions from the standard library are
+ * implemented on top of these, so they are counted as well.
+ */
+void* operator new(std::size_t size) {
+  n_allocs_by_thread++;
+  alloc_bytes_by_thread += size;
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return ::operator new(size); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace framework::performance {
+
+void Usage::reset() {
+  cpu_time_ = -1;
+  rss_delta_ = 0;
+  n_allocs_ = -1;
+  alloc_bytes_ = -1;
+  instructions_ = -1;
+  cache_misses_ = -1;
+  branch_misses_ = -1;
+}
+
+long int Usage::residentMemory() { return rss_kb(); }
+
+void Usage::start() {
+#ifdef LDMX_PERF_COUNTERS
+  HardwareCounters::get().read(begin_counters_);
+#endif
+  begin_rss_kb_ = rss_kb();
+  begin_allocs_ = n_allocs_by_thread;
+  begin_alloc_bytes_ = alloc_bytes_by_thread;
+  begin_cpu_ns_ = thread_cpu_ns();
+}
+
+void Usage::stop() {
+  cpu_time_ = (thread_cpu_ns() - begin_cpu_ns_) * 1e-9;
+  n_allocs_ = n_allocs_by_thread - begin_allocs_;
+  alloc_bytes_ = alloc_bytes_by_thread - begin_alloc_bytes_;
+  rss_delta_ = rss_kb() - begin_rss_kb_;
+#ifdef LDMX_PERF_COUNTERS
+  long int counters[3];
+  if (HardwareCounters::get().read(counters)) {
+    instructions_ = counters[0] - begin_counters_[0];
+    cache_misses_ = counters[1] - begin_counters_[1];
+    branch_misses_ = counters[2] - begin_counters_[2];
+  }
+#endif
+}
+
+double Usage::cpu_time() const { return cpu_time_; }
+
+long int Usage::allocations() const { return n_allocs_; }
+
+void Usage::write(TDirectory* location, const std::string& name) const {
+  location->WriteObject(this, name.c_str());
+}
+
+}  // namespace framework::performance
@@ -5,28 +5,126 @@
 
 #include "Framework/Process.h"
 
+#include <regex.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <thread>
 
+#include "Framework/ConfigurePython.h"
 #include "Framework/Event.h"
 #include "Framework/EventFile.h"
 #include "Framework/EventProcessor.h"
 #include "Framework/Exception/Exception.h"
 #include "Framework/Logger.h"
 #include "Framework/NtupleManager.h"
+#include "Framework/Performance/Usage.h"
 #include "Framework/PluginFactory.h"
 #include "Framework/RunHeader.h"
 #include "TFile.h"
+#include "TFileMerger.h"
+#include "TH1.h"
 #include "TROOT.h"
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
 
 namespace framework {
 
+namespace {
+
+/// name of the run header parameter holding the hash of a producer
+std::string productHashKey(const std::string &producer) {
+  return "ProductHash " + producer;
+}
+
+/// FNV-1a hash of the text, continuing from the input hash
+uint64_t fnv1a(const std::string &text,
+               uint64_t hash = 0xcbf29ce484222325ull) {
+  for (unsigned char c : text) {
+    hash ^= c;
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+/**
+ * Read the hashes of the producers recorded in the runs of the files
+ *
+ * Only the hashes that are the same in all of the runs of all of the
+ * files are returned.
+ */
+std::map<std::string, std::string> readProductHashes(
+    const std::vector<std::string> &files) {
+  std::map<std::string, std::string> hashes;
+  bool first{true};
+  for (const auto &name : files) {
+    std::unique_ptr<TFile> file{TFile::Open(name.c_str())};
+    if (not file or file->IsZombie()) {
+      EXCEPTION_RAISE("FileError",
+                      "Unable to open '" + name + "' to read its runs.");
+    }
+    TTreeReader runs("LDMX_Run", file.get());
+    TTreeReaderValue<ldmx::RunHeader> header(runs, "RunHeader");
+    while (runs.Next()) {
+      std::map<std::string, std::string> in_run;
+      const std::string prefix{productHashKey("")};
+      for (const auto &[key, value] : header->getStringParameters()) {
+        if (key.compare(0, prefix.size(), prefix) == 0)
+          in_run.emplace(key.substr(prefix.size()), value);
+      }
+      if (first) {
+        hashes = std::move(in_run);
+        first = false;
+        continue;
+      }
+      for (auto it{hashes.begin()}; it != hashes.end();) {
+        auto other{in_run.find(it->first)};
+        if (other == in_run.end() or other->second != it->second)
+          it = hashes.erase(it);
+        else
+          ++it;
+      }
+    }
+  }
+  return hashes;
+}
+
+}  // namespace
+
+thread_local Process::Slot *Process::currentSlot_{nullptr};
+
 Process::Process(const framework::config::Parameters &configuration)
     : conditions_{*this} {
   config_ = configuration;
 
   passname_ = configuration.getParameter<std::string>("passName", "");
   histoFilename_ = configuration.getParameter<std::string>("histogramFile", "");
+  histoSnapshotFilename_ =
+      configuration.getParameter<std::string>("histogramSnapshotFile", "");
+  histoSnapshotEvents_ =
+      configuration.getParameter<int>("histogramSnapshotEvents", 0);
+  histoSnapshotSeconds_ =
+      configuration.getParameter<int>("histogramSnapshotSeconds", 0);
+  histoAggregationDir_ = configuration.getParameter<std::string>(
+      "histogramAggregationDirectory", "");
   logFileName_ = configuration.getParameter<std::string>("logFileName", "");
+  logFileAsync_ = configuration.getParameter<bool>("logFileAsync", false);
 
   maxTries_ = configuration.getParameter<int>("maxTriesPerEvent", 1);
   eventLimit_ = configuration.getParameter<int>("maxEvents", -1);
@@ -55,6 +153,124 @@ Process::Process(const framework::config::Parameters &configuration)
     PluginFactory::getInstance().loadLibrary(lib);
   });
 
+  auto n_threads{configuration.getParameter<int>("n_threads", 1)};
+  if (n_threads < 1) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The number of threads must be at least one, but " +
+                        std::to_string(n_threads) + " was given.");
+  }
+  auto batch_size{configuration.getParameter<int>("batchSize", 1)};
+  if (batch_size < 1) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The batch size must be at least one, but " +
+                        std::to_string(batch_size) + " was given.");
+  }
+  if (batch_size > 1 and n_threads > 1) {
+    // the events of a batch all go through the same processors
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The events can be processed in batches or with several "
+                    "threads, but not both.");
+  }
+  batching_ = batch_size > 1;
+
+  scheduleWindow_ = configuration.getParameter<int>("scheduleWindow", 0);
+  if (scheduleWindow_ < 0) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The schedule window cannot be negative, but " +
+                        std::to_string(scheduleWindow_) + " was given.");
+  }
+  costBranches_ = configuration.getParameter<std::vector<std::string>>(
+      "costBranches", {});
+
+  auto memory_budget{configuration.getParameter<int>("memoryBudget", 0)};
+  if (memory_budget < 0) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The memory budget cannot be negative, but " +
+                        std::to_string(memory_budget) + " MB was given.");
+  }
+  memoryBudget_ = long(memory_budget) * 1024;
+  memoryDumpFile_ =
+      configuration.getParameter<std::string>("memoryDumpFile", "");
+
+  nSequenceThreads_ = configuration.getParameter<int>("n_sequence_threads", 1);
+  if (nSequenceThreads_ < 1) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The number of sequence threads must be at least one, "
+                    "but " +
+                        std::to_string(nSequenceThreads_) + " was given.");
+  }
+  if (nSequenceThreads_ > 1 and (n_threads > 1 or batching_)) {
+    // the slots already keep the threads busy with whole events
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The processors of the sequence can be run concurrently "
+                    "or the events can be processed with several threads "
+                    "(or in batches), but not both.");
+  }
+  // make sure ROOT is ready for us to open files and create histograms
+  // from several threads before we do any of that
+  if (n_threads > 1 or nSequenceThreads_ > 1) ROOT::EnableThreadSafety();
+
+  // the read-ahead of the input files decompresses baskets on ROOT's
+  // implicit thread pool, so we need one to be around
+  auto prefetch_depth{configuration.getParameter<int>("prefetchDepth", 0)};
+  if (prefetch_depth < 0) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The prefetch depth cannot be negative, but " +
+                        std::to_string(prefetch_depth) + " was given.");
+  }
+  if (prefetch_depth > 0 and not ROOT::IsImplicitMTEnabled())
+    ROOT::EnableImplicitMT(std::max(2, n_threads));
+
+  // the read cache and read-ahead of the input files are set up by EventFile
+  for (const std::string name :
+       {"readCacheSize", "cacheLearnEntries", "readaheadSize"}) {
+    auto value{configuration.getParameter<int>(name, 0)};
+    if (value < 0) {
+      EXCEPTION_RAISE("InvalidConfig", "The " + name +
+                                           " cannot be negative, but " +
+                                           std::to_string(value) +
+                                           " was given.");
+    }
+  }
+  asyncOpen_ = configuration.getParameter<bool>("asyncOpen", false);
+
+  nFileWorkers_ = configuration.getParameter<int>("n_file_workers", 1);
+  if (nFileWorkers_ < 1) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The number of file workers must be at least one, but " +
+                        std::to_string(nFileWorkers_) + " was given.");
+  }
+  if (nFileWorkers_ > 1 and (n_threads > 1 or prefetch_depth > 0)) {
+    // the workers are forked and threads do not survive a fork
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The input files can be spread over several workers or "
+                    "processed with several threads, but not both.");
+  }
+
+  checkpointFilename_ =
+      configuration.getParameter<std::string>("checkpointFile", "");
+  checkpointEvents_ =
+      configuration.getParameter<int>("checkpointEvents", 1000);
+  if (not checkpointFilename_.empty()) {
+    if (n_threads > 1 or batching_ or nFileWorkers_ > 1) {
+      EXCEPTION_RAISE("InvalidConfig",
+                      "Checkpoints are only written when the events are "
+                      "processed one at a time, without threads, batches or "
+                      "file workers.");
+    }
+    if (configuration.getParameter<bool>("fastSkim", false) or
+        configuration.getParameter<bool>("friendOutput", false) or
+        configuration.getParameter<std::string>("outputBackend", "TTree") !=
+            "TTree") {
+      EXCEPTION_RAISE("InvalidConfig",
+                      "Checkpoints can only be written for output files "
+                      "written with TTrees, without fast skimming and "
+                      "that aren't friend outputs.");
+    }
+    // the histogram file needs to be set aside before anyone opens it
+    if (configuration.getParameter<bool>("resume", false)) prepareResume();
+  }
+
   storageController_.setDefaultKeep(
       configuration.getParameter<bool>("skimDefaultIsKeep", true));
   auto skimRules{
@@ -63,6 +279,9 @@ Process::Process(const framework::config::Parameters &configuration)
     storageController_.addRule(skimRules[i], skimRules[i + 1]);
   }
 
+  NtupleManager::getInstance().setClusterSize(
+      configuration.getParameter<int>("ntupleClusterSize", 0));
+
   auto sequence{
       configuration.getParameter<std::vector<framework::config::Parameters>>(
           "sequence", {})};
@@ -73,27 +292,54 @@ Process::Process(const framework::config::Parameters &configuration)
         "No sequence has been defined. What should I be doing?\nUse "
         "p.sequence to tell me what processors to run.");
   }
+  parallelStart_ = configuration.getParameter<bool>("parallelStart", false);
   for (auto proc : sequence) {
-    auto className{proc.getParameter<std::string>("className")};
-    auto instanceName{proc.getParameter<std::string>("instanceName")};
-    EventProcessor *ep = PluginFactory::getInstance().createEventProcessor(
-        className, instanceName, *this);
-    if (ep == 0) {
-      EXCEPTION_RAISE(
-          "UnableToCreate",
-          "Unable to create instance '" + instanceName + "' of class '" +
-              className +
-              "'. Did you load the library that this class is apart of?");
-    }
-    auto histograms{
-        proc.getParameter<std::vector<framework::config::Parameters>>(
-            "histograms", {})};
-    if (!histograms.empty()) {
-      ep->getHistoDirectory();
-      ep->createHistograms(histograms);
-    }
-    ep->configure(proc);
-    sequence_.push_back(ep);
+    auto begin{std::chrono::steady_clock::now()};
+    sequence_.push_back(createProcessor(proc));
+    configureTimes_.push_back(std::chrono::duration<double>(
+                                  std::chrono::steady_clock::now() - begin)
+                                  .count());
+  }
+  hashProducers(sequence);
+  if (configuration.getParameter<bool>("reuseProducts", false))
+    reuseProducts(sequence);
+  if (configuration.getParameter<bool>("pruneUnusedProducers", false))
+    pruneSequence(sequence);
+  validateSequence();
+  compileSequence(sequence);
+
+  if (n_threads > 1) {
+    // the primary slot runs the sequence above and the other
+    // slots each get their own copy of it
+    for (int i_slot{0}; i_slot < n_threads; i_slot++) {
+      Slot *slot = new Slot;
+      slot->index = i_slot;
+      slot->event = new Event(passname_);
+      slot->storageController = storageController_;
+      slots_.push_back(slot);
+      if (i_slot == 0) {
+        slot->sequence = sequence_;
+      } else {
+        slot->ownsSequence = true;
+        currentSlot_ = slot;
+        for (auto proc : sequence) {
+          slot->sequence.push_back(createProcessor(proc));
+        }
+        currentSlot_ = nullptr;
+      }
+    }
+    nThreads_ = n_threads;
+  } else if (batching_) {
+    // each event of a batch is held by its own slot,
+    // but they are all run through the primary sequence
+    for (int i_slot{0}; i_slot < batch_size; i_slot++) {
+      Slot *slot = new Slot;
+      slot->index = i_slot;
+      slot->event = new Event(passname_);
+      slot->storageController = storageController_;
+      slot->sequence = sequence_;
+      slots_.push_back(slot);
+    }
   }
 
   auto conditionsObjectProviders{
@@ -107,16 +353,35 @@ Process::Process(const framework::config::Parameters &configuration)
     conditions_.createConditionsObjectProvider(className, objectName, tagName,
                                                cop);
   }
+  auto prefetch_threads{
+      configuration.getParameter<int>("conditionsPrefetchThreads", 0)};
+  if (prefetch_threads < 0) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The number of conditions prefetch threads cannot be "
+                    "negative, but " +
+                        std::to_string(prefetch_threads) + " was given.");
+  }
+  conditions_.setPrefetchThreads(prefetch_threads);
 
   bool logPerformance =
       configuration.getParameter<bool>("logPerformance", false);
   if (logPerformance) {
+    if (not slots_.empty()) {
+      ldmx_log(warn) << "The per-event processor timing is not recorded "
+                        "when running with more than one thread or when "
+                        "processing events in batches.";
+    }
     std::vector<std::string> names{sequence_.size()};
     for (std::size_t i{0}; i < sequence_.size(); i++) {
       names[i] = sequence_[i]->getName();
     }
-    performance_ =
-        new performance::Tracker(makeHistoDirectory("performance"), names);
+    performance_ = new performance::Tracker(
+        makeHistoDirectory("performance"), names,
+        configuration.getParameter<bool>("logResourceUsage", false),
+        configuration.getParameter<std::string>("performanceTraceFile", ""),
+        configuration.getParameter<int>("performanceProfileEvery", 1));
+    logProductSizes_ =
+        configuration.getParameter<bool>("logProductSizes", false);
   }
 }
 
@@ -127,51 +392,179 @@ Process::~Process() {
   for (EventProcessor *ep : sequence_) {
     delete ep;
   }
+  for (Slot *slot : slots_) {
+    // the primary slot (and the slots of a batch) are sharing sequence_
+    if (slot->ownsSequence) {
+      for (EventProcessor *ep : slot->sequence) delete ep;
+    }
+    delete slot->event;
+    delete slot;
+  }
   if (histoTFile_) {
     histoTFile_->Write();
     delete histoTFile_;
     histoTFile_ = 0;
   }
+  if (histogramParts_ > 0 and not mergeParts(histoFilename_, histogramParts_))
+    ldmx_log(error) << "Unable to merge the parts of '" << histoFilename_
+                    << "' set aside when resuming, they are left as they are.";
 }
 
 void Process::run() {
   if (performance_) performance_->absolute_start();
   // set up the logging for this run
+  //  the thread writing the file asynchronously would not be in the
+  //  forked file workers, so they write to it directly
   logging::open(logging::convertLevel(termLevelInt_),
                 logging::convertLevel(fileLevelInt_),
-                logFileName_  // if this is empty string, no file is logged to
-  );
+                logFileName_,  // if this is empty string, no file is logged to
+                logFileAsync_ and nFileWorkers_ <= 1);
+
+  // spread the input files over several workers, the parent
+  // has nothing left to do once the workers are all done
+  if (nFileWorkers_ > 1 and not inputFiles_.empty() and
+      not forkFileWorkers()) {
+    logging::close();
+    return;
+  }
 
-  // Counter to keep track of the number of events that have been
-  // procesed
-  auto n_events_processed{0};
+  // event bus for this process
+  Event theEvent(passname_);
+
+  startProcessing(theEvent);
+  processFiles(theEvent);
+  endProcessing();
+
+  // we're done so let's close up the logging
+  logging::close();
+  if (performance_) performance_->absolute_stop();
+}
+
+void Process::serve(const std::string &spool) {
+  if (performance_) performance_->absolute_start();
+  logging::open(logging::convertLevel(termLevelInt_),
+                logging::convertLevel(fileLevelInt_), logFileName_,
+                logFileAsync_);
+
+  if (nFileWorkers_ > 1) {
+    ldmx_log(warn) << "The input files of the jobs are not spread over file "
+                   << "workers when serving, they are processed here.";
+    nFileWorkers_ = 1;
+  }
+  if (not checkpointFilename_.empty()) {
+    ldmx_log(warn) << "Checkpoints are not written when serving.";
+    checkpointFilename_.clear();
+  }
+
+  // the defaults of the jobs are the configured files and limits
+  const auto configured_inputs{inputFiles_};
+  const auto configured_outputs{outputFiles_};
+  const int configured_run{runForGeneration_}, configured_limit{eventLimit_};
+
+  Event theEvent(passname_);
+  startProcessing(theEvent);
+
+  namespace fs = std::filesystem;
+  ldmx_log(info) << "Serving the jobs put into " << spool;
+  while (not fs::exists(fs::path(spool) / "stop")) {
+    // claim the oldest job by name, renaming it is atomic so
+    //  several servers can share a spool directory
+    std::vector<fs::path> jobs;
+    for (const auto &entry : fs::directory_iterator(spool)) {
+      if (entry.path().extension() == ".job") jobs.push_back(entry.path());
+    }
+    std::sort(jobs.begin(), jobs.end());
+    fs::path claimed;
+    for (const auto &job : jobs) {
+      std::error_code error;
+      fs::path running{job};
+      running.replace_extension(".running");
+      fs::rename(job, running, error);
+      if (not error) {
+        claimed = running;
+        break;
+      }
+    }
+    if (claimed.empty()) {
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+      continue;
+    }
+
+    fs::path finished{claimed};
+    try {
+      inputFiles_.clear();
+      outputFiles_.clear();
+      runForGeneration_ = configured_run;
+      eventLimit_ = configured_limit;
+      std::ifstream job_file(claimed);
+      std::string line;
+      while (std::getline(job_file, line)) {
+        std::istringstream words(line);
+        std::string key, value;
+        if (not(words >> key >> value) or key[0] == '#') continue;
+        if (key == "input") {
+          inputFiles_.push_back(value);
+        } else if (key == "output") {
+          outputFiles_.push_back(value);
+        } else if (key == "run") {
+          runForGeneration_ = std::stoi(value);
+        } else if (key == "maxEvents") {
+          eventLimit_ = std::stoi(value);
+        } else {
+          ldmx_log(warn) << "Unknown job setting '" << key << "' in "
+                         << claimed;
+        }
+      }
+      if (inputFiles_.empty() and outputFiles_.empty()) {
+        inputFiles_ = configured_inputs;
+        outputFiles_ = configured_outputs;
+      }
 
+      ldmx_log(info) << "Starting job " << claimed.stem().string();
+      theEvent.getEventHeader().setRun(runForGeneration_);
+      processFiles(theEvent);
+      finished.replace_extension(".done");
+    } catch (const exception::Exception &e) {
+      ldmx_log(error) << "Job " << claimed.stem().string() << " failed ["
+                      << e.name() << "] : " << e.message();
+      finished.replace_extension(".failed");
+    } catch (const std::exception &e) {
+      ldmx_log(error) << "Job " << claimed.stem().string()
+                      << " failed : " << e.what();
+      finished.replace_extension(".failed");
+    }
+    fs::rename(claimed, finished);
+    ldmx_log(info) << "Finished job " << claimed.stem().string();
+  }
+  ldmx_log(info) << "Stopped serving the jobs put into " << spool;
+
+  endProcessing();
+  logging::close();
+  if (performance_) performance_->absolute_stop();
+}
+
+void Process::startProcessing(Event &theEvent) {
   // make sure the ntuple manager is in a blank state
   NtupleManager::getInstance().reset();
 
-  // event bus for this process
-  Event theEvent(passname_);
   // the EventHeader object is created with the event bus as
   // one of its members, we obtain a pointer for the header
   // here so we can share it with the conditions system
   eventHeader_ = theEvent.getEventHeaderPtr();
   theEvent.getEventHeader().setRun(runForGeneration_);
+  for (Slot *slot : slots_) {
+    slot->event->getEventHeader().setRun(runForGeneration_);
+  }
 
   // Start by notifying everyone that modules processing is beginning
-  std::size_t i_proc{0};
-  if (performance_)
-    performance_->start(performance::Callback::onProcessStart, 0);
-  conditions_.onProcessStart();
-  for (auto module : sequence_) {
-    i_proc++;
-    if (performance_)
-      performance_->start(performance::Callback::onProcessStart, i_proc);
-    module->onProcessStart();
-    if (performance_)
-      performance_->stop(performance::Callback::onProcessStart, i_proc);
-  }
-  if (performance_)
-    performance_->stop(performance::Callback::onProcessStart, 0);
+  startProcessors();
+}
+
+void Process::processFiles(Event &theEvent) {
+  // Counter to keep track of the number of events that have been
+  // procesed, a resumed job carries on from where its checkpoint was written
+  auto n_events_processed{resumeFrom_.events};
+  lastHistoSnapshot_ = std::chrono::steady_clock::now();
 
   // If we have no input files, but do have an event number, run for
   // that number of events and generate an output file.
@@ -201,7 +594,7 @@ void Process::run() {
 
     newRun(runHeader);
 
-    int totalTries = 0;  // total number of tries for entire run
+    int totalTries = resumeFrom_.tries;  // total number of tries for run
     int numTries = 0;    // number of tries for the current event number
     int event_limit = eventLimit_;
     if (totalEvents_ > 0) {
@@ -211,6 +604,10 @@ void Process::run() {
                           "maxTriesPerEvent will be ignored!";
       event_limit = totalEvents_;
     }
+    if (not slots_.empty()) {
+      totalTries =
+          produceInSlots(outFile, theEvent, event_limit, n_events_processed);
+    }
     while (n_events_processed < event_limit) {
       totalTries++;
       numTries++;
@@ -239,6 +636,9 @@ void Process::run() {
       }
 
       NtupleManager::getInstance().clear();
+      snapshotHistograms(n_events_processed);
+      checkMemory(theEvent, nullptr);
+      checkpoint(&outFile, n_events_processed, totalTries, -1, 0);
     }
 
     onFileClose(outFile);
@@ -246,6 +646,7 @@ void Process::run() {
     runHeader.setRunEnd(std::time(nullptr));
     runHeader.setNumTries(totalTries);
     ldmx_log(info) << runHeader;
+    recordProductStorage(outFile);
     outFile.writeRunTree();
 
     // Give a warning that this filter has very low efficiency
@@ -275,9 +676,20 @@ void Process::run() {
     // next, loop through the files
     int ifile = 0;
     int wasRun = -1;
-    for (auto infilename : inputFiles_) {
+    for (int i_file{nextInputFile(-1)}; i_file < int(inputFiles_.size());
+         i_file = nextInputFile(i_file)) {
+      // the files before the checkpoint were done already
+      if (i_file < resumeFrom_.file) continue;
+      const std::string &infilename{inputFiles_[i_file]};
       EventFile inFile(config_, infilename);
 
+      // start opening the next input file while this one is processed,
+      //  TFile::Open in EventFile takes it over; the file workers don't know
+      //  which file they take next
+      if (asyncOpen_ and not fileQueue_ and
+          i_file + 1 < int(inputFiles_.size()))
+        TFile::AsyncOpen(inputFiles_[i_file + 1].c_str());
+
       ldmx_log(info) << "Opening file " << infilename;
       onFileOpen(inFile);
 
@@ -289,8 +701,11 @@ void Process::run() {
         // 2) this is the first input file
         if (!singleOutput or ifile == 0) {
           // setup new output file
-          outFile = new EventFile(config_, outputFiles_[ifile], &inFile,
+          const std::string &outfilename{
+              outputFiles_[singleOutput ? 0 : i_file]};
+          outFile = new EventFile(config_, outfilename, &inFile,
                                   singleOutput);
+          if (performance_) outFile->setTrace(performance_->trace());
           ifile++;
 
           // setup theEvent we will iterate over
@@ -299,11 +714,18 @@ void Process::run() {
             masterFile = outFile;
           } else {
             EXCEPTION_RAISE("Process", "Unable to construct output file for " +
-                                           outputFiles_[ifile]);
+                                           outfilename);
           }
 
           for (auto rule : dropKeepRules_) outFile->addDrop(rule);
 
+          // the runs of the input files done before the checkpoint
+          //  go into the same output file
+          if (singleOutput) {
+            for (int j_file{0}; j_file < resumeFrom_.file; j_file++)
+              outFile->importRunHeaders(inputFiles_[j_file]);
+          }
+
         } else {
           // all other input files
           outFile->updateParent(&inFile);
@@ -317,10 +739,27 @@ void Process::run() {
         masterFile = &inFile;
       }
 
+      if (not slots_.empty()) {
+        processFileInSlots(infilename, *masterFile, !outputFiles_.empty(),
+                           theEvent, n_events_processed, wasRun);
+      }
+
+      if (i_file == resumeFrom_.file) {
+        inFile.skipToEvent(resumeFrom_.entry);
+        ldmx_log(info) << "Resuming " << infilename << " at entry "
+                       << resumeFrom_.entry;
+      }
+
       bool event_completed = true;
-      while (masterFile->nextEvent(
+      while (slots_.empty() and
+             masterFile->nextEvent(
                  storageController_.keepEvent(event_completed)) &&
              (eventLimit_ < 0 || (n_events_processed) < eventLimit_)) {
+        // the events before this one are all written out, so this
+        //  is the one to start from when resuming
+        checkpoint(outFile, n_events_processed, 0, i_file,
+                   inFile.getPosition());
+
         // clean up for storage control calculation
         storageController_.resetEventState();
 
@@ -346,6 +785,8 @@ void Process::run() {
         NtupleManager::getInstance().clear();
 
         n_events_processed++;
+        snapshotHistograms(n_events_processed);
+        checkMemory(theEvent, &inFile);
       }  // loop through events
 
       bool leave_early{false};
@@ -359,13 +800,28 @@ void Process::run() {
         leave_early = true;
       }
 
+      // the kept events need the input file to finish being written
+      if (outFile) outFile->copyKeptEntries();
+
       ldmx_log(info) << "Closing file " << infilename;
+      if (auto n_baskets{inFile.getPrefetchHits() + inFile.getPrefetchWaits()};
+          n_baskets > 0) {
+        ldmx_log(info) << "Waited on " << inFile.getPrefetchWaits() << " of "
+                       << n_baskets << " baskets read ahead from "
+                       << infilename;
+      }
+      inputReadCalls_ += inFile.getReadCalls();
+      inputBytesRead_ += inFile.getBytesRead();
+      ldmx_log(info) << "Read " << inFile.getBytesRead() << " bytes in "
+                     << inFile.getReadCalls() << " read calls from "
+                     << infilename;
       onFileClose(inFile);
 
       // Reset the event in case of multiple input files
       theEvent.onEndOfFile();
 
       if (outFile and !singleOutput) {
+        recordProductStorage(*outFile);
         outFile->writeRunTree();
         delete outFile;
         outFile = nullptr;
@@ -379,6 +835,7 @@ void Process::run() {
     if (outFile) {
       // close outFile
       //  outFile would survive to here in single output mode
+      recordProductStorage(*outFile);
       outFile->writeRunTree();
       delete outFile;
       outFile = nullptr;
@@ -386,30 +843,84 @@ void Process::run() {
 
   }  // are there input files? if-else tree
 
+  // the output file the job was resumed in is complete now,
+  //  so it can take in the parts that were set aside
+  if (outputParts_ > 0 and not mergeParts(resumeFrom_.output, outputParts_)) {
+    EXCEPTION_RAISE("Resume", "Unable to merge the parts of '" +
+                                  resumeFrom_.output +
+                                  "' set aside when resuming.");
+  }
+  outputParts_ = 0;
+  if (not checkpointFilename_.empty()) std::remove(checkpointFilename_.c_str());
+}
+
+void Process::endProcessing() {
+  if (inputReadCalls_ > 0) {
+    ldmx_log(info) << "Read " << inputBytesRead_
+                   << " bytes from the input files in " << inputReadCalls_
+                   << " read calls";
+  }
+
   // finally, notify everyone that we are stopping
   if (performance_) performance_->start(performance::Callback::onProcessEnd, 0);
-  i_proc = 0;
+  // the copies in the other slots finish up first so that their histograms
+  // are complete when they are merged into the primary slot's histograms
+  forEachCopy([](EventProcessor *module) {
+    module->flushHistograms();
+    module->onProcessEnd();
+  });
+  mergeSlotHistograms();
+  std::size_t i_proc{0};
   for (auto module : sequence_) {
     i_proc++;
     if (performance_)
       performance_->start(performance::Callback::onProcessEnd, i_proc);
+    module->flushHistograms();
     module->onProcessEnd();
     if (performance_)
       performance_->stop(performance::Callback::onProcessEnd, i_proc);
   }
   if (performance_) performance_->stop(performance::Callback::onProcessEnd, 0);
 
-  // we're done so let's close up the logging
-  logging::close();
-  if (performance_) performance_->absolute_stop();
+  writeHistogramChunk();
 }
 
 int Process::getRunNumber() const {
-  return (eventHeader_) ? (eventHeader_->getRun()) : (runForGeneration_);
+  const ldmx::EventHeader *header{getEventHeader()};
+  return (header) ? (header->getRun()) : (runForGeneration_);
+}
+
+const ldmx::EventHeader *Process::getEventHeader() const {
+  if (currentSlot_) return currentSlot_->event->getEventHeaderPtr();
+  return eventHeader_;
+}
+
+StorageControl &Process::getStorageController() {
+  if (currentSlot_) return currentSlot_->storageController;
+  return storageController_;
+}
+
+StorageControl &Process::getStorageController(const Event &event) {
+  for (Slot *slot : slots_) {
+    if (slot->event == &event) return slot->storageController;
+  }
+  return getStorageController();
+}
+
+std::size_t Process::getSlotIndex() const {
+  return currentSlot_ ? currentSlot_->index : 0;
 }
 
 TDirectory *Process::makeHistoDirectory(const std::string &dirName) {
   auto owner{openHistoFile()};
+  if (currentSlot_ and currentSlot_->ownsSequence) {
+    // the copies of processors in the other slots get their own
+    // directories which are merged into the primary ones at the end
+    std::string slotDirName{"slot" + std::to_string(currentSlot_->index)};
+    TDirectory *slotDir = owner->GetDirectory(slotDirName.c_str());
+    if (!slotDir) slotDir = owner->mkdir(slotDirName.c_str());
+    owner = slotDir;
+  }
   TDirectory *child = owner->mkdir((char *)dirName.c_str());
   if (child) child->cd();
   return child;
@@ -437,6 +948,14 @@ TDirectory *Process::openHistoFile() {
 }
 
 void Process::newRun(ldmx::RunHeader &header) {
+  // record what the products of this pass were made with, so a later
+  // process can tell if it can reuse them
+  for (auto module : sequence_) {
+    auto hash{productHashes_.find(module->getName())};
+    if (hash != productHashes_.end())
+      header.setStringParameter(productHashKey(hash->first), hash->second);
+  }
+
   // Producers are allowed to put parameters into
   // the run header through 'beforeNewRun' method
   if (performance_) performance_->start(performance::Callback::beforeNewRun, 0);
@@ -465,7 +984,18 @@ void Process::newRun(ldmx::RunHeader &header) {
     if (performance_)
       performance_->stop(performance::Callback::onNewRun, i_proc);
   }
+  forEachCopy([&header](EventProcessor *module) { module->onNewRun(header); });
   if (performance_) performance_->stop(performance::Callback::onNewRun, 0);
+
+  // the processors carry on from their state at the checkpoint
+  //  rather than from the start of the run
+  for (auto module : sequence_) {
+    auto state{resumeStates_.find(module->getName())};
+    if (state == resumeStates_.end()) continue;
+    std::istringstream stream(state->second);
+    module->onResume(stream);
+  }
+  resumeStates_.clear();
 }
 
 bool Process::process(int n, Event &event) const {
@@ -477,37 +1007,1349 @@ bool Process::process(int n, Event &event) const {
                    << t.AsString("lc") << ")";
   }
 
+  if (sequenceGraphBuilt_) return processConcurrently(event);
+
+  // record the products used by each processor until we know
+  // which processors can run at the same time
+  bool recording{nSequenceThreads_ > 1};
+  if (recording and accesses_.empty()) accesses_.resize(sequence_.size());
+
   if (performance_) performance_->start(performance::Callback::process, 0);
   std::size_t i_proc{0};
+  bool all_ran{true};
   try {
-    for (auto module : sequence_) {
+    for (const Step &step : steps_) {
       i_proc++;
+      if (step.condition and
+          not step.condition->accepts(event, storageController_)) {
+        all_ran = false;
+        continue;
+      }
+      if (recording) event.recordAccesses(&accesses_[i_proc - 1]);
       if (performance_)
         performance_->start(performance::Callback::process, i_proc);
-      if (dynamic_cast<Producer *>(module)) {
-        (dynamic_cast<Producer *>(module))->produce(event);
-      } else if (dynamic_cast<Analyzer *>(module)) {
-        (dynamic_cast<Analyzer *>(module))->analyze(event);
+      if (step.producer) {
+        step.producer->produce(event);
+      } else if (step.analyzer) {
+        step.analyzer->analyze(event);
       }
       if (performance_)
         performance_->stop(performance::Callback::process, i_proc);
     }
   } catch (AbortEventException &) {
+    event.recordAccesses(nullptr);
     if (performance_) {
       performance_->stop(performance::Callback::process, i_proc);
       performance_->stop(performance::Callback::process, 0);
+      if (logProductSizes_)
+        performance_->product_sizes(event.getProductSizes());
       performance_->end_event(false);
     }
     return false;
   }
+  event.recordAccesses(nullptr);
   if (performance_) {
     performance_->stop(performance::Callback::process, 0);
+    if (logProductSizes_) performance_->product_sizes(event.getProductSizes());
     performance_->end_event(true);
   }
+  // the first event through the whole sequence has shown us
+  // the products the processors use
+  if (recording and all_ran) buildSequenceGraph();
   return true;
 }
 
+void Process::buildSequenceGraph() const {
+  std::size_t n_procs{sequence_.size()};
+  for (std::size_t i{0}; i < n_procs; i++) {
+    const auto &inputs{sequence_[i]->getDeclaredInputs()};
+    const auto &outputs{sequence_[i]->getDeclaredOutputs()};
+    accesses_[i].reads.insert(inputs.begin(), inputs.end());
+    accesses_[i].writes.insert(outputs.begin(), outputs.end());
+  }
+  auto overlap = [](const std::set<std::string> &a,
+                    const std::set<std::string> &b) {
+    return std::any_of(a.begin(), a.end(),
+                       [&b](const std::string &name) { return b.count(name); });
+  };
+  auto conflict = [&overlap](const ProductAccesses &earlier,
+                             const ProductAccesses &later) {
+    return overlap(earlier.writes, later.reads) or
+           overlap(earlier.reads, later.writes) or
+           overlap(earlier.writes, later.writes) or
+           (earlier.searched and not later.writes.empty()) or
+           (later.searched and not earlier.writes.empty());
+  };
+
+  // a processor only run if another passed needs to wait for its hints
+  //  and the hints we listen to are only read once they are all in
+  auto gated = [this](std::size_t i, std::size_t j) {
+    const RunCondition &earlier{runConditions_[i]}, &later{runConditions_[j]};
+    return std::find(later.after.begin(), later.after.end(), i) !=
+               later.after.end() or
+           (later.skimDependent and earlier.listened) or
+           (earlier.skimDependent and later.listened);
+  };
+
+  waitsFor_.assign(n_procs, 0);
+  dependents_.assign(n_procs, {});
+  for (std::size_t j{0}; j < n_procs; j++) {
+    std::string waits;
+    for (std::size_t i{0}; i < j; i++) {
+      if (conflict(accesses_[i], accesses_[j]) or gated(i, j)) {
+        dependents_[i].push_back(j);
+        waitsFor_[j]++;
+        waits += " " + sequence_[i]->getName();
+      }
+    }
+    ldmx_log(debug) << sequence_[j]->getName() << " waits for"
+                    << (waits.empty() ? " nothing" : waits);
+  }
+  accesses_.clear();
+  sequenceGraphBuilt_ = true;
+}
+
+void Process::validateSequence() const {
+  std::map<std::string, std::string> added_by;
+  for (auto module : sequence_) {
+    for (const auto &output : module->getDeclaredOutputs()) {
+      auto [it, inserted] = added_by.emplace(output, module->getName());
+      if (not inserted) {
+        EXCEPTION_RAISE("InvalidSequence",
+                        "Both '" + it->second + "' and '" +
+                            module->getName() + "' declare that they add '" +
+                            output + "' to the event.");
+      }
+    }
+  }
+  std::set<std::string> added;
+  for (auto module : sequence_) {
+    for (const auto &input : module->getDeclaredInputs()) {
+      auto producer{added_by.find(input)};
+      if (producer != added_by.end() and added.count(input) == 0) {
+        ldmx_log(warn) << module->getName() << " reads '" << input
+                       << "' which is only added later by "
+                       << producer->second;
+      }
+    }
+    const auto &outputs{module->getDeclaredOutputs()};
+    added.insert(outputs.begin(), outputs.end());
+  }
+}
+
+void Process::pruneSequence(
+    std::vector<framework::config::Parameters> &sequence) {
+  // the inputs of the processors that remain after the current one
+  std::set<std::string> needed;
+  // the processors the ones remaining after the current one are run after
+  std::set<std::string> gates;
+  for (std::size_t i{sequence_.size()}; i > 0; i--) {
+    EventProcessor *module{sequence_[i - 1]};
+    const auto &outputs{module->getDeclaredOutputs()};
+    bool unused{dynamic_cast<Producer *>(module) and not outputs.empty() and
+                not storageController_.listensTo(module->getName()) and
+                gates.count(module->getName()) == 0 and
+                sequence[i - 1]
+                    .getParameter<std::vector<framework::config::Parameters>>(
+                        "histograms", {})
+                    .empty()};
+    for (const auto &output : outputs) {
+      if (needed.count(output) or not isDropped(output)) unused = false;
+    }
+    if (unused) {
+      ldmx_log(info) << "Removing " << module->getName()
+                     << " from the sequence since none of its outputs are "
+                        "used or saved";
+      delete module;
+      sequence_.erase(sequence_.begin() + (i - 1));
+      sequence.erase(sequence.begin() + (i - 1));
+      configureTimes_.erase(configureTimes_.begin() + (i - 1));
+    } else {
+      const auto &inputs{module->getDeclaredInputs()};
+      needed.insert(inputs.begin(), inputs.end());
+      auto passed{sequence[i - 1].getParameter<std::vector<std::string>>(
+          "onlyIfPassed", {})};
+      gates.insert(passed.begin(), passed.end());
+    }
+  }
+}
+
+void Process::hashProducers(
+    const std::vector<framework::config::Parameters> &sequence) {
+  // the conditions and random seeds can change any of the products
+  std::map<std::string, std::any> conditions;
+  for (const char *key : {"conditionsGlobalTag", "conditionsObjectProviders",
+                          "randomNumberSeedService"}) {
+    auto it{config_.getParameters().find(key)};
+    if (it != config_.getParameters().end()) conditions.emplace(*it);
+  }
+  framework::config::Parameters conditions_params;
+  conditions_params.setParameters(conditions);
+  uint64_t base{fnv1a(ConfigurePython::toJSON(conditions_params))};
+
+  // hash of the producer adding each collection
+  std::map<std::string, uint64_t> added_by;
+  for (std::size_t i_proc{0}; i_proc < sequence_.size(); i_proc++) {
+    EventProcessor *module{sequence_[i_proc]};
+    uint64_t hash{fnv1a(ConfigurePython::toJSON(sequence[i_proc]), base)};
+    for (const auto &input : module->getDeclaredInputs()) {
+      auto producer{added_by.find(input)};
+      if (producer != added_by.end())
+        hash = fnv1a(std::to_string(producer->second), hash);
+    }
+    for (const auto &output : module->getDeclaredOutputs())
+      added_by[output] = hash;
+    if (dynamic_cast<Producer *>(module)) {
+      std::ostringstream hex;
+      hex << std::hex << std::setw(16) << std::setfill('0') << hash;
+      productHashes_[module->getName()] = hex.str();
+    }
+  }
+}
+
+void Process::reuseProducts(
+    std::vector<framework::config::Parameters> &sequence) {
+  if (inputFiles_.empty()) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "Products can only be reused from input files, but no "
+                    "input files were given.");
+  }
+  auto recorded{readProductHashes(inputFiles_)};
+
+  // the processors others are only run after
+  std::set<std::string> gates;
+  for (const auto &proc : sequence) {
+    auto passed{proc.getParameter<std::vector<std::string>>("onlyIfPassed",
+                                                            {})};
+    gates.insert(passed.begin(), passed.end());
+  }
+
+  for (std::size_t i{0}; i < sequence_.size();) {
+    EventProcessor *module{sequence_[i]};
+    const std::string name{module->getName()};
+    auto hash{productHashes_.find(name)};
+    auto old{recorded.find(name)};
+    if (hash == productHashes_.end() or old == recorded.end()) {
+      i++;
+      continue;
+    }
+    const auto &outputs{module->getDeclaredOutputs()};
+    bool reusable{old->second == hash->second and not outputs.empty() and
+                  not storageController_.listensTo(name) and
+                  gates.count(name) == 0 and
+                  sequence[i]
+                      .getParameter<std::vector<framework::config::Parameters>>(
+                          "histograms", {})
+                      .empty()};
+    if (reusable) {
+      ldmx_log(info) << "Reusing the products of " << name
+                     << " from the input files since its configuration and "
+                        "inputs are unchanged";
+      delete module;
+      sequence_.erase(sequence_.begin() + i);
+      sequence.erase(sequence.begin() + i);
+      configureTimes_.erase(configureTimes_.begin() + i);
+      productHashes_.erase(hash);
+      continue;
+    }
+    ldmx_log(info) << "Running " << name << " again since "
+                   << (old->second == hash->second
+                           ? "its products can't be reused"
+                           : "its configuration or inputs changed");
+    // the products it made before are replaced by the new ones
+    for (const auto &output : outputs)
+      dropKeepRules_.push_back("ignore " + output + "_" + passname_);
+    i++;
+  }
+}
+
+void Process::compileSequence(
+    const std::vector<framework::config::Parameters> &sequence) {
+  runConditions_.assign(sequence_.size(), {});
+  steps_.assign(sequence_.size(), {});
+  for (std::size_t i_proc{0}; i_proc < sequence_.size(); i_proc++) {
+    EventProcessor *module{sequence_[i_proc]};
+    RunCondition &condition{runConditions_[i_proc]};
+    for (const auto &name :
+         sequence[i_proc].getParameter<std::vector<std::string>>(
+             "onlyIfPassed", {})) {
+      auto passer{std::find_if(
+          sequence_.begin(), sequence_.begin() + i_proc,
+          [&name](EventProcessor *ep) { return ep->getName() == name; })};
+      if (passer == sequence_.begin() + i_proc) {
+        EXCEPTION_RAISE("InvalidConfig",
+                        module->getName() + " is only run if '" + name +
+                            "' passed, but there is no processor with that "
+                            "name before it in the sequence.");
+      }
+      condition.after.push_back(passer - sequence_.begin());
+      condition.watched.push_back(storageController_.watch(name));
+    }
+    auto only_on{sequence[i_proc].getParameter<std::string>("onlyOn", "")};
+    if (only_on == "data") {
+      condition.realData = 1;
+    } else if (only_on == "sim") {
+      condition.realData = 0;
+    } else if (not only_on.empty()) {
+      EXCEPTION_RAISE("InvalidConfig",
+                      module->getName() + " is configured to only run on '" +
+                          only_on + "', which should be 'data' or 'sim'.");
+    }
+    condition.skimDependent =
+        sequence[i_proc].getParameter<bool>("skimDependent", false);
+    condition.listened = storageController_.listensTo(module->getName());
+
+    Step &step{steps_[i_proc]};
+    step.producer = dynamic_cast<Producer *>(module);
+    if (not step.producer) step.analyzer = dynamic_cast<Analyzer *>(module);
+    if (not condition.always()) step.condition = &condition;
+  }
+
+  bool listened_after{false};
+  for (std::size_t i_proc{sequence_.size()}; i_proc > 0; i_proc--) {
+    runConditions_[i_proc - 1].hintsAfter = listened_after;
+    listened_after = listened_after or runConditions_[i_proc - 1].listened;
+  }
+}
+
+bool Process::isDropped(const std::string &collectionName) const {
+  if (outputFiles_.empty()) return true;
+  std::string branchName{collectionName + "_" + passname_};
+  for (const auto &rule : dropKeepRules_) {
+    // only the drop rules apply to the products of this pass,
+    // the pattern is made the same way as EventFile::addDrop does
+    if (rule.find("drop") == std::string::npos or
+        rule.find("keep") != std::string::npos or
+        rule.find("ignore") != std::string::npos)
+      continue;
+    std::string pattern{rule.substr(rule.find("drop") + 4)};
+    auto is_space = [](unsigned char c) { return std::isspace(c); };
+    pattern.erase(std::remove_if(pattern.begin(), pattern.end(), is_space),
+                  pattern.end());
+    if (pattern.empty()) continue;
+    if (pattern.back() != '*') pattern += ".*";
+    regex_t reg;
+    if (regcomp(&reg, pattern.c_str(), REG_EXTENDED | REG_ICASE | REG_NOSUB))
+      continue;
+    bool matches{regexec(&reg, branchName.c_str(), 0, 0, 0) == 0};
+    regfree(&reg);
+    if (matches) return true;
+  }
+  return false;
+}
+
+bool Process::processConcurrently(Event &event) const {
+  std::size_t n_procs{sequence_.size()};
+  std::vector<std::size_t> waiting{waitsFor_};
+  std::vector<std::size_t> ready;
+  for (std::size_t i{0}; i < n_procs; i++) {
+    if (waiting[i] == 0) ready.push_back(i);
+  }
+  std::size_t n_done{0};
+  bool aborted{false};
+  std::exception_ptr error;
+  std::mutex mutex;
+  std::condition_variable cv;
+
+  // each thread takes the next ready processor until all of
+  // them are done or no more will become ready
+  auto work = [&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      cv.wait(lock, [&]() {
+        return not ready.empty() or n_done == n_procs or aborted or error;
+      });
+      if (n_done == n_procs or aborted or error) break;
+      std::size_t i_proc{ready.back()};
+      ready.pop_back();
+      lock.unlock();
+
+      bool completed{true};
+      std::exception_ptr caught;
+      const Step &step{steps_[i_proc]};
+      // a skipped processor is done right away
+      bool run{not step.condition or
+               step.condition->accepts(event, storageController_)};
+      if (run and performance_)
+        performance_->start(performance::Callback::process, i_proc + 1);
+      try {
+        if (run and step.producer) {
+          step.producer->produce(event);
+        } else if (run and step.analyzer) {
+          step.analyzer->analyze(event);
+        }
+      } catch (AbortEventException &) {
+        completed = false;
+      } catch (...) {
+        completed = false;
+        caught = std::current_exception();
+      }
+      if (run and performance_)
+        performance_->stop(performance::Callback::process, i_proc + 1);
+
+      lock.lock();
+      if (completed) {
+        n_done++;
+        for (std::size_t j : dependents_[i_proc]) {
+          if (--waiting[j] == 0) ready.push_back(j);
+        }
+      } else if (caught) {
+        if (not error) error = caught;
+      } else {
+        aborted = true;
+      }
+      cv.notify_all();
+    }
+  };
+
+  if (performance_) performance_->start(performance::Callback::process, 0);
+  event.setConcurrent(true);
+  std::vector<std::thread> threads;
+  for (int i_thread{1}; i_thread < nSequenceThreads_; i_thread++) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (auto &thread : threads) thread.join();
+  event.setConcurrent(false);
+  if (performance_) {
+    performance_->stop(performance::Callback::process, 0);
+    if (logProductSizes_) performance_->product_sizes(event.getProductSizes());
+    performance_->end_event(not aborted and not error);
+  }
+
+  if (error) std::rethrow_exception(error);
+  return not aborted;
+}
+
+bool Process::process(int n, Slot &slot) const {
+  Event &event{*slot.event};
+  if ((logFrequency_ != -1) && ((n + 1) % logFrequency_ == 0)) {
+    TTimeStamp t;
+    ldmx_log(info) << "Processing " << n + 1 << " Run "
+                   << event.getEventHeader().getRun() << " Event "
+                   << event.getEventHeader().getEventNumber() << "  ("
+                   << t.AsString("lc") << ")";
+  }
+
+  try {
+    for (std::size_t i_proc{0}; i_proc < slot.sequence.size(); i_proc++) {
+      runProcessor(i_proc, slot.sequence[i_proc], event,
+                   slot.storageController);
+    }
+  } catch (AbortEventException &) {
+    return false;
+  }
+  return true;
+}
+
+bool Process::runProcessor(std::size_t i_proc, EventProcessor *module,
+                           Event &event, const StorageControl &storage) const {
+  const RunCondition &condition{runConditions_[i_proc]};
+  if (not condition.always() and not condition.accepts(event, storage))
+    return false;
+  if (dynamic_cast<Producer *>(module)) {
+    (dynamic_cast<Producer *>(module))->produce(event);
+  } else if (dynamic_cast<Analyzer *>(module)) {
+    (dynamic_cast<Analyzer *>(module))->analyze(event);
+  }
+  return true;
+}
+
+bool Process::RunCondition::accepts(const Event &event,
+                                    const StorageControl &storage) const {
+  if (realData >= 0 and event.getEventHeader().isRealData() != (realData > 0))
+    return false;
+  for (std::size_t i_watched : watched) {
+    if (not storage.kept(i_watched)) return false;
+  }
+  return not skimDependent or not storage.dropped(hintsAfter);
+}
+
+void Process::processBatch(const std::vector<Slot *> &batch,
+                           int first_event) const {
+  for (Slot *slot : batch) {
+    int n{first_event + int(slot->index)};
+    if ((logFrequency_ != -1) && ((n + 1) % logFrequency_ == 0)) {
+      TTimeStamp t;
+      ldmx_log(info) << "Processing " << n + 1 << " Run "
+                     << slot->event->getEventHeader().getRun() << " Event "
+                     << slot->event->getEventHeader().getEventNumber()
+                     << "  (" << t.AsString("lc") << ")";
+    }
+    slot->completed = true;
+  }
+
+  auto module{sequence_.begin()};
+  while (module != sequence_.end()) {
+    if ((*module)->producesInBatches()) {
+      const RunCondition &condition{
+          runConditions_[module - sequence_.begin()]};
+      std::vector<Event *> events;
+      for (Slot *slot : batch) {
+        if (slot->completed and
+            (condition.always() or
+             condition.accepts(*slot->event, slot->storageController)))
+          events.push_back(slot->event);
+      }
+      // the conditions are the same for all events of a batch
+      // since a batch never spans more than one run
+      currentSlot_ = batch.front();
+      try {
+        if (not events.empty())
+          dynamic_cast<Producer *>(*module)->produceBatch(events);
+      } catch (AbortEventException &) {
+        for (Slot *slot : batch) slot->completed = false;
+      }
+      currentSlot_ = nullptr;
+      ++module;
+      continue;
+    }
+
+    // the processors up to the next one that produces in batches
+    // are run on one event at a time
+    auto end{std::find_if(module, sequence_.end(), [](EventProcessor *ep) {
+      return ep->producesInBatches();
+    })};
+    for (Slot *slot : batch) {
+      if (not slot->completed) continue;
+      currentSlot_ = slot;
+      try {
+        for (auto it{module}; it != end; ++it) {
+          runProcessor(it - sequence_.begin(), *it, *slot->event,
+                       slot->storageController);
+        }
+      } catch (AbortEventException &) {
+        slot->completed = false;
+      }
+    }
+    currentSlot_ = nullptr;
+    module = end;
+  }
+}
+
+void Process::runInSlots(std::size_t n_slots,
+                         const std::function<void(Slot &)> &work) const {
+  std::vector<std::exception_ptr> errors(n_slots);
+  auto run_slot = [&](std::size_t i_slot) {
+    currentSlot_ = slots_[i_slot];
+    try {
+      work(*slots_[i_slot]);
+    } catch (...) {
+      errors[i_slot] = std::current_exception();
+    }
+    currentSlot_ = nullptr;
+  };
+
+  // each thread works for every n_workers'th slot
+  std::size_t n_workers{std::min(n_slots, nThreads_)};
+  auto run_worker = [&](std::size_t i_worker) {
+    for (std::size_t i_slot{i_worker}; i_slot < n_slots; i_slot += n_workers)
+      run_slot(i_slot);
+  };
+
+  std::vector<std::thread> workers;
+  for (std::size_t i_worker{1}; i_worker < n_workers; i_worker++) {
+    workers.emplace_back(run_worker, i_worker);
+  }
+  if (n_workers > 0) run_worker(0);
+  for (std::thread &worker : workers) worker.join();
+
+  for (auto &error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
+
+void Process::forEachCopy(
+    const std::function<void(EventProcessor *)> &callback) const {
+  for (std::size_t i_slot{1}; i_slot < slots_.size(); i_slot++) {
+    if (not slots_[i_slot]->ownsSequence) continue;
+    currentSlot_ = slots_[i_slot];
+    for (auto module : slots_[i_slot]->sequence) callback(module);
+  }
+  currentSlot_ = nullptr;
+}
+
+int Process::produceInSlots(EventFile &outFile, Event &theEvent,
+                            int event_limit, int &n_events_processed) {
+  int totalTries{0};
+  while (n_events_processed < event_limit) {
+    std::size_t n_slots{std::min<std::size_t>(
+        slots_.size(), event_limit - n_events_processed)};
+
+    int first_event{n_events_processed};
+    auto begin_try = [this, first_event](Slot &slot) {
+      slot.event->Clear();
+      ldmx::EventHeader &eh = slot.event->getEventHeader();
+      eh.setRun(runForGeneration_);
+      eh.setEventNumber(first_event + int(slot.index) + 1);
+      eh.setTimestamp(TTimeStamp());
+      slot.storageController.resetEventState();
+    };
+    auto end_try = [this](Slot &slot) {
+      slot.tries++;
+      // same stopping condition as the single-threaded production loop
+      bool done{slot.completed or
+                (totalEvents_ < 0 and slot.tries % maxTries_ == 0)};
+      if (done) slot.keep = slot.storageController.keepEvent(slot.completed);
+      return done;
+    };
+    if (batching_) {
+      // the events still being tried are processed together
+      std::vector<Slot *> batch{slots_.begin(), slots_.begin() + n_slots};
+      for (Slot *slot : batch) slot->tries = 0;
+      while (not batch.empty()) {
+        for (Slot *slot : batch) begin_try(*slot);
+        processBatch(batch, first_event);
+        batch.erase(std::remove_if(batch.begin(), batch.end(),
+                                   [&](Slot *slot) { return end_try(*slot); }),
+                    batch.end());
+      }
+    } else {
+      runInSlots(n_slots, [&](Slot &slot) {
+        slot.tries = 0;
+        do {
+          begin_try(slot);
+          slot.completed = process(first_event + int(slot.index), slot);
+        } while (not end_try(slot));
+      });
+    }
+
+    // write the events out in order
+    for (std::size_t i_slot{0}; i_slot < n_slots; i_slot++) {
+      Slot &slot{*slots_[i_slot]};
+      totalTries += slot.tries;
+      if (slot.keep) slot.event->transfer(theEvent);
+      outFile.nextEvent(slot.keep);
+      n_events_processed++;
+      NtupleManager::getInstance().fill();
+      NtupleManager::getInstance().clear();
+    }
+    snapshotHistograms(n_events_processed);
+    checkMemory(*slots_.front()->event, nullptr);
+  }
+  return totalTries;
+}
+
+void Process::processFileInSlots(const std::string &filename,
+                                 EventFile &masterFile, bool writeOutput,
+                                 Event &theEvent, int &n_events_processed,
+                                 int &wasRun) {
+  for (Slot *slot : slots_) {
+    slot->input = new EventFile(config_, filename);
+    slot->input->setupEvent(slot->event);
+  }
+
+  // the primary processors start a new run with the event in the first slot
+  auto start_run = [&](int run) {
+    wasRun = run;
+    ldmx::RunHeader *rh{masterFile.getRunHeaderPtr(wasRun)};
+    if (rh != nullptr) {
+      runHeader_ = rh;
+      ldmx_log(info) << "Got new run header from '" << masterFile.getFileName()
+                     << "' ...\n"
+                     << *runHeader_;
+      currentSlot_ = slots_.front();
+      newRun(*runHeader_);
+      currentSlot_ = nullptr;
+    } else {
+      ldmx_log(warn) << "Run header for run " << wasRun << " was not found!";
+    }
+  };
+
+  // the products of the kept events of a window wait here to be written
+  bool scheduled{scheduleWindow_ > 0 and nThreads_ > 1};
+  std::vector<std::unique_ptr<Event>> held;
+  if (scheduled and writeOutput) {
+    for (int i{0}; i < scheduleWindow_; i++)
+      held.push_back(std::make_unique<Event>(passname_));
+  }
+
+  Long64_t entries{slots_.front()->input->getEntries()}, entry{0};
+  bool keep{true};
+  while (entry < entries and
+         (eventLimit_ < 0 or n_events_processed < eventLimit_)) {
+    std::size_t n_slots{std::min<std::size_t>(
+        scheduled ? scheduleWindow_ : slots_.size(), entries - entry)};
+    if (eventLimit_ > 0) {
+      n_slots = std::min<std::size_t>(n_slots,
+                                      eventLimit_ - n_events_processed);
+    }
+
+    if (scheduled) {
+      // peek at the cost of the entries of the window with the first slot,
+      //  the window ends before the first event of a new run
+      Slot &primary{*slots_.front()};
+      std::vector<Long64_t> cost;
+      for (std::size_t i{0}; i < n_slots; i++) {
+        Long64_t bytes{primary.input->peekEntry(entry + i, costBranches_)};
+        int run{primary.event->getEventHeader().getRun()};
+        if (run != wasRun) {
+          if (i > 0) break;
+          start_run(run);
+        }
+        cost.push_back(bytes);
+      }
+      n_slots = cost.size();
+
+      // the costliest entries go first so the cheap ones fill in the gaps
+      //  and each slot takes the next entry as soon as it is free
+      std::vector<std::size_t> order(n_slots);
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(),
+                       [&cost](std::size_t a, std::size_t b) {
+                         return cost[a] > cost[b];
+                       });
+      std::vector<char> completed(n_slots), kept(n_slots);
+      std::atomic<std::size_t> next{0};
+      int first_event{n_events_processed};
+      runInSlots(slots_.size(), [&](Slot &slot) {
+        for (std::size_t i{next++}; i < n_slots; i = next++) {
+          std::size_t k{order[i]};
+          slot.input->skipToEvent(entry + k);
+          slot.input->nextEvent(false);
+          slot.storageController.resetEventState();
+          completed[k] = process(first_event + int(k), slot);
+          kept[k] = slot.storageController.keepEvent(completed[k]);
+          if (writeOutput and kept[k]) slot.event->transfer(*held[k]);
+        }
+      });
+
+      for (std::size_t k{0}; k < n_slots; k++) {
+        if (writeOutput) {
+          if (not masterFile.nextEvent(keep)) {
+            EXCEPTION_RAISE("Process", "Output file '" +
+                                           masterFile.getFileName() +
+                                           "' fell out of sync with input '" +
+                                           filename + "'.");
+          }
+          if (kept[k]) {
+            held[k]->transfer(theEvent);
+            held[k]->Clear();
+          }
+          keep = kept[k];
+        }
+        if (completed[k]) NtupleManager::getInstance().fill();
+        NtupleManager::getInstance().clear();
+        n_events_processed++;
+      }
+      entry += n_slots;
+      snapshotHistograms(n_events_processed);
+      checkMemory(*slots_.front()->event, nullptr);
+      continue;
+    }
+
+    runInSlots(n_slots, [entry](Slot &slot) {
+      slot.input->skipToEvent(entry + slot.index);
+      slot.input->nextEvent(false);
+    });
+
+    // a new run needs to be started before any of its events are processed
+    //  if it starts in a slot other than the first, the events from there
+    //  on are postponed until the next round
+    for (std::size_t i_slot{0}; i_slot < n_slots; i_slot++) {
+      int run{slots_[i_slot]->event->getEventHeader().getRun()};
+      if (run == wasRun) continue;
+      if (i_slot > 0) {
+        n_slots = i_slot;
+        break;
+      }
+      start_run(run);
+    }
+
+    int first_event{n_events_processed};
+    if (batching_) {
+      std::vector<Slot *> batch{slots_.begin(), slots_.begin() + n_slots};
+      for (Slot *slot : batch) slot->storageController.resetEventState();
+      processBatch(batch, first_event);
+      for (Slot *slot : batch)
+        slot->keep = slot->storageController.keepEvent(slot->completed);
+    } else {
+      runInSlots(n_slots, [this, first_event](Slot &slot) {
+        slot.storageController.resetEventState();
+        slot.completed = process(first_event + int(slot.index), slot);
+        slot.keep = slot.storageController.keepEvent(slot.completed);
+      });
+    }
+
+    // follow along with the master file in order
+    for (std::size_t i_slot{0}; i_slot < n_slots; i_slot++) {
+      Slot &slot{*slots_[i_slot]};
+      if (writeOutput) {
+        if (not masterFile.nextEvent(keep)) {
+          EXCEPTION_RAISE("Process", "Output file '" +
+                                         masterFile.getFileName() +
+                                         "' fell out of sync with input '" +
+                                         filename + "'.");
+        }
+        if (slot.keep) slot.event->transfer(theEvent);
+        keep = slot.keep;
+      }
+      if (slot.completed) NtupleManager::getInstance().fill();
+      NtupleManager::getInstance().clear();
+      n_events_processed++;
+    }
+    entry += n_slots;
+    snapshotHistograms(n_events_processed);
+    checkMemory(*slots_.front()->event, nullptr);
+  }
+
+  // store the last event
+  if (writeOutput and entry > 0) masterFile.nextEvent(keep);
+
+  for (Slot *slot : slots_) {
+    inputReadCalls_ += slot->input->getReadCalls();
+    inputBytesRead_ += slot->input->getBytesRead();
+    delete slot->input;
+    slot->input = nullptr;
+    slot->event->onEndOfFile();
+  }
+}
+
+/**
+ * Merge the histograms in one directory into the matching ones in another
+ *
+ * Sub-directories are merged recursively and are removed once they
+ * are empty. Histograms without a match are moved into the other directory
+ * and other objects (e.g. TTrees) are left where they are.
+ *
+ * @param[in] from directory to take histograms from
+ * @param[in] into directory to merge histograms into
+ */
+static void mergeHistograms(TDirectory *from, TDirectory *into) {
+  // copy list of objects since we will be removing them from the directory
+  std::vector<TObject *> objects;
+  TIter next(from->GetList());
+  while (TObject *obj = next()) objects.push_back(obj);
+
+  for (TObject *obj : objects) {
+    if (auto dir = dynamic_cast<TDirectory *>(obj)) {
+      std::string name{dir->GetName()};
+      TDirectory *into_dir = into->GetDirectory(name.c_str());
+      if (!into_dir) into_dir = into->mkdir(name.c_str());
+      mergeHistograms(dir, into_dir);
+      if (dir->GetList()->GetSize() == 0) from->rmdir(name.c_str());
+    } else if (auto hist = dynamic_cast<TH1 *>(obj)) {
+      auto into_hist =
+          dynamic_cast<TH1 *>(into->GetList()->FindObject(hist->GetName()));
+      if (into_hist) {
+        TList to_merge;
+        to_merge.Add(hist);
+        into_hist->Merge(&to_merge);
+        delete hist;
+      } else {
+        hist->SetDirectory(into);
+      }
+    }
+  }
+}
+
+void Process::mergeSlotHistograms() {
+  if (slots_.size() < 2 or histoTFile_ == nullptr) return;
+  for (std::size_t i_slot{1}; i_slot < slots_.size(); i_slot++) {
+    std::string slotDirName{"slot" + std::to_string(i_slot)};
+    TDirectory *slotDir = histoTFile_->GetDirectory(slotDirName.c_str());
+    if (!slotDir) continue;
+    mergeHistograms(slotDir, histoTFile_);
+    if (slotDir->GetList()->GetSize() == 0) {
+      histoTFile_->rmdir(slotDirName.c_str());
+    } else {
+      ldmx_log(warn) << "Objects created by the processors in worker slot "
+                     << i_slot << " that are not histograms are left in the '"
+                     << slotDirName << "' directory of the histogram file.";
+    }
+  }
+}
+
+/**
+ * Copy the histograms in one directory into another
+ *
+ * Sub-directories are copied recursively and histograms that are already
+ * in the other directory are added to. The histograms in the directory
+ * copied from are left untouched.
+ *
+ * @param[in] from directory to copy histograms from
+ * @param[in] into directory to copy histograms into
+ * @param[in] skip names of sub-directories not to copy
+ */
+static void copyHistograms(TDirectory *from, TDirectory *into,
+                           const std::set<std::string> &skip = {}) {
+  TIter next(from->GetList());
+  while (TObject *obj = next()) {
+    if (auto dir = dynamic_cast<TDirectory *>(obj)) {
+      std::string name{dir->GetName()};
+      if (skip.count(name) > 0) continue;
+      TDirectory *into_dir = into->GetDirectory(name.c_str());
+      if (!into_dir) into_dir = into->mkdir(name.c_str());
+      copyHistograms(dir, into_dir);
+    } else if (auto hist = dynamic_cast<TH1 *>(obj)) {
+      auto into_hist =
+          dynamic_cast<TH1 *>(into->GetList()->FindObject(hist->GetName()));
+      if (into_hist) {
+        TList to_merge;
+        to_merge.Add(hist);
+        into_hist->Merge(&to_merge);
+      } else {
+        static_cast<TH1 *>(hist->Clone())->SetDirectory(into);
+      }
+    }
+  }
+}
+
+void Process::snapshotHistograms(int n_events_processed) {
+  if (histoSnapshotFilename_.empty() or histoTFile_ == nullptr) return;
+  auto now{std::chrono::steady_clock::now()};
+  bool due{histoSnapshotEvents_ > 0 and
+           n_events_processed - lastHistoSnapshotEvents_ >=
+               histoSnapshotEvents_};
+  if (histoSnapshotSeconds_ > 0 and
+      now - lastHistoSnapshot_ >= std::chrono::seconds(histoSnapshotSeconds_))
+    due = true;
+  if (not due) return;
+  lastHistoSnapshot_ = now;
+  lastHistoSnapshotEvents_ = n_events_processed;
+
+  // the fills buffered by the processors need to be in the histograms
+  for (auto module : sequence_) module->flushHistograms();
+  forEachCopy([](EventProcessor *module) { module->flushHistograms(); });
+
+  if (writeHistogramCopy(histoSnapshotFilename_)) {
+    ldmx_log(debug) << "Wrote a snapshot of the histograms after "
+                    << n_events_processed << " events to '"
+                    << histoSnapshotFilename_ << "'";
+  }
+}
+
+double Process::getMemoryHeadroom() const {
+  if (memoryBudget_ <= 0) return 1.;
+  return 1. - double(performance::Usage::residentMemory()) / memoryBudget_;
+}
+
+void Process::checkMemory(const Event &event, EventFile *input) {
+  if (memoryBudget_ <= 0) return;
+  long int rss{performance::Usage::residentMemory()};
+  if (rss <= memoryBudget_ or rss <= memoryExceeded_ * 11 / 10) return;
+  memoryExceeded_ = rss;
+
+  // the read-ahead is the one cache we hold ourselves
+  std::vector<EventFile *> inputs;
+  if (input) inputs.push_back(input);
+  for (Slot *slot : slots_) {
+    if (slot->input) inputs.push_back(slot->input);
+  }
+  Long64_t cache{0};
+  for (EventFile *file : inputs) cache += file->shrinkCache();
+
+  std::stringstream dump;
+  dump << "Resident memory " << rss / 1024 << " MB is over the budget of "
+       << memoryBudget_ / 1024 << " MB after run "
+       << event.getEventHeader().getRun() << " event "
+       << event.getEventHeader().getEventNumber()
+       << ", input read caches shrunk to " << cache / 1024 / 1024
+       << " MB.\nLargest objects on the event bus:\n";
+  auto sizes{event.getProductSizes()};
+  for (std::size_t i{0}; i < sizes.size() and i < 20; i++) {
+    dump << "  " << sizes[i].first << " : " << sizes[i].second / 1024
+         << " kB\n";
+  }
+
+  if (memoryDumpFile_.empty()) {
+    ldmx_log(warn) << dump.str();
+    return;
+  }
+  std::ofstream file{memoryDumpFile_, std::ios::app};
+  file << dump.str() << std::endl;
+  ldmx_log(warn) << "Resident memory " << rss / 1024
+                 << " MB is over the budget, see '" << memoryDumpFile_
+                 << "' for the largest objects on the event bus.";
+}
+
+void Process::writeHistogramChunk() {
+  if (histoAggregationDir_.empty() or histoTFile_ == nullptr) return;
+  // unique among the jobs sharing the directory
+  char host[256]{};
+  gethostname(host, sizeof(host) - 1);
+  std::string chunk{histoAggregationDir_ + "/" + host + "_" +
+                    std::to_string(getpid()) + "_" +
+                    std::to_string(std::time(nullptr)) + ".root"};
+  if (writeHistogramCopy(chunk)) {
+    ldmx_log(info) << "Handed the histograms to the aggregator in '"
+                   << chunk << "'";
+  }
+}
+
+bool Process::writeHistogramCopy(const std::string &filename) {
+  // the copies in the other slots are merged into the copy,
+  //  not into the histograms that are still being filled
+  std::set<std::string> slotDirNames;
+  for (std::size_t i_slot{1}; i_slot < slots_.size(); i_slot++)
+    slotDirNames.insert("slot" + std::to_string(i_slot));
+
+  // written next to the file and moved over it once it is complete,
+  //  so whoever is looking at the file never sees half of it
+  std::string tmpFilename{filename + ".tmp"};
+  {
+    TDirectory::TContext keep_current_directory;
+    TFile copy(tmpFilename.c_str(), "RECREATE");
+    if (copy.IsZombie()) {
+      ldmx_log(warn) << "Unable to open '" << tmpFilename
+                     << "' to write a copy of the histograms to.";
+      return false;
+    }
+    copyHistograms(histoTFile_, &copy, slotDirNames);
+    for (const auto &slotDirName : slotDirNames) {
+      TDirectory *slotDir = histoTFile_->GetDirectory(slotDirName.c_str());
+      if (slotDir) copyHistograms(slotDir, &copy);
+    }
+    copy.Write();
+    copy.Close();
+  }
+  if (std::rename(tmpFilename.c_str(), filename.c_str()) != 0) {
+    ldmx_log(warn) << "Unable to move the copy of the histograms to '"
+                   << filename << "'.";
+    return false;
+  }
+  return true;
+}
+
+void Process::checkpoint(EventFile *outFile, int n_events_processed,
+                         int totalTries, int i_file, long long entry) {
+  if (checkpointFilename_.empty() or checkpointEvents_ <= 0 or
+      n_events_processed - lastCheckpointEvents_ < checkpointEvents_)
+    return;
+  lastCheckpointEvents_ = n_events_processed;
+
+  Checkpoint state;
+  state.events = n_events_processed;
+  state.tries = totalTries;
+  state.file = i_file;
+  state.entry = entry;
+  if (outFile) {
+    if (not outFile->checkpoint()) {
+      ldmx_log(warn) << "Unable to checkpoint the output file '"
+                     << outFile->getFileName() << "'.";
+      return;
+    }
+    state.output = outFile->getFileName();
+    // only the file the job was resumed in has parts
+    if (state.output == resumeFrom_.output) state.outputParts = outputParts_;
+  }
+
+  if (histoTFile_) {
+    for (auto module : sequence_) module->flushHistograms();
+    NtupleManager::getInstance().checkpoint();
+    TDirectory::TContext keep_current_directory;
+    histoTFile_->Write(nullptr, TObject::kOverwrite);
+  }
+  state.histogramParts = histogramParts_;
+
+  for (auto module : sequence_) {
+    std::ostringstream module_state;
+    module->onCheckpoint(module_state);
+    if (not module_state.str().empty())
+      state.states[module->getName()] = module_state.str();
+  }
+
+  writeCheckpoint(state);
+  ldmx_log(info) << "Wrote a checkpoint after " << n_events_processed
+                 << " events to '" << checkpointFilename_ << "'";
+}
+
+void Process::writeCheckpoint(const Checkpoint &state) const {
+  std::string tmpFilename{checkpointFilename_ + ".tmp"};
+  {
+    std::ofstream file(tmpFilename);
+    file << "events " << state.events << '\n'
+         << "tries " << state.tries << '\n'
+         << "file " << state.file << '\n'
+         << "entry " << state.entry << '\n'
+         << "output " << state.output << '\n'
+         << "outputParts " << state.outputParts << '\n'
+         << "histogramParts " << state.histogramParts << '\n';
+    for (const auto &[name, bytes] : state.states)
+      file << "state " << name << ' ' << bytes.size() << '\n'
+           << bytes << '\n';
+    if (not file) {
+      EXCEPTION_RAISE("Checkpoint", "Unable to write the checkpoint to '" +
+                                        tmpFilename + "'.");
+    }
+  }
+  if (std::rename(tmpFilename.c_str(), checkpointFilename_.c_str()) != 0) {
+    EXCEPTION_RAISE("Checkpoint", "Unable to move the checkpoint to '" +
+                                      checkpointFilename_ + "'.");
+  }
+}
+
+void Process::prepareResume() {
+  std::ifstream file(checkpointFilename_);
+  if (not file) {
+    ldmx_log(info) << "No checkpoint in '" << checkpointFilename_
+                   << "', starting from the beginning.";
+    return;
+  }
+
+  Checkpoint &state{resumeFrom_};
+  std::string key;
+  while (file >> key) {
+    if (key == "events") {
+      file >> state.events;
+    } else if (key == "tries") {
+      file >> state.tries;
+    } else if (key == "file") {
+      file >> state.file;
+    } else if (key == "entry") {
+      file >> state.entry;
+    } else if (key == "output") {
+      file.get();
+      std::getline(file, state.output);
+    } else if (key == "outputParts") {
+      file >> state.outputParts;
+    } else if (key == "histogramParts") {
+      file >> state.histogramParts;
+    } else if (key == "state") {
+      std::string name;
+      std::size_t size{0};
+      file >> name >> size;
+      file.get();
+      std::string bytes(size, '\0');
+      file.read(bytes.data(), size);
+      state.states[name] = bytes;
+    } else {
+      EXCEPTION_RAISE("Checkpoint", "Unknown setting '" + key +
+                                        "' in the checkpoint '" +
+                                        checkpointFilename_ + "'.");
+    }
+    if (not file) {
+      EXCEPTION_RAISE("Checkpoint", "The checkpoint '" + checkpointFilename_ +
+                                        "' is corrupted at '" + key + "'.");
+    }
+  }
+
+  // what was written after the checkpoint is dropped with the files, the
+  //  trees in them are only saved at the checkpoints
+  auto set_aside = [](const std::string &filename, int &n_parts) {
+    if (filename.empty() or access(filename.c_str(), F_OK) != 0) return;
+    std::string part{filename + ".part" + std::to_string(n_parts)};
+    if (std::rename(filename.c_str(), part.c_str()) != 0) {
+      EXCEPTION_RAISE("Resume",
+                      "Unable to set '" + filename + "' aside to '" + part +
+                          "' to resume from the checkpoint.");
+    }
+    n_parts++;
+  };
+  outputParts_ = state.outputParts;
+  set_aside(state.output, outputParts_);
+  histogramParts_ = state.histogramParts;
+  set_aside(histoFilename_, histogramParts_);
+
+  // the parts are counted in the checkpoint right away, so that they are
+  //  not written over if the job is stopped again before the next one
+  Checkpoint counted{state};
+  counted.outputParts = outputParts_;
+  counted.histogramParts = histogramParts_;
+  writeCheckpoint(counted);
+
+  resumeStates_ = state.states;
+  lastCheckpointEvents_ = state.events;
+  ldmx_log(info) << "Resuming from the checkpoint in '" << checkpointFilename_
+                 << "' after " << state.events << " events";
+}
+
+bool Process::mergeParts(const std::string &filename, int n_parts) const {
+  std::vector<std::string> parts;
+  for (int i_part{0}; i_part < n_parts; i_part++) {
+    std::string part{filename + ".part" + std::to_string(i_part)};
+    // a job stopped before it opened the file didn't leave a part
+    if (access(part.c_str(), F_OK) == 0) parts.push_back(part);
+  }
+  if (parts.empty()) return true;
+
+  // the parts come first so the events stay in the order they were made
+  std::string merged{filename + ".merged"};
+  TFileMerger merger(false);
+  merger.OutputFile(merged.c_str(), "RECREATE", compressionSetting_);
+  for (const auto &part : parts) merger.AddFile(part.c_str(), false);
+  if (access(filename.c_str(), F_OK) == 0)
+    merger.AddFile(filename.c_str(), false);
+  if (not merger.Merge() or
+      std::rename(merged.c_str(), filename.c_str()) != 0)
+    return false;
+  for (const auto &part : parts) std::remove(part.c_str());
+  ldmx_log(info) << "Merged " << parts.size() << " parts set aside when "
+                 << "resuming into '" << filename << "'";
+  return true;
+}
+
+bool Process::forkFileWorkers() {
+  if (histoTFile_) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The histogram file is already open, so all of the file "
+                    "workers would write to it. Logging the performance is "
+                    "not supported with several file workers.");
+  }
+  if (outputFiles_.size() == 1 and inputFiles_.size() > 1) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "A single output file cannot be shared between several "
+                    "file workers. Give one output file per input file.");
+  }
+  if (eventLimit_ > 0) {
+    ldmx_log(warn) << "The limit of " << eventLimit_
+                   << " events is applied to each file worker separately.";
+  }
+
+  int n_workers{std::min(nFileWorkers_, int(inputFiles_.size()))};
+  void *queue{mmap(nullptr, sizeof(std::atomic<int>), PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS, -1, 0)};
+  if (queue == MAP_FAILED) {
+    EXCEPTION_RAISE("WorkerFailed",
+                    "Unable to create the input file queue for the workers.");
+  }
+  fileQueue_ = new (queue) std::atomic<int>(0);
+
+  // don't let the workers repeat what is still buffered
+  std::cout.flush();
+  std::fflush(nullptr);
+
+  ldmx_log(info) << "Spreading " << inputFiles_.size() << " input files over "
+                 << n_workers << " file workers";
+  std::vector<pid_t> workers;
+  std::vector<std::string> parts;
+  for (int i_worker{0}; i_worker < n_workers; i_worker++) {
+    auto worker_part = [i_worker](std::string name) {
+      if (not name.empty()) {
+        auto ext{name.rfind(".root")};
+        name.insert(ext == std::string::npos ? name.size() : ext,
+                    "_worker" + std::to_string(i_worker));
+      }
+      return name;
+    };
+    std::string part{worker_part(histoFilename_)};
+    pid_t pid{fork()};
+    if (pid == 0) {
+      // we are the worker, carry on with the run
+      histoFilename_ = part;
+      histoSnapshotFilename_ = worker_part(histoSnapshotFilename_);
+      return true;
+    } else if (pid < 0) {
+      ldmx_log(error) << "Unable to start file worker " << i_worker;
+      break;
+    }
+    workers.push_back(pid);
+    parts.push_back(part);
+  }
+
+  bool failed{int(workers.size()) != n_workers};
+  for (pid_t pid : workers) {
+    int status;
+    if (waitpid(pid, &status, 0) < 0 or not WIFEXITED(status) or
+        WEXITSTATUS(status) != 0)
+      failed = true;
+  }
+  munmap(queue, sizeof(std::atomic<int>));
+  fileQueue_ = nullptr;
+  if (failed) {
+    EXCEPTION_RAISE("WorkerFailed",
+                    "At least one of the file workers failed.");
+  }
+
+  if (not histoFilename_.empty()) {
+    TFileMerger merger(false);
+    merger.OutputFile(histoFilename_.c_str(), "RECREATE");
+    int n_parts{0};
+    for (const auto &part : parts) {
+      // workers that didn't create any histograms didn't write a file
+      if (access(part.c_str(), F_OK) != 0) continue;
+      merger.AddFile(part.c_str(), false);
+      n_parts++;
+    }
+    if (n_parts > 0 and not merger.Merge()) {
+      EXCEPTION_RAISE("WorkerFailed",
+                      "Unable to merge the histogram files of the file "
+                      "workers into '" +
+                          histoFilename_ + "'.");
+    }
+    for (const auto &part : parts) std::remove(part.c_str());
+  }
+
+  return false;
+}
+
+int Process::nextInputFile(int i_file) const {
+  if (fileQueue_) return (*fileQueue_)++;
+  return i_file + 1;
+}
+
+void Process::startProcessors() {
+  if (performance_)
+    performance_->start(performance::Callback::onProcessStart, 0);
+  conditions_.onProcessStart();
+
+  std::vector<double> start_times(sequence_.size(), 0.);
+  auto start = [&](std::size_t i_proc) {
+    auto begin{std::chrono::steady_clock::now()};
+    if (performance_)
+      performance_->start(performance::Callback::onProcessStart, i_proc + 1);
+    sequence_[i_proc]->onProcessStart();
+    if (performance_)
+      performance_->stop(performance::Callback::onProcessStart, i_proc + 1);
+    start_times[i_proc] = std::chrono::duration<double>(
+                              std::chrono::steady_clock::now() - begin)
+                              .count();
+  };
+
+  // launch the independent processors first so they overlap with
+  // the ones that have to be started here in sequence order
+  std::vector<std::future<void>> independent;
+  for (std::size_t i_proc{0}; i_proc < sequence_.size(); i_proc++) {
+    if (parallelStart_ and sequence_[i_proc]->hasIndependentStart()) {
+      independent.push_back(std::async(std::launch::async, start, i_proc));
+    }
+  }
+  for (std::size_t i_proc{0}; i_proc < sequence_.size(); i_proc++) {
+    if (not(parallelStart_ and sequence_[i_proc]->hasIndependentStart())) {
+      start(i_proc);
+    }
+  }
+  // get re-throws any exception from the processor's onProcessStart
+  for (auto &f : independent) f.get();
+
+  forEachCopy([](EventProcessor *module) { module->onProcessStart(); });
+  if (performance_)
+    performance_->stop(performance::Callback::onProcessStart, 0);
+
+  for (std::size_t i_proc{0}; i_proc < sequence_.size(); i_proc++) {
+    ldmx_log(info) << "Startup of " << sequence_[i_proc]->getName()
+                   << ": configure " << configureTimes_[i_proc]
+                   << " s, onProcessStart " << start_times[i_proc] << " s";
+  }
+}
+
+EventProcessor *Process::createProcessor(framework::config::Parameters proc) {
+  auto className{proc.getParameter<std::string>("className")};
+  auto instanceName{proc.getParameter<std::string>("instanceName")};
+  EventProcessor *ep = PluginFactory::getInstance().createEventProcessor(
+      className, instanceName, *this);
+  if (ep == 0) {
+    EXCEPTION_RAISE(
+        "UnableToCreate",
+        "Unable to create instance '" + instanceName + "' of class '" +
+            className +
+            "'. Did you load the library that this class is apart of?");
+  }
+  ep->declareCollections(
+      proc.getParameter<std::vector<std::string>>("inputs", {}),
+      proc.getParameter<std::vector<std::string>>("outputs", {}));
+  auto histograms{proc.getParameter<std::vector<framework::config::Parameters>>(
+      "histograms", {})};
+  if (!histograms.empty()) {
+    ep->getHistoDirectory();
+    ep->createHistograms(histograms);
+  }
+  ep->configure(proc);
+  return ep;
+}
+
 void Process::onFileOpen(EventFile &file) const {
+  if (performance_) file.setTrace(performance_->trace());
   if (performance_) performance_->start(performance::Callback::onFileOpen, 0);
   std::size_t i_proc{0};
   for (auto module : sequence_) {
@@ -518,9 +2360,16 @@ void Process::onFileOpen(EventFile &file) const {
     if (performance_)
       performance_->stop(performance::Callback::onFileOpen, i_proc);
   }
+  forEachCopy([&file](EventProcessor *module) { module->onFileOpen(file); });
   if (performance_) performance_->stop(performance::Callback::onFileOpen, 0);
 }
 
+void Process::recordProductStorage(EventFile &file) const {
+  if (not performance_ or not logProductSizes_) return;
+  for (const auto &[branch, tot_bytes, zip_bytes] : file.getBranchSizes())
+    performance_->product_storage(branch, tot_bytes, zip_bytes);
+}
+
 void Process::onFileClose(EventFile &file) const {
   if (performance_) performance_->start(performance::Callback::onFileClose, 0);
   std::size_t i_proc{0};
@@ -532,6 +2381,7 @@ void Process::onFileClose(EventFile &file) const {
     if (performance_)
       performance_->stop(performance::Callback::onFileClose, i_proc);
   }
+  forEachCopy([&file](EventProcessor *module) { module->onFileClose(file); });
   if (performance_) performance_->stop(performance::Callback::onFileClose, 0);
 }
 
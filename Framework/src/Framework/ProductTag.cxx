@@ -1,5 +1,22 @@
 #include "Framework/ProductTag.h"
 
+#include <mutex>
+#include <unordered_set>
+
+namespace framework {
+
+const std::string& ProductTag::intern(const std::string& str) {
+  // the products are listed by the events of all the threads
+  static std::mutex mutex;
+  static std::unordered_set<std::string> strings;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it{strings.find(str)};
+  if (it == strings.end()) it = strings.insert(str).first;
+  return *it;
+}
+
+}  // namespace framework
+
 std::ostream& operator<<(std::ostream& s, const framework::ProductTag& pt) {
   return s << "{ name = " << pt.name() << ", pass = " << pt.passname()
            << ", type = " << pt.type() << "}";
@@ -55,7 +55,15 @@ void RandomNumberSeedService::onNewRun(ldmx::RunHeader& rh) {
   rh.setIntParameter(key, int(masterSeed_));
 }
 
-uint64_t RandomNumberSeedService::getSeed(const std::string& name) const {
+uint64_t RandomNumberSeedService::getSeed(const std::string& seed_name) const {
+  // copies of a processor running in the other worker slots of a
+  // multi-threaded process get their own seeds, otherwise every slot
+  // would produce the same sequence of random numbers
+  std::string name{seed_name};
+  std::size_t slot{process().getSlotIndex()};
+  if (slot > 0) name += "[slot" + std::to_string(slot) + "]";
+
+  std::lock_guard<std::mutex> lock(seeds_mutex_);
   uint64_t seed(0);
   std::map<std::string, uint64_t>::const_iterator i = seeds_.find(name);
   if (i == seeds_.end()) {
@@ -70,7 +78,13 @@ uint64_t RandomNumberSeedService::getSeed(const std::string& name) const {
   return seed;
 }
 
+RandomStream RandomNumberSeedService::getStream(
+    const std::string& name, const ldmx::EventHeader& header) const {
+  return getStream(name, header.getRun(), header.getEventNumber());
+}
+
 std::vector<std::string> RandomNumberSeedService::getSeedNames() const {
+  std::lock_guard<std::mutex> lock(seeds_mutex_);
   std::vector<std::string> rv;
   for (auto i : seeds_) {
     rv.push_back(i.first);
@@ -1,22 +1,63 @@
 #include "Framework/StorageControl.h"
 
+#include <algorithm>
+
 #include "Framework/Exception/Exception.h"
 
 namespace framework {
 
-void StorageControl::resetEventState() { hints_.clear(); }
+void StorageControl::resetEventState() {
+  hints_.clear();
+  std::fill(watchedHints_.begin(), watchedHints_.end(), Hint::NoOpinion);
+}
+
+StorageControl::Listening& StorageControl::listening(
+    const std::string& processor_name) const {
+  auto it{decisions_.find(processor_name)};
+  if (it != decisions_.end()) return it->second;
+  Listening& listening{decisions_[processor_name]};
+  for (std::size_t i_rule{0}; i_rule < rules_.size(); i_rule++) {
+    if (std::regex_match(processor_name, rules_[i_rule].first))
+      listening.rules.push_back(i_rule);
+  }
+  auto watched{watched_.find(processor_name)};
+  if (watched != watched_.end()) listening.watched = watched->second;
+  return listening;
+}
 
 void StorageControl::addHint(const std::string& processor_name, Hint hint,
                              const std::string& purposeString) {
-  for (const auto& [processor_rule, purpose_rule] : rules_) {
-    if (std::regex_match(processor_name, processor_rule) and
-        std::regex_match(purposeString, purpose_rule)) {
-      // cache hints that matched a rule for later tallying
-      hints_.push_back(hint);
-      // leave after first match to avoid double-counting
-      break;
+  Listening& decisions{listening(processor_name)};
+  if (decisions.watched >= 0) watchedHints_[decisions.watched] = hint;
+  if (decisions.rules.empty()) return;
+  auto it{decisions.byPurpose.find(purposeString)};
+  if (it == decisions.byPurpose.end()) {
+    bool listen{false};
+    for (std::size_t i_rule : decisions.rules) {
+      if (std::regex_match(purposeString, rules_[i_rule].second)) {
+        listen = true;
+        break;
+      }
     }
+    it = decisions.byPurpose.emplace(purposeString, listen).first;
+  }
+  // cache hints that matched a rule for later tallying
+  //  only once even if several rules match to avoid double-counting
+  if (it->second) hints_.push_back(hint);
+}
+
+bool StorageControl::listensTo(const std::string& processor_name) const {
+  return not listening(processor_name).rules.empty();
+}
+
+std::size_t StorageControl::watch(const std::string& processor_name) {
+  auto [it, inserted] = watched_.emplace(processor_name, watchedHints_.size());
+  if (inserted) {
+    watchedHints_.push_back(Hint::NoOpinion);
+    // the decisions are made again with the index of the processor
+    decisions_.erase(processor_name);
   }
+  return it->second;
 }
 
 void StorageControl::addRule(const std::string& processor_pat,
@@ -26,6 +67,9 @@ void StorageControl::addRule(const std::string& processor_pat,
    */
   if (processor_pat.empty()) return;
 
+  // the decisions made with the previous rules may change
+  decisions_.clear();
+
   try {
     rules_.emplace_back(
         std::piecewise_construct,
@@ -106,4 +150,10 @@ bool StorageControl::keepEvent(bool event_completed) const {
    */
   return defaultIsKeep_;
 }
+
+bool StorageControl::dropped(bool more_hints) const {
+  if (std::find(hints_.begin(), hints_.end(), Hint::MustDrop) != hints_.end())
+    return true;
+  return not more_hints and not keepEvent(true);
+}
 }  // namespace framework
@@ -143,6 +143,21 @@ TEST_CASE("Configure Python Test", "[Framework][functionality]") {
     CHECK(p->getPassName() == "test");
   }
 
+  // Write the configuration to JSON and make the process from it instead,
+  // the processor checks its parameters are the same in configure
+  SECTION("Configuration written to and read from JSON") {
+    const std::string json_file_name{"/tmp/config_python_test_config.json"};
+    framework::ConfigurePython cfg(config_file_name, args, 0);
+    cfg.dump(json_file_name);
+
+    auto loaded{framework::ConfigurePython::load(json_file_name)};
+    CHECK(loaded.get().keys() == cfg.get().keys());
+    p = loaded.makeProcess();
+
+    CHECK(p->getPassName() == "test");
+    CHECK(framework::test::removeFile(json_file_name.c_str()));
+  }
+
   // Update the python config so we can pass the log frequency as a parameter.
   std::ifstream in_file;
   std::ofstream out_file;
@@ -0,0 +1,44 @@
+/**
+ * @file EventHeaderTest.cxx
+ * @brief Test the parameters of the EventHeader
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include "Framework/EventHeader.h"
+#include "Framework/Exception/Exception.h"
+
+/**
+ * Test the EventHeader parameters
+ *
+ * A parameter set by name must be found by its key and the other way
+ * around, setting it again must replace its value and clearing the
+ * header must remove all of them.
+ */
+TEST_CASE("EventHeader parameters", "[Framework][functionality]") {
+  ldmx::EventHeader header;
+
+  header.setIntParameter("count", 1);
+  header.setIntParameter("count", 2);
+  header.setFloatParameter("energy", 1.5);
+  header.setStringParameter("seed", "1 2 3");
+
+  auto key{ldmx::EventHeader::key("Pass")};
+  header.setIntParameter(key, 1);
+
+  CHECK(header.getIntParameter("count") == 2);
+  CHECK(header.getIntParameter(ldmx::EventHeader::key("count")) == 2);
+  CHECK(header.getIntParameter("Pass") == 1);
+  CHECK(header.getFloatParameter("energy") == 1.5);
+  CHECK(header.getStringParameter("seed") == "1 2 3");
+  CHECK(header.hasIntParameter("Pass"));
+  CHECK_FALSE(header.hasIntParameter("energy"));
+  CHECK(header.hasFloatParameter("energy"));
+
+  auto names{ldmx::EventHeader::getParameterNames()};
+  CHECK(names.at(key) == "Pass");
+
+  header.Clear();
+  CHECK_FALSE(header.hasIntParameter("count"));
+  CHECK_THROWS_AS(header.getIntParameter("count"),
+                  framework::exception::Exception);
+}
@@ -103,6 +103,7 @@ class TestProducer : public Producer {
  * - the correct number and contents following the pattern produced by
  * TestProducer.
  * - Event::getCollection and Event::getObject don't throw errors.
+ * - Product handles find the same objects as the names.
  */
 class TestAnalyzer : public Analyzer {
  public:
@@ -113,6 +114,8 @@ class TestAnalyzer : public Analyzer {
     REQUIRE_NOTHROW(getHistoDirectory());
     test_hist_ = new TH1F("test_hist_", "Test Histogram", 101, -50, 50);
     test_hist_->SetCanExtend(TH1::kAllAxes);
+    index_handle_ = Event::getHandle("EventIndex");
+    missing_handle_ = Event::getHandle("NotInTheEvent");
   }
 
   void analyze(const framework::Event& event) final override {
@@ -147,12 +150,22 @@ class TestAnalyzer : public Analyzer {
     CHECK(i_event_from_bus.at(0) == i_event);
     CHECK(i_event_from_bus.at(1) == i_event);
 
+    CHECK(event.exists(index_handle_));
+    CHECK_FALSE(event.exists(missing_handle_));
+    CHECK(&event.getCollection<int>(index_handle_) == &i_event_from_bus);
+
     return;
   }
 
  private:
   /// test histogram filled with event indices
   TH1F* test_hist_;
+
+  /// handle to the event indices
+  ProductHandle index_handle_;
+
+  /// handle to a product nobody makes
+  ProductHandle missing_handle_;
 };  // TestAnalyzer
 
 /**
@@ -134,3 +134,46 @@ TEST_CASE("Ntuple Manager Functions", "[Framework][functionality]") {
   }
 
 }  // process test
+
+/**
+ * Test for the columns of the NtupleManager
+ *
+ * We check that variables set through their columns end up in the
+ * TTree and that vectors set this way keep their order.
+ */
+TEST_CASE("Ntuple Manager Columns", "[Framework][functionality]") {
+  const char* ntuple_file = "/tmp/test_ntuplemanager_columns.root";
+
+  TFile f(ntuple_file, "recreate");
+  framework::NtupleManager& n{framework::NtupleManager::getInstance()};
+  n.reset();
+  REQUIRE_NOTHROW(n.create("columns"));
+
+  auto int_column{n.addVar<int>("columns", "int")};
+  auto vector_column{n.addVar<std::vector<float>>("columns", "vector_float")};
+
+  std::vector<int> ints = {2, 3, 4};
+  std::vector<std::vector<float>> vector_floats = {
+      {0.3, 0.2, 0.1}, {4e6, 3e5, 2e4}, {0.999, 0.9, 0.99}};
+
+  for (size_t i = 0; i < 3; i++) {
+    n.setVar(int_column, ints.at(i));
+    n.setVar(vector_column, vector_floats.at(i));
+    n.fill();
+    n.clear();
+  }
+
+  f.Write();
+  f.Close();
+
+  TTreeReader r("columns", TFile::Open(ntuple_file));
+  TTreeReaderValue<int> root_int(r, "int");
+  TTreeReaderValue<std::vector<float>> root_vector_float(r, "vector_float");
+
+  for (size_t i = 0; i < 3; i++) {
+    REQUIRE(r.Next());
+    CHECK(*root_int == ints.at(i));
+    CHECK_THAT(*root_vector_float,
+               Catch::Matchers::Equals(vector_floats.at(i)));
+  }
+}
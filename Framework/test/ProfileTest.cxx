@@ -0,0 +1,52 @@
+/**
+ * @file ProfileTest.cxx
+ * @brief Test the timing of scopes with the Profile
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "Framework/Performance/Profile.h"
+
+namespace {
+
+/// a function with a profiled scope
+void profiled() { LDMX_PROFILE_SCOPE("ProfileTest::profiled"); }
+
+}  // namespace
+
+/**
+ * Test the Profile
+ *
+ * The scopes should only record while the profiling is enabled and the
+ * calls of all of the threads should be collected.
+ */
+TEST_CASE("Profile", "[Framework][performance]") {
+  using framework::performance::Profile;
+
+  Profile::enable(false);
+  profiled();
+
+  Profile::enable(true);
+  profiled();
+  std::vector<std::thread> threads;
+  for (int i{0}; i < 4; i++) {
+    threads.emplace_back([]() {
+      for (int j{0}; j < 10; j++) profiled();
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  Profile::enable(false);
+
+  auto stats{Profile::collect()};
+#ifdef LDMX_PROFILE_DISABLED
+  CHECK(stats.count("ProfileTest::profiled") == 0);
+#else
+  REQUIRE(stats.count("ProfileTest::profiled") == 1);
+  const auto& stat{stats.at("ProfileTest::profiled")};
+  CHECK(stat.calls == 41);
+  CHECK(stat.total >= 0.);
+  CHECK(stat.max <= stat.total);
+#endif
+}
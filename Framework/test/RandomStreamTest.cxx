@@ -0,0 +1,86 @@
+/**
+ * @file RandomStreamTest.cxx
+ * @brief Test the counter-based random number streams
+ */
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Framework/RandomStream.h"
+
+/**
+ * Test the RandomStream
+ *
+ * The generator must give the known answers of the reference implementation
+ * of Philox4x32-10 and the stream of an event must not depend on the order
+ * the events are drawn in.
+ */
+TEST_CASE("RandomStream", "[Framework][functionality]") {
+  using framework::RandomStream;
+
+  SECTION("Known answers of Philox4x32-10") {
+    CHECK(RandomStream::philox({0, 0, 0, 0}, {0, 0}) ==
+          RandomStream::Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8});
+    CHECK(RandomStream::philox({0xffffffff, 0xffffffff, 0xffffffff,
+                                0xffffffff},
+                               {0xffffffff, 0xffffffff}) ==
+          RandomStream::Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd});
+    CHECK(RandomStream::philox({0x243f6a88, 0x85a308d3, 0x13198a2e,
+                                0x03707344},
+                               {0xa4093822, 0x299f31d0}) ==
+          RandomStream::Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1});
+  }
+
+  uint64_t key{RandomStream::key(1, "processor")};
+  auto draw = [&](int event) {
+    RandomStream stream(key, 1, event);
+    std::vector<uint32_t> numbers(10);
+    for (auto& n : numbers) n = stream();
+    return numbers;
+  };
+
+  SECTION("Events in any order") {
+    std::vector<std::vector<uint32_t>> in_order;
+    for (int event{1}; event <= 20; event++) in_order.push_back(draw(event));
+
+    std::vector<int> events(20);
+    for (int i{0}; i < 20; i++) events[i] = i + 1;
+    std::shuffle(events.begin(), events.end(), std::mt19937(5));
+    for (int event : events) CHECK(draw(event) == in_order[event - 1]);
+
+    // and the events have different streams
+    CHECK(in_order[0] != in_order[1]);
+  }
+
+  SECTION("Distinct names, seeds and runs") {
+    CHECK(key != RandomStream::key(2, "processor"));
+    CHECK(key != RandomStream::key(1, "processer"));
+    RandomStream run1(key, 1, 1), run2(key, 2, 1);
+    CHECK(run1() != run2());
+  }
+
+  SECTION("Skipping through the stream") {
+    RandomStream drawn(key, 1, 1), skipped(key, 1, 1);
+    for (int i{0}; i < 7; i++) drawn();
+    skipped.discard(7);
+    CHECK(drawn() == skipped());
+    for (int i{0}; i < 3; i++) drawn();
+    skipped.discard(3);
+    CHECK(drawn() == skipped());
+  }
+
+  SECTION("Uniform numbers") {
+    RandomStream stream(key, 1, 1);
+    double sum{0.};
+    for (int i{0}; i < 10000; i++) {
+      double u{stream.uniform()};
+      REQUIRE(u > 0.);
+      REQUIRE(u < 1.);
+      sum += u;
+    }
+    CHECK(sum / 10000 > 0.49);
+    CHECK(sum / 10000 < 0.51);
+  }
+}
@@ -1,6 +1,6 @@
 #ifndef HCALALIGNPOLARFIRES_H
 #define HCALALIGNPOLARFIRES_H
-#include <queue>
+#include <vector>
 
 #include "Framework/EventProcessor.h"
 #include "Recon/Event/HgcrocDigiCollection.h"
@@ -12,6 +12,11 @@ namespace hcal {
  * - Only checking for /dropped/ events
  * - assuming that ticks and spills are already in correct ORDER
  * - assuming spill numbering is NOT the same between the two DPMs
+ *
+ * The entries waiting for a match are held in fixed-size ring buffers
+ * whose storage is reused, so a polarfire that stops sending (or whose
+ * clock drifts away from the other one) can't make the job run out of
+ * memory. When a buffer is full its oldest entry is dropped and counted.
  */
 class HcalAlignPolarfires : public framework::Producer {
   /// input decoded objects (vector index == polarfire index)
@@ -22,6 +27,8 @@ class HcalAlignPolarfires : public framework::Producer {
   std::string output_name_;
   /// number of 5MHz ticks difference to consider polarfires aligned
   static int max_tick_diff_;
+  /// maximum number of unmatched entries buffered for each polarfire
+  int max_queue_depth_;
 
  public:
   struct PolarfireQueueEntry {
@@ -30,10 +37,15 @@ class HcalAlignPolarfires : public framework::Producer {
     /// ticks since spill
     int ticks;
     ldmx::HgcrocDigiCollection digis;
+    PolarfireQueueEntry() = default;
     PolarfireQueueEntry(const framework::Event& event,
                         const std::string& input_name,
                         const std::string& input_pass,
                         std::pair<int, int>& spill_counter);
+    /// fill from the event, reusing the storage of the digis
+    void fill(const framework::Event& event, const std::string& input_name,
+              const std::string& input_pass,
+              std::pair<int, int>& spill_counter);
     bool same_event(const PolarfireQueueEntry& rhs) {
       return (spill == rhs.spill and abs(ticks - rhs.ticks) < max_tick_diff_);
     }
@@ -42,17 +54,68 @@ class HcalAlignPolarfires : public framework::Producer {
       return spill < rhs.spill;
     }
   };
+  /**
+   * First-in-first-out queue of entries in a ring buffer
+   *
+   * The entries are kept when popped so that their digi collections can
+   * be filled again without allocating.
+   */
+  class EntryQueue {
+   public:
+    /// set the maximum number of entries, dropping any queued ones
+    void setCapacity(std::size_t capacity) {
+      entries_.resize(capacity);
+      head_ = 0;
+      size_ = 0;
+    }
+    std::size_t size() const { return size_; }
+    bool full() const { return size_ == entries_.size(); }
+    PolarfireQueueEntry& front() { return entries_[head_]; }
+    /// add an entry at the back and return it to be filled, must not be full
+    PolarfireQueueEntry& push() {
+      return entries_[(head_ + size_++) % entries_.size()];
+    }
+    void pop() {
+      head_ = (head_ + 1) % entries_.size();
+      size_--;
+    }
+
+   private:
+    std::vector<PolarfireQueueEntry> entries_;
+    std::size_t head_{0}, size_{0};
+  };
   /// queue of unmatched digis
-  std::queue<PolarfireQueueEntry> pf0_queue, pf1_queue;
+  EntryQueue pf0_queue, pf1_queue;
   /// spill counter
   std::pair<int, int> pf0_spill_counter{0, -1}, pf1_spill_counter{0, -1};
 
+ private:
+  /**
+   * Put the next package of decoding into a queue
+   *
+   * @return true if the oldest entry had to be dropped to make room
+   */
+  bool enqueue(EntryQueue& queue, const framework::Event& event,
+               const std::string& input_name,
+               std::pair<int, int>& spill_counter);
+
+  /// number of events with both polarfires merged
+  long n_aligned_{0};
+  /// number of entries of each polarfire put out without a match
+  long n_unmatched_[2]{0, 0};
+  /// number of entries of each polarfire dropped from a full queue
+  long n_dropped_[2]{0, 0};
+  /// deepest each queue has been
+  std::size_t max_depth_[2]{0, 0};
+
  public:
   HcalAlignPolarfires(const std::string& n, framework::Process& p)
       : framework::Producer(n, p) {}
   virtual ~HcalAlignPolarfires() = default;
   void configure(framework::config::Parameters& ps) override;
   void produce(framework::Event& event) override;
+  /// print the alignment metrics
+  void onProcessEnd() override;
 };
 
 }  // namespace hcal
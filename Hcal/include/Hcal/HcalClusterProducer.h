@@ -22,6 +22,7 @@
 #include "DetDescr/HcalGeometry.h"
 #include "Hcal/Event/HcalCluster.h"
 #include "Hcal/Event/HcalHit.h"
+#include "Hcal/HcalHitView.h"
 #include "Hcal/MyClusterWeight.h"
 #include "Hcal/TemplatedClusterFinder.h"
 #include "Hcal/WorkingCluster.h"
@@ -54,7 +55,11 @@ class HcalClusterProducer : public framework::Producer {
   double deltaR_{0};
   double EminCluster_{0.};
   double cutOff_{0.};
+  /// Find the merges with a queue instead of scanning all the pairs
+  bool useMergeQueue_{true};
   std::string clusterCollName_;
+  /// the hits of the event as arrays, reused between events
+  HcalHitView hitView_;
 };
 
 }  // namespace hcal
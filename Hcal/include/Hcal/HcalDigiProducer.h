@@ -17,6 +17,8 @@
 #include "Recon/Event/EventConstants.h"
 #include "Recon/Event/HgcrocDigiCollection.h"
 #include "SimCore/Event/SimCalorimeterHit.h"
+#include "Tools/EmptyChannelSampler.h"
+#include "Tools/GroupByID.h"
 #include "Tools/HgcrocEmulator.h"
 #include "Tools/NoiseGenerator.h"
 
@@ -62,6 +64,9 @@ class HcalDigiProducer : public framework::Producer {
   /// output hit collection name
   std::string digiCollName_;
 
+  /// pack the digis so they take less room on disk
+  bool packDigis_;
+
   /// Time interval for chip clock in ns
   double clockCycle_;
 
@@ -87,6 +92,9 @@ class HcalDigiProducer : public framework::Producer {
   /// Hgcroc Emulator to digitize analog voltage signals
   std::unique_ptr<ldmx::HgcrocEmulator> hgcroc_;
 
+  /// Conditions, noise generator and buffers of the emulator
+  std::unique_ptr<ldmx::HgcrocEmulator::Context> hgcrocContext_;
+
   /// Conversion from time in ns to ticks of the internal clock
   double ns_;
 
@@ -95,6 +103,21 @@ class HcalDigiProducer : public framework::Producer {
 
   /// Generates Gaussian noise on top of real hits
   std::unique_ptr<TRandom3> noiseInjector_;
+
+  /// Sim hits grouped by bar, reused between events
+  ldmx::GroupByID simHitGroups_;
+
+  /// Pulses arriving at the positive end of the current bar
+  std::vector<std::pair<double, double>> pulsesPosEnd_;
+
+  /// Pulses arriving at the negative end of the current bar
+  std::vector<std::pair<double, double>> pulsesNegEnd_;
+
+  /// IDs of the bars already holding a hit when placing noise
+  std::vector<unsigned int> usedIDs_;
+
+  /// Draws the empty bars to put the noise hits in
+  std::unique_ptr<ldmx::EmptyChannelSampler> noiseChannels_;
 };
 }  // namespace hcal
 
@@ -8,6 +8,7 @@
 #include "DetDescr/HcalID.h"
 #include "Framework/EventProcessor.h"
 #include "Hcal/Event/HcalHit.h"
+#include "Hcal/HcalHitReconstruction.h"
 #include "Hcal/HcalReconConditions.h"
 #include "Recon/Event/HgcrocDigiCollection.h"
 
@@ -24,12 +25,8 @@ class HcalDoubleEndRecProducer : public framework::Producer {
   /// name of rechits to reconstruct
   std::string rec_coll_name_{"HcalRecHitsDoubleEnd"};
 
-  /// number of PEs per MIP
-  double pe_per_mip_;
-  /// energy per MIP [MeV]
-  double mip_energy_;
-  /// length of clock cycle [ns]
-  double clock_cycle_;
+  /// the reconstruction algorithm
+  DoubleEndReconstruction reconstruction_;
 
  public:
   HcalDoubleEndRecProducer(const std::string& n, framework::Process& p)
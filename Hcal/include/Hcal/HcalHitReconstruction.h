@@ -0,0 +1,132 @@
+#ifndef HCALHITRECONSTRUCTION_H
+#define HCALHITRECONSTRUCTION_H
+
+#include <tuple>
+#include <vector>
+
+#include "DetDescr/HcalDigiID.h"
+#include "DetDescr/HcalGeometry.h"
+#include "DetDescr/HcalID.h"
+#include "Framework/Configure/Parameters.h"
+#include "Hcal/Event/HcalHit.h"
+#include "Hcal/HcalReconConditions.h"
+#include "Recon/Event/HgcrocDigiCollection.h"
+#include "Tools/GroupByID.h"
+
+namespace hcal {
+
+/**
+ * @class SingleEndReconstruction
+ * @brief Reconstruct one HcalHit per digi, i.e. per end of a bar
+ *
+ * This is the algorithm of HcalSingleEndRecProducer, kept apart from the
+ * producer so that HcalRawRecProducer can run it on the digis it decodes
+ * without putting them on the event bus first.
+ */
+class SingleEndReconstruction {
+ public:
+  /**
+   * Get the parameters of the reconstruction
+   *
+   * pe_per_mip, mip_energy and clock_cycle are read from the input set,
+   * which is the configuration of the producer running it.
+   */
+  void configure(framework::config::Parameters& p);
+
+  /**
+   * Reconstruct the input digis
+   *
+   * @param[in] hcalDigis digis to reconstruct
+   * @param[in] hcalGeometry geometry for the positions of the hits
+   * @param[in] conditions calibration of each channel
+   * @param[out] hcalRecHits cleared and filled with a hit for each digi
+   */
+  void reconstruct(const ldmx::HgcrocDigiCollection& hcalDigis,
+                   const ldmx::HcalGeometry& hcalGeometry,
+                   const HcalReconConditions& conditions,
+                   std::vector<ldmx::HcalHit>& hcalRecHits);
+
+ private:
+  /**
+   * extract toa, sum adc, and sum tot from the input raw digi
+   *
+   * in the far future, we can make these member functions ofthe HgcrocDigi
+   * class; however, right now as we develop our reconstruction method it is
+   * helpful to have more flexible control on how we extract these measurements
+   *
+   * with C++17 structured bindings, this tuple return can be bound to separate
+   * variables:
+   * ```cpp
+   * auto [ toa, sum_adc, sum_tot ] =
+   * extract_measurements(digi,pedestal,bx_shift);
+   * ```
+   * giving us the dual benefit of separate variable names while only having to
+   * loop over the samples within a single digi once
+   *
+   * Uses isoi_ and clock_cycle_ member variables to convert TOA into ns since
+   * beginning of Sample Of Interest (SOI)
+   *
+   * @param[in] digi handle to HgcrocDigi to extract from
+   * @param[in] pedestal pedestal for this channel
+   * @param[in] shift in BX associated to TOA for this channel
+   * @return tuple of (toa [ns since SOI], sum_adc, sum_tot)
+   */
+  std::tuple<double, double, int> extract_measurements(
+      const ldmx::HgcrocDigiCollection::HgcrocDigi& digi, double pedestal,
+      double bx_shift) const;
+
+ private:
+  /// number of PEs per MIP
+  double pe_per_mip_;
+  /// energy per MIP [MeV]
+  double mip_energy_;
+  /// length of clock cycle [ns]
+  double clock_cycle_;
+  /// sample of interest index
+  unsigned int isoi_;
+};  // SingleEndReconstruction
+
+/**
+ * @class DoubleEndReconstruction
+ * @brief Combine the hits from the two ends of the back HCal bars
+ *
+ * This is the algorithm of HcalDoubleEndRecProducer, kept apart from the
+ * producer so that HcalRawRecProducer can run it on the single-ended hits
+ * it reconstructs without putting them on the event bus first.
+ */
+class DoubleEndReconstruction {
+ public:
+  /**
+   * Get the parameters of the reconstruction
+   *
+   * pe_per_mip and mip_energy are read from the input set, which is the
+   * configuration of the producer running it.
+   */
+  void configure(framework::config::Parameters& p);
+
+  /**
+   * Reconstruct the input single-ended hits
+   *
+   * @param[in] hcalRecHits single-ended hits to combine
+   * @param[in] hcalGeometry geometry for the positions of the bars
+   * @param[in] conditions calibration of each channel
+   * @param[out] doubleHcalRecHits cleared and filled with a hit for each
+   * back HCal bar
+   */
+  void reconstruct(const std::vector<ldmx::HcalHit>& hcalRecHits,
+                   const ldmx::HcalGeometry& hcalGeometry,
+                   const HcalReconConditions& conditions,
+                   std::vector<ldmx::HcalHit>& doubleHcalRecHits);
+
+ private:
+  /// number of PEs per MIP
+  double pe_per_mip_;
+  /// energy per MIP [MeV]
+  double mip_energy_;
+  /// rechits grouped by bar, reused between events
+  ldmx::GroupByID hitGroups_;
+};  // DoubleEndReconstruction
+
+}  // namespace hcal
+
+#endif /* HCALHITRECONSTRUCTION_H */
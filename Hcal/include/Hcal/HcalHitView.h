@@ -0,0 +1,125 @@
+/**
+ * @file HcalHitView.h
+ * @brief Structure-of-arrays copy of the HCal hits of an event
+ */
+
+#ifndef HCAL_HCALHITVIEW_H_
+#define HCAL_HCALHITVIEW_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "Hcal/Event/HcalHit.h"
+
+namespace hcal {
+
+/**
+ * The HCal hits of an event laid out as one array per quantity
+ *
+ * Looping over a std::vector<HcalHit> to look at one or two of its members
+ * reads the whole hit for each of them, and the selections made by the
+ * veto processors put branches in the middle of those loops. Here the
+ * quantities the HCal processors look at are copied into contiguous arrays
+ * once per event and the reductions over them are written as plain loops
+ * over those arrays without branches, which the compiler can vectorize.
+ *
+ * The view keeps its buffers, so when it is a member of a processor it
+ * stops allocating once it has seen the largest event.
+ * ```cpp
+ * view_.fill(hits);
+ * int imax{view_.maxPEIndex(max_time, back_min_pe)};
+ * if (imax >= 0) use(hits[imax]);
+ * ```
+ */
+class HcalHitView {
+ public:
+  /**
+   * Copy the input hits into the arrays
+   *
+   * @param[in] hits the HCal hits of the event
+   */
+  void fill(const std::vector<ldmx::HcalHit>& hits);
+
+  /// @return number of hits in the view
+  std::size_t size() const { return pe_.size(); }
+
+  /// @return the section of each hit (decoded from its HcalID)
+  const int* section() const { return section_.data(); }
+  /// @return the layer of each hit
+  const int* layer() const { return layer_.data(); }
+  /// @return the PEs of each hit
+  const float* pe() const { return pe_.data(); }
+  /// @return the smaller PEs of the two ends of each hit
+  const float* minPE() const { return minpe_.data(); }
+  /// @return the time of each hit [ns]
+  const float* time() const { return time_.data(); }
+  /// @return the energy of each hit [MeV]
+  const float* energy() const { return energy_.data(); }
+  /// @return the x position of each hit [mm]
+  const float* x() const { return x_.data(); }
+  /// @return the y position of each hit [mm]
+  const float* y() const { return y_.data(); }
+  /// @return the z position of each hit [mm]
+  const float* z() const { return z_.data(); }
+  /// @return 1 for the hits that are only noise, 0 otherwise
+  const float* noise() const { return noise_.data(); }
+
+  /**
+   * Find the hit with the most PEs among the ones the HCal veto looks at
+   *
+   * Hits at or after max_time are ignored as are hits in the back HCal
+   * whose smaller PE of the two ends is below back_min_pe. The first hit
+   * with the largest PE is returned, the same as a loop updating its
+   * maximum with maxPE < pe, and only hits above -1000 PE are considered.
+   *
+   * @param[in] max_time hits arriving at or after this time are ignored
+   * @param[in] back_min_pe minimum PE on both ends of a back HCal bar
+   * @return index of the hit or -1 if no hit passes
+   */
+  int maxPEIndex(float max_time, float back_min_pe);
+
+  /**
+   * Find the hit with the most PEs
+   *
+   * @return index of the first hit with the largest PE above -1000 or -1
+   */
+  int maxPEIndex();
+
+  /**
+   * Sum the PEs of the hits
+   *
+   * @param[in] skip_noise leave out the hits that are only noise
+   * @return total PEs
+   */
+  float sumPE(bool skip_noise = false) const;
+
+  /**
+   * Sum the energies of the hits
+   *
+   * @param[in] skip_noise leave out the hits that are only noise
+   * @return total energy [MeV]
+   */
+  float sumEnergy(bool skip_noise = false) const;
+
+ private:
+  /// index of the first largest selected_ entry above -1000, -1 if none
+  int maxSelected() const;
+
+ private:
+  std::vector<int> section_;
+  std::vector<int> layer_;
+  std::vector<float> pe_;
+  std::vector<float> minpe_;
+  std::vector<float> time_;
+  std::vector<float> energy_;
+  std::vector<float> x_;
+  std::vector<float> y_;
+  std::vector<float> z_;
+  std::vector<float> noise_;
+  /// PEs of the hits passing a selection and -inf for the others
+  std::vector<float> selected_;
+};
+
+}  // namespace hcal
+
+#endif  // HCAL_HCALHITVIEW_H_
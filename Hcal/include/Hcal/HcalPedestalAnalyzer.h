@@ -3,37 +3,26 @@
 
 #include "DetDescr/HcalDigiID.h"
 #include "Framework/EventProcessor.h"
+#include "Hcal/PedestalStatistics.h"
 #include "Recon/Event/HgcrocDigiCollection.h"
 namespace hcal {
 
 class HcalPedestalAnalyzer : public framework::Analyzer {
   std::string input_name_, input_pass_;
   std::string output_file_, comments_;
+  /// file to write the statistics to for merging, empty to not write them
+  std::string partial_file_;
+  /// files of statistics from other jobs to merge into this one
+  std::vector<std::string> merge_files_;
   bool make_histos_;
   bool filter_noTOT;
   bool filter_noTOA;
   int low_cutoff_, high_cutoff_;
 
-  struct Channel {
-    Channel() : hist{0}, sum{0}, sum_sq{0}, entries{0}, rejects{4, 0} {}
-    /// collection of hits accumulated to produce appropriately-binned
-    /// histograms
-    std::vector<int> adcs;
-    /// Histogram, if used
-    TH1* hist;
-    /// Sum of values
-    uint64_t sum;
-    /// Sum of values squared
-    double sum_sq;
-    /// Number of entries
-    int entries;
-    /// counts of various rejections
-    std::vector<int> rejects;
-  };
-
-  std::map<ldmx::HcalDigiID, Channel> pedestal_data_;
-
-  void create_and_fill(Channel& chan, ldmx::HcalDigiID detid);
+  /// statistics of each channel
+  PedestalStatistics stats_;
+
+  void create_and_fill(std::size_t chan);
 
  public:
   HcalPedestalAnalyzer(const std::string& n, framework::Process& p)
@@ -45,6 +34,9 @@ class HcalPedestalAnalyzer : public framework::Analyzer {
     input_pass_ = ps.getParameter<std::string>("input_pass");
     output_file_ = ps.getParameter<std::string>("output_file");
     comments_ = ps.getParameter<std::string>("comments");
+    partial_file_ = ps.getParameter<std::string>("partial_file", "");
+    merge_files_ = ps.getParameter<std::vector<std::string>>(
+        "merge_files", std::vector<std::string>());
 
     make_histos_ = ps.getParameter<bool>("make_histos", false);
 
@@ -54,6 +46,7 @@ class HcalPedestalAnalyzer : public framework::Analyzer {
     high_cutoff_ = ps.getParameter<int>("high_cutoff", 512);
   }
 
+  void onProcessStart() override;
   void analyze(const framework::Event& event) override;
   void onProcessEnd() override;
 };
@@ -65,6 +65,20 @@ class HcalRawDecoder : public framework::Producer {
   /// use read function to decode data, then translate EIDs into DetIDs
   void produce(framework::Event& event) override;
 
+ protected:
+  /**
+   * Decode the raw data of this event into digis
+   *
+   * The polarfire event header is put onto the event bus, but the digis
+   * are only filled in so the caller can decide what to do with them.
+   *
+   * @param[in] event event bus to read the raw data from (if not reading
+   * from a file) and to put the header on
+   * @param[out] digis collection to fill with the decoded digis
+   * @return false if there was nothing left to decode in the input file
+   */
+  bool decode(framework::Event& event, ldmx::HgcrocDigiCollection& digis);
+
  private:
   /**
    * Assume input reader behaves like a binary data input stream
@@ -394,7 +408,7 @@ class HcalRawDecoder : public framework::Producer {
     return eid_to_samples;
   }
 
- private:
+ protected:
   /// input file of encoded data
   std::string input_file_;
   /// input object of encoded data
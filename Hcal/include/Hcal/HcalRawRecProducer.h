@@ -0,0 +1,55 @@
+#ifndef HCALRAWRECPRODUCER_H
+#define HCALRAWRECPRODUCER_H
+
+#include "Hcal/HcalHitReconstruction.h"
+#include "Hcal/HcalRawDecoder.h"
+
+namespace hcal {
+
+/**
+ * @class HcalRawRecProducer
+ * @brief Decode raw HCal data and reconstruct it into hits in one producer
+ *
+ * This does the same as running HcalRawDecoder, HcalSingleEndRecProducer
+ * and (optionally) HcalDoubleEndRecProducer in sequence, except that the
+ * digis and the single-ended hits stay in this producer instead of being
+ * put onto the event bus and read back by the next one. Putting them onto
+ * the bus is optional for when they are needed downstream or for
+ * debugging, and is what makes the chain expensive when it has to keep up
+ * with the beam.
+ *
+ * The decoding parameters are the ones of HcalRawDecoder and the
+ * reconstruction parameters the ones of the rec producers.
+ */
+class HcalRawRecProducer : public HcalRawDecoder {
+ public:
+  HcalRawRecProducer(const std::string& name, framework::Process& process)
+      : HcalRawDecoder(name, process) {}
+  virtual ~HcalRawRecProducer() = default;
+  void configure(framework::config::Parameters&) override;
+  void produce(framework::Event& event) override;
+
+ private:
+  /// name of the single-ended rechits
+  std::string rec_coll_name_;
+  /// name of the double-ended rechits
+  std::string double_rec_coll_name_;
+  /// combine the two ends of the back HCal bars as well
+  bool double_end_;
+  /// put the decoded digis onto the event bus as output_name
+  bool keep_digis_;
+  /// put the single-ended hits onto the event bus when doing double_end
+  bool keep_single_end_;
+
+  /// the single-ended reconstruction
+  SingleEndReconstruction single_end_;
+  /// the double-ended reconstruction
+  DoubleEndReconstruction double_end_reco_;
+
+  /// single-ended hits of the current event
+  std::vector<ldmx::HcalHit> hits_;
+};
+
+}  // namespace hcal
+
+#endif /* HCALRAWRECPRODUCER_H */
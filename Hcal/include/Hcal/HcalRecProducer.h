@@ -14,6 +14,7 @@
 //   C++ StdLib   //
 //----------------//
 #include <memory>  //for smart pointers
+#include <vector>
 
 //----------//
 //   LDMX   //
@@ -23,14 +24,9 @@
 #include "DetDescr/HcalGeometry.h"
 #include "DetDescr/HcalID.h"
 #include "Framework/EventProcessor.h"
+#include "Hcal/HcalReconConditions.h"
 #include "Recon/Event/HgcrocDigiCollection.h"
 
-//---------//
-//  ROOT   //
-//---------//
-#include "TF1.h"
-#include "TGraph.h"
-
 namespace hcal {
 
 /**
@@ -59,9 +55,12 @@ class HcalRecProducer : public framework::Producer {
 
   /**
    * Gets Time of Arrival with respect to the SOI.
+   *
+   * @param[in] decoded decoded samples of the digi collection
+   * @param[in] iDigi index of the digi in the collection
    */
-  double getTOA(const ldmx::HgcrocDigiCollection::HgcrocDigi digi,
-                double pedestal, unsigned int iSOI) const;
+  double getTOA(const ldmx::HgcrocDigiCollection::Decoded& decoded,
+                unsigned int iDigi, double pedestal, unsigned int iSOI) const;
 
   /**
    * Produce HcalHits and put them into the event bus using the
@@ -104,8 +103,20 @@ class HcalRecProducer : public framework::Producer {
   /// Strip attenuation length [m]
   double attlength_;
 
-  /// Pulse function
-  mutable TF1 pulseFunc_;
+  /**
+   * A function tabulated at increasing x
+   *
+   * It is evaluated by linear interpolation between the points around x,
+   * or extrapolation from the first or last two points, like the Eval of
+   * a TGraph.
+   */
+  struct Table {
+    std::vector<double> x, y;
+    /// sort the points by x
+    void sort();
+    /// interpolate the function at the input x
+    double operator()(double at) const;
+  };
 
   /**
    * Correction to the pulse's measured amplitude at the peak.
@@ -113,7 +124,7 @@ class HcalRecProducer : public framework::Producer {
    *(T) over its correct value (1.0) with the ratio between sample T and sample
    *T+25ns.
    **/
-  mutable TGraph correctionAmpl_;
+  Table correctionAmpl_;
 
   /**
    * Correction to the measured TOA relative to the peak.
@@ -124,7 +135,7 @@ class HcalRecProducer : public framework::Producer {
    * TOA threshold) with the amplitude at the sample time (T) over its correct
    * value (1.0).
    */
-  mutable TGraph correctionTOA_;
+  Table correctionTOA_;
 
   /// Minimum amplitude fraction to apply amplitude correction
   double minAmplFraction_;
@@ -149,6 +160,14 @@ class HcalRecProducer : public framework::Producer {
 
   /// Time of Peak relative to pulse shape fit [ns]
   double timePeak_;
+
+  /// handle to the geometry, requested in every event
+  framework::ConditionsHandle geometry_handle_{
+      ldmx::HcalGeometry::CONDITIONS_OBJECT_NAME};
+
+  /// handle to the reconstruction conditions, requested in every event
+  framework::ConditionsHandle conditions_handle_{
+      HcalReconConditions::CONDITIONS_NAME};
 };
 }  // namespace hcal
 
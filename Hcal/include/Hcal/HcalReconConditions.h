@@ -2,7 +2,10 @@
 #ifndef HCAL_HCALRECONCONDTIONS_H_
 #define HCAL_HCALRECONCONDTIONS_H_
 
+#include <memory>
+
 #include "Conditions/SimpleTableCondition.h"
+#include "Conditions/TableColumns.h"
 #include "DetDescr/HcalDigiID.h"
 
 namespace hcal {
@@ -13,6 +16,11 @@ namespace hcal {
  * We expect all of the condition tables to only have two columns
  * (the DetID and the condition itself) so that the column number
  * for getting a value from any of them is zero.
+ *
+ * When built columnar, the tables are also copied into contiguous
+ * columns indexed by the strip and the rest of the HcalDigiID
+ * (see conditions::TableColumns) so that the per-channel accessors
+ * below are direct reads instead of binary searches over the table keys.
  */
 class HcalReconConditions : public framework::ConditionsObject {
  public:
@@ -47,11 +55,13 @@ class HcalReconConditions : public framework::ConditionsObject {
    * @param[in] adc_gain double table of ADC gains
    * @param[in] tot_calib double table of TOT calibrations
    * @param[in] toa_calib double table of TOA calibrations
+   * @param[in] columnar copy the tables into columns for faster access
    */
   HcalReconConditions(const conditions::DoubleTableCondition& adc_ped,
                       const conditions::DoubleTableCondition& adc_gain,
                       const conditions::DoubleTableCondition& tot_calib,
-                      const conditions::DoubleTableCondition& toa_calib);
+                      const conditions::DoubleTableCondition& toa_calib,
+                      bool columnar = false);
 
   /**
    * get the ADC pedestal
@@ -61,6 +71,7 @@ class HcalReconConditions : public framework::ConditionsObject {
    * @returns the ADC pedestal for that chip in counts
    */
   double adcPedestal(const ldmx::HcalDigiID& id, int idx = 0) const {
+    if (columns_) return columns_->adc_pedestals.get(id.raw(), idx);
     return adc_pedestals_.get(id.raw(), idx);
   }
 
@@ -75,6 +86,7 @@ class HcalReconConditions : public framework::ConditionsObject {
    * @returns the ADC threshold for that chip in fC/counts
    */
   double adcGain(const ldmx::HcalDigiID& id, int idx = 0) const {
+    if (columns_) return columns_->adc_gains.get(id.raw(), idx);
     return adc_gains_.get(id.raw(), idx);
   }
 
@@ -111,9 +123,22 @@ class HcalReconConditions : public framework::ConditionsObject {
    * @returns the TOT calibration for that i
    */
   double totCalib(const ldmx::HcalDigiID& id, int idx = 0) const {
+    if (columns_) return columns_->tot_calibs.get(id.raw(), idx);
     return tot_calibs_.get(id.raw(), idx);
   }
 
+  /**
+   * get all of the TOT calibration values of a channel with a single
+   * lookup of its id, indexed by the same columns as totCalib
+   *
+   * @param[in] id HCal Digi ID for specific chip
+   * @returns view of the TOT calibrations of that chip
+   */
+  conditions::TableRow<double> totCalibRow(const ldmx::HcalDigiID& id) const {
+    if (columns_) return columns_->tot_calibs.row(id.raw());
+    return tot_calibs_.row(id.raw());
+  }
+
   /**
    * get a TOA calibration value
    *
@@ -122,6 +147,7 @@ class HcalReconConditions : public framework::ConditionsObject {
    * @returns the TOA calibration for that i
    */
   double toaCalib(const ldmx::HcalDigiID& id, int idx = 0) const {
+    if (columns_) return columns_->toa_calibs.get(id.raw(), idx);
     return toa_calibs_.get(id.raw(), idx);
   }
 
@@ -134,6 +160,20 @@ class HcalReconConditions : public framework::ConditionsObject {
   const conditions::DoubleTableCondition& tot_calibs_;
   /// reference to the table of conditions storing the toa calibrations
   const conditions::DoubleTableCondition& toa_calibs_;
+
+  /// the tables copied into columns
+  struct Columns {
+    Columns(const conditions::DoubleTableCondition& adc_ped,
+            const conditions::DoubleTableCondition& adc_gain,
+            const conditions::DoubleTableCondition& tot_calib,
+            const conditions::DoubleTableCondition& toa_calib);
+    conditions::TableColumns<double> adc_pedestals;
+    conditions::TableColumns<double> adc_gains;
+    conditions::TableColumns<double> tot_calibs;
+    conditions::TableColumns<double> toa_calibs;
+  };
+  /// columns of the tables, null if not built columnar
+  std::unique_ptr<const Columns> columns_;
 };  // HcalReconConditions
 
 }  // namespace hcal
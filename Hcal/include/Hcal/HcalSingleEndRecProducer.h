@@ -8,6 +8,7 @@
 #include "DetDescr/HcalID.h"
 #include "Framework/EventProcessor.h"
 #include "Hcal/Event/HcalHit.h"
+#include "Hcal/HcalHitReconstruction.h"
 #include "Hcal/HcalReconConditions.h"
 #include "Recon/Event/HgcrocDigiCollection.h"
 
@@ -22,43 +23,8 @@ class HcalSingleEndRecProducer : public framework::Producer {
   /// name of rechits to reconstruct
   std::string rec_coll_name_{"HcalRecHits"};
 
-  /// number of PEs per MIP
-  double pe_per_mip_;
-  /// energy per MIP [MeV]
-  double mip_energy_;
-  /// length of clock cycle [ns]
-  double clock_cycle_;
-  /// sample of interest index
-  unsigned int isoi_;
-
- private:
-  /**
-   * extract toa, sum adc, and sum tot from the input raw digi
-   *
-   * in the far future, we can make these member functions ofthe HgcrocDigi
-   * class; however, right now as we develop our reconstruction method it is
-   * helpful to have more flexible control on how we extract these measurements
-   *
-   * with C++17 structured bindings, this tuple return can be bound to separate
-   * variables:
-   * ```cpp
-   * auto [ toa, sum_adc, sum_tot ] =
-   * extract_measurements(digi,pedestal,bx_shift);
-   * ```
-   * giving us the dual benefit of separate variable names while only having to
-   * loop over the samples within a single digi once
-   *
-   * Uses isoi_ and clock_cycle_ member variables to convert TOA into ns since
-   * beginning of Sample Of Interest (SOI)
-   *
-   * @param[in] digi handle to HgcrocDigi to extract from
-   * @param[in] pedestal pedestal for this channel
-   * @param[in] shift in BX associated to TOA for this channel
-   * @return tuple of (toa [ns since SOI], sum_adc, sum_tot)
-   */
-  std::tuple<double, double, int> extract_measurements(
-      const ldmx::HgcrocDigiCollection::HgcrocDigi& digi, double pedestal,
-      double bx_shift);
+  /// the reconstruction algorithm
+  SingleEndReconstruction reconstruction_;
 
  public:
   HcalSingleEndRecProducer(const std::string& n, framework::Process& p)
@@ -6,6 +6,8 @@
 //----------------//
 #include "Framework/EventProcessor.h"
 
+#include <vector>
+
 namespace hcal {
 
 /**
@@ -47,8 +49,23 @@ class HcalTrigPrimDigiProducer : public framework::Producer {
   /** Conditions object for the calibration information */
   std::string condObjName_;
 
-  /** map of digis to the super trigger primitives */
-  std::map<unsigned int, unsigned int> stq_tps;
+  /**
+   * Linear charge summed into each quad of the event
+   *
+   * Indexed by the end and the dense quad index of the trigger geometry so
+   * it is ordered like the raw IDs. The entries are zeroed again after
+   * each event.
+   */
+  std::vector<unsigned int> linearCharge_;
+
+  /** Raw IDs of the quads with charge in this event */
+  std::vector<unsigned int> filled_;
+
+  /** Linear charge summed into each STQ, indexed like linearCharge_ */
+  std::vector<unsigned int> stqCharge_;
+
+  /** Indices of the STQs with charge in this event */
+  std::vector<int> stqFilled_;
 };
 }  // namespace hcal
 
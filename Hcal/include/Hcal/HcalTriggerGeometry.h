@@ -44,9 +44,75 @@ class HcalTriggerGeometry : public framework::ConditionsObject {
   ldmx::HcalTriggerID belongsToQuad(ldmx::HcalDigiID precisionCell) const;
   ldmx::HcalTriggerID belongsToSTQ(ldmx::HcalDigiID precisionCell) const;
 
+  /**
+   * Get the dense index of a quad
+   *
+   * The quads of the geometry are numbered in the order of their IDs
+   * without the end (by section, then layer, then superstrip), so that
+   * sums over the quads can be accumulated into a flat array.
+   *
+   * @param[in] quad trigger ID of the quad, its end is ignored
+   * @return index of the quad or -1 if it is not in the geometry
+   */
+  int quadIndex(ldmx::HcalTriggerID quad) const {
+    unsigned int section = quad.section(), layer = quad.layer();
+    if (section >= first_quad_.size() or
+        layer + 1 >= first_quad_[section].size())
+      return -1;
+    int index = first_quad_[section][layer] + quad.superstrip();
+    if (index >= first_quad_[section][layer + 1]) return -1;
+    return index;
+  }
+
+  /**
+   * Get the number of quads of one end in the geometry
+   */
+  int getNumQuads() const { return num_quads_; }
+
+  /**
+   * Get the dense index of the super trigger quad (STQ) of a quad
+   *
+   * The STQs of the geometry are numbered in the order of their IDs
+   * without the end, like the quads. The STQ of a quad is the belongsToSTQ
+   * of its first strip.
+   *
+   * @param[in] quad_index dense index of the quad
+   * @return index of the STQ the quad is summed into
+   */
+  int stqIndex(int quad_index) const { return quad_stq_[quad_index]; }
+
+  /**
+   * Get the number of STQs of one end in the geometry
+   */
+  int getNumSTQs() const { return stq_ids_.size(); }
+
+  /**
+   * Get the trigger ID of an STQ from its dense index
+   *
+   * @param[in] stq_index dense index of the STQ
+   * @param[in] end end of the STQ
+   * @return trigger ID of the STQ
+   */
+  ldmx::HcalTriggerID stqID(int stq_index, int end) const {
+    ldmx::HcalTriggerID stq{stq_ids_[stq_index]};
+    return ldmx::HcalTriggerID(stq.section(), stq.layer(), stq.superstrip(),
+                               end);
+  }
+
  private:
   /** Reference to the Hcal geometry used for trigger geometry information */
   const ldmx::HcalGeometry* hcalGeometry_;
+  /**
+   * Index of the first quad of each layer of each section, indexed by
+   * the layer number with one extra entry after the last layer
+   */
+  std::vector<std::vector<int>> first_quad_;
+  /// number of quads of one end
+  int num_quads_{0};
+  /// dense index of the STQ of each quad
+  std::vector<int> quad_stq_;
+  /// trigger ID of each STQ for end zero, in the order of the dense index
+  std::vector<ldmx::HcalTriggerID> stq_ids_;
 };
 
 }  // namespace hcal
@@ -19,6 +19,7 @@
 #include "Event/HcalVetoResult.h"
 #include "Framework/Configure/Parameters.h"
 #include "Framework/EventProcessor.h"
+#include "Hcal/HcalHitView.h"
 
 namespace hcal {
 
@@ -73,6 +74,9 @@ class HcalVetoProcessor : public framework::Producer {
    */
   ldmx::HcalHit defaultMaxHit_;
 
+  /// the hits of the event as arrays, reused between events
+  HcalHitView hitView_;
+
   std::string outputCollName_;
   std::string inputHitCollName_;
   std::string inputHitPassName_;
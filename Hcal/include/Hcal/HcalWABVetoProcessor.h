@@ -21,6 +21,7 @@
 #include "Event/HcalVetoResult.h"
 #include "Framework/Configure/Parameters.h"
 #include "Framework/EventProcessor.h"
+#include "Hcal/HcalHitView.h"
 
 namespace hcal {
 
@@ -62,6 +63,10 @@ class HcalWABVetoProcessor : public framework::Producer {
   std::string inputHCALClusterCollName_;
   std::string inputHCALHitCollName_;
   std::string inputECALHitCollName_;
+  /// hit recorded as the maximum PE hit when there are no hits
+  ldmx::HcalHit defaultMaxHit_;
+  /// the hits of the event as arrays, reused between events
+  HcalHitView hitView_;
 
 };  // HcalWABVetoProcessor
 }  // namespace hcal
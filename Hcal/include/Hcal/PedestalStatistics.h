@@ -0,0 +1,148 @@
+#ifndef HCAL_PEDESTALSTATISTICS_H_
+#define HCAL_PEDESTALSTATISTICS_H_
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace hcal {
+
+/**
+ * @class PedestalStatistics
+ * @brief Streaming per-channel statistics of pedestal ADC samples
+ *
+ * Each channel keeps its number of samples, their running mean and sum of
+ * squared deviations (Welford's algorithm, which doesn't lose precision the
+ * way the sum of squares does over long runs), the counts of each of the
+ * 1024 ADC values and the counts of rejected digis. All of them live in
+ * flat arrays indexed by the order in which the channels were first seen,
+ * so the memory used only depends on the number of channels and not on the
+ * length of the run.
+ *
+ * The statistics of separate jobs can be written out, read back and merged
+ * exactly, so a pedestal run can be processed in parallel over its files.
+ */
+class PedestalStatistics {
+ public:
+  /// number of possible ADC values
+  static const int N_ADC = 1024;
+
+  /// reasons a digi is rejected
+  enum Reject {
+    REJECT_TOT = 0,
+    REJECT_TOA,
+    REJECT_UNDER,
+    REJECT_OVER,
+    N_REJECT
+  };
+
+  /**
+   * Get the index of a channel, adding it if it hasn't been seen yet
+   *
+   * @param[in] id raw HcalDigiID of the channel
+   * @return index of the channel in the arrays
+   */
+  std::size_t channel(unsigned int id);
+
+  /**
+   * Add an ADC sample to a channel
+   *
+   * @param[in] chan index of the channel
+   * @param[in] adc the sample, values outside of the ADC range only enter
+   * the mean and RMS
+   */
+  void fill(std::size_t chan, int adc) {
+    uint64_t n{++entries_[chan]};
+    double delta{adc - mean_[chan]};
+    mean_[chan] += delta / n;
+    m2_[chan] += delta * (adc - mean_[chan]);
+    if (adc >= 0 and adc < N_ADC) counts_[chan * N_ADC + adc]++;
+  }
+
+  /**
+   * Count a rejected digi of a channel
+   *
+   * @param[in] chan index of the channel
+   * @param[in] why reason the digi was rejected
+   */
+  void reject(std::size_t chan, Reject why) {
+    rejects_[chan * N_REJECT + why]++;
+  }
+
+  /**
+   * Add the statistics of another set into this one
+   *
+   * The result is the same as if all of the samples of both had been
+   * filled into this one, up to the rounding of the mean.
+   *
+   * @param[in] other statistics to merge in
+   */
+  void merge(const PedestalStatistics& other);
+
+  /// @return number of channels
+  std::size_t size() const { return ids_.size(); }
+
+  /// @return raw HcalDigiID of a channel
+  unsigned int id(std::size_t chan) const { return ids_[chan]; }
+
+  /// @return number of samples in a channel
+  uint64_t entries(std::size_t chan) const { return entries_[chan]; }
+
+  /// @return mean of the samples in a channel
+  double mean(std::size_t chan) const { return mean_[chan]; }
+
+  /// @return RMS of the samples in a channel around their mean
+  double rms(std::size_t chan) const;
+
+  /// @return number of digis of a channel rejected for the input reason
+  uint64_t rejected(std::size_t chan, Reject why) const {
+    return rejects_[chan * N_REJECT + why];
+  }
+
+  /// @return counts of the N_ADC ADC values of a channel
+  const uint64_t* counts(std::size_t chan) const {
+    return counts_.data() + chan * N_ADC;
+  }
+
+  /**
+   * Write the statistics so they can be read back and merged
+   *
+   * One line per channel: the ID in hex, the entries, mean and sum of
+   * squared deviations, the rejection counts and then the number of
+   * non-zero ADC counts followed by pairs of ADC value and count.
+   *
+   * @param[in] s stream to write to
+   */
+  void write(std::ostream& s) const;
+
+  /**
+   * Read statistics written by write and merge them into this one
+   *
+   * @throws Exception if the stream is not in the format of write
+   *
+   * @param[in] s stream to read from
+   */
+  void read(std::istream& s);
+
+ private:
+  /// mask of the fields of the HcalDigiID
+  static const unsigned int ID_MASK = 0xFFFFF;
+  /// index of each channel by the fields of its ID, -1 if not seen
+  std::vector<int> index_;
+  /// ID of each channel
+  std::vector<unsigned int> ids_;
+  /// number of samples of each channel
+  std::vector<uint64_t> entries_;
+  /// running mean of each channel
+  std::vector<double> mean_;
+  /// sum of squared deviations from the mean of each channel
+  std::vector<double> m2_;
+  /// N_REJECT rejection counts of each channel
+  std::vector<uint64_t> rejects_;
+  /// N_ADC ADC value counts of each channel
+  std::vector<uint64_t> counts_;
+};  // PedestalStatistics
+
+}  // namespace hcal
+
+#endif  // HCAL_PEDESTALSTATISTICS_H_
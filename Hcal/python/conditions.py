@@ -24,6 +24,12 @@ class HcalReconConditionsProvider(ldmxcfg.ConditionsObjectProvider) :
     toa_calib : framework::ConditionsObjectProvider
         provider for the HCal TOA calibrations
 
+    Attributes
+    ----------
+    columnar : bool
+        copy the tables into contiguous columns when they are loaded so the
+        reconstruction reads them without searching the table keys
+
     Examples
     --------
     The hcal_hardcoded_conditions.py file provides a working example where each condition
@@ -39,3 +45,4 @@ class HcalReconConditionsProvider(ldmxcfg.ConditionsObjectProvider) :
         self.adc_gain = adc_gain.objectName
         self.tot_calib = tot_calib.objectName
         self.toa_calib = toa_calib.objectName
+        self.columnar = True
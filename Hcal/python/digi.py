@@ -72,6 +72,8 @@ class HcalDigiProducer(Producer) :
         Name of input pass 
     digiCollName : str    
         Name of digi collection                                                                                                                                                                          
+    packDigis : bool
+        Pack the digis so they take less room on disk
     """
 
     def __init__(self, instance_name = 'hcalDigis') :
@@ -98,6 +100,7 @@ class HcalDigiProducer(Producer) :
         self.inputCollName = 'HcalSimHits'
         self.inputPassName = ''
         self.digiCollName = 'HcalDigis'
+        self.packDigis = False
 
 class HcalRecProducer(Producer) :
     """Configuration for the HcalRecProducer
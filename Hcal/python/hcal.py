@@ -93,5 +93,7 @@ class HcalClusterProducer(ldmxcfg.Producer) :
         self.deltaR = 0.
         self.EminCluster = 0.5 # Minimum Energy to be classed as a cluster TODO
         self.cutOff = 10.
+        # Keep the candidate merges in a queue (same clusters, faster)
+        self.useMergeQueue = True
 
         self.clusterCollName = 'HcalClusters'
@@ -26,16 +26,32 @@ class HcalPedestalAnalyzer(ldmxcfg.Analyzer) :
         Ignore any event for a channel where any sample was above this level (default=300)
     comments : str
         Comments to put into the output CSV file for logging purposes
+    partial_file : str
+        File to write the per-channel statistics to so that they can be
+        merged with the ones of other jobs (default = no file)
+    merge_files : list of str
+        Statistics written by other jobs to merge into this one before
+        the output calibration file is written (default = none)
 
 
     Examples
     --------
         from LDMX.EventProc.hcal import HcalPedestalAnalyzer
         p.sequence.append( HcalPedestalAnalyzer() )
+
+    Processing the files of a pedestal run in parallel, each job writes
+    its statistics with partial_file and then one job without events
+    (maxEvents = 0) combines them and writes the calibration file.
+
+        HcalPedestalAnalyzer(output_file='file1.csv', partial_file='file1.stats')
+        ...
+        HcalPedestalAnalyzer(output_file='pedestals.csv',
+                             merge_files=['file1.stats','file2.stats'])
     """
 
     def __init__(self,name = 'hcal_ped_ana', input_name="", input_pass="", output_file="", make_histos=False,
-                 filter_noTOT=True, filter_noTOA=True, low_cutoff=10, high_cutoff=300, comments="") :
+                 filter_noTOT=True, filter_noTOA=True, low_cutoff=10, high_cutoff=300, comments="",
+                 partial_file="", merge_files=[]) :
         super().__init__(name,'hcal::HcalPedestalAnalyzer','Hcal')
 
         self.input_name = input_name
@@ -47,5 +63,7 @@ class HcalPedestalAnalyzer(ldmxcfg.Analyzer) :
         self.low_cutoff = low_cutoff
         self.high_cutoff = high_cutoff
         self.comments=comments
+        self.partial_file = partial_file
+        self.merge_files = list(merge_files)
 
 
@@ -44,6 +44,49 @@ class HcalRawDecoder(Producer) :
             HcalDetectorMap(connections_table)
             self.translate_eid = True
 
+class HcalRawRecProducer(HcalRawDecoder) :
+    """Decode a raw buffer and reconstruct it into HCal hits in one processor
+
+    The same as running the HcalRawDecoder followed by the single (and
+    optionally double) ended rec producers from LDMX.Hcal.digi, but the
+    intermediate collections are only put on the event bus if asked for.
+    The decoding arguments are the same as HcalRawDecoder, where
+    output_name is the name of the digis if they are kept.
+
+    Parameters
+    ----------
+    rec_coll_name : str
+        Name of the single-ended rechits
+    double_end : bool
+        True to also combine the two ends of the back HCal bars
+    double_rec_coll_name : str
+        Name of the double-ended rechits
+    keep_digis : bool
+        True to put the decoded digis on the event bus as well
+    keep_single_end : bool
+        True to put the single-ended rechits on the event bus when
+        reconstructing double-ended ones
+    """
+
+    def __init__(self, output_name = 'HcalDigis',
+            rec_coll_name = 'HcalRecHits', double_end = False,
+            double_rec_coll_name = 'HcalDoubleEndRecHits',
+            keep_digis = False, keep_single_end = False, **kwargs) :
+        super().__init__(output_name, **kwargs)
+        self.instanceName = 'hcalrawrec'
+        self.className = 'hcal::HcalRawRecProducer'
+
+        from LDMX.Hcal.digi import mipEnergy, nPEPerMIP
+        self.mip_energy = mipEnergy
+        self.clock_cycle = 25.
+        self.pe_per_mip = nPEPerMIP
+
+        self.rec_coll_name = rec_coll_name
+        self.double_end = double_end
+        self.double_rec_coll_name = double_rec_coll_name
+        self.keep_digis = keep_digis
+        self.keep_single_end = keep_single_end
+
 class HcalAlignPolarfires(Producer) :
     """Align the two polarfires from testbeam into singular events
 
@@ -57,6 +100,9 @@ class HcalAlignPolarfires(Producer) :
         pass generating decoded digis
     max_tick_diff : int
         Maximum number of ticks to consider the two polarfires on the same event
+    max_queue_depth : int
+        Maximum number of unmatched entries buffered for each polarfire,
+        the oldest entry is dropped when a polarfire falls further behind
     drop_lonely_events : bool
         True if you want to drop events that only have data from one polarfire
     keep_inputs : bool
@@ -65,13 +111,15 @@ class HcalAlignPolarfires(Producer) :
     """
 
     def __init__(self, output_name, input_names, input_pass = '',
-            max_tick_diff = 10, drop_lonely_events = False, keep_inputs = False) :
+            max_tick_diff = 10, drop_lonely_events = False, keep_inputs = False,
+            max_queue_depth = 1000) :
         super().__init__('hcalalign','hcal::HcalAlignPolarfires','Hcal')
 
         self.output_name = output_name
         self.input_names = input_names
         self.input_pass = input_pass
         self.max_tick_diff = max_tick_diff
+        self.max_queue_depth = max_queue_depth
 
         from LDMX.Framework import ldmxcfg
         p = ldmxcfg.Process.lastProcess
@@ -1,10 +1,19 @@
 
 #include "Hcal/HcalAlignPolarfires.h"
+
+#include <algorithm>
+
 namespace hcal {
 int HcalAlignPolarfires::max_tick_diff_ = 10;
 HcalAlignPolarfires::PolarfireQueueEntry::PolarfireQueueEntry(
     const framework::Event& event, const std::string& input_name,
     const std::string& input_pass, std::pair<int, int>& spill_counter) {
+  fill(event, input_name, input_pass, spill_counter);
+}
+
+void HcalAlignPolarfires::PolarfireQueueEntry::fill(
+    const framework::Event& event, const std::string& input_name,
+    const std::string& input_pass, std::pair<int, int>& spill_counter) {
   int spilln = event.getObject<int>(input_name + "Spill", input_pass);
   if (spilln != spill_counter.second) {
     spill_counter.first++;
@@ -20,12 +29,35 @@ void HcalAlignPolarfires::configure(framework::config::Parameters& ps) {
   input_pass_ = ps.getParameter<std::string>("input_pass");
   output_name_ = ps.getParameter<std::string>("output_name");
   max_tick_diff_ = ps.getParameter<int>("max_tick_diff");
+  max_queue_depth_ = ps.getParameter<int>("max_queue_depth", 1000);
+  if (max_queue_depth_ < 1) {
+    EXCEPTION_RAISE("BadConfig", "The maximum queue depth must be positive.");
+  }
+  pf0_queue.setCapacity(max_queue_depth_);
+  pf1_queue.setCapacity(max_queue_depth_);
 }  // configure
 
+bool HcalAlignPolarfires::enqueue(EntryQueue& queue,
+                                  const framework::Event& event,
+                                  const std::string& input_name,
+                                  std::pair<int, int>& spill_counter) {
+  bool dropped{queue.full()};
+  if (dropped) queue.pop();
+  queue.push().fill(event, input_name, input_pass_, spill_counter);
+  return dropped;
+}
+
 void HcalAlignPolarfires::produce(framework::Event& event) {
   // put next package of decoding into the queues
-  pf0_queue.emplace(event, input_names_[0], input_pass_, pf0_spill_counter);
-  pf1_queue.emplace(event, input_names_[1], input_pass_, pf1_spill_counter);
+  //  the oldest entry is dropped if a polarfire has fallen too far behind
+  if (enqueue(pf0_queue, event, input_names_[0], pf0_spill_counter)) {
+    n_dropped_[0]++;
+  }
+  if (enqueue(pf1_queue, event, input_names_[1], pf1_spill_counter)) {
+    n_dropped_[1]++;
+  }
+  max_depth_[0] = std::max(max_depth_[0], pf0_queue.size());
+  max_depth_[1] = std::max(max_depth_[1], pf1_queue.size());
 
   // remove empty events from front of queues for end-of-file condition
   while (pf0_queue.size() > 0 and pf0_queue.front().digis.getNumDigis() == 0)
@@ -46,11 +78,12 @@ void HcalAlignPolarfires::produce(framework::Event& event) {
         auto digi{unmerged.getDigi(i)};
         std::vector<ldmx::HgcrocDigiCollection::Sample> samples;
         for (int j{0}; j < unmerged.getNumSamplesPerDigi(); j++) {
-          samples.push_back(digi.at(i));
+          samples.push_back(digi.at(j));
         }
         merged.addDigi(digi.id(), samples);
       }
       aligned = true;
+      n_aligned_++;
       pf0_queue.pop();
       pf1_queue.pop();
       setStorageHint(framework::hint_shouldKeep);
@@ -58,11 +91,13 @@ void HcalAlignPolarfires::produce(framework::Event& event) {
       // should add pf0 but signal event is unmerged
       merged = pf0_queue.front().digis;
       pf0_queue.pop();
+      n_unmatched_[0]++;
       setStorageHint(framework::hint_shouldDrop);
     } else {
       // should add pf1 but signal event is unmerged
       merged = pf1_queue.front().digis;
       pf1_queue.pop();
+      n_unmatched_[1]++;
       setStorageHint(framework::hint_shouldDrop);
     }
   } else if (pf0_queue.size() > 0) {
@@ -70,12 +105,14 @@ void HcalAlignPolarfires::produce(framework::Event& event) {
     // should add pf0 but signal event is unmerged
     merged = pf0_queue.front().digis;
     pf0_queue.pop();
+    n_unmatched_[0]++;
     setStorageHint(framework::hint_shouldDrop);
   } else if (pf1_queue.size() > 0) {
     // only pf1 has non-empty events left
     // should add pf1 but signal event is unmerged
     merged = pf1_queue.front().digis;
     pf1_queue.pop();
+    n_unmatched_[1]++;
     setStorageHint(framework::hint_shouldDrop);
   } else {
     // no more events, both decoders are returning empty events
@@ -85,6 +122,14 @@ void HcalAlignPolarfires::produce(framework::Event& event) {
   event.add(output_name_, merged);
   event.add(output_name_ + "Aligned", aligned);
 }  // produce
+
+void HcalAlignPolarfires::onProcessEnd() {
+  ldmx_log(info) << n_aligned_ << " events aligned, unmatched entries "
+                 << n_unmatched_[0] << " (pf0) " << n_unmatched_[1]
+                 << " (pf1), dropped from full queues " << n_dropped_[0]
+                 << " (pf0) " << n_dropped_[1] << " (pf1), deepest queues "
+                 << max_depth_[0] << " (pf0) " << max_depth_[1] << " (pf1)";
+}
 }  // namespace hcal
 
 DECLARE_PRODUCER_NS(hcal, HcalAlignPolarfires);
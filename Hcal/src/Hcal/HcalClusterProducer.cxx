@@ -22,6 +22,7 @@ void HcalClusterProducer::configure(framework::config::Parameters& parameters) {
   deltaR_ = parameters.getParameter<double>("deltaR");
   EminCluster_ = parameters.getParameter<double>("EminCluster");
   cutOff_ = parameters.getParameter<double>("cutOff");
+  useMergeQueue_ = parameters.getParameter<bool>("useMergeQueue", true);
 
   clusterCollName_ = parameters.getParameter<std::string>("clusterCollName");
 }
@@ -38,22 +39,28 @@ void HcalClusterProducer::produce(framework::Event& event) {
 
   std::vector<ldmx::HcalCluster> hcalClusters;
   std::list<const ldmx::HcalHit*> seedList;
-  std::vector<ldmx::HcalHit> hcalHits =
+  const std::vector<ldmx::HcalHit>& hcalHits =
       event.getCollection<ldmx::HcalHit>("HcalRecHits");
 
   if (hcalHits.empty()) {
     return;
   }
 
-  for (ldmx::HcalHit& hit : hcalHits) {
-    if (hit.getEnergy() < EnoiseCut_) continue;
-    if (hit.getEnergy() == 0) continue;
-    finder.add(&hit, hcalGeom);
+  hitView_.fill(hcalHits);
+  const float* energy{hitView_.energy()};
+  for (std::size_t i{0}; i < hitView_.size(); i++) {
+    if (energy[i] < EnoiseCut_) continue;
+    if (energy[i] == 0) continue;
+    finder.add(&hcalHits[i], hcalGeom);
   }
 
   // seedList.sort([](const ldmx::HcalHit* a, const ldmx::HcalHit* b) {return
   // a->getEnergy() > b->getEnergy();});
-  finder.cluster(EminCluster_, cutOff_, deltaTime_);
+  if (useMergeQueue_) {
+    finder.clusterWithQueue(EminCluster_, cutOff_, deltaTime_);
+  } else {
+    finder.cluster(EminCluster_, cutOff_, deltaTime_);
+  }
 
   std::vector<WorkingCluster> wcVec = finder.getClusters();
   for (unsigned int c = 0; c < wcVec.size(); c++) {
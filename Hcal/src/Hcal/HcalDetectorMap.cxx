@@ -27,9 +27,8 @@ class HcalDetectorMapLoader : public framework::ConditionsObjectProvider {
       the_map_ = new HcalDetectorMap(connections_table_, want_d2e_);
     }
 
-    return std::make_pair(
-        the_map_, framework::ConditionsIOV(context.getRun(), context.getRun(),
-                                           true, true));
+    // the map is built once from the configured tables, valid for all runs
+    return std::make_pair(the_map_, framework::ConditionsIOV(true, true));
   }
 
   /**
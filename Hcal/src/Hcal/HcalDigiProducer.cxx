@@ -8,6 +8,8 @@
 
 #include "Hcal/HcalDigiProducer.h"
 
+#include <algorithm>
+
 #include "Framework/RandomNumberSeedService.h"
 
 namespace hcal {
@@ -39,6 +41,7 @@ void HcalDigiProducer::configure(framework::config::Parameters& ps) {
   inputCollName_ = ps.getParameter<std::string>("inputCollName");
   inputPassName_ = ps.getParameter<std::string>("inputPassName");
   digiCollName_ = ps.getParameter<std::string>("digiCollName");
+  packDigis_ = ps.getParameter<bool>("packDigis", false);
 
   // physical constants
   //  used to calculate unit conversions
@@ -75,65 +78,60 @@ void HcalDigiProducer::produce(framework::Event& event) {
     noiseInjector_ = std::make_unique<TRandom3>(
         rseed.getSeed("HcalDigiProducer::NoiseInjector"));
   }
-  if (!hgcroc_->hasSeed()) {
+  if (!hgcrocContext_) {
     const auto& rseed = getCondition<framework::RandomNumberSeedService>(
         framework::RandomNumberSeedService::CONDITIONS_OBJECT_NAME);
-    hgcroc_->seedGenerator(rseed.getSeed("HcalDigiProducer::HgcrocEmulator"));
+    hgcrocContext_ = std::make_unique<ldmx::HgcrocEmulator::Context>(
+        rseed.getSeed("HcalDigiProducer::HgcrocEmulator"));
   }
 
   // Get the Hgcroc Conditions
-  hgcroc_->condition(
+  hgcrocContext_->condition(
       getCondition<conditions::DoubleTableCondition>("HcalHgcrocConditions"));
 
   // Get the Hcal Geometry
   const auto& hcalGeometry = getCondition<ldmx::HcalGeometry>(
       ldmx::HcalGeometry::CONDITIONS_OBJECT_NAME);
 
+  double ecal_dx = hcalGeometry.getEcalDx();
+  double ecal_dy = hcalGeometry.getEcalDy();
+
   // Empty collection to be filled
   ldmx::HgcrocDigiCollection hcalDigis;
   hcalDigis.setNumSamplesPerDigi(nADCs_);
   hcalDigis.setSampleOfInterestIndex(iSOI_);
 
-  std::map<unsigned int, std::vector<const ldmx::SimCalorimeterHit*>> hitsByID;
-
   // get simulated hcal hits from Geant4 and group them by id
-  auto hcalSimHits{event.getCollection<ldmx::SimCalorimeterHit>(
+  auto hcalSimHits{event.get<std::vector<ldmx::SimCalorimeterHit>>(
       inputCollName_, inputPassName_)};
-
-  for (auto const& simHit : hcalSimHits) {
-    // get ID
-    unsigned int hitID = simHit.getID();
-
-    auto idh = hitsByID.find(hitID);
-    if (idh == hitsByID.end()) {
-      hitsByID[hitID] = std::vector<const ldmx::SimCalorimeterHit*>(1, &simHit);
-    } else {
-      idh->second.push_back(&simHit);
-    }
-  }
+  simHitGroups_.group(hcalSimHits.size(), [&](std::size_t i) {
+    return static_cast<unsigned int>(hcalSimHits[i].getID());
+  });
 
   /******************************************************************************************
    * HGCROC Emulation on Simulated Hits (grouped by HcalID)
    ******************************************************************************************/
-  for (auto const& simBar : hitsByID) {
-    ldmx::HcalID detID(simBar.first);
+  for (std::size_t iBar = 0; iBar < simHitGroups_.size(); iBar++) {
+    ldmx::HcalID detID(simHitGroups_.id(iBar));
     int section = detID.section();
     int layer = detID.layer();
     int strip = detID.strip();
 
     // get position
-    double half_total_width = hcalGeometry.getHalfTotalWidth(section, layer);
-    double ecal_dx = hcalGeometry.getEcalDx();
-    double ecal_dy = hcalGeometry.getEcalDy();
+    const auto& bar{hcalGeometry.getStrip(detID)};
+    double half_total_width = bar.half_total_width;
+    const auto orientation{bar.orientation};
 
     // contributions
-    std::vector<std::pair<double, double>> pulses_posend;
-    std::vector<std::pair<double, double>> pulses_negend;
+    auto& pulses_posend{pulsesPosEnd_};
+    auto& pulses_negend{pulsesNegEnd_};
+    pulses_posend.clear();
+    pulses_negend.clear();
 
-    for (auto psimHit : simBar.second) {
-      const ldmx::SimCalorimeterHit& simHit = *psimHit;
+    for (auto iHit : simHitGroups_.indices(iBar)) {
+      const ldmx::SimCalorimeterHit& simHit = hcalSimHits[iHit];
 
-      std::vector<float> position = simHit.getPosition();
+      const float position[2]{simHit.getX(), simHit.getY()};
 
       /**
        * Define two pulses: with positive and negative ends.
@@ -166,7 +164,6 @@ void HcalDigiProducer::produce(framework::Event& event) {
       float distance_along_bar, distance_ecal;
       float distance_close, distance_far;
       int end_close;
-      const auto orientation{hcalGeometry.getScintillatorOrientation(detID)};
       if (section == ldmx::HcalID::HcalSection::BACK) {
         distance_along_bar =
             (orientation ==
@@ -242,8 +239,10 @@ void HcalDigiProducer::produce(framework::Event& event) {
           digiToAddNegend;
       ldmx::HcalDigiID posendID(section, layer, strip, 0);
       ldmx::HcalDigiID negendID(section, layer, strip, 1);
-      if (hgcroc_->digitize(posendID.raw(), pulses_posend, digiToAddPosend) &&
-          hgcroc_->digitize(negendID.raw(), pulses_negend, digiToAddNegend)) {
+      if (hgcroc_->digitize(*hgcrocContext_, posendID.raw(), pulses_posend,
+                            digiToAddPosend) &&
+          hgcroc_->digitize(*hgcrocContext_, negendID.raw(), pulses_negend,
+                            digiToAddNegend)) {
         hcalDigis.addDigi(posendID.raw(), digiToAddPosend);
         hcalDigis.addDigi(negendID.raw(), digiToAddNegend);
       }  // Back Hcal needs to digitize both pulses or none
@@ -259,12 +258,14 @@ void HcalDigiProducer::produce(framework::Event& event) {
       }
       if (is_posend) {
         ldmx::HcalDigiID digiID(section, layer, strip, 0);
-        if (hgcroc_->digitize(digiID.raw(), pulses_posend, digiToAdd)) {
+        if (hgcroc_->digitize(*hgcrocContext_, digiID.raw(), pulses_posend,
+                              digiToAdd)) {
           hcalDigis.addDigi(digiID.raw(), digiToAdd);
         }
       } else {
         ldmx::HcalDigiID digiID(section, layer, strip, 1);
-        if (hgcroc_->digitize(digiID.raw(), pulses_negend, digiToAdd)) {
+        if (hgcroc_->digitize(*hgcrocContext_, digiID.raw(), pulses_negend,
+                              digiToAdd)) {
           hcalDigis.addDigi(digiID.raw(), digiToAdd);
         }
       }
@@ -294,64 +295,76 @@ void HcalDigiProducer::produce(framework::Event& event) {
     // populate the empty channels and are above the readout threshold
     auto noiseHitAmplitudes{
         noiseGenerator_->generateNoiseHits(numEmptyChannels)};
-    std::vector<std::pair<double, double>> fake_pulse(1, {0., 0.});
-    for (double noiseHit : noiseHitAmplitudes) {
-      // generate detector ID for noise hit
-      // making sure that it is in an empty channel
-      unsigned int noiseID;
-      int sectionID, layerID, stripID, endID;
-      do {
-        sectionID = noiseInjector_->Integer(hcalGeometry.getNumSections());
-        layerID = noiseInjector_->Integer(hcalGeometry.getNumLayers(sectionID));
-        // set layer to 1 if the generator says it is 0 (geometry map starts
-        // from 1)
-        if (layerID == 0) layerID = 1;
-        stripID = noiseInjector_->Integer(
-            hcalGeometry.getNumStrips(sectionID, layerID));
-        endID = noiseInjector_->Integer(2);
-        if ((sectionID == ldmx::HcalID::HcalSection::TOP) ||
-            (sectionID == ldmx::HcalID::HcalSection::LEFT)) {
-          endID = 0;
-        } else if ((sectionID == ldmx::HcalID::HcalSection::BOTTOM) ||
-                   (sectionID == ldmx::HcalID::HcalSection::RIGHT)) {
-          endID = 1;
+    // all bars of the HCal, listed once
+    if (not noiseChannels_) {
+      std::vector<unsigned int> bars;
+      for (int section = 0; section < hcalGeometry.getNumSections();
+           section++) {
+        for (int layer = 1; layer <= hcalGeometry.getNumLayers(section);
+             layer++) {
+          for (int strip = 0; strip < hcalGeometry.getNumStrips(section, layer);
+               strip++)
+            bars.push_back(ldmx::HcalID(section, layer, strip).raw());
         }
-        auto detID = ldmx::HcalDigiID(sectionID, layerID, stripID, endID);
-        noiseID = detID.raw();
-      } while (hitsByID.find(noiseID) != hitsByID.end());
-      hitsByID[noiseID] =
-          std::vector<const ldmx::SimCalorimeterHit*>();  // mark this as used
+      }
+      noiseChannels_ =
+          std::make_unique<ldmx::EmptyChannelSampler>(std::move(bars));
+    }
+    // bars already used
+    usedIDs_.clear();
+    for (std::size_t iBar = 0; iBar < simHitGroups_.size(); iBar++)
+      usedIDs_.push_back(simHitGroups_.id(iBar));
+    // distinct empty bars for the noise hits, drawn in one go
+    const auto& noiseBars{noiseChannels_->sample(
+        usedIDs_, noiseHitAmplitudes.size(), *noiseInjector_)};
+    std::vector<std::pair<double, double>> fake_pulse(1, {0., 0.});
+    for (std::size_t iNoise = 0; iNoise < noiseBars.size(); iNoise++) {
+      ldmx::HcalID barID(noiseBars[iNoise]);
+      int sectionID = barID.section(), layerID = barID.layer(),
+          stripID = barID.strip();
+      // the single ended sections are read out at a fixed end
+      int endID = ((sectionID == ldmx::HcalID::HcalSection::BOTTOM) ||
+                   (sectionID == ldmx::HcalID::HcalSection::RIGHT))
+                      ? 1
+                      : 0;
+      unsigned int noiseID =
+          ldmx::HcalDigiID(sectionID, layerID, stripID, endID).raw();
+      double noiseHit = noiseHitAmplitudes[iNoise];
 
       // get a time for this noise hit
       fake_pulse[0].second = noiseInjector_->Uniform(clockCycle_);
 
       // noise generator gives the amplitude above the readout threshold
       // we need to convert it to the amplitude above the pedestal
-      double gain = hgcroc_->gain(noiseID);
+      double gain = hgcrocContext_->gain(noiseID);
       fake_pulse[0].first = noiseHit +
-                            gain * hgcroc_->readoutThreshold(noiseID) -
-                            gain * hgcroc_->pedestal(noiseID);
+                            gain * hgcrocContext_->readoutThreshold(noiseID) -
+                            gain * hgcrocContext_->pedestal(noiseID);
 
       if (sectionID == ldmx::HcalID::HcalSection::BACK) {
         std::vector<ldmx::HgcrocDigiCollection::Sample> digiToAddPosend,
             digiToAddNegend;
         ldmx::HcalDigiID posendID(sectionID, layerID, stripID, 0);
         ldmx::HcalDigiID negendID(sectionID, layerID, stripID, 1);
-        if (hgcroc_->digitize(posendID.raw(), fake_pulse, digiToAddPosend) &&
-            hgcroc_->digitize(negendID.raw(), fake_pulse, digiToAddNegend)) {
+        if (hgcroc_->digitize(*hgcrocContext_, posendID.raw(), fake_pulse,
+                              digiToAddPosend) &&
+            hgcroc_->digitize(*hgcrocContext_, negendID.raw(), fake_pulse,
+                              digiToAddNegend)) {
           hcalDigis.addDigi(posendID.raw(), digiToAddPosend);
           hcalDigis.addDigi(negendID.raw(), digiToAddNegend);
         }
       } else {
         std::vector<ldmx::HgcrocDigiCollection::Sample> digiToAdd;
-        if (hgcroc_->digitize(noiseID, fake_pulse, digiToAdd)) {
+        if (hgcroc_->digitize(*hgcrocContext_, noiseID, fake_pulse,
+                              digiToAdd)) {
           hcalDigis.addDigi(noiseID, digiToAdd);
         }
       }
     }  // loop over noise amplitudes
   }    // if we should add noise
 
-  event.add(digiCollName_, hcalDigis);
+  if (packDigis_) hcalDigis.pack();
+  event.add(digiCollName_, std::move(hcalDigis));
 
   return;
 }  // produce
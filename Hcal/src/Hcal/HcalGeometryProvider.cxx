@@ -31,9 +31,9 @@ class HcalGeometryProvider : public framework::ConditionsObjectProvider {
 
   /**
    * Provides access to the HcalGeometry
-   * @note Currently, these are assumed to be valid for all time, but this
-   * behavior could be changed.  Users should not cache the pointer between
-   * events
+   * @note The geometry is built once for the detector of the job and is
+   * valid for all runs.  Users should still not cache the pointer between
+   * events, but request it through the conditions system.
    */
   virtual std::pair<const framework::ConditionsObject*,
                     framework::ConditionsIOV>
@@ -140,9 +140,9 @@ HcalGeometryProvider::getCondition(const ldmx::EventHeader& context) {
     }
   }
 
-  return std::make_pair(
-      hcalGeometry_,
-      framework::ConditionsIOV(context.getRun(), context.getRun(), true, true));
+  // the geometry of a job can't change, so it is valid for every run and
+  // isn't requested again (and rebuilt downstream) when the run changes
+  return std::make_pair(hcalGeometry_, framework::ConditionsIOV(true, true));
 }
 
 }  // namespace hcal
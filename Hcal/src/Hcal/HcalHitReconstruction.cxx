@@ -0,0 +1,258 @@
+#include "Hcal/HcalHitReconstruction.h"
+
+#include <cmath>
+
+namespace hcal {
+
+void SingleEndReconstruction::configure(framework::config::Parameters& p) {
+  pe_per_mip_ = p.getParameter<double>("pe_per_mip");
+  mip_energy_ = p.getParameter<double>("mip_energy");
+  clock_cycle_ = p.getParameter<double>("clock_cycle");
+}
+
+std::tuple<double, double, int> SingleEndReconstruction::extract_measurements(
+    const ldmx::HgcrocDigiCollection::HgcrocDigi& digi, double pedestal,
+    double bx_shift) const {
+  // sum_adc = total of all but first in-time adc measurements
+  double sum_adc{0};
+  // sum_tot = total of all tot measurements
+  int sum_tot{0};
+  // first, get time of arrival w.r.t to start BX
+  int toa_sample{0}, toa_startbx{0};
+  // get the correction for the wrong BX assignment
+  // TODO: Currently not used anywhere
+  [[maybe_unused]] int bx_to_time{0};
+  // and figure out sample of maximum amplitude
+  // TODO: Currently not used anywhere
+  [[maybe_unused]] int max_sample{0};
+  double max_meas{0};
+  for (std::size_t i_sample{0}; i_sample < digi.size(); i_sample++) {
+    // adc logic
+    if (i_sample > 0) sum_adc += (digi.at(i_sample).adc_t() - pedestal);
+
+    // tot logic
+    sum_tot += digi.at(i_sample).tot();
+
+    // toa logic
+    if (digi.at(i_sample).toa() > 0) {
+      if (digi.at(i_sample).toa() >= bx_shift) {
+        toa_sample = i_sample;
+      } else {
+        toa_sample = i_sample + 1;
+      }
+
+      // sum toa in given bx - given that multiple bx may be associated with the
+      // TOA measurement
+      toa_startbx += digi.at(i_sample).toa() * (clock_cycle_ / 1024) +
+                     (clock_cycle_ * toa_sample);
+    }
+
+    if (digi.at(i_sample).adc_t() - pedestal > max_meas) {
+      max_meas = digi.at(i_sample).adc_t() - pedestal;
+      max_sample = i_sample;
+    }
+  }
+  // get toa
+  double toa = toa_startbx;
+
+  // get toa w.r.t the peak
+  // double toa = (max_sample - toa_sample) * clock_cycle_ - toa_startbx;
+  // get toa w.r.t the SOI
+  // toa += ((int)isoi_ - max_sample) * clock_cycle_;
+
+  return std::make_tuple(toa, sum_adc, sum_tot);
+}
+
+void SingleEndReconstruction::reconstruct(
+    const ldmx::HgcrocDigiCollection& hcalDigis,
+    const ldmx::HcalGeometry& hcalGeometry,
+    const HcalReconConditions& conditions,
+    std::vector<ldmx::HcalHit>& hcalRecHits) {
+  hcalRecHits.clear();
+  hcalRecHits.reserve(hcalDigis.getNumDigis());
+
+  isoi_ = hcalDigis.getSampleOfInterestIndex();
+
+  for (unsigned int iDigi = 0; iDigi < hcalDigis.getNumDigis(); iDigi++) {
+    const auto digi{hcalDigis.getDigi(iDigi)};
+    ldmx::HcalDigiID id_digi(digi.id());
+    ldmx::HcalID id(id_digi.section(), id_digi.layer(), id_digi.strip());
+
+    // amplitude/TOT reconstruction
+    double num_mips_equivalent{0};
+    auto [toa, sum_adc, sum_tot] =
+        extract_measurements(digi, conditions.adcPedestal(digi.id()),
+                             conditions.toaCalib(digi.id(), 0));
+    auto is_adc = conditions.is_adc(digi.id(), sum_tot);
+    if (is_adc) {
+      double adc_calib = sum_adc / conditions.adcGain(digi.id(), 0);
+      num_mips_equivalent = adc_calib;
+    } else {
+      double tot_calib = conditions.linearize(digi.id(), sum_tot);
+      num_mips_equivalent = tot_calib / conditions.adcGain(digi.id(), 0);
+    }
+    int PEs = num_mips_equivalent * pe_per_mip_;
+    double reconstructed_energy =
+        num_mips_equivalent * pe_per_mip_ * mip_energy_;
+
+    // time reconstruction
+    double hitTime = toa;
+
+    // position single ended (taken directly from geometry)
+    const auto& position{hcalGeometry.getStrip(id).center};
+
+    // reconstructed Hit
+    ldmx::HcalHit recHit;
+    recHit.setID(id.raw());
+    recHit.setXPos(position[0]);
+    recHit.setYPos(position[1]);
+    recHit.setZPos(position[2]);
+    recHit.setSection(id.section());
+    recHit.setStrip(id.strip());
+    recHit.setLayer(id.layer());
+    recHit.setEnd(id_digi.end());
+    recHit.setPE(PEs);
+    recHit.setMinPE(PEs);
+    recHit.setAmplitude(num_mips_equivalent);
+    recHit.setEnergy(reconstructed_energy);
+    recHit.setTime(hitTime);
+    recHit.setIsADC(is_adc);
+    hcalRecHits.push_back(recHit);
+  }
+}
+
+void DoubleEndReconstruction::configure(framework::config::Parameters& p) {
+  pe_per_mip_ = p.getParameter<double>("pe_per_mip");
+  mip_energy_ = p.getParameter<double>("mip_energy");
+}
+
+void DoubleEndReconstruction::reconstruct(
+    const std::vector<ldmx::HcalHit>& hcalRecHits,
+    const ldmx::HcalGeometry& hcalGeometry,
+    const HcalReconConditions& conditions,
+    std::vector<ldmx::HcalHit>& doubleHcalRecHits) {
+  doubleHcalRecHits.clear();
+
+  // group hcal rechits by the same HcalID
+  hitGroups_.group(hcalRecHits.size(), [&](std::size_t i) {
+    const auto& hit{hcalRecHits[i]};
+    return ldmx::HcalID(hit.getSection(), hit.getLayer(), hit.getStrip())
+        .raw();
+  });
+
+  // reconstruct double-ended hits
+  for (std::size_t iBar = 0; iBar < hitGroups_.size(); iBar++) {
+    ldmx::HcalID id(hitGroups_.id(iBar));
+    auto hcalBar{hitGroups_.indices(iBar)};
+
+    // make a pair of hcal rechits indices that belong to the same pulse
+    // @TODO: for now we just take the first two indices that have
+    //        opposite-ends we do not cover the case where two hits come
+    //        separated in time
+    std::pair<int, int> indices(-1, -1);
+    int iHit = 0;
+    while (iHit < hcalBar.size()) {
+      const auto& hit = hcalRecHits[hcalBar[iHit]];
+
+      ldmx::HcalDigiID digi_id(hit.getSection(), hit.getLayer(), hit.getStrip(),
+                               hit.getEnd());
+      if (digi_id.isNegativeEnd() && indices.second == -1) {
+        indices.second = iHit;
+      }
+      if (!digi_id.isNegativeEnd() && indices.first == -1) {
+        indices.first = iHit;
+      }
+      iHit++;
+    }
+
+    // get bar position from geometry
+    const auto& strip{hcalGeometry.getStrip(id)};
+    TVector3 position(strip.center[0], strip.center[1], strip.center[2]);
+    const auto orientation{strip.orientation};
+
+    // skip non-double-ended layers
+    if (id.section() != ldmx::HcalID::HcalSection::BACK) continue;
+
+    // get two hits to reconstruct
+    const auto& hitPosEnd = hcalRecHits[hcalBar.at(indices.first)];
+    const auto& hitNegEnd = hcalRecHits[hcalBar.at(indices.second)];
+
+    // update TOA hit with negative end with mean shift
+    ldmx::HcalDigiID digi_id_pos(hitPosEnd.getSection(), hitPosEnd.getLayer(),
+                                 hitPosEnd.getStrip(), hitPosEnd.getEnd());
+    ldmx::HcalDigiID digi_id_neg(hitNegEnd.getSection(), hitNegEnd.getLayer(),
+                                 hitNegEnd.getStrip(), hitNegEnd.getEnd());
+    double mean_shift = conditions.toaCalib(digi_id_neg.raw(), 1);
+
+    double pos_time = hitPosEnd.getTime();
+    double neg_time = hitNegEnd.getTime();
+    if (pos_time != 0 || neg_time != 0) {
+      neg_time = neg_time - mean_shift;
+    }
+
+    // update position in strip according to time measurement
+    double v =
+        299.792 / 1.6;  // velocity of light in polystyrene, n = 1.6 = c/v
+    double hitTimeDiff = pos_time - neg_time;
+
+    // std::cout << "\n new hit " << std::endl;
+    // std::cout << "strip " << id.strip() << " layer " << id.layer() << "
+    // center position " << position.X() << " " << position.Y() << " " <<
+    // position.Z() << std::endl; std::cout << "hittime pos " << pos_time << "
+    // neg " << neg_time << " bar sign " << " diff " << hitTimeDiff <<
+    // std::endl;
+
+    int position_bar_sign = hitTimeDiff > 0 ? 1 : -1;
+    double position_unchanged = 0;
+    int isX = 0;
+    double position_bar = position_bar_sign * fabs(hitTimeDiff) * v / 2;
+    if (orientation ==
+        ldmx::HcalGeometry::ScintillatorOrientation::horizontal) {
+      position_unchanged = position.X();
+      isX = 1;
+      position.SetX(position_bar);
+    } else {
+      position_unchanged = position.Y();
+      isX = 0;
+      position.SetY(position_bar);
+    }
+    // std::cout << "position unchanged " << position_unchanged << " isx " <<
+    // isX << std::endl; std::cout << "newposition " << position.X() << " " <<
+    // position.Y() << " " << position.Z() << std::endl;
+
+    // TODO: switch unique hit time for this pulse
+    [[maybe_unused]] double hitTime =
+        (hitPosEnd.getTime() + hitNegEnd.getTime());
+
+    // amplitude and PEs
+    double num_mips_equivalent =
+        (hitPosEnd.getAmplitude() + hitNegEnd.getAmplitude());
+    double PEs = (hitPosEnd.getPE() + hitNegEnd.getPE());
+    double reconstructed_energy =
+        num_mips_equivalent * pe_per_mip_ * mip_energy_;
+
+    // reconstructed Hit
+    ldmx::HcalHit recHit;
+    recHit.setID(id.raw());
+    recHit.setXPos(position.X());
+    recHit.setYPos(position.Y());
+    recHit.setZPos(position.Z());
+    recHit.setSection(id.section());
+    recHit.setStrip(id.strip());
+    recHit.setLayer(id.layer());
+    recHit.setPE(PEs);
+    recHit.setMinPE(std::min(hitPosEnd.getPE(), hitNegEnd.getPE()));
+    recHit.setAmplitude(num_mips_equivalent);
+    recHit.setAmplitudePos(hitPosEnd.getAmplitude());
+    recHit.setAmplitudeNeg(hitNegEnd.getAmplitude());
+    recHit.setToaPos(hitPosEnd.getTime());
+    recHit.setToaNeg(hitNegEnd.getTime());
+    recHit.setEnergy(reconstructed_energy);
+    recHit.setTime(hitTimeDiff);
+    recHit.setTimeDiff(hitPosEnd.getTime() - hitNegEnd.getTime());
+    recHit.setPositionUnchanged(position_unchanged, isX);
+    doubleHcalRecHits.push_back(recHit);
+  }
+}
+
+}  // namespace hcal
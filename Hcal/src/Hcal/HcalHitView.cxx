@@ -0,0 +1,79 @@
+#include "Hcal/HcalHitView.h"
+
+#include <limits>
+
+#include "DetDescr/HcalID.h"
+
+namespace hcal {
+
+void HcalHitView::fill(const std::vector<ldmx::HcalHit>& hits) {
+  std::size_t n{hits.size()};
+  section_.resize(n);
+  layer_.resize(n);
+  pe_.resize(n);
+  minpe_.resize(n);
+  time_.resize(n);
+  energy_.resize(n);
+  x_.resize(n);
+  y_.resize(n);
+  z_.resize(n);
+  noise_.resize(n);
+  for (std::size_t i{0}; i < n; i++) {
+    const ldmx::HcalHit& hit{hits[i]};
+    section_[i] = ldmx::HcalID(hit.getID()).section();
+    layer_[i] = hit.getLayer();
+    pe_[i] = hit.getPE();
+    minpe_[i] = hit.getMinPE();
+    time_[i] = hit.getTime();
+    energy_[i] = hit.getEnergy();
+    x_[i] = hit.getXPos();
+    y_[i] = hit.getYPos();
+    z_[i] = hit.getZPos();
+    noise_[i] = hit.isNoise() ? 1.f : 0.f;
+  }
+}
+
+int HcalHitView::maxPEIndex(float max_time, float back_min_pe) {
+  constexpr float none{-std::numeric_limits<float>::infinity()};
+  std::size_t n{size()};
+  selected_.resize(n);
+  for (std::size_t i{0}; i < n; i++) {
+    bool keep = (time_[i] < max_time) and
+                (section_[i] != ldmx::HcalID::BACK or minpe_[i] >= back_min_pe);
+    selected_[i] = keep ? pe_[i] : none;
+  }
+  return maxSelected();
+}
+
+int HcalHitView::maxPEIndex() {
+  selected_.assign(pe_.begin(), pe_.end());
+  return maxSelected();
+}
+
+float HcalHitView::sumPE(bool skip_noise) const {
+  float sum{0};
+  for (std::size_t i{0}; i < size(); i++)
+    sum += (skip_noise and noise_[i] != 0) ? 0.f : pe_[i];
+  return sum;
+}
+
+float HcalHitView::sumEnergy(bool skip_noise) const {
+  float sum{0};
+  for (std::size_t i{0}; i < size(); i++)
+    sum += (skip_noise and noise_[i] != 0) ? 0.f : energy_[i];
+  return sum;
+}
+
+int HcalHitView::maxSelected() const {
+  // the largest value first and then where it is, so neither loop
+  // has to carry an index along with the maximum
+  float max{-1000};
+  for (float pe : selected_) max = (max < pe) ? pe : max;
+  if (max == -1000) return -1;
+  for (std::size_t i{0}; i < selected_.size(); i++) {
+    if (selected_[i] == max) return i;
+  }
+  return -1;
+}
+
+}  // namespace hcal
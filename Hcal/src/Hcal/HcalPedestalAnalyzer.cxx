@@ -3,17 +3,30 @@
 
 #include "Hcal/HcalPedestalAnalyzer.h"
 
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+
 namespace hcal {
 
+void HcalPedestalAnalyzer::onProcessStart() {
+  for (const auto& file : merge_files_) {
+    std::ifstream fin(file);
+    if (not fin.is_open()) {
+      EXCEPTION_RAISE("FileError",
+                      "Unable to open pedestal statistics '" + file + "'.");
+    }
+    stats_.read(fin);
+  }
+}
+
 void HcalPedestalAnalyzer::analyze(const framework::Event& event) {
   auto const& digis{
       event.getObject<ldmx::HgcrocDigiCollection>(input_name_, input_pass_)};
 
   for (std::size_t i_digi{0}; i_digi < digis.size(); i_digi++) {
     auto d{digis.getDigi(i_digi)};
-    ldmx::HcalDigiID detid(d.id());
-
-    Channel& chan = pedestal_data_[detid];
+    std::size_t chan{stats_.channel(d.id())};
 
     bool has_tot = false;
     bool has_toa = false;
@@ -27,10 +40,12 @@ void HcalPedestalAnalyzer::analyze(const framework::Event& event) {
       if (d.at(i).adc_t() > high_cutoff_) has_over = true;
     }
 
-    if (has_tot && filter_noTOT) chan.rejects[0]++;
-    if (has_toa && filter_noTOA) chan.rejects[1]++;
-    if (has_under) chan.rejects[2]++;
-    if (has_over) chan.rejects[3]++;
+    if (has_tot && filter_noTOT)
+      stats_.reject(chan, PedestalStatistics::REJECT_TOT);
+    if (has_toa && filter_noTOA)
+      stats_.reject(chan, PedestalStatistics::REJECT_TOA);
+    if (has_under) stats_.reject(chan, PedestalStatistics::REJECT_UNDER);
+    if (has_over) stats_.reject(chan, PedestalStatistics::REJECT_OVER);
 
     if (has_tot && filter_noTOT) continue;  // ignore this
     if (has_toa && filter_noTOA) continue;  // ignore this
@@ -41,44 +56,51 @@ void HcalPedestalAnalyzer::analyze(const framework::Event& event) {
                  // requirement
 
     for (int i = 0; i < digis.getNumSamplesPerDigi(); i++) {
-      int adc = d.at(i).adc_t();
-
-      chan.sum += adc;
-      chan.sum_sq += adc * adc;
-      chan.entries++;
-      if (chan.hist)
-        chan.hist->Fill(adc);
-      else if (make_histos_)
-        chan.adcs.push_back(adc);
+      stats_.fill(chan, d.at(i).adc_t());
     }
-
-    // histogram-related business
-    if (make_histos_ && !chan.hist && chan.entries > 250)
-      create_and_fill(chan, detid);
   }
 }
 
-void HcalPedestalAnalyzer::create_and_fill(Channel& chan,
-                                           ldmx::HcalDigiID detid) {
-  if (chan.entries == 0) return;
-
+void HcalPedestalAnalyzer::create_and_fill(std::size_t chan) {
+  ldmx::HcalDigiID detid(stats_.id(chan));
   TDirectory* hdir = getHistoDirectory();
   hdir->cd();
   char hname[120];
   sprintf(hname, "pedestal_%d_%d_%d_%d", detid.section(), detid.layer(),
           detid.strip(), detid.end());
-  // logic: 100 bins to +/- 5 sigma based on first 250 events.
-  double mean = (chan.sum * 1.0) / chan.entries;
-  double rms = sqrt(chan.sum_sq / chan.entries - mean * mean);
+  // logic: 100 bins to +/- 5 sigma
+  double mean = stats_.mean(chan);
+  double rms = stats_.rms(chan);
+  TH1* hist;
   if (rms * 5 < 50)
-    chan.hist = new TH1D(hname, hname, 30, int(mean) - 15, int(mean) + 15);
+    hist = new TH1D(hname, hname, 30, int(mean) - 15, int(mean) + 15);
   else
-    chan.hist = new TH1D(hname, hname, 100, mean - 5 * rms, mean + 5 * rms);
-  for (auto x : chan.adcs) chan.hist->Fill(x);
-  chan.adcs.clear();
+    hist = new TH1D(hname, hname, 100, mean - 5 * rms, mean + 5 * rms);
+  // the samples are only kept as counts of each ADC value
+  const uint64_t* counts{stats_.counts(chan)};
+  for (int adc{0}; adc < PedestalStatistics::N_ADC; adc++) {
+    if (counts[adc] > 0) hist->Fill(adc, counts[adc]);
+  }
+  hist->SetEntries(stats_.entries(chan));
 }
 
 void HcalPedestalAnalyzer::onProcessEnd() {
+  if (not partial_file_.empty()) {
+    std::ofstream partial(partial_file_);
+    if (not partial.is_open()) {
+      EXCEPTION_RAISE("FileError", "Unable to open pedestal statistics '" +
+                                       partial_file_ + "' for writing.");
+    }
+    stats_.write(partial);
+  }
+
+  // channels in the order of their IDs
+  std::vector<std::size_t> order(stats_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+    return stats_.id(a) < stats_.id(b);
+  });
+
   FILE* fout = fopen(output_file_.c_str(), "w");
 
   time_t t = time(NULL);
@@ -89,19 +111,26 @@ void HcalPedestalAnalyzer::onProcessEnd() {
   fprintf(fout, "# Produced %s\n", times);
   fprintf(fout, "DetID,PEDESTAL_ADC,PEDESTAL_RMS_ADC\n");
 
-  for (auto ichan : pedestal_data_) {
-    if (ichan.second.entries == 0) {
-      std::cout << "All entries filtered for " << ichan.first << " for TOT "
-                << ichan.second.rejects[0] << " for TOA "
-                << ichan.second.rejects[1] << " for underthreshold "
-                << ichan.second.rejects[2] << " for overthreshold "
-                << ichan.second.rejects[3] << std::endl;
+  for (std::size_t chan : order) {
+    ldmx::HcalDigiID detid(stats_.id(chan));
+    if (stats_.entries(chan) == 0) {
+      std::cout << "All entries filtered for " << detid << " for TOT "
+                << stats_.rejected(chan, PedestalStatistics::REJECT_TOT)
+                << " for TOA "
+                << stats_.rejected(chan, PedestalStatistics::REJECT_TOA)
+                << " for underthreshold "
+                << stats_.rejected(chan, PedestalStatistics::REJECT_UNDER)
+                << " for overthreshold "
+                << stats_.rejected(chan, PedestalStatistics::REJECT_OVER)
+                << std::endl;
       continue;  // all entries were filtered out
     }
 
-    double mean = ichan.second.sum * 1.0 / ichan.second.entries;
-    double rms = sqrt(ichan.second.sum_sq / ichan.second.entries - mean * mean);
-    fprintf(fout, "0x%08x,%9.3f,%9.3f\n", ichan.first.raw(), mean, rms);
+    // histogram-related business
+    if (make_histos_ && stats_.entries(chan) > 250) create_and_fill(chan);
+
+    fprintf(fout, "0x%08x,%9.3f,%9.3f\n", detid.raw(), stats_.mean(chan),
+            stats_.rms(chan));
   }
 
   fclose(fout);
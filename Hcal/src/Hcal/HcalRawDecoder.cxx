@@ -1,6 +1,9 @@
 
 
 #include "Hcal/HcalRawDecoder.h"
+
+#include "Packing/Utility/BufferReader.h"
+
 // un comment for HcalRawDecoder-specific debug printouts to std::cout
 //#define DEBUG
 
@@ -15,9 +18,11 @@ class Reader {
   const std::vector<uint8_t>& buffer_;
   std::size_t i_word_;
   uint32_t next() {
-    uint32_t w = buffer_.at(i_word_) | (buffer_.at(i_word_ + 1) << 8) |
-                 (buffer_.at(i_word_ + 2) << 16) |
-                 (buffer_.at(i_word_ + 3) << 24);
+    if (i_word_ + 4 > buffer_.size()) {
+      throw std::out_of_range("Reader: word past the end of buffer");
+    }
+    uint32_t w = packing::utility::fromLittleEndian<uint32_t>(buffer_.data() +
+                                                              i_word_);
     i_word_ += 4;
     return w;
   }
@@ -94,12 +99,24 @@ void HcalRawDecoder::beforeNewRun(ldmx::RunHeader& rh) {
 }
 
 void HcalRawDecoder::produce(framework::Event& event) {
+  ldmx::HgcrocDigiCollection digis;
+  if (not decode(event, digis)) return;
+#ifdef DEBUG
+  std::cout << "adding " << digis.getNumDigis() << " digis each with "
+            << digis.getNumSamplesPerDigi() << " samples to event bus"
+            << std::endl;
+#endif
+  event.add(output_name_, std::move(digis));
+}  // produce
+
+bool HcalRawDecoder::decode(framework::Event& event,
+                            ldmx::HgcrocDigiCollection& digis) {
   std::map<ldmx::HcalElectronicsID,
            std::vector<ldmx::HgcrocDigiCollection::Sample>>
       eid_to_samples;
   PolarfireEventHeader eh;
   if (read_from_file_) {
-    if (!file_reader_ or file_reader_.eof()) return;
+    if (!file_reader_ or file_reader_.eof()) return false;
     eid_to_samples = this->read(file_reader_, eh);
   } else {
     for (const auto& name : input_names_) {
@@ -114,7 +131,6 @@ void HcalRawDecoder::produce(framework::Event& event) {
 
   eh.board(event, output_name_);
 
-  ldmx::HgcrocDigiCollection digis;
   // assume all channels have same number of samples
   digis.setNumSamplesPerDigi(eid_to_samples.begin()->second.size());
   digis.setSampleOfInterestIndex(0);  // TODO configurable
@@ -131,7 +147,7 @@ void HcalRawDecoder::produce(framework::Event& event) {
     std::cout << "Translating EIDs into DetIDs. Printing skipped EIDs..."
               << std::endl;
 #endif
-    auto detmap{
+    const auto& detmap{
         getCondition<HcalDetectorMap>(HcalDetectorMap::CONDITIONS_OBJECT_NAME)};
     for (auto const& [eid, digi] : eid_to_samples) {
       // The electronics map returns an empty ID of the correct
@@ -169,14 +185,8 @@ void HcalRawDecoder::produce(framework::Event& event) {
     }
   }
 
-#ifdef DEBUG
-  std::cout << "adding " << digis.getNumDigis() << " digis each with "
-            << digis.getNumSamplesPerDigi() << " samples to event bus"
-            << std::endl;
-#endif
-  event.add(output_name_, digis);
-  return;
-}  // produce
+  return true;
+}  // decode
 
 }  // namespace hcal
 DECLARE_PRODUCER_NS(hcal, HcalRawDecoder);
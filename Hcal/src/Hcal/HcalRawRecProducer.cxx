@@ -0,0 +1,41 @@
+#include "Hcal/HcalRawRecProducer.h"
+
+namespace hcal {
+
+void HcalRawRecProducer::configure(framework::config::Parameters& ps) {
+  HcalRawDecoder::configure(ps);
+  rec_coll_name_ = ps.getParameter<std::string>("rec_coll_name");
+  double_rec_coll_name_ = ps.getParameter<std::string>("double_rec_coll_name");
+  double_end_ = ps.getParameter<bool>("double_end");
+  keep_digis_ = ps.getParameter<bool>("keep_digis", false);
+  keep_single_end_ = ps.getParameter<bool>("keep_single_end", false);
+  single_end_.configure(ps);
+  if (double_end_) double_end_reco_.configure(ps);
+}
+
+void HcalRawRecProducer::produce(framework::Event& event) {
+  ldmx::HgcrocDigiCollection digis;
+  if (not decode(event, digis)) return;
+
+  const auto& hcalGeometry = getCondition<ldmx::HcalGeometry>(
+      ldmx::HcalGeometry::CONDITIONS_OBJECT_NAME);
+
+  const auto& conditions{
+      getCondition<HcalReconConditions>(HcalReconConditions::CONDITIONS_NAME)};
+
+  single_end_.reconstruct(digis, hcalGeometry, conditions, hits_);
+  if (keep_digis_) event.add(output_name_, std::move(digis));
+
+  if (double_end_) {
+    std::vector<ldmx::HcalHit> doubleHcalRecHits;
+    double_end_reco_.reconstruct(hits_, hcalGeometry, conditions,
+                                 doubleHcalRecHits);
+    event.add(double_rec_coll_name_, std::move(doubleHcalRecHits));
+    if (keep_single_end_) event.add(rec_coll_name_, std::move(hits_));
+  } else {
+    event.add(rec_coll_name_, std::move(hits_));
+  }
+}
+
+}  // namespace hcal
+DECLARE_PRODUCER_NS(hcal, HcalRawRecProducer);
@@ -7,6 +7,11 @@
 
 #include "Hcal/HcalRecProducer.h"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "DetDescr/IDMap.h"
 #include "Hcal/Event/HcalHit.h"
 #include "Hcal/HcalReconConditions.h"
 #include "Recon/Event/HgcrocDigiCollection.h"
@@ -41,63 +46,103 @@ void HcalRecProducer::configure(framework::config::Parameters& ps) {
   rateDnSlope_ = ps.getParameter<double>("rateDnSlope");
   timeDnSlope_ = ps.getParameter<double>("timeDnSlope");
   timePeak_ = ps.getParameter<double>("timePeak");
-  pulseFunc_ =
-      TF1("pulseFunc",
-          "[0]*((1.0+exp([1]*(-[2]+[3])))*(1.0+exp([5]*(-[6]+[3]))))/"
-          "((1.0+exp([1]*(x-[2]+[3]-[4])))*(1.0+exp([5]*(x-[6]+[3]-[4]))))",
-          (double)nADCs_ * clock_cycle_ * -1, (double)nADCs_ * clock_cycle_);
-  pulseFunc_.FixParameter(1, rateUpSlope_);
-  pulseFunc_.FixParameter(2, timeUpSlope_);
-  pulseFunc_.FixParameter(3, timePeak_);
-  pulseFunc_.FixParameter(5, rateDnSlope_);
-  pulseFunc_.FixParameter(6, timeDnSlope_);
-  pulseFunc_.FixParameter(4, 0);
-  pulseFunc_.FixParameter(0, 1);
+
+  // the pulse shape of the HGCROC emulator normalized to one at t = 0,
+  //  [0]*((1.0+exp([1]*(-[2]+[3])))*(1.0+exp([5]*(-[6]+[3]))))/
+  //  ((1.0+exp([1]*(x-[2]+[3]-[4])))*(1.0+exp([5]*(x-[6]+[3]-[4]))))
+  // with [0] = 1 and [4] = 0
+  const double norm{(1.0 + exp(rateUpSlope_ * (-timeUpSlope_ + timePeak_))) *
+                    (1.0 + exp(rateDnSlope_ * (-timeDnSlope_ + timePeak_)))};
+  auto pulse = [&](double t) {
+    return norm /
+           ((1.0 + exp(rateUpSlope_ * (t - timeUpSlope_ + timePeak_))) *
+            (1.0 + exp(rateDnSlope_ * (t - timeDnSlope_ + timePeak_))));
+  };
 
   // build amplitude correction (Ampl[t-1]/Ampl[t]) with pulse-shape
   int n = 0;
+  correctionAmpl_ = Table();
   for (double t = -clock_cycle_; t < clock_cycle_; t += 0.01) {
-    double ampl_t = pulseFunc_.Eval(t);
-    double ampl_tm1 = pulseFunc_.Eval(t - clock_cycle_);
+    double ampl_t = pulse(t);
+    double ampl_tm1 = pulse(t - clock_cycle_);
     if (ampl_tm1 > ampl_t) continue;
-    correctionAmpl_.SetPoint(n, ampl_tm1 / ampl_t, ampl_t);
+    correctionAmpl_.x.push_back(ampl_tm1 / ampl_t);
+    correctionAmpl_.y.push_back(ampl_t);
     if (n == 0) minAmplFraction_ = ampl_tm1 / ampl_t;
     n++;
   }
+  correctionAmpl_.sort();
+
+  // tabulate the rising edge of the pulse-shape over the readout window,
+  // up to its peak, so the time it crosses a level can be interpolated
+  const double window_start{(double)nADCs_ * clock_cycle_ * -1},
+      window_end{(double)nADCs_ * clock_cycle_};
+  Table rising;
+  for (double t = window_start; t <= window_end; t += 0.01) {
+    double ampl = pulse(t);
+    if (not rising.x.empty() and ampl <= rising.x.back()) break;
+    rising.x.push_back(ampl);
+    rising.y.push_back(t);
+  }
 
   // build TOA timewalk correction with pulse-shape
   double toaThreshold = ps.getParameter<double>("avgToaThreshold");
   double gain = ps.getParameter<double>("avgGain");
   double pedestal = ps.getParameter<double>("avgPedestal");
   n = 0;
+  correctionTOA_ = Table();
   for (double ampl = toaThreshold + 0.1; ampl < 10000; ampl += 0.01) {
-    pulseFunc_.FixParameter(0, ampl);
-    double ampl_t = gain * pedestal + pulseFunc_.Eval(0);
-    double toa =
-        fabs(pulseFunc_.GetX(toaThreshold, (double)nADCs_ * clock_cycle_ * -1,
-                             (double)nADCs_ * clock_cycle_));
-    correctionTOA_.SetPoint(n, ampl_t, toa);
+    double ampl_t = gain * pedestal + ampl;
+    // first time the pulse of this amplitude crosses the threshold
+    double toa = fabs(rising(toaThreshold / ampl));
+    correctionTOA_.x.push_back(ampl_t);
+    correctionTOA_.y.push_back(toa);
     if (n == 0) minAmpl_ = ampl_t;
     n++;
   }
-  correctionTOA_.SetBit(TGraph::kIsSortedX);
+}
+
+void HcalRecProducer::Table::sort() {
+  std::vector<std::size_t> order(x.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](std::size_t a, std::size_t b) { return x[a] < x[b]; });
+  std::vector<double> sorted_x, sorted_y;
+  sorted_x.reserve(x.size());
+  sorted_y.reserve(y.size());
+  for (std::size_t i : order) {
+    sorted_x.push_back(x[i]);
+    sorted_y.push_back(y[i]);
+  }
+  x.swap(sorted_x);
+  y.swap(sorted_y);
+}
+
+double HcalRecProducer::Table::operator()(double at) const {
+  if (x.size() < 2) return y.empty() ? 0. : y.front();
+  // the two points around at, or the first or last two points
+  std::size_t up = std::upper_bound(x.begin(), x.end(), at) - x.begin();
+  up = std::min(std::max(up, std::size_t(1)), x.size() - 1);
+  std::size_t low = up - 1;
+  if (x[up] == x[low]) return y[low];
+  return y[low] + (at - x[low]) * (y[up] - y[low]) / (x[up] - x[low]);
 }
 
 double HcalRecProducer::getTOA(
-    const ldmx::HgcrocDigiCollection::HgcrocDigi digi, double pedestal,
-    unsigned int iSOI) const {
+    const ldmx::HgcrocDigiCollection::Decoded& decoded, unsigned int iDigi,
+    double pedestal, unsigned int iSOI) const {
   // get toa relative to the startBX
   double toaRelStartBX(0.), maxMeas{0.};
   int toaSample(0), maxSample(0), iADC(0);
-  for (int i_sample{0}; i_sample < digi.size(); i_sample++) {
-    auto sample{digi.at(i_sample)};
-    if (sample.toa() > 0) {
-      toaRelStartBX = sample.toa() * (clock_cycle_ / 1024);  // ns
+  for (int i_sample{0}; i_sample < decoded.num_samples; i_sample++) {
+    std::size_t i{decoded.index(iDigi, i_sample)};
+    if (decoded.toa[i] > 0) {
+      toaRelStartBX = decoded.toa[i] * (clock_cycle_ / 1024);  // ns
       // find in which ADC sample the TOA was taken
       toaSample = iADC;
     }
-    if ((sample.adc_t() - pedestal) > maxMeas) {
-      maxMeas = (sample.adc_t() - pedestal);
+    if ((decoded.adc_t[i] - pedestal) > maxMeas) {
+      maxMeas = (decoded.adc_t[i] - pedestal);
       maxSample = iADC;
     }
     iADC++;
@@ -114,17 +159,18 @@ double HcalRecProducer::getTOA(
 
 void HcalRecProducer::produce(framework::Event& event) {
   // get the Hcal Geometry
-  const auto& hcalGeometry = getCondition<ldmx::HcalGeometry>(
-      ldmx::HcalGeometry::CONDITIONS_OBJECT_NAME);
+  const auto& hcalGeometry = getCondition<ldmx::HcalGeometry>(geometry_handle_);
 
   // get the reconstruction parameters
   const auto& the_conditions{
-      getCondition<HcalReconConditions>(HcalReconConditions::CONDITIONS_NAME)};
+      getCondition<HcalReconConditions>(conditions_handle_)};
 
   std::vector<ldmx::HcalHit> hcalRecHits;
-  auto hcalDigis =
+  const auto& hcalDigis =
       event.getObject<ldmx::HgcrocDigiCollection>(digiCollName_, digiPassName_);
   int numDigiHits = hcalDigis.getNumDigis();
+  // the samples decoded once for all of the processors reading them
+  const auto& decoded{hcalDigis.decoded()};
 
   // get sample of interest index
   unsigned int iSOI = hcalDigis.getSampleOfInterestIndex();
@@ -132,16 +178,15 @@ void HcalRecProducer::produce(framework::Event& event) {
   // loop through digis
   int iDigi = 0;
   while (iDigi < numDigiHits) {
-    auto digi_posend = hcalDigis.getDigi(iDigi);
-
     // ID from first digi sample (which should be in positive end)
-    ldmx::HcalDigiID id_posend(digi_posend.id());
+    ldmx::HcalDigiID id_posend(hcalDigis.getDigiID(iDigi));
+    std::size_t soi_posend{decoded.soi(iDigi)};
     ldmx::HcalID id(id_posend.section(), id_posend.layer(), id_posend.strip());
 
     // position from ID
-    auto position = hcalGeometry.getStripCenterPosition(id);
-    double half_total_width =
-        hcalGeometry.getHalfTotalWidth(id.section(), id.layer());
+    const auto& strip{hcalGeometry.getStrip(id)};
+    TVector3 position(strip.center[0], strip.center[1], strip.center[2]);
+    double half_total_width = strip.half_total_width;
     double ecal_dx = hcalGeometry.getEcalDx();
     double ecal_dy = hcalGeometry.getEcalDy();
 
@@ -174,33 +219,33 @@ void HcalRecProducer::produce(framework::Event& event) {
 
     // double readout
     if (id.section() == ldmx::HcalID::HcalSection::BACK) {
-      auto digi_negend = hcalDigis.getDigi(iDigi + 1);
-      ldmx::HcalDigiID id_negend(digi_negend.id());
+      ldmx::HcalDigiID id_negend(hcalDigis.getDigiID(iDigi + 1));
+      std::size_t soi_negend{decoded.soi(iDigi + 1)};
+
+      // the pedestals are used several times, look them up once
+      double pedestal_posend{the_conditions.adcPedestal(id_posend)};
+      double pedestal_negend{the_conditions.adcPedestal(id_negend)};
 
       double voltage_posend, voltage_negend;
-      if (digi_posend.isTOT()) {
+      if (decoded.isTOT(iDigi)) {
+        auto tot_posend{the_conditions.totCalibRow(id_posend)};
+        auto tot_negend{the_conditions.totCalibRow(id_negend)};
         voltage_posend =
-            (digi_posend.tot() - the_conditions.totCalib(id_posend, 0)) *
-            the_conditions.totCalib(id_posend, 1);
+            (decoded.digiTOT(iDigi) - tot_posend[0]) * tot_posend[1];
         voltage_negend =
-            (digi_negend.tot() - the_conditions.totCalib(id_negend, 0)) *
-            the_conditions.totCalib(id_negend, 1);
+            (decoded.digiTOT(iDigi + 1) - tot_negend[0]) * tot_negend[1];
       } else {
-        amplT_posend =
-            digi_posend.soi().adc_t() - the_conditions.adcPedestal(id_posend);
-        amplTm1_posend =
-            digi_posend.soi().adc_tm1() - the_conditions.adcPedestal(id_posend);
-        amplT_negend =
-            digi_negend.soi().adc_t() - the_conditions.adcPedestal(id_negend);
-        amplTm1_negend =
-            digi_negend.soi().adc_tm1() - the_conditions.adcPedestal(id_negend);
+        amplT_posend = decoded.adc_t[soi_posend] - pedestal_posend;
+        amplTm1_posend = decoded.adc_tm1[soi_posend] - pedestal_posend;
+        amplT_negend = decoded.adc_t[soi_negend] - pedestal_negend;
+        amplTm1_negend = decoded.adc_tm1[soi_negend] - pedestal_negend;
 
         // correct amplitude (amplitude fractions from both ends need to be
         // above the boundary of the correction)
         if (amplTm1_posend / amplT_posend > minAmplFraction_ &&
             amplTm1_negend / amplT_negend > minAmplFraction_) {
-          amplT_posend *= correctionAmpl_.Eval(amplTm1_posend / amplT_posend);
-          amplT_negend *= correctionAmpl_.Eval(amplTm1_negend / amplT_negend);
+          amplT_posend *= correctionAmpl_(amplTm1_posend / amplT_posend);
+          amplT_negend *= correctionAmpl_(amplTm1_negend / amplT_negend);
         }
 
         // set voltage
@@ -209,10 +254,8 @@ void HcalRecProducer::produce(framework::Event& event) {
       }
 
       // get TOA
-      double TOA_posend =
-          getTOA(digi_posend, the_conditions.adcPedestal(id_posend), iSOI);
-      double TOA_negend =
-          getTOA(digi_negend, the_conditions.adcPedestal(id_negend), iSOI);
+      double TOA_posend = getTOA(decoded, iDigi, pedestal_posend, iSOI);
+      double TOA_negend = getTOA(decoded, iDigi + 1, pedestal_negend, iSOI);
 
       // get sign of position along the bar
       int position_bar_sign = (TOA_posend - TOA_negend) > 0 ? 1 : -1;
@@ -222,8 +265,8 @@ void HcalRecProducer::produce(framework::Event& event) {
       // correction otherwise, one TOA gets corrected and the other does not,
       // which results in a large TOA difference and an out-of-bounds position
       if (amplT_posend > minAmpl_ && amplT_negend > minAmpl_) {
-        TOA_posend = correctionTOA_.Eval(amplT_posend) - TOA_posend;
-        TOA_negend = correctionTOA_.Eval(amplT_negend) - TOA_negend;
+        TOA_posend = correctionTOA_(amplT_posend) - TOA_posend;
+        TOA_negend = correctionTOA_(amplT_negend) - TOA_negend;
       }
 
       // get x(y) coordinate from TOA measurement = (dt*v/2)
@@ -250,9 +293,8 @@ void HcalRecProducer::produce(framework::Event& event) {
       // set amplitude as the average of both bars (reverse attenuated)
       amplT = (amplT_posend / att_posend + amplT_negend / att_negend) / 2;
 
-      const auto orientation{hcalGeometry.getScintillatorOrientation(id)};
       // set position along the bar
-      if (orientation ==
+      if (strip.orientation ==
           ldmx::HcalGeometry::ScintillatorOrientation::horizontal) {
         position.SetX(position_bar);
       } else {
@@ -269,7 +311,7 @@ void HcalRecProducer::produce(framework::Event& event) {
     else {  // single readout
 
       double voltage_i;
-      if (digi_posend.isTOT()) {
+      if (decoded.isTOT(iDigi)) {
         // TOT - number of clock ticks that pulse was over threshold
         // this is related to the amplitude of the pulse approximately through a
         // linear drain rate the amplitude of the pulse is related to the energy
@@ -278,16 +320,16 @@ void HcalRecProducer::produce(framework::Event& event) {
         // convert the time over threshold into a total energy deposited in the
         // bar (time over threshold [ns] - pedestal) * gain
 
-        voltage_i = (digi_posend.tot() - the_conditions.totCalib(id_posend)) *
-                    the_conditions.totCalib(id_posend);
+        voltage_i =
+            (decoded.digiTOT(iDigi) - the_conditions.totCalib(id_posend)) *
+            the_conditions.totCalib(id_posend);
 
       } else {
         // ADC mode of readout
         // ADC - voltage measurement at a specific time of the pulse
-        amplT_posend =
-            digi_posend.soi().adc_t() - the_conditions.adcPedestal(id_posend);
-        amplTm1_posend =
-            digi_posend.soi().adc_tm1() - the_conditions.adcPedestal(id_posend);
+        double pedestal{the_conditions.adcPedestal(id_posend)};
+        amplT_posend = decoded.adc_t[soi_posend] - pedestal;
+        amplTm1_posend = decoded.adc_tm1[soi_posend] - pedestal;
         voltage_i = amplT_posend * the_conditions.adcGain(id_posend);
       }
 
@@ -306,11 +348,11 @@ void HcalRecProducer::produce(framework::Event& event) {
       amplT = amplT_posend / att;
 
       // get TOA
-      double TOA =
-          getTOA(digi_posend, the_conditions.adcPedestal(id_posend), iSOI);
+      double TOA = getTOA(decoded, iDigi,
+                          the_conditions.adcPedestal(id_posend), iSOI);
 
       // correct TOA
-      TOA = correctionTOA_.Eval(amplT) - TOA;
+      TOA = correctionTOA_(amplT) - TOA;
 
       // set hit time
       hitTime = TOA;  // ns
@@ -364,16 +406,17 @@ void HcalRecProducer::produce(framework::Event& event) {
   if (event.exists(simHitCollName_, simHitPassName_)) {
     // hcal sim hits exist ==> label which hits are real and which are pure
     // noise
-    auto hcalSimHits{event.getCollection<ldmx::SimCalorimeterHit>(
+    auto hcalSimHits{event.get<std::vector<ldmx::SimCalorimeterHit>>(
         simHitCollName_, simHitPassName_)};
-    std::set<int> real_hits;
-    for (auto const& sim_hit : hcalSimHits) real_hits.insert(sim_hit.getID());
+    ldmx::IDSet<ldmx::DetectorID> real_hits(hcalSimHits.size());
+    for (auto const& sim_hit : hcalSimHits)
+      real_hits.insert(ldmx::DetectorID(sim_hit.getID()));
     for (auto& hit : hcalRecHits)
-      hit.setNoise(real_hits.find(hit.getID()) == real_hits.end());
+      hit.setNoise(!real_hits.contains(ldmx::DetectorID(hit.getID())));
   }
 
   // add collection to event bus
-  event.add(recHitCollName_, hcalRecHits);
+  event.add(recHitCollName_, std::move(hcalRecHits));
 }
 
 }  // namespace hcal
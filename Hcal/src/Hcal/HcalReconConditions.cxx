@@ -11,24 +11,45 @@ HcalReconConditions::HcalReconConditions(
     const conditions::DoubleTableCondition& adc_ped,
     const conditions::DoubleTableCondition& adc_gain,
     const conditions::DoubleTableCondition& tot_calib,
-    const conditions::DoubleTableCondition& toa_calib)
+    const conditions::DoubleTableCondition& toa_calib, bool columnar)
     : framework::ConditionsObject(HcalReconConditions::CONDITIONS_NAME),
       adc_pedestals_{adc_ped},
       adc_gains_{adc_gain},
       tot_calibs_{tot_calib},
-      toa_calibs_{toa_calib} {}
+      toa_calibs_{toa_calib} {
+  if (columnar) {
+    columns_ = std::make_unique<const Columns>(adc_ped, adc_gain, tot_calib,
+                                               toa_calib);
+  }
+}
+
+/**
+ * The strip is the inner field of the HcalDigiID and the layer, section
+ * and end make up the outer one, so the channels of a layer are next
+ * to each other in the columns.
+ */
+HcalReconConditions::Columns::Columns(
+    const conditions::DoubleTableCondition& adc_ped,
+    const conditions::DoubleTableCondition& adc_gain,
+    const conditions::DoubleTableCondition& tot_calib,
+    const conditions::DoubleTableCondition& toa_calib)
+    : adc_pedestals{adc_ped, 8, 12},
+      adc_gains{adc_gain, 8, 12},
+      tot_calibs{tot_calib, 8, 12},
+      toa_calibs{toa_calib, 8, 12} {}
 
 bool HcalReconConditions::is_adc(const ldmx::HcalDigiID& id,
                                  double sum_tot) const {
+  auto tot{totCalibRow(id)};
   // check if the linearization has been done correctly
   //  a non-zero flag value is implicitly converted to true
-  if (totCalib(id, i_flagged) == 1) {
+  if (tot[i_flagged] == 1) {
     return true;
   }
 
   // if we are in ADC range (which was used as a reference in linearization),
   // we use ADC
-  if (sum_tot < totCalib(id, i_lower_offset)) {
+  if (sum_tot < tot[i_lower_offset]) {
     return true;
   }
 
@@ -37,18 +58,18 @@ bool HcalReconConditions::is_adc(const ldmx::HcalDigiID& id,
 
 double HcalReconConditions::linearize(const ldmx::HcalDigiID& id,
                                       double sum_tot) const {
+  auto tot{totCalibRow(id)};
   // we know we have a linearization fit and are in TOT range,
   //  the lower side of TOT needs to be linearized with a specialized power law
-  if (sum_tot < totCalib(id, i_cut_point_tot)) {
-    return pow((sum_tot - totCalib(id, i_lower_offset)) /
-                   totCalib(id, i_low_slope),
-               1 / totCalib(id, i_low_power)) +
-           totCalib(id, i_tot_not);
+  if (sum_tot < tot[i_cut_point_tot]) {
+    return pow((sum_tot - tot[i_lower_offset]) / tot[i_low_slope],
+               1 / tot[i_low_power]) +
+           tot[i_tot_not];
   }
 
   // we know sum_tot is >= lower offset and >= tot cut
   //  higher tot, linearized with adc using a simple linear mapping
-  return (sum_tot - totCalib(id, i_high_offset)) * totCalib(id, i_high_slope);
+  return (sum_tot - tot[i_high_offset]) * tot[i_high_slope];
 }
 
 /**
@@ -70,6 +91,8 @@ class HcalReconConditionsProvider : public framework::ConditionsObjectProvider {
   std::string tot_calib_;
   /// name of condition object for hcal toa calibrations
   std::string toa_calib_;
+  /// copy the tables into columns for faster access
+  bool columnar_;
 
  public:
   /**
@@ -98,6 +121,7 @@ class HcalReconConditionsProvider : public framework::ConditionsObjectProvider {
     adc_ped_ = parameters.getParameter<std::string>("adc_ped");
     tot_calib_ = parameters.getParameter<std::string>("tot_calib");
     toa_calib_ = parameters.getParameter<std::string>("toa_calib");
+    columnar_ = parameters.getParameter<bool>("columnar", false);
   }
 
   /**
@@ -135,7 +159,8 @@ class HcalReconConditionsProvider : public framework::ConditionsObjectProvider {
         dynamic_cast<const conditions::DoubleTableCondition&>(*adc_ped_co),
         dynamic_cast<const conditions::DoubleTableCondition&>(*adc_gain_co),
         dynamic_cast<const conditions::DoubleTableCondition&>(*tot_calib_co),
-        dynamic_cast<const conditions::DoubleTableCondition&>(*toa_calib_co));
+        dynamic_cast<const conditions::DoubleTableCondition&>(*toa_calib_co),
+        columnar_);
 
     return {co, framework::ConditionsIOV(context.getRun(), context.getRun())};
   }
@@ -1,5 +1,7 @@
 #include "Hcal/HcalTrigPrimDigiProducer.h"
 
+#include <algorithm>
+
 #include "DetDescr/HcalGeometry.h"
 #include "Hcal/HcalTriggerGeometry.h"
 #include "Recon/Event/CaloTrigPrim.h"
@@ -30,10 +32,17 @@ void HcalTrigPrimDigiProducer::produce(framework::Event& event) {
   const conditions::IntegerTableCondition& conditions =
       getCondition<conditions::IntegerTableCondition>(condObjName_);
 
-  // construct the calculator...
-  ldmx::HgcrocTriggerCalculations calc(conditions);
+  // the conditions are validated once, then looked up per channel
+  ldmx::HgcrocTriggerConditions tconds(conditions);
+
+  // quads and STQs of both ends, end 0 before end 1 like their raw IDs
+  const int n_quads = geom.getNumQuads(), n_stqs = geom.getNumSTQs();
+  if (linearCharge_.size() != std::size_t(2 * n_quads)) {
+    linearCharge_.assign(2 * n_quads, 0);
+    stqCharge_.assign(2 * n_stqs, 0);
+  }
 
-  // Loop over the digis
+  // Loop over the digis, summing the charge into the quads
   for (unsigned int ix = 0; ix < hcalDigis.getNumDigis(); ix++) {
     const ldmx::HgcrocDigiCollection::HgcrocDigi pdigi = hcalDigis.getDigi(ix);
     ldmx::HcalTriggerID tid = geom.belongsToQuad(ldmx::HcalDigiID(pdigi.id()));
@@ -41,64 +50,70 @@ void HcalTrigPrimDigiProducer::produce(framework::Event& event) {
     if (!tid.null()) {
       int tot = 0;
       if (pdigi.soi().isTOTComplete()) tot = pdigi.soi().tot();
-      calc.addDigi(pdigi.id(), tid.raw(), pdigi.soi().adc_t(), tot);
+      unsigned int id = pdigi.id();
+      unsigned int charge =
+          ldmx::HgcrocTriggerCalculations::singleChannelCharge(
+              pdigi.soi().adc_t(), tot, tconds.adcPedestal(id),
+              tconds.adcThreshold(id), tconds.totPedestal(id),
+              tconds.totThreshold(id), tconds.totGain(id));
+      if (charge > 0) {
+        int quad = geom.quadIndex(tid);
+        if (quad < 0 or tid.end() > 1) {
+          std::cout << "Failing HcalTriggerID(" << tid.section() << ','
+                    << tid.layer() << ',' << tid.superstrip() << ','
+                    << tid.end() << ')' << std::endl;
+          EXCEPTION_RAISE("TrigToPrecIDMismatch",
+                          "Attempted to lookup a nonexistent HcalDigiID from "
+                          "an HcalTriggerID");
+        }
+        unsigned int& lcharge = linearCharge_[tid.end() * n_quads + quad];
+        if (lcharge == 0) filled_.push_back(tid.raw());
+        lcharge += charge;
+      }
     }
   }
 
-  // Now, we compress the digis
-  calc.compressDigis(4);
+  // Now, we compress the digis in order of trigger ID
+  // 4 is the number for Hcal...
+  const int shift = ldmx::HgcrocTriggerCalculations::compressionShift(4);
   const float hgc_compress_factor = 2;
+  std::sort(filled_.begin(), filled_.end());
 
-  // const std::map<unsigned int, uint8_t> results;
-  const std::map<unsigned int, uint8_t>& results = calc.compressedEnergies();
   ldmx::HgcrocTrigDigiCollection tdigis;
   // ldmx::CaloTrigPrimCollection tdigisUC; // sums without any compression
   // applied
-
-  for (auto result : results) {
-    if (result.second > 0) {
-      tdigis.push_back(ldmx::HgcrocTrigDigi(result.first, result.second));
-      // tdigisUC.push_back( ldmx::CaloTrigPrim(result.first,
-      //         hgc_compress_factor*ldmx::HgcrocTrigDigi::compressed2Linear(result.second))
+  tdigis.reserve(filled_.size());
+  for (unsigned int raw : filled_) {
+    const ldmx::HcalTriggerID quad_id(raw);
+    int quad = geom.quadIndex(quad_id);
+    unsigned int& lcharge = linearCharge_[quad_id.end() * n_quads + quad];
+    uint8_t ccharge = ldmx::HgcrocTrigDigi::linear2Compressed(lcharge >> shift);
+    lcharge = 0;
+    if (ccharge > 0) {
+      tdigis.push_back(ldmx::HgcrocTrigDigi(raw, ccharge));
+      // tdigisUC.push_back( ldmx::CaloTrigPrim(raw,
+      //         hgc_compress_factor*ldmx::HgcrocTrigDigi::compressed2Linear(ccharge))
       //         );
-    }
-  }
 
-  // build STQs from the quads (w/ compressed energies)
-  stq_tps.clear();
-  for (auto result : results) {
-    if (result.second > 0) {
-      const ldmx::HcalTriggerID quad_id(result.first);
-      const std::vector<ldmx::HcalDigiID> precisions_ids =
-          geom.contentsOfQuad(quad_id);
-      if (precisions_ids.size() == 0) {
-        std::cout << "Failing HcalTriggerID(" << quad_id.section() << ','
-                  << quad_id.layer() << ',' << quad_id.superstrip() << ','
-                  << quad_id.end() << ')' << std::endl;
-        EXCEPTION_RAISE("TrigToPrecIDMismatch",
-                        "Attempted to lookup a nonexistent HcalDigiID from an "
-                        "HcalTriggerID");
-      }
-      const ldmx::HcalDigiID prec_id(precisions_ids.front().raw());
-      const ldmx::HcalTriggerID stq_id = geom.belongsToSTQ(prec_id);
-      auto ptr = stq_tps.find(stq_id.raw());
-      int linear_charge =
-          hgc_compress_factor *
-          ldmx::HgcrocTrigDigi::compressed2Linear(result.second);
-      if (ptr != stq_tps.end()) {
-        ptr->second += linear_charge;
-      } else {
-        stq_tps[stq_id.raw()] = linear_charge;
-      }
+      // build STQs from the quads (w/ compressed energies)
+      int linear_charge = hgc_compress_factor *
+                          ldmx::HgcrocTrigDigi::compressed2Linear(ccharge);
+      int stq = quad_id.end() * n_stqs + geom.stqIndex(quad);
+      if (stqCharge_[stq] == 0) stqFilled_.push_back(stq);
+      stqCharge_[stq] += linear_charge;
     }
   }
+  filled_.clear();
 
+  std::sort(stqFilled_.begin(), stqFilled_.end());
   ldmx::CaloTrigPrimCollection stq_digis;
-  for (auto result : stq_tps) {
-    if (result.second > 0) {
-      stq_digis.push_back(ldmx::CaloTrigPrim(result.first, result.second));
-    }
+  stq_digis.reserve(stqFilled_.size());
+  for (int stq : stqFilled_) {
+    stq_digis.push_back(ldmx::CaloTrigPrim(
+        geom.stqID(stq % n_stqs, stq / n_stqs).raw(), stqCharge_[stq]));
+    stqCharge_[stq] = 0;
   }
+  stqFilled_.clear();
 
   event.add(getName(), tdigis);
   // event.add(getName()+"Uncompress", tdigisUC);
@@ -1,5 +1,6 @@
 #include "Hcal/HcalTriggerGeometry.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -10,7 +11,38 @@
 namespace hcal {
 
 HcalTriggerGeometry::HcalTriggerGeometry(const ldmx::HcalGeometry* hcalGeom)
-    : ConditionsObject(CONDITIONS_OBJECT_NAME), hcalGeometry_{hcalGeom} {}
+    : ConditionsObject(CONDITIONS_OBJECT_NAME), hcalGeometry_{hcalGeom} {
+  if (hcalGeometry_ == nullptr) return;
+  // raw ID of the STQ of each quad
+  std::vector<unsigned int> quad_stq_raw;
+  // layers are numbered from one, so layer zero is an empty range
+  for (int section = 0; section < hcalGeometry_->getNumSections(); section++) {
+    int n_layers = hcalGeometry_->getNumLayers(section);
+    std::vector<int> first(n_layers + 2, num_quads_);
+    for (int layer = 1; layer <= n_layers; layer++) {
+      // the quads of belongsToQuad: four strips each, the last one partial
+      int n_quads = (hcalGeometry_->getNumStrips(section, layer) + 3) / 4;
+      for (int superstrip = 0; superstrip < n_quads; superstrip++) {
+        quad_stq_raw.push_back(
+            belongsToSTQ(ldmx::HcalDigiID(section, layer, 4 * superstrip, 0))
+                .raw());
+      }
+      num_quads_ += n_quads;
+      first[layer + 1] = num_quads_;
+    }
+    first_quad_.push_back(first);
+  }
+
+  // number the STQs in order of their IDs and point the quads at them
+  std::vector<unsigned int> stq_raw(quad_stq_raw);
+  std::sort(stq_raw.begin(), stq_raw.end());
+  stq_raw.erase(std::unique(stq_raw.begin(), stq_raw.end()), stq_raw.end());
+  for (unsigned int raw : stq_raw) stq_ids_.push_back(ldmx::HcalTriggerID(raw));
+  for (unsigned int raw : quad_stq_raw) {
+    quad_stq_.push_back(std::lower_bound(stq_raw.begin(), stq_raw.end(), raw) -
+                        stq_raw.begin());
+  }
+}
 
 std::vector<ldmx::HcalDigiID> HcalTriggerGeometry::contentsOfQuad(
     ldmx::HcalTriggerID triggerCell) const {
@@ -80,9 +112,9 @@ class HcalTriggerGeometryProvider : public framework::ConditionsObjectProvider {
 
   /**
    * Provides access to the HcalGeometry or HcalTriggerGeometry
-   * @note Currently, these are assumed to be valid for all time, but this
-   * behavior could be changed.  Users should not cache the pointer between
-   * events
+   * @note The trigger geometry is built once and is valid for all runs.
+   * Users should still not cache the pointer between events, but request
+   * it through the conditions system.
    */
   virtual std::pair<const framework::ConditionsObject*,
                     framework::ConditionsIOV>
@@ -95,9 +127,8 @@ class HcalTriggerGeometryProvider : public framework::ConditionsObjectProvider {
           dynamic_cast<const ldmx::HcalGeometry*>(cond_hcal_geom.first);
       hcalTriggerGeometry_ = new HcalTriggerGeometry(hcalgeom);
     }
-    return std::make_pair(hcalTriggerGeometry_,
-                          framework::ConditionsIOV(
-                              context.getRun(), context.getRun(), true, true));
+    // built from the geometry, which is valid for all runs
+    return std::make_pair(hcalTriggerGeometry_, framework::ConditionsIOV(true, true));
   }
 
   /**
@@ -57,42 +57,20 @@ void HcalVetoProcessor::configure(framework::config::Parameters &parameters) {
 
 void HcalVetoProcessor::produce(framework::Event &event) {
   // Get the collection of sim particles from the event
-  const std::vector<ldmx::HcalHit> hcalRecHits =
+  const std::vector<ldmx::HcalHit> &hcalRecHits =
       event.getCollection<ldmx::HcalHit>(inputHitCollName_, inputHitPassName_);
 
-  // Loop over all of the Hcal hits and calculate to total photoelectrons
-  // in the event.
-  [[maybe_unused]] float totalPe{0};
+  // Find the hit with the maximum PE, ignoring the hits outside of the
+  // readout window. Double sided readout is only being used for the back
+  // HCal bars, so there both sides of the bar need a PE value above
+  // threshold. For the side HCal, just use the maximum PE as before.
+  hitView_.fill(hcalRecHits);
+  int imax{hitView_.maxPEIndex(maxTime_, backMinPE_)};
   float maxPE{-1000};
-
   const ldmx::HcalHit *maxPEHit{&defaultMaxHit_};
-  for (const ldmx::HcalHit &hcalHit : hcalRecHits) {
-    // If the hit time is outside the readout window, don't consider it.
-    if (hcalHit.getTime() >= maxTime_) {
-      continue;
-    }
-
-    // Get the total PE in the bar
-    float pe = hcalHit.getPE();
-
-    // Keep track of the total PE
-    // TODO: This is currently not used anywhere
-    totalPe += pe;
-
-    // Check that both sides of the bar have a PE value above threshold.
-    // If not, don't consider the hit.  Double sided readout is only
-    // being used for the back HCal bars.  For the side HCal, just
-    // use the maximum PE as before.
-    ldmx::HcalID id(hcalHit.getID());
-    if ((id.section() == ldmx::HcalID::BACK) &&
-        (hcalHit.getMinPE() < backMinPE_))
-      continue;
-
-    // Find the maximum PE in the list
-    if (maxPE < pe) {
-      maxPE = pe;
-      maxPEHit = &hcalHit;
-    }
+  if (imax >= 0) {
+    maxPE = hitView_.pe()[imax];
+    maxPEHit = &hcalRecHits[imax];
   }
 
   // If the maximum PE found is below threshold, it passes the veto.
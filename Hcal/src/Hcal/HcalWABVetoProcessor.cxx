@@ -44,32 +44,24 @@ void HcalWABVetoProcessor::configure(
 void HcalWABVetoProcessor::produce(framework::Event &event) {
   // Get the collection of sim particles from the event
   // HCAL:
-  const std::vector<ldmx::HcalHit> hcalRecHits =
+  const std::vector<ldmx::HcalHit> &hcalRecHits =
       event.getCollection<ldmx::HcalHit>(inputHCALHitCollName_);
   // ECAL:
-  const std::vector<ldmx::EcalHit> ecalRecHits =
+  const std::vector<ldmx::EcalHit> &ecalRecHits =
       event.getCollection<ldmx::EcalHit>(inputECALHitCollName_);
   // Clusters:
-  const std::vector<ldmx::HcalCluster> hcalClusters =
+  const std::vector<ldmx::HcalCluster> &hcalClusters =
       event.getCollection<ldmx::HcalCluster>(inputHCALClusterCollName_);
 
-  // Loop over all of the Hcal hits and calculate to total photoelectrons
-  // in the event.
-  float totalHCALEnergy{0};
+  // Sum the photoelectrons of the Hcal hits that aren't noise and find
+  // the hit with the maximum PE in the event.
+  hitView_.fill(hcalRecHits);
+  float totalHCALEnergy{hitView_.sumPE(true)};
   float totalECALEnergy{0};
-  float maxPE{-1000};
-  const ldmx::HcalHit *maxPEHit;
-  for (const ldmx::HcalHit &hcalHit : hcalRecHits) {
-    if (hcalHit.isNoise() == 0) {
-      totalHCALEnergy += hcalHit.getPE();
-    }
-
-    // Find the maximum PE in the list
-    if (maxPE < hcalHit.getPE()) {
-      maxPE = hcalHit.getPE();
-      maxPEHit = &hcalHit;
-    }
-  }
+  // an empty hit is recorded if no hit has more than -1000 PE
+  const ldmx::HcalHit *maxPEHit{&defaultMaxHit_};
+  int imax{hitView_.maxPEIndex()};
+  if (imax >= 0) maxPEHit = &hcalRecHits[imax];
 
   for (const ldmx::EcalHit &ecalHit : ecalRecHits) {
     if (ecalHit.isNoise() == 0) {
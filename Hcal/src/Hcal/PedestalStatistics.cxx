@@ -0,0 +1,103 @@
+#include "Hcal/PedestalStatistics.h"
+
+#include <cmath>
+#include <sstream>
+#include <string>
+
+#include "Framework/Exception/Exception.h"
+
+namespace hcal {
+
+std::size_t PedestalStatistics::channel(unsigned int id) {
+  if (index_.empty()) index_.assign(ID_MASK + 1, -1);
+  int& i{index_[id & ID_MASK]};
+  if (i < 0) {
+    i = ids_.size();
+    ids_.push_back(id);
+    entries_.push_back(0);
+    mean_.push_back(0.);
+    m2_.push_back(0.);
+    rejects_.resize(rejects_.size() + N_REJECT, 0);
+    counts_.resize(counts_.size() + N_ADC, 0);
+  }
+  return i;
+}
+
+void PedestalStatistics::merge(const PedestalStatistics& other) {
+  for (std::size_t ochan{0}; ochan < other.size(); ochan++) {
+    std::size_t chan{channel(other.id(ochan))};
+    uint64_t na{entries_[chan]}, nb{other.entries_[ochan]};
+    if (nb > 0) {
+      // Chan et al.'s pairwise update of the mean and squared deviations
+      uint64_t n{na + nb};
+      double delta{other.mean_[ochan] - mean_[chan]};
+      mean_[chan] += delta * nb / n;
+      m2_[chan] += other.m2_[ochan] + delta * delta * na * nb / n;
+      entries_[chan] = n;
+    }
+    for (int r{0}; r < N_REJECT; r++)
+      rejects_[chan * N_REJECT + r] += other.rejects_[ochan * N_REJECT + r];
+    for (int adc{0}; adc < N_ADC; adc++)
+      counts_[chan * N_ADC + adc] += other.counts_[ochan * N_ADC + adc];
+  }
+}
+
+double PedestalStatistics::rms(std::size_t chan) const {
+  if (entries_[chan] == 0) return 0.;
+  return sqrt(m2_[chan] / entries_[chan]);
+}
+
+void PedestalStatistics::write(std::ostream& s) const {
+  s.precision(17);
+  for (std::size_t chan{0}; chan < size(); chan++) {
+    s << "0x" << std::hex << ids_[chan] << std::dec << ' ' << entries_[chan]
+      << ' ' << mean_[chan] << ' ' << m2_[chan];
+    for (int r{0}; r < N_REJECT; r++) s << ' ' << rejected(chan, Reject(r));
+    const uint64_t* c{counts(chan)};
+    int n_filled{0};
+    for (int adc{0}; adc < N_ADC; adc++)
+      if (c[adc] > 0) n_filled++;
+    s << ' ' << n_filled;
+    for (int adc{0}; adc < N_ADC; adc++)
+      if (c[adc] > 0) s << ' ' << adc << ' ' << c[adc];
+    s << '\n';
+  }
+}
+
+void PedestalStatistics::read(std::istream& s) {
+  PedestalStatistics partial;
+  std::string line;
+  int iline{0};
+  while (std::getline(s, line)) {
+    iline++;
+    if (line.empty()) continue;
+    std::istringstream ls(line);
+    unsigned int id;
+    uint64_t entries;
+    double mean, m2;
+    ls >> std::hex >> id >> std::dec >> entries >> mean >> m2;
+    std::size_t chan{partial.channel(id)};
+    partial.entries_[chan] = entries;
+    partial.mean_[chan] = mean;
+    partial.m2_[chan] = m2;
+    for (int r{0}; r < N_REJECT; r++)
+      ls >> partial.rejects_[chan * N_REJECT + r];
+    int n_filled{0};
+    ls >> n_filled;
+    for (int i{0}; i < n_filled and ls; i++) {
+      int adc;
+      uint64_t count;
+      ls >> adc >> count;
+      if (adc < 0 or adc >= N_ADC) ls.setstate(std::ios::failbit);
+      else partial.counts_[chan * N_ADC + adc] = count;
+    }
+    if (ls.fail()) {
+      EXCEPTION_RAISE("BadFormat", "Unable to parse line " +
+                                       std::to_string(iline) +
+                                       " of pedestal statistics.");
+    }
+  }
+  merge(partial);
+}
+
+}  // namespace hcal
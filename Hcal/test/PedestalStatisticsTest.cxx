@@ -0,0 +1,78 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <sstream>
+
+using Catch::Approx;
+
+#include "DetDescr/HcalDigiID.h"
+#include "Hcal/PedestalStatistics.h"
+
+namespace hcal {
+namespace test {
+
+/**
+ * Fill the samples of two channels with a simple pattern
+ *
+ * @param[in] stats statistics to fill
+ * @param[in] first first sample number to fill
+ * @param[in] last one past the last sample number to fill
+ */
+void fillPattern(PedestalStatistics& stats, int first, int last) {
+  ldmx::HcalDigiID a(1, 2, 3, 0), b(0, 7, 40, 1);
+  for (int i = first; i < last; i++) {
+    stats.fill(stats.channel(a.raw()), 100 + i % 7);
+    stats.fill(stats.channel(b.raw()), 200 + (i * 3) % 11);
+  }
+  stats.reject(stats.channel(a.raw()), PedestalStatistics::REJECT_TOA);
+}
+
+TEST_CASE("PedestalStatistics", "[Hcal][PedestalStatistics]") {
+  PedestalStatistics whole;
+  fillPattern(whole, 0, 1000);
+
+  SECTION("mean and RMS") {
+    std::size_t chan{whole.channel(ldmx::HcalDigiID(1, 2, 3, 0).raw())};
+    double sum{0}, sum_sq{0};
+    for (int i = 0; i < 1000; i++) {
+      sum += 100 + i % 7;
+      sum_sq += (100 + i % 7) * (100 + i % 7);
+    }
+    double mean{sum / 1000};
+    CHECK(whole.entries(chan) == 1000);
+    CHECK(whole.mean(chan) == Approx(mean));
+    CHECK(whole.rms(chan) == Approx(sqrt(sum_sq / 1000 - mean * mean)));
+    CHECK(whole.counts(chan)[100] == 143);
+  }
+
+  SECTION("merging partial statistics") {
+    PedestalStatistics first, second;
+    fillPattern(first, 0, 300);
+    fillPattern(second, 300, 1000);
+
+    // through the written format like separate jobs would
+    std::stringstream ss;
+    second.write(ss);
+    first.read(ss);
+
+    REQUIRE(first.size() == whole.size());
+    for (std::size_t chan = 0; chan < whole.size(); chan++) {
+      std::size_t merged{first.channel(whole.id(chan))};
+      CHECK(first.entries(merged) == whole.entries(chan));
+      CHECK(first.mean(merged) == Approx(whole.mean(chan)));
+      CHECK(first.rms(merged) == Approx(whole.rms(chan)));
+      CHECK(first.rejected(merged, PedestalStatistics::REJECT_TOA) ==
+            2 * whole.rejected(chan, PedestalStatistics::REJECT_TOA));
+      for (int adc = 0; adc < PedestalStatistics::N_ADC; adc++)
+        CHECK(first.counts(merged)[adc] == whole.counts(chan)[adc]);
+    }
+  }
+
+  SECTION("bad format") {
+    std::stringstream ss("0x1 not a number");
+    CHECK_THROWS(whole.read(ss));
+  }
+}
+
+}  // namespace test
+}  // namespace hcal
@@ -0,0 +1,83 @@
+/**
+ * @file ReaderBench.cxx
+ * @brief Benchmark reading raw data files
+ */
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Packing/RawDataFile/EventPacket.h"
+#include "Packing/Utility/Reader.h"
+#include "Packing/Utility/Writer.h"
+
+namespace packing {
+namespace bench {
+
+/**
+ * Write a raw data file of a few events
+ *
+ * Each event has a packet of the ECal, HCal and trigger scintillator
+ * with about as many words as their readout sends. The words are drawn
+ * from a fixed seed, so every run and every build reads the same file.
+ *
+ * @return name of the file that was written
+ */
+static const std::string& recordedFile() {
+  static const std::string file_name{"reader_bench.raw"};
+  static bool written{false};
+  if (written) return file_name;
+
+  std::mt19937 rng(31);
+  std::uniform_int_distribution<uint32_t> word;
+  std::map<uint16_t, std::size_t> n_words = {
+      {0x0001, 6000}, {0x0002, 2000}, {0x0003, 200}};
+  utility::Writer w(file_name);
+  for (uint32_t event{0}; event < 1000; event++) {
+    std::map<uint16_t, std::vector<uint32_t>> data;
+    for (const auto& [id, n] : n_words) {
+      auto& words{data[id]};
+      for (std::size_t i{0}; i < n; i++) words.push_back(word(rng));
+    }
+    w << rawdatafile::EventPacket(event, data);
+  }
+  written = true;
+  return file_name;
+}
+
+}  // namespace bench
+}  // namespace packing
+
+/// Read the words of the recorded file in blocks
+static void BM_Reader_words(benchmark::State& state) {
+  using namespace packing;
+  const auto& file_name{bench::recordedFile()};
+  std::vector<uint32_t> words;
+  std::size_t n_words{0};
+  for (auto _ : state) {
+    utility::Reader r(file_name);
+    n_words = 0;
+    while (not r.eof() and r.read(words, 1024)) n_words += words.size();
+    benchmark::DoNotOptimize(words.data());
+  }
+  state.SetBytesProcessed(state.iterations() * n_words * sizeof(uint32_t));
+}
+BENCHMARK(BM_Reader_words);
+
+/// Read the event packets of the recorded file
+static void BM_Reader_eventPackets(benchmark::State& state) {
+  using namespace packing;
+  const auto& file_name{bench::recordedFile()};
+  int n_events{0};
+  for (auto _ : state) {
+    utility::Reader r(file_name);
+    rawdatafile::EventPacket event;
+    n_events = 0;
+    while (not r.eof() and r >> event) n_events++;
+    benchmark::DoNotOptimize(event);
+  }
+  state.SetItemsProcessed(state.iterations() * n_events);
+}
+BENCHMARK(BM_Reader_eventPackets);
@@ -1,6 +1,13 @@
 #ifndef PACKING_RAWDATAFILE_FILE_H_
 #define PACKING_RAWDATAFILE_FILE_H_
 
+#include <condition_variable>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "Framework/Configure/Parameters.h"
 #include "Framework/Event.h"
 #include "Framework/RunHeader.h"
@@ -13,6 +20,12 @@ namespace rawdatafile {
 
 /**
  * The raw data file object
+ *
+ * When reading with decoding threads, the offset of each event packet is
+ * found by scanning the packet headers when the file is opened. The threads
+ * then each read and decode the next event packets from their own handle to
+ * the file while the events already decoded are put onto the event bus in
+ * order.
  */
 class File {
  public:
@@ -24,6 +37,9 @@ class File {
    */
   File(const framework::config::Parameters& params);
 
+  /// stop the decoding threads
+  ~File();
+
   /**
    * Connect the passed event bus to this event file.
    */
@@ -58,6 +74,19 @@ class File {
   /// for writing, do we skip subsystems if their raw object is unavailable
   bool skip_unavailable_;
 
+ private:
+  /// find the offset of each event packet in the input file
+  void scan();
+
+  /// start the decoding threads at the current entry
+  void startDecoding();
+
+  /// stop the decoding threads and drop the events they decoded
+  void stopDecoding();
+
+  /// body of a decoding thread
+  void decode();
+
  private:
   /// number of entries in the file
   uint32_t entries_{0};
@@ -73,6 +102,29 @@ class File {
   utility::Writer writer_;
   /// crc calculator for output mode
   utility::CRC crc_;
+
+  /// name of the file, opened again by each decoding thread
+  std::string filename_;
+  /// number of threads decoding event packets, 0 to decode when reading
+  int n_decode_threads_{0};
+  /// maximum number of event packets decoded ahead of the current entry
+  std::size_t decode_ahead_{0};
+  /// offset of each event packet in the input file, in 32-bit words
+  std::vector<std::size_t> offsets_;
+  /// decoding threads
+  std::vector<std::thread> decoders_;
+  /// protects the members shared with the decoding threads
+  std::mutex mutex_;
+  /// signals a decoded event packet, a read entry or a request to stop
+  std::condition_variable changed_;
+  /// decoded event packets by entry index
+  std::map<uint32_t, EventPacket> decoded_;
+  /// entry index the next free decoding thread decodes
+  uint32_t next_decode_{0};
+  /// entry index of the first event packet that couldn't be read
+  uint32_t failed_entry_{std::numeric_limits<uint32_t>::max()};
+  /// the decoding threads should stop
+  bool stop_{false};
 };  // File
 
 }  // namespace rawdatafile
@@ -1,12 +1,40 @@
 #ifndef PACKING_BUFFER_H_
 #define PACKING_BUFFER_H_
 
+#include <cstdint>
+#include <cstring>
 #include <stdexcept>
 #include <vector>
 
 namespace packing {
 namespace utility {
 
+/**
+ * Get a word from its bytes, stored least significant byte first.
+ *
+ * The bytes are copied into the word at once and only swapped
+ * on big-endian machines.
+ *
+ * @tparam[in] WordType integral type of the word
+ * @param[in] bytes pointer to the first byte of the word
+ * @return the word
+ */
+template <typename WordType>
+WordType fromLittleEndian(const uint8_t* bytes) {
+  WordType w;
+  std::memcpy(&w, bytes, sizeof(WordType));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  if constexpr (sizeof(WordType) == 2) {
+    w = __builtin_bswap16(w);
+  } else if constexpr (sizeof(WordType) == 4) {
+    w = __builtin_bswap32(w);
+  } else if constexpr (sizeof(WordType) == 8) {
+    w = __builtin_bswap64(w);
+  }
+#endif
+  return w;
+}
+
 /**
  * @class BufferReader
  * This class is a helper class for reading the buffer
@@ -72,10 +100,10 @@ class BufferReader {
    * @return next word in buffer
    */
   WordType next() {
-    WordType w{0};
-    for (std::size_t i_byte{0}; i_byte < n_bytes_; i_byte++) {
-      w |= (buffer_.at(i_word_ + i_byte) << 8 * i_byte);
+    if (i_word_ + n_bytes_ > buffer_.size()) {
+      throw std::out_of_range("BufferReader: word past the end of buffer");
     }
+    WordType w{fromLittleEndian<WordType>(buffer_.data() + i_word_)};
     i_word_ += n_bytes_;
     return w;
   }
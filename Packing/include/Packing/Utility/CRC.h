@@ -1,7 +1,15 @@
 #ifndef PACKING_UTILITY_CRC_H_
 #define PACKING_UTILITY_CRC_H_
 
-#include <boost/crc.hpp>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
 
 namespace packing {
 namespace utility {
@@ -10,8 +18,15 @@ namespace utility {
  * @class CRC
  *
  * The HGC ROC and FPGA use a CRC checksum to double check that the
- * data transfer has been done correctly. Boost has a CRC checksum
- * library that we can use to do this checking here as well.
+ * data transfer has been done correctly. This calculates the same
+ * CRC-32 as boost::crc_32_type so that we can do this checking here
+ * as well.
+ *
+ * The bytes are processed eight at a time with the slicing-by-8 tables,
+ * or with the CRC32 instructions on ARM processors that have them.
+ * (The SSE4.2 crc32 instruction computes CRC-32C, a different polynomial,
+ * so it can't be used here.) Contiguous words, like a vector of integral
+ * words, are processed as a single buffer.
  *
  * Idea for this helper struct was found on StackOverflow
  * https://stackoverflow.com/a/63237679
@@ -63,7 +78,42 @@ class CRC {
   template <typename WordType,
             std::enable_if_t<std::is_integral<WordType>::value, bool> = true>
   CRC& operator<<(const WordType& w) {
-    crc.process_bytes(&w, sizeof(WordType));
+    return process(&w, sizeof(WordType));
+  }
+
+  /**
+   * Insert a buffer of bytes into the calculator
+   *
+   * @param[in] data pointer to the first byte
+   * @param[in] n_bytes number of bytes in the buffer
+   * @return CRC modified calculator
+   */
+  CRC& process(const void* data, std::size_t n_bytes) {
+    auto bytes{static_cast<const uint8_t*>(data)};
+#if defined(__ARM_FEATURE_CRC32)
+    for (; n_bytes >= 8; bytes += 8, n_bytes -= 8) {
+      uint64_t word;
+      std::memcpy(&word, bytes, 8);
+      crc_ = __crc32d(crc_, word);
+    }
+    for (; n_bytes > 0; bytes++, n_bytes--) crc_ = __crc32b(crc_, *bytes);
+#else
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; n_bytes >= 8; bytes += 8, n_bytes -= 8) {
+      uint32_t one, two;
+      std::memcpy(&one, bytes, 4);
+      std::memcpy(&two, bytes + 4, 4);
+      one ^= crc_;
+      crc_ = table_[7][one & 0xff] ^ table_[6][(one >> 8) & 0xff] ^
+             table_[5][(one >> 16) & 0xff] ^ table_[4][one >> 24] ^
+             table_[3][two & 0xff] ^ table_[2][(two >> 8) & 0xff] ^
+             table_[1][(two >> 16) & 0xff] ^ table_[0][two >> 24];
+    }
+#endif
+    for (; n_bytes > 0; bytes++, n_bytes--) {
+      crc_ = (crc_ >> 8) ^ table_[0][(crc_ ^ *bytes) & 0xff];
+    }
+#endif
     return *this;
   }
 
@@ -99,19 +149,50 @@ class CRC {
    */
   template <typename ContentType>
   CRC& operator<<(const std::vector<ContentType>& vec) {
-    for (auto const& w : vec) *this << w;
-    return *this;
+    if constexpr (std::is_integral<ContentType>::value) {
+      return process(vec.data(), vec.size() * sizeof(ContentType));
+    } else {
+      for (auto const& w : vec) *this << w;
+      return *this;
+    }
   }
 
   /**
    * Get the calculate checksum from the calculator
    * @return uint32_t checksum
    */
-  uint32_t get() { return crc.checksum(); }
+  uint32_t get() { return crc_ ^ 0xffffffff; }
 
  private:
-  /// the object from Boost doing the summing
-  boost::crc_32_type crc;
+  /// the (reflected) CRC-32 polynomial
+  static constexpr uint32_t polynomial_{0xedb88320};
+
+  /**
+   * Tables of the slicing-by-8 algorithm
+   *
+   * The first table is the usual byte-wise table, table k gives the CRC of
+   * a byte followed by k zero bytes.
+   */
+  static constexpr std::array<std::array<uint32_t, 256>, 8> table_ = [] {
+    std::array<std::array<uint32_t, 256>, 8> table{};
+    for (uint32_t i{0}; i < 256; i++) {
+      uint32_t c{i};
+      for (int bit{0}; bit < 8; bit++) {
+        c = (c & 1) ? (c >> 1) ^ polynomial_ : c >> 1;
+      }
+      table[0][i] = c;
+    }
+    for (std::size_t k{1}; k < 8; k++) {
+      for (std::size_t i{0}; i < 256; i++) {
+        table[k][i] =
+            (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xff];
+      }
+    }
+    return table;
+  }();
+
+  /// the running remainder, before the final inversion
+  uint32_t crc_{0xffffffff};
 };  // CRC
 
 }  // namespace utility
@@ -1,10 +1,19 @@
 #ifndef PACKING_UTILITY_READER_H_
 #define PACKING_UTILITY_READER_H_
 
-#include <fstream>
-#include <iostream>  //debuggin
+// POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <ios>
+#include <iostream>
 #include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace packing {
 namespace utility {
@@ -13,30 +22,46 @@ namespace utility {
  * @class Reader
  * Reading a raw data file.
  *
- * We wrap a basic std::ifstream in order to make the retrieving
- * of specific-width words easier for ourselves.
+ * The file is mapped into memory and the words are copied straight out of
+ * the mapped region, so reading a word doesn't go through a stream. The
+ * interface and the fail/eof behavior follow the std::ifstream it used to
+ * wrap.
  */
 class Reader {
  public:
-  /**
-   * default constructor
-   *
-   * We make sure that our input file stream will not skip white space.
-   */
-  Reader() { file_.unsetf(std::ios::skipws); }
+  /// default constructor, no file is open
+  Reader() = default;
 
   /**
    * Open a file with this reader
    *
-   * We open the file as an input, binary file.
+   * We map the whole file read-only into memory.
+   * If the file can't be opened, the reader is put into the fail state.
    *
    * @param[in] file_name full path to the file we are going to open
    */
   void open(const std::string& file_name) {
-    file_.open(file_name, std::ios::in | std::ios::binary);
-    file_.seekg(0, std::ios::end);
-    file_size_ = file_.tellg();
-    file_.seekg(0);
+    unmap();
+    pos_ = 0;
+    eof_ = false;
+    fail_ = true;
+    int fd{::open(file_name.c_str(), O_RDONLY)};
+    if (fd < 0) return;
+    struct stat info;
+    if (fstat(fd, &info) == 0) {
+      file_size_ = info.st_size;
+      if (file_size_ == 0) {
+        fail_ = false;
+      } else {
+        void* data{mmap(nullptr, file_size_, PROT_READ, MAP_PRIVATE, fd, 0)};
+        if (data != MAP_FAILED) {
+          data_ = static_cast<const char*>(data);
+          madvise(data, file_size_, MADV_SEQUENTIAL);
+          fail_ = false;
+        }
+      }
+    }
+    ::close(fd);
   }
 
   /**
@@ -46,8 +71,26 @@ class Reader {
    */
   Reader(const std::string& file_name) : Reader() { this->open(file_name); }
 
-  /// destructor, close the input file stream
-  ~Reader() = default;
+  /// the mapping belongs to a single reader
+  Reader(const Reader&) = delete;
+  Reader& operator=(const Reader&) = delete;
+
+  /// move the mapping to another reader
+  Reader(Reader&& other) { *this = std::move(other); }
+  Reader& operator=(Reader&& other) {
+    if (this != &other) {
+      unmap();
+      std::swap(data_, other.data_);
+      std::swap(file_size_, other.file_size_);
+      pos_ = other.pos_;
+      fail_ = other.fail_;
+      eof_ = other.eof_;
+    }
+    return *this;
+  }
+
+  /// destructor, unmap the input file
+  ~Reader() { unmap(); }
 
   /**
    * Go ("seek") a specific position in the file.
@@ -58,8 +101,18 @@ class Reader {
    * @param[in] off number of bytes to move relative to dir
    * @param[in] dir location flag for the file, default is beginning
    */
-  void seek(int off, std::ios_base::seekdir dir = std::ios::beg) {
-    file_.seekg(off, dir);
+  void seek(std::streamoff off, std::ios_base::seekdir dir = std::ios::beg) {
+    // like seekg, leaving the end of the file clears eof but not fail
+    eof_ = false;
+    if (fail_) return;
+    std::streamoff base{0};
+    if (dir == std::ios::cur) base = pos_;
+    if (dir == std::ios::end) base = file_size_;
+    if (base + off < 0) {
+      fail_ = true;
+      return;
+    }
+    pos_ = base + off;
   }
 
   /**
@@ -75,8 +128,8 @@ class Reader {
    */
   template <typename WordType,
             std::enable_if_t<std::is_integral<WordType>::value, bool> = true>
-  void seek(int off, std::ios_base::seekdir dir = std::ios::beg) {
-    seek(off * sizeof(WordType), dir);
+  void seek(std::streamoff off, std::ios_base::seekdir dir = std::ios::beg) {
+    seek(off * std::streamoff(sizeof(WordType)), dir);
   }
 
   /**
@@ -84,7 +137,7 @@ class Reader {
    *
    * @return int number of bytes relative to beginning of file
    */
-  int tell() { return file_.tellg(); }
+  std::streamoff tell() { return fail_ ? -1 : pos_; }
 
   /**
    * Tell by number of words
@@ -92,7 +145,7 @@ class Reader {
    * @return int number of words relative to beginning of file
    */
   template <typename WordType>
-  int tell() {
+  std::streamoff tell() {
     return tell() / sizeof(WordType);
   }
 
@@ -111,7 +164,21 @@ class Reader {
   template <typename WordType,
             std::enable_if_t<std::is_integral<WordType>::value, bool> = true>
   Reader& read(WordType* w, std::size_t count) {
-    file_.read(reinterpret_cast<char*>(w), sizeof(WordType) * count);
+    if (fail_) return *this;
+    std::size_t n_bytes{sizeof(WordType) * count};
+    std::size_t available{pos_ < std::streamoff(file_size_)
+                              ? file_size_ - std::size_t(pos_)
+                              : 0};
+    if (n_bytes > available) {
+      // copy what is left, as a stream would, and fail
+      if (available > 0) std::memcpy(w, data_ + pos_, available);
+      pos_ = file_size_;
+      eof_ = true;
+      fail_ = true;
+      return *this;
+    }
+    std::memcpy(w, data_ + pos_, n_bytes);
+    pos_ += n_bytes;
     return *this;
   }
 
@@ -162,6 +229,7 @@ class Reader {
    * copies while the vector is being expanded. After allocating the space
    * for each entry in the vector, we call the stream operator from
    * *this into each entry in order, leaving early if a failure occurs.
+   * Integral words are copied out of the file all at once.
    *
    * @tparam[in] ContentType type of object inside the vector
    * @param[in] vec object vector to read into
@@ -171,27 +239,31 @@ class Reader {
   template <typename ContentType>
   Reader& read(std::vector<ContentType>& vec, std::size_t count) {
     vec.resize(count);
-    for (auto& w : vec) {
-      if (!(*this >> w)) return *this;
+    if constexpr (std::is_integral<ContentType>::value) {
+      return read(vec.data(), count);
+    } else {
+      for (auto& w : vec) {
+        if (!(*this >> w)) return *this;
+      }
+      return *this;
     }
-    return *this;
   }
 
   /**
    * Check if reader is in a fail state
    *
-   * Following the C++ reference, we pass-along the check
-   * on if our ifstream is in a fail state.
+   * Following the C++ reference for streams, a failed read or seek
+   * puts the reader into the fail state.
    *
    * @return bool true if ifstream is in fail state
    */
-  bool operator!() const { return file_.fail(); }
+  bool operator!() const { return fail_; }
 
   /**
    * Check if reader is in good/bad state
    *
-   * Following the C++ reference, we pass-along the check
-   * on if our ifstream is in a fail state.
+   * Following the C++ reference for streams, a failed read or seek
+   * puts the reader into the fail state.
    *
    * Defining this operator allows us to do the following.
    *
@@ -202,22 +274,35 @@ class Reader {
    *
    * @return bool true if ifstream is in good state
    */
-  operator bool() const { return !file_.fail(); }
+  operator bool() const { return !fail_; }
 
   /**
    * check if file is done
    *
-   * Just calls the underlying ifstream eof.
+   * Either a read went past the end or we are at the end.
    *
    * @return true if we have reached the end of file.
    */
-  bool eof() { return file_.eof() or file_.tellg() == file_size_; }
+  bool eof() { return eof_ or pos_ == std::streamoff(file_size_); }
 
  private:
-  /// file stream we are reading from
-  std::ifstream file_;
+  /// unmap the current file, if any
+  void unmap() {
+    if (data_) munmap(const_cast<char*>(data_), file_size_);
+    data_ = nullptr;
+    file_size_ = 0;
+  }
+
+  /// contents of the file, mapped into memory
+  const char* data_{nullptr};
   /// file size in bytes
-  std::size_t file_size_;
+  std::size_t file_size_{0};
+  /// current position in bytes
+  std::streamoff pos_{0};
+  /// a read or seek failed, or the file couldn't be opened
+  bool fail_{false};
+  /// a read went past the end of the file
+  bool eof_{false};
 };  // RawDataFile
 
 }  // namespace utility
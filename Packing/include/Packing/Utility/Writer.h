@@ -1,10 +1,16 @@
 #ifndef PACKING_UTILITY_WRITER_H_
 #define PACKING_UTILITY_WRITER_H_
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
 #include <iostream>  //debuggin
+#include <mutex>
 #include <string>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 namespace packing {
 namespace utility {
@@ -15,6 +21,13 @@ namespace utility {
  *
  * We wrap a basic std::ifstream in order to make the writing
  * of specific-width words easier for ourselves.
+ *
+ * With a block size, the words are copied into one of two blocks and a
+ * background thread writes each block to the file once it is full while
+ * the other block is filled. The processing thread then only waits on
+ * the file when it fills a block faster than the file takes it. The
+ * failure of a block is only seen after it was written, so the writer
+ * has to be closed before its final state is known.
  */
 class Writer {
  public:
@@ -31,20 +44,56 @@ class Writer {
    * We open the file stream in output, binary mode.
    *
    * @param[in] file_name name of file to open
+   * @param[in] block_size size of the blocks written by the background
+   * thread [bytes], 0 writes directly to the file stream
    */
-  void open(const std::string& file_name) {
+  void open(const std::string& file_name, std::size_t block_size = 0) {
+    close();
+    file_.clear();
     file_.open(file_name, std::ios::out | std::ios::binary);
+    failed_ = file_.fail();
+    block_size_ = block_size;
+    if (block_size_ == 0 or failed_) return;
+    filling_.reserve(block_size_);
+    flushing_.reserve(block_size_);
+    stop_ = false;
+    flusher_ = std::thread(&Writer::flushBlocks, this);
   }
 
   /**
    * Open the input file name upon construction of this writer.
    *
    * @param[in] file_name name of file to open
+   * @param[in] block_size size of the blocks written by the background
+   * thread [bytes], 0 writes directly to the file stream
    */
-  Writer(const std::string& file_name) : Writer() { this->open(file_name); }
+  Writer(const std::string& file_name, std::size_t block_size = 0)
+      : Writer() {
+    this->open(file_name, block_size);
+  }
 
-  /// destructor, close the input file stream
-  ~Writer() = default;
+  /// destructor, write the blocks and close the output file stream
+  ~Writer() { close(); }
+
+  /**
+   * Write the block being filled, stop the background thread and close
+   * the output file stream
+   */
+  void close() {
+    if (flusher_.joinable()) {
+      if (not filling_.empty()) flush();
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+      }
+      changed_.notify_all();
+      flusher_.join();
+    }
+    if (file_.is_open()) {
+      file_.close();
+      if (file_.fail()) failed_ = true;
+    }
+  }
 
   /**
    * Write a certain number of words from the input array to the output file
@@ -61,7 +110,20 @@ class Writer {
   template <typename WordType,
             std::enable_if_t<std::is_integral<WordType>::value, bool> = true>
   Writer& write(const WordType* w, std::size_t num) {
-    file_.write(reinterpret_cast<const char*>(w), sizeof(WordType) * num);
+    auto data{reinterpret_cast<const char*>(w)};
+    std::size_t size{sizeof(WordType) * num};
+    if (not flusher_.joinable()) {
+      file_.write(data, size);
+      if (file_.fail()) failed_ = true;
+      return *this;
+    }
+    while (size > 0) {
+      std::size_t n{std::min(size, block_size_ - filling_.size())};
+      filling_.insert(filling_.end(), data, data + n);
+      data += n;
+      size -= n;
+      if (filling_.size() == block_size_) flush();
+    }
     return *this;
   }
 
@@ -136,24 +198,70 @@ class Writer {
   /**
    * Check if writer is in a fail state
    *
-   * Uses std::ofstream::fail to check on stream.
+   * Uses std::ofstream::fail of the writes to the stream so far.
    *
    * @return true if stream is in fail state
    */
-  bool operator!() const { return file_.fail(); }
+  bool operator!() const { return failed_; }
 
   /**
    * Check if writer is in a good/bad state
    *
-   * Uses std::ofstream::fail to check on stream.
+   * Uses std::ofstream::fail of the writes to the stream so far.
    *
    * @return true if stream is in good state
    */
-  operator bool() const { return !file_.fail(); }
+  operator bool() const { return !failed_; }
+
+ private:
+  /**
+   * Hand the block being filled to the background thread
+   *
+   * We wait for the background thread to finish writing the previous block
+   * and then swap the blocks, so their memory is reused.
+   */
+  void flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this] { return flushing_.empty(); });
+    std::swap(filling_, flushing_);
+    lock.unlock();
+    changed_.notify_all();
+  }
+
+  /// body of the background thread, write the blocks until stopped
+  void flushBlocks() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      changed_.wait(lock, [this] { return stop_ or not flushing_.empty(); });
+      if (flushing_.empty()) return;
+      lock.unlock();
+      file_.write(flushing_.data(), flushing_.size());
+      if (file_.fail()) failed_ = true;
+      lock.lock();
+      flushing_.clear();
+      changed_.notify_all();
+    }
+  }
 
  private:
   /// file stream we are writing to
   std::ofstream file_;
+  /// the file stream failed, set by the background thread as well
+  std::atomic<bool> failed_{false};
+  /// size of the blocks [bytes], 0 if there is no background thread
+  std::size_t block_size_{0};
+  /// block being filled by the writing thread
+  std::vector<char> filling_;
+  /// block being written by the background thread, empty when done
+  std::vector<char> flushing_;
+  /// background thread writing the blocks
+  std::thread flusher_;
+  /// protects the block being written and the stop request
+  std::mutex mutex_;
+  /// signals a block to write, a written block or a request to stop
+  std::condition_variable changed_;
+  /// the background thread should stop after writing its block
+  bool stop_{false};
 };  // RawDataFile
 
 }  // namespace utility
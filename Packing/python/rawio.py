@@ -15,6 +15,14 @@ class RawDataFile() :
         self.triggerpad_object_name = "TriggerPadRaw"
         self.pass_name = ""
         self.skip_unavailable = True
+        # number of threads decoding the event packets of an input file,
+        # 0 decodes each event when it is read
+        self.n_decode_threads = 0
+        # maximum number of event packets decoded ahead of the current event
+        self.decode_ahead = 64
+        # size of the blocks an output file is written in by a background
+        # thread [bytes], 0 writes each event packet when it is packed
+        self.write_block_size = 0
 
 class RawIO(ldmxcfg.Producer) :
     """Producer which runs a single raw data file for input/output
@@ -73,13 +81,18 @@ class SingleSubsystemPacker(ldmxcfg.Analyzer) :
         event bus object name for encoded buffer
     input_pass : str
         event bus object pass for encoded buffer
+    write_block_size : int
+        size of the blocks written by a background thread [bytes],
+        0 writes each buffer when it is packed
     """
 
-    def __init__(self, raw_file, input_name, input_pass = '') :
+    def __init__(self, raw_file, input_name, input_pass = '',
+                 write_block_size = 0) :
         super().__init__(f'pack_{os.path.basename(raw_file)}','packing::SingleSubsystemPacker','Packing')
         self.raw_file = raw_file
         self.input_name = input_name
         self.input_pass = input_pass
+        self.write_block_size = write_block_size
 
 class WRRawDecoder(ldmxcfg.Producer) :
     def __init__(self, raw_file, output_name, ntuplize = True, name = 'wr') :
@@ -89,8 +102,10 @@ class WRRawDecoder(ldmxcfg.Producer) :
         self.ntuplize = ntuplize
 
 class FiberTrackerRawDecoder(ldmxcfg.Producer) :
-    def __init__(self, raw_file, output_name, name, ntuplize = True) :
+    def __init__(self, raw_file, output_name, name, ntuplize = True, count_only = False) :
         super().__init__(name,'packing::FiberTrackerRawDecoder','Packing')
         self.input_file = raw_file
         self.output_name = output_name
         self.ntuplize = ntuplize
+        # only put the number of hit fibers of each event on the bus
+        self.count_only = count_only
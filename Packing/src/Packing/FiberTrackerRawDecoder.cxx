@@ -1,4 +1,5 @@
 
+#include <algorithm>
 #include <bitset>
 #include <iomanip>
 #include <optional>
@@ -61,13 +62,26 @@ class FiberTrackerField {
    * i_field - field we are supposed to be reading from
    */
   FiberTrackerField(utility::Reader& r, int i_field) {
-    uint32_t len;
-    r >> len >> field_header_;
-    r.read(field_value_, len - 1);
-    if (i_field != field_header_) {
+    read(r, i_field, field_value_);
+  }
+
+  /**
+   * Read the value of a field into a buffer the caller keeps,
+   * so its memory can be reused
+   *
+   * r - reader
+   * i_field - field we are supposed to be reading from
+   * value - buffer for the value of the field
+   */
+  static void read(utility::Reader& r, int i_field,
+                   std::vector<uint32_t>& value) {
+    uint32_t len, field_header;
+    r >> len >> field_header;
+    r.read(value, len - 1);
+    if (i_field != field_header) {
       EXCEPTION_RAISE("BadForm", "Field " + std::to_string(i_field) +
                                      " has a mismatched header " +
-                                     std::to_string(field_header_));
+                                     std::to_string(field_header));
     }
   }
 
@@ -141,15 +155,25 @@ struct FiberTrackerEvent {
 
   FiberTrackerEvent(const std::vector<uint32_t>& spill_data,
                     std::size_t i_word) {
+    assign(spill_data, i_word, true);
+  }
+
+  /**
+   * Set this event from the words of the spill starting at i_word,
+   * reusing the memory of the hits
+   */
+  void assign(const std::vector<uint32_t>& spill_data, std::size_t i_word,
+              bool with_hits) {
     trigger_timestamp_lsb = spill_data.at(i_word);
     trigger_timestamp_msb = spill_data.at(i_word + 1);
     event_timestamp_lsb = spill_data.at(i_word + 2);
     event_timestamp_msb = spill_data.at(i_word + 3);
     channel_hits.clear();
-    channel_hits.reserve(6);
-    for (std::size_t i{i_word + 4}; i < i_word + 10 and i < spill_data.size();
-         i++)
-      channel_hits.push_back(spill_data.at(i));
+    if (with_hits) {
+      channel_hits.insert(
+          channel_hits.end(), spill_data.begin() + i_word + 4,
+          spill_data.begin() + std::min(i_word + 10, spill_data.size()));
+    }
   }
 };
 
@@ -171,9 +195,14 @@ struct FiberTrackerBinaryPacket {
   std::string equipmentName;
   int eventSelectionAcq;
   /**
-   * This is the actual event data in which we are interested
+   * This is the actual event data in which we are interested,
+   * the 10 words of each event one after the other. The events are only
+   * made from them when they are used and the buffer is reused by the
+   * following spills.
    */
-  std::vector<FiberTrackerEvent> eventsData;
+  std::vector<uint32_t> eventsData;
+  /// number of hit fibers in each event
+  std::vector<int> eventsHits;
   /// index of event we are on (for next)
   int i_event{0};
 
@@ -189,13 +218,27 @@ struct FiberTrackerBinaryPacket {
   int triggerOffsetAcq;
   int triggerSelectionAcq;
 
-  bool next(FiberTrackerEvent& e) {
+  /// number of events in the spill, the last one may be cut short
+  int nEvents() const { return (eventsData.size() + 9) / 10; }
+
+  /// go to the next event, false if there are no more in this spill
+  bool next() {
     i_event++;
-    if (i_event < eventsData.size()) {
-      e = eventsData.at(i_event);
-      return true;
-    }
-    return false;
+    return i_event < nEvents();
+  }
+
+  /// make the current event, optionally without its hits
+  void get(FiberTrackerEvent& e, bool with_hits = true) const {
+    e.assign(eventsData, 10 * i_event, with_hits);
+  }
+
+  /// number of hit fibers in the current event
+  int hits() const { return eventsHits.at(i_event); }
+
+  bool next(FiberTrackerEvent& e) {
+    if (not next()) return false;
+    get(e);
+    return true;
   }
 
   /**
@@ -269,17 +312,18 @@ struct FiberTrackerBinaryPacket {
     std::cout << i_field << " "
               << "eventSelectionAcq = " << eventSelectionAcq << std::endl;
 #endif
-    FiberTrackerField events_data_field(r, ++i_field);
+    FiberTrackerField::read(r, ++i_field, eventsData);
     i_event = -1;
-    eventsData.clear();
-    eventsData.reserve(events_data_field.value().size() / 10);
-    for (std::size_t i_word{0}; i_word < events_data_field.value().size();
-         i_word += 10) {
-      eventsData.emplace_back(events_data_field.value(), i_word);
+    // count the hits of all the events in one pass over the spill
+    eventsHits.assign(nEvents(), 0);
+    for (std::size_t i_word{0}; i_word < eventsData.size(); i_word++) {
+      if (i_word % 10 >= 4) {
+        eventsHits[i_word / 10] += __builtin_popcount(eventsData[i_word]);
+      }
     }
 #ifdef DEBUG
     std::cout << i_field << " "
-              << "eventsData (size = " << eventsData.size() << ")" << std::endl;
+              << "eventsData (size = " << nEvents() << ")" << std::endl;
 #endif
     meanSNew = FiberTrackerField(r, ++i_field).to_double();
 #ifdef DEBUG
@@ -378,6 +422,8 @@ class FiberTrackerRawDecoder : public framework::Producer {
   std::string output_name_;
   /// should we ntuplize?
   bool ntuplize_;
+  /// only count the hit fibers of each event instead of adding them
+  bool count_only_;
 
  private:
   /// the file reader (if we are doing that)
@@ -394,6 +440,7 @@ void FiberTrackerRawDecoder::configure(framework::config::Parameters& ps) {
   input_file_ = ps.getParameter<std::string>("input_file");
   output_name_ = ps.getParameter<std::string>("output_name");
   ntuplize_ = ps.getParameter<bool>("ntuplize");
+  count_only_ = ps.getParameter<bool>("count_only", false);
 
   file_reader_.open(input_file_);
 }
@@ -432,12 +479,13 @@ void FiberTrackerRawDecoder::onProcessStart() {
 
 void FiberTrackerRawDecoder::produce(framework::Event& event) {
   // only add and fill when file able to readout packet
-  if (not spill_packet_.next(ft_event_)) {
+  bool has_event = spill_packet_.next();
+  if (not has_event) {
     // no more events in this spill
     if (file_reader_ >> spill_packet_) {
-      spill_tree_->Fill();
+      if (ntuplize_) spill_tree_->Fill();
       // next spill loaded, pop its first event
-      spill_packet_.next(ft_event_);
+      has_event = spill_packet_.next();
     } else {
 #ifdef DEBUG
       std::cout << "no more events" << std::endl;
@@ -445,13 +493,20 @@ void FiberTrackerRawDecoder::produce(framework::Event& event) {
       return;
     }
   }
-  tree_->Fill();
+  // the hits are only copied out of the spill if they are used
+  bool with_hits = not count_only_ or ntuplize_;
+  if (has_event) spill_packet_.get(ft_event_, with_hits);
+  if (ntuplize_) tree_->Fill();
 
   event.add(output_name_ + "TriggerTSLSB", ft_event_.trigger_timestamp_lsb);
   event.add(output_name_ + "TriggerTSMSB", ft_event_.trigger_timestamp_msb);
   event.add(output_name_ + "EventTSLSB", ft_event_.event_timestamp_lsb);
   event.add(output_name_ + "EventTSMSB", ft_event_.event_timestamp_msb);
-  event.add(output_name_ + "Hits", ft_event_.channel_hits);
+  if (count_only_) {
+    event.add(output_name_ + "NHits", has_event ? spill_packet_.hits() : 0);
+  } else {
+    event.add(output_name_ + "Hits", ft_event_.channel_hits);
+  }
   return;
 }  // produce
 
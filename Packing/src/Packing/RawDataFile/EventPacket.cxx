@@ -51,8 +51,8 @@ utility::Reader& EventPacket::read(utility::Reader& r) {
 }
 
 utility::Writer& EventPacket::write(utility::Writer& w) const {
-  std::vector<uint32_t> h{header()}, t{tail()};
-  w << h << subsys_data_ << t;
+  std::vector<uint32_t> h{header()};
+  w << h << subsys_data_ << crc_;
   return w;
 }
 
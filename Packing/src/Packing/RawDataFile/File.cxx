@@ -1,6 +1,8 @@
 
 #include "Packing/RawDataFile/File.h"
 
+#include <algorithm>
+
 #include "DetDescr/DetectorID.h"
 #include "Packing/Utility/CRC.h"
 #include "Packing/Utility/Mask.h"
@@ -13,6 +15,10 @@ File::File(const framework::config::Parameters &ps) {
   skip_unavailable_ = ps.getParameter<bool>("skip_unavailable");
 
   std::string fn = ps.getParameter<std::string>("filename");
+  filename_ = fn;
+  n_decode_threads_ = ps.getParameter<int>("n_decode_threads", 0);
+  decode_ahead_ = ps.getParameter<int>("decode_ahead", 64);
+  int write_block_size{ps.getParameter<int>("write_block_size", 0)};
 
   ecal_object_name_ = ps.getParameter<std::string>("ecal_object_name");
   hcal_object_name_ = ps.getParameter<std::string>("hcal_object_name");
@@ -23,7 +29,7 @@ File::File(const framework::config::Parameters &ps) {
 
   std::cerr << "creating file" << std::endl;
   if (is_output_) {
-    writer_.open(fn);
+    writer_.open(fn, write_block_size);
     // leave entry count undefined
     entries_ = 0;
     i_entry_ = 0;
@@ -52,10 +58,14 @@ File::File(const framework::config::Parameters &ps) {
     reader_.seek<uint32_t>(1, std::ios::beg);
 
     if (ps.getParameter<bool>("verify_checksum")) {
+      // sum the file in large chunks rather than word by word
       utility::CRC crc;
-      for (auto ifile{reader_.tell<uint32_t>()}; ifile < eof; ifile++) {
-        reader_ >> word;
-        crc << word;
+      std::vector<uint32_t> chunk;
+      static const std::size_t chunk_size{1 << 20};
+      for (auto ifile{reader_.tell<uint32_t>()}; ifile < eof;
+           ifile += chunk.size()) {
+        reader_.read(chunk, std::min<std::size_t>(chunk_size, eof - ifile));
+        crc << chunk;
       }
 
       if (crc.get() != crc_read_in) {
@@ -65,9 +75,16 @@ File::File(const framework::config::Parameters &ps) {
 
       reader_.seek<uint32_t>(1, std::ios::beg);
     }  // verify checksum of input file
-  }    // input or output file
+
+    if (n_decode_threads_ > 0) {
+      scan();
+      startDecoding();
+    }
+  }  // input or output file
 }
 
+File::~File() { stopDecoding(); }
+
 bool File::connect(framework::Event &event) {
   event_ = &event;
   return true;
@@ -100,14 +117,33 @@ bool File::nextEvent() {
     // check for EoF
     if (i_entry_ + 1 > entries_) return false;
 
-    i_entry_++;
-
     // read buffers from event packet and add to event bus
     static EventPacket read_event;
-    reader_ >> read_event;
-    if (!reader_) {
-      // ERROR
-      return false;
+    if (decoders_.empty()) {
+      i_entry_++;
+      reader_ >> read_event;
+      if (!reader_) {
+        // ERROR
+        return false;
+      }
+    } else {
+      // wait for the decoding threads to get to this entry
+      std::unique_lock<std::mutex> lock(mutex_);
+      uint32_t entry{i_entry_};
+      changed_.wait(lock, [&] {
+        return decoded_.find(entry) != decoded_.end() or
+               failed_entry_ <= entry or entry >= offsets_.size();
+      });
+      auto decoded{decoded_.find(entry)};
+      if (decoded == decoded_.end()) {
+        // ERROR
+        return false;
+      }
+      read_event = std::move(decoded->second);
+      decoded_.erase(decoded);
+      i_entry_++;
+      lock.unlock();
+      changed_.notify_all();
     }
 
     event_->getEventHeader().setEventNumber(read_event.id());
@@ -140,11 +176,101 @@ void File::writeRunHeader(ldmx::RunHeader &header) {
 }
 
 void File::close() {
+  stopDecoding();
   event_ = nullptr;
   if (is_output_) {
     writer_ << entries_;
     crc_ << entries_;
     writer_ << crc_.get();
+    writer_.close();
+  }
+}
+
+void File::scan() {
+  offsets_.clear();
+  offsets_.reserve(entries_);
+  // count the words ourselves, the file can be larger than tell can report
+  std::size_t offset{1};
+  reader_.seek<uint32_t>(offset, std::ios::beg);
+  for (uint32_t i_entry{0}; i_entry < entries_; i_entry++) {
+    // event id and header word
+    uint32_t id, word;
+    if (!(reader_ >> id >> word)) break;
+    std::size_t length{2};
+    uint16_t num_subsys = (word >> 16) & utility::mask<16>;
+    for (uint16_t i_subsys{0}; i_subsys < num_subsys; i_subsys++) {
+      if (!(reader_ >> word)) break;
+      // skip the event number, the data and the crc of the subsystem
+      uint32_t len = (word >> 1) & utility::mask<15>;
+      reader_.seek<uint32_t>(len + 2, std::ios::cur);
+      length += len + 3;
+    }
+    // skip the crc of the event
+    reader_.seek<uint32_t>(1, std::ios::cur);
+    length++;
+    if (!reader_) break;
+    offsets_.push_back(offset);
+    offset += length;
+  }
+
+  if (offsets_.size() < entries_) {
+    std::cerr << "Only found " << offsets_.size() << " of the " << entries_
+              << " event packets in " << filename_ << "." << std::endl;
+  }
+
+  reader_.seek<uint32_t>(1, std::ios::beg);
+}
+
+void File::startDecoding() {
+  stop_ = false;
+  next_decode_ = i_entry_;
+  failed_entry_ = std::numeric_limits<uint32_t>::max();
+  for (int i_thread{0}; i_thread < n_decode_threads_; i_thread++) {
+    decoders_.emplace_back(&File::decode, this);
+  }
+}
+
+void File::stopDecoding() {
+  if (decoders_.empty()) return;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  changed_.notify_all();
+  for (auto &decoder : decoders_) decoder.join();
+  decoders_.clear();
+  decoded_.clear();
+}
+
+void File::decode() {
+  // each thread reads from its own handle so that they don't share a position
+  utility::Reader reader(filename_);
+  while (true) {
+    uint32_t entry;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      changed_.wait(lock, [this] {
+        return stop_ or next_decode_ < i_entry_ + decode_ahead_;
+      });
+      if (stop_ or next_decode_ >= offsets_.size()) return;
+      entry = next_decode_++;
+    }
+
+    EventPacket packet;
+    reader.seek<uint32_t>(offsets_[entry], std::ios::beg);
+    reader >> packet;
+
+    bool ok{reader};
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (ok) {
+        decoded_.emplace(entry, std::move(packet));
+      } else {
+        failed_entry_ = std::min(failed_entry_, entry);
+      }
+    }
+    changed_.notify_all();
+    if (not ok) return;
   }
 }
 
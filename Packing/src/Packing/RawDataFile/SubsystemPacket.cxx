@@ -43,8 +43,9 @@ utility::Reader& SubsystemPacket::read(utility::Reader& r) {
 }
 
 utility::Writer& SubsystemPacket::write(utility::Writer& w) const {
-  std::vector<uint32_t> head{header()}, t{tail()};
-  w << head << data_ << t;
+  // the data is written in one block, only the header needs a copy
+  std::vector<uint32_t> head{header()};
+  w << head << data_ << static_cast<uint32_t>(crc_);
   return w;
 }
 
@@ -4,7 +4,8 @@
 namespace packing {
 
 void SingleSubsystemPacker::configure(framework::config::Parameters& ps) {
-  writer_.open(ps.getParameter<std::string>("raw_file"));
+  writer_.open(ps.getParameter<std::string>("raw_file"),
+               ps.getParameter<int>("write_block_size", 0));
   input_name_ = ps.getParameter<std::string>("input_name");
   input_pass_ = ps.getParameter<std::string>("input_pass");
 }
@@ -45,6 +45,39 @@ TEST_CASE("BinaryIO", "[Packing][functionality]") {
       CHECK(read_vec == test_vec);
       CHECK(read_wide == test_wide);
     }
+
+    SECTION("Seek") {
+      packing::utility::Reader r(test_file);
+
+      uint64_t read_wide;
+      r.seek<uint64_t>(-1, std::ios::end);
+      CHECK(r.tell<uint16_t>() == 4);
+      CHECK(r >> read_wide);
+      CHECK(read_wide == test_wide);
+      CHECK(r.eof());
+    }
+  }
+
+  SECTION("Blocks") {
+    std::string test_file{"blocks_test.raw"};
+    // a block size that doesn't divide the words so they span blocks
+    std::vector<uint32_t> test_vec(1000);
+    for (std::size_t i{0}; i < test_vec.size(); i++) test_vec[i] = i * 7919;
+
+    {
+      packing::utility::Writer w(test_file, 30);
+      for (std::size_t i{0}; i < 10; i++) CHECK(w.write(&test_vec[i], 1));
+      CHECK(w.write(test_vec.data() + 10, test_vec.size() - 10));
+      w.close();
+      CHECK(w);
+    }
+
+    packing::utility::Reader r(test_file);
+    std::vector<uint32_t> read_vec;
+    uint32_t dummy;
+    CHECK(r.read(read_vec, test_vec.size()));
+    CHECK_FALSE(r >> dummy);
+    CHECK(read_vec == test_vec);
   }
 
   SECTION("Subsystem Packet") {
@@ -0,0 +1,59 @@
+#include <boost/crc.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+
+#include "Packing/Utility/CRC.h"
+
+/**
+ * Do we calculate the same checksum as Boost
+ */
+TEST_CASE("CRC", "[Packing][functionality]") {
+  SECTION("Check value") {
+    std::string check{"123456789"};
+    packing::utility::CRC crc;
+    crc.process(check.data(), check.size());
+    CHECK(crc.get() == 0xcbf43926);
+  }
+
+  SECTION("Same as Boost") {
+    std::mt19937 rng{42};
+    for (std::size_t size : {0, 1, 7, 8, 9, 100, 1001}) {
+      std::vector<uint32_t> data(size);
+      for (auto& w : data) w = rng();
+      uint16_t tail = rng();
+
+      packing::utility::CRC crc;
+      crc << data << tail;
+
+      boost::crc_32_type boost_crc;
+      for (auto const& w : data) boost_crc.process_bytes(&w, sizeof(w));
+      boost_crc.process_bytes(&tail, sizeof(tail));
+
+      CHECK(crc.get() == boost_crc.checksum());
+    }
+  }
+}
+
+/**
+ * How fast do we checksum a buffer
+ *
+ * Hidden by default, run with the [!benchmark] tag.
+ */
+TEST_CASE("CRC Benchmark", "[Packing][!benchmark]") {
+  std::mt19937 rng{42};
+  std::vector<uint32_t> data(1 << 20);
+  for (auto& w : data) w = rng();
+
+  BENCHMARK("CRC 4 MB buffer") {
+    packing::utility::CRC crc;
+    crc << data;
+    return crc.get();
+  };
+
+  BENCHMARK("Boost 4 MB buffer") {
+    boost::crc_32_type crc;
+    crc.process_bytes(data.data(), data.size() * sizeof(uint32_t));
+    return crc.checksum();
+  };
+}
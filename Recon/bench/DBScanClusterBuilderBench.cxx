@@ -0,0 +1,84 @@
+/**
+ * @file DBScanClusterBuilderBench.cxx
+ * @brief Benchmark the DBSCAN clustering of calorimeter hits
+ */
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "Recon/DBScanClusterBuilder.h"
+#include "Recon/Event/CalorimeterHit.h"
+
+namespace recon {
+namespace bench {
+
+/**
+ * The hits of an event with a few showers in the ECal
+ *
+ * Most of the hits belong to three showers spread around their axes,
+ * the rest are spread over the ECal. They are drawn from a fixed seed,
+ * so every run and every build clusters the same hits.
+ *
+ * @param[in] n_hits number of hits in the event
+ */
+static std::vector<ldmx::CalorimeterHit> recordedHits(int n_hits) {
+  std::mt19937 rng(17);
+  std::uniform_real_distribution<float> x_axis(-200., 200.),
+      z_hit(240., 750.);
+  std::normal_distribution<float> spread(0., 15.);
+  std::exponential_distribution<float> energy(1. / 5.);
+
+  std::vector<ldmx::CalorimeterHit> hits;
+  auto add = [&](float x, float y, float z) {
+    ldmx::CalorimeterHit hit;
+    hit.setXPos(x);
+    hit.setYPos(y);
+    hit.setZPos(z);
+    hit.setEnergy(energy(rng));
+    hits.push_back(hit);
+  };
+  for (int i_shower{0}; i_shower < 3; i_shower++) {
+    float x{x_axis(rng)}, y{x_axis(rng)};
+    for (int i{0}; i < n_hits / 4; i++)
+      add(x + spread(rng), y + spread(rng), z_hit(rng));
+  }
+  while (int(hits.size()) < n_hits) add(x_axis(rng), x_axis(rng), z_hit(rng));
+  return hits;
+}
+
+}  // namespace bench
+}  // namespace recon
+
+/// Cluster the recorded hits of an event with the PF ECal settings
+static void BM_DBScanClusterBuilder_runDBSCAN(benchmark::State& state) {
+  using namespace recon;
+  const auto hits{bench::recordedHits(state.range(0))};
+  std::vector<const ldmx::CalorimeterHit*> ptrs;
+  for (const auto& hit : hits) ptrs.push_back(&hit);
+  DBScanClusterBuilder cb(1., 50., 1., 2);
+  for (auto _ : state) {
+    auto clusters{cb.runDBSCAN(ptrs, false)};
+    benchmark::DoNotOptimize(clusters);
+  }
+  state.SetItemsProcessed(state.iterations() * hits.size());
+}
+BENCHMARK(BM_DBScanClusterBuilder_runDBSCAN)->Arg(100)->Arg(300)->Arg(1000);
+
+/// Cluster the recorded hits of an event from their view
+static void BM_DBScanClusterBuilder_runDBSCANView(benchmark::State& state) {
+  using namespace recon;
+  const auto hits{bench::recordedHits(state.range(0))};
+  CaloHitView view;
+  view.fill(hits);
+  DBScanClusterBuilder cb(1., 50., 1., 2);
+  for (auto _ : state) {
+    auto clusters{cb.runDBSCAN(view, false)};
+    benchmark::DoNotOptimize(clusters);
+  }
+  state.SetItemsProcessed(state.iterations() * hits.size());
+}
+BENCHMARK(BM_DBScanClusterBuilder_runDBSCANView)
+    ->Arg(100)
+    ->Arg(300)
+    ->Arg(1000);
@@ -0,0 +1,92 @@
+/**
+ * @file HgcrocDigiCollectionBench.cxx
+ * @brief Benchmark going through the digis of an HgcrocDigiCollection
+ */
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "Recon/Event/HgcrocDigiCollection.h"
+
+namespace ldmx {
+namespace bench {
+
+/**
+ * The digis of an event
+ *
+ * Most of the digis are in ADC mode with a pulse around the sample
+ * of interest and a few are in TOT mode, with the settings of the ECal.
+ * They are drawn from a fixed seed, so every run and every build goes
+ * through the same digis.
+ *
+ * @param[in] n_digis number of digis in the collection
+ */
+static HgcrocDigiCollection recordedDigis(int n_digis) {
+  HgcrocDigiCollection digis;
+  digis.setNumSamplesPerDigi(10);
+  digis.setSampleOfInterestIndex(2);
+  digis.setVersion(3);
+
+  std::mt19937 rng(19);
+  std::uniform_int_distribution<int> adc(50, 300), toa(0, 1023),
+      tot(0, 4095);
+  std::bernoulli_distribution is_tot(0.05);
+  std::vector<HgcrocDigiCollection::Sample> digi;
+  for (int i_digi{0}; i_digi < n_digis; i_digi++) {
+    digi.clear();
+    bool tot_mode{is_tot(rng)};
+    int adc_tm1{50};
+    for (int i_sample{0}; i_sample < 10; i_sample++) {
+      if (tot_mode and i_sample == 2) {
+        digi.emplace_back(false, true, adc_tm1, tot(rng), toa(rng));
+        adc_tm1 = 50;
+      } else {
+        int adc_t{adc(rng)};
+        digi.emplace_back(false, false, adc_tm1, adc_t, toa(rng));
+        adc_tm1 = adc_t;
+      }
+    }
+    digis.addDigi(i_digi, digi);
+  }
+  return digis;
+}
+
+}  // namespace bench
+}  // namespace ldmx
+
+/// Sum the ADC of the sample of interest of each digi, one digi at a time
+static void BM_HgcrocDigiCollection_iterate(benchmark::State& state) {
+  using namespace ldmx;
+  auto digis{bench::recordedDigis(state.range(0))};
+  for (auto _ : state) {
+    long sum{0};
+    for (auto digi : digis) {
+      if (digi.isADC()) sum += digi.soi().adc_t();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * digis.size());
+}
+BENCHMARK(BM_HgcrocDigiCollection_iterate)->Arg(1000)->Arg(10000);
+
+/**
+ * Sum the ADC of the sample of interest of each digi from the decoded
+ * samples, decoding them for every pass like each new event would
+ */
+static void BM_HgcrocDigiCollection_decoded(benchmark::State& state) {
+  using namespace ldmx;
+  auto digis{bench::recordedDigis(state.range(0))};
+  for (auto _ : state) {
+    // setting the version drops the decoded samples
+    digis.setVersion(3);
+    const auto& decoded{digis.decoded()};
+    long sum{0};
+    for (unsigned int i_digi{0}; i_digi < digis.size(); i_digi++) {
+      if (decoded.isADC(i_digi)) sum += decoded.adc_t[decoded.soi(i_digi)];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * digis.size());
+}
+BENCHMARK(BM_HgcrocDigiCollection_decoded)->Arg(1000)->Arg(10000);
@@ -10,6 +10,10 @@
 #include "Recon/Event/BeamElectronTruth.h"
 #include "SimCore/Event/SimCalorimeterHit.h"
 
+//---< Tools >---//
+#include "Tools/BarBins.h"
+#include "Tools/ToleranceMatcher.h"
+
 namespace recon {
 
 /**
@@ -116,16 +120,20 @@ class BeamElectronLocator : public framework::Producer {
   bool verbose_{false};
 
   /**
-   * Bins coordinates according to some given granularity (passed as argument).
-   * Returns the lower bin edge. -1 for underflow (coordinate < min_in_mm);
-   * with a system of N bins, returns n = N if coordinate > max_in_mm.
+   * Bars in X and Y, built from the granularity and the edges.
+   *
+   * A coordinate gets the lower edge of its bar, -1 for underflow
+   * (coordinate < min_in_mm); with a system of N bars, it gets n = N if the
+   * coordinate > max_in_mm.
    *
    * TODO also implement a function that returns the grid of non-empty hit
    * coordinates, which accounts for that we don't know the multiplicity at a
    * location
    */
-  int bin(float coordinate, double binWidth, double min, double max);
+  std::unique_ptr<ldmx::BarBins> barsX_, barsY_;
 
+  /// Positions of the electrons found so far in the event
+  ldmx::ToleranceMatcher found_;
 };  // BeamElectronLocator
 }  // namespace recon
 
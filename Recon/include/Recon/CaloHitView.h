@@ -0,0 +1,118 @@
+/**
+ * @file CaloHitView.h
+ * @brief Structure-of-arrays copy of a collection of calorimeter hits
+ */
+
+#ifndef RECON_CALOHITVIEW_H_
+#define RECON_CALOHITVIEW_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Framework/Event.h"
+#include "Recon/Event/CalorimeterHit.h"
+
+namespace recon {
+
+/**
+ * The hits of a calorimeter collection laid out as one array per quantity
+ *
+ * The clustering and particle flow processors only look at the position,
+ * energy and time of the hits, which are copied here into contiguous
+ * arrays so their loops read only what they use, the same as the
+ * hcal::HcalHitView does for the HCal vetoes.
+ *
+ * The view of a collection is made once per event and shared by all of
+ * the processors asking for it through get, which keeps it on the event.
+ * ```cpp
+ * const auto& view{CaloHitView::get<ldmx::EcalHit>(event, "EcalRecHits")};
+ * for (std::size_t i{0}; i < view.size(); i++) use(view.x()[i]);
+ * ```
+ * The index of a hit in the view is its index in the collection.
+ */
+class CaloHitView {
+ public:
+  /**
+   * Copy a collection of hits into the arrays
+   *
+   * @tparam Hit type of the hits, derived from ldmx::CalorimeterHit
+   * @param[in] hits the hits to copy
+   */
+  template <typename Hit>
+  void fill(const std::vector<Hit>& hits) {
+    resize(hits.size());
+    for (std::size_t i{0}; i < hits.size(); i++) set(i, hits[i]);
+  }
+
+  /**
+   * Copy a list of hits into the arrays
+   *
+   * @param[in] hits the hits to copy
+   */
+  void fill(const std::vector<const ldmx::CalorimeterHit*>& hits);
+
+  /**
+   * Get the view of a collection of the event, making it the first time
+   *
+   * @tparam Hit type of the hits, derived from ldmx::CalorimeterHit
+   * @param[in] event event with the collection
+   * @param[in] name name of the collection
+   * @param[in] pass pass of the collection, empty for any pass
+   * @return the view, valid until the end of the event
+   */
+  template <typename Hit>
+  static const CaloHitView& get(const framework::Event& event,
+                                const std::string& name,
+                                const std::string& pass = "") {
+    return event.getDerived<CaloHitView>(
+        "CaloHitView/" + name + "/" + pass, [&]() {
+          auto view{std::make_shared<CaloHitView>()};
+          view->fill(event.getCollection<Hit>(name, pass));
+          return view;
+        });
+  }
+
+  /// @return number of hits in the view
+  std::size_t size() const { return energy_.size(); }
+
+  /// @return the ID of each hit
+  const int* id() const { return id_.data(); }
+  /// @return the x position of each hit [mm]
+  const float* x() const { return x_.data(); }
+  /// @return the y position of each hit [mm]
+  const float* y() const { return y_.data(); }
+  /// @return the z position of each hit [mm]
+  const float* z() const { return z_.data(); }
+  /// @return the energy of each hit [MeV]
+  const float* energy() const { return energy_.data(); }
+  /// @return the time of each hit [ns]
+  const float* time() const { return time_.data(); }
+
+  /**
+   * Sum the energies of the hits
+   *
+   * @return total energy [MeV]
+   */
+  float sumEnergy() const;
+
+ private:
+  /// resize the arrays to a number of hits
+  void resize(std::size_t n);
+
+  /// copy a hit into the arrays at an index
+  void set(std::size_t i, const ldmx::CalorimeterHit& hit);
+
+ private:
+  std::vector<int> id_;
+  std::vector<float> x_;
+  std::vector<float> y_;
+  std::vector<float> z_;
+  std::vector<float> energy_;
+  std::vector<float> time_;
+};
+
+}  // namespace recon
+
+#endif  // RECON_CALOHITVIEW_H_
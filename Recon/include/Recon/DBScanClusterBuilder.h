@@ -8,10 +8,11 @@
 #define DBSCANCLUSTERBUILDER_H
 
 #include "Framework/EventProcessor.h"
+#include "Recon/CaloHitView.h"
 #include "Recon/Event/CaloCluster.h"
 #include "Recon/Event/CalorimeterHit.h"
-#include "TFitResult.h"
-#include "TGraph.h"
+#include "Tools/ClusterMoments.h"
+
 namespace recon {
 
 /**
@@ -29,8 +30,31 @@ class DBScanClusterBuilder {
   std::vector<std::vector<const ldmx::CalorimeterHit *> > runDBSCAN(
       const std::vector<const ldmx::CalorimeterHit *> &hits, bool debug);
 
-  void fillClusterInfoFromHits(ldmx::CaloCluster *cl,
-                               std::vector<const ldmx::CalorimeterHit *> hits,
+  /**
+   * Cluster the hits of a view
+   *
+   * @param[in] hits view of the hits
+   * @param[in] debug unused, the debug messages follow the log level
+   * @return the indices in the view of the hits of each cluster
+   */
+  std::vector<std::vector<unsigned int> > runDBSCAN(const CaloHitView &hits,
+                                                    bool debug);
+
+  void fillClusterInfoFromHits(
+      ldmx::CaloCluster *cl,
+      const std::vector<const ldmx::CalorimeterHit *> &hits,
+      bool logEnergyWeight);
+
+  /**
+   * Fill a cluster from some of the hits of a view
+   *
+   * @param[out] cl cluster to fill
+   * @param[in] hits view of the hits
+   * @param[in] indices indices in the view of the hits of the cluster
+   * @param[in] logEnergyWeight weight the positions by the log of the energy
+   */
+  void fillClusterInfoFromHits(ldmx::CaloCluster *cl, const CaloHitView &hits,
+                               const std::vector<unsigned int> &indices,
                                bool logEnergyWeight);
 
   void setMinHitEnergy(float x) { minHitEnergy_ = x; }
@@ -50,13 +74,10 @@ class DBScanClusterBuilder {
   int setMinHitMultiplicity() const { return minClusterHitMult_; }
 
  private:
-  bool isIn(unsigned int i, std::vector<unsigned int> l) {
-    return std::find(l.begin(), l.end(), i) != l.end();
-  }
-  float dist(const ldmx::CalorimeterHit *a, const ldmx::CalorimeterHit *b) {
-    return sqrt(pow(a->getXPos() - b->getXPos(), 2)  // distance
-                + pow(a->getYPos() - b->getYPos(), 2) +
-                pow((a->getZPos() - b->getZPos()) / clusterZBias_,
+  float dist(const CaloHitView &hits, unsigned int a, unsigned int b) {
+    return sqrt(pow(hits.x()[a] - hits.x()[b], 2)  // distance
+                + pow(hits.y()[a] - hits.y()[b], 2) +
+                pow((hits.z()[a] - hits.z()[b]) / clusterZBias_,
                     2));  // divide by the z bias
   }
 
@@ -16,6 +16,7 @@
 #include <stdint.h>  //32bit words
 
 #include <iostream>  //Print method
+#include <memory>    //shared decoded samples
 #include <vector>    //vector lists
 
 namespace ldmx {
@@ -39,6 +40,10 @@ namespace ldmx {
  *  for (auto digi : digi_collection) {
  *    // digi is of type HgcrocDigi
  *  }
+ *
+ * The collection can be packed before it is put into the event so it takes
+ * much less room on disk, @see pack. A packed collection is read like any
+ * other, it is unpacked the first time its digis are asked for.
  */
 class HgcrocDigiCollection {
  public:
@@ -313,6 +318,60 @@ class HgcrocDigiCollection {
 
   };  // HgcrocDigi
 
+ public:
+  /**
+   * @class Decoded
+   * @brief The measurements of all of the samples in the collection, decoded
+   *
+   * The fields of every sample are decoded once, with the version of the
+   * ROC, into parallel lists indexed by index(digi, sample), so the
+   * processors reading the same collection don't each take the words
+   * apart again. Each list holds what the Sample accessor of the same
+   * name returns, and the digi methods match those of HgcrocDigi.
+   */
+  class Decoded {
+   public:
+    /// index of a sample of a digi in the lists
+    std::size_t index(unsigned int digi, unsigned int sample) const {
+      return std::size_t(digi) * num_samples + sample;
+    }
+
+    /// index of the sample of interest of a digi in the lists
+    std::size_t soi(unsigned int digi) const { return index(digi, i_soi); }
+
+    /// @see HgcrocDigi::isADC
+    bool isADC(unsigned int digi) const {
+      return !(tot_progress[soi(digi)] or tot_complete[soi(digi)]);
+    }
+
+    /// @see HgcrocDigi::isTOT
+    bool isTOT(unsigned int digi) const { return !isADC(digi); }
+
+    /// @see HgcrocDigi::tot
+    int digiTOT(unsigned int digi) const {
+      if (not isTOT(digi)) return -1;
+      if (tot_progress[soi(digi)]) return -2;
+      return tot[soi(digi)];
+    }
+
+    /// number of samples per digi
+    unsigned int num_samples{0};
+    /// index of the sample of interest within a digi
+    unsigned int i_soi{0};
+    /// Sample::adc_t of each sample
+    std::vector<int> adc_t;
+    /// Sample::adc_tm1 of each sample
+    std::vector<int> adc_tm1;
+    /// Sample::tot of each sample
+    std::vector<int> tot;
+    /// Sample::toa of each sample
+    std::vector<int> toa;
+    /// Sample::isTOTinProgress of each sample
+    std::vector<char> tot_progress;
+    /// Sample::isTOTComplete of each sample
+    std::vector<char> tot_complete;
+  };  // Decoded
+
  public:
   /**
    * Class constructor.
@@ -351,6 +410,7 @@ class HgcrocDigiCollection {
    */
   void setVersion(int v) {
     version_ = v;
+    decoded_.reset();
     return;
   }
 
@@ -365,7 +425,9 @@ class HgcrocDigiCollection {
    * @param[in] n number of samples per digi
    */
   void setNumSamplesPerDigi(unsigned int n) {
+    unpack();
     numSamplesPerDigi_ = n;
+    decoded_.reset();
     return;
   }
 
@@ -385,6 +447,7 @@ class HgcrocDigiCollection {
    */
   void setSampleOfInterestIndex(unsigned int n) {
     sampleOfInterest_ = n;
+    decoded_.reset();
     return;
   }
 
@@ -403,17 +466,42 @@ class HgcrocDigiCollection {
    */
   const HgcrocDigi getDigi(unsigned int digiIndex) const;
 
+  /**
+   * Get the channel ID of a digi without building the HgcrocDigi
+   *
+   * @param[in] digiIndex index of digi
+   * @return global integer ID of the channel
+   */
+  unsigned int getDigiID(unsigned int digiIndex) const {
+    return ids().at(digiIndex);
+  }
+
+  /**
+   * Get the decoded measurements of all of the samples
+   *
+   * They are decoded the first time this is called after the collection
+   * changed, which is once per event for a collection read from the event
+   * since the event bus clears its objects between events. Processors
+   * running at the same time on the event may all call this, the first
+   * one decodes and the others wait for it.
+   *
+   * @return decoded samples, valid until the collection is changed
+   */
+  const Decoded& decoded() const;
+
   /**
    * Get total number of digis
    * @return unsigned int number of digis
    */
-  unsigned int getNumDigis() const { return channelIDs_.size(); }
+  unsigned int getNumDigis() const {
+    return isPacked() ? numPackedDigis_ : channelIDs_.size();
+  }
 
   /**
    * Get total number of digis
    * @return unsigned int number of digis
    */
-  unsigned int size() const { return channelIDs_.size(); }
+  unsigned int size() const { return getNumDigis(); }
 
   /**
    * Add samples to collection
@@ -426,6 +514,49 @@ class HgcrocDigiCollection {
   void addDigi(unsigned int id, const std::vector<Sample>& digi);
   void addDigi(unsigned int id, const std::vector<uint32_t>& digi);
 
+  /**
+   * Add a digi whose samples are written in place
+   *
+   * This avoids making a temporary list of samples for each digi
+   * when many digis are added at once (e.g. noise in every channel).
+   * The samples are zero until they are written.
+   *
+   * @param[in] id global integer ID for this channel
+   * @return pointer to the getNumSamplesPerDigi() raw sample words
+   * of the new digi, valid until the next digi is added; the samples
+   * must be written before decoded() is called
+   */
+  uint32_t* addDigi(unsigned int id);
+
+  /**
+   * Make room for digis that will be added
+   *
+   * @param[in] n total number of digis to make room for
+   */
+  void reserve(unsigned int n);
+
+  /**
+   * Pack the digis into a compact form for storage
+   *
+   * The samples are written as bytes: each digi starts with the difference
+   * of its ID to the previous one and each sample with a byte holding the
+   * two flags and which of its three 10-bit fields are not zero, followed
+   * by only those fields, each with as many bytes as it needs. The first
+   * field is written as its difference to the second field of the sample
+   * before, since the ADC t-1 of a sample is the ADC t of the one before
+   * when the TOT isn't running. No bits are lost and the order of the
+   * digis is kept, so the collection reads the same afterwards.
+   *
+   * Adding digis to a packed collection unpacks it first.
+   */
+  void pack();
+
+  /**
+   * Check if the digis are stored packed
+   * @return true if pack was called since the last digi was added
+   */
+  bool isPacked() const { return not packed_.empty(); }
+
  public:
   /**
    * iterator class so we can do range-based loops over digi collections
@@ -509,12 +640,41 @@ class HgcrocDigiCollection {
   static const int SECONMEAS_POS = 10;
 
  private:
-  /** list of channel IDs that we have digis for */
+  /// channel IDs of the digis, unpacking them if needed
+  const std::vector<unsigned int>& ids() const;
+
+  /// samples of the digis, unpacking them if needed
+  const std::vector<uint32_t>& words() const;
+
+  /// unpack the digis for good before they are changed
+  void unpack();
+
+  /// decode the packed digis into the given lists
+  void unpackTo(std::vector<unsigned int>& ids,
+                std::vector<uint32_t>& samples) const;
+
+ private:
+  /** list of channel IDs that we have digis for, empty if packed */
   std::vector<unsigned int> channelIDs_;
 
-  /** list of samples that we have been given */
+  /** list of samples that we have been given, empty if packed */
   std::vector<uint32_t> samples_;
 
+  /** the digis packed by pack(), empty unless packed */
+  std::vector<unsigned char> packed_;
+
+  /** number of digis in packed_ */
+  unsigned int numPackedDigis_{0};
+
+  /** channel IDs of a packed collection, unpacked when first read */
+  mutable std::vector<unsigned int> unpackedIDs_;  //! not serialized
+
+  /** samples of a packed collection, unpacked when first read */
+  mutable std::vector<uint32_t> unpackedSamples_;  //! not serialized
+
+  /** true once unpackedIDs_ and unpackedSamples_ are filled */
+  mutable bool unpacked_{false};  //! not serialized
+
   /** number of samples for each digi */
   unsigned int numSamplesPerDigi_;
 
@@ -524,10 +684,13 @@ class HgcrocDigiCollection {
   /** version of the ROC we have read */
   int version_;
 
+  /** decoded samples, built by decoded() and shared by copies */
+  mutable std::shared_ptr<const Decoded> decoded_;  //! not serialized
+
   /**
    * The ROOT class definition.
    */
-  ClassDef(HgcrocDigiCollection, 4);
+  ClassDef(HgcrocDigiCollection, 5);
 };
 }  // namespace ldmx
 
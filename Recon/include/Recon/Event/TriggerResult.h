@@ -63,6 +63,12 @@ class TriggerResult {
    */
   double getAlgoVar(int element) const { return variables_[element]; }
 
+  /**
+   * Return the number of algorithm variables.
+   * @return The number of algorithm variables.
+   */
+  int getNAlgoVars() const { return variables_.GetSize(); }
+
   /**
    * Return algorithm variable 0 (see algorithm code for details).
    * @note Provided for interactive ROOT use.
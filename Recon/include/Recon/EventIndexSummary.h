@@ -0,0 +1,63 @@
+#ifndef RECON_EVENTINDEXSUMMARY_H
+#define RECON_EVENTINDEXSUMMARY_H
+
+//---< Framework >---//
+#include "Framework/Configure/Parameters.h"
+#include "Framework/EventProcessor.h"
+
+namespace recon {
+
+/**
+ * Summarize the event in parameters of its EventHeader
+ *
+ * The pass bits of the triggers, the main variables of the ECal veto and
+ * the number of hits of some collections are set as int or float
+ * parameters of the EventHeader, so they can be copied into the event
+ * index of the output file (see the eventIndex parameters of the
+ * Process). Later processing can then select the events it needs with
+ * the indexSelection parameter without reading the rest of each event.
+ *
+ * The parameters are named after the collections they come from:
+ * \<trigger\>Pass, \<veto\>Pass, \<veto\>Disc, \<veto\>NReadoutHits,
+ * \<veto\>SummedDet and n\<hits\>. Collections missing from an event
+ * are skipped, so the corresponding parameters are not set.
+ */
+class EventIndexSummary : public framework::Producer {
+ public:
+  EventIndexSummary(const std::string &name, framework::Process &process)
+      : framework::Producer(name, process) {}
+
+  /**
+   * Configure the processor using the given user specified parameters.
+   *
+   * @param parameters Set of parameters used to configure this processor.
+   */
+  void configure(framework::config::Parameters &parameters) final override;
+
+  /**
+   * Set the summary parameters of the EventHeader
+   *
+   * @param event The event to summarize.
+   */
+  void produce(framework::Event &event) final override;
+
+ private:
+  /// pass name of the input collections, empty for any
+  std::string inputPassName_;
+
+  /// names of the TriggerResult objects
+  std::vector<std::string> triggerCollections_;
+
+  /// name of the EcalVetoResult object, empty to skip it
+  std::string ecalVetoCollection_;
+
+  /// names of the collections of EcalHit to count
+  std::vector<std::string> ecalHitCollections_;
+
+  /// names of the collections of HcalHit to count
+  std::vector<std::string> hcalHitCollections_;
+};
+
+}  // namespace recon
+
+#endif  // RECON_EVENTINDEXSUMMARY_H
@@ -2,7 +2,8 @@
 #define RECON_OVERLAYPRODUCER_H
 
 //---< C++ StdLib >---//
-#include <map>
+#include <algorithm>
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -15,6 +16,11 @@
 #include "Framework/EventFile.h"
 #include "Framework/EventProcessor.h"
 
+//---< ldmx-sw >---//
+#include "SimCore/Event/SimCalorimeterHit.h"
+#include "SimCore/Event/SimTrackerHit.h"
+#include "Tools/ChannelSlots.h"
+
 namespace recon {
 
 /**
@@ -64,6 +70,44 @@ class OverlayProducer : public framework::Producer {
   void onProcessStart() override;
 
  private:
+  /**
+   * Read the next overlayPoolSize_ events of the overlay file into the pool
+   */
+  void fillPool();
+
+  /// Pileup of a bunch of the time-frame stream
+  struct FrameBunch;
+
+  /**
+   * Draw the pileup events of the next bunch of the time-frame stream
+   *
+   * @param[out] bunch the bunch to fill, its old hits are cleared
+   */
+  void fillBunch(FrameBunch &bunch);
+
+  /**
+   * Slide the time-frame window by a bunch and add its pileup to the output
+   *
+   * @param[in,out] event the event of the frame, its header gets the
+   * in-time pileup and the bunch number
+   * @param[in,out] caloOutput calo hits of the frame, by collection
+   * @param[in,out] trackerOutput tracker hits of the frame, by collection
+   */
+  void overlayTimeFrame(
+      framework::Event &event,
+      std::vector<std::vector<ldmx::SimCalorimeterHit>> &caloOutput,
+      std::vector<std::vector<ldmx::SimTrackerHit>> &trackerOutput);
+
+  /**
+   * Name of the collection written for an input collection
+   *
+   * Premixed and time frames keep the names of the input collections so
+   * that they can be overlaid or digitized like any other sim file.
+   */
+  std::string outputName(const std::string &collName) const {
+    return buildFrames_ || timeFrames_ ? collName : collName + "Overlay";
+  }
+
   /// The parameters used to configure this producer
   framework::config::Parameters params_;
 
@@ -167,6 +211,34 @@ class OverlayProducer : public framework::Producer {
    */
   int nLater_{0};
 
+  /**
+   * Number of pileup events read into memory at the start of the first run,
+   * 0 to read every overlaid event from the file as it is needed
+   */
+  int overlayPoolSize_{0};
+
+  /**
+   * Build premixed frames: no sim event is read, and the pileup of a whole
+   * bunch window is written out with its time offsets under the names of
+   * the input collections, to be overlaid later with premixedFrames_
+   */
+  bool buildFrames_{false};
+
+  /**
+   * The overlay file holds premixed frames: exactly one is overlaid on each
+   * sim event, without further time offsets, and its in-time pileup count
+   * is passed on
+   */
+  bool premixedFrames_{false};
+
+  /**
+   * Make time frames: no sim event is read, each event is the next bunch
+   * crossing of a continuous stream of bunches, overlaid with the pileup of
+   * the bunches around it. The pileup of each bunch is drawn once and kept
+   * while it is in the window of a frame.
+   */
+  bool timeFrames_{false};
+
   /**
    * Local control of processor verbosity
    */
@@ -181,6 +253,137 @@ class OverlayProducer : public framework::Producer {
   int overlayIncidentID_{-1000};
   int overlayTrackID_{-1000};
   int overlayPdgCode_{0};
+
+  /**
+   * An overlay hit that is added as a contrib to the Ecal hit with its ID
+   */
+  struct OverlayContrib {
+    int id;
+    float x, y, z;
+    float edep;
+    float time;
+  };
+
+  /**
+   * Add an overlay Ecal hit as contribs
+   *
+   * A plain pileup hit becomes a single contrib, while a hit of a premixed
+   * frame gives back each of the contribs it was merged from.
+   *
+   * @param[in] hit the overlay hit
+   * @param[in] timeOffset time offset to add to the contribs [ns]
+   * @param[in,out] contribs the contribs to append to
+   */
+  void addContribs(const ldmx::SimCalorimeterHit &hit, float timeOffset,
+                   std::vector<OverlayContrib> &contribs) const;
+
+  /**
+   * Pileup events held in memory, each collection keeping the hits of all of
+   * the events back to back, so overlaying an event is a copy out of flat
+   * arrays instead of a read of the overlay file. The Ecal collections only
+   * keep their hits as the contribs they are added as, with the time of the
+   * hit before any offset.
+   */
+  struct OverlayPool {
+    /// event number in the overlay file of each pool event
+    std::vector<int> eventNumbers;
+    /// in-time pileup of each pool event, only for premixed frames
+    std::vector<int> inTimePU;
+    /// contribs of each calo collection that needs them
+    std::vector<std::vector<OverlayContrib>> contribs;
+    /// hits of each calo collection that doesn't need contribs
+    std::vector<std::vector<ldmx::SimCalorimeterHit>> caloHits;
+    /// first contrib or hit of each event in each calo collection
+    std::vector<std::vector<std::size_t>> caloStart;
+    /// hits of each tracker collection
+    std::vector<std::vector<ldmx::SimTrackerHit>> trackerHits;
+    /// first hit of each event in each tracker collection
+    std::vector<std::vector<std::size_t>> trackerStart;
+
+    /// @return number of events in the pool
+    std::size_t size() const { return eventNumbers.size(); }
+
+    /// @return copy of the hits of a calo collection in a pool event
+    std::vector<ldmx::SimCalorimeterHit> caloHitsOf(std::size_t iColl,
+                                                    std::size_t iEv) const {
+      const auto &start{caloStart[iColl]};
+      return {caloHits[iColl].begin() + start[iEv],
+              caloHits[iColl].begin() + start[iEv + 1]};
+    }
+
+    /// @return copy of the hits of a tracker collection in a pool event
+    std::vector<ldmx::SimTrackerHit> trackerHitsOf(std::size_t iColl,
+                                                   std::size_t iEv) const {
+      const auto &start{trackerStart[iColl]};
+      return {trackerHits[iColl].begin() + start[iEv],
+              trackerHits[iColl].begin() + start[iEv + 1]};
+    }
+  };
+
+  /**
+   * Pileup events read into memory, empty if the file is read as it goes
+   */
+  OverlayPool pool_;
+
+  /**
+   * Pileup of a bunch of the time-frame stream, with the time offset of
+   * each pileup event within its bunch already applied to its hits
+   */
+  struct FrameBunch {
+    /// number of pileup events in the bunch
+    int nEvents{0};
+    /// contribs of each calo collection that needs them
+    std::vector<std::vector<OverlayContrib>> contribs;
+    /// hits of each calo collection that doesn't need contribs
+    std::vector<std::vector<ldmx::SimCalorimeterHit>> caloHits;
+    /// hits of each tracker collection
+    std::vector<std::vector<ldmx::SimTrackerHit>> trackerHits;
+  };
+
+  /**
+   * Bunches in the window of the current time frame, from nEarlier_
+   * bunches before it to nLater_ bunches after it
+   */
+  std::deque<FrameBunch> frameWindow_;
+
+  /**
+   * Number of the bunch of the next time frame in the stream
+   */
+  int frameBunch_{0};
+
+  /**
+   * Pool event to overlay next; the pool wraps around like the file does
+   */
+  std::size_t poolCursor_{0};
+
+  /**
+   * Ecal hits of the sim event, pointing into the event bus
+   */
+  std::vector<const ldmx::SimCalorimeterHit *> ecalSimHits_;
+
+  /**
+   * Ecal hits of the overlay events, in the order they were read
+   */
+  std::vector<OverlayContrib> ecalOverlayContribs_;
+
+  /**
+   * Slot of each Ecal channel in the event, over the layer, module and cell
+   * fields of the EcalID, reused between events
+   */
+  ldmx::ChannelSlots ecalSlots_{23};
+
+  /// index of the sim hit of each slot, -1 if none
+  std::vector<int> slotSimHit_;
+
+  /// index of the first and last overlay contrib of each slot, -1 if none
+  std::vector<int> slotFirstContrib_;
+  std::vector<int> slotLastContrib_;
+
+  /// index of the next overlay contrib with the same ID, -1 at the end
+  std::vector<int> nextContrib_;
+
+  /// slots in increasing ID order
+  std::vector<std::size_t> slotOrder_;
 };
 }  // namespace recon
 
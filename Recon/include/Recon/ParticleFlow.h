@@ -61,6 +61,10 @@ class ParticleFlow : public framework::Producer {
   std::string outputCollName_;
   // configuration
   bool singleParticle_;
+  // largest normalized distance of a track to a linked ecal cluster
+  double tkEcalMatchDist_;
+  // largest normalized distance of an ecal to a linked hcal cluster
+  double ecalHcalMatchDist_;
 };
 }  // namespace recon
 
@@ -0,0 +1,117 @@
+#ifndef RECON_SYNTHETICCALOHITS_H
+#define RECON_SYNTHETICCALOHITS_H
+
+//---< C++ StdLib >---//
+#include <memory>
+#include <string>
+#include <vector>
+
+//---< ROOT >---//
+#include "TRandom2.h"
+
+//---< Framework >---//
+#include "Framework/Configure/Parameters.h"
+#include "Framework/EventProcessor.h"
+
+//---< ldmx-sw >---//
+#include "DetDescr/IDMap.h"
+#include "SimCore/Event/SimCalorimeterHit.h"
+
+namespace recon {
+
+/**
+ * Producer of synthetic calorimeter sim hits at a chosen occupancy
+ *
+ * Each subsystem gets a Poisson number of hits per event in channels drawn
+ * uniformly from its geometry (EcalGeometry, HcalGeometry or the bars of a
+ * trigger scintillator module). The energies follow an exponential spectrum
+ * above a minimum and the times are spread around the in-time bunch and a
+ * number of earlier bunches. Hits falling into the same channel are merged
+ * into contributions of one hit like the simulation does.
+ *
+ * The collections feed the digitization and reconstruction of the
+ * calorimeters without a Geant4 sample, so their time per event can be
+ * measured as a function of the occupancy.
+ */
+class SyntheticCaloHits : public framework::Producer {
+ public:
+  SyntheticCaloHits(const std::string &name, framework::Process &process)
+      : framework::Producer(name, process) {}
+
+  /**
+   * Configure the subsystems to make hits for
+   */
+  void configure(framework::config::Parameters &parameters) override;
+
+  /**
+   * Give the run the name of the detector, there is no simulation to do it
+   */
+  void beforeNewRun(ldmx::RunHeader &header) override;
+
+  /**
+   * Seed the generator and list the channels of the subsystems in the
+   * geometry of the run
+   */
+  void onNewRun(const ldmx::RunHeader &) override;
+
+  /**
+   * Put a collection of hits for each subsystem on the event bus
+   */
+  void produce(framework::Event &event) override;
+
+ private:
+  /// a channel hits are put in
+  struct Channel {
+    /// raw ID of the channel
+    int id;
+    /// position of the center of the channel [mm]
+    float x, y, z;
+  };
+
+  /// configuration and channels of a subsystem
+  struct Subsystem {
+    /// "Ecal", "Hcal" or "TrigScint"
+    std::string detector;
+    /// name of the output collection
+    std::string collection;
+    /// mean number of hits per event
+    double mean_hits;
+    /// mean energy above the minimum [MeV]
+    double mean_energy;
+    /// minimum energy of a hit [MeV]
+    double min_energy;
+    /// mean time of the hits in the in-time bunch [ns]
+    double time_mean;
+    /// width of the times in a bunch [ns]
+    double time_sigma;
+    /// time between bunches [ns]
+    double bunch_spacing;
+    /// number of bunches before the in-time one that hits come from
+    int n_earlier_bunches;
+    /// module of the trigger scintillator
+    int module;
+    /// number of bars of the trigger scintillator module
+    int n_bars;
+    /// channels of the subsystem in the current geometry
+    std::vector<Channel> channels;
+  };
+
+  /// name of the detector the geometry conditions are taken for
+  std::string detector_name_;
+
+  /// subsystems to make hits for
+  std::vector<Subsystem> subsystems_;
+
+  /// factor multiplying the mean number of hits of all subsystems
+  double occupancy_scale_{1.};
+
+  /// random number generator, seeded from the RandomNumberSeedService
+  std::unique_ptr<TRandom2> rndm_;
+
+  /// index of the hit of each channel in the collection being made
+  ldmx::IDMap<ldmx::DetectorID, std::size_t> hit_index_;
+};
+
+}  // namespace recon
+
+#endif  // RECON_SYNTHETICCALOHITS_H
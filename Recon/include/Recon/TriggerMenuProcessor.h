@@ -0,0 +1,102 @@
+/**
+ * @file TriggerMenuProcessor.h
+ * @brief Class that evaluates a menu of ECal layer sum trigger lines in one
+ * pass over the hits
+ */
+
+#ifndef RECON_TRIGGER_TRIGGERMENUPROCESSOR_H_
+#define RECON_TRIGGER_TRIGGERMENUPROCESSOR_H_
+
+// LDMX
+#include "Ecal/Event/EcalHit.h"
+#include "Event/TriggerResult.h"
+#include "Framework/Configure/Parameters.h"
+#include "Framework/EventProcessor.h"
+
+namespace recon {
+
+/**
+ * @class TriggerMenuProcessor
+ * @brief Evaluates many ECal layer sum triggers in one pass over the hits.
+ *
+ * @note
+ * Each line of the menu is a TriggerProcessor layer sum trigger: an energy
+ * sum over a range of layers is compared to a threshold chosen by the
+ * number of electrons. The energy of each layer is summed once per event
+ * and accumulated over the layers, so the sum of any range of layers is a
+ * difference of two entries and a line costs the same whatever its range.
+ *
+ * The decisions are stored in one TriggerResult, which passes if any line
+ * passes. Its algorithm variables are
+ *   0: bitmask of the lines that passed, bit i for line i
+ *   1: number of electrons counted in the event
+ *   2 + 2i: energy sum of line i
+ *   3 + 2i: energy sum cut of line i
+ * The bitmask is exact in the double of the variable for up to 52 lines.
+ */
+class TriggerMenuProcessor : public framework::Producer {
+ public:
+  /**
+   * Class constructor.
+   */
+  TriggerMenuProcessor(const std::string& name, framework::Process& process)
+      : framework::Producer(name, process) {}
+
+  /**
+   * Configure the processor using the given user specified parameters.
+   *
+   * @param parameters Set of parameters used to configure this processor.
+   */
+  void configure(framework::config::Parameters& parameters) override;
+
+  /**
+   * Sum the layer energies and evaluate every line of the menu on them.
+   *
+   * @param event The event to run the trigger menu on.
+   */
+  void produce(framework::Event& event) override;
+
+ private:
+  /// One trigger line of the menu
+  struct Line {
+    /// The energy sum cuts for 1e, 2e, ... [MeV]
+    std::vector<double> thresholds;
+    /// First layer of the sum
+    int startLayer;
+    /// Layer after the last layer of the sum
+    int endLayer;
+    /// Number of electrons assumed, the event count if not positive
+    int nElectrons;
+  };
+
+  /// The maximum number of lines in a menu
+  static constexpr std::size_t MAX_LINES{52};
+
+  /// The number of layers summed over
+  static constexpr int N_LAYERS{100};
+
+  /// The lines of the menu
+  std::vector<Line> lines_;
+
+  /// The Beam energy [MeV]
+  double beamEnergy_;
+
+  /// The name of the menu, stored as the name of the TriggerResult
+  TString menuName_;
+
+  /** The name of the input collection (the Ecal hits). */
+  std::string inputColl_;
+
+  /** The pass name of the input (the Ecal hits). */
+  std::string inputPass_;
+
+  /** The name of the output collection (the trigger decision). */
+  std::string outputColl_;
+
+  /// Energy of each layer and of the layers before it, reused every event
+  std::vector<double> cumulativeE_;
+};
+
+}  // namespace recon
+
+#endif
@@ -58,6 +58,31 @@ class TriggerProcessor : public framework::Producer {
    */
   void produce(framework::Event& event) override;
 
+  /**
+   * Get the energy sum cut for a number of electrons
+   *
+   * There are three scenarios:
+   *  1. No Incoming Electrons - If the electron count is 0 or negative
+   *     (undetermined), then we set the sum-energy cut to zero
+   *     so the event always fails.
+   *  2. Num Electrons Listed in Thresholds - Pull cut from list
+   *  3. More electrons than listed - Set threshold as
+   *      'threshold_for_1e + nExtraElectrons*beamEnergy'
+   *     Note that the "overflow" formula here is too naive.
+   *     It should be a
+   *      fct( nElectrons, 1e_thr, beamE),
+   *     taking how sigma evolves with multiplicity into account.
+   *     a simple scaling might suffice there too assuming
+   *     energy cuts are listed as [ Ecut_1e, Ecut_2e, ... ]
+   *
+   * @param cuts the energy sum cuts for 1e, 2e, ... [MeV]
+   * @param nElectrons number of electrons in the event
+   * @param beamEnergy the beam energy [MeV]
+   * @return the cut on the energy sum [MeV]
+   */
+  static double layerESumCut(const std::vector<double>& cuts, int nElectrons,
+                             double beamEnergy);
+
  private:
   /// The energy sum to make cut on.
   std::vector<double> layerESumCuts_;
@@ -0,0 +1,57 @@
+"""Configuration for EventIndexSummary
+
+Sets the summary of the event in the parameters of its EventHeader, which
+can then be written to the event index of the output file.
+
+Examples
+--------
+    from LDMX.Recon.eventIndexSummary import EventIndexSummary
+    summary = EventIndexSummary()
+    p.sequence.append( summary )
+    p.eventIndex = True
+    p.eventIndexParameters = summary.parameterNames()
+"""
+
+from LDMX.Framework import ldmxcfg
+
+class EventIndexSummary(ldmxcfg.Producer) :
+    """Configuration for the summary of the event in its EventHeader
+
+    Parameters
+    ----------
+    name : str
+        Name of this producer
+
+    Attributes
+    ----------
+    input_pass_name : str
+        Pass name of the input collections, empty for any
+    trigger_collections : list of str
+        Names of the TriggerResult objects, sets <name>Pass
+    ecal_veto_collection : str
+        Name of the EcalVetoResult object (empty to skip it), sets <name>Pass,
+        <name>Disc, <name>NReadoutHits and <name>SummedDet
+    ecal_hit_collections : list of str
+        Names of the EcalHit collections to count, sets n<name>
+    hcal_hit_collections : list of str
+        Names of the HcalHit collections to count, sets n<name>
+    """
+
+    def __init__(self, name = 'eventIndexSummary') :
+        super().__init__(name, 'recon::EventIndexSummary', 'Recon')
+
+        self.input_pass_name = ''
+        self.trigger_collections = ['Trigger']
+        self.ecal_veto_collection = 'EcalVeto'
+        self.ecal_hit_collections = ['EcalRecHits']
+        self.hcal_hit_collections = ['HcalRecHits']
+
+    def parameterNames(self) :
+        """Names of the EventHeader parameters this producer sets"""
+        names = [ c + 'Pass' for c in self.trigger_collections ]
+        if self.ecal_veto_collection :
+            names += [ self.ecal_veto_collection + s
+                       for s in ['Pass', 'Disc', 'NReadoutHits', 'SummedDet'] ]
+        names += [ 'n' + c for c in self.ecal_hit_collections ]
+        names += [ 'n' + c for c in self.hcal_hit_collections ]
+        return names
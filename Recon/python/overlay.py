@@ -40,6 +40,26 @@ nLatererBunchesToSample : int
     while the sim event is always in bunch m = 0. 
 bunchSpacing : float
     The spacing in time between bunches [ns]
+overlayPoolSize : int
+    The number of pileup events read into memory at the start of the first run and then overlaid in turn,
+    wrapping around when they are used up. 0 reads every overlaid event from the file as it is needed.
+    The pool stops filling early if the process is within 10% of its memoryBudget.
+buildPremixedFrames : bool
+    Build premixed frames instead of overlaying: no sim event is read, and each event gets the pileup of a whole
+    bunch window, with the timing model above applied, under the names of the input collections.
+    Run it on empty events (no input files) and keep the output file as the pileup library.
+overlayPremixedFrames : bool
+    The overlay file holds premixed frames: exactly one frame is overlaid on each sim event, without further
+    time offsets or sampling, and its in-time pileup count is copied to the event header.
+    Set overlayPassName to the pass name of the job that built the frames.
+timeFrames : bool
+    Make time frames for trigger-rate studies: no sim event is read, and each event is the next bunch crossing
+    of a continuous stream of bunches, with the pileup of the nEarlierBunchesToSample bunches before it and the
+    nLaterBunchesToSample bunches after it. The pileup of each bunch is drawn once (Poisson if doPoissonIntime)
+    and kept while the window slides over it, so each pileup event is overlaid into every frame it reaches.
+    The output collections keep the names of the input collections, for the digitization to read, and the
+    event header gets the in-time pileup (inTimePU) and the number of the bunch (timeFrameBunch).
+    Run it on empty events (no input files).
 verbosity : int
     Sets the producer specific level of verbosity, up to 3 for the most verbose step-by-step debug printouts.
 
@@ -76,6 +96,10 @@ class OverlayProducer(ldmxcfg.Producer) :
         self.nEarlierBunchesToSample = 0
         self.nLaterBunchesToSample = 0
         self.bunchSpacing = 26.88   # [ns]
+        self.overlayPoolSize = 0
+        self.buildPremixedFrames = False
+        self.overlayPremixedFrames = False
+        self.timeFrames = False
         self.verbosity = 1	
         self.tree_name = 'LDMX_Events'
         self.compressionSetting = 9
@@ -50,6 +50,9 @@ class pfProducer(ldmxcfg.Producer) :
         self.inputTrackCollName = 'PFTracks'
         self.outputCollName     = 'PFCandidates'
         self.singleParticle     = False
+        # largest distances of linked objects, in units of the cluster spreads
+        self.tkEcalMatchDist    = 2.
+        self.ecalHcalMatchDist  = 5.
   
 class pfTruthProducer(ldmxcfg.Producer) :
     """Configuration for track selector for particle reco"""
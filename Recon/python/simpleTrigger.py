@@ -48,5 +48,65 @@ class TriggerProcessor(ldmxcfg.Producer) :
         self.input_pass = ''
         self.trigger_collection = "Trigger"
 
+class TriggerLine :
+    """One line of a TriggerMenuProcessor, a TriggerProcessor layer sum trigger
+
+    Attributes
+    ----------
+    name : str
+        Name of the line, for error messages and bookkeeping
+    thresholds : list of floats
+        The upper limits on the energy sum in MeV, [ my_cut_for_1e, my_cut_for_2e, ... ]
+    start_layer : int
+        First layer used in the energy sum
+    end_layer : int
+        First layer not used in the energy sum
+    n_electrons : int
+        Number of electrons assumed to choose the threshold,
+        the electron count of the event if not positive
+    """
+
+    def __init__(self, name, thresholds, start_layer = 0, end_layer = 20, n_electrons = 0) :
+        self.name = name
+        self.thresholds = thresholds
+        self.start_layer = start_layer
+        self.end_layer = end_layer
+        self.n_electrons = n_electrons
+
+class TriggerMenuProcessor(ldmxcfg.Producer) :
+    """Configuration for a menu of layer sum triggers evaluated in one pass
+
+    The TriggerResult stored passes if any line passes, its algorithm
+    variables are the bitmask of the lines that passed (bit i for line i),
+    the electron count, then the energy sum and cut of each line.
+
+    Attributes
+    ----------
+    lines : list of TriggerLine
+        The lines of the menu, at most 52
+
+    Examples
+    --------
+        from LDMX.Recon.simpleTrigger import TriggerMenuProcessor
+        menu = TriggerMenuProcessor('trigger_scan', 8000.)
+        for cut in [1000., 1500., 2000.] :
+            menu.add_line(f'sum20_{cut:.0f}', [cut])
+        p.sequence.append( menu )
+    """
+
+    def __init__(self, name, beamEnergy) :
+        super().__init__(name,'recon::TriggerMenuProcessor','Recon')
+
+        self.beamEnergy = beamEnergy
+        self.menu_name = name
+        self.lines = []
+        self.input_collection = "EcalRecHits"
+        self.input_pass = ''
+        self.trigger_collection = "TriggerMenu"
+
+    def add_line(self, name, thresholds, start_layer = 0, end_layer = 20, n_electrons = 0) :
+        """Add a line to the menu, see TriggerLine for the arguments"""
+        self.lines.append(TriggerLine(name, thresholds, start_layer, end_layer, n_electrons))
+
 simpleTrigger = TriggerProcessor("simpleTrigger", 8000.)
 
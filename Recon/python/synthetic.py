@@ -0,0 +1,95 @@
+"""Synthetic sim hits at a chosen occupancy for scaling benchmarks"""
+
+from LDMX.Framework.ldmxcfg import Producer
+
+class Occupancy:
+    """Occupancy of the synthetic hits of a subsystem
+
+    Parameters
+    ----------
+    detector : str
+        'Ecal', 'Hcal' or 'TrigScint', the channels are taken from the
+        geometry of the first two and from module and n_bars for the last
+    collection : str
+        Name of the SimCalorimeterHit collection to make
+    mean_hits : float
+        Mean number of hits per event (Poisson)
+    mean_energy : float
+        Mean of the exponential energy spectrum above min_energy [MeV]
+    min_energy : float
+        Minimum energy of a hit [MeV]
+
+    Attributes
+    ----------
+    time_mean : float
+        Mean time of the hits in the in-time bunch [ns]
+    time_sigma : float
+        Width of the times within a bunch [ns]
+    bunch_spacing : float
+        Time between bunches [ns]
+    n_earlier_bunches : int
+        Number of bunches before the in-time one that hits are uniformly
+        spread over, 0 puts all hits in time
+    module : int
+        Module of the trigger scintillator
+    n_bars : int
+        Number of bars of the trigger scintillator module
+    """
+
+    def __init__(self, detector, collection, mean_hits, mean_energy,
+                 min_energy = 0.) :
+        self.detector = detector
+        self.collection = collection
+        self.mean_hits = float(mean_hits)
+        self.mean_energy = float(mean_energy)
+        self.min_energy = float(min_energy)
+        self.time_mean = 0.
+        self.time_sigma = 0.5
+        self.bunch_spacing = 26.9
+        self.n_earlier_bunches = 0
+        self.module = 0
+        self.n_bars = 0
+
+    def ecal(mean_hits = 500., mean_energy = 0.5) :
+        """ECal sim hits of about an electron shower"""
+        return Occupancy('Ecal', 'EcalSimHits', mean_hits, mean_energy, 0.01)
+
+    def hcal(mean_hits = 50., mean_energy = 1.) :
+        """HCal sim hits of a few hadrons"""
+        return Occupancy('Hcal', 'HcalSimHits', mean_hits, mean_energy, 0.01)
+
+    def trigscint(collection, module, mean_hits = 2., mean_energy = 0.8) :
+        """Trigger scintillator sim hits of a few beam electrons"""
+        o = Occupancy('TrigScint', collection, mean_hits, mean_energy, 0.1)
+        o.module = module
+        o.n_bars = 50
+        return o
+
+class SyntheticCaloHits(Producer) :
+    """Make synthetic calorimeter sim hits instead of simulating events
+
+    Parameters
+    ----------
+    subsystems : list of Occupancy
+        Subsystems to make hits for
+
+    Attributes
+    ----------
+    detector_name : str
+        Detector written into the run header when no simulation did, it
+        picks the geometry conditions
+    occupancy_scale : float
+        Factor multiplying the mean number of hits of all subsystems,
+        the variable of a scaling study
+    """
+
+    def __init__(self, subsystems = None, name = 'syntheticCaloHits') :
+        super().__init__(name, 'recon::SyntheticCaloHits', 'Recon')
+        if subsystems is None :
+            subsystems = [Occupancy.ecal(), Occupancy.hcal(),
+                          Occupancy.trigscint('TriggerPad1SimHits', 2),
+                          Occupancy.trigscint('TriggerPad2SimHits', 1),
+                          Occupancy.trigscint('TriggerPad3SimHits', 3)]
+        self.subsystems = subsystems
+        self.detector_name = 'ldmx-det-v14-8gev'
+        self.occupancy_scale = 1.
@@ -20,6 +20,14 @@ void BeamElectronLocator::configure(framework::config::Parameters &parameters) {
   minYmm_ = parameters.getParameter<double>("min_Y_mm");
   maxYmm_ = parameters.getParameter<double>("max_Y_mm");
   verbose_ = parameters.getParameter<bool>("verbose");
+
+  if (not(granularityXmm_ > 0.) or not(granularityYmm_ > 0.)) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The granularity in X and Y needs to be positive.");
+  }
+  barsX_ = std::make_unique<ldmx::BarBins>(granularityXmm_, minXmm_, maxXmm_);
+  barsY_ = std::make_unique<ldmx::BarBins>(granularityYmm_, minYmm_, maxYmm_);
+  found_.setTolerance(tolerance_);
 }
 void BeamElectronLocator::onProcessStart() {
   ldmx_log(debug) << "BeamElectronLocator is using parameters: "
@@ -47,7 +55,7 @@ void BeamElectronLocator::produce(framework::Event &event) {
   }
 
   std::vector<ldmx::BeamElectronTruth> beamElectronInfo;
-  const auto simHits{
+  const auto &simHits{
       event.getCollection<ldmx::SimCalorimeterHit>(inputColl_, inputPassName_)};
 
   if (verbose_) {
@@ -55,67 +63,42 @@ void BeamElectronLocator::produce(framework::Event &event) {
                    << event.getEventNumber() << ".";
   }
 
+  found_.clear();
   for (const auto &simHit : simHits) {
     // check if we already caught this position, else, add it
-    bool isMatched = false;
     std::vector<float> pos = simHit.getPosition();
-    for (auto foundElectrons : beamElectronInfo) {
-      // this check makes it square rather than a dR circle
-      if (fabs(pos[0] - foundElectrons.getX()) < tolerance_ &&
-          fabs(pos[1] - foundElectrons.getY()) < tolerance_) {
-        if (verbose_) {
-          ldmx_log(debug) << "\tHit at (x = " << pos[0] << ", y = " << pos[1]
-                          << " matches electron found at (x = "
-                          << foundElectrons.getX()
-                          << ", y = " << foundElectrons.getY()
-                          << "); skip this simhit";
-        }
-        isMatched = true;
-        break;  // finding a match means Move on
-      }         // if coordinates match something we already found
-    }           // over found electrons
-    if (!isMatched) {
+    // this check makes it square rather than a dR circle
+    if (found_.matches(pos[0], pos[1])) {
       if (verbose_) {
-        ldmx_log(info) << "\tHit at (x = " << pos[0] << ", y = " << pos[1]
-                       << " not formerly matched. Adding to collection.";
+        ldmx_log(debug) << "\tHit at (x = " << pos[0] << ", y = " << pos[1]
+                        << " matches an electron found before; skip this "
+                           "simhit";
       }
-      ldmx::BeamElectronTruth electronInfo;
-      electronInfo.setXYZ(pos[0], pos[1], pos[2]);
-      // find a way to do this later
-      // electronInfo.setThreeMomentum(simHit.getPx(), simHit.getPy(),
-      // simHit.getPz());
+      continue;  // finding a match means Move on
+    }
+    if (verbose_) {
+      ldmx_log(info) << "\tHit at (x = " << pos[0] << ", y = " << pos[1]
+                     << " not formerly matched. Adding to collection.";
+    }
+    found_.add(pos[0], pos[1]);
+    ldmx::BeamElectronTruth electronInfo;
+    electronInfo.setXYZ(pos[0], pos[1], pos[2]);
+    // find a way to do this later
+    // electronInfo.setThreeMomentum(simHit.getPx(), simHit.getPy(),
+    // simHit.getPz());
 
-      electronInfo.setBarX(bin(pos[0], granularityXmm_, minXmm_, maxXmm_));
-      electronInfo.setBarY(bin(pos[1], granularityYmm_, minYmm_, maxYmm_));
-      // set coordinates to bin center
-      electronInfo.setBinnedX(minXmm_ +
-                              (electronInfo.getBarX() + 0.5) * granularityXmm_);
-      electronInfo.setBinnedY(minYmm_ +
-                              (electronInfo.getBarY() + 0.5) * granularityYmm_);
+    electronInfo.setBarX(barsX_->bin(pos[0]));
+    electronInfo.setBarY(barsY_->bin(pos[1]));
+    // set coordinates to bin center
+    electronInfo.setBinnedX(barsX_->center(electronInfo.getBarX()));
+    electronInfo.setBinnedY(barsY_->center(electronInfo.getBarY()));
 
-      beamElectronInfo.push_back(electronInfo);
-    }
+    beamElectronInfo.push_back(electronInfo);
   }  // over simhits in the collection
 
   event.add(outputColl_, beamElectronInfo);
 }
 
-int BeamElectronLocator::bin(float coordinate, double binWidth, double min,
-                             double max) {
-  int n = 0;
-  while (coordinate > min + n * binWidth) {
-    n++;
-    if (min + n * binWidth > max) {
-      // don't go out of bounds, but, still indicate overflow by increasing n
-      // before breaking
-      break;
-    }
-  }
-  // the n we have now is the first bin beyond our coordinate.
-  // better aligned with conventions to return the lower edge.
-  return n - 1;
-}
-
 }  // namespace recon
 
 DECLARE_PRODUCER_NS(recon, BeamElectronLocator)
@@ -0,0 +1,34 @@
+#include "Recon/CaloHitView.h"
+
+namespace recon {
+
+void CaloHitView::fill(const std::vector<const ldmx::CalorimeterHit*>& hits) {
+  resize(hits.size());
+  for (std::size_t i{0}; i < hits.size(); i++) set(i, *hits[i]);
+}
+
+float CaloHitView::sumEnergy() const {
+  float sum{0};
+  for (std::size_t i{0}; i < energy_.size(); i++) sum += energy_[i];
+  return sum;
+}
+
+void CaloHitView::resize(std::size_t n) {
+  id_.resize(n);
+  x_.resize(n);
+  y_.resize(n);
+  z_.resize(n);
+  energy_.resize(n);
+  time_.resize(n);
+}
+
+void CaloHitView::set(std::size_t i, const ldmx::CalorimeterHit& hit) {
+  id_[i] = hit.getID();
+  x_[i] = hit.getXPos();
+  y_[i] = hit.getYPos();
+  z_[i] = hit.getZPos();
+  energy_[i] = hit.getEnergy();
+  time_[i] = hit.getTime();
+}
+
+}  // namespace recon
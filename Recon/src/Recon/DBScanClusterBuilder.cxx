@@ -2,8 +2,12 @@
 // #include "Recon/Event/HgcrocDigiCollection.h"
 #include "Recon/DBScanClusterBuilder.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <iostream>
-#include <set>
+#include <queue>
+#include <unordered_map>
 
 namespace recon {
 
@@ -24,53 +28,177 @@ DBScanClusterBuilder::DBScanClusterBuilder(float minHitEnergy,
   minClusterHitMult_ = minClusterHitMult;
 }
 
+namespace {
+
+/**
+ * The hits binned in a grid, so that the hits close to one of them can be
+ * found without looking at all of them
+ *
+ * The bins are a little wider than the clustering distance in x, y and in z
+ * divided by the bias, so all of the hits closer than the distance to a hit
+ * are in the 27 bins around and including its own. Far away bins can share
+ * a key, which only adds candidates that fail the distance check.
+ */
+class HitGrid {
+ public:
+  HitGrid(const CaloHitView &hits, float dist, float zbias)
+      : width_{1.0001f * dist}, zbias_{zbias}, keys_(hits.size()) {
+    use_grid_ = width_ > 0 && std::isfinite(width_) &&
+                std::isfinite(1.f / zbias_);
+    std::vector<std::array<double, 3> > scaled;
+    for (unsigned int i = 0; i < hits.size(); i++) {
+      scaled.push_back({std::floor(hits.x()[i] / width_),
+                        std::floor(hits.y()[i] / width_),
+                        std::floor(hits.z()[i] / zbias_ / width_)});
+      // if a position can't be binned, all of the hits are compared
+      for (double c : scaled.back()) {
+        if (!(std::fabs(c) < 1e15)) use_grid_ = false;
+      }
+    }
+    sorted_.resize(hits.size());
+    for (unsigned int i = 0; i < hits.size(); i++) {
+      if (use_grid_)
+        bins_.push_back({long(scaled[i][0]), long(scaled[i][1]),
+                         long(scaled[i][2])});
+      else
+        bins_.push_back({0, 0, 0});
+      keys_[i] = key(bins_[i][0], bins_[i][1], bins_[i][2]);
+      sorted_[i] = i;
+    }
+    std::stable_sort(
+        sorted_.begin(), sorted_.end(),
+        [&](unsigned int a, unsigned int b) { return keys_[a] < keys_[b]; });
+    for (unsigned int s = 0; s < sorted_.size(); s++) {
+      auto &range{cells_[keys_[sorted_[s]]]};
+      if (range.second == 0) range.first = s;
+      range.second = s + 1;
+    }
+  }
+
+  /**
+   * Call a function with each hit in the bins around a hit
+   *
+   * @param[in] i index of the hit
+   * @param[in] f callable taking the index of a candidate hit
+   */
+  template <typename F>
+  void forCandidates(unsigned int i, F f) const {
+    const auto &b{bins_[i]};
+    for (long dx = -1; dx <= 1; dx++) {
+      for (long dy = -1; dy <= 1; dy++) {
+        for (long dz = -1; dz <= 1; dz++) {
+          if (!use_grid_ && (dx != 0 || dy != 0 || dz != 0)) continue;
+          auto cell{cells_.find(key(b[0] + dx, b[1] + dy, b[2] + dz))};
+          if (cell == cells_.end()) continue;
+          for (unsigned int s = cell->second.first; s < cell->second.second;
+               s++)
+            f(sorted_[s]);
+        }
+      }
+    }
+  }
+
+ private:
+  static uint64_t key(long bx, long by, long bz) {
+    const uint64_t mask{(uint64_t(1) << 21) - 1};
+    return ((uint64_t(bx) & mask) << 42) | ((uint64_t(by) & mask) << 21) |
+           (uint64_t(bz) & mask);
+  }
+
+  float width_;
+  float zbias_;
+  bool use_grid_;
+  /// bin of each hit in x, y and z
+  std::vector<std::array<long, 3> > bins_;
+  /// key of the bin of each hit
+  std::vector<uint64_t> keys_;
+  /// hit indices sorted by their bin
+  std::vector<unsigned int> sorted_;
+  /// range in sorted_ of the hits in each bin
+  std::unordered_map<uint64_t, std::pair<unsigned int, unsigned int> > cells_;
+};
+
+}  // namespace
+
 std::vector<std::vector<const ldmx::CalorimeterHit *> >
 DBScanClusterBuilder::runDBSCAN(
     const std::vector<const ldmx::CalorimeterHit *> &hits, bool debug = false) {
-  const int n = hits.size();
-  std::vector<std::vector<const ldmx::CalorimeterHit *> > idx_clusters;
-  std::vector<unsigned int> tried;
-  tried.reserve(n);
-  std::vector<unsigned int> used;
-  used.reserve(n);
+  CaloHitView view;
+  view.fill(hits);
+  std::vector<std::vector<const ldmx::CalorimeterHit *> > clusters;
+  for (const auto &indices : runDBSCAN(view, debug)) {
+    clusters.emplace_back();
+    for (unsigned int i : indices) clusters.back().push_back(hits[i]);
+  }
+  return clusters;
+}
+
+std::vector<std::vector<unsigned int> > DBScanClusterBuilder::runDBSCAN(
+    const CaloHitView &hits, bool debug) {
+  const unsigned int n = hits.size();
+  const float *energy{hits.energy()};
+  std::vector<std::vector<unsigned int> > idx_clusters;
+  std::vector<char> tried(n, 0);
+  std::vector<char> used(n, 0);
+  HitGrid grid(hits, clusterHitDist_, clusterZBias_);
+
+  // The neighbors of a cluster are visited in increasing index order while
+  // the neighbors of the visited hits are added, and an added index below
+  // the one being visited is never visited itself. They are kept as a
+  // min-heap of the indices still to visit and a flag of the indices that
+  // were added, which are reset when the cluster is done.
+  std::vector<char> inNeighbors(n, 0);
+  std::vector<unsigned int> added;
+  std::priority_queue<unsigned int, std::vector<unsigned int>,
+                      std::greater<unsigned int> >
+      toVisit;
+
   for (unsigned int i = 0; i < n; i++) {
-    if (isIn(i, tried)) continue;
-    tried.push_back(i);
+    if (tried[i]) continue;
+    tried[i] = 1;
     ldmx_log(debug) << "trying " << i;
-    if (hits[i]->getEnergy() < minHitEnergy_) continue;
-    std::set<unsigned int> neighbors;
+    if (energy[i] < minHitEnergy_) continue;
+    std::vector<unsigned int> neighbors;
     unsigned int nNearby = 1;
     // find neighbors
-    for (unsigned int j = 0; j < n; j++) {
+    grid.forCandidates(i, [&](unsigned int j) {
       if (i != j &&
-          dist(hits[i], hits[j]) < clusterHitDist_) {  // pair-wise distance
-        neighbors.insert(j);
-        if (hits[j]->getEnergy() >= minHitEnergy_) nNearby++;
+          dist(hits, i, j) < clusterHitDist_) {  // pair-wise distance
+        neighbors.push_back(j);
+        if (energy[j] >= minHitEnergy_) nNearby++;
       }
-    }
+    });
     if (nNearby >= minClusterHitMult_) {
-      std::vector<const ldmx::CalorimeterHit *> idx_cluster{
-          hits[i]};  // start a cluster
-      used.push_back(i);
+      std::vector<unsigned int> idx_cluster{i};  // start a cluster
+      used[i] = 1;
       ldmx_log(debug) << "- starting a cluster from " << i;
       for (unsigned int j : neighbors) {
-        if (!isIn(j, tried)) {
-          tried.push_back(j);
+        inNeighbors[j] = 1;
+        added.push_back(j);
+        toVisit.push(j);
+      }
+      while (!toVisit.empty()) {
+        unsigned int j = toVisit.top();
+        toVisit.pop();
+        if (!tried[j]) {
+          tried[j] = 1;
           ldmx_log(debug) << "== tried " << j;
-          std::vector<unsigned int> neighbors2;
-          for (unsigned int k = 0; k < n; k++) {
-            if (dist(hits[k], hits[j]) < clusterHitDist_) {
-              neighbors2.push_back(k);
+          grid.forCandidates(j, [&](unsigned int k) {
+            if (!inNeighbors[k] && dist(hits, k, j) < clusterHitDist_) {
+              inNeighbors[k] = 1;
+              added.push_back(k);
+              if (k > j) toVisit.push(k);
             }
-          }
-          for (unsigned int k : neighbors2) neighbors.insert(k);
+          });
         }
-        if (!isIn(j, used)) {
+        if (!used[j]) {
           ldmx_log(debug) << "== used " << j;
-          used.push_back(j);
-          idx_cluster.push_back(hits[j]);
+          used[j] = 1;
+          idx_cluster.push_back(j);
         }
       }
+      for (unsigned int k : added) inNeighbors[k] = 0;
+      added.clear();
       idx_clusters.push_back(idx_cluster);
     }
   }
@@ -80,72 +208,63 @@ DBScanClusterBuilder::runDBSCAN(
 }
 
 void DBScanClusterBuilder::fillClusterInfoFromHits(
-    ldmx::CaloCluster *cl, std::vector<const ldmx::CalorimeterHit *> hits,
+    ldmx::CaloCluster *cl,
+    const std::vector<const ldmx::CalorimeterHit *> &hits,
     bool logEnergyWeight) {
-  float e(0), x(0), y(0), z(0), xx(0), yy(0), zz(0), n(0);
+  CaloHitView view;
+  view.fill(hits);
+  std::vector<unsigned int> indices(hits.size());
+  for (unsigned int i = 0; i < indices.size(); i++) indices[i] = i;
+  fillClusterInfoFromHits(cl, view, indices, logEnergyWeight);
+}
+
+void DBScanClusterBuilder::fillClusterInfoFromHits(
+    ldmx::CaloCluster *cl, const CaloHitView &hits,
+    const std::vector<unsigned int> &indices, bool logEnergyWeight) {
+  float e(0);
   float w = 1;  // weight
-  float sumw = 0;
+  // the moments of the weighted positions, and of the plain ones for the fits
+  ldmx::ClusterMoments moments, line;
   std::vector<float> raw_xvals{};
   std::vector<float> raw_yvals{};
   std::vector<float> raw_zvals{};
   std::vector<float> raw_evals{};
+  raw_xvals.reserve(indices.size());
+  raw_yvals.reserve(indices.size());
+  raw_zvals.reserve(indices.size());
+  raw_evals.reserve(indices.size());
 
-  for (const ldmx::CalorimeterHit *h : hits) {
-    if (h->getEnergy() < minHitEnergy_) continue;
-    if (logEnergyWeight) w = log(h->getEnergy() - log(minHitEnergy_));
-    e += h->getEnergy();
-    x += w * h->getXPos();
-    y += w * h->getYPos();
-    z += w * h->getZPos();
-    xx += w * h->getXPos() * h->getXPos();
-    yy += w * h->getYPos() * h->getYPos();
-    zz += w * h->getZPos() * h->getZPos();
-    n += 1;
-    sumw += w;
-    raw_xvals.push_back(h->getXPos());
-    raw_yvals.push_back(h->getYPos());
-    raw_zvals.push_back(h->getZPos());
-    raw_evals.push_back(h->getEnergy());
+  for (unsigned int i : indices) {
+    const float x{hits.x()[i]}, y{hits.y()[i]}, z{hits.z()[i]};
+    const float energy{hits.energy()[i]};
+    if (energy < minHitEnergy_) continue;
+    if (logEnergyWeight) w = log(energy - log(minHitEnergy_));
+    e += energy;
+    moments.add(x, y, z, w);
+    if (logEnergyWeight) line.add(x, y, z);
+    raw_xvals.push_back(x);
+    raw_yvals.push_back(y);
+    raw_zvals.push_back(z);
+    raw_evals.push_back(energy);
   }
-  x /= sumw;  // now is <x>
-  y /= sumw;
-  z /= sumw;
-  xx /= sumw;  // now is <x^2>
-  yy /= sumw;
-  zz /= sumw;
-  xx = sqrt(xx - x * x);  // now is sqrt(<x^2>-<x>^2)
-  yy = sqrt(yy - y * y);
-  zz = sqrt(zz - z * z);
+  const ldmx::ClusterMoments &fit{logEnergyWeight ? line : moments};
   cl->setEnergy(e);
-  cl->setNHits(n);
-  cl->setCentroidXYZ(x, y, z);
-  cl->setRMSXYZ(xx, yy, zz);
+  cl->setNHits(moments.size());
+  cl->setCentroidXYZ(moments.centroid(0), moments.centroid(1),
+                     moments.centroid(2));
+  cl->setRMSXYZ(moments.rms(0), moments.rms(1), moments.rms(2));
   cl->setHitValsX(raw_xvals);
   cl->setHitValsY(raw_yvals);
   cl->setHitValsZ(raw_zvals);
   cl->setHitValsE(raw_evals);
 
-  if (raw_xvals.size() > 2) {
-    // skip fits for 'vertical' clusters
-    std::vector<float> sortedZ = raw_zvals;
-    std::sort(sortedZ.begin(), sortedZ.end());
-    if (sortedZ[sortedZ.size() - 1] - sortedZ[0] > 1e3) {
-      for (int i = 0; i < raw_xvals.size(); i++) {  // mean subtract
-        raw_xvals[i] = raw_xvals[i] - x;
-        raw_yvals[i] = raw_yvals[i] - y;
-        raw_zvals[i] = raw_zvals[i] - z;
-      }
-
-      TGraph gxz(raw_zvals.size(), raw_zvals.data(), raw_xvals.data());
-      auto r_xz = gxz.Fit("pol1", "SQ");  // p0 + x*p1
-      cl->setDXDZ(r_xz->Value(1));
-      cl->setEDXDZ(r_xz->ParError(1));
-
-      TGraph gyz(raw_zvals.size(), raw_zvals.data(), raw_yvals.data());
-      auto r_yz = gyz.Fit("pol1", "SQ");  // p0 + x*p1
-      cl->setDYDZ(r_yz->Value(1));
-      cl->setEDYDZ(r_yz->ParError(1));
-    }
+  // skip fits for 'vertical' clusters; the straight line fits of x and y
+  // against z are solved from the moments, as the pol1 fits of the graphs
+  if (fit.size() > 2 and fit.max(2) - fit.min(2) > 1e3) {
+    cl->setDXDZ(fit.slope(0, 2));
+    cl->setEDXDZ(fit.slopeError(0, 2));
+    cl->setDYDZ(fit.slope(1, 2));
+    cl->setEDYDZ(fit.slopeError(1, 2));
   }
   return;
 }
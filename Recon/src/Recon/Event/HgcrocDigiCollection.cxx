@@ -1,9 +1,57 @@
 
 #include "Recon/Event/HgcrocDigiCollection.h"
 
+#include <mutex>
+#include <stdexcept>
+
 ClassImp(ldmx::HgcrocDigiCollection)
 
-    namespace ldmx {
+    namespace {
+  /// one lock for the lazy unpacking and decoding of all collections
+  std::mutex &lazyMutex() {
+    static std::mutex m;
+    return m;
+  }
+
+  /// write a number with seven bits per byte, the high bit marks more bytes
+  void putVarint(std::vector<unsigned char> &out, uint64_t v) {
+    while (v >= 0x80) {
+      out.push_back(static_cast<unsigned char>(v | 0x80));
+      v >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(v));
+  }
+
+  /// the packed bytes don't hold the digis they should
+  [[noreturn]] void corrupt() {
+    throw std::runtime_error("HgcrocDigiCollection: packed digis are corrupt");
+  }
+
+  /// read a number written by putVarint
+  uint64_t getVarint(const unsigned char *&p, const unsigned char *end) {
+    uint64_t v{0};
+    for (int shift{0}; p != end and shift < 64; shift += 7) {
+      unsigned char b{*p++};
+      v |= uint64_t(b & 0x7f) << shift;
+      if (not(b & 0x80)) return v;
+    }
+    corrupt();
+  }
+
+  /// map a signed difference to an unsigned number, small for small values
+  uint64_t zigzag(int64_t d) { return (uint64_t(d) << 1) ^ uint64_t(d >> 63); }
+
+  /// inverse of zigzag
+  int64_t unzigzag(uint64_t z) { return int64_t(z >> 1) ^ -int64_t(z & 1); }
+
+  /// bits of the per-sample header byte of the packed digis
+  const unsigned char FLAGS_MASK = 0x3;
+  const unsigned char HAS_FIRST = 0x4;
+  const unsigned char HAS_SECON = 0x8;
+  const unsigned char HAS_THIRD = 0x10;
+}  // namespace
+
+namespace ldmx {
   HgcrocDigiCollection::Sample::Sample(bool tot_progress, bool tot_complete,
                                        int firstMeas, int seconMeas, int toa,
                                        int version) {
@@ -45,13 +93,20 @@ ClassImp(ldmx::HgcrocDigiCollection)
   void HgcrocDigiCollection::Clear() {
     channelIDs_.clear();
     samples_.clear();
+    packed_.clear();
+    numPackedDigis_ = 0;
+    unpackedIDs_.clear();
+    unpackedSamples_.clear();
+    unpacked_ = false;
+    decoded_.reset();
 
     return;
   }
 
   void HgcrocDigiCollection::Print() const {
     std::cout << "HgcrocDigiCollection { Num Channel IDs: "
-              << channelIDs_.size() << ", Num Samples: " << samples_.size()
+              << getNumDigis() << ", Num Samples: " << words().size()
+              << ", Packed Bytes: " << packed_.size()
               << ", Samples Per Digi: " << numSamplesPerDigi_
               << ", Index for SOI: " << sampleOfInterest_ << "}" << std::endl;
 
@@ -61,8 +116,38 @@ ClassImp(ldmx::HgcrocDigiCollection)
   const HgcrocDigiCollection::HgcrocDigi HgcrocDigiCollection::getDigi(
       unsigned int digiIndex) const {
     return HgcrocDigiCollection::HgcrocDigi(
-        channelIDs_.at(digiIndex),
-        samples_.begin() + digiIndex * getNumSamplesPerDigi(), *this);
+        ids().at(digiIndex),
+        words().begin() + digiIndex * getNumSamplesPerDigi(), *this);
+  }
+
+  const HgcrocDigiCollection::Decoded &HgcrocDigiCollection::decoded() const {
+    // unpacked before taking the lock, which unpacking takes too
+    const std::vector<uint32_t> &samples{words()};
+    // the lock is only held while decoding
+    std::lock_guard<std::mutex> lock(lazyMutex());
+    if (decoded_) return *decoded_;
+
+    auto d{std::make_shared<Decoded>()};
+    d->num_samples = getNumSamplesPerDigi();
+    d->i_soi = getSampleOfInterestIndex();
+    std::size_t n{samples.size()};
+    d->adc_t.resize(n);
+    d->adc_tm1.resize(n);
+    d->tot.resize(n);
+    d->toa.resize(n);
+    d->tot_progress.resize(n);
+    d->tot_complete.resize(n);
+    for (std::size_t i{0}; i < n; i++) {
+      Sample sample(samples[i], version_);
+      d->adc_t[i] = sample.adc_t();
+      d->adc_tm1[i] = sample.adc_tm1();
+      d->tot[i] = sample.tot();
+      d->toa[i] = sample.toa();
+      d->tot_progress[i] = sample.isTOTinProgress();
+      d->tot_complete[i] = sample.isTOTComplete();
+    }
+    decoded_ = d;
+    return *decoded_;
   }
 
   void HgcrocDigiCollection::addDigi(
@@ -76,8 +161,10 @@ ClassImp(ldmx::HgcrocDigiCollection)
       return;
     }
 
+    unpack();
     channelIDs_.push_back(id);
     for (auto const &s : digi) samples_.push_back(s.raw());
+    decoded_.reset();
 
     return;
   }
@@ -93,11 +180,122 @@ ClassImp(ldmx::HgcrocDigiCollection)
       return;
     }
 
+    unpack();
     channelIDs_.push_back(id);
     for (auto const &s : digi) samples_.push_back(s);
+    decoded_.reset();
 
     return;
   }
+
+  uint32_t *HgcrocDigiCollection::addDigi(unsigned int id) {
+    unpack();
+    channelIDs_.push_back(id);
+    decoded_.reset();
+    samples_.resize(samples_.size() + this->getNumSamplesPerDigi(), 0);
+    return samples_.data() + samples_.size() - this->getNumSamplesPerDigi();
+  }
+
+  void HgcrocDigiCollection::reserve(unsigned int n) {
+    unpack();
+    channelIDs_.reserve(n);
+    samples_.reserve(n * this->getNumSamplesPerDigi());
+  }
+
+  void HgcrocDigiCollection::pack() {
+    if (isPacked() or channelIDs_.empty()) return;
+    const unsigned int n_samples{getNumSamplesPerDigi()};
+    std::vector<unsigned char> out;
+    out.reserve(channelIDs_.size() * (2 + 2 * n_samples));
+    uint32_t prev_id{0};
+    for (std::size_t i_digi{0}; i_digi < channelIDs_.size(); i_digi++) {
+      uint32_t id{channelIDs_[i_digi]};
+      putVarint(out, zigzag(int64_t(id) - int64_t(prev_id)));
+      prev_id = id;
+      uint32_t prev_secon{0};
+      for (unsigned int i{0}; i < n_samples; i++) {
+        uint32_t w{samples_[i_digi * n_samples + i]};
+        uint32_t flags{w >> SECONFLAG_POS};
+        uint32_t first{TEN_BIT_MASK & (w >> FIRSTMEAS_POS)};
+        uint32_t secon{TEN_BIT_MASK & (w >> SECONMEAS_POS)};
+        uint32_t third{TEN_BIT_MASK & w};
+        uint64_t dfirst{zigzag(int64_t(first) - int64_t(prev_secon))};
+        out.push_back(static_cast<unsigned char>(
+            flags | (dfirst ? HAS_FIRST : 0) | (secon ? HAS_SECON : 0) |
+            (third ? HAS_THIRD : 0)));
+        if (dfirst) putVarint(out, dfirst);
+        if (secon) putVarint(out, secon);
+        if (third) putVarint(out, third);
+        prev_secon = secon;
+      }
+    }
+    numPackedDigis_ = channelIDs_.size();
+    packed_ = std::move(out);
+    // the decoded samples are still the same
+    std::vector<unsigned int>().swap(channelIDs_);
+    std::vector<uint32_t>().swap(samples_);
+  }
+
+  const std::vector<unsigned int> &HgcrocDigiCollection::ids() const {
+    if (not isPacked()) return channelIDs_;
+    std::lock_guard<std::mutex> lock(lazyMutex());
+    if (not unpacked_) {
+      unpackTo(unpackedIDs_, unpackedSamples_);
+      unpacked_ = true;
+    }
+    return unpackedIDs_;
+  }
+
+  const std::vector<uint32_t> &HgcrocDigiCollection::words() const {
+    if (not isPacked()) return samples_;
+    ids();
+    return unpackedSamples_;
+  }
+
+  void HgcrocDigiCollection::unpack() {
+    if (not isPacked()) return;
+    if (unpacked_) {
+      channelIDs_.swap(unpackedIDs_);
+      samples_.swap(unpackedSamples_);
+    } else {
+      unpackTo(channelIDs_, samples_);
+    }
+    packed_.clear();
+    numPackedDigis_ = 0;
+    unpackedIDs_.clear();
+    unpackedSamples_.clear();
+    unpacked_ = false;
+  }
+
+  void HgcrocDigiCollection::unpackTo(std::vector<unsigned int> &ids,
+                                      std::vector<uint32_t> &samples) const {
+    const unsigned int n_samples{getNumSamplesPerDigi()};
+    ids.resize(numPackedDigis_);
+    samples.resize(std::size_t(numPackedDigis_) * n_samples);
+    const unsigned char *p{packed_.data()};
+    const unsigned char *end{p + packed_.size()};
+    int64_t prev_id{0};
+    for (std::size_t i_digi{0}; i_digi < numPackedDigis_; i_digi++) {
+      prev_id += unzigzag(getVarint(p, end));
+      ids[i_digi] = static_cast<unsigned int>(prev_id);
+      int64_t prev_secon{0};
+      for (unsigned int i{0}; i < n_samples; i++) {
+        if (p == end) corrupt();
+        unsigned char header{*p++};
+        int64_t first{prev_secon}, secon{0}, third{0};
+        if (header & HAS_FIRST) first += unzigzag(getVarint(p, end));
+        if (header & HAS_SECON) secon = getVarint(p, end);
+        if (header & HAS_THIRD) third = getVarint(p, end);
+        samples[i_digi * n_samples + i] =
+            (uint32_t(header & FLAGS_MASK) << SECONFLAG_POS) |
+            ((uint32_t(first) & TEN_BIT_MASK) << FIRSTMEAS_POS) |
+            ((uint32_t(secon) & TEN_BIT_MASK) << SECONMEAS_POS) |
+            (uint32_t(third) & TEN_BIT_MASK);
+        prev_secon = secon;
+      }
+    }
+    if (p != end) corrupt();
+  }
 }  // namespace ldmx
 
 std::ostream &operator<<(std::ostream &s,
@@ -0,0 +1,61 @@
+#include "Recon/EventIndexSummary.h"
+
+#include "Ecal/Event/EcalHit.h"
+#include "Ecal/Event/EcalVetoResult.h"
+#include "Hcal/Event/HcalHit.h"
+#include "Recon/Event/TriggerResult.h"
+
+namespace recon {
+
+void EventIndexSummary::configure(framework::config::Parameters &parameters) {
+  inputPassName_ = parameters.getParameter<std::string>("input_pass_name", "");
+  triggerCollections_ = parameters.getParameter<std::vector<std::string>>(
+      "trigger_collections", {});
+  ecalVetoCollection_ =
+      parameters.getParameter<std::string>("ecal_veto_collection", "");
+  ecalHitCollections_ = parameters.getParameter<std::vector<std::string>>(
+      "ecal_hit_collections", {});
+  hcalHitCollections_ = parameters.getParameter<std::vector<std::string>>(
+      "hcal_hit_collections", {});
+}
+
+void EventIndexSummary::produce(framework::Event &event) {
+  auto &header{event.getEventHeader()};
+
+  for (const auto &name : triggerCollections_) {
+    if (not event.exists(name, inputPassName_)) continue;
+    const auto &trigger{
+        event.getObject<ldmx::TriggerResult>(name, inputPassName_)};
+    header.setIntParameter(name + "Pass", trigger.passed());
+  }
+
+  if (not ecalVetoCollection_.empty() and
+      event.exists(ecalVetoCollection_, inputPassName_)) {
+    const auto &veto{event.getObject<ldmx::EcalVetoResult>(ecalVetoCollection_,
+                                                           inputPassName_)};
+    header.setIntParameter(ecalVetoCollection_ + "Pass", veto.passesVeto());
+    header.setFloatParameter(ecalVetoCollection_ + "Disc", veto.getDisc());
+    header.setIntParameter(ecalVetoCollection_ + "NReadoutHits",
+                           veto.getNReadoutHits());
+    header.setFloatParameter(ecalVetoCollection_ + "SummedDet",
+                             veto.getSummedDet());
+  }
+
+  for (const auto &name : ecalHitCollections_) {
+    if (not event.exists(name, inputPassName_)) continue;
+    header.setIntParameter(
+        "n" + name,
+        event.getCollection<ldmx::EcalHit>(name, inputPassName_).size());
+  }
+
+  for (const auto &name : hcalHitCollections_) {
+    if (not event.exists(name, inputPassName_)) continue;
+    header.setIntParameter(
+        "n" + name,
+        event.getCollection<ldmx::HcalHit>(name, inputPassName_).size());
+  }
+}
+
+}  // namespace recon
+
+DECLARE_PRODUCER_NS(recon, EventIndexSummary)
@@ -29,6 +29,20 @@ void OverlayProducer::configure(framework::config::Parameters &parameters) {
   nEarlier_ = parameters.getParameter<int>("nEarlierBunchesToSample");
   nLater_ = parameters.getParameter<int>("nLaterBunchesToSample");
   bunchSpacing_ = parameters.getParameter<double>("bunchSpacing");
+  overlayPoolSize_ = parameters.getParameter<int>("overlayPoolSize", 0);
+  buildFrames_ = parameters.getParameter<bool>("buildPremixedFrames", false);
+  premixedFrames_ =
+      parameters.getParameter<bool>("overlayPremixedFrames", false);
+  timeFrames_ = parameters.getParameter<bool>("timeFrames", false);
+  if (buildFrames_ && premixedFrames_) {
+    EXCEPTION_RAISE("BadConf",
+                    "Premixed frames can't be built from premixed frames.");
+  }
+  if (timeFrames_ && (buildFrames_ || premixedFrames_)) {
+    EXCEPTION_RAISE("BadConf",
+                    "Time frames are made from plain pileup events, not "
+                    "with premixed frames.");
+  }
   verbosity_ = parameters.getParameter<int>("verbosity");
 
   /// Print the parameters actually set. Helpful in case of typos.
@@ -48,6 +62,10 @@ void OverlayProducer::configure(framework::config::Parameters &parameters) {
                    << "\n\t nEarlierBunchesToSample = " << nEarlier_
                    << "\n\t nLaterBunchesToSample = " << nLater_
                    << "\n\t bunchSpacing = " << bunchSpacing_
+                   << "\n\t overlayPoolSize = " << overlayPoolSize_
+                   << "\n\t buildPremixedFrames = " << buildFrames_
+                   << "\n\t overlayPremixedFrames = " << premixedFrames_
+                   << "\n\t timeFrames = " << timeFrames_
                    << "\n\t doPoissonIntime = " << doPoissonIT_
                    << "\n\t doPoissonOutoftime = " << doPoissonOOT_
                    << "\n\t timeSpread = " << timeSigma_
@@ -67,6 +85,13 @@ void OverlayProducer::onNewRun(const ldmx::RunHeader &) {
   }
 
   int start_event = rndm_->Uniform(20., 1e4);
+  if (pool_.size() > 0) {
+    // the pool was filled by an earlier run, start at a random place in it
+    poolCursor_ = start_event % pool_.size();
+    ldmx_log(info) << "Starting overlay process with pileup event number "
+                   << pool_.eventNumbers[poolCursor_] << " of the pool.";
+    return;
+  }
   // EventFile::skipToEvent handles actual number of events in file
   int evNb = overlayFile_->skipToEvent(start_event);
   if (evNb < 0) {
@@ -75,6 +100,189 @@ void OverlayProducer::onNewRun(const ldmx::RunHeader &) {
   overlayEvent_.getEventHeader().setEventNumber(evNb);
   ldmx_log(info) << "Starting overlay process with pileup event number " << evNb
                  << " (random event number picked was " << start_event << ").";
+  if (overlayPoolSize_ > 0) fillPool();
+}
+
+void OverlayProducer::fillPool() {
+  const std::size_t nCalo{caloCollections_.size()};
+  const std::size_t nTracker{trackerCollections_.size()};
+  pool_.eventNumbers.clear();
+  pool_.inTimePU.clear();
+  pool_.contribs.assign(nCalo, {});
+  pool_.caloHits.assign(nCalo, {});
+  pool_.caloStart.assign(nCalo, {0});
+  pool_.trackerHits.assign(nTracker, {});
+  pool_.trackerStart.assign(nTracker, {0});
+  for (int iEv = 0; iEv < overlayPoolSize_; iEv++) {
+    if (iEv > 0 and getMemoryHeadroom() < 0.1) {
+      ldmx_log(warn) << "Stopped filling the overlay pool at " << iEv
+                     << " events, the job is close to its memory budget.";
+      break;
+    }
+    if (!overlayFile_->nextEvent()) {
+      EXCEPTION_RAISE("BadRead", "Couldn't read overlay event " +
+                                     std::to_string(iEv) + " of the pool.");
+    }
+    pool_.eventNumbers.push_back(
+        overlayEvent_.getEventHeader().getEventNumber());
+    if (premixedFrames_) {
+      pool_.inTimePU.push_back(
+          overlayEvent_.getEventHeader().getIntParameter("inTimePU"));
+    }
+    for (std::size_t iColl = 0; iColl < nCalo; iColl++) {
+      const auto &overlayHits{
+          overlayEvent_.getCollection<ldmx::SimCalorimeterHit>(
+              caloCollections_[iColl], overlayPassName_)};
+      if (strstr(caloCollections_[iColl].c_str(), "Ecal")) {
+        for (const auto &overlayHit : overlayHits)
+          addContribs(overlayHit, 0., pool_.contribs[iColl]);
+        pool_.caloStart[iColl].push_back(pool_.contribs[iColl].size());
+      } else {
+        pool_.caloHits[iColl].insert(pool_.caloHits[iColl].end(),
+                                     overlayHits.begin(), overlayHits.end());
+        pool_.caloStart[iColl].push_back(pool_.caloHits[iColl].size());
+      }
+    }
+    for (std::size_t iColl = 0; iColl < nTracker; iColl++) {
+      const auto &overlayHits{overlayEvent_.getCollection<ldmx::SimTrackerHit>(
+          trackerCollections_[iColl], overlayPassName_)};
+      pool_.trackerHits[iColl].insert(pool_.trackerHits[iColl].end(),
+                                      overlayHits.begin(), overlayHits.end());
+      pool_.trackerStart[iColl].push_back(pool_.trackerHits[iColl].size());
+    }
+  }
+  poolCursor_ = 0;
+  ldmx_log(info) << "Read " << pool_.size()
+                 << " pileup events into the overlay pool.";
+}
+
+void OverlayProducer::fillBunch(FrameBunch &bunch) {
+  const std::size_t nCalo{caloCollections_.size()};
+  const std::size_t nTracker{trackerCollections_.size()};
+  bunch.contribs.resize(nCalo);
+  bunch.caloHits.resize(nCalo);
+  bunch.trackerHits.resize(nTracker);
+  for (auto &contribs : bunch.contribs) contribs.clear();
+  for (auto &hits : bunch.caloHits) hits.clear();
+  for (auto &hits : bunch.trackerHits) hits.clear();
+
+  // there is no sim event, every bunch holds only pileup
+  bunch.nEvents =
+      doPoissonIT_ ? (int)rndm_->Poisson(poissonMu_) : (int)poissonMu_;
+  for (int iEv = 0; iEv < bunch.nEvents; iEv++) {
+    const std::size_t iPool{poolCursor_};
+    const bool fromPool{pool_.size() > 0};
+    if (fromPool) {
+      poolCursor_ = (poolCursor_ + 1) % pool_.size();
+    } else if (!overlayFile_->nextEvent()) {
+      EXCEPTION_RAISE("BadRead", "Couldn't read the next overlay event.");
+    }
+
+    // the time of the event within its bunch, the offset of the bunch is
+    // added for each frame it is in
+    float timeOffset = rndmTime_->Gaus(timeMean_, timeSigma_);
+
+    for (std::size_t iColl = 0; iColl < nCalo; iColl++) {
+      bool needsContribsAdded{
+          strstr(caloCollections_[iColl].c_str(), "Ecal") != nullptr};
+      if (fromPool && needsContribsAdded) {
+        const auto &contribs{pool_.contribs[iColl]};
+        for (std::size_t i{pool_.caloStart[iColl][iPool]};
+             i < pool_.caloStart[iColl][iPool + 1]; i++) {
+          OverlayContrib contrib{contribs[i]};
+          contrib.time += timeOffset;
+          bunch.contribs[iColl].push_back(contrib);
+        }
+        continue;
+      }
+      std::vector<ldmx::SimCalorimeterHit> overlayHits =
+          fromPool ? pool_.caloHitsOf(iColl, iPool)
+                   : overlayEvent_.getCollection<ldmx::SimCalorimeterHit>(
+                         caloCollections_[iColl], overlayPassName_);
+      for (auto &overlayHit : overlayHits) {
+        if (needsContribsAdded) {
+          addContribs(overlayHit, timeOffset, bunch.contribs[iColl]);
+        } else {
+          overlayHit.setTime(overlayHit.getTime() + timeOffset);
+          bunch.caloHits[iColl].push_back(overlayHit);
+        }
+      }
+    }
+    for (std::size_t iColl = 0; iColl < nTracker; iColl++) {
+      std::vector<ldmx::SimTrackerHit> overlayHits =
+          fromPool ? pool_.trackerHitsOf(iColl, iPool)
+                   : overlayEvent_.getCollection<ldmx::SimTrackerHit>(
+                         trackerCollections_[iColl], overlayPassName_);
+      for (auto &overlayHit : overlayHits) {
+        overlayHit.setTime(overlayHit.getTime() + timeOffset);
+        bunch.trackerHits[iColl].push_back(overlayHit);
+      }
+    }
+  }
+}
+
+void OverlayProducer::overlayTimeFrame(
+    framework::Event &event,
+    std::vector<std::vector<ldmx::SimCalorimeterHit>> &caloOutput,
+    std::vector<std::vector<ldmx::SimTrackerHit>> &trackerOutput) {
+  if (frameWindow_.empty()) {
+    // the first frame draws its whole window
+    frameWindow_.resize(nEarlier_ + nLater_ + 1);
+    for (auto &bunch : frameWindow_) fillBunch(bunch);
+  } else {
+    // the earliest bunch leaves the window and a new one enters it, reusing
+    // the memory of the one that left
+    frameWindow_.push_back(std::move(frameWindow_.front()));
+    frameWindow_.pop_front();
+    fillBunch(frameWindow_.back());
+  }
+  event.getEventHeader().setIntParameter("inTimePU",
+                                         frameWindow_[nEarlier_].nEvents);
+  event.getEventHeader().setIntParameter("timeFrameBunch", frameBunch_++);
+
+  for (std::size_t iBunch = 0; iBunch < frameWindow_.size(); iBunch++) {
+    const auto &bunch{frameWindow_[iBunch]};
+    float bunchTimeOffset = bunchSpacing_ * (int(iBunch) - nEarlier_);
+    for (std::size_t iColl = 0; iColl < caloCollections_.size(); iColl++) {
+      for (OverlayContrib contrib : bunch.contribs[iColl]) {
+        contrib.time += bunchTimeOffset;
+        ecalOverlayContribs_.push_back(contrib);
+      }
+      for (ldmx::SimCalorimeterHit hit : bunch.caloHits[iColl]) {
+        hit.setTime(hit.getTime() + bunchTimeOffset);
+        caloOutput[iColl].push_back(std::move(hit));
+      }
+    }
+    for (std::size_t iColl = 0; iColl < trackerCollections_.size(); iColl++) {
+      for (ldmx::SimTrackerHit hit : bunch.trackerHits[iColl]) {
+        hit.setTime(hit.getTime() + bunchTimeOffset);
+        trackerOutput[iColl].push_back(std::move(hit));
+      }
+    }
+  }
+  if (verbosity_ > 2) {
+    ldmx_log(debug) << "time frame of bunch " << frameBunch_ - 1 << " has "
+                    << frameWindow_[nEarlier_].nEvents
+                    << " pileup events in time";
+  }
+}
+
+void OverlayProducer::addContribs(const ldmx::SimCalorimeterHit &hit,
+                                  float timeOffset,
+                                  std::vector<OverlayContrib> &contribs) const {
+  std::vector<float> hitPos = hit.getPosition();
+  if (!premixedFrames_) {
+    contribs.push_back({hit.getID(), hitPos[0], hitPos[1], hitPos[2],
+                        hit.getEdep(), hit.getTime() + timeOffset});
+    return;
+  }
+  // the hits of a frame were merged from the contribs of its pileup events,
+  // which are added back one by one so a frame merges like its events would
+  for (unsigned i = 0; i < hit.getNumberOfContribs(); i++) {
+    auto contrib{hit.getContrib(i)};
+    contribs.push_back({hit.getID(), hitPos[0], hitPos[1], hitPos[2],
+                        contrib.edep, contrib.time + timeOffset});
+  }
 }
 
 void OverlayProducer::produce(framework::Event &event) {
@@ -97,29 +305,40 @@ void OverlayProducer::produce(framework::Event &event) {
   // inner loop, loop over collections, and store them. after all pileup events
   // have been added, the vector of collections is iterated over and added to
   // the event bus.
-  std::map<std::string, std::vector<ldmx::SimCalorimeterHit>> caloCollectionMap;
-  std::map<std::string, std::vector<ldmx::SimTrackerHit>> trackerCollectionMap;
-  std::map<int, ldmx::SimCalorimeterHit> hitMap;
+  std::vector<std::vector<ldmx::SimCalorimeterHit>> caloOutput(
+      caloCollections_.size());
+  std::vector<std::vector<ldmx::SimTrackerHit>> trackerOutput(
+      trackerCollections_.size());
+  // the ecal hits are merged by ID once all the overlay contribs are in
+  ecalSimHits_.clear();
+  ecalOverlayContribs_.clear();
 
   // start by copying over all the collections from the sim event
 
   /* ----------- first do the SimCalorimeterHits ----------- */
 
+  // a premixed frame only holds the pileup, the sim event is added to it
+  // when the frame is overlaid; a time frame has no sim event
+  const bool noSimEvent{buildFrames_ || timeFrames_};
+  const std::size_t nSimCalo{noSimEvent ? 0 : caloCollections_.size()};
+  const std::size_t nSimTracker{noSimEvent ? 0 : trackerCollections_.size()};
+
   // get the calo hits collections that we want to overlay, by looping over
   // the list of collections passed to the producer : caloCollections_
-  for (const auto &collName : caloCollections_) {
+  for (uint iColl = 0; iColl < nSimCalo; iColl++) {
+    const auto &collName{caloCollections_[iColl]};
     // for now, Ecal and only Ecal uses contribs instead of multiple
     // SimHitsCalo per channel, meaning, it requires special treatment
     auto needsContribsAdded{collName.find("Ecal") != std::string::npos ? true
                                                                        : false};
 
     // start out by just copying the sim hits, unaltered.
-    auto simHitsCalo =
+    const auto &simHitsCalo =
         event.getCollection<ldmx::SimCalorimeterHit>(collName, simPassName_);
     // but don't copy ecal hits immediately: for them, wait until overlay
-    // contribs have been added. then add everything through the hitmap
+    // contribs have been added. then merge everything by ID
     if (!needsContribsAdded) {
-      caloCollectionMap[collName + "Overlay"] = simHitsCalo;
+      caloOutput[iColl] = simHitsCalo;
     }
 
     if (verbosity_ > 2) {
@@ -130,14 +349,14 @@ void OverlayProducer::produce(framework::Event &event) {
                     << simHitsCalo.size();
 
     // we don't need to touch the hard process sim hits, really... but we
-    // might need the simhits in the hit map.
+    // might need the simhits when merging.
     if (needsContribsAdded || verbosity_ > 2) {
       for (const ldmx::SimCalorimeterHit &simHit : simHitsCalo) {
         if (verbosity_ > 2) simHit.Print();
 
         if (needsContribsAdded) {
-          // this copies the hit, its ID and its coordinates directly
-          hitMap[simHit.getID()] = simHit;
+          // the hit, its ID and its coordinates are copied when merging
+          ecalSimHits_.push_back(&simHit);
         }
 
       }  // over calo simhit collection
@@ -149,10 +368,11 @@ void OverlayProducer::produce(framework::Event &event) {
 
   // get the SimTrackerHit collections that we want to overlay, by looping
   // over the list of collections passed to the producer : trackerCollections_
-  for (const auto &collName : trackerCollections_) {
-    auto simHitsTracker =
+  for (uint iColl = 0; iColl < nSimTracker; iColl++) {
+    const auto &collName{trackerCollections_[iColl]};
+    const auto &simHitsTracker =
         event.getCollection<ldmx::SimTrackerHit>(collName, simPassName_);
-    trackerCollectionMap[collName + "Overlay"] = simHitsTracker;
+    trackerOutput[iColl] = simHitsTracker;
 
     // the rest is printouts for debugging
     ldmx_log(debug) << "in loop: size of sim hits vector " << collName << " is "
@@ -174,20 +394,31 @@ void OverlayProducer::produce(framework::Event &event) {
   // int simBunch= (int)rndmTime_->Uniform(
   //				   -(nEarlier_+1) , nLater_+1);  // +1 to get
   // inclusive interval
-  int startBunch = -nEarlier_;
-  int endBunch = nLater_;
+  // a premixed frame already holds the pileup of all of the bunches
+  int startBunch = premixedFrames_ ? 0 : -nEarlier_;
+  int endBunch = premixedFrames_ ? 0 : nLater_;
+
+  // a time frame takes the pileup of its window from the stream of bunches,
+  // so there is nothing left to draw for it
+  if (timeFrames_) {
+    overlayTimeFrame(event, caloOutput, trackerOutput);
+    endBunch = startBunch - 1;
+  }
 
   // TODO -- figure out if we should also randomly shift the time of the sim
   // event (likely only needed if time bias gets picked up by BDT or ML by way
   // of pulse behaviour)
   for (int bunchOffset{startBunch}; bunchOffset <= endBunch; bunchOffset++) {
     // sample a poisson distribution, or use mu as fixed number of overlay
-    // events
-    int nEvsOverlay =
-        doPoissonOOT_ ? (int)rndm_->Poisson(poissonMu_) : (int)poissonMu_;
+    // events; only one premixed frame is overlaid
+    int nEvsOverlay{1};
+    if (!premixedFrames_) {
+      nEvsOverlay =
+          doPoissonOOT_ ? (int)rndm_->Poisson(poissonMu_) : (int)poissonMu_;
+    }
 
     // special case: in-time pileup at bunch 0
-    if (bunchOffset == 0) {
+    if (bunchOffset == 0 && !premixedFrames_) {
       if (!doPoissonIT_)
         nEvsOverlay = (int)poissonMu_;          // fix it to the average
       else if (doPoissonIT_ && !doPoissonOOT_)  // then we haven't set this yet
@@ -219,20 +450,40 @@ void OverlayProducer::produce(framework::Event &event) {
        * return false if an error is occurred or if the overlay file is
        * mis-configured.
        */
-      if (!overlayFile_->nextEvent()) {
+      // take the next pool event, or read the next event of the file
+      const std::size_t iPool{poolCursor_};
+      const bool fromPool{pool_.size() > 0};
+      if (fromPool) {
+        poolCursor_ = (poolCursor_ + 1) % pool_.size();
+      } else if (!overlayFile_->nextEvent()) {
         ldmx_log(error) << "At sim event "
                         << event.getEventHeader().getEventNumber()
                         << ": couldn't read next overlay event!";
         return;
       }
 
-      // a pileup event wide time offset to be applied to all its hits.
-      float timeOffset = rndmTime_->Gaus(timeMean_, timeSigma_);
-      timeOffset += bunchTimeOffset;
+      // the frame carries the in-time pileup of the window it was built for
+      if (premixedFrames_) {
+        event.getEventHeader().setIntParameter(
+            "inTimePU",
+            fromPool ? pool_.inTimePU[iPool]
+                     : overlayEvent_.getEventHeader().getIntParameter(
+                           "inTimePU"));
+      }
+
+      // a pileup event wide time offset to be applied to all its hits, the
+      // hits of a frame have theirs already
+      float timeOffset{0.};
+      if (!premixedFrames_) {
+        timeOffset = rndmTime_->Gaus(timeMean_, timeSigma_);
+        timeOffset += bunchTimeOffset;
+      }
 
       if (verbosity_ > 2) {
         ldmx_log(debug) << "in overlay loop: overlaying event "
-                        << overlayEvent_.getEventHeader().getEventNumber()
+                        << (fromPool ? pool_.eventNumbers[iPool]
+                                     : overlayEvent_.getEventHeader()
+                                           .getEventNumber())
                         << "which is " << iEv + 1 << " out of " << nEvsOverlay
                         << "\n\thit time offset is " << timeOffset << " ns"
                         << "\n\tbunch position offset is " << bunchOffset
@@ -249,14 +500,27 @@ void OverlayProducer::produce(framework::Event &event) {
         if (strstr(caloCollections_[iColl].c_str(), "Ecal"))
           needsContribsAdded = true;
 
+        if (fromPool && needsContribsAdded) {
+          // the pool already holds the hits as contribs
+          const auto &contribs{pool_.contribs[iColl]};
+          for (std::size_t i{pool_.caloStart[iColl][iPool]};
+               i < pool_.caloStart[iColl][iPool + 1]; i++) {
+            OverlayContrib contrib{contribs[i]};
+            contrib.time += timeOffset;
+            ecalOverlayContribs_.push_back(contrib);
+          }
+          continue;
+        }
+
         std::vector<ldmx::SimCalorimeterHit> overlayHits =
-            overlayEvent_.getCollection<ldmx::SimCalorimeterHit>(
-                caloCollections_[iColl], overlayPassName_);
+            fromPool ? pool_.caloHitsOf(iColl, iPool)
+                     : overlayEvent_.getCollection<ldmx::SimCalorimeterHit>(
+                           caloCollections_[iColl], overlayPassName_);
 
         ldmx_log(debug) << "in loop: size of overlay hits vector is "
                         << overlayHits.size();
 
-        std::string outCollName = caloCollections_[iColl] + "Overlay";
+        std::string outCollName = outputName(caloCollections_[iColl]);
 
         if (verbosity_ > 2) {
           ldmx_log(debug) << "in loop: printing overlay event: ";
@@ -265,28 +529,14 @@ void OverlayProducer::produce(framework::Event &event) {
         for (ldmx::SimCalorimeterHit &overlayHit : overlayHits) {
           if (verbosity_ > 2) overlayHit.Print();
 
-          const float overlayTime = overlayHit.getTime() + timeOffset;
-          overlayHit.setTime(overlayTime);
-
           if (needsContribsAdded) {  // special treatment for (for now only)
                                      // ecal
-            int overlayHitID = overlayHit.getID();
-            if (hitMap.find(overlayHitID) ==
-                hitMap.end()) {  // there wasn't already a simhit in this id
-              hitMap[overlayHitID] = ldmx::SimCalorimeterHit();
-              hitMap[overlayHitID].setID(overlayHitID);
-              std::vector<float> hitPos = overlayHit.getPosition();
-              hitMap[overlayHitID].setPosition(hitPos[0], hitPos[1], hitPos[2]);
-            }
-            // add the overlay hit (as a) contrib
-            // incidentID = -1000, trackID = -1000, pdgCode = 0  <-- these are
-            // set in the header for now but could be parameters
-            hitMap[overlayHitID].addContrib(overlayIncidentID_, overlayTrackID_,
-                                            overlayPdgCode_,
-                                            overlayHit.getEdep(), overlayTime);
+            // the overlay hit is added (as a) contrib when merging
+            addContribs(overlayHit, timeOffset, ecalOverlayContribs_);
           }  // if add overlay as contribs
           else {
-            caloCollectionMap[outCollName].push_back(overlayHit);
+            overlayHit.setTime(overlayHit.getTime() + timeOffset);
+            caloOutput[iColl].push_back(overlayHit);
             if (verbosity_ > 2)
               ldmx_log(debug) << "Adding non-Ecal overlay hit to outhit vector "
                               << outCollName;
@@ -295,22 +545,24 @@ void OverlayProducer::produce(framework::Event &event) {
 
         if (!needsContribsAdded)
           ldmx_log(debug) << "Nhits in overlay collection " << outCollName
-                          << ": " << caloCollectionMap[outCollName].size();
+                          << ": " << caloOutput[iColl].size();
 
       }  // over caloCollections
 
       /* ----------- now do simtracker hits overlay ----------- */
 
       // get the SimTrackerHit collections that we want to overlay
-      for (const auto &coll : trackerCollections_) {
-        auto overlayTrackerHits{
-            overlayEvent_.getCollection<ldmx::SimTrackerHit>(coll,
-                                                             overlayPassName_)};
+      for (uint iColl = 0; iColl < trackerCollections_.size(); iColl++) {
+        const auto &coll{trackerCollections_[iColl]};
+        std::vector<ldmx::SimTrackerHit> overlayTrackerHits =
+            fromPool ? pool_.trackerHitsOf(iColl, iPool)
+                     : overlayEvent_.getCollection<ldmx::SimTrackerHit>(
+                           coll, overlayPassName_);
 
         ldmx_log(debug) << "in loop: size of overlay hits vector is "
                         << overlayTrackerHits.size();
 
-        auto outCollName{coll + "Overlay"};
+        auto outCollName{outputName(coll)};
 
         if (verbosity_ > 2) {
           ldmx_log(debug) << "in loop: printing overlay event: ";
@@ -319,7 +571,7 @@ void OverlayProducer::produce(framework::Event &event) {
         for (auto &overlayHit : overlayTrackerHits) {
           auto overlayTime{overlayHit.getTime() + timeOffset};
           overlayHit.setTime(overlayTime);
-          trackerCollectionMap[outCollName].push_back(overlayHit);
+          trackerOutput[iColl].push_back(overlayHit);
 
           if (verbosity_ > 2) {
             overlayHit.Print();
@@ -329,61 +581,119 @@ void OverlayProducer::produce(framework::Event &event) {
         }    // over overlay tracker simhit collection
 
         ldmx_log(debug) << "Nhits in overlay collection " << outCollName << ": "
-                        << trackerCollectionMap[outCollName].size();
+                        << trackerOutput[iColl].size();
 
       }  // over trackerCollections
 
     }  // over overlay events
   }    // over bunches
 
-  // after all events are done, the ecal hitmap is final and can be written to
-  // the event output
+  // after all events are done, the ecal hits can be merged by ID and written
+  // to the event output
+  int ecalOutput{-1};
   for (uint iColl = 0; iColl < caloCollections_.size(); iColl++) {
     // loop through collection names to find the right collection name
-    // add overlaid ecal hits as contribs/from hitmap rather than as copied
-    // simhits
+    // add overlaid ecal hits as contribs of the merged hits rather than as
+    // copied simhits
     if (strstr(caloCollections_[iColl].c_str(), "Ecal")) {
       if (verbosity_ > 2)
-        ldmx_log(debug) << "Hits in hitmap after overlay of "
-                        << caloCollections_[iColl] << "Overlay :";
-
-      for (auto &mapHit : hitMap) {
-        if (verbosity_ > 2) mapHit.second.Print();
-
-        if (caloCollectionMap.find(caloCollections_[iColl] + "Overlay") ==
-            caloCollectionMap.end()) {
-          ldmx_log(debug) << "Adding first hit from hit map as first outhit "
-                             "vector to caloCollectionMap";
-          caloCollectionMap[caloCollections_[iColl] + "Overlay"] = {
-              mapHit.second};
-        } else
-          caloCollectionMap[caloCollections_[iColl] + "Overlay"].push_back(
-              mapHit.second);
+        ldmx_log(debug) << "Hits after overlay of " << caloCollections_[iColl]
+                        << "Overlay :";
+
+      // each ID gets a slot the first time it is seen; the sim hit with
+      // that ID is the one the contribs of the slot are added to, and the
+      // contribs of a slot are chained in the order they were read
+      ecalSlots_.clear();
+      slotSimHit_.clear();
+      slotFirstContrib_.clear();
+      slotLastContrib_.clear();
+      auto slotOf = [&](int id) {
+        std::size_t s{ecalSlots_.slot(static_cast<unsigned int>(id))};
+        if (s == slotSimHit_.size()) {
+          slotSimHit_.push_back(-1);
+          slotFirstContrib_.push_back(-1);
+          slotLastContrib_.push_back(-1);
+        }
+        return s;
+      };
+      for (std::size_t i{0}; i < ecalSimHits_.size(); i++)
+        slotSimHit_[slotOf(ecalSimHits_[i]->getID())] = i;
+      nextContrib_.assign(ecalOverlayContribs_.size(), -1);
+      for (std::size_t i{0}; i < ecalOverlayContribs_.size(); i++) {
+        std::size_t s{slotOf(ecalOverlayContribs_[i].id)};
+        if (slotFirstContrib_[s] < 0)
+          slotFirstContrib_[s] = i;
+        else
+          nextContrib_[slotLastContrib_[s]] = i;
+        slotLastContrib_[s] = i;
       }
-      break;  // for now we only have one hitMap: for Ecal. so no need looking
-              // further after we got a match
+      // frames always hold the collection, so each of them can be read back
+      if (noSimEvent) ecalOutput = iColl;
+      if (ecalSlots_.size() == 0) break;
+
+      // write the channels out in increasing ID order
+      slotOrder_.resize(ecalSlots_.size());
+      for (std::size_t s{0}; s < slotOrder_.size(); s++) slotOrder_[s] = s;
+      std::sort(slotOrder_.begin(), slotOrder_.end(),
+                [&](std::size_t lhs, std::size_t rhs) {
+                  return ecalSlots_.id(lhs) < ecalSlots_.id(rhs);
+                });
+
+      auto &outHits{caloOutput[iColl]};
+      outHits.reserve(slotOrder_.size());
+      for (auto s : slotOrder_) {
+        ldmx::SimCalorimeterHit hit;
+        if (slotSimHit_[s] >= 0) {
+          // this copies the hit, its ID and its coordinates directly
+          hit = *ecalSimHits_[slotSimHit_[s]];
+        } else {  // there wasn't a simhit in this id
+          const auto &contrib{ecalOverlayContribs_[slotFirstContrib_[s]]};
+          hit.setID(contrib.id);
+          hit.setPosition(contrib.x, contrib.y, contrib.z);
+        }
+        for (int i{slotFirstContrib_[s]}; i >= 0; i = nextContrib_[i]) {
+          const auto &contrib{ecalOverlayContribs_[i]};
+          // incidentID = -1000, trackID = -1000, pdgCode = 0  <-- these are
+          // set in the header for now but could be parameters
+          hit.addContrib(overlayIncidentID_, overlayTrackID_, overlayPdgCode_,
+                         contrib.edep, contrib.time);
+        }
+        if (verbosity_ > 2) hit.Print();
+        outHits.push_back(std::move(hit));
+      }
+      ecalOutput = iColl;
+      break;  // for now we only merge one set of hits: for Ecal. so no need
+              // looking further after we got a match
     }         // isEcal
-  }           // second loop over collections, to collect hits from hitmap
+  }           // second loop over collections, to collect the merged hits
 
   // done collecting hits.
 
   // this should be added to the sim file, so to "event"
   // once for each hit type
-  for (auto &[name, coll] : caloCollectionMap) {
+  for (uint iColl = 0; iColl < caloCollections_.size(); iColl++) {
+    // the ecal collections are only written once merged
+    if (strstr(caloCollections_[iColl].c_str(), "Ecal") &&
+        int(iColl) != ecalOutput)
+      continue;
+    auto name{outputName(caloCollections_[iColl])};
+    auto &coll{caloOutput[iColl]};
     ldmx_log(debug) << "Writing " << name << " to event bus.";
     if (verbosity_ > 2) {
       ldmx_log(debug) << "List of hits added: ";
       for (auto &hit : coll) hit.Print();
     }
-    event.add(name, coll);
+    event.add(name, std::move(coll));
   }
-  for (auto &[name, coll] : trackerCollectionMap) {
+  for (uint iColl = 0; iColl < trackerCollections_.size(); iColl++) {
+    auto name{outputName(trackerCollections_[iColl])};
+    auto &coll{trackerOutput[iColl]};
     ldmx_log(debug) << "Writing " << name << " to event bus.";
     if (verbosity_ > 2) {
       ldmx_log(debug) << "List of hits added: ";
       for (auto &hit : coll) hit.Print();
     }
-    event.add(name, coll);
+    event.add(name, std::move(coll));
   }
   return;
 }
@@ -1,5 +1,6 @@
 #include "Recon/PFEcalClusterProducer.h"
 
+#include "Recon/CaloHitView.h"
 #include "Recon/DBScanClusterBuilder.h"
 #include "Recon/Event/CaloCluster.h"
 #include "Recon/Event/CalorimeterHit.h"
@@ -21,37 +22,27 @@ void PFEcalClusterProducer::configure(framework::config::Parameters& ps) {
 
 void PFEcalClusterProducer::produce(framework::Event& event) {
   if (!event.exists(hitCollName_)) return;
-  const auto ecalRecHits = event.getCollection<ldmx::EcalHit>(hitCollName_);
-  const auto& geo = getCondition<ldmx::EcalGeometry>(
-      ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME);
+  // the hits are only read through their view, shared with other processors
+  const auto& hitView = CaloHitView::get<ldmx::EcalHit>(event, hitCollName_);
 
-  float eTotal = 0;
-  for (const auto& h : ecalRecHits) eTotal += h.getEnergy();
+  float eTotal = hitView.sumEnergy();
 
   std::vector<ldmx::CaloCluster> pfClusters;
   if (!singleCluster_) {
     DBScanClusterBuilder cb(minHitEnergy_, clusterHitDist_, clusterZBias_,
                             minClusterHitMult_);
-    std::vector<const ldmx::CalorimeterHit*> ptrs;
-    for (const auto& h : ecalRecHits) ptrs.push_back(&h);
-    std::vector<std::vector<const ldmx::CalorimeterHit*> > all_hit_ptrs =
-        cb.runDBSCAN(ptrs, false);
-
-    for (const auto hit_ptrs : all_hit_ptrs) {
+    for (const auto& indices : cb.runDBSCAN(hitView, false)) {
       ldmx::CaloCluster cl;
-      cb.fillClusterInfoFromHits(&cl, hit_ptrs, logEnergyWeight_);
+      cb.fillClusterInfoFromHits(&cl, hitView, indices, logEnergyWeight_);
       pfClusters.push_back(cl);
     }
   } else {  // create a single, large cluster
 
     ldmx::CaloCluster cl;
-    std::vector<const ldmx::CalorimeterHit*> ptrs;
-    ptrs.reserve(ecalRecHits.size());
-    for (const auto& h : ecalRecHits) {
-      ptrs.push_back(&h);
-    }
+    std::vector<unsigned int> indices(hitView.size());
+    for (unsigned int i = 0; i < indices.size(); i++) indices[i] = i;
     DBScanClusterBuilder dummy;
-    dummy.fillClusterInfoFromHits(&cl, ptrs, logEnergyWeight_);
+    dummy.fillClusterInfoFromHits(&cl, hitView, indices, logEnergyWeight_);
     pfClusters.push_back(cl);
   }
 
@@ -2,6 +2,7 @@
 
 #include "Hcal/Event/HcalCluster.h"
 #include "Hcal/Event/HcalHit.h"
+#include "Recon/CaloHitView.h"
 #include "Recon/DBScanClusterBuilder.h"
 #include "Recon/Event/CaloCluster.h"
 #include "Recon/Event/CalorimeterHit.h"
@@ -25,35 +26,27 @@ void PFHcalClusterProducer::configure(framework::config::Parameters& ps) {
 
 void PFHcalClusterProducer::produce(framework::Event& event) {
   if (!event.exists(hitCollName_)) return;
-  const auto hcalRecHits = event.getCollection<ldmx::HcalHit>(hitCollName_);
-  float eTotal = 0;
-  for (const auto& h : hcalRecHits) eTotal += h.getEnergy();
+  // the hits are only read through their view, shared with other processors
+  const auto& hitView = CaloHitView::get<ldmx::HcalHit>(event, hitCollName_);
+  float eTotal = hitView.sumEnergy();
 
   std::vector<ldmx::CaloCluster> pfClusters;
   if (!singleCluster_) {
     // construct DBScan
     DBScanClusterBuilder cb(minHitEnergy_, clusterHitDist_, clusterZBias_,
                             minClusterHitMult_);
-    std::vector<const ldmx::CalorimeterHit*> ptrs;
-    for (const auto& h : hcalRecHits) ptrs.push_back(&h);
-    std::vector<std::vector<const ldmx::CalorimeterHit*> > all_hit_ptrs =
-        cb.runDBSCAN(ptrs, false);
-
-    for (const auto hit_ptrs : all_hit_ptrs) {
+    for (const auto& indices : cb.runDBSCAN(hitView, false)) {
       ldmx::CaloCluster cl;
-      cb.fillClusterInfoFromHits(&cl, hit_ptrs, logEnergyWeight_);
+      cb.fillClusterInfoFromHits(&cl, hitView, indices, logEnergyWeight_);
       pfClusters.push_back(cl);
     }
 
   } else {
     ldmx::CaloCluster cl;
-    std::vector<const ldmx::CalorimeterHit*> ptrs;
-    ptrs.reserve(hcalRecHits.size());
-    for (const auto& h : hcalRecHits) {
-      ptrs.push_back(&h);
-    }
+    std::vector<unsigned int> indices(hitView.size());
+    for (unsigned int i = 0; i < indices.size(); i++) indices[i] = i;
     DBScanClusterBuilder dummy;
-    dummy.fillClusterInfoFromHits(&cl, ptrs, logEnergyWeight_);
+    dummy.fillClusterInfoFromHits(&cl, hitView, indices, logEnergyWeight_);
     pfClusters.push_back(cl);
   }
 
@@ -10,6 +10,14 @@ void PFTruthProducer::configure(framework::config::Parameters &ps) {
   targetCollName_ = ps.getParameter<std::string>("outputTargetCollName");
   ecalCollName_ = ps.getParameter<std::string>("outputEcalCollName");
   hcalCollName_ = ps.getParameter<std::string>("outputHcalCollName");
+
+  declareInput("TargetScoringPlaneHits");
+  declareInput("EcalScoringPlaneHits");
+  declareInput("SimParticles");
+  declareOutput(primaryCollName_);
+  declareOutput(targetCollName_);
+  declareOutput(ecalCollName_);
+  declareOutput(hcalCollName_);
 }
 template <class T>
 void sortHits(std::vector<T> spHits) {
@@ -21,11 +29,11 @@ void PFTruthProducer::produce(framework::Event &event) {
   if (!event.exists("TargetScoringPlaneHits")) return;
   if (!event.exists("EcalScoringPlaneHits")) return;
   if (!event.exists("SimParticles")) return;
-  const auto targSpHits =
+  const auto &targSpHits =
       event.getCollection<ldmx::SimTrackerHit>("TargetScoringPlaneHits");
-  const auto ecalSpHits =
+  const auto &ecalSpHits =
       event.getCollection<ldmx::SimTrackerHit>("EcalScoringPlaneHits");
-  const auto particle_map =
+  const auto &particle_map =
       event.getMap<int, ldmx::SimParticle>("SimParticles");
 
   std::map<int, ldmx::SimParticle> primaries;
@@ -1,9 +1,143 @@
 #include "Recon/ParticleFlow.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <vector>
 
 namespace recon {
 
+namespace {
+
+/**
+ * Boxes in the x-y plane binned on a uniform grid
+ *
+ * Each box is listed in every bin it covers, as (bin, box) pairs sorted by
+ * bin, so the boxes that may overlap a search window are found by looking
+ * up the bins of the window instead of trying all of them. The bins are as
+ * wide as the boxes are on average. Boxes that aren't finite or that cover
+ * too many bins are returned for every window, and so are all of the boxes
+ * for a window that isn't finite or that covers more bins than there are
+ * boxes, so the lookup never misses a box that overlaps the window.
+ */
+class BoxGrid {
+ public:
+  /// add a box, the boxes are numbered in the order they are added
+  void add(double xlo, double xhi, double ylo, double yhi) {
+    boxes_.push_back({xlo, xhi, ylo, yhi});
+  }
+
+  /// bin the boxes added so far
+  void build() {
+    double sum{0.};
+    int n{0};
+    for (const auto& b : boxes_) {
+      if (not finite(b)) continue;
+      sum += (b.xhi - b.xlo) + (b.yhi - b.ylo);
+      n += 2;
+    }
+    bin_ = n > 0 ? std::max(1., sum / n) : 1.;
+    cells_.clear();
+    everywhere_.clear();
+    for (int i{0}; i < boxes_.size(); i++) {
+      const auto& b{boxes_[i]};
+      long ix0, ix1, iy0, iy1;
+      if (not range(b, ix0, ix1, iy0, iy1) or ix1 - ix0 >= MAX_SPAN or
+          iy1 - iy0 >= MAX_SPAN) {
+        everywhere_.push_back(i);
+        continue;
+      }
+      for (long ix{ix0}; ix <= ix1; ix++) {
+        for (long iy{iy0}; iy <= iy1; iy++) cells_.push_back({key(ix, iy), i});
+      }
+    }
+    std::sort(cells_.begin(), cells_.end(),
+              [](const Cell& a, const Cell& b) { return a.key < b.key; });
+  }
+
+  /**
+   * Find the boxes that may overlap a window
+   *
+   * @param[in] xlo,xhi,ylo,yhi the window
+   * @param[out] boxes indices of the boxes, in increasing order
+   */
+  void find(double xlo, double xhi, double ylo, double yhi,
+            std::vector<int>& boxes) const {
+    boxes.clear();
+    long ix0, ix1, iy0, iy1;
+    if (not range({xlo, xhi, ylo, yhi}, ix0, ix1, iy0, iy1) or
+        double(ix1 - ix0 + 1) * double(iy1 - iy0 + 1) > boxes_.size()) {
+      for (int i{0}; i < boxes_.size(); i++) boxes.push_back(i);
+      return;
+    }
+    boxes = everywhere_;
+    for (long ix{ix0}; ix <= ix1; ix++) {
+      for (long iy{iy0}; iy <= iy1; iy++) {
+        Cell c{key(ix, iy), 0};
+        auto cells{std::equal_range(
+            cells_.begin(), cells_.end(), c,
+            [](const Cell& a, const Cell& b) { return a.key < b.key; })};
+        for (auto it{cells.first}; it != cells.second; ++it)
+          boxes.push_back(it->box);
+      }
+    }
+    std::sort(boxes.begin(), boxes.end());
+    boxes.erase(std::unique(boxes.begin(), boxes.end()), boxes.end());
+  }
+
+ private:
+  /// most bins a box can cover along an axis before it is everywhere
+  static const long MAX_SPAN = 16;
+
+  struct Box {
+    double xlo, xhi, ylo, yhi;
+  };
+
+  struct Cell {
+    uint64_t key;
+    int box;
+  };
+
+  static bool finite(const Box& b) {
+    return std::isfinite(b.xlo) and std::isfinite(b.xhi) and
+           std::isfinite(b.ylo) and std::isfinite(b.yhi);
+  }
+
+  static uint64_t key(long ix, long iy) {
+    return (uint64_t(uint32_t(ix)) << 32) | uint32_t(iy);
+  }
+
+  /// bins covered by a box, false if they can't be numbered
+  bool range(const Box& b, long& ix0, long& ix1, long& iy0,
+             long& iy1) const {
+    if (not finite(b)) return false;
+    const double lim{1e9};
+    double lo[2] = {std::floor(b.xlo / bin_), std::floor(b.ylo / bin_)};
+    double hi[2] = {std::floor(b.xhi / bin_), std::floor(b.yhi / bin_)};
+    for (int i{0}; i < 2; i++) {
+      if (not(std::fabs(lo[i]) < lim and std::fabs(hi[i]) < lim)) return false;
+    }
+    ix0 = long(lo[0]);
+    ix1 = long(hi[0]);
+    iy0 = long(lo[1]);
+    iy1 = long(hi[1]);
+    return true;
+  }
+
+  std::vector<Box> boxes_;
+  /// width of the bins
+  double bin_{1.};
+  /// (bin, box) pairs sorted by bin
+  std::vector<Cell> cells_;
+  /// boxes returned for every window
+  std::vector<int> everywhere_;
+};
+
+/// margin added to the windows so rounding can't drop a match [mm]
+const double WINDOW_MARGIN = 1.;
+
+}  // namespace
+
 void ParticleFlow::configure(framework::config::Parameters& ps) {
   // I/O
   inputEcalCollName_ = ps.getParameter<std::string>("inputEcalCollName");
@@ -12,6 +146,8 @@ void ParticleFlow::configure(framework::config::Parameters& ps) {
   outputCollName_ = ps.getParameter<std::string>("outputCollName");
   // Algorithm configuration
   singleParticle_ = ps.getParameter<bool>("singleParticle");
+  tkEcalMatchDist_ = ps.getParameter<double>("tkEcalMatchDist", 2.);
+  ecalHcalMatchDist_ = ps.getParameter<double>("ecalHcalMatchDist", 5.);
 
   // Calibration factors, from jason, temperary
   std::vector<float> em1{250.0,  750.0,  1250.0, 1750.0, 2250.0, 2750.0,
@@ -102,11 +238,11 @@ void ParticleFlow::produce(framework::Event& event) {
   if (!event.exists(inputEcalCollName_)) return;
   if (!event.exists(inputHcalCollName_)) return;
   // get the track and clustering info
-  const auto ecalClusters =
+  const auto& ecalClusters =
       event.getCollection<ldmx::CaloCluster>(inputEcalCollName_);
-  const auto hcalClusters =
+  const auto& hcalClusters =
       event.getCollection<ldmx::CaloCluster>(inputHcalCollName_);
-  const auto tracks =
+  const auto& tracks =
       event.getCollection<ldmx::SimTrackerHit>(inputTrackCollName_);
 
   std::vector<ldmx::PFCandidate> pfCands;
@@ -125,74 +261,121 @@ void ParticleFlow::produce(framework::Event& event) {
     //
     // track-calo linking
     //
-    std::map<int, std::vector<int> > tkCaloMap;
-    std::map<int, std::vector<int> > caloTkMap;
-    std::map<std::pair<int, int>, float> tkEMDist;
-    // std::vector<int> unmatchedTracks;
-    for (int i = 0; i < tracks.size(); i++) {
-      const auto& tk = tracks[i];
-      const std::vector<float> xyz = tk.getPosition();
-      const std::vector<double> pxyz = tk.getMomentum();
-      const float p = sqrt(pow(pxyz[0], 2) + pow(pxyz[1], 2) + pow(pxyz[2], 2));
-      // float bestMatchVal = 9e9;
+    // The links are found through a grid of the clusters, each one covering
+    // the window where a track can be within the matching distance of it,
+    // and are kept as compressed rows: the clusters linked to track i are
+    // tkCaloLinks[tkCaloStart[i]] to tkCaloLinks[tkCaloStart[i + 1] - 1],
+    // by increasing index.
+    std::vector<int> candidates;
+    std::vector<int> tkCaloStart;
+    std::vector<int> tkCaloLinks;
+    {
+      BoxGrid grid;
+      double zmin{0.}, zmax{0.};
       for (int j = 0; j < ecalClusters.size(); j++) {
         const auto& ecal = ecalClusters[j];
-        // Matching logic
-        const float ecalClusZ = ecal.getCentroidZ();
-        const float tkXAtClus =
-            xyz[0] + pxyz[0] / pxyz[2] * (ecalClusZ - xyz[2]);  // extrapolation
-        const float tkYAtClus =
-            xyz[1] + pxyz[1] / pxyz[2] * (ecalClusZ - xyz[2]);
-        float dist = hypot(
-            (tkXAtClus - ecal.getCentroidX()) / std::max(1.0, ecal.getRMSX()),
-            (tkYAtClus - ecal.getCentroidY()) / std::max(1.0, ecal.getRMSY()));
-        tkEMDist[{i, j}] = dist;
-        bool isMatch =
-            (dist < 2) && (ecal.getEnergy() > 0.3 * p &&
-                           ecal.getEnergy() < 2 * p);  // matching criteria *
-        // if (isMatch && dist < bestMatchVal) bestMatchVal = dist;
-        if (isMatch) {
-          if (tkCaloMap.count(i))
-            tkCaloMap[i].push_back(j);
-          else
-            tkCaloMap[i] = {j};
-          if (caloTkMap.count(j))
-            caloTkMap[j].push_back(i);
-          else
-            caloTkMap[j] = {i};
+        // a match needs each of the normalized offsets below the distance
+        double wx = tkEcalMatchDist_ * std::max(1.0, ecal.getRMSX());
+        double wy = tkEcalMatchDist_ * std::max(1.0, ecal.getRMSY());
+        grid.add(ecal.getCentroidX() - wx, ecal.getCentroidX() + wx,
+                 ecal.getCentroidY() - wy, ecal.getCentroidY() + wy);
+        if (j == 0 or ecal.getCentroidZ() < zmin) zmin = ecal.getCentroidZ();
+        if (j == 0 or ecal.getCentroidZ() > zmax) zmax = ecal.getCentroidZ();
+      }
+      grid.build();
+      for (int i = 0; i < tracks.size(); i++) {
+        tkCaloStart.push_back(tkCaloLinks.size());
+        const auto& tk = tracks[i];
+        const std::vector<float> xyz = tk.getPosition();
+        const std::vector<double> pxyz = tk.getMomentum();
+        const float p =
+            sqrt(pow(pxyz[0], 2) + pow(pxyz[1], 2) + pow(pxyz[2], 2));
+        // window swept by the track between the first and last clusters
+        double x0 = xyz[0] + pxyz[0] / pxyz[2] * (zmin - xyz[2]);
+        double x1 = xyz[0] + pxyz[0] / pxyz[2] * (zmax - xyz[2]);
+        double y0 = xyz[1] + pxyz[1] / pxyz[2] * (zmin - xyz[2]);
+        double y1 = xyz[1] + pxyz[1] / pxyz[2] * (zmax - xyz[2]);
+        grid.find(std::min(x0, x1) - WINDOW_MARGIN,
+                  std::max(x0, x1) + WINDOW_MARGIN,
+                  std::min(y0, y1) - WINDOW_MARGIN,
+                  std::max(y0, y1) + WINDOW_MARGIN, candidates);
+        for (int j : candidates) {
+          const auto& ecal = ecalClusters[j];
+          // Matching logic
+          const float ecalClusZ = ecal.getCentroidZ();
+          const float tkXAtClus =
+              xyz[0] +
+              pxyz[0] / pxyz[2] * (ecalClusZ - xyz[2]);  // extrapolation
+          const float tkYAtClus =
+              xyz[1] + pxyz[1] / pxyz[2] * (ecalClusZ - xyz[2]);
+          float dist = hypot(
+              (tkXAtClus - ecal.getCentroidX()) / std::max(1.0, ecal.getRMSX()),
+              (tkYAtClus - ecal.getCentroidY()) /
+                  std::max(1.0, ecal.getRMSY()));
+          bool isMatch = (dist < tkEcalMatchDist_) &&
+                         (ecal.getEnergy() > 0.3 * p &&
+                          ecal.getEnergy() < 2 * p);  // matching criteria *
+          if (isMatch) tkCaloLinks.push_back(j);
         }
       }
+      tkCaloStart.push_back(tkCaloLinks.size());
     }
 
-    // em-hadcalo linking
-    std::map<int, std::vector<int> > emHadCaloMap;
-    std::map<std::pair<int, int>, float> EMHadDist;
-    for (int i = 0; i < ecalClusters.size(); i++) {
-      const auto& ecal = ecalClusters[i];
+    // em-hadcalo linking, through a grid of the hcal clusters in the same
+    // way, the matching distance is normalized by the spreads of both
+    // clusters added in quadrature, which is at most their sum
+    std::vector<int> emHadCaloStart;
+    std::vector<int> emHadCaloLinks;
+    {
+      BoxGrid grid;
+      double zmin{0.}, zmax{0.};
       for (int j = 0; j < hcalClusters.size(); j++) {
         const auto& hcal = hcalClusters[j];
-        // TODO: matching logic
-        const float xAtHClus =
-            ecal.getCentroidX() +
-            ecal.getDXDZ() * (hcal.getCentroidZ() -
-                              ecal.getCentroidZ());  // extrapolated position
-        const float yAtHClus =
-            ecal.getCentroidY() +
-            ecal.getDYDZ() * (hcal.getCentroidZ() - ecal.getCentroidZ());
-        float dist = sqrt(
-            pow(xAtHClus - hcal.getCentroidX(), 2) /
-                std::max(1.0, pow(hcal.getRMSX(), 2) + pow(ecal.getRMSX(), 2)) +
-            pow(yAtHClus - hcal.getCentroidY(), 2) /
-                std::max(1.0, pow(hcal.getRMSY(), 2) + pow(ecal.getRMSY(), 2)));
-        EMHadDist[{i, j}] = dist;
-        bool isMatch = (dist < 5);  // matching criteria, was 2
-        if (isMatch) {
-          if (emHadCaloMap.count(i))
-            emHadCaloMap[i].push_back(j);
-          else
-            emHadCaloMap[i] = {j};
+        double wx = ecalHcalMatchDist_ * std::max(1.0, fabs(hcal.getRMSX()));
+        double wy = ecalHcalMatchDist_ * std::max(1.0, fabs(hcal.getRMSY()));
+        grid.add(hcal.getCentroidX() - wx, hcal.getCentroidX() + wx,
+                 hcal.getCentroidY() - wy, hcal.getCentroidY() + wy);
+        if (j == 0 or hcal.getCentroidZ() < zmin) zmin = hcal.getCentroidZ();
+        if (j == 0 or hcal.getCentroidZ() > zmax) zmax = hcal.getCentroidZ();
+      }
+      grid.build();
+      for (int i = 0; i < ecalClusters.size(); i++) {
+        emHadCaloStart.push_back(emHadCaloLinks.size());
+        const auto& ecal = ecalClusters[i];
+        double x0 = ecal.getCentroidX() +
+                    ecal.getDXDZ() * (zmin - ecal.getCentroidZ());
+        double x1 = ecal.getCentroidX() +
+                    ecal.getDXDZ() * (zmax - ecal.getCentroidZ());
+        double y0 = ecal.getCentroidY() +
+                    ecal.getDYDZ() * (zmin - ecal.getCentroidZ());
+        double y1 = ecal.getCentroidY() +
+                    ecal.getDYDZ() * (zmax - ecal.getCentroidZ());
+        double wx = ecalHcalMatchDist_ * fabs(ecal.getRMSX()) + WINDOW_MARGIN;
+        double wy = ecalHcalMatchDist_ * fabs(ecal.getRMSY()) + WINDOW_MARGIN;
+        grid.find(std::min(x0, x1) - wx, std::max(x0, x1) + wx,
+                  std::min(y0, y1) - wy, std::max(y0, y1) + wy, candidates);
+        for (int j : candidates) {
+          const auto& hcal = hcalClusters[j];
+          // TODO: matching logic
+          const float xAtHClus =
+              ecal.getCentroidX() +
+              ecal.getDXDZ() * (hcal.getCentroidZ() -
+                                ecal.getCentroidZ());  // extrapolated position
+          const float yAtHClus =
+              ecal.getCentroidY() +
+              ecal.getDYDZ() * (hcal.getCentroidZ() - ecal.getCentroidZ());
+          float dist =
+              sqrt(pow(xAtHClus - hcal.getCentroidX(), 2) /
+                       std::max(1.0, pow(hcal.getRMSX(), 2) +
+                                         pow(ecal.getRMSX(), 2)) +
+                   pow(yAtHClus - hcal.getCentroidY(), 2) /
+                       std::max(1.0, pow(hcal.getRMSY(), 2) +
+                                         pow(ecal.getRMSY(), 2)));
+          bool isMatch = (dist < ecalHcalMatchDist_);  // matching criteria
+          if (isMatch) emHadCaloLinks.push_back(j);
         }
       }
+      emHadCaloStart.push_back(emHadCaloLinks.size());
     }
 
     // NOT YET IMPLEMENTED...
@@ -218,15 +401,14 @@ void ParticleFlow::produce(framework::Event& event) {
     std::vector<bool> EMIsTkLinked(ecalClusters.size(), false);
     std::map<int, int> tkEMPairs{};
     for (int i = 0; i < tracks.size(); i++) {
-      if (tkCaloMap.count(i)) {
-        // pick first (highest-energy) unused matching cluster
-        for (int em_idx : tkCaloMap[i]) {
-          if (!EMIsTkLinked[em_idx]) {
-            EMIsTkLinked[em_idx] = true;
-            tkIsEMLinked[i] = true;
-            tkEMPairs[i] = em_idx;
-            break;
-          }
+      // pick first (highest-energy) unused matching cluster
+      for (int k = tkCaloStart[i]; k < tkCaloStart[i + 1]; k++) {
+        int em_idx = tkCaloLinks[k];
+        if (!EMIsTkLinked[em_idx]) {
+          EMIsTkLinked[em_idx] = true;
+          tkIsEMLinked[i] = true;
+          tkEMPairs[i] = em_idx;
+          break;
         }
       }
     }
@@ -236,15 +418,14 @@ void ParticleFlow::produce(framework::Event& event) {
     std::vector<bool> HadIsEMLinked(hcalClusters.size(), false);
     std::map<int, int> EMHadPairs{};
     for (int i = 0; i < ecalClusters.size(); i++) {
-      if (emHadCaloMap.count(i)) {
-        // pick first (highest-energy) unused matching cluster
-        for (int had_idx : emHadCaloMap[i]) {
-          if (!HadIsEMLinked[had_idx]) {
-            HadIsEMLinked[had_idx] = true;
-            EMIsHadLinked[i] = true;
-            EMHadPairs[i] = had_idx;
-            break;
-          }
+      // pick first (highest-energy) unused matching cluster
+      for (int k = emHadCaloStart[i]; k < emHadCaloStart[i + 1]; k++) {
+        int had_idx = emHadCaloLinks[k];
+        if (!HadIsEMLinked[had_idx]) {
+          HadIsEMLinked[had_idx] = true;
+          EMIsHadLinked[i] = true;
+          EMHadPairs[i] = had_idx;
+          break;
         }
       }
     }
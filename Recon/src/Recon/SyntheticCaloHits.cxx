@@ -0,0 +1,126 @@
+#include "Recon/SyntheticCaloHits.h"
+
+#include "DetDescr/EcalGeometry.h"
+#include "DetDescr/HcalGeometry.h"
+#include "DetDescr/TrigScintID.h"
+#include "Framework/RandomNumberSeedService.h"
+
+namespace recon {
+
+void SyntheticCaloHits::configure(framework::config::Parameters &parameters) {
+  detector_name_ = parameters.getParameter<std::string>("detector_name");
+  occupancy_scale_ = parameters.getParameter<double>("occupancy_scale");
+  subsystems_.clear();
+  for (const auto &subsystem :
+       parameters.getParameter<std::vector<framework::config::Parameters>>(
+           "subsystems")) {
+    Subsystem s;
+    s.detector = subsystem.getParameter<std::string>("detector");
+    if (s.detector != "Ecal" and s.detector != "Hcal" and
+        s.detector != "TrigScint") {
+      EXCEPTION_RAISE("InvalidConfig", "Unknown detector '" + s.detector +
+                                           "' to make synthetic hits in.");
+    }
+    s.collection = subsystem.getParameter<std::string>("collection");
+    s.mean_hits = subsystem.getParameter<double>("mean_hits");
+    s.mean_energy = subsystem.getParameter<double>("mean_energy");
+    s.min_energy = subsystem.getParameter<double>("min_energy");
+    s.time_mean = subsystem.getParameter<double>("time_mean");
+    s.time_sigma = subsystem.getParameter<double>("time_sigma");
+    s.bunch_spacing = subsystem.getParameter<double>("bunch_spacing");
+    s.n_earlier_bunches = subsystem.getParameter<int>("n_earlier_bunches");
+    s.module = subsystem.getParameter<int>("module", 0);
+    s.n_bars = subsystem.getParameter<int>("n_bars", 0);
+    subsystems_.push_back(s);
+  }
+}
+
+void SyntheticCaloHits::beforeNewRun(ldmx::RunHeader &header) {
+  if (header.getDetectorName().empty()) header.setDetectorName(detector_name_);
+}
+
+void SyntheticCaloHits::onNewRun(const ldmx::RunHeader &) {
+  if (not rndm_) {
+    const auto &rnss = getCondition<framework::RandomNumberSeedService>(
+        framework::RandomNumberSeedService::CONDITIONS_OBJECT_NAME);
+    rndm_ = std::make_unique<TRandom2>(rnss.getSeed("SyntheticCaloHits"));
+  }
+
+  // the channels are listed once per run so that each hit only has to draw
+  // an index, the geometry could change between runs
+  for (auto &s : subsystems_) {
+    s.channels.clear();
+    if (s.detector == "Ecal") {
+      const auto &geometry = getCondition<ldmx::EcalGeometry>(
+          ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME);
+      s.channels.reserve(geometry.getNumCells());
+      for (int layer{0}; layer < geometry.getNumLayers(); layer++) {
+        for (int module{0}; module < geometry.getNumModulesPerLayer();
+             module++) {
+          for (int cell{0}; cell < geometry.getNumCellsPerModule(); cell++) {
+            ldmx::EcalID id(layer, module, cell);
+            auto [x, y, z] = geometry.getPosition(id);
+            s.channels.push_back({int(id.raw()), float(x), float(y),
+                                  float(z)});
+          }
+        }
+      }
+    } else if (s.detector == "Hcal") {
+      const auto &geometry = getCondition<ldmx::HcalGeometry>(
+          ldmx::HcalGeometry::CONDITIONS_OBJECT_NAME);
+      for (int section{0}; section < geometry.getNumSections(); section++) {
+        for (int layer{1}; layer <= geometry.getNumLayers(section); layer++) {
+          for (int strip{0}; strip < geometry.getNumStrips(section, layer);
+               strip++) {
+            ldmx::HcalID id(section, layer, strip);
+            const auto &center{geometry.getStrip(id).center};
+            s.channels.push_back({int(id.raw()), float(center[0]),
+                                  float(center[1]), float(center[2])});
+          }
+        }
+      }
+    } else {
+      // the trigger scintillators don't have a geometry condition, the
+      // digitization only averages the positions of the hits of a bar
+      for (int bar{0}; bar < s.n_bars; bar++) {
+        ldmx::TrigScintID id(s.module, bar);
+        s.channels.push_back({int(id.raw()), 0.f, 0.f, 0.f});
+      }
+    }
+    if (s.channels.empty()) {
+      EXCEPTION_RAISE("InvalidConfig", "No " + s.detector +
+                                           " channels to put the hits of " +
+                                           s.collection + " in.");
+    }
+  }
+}
+
+void SyntheticCaloHits::produce(framework::Event &event) {
+  for (const auto &s : subsystems_) {
+    int n_hits{rndm_->Poisson(s.mean_hits * occupancy_scale_)};
+    std::vector<ldmx::SimCalorimeterHit> hits;
+    hits.reserve(n_hits);
+    hit_index_.clear();
+    for (int i_hit{0}; i_hit < n_hits; i_hit++) {
+      const auto &channel{
+          s.channels[rndm_->Integer(static_cast<UInt_t>(s.channels.size()))]};
+      double energy{s.min_energy + rndm_->Exp(s.mean_energy)};
+      double time{rndm_->Gaus(s.time_mean, s.time_sigma) -
+                  rndm_->Integer(s.n_earlier_bunches + 1) * s.bunch_spacing};
+
+      ldmx::DetectorID id(channel.id);
+      auto [index, inserted] = hit_index_.emplace(id, hits.size());
+      if (inserted) {
+        auto &hit{hits.emplace_back()};
+        hit.setID(channel.id);
+        hit.setPosition(channel.x, channel.y, channel.z);
+      }
+      hits[*index].addContrib(-1, -1, 0, energy, time);
+    }
+    event.add(s.collection, hits);
+  }
+}
+
+}  // namespace recon
+
+DECLARE_PRODUCER_NS(recon, SyntheticCaloHits)
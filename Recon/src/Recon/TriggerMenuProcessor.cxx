@@ -0,0 +1,106 @@
+
+#include "Recon/TriggerMenuProcessor.h"
+
+#include <cstdint>
+
+#include "DetDescr/EcalID.h"
+#include "Recon/TriggerProcessor.h"
+
+namespace recon {
+
+void TriggerMenuProcessor::configure(
+    framework::config::Parameters& parameters) {
+  beamEnergy_ = parameters.getParameter<double>("beamEnergy");
+  menuName_ = parameters.getParameter<std::string>("menu_name");
+  inputColl_ = parameters.getParameter<std::string>("input_collection");
+  inputPass_ = parameters.getParameter<std::string>("input_pass");
+  outputColl_ = parameters.getParameter<std::string>("trigger_collection");
+
+  lines_.clear();
+  for (const auto& line_parameters :
+       parameters.getParameter<std::vector<framework::config::Parameters>>(
+           "lines")) {
+    Line line;
+    line.thresholds =
+        line_parameters.getParameter<std::vector<double>>("thresholds");
+    line.startLayer = line_parameters.getParameter<int>("start_layer");
+    line.endLayer = line_parameters.getParameter<int>("end_layer");
+    line.nElectrons = line_parameters.getParameter<int>("n_electrons");
+    auto name{line_parameters.getParameter<std::string>("name")};
+    if (line.thresholds.empty()) {
+      EXCEPTION_RAISE("InvalidConfig",
+                      "Trigger line '" + name + "' has no thresholds.");
+    }
+    if (line.startLayer < 0 or line.endLayer < line.startLayer or
+        line.endLayer > N_LAYERS) {
+      EXCEPTION_RAISE("InvalidConfig",
+                      "Trigger line '" + name + "' has layers [" +
+                          std::to_string(line.startLayer) + "," +
+                          std::to_string(line.endLayer) +
+                          ") outside of the ECal layers.");
+    }
+    lines_.push_back(line);
+  }
+
+  if (lines_.size() > MAX_LINES) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The trigger menu has " + std::to_string(lines_.size()) +
+                        " lines, more than the " + std::to_string(MAX_LINES) +
+                        " that fit in its bitmask.");
+  }
+}
+
+void TriggerMenuProcessor::produce(framework::Event& event) {
+  const std::vector<ldmx::EcalHit>& ecalRecHits =
+      event.getCollection<ldmx::EcalHit>(inputColl_, inputPass_);
+
+  // number of electrons in this event
+  const int nElectrons{event.getElectronCount()};
+
+  // cumulativeE_[l] is the energy in the layers before l
+  cumulativeE_.assign(N_LAYERS + 1, 0.);
+  for (const ldmx::EcalHit& hit : ecalRecHits) {
+    ldmx::EcalID id(hit.getID());
+    if (id.layer() < N_LAYERS) cumulativeE_[id.layer() + 1] += hit.getEnergy();
+  }
+  for (int iL = 0; iL < N_LAYERS; ++iL) {
+    cumulativeE_[iL + 1] += cumulativeE_[iL];
+  }
+
+  ldmx::TriggerResult result;
+  result.set(menuName_, false, 2 + 2 * lines_.size());
+
+  std::uint64_t bits{0};
+  for (std::size_t i = 0; i < lines_.size(); ++i) {
+    const Line& line{lines_[i]};
+    // kept in single precision like the sum of the TriggerProcessor
+    float layerSum =
+        cumulativeE_[line.endLayer] - cumulativeE_[line.startLayer];
+    double layerESumCut{TriggerProcessor::layerESumCut(
+        line.thresholds, line.nElectrons > 0 ? line.nElectrons : nElectrons,
+        beamEnergy_)};
+    if (layerSum <= layerESumCut) bits |= std::uint64_t(1) << i;
+    result.setAlgoVar(2 + 2 * i, layerSum);
+    result.setAlgoVar(3 + 2 * i, layerESumCut);
+  }
+
+  bool pass{bits != 0};
+  result.set(menuName_, pass, 2 + 2 * lines_.size());
+  result.setAlgoVar(0, bits);
+  result.setAlgoVar(1, nElectrons);
+
+  ldmx_log(debug) << "Trigger menu " << menuName_ << " passed lines 0x"
+                  << std::hex << bits << std::dec;
+
+  event.add(outputColl_, result);
+
+  // mark the event
+  if (pass)
+    setStorageHint(framework::hint_shouldKeep);
+  else
+    setStorageHint(framework::hint_shouldDrop);
+}
+
+}  // namespace recon
+
+DECLARE_PRODUCER_NS(recon, TriggerMenuProcessor)
@@ -22,36 +22,23 @@ void TriggerProcessor::configure(framework::config::Parameters& parameters) {
   }
 }
 
+double TriggerProcessor::layerESumCut(const std::vector<double>& cuts,
+                                      int nElectrons, double beamEnergy) {
+  if (nElectrons <= 0) return 0.;  // always fail if no electrons
+  if (std::size_t(nElectrons) <= cuts.size()) return cuts.at(nElectrons - 1);
+  return cuts.at(0) + (nElectrons - 1) * beamEnergy;
+}
+
 void TriggerProcessor::produce(framework::Event& event) {
   /** Grab the Ecal hit collection for the given event */
-  const std::vector<ldmx::EcalHit> ecalRecHits =
+  const std::vector<ldmx::EcalHit>& ecalRecHits =
       event.getCollection<ldmx::EcalHit>(inputColl_, inputPass_);
 
   // number of electrons in this event
   const int nElectrons{event.getElectronCount()};
 
-  /**
-   * There are three scenarios:
-   *  1. No Incoming Electrons - If the electron count is 0 or negative
-   *     (undetermined), then we set the sum-energy cut to zero
-   *     so the event always fails.
-   *  2. Num Electrons Listed in Thresholds - Pull cut from list
-   *  3. More electrons than listed - Set threshold as
-   *      'threshold_for_1e + nExtraElectrons*beamEnergy'
-   *     Note that the "overflow" formula here is too naive.
-   *     It should be a
-   *      fct( nElectrons, 1e_thr, beamE),
-   *     taking how sigma evolves with multiplicity into account.
-   *     a simple scaling might suffice there too assuming
-   *     energy cuts are listed as [ Ecut_1e, Ecut_2e, ... ]
-   */
-  double layerESumCut{0.};
-  if (nElectrons <= 0)
-    layerESumCut = 0.;  // always fail if no electrons
-  else if (nElectrons <= layerESumCuts_.size())
-    layerESumCut = layerESumCuts_.at(nElectrons - 1);
-  else
-    layerESumCut = layerESumCuts_.at(0) + (nElectrons - 1) * beamEnergy_;
+  double layerESumCut{
+      TriggerProcessor::layerESumCut(layerESumCuts_, nElectrons, beamEnergy_)};
 
   ldmx_log(debug) << "Got trigger energy cut " << layerESumCut << " for "
                   << nElectrons << " electrons counted in the event.";
@@ -0,0 +1,64 @@
+"""Benchmark the reconstruction on synthetic hits at a chosen occupancy
+
+The sim hits of the ECal, HCal, trigger scintillators and trackers are
+made by SyntheticCaloHits and SyntheticTrackerHits instead of Geant4, with
+their mean numbers multiplied by the occupancy scale. The time each
+digitization and reconstruction step takes per event is written into the
+performance directory of the histogram file (see
+framework::performance::Tracker), so running the config over a range of
+scales shows which steps grow faster than the number of hits.
+
+    for scale in 1 2 4 8 16; do
+      fire occupancy_scaling.py ${scale} [max_events]
+    done
+"""
+
+import sys
+from LDMX.Framework import ldmxcfg
+
+scale = float(sys.argv[1]) if len(sys.argv) > 1 else 1.
+
+p = ldmxcfg.Process('scaling')
+
+p.maxEvents = int(sys.argv[2]) if len(sys.argv) > 2 else 1000
+p.histogramFile = f'occupancy_scaling_{scale:g}.root'
+p.logPerformance = True
+
+# Import the conditions and geometries
+from LDMX.Ecal import ecal_hardcoded_conditions
+from LDMX.Ecal import EcalGeometry
+from LDMX.Hcal import hcal_hardcoded_conditions
+from LDMX.Hcal import HcalGeometry
+from LDMX.Tracking import geo
+EcalGeometry.EcalGeometryProvider.getInstance()
+HcalGeometry.HcalGeometryProvider.getInstance()
+
+from LDMX.Recon import synthetic
+calo_hits = synthetic.SyntheticCaloHits()
+calo_hits.occupancy_scale = scale
+
+from LDMX.Tracking import tracking
+tagger_hits = tracking.SyntheticTrackerHits.tagger()
+tagger_hits.occupancy_scale = scale
+recoil_hits = tracking.SyntheticTrackerHits.recoil()
+recoil_hits.occupancy_scale = scale
+
+digi_tagger = tracking.DigitizationProcessor('digiTagger')
+digi_tagger.hit_collection = 'TaggerSimHits'
+digi_tagger.out_collection = 'DigiTaggerSimHits'
+digi_recoil = tracking.DigitizationProcessor('digiRecoil')
+digi_recoil.hit_collection = 'RecoilSimHits'
+digi_recoil.out_collection = 'DigiRecoilSimHits'
+
+from LDMX.Ecal import digi as ecal_digi
+from LDMX.Hcal import digi as hcal_digi
+from LDMX.TrigScint.trigScint import TrigScintDigiProducer
+
+p.sequence = [
+    calo_hits, tagger_hits, recoil_hits,
+    ecal_digi.EcalDigiProducer(), ecal_digi.EcalRecProducer(),
+    hcal_digi.HcalDigiProducer(), hcal_digi.HcalRecProducer(),
+    TrigScintDigiProducer.pad1(), TrigScintDigiProducer.pad2(),
+    TrigScintDigiProducer.pad3(),
+    digi_tagger, digi_recoil,
+    ]
@@ -0,0 +1,52 @@
+"""Estimate trigger rates on a continuous stream of bunch crossings
+
+Each event is a time frame of the OverlayProducer: the next bunch crossing
+of a stream of bunches, with the pileup of the bunches around it overlaid.
+The pileup of a bunch is drawn once and kept while the window slides over
+it, so the cost grows with the number of bunches and not with the number
+of bunches times the window. The frames are digitized and go through the
+ECal trigger primitives, the trigger energy sums and the TriggerProcessor;
+the fraction of frames passing times the bunch rate (37.2 MHz) is the
+trigger rate.
+
+    fire trigger_rate_frames.py pileup.root [n_bunches]
+"""
+
+import sys
+from LDMX.Framework import ldmxcfg
+
+p = ldmxcfg.Process('frames')
+
+p.maxEvents = int(sys.argv[2]) if len(sys.argv) > 2 else 10000
+p.outputFiles = ['trigger_rate_frames.root']
+
+# Import the conditions and geometries
+from LDMX.Ecal import ecal_hardcoded_conditions
+from LDMX.Ecal import EcalGeometry
+EcalGeometry.EcalGeometryProvider.getInstance()
+
+from LDMX.Recon.overlay import OverlayProducer
+frames = OverlayProducer(sys.argv[1], 'timeFrames')
+frames.timeFrames = True
+frames.overlayCaloHitCollections = ['EcalSimHits']
+frames.overlayTrackerHitCollections = []
+frames.totalNumberOfInteractions = 1.
+frames.doPoissonIntime = True
+frames.timeSpread = 0.
+frames.nEarlierBunchesToSample = 2
+frames.nLaterBunchesToSample = 2
+frames.bunchSpacing = 1000./37.2   # [ns]
+frames.overlayPoolSize = 10000
+
+from LDMX.Ecal import digi as ecal_digi
+from LDMX.Ecal import ecal_trig_digi
+from LDMX.Trigger import trigger_energy_sums
+from LDMX.Recon.simpleTrigger import TriggerProcessor
+
+p.sequence = [
+    frames,
+    ecal_digi.EcalDigiProducer(), ecal_digi.EcalRecProducer(),
+    ecal_trig_digi.EcalTrigPrimDigiProducer(),
+    trigger_energy_sums.TrigEcalEnergySum(),
+    TriggerProcessor('trigger', 8000.),
+    ]
@@ -50,6 +50,10 @@ class DetectorConstruction : public G4VUserDetectorConstruction {
 
   /**
    * Construct the detector.
+   *
+   * The production cuts and the kinetic energy below which tracks are
+   * killed are set for the regions listed in the region_cuts.
+   *
    * @return The top volume of the detector.
    */
   G4VPhysicalVolume *Construct();
@@ -62,7 +66,7 @@ class DetectorConstruction : public G4VUserDetectorConstruction {
    * @return The name of this detector. This is extracted from the
    *	description file used to build this detector.
    */
-  std::string getDetectorName() { return parser_->getDetectorName(); }
+  std::string getDetectorName() const { return parser_->getDetectorName(); }
 
  private:
   /// The parser used to load the detector into memory.
@@ -117,6 +117,24 @@ class SimCalorimeterHit {
    */
   std::vector<float> getPosition() const { return {x_, y_, z_}; }
 
+  /**
+   * Get the X position of the hit [mm].
+   * @return The X position, without making a vector as getPosition does.
+   */
+  float getX() const { return x_; }
+
+  /**
+   * Get the Y position of the hit [mm].
+   * @return The Y position, without making a vector as getPosition does.
+   */
+  float getY() const { return y_; }
+
+  /**
+   * Get the Z position of the hit [mm].
+   * @return The Z position, without making a vector as getPosition does.
+   */
+  float getZ() const { return z_; }
+
   /**
    * Get the XYZ pre-step position of the hit in the coordinate frame of the
    * sensitive volume [mm].
@@ -230,6 +248,19 @@ class SimCalorimeterHit {
    */
   unsigned getNumberOfContribs() const { return nContribs_; }
 
+  /**
+   * Get the memory held by this hit, including its contributions.
+   * @return The size of the hit [bytes].
+   */
+  std::size_t byteSize() const {
+    return sizeof(*this) +
+           (trackIDContribs_.capacity() + incidentIDContribs_.capacity() +
+            pdgCodeContribs_.capacity()) *
+               sizeof(int) +
+           (edepContribs_.capacity() + timeContribs_.capacity()) *
+               sizeof(float);
+  }
+
   /**
    * Add a hit contribution from a SimParticle.
    * @param incidentID the Geant4 track ID for the particle's parent incident on
@@ -242,6 +273,12 @@ class SimCalorimeterHit {
   void addContrib(int incidentID, int trackID, int pdgCode, float edep,
                   float time);
 
+  /**
+   * Reserve the memory for a number of hit contributions.
+   * @param n The number of contributions the hit will have.
+   */
+  void reserveContribs(unsigned n);
+
   /**
    * Get a hit contribution by index.
    * @param i The index of the hit contribution.
@@ -274,6 +311,9 @@ class SimCalorimeterHit {
   }
 
  private:
+  /// moves the contributions in and out of the hits it packs
+  friend class SimCalorimeterHitCollection;
+
   /**
    * Member variables used in all calorimeter types
    */
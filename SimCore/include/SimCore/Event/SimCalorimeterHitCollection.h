@@ -0,0 +1,191 @@
+/**
+ * @file SimCalorimeterHitCollection.h
+ * @brief Collection of simulated calorimeter hits with packed contributions
+ */
+
+#ifndef SIMCORE_EVENT_SIMCALORIMETERHITCOLLECTION_H_
+#define SIMCORE_EVENT_SIMCALORIMETERHITCOLLECTION_H_
+
+// ROOT
+#include "TObject.h"  //For ClassDef
+
+// STL
+#include <vector>
+
+// LDMX
+#include "SimCore/Event/SimCalorimeterHit.h"
+
+namespace ldmx {
+
+/**
+ * @class SimCalorimeterHitCollection
+ * @brief Simulated calorimeter hits with their contributions in shared lists
+ *
+ * A std::vector<SimCalorimeterHit> keeps five lists of contributions in
+ * each hit, so a collection of N hits makes 5N allocations when it is
+ * filled and again when it is read from a file. This collection keeps the
+ * hits without their contributions and the contributions of all of the
+ * hits in five lists shared by the collection, the contributions of hit i
+ * being those from firstContrib_[i] to firstContrib_[i+1].
+ *
+ * The contributions of a hit are read in place with getNumberOfContribs
+ * and getContrib, and at and unpack rebuild the SimCalorimeterHit objects
+ * for code that needs them.
+ *
+ *  for (std::size_t i{0}; i < hits.size(); i++) {
+ *    const auto& hit{hits.getHit(i)};  // no contributions
+ *    for (unsigned j{0}; j < hits.getNumberOfContribs(i); j++) {
+ *      auto contrib{hits.getContrib(i, j)};
+ *    }
+ *  }
+ */
+class SimCalorimeterHitCollection {
+ public:
+  /// Contribution to a hit
+  using Contrib = SimCalorimeterHit::Contrib;
+
+  /**
+   * Class constructor.
+   */
+  SimCalorimeterHitCollection() = default;
+
+  /**
+   * Pack a list of hits
+   *
+   * @param[in] hits the hits to pack, their contributions are moved out
+   */
+  explicit SimCalorimeterHitCollection(std::vector<SimCalorimeterHit> hits);
+
+  /**
+   * Class destructor.
+   */
+  virtual ~SimCalorimeterHitCollection() = default;
+
+  /**
+   * Clear the hits and contributions in the collection.
+   */
+  void Clear();
+
+  /**
+   * Print out the collection.
+   */
+  void Print() const;
+
+  /**
+   * Reserve the memory for a number of hits and contributions.
+   * @param n_hits The number of hits the collection will have.
+   * @param n_contribs The number of contributions of all the hits.
+   */
+  void reserve(std::size_t n_hits, std::size_t n_contribs);
+
+  /**
+   * Add a hit with its contributions to the end of the collection.
+   * @param hit The hit to add, its contributions are moved out.
+   */
+  void push_back(SimCalorimeterHit hit);
+
+  /**
+   * Add a contribution to the last hit added
+   *
+   * Unlike SimCalorimeterHit::addContrib, the energy and time of the hit
+   * are not updated, they are expected to already be set.
+   *
+   * @param contrib The contribution to add.
+   */
+  void addContrib(const Contrib &contrib);
+
+  /**
+   * Get the number of hits.
+   * @return The number of hits in the collection.
+   */
+  std::size_t size() const { return hits_.size(); }
+
+  /**
+   * Check if there are no hits.
+   * @return true if the collection is empty.
+   */
+  bool empty() const { return hits_.empty(); }
+
+  /**
+   * Get a hit without its contributions.
+   * @param i The index of the hit.
+   * @return The hit at the index, with no contributions.
+   */
+  const SimCalorimeterHit &getHit(std::size_t i) const { return hits_.at(i); }
+
+  /**
+   * Get the number of contributions of a hit.
+   * @param i The index of the hit.
+   * @return The number of contributions to the hit.
+   */
+  unsigned getNumberOfContribs(std::size_t i) const {
+    return firstContrib_.at(i + 1) - firstContrib_.at(i);
+  }
+
+  /**
+   * Get a contribution of a hit.
+   * @param i The index of the hit.
+   * @param j The index of the contribution in the hit.
+   * @return The contribution.
+   */
+  Contrib getContrib(std::size_t i, unsigned j) const;
+
+  /**
+   * Get a hit with its contributions.
+   * @param i The index of the hit.
+   * @return A copy of the hit at the index, with its contributions.
+   */
+  SimCalorimeterHit at(std::size_t i) const;
+
+  /**
+   * Get all the hits with their contributions.
+   * @return The hits as they were before being packed.
+   */
+  std::vector<SimCalorimeterHit> unpack() const;
+
+ private:
+  /**
+   * The hits, without their contributions.
+   */
+  std::vector<SimCalorimeterHit> hits_;
+
+  /**
+   * The index of the first contribution of each hit, with the total number
+   * of contributions at the end.
+   */
+  std::vector<unsigned> firstContrib_{0};
+
+  /**
+   * The incident IDs of the contributions of all the hits.
+   */
+  std::vector<int> incidentIDs_;
+
+  /**
+   * The track IDs of the contributions of all the hits.
+   */
+  std::vector<int> trackIDs_;
+
+  /**
+   * The PDG codes of the contributions of all the hits.
+   */
+  std::vector<int> pdgCodes_;
+
+  /**
+   * The energy depositions of the contributions of all the hits.
+   */
+  std::vector<float> edeps_;
+
+  /**
+   * The times of the contributions of all the hits.
+   */
+  std::vector<float> times_;
+
+  /**
+   * ROOT class definition.
+   */
+  ClassDef(SimCalorimeterHitCollection, 1)
+};
+
+}  // namespace ldmx
+
+#endif  // SIMCORE_EVENT_SIMCALORIMETERHITCOLLECTION_H_
@@ -112,6 +112,15 @@ class SimParticle {
    */
   std::vector<double> getVertex() const { return {x_, y_, z_}; }
 
+  /// Get the X position of the vertex [mm], without making a vector
+  double getVertexX() const { return x_; }
+
+  /// Get the Y position of the vertex [mm], without making a vector
+  double getVertexY() const { return y_; }
+
+  /// Get the Z position of the vertex [mm], without making a vector
+  double getVertexZ() const { return z_; }
+
   /**
    * Get the volume name in which this particle was created in.
    *
@@ -129,6 +138,15 @@ class SimParticle {
    */
   std::vector<double> getEndPoint() const { return {endX_, endY_, endZ_}; }
 
+  /// Get the X position of the endpoint [mm], without making a vector
+  double getEndPointX() const { return endX_; }
+
+  /// Get the Y position of the endpoint [mm], without making a vector
+  double getEndPointY() const { return endY_; }
+
+  /// Get the Z position of the endpoint [mm], without making a vector
+  double getEndPointZ() const { return endZ_; }
+
   /**
    * Get a vector containing the momentum of this particle [MeV].
    *
@@ -138,6 +156,15 @@ class SimParticle {
    */
   std::vector<double> getMomentum() const { return {px_, py_, pz_}; }
 
+  /// Get the X momentum of this particle [MeV], without making a vector
+  double getPx() const { return px_; }
+
+  /// Get the Y momentum of this particle [MeV], without making a vector
+  double getPy() const { return py_; }
+
+  /// Get the Z momentum of this particle [MeV], without making a vector
+  double getPz() const { return pz_; }
+
   /**
    * Get the mass of this particle [GeV].
    *
@@ -167,6 +194,18 @@ class SimParticle {
    */
   std::vector<int> getParents() const { return parents_; }
 
+  /**
+   * Get the memory held by this particle, including the track IDs of
+   * its daughters and parents and the name of its vertex volume.
+   *
+   * @return The size of the particle [bytes].
+   */
+  std::size_t byteSize() const {
+    return sizeof(*this) +
+           (daughters_.capacity() + parents_.capacity()) * sizeof(int) +
+           vertexVolume_.capacity();
+  }
+
   /**
    * Set the energy of this particle [MeV].
    *
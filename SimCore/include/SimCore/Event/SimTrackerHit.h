@@ -68,6 +68,24 @@ class SimTrackerHit {
    */
   std::vector<float> getPosition() const { return {x_, y_, z_}; };
 
+  /**
+   * Get the X position of the hit [mm].
+   * @return The X position, without making a vector as getPosition does.
+   */
+  float getX() const { return x_; };
+
+  /**
+   * Get the Y position of the hit [mm].
+   * @return The Y position, without making a vector as getPosition does.
+   */
+  float getY() const { return y_; };
+
+  /**
+   * Get the Z position of the hit [mm].
+   * @return The Z position, without making a vector as getPosition does.
+   */
+  float getZ() const { return z_; };
+
   /**
    * Get the energy deposited on the hit [MeV].
    * @return The energy deposited on the hit.
@@ -100,6 +118,24 @@ class SimTrackerHit {
    */
   std::vector<double> getMomentum() const { return {px_, py_, pz_}; };
 
+  /**
+   * Get the X momentum of the particle at the hit [MeV].
+   * @return The X momentum, without making a vector as getMomentum does.
+   */
+  double getPx() const { return px_; };
+
+  /**
+   * Get the Y momentum of the particle at the hit [MeV].
+   * @return The Y momentum, without making a vector as getMomentum does.
+   */
+  double getPy() const { return py_; };
+
+  /**
+   * Get the Z momentum of the particle at the hit [MeV].
+   * @return The Z momentum, without making a vector as getMomentum does.
+   */
+  double getPz() const { return pz_; };
+
   /**
    * Get the Sim particle track ID of the hit.
    * @return The Sim particle track ID of the hit.
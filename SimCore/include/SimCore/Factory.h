@@ -6,6 +6,7 @@
 #include <memory>                   // for the unique_ptr default
 #include <string>                   // for the keys in the library map
 #include <unordered_map>            // for the library of prototypes
+#include <vector>                   // for the warehouse of objects
 
 #include "Framework/Exception/Exception.h"
 
@@ -260,6 +261,10 @@ class Factory {
    * declare
    * @param[in] maker_args parameter pack of arguments to pass on to maker
    *
+   * @note The object is put into the warehouse of the calling thread,
+   * so that the worker threads of a multi-threaded simulation each
+   * have their own objects.
+   *
    * @returns a pointer to the parent class that the objects derive from.
    */
   PrototypePtr make(const std::string& full_name,
@@ -269,19 +274,22 @@ class Factory {
       EXCEPTION_RAISE("SimFactory", "An object named " + full_name +
                                         " has not been declared.");
     }
-    warehouse_.emplace_back(lib_it->second(maker_args...));
-    return warehouse_.back();
+    PrototypePtr object{lib_it->second(maker_args...)};
+    warehouse().emplace_back(object);
+    return object;
   }
 
   /**
    * Apply the input UnaryFunction to each entry in the inventory
+   * of the calling thread
    *
    * UnaryFunction is simply passed dirctly to std::for_each so
    * look there for requirements upon it.
    */
   template <class UnaryFunction>
   void apply(UnaryFunction f) const {
-    std::for_each(warehouse_.begin(), warehouse_.end(), f);
+    const auto& objects{warehouse()};
+    std::for_each(objects.begin(), objects.end(), f);
   }
 
   /// delete the copy constructor
@@ -319,11 +327,21 @@ class Factory {
   /// private constructor to prevent creation
   Factory() = default;
 
+  /**
+   * warehouse of objects that have already been created by the calling
+   * thread
+   *
+   * Geant4 gives each worker thread its own sensitive detectors, user
+   * actions, biasing operators and physics, so the objects made on one
+   * thread are only applied to on that thread.
+   */
+  static std::vector<PrototypePtr>& warehouse() {
+    thread_local std::vector<PrototypePtr> the_warehouse;
+    return the_warehouse;
+  }
+
   /// library of possible objects to create
   std::unordered_map<std::string, PrototypeMaker> library_;
-
-  /// warehouse of objects that have already been created
-  std::vector<PrototypePtr> warehouse_;
 };  // Factory
 
 }  // namespace simcore
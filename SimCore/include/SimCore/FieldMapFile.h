@@ -0,0 +1,296 @@
+/**
+ * @file FieldMapFile.h
+ * @brief Magnetic field map grid shared by the simulation and the tracking
+ */
+
+#ifndef SIMCORE_FIELDMAPFILE_H_
+#define SIMCORE_FIELDMAPFILE_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Framework/Exception/Exception.h"
+
+namespace simcore {
+
+/**
+ * @class FieldMapFile
+ * @brief The grid of a magnetic field map, read from text or mapped from a
+ * binary file
+ *
+ * The text maps are the ones read by MagneticFieldMap3D: a blank line, the
+ * number of points along x, y and z, a header ended by the first line whose
+ * second character is '0' and then one line "x y z Bx By Bz" per point, with
+ * z changing the fastest. The coordinates are in mm and the field in kT.
+ *
+ * Parsing the text of a large map is slow, so it can be converted once
+ * (with convert-field-map) to a binary file made of a Header followed by
+ * Bx, By and Bz of each point as doubles, in the same order as the text.
+ * A binary file is mapped into memory and used where it is, without
+ * copying or converting it, so the values are exactly the ones parsed from
+ * the text.
+ *
+ * The maps are usually loaded through get, which keeps each one for the
+ * rest of the process, so the simulation and all of the tracking
+ * processors use a single copy of it.
+ */
+class FieldMapFile {
+ public:
+  /// Beginning of a binary map, on a little-endian host
+  struct Header {
+    /// always MAGIC
+    char magic[8];
+    /// version of the format, VERSION
+    std::uint32_t version;
+    /// number of points along x, y and z
+    std::uint32_t n[3];
+    /// coordinates of the first and last points of the map
+    double first[3], last[3];
+    /// size of a unit of the coordinates in mm
+    double length_unit;
+    /// size of a unit of the field in T
+    double field_unit;
+  };
+  static_assert(sizeof(Header) == 88, "the binary map header is 88 bytes");
+
+  /// first bytes of a binary map
+  static constexpr char MAGIC[8] = {'L', 'D', 'M', 'X', 'B', 'M', 'A', 'P'};
+  /// version of the binary format written
+  static constexpr std::uint32_t VERSION = 1;
+
+  /**
+   * Get a map, loading it if it is the first time it is asked for
+   *
+   * @param[in] filename text or binary map
+   * @return the map, shared with the other users of the same file
+   */
+  static std::shared_ptr<const FieldMapFile> get(const std::string& filename) {
+    static std::mutex mutex;
+    static std::map<std::string, std::shared_ptr<const FieldMapFile>> maps;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& map{maps[filename]};
+    if (not map) map = std::make_shared<const FieldMapFile>(filename);
+    return map;
+  }
+
+  /**
+   * Load a map
+   *
+   * The format is recognized by the first bytes of the file.
+   *
+   * @throw Exception if the file does not exist or is truncated
+   * @param[in] filename text or binary map
+   */
+  explicit FieldMapFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.good()) {
+      EXCEPTION_RAISE("FileDNE",
+                      "The field map file '" + filename + "' does not exist!");
+    }
+    char magic[sizeof(MAGIC)] = {0};
+    file.read(magic, sizeof(magic));
+    if (file.gcount() == sizeof(magic) and
+        std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0) {
+      file.close();
+      mapBinary(filename);
+    } else {
+      file.clear();
+      file.seekg(0);
+      parseText(file, filename);
+    }
+  }
+
+  /// unmap the binary file we read
+  ~FieldMapFile() {
+    if (mapped_) munmap(mapped_, mappedSize_);
+  }
+
+  FieldMapFile(const FieldMapFile&) = delete;
+  FieldMapFile& operator=(const FieldMapFile&) = delete;
+
+  /// @return true if the map was read from a binary file
+  bool isBinary() const { return mapped_ != nullptr; }
+
+  /// @return number of points along a coordinate
+  std::size_t size(int i) const { return header_.n[i]; }
+
+  /// @return total number of points
+  std::size_t points() const {
+    return std::size_t(header_.n[0]) * header_.n[1] * header_.n[2];
+  }
+
+  /// @return coordinate of the first point of the map
+  double first(int i) const { return header_.first[i]; }
+
+  /// @return coordinate of the last point of the map
+  double last(int i) const { return header_.last[i]; }
+
+  /// @return smallest value of a coordinate
+  double min(int i) const {
+    return header_.first[i] < header_.last[i] ? header_.first[i]
+                                              : header_.last[i];
+  }
+
+  /// @return largest value of a coordinate
+  double max(int i) const {
+    return header_.first[i] < header_.last[i] ? header_.last[i]
+                                              : header_.first[i];
+  }
+
+  /// @return size of a unit of the coordinates in mm
+  double lengthUnit() const { return header_.length_unit; }
+
+  /// @return size of a unit of the field in T
+  double fieldUnit() const { return header_.field_unit; }
+
+  /**
+   * @param[in] i index of a point in the order of the map
+   * @return Bx, By and Bz at the point
+   */
+  const double* field(std::size_t i) const { return field_ + 3 * i; }
+
+  /**
+   * @param[in] ix,iy,iz indices of a point along x, y and z
+   * @return Bx, By and Bz at the point
+   */
+  const double* field(int ix, int iy, int iz) const {
+    return field((std::size_t(ix) * header_.n[1] + iy) * header_.n[2] + iz);
+  }
+
+  /**
+   * Write the map in the binary format
+   *
+   * @throw Exception if the file cannot be written
+   * @param[in] filename file to write
+   */
+  void write(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+    file.write(reinterpret_cast<const char*>(field_),
+               3 * points() * sizeof(double));
+    if (!file.good()) {
+      EXCEPTION_RAISE("FileError", "The field map could not be written to '" +
+                                       filename + "'.");
+    }
+  }
+
+ private:
+  /// read a text map and keep its values
+  void parseText(std::ifstream& file, const std::string& filename) {
+    std::memcpy(header_.magic, MAGIC, sizeof(MAGIC));
+    header_.version = VERSION;
+    header_.length_unit = 1.;
+    header_.field_unit = 1000.;
+
+    // Ignore first blank line
+    char buffer[256] = {0};
+    file.getline(buffer, 256);
+
+    // Read table dimensions
+    int nx{0}, ny{0}, nz{0};
+    file >> nx >> ny >> nz;
+    if (!file or nx < 1 or ny < 1 or nz < 1) {
+      EXCEPTION_RAISE("FileError", "The field map file '" + filename +
+                                       "' does not start with the number of "
+                                       "points along x, y and z.");
+    }
+    header_.n[0] = nx;
+    header_.n[1] = ny;
+    header_.n[2] = nz;
+
+    // Ignore other header information
+    // The first line whose second character is '0' is considered to
+    // be the last line of the header.
+    do {
+      file.getline(buffer, 256);
+      if (file.eof()) break;
+      // lines longer than the buffer are skipped in pieces
+      if (file.fail()) file.clear();
+    } while (buffer[1] != '0');
+
+    owned_.resize(3 * points());
+    double x{0.}, y{0.}, z{0.};
+    for (std::size_t i{0}; i < points(); i++) {
+      file >> x >> y >> z >> owned_[3 * i] >> owned_[3 * i + 1] >>
+          owned_[3 * i + 2];
+      if (!file) {
+        EXCEPTION_RAISE("FileError", "The field map file '" + filename +
+                                         "' ends after " + std::to_string(i) +
+                                         " of its " +
+                                         std::to_string(points()) + " points.");
+      }
+      if (i == 0) {
+        header_.first[0] = x;
+        header_.first[1] = y;
+        header_.first[2] = z;
+      }
+    }
+    header_.last[0] = x;
+    header_.last[1] = y;
+    header_.last[2] = z;
+    field_ = owned_.data();
+  }
+
+  /// map a binary map into memory
+  void mapBinary(const std::string& filename) {
+    int fd{open(filename.c_str(), O_RDONLY)};
+    struct stat info;
+    if (fd < 0 or fstat(fd, &info) != 0) {
+      if (fd >= 0) close(fd);
+      EXCEPTION_RAISE("FileError",
+                      "The field map file '" + filename + "' can't be read.");
+    }
+    mappedSize_ = info.st_size;
+    void* data{mappedSize_ >= sizeof(Header)
+                   ? mmap(nullptr, mappedSize_, PROT_READ, MAP_SHARED, fd, 0)
+                   : MAP_FAILED};
+    close(fd);
+    if (data == MAP_FAILED) {
+      EXCEPTION_RAISE("FileError", "The field map file '" + filename +
+                                       "' can't be mapped into memory.");
+    }
+    mapped_ = data;
+    std::memcpy(&header_, data, sizeof(Header));
+    if (header_.version != VERSION) {
+      EXCEPTION_RAISE("FileError",
+                      "The field map file '" + filename + "' has version " +
+                          std::to_string(header_.version) +
+                          " of the binary format, this build reads version " +
+                          std::to_string(VERSION) + ".");
+    }
+    if (mappedSize_ != sizeof(Header) + 3 * points() * sizeof(double)) {
+      EXCEPTION_RAISE("FileError", "The field map file '" + filename +
+                                       "' does not have the size of its " +
+                                       std::to_string(points()) + " points.");
+    }
+    // the header is a multiple of 8 bytes, so the doubles stay aligned
+    field_ = reinterpret_cast<const double*>(static_cast<const char*>(data) +
+                                             sizeof(Header));
+  }
+
+  /// header of the map, filled from the text for text maps
+  Header header_{};
+  /// Bx, By and Bz of each point
+  const double* field_{nullptr};
+  /// values of a text map
+  std::vector<double> owned_;
+  /// binary file mapped into memory
+  void* mapped_{nullptr};
+  /// size of the binary file
+  std::size_t mappedSize_{0};
+};
+
+}  // namespace simcore
+
+#endif  // SIMCORE_FIELDMAPFILE_H_
@@ -0,0 +1,81 @@
+/**
+ * @file ActionInitialization.h
+ * @brief Class which creates the Geant4 user actions
+ */
+
+#ifndef SIMCORE_G4USER_ACTIONINITIALIZATION_H
+#define SIMCORE_G4USER_ACTIONINITIALIZATION_H
+
+/*~~~~~~~~~~~~~~~~*/
+/*   C++ StdLib   */
+/*~~~~~~~~~~~~~~~~*/
+#include <functional>
+
+/*~~~~~~~~~~~~*/
+/*   Geant4   */
+/*~~~~~~~~~~~~*/
+#include "G4VUserActionInitialization.hh"
+
+/*~~~~~~~~~~~~~~~*/
+/*   Framework   */
+/*~~~~~~~~~~~~~~~*/
+#include "Framework/Configure/Parameters.h"
+
+// Forward declarations
+class G4Event;
+
+namespace simcore::g4user {
+
+/**
+ * @class ActionInitialization
+ * @brief Create our G4User actions and the UserActions attached to them
+ *
+ * Geant4 calls Build once for the sequential run manager and once on each
+ * worker thread of a multi-threaded run manager, so each thread gets its
+ * own primary generators, TrackMap (held by the TrackingAction) and
+ * UserActions.
+ */
+class ActionInitialization : public G4VUserActionInitialization {
+ public:
+  /**
+   * Constructor
+   *
+   * @param[in] parameters configuration of the simulation
+   * @param[in] end_of_event function the EventAction calls at the end of
+   * each event, none if empty
+   */
+  ActionInitialization(const framework::config::Parameters& parameters,
+                       std::function<void(const G4Event*)> end_of_event = {});
+
+  /**
+   * Class destructor.
+   */
+  virtual ~ActionInitialization() = default;
+
+  /**
+   * Create the user actions of the master thread of a multi-threaded run
+   *
+   * The master doesn't process events, but we create the primary
+   * generators so that their configuration can be recorded in the
+   * RunHeader.
+   */
+  void BuildForMaster() const final override;
+
+  /**
+   * Create the user actions of the (worker) thread processing events
+   *
+   * @throws Exception if a UserAction has an unknown type
+   */
+  void Build() const final override;
+
+ private:
+  /// configuration of the simulation
+  framework::config::Parameters parameters_;
+
+  /// called at the end of each event
+  std::function<void(const G4Event*)> end_of_event_;
+};  // ActionInitialization
+
+}  // namespace simcore::g4user
+
+#endif  // SIMCORE_G4USER_ACTIONINITIALIZATION_H
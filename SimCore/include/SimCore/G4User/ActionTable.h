@@ -0,0 +1,104 @@
+#ifndef SIMCORE_G4USER_ACTIONTABLE_H
+#define SIMCORE_G4USER_ACTIONTABLE_H
+
+/*~~~~~~~~~~~~~~~~*/
+/*   C++ StdLib   */
+/*~~~~~~~~~~~~~~~~*/
+#include <algorithm>
+#include <vector>
+
+/*~~~~~~~~~~~~*/
+/*   Geant4   */
+/*~~~~~~~~~~~~*/
+#include "G4Track.hh"
+
+/*~~~~~~~~~~~~~*/
+/*   SimCore   */
+/*~~~~~~~~~~~~~*/
+#include "SimCore/UserAction.h"
+
+namespace simcore::g4user {
+
+/**
+ * @class ActionTable
+ * @brief Dispatch table of the user actions of one type
+ *
+ * The actions are looked up by the tag of the region of the track (see
+ * NameTags), the list of the actions selecting a region being made the
+ * first time a track is in it. Only the particle and the parent of the
+ * track are then checked against the selection of each action, so the
+ * actions that don't select a track aren't called at all.
+ */
+class ActionTable {
+ public:
+  /**
+   * Make the table of a type of action
+   *
+   * @param[in] type type of the actions, passed to UserAction::getSelection
+   */
+  explicit ActionTable(TYPE type) : type_{type} {}
+
+  /**
+   * Add an action, called after the ones already added
+   *
+   * @param[in] action user action to add
+   */
+  void add(UserAction* action);
+
+  /// All the actions, in the order they were added
+  const std::vector<UserAction*>& actions() const { return actions_; }
+
+  /**
+   * Call the actions selecting a track, in the order they were added
+   *
+   * @param[in] track current track
+   * @param[in] call callable taking the UserAction* to call
+   */
+  template <typename Call>
+  void forEach(const G4Track* track, Call&& call) {
+    const bool primary{track->GetParentID() == 0};
+    const int pdg{track->GetParticleDefinition()->GetPDGEncoding()};
+    for (std::size_t i : inRegionOf(track)) {
+      const Entry& entry{entries_[i]};
+      if (entry.primaries_only and not primary) continue;
+      if (not entry.particles.empty() and
+          std::find(entry.particles.begin(), entry.particles.end(), pdg) ==
+              entry.particles.end())
+        continue;
+      call(actions_[i]);
+    }
+  }
+
+ private:
+  /// The selection of an action with the regions as tags
+  struct Entry {
+    std::vector<int> regions;
+    std::vector<int> particles;
+    bool primaries_only;
+  };
+
+  /// Get the indices of the actions selecting the region of a track
+  const std::vector<std::size_t>& inRegionOf(const G4Track* track);
+
+  /// type of the actions
+  TYPE type_;
+
+  /// the actions
+  std::vector<UserAction*> actions_;
+
+  /// the selection of each action
+  std::vector<Entry> entries_;
+
+  /// does any action select regions
+  bool selectsRegions_{false};
+
+  /// indices of the actions by region tag plus one (zero for no region)
+  std::vector<std::vector<std::size_t>> byRegion_;
+
+  /// which entries of byRegion_ were made
+  std::vector<bool> made_;
+};
+
+}  // namespace simcore::g4user
+
+#endif  // SIMCORE_G4USER_ACTIONTABLE_H
@@ -10,6 +10,7 @@
 /*~~~~~~~~~~~~~~~~*/
 /*   C++ StdLib   */
 /*~~~~~~~~~~~~~~~~*/
+#include <functional>
 #include <vector>
 
 /*~~~~~~~~~~~~*/
@@ -74,9 +75,25 @@ class EventAction : public G4UserEventAction {
     eventActions_.push_back(eventAction);
   }
 
+  /**
+   * Set the function called at the end of each event, after the user
+   * event actions
+   *
+   * The worker threads of a multi-threaded simulation use it to hand
+   * the finished event over to the Simulator.
+   *
+   * @param callback function to call with the finished event
+   */
+  void setEndOfEventCallback(std::function<void(const G4Event*)> callback) {
+    endOfEventCallback_ = std::move(callback);
+  }
+
  private:
   std::vector<UserAction*> eventActions_;
 
+  /// called at the end of each event (if set)
+  std::function<void(const G4Event*)> endOfEventCallback_;
+
 };  // EventAction
 
 }  // namespace g4user
@@ -20,6 +20,7 @@
 /*~~~~~~~~~~~~~*/
 /*   SimCore   */
 /*~~~~~~~~~~~~~*/
+#include "SimCore/G4User/ActionTable.h"
 #include "SimCore/UserAction.h"
 
 namespace simcore {
@@ -28,11 +29,23 @@ namespace g4user {
 /**
  * @class StackingAction
  * @brief Class implementing a user stacking action.
+ *
+ * The secondaries can be simulated in stages by their kinetic energy,
+ * the highest energies first. A secondary of stage k goes to the
+ * waiting stack until the k-th new stage, when the waiting tracks still
+ * in a later stage are put back on the waiting stack (re-classified).
+ * The secondaries deferred until the kill-early actions decided are in
+ * the stage after the last energy.
  */
 class StackingAction : public G4UserStackingAction {
  public:
-  /// Constructor
-  StackingAction() = default;
+  /**
+   * Constructor
+   *
+   * @param[in] stage_energies kinetic energies [MeV] splitting the
+   * secondaries into stages, in any order, no stages if empty
+   */
+  explicit StackingAction(std::vector<double> stage_energies = {});
 
   /// Destructor
   virtual ~StackingAction() = default;
@@ -60,12 +73,55 @@ class StackingAction : public G4UserStackingAction {
    * @param action  User action of type StackingAction
    */
   void registerAction(UserAction* stackingAction) {
-    stackingActions_.push_back(stackingAction);
+    stackingActions_.add(stackingAction);
   }
 
+  /**
+   * Register a user action that kills early with this class.
+   *
+   * Until all of these actions passed the event, the new secondaries
+   * none of the undecided actions needs are put on the waiting stack.
+   *
+   * @param action User action configured to kill early
+   */
+  void registerKillEarlyAction(UserAction* action) {
+    killEarlyActions_.push_back(action);
+  }
+
+ private:
+  /**
+   * Should the input new track wait until the kill-early actions
+   * decided on the event?
+   *
+   * @param track new track being classified
+   * @return true if an action is undecided and none of the undecided
+   * ones needs the track
+   */
+  bool deferUntilDecision(const G4Track* track) const;
+
+  /**
+   * Get the stage the input new track is simulated in
+   *
+   * @param track new secondary track
+   * @return number of the stage, the primaries are in the first (zero)
+   */
+  std::size_t stageOf(const G4Track* track) const;
+
  private:
+  /// Kinetic energies splitting the stages, from the highest to the lowest
+  std::vector<double> stageEnergies_;
+
+  /// Stage being simulated in this event
+  std::size_t stage_{0};
+
+  /// Are the waiting tracks being re-classified
+  bool reclassifying_{false};
+
   /// Collection of user stacking actions
-  std::vector<UserAction*> stackingActions_;
+  ActionTable stackingActions_{TYPE::STACKING};
+
+  /// User actions deciding on the event before their secondaries are needed
+  std::vector<UserAction*> killEarlyActions_;
 
 };  // StackingAction
 
@@ -6,11 +6,6 @@
 #ifndef SIMCORE_G4USER_STEPPINGACTION_H
 #define SIMCORE_G4USER_STEPPINGACTION_H
 
-/*~~~~~~~~~~~~~~~~*/
-/*   C++ StdLib   */
-/*~~~~~~~~~~~~~~~~*/
-#include <vector>
-
 /*~~~~~~~~~~~~*/
 /*   Geant4   */
 /*~~~~~~~~~~~~*/
@@ -19,6 +14,7 @@
 /*~~~~~~~~~~~~~*/
 /*   SimCore   */
 /*~~~~~~~~~~~~~*/
+#include "SimCore/G4User/ActionTable.h"
 #include "SimCore/UserAction.h"
 
 namespace simcore {
@@ -46,12 +42,12 @@ class SteppingAction : public G4UserSteppingAction {
    * @param action  User action of type SteppingAction
    */
   void registerAction(UserAction* steppingAction) {
-    steppingActions_.push_back(steppingAction);
+    steppingActions_.add(steppingAction);
   }
 
  private:
   /// Collection of user stepping actions
-  std::vector<UserAction*> steppingActions_;
+  ActionTable steppingActions_{TYPE::STEPPING};
 
 };  // SteppingAction
 
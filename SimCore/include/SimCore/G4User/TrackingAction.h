@@ -22,6 +22,7 @@
 /*~~~~~~~~~~~~~*/
 /*   SimCore   */
 /*~~~~~~~~~~~~~*/
+#include "SimCore/G4User/ActionTable.h"
 #include "SimCore/UserAction.h"
 
 namespace simcore::g4user {
@@ -124,12 +125,12 @@ class TrackingAction : public G4UserTrackingAction {
    * @param action  User action of type RunAction
    */
   void registerAction(UserAction* trackingAction) {
-    trackingActions_.push_back(trackingAction);
+    trackingActions_.add(trackingAction);
   }
 
  private:
   /// custom user actions to be called before and after processing a track
-  std::vector<UserAction*> trackingActions_;
+  ActionTable trackingActions_{TYPE::TRACKING};
 
   /** Stores parentage information for all tracks in the event. */
   TrackMap trackMap_;
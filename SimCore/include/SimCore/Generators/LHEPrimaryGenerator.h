@@ -50,6 +50,8 @@ class LHEPrimaryGenerator : public simcore::PrimaryGenerator {
   simcore::lhe::LHEReader* reader_;
   /// path to LHE file
   std::string file_path_;
+  /// index of the first event read from the file
+  int first_event_;
 };
 
 }  // namespace generators
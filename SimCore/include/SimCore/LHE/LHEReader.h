@@ -11,21 +11,47 @@
 #include "SimCore/LHE/LHEEvent.h"
 
 // STL
-#include <fstream>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace simcore::lhe {
 
 /**
  * @class LHEReader
  * @brief Reads LHE event data into an LHEEvent object
+ *
+ * The file is mapped into memory and the position of each <event> block
+ * is found when it is opened, so that reading can start at any event
+ * without parsing the ones before it. The index of a large file can be
+ * saved to an index file which is loaded instead of scanning the file
+ * again as long as the size of the LHE file doesn't change.
+ *
+ * With a read-ahead depth, the events are parsed on a background thread
+ * into a queue holding at most that many events.
+ *
+ * Compressed (gzip) files are not supported, they need to be
+ * decompressed before they are read.
  */
 class LHEReader {
  public:
   /**
    * Class constructor.
    * @param fileName The input file name.
+   * @param indexFile File the event index is loaded from, or saved to if it
+   * doesn't exist or doesn't match the input file; no index file if empty.
+   * @param readAhead Number of events parsed ahead on a background thread,
+   * 0 to parse each event when it is read.
+   * @throws Exception if the file can't be read or is compressed
    */
-  LHEReader(std::string& fileName);
+  LHEReader(const std::string& fileName, const std::string& indexFile = "",
+            std::size_t readAhead = 0);
 
   /**
    * Class destructor.
@@ -38,11 +64,83 @@ class LHEReader {
    */
   LHEEvent* readNextEvent();
 
+  /**
+   * Get the number of events in the file.
+   * @return The number of <event> blocks.
+   */
+  std::size_t getNumberOfEvents() const { return offsets_.size(); }
+
+  /**
+   * Continue reading at the input event.
+   * @param event index of the next event read, starting from 0
+   */
+  void seek(std::size_t event);
+
  private:
+  /// find the <event> blocks in the mapped file
+  void buildIndex();
+
   /**
-   * The input file stream.
+   * Load the index from an index file.
+   * @param indexFile name of the index file
+   * @return true if the index file exists and matches the input file
    */
-  std::ifstream ifs_;
+  bool loadIndex(const std::string& indexFile);
+
+  /// save the index to an index file, warning if it can't be written
+  void saveIndex(const std::string& indexFile) const;
+
+  /**
+   * Parse an event of the file.
+   * @param event index of the event
+   * @return The new LHE event.
+   */
+  LHEEvent* parseEvent(std::size_t event) const;
+
+  /// start parsing ahead from the next event
+  void startParsing();
+
+  /// stop the background thread and drop the events it parsed
+  void stopParsing();
+
+  /// body of the background thread
+  void parseAhead();
+
+  /// contents of the file, mapped into memory
+  const char* data_{nullptr};
+
+  /// size of the file
+  std::size_t size_{0};
+
+  /// offset of the line following each <event> line
+  std::vector<std::uint64_t> offsets_;
+
+  /// index of the next event read
+  std::size_t next_{0};
+
+  /// maximum number of events parsed ahead
+  std::size_t readAhead_;
+
+  /// background thread parsing events ahead
+  std::thread parser_;
+
+  /// protects the members shared with the background thread
+  std::mutex mutex_;
+
+  /// signals a change of the queue or a request to stop
+  std::condition_variable changed_;
+
+  /// events parsed ahead, in order
+  std::deque<std::unique_ptr<LHEEvent>> queue_;
+
+  /// index of the next event the background thread parses
+  std::size_t nextParsed_{0};
+
+  /// the background thread should stop
+  bool stop_{false};
+
+  /// error raised on the background thread, rethrown when reading
+  std::exception_ptr error_;
 };
 
 }  // namespace simcore::lhe
@@ -12,7 +12,10 @@
 #include "G4MagneticField.hh"
 
 // STL
+#include <memory>
 #include <vector>
+
+#include "SimCore/FieldMapFile.h"
 using std::vector;
 
 namespace simcore {
@@ -55,6 +58,14 @@ namespace simcore {
  *
  * x y z B_x B_y B_z
  *
+ * The map can also be converted once with convert-field-map to a binary
+ * file, which is read much faster (see FieldMapFile).
+ *
+ * The steps of a track are close together, so most of the calls fall in the
+ * cell of the previous one. Each thread keeps the field at the corners of
+ * the last cell it used next to each other and only goes back to the table
+ * when it moves to another cell.
+ *
  * Original PurgMagTabulatedField3D code developed by: S.Larsson and J.
  * Generowicz.
  */
@@ -79,11 +90,14 @@ class MagneticFieldMap3D : public G4MagneticField {
 
  private:
   /*
-   * Storage space for the table.
+   * The table, shared with the other users of the same map.
+   */
+  std::shared_ptr<const FieldMapFile> map_;
+
+  /*
+   * Number of this map, telling apart the cells cached by each thread.
    */
-  vector<vector<vector<double>>> xField_;
-  vector<vector<vector<double>>> yField_;
-  vector<vector<vector<double>>> zField_;
+  std::size_t id_;
 
   /*
    * The dimensions of the table.
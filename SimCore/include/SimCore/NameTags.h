@@ -0,0 +1,119 @@
+/**
+ * @file NameTags.h
+ * @brief Integer tags for the names of regions, volumes and processes
+ */
+
+#ifndef SIMCORE_NAMETAGS_H_
+#define SIMCORE_NAMETAGS_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class G4Region;
+class G4LogicalVolume;
+class G4VPhysicalVolume;
+class G4VProcess;
+
+namespace simcore {
+
+/**
+ * @class NameTags
+ * @brief Registry of integer tags for the names of the geometry and physics
+ *
+ * Each name gets a tag the first time it is asked for, the same for the
+ * whole program. The stepping actions get the tags of the names they
+ * look for when they are constructed and compare them to the tags of the
+ * region, volume or process of a step, so no string is copied or compared
+ * on each step.
+ *
+ * The tags of the regions and volumes are cached by their Geant4 instance
+ * ID and the ones of the processes by their address, in a cache kept by
+ * each thread, so only the first lookup of each object looks at its name.
+ * ```cpp
+ * // in the constructor
+ * target_ = simcore::NameTags::get().tag("target");
+ * // on each step
+ * if (simcore::NameTags::get().region(region) != target_) return;
+ * ```
+ */
+class NameTags {
+ public:
+  /// Tag of the objects without a name (e.g. the next volume out of the world)
+  static constexpr int NONE{-1};
+
+  /**
+   * Get the registry of the calling thread
+   *
+   * The tags are shared by all the threads, only the caches are not.
+   */
+  static NameTags& get();
+
+  /**
+   * Get the tag of a name, giving it one if it doesn't have one yet
+   *
+   * @param[in] name name to get the tag of
+   * @return tag of the name
+   */
+  int tag(const std::string& name);
+
+  /**
+   * Get the name with a tag
+   *
+   * @param[in] tag tag returned by one of the other methods
+   * @return name with the tag, empty for NONE
+   */
+  const std::string& name(int tag) const;
+
+  /**
+   * Get the tag of the name of a region
+   * @param[in] region the region, may be null
+   * @return tag of its name, NONE if there is no region
+   */
+  int region(const G4Region* region);
+
+  /**
+   * Get the tag of the name of a logical volume
+   * @param[in] volume the volume, may be null
+   * @return tag of its name, NONE if there is no volume
+   */
+  int volume(const G4LogicalVolume* volume);
+
+  /**
+   * Get the tag of the name of a physical volume
+   * @param[in] volume the volume, may be null
+   * @return tag of its name, NONE if there is no volume
+   */
+  int volume(const G4VPhysicalVolume* volume);
+
+  /**
+   * Get the tag of the name of a process
+   * @param[in] process the process, may be null
+   * @return tag of its name, NONE if there is no process
+   */
+  int process(const G4VProcess* process);
+
+ private:
+  /// Only get makes the registries
+  NameTags() = default;
+
+  /**
+   * Get a cached tag by the instance ID of an object, looking up its
+   * name the first time
+   */
+  template <typename Object>
+  int cached(std::vector<int>& cache, const Object* object);
+
+  /// Tags of the regions by instance ID
+  std::vector<int> regions_;
+  /// Tags of the logical volumes by instance ID
+  std::vector<int> logicalVolumes_;
+  /// Tags of the physical volumes by instance ID
+  std::vector<int> physicalVolumes_;
+  /// Tags of the processes by address
+  std::unordered_map<const G4VProcess*, int> processes_;
+};
+
+}  // namespace simcore
+
+#endif  // SIMCORE_NAMETAGS_H_
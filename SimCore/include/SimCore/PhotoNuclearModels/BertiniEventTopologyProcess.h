@@ -8,6 +8,8 @@
 #include <G4HadronicInteraction.hh>
 #include <G4Nucleus.hh>
 #include <iostream>
+#include <map>
+#include <utility>
 
 #include "SimCore/PhotoNuclearModel.h"
 #include "SimCore/UserEventInformation.h"
@@ -28,6 +30,10 @@ namespace simcore {
 ** Note: When performing N attempts, this will increment the event weight in the
 ** UserEventInformation by 1/N. To change this behaviour, override the
 ** incrementEventWeight function.
+**
+** Note: The number of attempts is counted by target Z and projectile energy
+** (in 1 GeV bins) and the acceptance of the topology in each of them is
+** printed when the process is deleted at the end of the run.
 */
 
 class BertiniEventTopologyProcess : public G4CascadeInterface {
@@ -35,6 +41,11 @@ class BertiniEventTopologyProcess : public G4CascadeInterface {
   BertiniEventTopologyProcess(bool count_light_ions = true)
       : G4CascadeInterface{}, count_light_ions_{count_light_ions} {}
 
+  /*
+   * Print the acceptance of the topology by target Z and projectile energy.
+   */
+  virtual ~BertiniEventTopologyProcess();
+
   /*
    * The primary function for derived classes to customize. After each call to
    * the Bertini cascade, this function will be called to see whether or not to
@@ -130,6 +141,21 @@ class BertiniEventTopologyProcess : public G4CascadeInterface {
 
  private:
   bool count_light_ions_;
+
+  /*
+   * Number of interactions with an accepted topology and the number of
+   * attempts they needed
+   */
+  struct Acceptance {
+    long interactions{0};
+    long attempts{0};
+  };
+
+  /*
+   * Acceptance by target Z and projectile kinetic energy in GeV (rounded
+   * down)
+   */
+  std::map<std::pair<int, int>, Acceptance> acceptance_;
 };
 }  // namespace simcore
 
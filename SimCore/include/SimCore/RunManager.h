@@ -19,6 +19,7 @@
 //------------//
 #include "G4PhysListFactory.hh"
 #include "G4RunManager.hh"
+#include "G4VModularPhysicsList.hh"
 
 /*~~~~~~~~~~~~~~~*/
 /*   Framework   */
@@ -69,6 +70,40 @@ class RunManager : public G4RunManager {
    */
   void TerminateOneEvent();
 
+  /**
+   * Create the physics list configured by the input parameters
+   *
+   * The biasing operators are created on the calling thread, their
+   * particles are given to the biasing physics.
+   *
+   * @param[in] parameters configuration of the simulation
+   * @return new physics list, ownership is given to the run manager
+   */
+  static G4VModularPhysicsList* makePhysicsList(
+      const framework::config::Parameters& parameters);
+
+  /**
+   * Register the parallel world of the scoring planes with the detector
+   * construction (if there are scoring planes)
+   *
+   * This needs to happen before the run manager is initialized.
+   *
+   * @param[in] parameters configuration of the simulation
+   * @param[in] detector detector construction to register it with
+   */
+  static void registerParallelWorld(
+      const framework::config::Parameters& parameters,
+      DetectorConstruction* detector);
+
+  /**
+   * Reactivate the G4DarkBremsstrahlung process of the electrons of the
+   * calling thread (if dark brem is possible)
+   *
+   * The dark brem filters deactivate the process once it happened, so it
+   * needs to be turned back on at the end of each event.
+   */
+  static void reactivateDarkBrem();
+
   /**
    * Get the user detector construction cast to a specific type.
    * @return The user detector construction.
@@ -89,20 +124,6 @@ class RunManager : public G4RunManager {
   /// The set of parameters used to configure the RunManager
   framework::config::Parameters parameters_;
 
-  /**
-   * Factory class for instantiating the physics list.
-   */
-  G4PhysListFactory physicsListFactory_;
-
-  /**
-   * Flag indicating whether a parallel world should be
-   * registered
-   */
-  bool isPWEnabled_{false};
-
-  /** Path to GDML description of parallel world. */
-  std::string parallelWorldPath_{""};
-
   /**
    * Should we use random seed from root file?
    */
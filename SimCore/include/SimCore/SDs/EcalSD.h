@@ -9,8 +9,10 @@
 #define SIMCORE_ECALSD_H_
 
 // LDMX
+#include "DetDescr/EcalGeometry.h"
 #include "DetDescr/EcalID.h"
 #include "SimCore/Event/SimCalorimeterHit.h"
+#include "SimCore/Event/SimCalorimeterHitCollection.h"
 #include "SimCore/G4User/TrackingAction.h"
 #include "SimCore/SensitiveDetector.h"
 #include "SimCore/TrackMap.h"
@@ -21,6 +23,9 @@
 // Geant4
 #include "G4Polyhedra.hh"
 
+// STL
+#include <vector>
+
 namespace simcore {
 
 /**
@@ -59,6 +64,15 @@ class EcalSD : public SensitiveDetector {
     return false;
   }
 
+  /**
+   * Get the geometry of this event
+   */
+  virtual void Initialize(G4HCofThisEvent*) final override {
+    refresh(geometry_);
+    if (hit_of_cell_.size() != geometry_->getNumCells())
+      hit_of_cell_.assign(geometry_->getNumCells(), -1);
+  }
+
   /**
    * Process steps to create hits.
    * @param aStep The step information.
@@ -72,17 +86,48 @@ class EcalSD : public SensitiveDetector {
   virtual void saveHits(framework::Event& event) final override;
 
   /**
-   * Clear the map of hits we have accumulated
+   * Clear the hits we have accumulated, keeping the memory for the next event
    */
-  virtual void OnFinishedEvent() final override { hits_.clear(); }
+  virtual void OnFinishedEvent() final override;
 
  private:
-  /// map of hits to add to the event (will be squashed)
-  std::map<ldmx::EcalID, ldmx::SimCalorimeterHit> hits_;
+  /**
+   * The hits of the event are accumulated in flat arrays that keep their
+   * memory from one event to the next. They are only turned into
+   * SimCalorimeterHits in saveHits, if the event is kept.
+   */
+  /// hit of each cell (indexed by EcalGeometry::getCellIndex), -1 if none
+  std::vector<int> hit_of_cell_;
+  /// cell index of each hit
+  std::vector<std::size_t> hit_cell_;
+  /// ID of each hit
+  std::vector<ldmx::EcalID> hit_id_;
+  /// energy deposited in each hit [MeV]
+  std::vector<float> hit_edep_;
+  /// earliest time of each hit [ns]
+  std::vector<float> hit_time_;
+  /// first and last contribution of each hit, -1 if none
+  std::vector<int> hit_first_contrib_, hit_last_contrib_;
+  /// number of contributions of each hit
+  std::vector<unsigned> hit_n_contribs_;
+  /**
+   * Contributions of all the hits, the ones of a hit are chained from its
+   * first contribution through contrib_next_ (-1 after the last one)
+   */
+  std::vector<int> contrib_next_, contrib_incident_, contrib_track_,
+      contrib_pdg_;
+  std::vector<float> contrib_edep_, contrib_time_;
+  /// hits in the order they are written (by ID), reused in saveHits
+  std::vector<int> hit_order_;
+  /// geometry used to find the cell of the hits
+  ConditionHandle<ldmx::EcalGeometry> geometry_{
+      ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME};
   /// enable hit contribs
   bool enableHitContribs_;
   /// compress hit contribs
   bool compressHitContribs_;
+  /// write the hits as a SimCalorimeterHitCollection
+  bool packHitContribs_;
 };
 
 }  // namespace simcore
@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 
+#include "DetDescr/HcalGeometry.h"
 #include "DetDescr/HcalID.h"
 #include "DetDescr/PackedIndex.h"
 #include "SimCore/Event/SimCalorimeterHit.h"
@@ -70,6 +71,13 @@ class HcalSD : public SensitiveDetector {
                                 const G4ThreeVector& localPosition,
                                 const G4Box* scint);
 
+  /**
+   * Get the geometry of this event
+   */
+  virtual void Initialize(G4HCofThisEvent*) final override {
+    refresh(geometry_);
+  }
+
   /**
    * Create a hit out of the energy deposition deposited during a
    * step.
@@ -83,11 +91,12 @@ class HcalSD : public SensitiveDetector {
   /**
    * Add our hits to the event bus and then reset the container
    */
-  virtual void saveHits(framework::Event& event) final override {
-    event.add(COLLECTION_NAME, hits_);
-  }
+  virtual void saveHits(framework::Event& event) final override;
 
-  virtual void OnFinishedEvent() final override { hits_.clear(); }
+  /**
+   * Clear the steps of the event, keeping the memory for the next one
+   */
+  virtual void OnFinishedEvent() final override { steps_.clear(); }
 
  private:
   // A list of identifiers used to find out whether or not a given logical
@@ -102,8 +111,40 @@ class HcalSD : public SensitiveDetector {
   // TODO: document!
   double birksc2_;
 
-  // collection of hits to write to event bus
-  std::vector<ldmx::SimCalorimeterHit> hits_;
+  /**
+   * A step in a bar, which makes a hit with a single contribution
+   *
+   * The steps are kept in a flat array that keeps its memory from one
+   * event to the next and are only turned into SimCalorimeterHits in
+   * saveHits, if the event is kept.
+   */
+  struct Step {
+    /// ID of the bar
+    ldmx::HcalID id;
+    /// global position of the step mid-point [mm]
+    float x, y, z;
+    /// pre/post step positions in the local bar coordinates [mm]
+    float pre_x, pre_y, pre_z, post_x, post_y, post_z;
+    /// pre/post step times [ns]
+    float pre_time, post_time;
+    /// step length [mm]
+    float path_length;
+    /// velocity of the track
+    float velocity;
+    /// contribution of the track
+    int incident_id, track_id, pdg;
+    /// energy deposited including the birks factor [MeV]
+    float edep;
+    /// global time of the track [ns]
+    float time;
+  };
+
+  // steps of the event to write to event bus as hits
+  std::vector<Step> steps_;
+
+  // geometry used to find the strip and bar position of the hits
+  ConditionHandle<ldmx::HcalGeometry> geometry_{
+      ldmx::HcalGeometry::CONDITIONS_OBJECT_NAME};
 
 };  // HcalSD
 
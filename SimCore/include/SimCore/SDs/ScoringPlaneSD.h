@@ -9,6 +9,12 @@ namespace simcore {
 
 /**
  * Class defining a basic sensitive detector for scoring planes.
+ *
+ * By default a hit is recorded for every particle crossing a plane.
+ * The crossings can be thinned out in the SD with a kinetic energy
+ * threshold, a list of the PDG IDs to keep and a maximum number of
+ * generations below the primaries, so the low energy shower particles
+ * don't need to be written.
  */
 class ScoringPlaneSD : public SensitiveDetector {
  public:
@@ -54,12 +60,29 @@ class ScoringPlaneSD : public SensitiveDetector {
   virtual void OnFinishedEvent() final override { hits_.clear(); }
 
  private:
+  /**
+   * Check if the particle of the input step passes the thinning
+   *
+   * @param[in] step the step entering the scoring plane
+   * @return true if a hit should be recorded for it
+   */
+  bool keep(const G4Step* step) const;
+
   /// Substring to match to logical volumes
   std::string match_substr_;
 
   /// Name of output collection to add
   std::string collection_name_;
 
+  /// Minimum kinetic energy of a particle entering a plane [MeV]
+  double min_kinetic_energy_;
+
+  /// Sorted PDG IDs of the particles to record, all if empty
+  std::vector<int> pdg_ids_;
+
+  /// Maximum generation to record, primaries are 0, no limit if negative
+  int max_generation_;
+
   /// The actual output collection
   std::vector<ldmx::SimTrackerHit> hits_;
 
@@ -80,6 +80,14 @@ class SensitiveDetector : public G4VSensitiveDetector {
    */
   virtual void saveHits(framework::Event& event) = 0;
 
+  /**
+   * This is Geant4's handle to tell us a new event is starting
+   *
+   * The conditions can only change between events, so this is where the
+   * ConditionHandle's of the SD are refreshed.
+   */
+  virtual void Initialize(G4HCofThisEvent*) override {}
+
   /**
    * This is Geant4's handle to tell us the event is ending
    *
@@ -120,6 +128,56 @@ class SensitiveDetector : public G4VSensitiveDetector {
     return conditions_interface_.getCondition<T>(condition_name);
   }
 
+  /**
+   * Handle to a condition object that is looked up once per event
+   *
+   * Getting a condition goes through its name and interval of validity,
+   * which is too slow to do on every step. The SD refreshes the handle at
+   * the start of each event and the steps only dereference it.
+   * ```cpp
+   * ConditionHandle<ldmx::EcalGeometry> geometry_{
+   *     ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME};
+   * void Initialize(G4HCofThisEvent*) override { refresh(geometry_); }
+   * ```
+   *
+   * @tparam T type of condition to hold
+   */
+  template <class T>
+  class ConditionHandle {
+   public:
+    /**
+     * @param[in] condition_name name of condition to hold
+     */
+    ConditionHandle(const std::string& condition_name)
+        : condition_name_{condition_name} {}
+
+    /// @returns condition object of the current event
+    const T& operator*() const { return *condition_; }
+
+    /// @returns condition object of the current event
+    const T* operator->() const { return condition_; }
+
+   private:
+    friend class SensitiveDetector;
+
+    /// name of the condition
+    std::string condition_name_;
+
+    /// the condition of the current event, set by refresh
+    const T* condition_{nullptr};
+  };
+
+  /**
+   * Look up the condition of a handle for the current event
+   *
+   * @tparam[in,out] T type of condition to get
+   * @param[in,out] handle handle to refresh
+   */
+  template <class T>
+  void refresh(ConditionHandle<T>& handle) {
+    handle.condition_ = &getCondition<T>(handle.condition_name_);
+  }
+
   /**
    * Check if the passed step is a step of a geantino
    *
@@ -0,0 +1,114 @@
+/**
+ * @file ShowerModel.h
+ * @brief Parameterized EM showers for the fast simulation of a region
+ */
+
+#ifndef SIMCORE_SHOWERMODEL_H_
+#define SIMCORE_SHOWERMODEL_H_
+
+#include <unordered_map>
+
+//---< Geant4 >---//
+#include "G4Navigator.hh"
+#include "G4Step.hh"
+#include "G4TouchableHandle.hh"
+#include "G4VFastSimulationModel.hh"
+
+//---< Framework >---//
+#include "Framework/Configure/Parameters.h"
+
+class G4Material;
+
+namespace simcore {
+
+/**
+ * @class ShowerModel
+ * @brief Deposits the EM showers of a region from a parameterized profile
+ *
+ * The electrons, positrons and photons above a minimum energy entering
+ * the region are killed and their energy is split into spots placed
+ * along a Gamma distribution in depth and the Grindhammer radial profile
+ * 2rR^2/(r^2+R^2)^2 around their direction, the depth and radius being
+ * in units of the effective radiation length and Moliere radius of the
+ * calorimeter. The spots landing in a sensitive volume are given to its
+ * sensitive detector as zero-length steps of the killed track, so the
+ * EcalSD and HcalSD hits are made as for the full simulation.
+ *
+ * The energy of a spot is weighted by the ratio of the stopping power
+ * (taken as the critical energy over the radiation length) of the
+ * material it lands in to the effective one, which makes up for the
+ * sampling fraction of the sensitive layers.
+ *
+ * Tracks that are brem candidates, PN photons or marked for the full
+ * simulation in their UserTrackInformation are simulated by Geant4.
+ */
+class ShowerModel : public G4VFastSimulationModel {
+ public:
+  /**
+   * Make the model of a region
+   *
+   * @param[in] name name of the model
+   * @param[in] region envelope the model showers in
+   * @param[in] parameters configuration of the model
+   */
+  ShowerModel(const std::string& name, G4Region* region,
+              const framework::config::Parameters& parameters);
+
+  /// Destructor
+  virtual ~ShowerModel() = default;
+
+  /// Only shower electrons, positrons and photons
+  G4bool IsApplicable(const G4ParticleDefinition& particle) override;
+
+  /// Shower the tracks above the minimum energy not needing full simulation
+  G4bool ModelTrigger(const G4FastTrack& track) override;
+
+  /// Kill the track and deposit its energy in spots
+  void DoIt(const G4FastTrack& track, G4FastStep& step) override;
+
+ private:
+  /**
+   * Deposit a spot in the sensitive detector of the volume it is in
+   *
+   * @param[in] track killed track the spot comes from
+   * @param[in] position global position of the spot
+   * @param[in] time global time of the spot
+   * @param[in] energy energy of the spot before its weight
+   */
+  void deposit(const G4Track* track, const G4ThreeVector& position,
+               double time, double energy);
+
+  /// Get the weight of the energy of the spots in a material
+  double weightIn(const G4Material* material);
+
+  /// Minimum kinetic energy of the tracks showered [MeV]
+  double minEnergy_;
+
+  /// Energy of each spot [MeV]
+  double spotEnergy_;
+
+  /// Effective radiation length of the region [mm]
+  double radiationLength_;
+
+  /// Effective critical energy of the region [MeV]
+  double criticalEnergy_;
+
+  /// Radius of the radial profile [mm]
+  double moliereRadius_;
+
+  /// Navigator of our own to find the volumes of the spots
+  G4Navigator navigator_;
+
+  /// Touchable of the last spot
+  G4TouchableHandle touchable_;
+
+  /// Step handed to the sensitive detectors
+  G4Step step_;
+
+  /// Weight of the spots by material
+  std::unordered_map<const G4Material*, double> weights_;
+};
+
+}  // namespace simcore
+
+#endif  // SIMCORE_SHOWERMODEL_H_
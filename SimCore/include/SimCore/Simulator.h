@@ -14,7 +14,9 @@
 #include <any>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 /*~~~~~~~~~~~~~~~*/
 /*   Framework   */
@@ -42,6 +44,11 @@ namespace simcore {
  * Most (if not all) of the heavy lifting is done in the classes in the
  * Sim* modules.  This producer is mainly focused on calling appropriate
  * functions at the right time in the processing chain.
+ *
+ * With more than one thread, the events are simulated in batches by the
+ * worker threads of a TaskRunManager sharing one copy of the geometry
+ * and of the physics tables. The finished events are kept in the order
+ * Geant4 numbered them and handed out one per call to produce.
  */
 class Simulator : public SimulatorBase {
  public:
@@ -98,6 +105,21 @@ class Simulator : public SimulatorBase {
   /// Callback called once processing is complete.
   void onProcessEnd() final override;
 
+  /**
+   * Save the state of the random engine and the counts of events
+   *
+   * @param state stream to write the state to
+   */
+  void onCheckpoint(std::ostream& state) final override;
+
+  /**
+   * Restore the state of the random engine and the counts of events,
+   * replacing the seeding of the run
+   *
+   * @param state stream to read the state from
+   */
+  void onResume(std::istream& state) final override;
+
  private:
   /**
    * Set the seeds to be used by the Geant4 random engine.
@@ -108,7 +130,44 @@ class Simulator : public SimulatorBase {
    */
   void setSeeds(std::vector<int> seeds);
 
+  /**
+   * Copy the tracks, the hits and the event header of the event a worker
+   * thread finished into an event of the pool and keep it until produce
+   * hands it out
+   *
+   * @param[in] g4event event the worker thread finished
+   */
+  void endOfWorkerEvent(const G4Event* g4event) final override;
+
+  /**
+   * Hand out the next event simulated by the worker threads, simulating
+   * a new batch of events if all of them have been handed out
+   *
+   * @param[in,out] event event to copy the simulated products into
+   */
+  void produceFromWorkers(framework::Event& event);
+
  private:
+  /// An event simulated by a worker thread
+  struct SimulatedEvent {
+    /// products and header of the event
+    std::unique_ptr<framework::Event> event;
+    /// was the event aborted
+    bool aborted;
+  };
+
+  /// Number of events each worker thread simulates per batch
+  int n_events_per_thread_{10};
+
+  /// Events of the current batch not handed out yet, by G4 event ID
+  std::map<int, SimulatedEvent> simulated_;
+
+  /// Pool of events the worker threads copy their products into
+  std::vector<std::unique_ptr<framework::Event>> spare_events_;
+
+  /// Protects the simulated events and the pool from the worker threads
+  std::mutex simulated_mutex_;
+
   /// Number of events started
   int numEventsBegan_{0};
 
@@ -18,6 +18,9 @@
 #include "SimCore/RunManager.h"
 #include "SimCore/SensitiveDetector.h"
 #include "SimCore/UserEventInformation.h"
+
+class G4Event;
+
 namespace simcore {
 class SimulatorBase : public framework::Producer {
  public:
@@ -43,8 +46,13 @@ class SimulatorBase : public framework::Producer {
   /// User interface handle
   G4UImanager* uiManager_{nullptr};
 
-  /// Manager controlling G4 simulation run
-  std::unique_ptr<RunManager> runManager_;
+  /**
+   * Manager controlling G4 simulation run
+   *
+   * This is our RunManager when simulating on the calling thread and our
+   * TaskRunManager when the events are simulated by worker threads.
+   */
+  std::unique_ptr<G4RunManager> runManager_;
 
   /// Handle to the G4Session -> how to deal with G4cout and G4cerr
   std::unique_ptr<G4UIsession> sessionHandle_;
@@ -59,6 +67,12 @@ class SimulatorBase : public framework::Producer {
 
   /// Vebosity for the simulation
   int verbosity_{1};
+
+  /// Number of Geant4 worker threads, 1 for simulating on the calling thread
+  int n_threads_{1};
+
+  /// Directory the physics tables are cached in, no cache if empty
+  std::string physics_table_cache_;
   /// The parameters used to configure the simulation
   framework::config::Parameters parameters_;
 
@@ -74,6 +88,26 @@ class SimulatorBase : public framework::Producer {
    */
   virtual void updateEventHeader(ldmx::EventHeader& eventHeader) const;
 
+  /**
+   * Put the weight, the total PN/EN energy and the dark brem material of
+   * the input G4Event into the event header
+   *
+   * @param[in,out] eventHeader header to update
+   * @param[in] g4event simulated event carrying the UserEventInformation
+   */
+  static void fillEventHeader(ldmx::EventHeader& eventHeader,
+                              const G4Event& g4event);
+
+  /**
+   * Called on the worker thread at the end of each event simulated by the
+   * worker threads
+   *
+   * Only used with more than one thread. The default does nothing.
+   *
+   * @param[in] g4event event the worker thread finished
+   */
+  virtual void endOfWorkerEvent(const G4Event* g4event) {}
+
   /*
    * Save all tracks from the event that are marked for saving
    */
@@ -102,6 +136,24 @@ class SimulatorBase : public framework::Producer {
    */
   void buildGeometry();
 
+  /*
+   * Have Geant4 retrieve the physics tables from the cache if they were
+   * stored for this detector and physics list, otherwise remember to store
+   * them once they are built.
+   */
+  void retrievePhysicsTables();
+
+  /*
+   * Store the physics tables built during this job in the cache.
+   */
+  void storePhysicsTables();
+
+  /// Directory of the cache holding the tables of this detector and physics
+  std::string physics_table_dir_;
+
+  /// The physics tables were built by this job and should be stored
+  bool store_physics_tables_{false};
+
   /*
    * Check that no invalid commands have been requested or that the old style
    * of setting the run number on the simulator rather than the process object
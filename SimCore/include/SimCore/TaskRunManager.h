@@ -0,0 +1,73 @@
+/**
+ * @file TaskRunManager.h
+ * @brief Class providing a multi-threaded Geant4 run manager implementation.
+ */
+
+#ifndef SIMCORE_TASKRUNMANAGER_H
+#define SIMCORE_TASKRUNMANAGER_H
+
+/*~~~~~~~~~~~~~~~~*/
+/*   C++ StdLib   */
+/*~~~~~~~~~~~~~~~~*/
+#include <functional>
+
+//------------//
+//   Geant4   //
+//------------//
+#include "G4TaskRunManager.hh"
+
+/*~~~~~~~~~~~~~~~*/
+/*   Framework   */
+/*~~~~~~~~~~~~~~~*/
+#include "Framework/Configure/Parameters.h"
+
+class G4Event;
+
+namespace simcore {
+
+/**
+ * @class TaskRunManager
+ * @brief Extension of the Geant4 tasking run manager
+ *
+ * The master thread shares the geometry, the physics tables and the
+ * cross section data with the worker threads simulating the events.
+ * Each worker thread builds its own sensitive detectors, biasing operators,
+ * TrackMap and user actions and hands each finished event over with the
+ * end-of-event function.
+ */
+class TaskRunManager : public G4TaskRunManager {
+ public:
+  /**
+   * Class constructor.
+   *
+   * @param[in] parameters configuration of the simulation
+   * @param[in] n_threads number of worker threads
+   * @param[in] end_of_event function called on the worker thread at the
+   * end of each event, before the event is deleted
+   */
+  TaskRunManager(framework::config::Parameters& parameters, int n_threads,
+                 std::function<void(const G4Event*)> end_of_event);
+
+  /**
+   * Class destructor.
+   */
+  virtual ~TaskRunManager() = default;
+
+  /**
+   * Perform application initialization.
+   *
+   * The physics list, the parallel world and the action initialization
+   * are the ones of the sequential RunManager.
+   */
+  void Initialize() override;
+
+ private:
+  /// The set of parameters used to configure the TaskRunManager
+  framework::config::Parameters parameters_;
+
+  /// called on the worker threads at the end of each event
+  std::function<void(const G4Event*)> end_of_event_;
+};  // TaskRunManager
+}  // namespace simcore
+
+#endif  // SIMCORE_TASKRUNMANAGER_H
@@ -2,7 +2,8 @@
 #define SIMCORE_TRACKMAP_H_
 
 // STL
-#include <unordered_map>
+#include <map>
+#include <vector>
 
 // Geant4
 #include "G4Event.hh"
@@ -38,7 +39,7 @@ class TrackMap {
    * into the track map.
    */
   inline bool contains(const G4Track* track) const {
-    return ancestry_.find(track->GetTrackID()) != ancestry_.end();
+    return contains(track->GetTrackID());
   }
 
   /**
@@ -92,6 +93,7 @@ class TrackMap {
    * This should be called at the **beginning** of an event.
    * The maps need to persist through the end of the event so
    * that they are available to be written to the output file.
+   * The ancestry keeps its memory for the next event.
    */
   void clear();
 
@@ -110,9 +112,51 @@ class TrackMap {
    */
   bool isInCalorimeterRegion(const G4Track* track) const;
 
+  /**
+   * Has the track with the input ID been inserted?
+   */
+  inline bool contains(int trackID) const {
+    return trackID > 0 and
+           static_cast<std::size_t>(trackID) < ancestry_.size() and
+           ancestry_[trackID].parent >= 0;
+  }
+
  private:
   /**
-   * ancestry map of particles in event (child -> parent)
+   * The ancestry of one track
+   */
+  struct Ancestry {
+    /// ID of the parent track, -1 if the track hasn't been inserted
+    int parent{-1};
+    /**
+     * whether **the child track** is in the calorimeter region
+     *
+     * @see isInCalorimeterRegion for how we check if a track
+     * originated in the calorimeter region.
+     */
+    bool in_calorimeter{false};
+    /// index of the first child in children_, -1 if none
+    int first_child{-1};
+    /// index of the last child in children_, -1 if none
+    int last_child{-1};
+  };
+
+  /**
+   * A child in the list of children of a track
+   */
+  struct Child {
+    /// track ID of the child
+    int id;
+    /// index of the next child of the same parent in children_, -1 if none
+    int next;
+  };
+
+  /**
+   * ancestry of particles in event indexed by track ID (child -> parent)
+   *
+   * Geant4 numbers the tracks of an event from one without gaps, so
+   * indexing by ID keeps the ancestry of all the tracks of a shower
+   * in one allocation.
    *
    * Primary particles are given a "parent" ID of 0 to reflect
    * that they don't have a parent. This is the default in Geant4
@@ -121,18 +165,16 @@ class TrackMap {
    * This is helpful for the findIncident method which looks
    * up through a track's history to find the first ancestor
    * which originated outside of the calorimeter region.
-   *
-   * The key value is a pair where the first entry
-   * is the parent track ID and the second entry is
-   * whether **the child track** is in the calorimeter region.
-   *
-   * @see isInCalorimeterRegion for how we check if a track
-   * originated in the calorimeter region.
    */
-  std::unordered_map<int, std::pair<int, bool>> ancestry_;
+  std::vector<Ancestry> ancestry_;
 
-  /// descendents map of particles in event (parent -> children)
-  std::unordered_map<int, std::vector<int>> descendents_;
+  /**
+   * descendents of particles in event (parent -> children)
+   *
+   * The children of a track are linked in the order they were inserted,
+   * starting from the first child of its Ancestry.
+   */
+  std::vector<Child> children_;
 
   /// map of SimParticles that will be stored
   std::map<int, ldmx::SimParticle> particle_map_;
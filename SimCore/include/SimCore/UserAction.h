@@ -35,6 +35,21 @@ namespace simcore {
 /// Enum for each of the user action types.
 enum TYPE { RUN = 1, EVENT, TRACKING, STEPPING, STACKING, NONE };
 
+/**
+ * @struct Selection
+ * @brief The tracks a user action of one type is called for
+ *
+ * An empty selection (the default) calls the action for every track.
+ */
+struct Selection {
+  /// names of the regions the track must be in, any region if empty
+  std::vector<std::string> regions;
+  /// PDG IDs the particle of the track must have, any particle if empty
+  std::vector<int> particles;
+  /// only call the action for the primary tracks (parent ID zero)
+  bool primaries_only{false};
+};
+
 /**
  * @class UserAction
  * @brief Interface that defines a user action.
@@ -154,7 +169,70 @@ class UserAction {
    */
   virtual std::vector<TYPE> getTypes() = 0;
 
+  /**
+   * Get the tracks the action of one type needs to be called for
+   *
+   * The G4User actions call each user action only for the steps or
+   * tracks it selected, looking the actions of a region up in a table,
+   * so an action can return the selection it would otherwise check on
+   * each call. The region is the one of the current volume of the
+   * track, so an action selecting regions isn't called for the new
+   * tracks that aren't placed yet (e.g. when classifying primaries).
+   *
+   * @param[in] type type of action (TRACKING, STEPPING or STACKING)
+   * @return the tracks to call the action for, all of them by default
+   */
+  virtual Selection getSelection(TYPE) const { return {}; }
+
+  /**
+   * Does this action need the input new track to be simulated before it
+   * decides to keep the event?
+   *
+   * Only asked for the actions configured to kill early (with the
+   * parameter 'kill_early'). While one of them hasn't passed the event,
+   * the StackingAction puts the new secondaries none of them needs on the
+   * waiting stack, so they are only simulated once the actions passed
+   * the event (or not at all if the event is aborted).
+   *
+   * @param track new track being classified
+   * @return true if the track is needed, the default
+   */
+  virtual bool neededForDecision(const G4Track*) const { return true; }
+
+  /// @return true if this action defers the tracks it doesn't need
+  bool killsEarly() const { return kill_early_; }
+
+  /// @return true if this action decided to keep the current event
+  bool hasPassed() const { return passed_; }
+
+  /// Forget the decision on the previous event
+  void resetDecision() { passed_ = false; }
+
+  /**
+   * Print how many events each action aborted, for which reason, and the
+   * average tracks, steps and wall time simulated before the abort
+   *
+   * The counts are summed over all the threads of the simulation.
+   *
+   * @param[in] out stream to print to
+   */
+  static void printAbortSummary(std::ostream& out);
+
  protected:
+  /**
+   * Abort the current event
+   *
+   * The reason, the number of tracks and steps simulated so far and the
+   * wall time since the start of the event are added to the abort
+   * summary of this action.
+   *
+   * @param[in] reason why (or where in the event) the action aborted it
+   */
+  void abortEvent(const std::string& reason) const;
+
+  /// Declare that this action keeps the current event
+  void passed() { passed_ = true; }
+
   /**
    * Get a handle to the event information
    *
@@ -183,6 +261,13 @@ class UserAction {
   /// The set of parameters used to configure this class
   framework::config::Parameters parameters_;
 
+ private:
+  /// Defer the tracks not needed for the decision of this action
+  bool kill_early_{false};
+
+  /// Has this action decided to keep the current event
+  bool passed_{false};
+
 };  // UserAction
 
 }  // namespace simcore
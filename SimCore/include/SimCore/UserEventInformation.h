@@ -1,6 +1,8 @@
 #ifndef SIMCORE_USEREVENTINFORMATION_H
 #define SIMCORE_USEREVENTINFORMATION_H
 
+#include <chrono>
+
 #include "G4VUserEventInformation.hh"
 namespace simcore {
 
@@ -117,6 +119,25 @@ class UserEventInformation : public G4VUserEventInformation {
    */
   bool wasLastStepEN() const { return last_step_en_; }
 
+  /// Count a new track simulated in this event
+  void incTrackCount() { n_tracks_ += 1; }
+
+  /// Count a step simulated in this event
+  void incStepCount() { n_steps_ += 1; }
+
+  /// @return number of tracks simulated so far in this event
+  long getTrackCount() const { return n_tracks_; }
+
+  /// @return number of steps simulated so far in this event
+  long getStepCount() const { return n_steps_; }
+
+  /// @return wall time since the event started [s]
+  double getElapsedTime() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start_)
+        .count();
+  }
+
  private:
   /// Total number of brem candidates in the event
   int bremCandidateCount_{0};
@@ -165,6 +186,16 @@ class UserEventInformation : public G4VUserEventInformation {
    * dark brem did not occur within the event in question.
    */
   double db_material_z_{-1.};
+
+  /// number of tracks simulated so far in this event
+  long n_tracks_{0};
+
+  /// number of steps simulated so far in this event
+  long n_steps_{0};
+
+  /// when the event started (its primaries were generated)
+  std::chrono::steady_clock::time_point start_{
+      std::chrono::steady_clock::now()};
 };
 }  // namespace simcore
 
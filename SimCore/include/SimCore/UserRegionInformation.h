@@ -21,6 +21,9 @@ namespace simcore {
  * whether secondary particles should be stored.  This flag is used
  * in the UserTrackingAction to determine whether or not a trajectory
  * is created for a track created in the region.
+ *
+ * It also holds the kinetic energy below which the SteppingAction kills
+ * the tracks in the region, zero (the default) keeps all tracks.
  */
 class UserRegionInformation : public G4VUserRegionInformation {
  public:
@@ -32,8 +35,21 @@ class UserRegionInformation : public G4VUserRegionInformation {
 
   bool getStoreSecondaries() const;
 
+  /**
+   * Set the kinetic energy below which tracks in the region are killed
+   *
+   * @param[in] killBelow kinetic energy [MeV], zero keeps all tracks
+   */
+  void setKillBelow(double killBelow) { killBelow_ = killBelow; }
+
+  /// @return kinetic energy below which tracks are killed [MeV]
+  double getKillBelow() const { return killBelow_; }
+
  private:
   bool storeSecondaries_;
+
+  /// kinetic energy below which tracks are killed [MeV]
+  double killBelow_{0.};
 };
 
 }  // namespace simcore
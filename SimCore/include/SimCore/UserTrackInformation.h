@@ -4,6 +4,7 @@
 #include "G4ThreeVector.hh"
 #include "G4Track.hh"
 #include "G4VUserTrackInformation.hh"
+#include "SimCore/NameTags.h"
 
 namespace simcore {
 
@@ -118,6 +119,24 @@ class UserTrackInformation : public G4VUserTrackInformation {
    */
   void tagPNGamma(bool isPNGamma = true) { isPNGamma_ = isPNGamma; }
 
+  /**
+   * Check whether this track must be simulated by Geant4 even in a
+   * region with a parameterized shower (see ShowerModel).
+   *
+   * @return true if the track needs the full simulation
+   */
+  bool needsFullSimulation() const { return fullSimulation_; }
+
+  /**
+   * Mark this track for the full simulation by a filter that needs it.
+   *
+   * @param[in] fullSimulation flag indicating whether this track needs
+   *      the full simulation or not.
+   */
+  void setFullSimulation(bool fullSimulation = true) {
+    fullSimulation_ = fullSimulation;
+  }
+
   /**
    * Get the initial momentum 3-vector of the track [MeV].
    *
@@ -128,7 +147,9 @@ class UserTrackInformation : public G4VUserTrackInformation {
   /**
    * Get the name of the volume that this track was created in.
    */
-  std::string getVertexVolume() const { return vertexVolume_; }
+  const std::string& getVertexVolume() const {
+    return NameTags::get().name(vertexVolume_);
+  }
 
   /**
    * Get the global time at which this track was created.
@@ -157,8 +178,11 @@ class UserTrackInformation : public G4VUserTrackInformation {
    */
   bool isPNGamma_{false};
 
-  /// Volume the track was created in.
-  std::string vertexVolume_{""};
+  /// Flag indicating whether this track needs the full simulation
+  bool fullSimulation_{false};
+
+  /// Tag of the name of the volume the track was created in.
+  int vertexVolume_{NameTags::NONE};
 
   /// Global Time of Creation
   double vertex_time_{0.};
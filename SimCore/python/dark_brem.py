@@ -31,6 +31,12 @@ class G4DarkBreMModel(DarkBremModel) :
     a CSV processed by G4DarkBreM, or a gzip-compressed CSV
     processed by G4DarkBreM.
 
+    The library is read and parsed when the process is constructed
+    in every simulation job, which takes the longest for a directory
+    of LHE files. Jobs that share a library should point at the CSV
+    form processed once by G4DarkBreM, which skips parsing the LHE
+    records.
+
     Parameters
     ----------
     library_path : str
@@ -0,0 +1,43 @@
+"""Parameterized EM showers for the fast simulation of a region"""
+
+class ShowerModel:
+    """Configuration of the parameterized showers of a region
+
+    The electrons, positrons and photons above the minimum energy entering
+    the region are killed and their energy is deposited in spots sampled
+    from a Gamma distribution in depth and the Grindhammer radial profile.
+    The spots in sensitive volumes are given to their sensitive detectors.
+    The effective values of the region are starting points to be tuned
+    against the full simulation.
+
+    Parameters
+    ----------
+    region : str
+        Name of the region (from the GDML) the model showers in
+    min_energy : float
+        Minimum kinetic energy of the tracks showered [MeV]
+    spot_energy : float
+        Energy of each spot [MeV]
+    radiation_length : float
+        Effective radiation length of the region [mm]
+    critical_energy : float
+        Effective critical energy of the region [MeV]
+    moliere_radius : float
+        Radius of the radial profile, of the order of the Moliere radius [mm]
+    """
+
+    def __init__(self, region, min_energy, spot_energy, radiation_length,
+                 critical_energy, moliere_radius) :
+        self.instance_name = f'{region}_showers'
+        self.region = region
+        self.min_energy = min_energy
+        self.spot_energy = spot_energy
+        self.radiation_length = radiation_length
+        self.critical_energy = critical_energy
+        self.moliere_radius = moliere_radius
+
+    def calorimeter(min_energy = 100.) :
+        """Showers in the calorimeter region with the averages of the ECal layers"""
+        return ShowerModel('CalorimeterRegion', min_energy, spot_energy = 2.,
+                           radiation_length = 11., critical_energy = 10.,
+                           moliere_radius = 20.)
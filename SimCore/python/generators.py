@@ -90,12 +90,27 @@ class lhe(simcfg.PrimaryGenerator) :
         name of new primary generator
     filePath : str
         path to LHE file containing the primary vertices
+
+    Attributes
+    ----------
+    first_event : int
+        index of the first event read from the file, so that jobs can share
+        one file by reading different ranges of its events
+    index_file : str
+        file the index of the <event> blocks is loaded from, or saved to if
+        it doesn't exist yet, no index file if empty
+    read_ahead : int
+        number of events parsed ahead on a background thread, 0 to parse
+        each event when it is needed
     """
 
     def __init__(self,name,filePath):
         super().__init__(name,'simcore::generators::LHEPrimaryGenerator')
 
         self.filePath = filePath
+        self.first_event = 0
+        self.index_file = ''
+        self.read_ahead = 0
 
 class completeReSim(simcfg.PrimaryGenerator) :
     """New complete re-simprimary generator
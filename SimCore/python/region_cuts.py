@@ -0,0 +1,43 @@
+"""Production cuts and tracking thresholds of a region"""
+
+class RegionCuts:
+    """Configuration of the cuts of a region
+
+    The production cuts are the ranges below which Geant4 doesn't produce
+    secondaries and deposits their energy locally instead. The tracks in
+    the region with a kinetic energy below the kill threshold are killed
+    and their remaining energy is lost. Raising both in the regions where
+    the low energy detail doesn't matter saves a lot of time in background
+    productions. The cuts of the world region are set by the physics list,
+    so only its kill threshold can be changed here.
+
+    Parameters
+    ----------
+    region : str
+        Name of the region (from the GDML) to set the cuts of
+    cut : float, optional
+        Production cut of all of the particles [mm], the Geant4 default
+    gamma : float, optional
+        Production cut of photons [mm], cut if None
+    electron : float, optional
+        Production cut of electrons [mm], cut if None
+    positron : float, optional
+        Production cut of positrons [mm], cut if None
+    proton : float, optional
+        Production cut of protons [mm], cut if None
+    kill_below : float, optional
+        Kinetic energy below which tracks are killed [MeV], none if zero
+    """
+
+    def __init__(self, region, cut = 0.7, gamma = None, electron = None,
+                 positron = None, proton = None, kill_below = 0.) :
+        self.region = region
+        self.gamma = float(cut if gamma is None else gamma)
+        self.electron = float(cut if electron is None else electron)
+        self.positron = float(cut if positron is None else positron)
+        self.proton = float(cut if proton is None else proton)
+        self.kill_below = float(kill_below)
+
+    def magnet(cut = 10., kill_below = 1.) :
+        """Coarse cuts in the magnet where only the tracks leaving it matter"""
+        return RegionCuts('MagnetRegion', cut, kill_below = kill_below)
@@ -13,6 +13,17 @@ class ScoringPlaneSD(simcfg.SensitiveDetector) :
     subsystem : str
         Name of subsystem to store scoring plane hits for
         Names must match what is in gdml for sp_<subsystem>
+
+    Attributes
+    ----------
+    min_kinetic_energy : float
+        Only record particles entering a plane with at least this
+        kinetic energy [MeV]
+    pdg_ids : list[int]
+        Only record particles with these PDG IDs, all particles if empty
+    max_generation : int
+        Only record particles at most this many generations below the primaries
+        (0 for primaries only, 1 for their daughters too), no limit if negative
     """
     def __init__(self,subsystem) :
         super().__init__(f'{subsystem}_sp','simcore::ScoringPlaneSD','SimCore_SDs')
@@ -22,6 +33,11 @@ class ScoringPlaneSD(simcfg.SensitiveDetector) :
         self.collection_name = f'{subsystem[0].upper()+subsystem[1:]}ScoringPlaneHits'
         self.match_substr = f'sp_{subsystem}' #depends on gdml
 
+        # thinning of the recorded crossings, off by default
+        self.min_kinetic_energy = 0.
+        self.pdg_ids = []
+        self.max_generation = -1
+
     def ecal() :
         return ScoringPlaneSD('ecal')
 
@@ -106,11 +122,17 @@ class EcalSD(simcfg.SensitiveDetector) :
         Should the simulation save contributions to Ecal sim hits?
     compressHitContribs : bool, optional
         Should the simulation compress contributions to Ecal sim hits by PDG ID?
+    packHitContribs : bool, optional
+        Should the Ecal sim hits be written as a SimCalorimeterHitCollection,
+        with the contributions of all the hits in shared lists?
+        The EcalDigiProducer and EcalRecProducer reading them need their
+        packed_sim_hits set to match.
     """
     def __init__(self) :
         super().__init__('ecal_sd', 'simcore::EcalSD','SimCore_SDs')
         self.enableHitContribs = True
         self.compressHitContribs = True
+        self.packHitContribs = False
 
 class TrigScintSD(simcfg.SensitiveDetector) :
     """Trigger Scintillaotr Sensitive Detector
@@ -4,7 +4,7 @@ Defines a derived class from ldmxcfg.Producer
 with several helpful member functions.
 """
 
-from LDMX.Framework.ldmxcfg import Producer
+from LDMX.Framework.ldmxcfg import Producer, Process
 
 class _EventToReSim:
     """A class to hold the information identifying a specific event we wish to re-simulate
@@ -76,6 +76,28 @@ class simulator(Producer):
         Use the seed stored in the EventHeader for random generation
     verbosity : int, optional
         Verbosity level to print
+    n_threads : int, optional
+        Number of Geant4 worker threads simulating the events. They share one
+        copy of the geometry and physics tables. The events are still written
+        in order. Generators reading their primaries from a file need one thread.
+    n_events_per_thread : int, optional
+        Number of events each worker thread simulates per batch when running
+        with more than one thread
+    physics_table_cache : str, optional
+        Directory the Geant4 physics tables are stored in by the first job
+        and retrieved from by the later jobs with the same detector and
+        physics list, no cache if empty
+    stacking_energies : list of float, optional
+        Kinetic energies [MeV] splitting the secondaries into stages that are
+        simulated from the highest energies to the lowest, so filters can
+        decide on the event before the low energy tracks are simulated.
+        The secondaries the undecided 'kill_early' actions don't need
+        wait until after the last stage. No stages if empty
+    fast_showers : list of fast_showers.ShowerModel, optional
+        Regions in which the EM showers are parameterized instead of simulated
+    region_cuts : list of region_cuts.RegionCuts, optional
+        Production cuts and kinetic energies below which tracks are killed
+        for each listed region, the others keep the Geant4 defaults
     """
 
     def __init__(self, instance_name ) :
@@ -101,6 +123,12 @@ class simulator(Producer):
         self.rootPrimaryGenUseSeed = False
         self.validate_detector = False
         self.verbosity = 0
+        self.n_threads = 1
+        self.n_events_per_thread = 10
+        self.physics_table_cache = ''
+        self.stacking_energies = [ ]
+        self.fast_showers = [ ]
+        self.region_cuts = [ ]
 
 
         #Dark Brem stuff
@@ -157,7 +185,7 @@ class simulator(Producer):
                 sds.ScoringPlaneSD.magnet()
                 ])
 
-    def resimulate(self, which_events = None, which_runs = None):
+    def resimulate(self, which_events = None, which_runs = None, use_event_index = False):
         """Create a resimulator based on the simulator configuration.
 
         This is intended to ensure that a resimulator has the same configuration
@@ -191,9 +219,16 @@ class simulator(Producer):
             If more than one value is provided, it must be the same length as the
             number of events requested so that the event/run number pair can be required.
 
+        use_event_index : bool, optional
+            Have the process read only the requested events from the input files
+            using their event index instead of reading every event and skipping
+            the ones that weren't requested. The input files need to have been
+            written with eventIndex enabled.
+
         """
         resimulator = self
         resimulator.className = 'simcore::ReSimulator'
+        resimulator.n_threads = 1
         if which_events is None:
             resimulator.resimulate_all_events = True
             resimulator.care_about_run = False
@@ -214,9 +249,13 @@ class simulator(Producer):
                 if len(which_runs) != len(which_events):
                     raise ValueError('which_runs must have the same number of entries as which_events if more than one run is provided')
                 resimulator.care_about_run = True
-                resimulator.runs_to_resimulate = [ _EventToReSim(event, run) for event, run in zip(which_events, which_runs) ]
+                resimulator.events_to_resimulate = [ _EventToReSim(event, run) for event, run in zip(which_events, which_runs) ]
             else:
                 raise ValueError('which_runs must be an int or a list of ints if provided')
         else:
             raise ValueError('which_events must be a list if provided')
+        if use_event_index and not resimulator.resimulate_all_events:
+            if Process.lastProcess is None:
+                raise Exception('The event index can only be used once a Process has been created')
+            Process.lastProcess.indexEvents = resimulator.events_to_resimulate
         return resimulator
@@ -1,7 +1,12 @@
 #include "SimCore/DetectorConstruction.h"
 
 #include "Framework/Exception/Exception.h"
+#include "G4ProductionCuts.hh"
+#include "G4RegionStore.hh"
+#include "G4Threading.hh"
 #include "SimCore/SensitiveDetector.h"
+#include "SimCore/ShowerModel.h"
+#include "SimCore/UserRegionInformation.h"
 #include "SimCore/XsecBiasingOperator.h"
 
 namespace simcore {
@@ -122,10 +127,56 @@ DetectorConstruction::DetectorConstruction(
     : parser_(parser), parameters_{parameters}, conditions_interface_{ci} {}
 
 G4VPhysicalVolume* DetectorConstruction::Construct() {
-  return parser_->GetWorldVolume();
+  auto world{parser_->GetWorldVolume()};
+
+  // the regions are shared by the worker threads, so their cuts are set
+  // once here with the geometry
+  for (auto& cuts :
+       parameters_.getParameter<std::vector<framework::config::Parameters>>(
+           "region_cuts", {})) {
+    auto region_name{cuts.getParameter<std::string>("region")};
+    auto region{G4RegionStore::GetInstance()->GetRegion(region_name, false)};
+    if (not region) {
+      EXCEPTION_RAISE("InvalidConfig",
+                      "No region '" + region_name + "' to set the cuts of.");
+    }
+
+    // Geant4 owns the production cuts and deletes them at the end
+    auto production_cuts{new G4ProductionCuts};  // NOLINT
+    production_cuts->SetProductionCut(cuts.getParameter<double>("gamma"),
+                                      "gamma");
+    production_cuts->SetProductionCut(cuts.getParameter<double>("electron"),
+                                      "e-");
+    production_cuts->SetProductionCut(cuts.getParameter<double>("positron"),
+                                      "e+");
+    production_cuts->SetProductionCut(cuts.getParameter<double>("proton"),
+                                      "proton");
+    region->SetProductionCuts(production_cuts);
+
+    // regions without information (like the world) store their secondaries
+    auto region_info{
+        static_cast<UserRegionInformation*>(region->GetUserInformation())};
+    if (not region_info) {
+      region_info = new UserRegionInformation(true);  // NOLINT
+      region->SetUserInformation(region_info);
+    }
+    region_info->setKillBelow(cuts.getParameter<double>("kill_below"));
+
+    std::cout << "[ DetectorConstruction ] : "
+              << "Setting the cuts of " << region_name << std::endl;
+  }
+
+  return world;
 }
 
 void DetectorConstruction::ConstructSDandField() {
+  // the master thread of a multi-threaded run doesn't simulate events,
+  // only the worker threads need sensitive detectors and biasing
+  if (G4Threading::IsMultithreadedApplication() and
+      G4Threading::IsMasterThread()) {
+    return;
+  }
+
   auto sens_dets{
       parameters_.getParameter<std::vector<framework::config::Parameters>>(
           "sensitive_detectors", {})};
@@ -146,9 +197,37 @@ void DetectorConstruction::ConstructSDandField() {
     }
   }
 
+  // Geant4 keeps the fast simulation models of each region, the worker
+  // threads need their own models just like their own sensitive detectors
+  for (auto& shower :
+       parameters_.getParameter<std::vector<framework::config::Parameters>>(
+           "fast_showers", {})) {
+    auto region_name{shower.getParameter<std::string>("region")};
+    auto region{G4RegionStore::GetInstance()->GetRegion(region_name, false)};
+    if (not region) {
+      EXCEPTION_RAISE("InvalidConfig",
+                      "No region '" + region_name + "' to make showers in.");
+    }
+    new ShowerModel(shower.getParameter<std::string>("instance_name"), region,
+                    shower);
+    std::cout << "[ DetectorConstruction ] : "
+              << "Parameterizing the EM showers in " << region_name
+              << std::endl;
+  }
+
   // Biasing operators were created in RunManager::setupPhysics
   //  which is called before G4RunManager::Initialize
   //  which is where this method ends up being called.
+  // The worker threads of a multi-threaded run need their own operators.
+  if (G4Threading::IsWorkerThread()) {
+    for (auto& bop :
+         parameters_.getParameter<std::vector<framework::config::Parameters>>(
+             "biasing_operators", {})) {
+      simcore::XsecBiasingOperator::Factory::get().make(
+          bop.getParameter<std::string>("class_name"),
+          bop.getParameter<std::string>("instance_name"), bop);
+    }
+  }
   simcore::XsecBiasingOperator::Factory::get().apply([](auto bop) {
     logical_volume_tests::Test includeVolumeTest{nullptr};
     if (bop->getVolumeToBias().compare("ecal") == 0) {
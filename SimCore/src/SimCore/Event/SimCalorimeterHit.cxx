@@ -49,6 +49,14 @@ ClassImp(ldmx::SimCalorimeterHit)
     ++nContribs_;
   }
 
+  void SimCalorimeterHit::reserveContribs(unsigned n) {
+    incidentIDContribs_.reserve(n);
+    trackIDContribs_.reserve(n);
+    pdgCodeContribs_.reserve(n);
+    edepContribs_.reserve(n);
+    timeContribs_.reserve(n);
+  }
+
   SimCalorimeterHit::Contrib SimCalorimeterHit::getContrib(int i) const {
     Contrib contrib;
     contrib.incidentID = incidentIDContribs_.at(i);
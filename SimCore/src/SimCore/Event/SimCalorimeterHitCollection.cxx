@@ -0,0 +1,113 @@
+#include "SimCore/Event/SimCalorimeterHitCollection.h"
+
+// STL
+#include <iostream>
+#include <stdexcept>
+
+ClassImp(ldmx::SimCalorimeterHitCollection)
+
+namespace ldmx {
+
+SimCalorimeterHitCollection::SimCalorimeterHitCollection(
+    std::vector<SimCalorimeterHit> hits) {
+  std::size_t n_contribs{0};
+  for (const auto &hit : hits) n_contribs += hit.getNumberOfContribs();
+  reserve(hits.size(), n_contribs);
+  for (auto &hit : hits) push_back(std::move(hit));
+}
+
+void SimCalorimeterHitCollection::Clear() {
+  hits_.clear();
+  firstContrib_.assign(1, 0);
+  incidentIDs_.clear();
+  trackIDs_.clear();
+  pdgCodes_.clear();
+  edeps_.clear();
+  times_.clear();
+}
+
+void SimCalorimeterHitCollection::Print() const {
+  std::cout << "SimCalorimeterHitCollection { num hits: " << hits_.size()
+            << ", num contribs: " << edeps_.size() << " }" << std::endl;
+}
+
+void SimCalorimeterHitCollection::reserve(std::size_t n_hits,
+                                          std::size_t n_contribs) {
+  hits_.reserve(n_hits);
+  firstContrib_.reserve(n_hits + 1);
+  incidentIDs_.reserve(n_contribs);
+  trackIDs_.reserve(n_contribs);
+  pdgCodes_.reserve(n_contribs);
+  edeps_.reserve(n_contribs);
+  times_.reserve(n_contribs);
+}
+
+void SimCalorimeterHitCollection::push_back(SimCalorimeterHit hit) {
+  incidentIDs_.insert(incidentIDs_.end(), hit.incidentIDContribs_.begin(),
+                      hit.incidentIDContribs_.end());
+  trackIDs_.insert(trackIDs_.end(), hit.trackIDContribs_.begin(),
+                   hit.trackIDContribs_.end());
+  pdgCodes_.insert(pdgCodes_.end(), hit.pdgCodeContribs_.begin(),
+                   hit.pdgCodeContribs_.end());
+  edeps_.insert(edeps_.end(), hit.edepContribs_.begin(),
+                hit.edepContribs_.end());
+  times_.insert(times_.end(), hit.timeContribs_.begin(),
+                hit.timeContribs_.end());
+  // the hit is kept without its lists so it doesn't own any memory
+  hit.incidentIDContribs_ = {};
+  hit.trackIDContribs_ = {};
+  hit.pdgCodeContribs_ = {};
+  hit.edepContribs_ = {};
+  hit.timeContribs_ = {};
+  hit.nContribs_ = 0;
+  hits_.push_back(std::move(hit));
+  firstContrib_.push_back(edeps_.size());
+}
+
+void SimCalorimeterHitCollection::addContrib(const Contrib &contrib) {
+  incidentIDs_.push_back(contrib.incidentID);
+  trackIDs_.push_back(contrib.trackID);
+  pdgCodes_.push_back(contrib.pdgCode);
+  edeps_.push_back(contrib.edep);
+  times_.push_back(contrib.time);
+  firstContrib_.back() = edeps_.size();
+}
+
+SimCalorimeterHitCollection::Contrib SimCalorimeterHitCollection::getContrib(
+    std::size_t i, unsigned j) const {
+  if (j >= getNumberOfContribs(i)) {
+    throw std::out_of_range("SimCalorimeterHitCollection::getContrib");
+  }
+  std::size_t k{firstContrib_[i] + j};
+  Contrib contrib;
+  contrib.incidentID = incidentIDs_[k];
+  contrib.trackID = trackIDs_[k];
+  contrib.pdgCode = pdgCodes_[k];
+  contrib.edep = edeps_[k];
+  contrib.time = times_[k];
+  return contrib;
+}
+
+SimCalorimeterHit SimCalorimeterHitCollection::at(std::size_t i) const {
+  SimCalorimeterHit hit{hits_.at(i)};
+  auto first{firstContrib_[i]}, last{firstContrib_[i + 1]};
+  hit.incidentIDContribs_.assign(incidentIDs_.begin() + first,
+                                 incidentIDs_.begin() + last);
+  hit.trackIDContribs_.assign(trackIDs_.begin() + first,
+                              trackIDs_.begin() + last);
+  hit.pdgCodeContribs_.assign(pdgCodes_.begin() + first,
+                              pdgCodes_.begin() + last);
+  hit.edepContribs_.assign(edeps_.begin() + first, edeps_.begin() + last);
+  hit.timeContribs_.assign(times_.begin() + first, times_.begin() + last);
+  hit.nContribs_ = last - first;
+  return hit;
+}
+
+std::vector<SimCalorimeterHit> SimCalorimeterHitCollection::unpack() const {
+  std::vector<SimCalorimeterHit> hits;
+  hits.reserve(hits_.size());
+  for (std::size_t i{0}; i < hits_.size(); i++) hits.push_back(at(i));
+  return hits;
+}
+
+}  // namespace ldmx
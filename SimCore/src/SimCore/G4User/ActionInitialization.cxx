@@ -0,0 +1,80 @@
+#include "SimCore/G4User/ActionInitialization.h"
+
+/*~~~~~~~~~~~~~*/
+/*   SimCore   */
+/*~~~~~~~~~~~~~*/
+#include "SimCore/G4User/EventAction.h"
+#include "SimCore/G4User/PrimaryGeneratorAction.h"
+#include "SimCore/G4User/RunAction.h"
+#include "SimCore/G4User/StackingAction.h"
+#include "SimCore/G4User/SteppingAction.h"
+#include "SimCore/G4User/TrackingAction.h"
+#include "SimCore/PrimaryGenerator.h"
+#include "SimCore/UserAction.h"
+
+namespace simcore::g4user {
+
+ActionInitialization::ActionInitialization(
+    const framework::config::Parameters& parameters,
+    std::function<void(const G4Event*)> end_of_event)
+    : parameters_{parameters}, end_of_event_{std::move(end_of_event)} {}
+
+void ActionInitialization::BuildForMaster() const {
+  SetUserAction(new RunAction);
+
+  for (auto& generator :
+       parameters_.getParameter<std::vector<framework::config::Parameters>>(
+           "generators", {})) {
+    PrimaryGenerator::Factory::get().make(
+        generator.getParameter<std::string>("class_name"),
+        generator.getParameter<std::string>("instance_name"), generator);
+  }
+}
+
+void ActionInitialization::Build() const {
+  // create our G4User actions
+  auto primary_action{new PrimaryGeneratorAction(parameters_)};
+  auto run_action{new RunAction};
+  auto event_action{new EventAction};
+  auto tracking_action{new TrackingAction};
+  auto stepping_action{new SteppingAction};
+  auto stacking_action{new StackingAction(
+      parameters_.getParameter<std::vector<double>>("stacking_energies", {}))};
+  // ...and register them with G4
+  SetUserAction(primary_action);
+  SetUserAction(run_action);
+  SetUserAction(event_action);
+  SetUserAction(tracking_action);
+  SetUserAction(stepping_action);
+  SetUserAction(stacking_action);
+
+  if (end_of_event_) event_action->setEndOfEventCallback(end_of_event_);
+
+  // Create all user actions and attch them to the corresponding G4 actions
+  auto user_actions{
+      parameters_.getParameter<std::vector<framework::config::Parameters>>(
+          "actions", {})};
+  for (auto& user_action : user_actions) {
+    auto ua = UserAction::Factory::get().make(
+        user_action.getParameter<std::string>("class_name"),
+        user_action.getParameter<std::string>("instance_name"), user_action);
+    for (auto& type : ua->getTypes()) {
+      if (type == simcore::TYPE::RUN) {
+        run_action->registerAction(ua.get());
+      } else if (type == simcore::TYPE::EVENT) {
+        event_action->registerAction(ua.get());
+      } else if (type == simcore::TYPE::TRACKING) {
+        tracking_action->registerAction(ua.get());
+      } else if (type == simcore::TYPE::STEPPING) {
+        stepping_action->registerAction(ua.get());
+      } else if (type == simcore::TYPE::STACKING) {
+        stacking_action->registerAction(ua.get());
+      } else {
+        EXCEPTION_RAISE("ActionType", "Action type does not exist.");
+      }
+    }
+    if (ua->killsEarly()) stacking_action->registerKillEarlyAction(ua.get());
+  }
+}
+
+}  // namespace simcore::g4user
@@ -0,0 +1,49 @@
+#include "SimCore/G4User/ActionTable.h"
+
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "SimCore/NameTags.h"
+
+namespace simcore::g4user {
+
+void ActionTable::add(UserAction* action) {
+  Selection selection{action->getSelection(type_)};
+  Entry entry;
+  auto& tags{NameTags::get()};
+  for (const auto& region : selection.regions)
+    entry.regions.push_back(tags.tag(region));
+  entry.particles = std::move(selection.particles);
+  entry.primaries_only = selection.primaries_only;
+  if (not entry.regions.empty()) selectsRegions_ = true;
+  actions_.push_back(action);
+  entries_.push_back(std::move(entry));
+  // the lists by region are remade with the new action
+  byRegion_.clear();
+  made_.clear();
+}
+
+const std::vector<std::size_t>& ActionTable::inRegionOf(
+    const G4Track* track) {
+  int region{NameTags::NONE};
+  if (selectsRegions_) {
+    if (auto volume{track->GetVolume()}; volume)
+      region = NameTags::get().region(volume->GetLogicalVolume()->GetRegion());
+  }
+  std::size_t slot = region + 1;
+  if (slot >= made_.size()) {
+    byRegion_.resize(slot + 1);
+    made_.resize(slot + 1, false);
+  }
+  if (not made_[slot]) {
+    for (std::size_t i{0}; i < entries_.size(); i++) {
+      const auto& regions{entries_[i].regions};
+      if (regions.empty() or
+          std::find(regions.begin(), regions.end(), region) != regions.end())
+        byRegion_[slot].push_back(i);
+    }
+    made_[slot] = true;
+  }
+  return byRegion_[slot];
+}
+
+}  // namespace simcore::g4user
@@ -37,6 +37,8 @@ void EventAction::EndOfEventAction(const G4Event* event) {
   for (auto& eventAction : eventActions_) {
     eventAction->EndOfEventAction(event);
   }
+
+  if (endOfEventCallback_) endOfEventCallback_(event);
 }
 
 }  // namespace g4user
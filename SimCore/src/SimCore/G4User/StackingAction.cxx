@@ -1,33 +1,94 @@
 #include "SimCore/G4User/StackingAction.h"
 
+#include <algorithm>
+#include <functional>
+
+#include "G4StackManager.hh"
+#include "G4Track.hh"
+
 namespace simcore {
 namespace g4user {
 
+StackingAction::StackingAction(std::vector<double> stage_energies)
+    : stageEnergies_{std::move(stage_energies)} {
+  std::sort(stageEnergies_.begin(), stageEnergies_.end(),
+            std::greater<double>());
+}
+
 G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack(
     const G4Track* track) {
+  // The waiting tracks were already classified by the plugins, only their
+  // stage is looked at again.
+  if (reclassifying_) {
+    return stageOf(track) > stage_ ? G4ClassificationOfNewTrack::fWaiting
+                                   : G4ClassificationOfNewTrack::fUrgent;
+  }
+
   // Default value of a track is fUrgent.
   G4ClassificationOfNewTrack currentTrackClass =
       G4ClassificationOfNewTrack::fUrgent;
 
   // Get proposed new track classification from this plugin.
-  for (auto& stackingAction : stackingActions_) {
+  stackingActions_.forEach(track, [&](UserAction* stackingAction) {
     // Get proposed new track classification from this plugin.
     G4ClassificationOfNewTrack newTrackClass =
         stackingAction->ClassifyNewTrack(track, currentTrackClass);
 
     // Only set the current classification if the plugin changed it.
     if (newTrackClass != currentTrackClass) currentTrackClass = newTrackClass;
+  });
+
+  if (currentTrackClass == G4ClassificationOfNewTrack::fUrgent and
+      stageOf(track) > stage_) {
+    currentTrackClass = G4ClassificationOfNewTrack::fWaiting;
   }
 
   return currentTrackClass;
 }
 
+bool StackingAction::deferUntilDecision(const G4Track* track) const {
+  bool undecided{false};
+  for (auto& action : killEarlyActions_) {
+    if (action->hasPassed()) continue;
+    if (action->neededForDecision(track)) return false;
+    undecided = true;
+  }
+  return undecided;
+}
+
+std::size_t StackingAction::stageOf(const G4Track* track) const {
+  if (track->GetParentID() == 0) return 0;
+  if (deferUntilDecision(track)) return stageEnergies_.size() + 1;
+  // number of stage energies above the energy of the track
+  return std::upper_bound(stageEnergies_.begin(), stageEnergies_.end(),
+                          track->GetKineticEnergy(), std::greater<double>()) -
+         stageEnergies_.begin();
+}
+
 void StackingAction::NewStage() {
-  for (auto& stackingAction : stackingActions_) stackingAction->NewStage();
+  stage_++;
+  if (not stageEnergies_.empty()) {
+    // The waiting tracks were just made urgent, put back the ones of the
+    // later stages. Skip the stages without tracks since Geant4 ends the
+    // event if there are no urgent tracks after a new stage.
+    reclassifying_ = true;
+    stackManager->ReClassify();
+    while (stackManager->GetNUrgentTrack() == 0 and
+           stackManager->GetNWaitingTrack() > 0) {
+      stage_++;
+      stackManager->TransferStackedTracks(fWaiting, fUrgent);
+      stackManager->ReClassify();
+    }
+    reclassifying_ = false;
+  }
+  for (auto& stackingAction : stackingActions_.actions())
+    stackingAction->NewStage();
 }
 
 void StackingAction::PrepareNewEvent() {
-  for (auto& stackingAction : stackingActions_)
+  stage_ = 0;
+  for (auto& action : killEarlyActions_) action->resetDecision();
+  for (auto& stackingAction : stackingActions_.actions())
     stackingAction->PrepareNewEvent();
 }
 
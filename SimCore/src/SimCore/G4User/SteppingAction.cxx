@@ -1,5 +1,7 @@
 #include "SimCore/G4User/SteppingAction.h"
 
+#include "SimCore/UserRegionInformation.h"
+
 namespace simcore::g4user {
 
 void SteppingAction::UserSteppingAction(const G4Step* step) {
@@ -16,6 +18,17 @@ void SteppingAction::UserSteppingAction(const G4Step* step) {
       track_weight_post_step / track_weight_pre_step;
 
   event_info->incWeight(weight_of_this_step_alone);
+  event_info->incStepCount();
+
+  // kill the tracks below the kinetic energy threshold of their region,
+  // the threshold of a region is configured with the region_cuts
+  auto volume{step->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume()};
+  auto region_info{static_cast<UserRegionInformation*>(
+      volume->GetRegion()->GetUserInformation())};
+  if (region_info and step->GetPostStepPoint()->GetKineticEnergy() <
+                          region_info->getKillBelow()) {
+    step->GetTrack()->SetTrackStatus(fStopAndKill);
+  }
 
   const std::vector<const G4Track*>* secondaries{
       step->GetSecondaryInCurrentStep()};
@@ -52,7 +65,9 @@ void SteppingAction::UserSteppingAction(const G4Step* step) {
   }               // secondaries list was created
   // now stepping actions can use getEventInfo()->wasLastStep{P,E}N()
   //  to determine if last step was PN or EN
-  for (auto& steppingAction : steppingActions_) steppingAction->stepping(step);
+  steppingActions_.forEach(step->GetTrack(), [step](UserAction* action) {
+    action->stepping(step);
+  });
 }
 
 }  // namespace simcore::g4user
@@ -2,11 +2,13 @@
 
 // LDMX
 #include "SimCore/TrackMap.h"
+#include "SimCore/UserEventInformation.h"
 #include "SimCore/UserPrimaryParticleInformation.h"
 #include "SimCore/UserRegionInformation.h"
 #include "SimCore/UserTrackInformation.h"
 
 // Geant4
+#include "G4EventManager.hh"
 #include "G4PrimaryParticle.hh"
 #include "G4VUserPrimaryParticleInformation.hh"
 
@@ -56,17 +58,23 @@ void TrackingAction::PreUserTrackingAction(const G4Track* track) {
 
     // insert this track into the event's track map
     trackMap_.insert(track);
+
+    static_cast<UserEventInformation*>(
+        G4EventManager::GetEventManager()->GetUserInformation())
+        ->incTrackCount();
   }
 
   // Activate user tracking actions
-  for (auto& trackingAction : trackingActions_)
-    trackingAction->PreUserTrackingAction(track);
+  trackingActions_.forEach(track, [track](UserAction* action) {
+    action->PreUserTrackingAction(track);
+  });
 }
 
 void TrackingAction::PostUserTrackingAction(const G4Track* track) {
   // Activate user tracking actions
-  for (auto& trackingAction : trackingActions_)
-    trackingAction->PostUserTrackingAction(track);
+  trackingActions_.forEach(track, [track](UserAction* action) {
+    action->PostUserTrackingAction(track);
+  });
 
   /**
    * If a track is to-be saved and it is being killed,
@@ -26,7 +26,11 @@ LHEPrimaryGenerator::LHEPrimaryGenerator(
     const std::string& name, const framework::config::Parameters& parameters)
     : PrimaryGenerator(name, parameters) {
   file_path_ = parameters.getParameter<std::string>("filePath");
-  reader_ = new simcore::lhe::LHEReader(file_path_);
+  first_event_ = parameters.getParameter<int>("first_event", 0);
+  reader_ = new simcore::lhe::LHEReader(
+      file_path_, parameters.getParameter<std::string>("index_file", ""),
+      parameters.getParameter<int>("read_ahead", 0));
+  if (first_event_ > 0) reader_->seek(first_event_);
 }
 
 LHEPrimaryGenerator::~LHEPrimaryGenerator() { delete reader_; }
@@ -111,6 +115,7 @@ void LHEPrimaryGenerator::RecordConfig(const std::string& id,
   rh.setStringParameter(id + " Class",
                         "simcore::generators::LHEPrimaryGenerator");
   rh.setStringParameter(id + " LHE File", file_path_);
+  rh.setIntParameter(id + " First Event", first_event_);
 }
 
 }  // namespace generators
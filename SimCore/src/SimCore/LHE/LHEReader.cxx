@@ -1,38 +1,164 @@
 #include "SimCore/LHE/LHEReader.h"
 
+#include "Framework/Exception/Exception.h"
+
+// POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 // STL
+#include <fstream>
 #include <iostream>
+#include <string_view>
 
 namespace simcore::lhe {
 
-LHEReader::LHEReader(std::string& filename) {
+LHEReader::LHEReader(const std::string& filename, const std::string& indexFile,
+                     std::size_t readAhead)
+    : readAhead_{readAhead} {
   std::cout << "Opening LHE file " << filename << std::endl;
-  ifs_.open(filename.c_str(), std::ifstream::in);
-}
+  int fd{open(filename.c_str(), O_RDONLY)};
+  struct stat info;
+  if (fd < 0 or fstat(fd, &info) != 0) {
+    if (fd >= 0) close(fd);
+    EXCEPTION_RAISE("FileError",
+                    "The LHE file '" + filename + "' can't be read.");
+  }
+  size_ = info.st_size;
+  if (size_ > 0) {
+    void* data{mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0)};
+    if (data == MAP_FAILED) {
+      close(fd);
+      EXCEPTION_RAISE("FileError", "The LHE file '" + filename +
+                                       "' can't be mapped into memory.");
+    }
+    data_ = static_cast<const char*>(data);
+    madvise(data, size_, MADV_SEQUENTIAL);
+  }
+  close(fd);
 
-LHEReader::~LHEReader() { ifs_.close(); }
+  if (size_ >= 2 and static_cast<unsigned char>(data_[0]) == 0x1f and
+      static_cast<unsigned char>(data_[1]) == 0x8b) {
+    munmap(const_cast<char*>(data_), size_);
+    EXCEPTION_RAISE("FileError", "The LHE file '" + filename +
+                                     "' is gzip compressed, decompress it "
+                                     "before reading it.");
+  }
 
-LHEEvent* LHEReader::readNextEvent() {
-  std::string line;
-  bool foundEventElement = false;
-  while (getline(ifs_, line)) {
-    if (line == "<event>") {
-      foundEventElement = true;
-      break;
-    }
+  if (indexFile.empty()) {
+    buildIndex();
+  } else if (not loadIndex(indexFile)) {
+    buildIndex();
+    saveIndex(indexFile);
   }
 
-  if (!foundEventElement) {
+  if (readAhead_ > 0) startParsing();
+}
+
+LHEReader::~LHEReader() {
+  stopParsing();
+  if (data_) munmap(const_cast<char*>(data_), size_);
+}
+
+LHEEvent* LHEReader::readNextEvent() {
+  if (next_ >= offsets_.size()) {
     std::cerr << "WARNING: No next <event> element was found by the LHE reader."
               << std::endl;
     return nullptr;
   }
 
-  getline(ifs_, line);
+  if (readAhead_ == 0) return parseEvent(next_++);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  changed_.wait(lock, [this] { return not queue_.empty() or error_; });
+  if (queue_.empty()) std::rethrow_exception(error_);
+  LHEEvent* event{queue_.front().release()};
+  queue_.pop_front();
+  next_++;
+  lock.unlock();
+  changed_.notify_all();
+  return event;
+}
+
+void LHEReader::seek(std::size_t event) {
+  stopParsing();
+  next_ = event;
+  if (readAhead_ > 0) startParsing();
+}
+
+void LHEReader::buildIndex() {
+  offsets_.clear();
+  if (size_ == 0) return;
+  static constexpr std::string_view element{"<event>\n"};
+  std::string_view file{data_, size_};
+  for (std::size_t pos{file.find(element)}; pos != std::string_view::npos;
+       pos = file.find(element, pos + element.size())) {
+    // only whole lines, as when the file was read line by line
+    if (pos == 0 or file[pos - 1] == '\n') {
+      offsets_.push_back(pos + element.size());
+    }
+  }
+}
+
+bool LHEReader::loadIndex(const std::string& indexFile) {
+  std::ifstream ifs(indexFile, std::ios::binary);
+  std::uint64_t file_size{0}, n_events{0};
+  if (not ifs.read(reinterpret_cast<char*>(&file_size), sizeof(file_size)) or
+      not ifs.read(reinterpret_cast<char*>(&n_events), sizeof(n_events)) or
+      file_size != size_) {
+    return false;
+  }
+  offsets_.resize(n_events);
+  if (not ifs.read(reinterpret_cast<char*>(offsets_.data()),
+                   n_events * sizeof(std::uint64_t))) {
+    offsets_.clear();
+    return false;
+  }
+  for (auto offset : offsets_) {
+    if (offset > size_) {
+      offsets_.clear();
+      return false;
+    }
+  }
+  std::cout << "Loaded the index of " << n_events << " LHE events from "
+            << indexFile << std::endl;
+  return true;
+}
+
+void LHEReader::saveIndex(const std::string& indexFile) const {
+  std::ofstream ofs(indexFile, std::ios::binary | std::ios::trunc);
+  std::uint64_t file_size{size_}, n_events{offsets_.size()};
+  if (not ofs.write(reinterpret_cast<const char*>(&file_size),
+                    sizeof(file_size)) or
+      not ofs.write(reinterpret_cast<const char*>(&n_events),
+                    sizeof(n_events)) or
+      not ofs.write(reinterpret_cast<const char*>(offsets_.data()),
+                    n_events * sizeof(std::uint64_t))) {
+    std::cerr << "WARNING: The index of the LHE events can't be saved to "
+              << indexFile << "." << std::endl;
+  }
+}
+
+LHEEvent* LHEReader::parseEvent(std::size_t event) const {
+  std::string_view file{data_, size_};
+  std::size_t pos{offsets_.at(event)};
+  auto nextLine = [&](std::string& line) {
+    if (pos >= size_) return false;
+    std::size_t end{file.find('\n', pos)};
+    if (end == std::string_view::npos) end = size_;
+    line.assign(data_ + pos, end - pos);
+    pos = end + 1;
+    return true;
+  };
+
+  std::string line;
+  nextLine(line);
 
   LHEEvent* nextEvent = new LHEEvent(line);
 
-  while (getline(ifs_, line)) {
+  while (nextLine(line)) {
     if (line == "</event>" || line == "<mgrwt>") {
       // break if the event ended or in LHE 3.0 if we reach the mgrwt block
       break;
@@ -69,4 +195,46 @@ LHEEvent* LHEReader::readNextEvent() {
   return nextEvent;
 }
 
+void LHEReader::startParsing() {
+  nextParsed_ = next_;
+  stop_ = false;
+  error_ = nullptr;
+  parser_ = std::thread(&LHEReader::parseAhead, this);
+}
+
+void LHEReader::stopParsing() {
+  if (not parser_.joinable()) return;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  changed_.notify_all();
+  parser_.join();
+  queue_.clear();
+}
+
+void LHEReader::parseAhead() {
+  while (true) {
+    std::size_t event;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      changed_.wait(lock,
+                    [this] { return stop_ or queue_.size() < readAhead_; });
+      if (stop_ or nextParsed_ >= offsets_.size()) return;
+      event = nextParsed_++;
+    }
+    try {
+      std::unique_ptr<LHEEvent> parsed{parseEvent(event)};
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(std::move(parsed));
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      error_ = std::current_exception();
+      changed_.notify_all();
+      return;
+    }
+    changed_.notify_all();
+  }
+}
+
 }  // namespace simcore::lhe
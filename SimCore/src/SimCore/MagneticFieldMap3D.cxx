@@ -3,6 +3,7 @@
 #include "Framework/Exception/Exception.h"
 
 // STL
+#include <atomic>
 #include <cmath>
 #include <fstream>
 #include <iostream>
@@ -15,9 +16,32 @@
 using namespace std;
 
 namespace simcore {
+
+namespace {
+
+/**
+ * The field at the corners of the last cell a thread interpolated in
+ */
+struct CellCache {
+  /// id of the map the cell is in, 0 if there isn't one yet
+  std::size_t map{0};
+  /// indices of the lowest corner of the cell
+  int xindex{-1}, yindex{-1}, zindex{-1};
+  /// Bx, By and Bz at the eight corners, one component after the other
+  double b[3][8];
+};
+
+thread_local CellCache cell_cache;
+
+/// id of the next map made
+std::atomic<std::size_t> next_map_id{1};
+
+}  // namespace
+
 MagneticFieldMap3D::MagneticFieldMap3D(const char* filename, double xOffset,
                                        double yOffset, double zOffset)
-    : nx_(0),
+    : id_(next_map_id++),
+      nx_(0),
       ny_(0),
       nz_(0),
       xOffset_(xOffset),
@@ -26,14 +50,6 @@ MagneticFieldMap3D::MagneticFieldMap3D(const char* filename, double xOffset,
       invertX_(false),
       invertY_(false),
       invertZ_(false) {
-  ifstream file(filename);  // Open the file for reading.
-
-  // Throw an error if file does not exist.
-  if (!file.good()) {
-    EXCEPTION_RAISE("FileDNE", "The field map file '" + std::string(filename) +
-                                   "' does not exist!");
-  }
-
   G4cout << "-----------------------------------------------------------"
          << G4endl;
   G4cout << "    Magnetic Field Map 3D" << G4endl;
@@ -44,63 +60,29 @@ MagneticFieldMap3D::MagneticFieldMap3D(const char* filename, double xOffset,
   G4cout << "  Offsets: " << xOffset << " " << yOffset << " " << zOffset
          << G4endl;
 
-  // Ignore first blank line
-  char buffer[256];
-  file.getline(buffer, 256);
-
-  // Read table dimensions
-  file >> nx_ >> ny_ >> nz_;  // Note dodgy order
-
-  G4cout << "  Number of values: " << nx_ << " " << ny_ << " " << nz_ << G4endl;
-
-  // Set up storage space for table
-  xField_.resize(nx_);
-  yField_.resize(nx_);
-  zField_.resize(nx_);
-  int ix, iy, iz;
-  for (ix = 0; ix < nx_; ix++) {
-    xField_[ix].resize(ny_);
-    yField_[ix].resize(ny_);
-    zField_[ix].resize(ny_);
-    for (iy = 0; iy < ny_; iy++) {
-      xField_[ix][iy].resize(nz_);
-      yField_[ix][iy].resize(nz_);
-      zField_[ix][iy].resize(nz_);
-    }
+  // the grid is shared with the other users of the same map
+  map_ = FieldMapFile::get(filename);
+  if (map_->lengthUnit() != 1. or map_->fieldUnit() != 1000.) {
+    EXCEPTION_RAISE("FieldMap", "The field map file '" +
+                                    std::string(filename) +
+                                    "' is not in mm and kT.");
   }
+  nx_ = map_->size(0);
+  ny_ = map_->size(1);
+  nz_ = map_->size(2);
 
-  // Ignore other header information
-  // The first line whose second character is '0' is considered to
-  // be the last line of the header.
-  do {
-    file.getline(buffer, 256);
-  } while (buffer[1] != '0');
-
-  // Read in the data
-  double xval, yval, zval, bx, by, bz;
-  for (ix = 0; ix < nx_; ix++) {
-    for (iy = 0; iy < ny_; iy++) {
-      for (iz = 0; iz < nz_; iz++) {
-        file >> xval >> yval >> zval >> bx >> by >> bz;
-        if (ix == 0 && iy == 0 && iz == 0) {
-          minx_ = xval;
-          miny_ = yval;
-          minz_ = zval;
-        }
-        xField_[ix][iy][iz] = bx;
-        yField_[ix][iy][iz] = by;
-        zField_[ix][iy][iz] = bz;
-      }
-    }
-  }
-  file.close();
+  G4cout << "  Number of values: " << nx_ << " " << ny_ << " " << nz_ << G4endl;
 
-  maxx_ = xval;
-  maxy_ = yval;
-  maxz_ = zval;
+  minx_ = map_->first(0);
+  miny_ = map_->first(1);
+  minz_ = map_->first(2);
+  maxx_ = map_->last(0);
+  maxy_ = map_->last(1);
+  maxz_ = map_->last(2);
 
   G4cout << "  ... done reading " << G4endl << G4endl;
-  G4cout << "Read values of field from file " << filename << G4endl;
+  G4cout << "Read values of field from " << (map_->isBinary() ? "binary " : "")
+         << "file " << filename << G4endl;
   G4cout << "  Assumed the order: x, y, z, Bx, By, Bz" << G4endl;
   G4cout << "  Min values: " << minx_ << " " << miny_ << " " << minz_ << " mm "
          << G4endl;
@@ -200,55 +182,46 @@ void MagneticFieldMap3D::GetFieldValue(const double point[4],
     mulx1z1 = xlocal * zlocal;
 #endif
 
-    // Full 3-dimensional version
-    bfield[0] =
-        xField_[xindex][yindex][zindex] * (1 - xlocal) * (1 - ylocal) *
-            (1 - zlocal) +
-        xField_[xindex][yindex][zindex + 1] * (1 - xlocal) * (1 - ylocal) *
-            zlocal +
-        xField_[xindex][yindex + 1][zindex] * (1 - xlocal) * ylocal *
-            (1 - zlocal) +
-        xField_[xindex][yindex + 1][zindex + 1] * (1 - xlocal) * ylocal *
-            zlocal +
-        xField_[xindex + 1][yindex][zindex] * xlocal * (1 - ylocal) *
-            (1 - zlocal) +
-        xField_[xindex + 1][yindex][zindex + 1] * xlocal * (1 - ylocal) *
-            zlocal +
-        xField_[xindex + 1][yindex + 1][zindex] * xlocal * ylocal *
-            (1 - zlocal) +
-        xField_[xindex + 1][yindex + 1][zindex + 1] * xlocal * ylocal * zlocal;
-    bfield[1] =
-        yField_[xindex][yindex][zindex] * (1 - xlocal) * (1 - ylocal) *
-            (1 - zlocal) +
-        yField_[xindex][yindex][zindex + 1] * (1 - xlocal) * (1 - ylocal) *
-            zlocal +
-        yField_[xindex][yindex + 1][zindex] * (1 - xlocal) * ylocal *
-            (1 - zlocal) +
-        yField_[xindex][yindex + 1][zindex + 1] * (1 - xlocal) * ylocal *
-            zlocal +
-        yField_[xindex + 1][yindex][zindex] * xlocal * (1 - ylocal) *
-            (1 - zlocal) +
-        yField_[xindex + 1][yindex][zindex + 1] * xlocal * (1 - ylocal) *
-            zlocal +
-        yField_[xindex + 1][yindex + 1][zindex] * xlocal * ylocal *
-            (1 - zlocal) +
-        yField_[xindex + 1][yindex + 1][zindex + 1] * xlocal * ylocal * zlocal;
-    bfield[2] =
-        zField_[xindex][yindex][zindex] * (1 - xlocal) * (1 - ylocal) *
-            (1 - zlocal) +
-        zField_[xindex][yindex][zindex + 1] * (1 - xlocal) * (1 - ylocal) *
-            zlocal +
-        zField_[xindex][yindex + 1][zindex] * (1 - xlocal) * ylocal *
-            (1 - zlocal) +
-        zField_[xindex][yindex + 1][zindex + 1] * (1 - xlocal) * ylocal *
-            zlocal +
-        zField_[xindex + 1][yindex][zindex] * xlocal * (1 - ylocal) *
-            (1 - zlocal) +
-        zField_[xindex + 1][yindex][zindex + 1] * xlocal * (1 - ylocal) *
-            zlocal +
-        zField_[xindex + 1][yindex + 1][zindex] * xlocal * ylocal *
-            (1 - zlocal) +
-        zField_[xindex + 1][yindex + 1][zindex + 1] * xlocal * ylocal * zlocal;
+    // Bx, By and Bz at the corners of the cuboid, from the table only if
+    // the point is not in the same cell as the last one of this thread
+    CellCache& cell{cell_cache};
+    if (cell.map != id_ or cell.xindex != xindex or cell.yindex != yindex or
+        cell.zindex != zindex) {
+      const double* corners[8] = {
+          map_->field(xindex, yindex, zindex),
+          map_->field(xindex, yindex, zindex + 1),
+          map_->field(xindex, yindex + 1, zindex),
+          map_->field(xindex, yindex + 1, zindex + 1),
+          map_->field(xindex + 1, yindex, zindex),
+          map_->field(xindex + 1, yindex, zindex + 1),
+          map_->field(xindex + 1, yindex + 1, zindex),
+          map_->field(xindex + 1, yindex + 1, zindex + 1)};
+      for (int c = 0; c < 8; c++) {
+        for (int i = 0; i < 3; i++) cell.b[i][c] = corners[c][i];
+      }
+      cell.map = id_;
+      cell.xindex = xindex;
+      cell.yindex = yindex;
+      cell.zindex = zindex;
+    }
+
+    // Weights of the corners, in the same order
+    const double weights[8] = {(1 - xlocal) * (1 - ylocal) * (1 - zlocal),
+                               (1 - xlocal) * (1 - ylocal) * zlocal,
+                               (1 - xlocal) * ylocal * (1 - zlocal),
+                               (1 - xlocal) * ylocal * zlocal,
+                               xlocal * (1 - ylocal) * (1 - zlocal),
+                               xlocal * (1 - ylocal) * zlocal,
+                               xlocal * ylocal * (1 - zlocal),
+                               xlocal * ylocal * zlocal};
+
+    // Full 3-dimensional version, each component is a dot product of
+    // contiguous arrays the compiler can vectorize
+    for (int i = 0; i < 3; i++) {
+      double sum = 0.;
+      for (int c = 0; c < 8; c++) sum += cell.b[i][c] * weights[c];
+      bfield[i] = sum;
+    }
 
   } else {
     bfield[0] = 0.0;
@@ -0,0 +1,85 @@
+#include "SimCore/NameTags.h"
+
+#include <deque>
+#include <mutex>
+
+#include "G4LogicalVolume.hh"
+#include "G4Region.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VProcess.hh"
+
+namespace simcore {
+
+namespace {
+
+/**
+ * The names with a tag, shared by the registries of all the threads
+ *
+ * The names are kept in a deque so references to them stay valid while
+ * new ones are tagged.
+ */
+struct Names {
+  std::mutex mutex;
+  std::deque<std::string> names;
+  std::unordered_map<std::string, int> tags;
+};
+
+Names& names() {
+  static Names the_names;
+  return the_names;
+}
+
+}  // namespace
+
+NameTags& NameTags::get() {
+  static thread_local NameTags the_tags;
+  return the_tags;
+}
+
+int NameTags::tag(const std::string& name) {
+  auto& table{names()};
+  std::lock_guard<std::mutex> lock(table.mutex);
+  auto it{table.tags.find(name)};
+  if (it != table.tags.end()) return it->second;
+  table.names.push_back(name);
+  return table.tags[name] = table.names.size() - 1;
+}
+
+const std::string& NameTags::name(int tag) const {
+  static const std::string no_name;
+  if (tag < 0) return no_name;
+  auto& table{names()};
+  std::lock_guard<std::mutex> lock(table.mutex);
+  return table.names.at(tag);
+}
+
+template <typename Object>
+int NameTags::cached(std::vector<int>& cache, const Object* object) {
+  if (not object) return NONE;
+  std::size_t id = object->GetInstanceID();
+  if (id >= cache.size()) cache.resize(id + 1, NONE);
+  if (cache[id] == NONE) cache[id] = tag(object->GetName());
+  return cache[id];
+}
+
+int NameTags::region(const G4Region* region) {
+  return cached(regions_, region);
+}
+
+int NameTags::volume(const G4LogicalVolume* volume) {
+  return cached(logicalVolumes_, volume);
+}
+
+int NameTags::volume(const G4VPhysicalVolume* volume) {
+  return cached(physicalVolumes_, volume);
+}
+
+int NameTags::process(const G4VProcess* process) {
+  if (not process) return NONE;
+  auto it{processes_.find(process)};
+  if (it == processes_.end())
+    it = processes_.emplace(process, tag(process->GetProcessName())).first;
+  return it->second;
+}
+
+}  // namespace simcore
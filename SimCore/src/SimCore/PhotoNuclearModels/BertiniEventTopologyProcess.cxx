@@ -1,6 +1,20 @@
 #include "SimCore/PhotoNuclearModels/BertiniEventTopologyProcess.h"
 namespace simcore {
 
+BertiniEventTopologyProcess::~BertiniEventTopologyProcess() {
+  if (acceptance_.empty()) return;
+  std::cout << "[ BertiniEventTopologyProcess ] : Acceptance of the topology"
+            << std::endl;
+  for (const auto& [target_energy, acceptance] : acceptance_) {
+    const auto& [Z, energy] = target_energy;
+    std::cout << "  Z = " << Z << ", " << energy << "-" << energy + 1
+              << " GeV : " << acceptance.interactions << " interactions, "
+              << double(acceptance.interactions) / acceptance.attempts
+              << " of the " << acceptance.attempts << " attempts accepted"
+              << std::endl;
+  }
+}
+
 void BertiniEventTopologyProcess::cleanupSecondaries() {
   int secondaries{theParticleChange.GetNumberOfSecondaries()};
   // Geant4 won't clean up this memory for us by default
@@ -23,6 +37,11 @@ G4HadFinalState* BertiniEventTopologyProcess::ApplyYourself(
     theParticleChange.SetStatusChange(stopAndKill);
     G4CascadeInterface::ApplyYourself(projectile, targetNucleus);
     if (acceptEvent()) {
+      auto& acceptance{
+          acceptance_[{targetNucleus.GetZ_asInt(),
+                       int(projectile.GetKineticEnergy() / CLHEP::GeV)}]};
+      acceptance.interactions++;
+      acceptance.attempts += attempts;
       incrementEventWeight(attempts);
       return &theParticleChange;
     }
@@ -3,6 +3,11 @@
 namespace simcore {
 
 void ReSimulator::configure(framework::config::Parameters& parameters) {
+  // each event is resimulated from its own seed on the calling thread
+  if (parameters.getParameter<int>("n_threads", 1) != 1) {
+    EXCEPTION_RAISE("InvalidParam",
+                    "The resimulation can only be run with one thread.");
+  }
   SimulatorBase::configure(parameters);
   resimulate_all_events_ =
       parameters.getParameter<bool>("resimulate_all_events");
@@ -1,5 +1,9 @@
 #include "SimCore/SDs/EcalSD.h"
 
+// STL
+#include <algorithm>
+#include <numeric>
+
 // Geant4
 #include "G4Polyhedron.hh"
 #include "G4Step.hh"
@@ -21,12 +25,12 @@ EcalSD::EcalSD(const std::string& name, simcore::ConditionsInterface& ci,
     : SensitiveDetector(name, ci, p) {
   enableHitContribs_ = p.getParameter<bool>("enableHitContribs");
   compressHitContribs_ = p.getParameter<bool>("compressHitContribs");
+  packHitContribs_ = p.getParameter<bool>("packHitContribs", false);
 }
 
 G4bool EcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
   static const int layer_depth = 2;  // index depends on GDML implementation
-  const auto& geometry = getCondition<ldmx::EcalGeometry>(
-      ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME);
+  const auto& geometry{*geometry_};
 
   // Get the edep from the step.
   G4double edep = aStep->GetTotalEnergyDeposit();
@@ -53,8 +57,8 @@ G4bool EcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
                    ->GetVolume(layer_depth)
                    ->GetCopyNo();
   int layerNumber;
-  layerNumber = cpynum / 7;
-  int module_position = cpynum % 7;
+  layerNumber = cpynum / ldmx::EcalGeometry::MODULES_PER_LAYER;
+  int module_position = cpynum % ldmx::EcalGeometry::MODULES_PER_LAYER;
   /**
    * DEBUG
    *  this printout is helpful when developing the GDML and/or EcalGeometry
@@ -82,44 +86,65 @@ G4bool EcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
   //    is inside of the configured SD volumes from Geant4's point of view
   // ldmx::EcalID id = geometry.getID(position[0], position[1], position[2]);
 
-  if (hits_.find(id) == hits_.end()) {
+  std::size_t cell{geometry.getCellIndex(id)};
+  int& i_hit{hit_of_cell_[cell]};
+  if (i_hit < 0) {
     // hit in empty cell
-    auto& hit = hits_[id];
-    hit.setID(id.raw());
-    /**
-     * convert position to center of cell position
-     *
-     * This is the behavior that has been done in the past,
-     * although it is completely redundant with the ID information
-     * already deduced. It would probably help us more if we
-     * persisted the actual simulated position of the hit rather
-     * than the cell center; however, that is up for more discussion.
-     */
-    auto [x, y, z] = geometry.getPosition(id);
-    hit.setPosition(x, y, z);
+    i_hit = hit_id_.size();
+    hit_cell_.push_back(cell);
+    hit_id_.push_back(id);
+    hit_edep_.push_back(0.);
+    hit_time_.push_back(0.);
+    hit_first_contrib_.push_back(-1);
+    hit_last_contrib_.push_back(-1);
+    hit_n_contribs_.push_back(0);
   }
 
-  auto& hit = hits_[id];
-
   // hit variables
   auto track = aStep->GetTrack();
   auto time = track->GetGlobalTime();
   auto track_id = track->GetTrackID();
   auto pdg = track->GetParticleDefinition()->GetPDGEncoding();
 
+  // the contributions and sums are done as SimCalorimeterHit does them
   if (enableHitContribs_) {
-    int contrib_i = hit.findContribIndex(track_id, pdg);
-    if (compressHitContribs_ and contrib_i != -1) {
-      hit.updateContrib(contrib_i, edep, time);
+    int contrib_i{-1};
+    if (compressHitContribs_) {
+      for (int i{hit_first_contrib_[i_hit]}; i >= 0; i = contrib_next_[i]) {
+        if (contrib_track_[i] == track_id and contrib_pdg_[i] == pdg) {
+          contrib_i = i;
+          break;
+        }
+      }
+    }
+    if (contrib_i != -1) {
+      contrib_edep_[contrib_i] += float(edep);
+      if (float(time) < contrib_time_[contrib_i])
+        contrib_time_[contrib_i] = time;
     } else {
-      hit.addContrib(getTrackMap().findIncident(track_id), track_id, pdg, edep,
-                     time);
+      contrib_i = contrib_next_.size();
+      contrib_next_.push_back(-1);
+      contrib_incident_.push_back(getTrackMap().findIncident(track_id));
+      contrib_track_.push_back(track_id);
+      contrib_pdg_.push_back(pdg);
+      contrib_edep_.push_back(edep);
+      contrib_time_.push_back(time);
+      if (hit_last_contrib_[i_hit] < 0)
+        hit_first_contrib_[i_hit] = contrib_i;
+      else
+        contrib_next_[hit_last_contrib_[i_hit]] = contrib_i;
+      hit_last_contrib_[i_hit] = contrib_i;
+      hit_n_contribs_[i_hit]++;
+      if (float(time) < hit_time_[i_hit] or hit_time_[i_hit] == 0) {
+        hit_time_[i_hit] = time;
+      }
     }
+    hit_edep_[i_hit] += float(edep);
   } else {
     // no hit contribs and hit already exists
-    hit.setEdep(hit.getEdep() + edep);
-    if (time < hit.getTime() or hit.getTime() == 0) {
-      hit.setTime(time);
+    hit_edep_[i_hit] = hit_edep_[i_hit] + edep;
+    if (time < hit_time_[i_hit] or hit_time_[i_hit] == 0) {
+      hit_time_[i_hit] = time;
     }
   }
 
@@ -127,13 +152,77 @@ G4bool EcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
 }
 
 void EcalSD::saveHits(framework::Event& event) {
-  // squash hits into list
-  std::vector<ldmx::SimCalorimeterHit> hits;
-  hits.reserve(hits_.size());
-  for (const auto& [id, hit] : hits_) hits.push_back(hit);
+  // squash hits into list, ordered by ID
+  hit_order_.resize(hit_id_.size());
+  std::iota(hit_order_.begin(), hit_order_.end(), 0);
+  std::sort(hit_order_.begin(), hit_order_.end(),
+            [&](int lhs, int rhs) { return hit_id_[lhs] < hit_id_[rhs]; });
+
+  if (packHitContribs_) {
+    ldmx::SimCalorimeterHitCollection hits;
+    hits.reserve(hit_order_.size(), contrib_edep_.size());
+    for (int i_hit : hit_order_) {
+      ldmx::SimCalorimeterHit hit;
+      hit.setID(hit_id_[i_hit].raw());
+      auto [x, y, z] = geometry_->getPosition(hit_id_[i_hit]);
+      hit.setPosition(x, y, z);
+      hit.setEdep(hit_edep_[i_hit]);
+      hit.setTime(hit_time_[i_hit]);
+      hits.push_back(std::move(hit));
+      for (int c{hit_first_contrib_[i_hit]}; c >= 0; c = contrib_next_[c]) {
+        hits.addContrib({contrib_incident_[c], contrib_track_[c],
+                         contrib_pdg_[c], contrib_edep_[c], contrib_time_[c]});
+      }
+    }
+    event.add(COLLECTION_NAME, hits);
+    return;
+  }
+
+  std::vector<ldmx::SimCalorimeterHit> hits(hit_order_.size());
+  for (std::size_t i{0}; i < hit_order_.size(); i++) {
+    int i_hit{hit_order_[i]};
+    auto& hit{hits[i]};
+    hit.setID(hit_id_[i_hit].raw());
+    /**
+     * convert position to center of cell position
+     *
+     * This is the behavior that has been done in the past,
+     * although it is completely redundant with the ID information
+     * already deduced. It would probably help us more if we
+     * persisted the actual simulated position of the hit rather
+     * than the cell center; however, that is up for more discussion.
+     */
+    auto [x, y, z] = geometry_->getPosition(hit_id_[i_hit]);
+    hit.setPosition(x, y, z);
+    hit.reserveContribs(hit_n_contribs_[i_hit]);
+    for (int c{hit_first_contrib_[i_hit]}; c >= 0; c = contrib_next_[c]) {
+      hit.addContrib(contrib_incident_[c], contrib_track_[c], contrib_pdg_[c],
+                     contrib_edep_[c], contrib_time_[c]);
+    }
+    // the sums were made step by step
+    hit.setEdep(hit_edep_[i_hit]);
+    hit.setTime(hit_time_[i_hit]);
+  }
   event.add(COLLECTION_NAME, hits);
 }
 
+void EcalSD::OnFinishedEvent() {
+  for (auto cell : hit_cell_) hit_of_cell_[cell] = -1;
+  hit_cell_.clear();
+  hit_id_.clear();
+  hit_edep_.clear();
+  hit_time_.clear();
+  hit_first_contrib_.clear();
+  hit_last_contrib_.clear();
+  hit_n_contribs_.clear();
+  contrib_next_.clear();
+  contrib_incident_.clear();
+  contrib_track_.clear();
+  contrib_pdg_.clear();
+  contrib_edep_.clear();
+  contrib_time_.clear();
+}
+
 }  // namespace simcore
 
 DECLARE_SENSITIVEDETECTOR(simcore::EcalSD)
@@ -35,8 +35,7 @@ ldmx::HcalID HcalSD::decodeCopyNumber(const std::uint32_t copyNumber,
     return ldmx::HcalID{Index(copyNumber).field2(), Index(copyNumber).field1(),
                         Index(copyNumber).field0()};
   }
-  const auto& geometry = getCondition<ldmx::HcalGeometry>(
-      ldmx::HcalGeometry::CONDITIONS_OBJECT_NAME);
+  const auto& geometry{*geometry_};
   unsigned int stripID = 0;
   const unsigned int section = copyNumber / 1000;
   const unsigned int layer = copyNumber % 1000;
@@ -114,7 +113,7 @@ G4bool HcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory* ROhist) {
   edep *= birksFactor;
 
   // Create a new cal hit.
-  ldmx::SimCalorimeterHit& hit{hits_.emplace_back()};
+  Step& hit{steps_.emplace_back()};
 
   // Get the scintillator solid box
   G4Box* scint = static_cast<G4Box*>(aStep->GetPreStepPoint()
@@ -140,7 +139,9 @@ G4bool HcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory* ROhist) {
   G4ThreeVector position =
       0.5 * (prePoint->GetPosition() + postPoint->GetPosition());
   G4ThreeVector localPosition = topTransform.TransformPoint(position);
-  hit.setPosition(position[0], position[1], position[2]);
+  hit.x = position[0];
+  hit.y = position[1];
+  hit.z = position[2];
 
   // Create the ID for the hit. Note 2 here corresponds to the "depth" of the
   // geometry tree. If this changes in the GDML, this would have to be updated
@@ -148,7 +149,7 @@ G4bool HcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory* ROhist) {
   // Hcal, and 2 to the bars/absorbers
   int copyNum = touchableHistory->GetVolume(2)->GetCopyNo();
   ldmx::HcalID id = decodeCopyNumber(copyNum, localPosition, scint);
-  hit.setID(id.raw());
+  hit.id = id;
 
   // add one contributor for this hit with
   //  ID of ancestor incident on Cal-Region
@@ -158,17 +159,18 @@ G4bool HcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory* ROhist) {
   //  time of this hit
   const G4Track* track = aStep->GetTrack();
   int track_id = track->GetTrackID();
-  hit.addContrib(getTrackMap().findIncident(track_id), track_id,
-                 track->GetParticleDefinition()->GetPDGEncoding(), edep,
-                 track->GetGlobalTime());
+  hit.incident_id = getTrackMap().findIncident(track_id);
+  hit.track_id = track_id;
+  hit.pdg = track->GetParticleDefinition()->GetPDGEncoding();
+  hit.edep = edep;
+  hit.time = track->GetGlobalTime();
   //
   // Pre/post step details for scintillator response simulation
 
   // Convert back to mm
-  hit.setPathLength(stepLength * CLHEP::cm / CLHEP::mm);
-  hit.setVelocity(track->GetVelocity());
-  const auto& geometry = getCondition<ldmx::HcalGeometry>(
-      ldmx::HcalGeometry::CONDITIONS_OBJECT_NAME);
+  hit.path_length = stepLength * CLHEP::cm / CLHEP::mm;
+  hit.velocity = track->GetVelocity();
+  const auto& geometry{*geometry_};
   // Convert pre/post step position from global coordinates to coordinates
   // within the scintillator bar
   const auto localPreStepPoint{
@@ -184,21 +186,45 @@ G4bool HcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory* ROhist) {
   auto localPostPositionRotated{geometry.rotateGlobalToLocalBarPosition(
       {localPostStepPoint[0], localPostStepPoint[1], localPostStepPoint[2]},
       id)};
-  hit.setPreStepPosition(localPrePositionRotated[0], localPrePositionRotated[1],
-                         localPrePositionRotated[2]);
-  hit.setPostStepPosition(localPostPositionRotated[0],
-                          localPostPositionRotated[1],
-                          localPostPositionRotated[2]);
-  hit.setPreStepTime(prePoint->GetGlobalTime());
-  hit.setPostStepTime(postPoint->GetGlobalTime());
+  hit.pre_x = localPrePositionRotated[0];
+  hit.pre_y = localPrePositionRotated[1];
+  hit.pre_z = localPrePositionRotated[2];
+  hit.post_x = localPostPositionRotated[0];
+  hit.post_y = localPostPositionRotated[1];
+  hit.post_z = localPostPositionRotated[2];
+  hit.pre_time = prePoint->GetGlobalTime();
+  hit.post_time = postPoint->GetGlobalTime();
 
   if (this->verboseLevel > 2) {
-    hit.Print();
+    std::cout << "SimCalorimeterHit { id: " << id.raw()
+              << ",  edep: " << hit.edep << ", position: ( " << hit.x << ", "
+              << hit.y << ", " << hit.z << " ), num contribs: 1 }"
+              << std::endl;
   }
 
   return true;
 }
 
+void HcalSD::saveHits(framework::Event& event) {
+  std::vector<ldmx::SimCalorimeterHit> hits(steps_.size());
+  for (std::size_t i{0}; i < steps_.size(); i++) {
+    const Step& step{steps_[i]};
+    auto& hit{hits[i]};
+    hit.setID(step.id.raw());
+    hit.setPosition(step.x, step.y, step.z);
+    hit.reserveContribs(1);
+    hit.addContrib(step.incident_id, step.track_id, step.pdg, step.edep,
+                   step.time);
+    hit.setPathLength(step.path_length);
+    hit.setVelocity(step.velocity);
+    hit.setPreStepPosition(step.pre_x, step.pre_y, step.pre_z);
+    hit.setPostStepPosition(step.post_x, step.post_y, step.post_z);
+    hit.setPreStepTime(step.pre_time);
+    hit.setPostStepTime(step.post_time);
+  }
+  event.add(COLLECTION_NAME, hits);
+}
+
 }  // namespace simcore
 
 DECLARE_SENSITIVEDETECTOR(simcore::HcalSD)
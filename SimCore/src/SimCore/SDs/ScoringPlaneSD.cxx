@@ -6,6 +6,7 @@
 /*----------------*/
 /*   C++ StdLib   */
 /*----------------*/
+#include <algorithm>
 #include <iostream>
 
 /*~~~~~~~~~~~~*/
@@ -25,9 +26,34 @@ ScoringPlaneSD::ScoringPlaneSD(const std::string& name,
     : SensitiveDetector(name, ci, params) {
   collection_name_ = params.getParameter<std::string>("collection_name");
   match_substr_ = params.getParameter<std::string>("match_substr");
+  min_kinetic_energy_ = params.getParameter<double>("min_kinetic_energy", 0.);
+  pdg_ids_ = params.getParameter<std::vector<int>>("pdg_ids", {});
+  std::sort(pdg_ids_.begin(), pdg_ids_.end());
+  max_generation_ = params.getParameter<int>("max_generation", -1);
+}
+
+bool ScoringPlaneSD::keep(const G4Step* step) const {
+  if (step->GetPreStepPoint()->GetKineticEnergy() < min_kinetic_energy_)
+    return false;
+  const G4Track* track{step->GetTrack()};
+  if (not pdg_ids_.empty() and
+      not std::binary_search(
+          pdg_ids_.begin(), pdg_ids_.end(),
+          track->GetDynamicParticle()->GetPDGcode()))
+    return false;
+  // primaries have the parent ID 0, which is reached within
+  // max_generation+1 steps up the ancestry
+  if (max_generation_ >= 0 and track->GetParentID() != 0 and
+      not getTrackMap().isDescendant(track->GetTrackID(), 0,
+                                     max_generation_ + 1))
+    return false;
+  return true;
 }
 
 G4bool ScoringPlaneSD::ProcessHits(G4Step* step, G4TouchableHistory* history) {
+  // Skip the crossings we were configured to thin out.
+  if (not keep(step)) return false;
+
   // Get the edep from the step.
   G4double edep = step->GetTotalEnergyDeposit();
 
@@ -0,0 +1,127 @@
+#include "SimCore/ShowerModel.h"
+
+#include <algorithm>
+#include <cmath>
+
+//---< Geant4 >---//
+#include "CLHEP/Random/RandGamma.h"
+#include "G4Electron.hh"
+#include "G4FastStep.hh"
+#include "G4FastTrack.hh"
+#include "G4Gamma.hh"
+#include "G4Material.hh"
+#include "G4Positron.hh"
+#include "G4TouchableHistory.hh"
+#include "G4TransportationManager.hh"
+#include "G4VSensitiveDetector.hh"
+#include "Randomize.hh"
+
+//---< SimCore >---//
+#include "SimCore/UserTrackInformation.h"
+
+namespace simcore {
+
+ShowerModel::ShowerModel(const std::string& name, G4Region* region,
+                         const framework::config::Parameters& parameters)
+    : G4VFastSimulationModel(name, region),
+      touchable_{new G4TouchableHistory} {
+  minEnergy_ = parameters.getParameter<double>("min_energy");
+  spotEnergy_ = parameters.getParameter<double>("spot_energy");
+  radiationLength_ = parameters.getParameter<double>("radiation_length");
+  criticalEnergy_ = parameters.getParameter<double>("critical_energy");
+  moliereRadius_ = parameters.getParameter<double>("moliere_radius");
+}
+
+G4bool ShowerModel::IsApplicable(const G4ParticleDefinition& particle) {
+  return &particle == G4Electron::Definition() or
+         &particle == G4Positron::Definition() or
+         &particle == G4Gamma::Definition();
+}
+
+G4bool ShowerModel::ModelTrigger(const G4FastTrack& fast_track) {
+  const G4Track* track{fast_track.GetPrimaryTrack()};
+  if (track->GetKineticEnergy() < minEnergy_) return false;
+  auto track_info{
+      dynamic_cast<UserTrackInformation*>(track->GetUserInformation())};
+  return not track_info or
+         not(track_info->isBremCandidate() or track_info->isPNGamma() or
+             track_info->needsFullSimulation());
+}
+
+void ShowerModel::DoIt(const G4FastTrack& fast_track, G4FastStep& fast_step) {
+  if (not navigator_.GetWorldVolume()) {
+    auto tracking{G4TransportationManager::GetTransportationManager()
+                      ->GetNavigatorForTracking()};
+    navigator_.SetWorldVolume(tracking->GetWorldVolume());
+  }
+
+  const G4Track* track{fast_track.GetPrimaryTrack()};
+  double energy{track->GetKineticEnergy()};
+  fast_step.KillPrimaryTrack();
+  fast_step.ProposePrimaryTrackPathLength(0.);
+  fast_step.ProposeTotalEnergyDeposited(energy);
+
+  // Gamma distribution in depth [radiation lengths] peaking at the shower
+  //  maximum, which is half a radiation length later for photons
+  static const double beta{0.5};
+  double shower_max{std::log(energy / criticalEnergy_) +
+                    (track->GetDefinition() == G4Gamma::Definition() ? 0.5
+                                                                     : -0.5)};
+  double alpha{1. + beta * std::max(shower_max, 0.)};
+
+  const G4ThreeVector& origin{track->GetPosition()};
+  const G4ThreeVector& direction{track->GetMomentumDirection()};
+  G4ThreeVector across{direction.orthogonal().unit()};
+  G4ThreeVector across_too{direction.cross(across)};
+
+  int n_spots{std::max(1, int(std::ceil(energy / spotEnergy_)))};
+  for (int i{0}; i < n_spots; i++) {
+    double depth{CLHEP::RandGamma::shoot(alpha, beta) * radiationLength_};
+    double u{G4UniformRand()};
+    double radius{moliereRadius_ * std::sqrt(u / (1. - u))};
+    double phi{CLHEP::twopi * G4UniformRand()};
+    G4ThreeVector position{
+        origin + depth * direction +
+        radius * (std::cos(phi) * across + std::sin(phi) * across_too)};
+    deposit(track, position,
+            track->GetGlobalTime() + depth / CLHEP::c_light,
+            energy / n_spots);
+  }
+}
+
+void ShowerModel::deposit(const G4Track* track, const G4ThreeVector& position,
+                          double time, double energy) {
+  navigator_.LocateGlobalPointAndUpdateTouchableHandle(
+      position, G4ThreeVector(), touchable_, false);
+  auto volume{touchable_->GetVolume()};
+  if (not volume) return;
+  auto logical{volume->GetLogicalVolume()};
+  auto sd{logical->GetSensitiveDetector()};
+  if (not sd) return;
+
+  for (auto point : {step_.GetPreStepPoint(), step_.GetPostStepPoint()}) {
+    point->SetPosition(position);
+    point->SetGlobalTime(time);
+    point->SetTouchableHandle(touchable_);
+    point->SetMaterial(logical->GetMaterial());
+  }
+  step_.SetTrack(const_cast<G4Track*>(track));
+  step_.SetStepLength(0.);
+  step_.SetTotalEnergyDeposit(energy * weightIn(logical->GetMaterial()));
+  sd->Hit(&step_);
+}
+
+double ShowerModel::weightIn(const G4Material* material) {
+  auto it{weights_.find(material)};
+  if (it != weights_.end()) return it->second;
+  // Rossi's critical energy with the mean atomic number of the material
+  double z{material->GetTotNbOfElectPerVolume() /
+           material->GetTotNbOfAtomsPerVolume()};
+  double critical_energy{610. * CLHEP::MeV / (z + 1.24)};
+  double weight{(critical_energy / material->GetRadlen()) /
+                (criticalEnergy_ / radiationLength_)};
+  weights_[material] = weight;
+  return weight;
+}
+
+}  // namespace simcore
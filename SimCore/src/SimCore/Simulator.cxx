@@ -25,6 +25,7 @@
 #include "SimCore/Geo/ParserFactory.h"
 #include "SimCore/PrimaryGenerator.h"
 #include "SimCore/SensitiveDetector.h"
+#include "SimCore/UserAction.h"
 #include "SimCore/UserEventInformation.h"
 #include "SimCore/XsecBiasingOperator.h"
 
@@ -34,6 +35,7 @@
 #include "G4BiasingProcessInterface.hh"
 #include "G4CascadeParameters.hh"
 #include "G4Electron.hh"
+#include "G4Event.hh"
 #include "G4GDMLParser.hh"
 #include "G4GeometryManager.hh"
 #include "G4UImanager.hh"
@@ -47,13 +49,35 @@ Simulator::Simulator(const std::string& name, framework::Process& process)
 
 void Simulator::configure(framework::config::Parameters& parameters) {
   SimulatorBase::configure(parameters);
+
+  if (n_threads_ > 1) {
+    n_events_per_thread_ = parameters.getParameter<int>("n_events_per_thread");
+    if (n_events_per_thread_ < 1) {
+      EXCEPTION_RAISE("InvalidParam",
+                      "Each thread needs to simulate at least one event per "
+                      "batch, " +
+                          std::to_string(n_events_per_thread_) +
+                          " was given.");
+    }
+    // all the worker threads would read the same file
+    for (const auto& generator :
+         parameters.getParameter<std::vector<framework::config::Parameters>>(
+             "generators", {})) {
+      auto class_name{generator.getParameter<std::string>("class_name")};
+      if (class_name == "simcore::generators::LHEPrimaryGenerator") {
+        EXCEPTION_RAISE("InvalidParam",
+                        "The primary generator '" + class_name +
+                            "' reads its primaries from a file and can only "
+                            "be run with one thread.");
+      }
+    }
+  }
 }
 
 void Simulator::beforeNewRun(ldmx::RunHeader& header) {
   // Get the detector header from the user detector construction
-  DetectorConstruction* detector =
-      dynamic_cast<RunManager*>(RunManager::GetRunManager())
-          ->getDetectorConstruction();
+  auto detector{static_cast<const DetectorConstruction*>(
+      runManager_->GetUserDetectorConstruction())};
 
   header.setDetectorName(detector->getDetectorName());
   header.setDescription(parameters_.getParameter<std::string>("description"));
@@ -94,6 +118,18 @@ void Simulator::beforeNewRun(ldmx::RunHeader& header) {
                    parameters_.getParameter<std::vector<std::string>>(
                        "postInitCommands", {}));
 
+  for (auto& cuts :
+       parameters_.getParameter<std::vector<framework::config::Parameters>>(
+           "region_cuts", {})) {
+    std::string name{"Region " + cuts.getParameter<std::string>("region")};
+    for (auto particle : {"gamma", "electron", "positron", "proton"}) {
+      header.setFloatParameter(name + " " + particle + " Cut [mm]",
+                               cuts.getParameter<double>(particle));
+    }
+    header.setFloatParameter(name + " Kill Below [MeV]",
+                             cuts.getParameter<double>("kill_below"));
+  }
+
   simcore::XsecBiasingOperator::Factory::get().apply(
       [&header](auto bop) { bop->RecordConfig(header); });
 
@@ -129,6 +165,11 @@ void Simulator::onNewRun(const ldmx::RunHeader& runHeader) {
 }
 
 void Simulator::produce(framework::Event& event) {
+  if (n_threads_ > 1) {
+    produceFromWorkers(event);
+    return;
+  }
+
   // Generate and process a Geant4 event.
   numEventsBegan_++;
   // Save the state of the random engine to an output stream. A string
@@ -166,11 +207,102 @@ void Simulator::produce(framework::Event& event) {
   return;
 }
 
+void Simulator::produceFromWorkers(framework::Event& event) {
+  if (simulated_.empty()) {
+    // the worker threads copy their events into the pool, one per event
+    // of the batch
+    std::size_t batch_size(n_threads_ * n_events_per_thread_);
+    while (spare_events_.size() < batch_size) {
+      spare_events_.emplace_back(
+          std::make_unique<framework::Event>(event.getPassName()));
+    }
+    runManager_->BeamOn(batch_size);
+    if (simulated_.empty()) {
+      EXCEPTION_RAISE("SimAbortedRun",
+                      "The worker threads didn't finish any event.");
+    }
+  }
+
+  // the worker threads are done with the batch, hand out the events in order
+  numEventsBegan_++;
+  auto simulated{std::move(simulated_.begin()->second)};
+  simulated_.erase(simulated_.begin());
+  auto recycle = [this](std::unique_ptr<framework::Event> used) {
+    used->Clear();
+    spare_events_.push_back(std::move(used));
+  };
+
+  // If a Geant4 event has been aborted, skip the rest of the processing
+  // sequence. This will immediately force the simulation to move on to
+  // the next event.
+  if (simulated.aborted) {
+    recycle(std::move(simulated.event));
+    this->abortEvent();  // get out of processors loop
+  }
+
+  numEventsCompleted_++;
+
+  // the simulated event takes the place of the event given by the framework
+  auto& event_header{event.getEventHeader()};
+  auto& simulated_header{simulated.event->getEventHeader()};
+  simulated_header.setEventNumber(event_header.getEventNumber());
+  simulated_header.setRun(event_header.getRun());
+  simulated_header.setTimestamp(event_header.getTimestamp());
+  simulated_header.setRealData(event_header.isRealData());
+  simulated.event->transfer(event);
+
+  recycle(std::move(simulated.event));
+}
+
+void Simulator::endOfWorkerEvent(const G4Event* g4event) {
+  std::unique_ptr<framework::Event> event;
+  {
+    std::lock_guard<std::mutex> lock(simulated_mutex_);
+    event = std::move(spare_events_.back());
+    spare_events_.pop_back();
+  }
+
+  // the tracks and hits are in the TrackMap and SDs of this worker thread
+  bool aborted{g4event->IsAborted()};
+  if (aborted) {
+    SensitiveDetector::Factory::get().apply(
+        [](auto sd) { sd->OnFinishedEvent(); });
+  } else {
+    auto& event_header{event->getEventHeader()};
+    fillEventHeader(event_header, *g4event);
+    // the state of the engine at the start of the event
+    event_header.setStringParameter("eventSeed",
+                                    g4event->GetRandomNumberStatus());
+    saveTracks(*event);
+    saveSDHits(*event);
+  }
+
+  std::lock_guard<std::mutex> lock(simulated_mutex_);
+  simulated_.emplace(g4event->GetEventID(),
+                     SimulatedEvent{std::move(event), aborted});
+}
+
+void Simulator::onCheckpoint(std::ostream& state) {
+  state << numEventsBegan_ << ' ' << numEventsCompleted_ << '\n';
+  G4Random::saveFullState(state);
+}
+
+void Simulator::onResume(std::istream& state) {
+  state >> numEventsBegan_ >> numEventsCompleted_;
+  G4Random::restoreFullState(state);
+}
+
 void Simulator::onProcessEnd() {
   SimulatorBase::onProcessEnd();
   std::cout << "[ Simulator ] : "
             << "Started " << numEventsBegan_ << " events to produce "
             << numEventsCompleted_ << " events." << std::endl;
+  if (not simulated_.empty()) {
+    std::cout << "[ Simulator ] : " << simulated_.size()
+              << " events simulated by the worker threads were not needed."
+              << std::endl;
+  }
+  UserAction::printAbortSummary(std::cout);
 }
 
 void Simulator::setSeeds(std::vector<int> seeds) {
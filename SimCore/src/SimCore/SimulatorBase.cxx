@@ -1,5 +1,20 @@
 #include "SimCore/SimulatorBase.h"
 
+#include <unistd.h>
+
+#include <filesystem>
+#include <functional>
+#include <sstream>
+
+#include "G4Event.hh"
+#include "G4ParticleTable.hh"
+#include "G4ProcessManager.hh"
+#include "G4RunManagerKernel.hh"
+#include "G4Threading.hh"
+#include "G4VUserPhysicsList.hh"
+#include "G4Version.hh"
+#include "SimCore/TaskRunManager.h"
+
 namespace simcore {
 
 const std::vector<std::string> SimulatorBase::invalidCommands_ = {
@@ -16,8 +31,12 @@ SimulatorBase::SimulatorBase(const std::string& name,
   uiManager_ = G4UImanager::GetUIpointer();
 }
 void SimulatorBase::updateEventHeader(ldmx::EventHeader& eventHeader) const {
-  auto event_info = static_cast<UserEventInformation*>(
-      runManager_->GetCurrentEvent()->GetUserInformation());
+  fillEventHeader(eventHeader, *runManager_->GetCurrentEvent());
+}
+void SimulatorBase::fillEventHeader(ldmx::EventHeader& eventHeader,
+                                    const G4Event& g4event) {
+  auto event_info =
+      static_cast<UserEventInformation*>(g4event.GetUserInformation());
 
   eventHeader.setWeight(event_info->getWeight());
   eventHeader.setFloatParameter("total_photonuclear_energy",
@@ -28,8 +47,12 @@ void SimulatorBase::updateEventHeader(ldmx::EventHeader& eventHeader) const {
                                 event_info->getDarkBremMaterialZ());
 }
 void SimulatorBase::onProcessEnd() {
-  runManager_->TerminateEventLoop();
-  runManager_->RunTermination();
+  // the worker threads end each of their runs within BeamOn
+  if (n_threads_ == 1) {
+    runManager_->TerminateEventLoop();
+    runManager_->RunTermination();
+  }
+  if (store_physics_tables_) storePhysicsTables();
   // Delete Run Manager
   // From Geant4 Basic Example B01:
   //      Job termination
@@ -52,6 +75,9 @@ void SimulatorBase::onProcessStart() {
   // initialize run
   runManager_->Initialize();
 
+  // the tables are built (or retrieved) when the first run is initialized
+  if (not physics_table_cache_.empty()) retrievePhysicsTables();
+
   for (const std::string& cmd : postInitCommands_) {
     int g4Ret = uiManager_->ApplyCommand(cmd);
     if (g4Ret > 0) {
@@ -62,6 +88,9 @@ void SimulatorBase::onProcessStart() {
     }
   }
 
+  // BeamOn starts the runs of the worker threads
+  if (n_threads_ > 1) return;
+
   // Instantiate the scoring worlds including any parallel worlds.
   runManager_->ConstructScoringWorlds();
 
@@ -111,6 +140,15 @@ void SimulatorBase::configure(framework::config::Parameters& parameters) {
   // Set the verbosity level.  The default level  is 0.
   verbosity_ = parameters_.getParameter<int>("verbosity");
 
+  n_threads_ = parameters_.getParameter<int>("n_threads", 1);
+  physics_table_cache_ =
+      parameters_.getParameter<std::string>("physics_table_cache", "");
+  if (n_threads_ < 1) {
+    EXCEPTION_RAISE("InvalidParam",
+                    "The simulation needs at least one thread, " +
+                        std::to_string(n_threads_) + " was given.");
+  }
+
   preInitCommands_ =
       parameters_.getParameter<std::vector<std::string>>("preInitCommands", {});
 
@@ -130,7 +168,19 @@ void SimulatorBase::configure(framework::config::Parameters& parameters) {
   // Set up logging before creating the run manager so that output from the
   // creation of the runManager goes to the appropriate place.
   createLogging();
-  runManager_ = std::make_unique<RunManager>(parameters_, conditionsIntf_);
+  if (n_threads_ > 1) {
+#ifdef G4MULTITHREADED
+    runManager_ = std::make_unique<TaskRunManager>(
+        parameters_, n_threads_,
+        [this](const G4Event* g4event) { endOfWorkerEvent(g4event); });
+#else
+    EXCEPTION_RAISE("InvalidParam",
+                    "Geant4 was built without multi-threading, the "
+                    "simulation can only be run with one thread.");
+#endif
+  } else {
+    runManager_ = std::make_unique<RunManager>(parameters_, conditionsIntf_);
+  }
   // Instantiate the class so cascade parameters can be set.
   // TODO: Are we actually using this?
   G4CascadeParameters::Instance();
@@ -196,4 +246,62 @@ void SimulatorBase::buildGeometry() {
   parser->read();
   runManager_->DefineWorldVolume(parser->GetWorldVolume());
 }
+
+void SimulatorBase::retrievePhysicsTables() {
+  // The tables depend on the materials and cuts of the detector, which
+  // Geant4 checks itself when retrieving them, and on the processes
+  // attached to each particle, which make up the key of the cache.
+  std::ostringstream processes;
+  processes << G4VERSION_NUMBER;
+  auto particles{G4ParticleTable::GetParticleTable()->GetIterator()};
+  particles->reset();
+  while ((*particles)()) {
+    auto particle{particles->value()};
+    auto manager{particle->GetProcessManager()};
+    if (not manager) continue;
+    processes << ' ' << particle->GetParticleName();
+    auto process_list{manager->GetProcessList()};
+    for (std::size_t i{0}; i < process_list->size(); i++) {
+      processes << ':' << (*process_list)[i]->GetProcessName();
+    }
+  }
+
+  auto detector{static_cast<const DetectorConstruction*>(
+      runManager_->GetUserDetectorConstruction())};
+  std::ostringstream key;
+  key << detector->getDetectorName() << '_' << std::hex
+      << std::hash<std::string>{}(processes.str());
+  physics_table_dir_ =
+      (std::filesystem::path(physics_table_cache_) / key.str()).string();
+
+  if (std::filesystem::is_directory(physics_table_dir_)) {
+    std::cout << "[ Simulator ] : Retrieving the physics tables from '"
+              << physics_table_dir_ << "'." << std::endl;
+    G4RunManagerKernel::GetRunManagerKernel()
+        ->GetPhysicsList()
+        ->SetPhysicsTableRetrieved(physics_table_dir_);
+  } else {
+    store_physics_tables_ = true;
+  }
+}
+
+void SimulatorBase::storePhysicsTables() {
+  // write to a directory of this job and move it into place, so that jobs
+  // sharing the cache never see (or retrieve) tables being written
+  std::filesystem::path staging{physics_table_dir_ + ".tmp" +
+                                std::to_string(getpid())};
+  std::error_code error;
+  std::filesystem::create_directories(staging, error);
+  bool stored{not error and G4RunManagerKernel::GetRunManagerKernel()
+                                ->GetPhysicsList()
+                                ->StorePhysicsTable(staging.string())};
+  if (stored) std::filesystem::rename(staging, physics_table_dir_, error);
+  if (not stored or error) {
+    // another job stored them first or the cache can't be written
+    std::filesystem::remove_all(staging, error);
+    return;
+  }
+  std::cout << "[ Simulator ] : Stored the physics tables in '"
+            << physics_table_dir_ << "'." << std::endl;
+}
 }  // namespace simcore
@@ -0,0 +1,45 @@
+/**
+ * @file TaskRunManager.cxx
+ * @brief Class providing a multi-threaded Geant4 run manager implementation.
+ */
+
+#include "SimCore/TaskRunManager.h"
+
+//-------------//
+//   ldmx-sw   //
+//-------------//
+#include "SimCore/DetectorConstruction.h"
+#include "SimCore/G4User/ActionInitialization.h"
+#include "SimCore/RunManager.h"
+
+namespace simcore {
+
+TaskRunManager::TaskRunManager(framework::config::Parameters& parameters,
+                               int n_threads,
+                               std::function<void(const G4Event*)> end_of_event)
+    : G4TaskRunManager(), parameters_{parameters},
+      end_of_event_{std::move(end_of_event)} {
+  SetNumberOfThreads(n_threads);
+  // have the workers keep the state of their engine at the start of each
+  // event so that it can be put into the EventHeader as the event seed
+  StoreRandomNumberStatusToG4Event(1);
+}
+
+void TaskRunManager::Initialize() {
+  this->SetUserInitialization(RunManager::makePhysicsList(parameters_));
+
+  RunManager::registerParallelWorld(
+      parameters_, static_cast<DetectorConstruction*>(this->userDetector));
+
+  // the worker threads build their actions when they start
+  SetUserInitialization(
+      new g4user::ActionInitialization(parameters_, [this](const G4Event* event) {
+        end_of_event_(event);
+        // what RunManager::TerminateOneEvent does for the sequential run
+        RunManager::reactivateDarkBrem();
+      }));
+
+  G4TaskRunManager::Initialize();
+}
+
+}  // namespace simcore
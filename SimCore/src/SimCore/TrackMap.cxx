@@ -1,5 +1,12 @@
 #include "SimCore/TrackMap.h"
 
+// STL
+#include <algorithm>
+#include <string>
+
+// LDMX
+#include "Framework/Exception/Exception.h"
+
 // Geant4
 #include "G4Event.hh"
 #include "G4EventManager.hh"
@@ -12,12 +19,9 @@ bool TrackMap::isDescendant(int trackID, int ancestorID,
   int current_track{trackID};
   // Walk the tree until we either no longer have a parent or we reach the
   // desired depth
-  while (current_depth < maximum_depth &&
-         (ancestry_.find(current_track) != ancestry_.end())) {
+  while (current_depth < maximum_depth && contains(current_track)) {
     // See if we have encountered the parent of the current track
-    //
-    // operator[] is not const, so we need to use at()
-    current_track = ancestry_.at(current_track).first;
+    current_track = ancestry_[current_track].parent;
     if (current_track == ancestorID) {
       // If one of the parents is the track of interest, we are done!
       return true;
@@ -27,17 +31,37 @@ bool TrackMap::isDescendant(int trackID, int ancestorID,
   return false;
 }
 void TrackMap::insert(const G4Track* track) {
-  ancestry_[track->GetTrackID()] =
-      std::make_pair(track->GetParentID(), isInCalorimeterRegion(track));
-  descendents_[track->GetParentID()].push_back(track->GetTrackID());
+  int id{track->GetTrackID()}, parent_id{track->GetParentID()};
+  std::size_t n_needed(std::max(id, parent_id) + 1);
+  if (ancestry_.size() < n_needed) ancestry_.resize(n_needed);
+
+  Ancestry& ancestry{ancestry_[id]};
+  ancestry.parent = parent_id;
+  ancestry.in_calorimeter = isInCalorimeterRegion(track);
+
+  // link the track at the end of the children of its parent
+  int child_index = children_.size();
+  children_.push_back(Child{id, -1});
+  Ancestry& parent{ancestry_[parent_id]};
+  if (parent.last_child < 0) {
+    parent.first_child = child_index;
+  } else {
+    children_[parent.last_child].next = child_index;
+  }
+  parent.last_child = child_index;
 }
 
 int TrackMap::findIncident(G4int trackID) const {
   int currTrackID = trackID;
   bool foundIncident{false};
   while (not foundIncident) {
-    auto& [parentID, inCalRegion] = ancestry_.at(currTrackID);
-    if (not inCalRegion or parentID == 0) {
+    if (not contains(currTrackID)) {
+      EXCEPTION_RAISE("TrackMap", "Track " + std::to_string(currTrackID) +
+                                      " has not been inserted.");
+    }
+    const Ancestry& ancestry{ancestry_[currTrackID]};
+    int parentID{ancestry.parent};
+    if (not ancestry.in_calorimeter or parentID == 0) {
       // current track ID is nearest ancestor
       // originating outside cal region
       // or is a primary particle
@@ -109,23 +133,23 @@ void TrackMap::save(const G4Track* track) {
 
 void TrackMap::traceAncestry() {
   for (auto& [id, particle] : particle_map_) {
-    particle.addParent(ancestry_.at(id).first);
-
-    /**
-     * Use [] instead of at() for descendents_
-     * so that if it wasn't previously created,
-     * we will just silently create an empty
-     * vector and move on.
-     */
-    for (auto& child : descendents_[id]) {
-      particle.addDaughter(child);
+    if (not contains(id)) {
+      EXCEPTION_RAISE("TrackMap", "Saved track " + std::to_string(id) +
+                                      " has not been inserted.");
+    }
+    const Ancestry& ancestry{ancestry_[id]};
+    particle.addParent(ancestry.parent);
+
+    for (int i_child{ancestry.first_child}; i_child >= 0;
+         i_child = children_[i_child].next) {
+      particle.addDaughter(children_[i_child].id);
     }
   }
 }
 
 void TrackMap::clear() {
   ancestry_.clear();
-  descendents_.clear();
+  children_.clear();
   particle_map_.clear();
 }
 
@@ -1,6 +1,13 @@
 
 #include "SimCore/UserAction.h"
 
+/*~~~~~~~~~~~~~~~~*/
+/*   C++ StdLib   */
+/*~~~~~~~~~~~~~~~~*/
+#include <map>
+#include <mutex>
+#include <utility>
+
 #include "SimCore/G4User/TrackingAction.h"
 
 /*~~~~~~~~~~~~*/
@@ -8,15 +15,61 @@
 /*~~~~~~~~~~~~*/
 #include "G4Event.hh"
 #include "G4Run.hh"
+#include "G4RunManager.hh"
 #include "G4Step.hh"
 #include "G4Track.hh"
 
 namespace simcore {
 
+namespace {
+
+/// What was simulated of the events an action aborted for one reason
+struct AbortTotals {
+  long n_events{0};
+  long n_tracks{0};
+  long n_steps{0};
+  double time{0.};
+};
+
+/// Totals by action name and reason, shared by all threads
+std::map<std::pair<std::string, std::string>, AbortTotals> abort_totals;
+
+/// Protects abort_totals
+std::mutex abort_totals_mutex;
+
+}  // namespace
+
 UserAction::UserAction(const std::string& name,
                        framework::config::Parameters& parameters) {
   name_ = name;
   parameters_ = parameters;
+  kill_early_ = parameters.getParameter<bool>("kill_early", false);
+}
+
+void UserAction::abortEvent(const std::string& reason) const {
+  auto event_info{getEventInfo()};
+  {
+    std::lock_guard<std::mutex> lock(abort_totals_mutex);
+    AbortTotals& totals{abort_totals[{name_, reason}]};
+    totals.n_events++;
+    totals.n_tracks += event_info->getTrackCount();
+    totals.n_steps += event_info->getStepCount();
+    totals.time += event_info->getElapsedTime();
+  }
+  G4RunManager::GetRunManager()->AbortEvent();
+}
+
+void UserAction::printAbortSummary(std::ostream& out) {
+  std::lock_guard<std::mutex> lock(abort_totals_mutex);
+  for (const auto& [action_reason, totals] : abort_totals) {
+    const auto& [action, reason] = action_reason;
+    out << "[ " << action << " ] : Aborted " << totals.n_events
+        << " events (" << reason << ") after "
+        << double(totals.n_tracks) / totals.n_events << " tracks, "
+        << double(totals.n_steps) / totals.n_events << " steps and "
+        << 1000. * totals.time / totals.n_events
+        << " ms per event (total " << totals.time << " s)." << std::endl;
+  }
 }
 
 UserEventInformation* UserAction::getEventInfo() const {
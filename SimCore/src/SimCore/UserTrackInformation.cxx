@@ -16,7 +16,7 @@ UserTrackInformation* UserTrackInformation::get(const G4Track* track) {
 
 void UserTrackInformation::initialize(const G4Track* track) {
   initialMomentum_ = track->GetMomentum();
-  vertexVolume_ = track->GetLogicalVolumeAtVertex()->GetName();
+  vertexVolume_ = NameTags::get().volume(track->GetLogicalVolumeAtVertex());
   vertex_time_ = track->GetGlobalTime();
 }
 void UserTrackInformation::Print() const {
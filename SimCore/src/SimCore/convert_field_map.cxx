@@ -0,0 +1,36 @@
+#include <iostream>
+
+#include "Framework/Exception/Exception.h"
+#include "SimCore/FieldMapFile.h"
+
+/**
+ * @app convert-field-map
+ *
+ * Converts a text magnetic field map into the binary format that the
+ * simulation and the tracking map into memory instead of parsing.
+ *
+ * Usage: convert-field-map <text map> <binary map>
+ */
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " <text map> <binary map>"
+              << std::endl;
+    return 1;
+  }
+
+  try {
+    simcore::FieldMapFile map(argv[1]);
+    if (map.isBinary()) {
+      std::cerr << "'" << argv[1] << "' is already a binary map." << std::endl;
+      return 1;
+    }
+    map.write(argv[2]);
+    std::cout << "Wrote the " << map.size(0) << " x " << map.size(1) << " x "
+              << map.size(2) << " points of '" << argv[1] << "' to '"
+              << argv[2] << "'" << std::endl;
+  } catch (const framework::exception::Exception& e) {
+    std::cerr << "[" << e.name() << "] " << e.message() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file HgcrocEmulatorBench.cxx
+ * @brief Benchmark the digitization of the HGCROC emulator
+ */
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Conditions/SimpleTableCondition.h"
+#include "Framework/Configure/Parameters.h"
+#include "Recon/Event/HgcrocDigiCollection.h"
+#include "Tools/HgcrocEmulator.h"
+
+namespace ldmx {
+namespace bench {
+
+/// GAIN of the ECal hardcoded conditions [mV/ADC]
+static const double GAIN{320. / 1024 / 20.};
+
+/**
+ * Make the emulator with the ECal settings
+ *
+ * @param[in] pulse_table_step spacing of the tabulated pulse shape [ns],
+ * zero to evaluate the pulse shape function
+ */
+static HgcrocEmulator makeEmulator(double pulse_table_step) {
+  framework::config::Parameters parameters;
+  parameters.addParameter("clockCycle", 25.);
+  parameters.addParameter("timingJitter", 0.25);
+  parameters.addParameter("nADCs", 10);
+  parameters.addParameter("iSOI", 2);
+  parameters.addParameter("rateUpSlope", -0.345);
+  parameters.addParameter("timeUpSlope", 70.6547);
+  parameters.addParameter("rateDnSlope", 0.140068);
+  parameters.addParameter("timeDnSlope", 87.7649);
+  parameters.addParameter("timePeak", 77.732);
+  parameters.addParameter("pulseTableStep", pulse_table_step);
+  parameters.addParameter("noise", false);
+  return HgcrocEmulator(parameters);
+}
+
+/// The chip conditions of the ECal hardcoded conditions, for all channels
+static std::unique_ptr<conditions::DoubleTableCondition> makeConditions() {
+  auto chip_conditions = std::make_unique<conditions::DoubleTableCondition>(
+      "BENCH_HGCROC_TABLE",
+      {"PEDESTAL", "NOISE", "MEAS_TIME", "PAD_CAPACITANCE", "TOT_MAX",
+       "DRAIN_RATE", "GAIN", "READOUT_THRESHOLD", "TOA_THRESHOLD",
+       "TOT_THRESHOLD"});
+  chip_conditions->setIdMask(0);  // all ids are the same
+  chip_conditions->add(0, {50., 0.6, 0.0, 20., 200., 10240. / 200., GAIN,
+                          50. + 3., 50. * GAIN + 5 * 37 * 0.1602 / 20.,
+                          50. * GAIN + 50 * 37 * 0.1602 / 20.});
+  return chip_conditions;
+}
+
+/**
+ * The pulses arriving at each channel of a few events
+ *
+ * The number of hits per channel and their amplitudes follow a falling
+ * spectrum from a fraction of a MIP up into TOT mode like the ECal hits
+ * of the PN sample. They are drawn from a fixed seed, so every run and
+ * every build digitizes the same pulses.
+ */
+static std::vector<std::vector<std::pair<double, double>>> recordedPulses() {
+  std::mt19937 rng(420);
+  std::exponential_distribution<double> log_voltage(1.);
+  std::uniform_real_distribution<double> time(0., 5.);
+  std::discrete_distribution<int> n_hits({70., 20., 7., 3.});
+  std::vector<std::vector<std::pair<double, double>>> pulses(10000);
+  for (auto& channel : pulses) {
+    int n{1 + n_hits(rng)};
+    for (int i{0}; i < n; i++)
+      channel.emplace_back(0.1 * std::exp(log_voltage(rng)), time(rng));
+  }
+  return pulses;
+}
+
+}  // namespace bench
+}  // namespace ldmx
+
+/**
+ * Digitize the recorded pulses, with the pulse shape function (0)
+ * or tabulated (1)
+ */
+static void BM_HgcrocEmulator_digitize(benchmark::State& state) {
+  using namespace ldmx;
+  auto emulator{bench::makeEmulator(state.range(0) ? 0.01 : 0.)};
+  auto chip_conditions{bench::makeConditions()};
+  HgcrocEmulator::Context context(420);
+  context.condition(*chip_conditions);
+  const auto recorded{bench::recordedPulses()};
+
+  std::vector<std::pair<double, double>> pulses;
+  std::vector<HgcrocDigiCollection::Sample> digi;
+  std::size_t n_digitized{0};
+  for (auto _ : state) {
+    for (std::size_t i{0}; i < recorded.size(); i++) {
+      // digitize sorts the pulses, start from the recorded order each time
+      pulses = recorded[i];
+      if (emulator.digitize(context, int(i), pulses, digi)) n_digitized++;
+      benchmark::DoNotOptimize(digi.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * recorded.size());
+  benchmark::DoNotOptimize(n_digitized);
+}
+BENCHMARK(BM_HgcrocEmulator_digitize)->Arg(0)->Arg(1);
+
+/**
+ * Digitize the recorded pulses as one batch with the tabulated pulse
+ * shape, on the input number of threads
+ */
+static void BM_HgcrocEmulator_digitizeBatch(benchmark::State& state) {
+  using namespace ldmx;
+  auto emulator{bench::makeEmulator(0.01)};
+  auto chip_conditions{bench::makeConditions()};
+  HgcrocEmulator::Context context(420);
+  context.condition(*chip_conditions);
+  context.channelStreams(420);
+  const auto recorded{bench::recordedPulses()};
+
+  HgcrocEmulator::Batch batch;
+  for (std::size_t i{0}; i < recorded.size(); i++) {
+    batch.addChannel(int(i));
+    for (const auto& [voltage, time] : recorded[i])
+      batch.addPulse(voltage, time);
+  }
+  for (auto _ : state) {
+    HgcrocDigiCollection digis;
+    digis.setNumSamplesPerDigi(10);
+    emulator.digitize(context, batch, digis, int(state.range(0)));
+    benchmark::DoNotOptimize(digis.getNumDigis());
+  }
+  state.SetItemsProcessed(state.iterations() * recorded.size());
+}
+BENCHMARK(BM_HgcrocEmulator_digitizeBatch)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
@@ -19,6 +19,7 @@
 // class FindableTrackResult;
 namespace ldmx {
 class SimParticle;
+class SimParticleIndex;
 }
 
 namespace Analysis {
@@ -65,6 +66,33 @@ const ldmx::SimParticle *getPNGamma(
     const std::map<int, ldmx::SimParticle> &particleMap,
     const ldmx::SimParticle *recoil, const float &energyThreshold);
 
+/**
+ * Find and return the sim particle associated with the recoil electron.
+ *
+ * @param[in] particles index of the sim particles
+ *
+ * @return[out] slot of the recoil electron in the index and a pointer to it
+ * (NOT_FOUND and nullptr if not found)
+ */
+std::tuple<int, const ldmx::SimParticle *> getRecoil(
+    const ldmx::SimParticleIndex &particles);
+
+/**
+ * Get the slot of the photon that underwent a photo-nuclear reaction.
+ *
+ * Same as getPNGamma with the particle map but the daughters are looked
+ * up in the index.
+ *
+ * @param[in] particles index of the sim particles
+ * @param[in] recoil slot of the recoil electron
+ * @param[in] energyThreshold The energy that the photon energy must be
+ *      greater than.
+ *
+ * @return[out] slot of the PN Gamma photon (NOT_FOUND if not found)
+ */
+int getPNGamma(const ldmx::SimParticleIndex &particles, int recoil,
+               const float &energyThreshold);
+
 }  // namespace Analysis
 
 #endif  // _ANALYSIS_UTILS_H_
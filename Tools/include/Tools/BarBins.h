@@ -0,0 +1,74 @@
+/**
+ * @file BarBins.h
+ * @brief Precomputed edges of equally wide bars
+ */
+
+#ifndef TOOLS_BARBINS_H_
+#define TOOLS_BARBINS_H_
+
+#include <algorithm>
+#include <vector>
+
+namespace ldmx {
+
+/**
+ * @class BarBins
+ * @brief Find the bar a coordinate falls in with a table of the bar edges
+ *
+ * The bars are binWidth wide starting at min, and the edges are computed
+ * once, as min + n*binWidth, up to the first one beyond max. A coordinate
+ * is then binned with a binary search of this table instead of walking the
+ * edges from min, and gets the same bar as it would by walking them: the
+ * index of the bar whose upper edge is the first at or above it, -1 if it
+ * is at or below min, and the number of bars N if it is beyond the last
+ * edge.
+ * ```cpp
+ * ldmx::BarBins bars(20. / 8., -10., 10.);
+ * int bar{bars.bin(x)};
+ * double center{bars.center(bar)};
+ * ```
+ */
+class BarBins {
+ public:
+  /**
+   * @param[in] binWidth width of the bars, must be positive
+   * @param[in] min lower edge of the first bar
+   * @param[in] max the edges go up to the first one beyond this
+   */
+  BarBins(double binWidth, double min, double max)
+      : binWidth_{binWidth}, min_{min} {
+    edges_.push_back(min);
+    for (int n{1};; n++) {
+      edges_.push_back(min + n * binWidth);
+      if (edges_.back() > max) break;
+    }
+  }
+
+  /**
+   * @param[in] coordinate value to bin
+   * @return index of its bar, -1 for underflow and N for overflow
+   */
+  int bin(double coordinate) const {
+    int n = std::lower_bound(edges_.begin(), edges_.end(), coordinate) -
+            edges_.begin();
+    return std::min<int>(n, edges_.size() - 1) - 1;
+  }
+
+  /// @return center of a bar
+  double center(double bar) const { return min_ + (bar + 0.5) * binWidth_; }
+
+  /// @return number of bars before the last edge
+  int size() const { return edges_.size() - 1; }
+
+ private:
+  /// width of the bars
+  double binWidth_;
+  /// lower edge of the first bar
+  double min_;
+  /// edges of the bars, in increasing order
+  std::vector<double> edges_;
+};
+
+}  // namespace ldmx
+
+#endif  // TOOLS_BARBINS_H_
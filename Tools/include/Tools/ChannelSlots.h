@@ -0,0 +1,103 @@
+/**
+ * @file ChannelSlots.h
+ * @brief Dense slots for the channels seen in an event
+ */
+
+#ifndef TOOLS_CHANNELSLOTS_H_
+#define TOOLS_CHANNELSLOTS_H_
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace ldmx {
+
+/**
+ * @class ChannelSlots
+ * @brief Number the channels of an event by a table instead of a map
+ *
+ * Each channel is given the next slot number the first time it is seen,
+ * so per-channel sums can be kept in plain vectors indexed by slot. The
+ * table is indexed directly by the lowest bits of the raw ID, the ones
+ * that hold the fields of the detector's ID, and it is allocated in pages
+ * as they are first used, so only the parts of the ID space a detector
+ * actually uses take memory. clear only resets the entries of the slots
+ * that were handed out, so when it is kept as a member of a processor the
+ * cost of an event depends on its number of channels and not on the size
+ * of the detector.
+ * ```cpp
+ * slots_.clear();
+ * for (const auto& hit : hits) {
+ *   std::size_t s{slots_.slot(hit.getID())};
+ *   if (s == sums_.size()) sums_.push_back(0.);
+ *   sums_[s] += hit.getEnergy();
+ * }
+ * ```
+ */
+class ChannelSlots {
+ public:
+  /**
+   * @param[in] id_bits number of low bits of the raw IDs that tell the
+   * channels apart
+   */
+  explicit ChannelSlots(int id_bits)
+      : mask_{id_bits >= 32 ? ~0u : (1u << id_bits) - 1},
+        pages_((mask_ >> PAGE_BITS) + 1) {}
+
+  /**
+   * Get the slot of a channel, giving it the next one if it is new
+   *
+   * @throws std::invalid_argument if another ID with the same low bits
+   * already has a slot
+   *
+   * @param[in] id raw ID of the channel
+   * @return slot of the channel
+   */
+  std::size_t slot(unsigned int id) {
+    unsigned int key{id & mask_};
+    auto& page{pages_[key >> PAGE_BITS]};
+    if (not page) {
+      page = std::make_unique<int[]>(PAGE_SIZE);
+      for (std::size_t i{0}; i < PAGE_SIZE; i++) page[i] = -1;
+    }
+    int& s{page[key & (PAGE_SIZE - 1)]};
+    if (s < 0) {
+      s = ids_.size();
+      ids_.push_back(id);
+    } else if (ids_[s] != id) {
+      throw std::invalid_argument("ChannelSlots::slot");
+    }
+    return s;
+  }
+
+  /// @return number of slots handed out since the last clear
+  std::size_t size() const { return ids_.size(); }
+
+  /// @return raw ID of the channel in a slot
+  unsigned int id(std::size_t s) const { return ids_[s]; }
+
+  /// forget the channels of the last event
+  void clear() {
+    for (auto id : ids_) {
+      unsigned int key{id & mask_};
+      pages_[key >> PAGE_BITS][key & (PAGE_SIZE - 1)] = -1;
+    }
+    ids_.clear();
+  }
+
+ private:
+  /// number of low bits of the IDs indexing within a page
+  static const int PAGE_BITS = 12;
+  static const std::size_t PAGE_SIZE = std::size_t(1) << PAGE_BITS;
+
+  /// mask of the bits of the IDs that index the table
+  unsigned int mask_;
+  /// slot of each ID in each page, -1 if it has none
+  std::vector<std::unique_ptr<int[]>> pages_;
+  /// ID of each slot, in the order they were handed out
+  std::vector<unsigned int> ids_;
+};
+
+}  // namespace ldmx
+
+#endif  // TOOLS_CHANNELSLOTS_H_
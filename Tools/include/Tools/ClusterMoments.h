@@ -0,0 +1,220 @@
+/**
+ * @file ClusterMoments.h
+ * @brief Weighted moments of the positions of the hits of a cluster
+ */
+
+#ifndef TOOLS_CLUSTERMOMENTS_H_
+#define TOOLS_CLUSTERMOMENTS_H_
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace ldmx {
+
+/**
+ * @class ClusterMoments
+ * @brief Centroid, covariance and principal axes of a cluster in one pass
+ *
+ * The hits are added one at a time and the weighted mean and the sums of
+ * the products of the deviations from it are updated as they come (West's
+ * algorithm), in double precision, so nothing has to be stored per hit and
+ * the spreads don't suffer from the cancellation of <x^2> - <x>^2 for
+ * clusters far from the origin. The principal axes come from a Jacobi
+ * diagonalization of the fixed 3x3 covariance. Coordinates are indexed
+ * 0, 1 and 2 for x, y and z.
+ * ```cpp
+ * ldmx::ClusterMoments moments;
+ * for (const auto& h : hits)
+ *   moments.add(h.getXPos(), h.getYPos(), h.getZPos(), h.getEnergy());
+ * cluster.setCentroidXYZ(moments.centroid(0), moments.centroid(1),
+ *                        moments.centroid(2));
+ * ```
+ */
+class ClusterMoments {
+ public:
+  ClusterMoments() { clear(); }
+
+  /// forget the hits added so far
+  void clear() {
+    n_ = 0;
+    sumw_ = 0.;
+    for (int i{0}; i < 3; i++) {
+      mean_[i] = 0.;
+      min_[i] = std::numeric_limits<double>::max();
+      max_[i] = std::numeric_limits<double>::lowest();
+      for (int j{0}; j < 3; j++) comoment_[i][j] = 0.;
+    }
+  }
+
+  /**
+   * Add a hit
+   *
+   * Hits with a weight of zero are counted and widen the extent but don't
+   * change the moments.
+   *
+   * @param[in] x,y,z position of the hit
+   * @param[in] w weight of the hit
+   */
+  void add(double x, double y, double z, double w = 1.) {
+    const double p[3] = {x, y, z};
+    n_++;
+    for (int i{0}; i < 3; i++) {
+      if (p[i] < min_[i]) min_[i] = p[i];
+      if (p[i] > max_[i]) max_[i] = p[i];
+    }
+    if (w == 0.) return;
+    double sumw{sumw_ + w};
+    double d[3];
+    for (int i{0}; i < 3; i++) {
+      d[i] = p[i] - mean_[i];
+      mean_[i] += d[i] * w / sumw;
+    }
+    // w*(p_i - old mean_i)*(p_j - new mean_j), which is symmetric
+    double f{w * sumw_ / sumw};
+    for (int i{0}; i < 3; i++) {
+      for (int j{i}; j < 3; j++) {
+        comoment_[i][j] += f * d[i] * d[j];
+        comoment_[j][i] = comoment_[i][j];
+      }
+    }
+    sumw_ = sumw;
+  }
+
+  /// @return number of hits added
+  std::size_t size() const { return n_; }
+
+  /// @return sum of the weights of the hits
+  double sumWeights() const { return sumw_; }
+
+  /// @return weighted mean of a coordinate
+  double centroid(int i) const { return mean_[i]; }
+
+  /// @return weighted covariance of two coordinates, <ij> - <i><j>
+  double covariance(int i, int j) const { return comoment_[i][j] / sumw_; }
+
+  /// @return weighted spread of a coordinate, sqrt(<i^2> - <i>^2)
+  double rms(int i) const { return std::sqrt(covariance(i, i)); }
+
+  /// @return smallest value of a coordinate
+  double min(int i) const { return min_[i]; }
+
+  /// @return largest value of a coordinate
+  double max(int i) const { return max_[i]; }
+
+  /**
+   * Slope of the least squares line i = a + b*j through the hits
+   *
+   * The hits enter with their weights, so this is the fit of a graph
+   * without errors only if they were all added with a weight of one.
+   *
+   * @return b
+   */
+  double slope(int i, int j) const {
+    return comoment_[i][j] / comoment_[j][j];
+  }
+
+  /**
+   * Uncertainty on the slope of the least squares line i = a + b*j
+   *
+   * For hits all added with a weight of one this is the usual error of the
+   * slope estimated from the residuals, sqrt(chi2/(n-2)/S_jj), the one ROOT
+   * gives for the fit of a graph without errors.
+   *
+   * @return uncertainty on b
+   */
+  double slopeError(int i, int j) const {
+    double chi2{comoment_[i][i] -
+                comoment_[i][j] * comoment_[i][j] / comoment_[j][j]};
+    if (chi2 < 0.) chi2 = 0.;
+    return std::sqrt(chi2 / (double(n_) - 2.) / comoment_[j][j]);
+  }
+
+  /**
+   * Diagonalize the covariance
+   *
+   * @param[out] values variances along the principal axes, largest first
+   * @param[out] axes unit vectors of the principal axes, axes[k] goes with
+   * values[k]
+   */
+  void principalAxes(std::array<double, 3>& values,
+                     std::array<std::array<double, 3>, 3>& axes) const {
+    double a[3][3], v[3][3];
+    for (int i{0}; i < 3; i++) {
+      for (int j{0}; j < 3; j++) {
+        a[i][j] = covariance(i, j);
+        v[i][j] = i == j ? 1. : 0.;
+      }
+    }
+    // cyclic Jacobi rotations, each zeroes one off-diagonal element
+    for (int sweep{0}; sweep < 50; sweep++) {
+      double off{a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2]};
+      double diag{a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2]};
+      if (not(off > 1e-30 * diag)) break;
+      for (int p{0}; p < 2; p++) {
+        for (int q{p + 1}; q < 3; q++) {
+          if (a[p][q] == 0.) continue;
+          double theta{(a[q][q] - a[p][p]) / (2. * a[p][q])};
+          double t{1. / (std::fabs(theta) + std::sqrt(theta * theta + 1.))};
+          if (theta < 0.) t = -t;
+          double c{1. / std::sqrt(t * t + 1.)}, s{t * c};
+          for (int k{0}; k < 3; k++) {
+            double akp{a[k][p]}, akq{a[k][q]};
+            a[k][p] = c * akp - s * akq;
+            a[k][q] = s * akp + c * akq;
+          }
+          for (int k{0}; k < 3; k++) {
+            double apk{a[p][k]}, aqk{a[q][k]};
+            a[p][k] = c * apk - s * aqk;
+            a[q][k] = s * apk + c * aqk;
+          }
+          for (int k{0}; k < 3; k++) {
+            double vkp{v[k][p]}, vkq{v[k][q]};
+            v[k][p] = c * vkp - s * vkq;
+            v[k][q] = s * vkp + c * vkq;
+          }
+        }
+      }
+    }
+    // order by decreasing variance, the eigenvectors are the columns of v
+    int order[3] = {0, 1, 2};
+    for (int i{0}; i < 3; i++) {
+      for (int j{i + 1}; j < 3; j++) {
+        if (a[order[j]][order[j]] > a[order[i]][order[i]]) {
+          int tmp{order[i]};
+          order[i] = order[j];
+          order[j] = tmp;
+        }
+      }
+    }
+    for (int k{0}; k < 3; k++) {
+      values[k] = a[order[k]][order[k]];
+      for (int i{0}; i < 3; i++) axes[k][i] = v[i][order[k]];
+    }
+  }
+
+  /// @return unit vector along which the cluster is the most spread
+  std::array<double, 3> principalAxis() const {
+    std::array<double, 3> values;
+    std::array<std::array<double, 3>, 3> axes;
+    principalAxes(values, axes);
+    return axes[0];
+  }
+
+ private:
+  /// number of hits
+  std::size_t n_;
+  /// sum of the weights
+  double sumw_;
+  /// weighted mean of each coordinate
+  double mean_[3];
+  /// sums of w*(i-<i>)*(j-<j>)
+  double comoment_[3][3];
+  /// extent of each coordinate
+  double min_[3], max_[3];
+};
+
+}  // namespace ldmx
+
+#endif  // TOOLS_CLUSTERMOMENTS_H_
@@ -9,10 +9,11 @@
 #ifndef TOOLS_ELECTRONICSMAP_H_
 #define TOOLS_ELECTRONICSMAP_H_
 
-#include <map>
 #include <sstream>
 #include <vector>
 
+#include "DetDescr/IDMap.h"
+
 namespace ldmx {
 
 /**
@@ -21,6 +22,11 @@ namespace ldmx {
  * A class for efficient mapping between electronics IDs (using packed index
  * techniques) and detector IDs which are arbitrarily formatted.
  *
+ * The electronics IDs index a flat array of detector IDs and, if requested,
+ * the detector IDs are hashed into an IDMap of electronics indices. A map is filled
+ * once when its conditions object is created and is only read afterwards,
+ * so it can be shared by several threads.
+ *
  * @tparam[in] ElectronicsID class of electronics ID
  * @tparam[in] DetID class of detector IDs
  */
@@ -28,7 +34,7 @@ template <class ElectronicsID, class DetID>
 class ElectronicsMap {
  public:
   ElectronicsMap(bool want_d2e = false)
-      : eid2did_{ElectronicsID::MAX_INDEX, 0}, makeD2E_(want_d2e) {}
+      : eid2did_(ElectronicsID::MAX_INDEX, 0), makeD2E_(want_d2e) {}
 
   /**
    * Remove all entries from the map
@@ -50,7 +56,8 @@ class ElectronicsMap {
                           " which is larger than allowed in this map");
     }
     eid2did_[index] = did.raw();
-    if (makeD2E_) did2eid_.insert(std::make_pair(did.raw(), eid));
+    // the first entry for a detector id is kept, like a map would
+    if (makeD2E_ && !did.null()) did2eid_.emplace(did, index);
   }
 
   /**
@@ -67,7 +74,7 @@ class ElectronicsMap {
    */
   bool exists(DetID did) const {
     if (makeD2E_) {
-      return did2eid_.find(did.raw()) == did2eid_.end();
+      return did2eid_.contains(did);
     } else {
       for (auto i : eid2did_) {
         if (i == did.raw()) return true;
@@ -94,13 +101,13 @@ class ElectronicsMap {
    */
   ElectronicsID get(DetID did) const {
     if (makeD2E_) {
-      auto itr = did2eid_.find(did.raw());
-      if (itr == did2eid_.end()) {
+      const unsigned int* index = did2eid_.find(did);
+      if (index == nullptr) {
         std::stringstream ss;
         ss << "Unable to find mapping for det id " << did;
         EXCEPTION_RAISE("ElectronicsMapNotFound", ss.str());
       }
-      return itr->second;
+      return ElectronicsID::idFromIndex(*index);
     } else {
       for (unsigned int i = 0; i < eid2did_.size(); i++) {
         if (eid2did_[i] == did.raw()) return ElectronicsID::idFromIndex(i);
@@ -122,9 +129,9 @@ class ElectronicsMap {
   bool makeD2E_;
 
   /**
-   * Log(N) map for raw detector id to electronics id
+   * Map from detector id to electronics index, only filled if makeD2E_
    */
-  std::map<DetectorID::RawValue, ElectronicsID> did2eid_;
+  IDMap<DetID, unsigned int> did2eid_;
 };
 
 }  // namespace ldmx
@@ -0,0 +1,92 @@
+/**
+ * @file EmptyChannelSampler.h
+ * @brief Draw the channels to put noise hits into
+ */
+
+#ifndef TOOLS_EMPTYCHANNELSAMPLER_H_
+#define TOOLS_EMPTYCHANNELSAMPLER_H_
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+class TRandom;
+
+namespace ldmx {
+
+/**
+ * @class EmptyChannelSampler
+ * @brief Draws distinct channels uniformly among those without a hit
+ *
+ * The channels of a detector are numbered densely (their index) in the
+ * order of their IDs. The channels with a hit are marked in a bitset and
+ * k of the others are drawn with a partial Fisher-Yates shuffle of the
+ * empty indices in which only the swapped entries are stored. There is no
+ * rejection of filled channels or of channels already drawn, so drawing
+ * costs O(k) whatever the occupancy, on top of O(log N) to mark each of
+ * the filled channels.
+ *
+ * The empty indices are numbered 0 to m-1 (m empty channels) by keeping
+ * the empty indices below m as they are and pairing the filled indices
+ * below m with the empty indices above it.
+ * ```cpp
+ * ldmx::EmptyChannelSampler sampler(all_channel_ids);
+ * for (unsigned int id : sampler.sample(filled_ids, n_noise_hits, rng)) {
+ *   // put a noise hit in channel id
+ * }
+ * ```
+ */
+class EmptyChannelSampler {
+ public:
+  /**
+   * Make the sampler of a detector
+   *
+   * @param[in] channels IDs of all channels of the detector, in any order
+   */
+  explicit EmptyChannelSampler(std::vector<unsigned int> channels);
+
+  /// Number of channels of the detector
+  std::size_t size() const { return channels_.size(); }
+
+  /**
+   * Draw distinct channels without a hit
+   *
+   * @param[in] filled IDs of the channels with a hit, IDs that aren't
+   * channels of the detector and duplicates are ignored
+   * @param[in] k number of channels to draw, at most the number of empty
+   * channels are drawn
+   * @param[in] rng random number generator to draw with
+   * @return IDs of the channels drawn in the order they were drawn,
+   * valid until the next call
+   */
+  template <typename Filled>
+  const std::vector<unsigned int>& sample(const Filled& filled, std::size_t k,
+                                          TRandom& rng) {
+    for (unsigned int id : filled) mark(id);
+    return draw(k, rng);
+  }
+
+ private:
+  /// mark a channel as filled if it is one of the detector
+  void mark(unsigned int id);
+
+  /// draw among the channels not marked and clear the marks
+  const std::vector<unsigned int>& draw(std::size_t k, TRandom& rng);
+
+  /// IDs of the channels, sorted, by index
+  std::vector<unsigned int> channels_;
+  /// which channel indices are filled in this event
+  std::vector<bool> isFilled_;
+  /// the filled channel indices of this event, in the order marked
+  std::vector<std::size_t> filled_;
+  /// the empty channel index each filled index below m stands for
+  std::unordered_map<std::size_t, std::size_t> standIn_;
+  /// the entries of the partial shuffle that were swapped
+  std::unordered_map<std::size_t, std::size_t> swapped_;
+  /// the channels drawn
+  std::vector<unsigned int> drawn_;
+};
+
+}  // namespace ldmx
+
+#endif  // TOOLS_EMPTYCHANNELSAMPLER_H_
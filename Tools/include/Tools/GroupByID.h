@@ -0,0 +1,118 @@
+/**
+ * @file GroupByID.h
+ * @brief Group the elements of a collection by their detector ID
+ */
+
+#ifndef TOOLS_GROUPBYID_H_
+#define TOOLS_GROUPBYID_H_
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace ldmx {
+
+/**
+ * @class GroupByID
+ * @brief Group the elements of a collection by an ID without a map
+ *
+ * The usual way to group hits that share a channel is a
+ * std::map<ID, std::vector<Hit>>, which allocates a node and a vector for
+ * every channel in every event. Here the indices of the elements are
+ * sorted by their ID instead and the groups are the runs of equal IDs.
+ * The grouping keeps its buffers, so when it is kept as a member of a
+ * processor and handed a new collection each event, it stops allocating
+ * once it has seen the largest event.
+ *
+ * The groups come out in ascending ID order and the indices within a
+ * group in the order the elements were given, the same as inserting
+ * them into a map of vectors.
+ * ```cpp
+ * grouping_.group(hits.size(),
+ *                 [&](std::size_t i) { return hits[i].getID(); });
+ * for (std::size_t g{0}; g < grouping_.size(); g++) {
+ *   for (auto i : grouping_.indices(g)) use(grouping_.id(g), hits[i]);
+ * }
+ * ```
+ */
+class GroupByID {
+ public:
+  /**
+   * The indices of the elements in one group
+   *
+   * Only valid until the next call to group.
+   */
+  class Indices {
+   public:
+    Indices(const unsigned int* first, const unsigned int* last)
+        : first_{first}, last_{last} {}
+    const unsigned int* begin() const { return first_; }
+    const unsigned int* end() const { return last_; }
+    std::size_t size() const { return last_ - first_; }
+    unsigned int operator[](std::size_t i) const { return first_[i]; }
+    /// @throws std::out_of_range if i is not in the group
+    unsigned int at(std::size_t i) const {
+      if (i >= size()) throw std::out_of_range("GroupByID::Indices::at");
+      return first_[i];
+    }
+
+   private:
+    const unsigned int *first_, *last_;
+  };
+
+  /**
+   * Group the n elements of a collection
+   *
+   * @tparam GetID callable taking an element index and returning its ID
+   * @param[in] n number of elements
+   * @param[in] get_id ID of each element
+   */
+  template <typename GetID>
+  void group(std::size_t n, GetID get_id) {
+    keys_.clear();
+    keys_.reserve(n);
+    for (std::size_t i{0}; i < n; i++)
+      keys_.emplace_back(get_id(i), static_cast<unsigned int>(i));
+    // the index is part of the key so equal IDs stay in input order
+    std::sort(keys_.begin(), keys_.end());
+
+    ids_.clear();
+    starts_.clear();
+    indices_.resize(n);
+    for (std::size_t k{0}; k < n; k++) {
+      if (k == 0 or keys_[k].first != keys_[k - 1].first) {
+        ids_.push_back(keys_[k].first);
+        starts_.push_back(k);
+      }
+      indices_[k] = keys_[k].second;
+    }
+    starts_.push_back(n);
+  }
+
+  /// @return number of groups (distinct IDs)
+  std::size_t size() const { return ids_.size(); }
+
+  /// @return the ID shared by the elements of group g
+  unsigned int id(std::size_t g) const { return ids_[g]; }
+
+  /// @return the indices of the elements in group g
+  Indices indices(std::size_t g) const {
+    return Indices(indices_.data() + starts_[g],
+                   indices_.data() + starts_[g + 1]);
+  }
+
+ private:
+  /// (ID, index) of each element, sorted
+  std::vector<std::pair<unsigned int, unsigned int>> keys_;
+  /// element indices in grouped order
+  std::vector<unsigned int> indices_;
+  /// ID of each group
+  std::vector<unsigned int> ids_;
+  /// start of each group in indices_, with the total at the end
+  std::vector<std::size_t> starts_;
+};
+
+}  // namespace ldmx
+
+#endif  // TOOLS_GROUPBYID_H_
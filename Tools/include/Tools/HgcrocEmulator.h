@@ -2,6 +2,9 @@
 #ifndef TOOLS_HGCROCEMULATOR_H
 #define TOOLS_HGCROCEMULATOR_H
 
+#include <array>
+#include <cmath>
+
 #include "Conditions/SimpleTableCondition.h"
 #include "Framework/Configure/Parameters.h"
 #include "Recon/Event/HgcrocDigiCollection.h"
@@ -11,7 +14,6 @@
 //----------//
 //   ROOT   //
 //----------//
-#include "TF1.h"
 #include "TRandom3.h"
 
 namespace ldmx {
@@ -30,6 +32,19 @@ namespace ldmx {
  * voltages. These tasks depend on the detector construction,
  * so they are left to the individual subsystem producers.
  *
+ * The emulator is not changed by digitizing, so one emulator can be shared
+ * by several threads. Everything that changes while digitizing (the chip
+ * conditions, the noise generator and the buffers reused for each channel)
+ * is kept in a Context, of which each thread digitizing has its own.
+ * ```cpp
+ * HgcrocEmulator::Context context(seed);
+ * context.condition(table);  // every event
+ * emulator.digitize(context, channel, pulses, digi);
+ * ```
+ *
+ * The channels of an event can also be gathered into a Batch and digitized
+ * together, spread over several threads.
+ *
  * @TODO time phase setting relative to target t=0ns using electronic IDs
  *
  * @TODO accurately model recovering from saturation (TOT Mode).
@@ -45,35 +60,194 @@ class HgcrocEmulator {
    */
   HgcrocEmulator(const framework::config::Parameters& ps);
 
-  /** Destructor */
-  ~HgcrocEmulator() {}
-
   /**
-   * Check if emulator has been seeded
-   * @return true if random generator has been seeded
+   * Context
+   *
+   * The state of a digitization: the conditions of the chips, the
+   * generator of the noise and the buffers reused for each channel.
+   * A context may only be used by one thread at a time.
    */
-  bool hasSeed() const { return noiseInjector_.get() != nullptr; }
+  class Context {
+   public:
+    /// The chip conditions we use, the names of their table columns
+    enum Column {
+      TOT_MAX,
+      PAD_CAPACITANCE,
+      GAIN,
+      PEDESTAL,
+      TOA_THRESHOLD,
+      TOT_THRESHOLD,
+      MEAS_TIME,
+      DRAIN_RATE,
+      READOUT_THRESHOLD,
+      NOISE,
+      N_COLUMNS
+    };
 
-  /**
-   * Seed the emulator for random number generation
-   * @param[in] seed integer to use as random seed
-   */
-  void seedGenerator(uint64_t seed);
+    /**
+     * Constructor
+     *
+     * @param[in] seed integer to use as random seed of the noise
+     */
+    explicit Context(uint64_t seed) : noiseInjector_(seed) {}
+
+    /**
+     * Set Conditions
+     *
+     * Passes the chips conditions to be used in digitization. The column
+     * numbers are looked up again only if the table changes.
+     *
+     * @param table conditions::DoubleTableConditions to be used for chip
+     * parameters
+     */
+    void condition(const conditions::DoubleTableCondition& table);
+
+    /**
+     * Get condition for input chip ID
+     *
+     * @param[in] id chip global integer ID used in condition table
+     * @param[in] column which chip parameter to get
+     * @return value of chip parameter
+     */
+    double get(int id, Column column) const {
+      // check if we have been passed a table of conditions
+      if (!chipConditions_) {
+        EXCEPTION_RAISE("HgcrocCond",
+                        "HGC ROC Emulator was not given a conditions table.");
+      }
+      return chipConditions_->get(id, columns_[column]);
+    }
+
+    /// Gain for input channel
+    double gain(const int& channelID) const { return get(channelID, GAIN); }
+
+    /// Pedestal [ADC Counts] for input channel
+    double pedestal(const int& id) const { return get(id, PEDESTAL); }
+
+    /// Readout Threshold (ADC Counts)
+    double readoutThreshold(const int& id) const {
+      return get(id, READOUT_THRESHOLD);
+    }
+
+    /**
+     * Draw the noise of each channel of a Batch from a stream of its own
+     *
+     * The noise generator is reseeded from the input seed and the channel
+     * ID before each channel of a Batch is digitized, so the noise of a
+     * channel depends neither on the channels digitized before it nor on
+     * the thread digitizing it. The seed should change every event. After
+     * a Batch, the generator is left at a stream of the seed alone.
+     *
+     * @param[in] seed seed of the streams of the channels
+     */
+    void channelStreams(uint64_t seed) {
+      streamSeed_ = seed;
+      channelStreams_ = true;
+    }
+
+    /// Check if the noise of a Batch is drawn from a stream per channel
+    bool hasChannelStreams() const { return channelStreams_; }
+
+   private:
+    friend class HgcrocEmulator;
+
+    /// Reseed the noise generator with the stream of the input channel
+    void seedChannel(int channelID);
+
+    /// Handle to table of chip-dependent conditions
+    const conditions::DoubleTableCondition* chipConditions_{nullptr};
+
+    /// Column number of each of the conditions in the table
+    std::array<unsigned int, N_COLUMNS> columns_{};
+
+    /// Generates Gaussian noise on top of real hits
+    TRandom3 noiseInjector_;
+
+    /**
+     * Times and voltages of the samples of the digi being emulated
+     *
+     * Kept so that we can reuse their memory for each digitize call.
+     * They hold the start of each BX, the end of each BX and the
+     * sampling time of each BX one after the other.
+     */
+    std::vector<double> sampleTimes_, sampleVolts_;
+
+    /// Draw the noise of a Batch from a stream per channel
+    bool channelStreams_{false};
+
+    /// Seed of the streams of the channels
+    uint64_t streamSeed_{0};
+
+    /// Pulses and samples of the channel of a Batch being digitized
+    std::vector<std::pair<double, double>> pulses_;
+    std::vector<ldmx::HgcrocDigiCollection::Sample> digi_;
+  };  // Context
 
   /**
-   * Set Conditions
+   * Batch
    *
-   * Passes the chips conditions to be cached here and
-   * used later in digitization.
-   *
-   * @param table conditions::DoubleTableConditions to be used for chip
-   * parameters
+   * The pulses arriving at many channels, kept in flat lists so that the
+   * channels can be digitized together. The digis of the channels read out
+   * are added to the collection in the order the channels were added.
+   * ```cpp
+   * batch.clear();
+   * for (const auto& hit : hits) {
+   *   batch.addChannel(hit.getID());
+   *   for (...) batch.addPulse(voltage, time);
+   * }
+   * emulator.digitize(context, batch, digis, n_threads);
+   * ```
    */
-  void condition(const conditions::DoubleTableCondition& table) {
-    // reset cache of column numbers if table changes
-    if (&table != chipConditions_) conditionNamesToIndex_.clear();
-    chipConditions_ = &table;
-  }
+  class Batch {
+   public:
+    /// Remove all channels, keeping the memory of the lists
+    void clear() {
+      channels_.clear();
+      firstPulse_.clear();
+      pulses_.clear();
+    }
+
+    /**
+     * Start a new channel, the pulses added next arrive at it
+     *
+     * @param[in] channelID raw integer ID for the readout channel
+     */
+    void addChannel(int channelID) {
+      channels_.push_back(channelID);
+      firstPulse_.push_back(pulses_.size());
+    }
+
+    /**
+     * Add a pulse arriving at the last channel added
+     *
+     * @param[in] voltage amplitude of the pulse [mV]
+     * @param[in] time time of the pulse [ns]
+     */
+    void addPulse(double voltage, double time) {
+      pulses_.emplace_back(voltage, time);
+    }
+
+    /// Number of channels in the batch
+    std::size_t size() const { return channels_.size(); }
+
+   private:
+    friend class HgcrocEmulator;
+
+    /// IDs of the channels
+    std::vector<int> channels_;
+
+    /// Index of the first pulse of each channel in pulses_
+    std::vector<std::size_t> firstPulse_;
+
+    /// Pulses of all channels one after the other, (voltage, time) pairs
+    std::vector<std::pair<double, double>> pulses_;
+
+    /// Raw sample words of the channels, nADCs_ per channel
+    std::vector<uint32_t> samples_;
+
+    /// Whether each channel is read out (char to be written by threads)
+    std::vector<char> readout_;
+  };  // Batch
 
   /**
    * Digitize the signals from the simulated hits
@@ -141,6 +315,7 @@ class HgcrocEmulator {
    * of "HgcrocConditions" passed to this function to configure the emulator
    * before digitizing.
    *
+   * @param[in,out] context conditions, noise generator and buffers to use
    * @param[in] channelID raw integer ID for this readout channel
    * @param[in] arriving_pulses pairs of (voltage,time) of hits arriving at the
    * chip
@@ -149,10 +324,33 @@ class HgcrocEmulator {
    * @return true if digis were constructed (false if hit was below readout)
    */
   bool digitize(
-      const int& channelID,
+      Context& context, const int& channelID,
       std::vector<std::pair<double, double>>& arriving_pulses,
       std::vector<ldmx::HgcrocDigiCollection::Sample>& digiToAdd) const;
 
+  /**
+   * Digitize the channels of a batch
+   *
+   * Each channel is digitized as by the digitize above and the digis of
+   * the channels read out are added to the collection in the order of the
+   * batch. With one thread, the channels are digitized one after the
+   * other with the input context, so the digis are the same as from
+   * calling digitize on each channel.
+   *
+   * With more threads, the channels are handed out in blocks to threads
+   * that each digitize with a copy of the input context. The noise must
+   * then be drawn from a stream per channel (Context::channelStreams),
+   * which gives the same digis for any number of threads.
+   *
+   * @param[in,out] context conditions, noise generator and buffers to use
+   * @param[in,out] batch channels and their pulses, it also holds the
+   * samples while the channels are digitized
+   * @param[in,out] digis collection to add the digis read out to
+   * @param[in] n_threads number of threads digitizing
+   */
+  void digitize(Context& context, Batch& batch,
+                ldmx::HgcrocDigiCollection& digis, int n_threads = 1) const;
+
   /**
    * Generate a digi of pure noise
    *
@@ -169,63 +367,172 @@ class HgcrocEmulator {
    * (or "not found"), so this also indirectly assumes we
    * are below the TOA threshold as well as below the TOT threshold.
    *
+   * @param[in,out] context conditions and noise generator to use
    * @param[in] channel raw integer ID for this readout channel
    * @param[in] soi_amplitude amplitude of noise "pulse" in mV
    * @return DIGI of pure noise
    */
   std::vector<ldmx::HgcrocDigiCollection::Sample> noiseDigi(
-      const int& channel, const double& soi_amplitude = 0) const;
+      Context& context, const int& channel,
+      const double& soi_amplitude = 0) const;
+
+  /**
+   * Generate a digi of pure noise into raw sample words
+   *
+   * This is the same as the other noiseDigi (and draws the same random
+   * numbers) but the conditions of the channel are looked up once and
+   * the samples are written directly into the input words, so it can
+   * be used on every channel of a detector without allocating.
+   *
+   * @see HgcrocDigiCollection::addDigi(unsigned int)
+   * @param[in,out] context conditions and noise generator to use
+   * @param[in] channel raw integer ID for this readout channel
+   * @param[out] samples the nADCs_ raw sample words to write
+   * @param[in] soi_amplitude amplitude of noise "pulse" in mV
+   */
+  void noiseDigi(Context& context, const int& channel, uint32_t* samples,
+                 const double& soi_amplitude = 0) const;
 
   /**
    * Get random noise amplitdue for input channel [mV]
    *
+   * @param[in,out] context conditions and noise generator to use
    * @param[in] channelID
    * @return electronic noise amplitude [mV] above pedestal
    */
-  double noise(const int& channelID) const {
-    return noiseInjector_->Gaus(
-        0, getCondition(channelID, "NOISE") * gain(channelID));
+  double noise(Context& context, const int& channelID) const {
+    return context.noiseInjector_.Gaus(
+        0, context.get(channelID, Context::NOISE) * context.gain(channelID));
   };
 
-  /// Gain for input channel
-  double gain(const int& channelID) const {
-    return getCondition(channelID, "GAIN");
-  }
+ private:
+  /**
+   * PulseShape
+   *
+   * Functional shape of signal pulse in time, normalized to a height
+   * of one at its peak time of zero.
+   *
+   * Shape parameters are hardcoded into the function currently.
+   *  Pulse Shape:
+   *  [0]*((1.0+exp([1]*(-[2]+[3])))*(1.0+exp([5]*(-[6]+[3]))))/((1.0+exp([1]*(x-[2]+[3]-[4])))*(1.0+exp([5]*(x-[6]+[3]-[4]))))
+   *   p[0] = amplitude (height of peak in mV) - one here
+   *   p[1] = rate of up slope - rateUpSlope_
+   *   p[2] = time of up slope relative to shape fit - timeUpSlope_
+   *   p[3] = time of peak relative to shape fit - timePeak_
+   *   p[4] = peak time (related to time of hit [ns]) - zero here
+   *   p[5] = rate of down slope - rateDnSlope_
+   *   p[6] = time of down slope relative to shape fit - timeDnSlope_
+   *
+   * @f[
+   *  V(t) =
+   *  p_0\frac{(1+\exp(p_1(-p_2+p_3)))(1+\exp(p_5*(-p_6+p_3)))}
+   *          {(1+\exp(p_1(t-p_2+p_3-p_4)))(1+\exp(p_5*(t-p_6+p_3-p_4)))}
+   * @f]
+   *
+   * It is evaluated directly instead of through a TF1, which keeps state
+   * while evaluating and so could not be shared between threads.
+   */
+  class PulseShape {
+   public:
+    /// A flat shape, which is not used
+    PulseShape() = default;
+
+    /**
+     * Configure the shape
+     *
+     * @param[in] rateUp rate of up slope [1/ns]
+     * @param[in] timeUp time of up slope relative to shape fit [ns]
+     * @param[in] rateDn rate of down slope [1/ns]
+     * @param[in] timeDn time of down slope relative to shape fit [ns]
+     * @param[in] timePeak time of peak relative to shape fit [ns]
+     */
+    PulseShape(double rateUp, double timeUp, double rateDn, double timeDn,
+               double timePeak)
+        : rateUp_{rateUp},
+          upOffset_{timePeak - timeUp},
+          rateDn_{rateDn},
+          dnOffset_{timePeak - timeDn} {
+      norm_ = (1.0 + std::exp(rateUp_ * upOffset_)) *
+              (1.0 + std::exp(rateDn_ * dnOffset_));
+    }
 
-  /// Pedestal [ADC Counts] for input channel
-  double pedestal(const int& id) const { return getCondition(id, "PEDESTAL"); }
+    /**
+     * Get the (normalized) pulse shape at the input time
+     *
+     * @param[in] time time relative to the pulse [ns]
+     * @return value of the pulse shape at that time
+     */
+    double operator()(double time) const {
+      return norm_ / ((1.0 + std::exp(rateUp_ * (time + upOffset_))) *
+                      (1.0 + std::exp(rateDn_ * (time + dnOffset_))));
+    }
 
-  /// Readout Threshold (ADC Counts)
-  double readoutThreshold(const int& id) const {
-    return getCondition(id, "READOUT_THRESHOLD");
-  }
+   private:
+    /// rate of up slope [1/ns]
+    double rateUp_{0.};
+    /// time of peak minus time of up slope [ns]
+    double upOffset_{0.};
+    /// rate of down slope [1/ns]
+    double rateDn_{0.};
+    /// time of peak minus time of down slope [ns]
+    double dnOffset_{0.};
+    /// denominator at the peak, so the peak is one
+    double norm_{4.};
+  };  // PulseShape
 
- private:
   /**
-   * Get condition for input chip ID, condition name, and default value
+   * PulseTable
    *
-   * @param[in] id chip global integer ID used in condition table
-   * @param[in] name std::string name of chip parameter in table
-   * @param[in] def default value for parameter if not found in table (or table
-   * not set)
-   * @return value of chip parameter
+   * The pulse shape function tabulated on a fine grid of times.
+   * Evaluating the table linearly interpolates between the grid
+   * points, which is much faster than evaluating the formula.
+   * Times outside of the grid are given to the function itself.
    */
-  double getCondition(int id, const std::string& name) const {
-    // check if emulator has been passed a table of conditions
-    if (!chipConditions_) {
-      EXCEPTION_RAISE("HgcrocCond",
-                      "HGC ROC Emulator was not given a conditions table.");
-    }
+  class PulseTable {
+   public:
+    /// An empty table, which is not used
+    PulseTable() = default;
 
-    // cache column index for the input name
-    if (conditionNamesToIndex_.count(name) == 0)
-      conditionNamesToIndex_[name] = chipConditions_->getColumnNumber(name);
+    /**
+     * Tabulate the input function
+     *
+     * @param[in] func pulse shape function to tabulate
+     * @param[in] min first time of the grid [ns]
+     * @param[in] max last time of the grid [ns]
+     * @param[in] step spacing of the grid [ns]
+     */
+    PulseTable(const PulseShape& func, double min, double max, double step);
 
-    // get condition
-    return chipConditions_->get(id, conditionNamesToIndex_.at(name));
-  }
+    /// Check if this table has been filled
+    bool empty() const { return values_.empty(); }
+
+    /**
+     * Get the (normalized) pulse shape at the input time
+     *
+     * @param[in] time time relative to the pulse [ns]
+     * @return value of the pulse shape at that time
+     */
+    double operator()(double time) const {
+      double x{(time - min_) * inv_step_};
+      if (not(x >= 0 and x < n_steps_)) return func_(time);
+      int i{static_cast<int>(x)};
+      double frac{x - i};
+      return values_[i] + frac * (values_[i + 1] - values_[i]);
+    }
+
+   private:
+    /// function we tabulated, for times outside of the grid
+    PulseShape func_;
+    /// first time of the grid [ns]
+    double min_{0.};
+    /// inverse of the grid spacing [1/ns]
+    double inv_step_{1.};
+    /// number of steps in the grid
+    int n_steps_{0};
+    /// function values at the n_steps_+1 grid points
+    std::vector<double> values_;
+  };  // PulseTable
 
- private:
   /**
    * CompositePulse
    *
@@ -242,8 +549,9 @@ class HgcrocEmulator {
      * shape function already configured by the chip
      * emulator.
      */
-    CompositePulse(TF1& func, const double& g, const double& p)
-        : pulseFunc_{func}, gain_{g}, pedestal_{p} {}
+    CompositePulse(const PulseShape& func, const PulseTable& table,
+                   const double& g, const double& p)
+        : pulseFunc_{func}, pulseTable_{table}, gain_{g}, pedestal_{p} {}
 
     /**
      * Put another hit into this composite pulse.
@@ -324,11 +632,40 @@ class HgcrocEmulator {
      */
     double at(double time) const {
       double signal = gain_ * pedestal_;
-      for (auto hit : hits_)
-        signal += hit.first * pulseFunc_.Eval(time - hit.second);
+      if (pulseTable_.empty()) {
+        for (auto hit : hits_)
+          signal += hit.first * pulseFunc_(time - hit.second);
+      } else {
+        for (auto hit : hits_)
+          signal += hit.first * pulseTable_(time - hit.second);
+      }
       return signal;
     };
 
+    /**
+     * Measure the voltage at several times
+     *
+     * This is the same as calling at for each time, but the hits are
+     * looped over once with the inner loop over the times so it can be
+     * vectorized when the pulse shape is tabulated.
+     *
+     * @param[in] times times to measure [ns]
+     * @param[out] volts voltages at those times [mV], resized to match
+     */
+    void at(const std::vector<double>& times,
+            std::vector<double>& volts) const {
+      volts.assign(times.size(), gain_ * pedestal_);
+      for (auto hit : hits_) {
+        if (pulseTable_.empty()) {
+          for (std::size_t i{0}; i < times.size(); i++)
+            volts[i] += hit.first * pulseFunc_(times[i] - hit.second);
+        } else {
+          for (std::size_t i{0}; i < times.size(); i++)
+            volts[i] += hit.first * pulseTable_(times[i] - hit.second);
+        }
+      }
+    }
+
     /// Get list of individual pulses that are entering the chip
     const std::vector<std::pair<double, double>>& hits() const { return hits_; }
 
@@ -347,7 +684,10 @@ class HgcrocEmulator {
     double pedestal_;
 
     /// reference to pulse shape function shared by all pulses
-    TF1& pulseFunc_;
+    const PulseShape& pulseFunc_;
+
+    /// reference to tabulated pulse shape, used if not empty
+    const PulseTable& pulseTable_;
 
   };  // CompositePulse
 
@@ -392,54 +732,18 @@ class HgcrocEmulator {
   /// Hit merging time [ns]
   double hit_merge_ns_;
 
-  /**************************************************************************************
-   * Chip-Dependent Parameters (Conditions)
-   *************************************************************************************/
-
-  /**
-   * Handle to table of chip-dependent conditions
-   *
-   * The defaults are listed below and are separate parameters
-   * passed through the python configuration.
-   */
-  const conditions::DoubleTableCondition* chipConditions_{nullptr};
-
-  /**
-   * Map of condition names to column numbers
-   *
-   * mutable so that we can update the cached column values
-   * in getCondition during processing.
-   */
-  mutable std::map<std::string, int> conditionNamesToIndex_;
+  /// Spacing of the tabulated pulse shape [ns], zero to not tabulate
+  double pulseTableStep_;
 
   /**************************************************************************************
    * Helpful Member Objects
    *************************************************************************************/
 
-  /// Generates Gaussian noise on top of real hits
-  std::unique_ptr<TRandom3> noiseInjector_;
+  /// Shape of signal pulse in time
+  PulseShape pulseFunc_;
 
-  /**
-   * Functional shape of signal pulse in time
-   *
-   * Shape parameters are hardcoded into the function currently.
-   *  Pulse Shape:
-   *  [0]*((1.0+exp([1]*(-[2]+[3])))*(1.0+exp([5]*(-[6]+[3]))))/((1.0+exp([1]*(x-[2]+[3]-[4])))*(1.0+exp([5]*(x-[6]+[3]-[4]))))
-   *   p[0] = amplitude (height of peak in mV)
-   *   p[1] = rate of up slope - rateUpSlope_
-   *   p[2] = time of up slope relative to shape fit - timeUpSlope_
-   *   p[3] = time of peak relative to shape fit - timePeak_
-   *   p[4] = peak time (related to time of hit [ns])
-   *   p[5] = rate of down slope - rateDnSlope_
-   *   p[6] = time of down slope relative to shape fit - timeDnSlope_
-   *
-   * @f[
-   *  V(t) =
-   *  p_0\frac{(1+\exp(p_1(-p_2+p_3)))(1+\exp(p_5*(-p_6+p_3)))}
-   *          {(1+\exp(p_1(t-p_2+p_3-p_4)))(1+\exp(p_5*(t-p_6+p_3-p_4)))}
-   * @f]
-   */
-  mutable TF1 pulseFunc_;
+  /// Tabulated pulseFunc_, empty if we evaluate it directly
+  PulseTable pulseTable_;
 
 };  // HgcrocEmulator
 
@@ -127,6 +127,17 @@ class HgcrocTriggerCalculations {
                                           int adc_thresh, int tot_ped,
                                           int tot_thresh, int tot_gain);
 
+  /**
+   * Number of low order bits dropped from the summed linear charge before
+   * compression, depending on the number of cells summed by the HGCROC
+   *
+   * @see compressDigis for how the compression is done
+   * @raises Exception if the input cells_per_trig is not 4 or 9.
+   * @param cells_per_trig Valid values are 4 or 9
+   * @returns number of bits to shift the linear charge by
+   */
+  static int compressionShift(int cells_per_trig);
+
   /**
    * Construct the chip trigger calculator
    *
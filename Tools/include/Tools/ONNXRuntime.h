@@ -16,9 +16,57 @@ typedef std::vector<std::vector<float>> FloatArrays;
 /**
  * @class ONNXRuntime
  * @brief A convenience wrapper of the ONNXRuntime C++ API.
+ *
+ * The model is only read once per process if the runtimes are made with
+ * get: processors (and threads) asking for the same model with the same
+ * options share one session, which is safe since running a session does
+ * not change it.
  */
 class ONNXRuntime {
  public:
+  /**
+   * @struct Options
+   * @brief How to make the session of a model.
+   */
+  struct Options {
+    /// Number of threads used within an operation
+    int intra_op_threads{1};
+    /// Number of threads used across independent operations of the graph
+    int inter_op_threads{1};
+    /// Graph optimizations: "disable", "basic", "extended" or "all"
+    std::string optimization_level{"all"};
+    /**
+     * File to keep the optimized model in, none if empty.
+     *
+     * The optimized model is written there the first time and read instead
+     * of the model (without optimizing it again) afterwards, as long as it
+     * is newer than the model. With the "extended" and "all" levels it is
+     * specific to the execution provider and the hardware it was made on.
+     */
+    std::string optimized_model_path;
+    /// Execution provider: "cpu", "cuda", "openvino" or "dnnl" (oneDNN)
+    std::string execution_provider{"cpu"};
+  };
+
+  /**
+   * Get the runtime of a model shared by the whole process.
+   *
+   * The session is made the first time the model is asked for with these
+   * options and kept while any of the runtimes given out are in use.
+   * @param model_path Path to the ONNX model file.
+   * @param options How to make the session.
+   * @return The runtime of the model.
+   */
+  static std::shared_ptr<const ONNXRuntime> get(const std::string& model_path,
+                                                const Options& options);
+
+  /**
+   * Class constructor.
+   * @param model_path Path to the ONNX model file.
+   * @param options How to make the session.
+   */
+  ONNXRuntime(const std::string& model_path, const Options& options);
+
   /**
    * Class constructor.
    * @param model_path Path to the ONNX model file.
@@ -31,6 +79,89 @@ class ONNXRuntime {
   ONNXRuntime& operator=(const ONNXRuntime&) = delete;
   ~ONNXRuntime();
 
+  /**
+   * Make the options of a session with the input thread counts
+   * @param intra_op_threads Number of threads used within an operation.
+   * @param inter_op_threads Number of threads used across independent
+   * operations of the graph.
+   * @return The options to give to the constructor.
+   */
+  static ::Ort::SessionOptions makeSessionOptions(int intra_op_threads,
+                                                  int inter_op_threads);
+
+  /**
+   * Make the options of a session
+   * @param options The thread counts, optimization level and execution
+   * provider of the session. The optimized model file is not set here.
+   * @return The options to give to the constructor.
+   */
+  static ::Ort::SessionOptions makeSessionOptions(const Options& options);
+
+  /**
+   * @class Binding
+   * @brief Input and output arrays bound to the session for a batch size.
+   *
+   * The arrays and the tensors wrapping them are made once in bind, so
+   * running the model with a binding does not allocate any of them again.
+   * The arrays can be written and read in place between runs, but they must
+   * not be resized since the tensors point to their memory.
+   */
+  class Binding {
+   public:
+    /**
+     * Get the array of an input node to fill before running.
+     * @param name Name of the input node.
+     * @return The array, with a shape layout of (batch_size, ...).
+     */
+    std::vector<float>& input(const std::string& name);
+
+    /**
+     * Get the array of an output node filled by the last run.
+     * @param name Name of the output node.
+     * @return The array, with a shape layout of (batch_size, ...).
+     */
+    const std::vector<float>& output(const std::string& name) const;
+
+    /// Number of samples in the batch
+    int64_t batchSize() const { return batch_size_; }
+
+   private:
+    friend class ONNXRuntime;
+    Binding() = default;
+
+    int64_t batch_size_{0};
+
+    std::vector<std::string> input_names_;
+    FloatArrays inputs_;
+    std::vector<::Ort::Value> input_tensors_;
+
+    std::vector<std::string> output_names_;
+    std::vector<const char*> output_node_names_;
+    FloatArrays outputs_;
+    std::vector<::Ort::Value> output_tensors_;
+  };
+
+  /**
+   * Bind input and output arrays for a batch size.
+   * @param batch_size Number of samples in the batch.
+   * @param output_names Names of the output nodes to get outputs from. Empty
+   * list means all output nodes.
+   * @param dynamic_size Size given to the dynamic dimensions of the nodes
+   * other than the batch size, e.g. the number of points of a model
+   * exported with a dynamic number of points.
+   * @return The binding to fill and give to run. All the node shapes (apart
+   * from the batch size) must be fixed unless a dynamic_size is given.
+   */
+  std::unique_ptr<Binding> bind(
+      int64_t batch_size, const std::vector<std::string>& output_names = {},
+      int64_t dynamic_size = -1) const;
+
+  /**
+   * Run model inference on the inputs of a binding and write its outputs.
+   * @param binding The binding made by `bind` of this runtime.
+   */
+  void run(Binding& binding) const;
+
   /**
    * Run model inference and get outputs.
    * @param input_names List of the names of the input nodes.
@@ -65,6 +196,9 @@ class ONNXRuntime {
       const std::string& output_name) const;
 
  private:
+  /// Read the names and shapes of the nodes of the session
+  void readNodes();
+
   static ::Ort::Env env_;
   std::unique_ptr<::Ort::Session> session_;
 
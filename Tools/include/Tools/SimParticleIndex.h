@@ -0,0 +1,147 @@
+/**
+ * @file SimParticleIndex.h
+ * @brief Index for navigating the SimParticles of an event
+ */
+
+#ifndef TOOLS_SIMPARTICLEINDEX_H_
+#define TOOLS_SIMPARTICLEINDEX_H_
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace framework {
+class Event;
+}
+
+namespace ldmx {
+
+class SimParticle;
+
+/**
+ * @class SimParticleIndex
+ * @brief Parents, daughters and PDG IDs of the SimParticles in one pass
+ *
+ * The particles are numbered in the order of their track IDs (their slot)
+ * and the daughters of all of them are kept one after the other, so going
+ * from a particle to its parent or daughters is an array lookup instead of
+ * a search of the map (and a copy of the vector of track IDs) each time.
+ * Daughters and parents that weren't saved are left out.
+ *
+ * Building the index is a single pass over the particles. The processors
+ * of an event share one index through get, which builds it the first time
+ * it is asked for in the event.
+ * ```cpp
+ * const auto &index{ldmx::SimParticleIndex::get(event)};
+ * for (int daughter : index.daughters(index.slot(track_id))) {
+ *   const auto &particle{index.particle(daughter)};
+ * }
+ * ```
+ */
+class SimParticleIndex {
+ public:
+  /// Slot of a track ID that is not in the index
+  static constexpr int NOT_FOUND{-1};
+
+  /// Slots of particles next to each other in the index
+  class Slots {
+   public:
+    Slots(const int *begin, const int *end) : begin_{begin}, end_{end} {}
+    const int *begin() const { return begin_; }
+    const int *end() const { return end_; }
+    std::size_t size() const { return end_ - begin_; }
+    bool empty() const { return begin_ == end_; }
+
+   private:
+    const int *begin_;
+    const int *end_;
+  };
+
+  /**
+   * Build the index of a map of particles
+   *
+   * @param[in] particles the particles by track ID, it must outlive the index
+   */
+  explicit SimParticleIndex(const std::map<int, SimParticle> &particles);
+
+  /**
+   * Get the index of the particles of an event
+   *
+   * The index is built once per event and shared by all of the processors
+   * asking for the same collection.
+   *
+   * @param[in] event the event with the particles
+   * @param[in] collection name of the particle map
+   * @param[in] pass name of the pass the particles were made in
+   * @return the index, valid until the end of the event
+   */
+  static const SimParticleIndex &get(const framework::Event &event,
+                                     const std::string &collection =
+                                         "SimParticles",
+                                     const std::string &pass = "");
+
+  /// Number of particles
+  std::size_t size() const { return particles_.size(); }
+
+  /**
+   * Get the slot of a particle
+   * @param[in] track_id track ID of the particle
+   * @return slot of the particle, NOT_FOUND if it wasn't saved
+   */
+  int slot(int track_id) const;
+
+  /// @return the particle in a slot
+  const SimParticle &particle(int slot) const { return *particles_[slot]; }
+
+  /// @return the track ID of the particle in a slot
+  int trackID(int slot) const { return trackIDs_[slot]; }
+
+  /**
+   * Find a particle by track ID
+   * @param[in] track_id track ID of the particle
+   * @return the particle, nullptr if it wasn't saved
+   */
+  const SimParticle *find(int track_id) const {
+    int s{slot(track_id)};
+    return s == NOT_FOUND ? nullptr : particles_[s];
+  }
+
+  /// @return the slot of the (first) parent of a particle, NOT_FOUND if none
+  int parent(int slot) const { return parents_[slot]; }
+
+  /// @return the slots of the daughters of a particle that were saved
+  Slots daughters(int slot) const {
+    return Slots(daughters_.data() + daughterOffsets_[slot],
+                 daughters_.data() + daughterOffsets_[slot + 1]);
+  }
+
+  /// @return the slots of the particles with a PDG ID, in track ID order
+  const std::vector<int> &withPdgID(int pdg_id) const;
+
+  /// @return the slots of the primary particles (with parent track ID 0)
+  const std::vector<int> &primaries() const { return primaries_; }
+
+ private:
+  /// the particles by slot
+  std::vector<const SimParticle *> particles_;
+  /// the track IDs by slot, sorted
+  std::vector<int> trackIDs_;
+  /// slot by track ID, if the track IDs are dense enough, otherwise empty
+  std::vector<int> slotByTrackID_;
+  /// slot of the parent by slot
+  std::vector<int> parents_;
+  /// where the daughters of each slot start in daughters_, one extra at end
+  std::vector<int> daughterOffsets_;
+  /// slots of the daughters of all particles one after the other
+  std::vector<int> daughters_;
+  /// slots of the primary particles
+  std::vector<int> primaries_;
+  /// slots of the particles by PDG ID
+  std::unordered_map<int, std::vector<int>> byPdgID_;
+};
+
+}  // namespace ldmx
+
+#endif  // TOOLS_SIMPARTICLEINDEX_H_
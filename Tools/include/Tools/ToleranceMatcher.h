@@ -0,0 +1,121 @@
+/**
+ * @file ToleranceMatcher.h
+ * @brief Look up earlier positions within a tolerance of a new one
+ */
+
+#ifndef TOOLS_TOLERANCEMATCHER_H_
+#define TOOLS_TOLERANCEMATCHER_H_
+
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ldmx {
+
+/**
+ * @class ToleranceMatcher
+ * @brief Match positions in a plane against the ones added so far
+ *
+ * Two positions match when they are closer than the tolerance in both x
+ * and y (a square, not a circle). The positions added are kept in cells
+ * as wide as the tolerance, so a match can only be in the 3x3 cells around
+ * a position and looking one up doesn't depend on how many were added,
+ * which keeps grouping N hits into positions linear in N. The comparisons
+ * themselves are the same as checking all of the earlier positions.
+ * ```cpp
+ * matcher_.clear();
+ * for (const auto& hit : hits) {
+ *   if (matcher_.matches(hit.x, hit.y)) continue;
+ *   matcher_.add(hit.x, hit.y);
+ *   // new position
+ * }
+ * ```
+ */
+class ToleranceMatcher {
+ public:
+  /// @param[in] tolerance distance in x and y below which positions match
+  explicit ToleranceMatcher(double tolerance = 0.) : tolerance_{tolerance} {}
+
+  /// forget the positions added so far, keeping the tolerance
+  void clear() {
+    cells_.clear();
+    x_.clear();
+    y_.clear();
+  }
+
+  /// @param[in] tolerance new tolerance, also forgets all positions
+  void setTolerance(double tolerance) {
+    tolerance_ = tolerance;
+    clear();
+  }
+
+  /**
+   * Add a position
+   *
+   * Positions that aren't finite can't match anything and are not kept.
+   *
+   * @param[in] x,y position
+   */
+  void add(double x, double y) {
+    if (not(tolerance_ > 0.) or not std::isfinite(x) or not std::isfinite(y))
+      return;
+    cells_[key(cell(x), cell(y))].push_back(x_.size());
+    x_.push_back(x);
+    y_.push_back(y);
+  }
+
+  /**
+   * @param[in] x,y position
+   * @return true if one of the positions added is within the tolerance
+   */
+  bool matches(double x, double y) const {
+    if (not(tolerance_ > 0.) or not std::isfinite(x) or not std::isfinite(y))
+      return false;
+    std::int64_t cx{cell(x)}, cy{cell(y)};
+    for (std::int64_t ix{cx - 1}; ix <= cx + 1; ix++) {
+      for (std::int64_t iy{cy - 1}; iy <= cy + 1; iy++) {
+        auto it{cells_.find(key(ix, iy))};
+        if (it == cells_.end()) continue;
+        for (std::size_t i : it->second) {
+          if (std::fabs(x - x_[i]) < tolerance_ and
+              std::fabs(y - y_[i]) < tolerance_)
+            return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  /// @return number of positions added
+  std::size_t size() const { return x_.size(); }
+
+ private:
+  /// cell of a coordinate, far away ones share the outermost cells
+  std::int64_t cell(double v) const {
+    double c{std::floor(v / tolerance_)};
+    if (c > LIMIT) return LIMIT;
+    if (c < -LIMIT) return -LIMIT;
+    return c;
+  }
+
+  /// key of a cell, different cells can share a key since the
+  /// positions in it are compared anyway
+  static std::uint64_t key(std::int64_t cx, std::int64_t cy) {
+    return std::uint64_t(cx) * 0x9E3779B97F4A7C15ull ^ std::uint64_t(cy);
+  }
+
+  /// largest cell index, well inside of the range of the integers
+  static constexpr std::int64_t LIMIT = std::int64_t(1) << 50;
+
+  /// distance in x and y below which positions match
+  double tolerance_;
+  /// indices of the positions in each cell
+  std::unordered_map<std::uint64_t, std::vector<std::size_t>> cells_;
+  /// positions added
+  std::vector<double> x_, y_;
+};
+
+}  // namespace ldmx
+
+#endif  // TOOLS_TOLERANCEMATCHER_H_
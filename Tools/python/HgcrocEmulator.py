@@ -31,6 +31,9 @@ class HgcrocEmulator() :
         Time of back edge in pulse shape fit
     timePeak : float
         Time of beak in pulse shape fit
+    pulseTableStep : float
+        Spacing [ns] of the grid the pulse shape is tabulated on,
+        zero evaluates the pulse shape function directly
     """
 
     def __init__(self) :
@@ -44,6 +47,7 @@ class HgcrocEmulator() :
         self.timingJitter = self.clockCycle / 100. #ns - pretty arbitrarily chosen
         self.nADCs        = 10 
         self.iSOI         = 2
+        self.pulseTableStep = 0. #ns - tabulation is off by default
 
         # turn on or off noise
         #   NOT DOCUMENTED - only meant for testing purposes
@@ -17,6 +17,7 @@
 //----------//
 #include "Framework/Exception/Exception.h"
 #include "SimCore/Event/SimParticle.h"
+#include "Tools/SimParticleIndex.h"
 
 //----------//
 //   ROOT   //
@@ -84,4 +85,34 @@ const ldmx::SimParticle *getPNGamma(
   return nullptr;
 }
 
+std::tuple<int, const ldmx::SimParticle *> getRecoil(
+    const ldmx::SimParticleIndex &particles) {
+  // same as with the particle map, but only looking at the electrons
+  for (int i : particles.withPdgID(11)) {
+    if (particles.particle(i).getProcessType() ==
+        ldmx::SimParticle::ProcessType::eDarkBrem) {
+      return {i, &particles.particle(i)};
+    }
+  }
+  int primary{particles.slot(1)};
+  if (primary == ldmx::SimParticleIndex::NOT_FOUND) return {primary, nullptr};
+  return {primary, &particles.particle(primary)};
+}
+
+int getPNGamma(const ldmx::SimParticleIndex &particles, int recoil,
+               const float &energyThreshold) {
+  for (int gamma : particles.daughters(recoil)) {
+    const auto &particle{particles.particle(gamma)};
+    if (particle.getPdgID() != 22 or particle.getEnergy() < energyThreshold)
+      continue;
+    for (int daughter : particles.daughters(gamma)) {
+      if (particles.particle(daughter).getProcessType() ==
+          ldmx::SimParticle::ProcessType::photonNuclear) {
+        return gamma;
+      }
+    }
+  }
+  return ldmx::SimParticleIndex::NOT_FOUND;
+}
+
 }  // namespace Analysis
@@ -0,0 +1,61 @@
+#include "Tools/EmptyChannelSampler.h"
+
+#include <algorithm>
+
+#include "TRandom.h"
+
+namespace ldmx {
+
+EmptyChannelSampler::EmptyChannelSampler(std::vector<unsigned int> channels)
+    : channels_{std::move(channels)} {
+  std::sort(channels_.begin(), channels_.end());
+  channels_.erase(std::unique(channels_.begin(), channels_.end()),
+                  channels_.end());
+  isFilled_.assign(channels_.size(), false);
+}
+
+void EmptyChannelSampler::mark(unsigned int id) {
+  auto it{std::lower_bound(channels_.begin(), channels_.end(), id)};
+  if (it == channels_.end() or *it != id) return;
+  std::size_t index = it - channels_.begin();
+  if (isFilled_[index]) return;
+  isFilled_[index] = true;
+  filled_.push_back(index);
+}
+
+const std::vector<unsigned int>& EmptyChannelSampler::draw(std::size_t k,
+                                                           TRandom& rng) {
+  std::size_t n_empty{channels_.size() - filled_.size()};
+  if (k > n_empty) k = n_empty;
+
+  // the empty indices above n_empty are as many as the filled ones below
+  //  it, pair them up so that 0 to n_empty-1 number the empty channels
+  standIn_.clear();
+  std::sort(filled_.begin(), filled_.end());
+  std::size_t above{n_empty};
+  for (std::size_t index : filled_) {
+    if (index >= n_empty) break;
+    while (isFilled_[above]) above++;
+    standIn_[index] = above++;
+  }
+
+  // partial Fisher-Yates shuffle of 0 to n_empty-1 keeping only the swaps
+  swapped_.clear();
+  drawn_.clear();
+  drawn_.reserve(k);
+  for (std::size_t i{0}; i < k; i++) {
+    std::size_t j{i + std::size_t(rng.Integer(n_empty - i))};
+    auto at_j{swapped_.find(j)};
+    std::size_t picked{at_j == swapped_.end() ? j : at_j->second};
+    auto at_i{swapped_.find(i)};
+    swapped_[j] = at_i == swapped_.end() ? i : at_i->second;
+    if (isFilled_[picked]) picked = standIn_[picked];
+    drawn_.push_back(channels_[picked]);
+  }
+
+  for (std::size_t index : filled_) isFilled_[index] = false;
+  filled_.clear();
+  return drawn_;
+}
+
+}  // namespace ldmx
@@ -1,6 +1,14 @@
 
 #include "Tools/HgcrocEmulator.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <thread>
+
+#include "Framework/Performance/Profile.h"
+
 namespace ldmx {
 
 HgcrocEmulator::HgcrocEmulator(const framework::config::Parameters &ps) {
@@ -16,6 +24,7 @@ HgcrocEmulator::HgcrocEmulator(const framework::config::Parameters &ps) {
   clockCycle_ = ps.getParameter<double>("clockCycle");
   nADCs_ = ps.getParameter<int>("nADCs");
   iSOI_ = ps.getParameter<int>("iSOI");
+  pulseTableStep_ = ps.getParameter<double>("pulseTableStep", 0.);
 
   // Time -> clock counts conversion
   //  time [ns] * ( 2^10 / max time in ns ) = clock counts
@@ -24,45 +33,76 @@ HgcrocEmulator::HgcrocEmulator(const framework::config::Parameters &ps) {
   hit_merge_ns_ = 0.05;  // combine at 50 ps level
 
   // Configure the pulse shape function
-  pulseFunc_ =
-      TF1("pulseFunc",
-          "[0]*((1.0+exp([1]*(-[2]+[3])))*(1.0+exp([5]*(-[6]+[3]))))/"
-          "((1.0+exp([1]*(x-[2]+[3]-[4])))*(1.0+exp([5]*(x-[6]+[3]-[4]))))",
-          0.0, (double)nADCs_ * clockCycle_);
-  pulseFunc_.FixParameter(0, 1.0);  // amplitude is set externally
-  pulseFunc_.FixParameter(1, rateUpSlope_);
-  pulseFunc_.FixParameter(2, timeUpSlope_);
-  pulseFunc_.FixParameter(3, timePeak_);
-  pulseFunc_.FixParameter(4, 0);  // not using time offset in this way
-  pulseFunc_.FixParameter(5, rateDnSlope_);
-  pulseFunc_.FixParameter(6, timeDnSlope_);
+  //  the amplitude is set externally
+  pulseFunc_ = PulseShape(rateUpSlope_, timeUpSlope_, rateDnSlope_,
+                          timeDnSlope_, timePeak_);
+
+  // Tabulate the pulse shape over the times we sample it at
+  //  (the sampling times relative to the hit times), outside of
+  //  this range the function is evaluated directly
+  if (pulseTableStep_ > 0) {
+    pulseTable_ = PulseTable(pulseFunc_, -nADCs_ * clockCycle_,
+                             nADCs_ * clockCycle_, pulseTableStep_);
+  }
+}
+
+HgcrocEmulator::PulseTable::PulseTable(const PulseShape &func, double min,
+                                       double max, double step)
+    : func_{func}, min_{min}, inv_step_{1. / step} {
+  n_steps_ = static_cast<int>(std::ceil((max - min) / step));
+  values_.reserve(n_steps_ + 1);
+  for (int i{0}; i <= n_steps_; i++) values_.push_back(func(min + i * step));
 }
 
-void HgcrocEmulator::seedGenerator(uint64_t seed) {
-  noiseInjector_ = std::make_unique<TRandom3>(seed);
+void HgcrocEmulator::Context::condition(
+    const conditions::DoubleTableCondition &table) {
+  if (&table == chipConditions_) return;
+  // names of the columns in the order of Column
+  static const std::array<std::string, N_COLUMNS> names{
+      "TOT_MAX",       "PAD_CAPACITANCE", "GAIN",
+      "PEDESTAL",      "TOA_THRESHOLD",   "TOT_THRESHOLD",
+      "MEAS_TIME",     "DRAIN_RATE",      "READOUT_THRESHOLD",
+      "NOISE"};
+  for (int i{0}; i < N_COLUMNS; i++)
+    columns_[i] = table.getColumnNumber(names[i]);
+  chipConditions_ = &table;
+}
+
+void HgcrocEmulator::Context::seedChannel(int channelID) {
+  // splitmix64 of the seed and the channel, so neighbouring channels get
+  //  unrelated streams
+  uint64_t z{streamSeed_ +
+             0x9E3779B97F4A7C15ull * (uint64_t(uint32_t(channelID)) + 1)};
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  z ^= z >> 31;
+  // TRandom3 takes 32 bits and seeds from the clock when given zero
+  UInt_t seed{UInt_t(z ^ (z >> 32))};
+  noiseInjector_.SetSeed(seed == 0 ? 1 : seed);
 }
 
 bool HgcrocEmulator::digitize(
-    const int &channelID,
+    Context &context, const int &channelID,
     std::vector<std::pair<double, double>> &arriving_pulses,
     std::vector<ldmx::HgcrocDigiCollection::Sample> &digiToAdd) const {
+  LDMX_PROFILE_SCOPE("HgcrocEmulator::digitize");
   // step 0: prepare ourselves for emulation
 
   digiToAdd.clear();  // make sure it is clean
 
   // Configure chip settings based off of table (that may have been passed)
-  double totMax = getCondition(channelID, "TOT_MAX");
-  double padCapacitance = getCondition(channelID, "PAD_CAPACITANCE");
-  double gain = this->gain(channelID);
-  double pedestal = this->pedestal(channelID);
-  double toaThreshold = getCondition(channelID, "TOA_THRESHOLD");
-  double totThreshold = getCondition(channelID, "TOT_THRESHOLD");
+  double totMax = context.get(channelID, Context::TOT_MAX);
+  double padCapacitance = context.get(channelID, Context::PAD_CAPACITANCE);
+  double gain = context.gain(channelID);
+  double pedestal = context.pedestal(channelID);
+  double toaThreshold = context.get(channelID, Context::TOA_THRESHOLD);
+  double totThreshold = context.get(channelID, Context::TOT_THRESHOLD);
   // measTime defines the point in the BX where an in-time
   //  (time=0 in times vector) hit would arrive.
   // Used to determine BX boundaries and TOA behavior.
-  double measTime = getCondition(channelID, "MEAS_TIME");
-  double drainRate = getCondition(channelID, "DRAIN_RATE");
-  double readoutThresholdFloat = this->readoutThreshold(channelID);
+  double measTime = context.get(channelID, Context::MEAS_TIME);
+  double drainRate = context.get(channelID, Context::DRAIN_RATE);
+  double readoutThresholdFloat = context.readoutThreshold(channelID);
   int readoutThreshold = int(readoutThresholdFloat);
 
   // sort by amplitude
@@ -74,10 +114,26 @@ bool HgcrocEmulator::digitize(
 
   // step 1: gather voltages into groups separated by (programmable) ns, single
   // pass
-  CompositePulse pulse(pulseFunc_, gain, pedestal);
+  CompositePulse pulse(pulseFunc_, pulseTable_, gain, pedestal);
 
   for (auto hit : arriving_pulses) pulse.addOrMerge(hit, hit_merge_ns_);
 
+  // measure the voltage at the start, end and sampling time of each BX
+  //  all at once
+  std::vector<double> &sampleTimes{context.sampleTimes_};
+  std::vector<double> &sampleVolts{context.sampleVolts_};
+  sampleTimes.resize(3 * nADCs_);
+  for (int iADC = 0; iADC < nADCs_; iADC++) {
+    double startBX = (iADC - iSOI_) * clockCycle_ - measTime;
+    sampleTimes[iADC] = startBX;
+    sampleTimes[nADCs_ + iADC] = startBX + clockCycle_;
+    sampleTimes[2 * nADCs_ + iADC] = (iADC - iSOI_) * clockCycle_;
+  }
+  pulse.at(sampleTimes, sampleVolts);
+  const double *startBXVolts{sampleVolts.data()};
+  const double *endBXVolts{startBXVolts + nADCs_};
+  const double *bxVolts{endBXVolts + nADCs_};
+
   // TODO step 2: add timing jitter
   // if (noise_) pulse.jitter();
 
@@ -116,8 +172,8 @@ bool HgcrocEmulator::digitize(
     }  // loop over sim hits
 
     // check for the case of a TOA even though the peak is in the next BX
-    if (!overTOA && pulse(startBX + clockCycle_) > toaThreshold) {
-      if (pulse(startBX) < toaThreshold) {
+    if (!overTOA && endBXVolts[iADC] > toaThreshold) {
+      if (startBXVolts[iADC] < toaThreshold) {
         // pulse crossed TOA threshold somewhere between the start of this
         // basket and the end
         overTOA = true;
@@ -186,9 +242,9 @@ bool HgcrocEmulator::digitize(
       return true;  // always readout
     } else {
       // determine the voltage at the sampling time
-      double bxvolts = pulse((iADC - iSOI_) * clockCycle_);
+      double bxvolts = bxVolts[iADC];
       // add noise if requested
-      if (noise_) bxvolts += noise(channelID);
+      if (noise_) bxvolts += noise(context, channelID);
       // convert to integer and keep in range (handle low and high saturation)
       int adc = bxvolts / gain;
       if (adc < 0) adc = 0;
@@ -196,7 +252,7 @@ bool HgcrocEmulator::digitize(
 
       // check for TOA
       int toa(0);
-      if (pulse(startBX) < toaThreshold && overTOA) {
+      if (startBXVolts[iADC] < toaThreshold && overTOA) {
         double timecross = pulse.findCrossing(startBX, toverTOA, toaThreshold);
         toa = int((timecross - startBX) * ns_);
         // keep inside valid limits
@@ -222,29 +278,121 @@ bool HgcrocEmulator::digitize(
   return digiToAdd.at(iSOI_).adc_t() >= readoutThreshold;
 }  // HgcrocEmulator::digitize
 
+void HgcrocEmulator::digitize(Context &context, Batch &batch,
+                              ldmx::HgcrocDigiCollection &digis,
+                              int n_threads) const {
+  LDMX_PROFILE_SCOPE("HgcrocEmulator::digitize(Batch)");
+  std::size_t n_channels{batch.size()};
+  batch.samples_.resize(n_channels * nADCs_);
+  batch.readout_.assign(n_channels, 0);
+
+  // digitize a channel of the batch with the input context
+  //  each channel only writes its own samples and flag
+  auto digitize_channel = [&](Context &ctx, std::size_t i) {
+    auto first{batch.pulses_.begin() + batch.firstPulse_[i]};
+    auto last{i + 1 < n_channels
+                  ? batch.pulses_.begin() + batch.firstPulse_[i + 1]
+                  : batch.pulses_.end()};
+    ctx.pulses_.assign(first, last);
+    if (ctx.channelStreams_) ctx.seedChannel(batch.channels_[i]);
+    batch.readout_[i] =
+        digitize(ctx, batch.channels_[i], ctx.pulses_, ctx.digi_);
+    std::transform(ctx.digi_.begin(), ctx.digi_.end(),
+                   batch.samples_.begin() + i * nADCs_,
+                   [](const auto &sample) { return sample.raw(); });
+  };
+
+  // blocks of channels handed out to the threads, large enough that
+  //  taking a block costs little next to digitizing it
+  static const std::size_t block_size{64};
+  std::size_t n_blocks{(n_channels + block_size - 1) / block_size};
+  std::size_t n_workers{
+      std::min(std::size_t(std::max(n_threads, 1)), n_blocks)};
+  if (n_workers > 1) {
+    if (not context.channelStreams_) {
+      EXCEPTION_RAISE("HgcrocBatch",
+                      "Digitizing on several threads needs the noise drawn "
+                      "from a stream per channel (Context::channelStreams).");
+    }
+    // each thread takes the next block nobody has taken yet
+    std::vector<Context> contexts(n_workers - 1, context);
+    std::atomic<std::size_t> next_block{0};
+    std::vector<std::exception_ptr> errors(n_workers);
+    auto run_worker = [&](std::size_t i_worker) {
+      Context &ctx{i_worker == 0 ? context : contexts[i_worker - 1]};
+      try {
+        for (std::size_t i_block{next_block++}; i_block < n_blocks;
+             i_block = next_block++) {
+          std::size_t end{std::min(n_channels, (i_block + 1) * block_size)};
+          for (std::size_t i{i_block * block_size}; i < end; i++)
+            digitize_channel(ctx, i);
+        }
+      } catch (...) {
+        errors[i_worker] = std::current_exception();
+      }
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t i_worker{1}; i_worker < n_workers; i_worker++) {
+      workers.emplace_back(run_worker, i_worker);
+    }
+    run_worker(0);
+    for (std::thread &worker : workers) worker.join();
+    for (auto &error : errors) {
+      if (error) std::rethrow_exception(error);
+    }
+  } else {
+    for (std::size_t i{0}; i < n_channels; i++) digitize_channel(context, i);
+  }
+
+  // leave the generator of the context at a stream that doesn't depend on
+  //  the channel it digitized last, which depends on the threads
+  if (context.channelStreams_) context.seedChannel(-1);
+
+  // add the channels read out in the order of the batch
+  for (std::size_t i{0}; i < n_channels; i++) {
+    if (not batch.readout_[i]) continue;
+    std::copy_n(batch.samples_.begin() + i * nADCs_, nADCs_,
+                digis.addDigi(batch.channels_[i]));
+  }
+}  // HgcrocEmulator::digitize(Batch)
+
 std::vector<ldmx::HgcrocDigiCollection::Sample> HgcrocEmulator::noiseDigi(
-    const int &channel, const double &soi_amplitude) const {
-  // get chip conditions from emulator
-  double pedestal{this->pedestal(channel)};
-  double gain{this->gain(channel)};
+    Context &context, const int &channel, const double &soi_amplitude) const {
+  std::vector<uint32_t> samples(nADCs_);
+  noiseDigi(context, channel, samples.data(), soi_amplitude);
+  return std::vector<ldmx::HgcrocDigiCollection::Sample>(samples.begin(),
+                                                         samples.end());
+}
+
+void HgcrocEmulator::noiseDigi(Context &context, const int &channel,
+                               uint32_t *samples,
+                               const double &soi_amplitude) const {
+  // get chip conditions from the context
+  double pedestal{context.pedestal(channel)};
+  double gain{context.gain(channel)};
+  // width of noise(channel), looked up once for all the samples
+  double noise_width{context.get(channel, Context::NOISE) * gain};
+  TRandom3 &noiseInjector{context.noiseInjector_};
   // fill a digi with noise samples
-  std::vector<ldmx::HgcrocDigiCollection::Sample> noise_digi;
+  ldmx::HgcrocDigiCollection::Sample sample;
   for (int iADC{0}; iADC < nADCs_; iADC++) {
     // gen noise for ADC samples
     int adc_tm1{static_cast<int>(pedestal)};
     if (iADC > 0)
-      adc_tm1 = noise_digi.at(iADC - 1).adc_t();
+      adc_tm1 = sample.adc_t();
     else
-      adc_tm1 += noise(channel) / gain;
-    int adc_t{static_cast<int>(pedestal + noise(channel) / gain)};
+      adc_tm1 += noiseInjector.Gaus(0, noise_width) / gain;
+    int adc_t{static_cast<int>(pedestal +
+                               noiseInjector.Gaus(0, noise_width) / gain)};
 
     if (iADC == iSOI_) adc_t += soi_amplitude / gain;
 
     // set toa to 0 (not determined)
     // put new sample into noise digi
-    noise_digi.emplace_back(false, false, adc_tm1, adc_t, 0);
+    sample =
+        ldmx::HgcrocDigiCollection::Sample(false, false, adc_tm1, adc_t, 0);
+    samples[iADC] = sample.raw();
   }  // samples in noise digi
-  return noise_digi;
 }
 
 }  // namespace ldmx
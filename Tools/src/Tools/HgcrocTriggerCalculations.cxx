@@ -72,18 +72,16 @@ void HgcrocTriggerCalculations::addDigi(unsigned int id, unsigned int tid,
   }
 }
 
-void HgcrocTriggerCalculations::compressDigis(int cells_per_trig) {
-  int shift;
-  if (cells_per_trig == 4)
-    shift = 1;
-  else if (cells_per_trig == 9)
-    shift = 3;
-  else {
-    EXCEPTION_RAISE("HgcrocTriggerException",
-                    "Invalid number of precision cells per trigger cell: " +
-                        std::to_string(cells_per_trig));
-  }
+int HgcrocTriggerCalculations::compressionShift(int cells_per_trig) {
+  if (cells_per_trig == 4) return 1;
+  if (cells_per_trig == 9) return 3;
+  EXCEPTION_RAISE("HgcrocTriggerException",
+                  "Invalid number of precision cells per trigger cell: " +
+                      std::to_string(cells_per_trig));
+}
 
+void HgcrocTriggerCalculations::compressDigis(int cells_per_trig) {
+  int shift{compressionShift(cells_per_trig)};
   for (auto ilinear : linearCharge_) {
     unsigned int lcharge = ilinear.second;
     lcharge = lcharge >> shift;
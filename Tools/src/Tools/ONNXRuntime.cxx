@@ -4,8 +4,10 @@
 #include <algorithm>
 #include <cassert>
 #include <exception>
+#include <filesystem>
 #include <functional>
 #include <iostream>
+#include <mutex>
 #include <numeric>
 
 namespace ldmx::Ort {
@@ -53,6 +55,54 @@ ONNXRuntime::ONNXRuntime(const std::string& model_path,
     sess_opts.SetIntraOpNumThreads(1);
     session_.reset(new Session(env_, model_path.c_str(), sess_opts));
   }
+  readNodes();
+}
+
+ONNXRuntime::ONNXRuntime(const std::string& model_path,
+                         const Options& options) {
+  SessionOptions sess_opts{makeSessionOptions(options)};
+  std::string path{model_path};
+  if (not options.optimized_model_path.empty()) {
+    // use the optimized model if it was made after the model was changed
+    std::error_code model_error, optimized_error;
+    auto model_time = std::filesystem::last_write_time(model_path, model_error);
+    auto optimized_time = std::filesystem::last_write_time(
+        options.optimized_model_path, optimized_error);
+    if (not model_error and not optimized_error and
+        optimized_time >= model_time) {
+      path = options.optimized_model_path;
+      sess_opts.SetGraphOptimizationLevel(ORT_DISABLE_ALL);
+    } else {
+      sess_opts.SetOptimizedModelFilePath(
+          options.optimized_model_path.c_str());
+    }
+  }
+  session_.reset(new Session(env_, path.c_str(), sess_opts));
+  readNodes();
+}
+
+std::shared_ptr<const ONNXRuntime> ONNXRuntime::get(
+    const std::string& model_path, const Options& options) {
+  static std::mutex mutex;
+  static std::map<std::string, std::weak_ptr<const ONNXRuntime>> runtimes;
+
+  std::string key{model_path + "|" + std::to_string(options.intra_op_threads) +
+                  "|" + std::to_string(options.inter_op_threads) + "|" +
+                  options.optimization_level + "|" +
+                  options.optimized_model_path + "|" +
+                  options.execution_provider};
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& runtime{runtimes[key]};
+  auto shared{runtime.lock()};
+  if (not shared) {
+    shared = std::make_shared<const ONNXRuntime>(model_path, options);
+    runtime = shared;
+  }
+  return shared;
+}
+
+void ONNXRuntime::readNodes() {
   AllocatorWithDefaultOptions allocator;
 
   // get input names and shapes
@@ -107,6 +157,146 @@ ONNXRuntime::ONNXRuntime(const std::string& model_path,
 
 ONNXRuntime::~ONNXRuntime() {}
 
+SessionOptions ONNXRuntime::makeSessionOptions(int intra_op_threads,
+                                               int inter_op_threads) {
+  SessionOptions sess_opts;
+  sess_opts.SetIntraOpNumThreads(intra_op_threads);
+  sess_opts.SetInterOpNumThreads(inter_op_threads);
+  return sess_opts;
+}
+
+SessionOptions ONNXRuntime::makeSessionOptions(const Options& options) {
+  SessionOptions sess_opts{
+      makeSessionOptions(options.intra_op_threads, options.inter_op_threads)};
+
+  static const std::map<std::string, GraphOptimizationLevel> levels{
+      {"disable", ORT_DISABLE_ALL},
+      {"basic", ORT_ENABLE_BASIC},
+      {"extended", ORT_ENABLE_EXTENDED},
+      {"all", ORT_ENABLE_ALL}};
+  auto level = levels.find(options.optimization_level);
+  if (level == levels.end()) {
+    throw std::runtime_error("Graph optimization level " +
+                             options.optimization_level + " is invalid!");
+  }
+  sess_opts.SetGraphOptimizationLevel(level->second);
+
+  // the nodes the provider can't run are left to the CPU
+  const auto& provider = options.execution_provider;
+  if (provider == "cpu") return sess_opts;
+#if ORT_API_VERSION == 2
+  throw std::runtime_error("Execution provider " + provider +
+                           " is not supported by this ONNXRuntime version!");
+#else
+  if (provider == "cuda") {
+    OrtCUDAProviderOptions cuda_options;
+    sess_opts.AppendExecutionProvider_CUDA(cuda_options);
+  } else if (provider == "openvino") {
+    OrtOpenVINOProviderOptions openvino_options;
+    sess_opts.AppendExecutionProvider_OpenVINO(openvino_options);
+  } else if (provider == "dnnl") {
+#if ORT_API_VERSION >= 16
+    const auto& api = GetApi();
+    OrtDnnlProviderOptions* dnnl_options{nullptr};
+    ThrowOnError(api.CreateDnnlProviderOptions(&dnnl_options));
+    auto status =
+        api.SessionOptionsAppendExecutionProvider_Dnnl(sess_opts, dnnl_options);
+    api.ReleaseDnnlProviderOptions(dnnl_options);
+    ThrowOnError(status);
+#else
+    throw std::runtime_error(
+        "Execution provider dnnl is not supported by this ONNXRuntime "
+        "version!");
+#endif
+  } else {
+    throw std::runtime_error("Execution provider " + provider +
+                             " is invalid!");
+  }
+  return sess_opts;
+#endif
+}
+
+std::vector<float>& ONNXRuntime::Binding::input(const std::string& name) {
+  auto iter = std::find(input_names_.begin(), input_names_.end(), name);
+  if (iter == input_names_.end()) {
+    throw std::runtime_error("Input name " + name + " is invalid!");
+  }
+  return inputs_[iter - input_names_.begin()];
+}
+
+const std::vector<float>& ONNXRuntime::Binding::output(
+    const std::string& name) const {
+  auto iter = std::find(output_names_.begin(), output_names_.end(), name);
+  if (iter == output_names_.end()) {
+    throw std::runtime_error("Output " + name + " is not bound!");
+  }
+  return outputs_[iter - output_names_.begin()];
+}
+
+std::unique_ptr<ONNXRuntime::Binding> ONNXRuntime::bind(
+    int64_t batch_size, const std::vector<std::string>& output_names,
+    int64_t dynamic_size) const {
+  assert(batch_size > 0);
+
+  std::unique_ptr<Binding> binding(new Binding);
+  binding->batch_size_ = batch_size;
+  binding->output_names_ =
+      output_names.empty() ? output_node_strings_ : output_names;
+  binding->inputs_.reserve(input_node_strings_.size());
+  binding->outputs_.reserve(binding->output_names_.size());
+
+  // the memory of the arrays is given to the tensors, so the tensors
+  // don't own it and nothing is copied when running
+  auto memory_info =
+      MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  auto bind_array = [&](const std::string& name, std::vector<int64_t> dims,
+                        FloatArrays& arrays, std::vector<Value>& tensors) {
+    dims[0] = batch_size;
+    for (auto& dim : dims) {
+      if (dim < 0) dim = dynamic_size;
+      if (dim < 0) {
+        throw std::runtime_error("Node " + name +
+                                 " has a dynamic shape and cannot be bound!");
+      }
+    }
+    auto len = std::accumulate(dims.begin(), dims.end(), int64_t(1),
+                               std::multiplies<int64_t>());
+    auto& array = arrays.emplace_back(len, 0.);
+    tensors.emplace_back(Value::CreateTensor<float>(
+        memory_info, array.data(), array.size(), dims.data(), dims.size()));
+  };
+
+  for (const auto& name : input_node_strings_) {
+    binding->input_names_.push_back(name);
+    bind_array(name, input_node_dims_.at(name), binding->inputs_,
+               binding->input_tensors_);
+  }
+  for (const auto& name : binding->output_names_) {
+    bind_array(name, getOutputShape(name), binding->outputs_,
+               binding->output_tensors_);
+    binding->output_node_names_.push_back(name.c_str());
+  }
+
+  return binding;
+}
+
+void ONNXRuntime::run(Binding& binding) const {
+  // the tensors are only valid while the arrays keep their memory
+  for (std::size_t i = 0; i < binding.inputs_.size(); i++) {
+    if (binding.input_tensors_[i].GetTensorMutableData<float>() !=
+        binding.inputs_[i].data()) {
+      throw std::runtime_error("Input array " + binding.input_names_[i] +
+                               " was resized after it was bound!");
+    }
+  }
+
+  session_->Run(RunOptions{nullptr}, input_node_names_.data(),
+                binding.input_tensors_.data(), binding.input_tensors_.size(),
+                binding.output_node_names_.data(),
+                binding.output_tensors_.data(),
+                binding.output_tensors_.size());
+}
+
 FloatArrays ONNXRuntime::run(const std::vector<std::string>& input_names,
                              FloatArrays& input_values,
                              const std::vector<std::string>& output_names,
@@ -0,0 +1,79 @@
+#include "Tools/SimParticleIndex.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "Framework/Event.h"
+#include "SimCore/Event/SimParticle.h"
+
+namespace ldmx {
+
+SimParticleIndex::SimParticleIndex(
+    const std::map<int, SimParticle> &particles) {
+  particles_.reserve(particles.size());
+  trackIDs_.reserve(particles.size());
+  for (const auto &[track_id, particle] : particles) {
+    particles_.push_back(&particle);
+    trackIDs_.push_back(track_id);
+  }
+
+  // the track IDs are counted up by Geant4 and only some tracks are saved,
+  //  look them up in a table unless that would be mostly empty
+  if (not trackIDs_.empty() and trackIDs_.front() >= 0 and
+      trackIDs_.back() < 8 * int(trackIDs_.size()) + 1024) {
+    slotByTrackID_.assign(trackIDs_.back() + 1, NOT_FOUND);
+    for (std::size_t i{0}; i < trackIDs_.size(); i++)
+      slotByTrackID_[trackIDs_[i]] = int(i);
+  }
+
+  parents_.resize(particles_.size(), NOT_FOUND);
+  daughterOffsets_.reserve(particles_.size() + 1);
+  daughterOffsets_.push_back(0);
+  for (std::size_t i{0}; i < particles_.size(); i++) {
+    const SimParticle &particle{*particles_[i]};
+    for (int parent_id : particle.getParents()) {
+      if (parent_id == 0) {
+        primaries_.push_back(int(i));
+        continue;
+      }
+      int parent_slot{slot(parent_id)};
+      if (parent_slot != NOT_FOUND and parents_[i] == NOT_FOUND)
+        parents_[i] = parent_slot;
+    }
+    for (int daughter_id : particle.getDaughters()) {
+      int daughter_slot{slot(daughter_id)};
+      if (daughter_slot != NOT_FOUND) daughters_.push_back(daughter_slot);
+    }
+    daughterOffsets_.push_back(int(daughters_.size()));
+    byPdgID_[particle.getPdgID()].push_back(int(i));
+  }
+}
+
+const SimParticleIndex &SimParticleIndex::get(const framework::Event &event,
+                                              const std::string &collection,
+                                              const std::string &pass) {
+  return event.getDerived<SimParticleIndex>(
+      "SimParticleIndex_" + collection + "_" + pass, [&]() {
+        return std::make_shared<SimParticleIndex>(
+            event.getMap<int, SimParticle>(collection, pass));
+      });
+}
+
+int SimParticleIndex::slot(int track_id) const {
+  if (not slotByTrackID_.empty()) {
+    if (track_id < 0 or track_id >= int(slotByTrackID_.size()))
+      return NOT_FOUND;
+    return slotByTrackID_[track_id];
+  }
+  auto it{std::lower_bound(trackIDs_.begin(), trackIDs_.end(), track_id)};
+  if (it == trackIDs_.end() or *it != track_id) return NOT_FOUND;
+  return int(it - trackIDs_.begin());
+}
+
+const std::vector<int> &SimParticleIndex::withPdgID(int pdg_id) const {
+  static const std::vector<int> none;
+  auto it{byPdgID_.find(pdg_id)};
+  return it == byPdgID_.end() ? none : it->second;
+}
+
+}  // namespace ldmx
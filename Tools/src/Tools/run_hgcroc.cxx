@@ -46,8 +46,8 @@ int main() {
       });
 
   ldmx::HgcrocEmulator hgcroc(parameters);
-  hgcroc.seedGenerator(420);
-  hgcroc.condition(chip_conditions);
+  ldmx::HgcrocEmulator::Context context(420);
+  context.condition(chip_conditions);
 
   double readout_threshold = gain * 53.;
   double tot_threshold = 15.76225;
@@ -102,7 +102,7 @@ int main() {
       the_pulse[0].second = time;
 
       std::vector<ldmx::HgcrocDigiCollection::Sample> digi_to_add;
-      digitized = hgcroc.digitize(cell_id, the_pulse, digi_to_add);
+      digitized = hgcroc.digitize(context, cell_id, the_pulse, digi_to_add);
       if (digitized) {
         all_digis.addDigi(cell_id, digi_to_add);
 
@@ -10,6 +10,7 @@
 #include <random>
 
 //--- LDMX ---//
+#include "Tracking/Reco/StageProfile.h"
 #include "Tracking/Reco/TrackingGeometryUser.h"
 
 //--- ACTS ---//
@@ -44,6 +45,7 @@
 #include "Acts/Propagator/StandardAborters.hpp"
 #include "Acts/Propagator/detail/SteppingLogger.hpp"
 #include "Acts/Surfaces/PerigeeSurface.hpp"
+#include "Acts/Surfaces/PlaneSurface.hpp"
 #include "Acts/Utilities/Logger.hpp"
 
 // Kalman Filter
@@ -143,10 +145,11 @@ class CKFProcessor final : public TrackingGeometryUser {
 
  private:
   // Make geoid -> source link map Measurements
-  auto makeGeoIdSourceLinkMap(const geo::TrackersTrackingGeometry &tg,
-                              const std::vector<ldmx::Measurement> &ldmxsps)
-      -> std::unordered_multimap<Acts::GeometryIdentifier,
-                                 ActsExamples::IndexSourceLink>;
+  //  The links are kept in a flat multiset sorted by geoid, whose memory
+  //  is reused by the next events
+  const ActsExamples::IndexSourceLinkContainer &makeGeoIdSourceLinkMap(
+      const geo::TrackersTrackingGeometry &tg,
+      const std::vector<ldmx::Measurement> &ldmxsps);
 
   // If we want to dump the tracking geometry
   bool dumpobj_{false};
@@ -159,7 +162,12 @@ class CKFProcessor final : public TrackingGeometryUser {
   double processing_time_{0.};
 
   // time profiling
-  std::map<std::string, double> profiling_map_;
+  StageProfile profile_;
+
+  // Fill the per-event distributions of the profiling
+  bool profiling_histograms_{false};
+  framework::HistogramHelper::ID n_branches_id_;
+  framework::HistogramHelper::ID n_surface_measurements_id_;
 
   bool debug_{false};
 
@@ -236,6 +244,46 @@ class CKFProcessor final : public TrackingGeometryUser {
   // Keep track on which system this processor is running on
   bool taggerTracking_{true};
 
+  // Number of threads following the seeds of an event
+  int n_seed_threads_{1};
+
+  // The propagator options, set up for each run
+  std::unique_ptr<Acts::PropagatorOptions<ActionList, AbortList>>
+      propagator_options_;
+
+  // The Kalman filter pieces the CKF extensions are connected to
+  Acts::GainMatrixUpdater kf_updater_;
+  Acts::GainMatrixSmoother kf_smoother_;
+  std::unique_ptr<Acts::MeasurementSelector> meas_sel_;
+
+  // The calibrator, pointed to the measurements of each event
+  tracking::sim::LdmxMeasurementCalibrator calibrator_;
+
+  // The CKF extensions, connected once for each run
+  Acts::CombinatorialKalmanFilterExtensions<Acts::VectorMultiTrajectory>
+      ckf_extensions_;
+
+  // The surface the found tracks are expressed at
+  std::shared_ptr<Acts::PlaneSurface> tgt_surface_unbound_;
+
+  // The surfaces the tracks are extrapolated to
+  std::shared_ptr<Acts::PlaneSurface> ecal_surface_;
+  std::shared_ptr<Acts::PlaneSurface> target_surface_;
+  std::shared_ptr<Acts::Surface> beam_origin_surface_;
+
+  // The track containers of a seed thread, cleared for each seed
+  struct TrackBuffers {
+    Acts::VectorTrackContainer vtc;
+    Acts::VectorMultiTrajectory mtj;
+  };
+
+  // The track containers of each seed thread
+  std::vector<std::unique_ptr<TrackBuffers>> track_buffers_;
+
+  // The source links of the event and the buffer they are sorted in
+  std::vector<ActsExamples::IndexSourceLink> sorted_source_links_;
+  ActsExamples::IndexSourceLinkContainer source_links_;
+
 };  // CKFProcessor
 
 }  // namespace reco
@@ -12,12 +12,14 @@
 #include "Acts/Surfaces/Surface.hpp"
 
 //--- LDMX ---//
+#include "Tracking/Digitization/StripChargeDeposition.h"
 #include "Tracking/Sim/TrackingUtils.h"
 
 //--- ACTS ---//
 #include "Acts/Definitions/Units.hpp"
 
 //--- C++ ---//
+#include <memory>
 #include <random>
 
 namespace ldmx {
@@ -49,7 +51,9 @@ class DigitizationProcessor : public TrackingGeometryUser {
    * Does basic digitization of SimTrackerHits. For now, this simply uses the
    * global coordinates (SimTrackerHit position) and hit surface to extract
    * the local coordinates.  If specified, the local coordinates are smeared and
-   * the global coordinates are updated.
+   * the global coordinates are updated. With the strip simulation, the
+   * local u coordinate is instead the centroid of the charge the hit
+   * deposits on the strips.
    *
    * @param sim_hits The collection of SimTrackerHits to digitize.
    */
@@ -80,6 +84,17 @@ class DigitizationProcessor : public TrackingGeometryUser {
   double sigma_u_{0};
   /// v-direction sigma
   double sigma_v_{0};
+  /// Share the charge of the hits among the strips instead of smearing u.
+  bool strip_sim_{false};
+  /// Smallest charge of a strip that is read out, in electrons.
+  double strip_threshold_{0.};
+  /// Length of the segments the path of a hit is cut into.
+  double segment_length_{0.};
+
+  //--- Strip simulation ---//
+
+  /// Charge on the strips of the sensor of the hit being digitized
+  std::unique_ptr<tracking::digitization::StripChargeDeposition> strips_;
 
   //--- Smearing ---//
 
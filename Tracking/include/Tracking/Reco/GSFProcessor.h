@@ -10,6 +10,7 @@
 #include <random>
 
 //--- LDMX ---//
+#include "Tracking/Reco/StageProfile.h"
 #include "Tracking/Reco/TrackingGeometryUser.h"
 
 //--- ACTS ---//
@@ -167,7 +168,10 @@ class GSFProcessor final : public TrackingGeometryUser {
   double processing_time_{0.};
 
   // time profiling
-  std::map<std::string, double> profiling_map_;
+  StageProfile profile_;
+
+  // Fill the per-event distributions of the profiling
+  bool profiling_histograms_{false};
 
   // refitting of tracks
   bool kf_refit_{false};
@@ -191,8 +195,14 @@ class GSFProcessor final : public TrackingGeometryUser {
   // Use 2d measurements instead of 1D
   bool use1Dmeasurements_{true};
 
-  // Minimum number of hits on tracks
-  int min_hits_{7};
+  // Minimum number of hits on the tracks to refit
+  int min_hits_{0};
+
+  // Maximum chi2/ndf of the tracks to refit, no cut if negative
+  double max_chi2_ndf_{-1.};
+
+  // Number of tracks refitted and skipped by the preselection
+  long n_refitted_{0}, n_preselected_out_{0};
 
   // The extrapolation surface
   bool use_extrapolate_location_{true};
@@ -232,6 +242,9 @@ class GSFProcessor final : public TrackingGeometryUser {
   bool abortOnError_{false};
   bool disableAllMaterialHandling_{false};
   double weightCutoff_{1.0e-4};
+  // How the components are reduced to a single track state
+  Acts::MixtureReductionMethod reductionMethod_{
+      Acts::MixtureReductionMethod::eMaxWeight};
 
   double propagator_step_size_{200.};  // mm
   int propagator_maxSteps_{1000};
@@ -253,6 +266,25 @@ class GSFProcessor final : public TrackingGeometryUser {
   std::shared_ptr<tracking::reco::TrackExtrapolatorTool<Propagator>>
       trk_extrap_;
 
+  // The GSF pieces, set up for each run
+  Acts::GainMatrixUpdater updater_;
+  tracking::sim::LdmxMeasurementCalibrator calibrator_;
+  Acts::Experimental::GsfExtensions<Acts::VectorMultiTrajectory>
+      gsf_extensions_;
+  std::unique_ptr<Acts::PropagatorOptions<ActionList, AbortList>>
+      propagator_options_;
+  std::shared_ptr<const Acts::PerigeeSurface> origin_surface_;
+  std::unique_ptr<Acts::Experimental::GsfOptions<Acts::VectorMultiTrajectory>>
+      gsf_options_;
+
+  // The surfaces the tracks are extrapolated to
+  std::shared_ptr<Acts::Surface> target_surface_;
+  std::shared_ptr<Acts::Surface> beam_origin_surface_;
+
+  // The Acts track containers, cleared for each event
+  Acts::VectorTrackContainer vtc_;
+  Acts::VectorMultiTrajectory mtj_;
+
 };  // GSFProcessor
 
 }  // namespace reco
@@ -33,6 +33,7 @@
 #include "TFile.h"
 #include "TTree.h"
 #include "Tracking/Event/Measurement.h"
+#include "Tracking/Reco/StageProfile.h"
 #include "Tracking/Reco/TrackingGeometryUser.h"
 #include "Tracking/Reco/TruthMatchingTool.h"
 
@@ -83,9 +84,28 @@ class SeedFinderProcessor : public TrackingGeometryUser {
   void FindSeedsFromMap(ldmx::Tracks& seeds, const ldmx::Measurements& pmeas);
 
  private:
-  ldmx::Track SeedTracker(const ldmx::Measurements& vmeas, double xOrigin,
-                          const Acts::Vector3& perigee_location,
-                          const ldmx::Measurements& pmeas_tgt);
+  /// A grouped measurement with the transformation of its surface
+  struct SeedHit {
+    /// the measurement
+    const ldmx::Measurement* meas;
+    /// global x of the measurement, the combinations are ordered by it
+    double x;
+    /// rotation from the local to the global frame of the surface
+    Acts::RotationMatrix3 rotl2g;
+    /// position of the surface in its local frame
+    Acts::Vector2 offset;
+  };
+
+  /// Fit the line and parabola of a combination of hits ordered in x
+  Acts::ActsVector<5> FitLineParabola(const std::array<const SeedHit*, 5>& hits,
+                                      double xOrigin);
+
+  /// Make the seed track from the fitted line and parabola
+  ldmx::Track SeedTracker(const Acts::ActsVector<5>& B, double xOrigin,
+                          const Acts::Vector3& perigee_location);
+
+  /// Move the iterators to the next combination of the groups
+  void NextCombination(std::array<std::vector<SeedHit>::const_iterator, 5>& it);
 
   void LineParabolaToHelix(const Acts::ActsVector<5> parameters,
                            Acts::ActsVector<5>& helix_parameters,
@@ -104,6 +124,13 @@ class SeedFinderProcessor : public TrackingGeometryUser {
   long nevents_{0};
   unsigned int ntracks_{0};
 
+  // time profiling
+  StageProfile profile_;
+
+  // Fill the per-event distributions of the profiling
+  bool profiling_histograms_{false};
+  framework::HistogramHelper::ID n_seeds_id_;
+
   std::vector<double> inflate_factors_{1., 1., 1., 1., 1.};
 
   /// The name of the output collection of seeds to be stored.
@@ -137,6 +164,9 @@ class SeedFinderProcessor : public TrackingGeometryUser {
   /// ThetaRange
   double thetacut_{0.2};
 
+  /// Relative margin of the momentum cut applied before making the seeds
+  static constexpr double precut_margin_{1e-6};
+
   /// loc0 / loc1 cuts
   double loc0cut_{0.1};
   double loc1cut_{0.3};
@@ -171,7 +201,7 @@ class SeedFinderProcessor : public TrackingGeometryUser {
 
   // The measurements groups
 
-  std::map<int, std::vector<const ldmx::Measurement*>> groups_map;
+  std::map<int, std::vector<SeedHit>> groups_map;
   std::array<const ldmx::Measurement*, 5> groups_array;
 
   // Truth Matching tool
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Framework/Histograms.h"
+
+namespace tracking::reco {
+
+/**
+ * @class StageProfile
+ * @brief Time spent in the stages of the events of a tracking processor
+ *
+ * The time of each stage is always summed for the averages printed at the
+ * end of the processing. Once book has been called, each stage also fills a
+ * histogram with its time in every event, so the few events that take
+ * orders of magnitude longer than the average can be found. The bins are
+ * logarithmic, from 1 us to 100 s.
+ * ```cpp
+ * // in onProcessStart
+ * if (profiling_histograms_) profile_.book(histograms_, {"hits", "fit"});
+ * // in produce
+ * auto start{StageProfile::now()};
+ * ...
+ * start = profile_.add("hits", start);
+ * ```
+ */
+class StageProfile {
+ public:
+  using Clock = std::chrono::high_resolution_clock;
+
+  /// @return the current time
+  static Clock::time_point now() { return Clock::now(); }
+
+  /**
+   * @return edges of n bins of equal width in log from min to max, for
+   * the histograms whose values span orders of magnitude
+   */
+  static std::vector<double> logBinEdges(double min, double max, int n) {
+    std::vector<double> edges(n + 1);
+    for (int i{0}; i <= n; i++) {
+      edges[i] = min * std::pow(max / min, double(i) / n);
+    }
+    return edges;
+  }
+
+  /**
+   * Create the histogram of the time of each stage, named after the stage
+   * with a "_time" suffix
+   *
+   * @param[in] histograms histograms of the processor
+   * @param[in] stages names of the stages
+   */
+  void book(framework::HistogramHelper& histograms,
+            const std::vector<std::string>& stages) {
+    histograms_ = &histograms;
+    auto edges{logBinEdges(1e-3, 1e5, 80)};
+    for (const auto& stage : stages) {
+      histograms.create(stage + "_time", stage + " time [ms]", edges);
+      stages_[stage].id = histograms.id(stage + "_time");
+      stages_[stage].booked = true;
+    }
+  }
+
+  /**
+   * Add the time of a stage of this event
+   *
+   * @param[in] stage name of the stage
+   * @param[in] ms time spent in it in ms
+   */
+  void add(const std::string& stage, double ms) {
+    auto& s{stages_[stage]};
+    s.total += ms;
+    if (s.booked) histograms_->fill(s.id, ms);
+  }
+
+  /**
+   * Add the time of a stage that ends now
+   *
+   * @param[in] stage name of the stage
+   * @param[in] start time the stage started at
+   * @return now, the start of the next stage
+   */
+  Clock::time_point add(const std::string& stage, Clock::time_point start) {
+    auto end{now()};
+    add(stage, std::chrono::duration<double, std::milli>(end - start).count());
+    return end;
+  }
+
+  /// @return total time spent in a stage in ms
+  double total(const std::string& stage) const {
+    auto s{stages_.find(stage)};
+    return s == stages_.end() ? 0. : s->second.total;
+  }
+
+ private:
+  /// a stage of the events
+  struct Stage {
+    /// time summed over the events in ms
+    double total{0.};
+    /// histogram of the time per event
+    framework::HistogramHelper::ID id;
+    /// true if the histogram was created
+    bool booked{false};
+  };
+
+  /// the histograms of the processor, once booked
+  framework::HistogramHelper* histograms_{nullptr};
+  /// the stages by name
+  std::map<std::string, Stage> stages_;
+};
+
+}  // namespace tracking::reco
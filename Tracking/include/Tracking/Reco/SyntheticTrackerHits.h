@@ -0,0 +1,68 @@
+#pragma once
+
+//--- C++ ---//
+#include <random>
+#include <string>
+#include <vector>
+
+//--- LDMX ---//
+#include "SimCore/Event/SimTrackerHit.h"
+#include "Tracking/Reco/TrackingGeometryUser.h"
+
+namespace tracking::reco {
+
+/**
+ * Producer of synthetic tracker sim hits at a chosen occupancy
+ *
+ * Each event gets a Poisson number of hits on the sensors of one tracker,
+ * drawn uniformly from the surfaces of the tracking geometry and uniformly
+ * within their bounds. The hits cross the sensor along the beam with an
+ * exponential energy deposit and their IDs are the ones the TrackerSD
+ * gives, so the DigitizationProcessor finds their surfaces again.
+ *
+ * With recon::SyntheticCaloHits it replaces a Geant4 sample with pile-up
+ * when measuring how the reconstruction scales with the occupancy.
+ */
+class SyntheticTrackerHits : public TrackingGeometryUser {
+ public:
+  SyntheticTrackerHits(const std::string& name, framework::Process& process)
+      : TrackingGeometryUser(name, process) {}
+
+  void configure(framework::config::Parameters& parameters) final override;
+
+  /**
+   * Seed the generator for this run
+   *
+   * @param[in] header RunHeader for this run, unused
+   */
+  void onNewRun(const ldmx::RunHeader& header) final override;
+
+  void produce(framework::Event& event) final override;
+
+ private:
+  /// Name of the output hit collection
+  std::string collection_;
+  /// Tracking volume of the tracker, 2 for the tagger and 3 for the recoil
+  int volume_{2};
+  /// Mean number of hits per event
+  double mean_hits_{0.};
+  /// Factor multiplying the mean number of hits
+  double occupancy_scale_{1.};
+  /// Mean energy deposited by a hit [MeV]
+  double mean_edep_{0.};
+  /// Mean time of the hits in the in-time bunch [ns]
+  double time_mean_{0.};
+  /// Width of the times in a bunch [ns]
+  double time_sigma_{0.};
+  /// Time between bunches [ns]
+  double bunch_spacing_{0.};
+  /// Number of bunches before the in-time one that hits come from
+  int n_earlier_bunches_{0};
+
+  /// Surfaces of the tracker with their surface ID, listed on the first event
+  std::vector<std::pair<unsigned int, const Acts::Surface*>> surfaces_;
+
+  std::mt19937_64 generator_;
+};
+
+}  // namespace tracking::reco
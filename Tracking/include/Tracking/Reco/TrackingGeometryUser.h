@@ -5,6 +5,7 @@
 #include "Tracking/geo/CalibrationContext.h"
 #include "Tracking/geo/GeometryContext.h"
 #include "Tracking/geo/MagneticFieldContext.h"
+#include "Tracking/geo/MagneticFieldMap.h"
 #include "Tracking/geo/TrackersTrackingGeometry.h"
 
 namespace tracking::reco {
@@ -22,6 +23,7 @@ class TrackingGeometryUser : public framework::Producer {
   const Acts::MagneticFieldContext& magnetic_field_context();
   const Acts::CalibrationContext& calibration_context();
   const geo::TrackersTrackingGeometry& geometry();
+  const geo::MagneticFieldMap& magnetic_field_map();
 
  private:
   /**
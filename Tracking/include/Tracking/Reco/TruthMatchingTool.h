@@ -21,6 +21,9 @@ class TruthMatchingTool {
   /**
    * Constructor.
    *
+   * The tool keeps pointers to the particle map and the measurements, which
+   * have to outlive it or the next call to setup.
+   *
    * @param particleMap The map of all the simulated particles in the event.
    * @param measurements All the measurements in the event.
    */
@@ -32,11 +35,20 @@ class TruthMatchingTool {
 
   void setup(const std::map<int, ldmx::SimParticle>& particleMap,
              const std::vector<ldmx::Measurement>& measurements) {
-    map_ = particleMap;
-    measurements_ = measurements;
+    map_ = &particleMap;
+    measurements_ = &measurements;
     configured_ = true;
   }
 
+  /**
+   * Forget the particle map and measurements of the previous setup.
+   */
+  void reset() {
+    map_ = nullptr;
+    measurements_ = nullptr;
+    configured_ = false;
+  }
+
   /**
    * Destructor.
    */
@@ -45,15 +57,20 @@ class TruthMatchingTool {
 
   TruthInfo TruthMatch(const ldmx::Track& trk);
   TruthInfo Evaluate(
-      const std::unordered_map<unsigned int, unsigned int>& trk_trackIDs,
+      const std::vector<std::pair<unsigned int, unsigned int>>& trk_trackIDs,
       int n_meas);
   TruthInfo TruthMatch(const std::vector<ldmx::Measurement>& vmeas);
 
   bool configured() { return configured_; }
 
  private:
-  std::map<int, ldmx::SimParticle> map_;
-  std::vector<ldmx::Measurement> measurements_;
+  /// count one more measurement left by a track in trk_trackIDs_
+  void count(unsigned int trkId);
+
+  const std::map<int, ldmx::SimParticle>* map_{nullptr};
+  const std::vector<ldmx::Measurement>* measurements_{nullptr};
+  /// trackIDs on the track being matched and their frequency, reused
+  std::vector<std::pair<unsigned int, unsigned int>> trk_trackIDs_;
   bool debug_{false};
   std::shared_ptr<tracking::sim::TruthMatchingTool> truthMatchingTool = nullptr;
   bool configured_{false};
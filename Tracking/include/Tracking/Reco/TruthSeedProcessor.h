@@ -13,6 +13,7 @@
 #include "Tracking/Reco/TrackExtrapolatorTool.h"
 #include "Tracking/Reco/TrackingGeometryUser.h"
 #include "Tracking/Sim/TrackingUtils.h"
+#include "Tracking/Sim/TruthHitIndex.h"
 
 // --- ACTS --- //
 #include <Acts/Propagator/StraightLineStepper.hpp>
@@ -91,14 +92,14 @@ class TruthSeedProcessor : public TrackingGeometryUser {
 
  private:
   /**
-   * Create a mapping from the selected scoring plane hit objects to the number
-   * of hits they associated particle creates in the tracker.
+   * Index the sim hits by the track leaving them, keeping only the first hit
+   * of a track on each sensor.
    * @param sim_hits vector
    * @param hit_count_map filled with the hits lefts by each track
    */
 
   void makeHitCountMap(const std::vector<ldmx::SimTrackerHit>& sim_hits,
-                       std::map<int, std::vector<int>>& hit_count_map);
+                       tracking::sim::TruthHitIndex& hit_count_map);
 
   /**
    * Use the vertex position of the SimParticle to extract
@@ -158,7 +159,7 @@ class TruthSeedProcessor : public TrackingGeometryUser {
   ldmx::Track RecoilFullSeed(
       const ldmx::SimParticle& particle, const int trackID,
       const ldmx::SimTrackerHit& hit, const ldmx::SimTrackerHit& ecal_hit,
-      const std::map<int, std::vector<int>>& hit_count_map,
+      const tracking::sim::TruthHitIndex& hit_count_map,
       const std::shared_ptr<Acts::Surface>& origin_surface,
       const std::shared_ptr<Acts::Surface>& target_surface,
       const std::shared_ptr<Acts::Surface>& ecal_surface);
@@ -185,7 +186,7 @@ class TruthSeedProcessor : public TrackingGeometryUser {
   ldmx::Track TaggerFullSeed(
       const ldmx::SimParticle& beam_electron, const int trackID,
       const ldmx::SimTrackerHit& hit,
-      const std::map<int, std::vector<int>>& hit_count_map,
+      const tracking::sim::TruthHitIndex& hit_count_map,
       const std::shared_ptr<Acts::Surface>& origin_surface,
       const std::shared_ptr<Acts::Surface>& target_surface);
 
@@ -1,6 +1,10 @@
 #ifndef TRACKING_RECO_VERTEXER_H_
 #define TRACKING_RECO_VERTEXER_H_
 
+//--- C++ ---//
+#include <memory>
+#include <vector>
+
 //--- Framework ---//
 #include "Framework/Configure/Parameters.h"
 #include "Framework/EventProcessor.h"
@@ -62,6 +66,13 @@ class Vertexer : public framework::Producer {
                               const std::vector<ldmx::Track>& recoil_tracks);
 
  private:
+  // Track linearizer in the proximity of the vertex location
+  using Linearizer = Acts::HelicalTrackLinearizer<VoidPropagator>;
+
+  // Billoir Vertex Fitter
+  using VertexFitter =
+      Acts::FullBilloirVertexFitter<Acts::BoundTrackParameters, Linearizer>;
+
   Acts::GeometryContext gctx_;
   Acts::MagneticFieldContext bctx_;
 
@@ -79,6 +90,20 @@ class Vertexer : public framework::Producer {
   std::shared_ptr<VoidPropagator> propagator_;
   double processing_time_{0.};
 
+  // Largest distance of closest approach of the straight lines of two
+  // tracks at the perigee for the pair to be fit
+  double max_doca_{2.};
+
+  // Number of threads fitting the pairs of an event
+  int n_pair_threads_{1};
+
+  // The linearizer and the fitter, set up once for the whole process
+  std::unique_ptr<const Linearizer> linearizer_;
+  std::unique_ptr<const VertexFitter> billoir_fitter_;
+
+  // The fitter states, one for each thread
+  std::vector<std::unique_ptr<VertexFitter::State>> fitter_states_;
+
   // Monitoring histograms
 
   TH1F* h_delta_d0;
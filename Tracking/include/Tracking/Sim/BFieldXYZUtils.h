@@ -12,6 +12,7 @@
 #include "Acts/Utilities/Result.hpp"
 #include "Acts/Utilities/detail/AxisFwd.hpp"
 #include "Acts/Utilities/detail/Grid.hpp"
+#include "SimCore/FieldMapFile.h"
 
 static const double DIPOLE_OFFSET = 400.;  // 400 mm
 
@@ -54,47 +55,36 @@ void testField(const std::shared_ptr<Acts::MagneticFieldProvider> bfield,
 size_t localToGlobalBin_xyz(std::array<size_t, 3> bins,
                             std::array<size_t, 3> sizes);
 
+/**
+ * Build the interpolated field map of a grid rotated to the tracking frame
+ *
+ * The grid is described by the smallest and largest values of each
+ * coordinate and the number of points along each, the field of the point
+ * with the global bin i (see localToGlobalBin) is bField(i).
+ */
 inline InterpolatedMagneticField3 rotateFieldMapXYZ(
     const std::function<size_t(std::array<size_t, 3> binsXYZ,
                                std::array<size_t, 3> nBinsXYZ)>&
         localToGlobalBin,
-    std::vector<double> xPos, std::vector<double> yPos,
-    std::vector<double> zPos, std::vector<Acts::Vector3> bField,
-    double lengthUnit, double BFieldUnit, bool firstOctant,
-    GenericTransformPos transformPosition,
+    std::array<double, 3> minima, std::array<double, 3> maxima,
+    std::array<size_t, 3> nPoints,
+    const std::function<Acts::Vector3(size_t)>& bField, double lengthUnit,
+    double BFieldUnit, bool firstOctant, GenericTransformPos transformPosition,
     GenericTransformBField transformMagneticField) {
-  // [1] Create Grid
-  // Sort the values
-  std::sort(xPos.begin(), xPos.end());
-  std::sort(yPos.begin(), yPos.end());
-  std::sort(zPos.begin(), zPos.end());
-
-  // Get unique values
-  xPos.erase(std::unique(xPos.begin(), xPos.end()), xPos.end());
-  yPos.erase(std::unique(yPos.begin(), yPos.end()), yPos.end());
-  zPos.erase(std::unique(zPos.begin(), zPos.end()), zPos.end());
-  xPos.shrink_to_fit();
-  yPos.shrink_to_fit();
-  zPos.shrink_to_fit();
-
   // get the number of bins
-  size_t nBinsX = xPos.size();
-  size_t nBinsY = yPos.size();
-  size_t nBinsZ = zPos.size();
-
-  // get the minimum and maximum
-  auto minMaxX = std::minmax_element(xPos.begin(), xPos.end());
-  auto minMaxY = std::minmax_element(yPos.begin(), yPos.end());
-  auto minMaxZ = std::minmax_element(zPos.begin(), zPos.end());
+  size_t nBinsX = nPoints[0];
+  size_t nBinsY = nPoints[1];
+  size_t nBinsZ = nPoints[2];
+
   // Create the axis for the grid
   // get minima
-  double xMin = *minMaxX.first;
-  double yMin = *minMaxY.first;
-  double zMin = *minMaxZ.first;
+  double xMin = minima[0];
+  double yMin = minima[1];
+  double zMin = minima[2];
   // get maxima
-  double xMax = *minMaxX.second;
-  double yMax = *minMaxY.second;
-  double zMax = *minMaxZ.second;
+  double xMax = maxima[0];
+  double yMax = maxima[1];
+  double zMax = maxima[2];
   // calculate maxima (add one last bin, because bin value always corresponds to
   // left boundary)
   double stepZ = std::fabs(zMax - zMin) / (nBinsZ - 1);
@@ -106,9 +96,9 @@ inline InterpolatedMagneticField3 rotateFieldMapXYZ(
 
   // If only the first octant is given
   if (firstOctant) {
-    xMin = -*minMaxX.second;
-    yMin = -*minMaxY.second;
-    zMin = -*minMaxZ.second;
+    xMin = -maxima[0];
+    yMin = -maxima[1];
+    zMin = -maxima[2];
     nBinsX = 2 * nBinsX - 1;
     nBinsY = 2 * nBinsY - 1;
     nBinsZ = 2 * nBinsZ - 1;
@@ -132,19 +122,18 @@ inline InterpolatedMagneticField3 rotateFieldMapXYZ(
     for (size_t j = 1; j <= nBinsY; ++j) {
       for (size_t k = 1; k <= nBinsZ; ++k) {
         Grid_t::index_t indices = {{i, j, k}};
-        std::array<size_t, 3> nIndices = {
-            {xPos.size(), yPos.size(), zPos.size()}};
+        std::array<size_t, 3> nIndices = nPoints;
         if (firstOctant) {
           // std::vectors begin with 0 and we do not want the user needing to
           // take underflow or overflow bins in account this is why we need to
           // subtract by one
-          size_t m = std::abs(int(i) - (int(xPos.size())));
-          size_t n = std::abs(int(j) - (int(yPos.size())));
-          size_t l = std::abs(int(k) - (int(zPos.size())));
+          size_t m = std::abs(int(i) - (int(nPoints[0])));
+          size_t n = std::abs(int(j) - (int(nPoints[1])));
+          size_t l = std::abs(int(k) - (int(nPoints[2])));
           Grid_t::index_t indicesFirstOctant = {{m, n, l}};
 
           grid.atLocalBins(indices) =
-              bField.at(localToGlobalBin(indicesFirstOctant, nIndices)) *
+              bField(localToGlobalBin(indicesFirstOctant, nIndices)) *
               BFieldUnit;
 
         } else {
@@ -152,7 +141,7 @@ inline InterpolatedMagneticField3 rotateFieldMapXYZ(
           // take underflow or overflow bins in account this is why we need to
           // subtract by one
           grid.atLocalBins(indices) =
-              bField.at(localToGlobalBin({{i - 1, j - 1, k - 1}}, nIndices)) *
+              bField(localToGlobalBin({{i - 1, j - 1, k - 1}}, nIndices)) *
               BFieldUnit;
         }
       }
@@ -198,6 +187,40 @@ inline InterpolatedMagneticField3 rotateFieldMapXYZ(
       {transformPosition, transformMagneticField, std::move(grid)});
 }
 
+/**
+ * Build the interpolated field map of the points read from a text map
+ *
+ * The grid is deduced from the distinct values of the coordinates of the
+ * points, their fields are in bField in the order of localToGlobalBin.
+ */
+inline InterpolatedMagneticField3 rotateFieldMapXYZ(
+    const std::function<size_t(std::array<size_t, 3> binsXYZ,
+                               std::array<size_t, 3> nBinsXYZ)>&
+        localToGlobalBin,
+    std::vector<double> xPos, std::vector<double> yPos,
+    std::vector<double> zPos, std::vector<Acts::Vector3> bField,
+    double lengthUnit, double BFieldUnit, bool firstOctant,
+    GenericTransformPos transformPosition,
+    GenericTransformBField transformMagneticField) {
+  // [1] Create Grid
+  // Sort the values
+  std::sort(xPos.begin(), xPos.end());
+  std::sort(yPos.begin(), yPos.end());
+  std::sort(zPos.begin(), zPos.end());
+
+  // Get unique values
+  xPos.erase(std::unique(xPos.begin(), xPos.end()), xPos.end());
+  yPos.erase(std::unique(yPos.begin(), yPos.end()), yPos.end());
+  zPos.erase(std::unique(zPos.begin(), zPos.end()), zPos.end());
+
+  return rotateFieldMapXYZ(
+      localToGlobalBin, {{xPos.front(), yPos.front(), zPos.front()}},
+      {{xPos.back(), yPos.back(), zPos.back()}},
+      {{xPos.size(), yPos.size(), zPos.size()}},
+      [&bField](size_t i) { return bField.at(i); }, lengthUnit, BFieldUnit,
+      firstOctant, transformPosition, transformMagneticField);
+}
+
 // This is a copy of
 // https://github.com/acts-project/acts/blob/main/Examples/Detectors/MagneticField/src/FieldMapTextIo.cpp
 // with additional rotateAxes flag to rotate the axes and field to be in the
@@ -269,6 +292,13 @@ inline InterpolatedMagneticField3 makeMagneticFieldMapXyzFromText(
                              lengthUnit, BFieldUnit, firstOctant);
 }
 
+/**
+ * Load the default field map in the tracking frame
+ *
+ * The grid is read through simcore::FieldMapFile, so a text map is parsed
+ * only once for all of the processors (and the simulation) of a process
+ * and a binary one (see convert-field-map) is read in place.
+ */
 inline InterpolatedMagneticField3 loadDefaultBField(
     const std::string& fieldMapFile, GenericTransformPos transformPosition,
     GenericTransformBField transformMagneticField) {
@@ -276,14 +306,19 @@ inline InterpolatedMagneticField3 loadDefaultBField(
   // transformPosition, std::function<Acts::Vector3(const Acts::Vector3&,const
   // Acts::Vector3&)> transformMagneticField
 
-  return makeMagneticFieldMapXyzFromText(
-      std::move(localToGlobalBin_xyz), transformPosition,
-      transformMagneticField, fieldMapFile,
-      1. * Acts::UnitConstants::mm,    // default scale for axes length
-      1000. * Acts::UnitConstants::T,  // The map is in kT, so scale it to T
-      false,                           // not symmetrical
-      true                             // rotate the axes to tracking frame
-  );
+  auto map{simcore::FieldMapFile::get(fieldMapFile)};
+  return rotateFieldMapXYZ(
+      localToGlobalBin_xyz, {{map->min(0), map->min(1), map->min(2)}},
+      {{map->max(0), map->max(1), map->max(2)}},
+      {{map->size(0), map->size(1), map->size(2)}},
+      [&map](size_t i) {
+        const double* b{map->field(i)};
+        return Acts::Vector3(b[0], b[1], b[2]);
+      },
+      map->lengthUnit() * Acts::UnitConstants::mm,  // the map is in mm
+      map->fieldUnit() * Acts::UnitConstants::T,    // and kT, scale it to T
+      false,                                        // not symmetrical
+      transformPosition, transformMagneticField);
 }
 
 // R =
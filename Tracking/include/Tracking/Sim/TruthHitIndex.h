@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace tracking {
+namespace sim {
+
+/**
+ * Index of the entries of a collection by the track ID they belong to
+ *
+ * The indices of the entries (sim hits, scoring plane hits, truth tracks,
+ * anything with getTrackID) are sorted by track ID once and kept in one
+ * array, with the offset of the first entry of each track (CSR layout).
+ * Finding the entries of a track is a binary search over the distinct
+ * track IDs and nothing is allocated per track, unlike a map of vectors.
+ *
+ *   TruthHitIndex index;
+ *   index.fill(sim_hits);
+ *   for (auto i : index.hits(track_id)) use(sim_hits.at(i));
+ *
+ * The entries of a track keep their order in the collection. The index
+ * can be refilled every event, reusing its memory.
+ */
+class TruthHitIndex {
+ public:
+  /// The indices of the entries of one track
+  class Hits {
+   public:
+    Hits(const unsigned* first, const unsigned* last)
+        : first_{first}, last_{last} {}
+    const unsigned* begin() const { return first_; }
+    const unsigned* end() const { return last_; }
+    std::size_t size() const { return last_ - first_; }
+    bool empty() const { return first_ == last_; }
+    unsigned operator[](std::size_t i) const { return first_[i]; }
+
+   private:
+    const unsigned* first_;
+    const unsigned* last_;
+  };
+
+  /**
+   * Index all the entries of a collection
+   *
+   * @param[in] entries the collection
+   */
+  template <typename Entry>
+  void fill(const std::vector<Entry>& entries) {
+    fill(entries, [](const Entry&) { return true; });
+  }
+
+  /**
+   * Index the selected entries of a collection
+   *
+   * @param[in] entries the collection
+   * @param[in] select callable returning true for the entries to index
+   */
+  template <typename Entry, typename Select>
+  void fill(const std::vector<Entry>& entries, Select select) {
+    scratch_.clear();
+    for (unsigned i = 0; i < entries.size(); i++) {
+      if (select(entries[i]))
+        scratch_.emplace_back(entries[i].getTrackID(), i);
+    }
+    build();
+  }
+
+  /**
+   * Keep only the first entry with each key within each track
+   *
+   * Tracks are short, so the kept entries of a track are searched
+   * linearly.
+   *
+   * @param[in] key callable returning the key of an entry from its index
+   */
+  template <typename Key>
+  void unique(Key key) {
+    unsigned out = 0;
+    for (std::size_t t = 0; t < track_ids_.size(); t++) {
+      unsigned first = out;
+      for (unsigned k = offsets_[t]; k < offsets_[t + 1]; k++) {
+        unsigned i = indices_[k];
+        bool seen = false;
+        for (unsigned j = first; j < out && !seen; j++)
+          seen = key(indices_[j]) == key(i);
+        if (!seen) indices_[out++] = i;
+      }
+      offsets_[t] = first;
+    }
+    offsets_.back() = out;
+    indices_.resize(out);
+  }
+
+  /**
+   * Get the entries of a track
+   *
+   * @param[in] track_id the track ID
+   * @return indices of its entries in the collection, empty if none
+   */
+  Hits hits(int track_id) const;
+
+  /**
+   * Get the number of entries of a track
+   *
+   * @param[in] track_id the track ID
+   * @return number of entries, zero if none
+   */
+  std::size_t count(int track_id) const { return hits(track_id).size(); }
+
+  /// @return the track IDs with at least one entry, in increasing order
+  const std::vector<int>& trackIDs() const { return track_ids_; }
+
+ private:
+  /// sort the (track ID, index) pairs in scratch_ into the arrays
+  void build();
+
+  /// the (track ID, index) pairs being indexed
+  std::vector<std::pair<int, unsigned>> scratch_;
+  /// the distinct track IDs, sorted
+  std::vector<int> track_ids_;
+  /// the entries of track_ids_[t] are from offsets_[t] to offsets_[t+1]
+  std::vector<unsigned> offsets_{0};
+  /// the indices of the entries, grouped by track
+  std::vector<unsigned> indices_;
+};
+
+}  // namespace sim
+}  // namespace tracking
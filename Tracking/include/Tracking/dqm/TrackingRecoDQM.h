@@ -6,6 +6,7 @@
 #include "SimCore/Event/SimTrackerHit.h"
 #include "Tracking/Event/Track.h"
 #include "Tracking/Event/TruthTrack.h"
+#include "Tracking/Sim/TruthHitIndex.h"
 
 namespace tracking::dqm {
 
@@ -75,6 +76,9 @@ class TrackingRecoDQM : public framework::Analyzer {
   // Truth Track collection
   std::shared_ptr<ldmx::Tracks> truthTrackCollection_{nullptr};
 
+  // Truth tracks indexed by their track ID
+  tracking::sim::TruthHitIndex truthTrackIndex_;
+
   // Ecal scoring plane hits
   std::shared_ptr<std::vector<ldmx::SimTrackerHit>> ecal_scoring_hits_{nullptr};
 
@@ -24,10 +24,15 @@ class DetectorElement : public Acts::DetectorElementBase {
   // transform(GeometryContext) method will return the full transformation valid
   // for a certain IoV via the ConditionsProvider mechanism
 
+  // The index is the dense index of the element in its tracking geometry,
+  // used to find its aligned transformation in the geometry context
+
   DetectorElement(const std::shared_ptr<Acts::Surface>& surface,
-                  const Acts::Transform3& default_transform, double thickness) {
+                  const Acts::Transform3& default_transform, double thickness,
+                  std::size_t index = 0) {
     m_surface = surface;
     m_thickness = thickness;
+    m_index = index;
 
     // This is the local to global transformation
     m_transform = default_transform;
@@ -39,6 +44,9 @@ class DetectorElement : public Acts::DetectorElementBase {
 
   Acts::Transform3 uncorrectedTransform() const { return m_transform; }
 
+  // Dense index of this element in its tracking geometry
+  std::size_t index() const { return m_index; }
+
   // This method will load the transformation from the geometry context if found
   // otherwise will return the default transform
   // This is very *hot* code, do not place computations in this function in
@@ -50,9 +58,8 @@ class DetectorElement : public Acts::DetectorElementBase {
   // In case the corrections to the stored transformations will be too large
   // this assumption will be broken.
 
-  // TODO Current implementation implies always checking the stored map of
-  // corrections Could be interesting to cache the transformations and re-update
-  // all of them when IoV changes
+  // The aligned transformations are computed once when they are published
+  // to the geometry context and looked up here by the dense index.
 
   const Acts::Transform3& transform(
       const Acts::GeometryContext& gctx) const override;
@@ -78,6 +85,7 @@ class DetectorElement : public Acts::DetectorElementBase {
 
   std::shared_ptr<Acts::Surface> m_surface;
   double m_thickness;
+  std::size_t m_index{0};
   bool m_debug{false};
 };
 
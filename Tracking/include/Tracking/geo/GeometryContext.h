@@ -1,6 +1,9 @@
 #pragma once
 
 #include <Acts/Geometry/TrackingGeometry.hpp>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 #include "Acts/Definitions/Algebra.hpp"
 #include "Framework/ConditionsObject.h"
@@ -58,6 +61,33 @@ class GeometryContext : public framework::ConditionsObject {
   void addAlignCorrection(unsigned int sensorId, const Acts::Vector3 deltaT,
                           const Acts::Vector3 deltaR, const bool active = true);
 
+  /**
+   * Make the transformations in alignment_map the ones seen by the
+   * detector elements
+   *
+   * The transformations are copied into a flat array indexed by the dense
+   * index of the detector elements, which replaces the previous one in a
+   * single atomic swap. The detector elements then only look up their
+   * transformation, and a new set of alignment constants (e.g. for a new
+   * IOV or an alignment iteration) is applied without rebuilding the
+   * tracking geometry.
+   */
+  void publish();
+
+  /**
+   * Get the published aligned transformation of a detector element
+   *
+   * @param[in] index dense index of the detector element
+   * @return pointer to the transformation, nullptr if it is not aligned
+   */
+  const Acts::Transform3* alignedTransform(std::size_t index) const {
+    const AlignmentStore* store = store_.load(std::memory_order_acquire);
+    if (store == nullptr || index >= store->aligned.size() ||
+        !store->aligned[index])
+      return nullptr;
+    return &store->transforms[index];
+  }
+
   // This holds all the transformations of the Tracking Geometry and
   // the alignment corrections already applied
 
@@ -80,11 +110,31 @@ class GeometryContext : public framework::ConditionsObject {
   /// the provider is a friend and so it can make one
   friend class GeometryContextProvider;
 
+  /// Aligned transformations indexed by the dense detector element index
+  struct AlignmentStore {
+    /// the transformation of each detector element
+    std::vector<Acts::Transform3> transforms;
+    /// whether the element at the same index has a transformation
+    std::vector<char> aligned;
+  };
+
   /**
    * Wrap this instance in an Acts::GeometryContext any object for passing
    * it down to the various acts tools
    */
   Acts::GeometryContext acts_gc_;
+
+  /// dense index of the detector element of each sensor in alignment_map
+  std::unordered_map<unsigned int, std::size_t> element_index_;
+
+  /// the published transformations read by the detector elements
+  std::atomic<const AlignmentStore*> store_{nullptr};
+
+  /**
+   * All the published stores, the ones replaced are kept since the
+   * detector elements read them without holding a reference
+   */
+  std::vector<std::unique_ptr<const AlignmentStore>> stores_;
 };
 
 }  // namespace tracking::geo
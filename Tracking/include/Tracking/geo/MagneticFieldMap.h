@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "Framework/ConditionsObject.h"
+#include "Tracking/Sim/BFieldXYZUtils.h"
+
+namespace tracking::geo {
+
+/// class name of provider
+class MagneticFieldMapProvider;
+
+/**
+ * The interpolated magnetic field map in the tracking frame
+ *
+ * Building the ACTS grid of the field map takes a while and it is large,
+ * so it is made once by the conditions system and shared by all of the
+ * processors that use the map with the default transformations
+ * (default_transformPos and default_transformBField). The map is not
+ * modified once it is built, so the processors running at the same time
+ * can all use it.
+ */
+class MagneticFieldMap : public framework::ConditionsObject {
+ public:
+  /// Conditions object name
+  static const std::string NAME;
+
+  /// @return the interpolated field map
+  const std::shared_ptr<const InterpolatedMagneticField3>& get() const {
+    return map_;
+  }
+
+  /// @return the path to the file the map was read from
+  const std::string& getFieldMap() const { return field_map_; }
+
+ private:
+  /// the provider is a friend and so it can make one
+  friend class MagneticFieldMapProvider;
+
+  /**
+   * Build the interpolated map
+   *
+   * @param[in] field_map path to the field map file
+   */
+  MagneticFieldMap(const std::string& field_map);
+
+  /// the path to the field map file
+  std::string field_map_;
+
+  /// the interpolated map
+  std::shared_ptr<const InterpolatedMagneticField3> map_;
+};
+
+}  // namespace tracking::geo
@@ -54,6 +54,19 @@ class TrackersTrackingGeometry : public TrackingGeometry {
   std::shared_ptr<Acts::PlaneSurface> GetSurface(G4VPhysicalVolume* pvol,
                                                  Acts::Transform3 ref_trans);
 
+  /**
+   * Make a silicon rectangular plane surface with its detector element
+   *
+   * @param[in] transform placement of the surface in the tracker frame
+   * @param[in] half_x half length of the sensor along its local x [mm]
+   * @param[in] half_y half length of the sensor along its local y [mm]
+   * @param[in] thickness thickness of the sensor [mm]
+   * @return the surface
+   */
+  std::shared_ptr<Acts::PlaneSurface> makeSurface(
+      const Acts::Transform3& transform, double half_x, double half_y,
+      double thickness);
+
   Acts::CuboidVolumeBuilder::VolumeConfig buildTrackerVolume();
   Acts::CuboidVolumeBuilder::VolumeConfig buildRecoilVolume();
 
@@ -63,11 +76,66 @@ class TrackersTrackingGeometry : public TrackingGeometry {
 
  private:
   friend TrackersTrackingGeometryProvider;
+  /**
+   * Build the geometry of the trackers
+   *
+   * With a cache directory, the placements of the tracker volumes and
+   * sensors read from the GDML are written to a file in it named after
+   * the detector and a hash of the files of the detector. Later jobs with
+   * the same detector build the geometry from that file without parsing
+   * the GDML.
+   *
+   * @param[in] gctx the geometry context for this geometry
+   * @param[in] gdml the path to the detector GDML to load
+   * @param[in] debug whether to print extra information or nah
+   * @param[in] cache_dir directory of the cached layouts, empty for none
+   */
   TrackersTrackingGeometry(const Acts::GeometryContext& gctx,
-                           const std::string& gdml, bool debug);
-
-  G4VPhysicalVolume* Tagger_;
-  G4VPhysicalVolume* Recoil_;
+                           const std::string& gdml, bool debug,
+                           const std::string& cache_dir = "");
+
+  /// Placement of a tracker volume in the tracker frame
+  struct VolumePlacement {
+    /// center of the volume [mm]
+    Acts::Vector3 position{0., 0., 0.};
+    /// length of the volume along the beam [mm]
+    double x_length{0.};
+  };
+
+  /// Get the placement of a tracker volume from its Geant4 volume
+  VolumePlacement placeVolume(G4VPhysicalVolume* pvol) const;
+
+  /// Read the volumes and sensors from the GDML
+  void readLayout();
+
+  /**
+   * Path to the cached layout of the detector
+   *
+   * @param[in] cache_dir directory of the cached layouts
+   * @return path to the file in the directory
+   */
+  std::string cachePath(const std::string& cache_dir) const;
+
+  /**
+   * Read the volumes and sensors from a cached layout
+   *
+   * @param[in] path path to the cached layout
+   * @return false if the file does not exist or is not a layout
+   */
+  bool readCache(const std::string& path);
+
+  /**
+   * Write the volumes and sensors to a cached layout
+   *
+   * @param[in] path path to the cached layout
+   */
+  void writeCache(const std::string& path) const;
+
+  G4VPhysicalVolume* Tagger_{nullptr};
+  G4VPhysicalVolume* Recoil_{nullptr};
+
+  VolumePlacement tagger_volume_;
+  VolumePlacement recoil_volume_;
 
   // I store the layout as a map to distinguish layers/sides
   // They are not too many modules, so it should be ok to use this data
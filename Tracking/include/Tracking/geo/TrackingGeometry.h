@@ -49,6 +49,9 @@ namespace tracking::geo {
 class TrackingGeometry : public framework::ConditionsObject {
  public:
   /**
+   * The GDML is not parsed here, derived classes call parseGDML when
+   * they need the Geant4 volumes.
+   *
    * @param[in] name the name of this geometry condition object
    * @param[in] gctx the geometry context for this geometry
    * @param[in] gdml the path to the detector GDML to load
@@ -102,6 +105,14 @@ class TrackingGeometry : public framework::ConditionsObject {
   std::vector<std::shared_ptr<DetectorElement>> detElements;
 
  protected:
+  /**
+   * Parse the detector GDML, setting the world volume
+   *
+   * The output of Geant4 is silenced while parsing unless a simulation
+   * is running.
+   */
+  void parseGDML();
+
   // This is not actually used anywhere
   // TODO:: Remove this.
   const Acts::GeometryContext& gctx_;
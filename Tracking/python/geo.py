@@ -14,6 +14,13 @@ class TrackersTrackingGeometryProvider(ldmxcfg.ConditionsObjectProvider):
         trackgeo.get_instance().setDetector('ldmx-det-v12')
 
     The default detector is 'ldmx-det-v14'.
+
+    Parsing the detector GDML takes most of the time to build the geometry.
+    If cacheDir is set to a directory, the layout of the trackers read from
+    the GDML is kept in it and later jobs with the same detector files read
+    that layout instead of the GDML.
+
+        trackgeo.get_instance().cacheDir = '/path/to/cache'
     """
 
     __instance = None
@@ -46,6 +53,7 @@ class TrackersTrackingGeometryProvider(ldmxcfg.ConditionsObjectProvider):
         else: 
             super().__init__('TrackersTrackingGeometry', 'tracking::geo::TrackersTrackingGeometryProvider', 'Tracking')
             self.debug = False
+            self.cacheDir = ''
             self.setDetector('ldmx-det-v14')
             TrackersTrackingGeometryProvider.__instance = self
 
@@ -65,6 +73,24 @@ class MagneticFieldContextProvider(ldmxcfg.ConditionsObjectProvider):
 
 magfield_context = MagneticFieldContextProvider()
 
+class MagneticFieldMapProvider(ldmxcfg.ConditionsObjectProvider):
+    """provider of the interpolated magnetic field map
+
+    The map is built once and shared by the tracking processors using the
+    same field map file with the default transformations.
+
+    Attributes
+    ----------
+    field_map : str
+        path to the field map file
+    """
+    def __init__(self):
+        super().__init__('MagneticFieldMap', 'tracking::geo::MagneticFieldMapProvider', 'Tracking')
+        from LDMX.Tracking.make_path import makeFieldMapPath
+        self.field_map = makeFieldMapPath()
+
+magfield_map = MagneticFieldMapProvider()
+
 class CalibrationContextProvider(ldmxcfg.ConditionsObjectProvider):
     """provider of the calibration context condition"""
     def __init__(self):
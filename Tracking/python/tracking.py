@@ -23,6 +23,26 @@ class DigitizationProcessor(Producer):
         Smearing sigma in the sensitive direction
     sigma_v : float
         Smearing sigma in the un-sensitive direction
+    strip_sim : bool
+        Share the charge of the hits among the strips and measure the
+        sensitive direction at the centroid of the strips above threshold
+        instead of smearing it. sigma_u is still the resolution given to
+        the measurements.
+    n_strips : int
+        Number of strips of a sensor for the strip simulation
+    strip_pitch : float
+        Distance between the strips in mm
+    sensor_thickness : float
+        Thickness of the sensors in mm
+    readout_side : int
+        -1 if the strips are on the negative local w side of the sensor, 1
+        if they are on the positive one
+    diffusion_sigma : float
+        Width in mm of the charge drifting through the whole sensor
+    strip_threshold : float
+        Smallest charge of a strip that is read out, in electrons
+    segment_length : float
+        Length in mm of the segments the path of a hit is cut into
     track_id : int
         If track_id > 0, retain only hits with that particular track_id and discard the rest.
     min_e_dep : float
@@ -39,10 +59,72 @@ class DigitizationProcessor(Producer):
         self.do_smearing = True
         self.sigma_u = 0.06
         self.sigma_v = 0.0
+        self.strip_sim = False
+        self.n_strips = 640
+        self.strip_pitch = 0.06
+        self.sensor_thickness = 0.32
+        self.readout_side = -1
+        self.diffusion_sigma = 0.008
+        self.strip_threshold = 2000.
+        self.segment_length = 0.01
         self.track_id = -1
         self.min_e_dep = 0.05
         self.hit_collection = 'TaggerSimHits'
         self.out_collection = 'OutputMeasurements'
+
+class SyntheticTrackerHits(Producer):
+    """ Producer of synthetic tracker sim hits at a chosen occupancy.
+
+    The hits are spread uniformly over the sensors of the tracking geometry
+    and replace a simulated sample when benchmarking the reconstruction.
+
+    Parameters
+    ----------
+    instance_name : str
+        Unique name for this instance.
+    collection : str
+        Name of the SimTrackerHit collection to make
+    volume : int
+        Tracking volume of the tracker, 2 for the tagger and 3 for the recoil
+    mean_hits : float
+        Mean number of hits per event (Poisson)
+
+    Attributes
+    ----------
+    occupancy_scale : float
+        Factor multiplying mean_hits, the variable of a scaling study
+    mean_edep : float
+        Mean of the exponential energy deposit of a hit [MeV]
+    time_mean : float
+        Mean time of the hits in the in-time bunch [ns]
+    time_sigma : float
+        Width of the times within a bunch [ns]
+    bunch_spacing : float
+        Time between bunches [ns]
+    n_earlier_bunches : int
+        Number of bunches before the in-time one that hits are uniformly
+        spread over
+    """
+    def __init__(self, instance_name, collection, volume, mean_hits):
+        super().__init__(instance_name,
+                         'tracking::reco::SyntheticTrackerHits', 'Tracking')
+        self.collection = collection
+        self.volume = volume
+        self.mean_hits = float(mean_hits)
+        self.occupancy_scale = 1.
+        self.mean_edep = 0.1
+        self.time_mean = 0.
+        self.time_sigma = 0.5
+        self.bunch_spacing = 26.9
+        self.n_earlier_bunches = 0
+
+    def tagger(mean_hits = 14.):
+        return SyntheticTrackerHits('syntheticTaggerHits', 'TaggerSimHits',
+                                    2, mean_hits)
+
+    def recoil(mean_hits = 12.):
+        return SyntheticTrackerHits('syntheticRecoilHits', 'RecoilSimHits',
+                                    3, mean_hits)
                 
 class SeedFinderProcessor(Producer):
     """ Producer to find Seeds for the KF-based track finding.
@@ -72,6 +154,9 @@ class SeedFinderProcessor(Producer):
         The name of the input collection of hits to be used for seed finding.
     out_seed_collection : string
         The name of the ouput collection of seeds to be stored.
+    profiling_histograms : bool
+        Fill per-event histograms of the time of each stage and of the
+        number of seeds.
     """
 
     def __init__(self, instance_name="SeedFinderProcessor"):
@@ -86,6 +171,7 @@ class SeedFinderProcessor(Producer):
         self.strategies = []
         self.input_hits_collection = 'TaggerSimHits'
         self.out_seed_collection = 'SeedTracks'
+        self.profiling_histograms = False
         
 
 class CKFProcessor(Producer):
@@ -159,6 +245,13 @@ class CKFProcessor(Producer):
     gsf_refit : bool
        <experimental>
        Refit tracks with Gaussian Sum Filter 
+    n_seed_threads : int
+       Number of threads following the seeds of an event. The tracks
+       don't depend on it.
+    profiling_histograms : bool
+       Fill per-event histograms of the time of each stage and of each
+       seed, of the branches found from each seed and of the measurements
+       on each surface.
         
     """
 
@@ -188,6 +281,8 @@ class CKFProcessor(Producer):
         self.kf_refit = False
         self.gsf_refit = False
         self.min_hits = 6
+        self.n_seed_threads = 1
+        self.profiling_histograms = False
 
 
 
@@ -211,14 +306,24 @@ class GSFProcessor(Producer):
         Abort fitting if an error occurred
     disableAllMaterialHandling : bool
         Disable material effects on surfaces. True only for debug purpose
-    weightCutOff    : double
+    weightCutoff    : double
         Kill a component if its weight is smaller than a certain treshold.
+    reductionMethod : string
+        How the components are reduced to one track state:
+        'max_weight' (the component with the largest weight) or 'mean'
+    min_hits        : int
+        Only refit the tracks with at least this many hits
+    max_chi2_ndf    : float
+        Only refit the tracks with at most this chi2/ndf, no cut if negative
     propagator_step_size : float
         Size of each RK propagator step.
     propagator_maxSteps : int
         Maximum number of steps for the propagator
     field_map_ : string
         Path to the location of the magnetic field map.
+    profiling_histograms : bool
+        Fill per-event histograms of the time spent fitting and
+        extrapolating the tracks.
     """
 
     def __init__(self, instance_name='GSFProcessor'):
@@ -227,14 +332,20 @@ class GSFProcessor(Producer):
 
         self.trackCollection = "TaggerTracks"
         self.measCollection  = "DigiTaggerSimHits"
-        self.maxComponent    = 4
+        self.maxComponents   = 4
         self.abortOnError    = False
         self.disableAllMaterialHandling = False
         self.weightCutoff    = 1.0e-4
+        self.reductionMethod = 'max_weight'
+
+        # preselection of the tracks to refit, off by default
+        self.min_hits     = 0
+        self.max_chi2_ndf = -1.
 
         self.propagator_step_size = 200.
         self.propagator_maxSteps  = 1000
         self.field_map = makeFieldMapPath()
+        self.profiling_histograms = False
 
         
 
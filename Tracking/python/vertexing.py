@@ -42,6 +42,11 @@ class Vertexer(Producer) :
     trk_c_name_2 : str
         Name of a track collection to vertex. This is unique from
         trk_c_name_1.
+    max_doca : float
+        Largest distance in mm between the straight lines of two tracks at
+        the perigee for the pair to be fit.
+    n_pair_threads : int
+        Number of threads fitting the pairs of tracks of an event.
 
     Parameters
     ----------
@@ -55,3 +60,5 @@ class Vertexer(Producer) :
         self.field_map = makeFieldMapPath()
         trk_c_name_1 = 'TaggerTracks'
         trk_c_name_2 = 'RecoilTracks'
+        self.max_doca = 2.
+        self.n_pair_threads = 1
@@ -36,6 +36,9 @@ void AlignmentTestProcessor::onNewRun(const ldmx::RunHeader& rh) {
   // Try to correct back 2100
   // translate, then rotate
   test_gctx_.addAlignCorrection(2100, -deltaT, -deltaR, false);
+
+  // Make the corrections seen by the surfaces
+  test_gctx_.publish();
 }
 
 void AlignmentTestProcessor::produce(framework::Event& event) {
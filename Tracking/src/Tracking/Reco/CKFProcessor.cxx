@@ -1,13 +1,17 @@
 #include "Tracking/Reco/CKFProcessor.h"
 
 #include "Acts/EventData/TrackHelpers.hpp"
+#include "Framework/Performance/Profile.h"
 #include "SimCore/Event/SimParticle.h"
 #include "Tracking/Reco/TruthMatchingTool.h"
 #include "Tracking/Sim/GeometryContainers.h"
 
 //--- C++ StdLib ---//
 #include <algorithm>  //std::vector reverse
+#include <atomic>
 #include <iostream>
+#include <optional>
+#include <thread>
 
 // eN files
 #include <fstream>
@@ -21,13 +25,6 @@ CKFProcessor::CKFProcessor(const std::string& name, framework::Process& process)
 CKFProcessor::~CKFProcessor() {}
 
 void CKFProcessor::onNewRun(const ldmx::RunHeader& rh) {
-  profiling_map_["setup"] = 0.;
-  profiling_map_["hits"] = 0.;
-  profiling_map_["seeds"] = 0.;
-  profiling_map_["ckf_setup"] = 0.;
-  profiling_map_["ckf_run"] = 0.;
-  profiling_map_["result_loop"] = 0.;
-
   // Generate a constant magnetic field
   Acts::Vector3 b_field(0., 0., bfield_ * Acts::UnitConstants::T);
 
@@ -92,11 +89,19 @@ void CKFProcessor::onNewRun(const ldmx::RunHeader& rh) {
   };
 
   // Setup a interpolated bfield map
-  const auto map = std::make_shared<InterpolatedMagneticField3>(
-      loadDefaultBField(field_map_,
-                        // default_transformPos,
-                        // default_transformBField));
-                        transformPos, transformBField));
+  //  the map of the conditions is shared with the other processors, it
+  //  has the default transformations, which ours are when not shifted
+  std::shared_ptr<const InterpolatedMagneticField3> map;
+  if (map_offset_ == std::vector<double>{0., 0., 0.} and
+      magnetic_field_map().getFieldMap() == field_map_) {
+    map = magnetic_field_map().get();
+  } else {
+    map = std::make_shared<InterpolatedMagneticField3>(
+        loadDefaultBField(field_map_,
+                          // default_transformPos,
+                          // default_transformBField));
+                          transformPos, transformBField));
+  }
 
   auto acts_loggingLevel = Acts::Logging::FATAL;
   if (debug_) acts_loggingLevel = Acts::Logging::VERBOSE;
@@ -129,29 +134,15 @@ void CKFProcessor::onNewRun(const ldmx::RunHeader& rh) {
       *propagator_, Acts::getDefaultLogger("CKF", acts_loggingLevel));
   trk_extrap_ = std::make_shared<std::decay_t<decltype(*trk_extrap_)>>(
       *propagator_, geometry_context(), magnetic_field_context());
-}
-
-void CKFProcessor::produce(framework::Event& event) {
-  eventnr_++;
-  // get the tracking geometry from conditions
-  auto tg{geometry()};
-
-  // TODO use global variable instead and call clear;
 
-  std::vector<ldmx::Track> tracks;
-
-  auto start = std::chrono::high_resolution_clock::now();
-
-  nevents_++;
-  if (nevents_ % 1000 == 0) ldmx_log(info) << "events processed:" << nevents_;
-
-  auto loggingLevel = Acts::Logging::DEBUG;
-  ACTS_LOCAL_LOGGER(
-      Acts::getDefaultLogger("LDMX Tracking Geometry Maker", loggingLevel));
+  // Everything below does not change from one event to the next, so it is
+  //  set up here once instead of in produce
 
-  // Move this at the start of the producer
-  Acts::PropagatorOptions<ActionList, AbortList> propagator_options(
-      geometry_context(), magnetic_field_context());
+  // The propagator options
+  propagator_options_ =
+      std::make_unique<Acts::PropagatorOptions<ActionList, AbortList>>(
+          geometry_context(), magnetic_field_context());
+  auto& propagator_options{*propagator_options_};
 
   propagator_options.pathLimit = std::numeric_limits<double>::max();
 
@@ -178,6 +169,114 @@ void CKFProcessor::produce(framework::Event& event) {
   // Electron hypothesis
   propagator_options.mass = 0.511 * Acts::UnitConstants::MeV;
 
+  // configuration for the measurement selector. Empty geometry identifier means
+  // applicable to all the detector elements
+
+  Acts::MeasurementSelector::Config measurementSelectorCfg = {
+      // global default: no chi2 cut, only one measurement per surface
+      {Acts::GeometryIdentifier(), {{}, {outlier_pval_}, {1u}}},
+  };
+
+  meas_sel_ =
+      std::make_unique<Acts::MeasurementSelector>(measurementSelectorCfg);
+
+  if (use1Dmeasurements_)
+    ckf_extensions_.calibrator
+        .connect<&tracking::sim::LdmxMeasurementCalibrator::calibrate_1d>(
+            &calibrator_);
+
+  else
+    ckf_extensions_.calibrator
+        .connect<&tracking::sim::LdmxMeasurementCalibrator::calibrate>(
+            &calibrator_);
+
+  ckf_extensions_.updater.connect<
+      &Acts::GainMatrixUpdater::operator()<Acts::VectorMultiTrajectory>>(
+      &kf_updater_);
+  ckf_extensions_.smoother.connect<
+      &Acts::GainMatrixSmoother::operator()<Acts::VectorMultiTrajectory>>(
+      &kf_smoother_);
+
+  ckf_extensions_.measurementSelector
+      .connect<&Acts::MeasurementSelector::select<Acts::VectorMultiTrajectory>>(
+          meas_sel_.get());
+
+  // The surface the found tracks are expressed at
+  Acts::RotationMatrix3 target_surf_rotation = Acts::RotationMatrix3::Zero();
+  // u direction along +Y
+  target_surf_rotation(1, 0) = 1;
+  // v direction along +Z
+  target_surf_rotation(2, 1) = 1;
+  // w direction along +X
+  target_surf_rotation(0, 2) = 1;
+  //
+  Acts::Vector3 target_center_unbound(0., 0., 0.);
+  Acts::Translation3 target_center_translation(target_center_unbound);
+  Acts::Transform3 target_center_transform(target_center_translation *
+                                           target_surf_rotation);
+
+  // Unbounded surface...different from above tgt_surface is that this is a
+  // plane and not perigee surface (cylinder)
+  tgt_surface_unbound_ =
+      Acts::Surface::makeShared<Acts::PlaneSurface>(target_center_transform);
+
+  // The surfaces the tracks are extrapolated to
+
+  // Define the target surface - be careful:
+  //  x - downstream
+  //  y - left (when looking along x)
+  //  z - up
+  //  Passing identity here means that your target surface is oriented in the
+  //  same way
+  Acts::RotationMatrix3 surf_rotation = Acts::RotationMatrix3::Zero();
+  // u direction along +Y
+  surf_rotation(1, 0) = 1;
+  // v direction along +Z
+  surf_rotation(2, 1) = 1;
+  // w direction along +X
+  surf_rotation(0, 2) = 1;
+
+  const double ECAL_SCORING_PLANE = 240.5;
+  Acts::Vector3 pos(ECAL_SCORING_PLANE, 0., 0.);
+  Acts::Translation3 surf_translation(pos);
+  Acts::Transform3 surf_transform(surf_translation * surf_rotation);
+
+  // Unbounded surface
+  ecal_surface_ = Acts::Surface::makeShared<Acts::PlaneSurface>(surf_transform);
+
+  Acts::Vector3 target_pos(0., 0., 0.);
+  Acts::Translation3 target_translation(target_pos);
+  Acts::Transform3 target_transform(target_translation * surf_rotation);
+
+  // Unbounded surface
+  target_surface_ =
+      Acts::Surface::makeShared<Acts::PlaneSurface>(target_transform);
+
+  // Beam Origin unbounded surface
+  beam_origin_surface_ = tracking::sim::utils::unboundSurface(-700);
+}
+
+void CKFProcessor::produce(framework::Event& event) {
+  eventnr_++;
+  // get the tracking geometry from conditions
+  auto tg{geometry()};
+
+  // TODO use global variable instead and call clear;
+
+  std::vector<ldmx::Track> tracks;
+
+  auto start = StageProfile::now();
+
+  nevents_++;
+  if (nevents_ % 1000 == 0) ldmx_log(info) << "events processed:" << nevents_;
+
+  auto loggingLevel = Acts::Logging::DEBUG;
+  ACTS_LOCAL_LOGGER(
+      Acts::getDefaultLogger("LDMX Tracking Geometry Maker", loggingLevel));
+
+  // The options are set up once per run, each seed works on a copy
+  const auto& propagator_options{*propagator_options_};
+
   // #######################//
   // Kalman Filter algorithm//
   // #######################//
@@ -186,11 +285,9 @@ void CKFProcessor::produce(framework::Event& event) {
 
   // a) Loop over the sim Hits
 
-  auto setup = std::chrono::high_resolution_clock::now();
-  profiling_map_["setup"] +=
-      std::chrono::duration<double, std::milli>(setup - start).count();
+  auto setup = profile_.add("setup", start);
 
-  const std::vector<ldmx::Measurement> measurements =
+  const std::vector<ldmx::Measurement>& measurements =
       event.getCollection<ldmx::Measurement>(measurement_collection_);
 
   // check if SimParticleMap is available for truth matching
@@ -206,11 +303,18 @@ void CKFProcessor::produce(framework::Event& event) {
 
   // The mapping between the geometry identifier
   // and the IndexsourceLink that points to the hit
-  const auto geoId_sl_map = makeGeoIdSourceLinkMap(tg, measurements);
+  const auto& geoId_sl_map = makeGeoIdSourceLinkMap(tg, measurements);
+
+  if (profiling_histograms_) {
+    // the source links are sorted by surface
+    for (auto sl{geoId_sl_map.begin()}; sl != geoId_sl_map.end();) {
+      auto [begin, end] = geoId_sl_map.equal_range(sl->geometryId());
+      histograms_.fill(n_surface_measurements_id_, std::distance(begin, end));
+      sl = end;
+    }
+  }
 
-  auto hits = std::chrono::high_resolution_clock::now();
-  profiling_map_["hits"] +=
-      std::chrono::duration<double, std::milli>(hits - setup).count();
+  auto hits = profile_.add("hits", setup);
 
   // ============   Setup the CKF  ============
 
@@ -218,7 +322,7 @@ void CKFProcessor::produce(framework::Event& event) {
 
   ldmx_log(debug) << "Retrieve the seeds::" << seed_coll_name_;
 
-  const std::vector<ldmx::Track> seed_tracks =
+  const std::vector<ldmx::Track>& seed_tracks =
       event.getCollection<ldmx::Track>(seed_coll_name_);
 
   // Run the CKF on each seed and produce a track candidate
@@ -270,48 +374,11 @@ void CKFProcessor::produce(framework::Event& event) {
     return;
   }
 
-  auto seeds = std::chrono::high_resolution_clock::now();
-  profiling_map_["seeds"] +=
-      std::chrono::duration<double, std::milli>(seeds - hits).count();
-
-  Acts::GainMatrixUpdater kfUpdater;
-  Acts::GainMatrixSmoother kfSmoother;
+  auto seeds = profile_.add("seeds", hits);
 
-  // configuration for the measurement selector. Empty geometry identifier means
-  // applicable to all the detector elements
-
-  Acts::MeasurementSelector::Config measurementSelectorCfg = {
-      // global default: no chi2 cut, only one measurement per surface
-      {Acts::GeometryIdentifier(), {{}, {outlier_pval_}, {1u}}},
-  };
-
-  Acts::MeasurementSelector measSel{measurementSelectorCfg};
-
-  tracking::sim::LdmxMeasurementCalibrator calibrator{measurements};
-
-  Acts::CombinatorialKalmanFilterExtensions<Acts::VectorMultiTrajectory>
-      ckf_extensions;
-
-  if (use1Dmeasurements_)
-    ckf_extensions.calibrator
-        .connect<&tracking::sim::LdmxMeasurementCalibrator::calibrate_1d>(
-            &calibrator);
-
-  else
-    ckf_extensions.calibrator
-        .connect<&tracking::sim::LdmxMeasurementCalibrator::calibrate>(
-            &calibrator);
-
-  ckf_extensions.updater.connect<
-      &Acts::GainMatrixUpdater::operator()<Acts::VectorMultiTrajectory>>(
-      &kfUpdater);
-  ckf_extensions.smoother.connect<
-      &Acts::GainMatrixSmoother::operator()<Acts::VectorMultiTrajectory>>(
-      &kfSmoother);
-
-  ckf_extensions.measurementSelector
-      .connect<&Acts::MeasurementSelector::select<Acts::VectorMultiTrajectory>>(
-          &measSel);
+  // The extensions are connected to the calibrator once per run, it only
+  //  has to be pointed to the measurements of this event
+  calibrator_ = tracking::sim::LdmxMeasurementCalibrator{measurements};
 
   ldmx_log(debug) << "SourceLinkAccessor..." << std::endl;
 
@@ -340,7 +407,7 @@ void CKFProcessor::produce(framework::Event& event) {
     // const value_type& operator*() const { return it->second; }
 
     // by value
-    value_type operator*() const { return value_type{it->second}; }
+    value_type operator*() const { return value_type{*it}; }
   };
 
   auto sourceLinkAccessor = [&](const Acts::Surface& surface)
@@ -356,25 +423,7 @@ void CKFProcessor::produce(framework::Event& event) {
 
   ldmx_log(debug) << "Surfaces..." << std::endl;
 
-  Acts::RotationMatrix3 target_surf_rotation = Acts::RotationMatrix3::Zero();
-  // u direction along +Y
-  target_surf_rotation(1, 0) = 1;
-  // v direction along +Z
-  target_surf_rotation(2, 1) = 1;
-  // w direction along +X
-  target_surf_rotation(0, 2) = 1;
-  //
-  Acts::Vector3 target_center_unbound(0., 0., 0.);
-  Acts::Translation3 target_center_translation(target_center_unbound);
-  Acts::Transform3 target_center_transform(target_center_translation *
-                                           target_surf_rotation);
-
-  // Unbounded surface...different from above tgt_surface is that this is a
-  // plane and not perigee surface (cylinder)
-  const std::shared_ptr<Acts::PlaneSurface> tgt_surface_unbound =
-      Acts::Surface::makeShared<Acts::PlaneSurface>(target_center_transform);
-
-  auto extr_surface = &(*tgt_surface_unbound);
+  auto extr_surface = &(*tgt_surface_unbound_);
 
   //  std::shared_ptr<const Acts::PerigeeSurface> origin_surface =
   //  Acts::Surface::makeShared<Acts::PerigeeSurface>(
@@ -384,33 +433,40 @@ void CKFProcessor::produce(framework::Event& event) {
   ldmx_log(debug) << "About to run CKF..." << std::endl;
 
   // run the CKF for all initial track states
-  auto ckf_setup = std::chrono::high_resolution_clock::now();
-  profiling_map_["ckf_setup"] +=
-      std::chrono::duration<double, std::milli>(ckf_setup - seeds).count();
-
-  auto ckf_run = std::chrono::high_resolution_clock::now();
-  profiling_map_["ckf_run"] +=
-      std::chrono::duration<double, std::milli>(ckf_run - ckf_setup).count();
+  auto ckf_setup = profile_.add("ckf_setup", seeds);
+
+  // The seeds are followed independently, by several threads if asked
+  //  to. Each seed fills its own track container and the tracks are
+  //  collected in the order of the seeds, so they don't depend on the
+  //  threads. The truth matching fills the particle map, so it is done
+  //  after the tracks are collected, and the conditions are all taken
+  //  before the threads start. Each thread has its own track containers,
+  //  kept from one event to the next.
+  const Acts::GeometryContext& gctx{geometry_context()};
+  const Acts::MagneticFieldContext& mctx{magnetic_field_context()};
+  const Acts::CalibrationContext& cctx{calibration_context()};
+  // the time and the number of branches of each seed, filled in the
+  //  histograms once the threads are done
+  std::vector<double> seed_times(startParameters.size(), 0.);
+  std::vector<std::size_t> seed_branches(startParameters.size(), 0);
+  auto follow_seed = [&](std::size_t trackId,
+                         TrackBuffers& buffers) -> std::optional<ldmx::Track> {
+    // the containers keep their memory from the previous seeds
+    buffers.vtc.clear();
+    buffers.mtj.clear();
+    Acts::TrackContainer tc{buffers.vtc, buffers.mtj};
 
-  Acts::VectorTrackContainer vtc;
-  Acts::VectorMultiTrajectory mtj;
-  Acts::TrackContainer tc{vtc, mtj};
-
-  for (size_t trackId = 0u; trackId < startParameters.size(); ++trackId) {
     // The seed has a track PdgID associated
-    if (seedPDGID.at(trackId) != 0) {
-      int pdgID = seedPDGID.at(trackId);
-
-      if (pdgID == 2212 || pdgID == -2212)
-        propagator_options.mass = 938 * Acts::UnitConstants::MeV;
-    }
+    auto seed_propagator_options{propagator_options};
+    int pdgID = seedPDGID.at(trackId);
+    if (pdgID == 2212 || pdgID == -2212)
+      seed_propagator_options.mass = 938 * Acts::UnitConstants::MeV;
 
     // Define the CKF options here:
     const Acts::CombinatorialKalmanFilterOptions<SourceLinkAccIt,
                                                  Acts::VectorMultiTrajectory>
-        ckfOptions(geometry_context(), magnetic_field_context(),
-                   calibration_context(), sourceLinkAccessorDelegate,
-                   ckf_extensions, propagator_options, &(*extr_surface));
+        ckfOptions(gctx, mctx, cctx, sourceLinkAccessorDelegate,
+                   ckf_extensions, seed_propagator_options, &(*extr_surface));
 
     ldmx_log(debug) << "Running CKF on seed params "
                     << startParameters.at(trackId).parameters().transpose()
@@ -421,11 +477,12 @@ void CKFProcessor::produce(framework::Event& event) {
 
     if (not results.ok()) {
       ldmx_log(debug) << "CKF Fit failed" << std::endl;
-      continue;
+      return std::nullopt;
     }
+    seed_branches[trackId] = tc.size();
 
     // No track found
-    if (tc.size() < trackId + 1) continue;
+    if (tc.size() < 1) return std::nullopt;
 
     ldmx_log(debug) << "Filling track info" << std::endl;
 
@@ -435,7 +492,7 @@ void CKFProcessor::produce(framework::Event& event) {
     //                                                        //.container()
     //                                                        //.trackStateContainer();
 
-    auto track = tc.getTrack(trackId);
+    auto track = tc.getTrack(0);
     calculateTrackQuantities(track);
     // MG ... if I converted above to target surface, these should be parameters
     // at target (should change names)
@@ -452,17 +509,16 @@ void CKFProcessor::produce(framework::Event& event) {
         << perigee_pars[Acts::eBoundTheta] << " "
         << perigee_pars[Acts::eBoundQOverP] << std::endl
         << "Reference Surface" << std::endl
-        << " " << perigee_surface.transform(geometry_context()).translation()(0)
-        << " " << perigee_surface.transform(geometry_context()).translation()(1)
-        << " " << perigee_surface.transform(geometry_context()).translation()(2)
+        << " " << perigee_surface.transform(gctx).translation()(0)
+        << " " << perigee_surface.transform(gctx).translation()(1)
+        << " " << perigee_surface.transform(gctx).translation()(2)
         << std::endl
         << "nHoles  " << track.nHoles();
 
     ldmx::Track trk = ldmx::Track();
-    trk.setPerigeeLocation(
-        perigee_surface.transform(geometry_context()).translation()(0),
-        perigee_surface.transform(geometry_context()).translation()(1),
-        perigee_surface.transform(geometry_context()).translation()(2));
+    trk.setPerigeeLocation(perigee_surface.transform(gctx).translation()(0),
+                           perigee_surface.transform(gctx).translation()(1),
+                           perigee_surface.transform(gctx).translation()(2));
 
     trk.setChi2(track.chi2());
     trk.setNhits(track.nMeasurements());
@@ -485,7 +541,7 @@ void CKFProcessor::produce(framework::Event& event) {
       // Check TrackStates Quality
       ldmx_log(debug) << "Checking Track State at location "
                       << ts.referenceSurface()
-                             .transform(geometry_context())
+                             .transform(gctx)
                              .translation()
                              .transpose()
                       << std::endl;
@@ -510,48 +566,13 @@ void CKFProcessor::produce(framework::Event& event) {
       }
     }
 
-    // Extrapolations
-
-    // Define the target surface - be careful:
-    //  x - downstream
-    //  y - left (when looking along x)
-    //  z - up
-    //  Passing identity here means that your target surface is oriented in the
-    //  same way
-    Acts::RotationMatrix3 surf_rotation = Acts::RotationMatrix3::Zero();
-    // u direction along +Y
-    surf_rotation(1, 0) = 1;
-    // v direction along +Z
-    surf_rotation(2, 1) = 1;
-    // w direction along +X
-    surf_rotation(0, 2) = 1;
-
-    const double ECAL_SCORING_PLANE = 240.5;
-    Acts::Vector3 pos(ECAL_SCORING_PLANE, 0., 0.);
-    Acts::Translation3 surf_translation(pos);
-    Acts::Transform3 surf_transform(surf_translation * surf_rotation);
-
-    // Unbounded surface
-    const std::shared_ptr<Acts::PlaneSurface> ecal_surface =
-        Acts::Surface::makeShared<Acts::PlaneSurface>(surf_transform);
-
-    Acts::Vector3 target_pos(0., 0., 0.);
-    Acts::Translation3 target_translation(target_pos);
-    Acts::Transform3 target_transform(target_translation * surf_rotation);
-
-    // Unbounded surface
-    const std::shared_ptr<Acts::PlaneSurface> target_surface =
-        Acts::Surface::makeShared<Acts::PlaneSurface>(target_transform);
-
-    // Beam Origin unbounded surface
-    const std::shared_ptr<Acts::Surface> beamOrigin_surface =
-        tracking::sim::utils::unboundSurface(-700);
+    // Extrapolations to the surfaces set up in onNewRun
 
     ldmx_log(debug) << "Target extrapolation  ...  this should not change "
                        "anything since track is stored at target plane";
     ldmx::Track::TrackState tsAtTarget;
     bool success = trk_extrap_->TrackStateAtSurface(
-        track, target_surface, tsAtTarget, ldmx::TrackStateType::AtTarget);
+        track, target_surface_, tsAtTarget, ldmx::TrackStateType::AtTarget);
     ldmx_log(debug) << "target extrapolation success??? " << success;
     if (success) {
       ldmx_log(debug) << "Successfully obtained TS at target";
@@ -566,7 +587,7 @@ void CKFProcessor::produce(framework::Event& event) {
       ldmx_log(debug) << "Beam Origin Extrapolation";
       ldmx::Track::TrackState tsAtBeamOrigin;
       bool success = trk_extrap_->TrackStateAtSurface(
-          track, beamOrigin_surface, tsAtBeamOrigin,
+          track, beam_origin_surface_, tsAtBeamOrigin,
           ldmx::TrackStateType::AtBeamOrigin);
 
       if (success) {
@@ -579,8 +600,8 @@ void CKFProcessor::produce(framework::Event& event) {
     if (!taggerTracking_) {
       ldmx_log(debug) << "Ecal Extrapolation";
       ldmx::Track::TrackState tsAtEcal;
-      success = trk_extrap_->TrackStateAtSurface(track, ecal_surface, tsAtEcal,
-                                                 ldmx::TrackStateType::AtECAL);
+      success = trk_extrap_->TrackStateAtSurface(
+          track, ecal_surface_, tsAtEcal, ldmx::TrackStateType::AtECAL);
 
       if (success) {
         trk.addTrackState(tsAtEcal);
@@ -592,25 +613,80 @@ void CKFProcessor::produce(framework::Event& event) {
       }
     }
 
+    return trk;
+  };
+  auto find_track = [&](std::size_t trackId, TrackBuffers& buffers) {
+    LDMX_PROFILE_SCOPE("CKF::seed");
+    auto seed_start = StageProfile::now();
+    auto trk{follow_seed(trackId, buffers)};
+    seed_times[trackId] = std::chrono::duration<double, std::milli>(
+                              StageProfile::now() - seed_start)
+                              .count();
+    return trk;
+  };
+
+  std::vector<std::optional<ldmx::Track>> found(startParameters.size());
+  std::size_t n_workers{
+      std::min(std::size_t(n_seed_threads_), startParameters.size())};
+  while (track_buffers_.size() < n_workers) {
+    track_buffers_.push_back(std::make_unique<TrackBuffers>());
+  }
+  if (n_workers > 1) {
+    // each thread takes the next seed nobody has taken yet
+    std::atomic<std::size_t> next_seed{0};
+    std::vector<std::exception_ptr> errors(n_workers);
+    auto run_worker = [&](std::size_t i_worker) {
+      try {
+        for (std::size_t i_seed{next_seed++}; i_seed < found.size();
+             i_seed = next_seed++)
+          found[i_seed] = find_track(i_seed, *track_buffers_[i_worker]);
+      } catch (...) {
+        errors[i_worker] = std::current_exception();
+      }
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t i_worker{1}; i_worker < n_workers; i_worker++) {
+      workers.emplace_back(run_worker, i_worker);
+    }
+    run_worker(0);
+    for (std::thread& worker : workers) worker.join();
+    for (auto& error : errors) {
+      if (error) std::rethrow_exception(error);
+    }
+  } else {
+    for (std::size_t i_seed = 0; i_seed < found.size(); i_seed++)
+      found[i_seed] = find_track(i_seed, *track_buffers_[0]);
+  }
+
+  auto ckf_run = profile_.add("ckf_run", ckf_setup);
+
+  if (profiling_histograms_) {
+    for (std::size_t i_seed = 0; i_seed < found.size(); i_seed++) {
+      histograms_.fill(n_branches_id_, seed_branches[i_seed]);
+    }
+  }
+  for (double seed_time : seed_times) profile_.add("seed", seed_time);
+
+  for (auto& trk : found) {
+    if (not trk) continue;
+
     // Truth matching
     if (truthMatchingTool) {
-      auto truthInfo = truthMatchingTool->TruthMatch(trk);
-      trk.setTrackID(truthInfo.trackID);
-      trk.setPdgID(truthInfo.pdgID);
-      trk.setTruthProb(truthInfo.truthProb);
+      auto truthInfo = truthMatchingTool->TruthMatch(*trk);
+      trk->setTrackID(truthInfo.trackID);
+      trk->setPdgID(truthInfo.pdgID);
+      trk->setTruthProb(truthInfo.truthProb);
     }
 
     // At least 8 hits and p > 50 MeV
-    if (trk.getNhits() > min_hits_ && abs(1. / trk.getQoP()) > 0.05) {
-      tracks.push_back(trk);
+    if (trk->getNhits() > min_hits_ && abs(1. / trk->getQoP()) > 0.05) {
+      tracks.push_back(*trk);
       ntracks_++;
     }
 
   }  // loop seed track parameters
 
-  auto result_loop = std::chrono::high_resolution_clock::now();
-  profiling_map_["result_loop"] +=
-      std::chrono::duration<double, std::milli>(result_loop - ckf_run).count();
+  profile_.add("result_loop", ckf_run);
 
   // Add the tracks to the event
   event.add(out_trk_collection_, tracks);
@@ -619,10 +695,24 @@ void CKFProcessor::produce(framework::Event& event) {
   // long long microseconds =
   // std::chrono::duration_cast<std::chrono::microseconds>(end-start).count();
   auto diff = end - start;
-  processing_time_ += std::chrono::duration<double, std::milli>(diff).count();
+  double event_time{std::chrono::duration<double, std::milli>(diff).count()};
+  processing_time_ += event_time;
+  profile_.add("event", event_time);
 }
 
 void CKFProcessor::onProcessStart() {
+  if (profiling_histograms_) {
+    getHistoDirectory();
+    profile_.book(histograms_, {"event", "setup", "hits", "seeds", "ckf_setup",
+                                "ckf_run", "result_loop", "seed"});
+    histograms_.create("n_branches", "branches found from a seed", 50, 0., 50.);
+    n_branches_id_ = histograms_.id("n_branches");
+    histograms_.create("n_surface_measurements",
+                       "measurements on a surface with measurements", 20, 0.,
+                       20.);
+    n_surface_measurements_id_ = histograms_.id("n_surface_measurements");
+  }
+
   if (use1Dmeasurements_)
     ldmx_log(info) << "use1Dmeasurements = " << std::boolalpha
                    << use1Dmeasurements_;
@@ -636,17 +726,17 @@ void CKFProcessor::onProcessEnd() {
   ldmx_log(info) << "AVG Time/Event: " << processing_time_ / nevents_ << " ms";
   ldmx_log(info) << "Breakdown::";
   ldmx_log(info) << "setup       Avg Time/Event = "
-                 << profiling_map_["setup"] / nevents_ << " ms";
+                 << profile_.total("setup") / nevents_ << " ms";
   ldmx_log(info) << "hits        Avg Time/Event = "
-                 << profiling_map_["hits"] / nevents_ << " ms";
+                 << profile_.total("hits") / nevents_ << " ms";
   ldmx_log(info) << "seeds       Avg Time/Event = "
-                 << profiling_map_["seeds"] / nevents_ << " ms";
+                 << profile_.total("seeds") / nevents_ << " ms";
   ldmx_log(info) << "cf_setup    Avg Time/Event = "
-                 << profiling_map_["ckf_setup"] / nevents_ << " ms";
+                 << profile_.total("ckf_setup") / nevents_ << " ms";
   ldmx_log(info) << "ckf_run     Avg Time/Event = "
-                 << profiling_map_["ckf_run"] / nevents_ << " ms";
+                 << profile_.total("ckf_run") / nevents_ << " ms";
   ldmx_log(info) << "result_loop Avg Time/Event = "
-                 << profiling_map_["result_loop"] / nevents_ << " ms";
+                 << profile_.total("result_loop") / nevents_ << " ms";
 }
 
 void CKFProcessor::configure(framework::config::Parameters& parameters) {
@@ -693,23 +783,31 @@ void CKFProcessor::configure(framework::config::Parameters& parameters) {
   // BField Systematics
   map_offset_ =
       parameters.getParameter<std::vector<double>>("map_offset_", {0., 0., 0.});
+
+  profiling_histograms_ =
+      parameters.getParameter<bool>("profiling_histograms", false);
+
+  // threads following the seeds of an event
+  n_seed_threads_ = parameters.getParameter<int>("n_seed_threads", 1);
+  if (n_seed_threads_ < 1) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The number of seed threads must be at least one, but " +
+                        std::to_string(n_seed_threads_) + " was given.");
+  }
 }
 
-auto CKFProcessor::makeGeoIdSourceLinkMap(
+const ActsExamples::IndexSourceLinkContainer&
+CKFProcessor::makeGeoIdSourceLinkMap(
     const geo::TrackersTrackingGeometry& tg,
-    const std::vector<ldmx::Measurement>& measurements)
-    -> std::unordered_multimap<Acts::GeometryIdentifier,
-                               ActsExamples::IndexSourceLink> {
-  std::unordered_multimap<Acts::GeometryIdentifier,
-                          ActsExamples::IndexSourceLink>
-      geoId_sl_map;
+    const std::vector<ldmx::Measurement>& measurements) {
+  sorted_source_links_.clear();
 
   ldmx_log(debug) << "makeGeoIdSourceLinkMap::Available measurements"
                   << measurements.size();
 
   // Check the hits associated to the surfaces
   for (unsigned int i_meas = 0; i_meas < measurements.size(); i_meas++) {
-    ldmx::Measurement meas = measurements.at(i_meas);
+    const ldmx::Measurement& meas = measurements.at(i_meas);
     unsigned int layerid = meas.getLayerID();
 
     const Acts::Surface* hit_surface = tg.getSurface(layerid);
@@ -729,7 +827,7 @@ auto CKFProcessor::makeGeoIdSourceLinkMap(
       ldmx_log(debug) << "Surface info::"
                       << std::tie(*hit_surface, geometry_context());
 
-      geoId_sl_map.insert(std::make_pair(hit_surface->geometryId(), idx_sl));
+      sorted_source_links_.push_back(idx_sl);
 
     } else
       std::cout << getName() << "::HIT " << i_meas << " at layer"
@@ -737,7 +835,15 @@ auto CKFProcessor::makeGeoIdSourceLinkMap(
                 << " is not associated to any surface?!" << std::endl;
   }
 
-  return geoId_sl_map;
+  // The links of a surface stay in the order of the measurements, and the
+  //  sorted links are copied into the flat multiset without searching
+  std::stable_sort(sorted_source_links_.begin(), sorted_source_links_.end(),
+                   ActsExamples::detail::CompareGeometryId{});
+  source_links_.clear();
+  source_links_.insert(boost::container::ordered_range,
+                       sorted_source_links_.begin(),
+                       sorted_source_links_.end());
+  return source_links_;
 }
 
 }  // namespace reco
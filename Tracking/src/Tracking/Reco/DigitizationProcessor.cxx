@@ -1,6 +1,7 @@
 #include "Tracking/Reco/DigitizationProcessor.h"
 
 #include <chrono>
+#include <cmath>
 
 #include "Tracking/Event/Measurement.h"
 #include "Tracking/Sim/TrackingUtils.h"
@@ -66,6 +67,17 @@ void DigitizationProcessor::configure(
   sigma_u_ = parameters.getParameter<double>("sigma_u", 0.01);
   sigma_v_ = parameters.getParameter<double>("sigma_v", 0.);
   merge_hits_ = parameters.getParameter<bool>("merge_hits", false);
+  strip_sim_ = parameters.getParameter<bool>("strip_sim", false);
+  strip_threshold_ = parameters.getParameter<double>("strip_threshold", 2000.);
+  segment_length_ = parameters.getParameter<double>("segment_length", 0.01);
+  if (strip_sim_) {
+    strips_ = std::make_unique<tracking::digitization::StripChargeDeposition>(
+        parameters.getParameter<int>("n_strips", 640),
+        parameters.getParameter<double>("strip_pitch", 0.06),
+        parameters.getParameter<double>("sensor_thickness", 0.32),
+        parameters.getParameter<int>("readout_side", -1),
+        parameters.getParameter<double>("diffusion_sigma", 0.008));
+  }
 }
 
 void DigitizationProcessor::onNewRun(const ldmx::RunHeader& runHeader) {
@@ -253,13 +265,38 @@ std::vector<ldmx::Measurement> DigitizationProcessor::digitizeHits(
           continue;
         }
 
-        // Smear the local position
-        if (do_smearing_) {
-          float smear_factor{(*normal_)(generator_)};
+        // Share the charge among the strips, the path of the hit is a
+        // straight line through its position along its momentum
+        if (strip_sim_) {
+          const auto& transform{hit_surface->transform(geometry_context())};
+          Acts::Vector3 center{transform.inverse() * global_pos};
+          Acts::Vector3 direction{
+              sim_hit.getMomentum()[0], sim_hit.getMomentum()[1],
+              sim_hit.getMomentum()[2]};
+          direction = transform.rotation().transpose() * direction.normalized();
+          double length{sim_hit.getPathLength()};
+          Acts::Vector3 entry{center - 0.5 * length * direction};
+          Acts::Vector3 exit{center + 0.5 * length * direction};
+          // electron-hole pairs, 3.62 eV each
+          double charge{sim_hit.getEdep() / 3.62e-6};
+          strips_->clear();
+          strips_->deposit(entry(0), entry(2), exit(0), exit(2), charge,
+                           int(std::ceil(length / segment_length_)));
+          double u{0.};
+          if (not strips_->centroid(strip_threshold_, u)) continue;
+          local_pos[0] = u;
+        }
 
-          local_pos[0] += smear_factor * sigma_u_;
-          smear_factor = (*normal_)(generator_);
-          local_pos[1] += smear_factor * sigma_v_;
+        // Smear the local position
+        if (do_smearing_ or strip_sim_) {
+          if (do_smearing_) {
+            float smear_factor{(*normal_)(generator_)};
+
+            // the strip simulation already gave u its resolution
+            if (not strip_sim_) local_pos[0] += smear_factor * sigma_u_;
+            smear_factor = (*normal_)(generator_);
+            local_pos[1] += smear_factor * sigma_v_;
+          }
 
           // update covariance
           measurement.setLocalCovariance(sigma_u_ * sigma_u_,
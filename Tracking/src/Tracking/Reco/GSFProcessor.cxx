@@ -1,6 +1,7 @@
 #include "Tracking/Reco/GSFProcessor.h"
 
 #include <algorithm>
+#include <map>
 
 #include "Acts/EventData/SourceLink.hpp"
 
@@ -67,11 +68,18 @@ void GSFProcessor::onNewRun(const ldmx::RunHeader& rh) {
   };
 
   // Setup a interpolated bfield map
-  const auto map = std::make_shared<InterpolatedMagneticField3>(
-      loadDefaultBField(field_map_,
-                        // default_transformPos,
-                        // default_transformBField));
-                        transformPos, transformBField));
+  //  the map of the conditions is shared with the other processors, it
+  //  has the default transformations, which ours are when not shifted
+  std::shared_ptr<const InterpolatedMagneticField3> map;
+  if (magnetic_field_map().getFieldMap() == field_map_) {
+    map = magnetic_field_map().get();
+  } else {
+    map = std::make_shared<InterpolatedMagneticField3>(
+        loadDefaultBField(field_map_,
+                          // default_transformPos,
+                          // default_transformBField));
+                          transformPos, transformBField));
+  }
 
   auto acts_loggingLevel = Acts::Logging::ERROR;
 
@@ -80,13 +88,10 @@ void GSFProcessor::onNewRun(const ldmx::RunHeader& rh) {
   // Setup the GSF Fitter
 
   // Stepper
-  // Acts::MixtureReductionMethod finalReductionMethod;
   // const auto multi_stepper = Acts::MultiEigenStepperLoop{map};
 
-  Acts::MixtureReductionMethod reductionMethod =
-      Acts::MixtureReductionMethod::eMaxWeight;
   Acts::MultiEigenStepperLoop multi_stepper(
-      map, reductionMethod,
+      map, reductionMethod_,
       Acts::getDefaultLogger("GSF_STEP", acts_loggingLevel));
 
   // Detailed Stepper
@@ -120,62 +125,25 @@ void GSFProcessor::onNewRun(const ldmx::RunHeader& rh) {
 
   trk_extrap_ = std::make_shared<std::decay_t<decltype(*trk_extrap_)>>(
       *propagator_, geometry_context(), magnetic_field_context());
-}
-
-void GSFProcessor::configure(framework::config::Parameters& parameters) {
-  out_trk_collection_ =
-      parameters.getParameter<std::string>("out_trk_collection", "GSFTracks");
-
-  maxComponents_ = parameters.getParameter<int>("maxComponents", 4);
-  abortOnError_ = parameters.getParameter<bool>("abortOnError", false);
-  disableAllMaterialHandling_ =
-      parameters.getParameter<bool>("disableAllMaterialHandling", false);
-  weightCutoff_ = parameters.getParameter<double>("weightCutoff_", 1.0e-4);
-
-  propagator_maxSteps_ =
-      parameters.getParameter<int>("propagator_maxSteps", 10000);
-  propagator_step_size_ =
-      parameters.getParameter<double>("propagator_step_size", 200.);
-  field_map_ = parameters.getParameter<std::string>("field_map");
-  usePerigee_ = parameters.getParameter<bool>("usePerigee", false);
-
-  debug_ = parameters.getParameter<bool>("debug", false);
-
-  // finalReductionMethod_ =
-  // parameters.getParameter<double>("finalReductionMethod",);
-}
-
-void GSFProcessor::produce(framework::Event& event) {
-  // General Setup
 
-  auto tg{geometry()};
-
-  // Retrieve the tracks
-  if (!event.exists(trackCollection_)) return;
-  auto tracks{event.getCollection<ldmx::Track>(trackCollection_)};
-
-  // Retrieve the measurements
-  if (!event.exists(measCollection_)) return;
-  auto measurements{event.getCollection<ldmx::Measurement>(measCollection_)};
-
-  tracking::sim::LdmxMeasurementCalibrator calibrator{measurements};
+  // Everything below does not change from one event to the next, so it is
+  //  set up here once instead of in produce
 
   // GSF Setup
 
-  Acts::GainMatrixUpdater updater;
-  Acts::Experimental::GsfExtensions<Acts::VectorMultiTrajectory> gsf_extensions;
-  gsf_extensions.updater.connect<
+  gsf_extensions_.updater.connect<
       &Acts::GainMatrixUpdater::operator()<Acts::VectorMultiTrajectory>>(
-      &updater);
-  gsf_extensions.calibrator
+      &updater_);
+  gsf_extensions_.calibrator
       .connect<&tracking::sim::LdmxMeasurementCalibrator::calibrate_1d>(
-          &calibrator);
+          &calibrator_);
 
   // Propagator Options
 
-  // Move this at the start of the producer
-  Acts::PropagatorOptions<ActionList, AbortList> propagator_options(
-      geometry_context(), magnetic_field_context());
+  propagator_options_ =
+      std::make_unique<Acts::PropagatorOptions<ActionList, AbortList>>(
+          geometry_context(), magnetic_field_context());
+  auto& propagator_options{*propagator_options_};
 
   propagator_options.pathLimit = std::numeric_limits<double>::max();
 
@@ -202,31 +170,114 @@ void GSFProcessor::produce(framework::Event& event) {
   // Electron hypothesis
   propagator_options.mass = 0.511 * Acts::UnitConstants::MeV;
 
-  // GSF Options, to be moved out of produce loop
+  // GSF Options
+
+  origin_surface_ = Acts::Surface::makeShared<Acts::PerigeeSurface>(
+      Acts::Vector3(0., 0., 0.));
+
+  gsf_options_ = std::make_unique<
+      Acts::Experimental::GsfOptions<Acts::VectorMultiTrajectory>>(
+      Acts::Experimental::GsfOptions<Acts::VectorMultiTrajectory>{
+          geometry_context(), magnetic_field_context(), calibration_context(),
+          gsf_extensions_, propagator_options, &(*origin_surface_),
+          maxComponents_, weightCutoff_, abortOnError_,
+          disableAllMaterialHandling_});
 
-  std::shared_ptr<const Acts::PerigeeSurface> origin_surface =
-      Acts::Surface::makeShared<Acts::PerigeeSurface>(
-          Acts::Vector3(0., 0., 0.));
+  // Unbounded surfaces the tracks are extrapolated to
+  target_surface_ = tracking::sim::utils::unboundSurface(0.);
+  beam_origin_surface_ = tracking::sim::utils::unboundSurface(-700);
+}
+
+void GSFProcessor::configure(framework::config::Parameters& parameters) {
+  out_trk_collection_ =
+      parameters.getParameter<std::string>("out_trk_collection", "GSFTracks");
 
-  Acts::Experimental::GsfOptions<Acts::VectorMultiTrajectory> gsfOptions{
-      geometry_context(),    magnetic_field_context(),
-      calibration_context(), gsf_extensions,
-      propagator_options,    &(*origin_surface),
-      maxComponents_,        weightCutoff_,
-      abortOnError_,         disableAllMaterialHandling_};
+  trackCollection_ =
+      parameters.getParameter<std::string>("trackCollection", "TaggerTracks");
+  measCollection_ = parameters.getParameter<std::string>("measCollection",
+                                                         "DigiTaggerSimHits");
+
+  maxComponents_ = parameters.getParameter<int>("maxComponents", 4);
+  abortOnError_ = parameters.getParameter<bool>("abortOnError", false);
+  disableAllMaterialHandling_ =
+      parameters.getParameter<bool>("disableAllMaterialHandling", false);
+  weightCutoff_ = parameters.getParameter<double>("weightCutoff", 1.0e-4);
+
+  static const std::map<std::string, Acts::MixtureReductionMethod>
+      reduction_methods{
+          {"max_weight", Acts::MixtureReductionMethod::eMaxWeight},
+          {"mean", Acts::MixtureReductionMethod::eMean}};
+  auto reduction_method{
+      parameters.getParameter<std::string>("reductionMethod", "max_weight")};
+  auto reduction_it{reduction_methods.find(reduction_method)};
+  if (reduction_it == reduction_methods.end()) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "Unrecognized reductionMethod '" + reduction_method +
+                        "', options are 'max_weight' or 'mean'.");
+  }
+  reductionMethod_ = reduction_it->second;
+
+  // preselection of the tracks to refit
+  min_hits_ = parameters.getParameter<int>("min_hits", 0);
+  max_chi2_ndf_ = parameters.getParameter<double>("max_chi2_ndf", -1.);
+
+  propagator_maxSteps_ =
+      parameters.getParameter<int>("propagator_maxSteps", 10000);
+  propagator_step_size_ =
+      parameters.getParameter<double>("propagator_step_size", 200.);
+  field_map_ = parameters.getParameter<std::string>("field_map");
+  usePerigee_ = parameters.getParameter<bool>("usePerigee", false);
+
+  debug_ = parameters.getParameter<bool>("debug", false);
+  profiling_histograms_ =
+      parameters.getParameter<bool>("profiling_histograms", false);
+
+  // finalReductionMethod_ =
+  // parameters.getParameter<double>("finalReductionMethod",);
+}
+
+void GSFProcessor::produce(framework::Event& event) {
+  auto start = StageProfile::now();
+  nevents_++;
+
+  // General Setup
+
+  auto tg{geometry()};
+
+  // Retrieve the tracks
+  if (!event.exists(trackCollection_)) return;
+  auto tracks{event.getCollection<ldmx::Track>(trackCollection_)};
+
+  // Retrieve the measurements
+  if (!event.exists(measCollection_)) return;
+  const auto& measurements{
+      event.getCollection<ldmx::Measurement>(measCollection_)};
+
+  // The extensions are connected to the calibrator once per run, it only
+  //  has to be pointed to the measurements of this event
+  calibrator_ = tracking::sim::LdmxMeasurementCalibrator{measurements};
 
   // Output track container
   std::vector<ldmx::Track> out_tracks;
 
-  // Acts containers
-  Acts::VectorTrackContainer vtc;
-  Acts::VectorMultiTrajectory mtj;
-  Acts::TrackContainer tc{vtc, mtj};
+  // Acts containers, they keep their memory from the previous events
+  vtc_.clear();
+  mtj_.clear();
+  Acts::TrackContainer tc{vtc_, mtj_};
 
   // Loop on tracks
   unsigned int itrk = 0;
 
   for (auto& track : tracks) {
+    // Only refit the tracks that pass the preselection
+    if (track.getNhits() < min_hits_ or
+        (max_chi2_ndf_ >= 0. and
+         track.getChi2() > max_chi2_ndf_ * std::max(track.getNdf(), 1))) {
+      n_preselected_out_++;
+      continue;
+    }
+    n_refitted_++;
+
     // Retrieve measurements on track
     std::vector<ldmx::Measurement> measOnTrack;
 
@@ -265,9 +316,6 @@ void GSFProcessor::produce(framework::Event& event) {
     Acts::BoundTrackParameters trk_btp =
         tracking::sim::utils::boundTrackParameters(track, perigee);
 
-    std::shared_ptr<Acts::Surface> beamOrigin_surface =
-        tracking::sim::utils::unboundSurface(-700);
-
     if (!track.getTrackState(ldmx::TrackStateType::AtBeamOrigin).has_value()) {
       ldmx_log(warn)
           << "Failed retreiving AtBeamOrigin TrackState for track. Skipping..";
@@ -276,7 +324,7 @@ void GSFProcessor::produce(framework::Event& event) {
 
     auto ts = track.getTrackState(ldmx::TrackStateType::AtBeamOrigin).value();
     Acts::BoundTrackParameters trk_btp_bO =
-        tracking::sim::utils::btp(ts, beamOrigin_surface);
+        tracking::sim::utils::btp(ts, beam_origin_surface_);
 
     const Acts::BoundVector& trkpars = trk_btp.parameters();
     ldmx_log(debug) << "CKF Track parameters" << std::endl
@@ -302,9 +350,11 @@ void GSFProcessor::produce(framework::Event& event) {
     ldmx_log(debug) << trk_pos_bO(0) << " " << trk_pos_bO(1) << " "
                     << trk_pos_bO(2) << std::endl;
 
+    auto fit_start = StageProfile::now();
     auto gsf_refit_result =
         gsf_->fit(fit_trackSourceLinks.begin(), fit_trackSourceLinks.end(),
-                  trk_btp_bO, gsfOptions, tc);
+                  trk_btp_bO, *gsf_options_, tc);
+    profile_.add("fit", fit_start);
 
     if (!gsf_refit_result.ok()) {
       ldmx_log(warn) << "GSF re-fit failed" << std::endl;
@@ -336,15 +386,13 @@ void GSFProcessor::produce(framework::Event& event) {
 
     ldmx::Track trk = ldmx::Track();
 
-    // Unbounded surface
-    const std::shared_ptr<Acts::Surface> target_surface =
-        tracking::sim::utils::unboundSurface(0.);
-
     ldmx_log(debug) << "Target extrapolation";
     ldmx::Track::TrackState tsAtTarget;
 
+    auto extrapolation_start = StageProfile::now();
     bool success = trk_extrap_->TrackStateAtSurface(
-        gsftrk, target_surface, tsAtTarget, ldmx::TrackStateType::AtTarget);
+        gsftrk, target_surface_, tsAtTarget, ldmx::TrackStateType::AtTarget);
+    profile_.add("extrapolation", extrapolation_start);
 
     if (success) trk.addTrackState(tsAtTarget);
 
@@ -374,10 +422,32 @@ void GSFProcessor::produce(framework::Event& event) {
   }  // loop on tracks
 
   event.add(out_trk_collection_, out_tracks);
+
+  double event_time{std::chrono::duration<double, std::milli>(
+                        StageProfile::now() - start)
+                        .count()};
+  processing_time_ += event_time;
+  profile_.add("event", event_time);
 }
 
-void GSFProcessor::onProcessStart(){};
-void GSFProcessor::onProcessEnd(){};
+void GSFProcessor::onProcessStart() {
+  if (profiling_histograms_) {
+    getHistoDirectory();
+    profile_.book(histograms_, {"event", "fit", "extrapolation"});
+  }
+}
+
+void GSFProcessor::onProcessEnd() {
+  if (nevents_ < 1) return;
+  ldmx_log(info) << "AVG Time/Event: " << processing_time_ / nevents_ << " ms";
+  ldmx_log(info) << "Breakdown::";
+  ldmx_log(info) << "fit           Avg Time/Event = "
+                 << profile_.total("fit") / nevents_ << " ms";
+  ldmx_log(info) << "extrapolation Avg Time/Event = "
+                 << profile_.total("extrapolation") / nevents_ << " ms";
+  ldmx_log(info) << "Refitted " << n_refitted_ << " tracks, "
+                 << n_preselected_out_ << " failed the preselection";
+}
 
 }  // namespace reco
 }  // namespace tracking
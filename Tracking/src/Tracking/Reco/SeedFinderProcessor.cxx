@@ -42,6 +42,13 @@ SeedFinderProcessor::~SeedFinderProcessor() {}
 
 void SeedFinderProcessor::onProcessStart() {
   truthMatchingTool_ = std::make_shared<tracking::sim::TruthMatchingTool>();
+
+  if (profiling_histograms_) {
+    getHistoDirectory();
+    profile_.book(histograms_, {"event", "setup", "group", "find"});
+    histograms_.create("n_seeds", "seeds in the event", 100, 0., 100.);
+    n_seeds_id_ = histograms_.id("n_seeds");
+  }
 }
 
 void SeedFinderProcessor::configure(framework::config::Parameters& parameters) {
@@ -82,11 +89,14 @@ void SeedFinderProcessor::configure(framework::config::Parameters& parameters) {
       "inflate_factors", {10., 10., 10., 10., 10., 10.});
 
   bfield_ = parameters.getParameter<double>("bfield", 1.5);
+
+  profiling_histograms_ =
+      parameters.getParameter<bool>("profiling_histograms", false);
 }
 
 void SeedFinderProcessor::produce(framework::Event& event) {
   const auto& tg{geometry()};
-  auto start = std::chrono::high_resolution_clock::now();
+  auto start = StageProfile::now();
   ldmx::Tracks seed_tracks;
 
   nevents_++;
@@ -94,7 +104,7 @@ void SeedFinderProcessor::produce(framework::Event& event) {
   // check if SimParticleMap is available for truth matching
   std::map<int, ldmx::SimParticle> particleMap;
 
-  const std::vector<ldmx::Measurement> measurements =
+  const std::vector<ldmx::Measurement>& measurements =
       event.getCollection<ldmx::Measurement>(input_hits_collection_);
 
   std::vector<ldmx::Track> tagger_tracks;
@@ -148,14 +158,20 @@ void SeedFinderProcessor::produce(framework::Event& event) {
   if (event.exists("SimParticles")) {
     particleMap = event.getMap<int, ldmx::SimParticle>("SimParticles");
     truthMatchingTool_->setup(particleMap, measurements);
+  } else {
+    truthMatchingTool_->reset();
   }
 
   ldmx_log(debug) << "Preparing the strategies";
 
+  auto setup = profile_.add("setup", start);
+
   groups_map.clear();
   std::vector<int> strategy = {0, 1, 2, 3, 4};
   bool success = GroupStrips(measurements, strategy);
+  auto group = profile_.add("group", setup);
   if (success) FindSeedsFromMap(seed_tracks, target_pseudo_meas);
+  profile_.add("find", group);
 
   /*
   groups_map.clear();
@@ -176,7 +192,10 @@ void SeedFinderProcessor::produce(framework::Event& event) {
   // std::chrono::duration_cast<std::chrono::microseconds>(end-start).count();
 
   auto diff = end - start;
-  processing_time_ += std::chrono::duration<double, std::milli>(diff).count();
+  double event_time{std::chrono::duration<double, std::milli>(diff).count()};
+  processing_time_ += event_time;
+  profile_.add("event", event_time);
+  if (profiling_histograms_) histograms_.fill(n_seeds_id_, seed_tracks.size());
 
   // Seed finding using 2D Hits
   //  - The hits should keep track if they are already associated to a track or
@@ -208,15 +227,11 @@ void SeedFinderProcessor::produce(framework::Event& event) {
 // yOrigin is the location along the beam about which we fit the seed helix
 // perigee_location is where the track parameters will be extracted
 
-ldmx::Track SeedFinderProcessor::SeedTracker(
-    const ldmx::Measurements& vmeas, double xOrigin,
-    const Acts::Vector3& perigee_location,
-    const ldmx::Measurements& pmeas_tgt) {
+Acts::ActsVector<5> SeedFinderProcessor::FitLineParabola(
+    const std::array<const SeedHit*, 5>& hits, double xOrigin) {
   // Fit a straight line in the non-bending plane and a parabola in the bending
   // plane
 
-  const int N = vmeas.size();
-
   // Each measurement is treated as a 3D point, where the v direction is in the
   // center of the strip with sigma equal to the length of the strip / sqrt(12).
   // In this way it's easier to incorporate the tagger track extrapolation to
@@ -225,17 +240,12 @@ ldmx::Track SeedFinderProcessor::SeedTracker(
   Acts::ActsMatrix<5, 5> A = Acts::ActsMatrix<5, 5>::Zero();
   Acts::ActsVector<5> Y = Acts::ActsVector<5>::Zero();
 
-  for (auto meas : vmeas) {
+  for (const SeedHit* hit : hits) {
+    const ldmx::Measurement& meas = *hit->meas;
     double xmeas = meas.getGlobalPosition()[0] - xOrigin;
 
-    // Get the surface
-    const Acts::Surface* hit_surface = geometry().getSurface(meas.getLayerID());
-
-    // Get the global to local transformation
-    auto rot = hit_surface->transform(geometry_context()).rotation();
-    auto tr = hit_surface->transform(geometry_context()).translation();
-
-    auto rotl2g = rot.transpose();
+    // The global to local transformation of the surface
+    const Acts::RotationMatrix3& rotl2g = hit->rotl2g;
 
     // Only for saving purposes
     Acts::Vector2 loc{meas.getLocalPosition()[0], 0.};
@@ -259,12 +269,12 @@ ldmx::Track SeedFinderProcessor::SeedTracker(
     A_i(1, 4) = rotl2g(1, 2) * xmeas;
 
     // Fill the yprime vector
-    Acts::Vector2 offset = (rot.transpose() * tr).topRows<2>();
+    const Acts::Vector2& offset = hit->offset;
     Acts::Vector2 xoffset = {rotl2g(0, 0) * xmeas, rotl2g(1, 0) * xmeas};
 
     loc(0) = meas.getLocalPosition()[0];
     loc(1) = 0.;
-    double uError = sqrt(vmeas[0].getLocalCovariance()[0]);
+    double uError = sqrt(hits[0]->meas->getLocalCovariance()[0]);
 
     // TODO Fix vError for measurements
     double vError = 40. / sqrt(12);
@@ -277,7 +287,6 @@ ldmx::Track SeedFinderProcessor::SeedTracker(
 
     Acts::Vector2 Yprime_i = loc + offset - xoffset;
 
-    Acts::Vector2 yi = W_i * Yprime_i;
     Y += (A_i.transpose()) * W_i * Yprime_i;
 
     Acts::ActsMatrix<2, 5> WA_i = (W_i * A_i);
@@ -286,7 +295,12 @@ ldmx::Track SeedFinderProcessor::SeedTracker(
 
   Acts::ActsVector<5> B;
   B = A.inverse() * Y;
+  return B;
+}
 
+ldmx::Track SeedFinderProcessor::SeedTracker(
+    const Acts::ActsVector<5>& B, double xOrigin,
+    const Acts::Vector3& perigee_location) {
   b0_.push_back(B(0));
   b1_.push_back(B(1));
   b2_.push_back(B(2));
@@ -422,6 +436,13 @@ void SeedFinderProcessor::onProcessEnd() {
   // outputTree_->Write();
   // outputFile_->Close();
   ldmx_log(info) << "AVG Time/Event: " << processing_time_ / nevents_ << " ms";
+  ldmx_log(info) << "Breakdown::";
+  ldmx_log(info) << "setup Avg Time/Event = "
+                 << profile_.total("setup") / nevents_ << " ms";
+  ldmx_log(info) << "group Avg Time/Event = "
+                 << profile_.total("group") / nevents_ << " ms";
+  ldmx_log(info) << "find  Avg Time/Event = "
+                 << profile_.total("find") / nevents_ << " ms";
   ldmx_log(info) << "Total Seeds/Events: " << ntracks_ << "/" << nevents_;
   ldmx_log(info) << "Seeds discarded due to multiple hits on layers "
                  << ndoubles_;
@@ -442,6 +463,8 @@ void SeedFinderProcessor::onProcessEnd() {
 bool SeedFinderProcessor::GroupStrips(
     const std::vector<ldmx::Measurement>& measurements,
     const std::vector<int> strategy) {
+  const auto& tg{geometry()};
+
   //    std::cout<<"Using stratedy"<<std::endl;
   // for (auto& e : strategy) {
   //  std::cout<<e<<" ";
@@ -453,7 +476,17 @@ bool SeedFinderProcessor::GroupStrips(
 
     if (std::find(strategy.begin(), strategy.end(), meas.getLayer()) !=
         strategy.end()) {
-      groups_map[meas.getLayer()].push_back(&meas);
+      // the transformation of the surface is needed by every combination
+      // the hit is in, so it is only computed once
+      const Acts::Surface* hit_surface = tg.getSurface(meas.getLayerID());
+      auto rot = hit_surface->transform(geometry_context()).rotation();
+      auto tr = hit_surface->transform(geometry_context()).translation();
+      SeedHit hit;
+      hit.meas = &meas;
+      hit.x = meas.getGlobalPosition()[0];
+      hit.rotl2g = rot.transpose();
+      hit.offset = (rot.transpose() * tr).topRows<2>();
+      groups_map[meas.getLayer()].push_back(hit);
     }
 
   }  // loop meas
@@ -470,18 +503,12 @@ bool SeedFinderProcessor::GroupStrips(
 
 void SeedFinderProcessor::FindSeedsFromMap(ldmx::Tracks& seeds,
                                            const ldmx::Measurements& pmeas) {
-  std::vector<ldmx::Measurement> meas_for_seeds;
-  meas_for_seeds.reserve(5);
-
-  std::map<int, std::vector<const ldmx::Measurement*>>::iterator groups_iter =
-      groups_map.begin();
-  std::vector<const ldmx::Measurement*>::iterator meas_iter;
+  auto groups_iter = groups_map.begin();
 
   // Vector of iterators
 
   constexpr size_t K = 5;
-  std::vector<std::vector<const ldmx::Measurement*>::iterator> it;
-  it.reserve(K);
+  std::array<std::vector<SeedHit>::const_iterator, K> it;
 
   unsigned int ikey = 0;
   for (auto& key : groups_map) {
@@ -489,48 +516,48 @@ void SeedFinderProcessor::FindSeedsFromMap(ldmx::Tracks& seeds,
     ikey++;
   }
 
+  Acts::Vector3 perigee{perigee_location_[0], perigee_location_[1],
+                        perigee_location_[2]};
+
   // K vectors in an array v[0],v[1].... v[K-1]
 
   while (it[0] != groups_iter->second.end()) {
     // process the pointed-to elements
 
-    /*
-      for (int j=0; j<K; j++) {
-      const ldmx::Measurement* meas = (*(it[j]));
-      std::cout<<meas->getGlobalPosition()[0]<<","
-      <<meas->getGlobalPosition()[1]<<","
-      <<meas->getGlobalPosition()[2]<<","<<std::endl;
-      }
-    */
-
-    std::vector<ldmx::Measurement> meas_for_seeds;
-    meas_for_seeds.reserve(5);
-
     ldmx_log(debug) << " Grouping ";
 
-    for (int j = 0; j < K; j++) {
-      const ldmx::Measurement* meas = (*(it[j]));
-      meas_for_seeds.push_back(*meas);
-    }
+    std::array<const SeedHit*, K> hits;
+    for (int j = 0; j < K; j++) hits[j] = &(*(it[j]));
 
-    std::sort(meas_for_seeds.begin(), meas_for_seeds.end(),
-              [](const ldmx::Measurement& m1, const ldmx::Measurement& m2) {
-                return m1.getGlobalPosition()[0] < m2.getGlobalPosition()[0];
+    std::sort(hits.begin(), hits.end(),
+              [](const SeedHit* h1, const SeedHit* h2) {
+                return h1->x < h2->x;
               });
 
-    if (meas_for_seeds.size() < 5) {
-      nmissing_++;
-      return;
+    double xOrigin = hits[2]->x;
+    Acts::ActsVector<5> B = FitLineParabola(hits, xOrigin);
+
+    // The momentum only depends on the curvature of the fit, so most of the
+    // random combinations are rejected here, before the seed track is made.
+    // The margin leaves the ones at the edges to the cut on the seed track.
+    double p = 0.3 * bfield_ * (1. / (2. * abs(B(2)))) * 0.001;
+    bool precut_fail = true;
+    if (p < pmin_ * (1. - precut_margin_)) {
+      nfailpmin_++;
+    } else if (p > pmax_ * (1. + precut_margin_)) {
+      nfailpmax_++;
+    } else {
+      precut_fail = false;
     }
 
-    ldmx_log(debug) << "seedTrack";
+    if (precut_fail) {
+      NextCombination(it);
+      continue;
+    }
 
-    Acts::Vector3 perigee{perigee_location_[0], perigee_location_[1],
-                          perigee_location_[2]};
+    ldmx_log(debug) << "seedTrack";
 
-    ldmx::Track seedTrack =
-        SeedTracker(meas_for_seeds, meas_for_seeds.at(2).getGlobalPosition()[0],
-                    perigee, pmeas);
+    ldmx::Track seedTrack = SeedTracker(B, xOrigin, perigee);
 
     bool fail = false;
 
@@ -593,6 +620,9 @@ void SeedFinderProcessor::FindSeedsFromMap(ldmx::Tracks& seeds,
 
     if (!fail) {
       if (truthMatchingTool_->configured()) {
+        std::vector<ldmx::Measurement> meas_for_seeds;
+        meas_for_seeds.reserve(K);
+        for (const SeedHit* hit : hits) meas_for_seeds.push_back(*hit->meas);
         auto truthInfo = truthMatchingTool_->TruthMatch(meas_for_seeds);
         seedTrack.setTrackID(truthInfo.trackID);
         seedTrack.setPdgID(truthInfo.pdgID);
@@ -610,18 +640,25 @@ void SeedFinderProcessor::FindSeedsFromMap(ldmx::Tracks& seeds,
       b4_.pop_back();
     }
 
-    // Go to next combination
-    ldmx_log(debug) << "Go to the next combination";
-
-    ++it[K - 1];
-    for (int i = K - 1;
-         (i > 0) && (it[i] == (std::next(groups_iter, i))->second.end()); --i) {
-      it[i] = std::next(groups_iter, i)->second.begin();
-      ++it[i - 1];
-    }
+    NextCombination(it);
   }
 }  // find seeds
 
+void SeedFinderProcessor::NextCombination(
+    std::array<std::vector<SeedHit>::const_iterator, 5>& it) {
+  // Go to next combination
+  ldmx_log(debug) << "Go to the next combination";
+
+  constexpr int K = 5;
+  auto groups_iter = groups_map.begin();
+  ++it[K - 1];
+  for (int i = K - 1;
+       (i > 0) && (it[i] == (std::next(groups_iter, i))->second.end()); --i) {
+    it[i] = std::next(groups_iter, i)->second.begin();
+    ++it[i - 1];
+  }
+}
+
 }  // namespace reco
 }  // namespace tracking
 
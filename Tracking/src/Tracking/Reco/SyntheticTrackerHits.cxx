@@ -0,0 +1,124 @@
+#include "Tracking/Reco/SyntheticTrackerHits.h"
+
+#include <algorithm>
+
+#include "Acts/Surfaces/PlanarBounds.hpp"
+#include "DetDescr/TrackerID.h"
+#include "Framework/RandomNumberSeedService.h"
+
+namespace tracking::reco {
+
+namespace {
+
+/**
+ * Layer and module the TrackerSD gives the hits on a surface
+ *
+ * This inverts tracking::sim::utils::getSensorID for the layouts of the
+ * v14 tagger and recoil.
+ *
+ * @param[in] surface_id vol * 1000 + layer * 100 + sensor
+ * @return layer and module of the hits
+ */
+std::pair<int, int> simLayerModule(unsigned int surface_id) {
+  int vol = surface_id / 1000;
+  int layer = (surface_id / 100) % 10;
+  int sensor = surface_id % 100;
+  if (vol == 2) return {2 * (7 - layer) + 1 + sensor, 0};
+  // the axial-stereo modules in the front of the recoil
+  if (layer < 5) return {2 * layer - 1 + sensor, 0};
+  // the axial only modules in the back of the recoil
+  return {layer + 4, sensor};
+}
+
+}  // namespace
+
+void SyntheticTrackerHits::configure(
+    framework::config::Parameters& parameters) {
+  collection_ = parameters.getParameter<std::string>("collection");
+  volume_ = parameters.getParameter<int>("volume");
+  if (volume_ != 2 and volume_ != 3) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The synthetic tracker hits are made in the tagger (2) "
+                    "or the recoil (3), not in volume " +
+                        std::to_string(volume_) + ".");
+  }
+  mean_hits_ = parameters.getParameter<double>("mean_hits");
+  occupancy_scale_ = parameters.getParameter<double>("occupancy_scale");
+  mean_edep_ = parameters.getParameter<double>("mean_edep");
+  time_mean_ = parameters.getParameter<double>("time_mean");
+  time_sigma_ = parameters.getParameter<double>("time_sigma");
+  bunch_spacing_ = parameters.getParameter<double>("bunch_spacing");
+  n_earlier_bunches_ = parameters.getParameter<int>("n_earlier_bunches");
+}
+
+void SyntheticTrackerHits::onNewRun(const ldmx::RunHeader&) {
+  const auto& rseed = getCondition<framework::RandomNumberSeedService>(
+      framework::RandomNumberSeedService::CONDITIONS_OBJECT_NAME);
+  generator_.seed(rseed.getSeed("Tracking::SyntheticTrackerHits"));
+  surfaces_.clear();
+}
+
+void SyntheticTrackerHits::produce(framework::Event& event) {
+  if (surfaces_.empty()) {
+    for (const auto& [id, surface] : geometry().layer_surface_map_) {
+      if (int(id / 1000) == volume_) surfaces_.emplace_back(id, surface);
+    }
+    if (surfaces_.empty()) {
+      EXCEPTION_RAISE("InvalidConfig", "No surfaces in tracking volume " +
+                                           std::to_string(volume_) + ".");
+    }
+    // the map has no order, sort so that the hits don't depend on it
+    std::sort(surfaces_.begin(), surfaces_.end());
+  }
+
+  std::poisson_distribution<int> n_hits(mean_hits_ * occupancy_scale_);
+  std::uniform_int_distribution<std::size_t> pick(0, surfaces_.size() - 1);
+  std::uniform_int_distribution<int> bunch(0, n_earlier_bunches_);
+  std::uniform_real_distribution<double> flat(0., 1.);
+  std::exponential_distribution<double> edep(1. / mean_edep_);
+  std::normal_distribution<double> time(time_mean_, time_sigma_);
+
+  // the hits go along the beam, which is the x axis of the tracking frame
+  const Acts::Vector3 direction{Acts::Vector3::UnitX()};
+
+  std::vector<ldmx::SimTrackerHit> hits;
+  int n{n_hits(generator_)};
+  hits.reserve(n);
+  for (int i_hit{0}; i_hit < n; i_hit++) {
+    const auto& [surface_id, surface] = surfaces_[pick(generator_)];
+    const auto& box{
+        static_cast<const Acts::PlanarBounds&>(surface->bounds())
+            .boundingBox()};
+    Acts::Vector2 local{
+        box.min().x() + flat(generator_) * (box.max().x() - box.min().x()),
+        box.min().y() + flat(generator_) * (box.max().y() - box.min().y())};
+    Acts::Vector3 global{
+        surface->localToGlobal(geometry_context(), local, direction)};
+
+    auto [layer, module] = simLayerModule(surface_id);
+    auto subdet{volume_ == 2 ? ldmx::SubdetectorIDType::SD_TRACKER_TAGGER
+                             : ldmx::SubdetectorIDType::SD_TRACKER_RECOIL};
+    ldmx::TrackerID id(subdet, layer, module);
+
+    auto& hit{hits.emplace_back()};
+    hit.setID(id.raw());
+    hit.setLayerID(layer);
+    hit.setModuleID(module);
+    // back from the tracking frame to the ldmx one
+    hit.setPosition(global.y(), global.z(), global.x());
+    hit.setEdep(edep(generator_));
+    hit.setTime(time(generator_) - bunch(generator_) * bunch_spacing_);
+    // straight through the 320 um sensor with a beam electron's momentum
+    hit.setPathLength(0.320);
+    hit.setMomentum(0., 0., 4000.);
+    hit.setEnergy(4000.);
+    // a track of its own, so merging the hits of a track keeps them apart
+    hit.setTrackID(i_hit + 1);
+    hit.setPdgID(11);
+  }
+  event.add(collection_, hits);
+}
+
+}  // namespace tracking::reco
+
+DECLARE_PRODUCER_NS(tracking::reco, SyntheticTrackerHits)
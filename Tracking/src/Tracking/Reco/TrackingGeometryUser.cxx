@@ -19,5 +19,8 @@ const Acts::CalibrationContext& TrackingGeometryUser::calibration_context() {
 const geo::TrackersTrackingGeometry& TrackingGeometryUser::geometry() {
   return getNamedCondition<geo::TrackersTrackingGeometry>();
 }
+const geo::MagneticFieldMap& TrackingGeometryUser::magnetic_field_map() {
+  return getNamedCondition<geo::MagneticFieldMap>();
+}
 
 }  // namespace tracking::reco
@@ -75,9 +75,7 @@ void TruthSeedProcessor::configure(framework::config::Parameters& parameters) {
 void TruthSeedProcessor::createTruthTrack(
     const ldmx::SimParticle& particle, const ldmx::SimTrackerHit& hit,
     ldmx::Track& trk, const std::shared_ptr<Acts::Surface>& target_surface) {
-  std::vector<double> pos{static_cast<double>(hit.getPosition()[0]),
-                          static_cast<double>(hit.getPosition()[1]),
-                          static_cast<double>(hit.getPosition()[2])};
+  std::vector<double> pos{hit.getX(), hit.getY(), hit.getZ()};
   createTruthTrack(pos, hit.getMomentum(), particle.getCharge(), trk,
                    target_surface);
 
@@ -181,7 +179,7 @@ void TruthSeedProcessor::createTruthTrack(
 ldmx::Track TruthSeedProcessor::RecoilFullSeed(
     const ldmx::SimParticle& particle, const int trackID,
     const ldmx::SimTrackerHit& hit, const ldmx::SimTrackerHit& ecal_hit,
-    const std::map<int, std::vector<int>>& hit_count_map,
+    const tracking::sim::TruthHitIndex& hit_count_map,
     const std::shared_ptr<Acts::Surface>& origin_surface,
     const std::shared_ptr<Acts::Surface>& target_surface,
     const std::shared_ptr<Acts::Surface>& ecal_surface) {
@@ -224,7 +222,7 @@ ldmx::Track TruthSeedProcessor::RecoilFullSeed(
   // Add the hits
   int nhits = 0;
 
-  for (auto sim_hit_idx : hit_count_map.at(smearedTruthTrack.getTrackID())) {
+  for (auto sim_hit_idx : hit_count_map.hits(smearedTruthTrack.getTrackID())) {
     smearedTruthTrack.addMeasurementIndex(sim_hit_idx);
     nhits += 1;
   }
@@ -237,7 +235,7 @@ ldmx::Track TruthSeedProcessor::RecoilFullSeed(
 ldmx::Track TruthSeedProcessor::TaggerFullSeed(
     const ldmx::SimParticle& beam_electron, const int trackID,
     const ldmx::SimTrackerHit& hit,
-    const std::map<int, std::vector<int>>& hit_count_map,
+    const tracking::sim::TruthHitIndex& hit_count_map,
     const std::shared_ptr<Acts::Surface>& origin_surface,
     const std::shared_ptr<Acts::Surface>& target_surface) {
   ldmx::Track truth_track;
@@ -301,7 +299,7 @@ ldmx::Track TruthSeedProcessor::TaggerFullSeed(
 
   int nhits = 0;
 
-  for (auto sim_hit_idx : hit_count_map.at(smearedTruthTrack.getTrackID())) {
+  for (auto sim_hit_idx : hit_count_map.hits(smearedTruthTrack.getTrackID())) {
     smearedTruthTrack.addMeasurementIndex(sim_hit_idx);
     nhits += 1;
   }
@@ -427,43 +425,19 @@ ldmx::Track TruthSeedProcessor::seedFromTruth(const ldmx::Track& tt,
 
 void TruthSeedProcessor::makeHitCountMap(
     const std::vector<ldmx::SimTrackerHit>& sim_hits,
-    std::map<int, std::vector<int>>& hit_count_map) {
-  for (int i_sim_hit = 0; i_sim_hit < sim_hits.size(); i_sim_hit++) {
-    auto& sim_hit = sim_hits.at(i_sim_hit);
-    // This track never left a hit before
-    if (!hit_count_map.count(sim_hit.getTrackID())) {
-      hit_count_map[sim_hit.getTrackID()].push_back(i_sim_hit);
-    }
-
-    // This track left a hit before.
-    // Check if it's on a different sensor than the others
-
-    else {
-      int sensorID = tracking::sim::utils::getSensorID(sim_hit);
-      bool foundHit = false;
-
-      for (auto& i_rhit : hit_count_map[sim_hit.getTrackID()]) {
-        int tmp_sensorID =
-            tracking::sim::utils::getSensorID(sim_hits.at(i_rhit));
-
-        if (sensorID == tmp_sensorID) {
-          foundHit = true;
-          break;
-        }
-      }  // loop on the already recorded hits
-
-      if (!foundHit) {
-        hit_count_map[sim_hit.getTrackID()].push_back(i_sim_hit);
-      }
-    }
-  }  // loop on sim hits
+    tracking::sim::TruthHitIndex& hit_count_map) {
+  hit_count_map.fill(sim_hits);
+  // A track may leave more than one hit on a sensor, only count the first
+  hit_count_map.unique([&](unsigned i_sim_hit) {
+    return tracking::sim::utils::getSensorID(sim_hits[i_sim_hit]);
+  });
 }
 
 bool TruthSeedProcessor::scoringPlaneHitFilter(
     const ldmx::SimTrackerHit& hit,
     const std::vector<ldmx::SimTrackerHit>& ecal_sp_hits) {
   // Clean some of the hits we don't want
-  if (hit.getPosition()[2] < z_min_) return false;
+  if (hit.getZ() < z_min_) return false;
 
   // Check if the track_id was requested
   if (track_id_ > 0 && hit.getTrackID() != track_id_) return false;
@@ -473,8 +447,7 @@ bool TruthSeedProcessor::scoringPlaneHitFilter(
       pdg_ids_.end())
     return false;
 
-  Acts::Vector3 p_vec{hit.getMomentum()[0], hit.getMomentum()[1],
-                      hit.getMomentum()[2]};
+  Acts::Vector3 p_vec{hit.getPx(), hit.getPy(), hit.getPz()};
 
   // p cut
   if (p_cut_ >= 0. && p_vec.norm() < p_cut_) return false;
@@ -493,9 +466,8 @@ bool TruthSeedProcessor::scoringPlaneHitFilter(
     for (auto& e_sp_hit : ecal_sp_hits) {
       if (e_sp_hit.getTrackID() == hit.getTrackID() &&
           e_sp_hit.getPdgID() == hit.getPdgID()) {
-        Acts::Vector3 e_sp_p{e_sp_hit.getMomentum()[0],
-                             e_sp_hit.getMomentum()[1],
-                             e_sp_hit.getMomentum()[2]};
+        Acts::Vector3 e_sp_p{e_sp_hit.getPx(), e_sp_hit.getPy(),
+                             e_sp_hit.getPz()};
 
         if (e_sp_p.norm() < p_cut_ecal_) pass_ecal_scoring_plane = false;
 
@@ -521,19 +493,15 @@ void TruthSeedProcessor::produce(framework::Event& event) {
   // Information is extracted using the
   // scoring plane hit left by the particle at the target.
 
-  const std::vector<ldmx::SimTrackerHit> scoring_hits{
+  const std::vector<ldmx::SimTrackerHit>& scoring_hits{
       event.getCollection<ldmx::SimTrackerHit>(scoring_hits_coll_name_)};
 
-  // Retrieve the scoring plane hits at the ECAL
-  const std::vector<ldmx::SimTrackerHit> scoring_hits_ecal{
-      event.getCollection<ldmx::SimTrackerHit>("EcalScoringPlaneHits")};
-
   // Retrieve the sim hits in the tagger tracker
-  const std::vector<ldmx::SimTrackerHit> tagger_sim_hits =
+  const std::vector<ldmx::SimTrackerHit>& tagger_sim_hits =
       event.getCollection<ldmx::SimTrackerHit>(tagger_sim_hits_coll_name_);
 
   // Retrieve the sim hits in the recoil tracker
-  const std::vector<ldmx::SimTrackerHit> recoil_sim_hits =
+  const std::vector<ldmx::SimTrackerHit>& recoil_sim_hits =
       event.getCollection<ldmx::SimTrackerHit>(recoil_sim_hits_coll_name_);
 
   // If sim hit collections are empty throw a warning
@@ -546,90 +514,49 @@ void TruthSeedProcessor::produce(framework::Event& event) {
                     << event.getEventNumber() << " in run "
                     << event.getEventHeader().getRun() << std::endl;
 
-  // The map stores which track leaves which sim hits
-  std::map<int, std::vector<int>> hit_count_map_recoil;
+  // The index stores which track leaves which sim hits
+  tracking::sim::TruthHitIndex hit_count_map_recoil;
   makeHitCountMap(recoil_sim_hits, hit_count_map_recoil);
 
-  std::map<int, std::vector<int>> hit_count_map_tagger;
+  tracking::sim::TruthHitIndex hit_count_map_tagger;
   makeHitCountMap(tagger_sim_hits, hit_count_map_tagger);
 
-  // to keep track of how many sim particles leave hits on the scoring plane
-  std::vector<int> recoil_sh_idxs;
-  std::unordered_map<int, std::vector<int>> recoil_sh_count_map;
-
-  std::vector<int> tagger_sh_idxs;
-  std::unordered_map<int, std::vector<int>> tagger_sh_count_map;
-
   // Target scoring hits for Tagger will have Z<0, Recoil scoring hits will have
-  // Z>0
-  for (unsigned int i_sh = 0; i_sh < scoring_hits.size(); i_sh++) {
-    const ldmx::SimTrackerHit& hit = scoring_hits.at(i_sh);
-    double zhit = hit.getPosition()[2];
-
-    Acts::Vector3 p_vec{hit.getMomentum()[0], hit.getMomentum()[1],
-                        hit.getMomentum()[2]};
-    double tagger_p_max = 0.;
-
-    // Check if it is a tagger track going fwd that passes basic cuts
-    if (zhit < 0.) {
-      // Tagger selection cuts
-      // Negative scoring plane hit, with momentum > p_cut
-      if (p_vec(2) < 0. || p_vec.norm() < p_cut_) continue;
-
-      // Check that the hit was left by a charged particle
-      if (abs(particleMap[hit.getTrackID()].getCharge()) < 1e-8) continue;
-
-      if (p_vec.norm() > tagger_p_max) {
-        tagger_sh_count_map[hit.getTrackID()].push_back(i_sh);
-      }
-    }  // Tagger loop
-
-    // Check the recoil hits
-    else {
-      // Recoil selection cuts
-      // Positive scoring plane hit, forward direction with momentum > p_cut
-      if (p_vec(2) < 0. || p_vec.norm() < p_cut_) continue;
-
-      // Check that the hit was left by a charged particle
-      if (abs(particleMap[hit.getTrackID()].getCharge()) < 1e-8) continue;
-
-      recoil_sh_count_map[hit.getTrackID()].push_back(i_sh);
+  // Z>0. Both select forward hits with momentum > p_cut left by a charged
+  // particle.
+  auto selected_sh = [&](const ldmx::SimTrackerHit& hit) {
+    Acts::Vector3 p_vec{hit.getPx(), hit.getPy(), hit.getPz()};
+    if (p_vec(2) < 0. || p_vec.norm() < p_cut_) return false;
+    return abs(particleMap[hit.getTrackID()].getCharge()) >= 1e-8;
+  };
 
-    }  // Recoil
-  }    // loop on Target scoring plane hits
-
-  for (std::pair<int, std::vector<int>> element : recoil_sh_count_map) {
-    std::sort(
-        element.second.begin(), element.second.end(),
-        [&](const int idx1, int idx2) -> bool {
-          const ldmx::SimTrackerHit& hit1 = scoring_hits.at(idx1);
-          const ldmx::SimTrackerHit& hit2 = scoring_hits.at(idx2);
-
-          Acts::Vector3 phit1{hit1.getMomentum()[0], hit1.getMomentum()[1],
-                              hit1.getMomentum()[2]};
-          Acts::Vector3 phit2{hit2.getMomentum()[0], hit2.getMomentum()[1],
-                              hit2.getMomentum()[2]};
-
-          return phit1.norm() > phit2.norm();
-        });
-  }
-
-  // Sort tagger hits.
-  for (auto& [_track_id, hit_indices] : tagger_sh_count_map) {
-    std::sort(
-        hit_indices.begin(), hit_indices.end(),
-        [&](const int idx1, int idx2) -> bool {
-          const ldmx::SimTrackerHit& hit1 = scoring_hits.at(idx1);
-          const ldmx::SimTrackerHit& hit2 = scoring_hits.at(idx2);
-
-          Acts::Vector3 phit1{hit1.getMomentum()[0], hit1.getMomentum()[1],
-                              hit1.getMomentum()[2]};
-          Acts::Vector3 phit2{hit2.getMomentum()[0], hit2.getMomentum()[1],
-                              hit2.getMomentum()[2]};
-
-          return phit1.norm() > phit2.norm();
-        });
-  }
+  // to keep track of how many sim particles leave hits on the scoring plane
+  tracking::sim::TruthHitIndex tagger_sh_count_map;
+  tagger_sh_count_map.fill(scoring_hits, [&](const ldmx::SimTrackerHit& hit) {
+    return hit.getZ() < 0. && selected_sh(hit);
+  });
+
+  tracking::sim::TruthHitIndex recoil_sh_count_map;
+  recoil_sh_count_map.fill(scoring_hits, [&](const ldmx::SimTrackerHit& hit) {
+    return hit.getZ() >= 0. && selected_sh(hit);
+  });
+
+  // The truth is taken from the scoring plane hit of a track with the highest
+  // momentum
+  auto leading_sh = [&](tracking::sim::TruthHitIndex::Hits hit_indices)
+      -> const ldmx::SimTrackerHit& {
+    unsigned i_lead = hit_indices[0];
+    double p_lead = 0.;
+    for (auto i_sh : hit_indices) {
+      const ldmx::SimTrackerHit& hit = scoring_hits.at(i_sh);
+      Acts::Vector3 p_vec{hit.getPx(), hit.getPy(), hit.getPz()};
+      if (p_vec.norm() > p_lead) {
+        i_lead = i_sh;
+        p_lead = p_vec.norm();
+      }
+    }
+    return scoring_hits.at(i_lead);
+  };
 
   // Building of the event truth information and the truth seeds
   // TODO remove the truthtracks in the future as the truth seeds are enough
@@ -655,15 +582,16 @@ void TruthSeedProcessor::produce(framework::Event& event) {
       Acts::Vector3(beamOrigin_[0], beamOrigin_[1], beamOrigin_[2]))};
 
   if (!skip_tagger_) {
-    for (const auto& [track_id, hit_indices] : tagger_sh_count_map) {
-      const ldmx::SimTrackerHit& hit = scoring_hits.at(hit_indices.at(0));
+    for (auto track_id : tagger_sh_count_map.trackIDs()) {
+      const ldmx::SimTrackerHit& hit =
+          leading_sh(tagger_sh_count_map.hits(track_id));
       const ldmx::SimParticle& phit = particleMap[hit.getTrackID()];
 
-      if (hit_count_map_tagger[hit.getTrackID()].size() > n_min_hits_tagger_) {
+      if (hit_count_map_tagger.count(hit.getTrackID()) > n_min_hits_tagger_) {
         ldmx::Track truth_tagger_track;
         createTruthTrack(phit, hit, truth_tagger_track, targetSurface);
         truth_tagger_track.setNhits(
-            hit_count_map_tagger[hit.getTrackID()].size());
+            hit_count_map_tagger.count(hit.getTrackID()));
         tagger_truth_tracks.push_back(truth_tagger_track);
 
         if (hit.getPdgID() == 11 && hit.getTrackID() < max_track_id_) {
@@ -677,42 +605,31 @@ void TruthSeedProcessor::produce(framework::Event& event) {
   }
 
   // Recover the EcalScoring hits
-  std::vector<ldmx::SimTrackerHit> ecal_spHits =
+  const std::vector<ldmx::SimTrackerHit>& ecal_spHits =
       event.getCollection<ldmx::SimTrackerHit>("EcalScoringPlaneHits");
   // Select ECAL hits
-  std::vector<ldmx::SimTrackerHit> sel_ecal_spHits;
-
-  for (auto sp_hit : ecal_spHits) {
-    if (sp_hit.getMomentum()[2] > 0 && ((sp_hit.getID() & 0xfff) == 31)) {
-      sel_ecal_spHits.push_back(sp_hit);
-    }
-  }
+  tracking::sim::TruthHitIndex sel_ecal_spHits;
+  sel_ecal_spHits.fill(ecal_spHits, [](const ldmx::SimTrackerHit& sp_hit) {
+    return sp_hit.getPz() > 0 && ((sp_hit.getID() & 0xfff) == 31);
+  });
 
   // Recoil target surface for truth and seed tracks is the target
 
-  for (std::pair<int, std::vector<int>> element : recoil_sh_count_map) {
-    // Only take the first entry of the vector: it should be the scoring plane
-    // hit with the highest momentum.
-    const ldmx::SimTrackerHit& hit = scoring_hits.at(element.second.at(0));
-    const ldmx::SimParticle& phit = particleMap[hit.getTrackID()];
-    ldmx::SimTrackerHit ecal_hit;
-
-    bool foundEcalHit = false;
-    for (auto ecal_sp_hit : sel_ecal_spHits) {
-      if (ecal_sp_hit.getTrackID() == hit.getTrackID()) {
-        ecal_hit = ecal_sp_hit;
-        foundEcalHit = true;
-        break;
-      }
-    }
+  for (auto track_id : recoil_sh_count_map.trackIDs()) {
+    const ldmx::SimTrackerHit& hit =
+        leading_sh(recoil_sh_count_map.hits(track_id));
+
+    // The first selected ecal scoring hit of the track
+    auto ecal_hits = sel_ecal_spHits.hits(hit.getTrackID());
+    bool foundEcalHit = !ecal_hits.empty();
 
     // Findable particle selection
-    if (hit_count_map_recoil[hit.getTrackID()].size() > n_min_hits_recoil_ &&
+    if (hit_count_map_recoil.count(hit.getTrackID()) > n_min_hits_recoil_ &&
         foundEcalHit && !skip_recoil_) {
-      ldmx::Track truth_recoil_track =
-          RecoilFullSeed(particleMap[hit.getTrackID()], hit.getTrackID(), hit,
-                         ecal_hit, hit_count_map_recoil, targetSurface,
-                         targetUnboundSurface, ecalSurface);
+      ldmx::Track truth_recoil_track = RecoilFullSeed(
+          particleMap[hit.getTrackID()], hit.getTrackID(), hit,
+          ecal_spHits.at(ecal_hits[0]), hit_count_map_recoil, targetSurface,
+          targetUnboundSurface, ecalSurface);
       recoil_truth_tracks.push_back(truth_recoil_track);
     }
   }
@@ -37,6 +37,11 @@ void VertexProcessor::onProcessStart() {
           field_map_, default_transformPos, default_transformBField));
 
   ldmx_log(info) << "Check if nullptr::" << sp_interpolated_bField_.get();
+
+  auto &&stepper = Acts::EigenStepper<>{sp_interpolated_bField_};
+
+  // Set up propagator with void navigator
+  propagator_ = std::make_shared<VoidPropagator>(stepper);
 }
 
 void VertexProcessor::configure(framework::config::Parameters &parameters) {
@@ -48,44 +53,14 @@ void VertexProcessor::configure(framework::config::Parameters &parameters) {
 }
 
 void VertexProcessor::produce(framework::Event &event) {
-  // TODO:: Move this to an external file
-  // And move all this to a single time per processor not for each event!!
-
   nevents_++;
   auto start = std::chrono::high_resolution_clock::now();
-  auto &&stepper = Acts::EigenStepper<>{sp_interpolated_bField_};
-
-  // Set up propagator with void navigator
-  propagator_ = std::make_shared<VoidPropagator>(stepper);
-
-  // Track linearizer in the proximity of the vertex location
-  using Linearizer = Acts::HelicalTrackLinearizer<VoidPropagator>;
-  Linearizer::Config linearizerConfig(sp_interpolated_bField_, propagator_);
-  Linearizer linearizer(linearizerConfig);
-
-  // Set up Billoir Vertex Fitter
-  using VertexFitter =
-      Acts::FullBilloirVertexFitter<Acts::BoundTrackParameters, Linearizer>;
-
-  VertexFitter::Config vertexFitterCfg;
-
-  VertexFitter billoirFitter(vertexFitterCfg);
-
-  VertexFitter::State state(sp_interpolated_bField_->makeCache(bctx_));
-
-  // Unconstrained fit
-  // See
-  // https://github.com/acts-project/acts/blob/main/Tests/UnitTests/Core/Vertexing/FullBilloirVertexFitterTests.cpp#L149
-  // For constraint implementation
-
-  Acts::VertexingOptions<Acts::BoundTrackParameters> vfOptions(gctx_, bctx_);
-
   // Retrieve the track collection
-  const std::vector<ldmx::Track> tracks =
+  const std::vector<ldmx::Track> &tracks =
       event.getCollection<ldmx::Track>(trk_coll_name_);
 
   // Retrieve the truth seeds
-  const std::vector<ldmx::Track> seeds =
+  const std::vector<ldmx::Track> &seeds =
       event.getCollection<ldmx::Track>("RecoilTruthSeeds");
 
   if (tracks.size() < 1) return;
@@ -1,6 +1,11 @@
 #include "Tracking/Reco/Vertexer.h"
 
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <exception>
+#include <optional>
+#include <thread>
 
 #include "TFile.h"
 using namespace framework;
@@ -14,6 +19,40 @@ using namespace framework;
 namespace tracking {
 namespace reco {
 
+namespace {
+
+/**
+ * Distance of closest approach of the straight lines tangent to two tracks
+ * at their perigee
+ *
+ * The tracks are expected to be defined at the same perigee, which then
+ * doesn't enter the distance. This is much cheaper than a vertex fit and
+ * close enough to it for the tracks of the target to reject the pairs that
+ * can't come from a common vertex.
+ */
+double perigeeDoca(const ldmx::Track& trk_1, const ldmx::Track& trk_2) {
+  auto point = [](const ldmx::Track& trk) {
+    return Acts::Vector3(-trk.getD0() * std::sin(trk.getPhi()),
+                         trk.getD0() * std::cos(trk.getPhi()), trk.getZ0());
+  };
+  auto direction = [](const ldmx::Track& trk) {
+    return Acts::Vector3(std::cos(trk.getPhi()) * std::sin(trk.getTheta()),
+                         std::sin(trk.getPhi()) * std::sin(trk.getTheta()),
+                         std::cos(trk.getTheta()));
+  };
+  Acts::Vector3 w0{point(trk_1) - point(trk_2)};
+  Acts::Vector3 d1{direction(trk_1)}, d2{direction(trk_2)};
+  double b{d1.dot(d2)}, d{d1.dot(w0)}, e{d2.dot(w0)};
+  double denom{1. - b * b};
+  // parallel lines are as far as the perigee points are from each other
+  // across them
+  if (denom < 1e-12) return (w0 - d * d1).norm();
+  double s{(b * e - d) / denom}, t{(e - b * d) / denom};
+  return (w0 + s * d1 - t * d2).norm();
+}
+
+}  // namespace
+
 Vertexer::Vertexer(const std::string& name, framework::Process& process)
     : framework::Producer(name, process) {}
 
@@ -76,6 +115,17 @@ void Vertexer::onProcessStart() {
   // propagator_ = std::make_shared<VoidPropagator>(stepper);
 
   propagator_ = std::make_shared<VoidPropagator>(stepper_const);
+
+  // Linearizer::Config linearizerConfig(sp_interpolated_bField_,propagator_);
+  Linearizer::Config linearizerConfig(bField_, propagator_);
+  linearizer_ = std::make_unique<const Linearizer>(linearizerConfig);
+
+  // Alternatively one can use
+  // using VertexFitter =
+  //  Acts::FullBilloirVertexFitter<tracking::sim::utils::boundTrackParameters,Linearizer>;
+
+  VertexFitter::Config vertexFitterCfg;
+  billoir_fitter_ = std::make_unique<const VertexFitter>(vertexFitterCfg);
 }
 
 void Vertexer::configure(framework::config::Parameters& parameters) {
@@ -86,31 +136,20 @@ void Vertexer::configure(framework::config::Parameters& parameters) {
       parameters.getParameter<std::string>("trk_c_name_1", "TaggerTracks");
   trk_c_name_2 =
       parameters.getParameter<std::string>("trk_c_name_2", "RecoilTracks");
+
+  max_doca_ = parameters.getParameter<double>("max_doca", 2.);
+  n_pair_threads_ = parameters.getParameter<int>("n_pair_threads", 1);
+  if (n_pair_threads_ < 1) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The number of pair threads must be at least one, but " +
+                        std::to_string(n_pair_threads_) + " was given.");
+  }
 }
 
 void Vertexer::produce(framework::Event& event) {
   nevents_++;
   auto start = std::chrono::high_resolution_clock::now();
 
-  // Track linearizer in the proximity of the vertex location
-  using Linearizer = Acts::HelicalTrackLinearizer<VoidPropagator>;
-  // Linearizer::Config linearizerConfig(sp_interpolated_bField_,propagator_);
-  Linearizer::Config linearizerConfig(bField_, propagator_);
-  Linearizer linearizer(linearizerConfig);
-
-  // Set up Billoir Vertex Fitter
-  using VertexFitter =
-      Acts::FullBilloirVertexFitter<Acts::BoundTrackParameters, Linearizer>;
-
-  // Alternatively one can use
-  // using VertexFitter =
-  //  Acts::FullBilloirVertexFitter<tracking::sim::utils::boundTrackParameters,Linearizer>;
-
-  VertexFitter::Config vertexFitterCfg;
-  VertexFitter billoirFitter(vertexFitterCfg);
-
-  VertexFitter::State state(sp_interpolated_bField_->makeCache(bctx_));
-
   // Unconstrained fit
   // See
   // https://github.com/acts-project/acts/blob/main/Tests/UnitTests/Core/Vertexing/FullBilloirVertexFitterTests.cpp#L149
@@ -120,9 +159,9 @@ void Vertexer::produce(framework::Event& event) {
 
   // Retrive the two track collections
 
-  const std::vector<ldmx::Track> tracks_1 =
+  const std::vector<ldmx::Track>& tracks_1 =
       event.getCollection<ldmx::Track>(trk_c_name_1);
-  const std::vector<ldmx::Track> tracks_2 =
+  const std::vector<ldmx::Track>& tracks_2 =
       event.getCollection<ldmx::Track>(trk_c_name_2);
 
   ldmx_log(debug) << "Retrieved track collections" << std::endl
@@ -157,39 +196,79 @@ void Vertexer::produce(framework::Event& event) {
         tracking::sim::utils::boundTrackParameters(trk, perigeeSurface));
   }
 
-  std::vector<Acts::Vertex<Acts::BoundTrackParameters> > fit_vertices;
-
-  for (auto& b_trk_1 : billoir_tracks_1) {
-    std::vector<const Acts::BoundTrackParameters*> fit_tracks_ptr;
-
-    for (auto& b_trk_2 : billoir_tracks_2) {
-      fit_tracks_ptr.push_back(&b_trk_1);
-      fit_tracks_ptr.push_back(&b_trk_2);
-
-      ldmx_log(debug) << "Calling vertex fitter" << std::endl
-                      << "Track 1 parameters" << std::endl
-                      << b_trk_1 << std::endl
-                      << "Track 2 parameters" << std::endl
-                      << b_trk_2 << std::endl;
+  // Only the pairs whose tracks get close enough to each other are fit
+  std::vector<std::pair<std::size_t, std::size_t>> pairs;
+  for (std::size_t i_1 = 0; i_1 < tracks_1.size(); i_1++) {
+    for (std::size_t i_2 = 0; i_2 < tracks_2.size(); i_2++) {
+      if (perigeeDoca(tracks_1[i_1], tracks_2[i_2]) < max_doca_)
+        pairs.emplace_back(i_1, i_2);
+    }
+  }
+  nreconstructable_ += pairs.size();
 
-      //  std::cout << "Perigee Surface" << std::endl;
-      //  perigeeSurface->toStream(gctx_, std::cout);
-      //  std::cout << std::endl;
+  auto fit_pair = [&](std::size_t i_pair, VertexFitter::State& state)
+      -> std::optional<Acts::Vertex<Acts::BoundTrackParameters>> {
+    const auto& b_trk_1{billoir_tracks_1[pairs[i_pair].first]};
+    const auto& b_trk_2{billoir_tracks_2[pairs[i_pair].second]};
+    std::vector<const Acts::BoundTrackParameters*> fit_tracks_ptr{&b_trk_1,
+                                                                  &b_trk_2};
 
-    }  // loop on second set of tracks
+    ldmx_log(debug) << "Calling vertex fitter" << std::endl
+                    << "Track 1 parameters" << std::endl
+                    << b_trk_1 << std::endl
+                    << "Track 2 parameters" << std::endl
+                    << b_trk_2 << std::endl;
 
-    nreconstructable_++;
     try {
-      // Acts::Vertex<Acts::BoundTrackParameters> fitVtx =
-      // billoirFitter.fit(fit_tracks_ptr, linearizer, vfOptions,
-      // state).value(); fit_vertices.push_back(fitVtx);
-      nvertices_++;
-
+      auto fit_vtx{billoir_fitter_->fit(fit_tracks_ptr, *linearizer_,
+                                        vfOptions, state)};
+      if (fit_vtx.ok()) return fit_vtx.value();
     } catch (...) {
-      ldmx_log(warn) << "Vertex fit failed" << std::endl;
     }
+    return std::nullopt;
+  };
 
-  }  // loop on first set
+  std::vector<std::optional<Acts::Vertex<Acts::BoundTrackParameters>>>
+      fit_vertices(pairs.size());
+  std::size_t n_workers{
+      std::min(std::size_t(n_pair_threads_), fit_vertices.size())};
+  while (fitter_states_.size() < std::max(n_workers, std::size_t(1))) {
+    fitter_states_.push_back(std::make_unique<VertexFitter::State>(
+        sp_interpolated_bField_->makeCache(bctx_)));
+  }
+  if (n_workers > 1) {
+    // each thread takes the next pair nobody has taken yet
+    std::atomic<std::size_t> next_pair{0};
+    std::vector<std::exception_ptr> errors(n_workers);
+    auto run_worker = [&](std::size_t i_worker) {
+      try {
+        for (std::size_t i_pair{next_pair++}; i_pair < fit_vertices.size();
+             i_pair = next_pair++)
+          fit_vertices[i_pair] = fit_pair(i_pair, *fitter_states_[i_worker]);
+      } catch (...) {
+        errors[i_worker] = std::current_exception();
+      }
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t i_worker{1}; i_worker < n_workers; i_worker++) {
+      workers.emplace_back(run_worker, i_worker);
+    }
+    run_worker(0);
+    for (std::thread& worker : workers) worker.join();
+    for (auto& error : errors) {
+      if (error) std::rethrow_exception(error);
+    }
+  } else {
+    for (std::size_t i_pair = 0; i_pair < fit_vertices.size(); i_pair++)
+      fit_vertices[i_pair] = fit_pair(i_pair, *fitter_states_[0]);
+  }
+
+  for (auto& vtx : fit_vertices) {
+    if (vtx)
+      nvertices_++;
+    else
+      ldmx_log(warn) << "Vertex fit failed" << std::endl;
+  }
 
   // Convert the vertices in the ldmx EDM and store them
 }
@@ -0,0 +1,34 @@
+#include "Tracking/Sim/TruthHitIndex.h"
+
+#include <algorithm>
+
+namespace tracking {
+namespace sim {
+
+void TruthHitIndex::build() {
+  // pairs sort by track ID, then by index so a track keeps its order
+  std::sort(scratch_.begin(), scratch_.end());
+
+  track_ids_.clear();
+  offsets_.clear();
+  indices_.clear();
+  indices_.reserve(scratch_.size());
+  for (const auto& [track_id, i] : scratch_) {
+    if (track_ids_.empty() || track_ids_.back() != track_id) {
+      track_ids_.push_back(track_id);
+      offsets_.push_back(indices_.size());
+    }
+    indices_.push_back(i);
+  }
+  offsets_.push_back(indices_.size());
+}
+
+TruthHitIndex::Hits TruthHitIndex::hits(int track_id) const {
+  auto it = std::lower_bound(track_ids_.begin(), track_ids_.end(), track_id);
+  if (it == track_ids_.end() || *it != track_id) return {nullptr, nullptr};
+  std::size_t t = it - track_ids_.begin();
+  return {indices_.data() + offsets_[t], indices_.data() + offsets_[t + 1]};
+}
+
+}  // namespace sim
+}  // namespace tracking
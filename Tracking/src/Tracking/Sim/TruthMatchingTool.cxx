@@ -4,42 +4,50 @@ namespace tracking {
 namespace sim {
 
 TruthMatchingTool::TruthInfo TruthMatchingTool::Evaluate(
-    const std::unordered_map<unsigned int, unsigned int>& trk_trackIDs,
+    const std::vector<std::pair<unsigned int, unsigned int>>& trk_trackIDs,
     int n_meas) {
   TruthInfo ti;
   ti.truthProb = 0.;
   ti.trackID = -1;
   ti.pdgID = 0;
 
-  for (std::unordered_map<unsigned int, unsigned int>::const_iterator it =
-           trk_trackIDs.begin();
-       it != trk_trackIDs.end(); it++) {
-    double currentTruthProb = (double)it->second / (double)n_meas;
+  for (const auto& [trkId, n] : trk_trackIDs) {
+    double currentTruthProb = (double)n / (double)n_meas;
     if (currentTruthProb > ti.truthProb) {
       ti.truthProb = currentTruthProb;
-      ti.trackID = it->first;
+      ti.trackID = trkId;
     }
   }
 
-  if (ti.trackID > 0) ti.pdgID = map_[ti.trackID].getPdgID();
+  if (ti.trackID > 0 && map_) {
+    auto it = map_->find(ti.trackID);
+    if (it != map_->end()) ti.pdgID = it->second.getPdgID();
+  }
 
   return ti;
 }
 
+void TruthMatchingTool::count(unsigned int trkId) {
+  // a track has only a handful of distinct trackIDs, a linear search over
+  // a flat vector is cheaper than hashing them
+  for (auto& [id, n] : trk_trackIDs_) {
+    if (id == trkId) {
+      n++;
+      return;
+    }
+  }
+  trk_trackIDs_.emplace_back(trkId, 1);
+}
+
 TruthMatchingTool::TruthInfo TruthMatchingTool::TruthMatch(
     const std::vector<ldmx::Measurement>& vmeas) {
-  std::unordered_map<unsigned int, unsigned int> trk_trackIDs;
-
-  for (auto meas : vmeas) {
-    for (auto trkId : meas.getTrackIds()) {
-      if (trk_trackIDs.find(trkId) != trk_trackIDs.end())
-        trk_trackIDs[trkId]++;
-      else
-        trk_trackIDs[trkId] = 1;
-    }
+  trk_trackIDs_.clear();
+
+  for (const auto& meas : vmeas) {
+    for (auto trkId : meas.getTrackIds()) count(trkId);
   }  // loop on measurements
 
-  return Evaluate(trk_trackIDs, vmeas.size());
+  return Evaluate(trk_trackIDs_, vmeas.size());
 }
 
 /**
@@ -53,37 +61,28 @@ TruthMatchingTool::TruthInfo TruthMatchingTool::TruthMatch(
 
 TruthMatchingTool::TruthInfo TruthMatchingTool::TruthMatch(
     const ldmx::Track& trk) {
-  // Map holding all tracksIds and their frequency
-  std::unordered_map<unsigned int, unsigned int> trk_trackIDs;
+  // All tracksIds and their frequency
+  trk_trackIDs_.clear();
 
   for (auto measID : trk.getMeasurementsIdxs()) {
-    auto meas = measurements_.at(measID);
+    const auto& meas = measurements_->at(measID);
     if (debug_) {
       std::cout << "Getting measurement at ID:" << measID << std::endl;
       std::cout << meas << std::endl;
       std::cout << meas.getTrackIds().size() << std::endl;
     }
 
-    for (auto trkId : meas.getTrackIds()) {
-      if (trk_trackIDs.find(trkId) != trk_trackIDs.end()) {
-        trk_trackIDs[trkId]++;
-      } else {
-        trk_trackIDs[trkId] = 1;
-      }
-
-    }  // loop on measurements trackIDs
+    for (auto trkId : meas.getTrackIds()) count(trkId);
 
     if (debug_) {
       std::cout << "The trackIDs maps look like:" << std::endl;
-      for (std::unordered_map<unsigned int, unsigned int>::iterator it =
-               trk_trackIDs.begin();
-           it != trk_trackIDs.end(); it++) {
-        std::cout << it->first << " " << it->second << std::endl;
+      for (const auto& [trkId, n] : trk_trackIDs_) {
+        std::cout << trkId << " " << n << std::endl;
       }
     }
   }  // loop on measurements
 
-  return Evaluate(trk_trackIDs, trk.getMeasurementsIdxs().size());
+  return Evaluate(trk_trackIDs_, trk.getMeasurementsIdxs().size());
 
 }  // Match Track
 
@@ -27,19 +27,17 @@ const Acts::Transform3& DetectorElement::transform(
   auto ctx = gctx.get<GeometryContext*>();
 
   // Found the aligned transform for this sensor
-  if ((ctx->alignment_map).count(elementId) > 0) {
-    const Acts::Transform3& c_transform = ctx->alignment_map[elementId];
-
+  if (const Acts::Transform3* c_transform = ctx->alignedTransform(m_index)) {
     if (m_debug) {
       std::cout << "Aligned transform" << std::endl;
-      std::cout << c_transform.translation() << std::endl;
-      std::cout << c_transform.rotation() << std::endl;
+      std::cout << c_transform->translation() << std::endl;
+      std::cout << c_transform->rotation() << std::endl;
       std::cout << "Original transform" << std::endl;
       std::cout << m_transform.translation() << std::endl;
       std::cout << m_transform.rotation() << std::endl;
     }
 
-    return c_transform;
+    return *c_transform;
   }
 
   else
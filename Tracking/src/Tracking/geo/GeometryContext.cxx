@@ -19,15 +19,30 @@ const Acts::GeometryContext& GeometryContext::get() const { return acts_gc_; }
 void GeometryContext::loadTransformations(const tgSurfMap& surf_map) {
   // Always clear the map before reloading the transformations.
   alignment_map.clear();
+  element_index_.clear();
 
   for (auto entry : surf_map) {
-    alignment_map[entry.first] =
-        static_cast<const DetectorElement*>(
-            (entry.second)->associatedDetectorElement())
-            ->uncorrectedTransform();
+    auto element = static_cast<const DetectorElement*>(
+        (entry.second)->associatedDetectorElement());
+    alignment_map[entry.first] = element->uncorrectedTransform();
+    element_index_[entry.first] = element->index();
   }
 }
 
+void GeometryContext::publish() {
+  auto store = std::make_unique<AlignmentStore>();
+  for (const auto& [sensorId, index] : element_index_) {
+    if (index >= store->aligned.size()) {
+      store->transforms.resize(index + 1, Acts::Transform3::Identity());
+      store->aligned.resize(index + 1, 0);
+    }
+    store->transforms[index] = alignment_map.at(sensorId);
+    store->aligned[index] = 1;
+  }
+  store_.store(store.get(), std::memory_order_release);
+  stores_.push_back(std::move(store));
+}
+
 // Some testing functionality
 
 // deltaT = (tu, tv, tw)
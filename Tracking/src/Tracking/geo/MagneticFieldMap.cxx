@@ -0,0 +1,57 @@
+#include "Tracking/geo/MagneticFieldMap.h"
+
+#include "Framework/ConditionsObjectProvider.h"
+#include "Framework/Configure/Parameters.h"
+
+namespace tracking::geo {
+
+const std::string MagneticFieldMap::NAME = "TrackingMagneticFieldMap";
+
+MagneticFieldMap::MagneticFieldMap(const std::string& field_map)
+    : framework::ConditionsObject(NAME),
+      field_map_{field_map},
+      map_{std::make_shared<const InterpolatedMagneticField3>(
+          loadDefaultBField(field_map, default_transformPos,
+                            default_transformBField))} {}
+
+class MagneticFieldMapProvider : public framework::ConditionsObjectProvider {
+ public:
+  /**
+   * Create the field map provider
+   *
+   * @param[in] name the name of this provider
+   * @param[in] tagname the name of the tag generation of this condition
+   * @param[in] parameters configuration parameters from python
+   * @param[in] process reference to the running process object
+   */
+  MagneticFieldMapProvider(const std::string& name, const std::string& tagname,
+                           const framework::config::Parameters& parameters,
+                           framework::Process& process)
+      : framework::ConditionsObjectProvider(MagneticFieldMap::NAME, tagname,
+                                            parameters, process) {
+    field_map_ = parameters.getParameter<std::string>("field_map");
+  }
+
+  /**
+   * Get the field map as a conditions object
+   *
+   * The map is built on the first request and is valid for all runs.
+   *
+   * @param[in] context EventHeader for the event context
+   * @returns new field map and unlimited interval of validity
+   */
+  std::pair<const framework::ConditionsObject*, framework::ConditionsIOV>
+  getCondition(const ldmx::EventHeader& context) final override {
+    return std::make_pair<const framework::ConditionsObject*,
+                          framework::ConditionsIOV>(
+        new MagneticFieldMap(field_map_), framework::ConditionsIOV(true, true));
+  }
+
+ private:
+  /// the path to the field map file
+  std::string field_map_;
+};
+
+}  // namespace tracking::geo
+
+DECLARE_CONDITIONS_PROVIDER_NS(tracking::geo, MagneticFieldMapProvider)
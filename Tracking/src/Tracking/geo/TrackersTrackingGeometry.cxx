@@ -1,26 +1,47 @@
 #include "Tracking/geo/TrackersTrackingGeometry.h"
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
 #include "Tracking/geo/GeoUtils.h"
 
 namespace tracking::geo {
 
 const std::string TrackersTrackingGeometry::NAME = "TrackersTrackingGeometry";
 
+namespace {
+
+/// identifies a cached layout and the version of its format
+const std::string CACHE_MAGIC{"LDMXTKG1"};
+
+template <typename T>
+void put(std::ostream& o, const T& val) {
+  o.write(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+template <typename T>
+bool get(std::istream& i, T& val) {
+  return bool(i.read(reinterpret_cast<char*>(&val), sizeof(T)));
+}
+
+}  // namespace
+
 TrackersTrackingGeometry::TrackersTrackingGeometry(
-    const Acts::GeometryContext& gctx, const std::string& gdml, bool debug)
+    const Acts::GeometryContext& gctx, const std::string& gdml, bool debug,
+    const std::string& cache_dir)
     : TrackingGeometry(NAME, gctx, gdml, debug) {
-  if (debug_) std::cout << "Looking for Tagger and Recoil volumes" << std::endl;
+  std::string cache_path;
+  if (!cache_dir.empty()) cache_path = cachePath(cache_dir);
+
+  if (cache_path.empty() || !readCache(cache_path)) {
+    readLayout();
+    if (!cache_path.empty()) writeCache(cache_path);
+  }
 
-  Tagger_ = findDaughterByName(fWorldPhysVol_, "tagger_PV");
-  // v12
-  // BuildTaggerLayoutMap(Tagger_, "LDMXTaggerModuleVolume_physvol");
-  // v14
-  BuildTaggerLayoutMap(Tagger_, "tagger");
   Acts::CuboidVolumeBuilder::VolumeConfig tagger_volume_cfg =
       buildTrackerVolume();
-
-  Recoil_ = findDaughterByName(fWorldPhysVol_, "recoil_PV");
-  BuildRecoilLayoutMap(Recoil_, "recoil");
   Acts::CuboidVolumeBuilder::VolumeConfig recoil_volume_cfg =
       buildRecoilVolume();
 
@@ -50,32 +71,60 @@ TrackersTrackingGeometry::TrackersTrackingGeometry(
   makeLayerSurfacesMap();
 }
 
-// This is basically a copy of the Tagger. TODO:: Make a single method!
-Acts::CuboidVolumeBuilder::VolumeConfig
-TrackersTrackingGeometry::buildRecoilVolume() {
-  Acts::CuboidVolumeBuilder::VolumeConfig subDetVolumeConfig;
-  Acts::Transform3 subDet_transform = GetTransform(*Recoil_, true);
+void TrackersTrackingGeometry::readLayout() {
+  parseGDML();
+
+  if (debug_) std::cout << "Looking for Tagger and Recoil volumes" << std::endl;
+
+  Tagger_ = findDaughterByName(fWorldPhysVol_, "tagger_PV");
+  // v12
+  // BuildTaggerLayoutMap(Tagger_, "LDMXTaggerModuleVolume_physvol");
+  // v14
+  BuildTaggerLayoutMap(Tagger_, "tagger");
+  tagger_volume_ = placeVolume(Tagger_);
+
+  Recoil_ = findDaughterByName(fWorldPhysVol_, "recoil_PV");
+  BuildRecoilLayoutMap(Recoil_, "recoil");
+  recoil_volume_ = placeVolume(Recoil_);
+}
+
+TrackersTrackingGeometry::VolumePlacement
+TrackersTrackingGeometry::placeVolume(G4VPhysicalVolume* pvol) const {
+  // Get the transform wrt the world volume in tracker frame
+  Acts::Transform3 subDet_transform = GetTransform(*pvol, true);
   if (debug_) {
+    std::cout << pvol->GetName() << std::endl;
     std::cout << subDet_transform.translation() << std::endl;
     std::cout << subDet_transform.rotation() << std::endl;
   }
 
+  VolumePlacement placement;
   // Add 1mm to not make it sit on the first layer surface  -  Ask Omar if it's
   // OK
-  Acts::Vector3 sub_det_position = {
+  placement.position = {
       subDet_transform.translation()(0) - 1,
       subDet_transform.translation()(1),
       subDet_transform.translation()(2),
   };
 
   // Get the size of the volume
-  G4Box* subDetBox = (G4Box*)(Recoil_->GetLogicalVolume()->GetSolid());
+  G4Box* subDetBox = (G4Box*)(pvol->GetLogicalVolume()->GetSolid());
 
   // In tracker coordinates. I add 1mm so that it compensates with the 1mm
   // movement of above
-  double x_length =
+  placement.x_length =
       2 * (subDetBox->GetZHalfLength() + 1) * Acts::UnitConstants::mm;
 
+  return placement;
+}
+
+// This is basically a copy of the Tagger. TODO:: Make a single method!
+Acts::CuboidVolumeBuilder::VolumeConfig
+TrackersTrackingGeometry::buildRecoilVolume() {
+  Acts::CuboidVolumeBuilder::VolumeConfig subDetVolumeConfig;
+  Acts::Vector3 sub_det_position = recoil_volume_.position;
+  double x_length = recoil_volume_.x_length;
+
   // double y_length  = 2*subDetBox->GetXHalfLength() * Acts::UnitConstants::mm;
   // double z_length  = 2*subDetBox->GetYHalfLength() * Acts::UnitConstants::mm;
 
@@ -85,7 +134,7 @@ TrackersTrackingGeometry::buildRecoilVolume() {
   double z_length = TrackerZLength_;
 
   if (debug_) {
-    std::cout << Recoil_->GetName() << std::endl;
+    std::cout << "Recoil" << std::endl;
     std::cout << "position" << std::endl;
     std::cout << sub_det_position << std::endl;
     std::cout << "x_length " << x_length << " y_length " << y_length
@@ -135,25 +184,8 @@ TrackersTrackingGeometry::buildRecoilVolume() {
 Acts::CuboidVolumeBuilder::VolumeConfig
 TrackersTrackingGeometry::buildTrackerVolume() {
   Acts::CuboidVolumeBuilder::VolumeConfig subDetVolumeConfig;
-
-  // Get the transform wrt the world volume in tracker frame
-  Acts::Transform3 subDet_transform = GetTransform(*Tagger_, true);
-
-  // Add 1mm to not make it sit on the first layer surface  -  Ask Omar if it's
-  // OK
-  Acts::Vector3 sub_det_position = {
-      subDet_transform.translation()(0) - 1,
-      subDet_transform.translation()(1),
-      subDet_transform.translation()(2),
-  };
-
-  // Get the size of the volume
-  G4Box* subDetBox = (G4Box*)(Tagger_->GetLogicalVolume()->GetSolid());
-
-  // In tracker coordinates. I add 1mm so that it compensates with the 1mm
-  // movement of above
-  double x_length =
-      2 * (subDetBox->GetZHalfLength() + 1) * Acts::UnitConstants::mm;
+  Acts::Vector3 sub_det_position = tagger_volume_.position;
+  double x_length = tagger_volume_.x_length;
 
   // double y_length  = 2*subDetBox->GetXHalfLength() * Acts::UnitConstants::mm;
   // double z_length  = 2*subDetBox->GetYHalfLength() * Acts::UnitConstants::mm;
@@ -164,14 +196,11 @@ TrackersTrackingGeometry::buildTrackerVolume() {
   double z_length = TrackerZLength_;
 
   if (debug_) {
-    std::cout << Tagger_->GetName() << std::endl;
+    std::cout << "Tagger" << std::endl;
     std::cout << "position" << std::endl;
     std::cout << sub_det_position << std::endl;
     std::cout << "x_length " << x_length << " y_length " << y_length
               << " z_length " << z_length << std::endl;
-
-    std::cout << subDet_transform.translation() << std::endl;
-    std::cout << subDet_transform.rotation() << std::endl;
   }
 
   subDetVolumeConfig.position = sub_det_position;
@@ -496,11 +525,6 @@ std::shared_ptr<Acts::PlaneSurface> TrackersTrackingGeometry::GetSurface(
     sens_mat->GetDensity());
   */
 
-  // Define the silicon material
-  Acts::Material silicon = Acts::Material::fromMassDensity(
-      95.7 * Acts::UnitConstants::mm, 465.2 * Acts::UnitConstants::mm, 28.03,
-      14., 2.32 * Acts::UnitConstants::g / Acts::UnitConstants::cm3);
-
   // Get the active sensor box
   G4Box* surfaceSolid = (G4Box*)(pvol->GetLogicalVolume()->GetSolid());
 
@@ -511,16 +535,28 @@ std::shared_ptr<Acts::PlaneSurface> TrackersTrackingGeometry::GetSurface(
               << surfaceSolid->GetZHalfLength() << " " << std::endl;
   }
 
+  return makeSurface(
+      surface_transform_tracker,
+      surfaceSolid->GetXHalfLength() * Acts::UnitConstants::mm,
+      surfaceSolid->GetYHalfLength() * Acts::UnitConstants::mm,
+      2 * surfaceSolid->GetZHalfLength() * Acts::UnitConstants::mm);
+}
+
+std::shared_ptr<Acts::PlaneSurface> TrackersTrackingGeometry::makeSurface(
+    const Acts::Transform3& surface_transform_tracker, double half_x,
+    double half_y, double thickness) {
+  // Define the silicon material
+  Acts::Material silicon = Acts::Material::fromMassDensity(
+      95.7 * Acts::UnitConstants::mm, 465.2 * Acts::UnitConstants::mm, 28.03,
+      14., 2.32 * Acts::UnitConstants::g / Acts::UnitConstants::cm3);
+
   // Form the material slab
-  double thickness =
-      2 * surfaceSolid->GetZHalfLength() * Acts::UnitConstants::mm;
   Acts::MaterialSlab silicon_slab(silicon, thickness);
 
   // Get the bounds
   std::shared_ptr<const Acts::RectangleBounds> rect_bounds =
-      std::make_shared<const Acts::RectangleBounds>(Acts::RectangleBounds(
-          surfaceSolid->GetXHalfLength() * Acts::UnitConstants::mm,
-          surfaceSolid->GetYHalfLength() * Acts::UnitConstants::mm));
+      std::make_shared<const Acts::RectangleBounds>(
+          Acts::RectangleBounds(half_x, half_y));
 
   // Form the active sensor surface
   std::shared_ptr<Acts::PlaneSurface> surface =
@@ -533,7 +569,7 @@ std::shared_ptr<Acts::PlaneSurface> TrackersTrackingGeometry::GetSurface(
   // The default transformation is the surface parsed transformation
 
   auto detElement = std::make_shared<DetectorElement>(
-      surface, surface_transform_tracker, thickness);
+      surface, surface_transform_tracker, thickness, detElements.size());
 
   // This is the call that modify the behaviour of surface->transform(gctx)
   // After this call each surface will use the underlying detectorElement
@@ -545,4 +581,135 @@ std::shared_ptr<Acts::PlaneSurface> TrackersTrackingGeometry::GetSurface(
   return surface;
 }
 
+std::string TrackersTrackingGeometry::cachePath(
+    const std::string& cache_dir) const {
+  namespace fs = boost::filesystem;
+  boost::system::error_code ec;
+  fs::path det_dir{fs::canonical(fs::path(gdml_), ec).parent_path()};
+  if (ec) return "";
+
+  // the GDML includes other files of the detector, so they are all hashed
+  std::vector<fs::path> files;
+  for (const auto& entry : fs::directory_iterator(det_dir, ec)) {
+    if (fs::is_regular_file(entry.status())) files.push_back(entry.path());
+  }
+  if (ec) return "";
+  std::sort(files.begin(), files.end());
+  std::string contents{CACHE_MAGIC};
+  for (const auto& file : files) {
+    std::ifstream ifs(file.string(), std::ios::binary);
+    contents += file.filename().string();
+    contents.append(std::istreambuf_iterator<char>(ifs),
+                    std::istreambuf_iterator<char>());
+  }
+
+  std::stringstream ss;
+  ss << cache_dir << "/" << det_dir.filename().string() << "_" << NAME << "_"
+     << std::hex << std::hash<std::string>{}(contents) << ".bin";
+  return ss.str();
+}
+
+bool TrackersTrackingGeometry::readCache(const std::string& path) {
+  std::ifstream ifs(path, std::ios::binary);
+  if (!ifs.is_open()) return false;
+
+  std::string magic(CACHE_MAGIC.size(), ' ');
+  if (!ifs.read(&magic[0], magic.size()) || magic != CACHE_MAGIC) return false;
+
+  for (auto volume : {&tagger_volume_, &recoil_volume_}) {
+    for (int i = 0; i < 3; i++) get(ifs, volume->position(i));
+    get(ifs, volume->x_length);
+  }
+
+  for (auto layout : {&tagger_layout, &recoil_layout}) {
+    uint32_t n_layers{0};
+    get(ifs, n_layers);
+    for (uint32_t l = 0; ifs && l < n_layers; l++) {
+      uint32_t name_size{0};
+      get(ifs, name_size);
+      std::string name(name_size, ' ');
+      ifs.read(&name[0], name_size);
+      uint32_t n_sensors{0};
+      get(ifs, n_sensors);
+      for (uint32_t k = 0; ifs && k < n_sensors; k++) {
+        Acts::Transform3 transform = Acts::Transform3::Identity();
+        for (int r = 0; r < 3; r++)
+          for (int c = 0; c < 4; c++) get(ifs, transform.matrix()(r, c));
+        double half_x{0}, half_y{0}, thickness{0};
+        get(ifs, half_x);
+        get(ifs, half_y);
+        get(ifs, thickness);
+        if (ifs)
+          (*layout)[name].push_back(
+              makeSurface(transform, half_x, half_y, thickness));
+      }
+    }
+  }
+
+  if (!ifs) {
+    // truncated file, start over from the GDML
+    tagger_layout.clear();
+    recoil_layout.clear();
+    detElements.clear();
+    return false;
+  }
+
+  if (debug_) std::cout << "Read tracker layout from " << path << std::endl;
+  return true;
+}
+
+void TrackersTrackingGeometry::writeCache(const std::string& path) const {
+  namespace fs = boost::filesystem;
+  boost::system::error_code ec;
+  fs::create_directories(fs::path(path).parent_path(), ec);
+
+  // written to a unique file and moved in place so that jobs starting at
+  // the same time never read a partially written layout
+  fs::path tmp{fs::unique_path(path + ".%%%%%%%%")};
+  {
+    std::ofstream ofs(tmp.string(), std::ios::binary);
+    if (!ofs.is_open()) return;
+
+    ofs.write(CACHE_MAGIC.data(), CACHE_MAGIC.size());
+
+    for (auto volume : {&tagger_volume_, &recoil_volume_}) {
+      for (int i = 0; i < 3; i++) put(ofs, volume->position(i));
+      put(ofs, volume->x_length);
+    }
+
+    for (auto layout : {&tagger_layout, &recoil_layout}) {
+      put(ofs, uint32_t(layout->size()));
+      for (const auto& [name, surfaces] : *layout) {
+        put(ofs, uint32_t(name.size()));
+        ofs.write(name.data(), name.size());
+        put(ofs, uint32_t(surfaces.size()));
+        for (const auto& surface : surfaces) {
+          auto element = dynamic_cast<const DetectorElement*>(
+              surface->associatedDetectorElement());
+          Acts::Transform3 transform = element->uncorrectedTransform();
+          for (int r = 0; r < 3; r++)
+            for (int c = 0; c < 4; c++) put(ofs, transform.matrix()(r, c));
+          const auto& bounds =
+              static_cast<const Acts::RectangleBounds&>(surface->bounds());
+          put(ofs, bounds.halfLengthX());
+          put(ofs, bounds.halfLengthY());
+          put(ofs, element->thickness());
+        }
+      }
+    }
+    if (!ofs) {
+      ofs.close();
+      fs::remove(tmp, ec);
+      return;
+    }
+  }
+
+  fs::rename(tmp, path, ec);
+  if (ec) {
+    fs::remove(tmp, ec);
+  } else if (debug_) {
+    std::cout << "Wrote tracker layout to " << path << std::endl;
+  }
+}
+
 }  // namespace tracking::geo
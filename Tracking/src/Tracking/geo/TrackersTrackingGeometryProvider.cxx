@@ -34,6 +34,8 @@ class TrackersTrackingGeometryProvider
   std::string detector_;
   /// whether to have debug information or not
   bool debug_;
+  /// directory of the cached tracker layouts, empty to always use the GDML
+  std::string cache_dir_;
 };
 
 TrackersTrackingGeometryProvider::TrackersTrackingGeometryProvider(
@@ -43,6 +45,7 @@ TrackersTrackingGeometryProvider::TrackersTrackingGeometryProvider(
     : framework::ConditionsObjectProvider(name, tag_name, parameters, process) {
   detector_ = parameters.getParameter<std::string>("detector");
   debug_ = parameters.getParameter<bool>("debug");
+  cache_dir_ = parameters.getParameter<std::string>("cacheDir", "");
 }
 
 std::pair<const framework::ConditionsObject*, framework::ConditionsIOV>
@@ -69,7 +72,9 @@ TrackersTrackingGeometryProvider::getCondition(
    * currently-designed conditions system.
    */
   return std::make_pair(
-      new TrackersTrackingGeometry(the_context->get(), detector_, debug_), iov);
+      new TrackersTrackingGeometry(the_context->get(), detector_, debug_,
+                                   cache_dir_),
+      iov);
 }
 }  // namespace tracking::geo
 
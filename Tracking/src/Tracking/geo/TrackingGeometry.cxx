@@ -55,7 +55,9 @@ TrackingGeometry::TrackingGeometry(const std::string& name,
   x_rot_.col(0) = xPos2;
   x_rot_.col(1) = yPos2;
   x_rot_.col(2) = zPos2;
+}
 
+void TrackingGeometry::parseGDML() {
   /**
    * We are about to use the G4GDMLParser and would like to silence
    * the output from parsing the geometry. This can only be done by
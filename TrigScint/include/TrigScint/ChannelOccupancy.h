@@ -0,0 +1,98 @@
+/**
+ * @file ChannelOccupancy.h
+ * @brief Hits of the channels of a pad, indexed by channel, for clustering
+ */
+
+#ifndef TRIGSCINT_CHANNELOCCUPANCY_H
+#define TRIGSCINT_CHANNELOCCUPANCY_H
+
+#include <algorithm>
+#include <vector>
+
+namespace trigscint {
+
+/**
+ * @class ChannelOccupancy
+ * @brief Index of the hit in each channel and whether it is used already
+ *
+ * The pads have a small, fixed number of channels, so the hits are looked
+ * up by indexing arrays with the channel number rather than searching a
+ * map. The arrays grow to the largest channel seen and are kept between
+ * events, only their contents are cleared.
+ */
+class ChannelOccupancy {
+ public:
+  /**
+   * Does the channel have a hit?
+   * @param channel channel number
+   */
+  bool has(int channel) const {
+    return channel >= 0 and channel < size() and hits_[channel] >= 0;
+  }
+
+  /**
+   * Index of the hit of a channel in the input collection
+   * @param channel channel number, which has to have a hit
+   */
+  int hit(int channel) const { return hits_[channel]; }
+
+  /**
+   * Set the hit of a channel, if it doesn't have one already
+   * @param channel channel number
+   * @param hit index of the hit in the input collection
+   * @return false if the channel already has a hit
+   */
+  bool insert(int channel, int hit) {
+    if (channel < 0) return false;
+    if (channel >= size()) {
+      hits_.resize(channel + 1, -1);
+      used_.resize(channel + 1, false);
+    }
+    if (hits_[channel] >= 0) return false;
+    hits_[channel] = hit;
+    return true;
+  }
+
+  /**
+   * Remove the hit of a channel
+   * @param channel channel number
+   */
+  void erase(int channel) {
+    if (has(channel)) hits_[channel] = -1;
+  }
+
+  /**
+   * Has the hit of a channel been added to a cluster?
+   * @param channel channel number
+   */
+  bool used(int channel) const {
+    return channel >= 0 and channel < size() and used_[channel];
+  }
+
+  /**
+   * Mark the hit of a channel as added to a cluster
+   * @param channel channel number
+   */
+  void use(int channel) {
+    if (channel >= 0 and channel < size()) used_[channel] = true;
+  }
+
+  /// One past the largest channel which had a hit
+  int size() const { return hits_.size(); }
+
+  /// Remove all the hits and their used flags
+  void clear() {
+    std::fill(hits_.begin(), hits_.end(), -1);
+    std::fill(used_.begin(), used_.end(), false);
+  }
+
+ private:
+  /// index of the hit of each channel, -1 if it has none
+  std::vector<int> hits_;
+  /// whether the hit of each channel is in a cluster
+  std::vector<bool> used_;
+};
+
+}  // namespace trigscint
+
+#endif  // TRIGSCINT_CHANNELOCCUPANCY_H
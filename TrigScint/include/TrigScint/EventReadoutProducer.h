@@ -48,6 +48,24 @@ class EventReadoutProducer : public framework::Producer {
   void produce(framework::Event& event);
 
  private:
+  /**
+   * Replace the pedestal and noise of the channel with their average over
+   * the last events, including this one.
+   *
+   * @param outEvent readout of the channel in this event
+   */
+  void updatePedestal(trigscint::EventReadout& outEvent);
+
+  /// Pedestal and noise of a channel in the last events, as a ring buffer
+  struct RunningPedestal {
+    std::vector<float> pedestals;
+    std::vector<float> noises;
+    /// index in the ring the next event is written to
+    int next{0};
+    /// number of events in the ring
+    int filled{0};
+  };
+
   /// Class to set the verbosity level.
   // TODO: Make use of the global verbose parameter.
   bool verbose_{false};
@@ -72,6 +90,20 @@ class EventReadoutProducer : public framework::Producer {
 
   /// Which of the fibers to set the time shift for (0 or 1)
   int fiberToShift_{1};
+
+  /// Number of events the pedestal and noise of a channel are averaged over,
+  /// 0 to use those of each event alone
+  int pedestalEvents_{0};
+
+  /// Running pedestals, indexed by channel, kept across events
+  std::vector<RunningPedestal> runningPedestals_;
+
+  /// Charge and its error of the samples of the channel at hand
+  std::vector<float> charge_;
+  std::vector<float> chargeErr_;
+
+  /// Locally normalized charges used in the oscillation check
+  std::vector<float> chargeCheck_;
 };
 
 }  // namespace trigscint
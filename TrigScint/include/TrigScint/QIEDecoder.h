@@ -40,6 +40,17 @@ class QIEDecoder : public framework::Producer {
   std::string channelMapFileName_;
   std::ifstream channelMapFile_;
   std::map<int, int> channelMap_;
+  /// bar ID of each electronics ID, -1 if it isn't in the map
+  std::vector<int> barIDs_;
+
+  /// ADCs of each channel, in electronics order, reused every event
+  std::vector<int> adcs_;
+  /// TDCs of each channel, in electronics order, reused every event
+  std::vector<int> tdcs_;
+  /// channels with a non-zero ADC in any sample
+  std::vector<bool> hasADC_;
+  /// channels with a non-zero TDC in any sample
+  std::vector<bool> hasTDC_;
 
   // input/output collection and pass name
   std::string inputCollection_;
@@ -45,6 +45,18 @@ class QIEInputPulse {
    */
   virtual float Max(int id) = 0;
 
+  /**
+   * First time in [T1, T2) at which the pulse train reaches the threshold
+   *
+   * The default scans the pulse train in steps of 0.1 ns.
+   *
+   * @param T1 start of the time window
+   * @param T2 end of the time window
+   * @param thr threshold on the pulse train
+   * @return crossing time, or T2 if the threshold isn't reached
+   */
+  virtual float CrossingTime(float T1, float T2, float thr);
+
   /**
    * To add a pulse to the collection
    * @param toff time at which the pulse starts
@@ -52,6 +64,11 @@ class QIEInputPulse {
    */
   void AddPulse(float toff, float ampl);
 
+  /**
+   * Remove all the pulses, keeping the memory for the next ones
+   */
+  void Clear();
+
   /**
    * Get the number of pulses in the collection
    */
@@ -174,6 +191,15 @@ class Expo : public QIEInputPulse {
    */
   float Derivative(float T, int id) final override;
 
+  /**
+   * First time in [T1, T2) at which the pulse train reaches the threshold
+   *
+   * Between the starts and the maxima of its pulses, the pulse train is
+   * a + b*exp(-k*t), which is monotonic, so the crossing is solved for
+   * exactly in the first of these intervals that reaches the threshold.
+   */
+  float CrossingTime(float T1, float T2, float thr) final override;
+
  private:
   /// 1/RC time constant (for the capacitor)
   float k_;
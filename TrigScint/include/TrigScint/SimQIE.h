@@ -1,6 +1,7 @@
 #ifndef TRIGSCINT_SIMQIE_H
 #define TRIGSCINT_SIMQIE_H
 
+#include <array>
 #include <iostream>
 
 #include "TMath.h"
@@ -111,14 +112,39 @@ class SimQIE {
 
  private:
   /// Indices of first bin of each subrange
-  int nbins_[5] = {0, 16, 36, 57, 64};
+  static constexpr int nbins_[5] = {0, 16, 36, 57, 64};
   /// Charge lower limit of all the 16 subranges
-  float edges_[17] = {-16,   34,    158,    419,    517,   915,
-                      1910,  3990,  4780,   7960,   15900, 32600,
-                      38900, 64300, 128000, 261000, 350000};
+  static constexpr float edges_[17] = {
+      -16,   34,    158,   419,   517,    915,    1910,   3990,  4780,
+      7960,  15900, 32600, 38900, 64300,  128000, 261000, 350000};
   /// sensitivity of the subranges (Total charge/no. of bins)
-  float sense_[16] = {3.1,   6.2,   12.4,  24.8, 24.8, 49.6, 99.2, 198.4,
-                      198.4, 396.8, 793.6, 1587, 1587, 3174, 6349, 12700};
+  static constexpr float sense_[16] = {3.1,   6.2,   12.4,  24.8,
+                                       24.8,  49.6,  99.2,  198.4,
+                                       198.4, 396.8, 793.6, 1587,
+                                       1587,  3174,  6349,  12700};
+
+  /**
+   * Mean charge of the bin of each ADC count (before the gain)
+   *
+   * The ADC count is split into its range (ADC/64) and the subrange of
+   * ADC%64 within that range, whose lower edge and sensitivity give the
+   * middle of the bin.
+   */
+  static constexpr std::array<float, 256> charges_ = [] {
+    std::array<float, 256> charges{};
+    for (int adc = 0; adc < 256; adc++) {
+      int rr = adc / 64;  // range
+      int v1 = adc % 64;  // temp. var
+      int ss = 0;         // sub range
+      for (int i = 1; i < 4; i++) {
+        if (v1 > nbins_[i]) ss++;
+      }
+      charges[adc] = edges_[4 * rr + ss] +
+                     (v1 - nbins_[ss]) * sense_[4 * rr + ss] +
+                     sense_[4 * rr + ss] / 2;
+    }
+    return charges;
+  }();
 
   /// QIE gain -> to convert from no. of e- to charge in fC
   float gain_{1};
@@ -12,6 +12,7 @@
 #include "Framework/Event.h"
 #include "Framework/EventProcessor.h"  //Needed to declare processor
 #include "Recon/Event/EventConstants.h"
+#include "TrigScint/ChannelOccupancy.h"
 #include "TrigScint/Event/TestBeamHit.h"
 #include "TrigScint/Event/TrigScintCluster.h"
 
@@ -85,9 +86,6 @@ class TestBeamClusterProducer : public framework::Producer {
   // book keep which channels have already been added to the cluster at hand
   std::vector<unsigned int> v_addedIndices_;
 
-  // book keep which channels have already been added to any cluster
-  std::vector<unsigned int> v_usedIndices_;
-
   // fraction of cluster energy deposition associated with beam electron sim
   // hits
   // -- could convert this to instead be a "cleanb frac"; fraction of cluster
@@ -101,8 +99,8 @@ class TestBeamClusterProducer : public framework::Producer {
   // cluster time (energy weighted based on hit time)
   float time_{0.};
 
-  // empty map container
-  std::map<int, int> hitChannelMap_;
+  // hit of each channel, and whether it has been added to any cluster
+  ChannelOccupancy hits_;
 };
 
 }  // namespace trigscint
@@ -12,6 +12,7 @@
 #include "Framework/Event.h"
 #include "Framework/EventProcessor.h"  //Needed to declare processor
 #include "Recon/Event/EventConstants.h"
+#include "TrigScint/ChannelOccupancy.h"
 #include "TrigScint/Event/TrigScintCluster.h"
 #include "TrigScint/Event/TrigScintHit.h"
 
@@ -91,9 +92,6 @@ class TrigScintClusterProducer : public framework::Producer {
   // book keep which channels have already been added to the cluster at hand
   std::vector<unsigned int> v_addedIndices_;
 
-  // book keep which channels have already been added to any cluster
-  std::vector<unsigned int> v_usedIndices_;
-
   // fraction of cluster energy deposition associated with beam electron sim
   // hits
   float beamE_{0.};
@@ -101,8 +99,8 @@ class TrigScintClusterProducer : public framework::Producer {
   // cluster time (energy weighted based on hit time)
   float time_{0.};
 
-  // empty map container
-  std::map<int, int> hitChannelMap_;
+  // hit of each channel, and whether it has been added to any cluster
+  ChannelOccupancy hits_;
 };
 
 }  // namespace trigscint
@@ -13,9 +13,11 @@
 #include "TRandom3.h"
 
 // LDMX
+#include "DetDescr/IDMap.h"
 #include "DetDescr/TrigScintID.h"
 #include "Recon/Event/EventConstants.h"
 #include "SimCore/Event/SimCalorimeterHit.h"
+#include "Tools/EmptyChannelSampler.h"
 #include "Tools/NoiseGenerator.h"
 #include "TrigScint/Event/TrigScintHit.h"
 
@@ -61,12 +63,28 @@ class TrigScintDigiProducer : public framework::Producer {
   ldmx::TrigScintID generateRandomID(int module);
 
  private:
+  /// The energy deposited in a bar and its weighted position and time
+  struct Cell {
+    /// energy deposited [MeV]
+    float edep{0.};
+    /// energy deposited by the beam electrons [MeV]
+    float beamEdep{0.};
+    /// energy-weighted time and position, divided by edep once summed
+    float time{0.}, x{0.}, y{0.}, z{0.};
+  };
+
+  /// The cells hit in the event, kept to reuse their memory
+  ldmx::IDMap<ldmx::TrigScintID, Cell> cells_;
+
   /// Random number generator
   std::unique_ptr<TRandom3> random_{nullptr};
 
   /// Generate noise hits given the number of channels and mean noise.
   std::unique_ptr<ldmx::NoiseGenerator> noiseGenerator_{nullptr};
 
+  /// Draws the empty bars of the array to put the noise hits in
+  std::unique_ptr<ldmx::EmptyChannelSampler> noiseBars_{nullptr};
+
   /// Class to set the verbosity level.
   // TODO: Make use of the global verbose parameter.
   bool verbose_{false};
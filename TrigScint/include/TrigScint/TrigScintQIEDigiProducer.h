@@ -129,8 +129,11 @@ class TrigScintQIEDigiProducer : public framework::Producer {
   /// Zero-suppression: discard any integrated pulses with PE < this number
   float zeroSuppCut_{1.};
 
-  /// SimQIE pointer
-  SimQIE* smq_{nullptr};
+  /// SimQIE instance
+  std::unique_ptr<SimQIE> smq_;
+
+  /// Input pulses of each bar, cleared and reused every event
+  std::vector<Expo> pulses_;
 };
 
 }  // namespace trigscint
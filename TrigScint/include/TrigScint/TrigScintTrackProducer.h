@@ -29,11 +29,55 @@ class TrigScintTrackProducer : public framework::Producer {
   void onProcessEnd() override;
 
  private:
+  // indices of the clusters of a pad, sorted by centroid and by x centroid
+  struct PadIndex {
+    std::vector<int> byCentroid;
+    std::vector<int> byX;
+  };
+
   // collection of produced tracks
   std::vector<ldmx::TrigScintTrack> tracks_;
 
+  // index of the pad1 and pad2 (-1 if none) cluster of each produced track
+  std::vector<int> trackPad1_;
+  std::vector<int> trackPad2_;
+
+  // sorted clusters of the two pads following the seeding pad
+  PadIndex pad1_;
+  PadIndex pad2_;
+
+  // clusters of the two pads matching the seed at hand
+  std::vector<int> matches1_;
+  std::vector<int> matches2_;
+
+  // sort the indices of the clusters of a pad
+  void indexPad(const std::vector<ldmx::TrigScintCluster> &clusters,
+                PadIndex &index) const;
+
+  // find the clusters of a pad which can be on a track with the seed, in the
+  // order of the collection
+  void findMatches(const ldmx::TrigScintCluster &seed,
+                   const std::vector<ldmx::TrigScintCluster> &clusters,
+                   const PadIndex &index, std::vector<int> &matches) const;
+
+  // unweighted centroid of the clusters of a track
+  float trackCentroid(
+      const std::vector<const ldmx::TrigScintCluster *> &clusters) const;
+
+  // residual of the clusters of a track around its centroid
+  float trackResidual(
+      const std::vector<const ldmx::TrigScintCluster *> &clusters,
+      float centroid) const;
+
   // add a cluster to a track
-  ldmx::TrigScintTrack makeTrack(std::vector<ldmx::TrigScintCluster> clusters);
+  ldmx::TrigScintTrack makeTrack(
+      const std::vector<const ldmx::TrigScintCluster *> &clusters);
+
+  // flag the tracks sharing a cluster in a pad, keeping the one with the
+  // smallest residual
+  void resolveOverlaps(const std::vector<ldmx::TrigScintCluster> &clusters,
+                       const std::vector<int> &trackClusters,
+                       std::vector<int> &keepIndices) const;
 
   // match x, y tracks and set their x,y spatial coordinates
   void matchXYTracks(std::vector<ldmx::TrigScintTrack> &tracks);
@@ -116,6 +116,9 @@ class EventReadoutProducer(ldmxcfg.Producer) :
         self.number_pedestal_samples=5
         self.time_shift=5
         self.fiber_to_shift=0
+        # number of events the channel pedestal and noise are averaged over,
+        # 0 to use those of each event alone
+        self.pedestal_events=0
         self.verbose = False
         
 class TestBeamHitProducer(ldmxcfg.Producer) :
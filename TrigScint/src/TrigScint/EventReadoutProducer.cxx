@@ -21,6 +21,7 @@ void EventReadoutProducer::configure(
   nPedSamples_ = parameters.getParameter<int>("number_pedestal_samples");
   timeShift_ = parameters.getParameter<int>("time_shift");
   fiberToShift_ = parameters.getParameter<int>("fiber_to_shift");
+  pedestalEvents_ = parameters.getParameter<int>("pedestal_events", 0);
   verbose_ = parameters.getParameter<bool>("verbose");
 
   ldmx_log(debug) << "In configure, got parameters:"
@@ -30,6 +31,7 @@ void EventReadoutProducer::configure(
                   << "\nnumber_pedestal_samples  = " << nPedSamples_
                   << "\ntime_shift = " << timeShift_
                   << "\nfiber_to_shift  = " << fiberToShift_
+                  << "\npedestal_events  = " << pedestalEvents_
                   << "\nverbose          = " << verbose_;
 }
 
@@ -41,10 +43,10 @@ void EventReadoutProducer::produce(framework::Event &event) {
       inputCollection_, inputPassName_)};
 
   std::vector<trigscint::EventReadout> channelReadoutEvents;
+  channelReadoutEvents.reserve(digis.size());
   for (const auto &digi : digis) {
     trigscint::EventReadout outEvent;
-    auto adc{digi.getADC()};
-    auto tdc{digi.getTDC()};
+    const auto adc{digi.getADC()};
 
     // copy over from qie digi for convenience
     outEvent.setChanID(digi.getChanID());
@@ -56,32 +58,34 @@ void EventReadoutProducer::produce(framework::Event &event) {
       outEvent.setTimeOffset(timeShift_);
 
     outEvent.setADC(adc);
-    outEvent.setTDC(tdc);
-    std::vector<float> charge;
-    std::vector<float> chargeErr;
+    outEvent.setTDC(digi.getTDC());
+
+    // linearize all the samples into contiguous arrays first, the sums over
+    // them are then simple loops
+    const int nSamples = adc.size();
+    charge_.resize(nSamples);
+    chargeErr_.resize(nSamples);
+    for (int iS = 0; iS < nSamples; iS++) charge_[iS] = qie.ADC2Q(adc[iS]);
+    for (int iS = 0; iS < nSamples; iS++)
+      chargeErr_[iS] = qie.QErr(charge_[iS]);
 
     float avgQ = 0;
     float totPosQ = 0;
-    int iS = 0;
-    int nPos = 0;
     float earlyPed = 0;
-    for (auto &val : adc) {
-      float Q = qie.ADC2Q(val);
-      charge.push_back(Q);
-      chargeErr.push_back(qie.QErr(Q));
-      avgQ += Q;  // charge.back();
-      if (Q > 0) {
-        totPosQ += Q;
-        nPos++;
-      }
-      if (verbose_)
-        ldmx_log(debug) << "got adc value " << val << " and charge "
-                        << Q;  // qie.ADC2Q(val);
+    for (int iS = 0; iS < nSamples; iS++) {
+      float Q = charge_[iS];
+      avgQ += Q;
+      totPosQ += Q > 0 ? Q : 0;
       if (iS < nPedSamples_) earlyPed += Q;
-      iS++;
     }
-    outEvent.setQ(charge);          // set in proper order before sorting
-    outEvent.setQError(chargeErr);  // set in proper order before sorting
+    if (verbose_) {
+      for (int iS = 0; iS < nSamples; iS++)
+        ldmx_log(debug) << "got adc value " << adc[iS] << " and charge "
+                        << charge_[iS];
+    }
+    outEvent.setQ(charge_);          // set in proper order before sorting
+    outEvent.setQError(chargeErr_);  // set in proper order before sorting
+    std::vector<float> &charge{charge_};
     earlyPed /= nPedSamples_;
     outEvent.setEarlyPedestal(earlyPed);
 
@@ -92,7 +96,8 @@ void EventReadoutProducer::produce(framework::Event &event) {
     // case: multiple single PE peaks with that repetition. we probably don't
     // need to keep those anyway
     if (verbose_) ldmx_log(debug) << "going into oscillations check ";
-    std::vector<float> chargeCheck = {NULL};
+    std::vector<float> &chargeCheck{chargeCheck_};
+    chargeCheck.assign(1, 0.);
     float minCharge =
         10;  // no point in looking at oscillations just around the pedestal.
              // nearest edge is 10.35 fC  //ADC=0 corresponds to -16 fC.
@@ -269,6 +274,10 @@ flips and long weird pulses
         << flagOscillation << "+" << flagNoise;
     outEvent.setQualityFlag(flag);
 
+    // the flags above judge this event alone, while the pedestal and noise
+    // stored are averaged over the last events of the channel
+    if (pedestalEvents_ > 0) updatePedestal(outEvent);
+
     //	if (ped > 15 )
     //  continue;
     ldmx_log(debug) << "In event " << event.getEventHeader().getEventNumber()
@@ -285,6 +294,38 @@ flips and long weird pulses
   event.add(outputCollection_, channelReadoutEvents);
   ldmx_log(debug) << "\n";
 }
+
+void EventReadoutProducer::updatePedestal(trigscint::EventReadout &outEvent) {
+  int chan = outEvent.getChanID();
+  if (chan < 0) return;
+  if (chan >= (int)runningPedestals_.size()) runningPedestals_.resize(chan + 1);
+  auto &running{runningPedestals_[chan]};
+  if (running.pedestals.empty()) {
+    running.pedestals.resize(pedestalEvents_);
+    running.noises.resize(pedestalEvents_);
+  }
+
+  // overwrite the oldest event once the ring is full
+  running.pedestals[running.next] = outEvent.getPedestal();
+  running.noises[running.next] = outEvent.getNoise();
+  running.next = (running.next + 1) % pedestalEvents_;
+  if (running.filled < pedestalEvents_) running.filled++;
+
+  float ped = 0;
+  float noise = 0;
+  for (int i = 0; i < running.filled; i++) {
+    ped += running.pedestals[i];
+    noise += running.noises[i];
+  }
+  outEvent.setPedestal(ped / running.filled);
+  outEvent.setNoise(noise / running.filled);
+
+  if (verbose_)
+    ldmx_log(debug) << "Running pedestal of channel " << chan << " over "
+                    << running.filled
+                    << " events = " << outEvent.getPedestal()
+                    << " fC, noise = " << outEvent.getNoise() << " fC";
+}
 }  // namespace trigscint
 
 DECLARE_PRODUCER_NS(trigscint, EventReadoutProducer);
@@ -6,6 +6,18 @@
 
 namespace trigscint {
 
+namespace {
+
+/// Read the little-endian word of len bytes starting at pos in the stream
+uint32_t readWord(const uint8_t *stream, int pos, int len) {
+  uint32_t word = 0;
+  for (int iW = 0; iW < len; iW++)
+    word |= uint32_t(stream[pos + iW]) << iW * 8;  // a byte at a time
+  return word;
+}
+
+}  // namespace
+
 void QIEDecoder::configure(framework::config::Parameters &ps) {
   // Configure this instance of the encoder
   outputCollection_ = ps.getParameter<std::string>("output_collection");
@@ -52,6 +64,11 @@ void QIEDecoder::configure(framework::config::Parameters &ps) {
     ldmx_log(debug) << elID << "  chID " << chID;
   }
   channelMapFile_.close();
+  // bar of each electronics ID, -1 if it isn't mapped
+  barIDs_.assign(nChannels_, -1);
+  for (const auto &[elec, bar] : channelMap_) {
+    if (elec >= 0 and elec < nChannels_) barIDs_[elec] = bar;
+  }
   if (elID != nChannels_ - 1)
     ldmx_log(fatal) << "The set number of channels " << nChannels_
                     << " seems not to match the number from the map (+1) :"
@@ -78,46 +95,37 @@ void QIEDecoder::produce(framework::Event &event) {
 
   ldmx_log(debug) << "Looking up input collection " << inputCollection_ << "_"
                   << inputPassName_;
-  const auto eventStream{
+  const auto &eventStream{
       event.getCollection<uint8_t>(inputCollection_, inputPassName_)};
   ldmx_log(debug) << "Got input collection" << inputCollection_ << "_"
                   << inputPassName_;
 
-  uint32_t timeEpoch = 0;
-  // these don't have to be in any particular order, position is anyway looked
-  // up from definition in header
-  for (int iW = 0; iW < QIEStream::TIMESTAMP_LEN_BYTES; iW++) {
-    int pos = QIEStream::TIMESTAMP_POS + iW;
-    uint8_t timeWord = eventStream.at(pos);
-    ldmx_log(debug) << "time stamp word at position " << pos
-                    << " (with iW = " << iW
-                    << ") = " << std::bitset<8>(timeWord);
-    timeEpoch |= (timeWord << iW * 8);  // shift by a byte at a time
-  }
-
-  uint32_t timeClock = 0;
-  for (int iW = 0; iW < QIEStream::TIMESTAMPCLOCK_LEN_BYTES; iW++) {
-    int pos = QIEStream::TIMESTAMPCLOCK_POS + iW;
-    uint8_t timeWord = eventStream.at(pos);
-    ldmx_log(debug) << "time stamp ns word at position " << pos
-                    << " (with iW = " << iW
-                    << ") = " << std::bitset<8>(timeWord);
-    timeClock |= (timeWord << iW * 8);  // shift by a byte at a time
+  // the header ends with the error word or the trigger ID
+  int iWstart =
+      std::max(std::max(QIEStream::ERROR_POS, QIEStream::CHECKSUM_POS),
+               QIEStream::TRIGID_POS + (QIEStream::TRIGID_LEN_BYTES)) +
+      1;  // make sure we're at end of header
+  int nWords =
+      nSamp * nChannels_ * 2 + iWstart;  // 1 ADC, 1 TDC per channel per sample,
+                                         // + the words in the header
+  if (eventStream.size() < static_cast<std::size_t>(nWords)) {
+    EXCEPTION_RAISE("BadStream",
+                    "The QIE stream has " + std::to_string(eventStream.size()) +
+                        " words, the header and " + std::to_string(nSamp) +
+                        " samples of " + std::to_string(nChannels_) +
+                        " channels need " + std::to_string(nWords) + ".");
   }
+  // the stream is read in place
+  const uint8_t *stream{eventStream.data()};
 
-  uint32_t timeSpill = 0;
-  ldmx_log(debug) << "Before starting, timeSpill = " << timeSpill << " ("
-                  << std::bitset<64>(timeSpill) << ", or, " << std::hex
-                  << timeSpill << std::dec << ") counts since start of spill";
-
-  for (int iW = 0; iW < QIEStream::TIMESINCESPILL_LEN_BYTES; iW++) {
-    int pos = QIEStream::TIMESINCESPILL_POS + iW;
-    uint8_t timeWord = eventStream.at(pos);
-    ldmx_log(debug) << "time since spill word at position " << pos
-                    << " (with iW = " << iW
-                    << ") = " << std::bitset<8>(timeWord);
-    timeSpill |= (timeWord << iW * 8);  // shift by a byte at a time
-  }
+  // these don't have to be in any particular order, position is anyway looked
+  // up from definition in header
+  uint32_t timeEpoch = readWord(stream, QIEStream::TIMESTAMP_POS,
+                                QIEStream::TIMESTAMP_LEN_BYTES);
+  uint32_t timeClock = readWord(stream, QIEStream::TIMESTAMPCLOCK_POS,
+                                QIEStream::TIMESTAMPCLOCK_LEN_BYTES);
+  uint32_t timeSpill = readWord(stream, QIEStream::TIMESINCESPILL_POS,
+                                QIEStream::TIMESINCESPILL_LEN_BYTES);
   ldmx_log(debug) << "time stamp words are : " << timeEpoch << " ("
                   << std::bitset<64>(timeEpoch) << ") and " << timeClock << " ("
                   << std::bitset<64>(timeClock) << ") clock ticks, and "
@@ -137,22 +145,14 @@ void QIEDecoder::produce(framework::Event &event) {
   event.getEventHeader().setIntParameter("timeSinceSpill", timeSpill);
   //  event.getEventHeader().setTimeSinceSpill(timeSpill); //not working
 
-  TTimeStamp *timeStamp = new TTimeStamp(timeEpoch);
-  //  timeStamp->SetNanoSec(timeClock); //not sure about this one...
-  event.getEventHeader().setTimestamp(*timeStamp);
+  TTimeStamp timeStamp(timeEpoch);
+  //  timeStamp.SetNanoSec(timeClock); //not sure about this one...
+  event.getEventHeader().setTimestamp(timeStamp);
 
   // trigger ID event number
-  uint32_t triggerID = 0;
-
-  for (int iW = 0; iW < QIEStream::TRIGID_LEN_BYTES; iW++) {
-    // assume the whole 3B are written as a single 24 bits word
-    int pos = QIEStream::TRIGID_POS + iW;
-    uint8_t tIDword = eventStream.at(pos);
-    ldmx_log(debug) << "trigger word at position " << pos
-                    << " (with iW = " << iW
-                    << ") = " << std::bitset<8>(tIDword);
-    triggerID |= (tIDword << iW * 8);  // shift by a byte at a time
-  }
+  // assume the whole 3B are written as a single 24 bits word
+  uint32_t triggerID =
+      readWord(stream, QIEStream::TRIGID_POS, QIEStream::TRIGID_LEN_BYTES);
 
   //  ldmx_log(debug) << " got triggerID " << std::bitset<16>(triggerID) ;
   //  //eventStream.at(0);
@@ -177,7 +177,7 @@ void QIEDecoder::produce(framework::Event &event) {
          - isCRC0malformed : if there was an issue with CRC from fiber0
          - isCRC1malformed : if there was an issue with CRC from fiber1
   */
-  uint8_t flags = eventStream.at(QIEStream::ERROR_POS);
+  uint8_t flags = stream[QIEStream::ERROR_POS];
 
   bool isCIDskipped{(flags >> QIEStream::CID_SKIP_POS) &
                     mask8<QIEStream::FLAG_SIZE_BITS>::m};
@@ -201,98 +201,63 @@ void QIEDecoder::produce(framework::Event &event) {
   if (isCIDskipped) ldmx_log(fatal) << "Found skipped CIDs!";
 
   /* -- TS event header done; read the channel contents -- */
-  std::vector<trigscint::TrigScintQIEDigis> outDigis;
-  std::map<int, std::vector<int>> ADCmap;
-  std::map<int, std::vector<int>> TDCmap;
-
-  // read in words from the stream. line them up per channel and time sample.
+  // the samples of each channel are contiguous in these arrays
   // channels are in the electronics ordering
-  int iWstart =
-      std::max(std::max(QIEStream::ERROR_POS, QIEStream::CHECKSUM_POS),
-               QIEStream::TRIGID_POS + (QIEStream::TRIGID_LEN_BYTES)) +
-      1;  // make sure we're at end of header
-  int nWords =
-      nSamp * nChannels_ * 2 + iWstart;  // 1 ADC, 1 TDC per channel per sample,
-                                         // + the words in the header
-  int iWord = iWstart;
+  adcs_.assign(nChannels_ * nSamp, 0);
+  tdcs_.assign(nChannels_ * nSamp, 0);
+  hasADC_.assign(nChannels_, false);
+  hasTDC_.assign(nChannels_, false);
+
+  // each sample is the ADCs of all channels followed by their TDCs
   ldmx_log(debug) << "Event parsing starts at vector idx " << iWstart
                   << " and nWords = " << nWords;
-  // outer loop: over nSamples
-  // inner loop over nChannels to get ADCs, then repeat to get TDCs
   for (int iS = 0; iS < nSamp; iS++) {
+    const uint8_t *adcWords{stream + iWstart + iS * 2 * nChannels_};
+    const uint8_t *tdcWords{adcWords + nChannels_};
     for (int iQ = 0; iQ < nChannels_; iQ++) {
-      if (iWord >= nWords) {
-        ldmx_log(fatal)
-            << "More words than expected! Breaking ADC loop in sample " << iS
-            << " at iQ = " << iQ;
-        break;
-      }
-      uint8_t val = eventStream.at(iWord);
-      if (val > 0) {  // add only the digis with non-zero ADC value
-        ldmx_log(debug) << "got ADC value " << (unsigned)val
-                        << " at channel (elec) idx " << iQ;
-        if (ADCmap.find(iQ) == ADCmap.end()) {  // we have a new channel
-          std::vector<int> adcs(nSamp, 0);
-          ADCmap.insert(std::pair<int, std::vector<int>>(iQ, adcs));
-        }
-        ADCmap[iQ].at(iS) = val;
-      }
-      iWord++;
-    }
-    for (int iQ = 0; iQ < nChannels_; iQ++) {
-      if (iWord >= nWords) {
-        ldmx_log(debug)
-            << "More words than expected! Breaking TDC loop in sample " << iS
-            << " at iQ = " << iQ;
-        break;
-      }
-      uint8_t val = eventStream.at(iWord);
-      if (val > 0) {  // TODO: check if this channel is also present in ADC map?
-                      // in the end?
-        ldmx_log(debug) << "got TDC value " << (unsigned)val
-                        << " at channel (elec) idx " << iQ;
-        ;
-        if (TDCmap.find(iQ) == TDCmap.end()) {  // we have a new channel
-          std::vector<int> tdcs(nSamp, 0);
-          TDCmap.insert(std::pair<int, std::vector<int>>(iQ, tdcs));
-        }
+      uint8_t adc = adcWords[iQ];
+      adcs_[iQ * nSamp + iS] = adc;
+      // add only the digis with non-zero ADC value
+      hasADC_[iQ] = hasADC_[iQ] or adc > 0;
+      uint8_t tdc = tdcWords[iQ];
+      if (tdc > 0) {
         // this is LETDC; only the two most significant bits included
         // they are shipped as least significant bits --> shift them
-        TDCmap[iQ].at(iS) = (val + 1) * 16;  // want LE TDC = 3 to correspond to
-                                             // 64 > 49 (which is maxTDC in sim)
+        tdcs_[iQ * nSamp + iS] = (tdc + 1) * 16;  // want LE TDC = 3 to
+                                                  // correspond to 64 > 49
+                                                  // (which is maxTDC in sim)
+        hasTDC_[iQ] = true;
       }
-      iWord++;
     }
-    ldmx_log(debug) << "Done with sample " << iS;
   }
 
   ldmx_log(debug) << "Done reading in header, ADC and TDC for event "
                   << (unsigned)triggerID;
-  for (std::map<int, std::vector<int>>::iterator itr = ADCmap.begin();
-       itr != ADCmap.end(); ++itr) {
-    TrigScintQIEDigis digi;
-    digi.setADC(itr->second);
-    if (channelMap_.find(itr->first) == channelMap_.end()) {
+  std::vector<trigscint::TrigScintQIEDigis> outDigis;
+  for (int iQ = 0; iQ < nChannels_; iQ++) {
+    if (not hasADC_[iQ]) continue;
+    int bar = barIDs_[iQ];
+    if (bar < 0) {
       ldmx_log(fatal)
-          << "Couldn't find the bar ID corresponding to electronics ID "
-          << itr->first << "!! Skipping.";
+          << "Couldn't find the bar ID corresponding to electronics ID " << iQ
+          << "!! Skipping.";
       continue;
     }
-    int bar = channelMap_[itr->first];
-    digi.setElecID(itr->first);
+    TrigScintQIEDigis &digi{outDigis.emplace_back()};
+    auto adcs{adcs_.begin() + iQ * nSamp};
+    digi.setADC(std::vector<int>(adcs, adcs + nSamp));
+    digi.setElecID(iQ);
     digi.setChanID(bar);
-    digi.setTDC(TDCmap[itr->first]);
+    // channels without any TDC get an empty list, as they always have
+    if (hasTDC_[iQ]) {
+      auto tdcs{tdcs_.begin() + iQ * nSamp};
+      digi.setTDC(std::vector<int>(tdcs, tdcs + nSamp));
+    } else {
+      digi.setTDC({});
+    }
     digi.setTimeSinceSpill(timeSpill);
-    if (bar == 0)
-      ldmx_log(debug) << "for bar 0, got time since spill "
-                      << digi.getTimeSinceSpill();
-    outDigis.push_back(digi);
-    ldmx_log(debug) << "Iterator points to key " << itr->first
-                    << " and mapped channel supposedly  is " << bar;
     ldmx_log(debug) << "Made digi with elecID = " << digi.getElecID()
-                    << ", barID = " << digi.getChanID() << ", third adc value "
-                    << digi.getADC().at(2) << " and third tdc "
-                    << digi.getTDC().at(2);
+                    << ", barID = " << digi.getChanID();
   }
 
   event.add(outputCollection_, outDigis);
@@ -5,6 +5,7 @@
 
 #include "TrigScint/QIEInputPulse.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -15,6 +16,18 @@ void QIEInputPulse::AddPulse(float toff, float ampl) {
   ampl_.push_back(ampl);
 }
 
+void QIEInputPulse::Clear() {
+  toff_.clear();
+  ampl_.clear();
+}
+
+float QIEInputPulse::CrossingTime(float T1, float T2, float thr) {
+  for (float tt = T1; tt < T2; tt += 0.1) {
+    if (Eval(tt) >= thr) return tt;
+  }
+  return T2;
+}
+
 float QIEInputPulse::Eval(float T) {
   if (ampl_.size() == 0) return 0;
   float val = 0;
@@ -166,6 +179,45 @@ float Expo::Derivative(float T, int id) {
   return (-nc * k_ * (1 - exp(-k_ * tmax_)) * exp(k_ * (tmax_ - t)));
 }
 
+float Expo::CrossingTime(float T1, float T2, float thr) {
+  // the pulse train changes shape where a pulse starts or peaks
+  std::vector<float> edges{T1, T2};
+  for (int id = 0; id < ampl_.size(); id++) {
+    if (ampl_[id] == 0) continue;
+    for (float edge : {toff_[id], toff_[id] + tmax_}) {
+      if (edge > T1 && edge < T2) edges.push_back(edge);
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+
+  for (int i = 0; i + 1 < edges.size(); i++) {
+    float s = edges[i];
+    float e = edges[i + 1];
+    if (e <= s) continue;
+    // pulse train = a + b*exp(-k*(t-s)) within [s, e]
+    double a = 0;
+    double b = 0;
+    for (int id = 0; id < ampl_.size(); id++) {
+      if (ampl_[id] == 0 || toff_[id] >= e) continue;
+      double nc = ampl_[id] / tmax_;
+      double t = s - toff_[id];  // time relative to the offset
+      // the middle of the interval tells if the pulse is rising in it
+      if (0.5 * (s + e) - toff_[id] < tmax_) {
+        a += nc;
+        b -= nc * exp(-k_ * t);
+      } else {
+        b += nc * (1 - exp(-k_ * tmax_)) * exp(k_ * (tmax_ - t));
+      }
+    }
+    if (a + b >= thr) return s;
+    double end = a + b * exp(-k_ * (e - s));
+    if (end < thr) continue;
+    // rising through the threshold
+    return s - log((thr - a) / b) / k_;
+  }
+  return T2;
+}
+
 float Expo::I_Int(float T, int id) {
   if (T <= toff_[id]) return 0;
   float t = T - toff_[id];
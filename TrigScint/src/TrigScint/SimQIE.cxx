@@ -49,23 +49,11 @@ int SimQIE::Q2ADC(float Charge) {
 }
 
 // Function to convert ADCs back to charge
-// The method checks to which QIE subrange does the ADC correspnd to
-// and returns the mean charge of the correspnding bin in the subrange
+// The mean charge of the bin of each ADC is tabulated in charges_
 float SimQIE::ADC2Q(int ADC) {
   if (ADC <= 0) return -16;
   if (ADC >= 255) return 350000;
-
-  int rr = ADC / 64;  // range
-  int v1 = ADC % 64;  // temp. var
-  int ss = 0;         // sub range
-
-  for (int i = 1; i < 4; i++) {  // to get the subrange
-    if (v1 > nbins_[i]) ss++;
-  }
-  int cc = 64 * rr + nbins_[ss];
-  float temp = edges_[4 * rr + ss] + (v1 - nbins_[ss]) * sense_[4 * rr + ss] +
-               sense_[4 * rr + ss] / 2;
-  return (temp / gain_);
+  return (charges_[ADC] / gain_);
 }
 
 // Function to return the quantization error for given input charge
@@ -102,9 +90,8 @@ std::vector<int> SimQIE::Out_ADC(QIEInputPulse* pp) {
 int SimQIE::TDC(QIEInputPulse* pp, float T0 = 0) {
   float thr2 = tdc_thr_ / gain_;
   if (pp->Eval(T0) > thr2) return 62;  // when pulse starts high
-  for (float tt = T0; tt < T0 + tau_; tt += 0.1) {
-    if (pp->Eval(tt) >= thr2) return ((int)(2 * (tt - T0)));
-  }
+  float tt = pp->CrossingTime(T0, T0 + tau_, thr2);
+  if (tt < T0 + tau_) return ((int)(2 * (tt - T0)));
   return 63;  // when pulse remains low all along
 }
 
@@ -138,12 +125,7 @@ bool SimQIE::PulseCut(QIEInputPulse* pulse, float cut) {
 
   // Only keep the pulse if it produces 1 PE (or whatever the cutoff is set to)
   // integrate over entire pulse so we catch also single-PE pulses
-  float integral = 0;
-  for (int i = 0; i < maxts_; i++) {
-    //    if (pulse->Integrate(i * tau_, i * tau_ + tau_) >= thr_in_pes) return
-    //    true;
-    integral += pulse->Integrate(i * tau_, i * tau_ + tau_);
-  }
+  float integral = pulse->Integrate(0, maxts_ * tau_);
   if (integral >= cut) return true;
 
   return false;
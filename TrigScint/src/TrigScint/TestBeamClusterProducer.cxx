@@ -137,17 +137,16 @@ void TestBeamClusterProducer::produce(framework::Event &event) {
       // first check if there is a (pure) noise hit at this channel,  and
       // replace it in that case. this is a protection against a problem that
       // shouldn't be there in the first place.
-      if (doDuplicate && hitChannelMap_.find((ID)) != hitChannelMap_.end()) {
+      if (doDuplicate && hits_.has(ID)) {
         int idx = ID;
-        std::map<int, int>::iterator itr = hitChannelMap_.find(idx);
-        double oldVal = digis.at(itr->second).getPE();
+        double oldVal = digis.at(hits_.hit(idx)).getPE();
         if (verbose_) {
           ldmx_log(debug) << "Got duplicate digis for channel " << idx
                           << ", with already inserted value " << oldVal
                           << " and new " << digi.getPE();
         }
         if (digi.getPE() > oldVal) {
-          hitChannelMap_.erase(itr->first);
+          hits_.erase(idx);
           if (verbose_) {
             ldmx_log(debug)
                 << "Skipped duplicate digi with smaller value for channel "
@@ -159,7 +158,7 @@ void TestBeamClusterProducer::produce(framework::Event &event) {
       // don't add in late hits
       if (digi.getTime() > padTime_ + timeTolerance_) continue;
 
-      hitChannelMap_.insert(std::pair<int, int>(ID, iDigi));
+      hits_.insert(ID, iDigi);
       // the channel number is the key, the digi list index is the value
 
       if (verbose_) {
@@ -174,107 +173,74 @@ void TestBeamClusterProducer::produce(framework::Event &event) {
 
   // 2. now step through all the channels in the map and cluster the hits
 
-  std::map<int, int>::iterator itr;
-
   // Create the container to hold the digitized trigger scintillator hits.
   std::vector<ldmx::TrigScintCluster> trigScintClusters;
 
   // loop over channels
-  for (itr = hitChannelMap_.begin(); itr != hitChannelMap_.end(); ++itr) {
-    // this hit may have disappeared
-    if (hitChannelMap_.find(itr->first) == hitChannelMap_.end()) {
+  for (int channel = 0; channel < hits_.size(); channel++) {
+    if (!hits_.has(channel)) continue;
+
+    // the hits added to a cluster are flagged as used rather than removed
+    if (hits_.used(channel)) {
       if (verbose_ > 1) {
-        ldmx_log(debug) << "Attempting to use removed hit at channel "
-                        << itr->first << "; skipping.";
+        ldmx_log(warn) << "Attempting to re-use hit at channel " << channel
+                       << "; skipping.";
       }
       continue;
     }
-
-    // i don't like this but for now, erasing elements in the map leads, as it
-    // turns out, to edge cases where i miss out on hits or run into
-    // non-existing indices. so while what i do below means that i don't need to
-    // erase hits, i'd rather find a way to do that and skip this book keeping:
-    bool hasUsed = false;
-    for (const auto &index : v_usedIndices_) {
-      if (index == itr->first) {
-        if (verbose_ > 1) {
-          ldmx_log(warn) << "Attempting to re-use hit at channel " << itr->first
-                         << "; skipping.";
-        }
-        hasUsed = true;
-      }
-    }
-    if (hasUsed) continue;
     if (verbose_ > 1) {
-      ldmx_log(debug) << "\t At hit with channel nb " << itr->first << ".";
-    }
-
-    if (hitChannelMap_.size() ==
-        0)  // we removed them all..? shouldn't ever happen
-    {
-      if (verbose_)
-        ldmx_log(warn) << "Time flies, and all clusters have already been "
-                          "removed! Unclear how we even got here; interfering "
-                          "here to get out of the loop. ";
-      break;
+      ldmx_log(debug) << "\t At hit with channel nb " << channel << ".";
     }
 
-    trigscint::TestBeamHit digi = (trigscint::TestBeamHit)digis.at(itr->second);
+    trigscint::TestBeamHit digi =
+        (trigscint::TestBeamHit)digis.at(hits_.hit(channel));
 
     // skip all until hit a seed
     if (digi.getPE() >= seed_) {
       if (verbose_ > 1) {
-        ldmx_log(debug) << "Seeding cluster with channel " << itr->first
+        ldmx_log(debug) << "Seeding cluster with channel " << channel
                         << "; content " << digi.getPE();
       }
 
       // 1.  add seeding hit to cluster
 
-      addHit(itr->first, digi);
+      addHit(channel, digi);
 
       if (verbose_ > 1) {
         ldmx_log(debug) << "\t itr is pointing at hit with channel nb "
-                        << itr->first << ".";
+                        << channel << ".";
       }
 
       // ----- first look back one step
 
       // we have added the hit from the neighbouring channel to the list only if
       // it's above clustering threshold so no check needed now
-      std::map<int, int>::iterator itrBack =
-          hitChannelMap_.find(itr->first - 1);
-
       bool hasBacked = false;
 
-      if (itrBack !=
-          hitChannelMap_.end()) {  // there is an entry for the previous
-                                   // channel, so it had content above threshold
+      if (hits_.has(channel - 1)) {  // there is an entry for the previous
+                                     // channel, so it had content above
+                                     // threshold
         // but it wasn't enough to seed a cluster. so, unambiguous that it
         // should be added here because it's its only chance to get in.
 
         // need to check again for backwards hits
-        hasUsed = false;
-        for (const auto &index : v_usedIndices_) {
-          if (index == itrBack->first) {
-            if (verbose_ > 1) {
-              ldmx_log(warn) << "Attempting to re-use hit at channel "
-                             << itrBack->first << "; skipping.";
-            }
-            hasUsed = true;
+        if (hits_.used(channel - 1)) {
+          if (verbose_ > 1) {
+            ldmx_log(warn) << "Attempting to re-use hit at channel "
+                           << channel - 1 << "; skipping.";
           }
-        }
-        if (!hasUsed) {
-          digi = (trigscint::TestBeamHit)digis.at(itrBack->second);
+        } else {
+          digi = (trigscint::TestBeamHit)digis.at(hits_.hit(channel - 1));
 
           // 2. add seed-1 to cluster
-          addHit(itrBack->first, digi);
+          addHit(channel - 1, digi);
           hasBacked = true;
 
           if (verbose_ > 1) {
-            ldmx_log(debug) << "Added -1 channel " << itrBack->first
+            ldmx_log(debug) << "Added -1 channel " << channel - 1
                             << " to cluster; content " << digi.getPE();
             ldmx_log(debug) << "\t itr is pointing at hit with channel nb "
-                            << itr->first << ".";
+                            << channel << ".";
           }
 
         }  // if seed-1 wasn't used already
@@ -290,48 +256,42 @@ void TestBeamClusterProducer::produce(framework::Event &event) {
       // --- now, step 3, 4: look ahead 1 step from seed
 
       if (v_addedIndices_.size() < maxWidth_) {
-        // (in principle these don't need to be different iterators, but it
-        // makes the logic easier to follow)
-        std::map<int, int>::iterator itrNeighb =
-            hitChannelMap_.find(itr->first + 1);
-        if (itrNeighb !=
-            hitChannelMap_.end()) {  // there is an entry for the next channel,
-                                     // so it had content above threshold
+        if (hits_.has(channel + 1)) {  // there is an entry for the next
+                                       // channel, so it had content above
+                                       // threshold
           // seed+1 exists
           // check if there is sth in position seed+2
-          if (hitChannelMap_.find(itrNeighb->first + 1) !=
-              hitChannelMap_.end()) {  // a hit with that key exists, so seed+1
-                                       // and seed+2 exist
+          if (hits_.has(channel + 2)) {  // a hit with that key exists, so
+                                         // seed+1 and seed+2 exist
             if (!hasBacked) {  // there is no seed-1 in the cluster. room for at
                                // least seed+1, and for seed+2 only if there is
                                // no seed+3
               // 3b
-              digi = (trigscint::TestBeamHit)digis.at(itrNeighb->second);
-              addHit(itrNeighb->first, digi);
+              digi = (trigscint::TestBeamHit)digis.at(hits_.hit(channel + 1));
+              addHit(channel + 1, digi);
 
               if (verbose_ > 1) {
                 ldmx_log(debug)
-                    << "No -1 hit. Added +1 channel " << itrNeighb->first
+                    << "No -1 hit. Added +1 channel " << channel + 1
                     << " to cluster; content " << digi.getPE();
                 ldmx_log(debug) << "\t itr is pointing at hit with channel nb "
-                                << itr->first << ".";
+                                << channel << ".";
               }
 
               if (v_addedIndices_.size() < maxWidth_) {
-                if (hitChannelMap_.find(itrNeighb->first + 2) ==
-                    hitChannelMap_
-                        .end()) {  // no seed+3. also no seed-1. so add seed+2
+                if (!hits_.has(channel + 3)) {  // no seed+3. also no seed-1.
+                                                // so add seed+2
                   // 3d.  add seed+2 to the cluster
-                  itrNeighb = hitChannelMap_.find(itr->first + 2);
-                  digi = (trigscint::TestBeamHit)digis.at(itrNeighb->second);
-                  addHit(itrNeighb->first, digi);
+                  digi =
+                      (trigscint::TestBeamHit)digis.at(hits_.hit(channel + 2));
+                  addHit(channel + 2, digi);
                   if (verbose_ > 1) {
                     ldmx_log(debug)
-                        << "No +3 hit. Added +2 channel " << itrNeighb->first
+                        << "No +3 hit. Added +2 channel " << channel + 2
                         << " to cluster; content " << digi.getPE();
                     ldmx_log(debug)
                         << "\t itr is pointing at hit with channel nb "
-                        << itr->first << ".";
+                        << channel << ".";
                   }
                 }
 
@@ -339,17 +299,16 @@ void TestBeamClusterProducer::produce(framework::Event &event) {
             }     // if seed-1 wasn't added
           }       // if seed+2 exists. then already added seed+1.
           else {  // so: if not, then we need to add seed+1 here. (step 4)
-            digi = (trigscint::TestBeamHit)digis.at(
-                itrNeighb->second);  // itrNeighb hasn't moved since there was
-                                     // no seed+2
-            addHit(itrNeighb->first, digi);
+            // there was no seed+2
+            digi = (trigscint::TestBeamHit)digis.at(hits_.hit(channel + 1));
+            addHit(channel + 1, digi);
 
             if (verbose_ > 1) {
               ldmx_log(debug)
-                  << "Added +1 channel " << itrNeighb->first
+                  << "Added +1 channel " << channel + 1
                   << " as last channel to cluster; content " << digi.getPE();
               ldmx_log(debug) << "\t itr is pointing at hit with channel nb "
-                              << itr->first << ".";
+                              << channel << ".";
             }
           }
         }  // if seed+1 exists
@@ -357,21 +316,19 @@ void TestBeamClusterProducer::produce(framework::Event &event) {
         // we can afford to walk back one more step and add whatever junk was
         // there (we know it's not a seed)
         else if (hasBacked &&
-                 hitChannelMap_.find(itrBack->first - 1) !=
-                     hitChannelMap_
-                         .end()) {  // seed-1 has been added, but not seed+1,
-                                    // and there is a hit in seed-2
-          itrBack = hitChannelMap_.find(itr->first - 2);
-          digi = (trigscint::TestBeamHit)digis.at(itrBack->second);
-          addHit(itrBack->first, digi);
+                 hits_.has(channel - 2)) {  // seed-1 has been added, but not
+                                            // seed+1, and there is a hit in
+                                            // seed-2
+          digi = (trigscint::TestBeamHit)digis.at(hits_.hit(channel - 2));
+          addHit(channel - 2, digi);
 
           if (verbose_ > 1) {
-            ldmx_log(debug) << "Added -2 channel " << itrBack->first
+            ldmx_log(debug) << "Added -2 channel " << channel - 2
                             << " to cluster; content " << digi.getPE();
           }
           if (verbose_ > 1) {
             ldmx_log(debug) << "\t itr is pointing at hit with channel nb "
-                            << itr->first << ".";
+                            << channel << ".";
           }
 
         }  // check if add in seed -2
@@ -412,25 +369,17 @@ void TestBeamClusterProducer::produce(framework::Event &event) {
       if (verbose_ > 1) {
         ldmx_log(debug)
             << "\t Finished processing of seeding hit with channel nb "
-            << itr->first << ".";
+            << channel << ".";
       }
 
     }  // if content enough to seed a cluster
 
-    if (hitChannelMap_.begin() == hitChannelMap_.end()) {
-      if (verbose_)
-        ldmx_log(warn) << "Time flies, and all clusters have already been "
-                          "removed! Interfering here to get out of the loop. ";
-      break;
-    }
   }  // over channels
 
   if (trigScintClusters.size() > 0)
     event.add(output_collection_, trigScintClusters);
 
-  hitChannelMap_.clear();
-  v_usedIndices_.resize(
-      0);  // book keep which channels have already been added to a cluster
+  hits_.clear();
 
   return;
 }
@@ -451,15 +400,7 @@ void TestBeamClusterProducer::addHit(uint idx, trigscint::TestBeamHit hit) {
     time_ += hit.getTime() * ampl;
   }
 
-  v_usedIndices_.push_back(idx);
-  /*    // not working properly, but i'd prefer this type of solution
-        hitChannelMap_.erase( idx ) ;
-        if (verbose_ > 1 ) {
-        ldmx_log(debug) << "Removed used hit " << idx << " from list";
-        }
-        if ( hitChannelMap_.find( idx) != hitChannelMap_.end() )
-        std::cerr << "----- WARNING! Hit still present in map after removal!! ";
-  */
+  hits_.use(idx);
   if (verbose_ > 1) {
     ldmx_log(debug) << "   In addHit, adding hit at " << idx
                     << " with amplitude " << ampl
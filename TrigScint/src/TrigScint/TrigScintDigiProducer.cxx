@@ -31,6 +31,10 @@ void TrigScintDigiProducer::configure(
 
   noiseGenerator_ = std::make_unique<ldmx::NoiseGenerator>(meanNoise_, false);
   noiseGenerator_->setNoiseThreshold(1);
+
+  std::vector<unsigned int> bars(stripsPerArray_);
+  for (int bar{0}; bar < stripsPerArray_; bar++) bars[bar] = bar;
+  noiseBars_ = std::make_unique<ldmx::EmptyChannelSampler>(std::move(bars));
 }
 
 ldmx::TrigScintID TrigScintDigiProducer::generateRandomID(int module) {
@@ -54,12 +58,7 @@ void TrigScintDigiProducer::produce(framework::Event &event) {
         rseed.getSeed("TrigScintDigiProducer::NoiseGenerator"));
   }
 
-  std::map<ldmx::TrigScintID, int> cellPEs;
-  std::map<ldmx::TrigScintID, int> cellMinPEs;
-  std::map<ldmx::TrigScintID, float> Xpos, Ypos, Zpos, Edep, Time, beamFrac;
-  std::set<ldmx::TrigScintID> noiseHitIDs;
-
-  auto numRecHits{0};
+  cells_.clear();
 
   // looper over sim hits and aggregate energy depositions for each detID
   const auto simHits{event.getCollection<ldmx::SimCalorimeterHit>(
@@ -80,7 +79,8 @@ void TrigScintDigiProducer::produce(framework::Event &event) {
       std::cout << id << std::endl;
     }
 
-    unsigned int detIDRaw = id.raw();
+    // a new cell starts at zero
+    Cell &cell{cells_[id]};
 
     // check if hits is from beam electron and, if so, add to beamFrac
     for (int i = 0; i < simHit.getNumberOfContribs(); i++) {
@@ -96,10 +96,7 @@ void TrigScintDigiProducer::produce(framework::Event &event) {
       }
       if (particleMap[contrib.trackID].getPdgID() == 11 &&
           particleMap[contrib.trackID].getGenStatus() == 1) {
-        if (beamFrac.find(id) == beamFrac.end())
-          beamFrac[id] = contrib.edep;
-        else
-          beamFrac[id] += contrib.edep;
+        cell.beamEdep += contrib.edep;
       }
     }
 
@@ -107,95 +104,81 @@ void TrigScintDigiProducer::produce(framework::Event &event) {
     // simulate the hit position. AJW: these should be dropped, they are likely
     // to lead to a problem since we can't measure them anyway except roughly y
     // and z, which is encoded in the ids.
-    if (Edep.find(id) == Edep.end()) {
-      // first hit, initialize
-      Edep[id] = simHit.getEdep();
-      Time[id] = simHit.getTime() * simHit.getEdep();
-      Xpos[id] = position[0] * simHit.getEdep();
-      Ypos[id] = position[1] * simHit.getEdep();
-      Zpos[id] = position[2] * simHit.getEdep();
-      numRecHits++;
-
-    } else {
-      // not first hit, aggregate, and store the largest radius hit
-      Xpos[id] += position[0] * simHit.getEdep();
-      Ypos[id] += position[1] * simHit.getEdep();
-      Zpos[id] += position[2] * simHit.getEdep();
-      Edep[id] += simHit.getEdep();
-      // AJW: need to figure out a better way to model this...
-      Time[id] += simHit.getTime() * simHit.getEdep();
-    }
+    cell.x += position[0] * simHit.getEdep();
+    cell.y += position[1] * simHit.getEdep();
+    cell.z += position[2] * simHit.getEdep();
+    cell.edep += simHit.getEdep();
+    // AJW: need to figure out a better way to model this...
+    cell.time += simHit.getTime() * simHit.getEdep();
   }
 
   // Create the container to hold the digitized trigger scintillator hits.
   std::vector<ldmx::TrigScintHit> trigScintHits;
 
-  // loop over detIDs and simulate number of PEs
-  int ihit = 0;
-  for (std::map<ldmx::TrigScintID, float>::iterator it = Edep.begin();
-       it != Edep.end(); ++it) {
-    ldmx::TrigScintID id(it->first);
-
-    double depEnergy = Edep[id];
-    Time[id] = Time[id] / Edep[id];
-    Xpos[id] = Xpos[id] / Edep[id];
-    Ypos[id] = Ypos[id] / Edep[id];
-    Zpos[id] = Zpos[id] / Edep[id];
+  // loop over detIDs and simulate number of PEs, in the order of the
+  // IDs so the same random numbers are drawn for the same bars
+  cells_.forEachSorted([&](ldmx::TrigScintID id, Cell &cell) {
+    double depEnergy = cell.edep;
+    cell.time = cell.time / cell.edep;
+    cell.x = cell.x / cell.edep;
+    cell.y = cell.y / cell.edep;
+    cell.z = cell.z / cell.edep;
     double meanPE = depEnergy / mevPerMip_ * pePerMip_;
-    cellPEs[id] = random_->Poisson(meanPE + meanNoise_);
+    int cellPEs = random_->Poisson(meanPE + meanNoise_);
 
     // If a cell has a PE count above threshold, persit the hit.
-    if (cellPEs[id] >= 1) {
+    if (cellPEs >= 1) {
       ldmx::TrigScintHit hit;
       hit.setID(id.raw());
-      hit.setPE(cellPEs[id]);
-      hit.setMinPE(cellMinPEs[id]);
-      hit.setAmplitude(cellPEs[id]);
+      hit.setPE(cellPEs);
+      hit.setMinPE(0);
+      hit.setAmplitude(cellPEs);
       hit.setEnergy(depEnergy);
-      hit.setTime(Time[id]);
-      hit.setXPos(Xpos[id]);
-      hit.setYPos(Ypos[id]);
-      hit.setZPos(Zpos[id]);
+      hit.setTime(cell.time);
+      hit.setXPos(cell.x);
+      hit.setYPos(cell.y);
+      hit.setZPos(cell.z);
       hit.setModuleID(module);
       hit.setBarID(id.bar());  // getFieldValue("bar"));
       hit.setNoise(false);
-      hit.setBeamEfrac(beamFrac[id] / depEnergy);
+      hit.setBeamEfrac(cell.beamEdep / depEnergy);
 
       trigScintHits.push_back(hit);
     }
 
     if (verbose_) {
       std::cout << id << std::endl;
-      std::cout << "Edep: " << Edep[id] << std::endl;
-      std::cout << "numPEs: " << cellPEs[id] << std::endl;
-      std::cout << "time: " << Time[id] << std::endl;
-      std::cout << "z: " << Zpos[id] << std::endl;
-      std::cout << "\t X: " << Xpos[id] << "\t Y: " << Ypos[id]
-                << "\t Z: " << Zpos[id] << std::endl;
+      std::cout << "Edep: " << cell.edep << std::endl;
+      std::cout << "numPEs: " << cellPEs << std::endl;
+      std::cout << "time: " << cell.time << std::endl;
+      std::cout << "z: " << cell.z << std::endl;
+      std::cout << "\t X: " << cell.x << "\t Y: " << cell.y
+                << "\t Z: " << cell.z << std::endl;
     }  // end verbose
-  }
+  });
 
   // ------------------------------- Noise simulation -----------------------//
   // ------------------------------------------------------------------------//
   int numEmptyCells = stripsPerArray_ -
-                      numRecHits;  // only simulating for single array until
+                      cells_.size();  // only simulating for single array until
                                    // all arrays are merged into one collection
   std::vector<double> noiseHits_PE =
       noiseGenerator_->generateNoiseHits(numEmptyCells);
 
-  ldmx::TrigScintID tempID;
-
-  for (auto &noiseHitPE : noiseHits_PE) {
+  // bars with a hit, then distinct empty bars drawn in one go
+  std::vector<unsigned int> filledBars;
+  filledBars.reserve(cells_.size());
+  cells_.forEach([&](ldmx::TrigScintID id, const Cell &) {
+    filledBars.push_back(id.bar());
+  });
+  const auto &noiseBars{
+      noiseBars_->sample(filledBars, noiseHits_PE.size(), *random_)};
+
+  for (std::size_t iNoise{0}; iNoise < noiseBars.size(); iNoise++) {
+    double noiseHitPE{noiseHits_PE[iNoise]};
     ldmx::TrigScintHit hit;
-    // generate random ID from remaining cells
-    do {
-      tempID = generateRandomID(module);
-    } while (Edep.find(tempID) != Edep.end() ||
-             noiseHitIDs.find(tempID) != noiseHitIDs.end());
-
-    ldmx::TrigScintID noiseID = tempID;
+    ldmx::TrigScintID noiseID(module, noiseBars[iNoise]);
 
-    noiseHitIDs.insert(noiseID);
     hit.setID(noiseID.raw());
     hit.setPE(noiseHitPE);
     hit.setMinPE(noiseHitPE);
@@ -215,7 +198,7 @@ void TrigScintDigiProducer::produce(framework::Event &event) {
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // - -
 
-  event.add(outputCollection_, trigScintHits);
+  event.add(outputCollection_, std::move(trigScintHits));
 }
 }  // namespace trigscint
 
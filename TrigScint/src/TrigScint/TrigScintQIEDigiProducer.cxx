@@ -72,8 +72,8 @@ void TrigScintQIEDigiProducer::produce(framework::Event& event) {
 
     // Initialize SimQIE instance with
     // pedestal, electronic noise and the random seed
-    smq_ = new SimQIE(pedestal_, elec_noise_,
-                      rseed2.getSeed(outputCollection_ + "SimQIE"));
+    smq_ = std::make_unique<SimQIE>(
+        pedestal_, elec_noise_, rseed2.getSeed(outputCollection_ + "SimQIE"));
 
     smq_->setGain(sipm_gain_);
     smq_->setFreq(s_freq_);
@@ -85,13 +85,11 @@ void TrigScintQIEDigiProducer::produce(framework::Event& event) {
   // Initialize with stripsPerArray_ zeros
   std::vector<float> TrueEdep(stripsPerArray_, 0.);
 
-  // Initialize with stripsPerArray_ nullptrs
-  std::vector<Expo*> ex(stripsPerArray_, nullptr);
-  for (int i = 0; i < stripsPerArray_; i++) {
-    // Set the pulse shape with fixed parameters given by config. file
-    ex[i] = new Expo(pulse_params_[0], pulse_params_[1]);
-    TrueEdep[i] = 0;
-  }
+  // Set the pulse shape with fixed parameters given by config. file
+  // on the first event and empty the pulses of the previous event after
+  if (pulses_.empty())
+    pulses_.resize(stripsPerArray_, Expo(pulse_params_[0], pulse_params_[1]));
+  for (auto& pulse : pulses_) pulse.Clear();
 
   // loop over sim hits and aggregate energy depositions for each detID
   const auto simHits{event.getCollection<ldmx::SimCalorimeterHit>(
@@ -110,7 +108,7 @@ void TrigScintQIEDigiProducer::produce(framework::Event& event) {
 
     // Adding a pulse for every sim hit recorded.
     // time offset = global offset+simhit time
-    ex[id.bar()]->AddPulse(toff_overall_ + simHit.getTime(), PulseAmp);
+    pulses_[id.bar()].AddPulse(toff_overall_ + simHit.getTime(), PulseAmp);
 
     // incrementing true energy deposited in appropriate bar.
     TrueEdep[id.bar()] += simHit.getEdep();
@@ -131,19 +129,20 @@ void TrigScintQIEDigiProducer::produce(framework::Event& event) {
     // due to thermal fluctuations.
     // Every e- thus generated, mimicks a Photo Electron.
     // Hence we will creat 1PE pulses for each electron generated.
+    Expo* pulse = &pulses_[bar_id];
     int n_noise_pulses = random_->Poisson(TotalNoise);
     for (int i = 0; i < n_noise_pulses; i++) {
-      ex[bar_id]->AddPulse(random_->Uniform(0, maxts_ * SamplingTime), 1);
+      pulse->AddPulse(random_->Uniform(0, maxts_ * SamplingTime), 1);
     }
 
     // Storing the "good" digis
-    if (smq_->PulseCut(ex[bar_id], zeroSuppCut_)) {
+    if (smq_->PulseCut(pulse, zeroSuppCut_)) {
       trigscint::TrigScintQIEDigis QIEInfo;
 
       QIEInfo.setChanID(bar_id);
-      QIEInfo.setADC(smq_->Out_ADC(ex[bar_id]));
-      QIEInfo.setTDC(smq_->Out_TDC(ex[bar_id]));
-      QIEInfo.setCID(smq_->CapID(ex[bar_id]));
+      QIEInfo.setADC(smq_->Out_ADC(pulse));
+      QIEInfo.setTDC(smq_->Out_TDC(pulse));
+      QIEInfo.setCID(smq_->CapID(pulse));
 
       QDigis.push_back(QIEInfo);
     }
@@ -1,7 +1,9 @@
 #include "TrigScint/TrigScintTrackProducer.h"
 
+#include <algorithm>
 #include <iterator>  // std::next
 #include <map>
+#include <numeric>   // std::iota
 
 namespace trigscint {
 
@@ -139,119 +141,107 @@ void TrigScintTrackProducer::produce(framework::Event &event) {
     // the dn pad immediately
     //	if (! clusters_pad2.size())
     // skipDn = true ;
+    indexPad(clusters_pad1, pad1_);
+    indexPad(clusters_pad2, pad2_);
+
+    // track candidates of a seed, as indices of the pad1 and pad2 (-1 if
+    // none) clusters, with their residual
+    std::vector<std::pair<int, int>> trackCandidates;
+    std::vector<float> residuals;
+
     for (const auto &seed : seeds) {
       // for each seed, search through the other two pads to match all clusters
       // with centroids within tolerance to tracks
       float centroid = seed.getCentroid();
 
-      std::vector<ldmx::TrigScintTrack> trackCandidates;
+      trackCandidates.clear();
+      residuals.clear();
 
       if (verbose_ > 1) {
         ldmx_log(debug) << "Got seed with centroid " << centroid;
       }
 
-      // reset for each seed
-      // bool madeTrack = false;
+      findMatches(seed, clusters_pad1, pad1_, matches1_);
+      findMatches(seed, clusters_pad2, pad2_, matches2_);
 
-      for (const auto &cluster1 : clusters_pad1) {
+      for (int idx1 : matches1_) {
+        const auto &cluster1{clusters_pad1[idx1]};
         if (verbose_ > 1) {
           ldmx_log(debug) << "\tGot pad1 cluster with centroid "
                           << cluster1.getCentroid();
         }
-        if (fabs(cluster1.getCentroid() - centroid) < maxDelta_ ||
-            (centroid >= vertBarStartIdx_  // then in vertical bars
-             && seed.getCentroidX() == cluster1.getCentroidX())) {
-          // use geometry y overlap scheme to see if this is really a match in x
-          // should be done in a map
+        // use geometry y overlap scheme to see if this is really a match in x
+        // should be done in a map
 
-          if (centroid >= vertBarStartIdx_ &&
-              seed.getCentroidY() < cluster1.getCentroidY()) {
-            // impossible combination
-            if (verbose_ > 1) {
-              ldmx_log(debug) << "\tSkipping impossible x cluster combination "
-                                 "with y flags (tag up) ("
-                              << seed.getCentroidY() << " "
-                              << cluster1.getCentroidY() << ")";
-            }
-            continue;
+        if (centroid >= vertBarStartIdx_ &&
+            seed.getCentroidY() < cluster1.getCentroidY()) {
+          // impossible combination
+          if (verbose_ > 1) {
+            ldmx_log(debug) << "\tSkipping impossible x cluster combination "
+                               "with y flags (tag up) ("
+                            << seed.getCentroidY() << " "
+                            << cluster1.getCentroidY() << ")";
           }
+          continue;
+        }
 
-          // else: first (possible) match! loop through next pad too
+        // else: first (possible) match! loop through next pad too
 
-          if (verbose_ > 1) {
-            ldmx_log(debug) << "\t\tIt is close enough!. Check pad2";
-          }
+        if (verbose_ > 1) {
+          ldmx_log(debug) << "\t\tIt is close enough!. Check pad2";
+        }
 
-          // try making third pad clusters an optional part of track
+        // try making third pad clusters an optional part of track
 
-          std::vector<ldmx::TrigScintCluster> clusterVec = {seed, cluster1};
+        bool hasMatchDn = false;
 
-          bool hasMatchDn = false;
+        for (int idx2 : matches2_) {
+          const auto &cluster2{clusters_pad2[idx2]};
+          if (verbose_ > 1) {
+            ldmx_log(debug) << "\tGot pad2 cluster with centroid "
+                            << cluster2.getCentroid();
+          }
 
-          for (const auto &cluster2 : clusters_pad2) {
+          // use geometry y overlap scheme to see if this is really a match
+          // in x
+          if (centroid >= vertBarStartIdx_ &&
+              (seed.getCentroidY() < cluster2.getCentroidY() ||
+               cluster1.getCentroidY() >
+                   cluster2.getCentroidY())) {  // impossible
             if (verbose_ > 1) {
-              ldmx_log(debug) << "\tGot pad2 cluster with centroid "
-                              << cluster2.getCentroid();
+              ldmx_log(debug)
+                  << "\tSkipping impossible x cluster combination with y "
+                     "flags (tag up dn) ("
+                  << seed.getCentroidY() << " " << cluster1.getCentroidY()
+                  << " " << cluster2.getCentroidY() << ")";
             }
-
-            if (fabs(cluster2.getCentroid() - centroid) < maxDelta_ ||
-                (centroid >= vertBarStartIdx_  // then in vertical bars
-                 && seed.getCentroidX() == cluster2.getCentroidX())) {
-              // use geometry y overlap scheme to see if this is really a match
-              // in x
-
-              if (centroid >= vertBarStartIdx_ &&
-                  (seed.getCentroidY() < cluster2.getCentroidY() ||
-                   cluster1.getCentroidY() >
-                       cluster2.getCentroidY())) {  // impossible
-                if (verbose_ > 1) {
-                  ldmx_log(debug)
-                      << "\tSkipping impossible x cluster combination with y "
-                         "flags (tag up dn) ("
-                      << seed.getCentroidY() << " " << cluster1.getCentroidY()
-                      << " " << cluster2.getCentroidY() << ")";
-                }
-                continue;
-              }
-
-              // first match! loop through next pad too
-
-              if (verbose_ > 1) {
-                ldmx_log(debug) << "\t\tIt is close enough!. Make a track";
-              }
-
-              // only make this vector now! this ensures against hanging
-              // clusters with indices from earlier in the loop
-              std::vector<ldmx::TrigScintCluster> threeClusterVec = {
-                  seed, cluster1, cluster2};
-
-              /*
-              // here we could break if we didn't want to allow all possible
-              combinations madeTrack=true; break; //we're done with this
-              iteration once there's a track made
-              */
-              // make a track
-              ldmx::TrigScintTrack track = makeTrack(threeClusterVec);
-              trackCandidates.push_back(track);
-              hasMatchDn = true;
-            }  // if match in pad2
-          }    // over clusters in pad2
-          // if there was no match to this in pad 2, make a track with just
-          // these two clusters
-          if (!hasMatchDn &&
-              skipLast_) {  // we allow skipping last pad if needed
-            ldmx::TrigScintTrack track = makeTrack(clusterVec);
-            trackCandidates.push_back(track);
+            continue;
           }
 
-        }  // if possible (x,)y match in pad1
-           /*
-   //same here
-   if (madeTrack)
-   break;
-   */
+          if (verbose_ > 1) {
+            ldmx_log(debug) << "\t\tIt is close enough!. Make a track";
+          }
 
-      }  // over clusters in pad1
+          // only the residual is needed to choose between the candidates, the
+          // track itself is made for the chosen one
+          std::vector<const ldmx::TrigScintCluster *> threeClusterVec = {
+              &seed, &cluster1, &cluster2};
+          trackCandidates.emplace_back(idx1, idx2);
+          residuals.push_back(trackResidual(
+              threeClusterVec, trackCentroid(threeClusterVec)));
+          hasMatchDn = true;
+        }  // over matching clusters in pad2
+        // if there was no match to this in pad 2, make a track with just
+        // these two clusters
+        if (!hasMatchDn &&
+            skipLast_) {  // we allow skipping last pad if needed
+          std::vector<const ldmx::TrigScintCluster *> clusterVec = {&seed,
+                                                                    &cluster1};
+          trackCandidates.emplace_back(idx1, -1);
+          residuals.push_back(
+              trackResidual(clusterVec, trackCentroid(clusterVec)));
+        }
+      }  // over matching clusters in pad1
 
       // continue to next seed if 0 track candidates
       if (trackCandidates.size() == 0) continue;
@@ -269,10 +259,9 @@ void TrigScintTrackProducer::produce(framework::Event &event) {
         }
 
         for (uint idx = 0; idx < trackCandidates.size(); idx++) {
-          if ((trackCandidates.at(idx)).getResidual() < minResidual) {
+          if (residuals[idx] < minResidual) {
             keepIdx = (int)idx;
-            minResidual =
-                (trackCandidates.at(idx)).getResidual();  // update minimum
+            minResidual = residuals[idx];  // update minimum
 
             if (verbose_ > 1) {
               ldmx_log(debug)
@@ -284,15 +273,19 @@ void TrigScintTrackProducer::produce(framework::Event &event) {
         }    // over track candidates
       }      // if more than 1 to choose from
 
-      // store the track at keepIdx, if there was one we made it this far and
-      // keepIdx is 0 or has been updated to the smallest residual track idx
-      //	if (keepIdx >= 0) {
-      tracks_.push_back(trackCandidates.at(keepIdx));
+      // make the track at keepIdx, keepIdx is 0 or has been updated to the
+      // smallest residual track idx
+      auto [idx1, idx2] = trackCandidates[keepIdx];
+      std::vector<const ldmx::TrigScintCluster *> clusterVec = {
+          &seed, &clusters_pad1[idx1]};
+      if (idx2 >= 0) clusterVec.push_back(&clusters_pad2[idx2]);
+      tracks_.push_back(makeTrack(clusterVec));
+      trackPad1_.push_back(idx1);
+      trackPad2_.push_back(idx2);
       if (verbose_) {
         ldmx_log(debug) << "Kept track at index " << keepIdx;
-        (trackCandidates.at(keepIdx)).Print();
+        tracks_.back().Print();
       }
-      //}
     }  // over seeds
 
     // done here if there were no tracks found
@@ -306,84 +299,15 @@ void TrigScintTrackProducer::produce(framework::Event &event) {
     }
     // now, if there are multiple seeds sharing the same downstream hits, this
     // should also be remedied with a selection on min residual.
-
-    // The logic of this loop kind of assumes I can remove tracks immediately --
-    // that way I can do pairwise checks between more tracks within a single
-    // loop. But for now I haven't figured out how to erase elements in a fool
-    // proof way. So I iterate over a vector...
-
     std::vector keepIndices(tracks_.size(), 1);
     if (verbose_ > 1)
       ldmx_log(debug) << "vector of indices to keep has size "
                       << keepIndices.size();
 
-    for (uint idx = tracks_.size() - 1; idx > 0; idx--) {
-      // since we start in one end, we only have to check matches in one
-      // direction
-      ldmx::TrigScintTrack track = tracks_.at(idx);
-      for (int idxComp = idx - 1; idxComp >= 0; idxComp--) {
-        if (verbose_ > 1)
-          ldmx_log(debug) << "In track disambiguation loop, idx points at "
-                          << idx << " and prev idx points at " << idxComp;
-
-        ldmx::TrigScintTrack nextTrack = tracks_.at(idxComp);
-
-        // no need to start pulling constituents from tracks that are
-        // ridiculously far apart
-        if (fabs(track.getCentroid() - nextTrack.getCentroid() <
-                 3 * maxDelta_)) {
-          std::vector<ldmx::TrigScintCluster> consts_1 =
-              track.getConstituents();
-          std::vector<ldmx::TrigScintCluster> consts_2 =
-              nextTrack.getConstituents();
-          if (verbose_ > 1)
-            ldmx_log(debug)
-                << "In track disambiguation loop, got the two tracks, "
-                   "with nConstituents "
-                << consts_1.size() << " and " << consts_2.size()
-                << ", respectively. ";
-          // let's do "if either cluster is shared" right now... but could also
-          // have it settable to use a stricter cut: an AND
-          if (consts_1[1].getCentroid() == consts_2[1].getCentroid() ||
-              (consts_1.size() > 2 && consts_2.size() > 2 &&
-               consts_1[2].getCentroid() ==
-                   consts_2[2]
-                       .getCentroid())) {  // we have overlap downstream of the
-            // seeding pad. probably, one cluster
-            // in seeding pad is noise
-
-            if (verbose_ > 1) {
-              ldmx_log(debug) << "Found overlap! Tracks at index " << idx
-                              << " and " << idxComp;
-              (tracks_.at(idx)).Print();
-              (tracks_.at(idxComp)).Print();
-            }
-
-            if ((tracks_.at(idx)).getResidual() <
-                (tracks_.at(idxComp)).getResidual()) {
-              // next track (lower index) is a worse choice, remove its flag for
-              // keeping
-              keepIndices.at(idxComp) = 0;
-            } else  // prefer next track over current. remove current track's
-                    // keep
-              // flag
-              keepIndices.at(idx) = 0;
-            /*}
-                  else {
-                  tracks_.erase(itNext);
-                  //        removeIdx.push_back(idx+1);
-                  // we might see the same index two times in the loop in this
-               case, if there are three seeds sharing the same clusters
-               downstream.
-                  // then the third only gets removed if it's even worse than
-               the second.
-                  // one could deal with this with an extra overlap check. not
-               sure we will be in this situation any time soon though.
-                  }*/
-          }  // over matching/overlapping tracks
-        }    // over tracks close enough to share constituents
-      }      // over constructed tracks at other indices, to match
-    }        // over constructed tracks
+    // let's do "if either cluster is shared" right now... but could also
+    // have it settable to use a stricter cut: an AND
+    resolveOverlaps(clusters_pad1, trackPad1_, keepIndices);
+    resolveOverlaps(clusters_pad2, trackPad2_, keepIndices);
 
     for (uint idx = 0; idx < tracks_.size(); idx++) {
       if (verbose_ > 1) {
@@ -471,31 +395,103 @@ void TrigScintTrackProducer::produce(framework::Event &event) {
   event.add(output_collection_ + "X", cleanedTracksX);
 
   tracks_.resize(0);
+  trackPad1_.clear();
+  trackPad2_.clear();
 
   return;
 }
 
+void TrigScintTrackProducer::indexPad(
+    const std::vector<ldmx::TrigScintCluster> &clusters,
+    PadIndex &index) const {
+  index.byCentroid.resize(clusters.size());
+  std::iota(index.byCentroid.begin(), index.byCentroid.end(), 0);
+  std::sort(index.byCentroid.begin(), index.byCentroid.end(),
+                   [&](int a, int b) {
+                     return clusters[a].getCentroid() <
+                            clusters[b].getCentroid();
+                   });
+  index.byX = index.byCentroid;
+  std::sort(index.byX.begin(), index.byX.end(), [&](int a, int b) {
+    return clusters[a].getCentroidX() < clusters[b].getCentroidX();
+  });
+}
+
+void TrigScintTrackProducer::findMatches(
+    const ldmx::TrigScintCluster &seed,
+    const std::vector<ldmx::TrigScintCluster> &clusters, const PadIndex &index,
+    std::vector<int> &matches) const {
+  matches.clear();
+  float centroid = seed.getCentroid();
+
+  // the clusters with a centroid within tolerance of the seed are contiguous
+  // when sorted by centroid
+  auto first = std::partition_point(
+      index.byCentroid.begin(), index.byCentroid.end(), [&](int idx) {
+        return clusters[idx].getCentroid() - centroid <= -maxDelta_;
+      });
+  for (auto it = first; it != index.byCentroid.end() &&
+                        clusters[*it].getCentroid() - centroid < maxDelta_;
+       ++it) {
+    matches.push_back(*it);
+  }
+
+  // in the vertical bars, clusters in the same column match as well
+  if (centroid >= vertBarStartIdx_) {
+    float x = seed.getCentroidX();
+    auto begin = std::partition_point(
+        index.byX.begin(), index.byX.end(),
+        [&](int idx) { return clusters[idx].getCentroidX() < x; });
+    auto end = std::partition_point(begin, index.byX.end(), [&](int idx) {
+      return clusters[idx].getCentroidX() <= x;
+    });
+    matches.insert(matches.end(), begin, end);
+  }
+
+  // keep the order of the collection, which decides between candidates with
+  // equal residuals
+  std::sort(matches.begin(), matches.end());
+  matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+}
+
+float TrigScintTrackProducer::trackCentroid(
+    const std::vector<const ldmx::TrigScintCluster *> &clusters) const {
+  float centroid = 0;
+  for (const auto *cluster : clusters) centroid += cluster->getCentroid();
+  centroid /= clusters.size();
+  return centroid;
+}
+
+float TrigScintTrackProducer::trackResidual(
+    const std::vector<const ldmx::TrigScintCluster *> &clusters,
+    float centroid) const {
+  float residual = 0;
+  for (const auto *cluster : clusters)
+    residual += (cluster->getCentroid() - centroid) *
+                (cluster->getCentroid() - centroid);
+  residual = sqrt(residual / clusters.size());
+  return residual;
+}
+
 ldmx::TrigScintTrack TrigScintTrackProducer::makeTrack(
-    std::vector<ldmx::TrigScintCluster> clusters) {
+    const std::vector<const ldmx::TrigScintCluster *> &clusters) {
   // for now let's keep a straight, unweighted centroid
   // consider the possibility that at least one cluster has a centroid
   // identically == 0. then we need to shift them by 1 if we want to do energy
   // weighted track centroid later. but no need now
   ldmx::TrigScintTrack tr;
-  float centroid = 0;
+  float centroid = trackCentroid(clusters);
   float centroidX = 0;
   float centroidY = 0;
   float beamEfrac = 0;
   float pe = 0;
   for (uint i = 0; i < clusters.size(); i++) {
-    centroid += (clusters.at(i)).getCentroid();
-    centroidX += (clusters.at(i)).getCentroidX();
-    centroidY += (clusters.at(i)).getCentroidY();
-    tr.addConstituent(clusters.at(i));
-    beamEfrac += (clusters.at(i)).getBeamEfrac();
-    pe += (clusters.at(i)).getPE();
+    centroidX += clusters.at(i)->getCentroidX();
+    centroidY += clusters.at(i)->getCentroidY();
+    tr.addConstituent(*clusters.at(i));
+    beamEfrac += clusters.at(i)->getBeamEfrac();
+    pe += clusters.at(i)->getPE();
   }
-  centroid /= clusters.size();
   centroidX /= clusters.size();
   if (centroid >= vertBarStartIdx_) {
     if (verbose_) {
@@ -507,7 +503,7 @@ ldmx::TrigScintTrack TrigScintTrackProducer::makeTrack(
       //                    << " from clusters with y centroids";
       // for (uint i = 0; i < clusters.size(); i++)
       // ldmx_log(debug) << "\tpad " << i << ": centroidY "
-      //				  << (clusters.at(i)).getCentroidY();
+      //				  << clusters.at(i)->getCentroidY();
     }
     // then the sum of centroid y is 0, 2, 4 or 6
     // we have 4 divisions, so, the center of it should be divNb/8
@@ -524,11 +520,7 @@ ldmx::TrigScintTrack TrigScintTrackProducer::makeTrack(
   beamEfrac /= clusters.size();
   pe /= clusters.size();
 
-  float residual = 0;
-  for (uint i = 0; i < clusters.size(); i++)
-    residual += ((clusters.at(i)).getCentroid() - centroid) *
-                ((clusters.at(i)).getCentroid() - centroid);
-  residual = sqrt(residual / clusters.size());
+  float residual = trackResidual(clusters, centroid);
 
   tr.setCentroid(centroid);
   tr.setCentroidX(centroidX);
@@ -543,12 +535,61 @@ ldmx::TrigScintTrack TrigScintTrackProducer::makeTrack(
                     << pe << " from clusters with centroids";
     for (uint i = 0; i < clusters.size(); i++)
       ldmx_log(debug) << "\tpad " << i << ": centroid "
-                      << (clusters.at(i)).getCentroid();
+                      << clusters.at(i)->getCentroid();
   }
 
   return tr;
 }
 
+void TrigScintTrackProducer::resolveOverlaps(
+    const std::vector<ldmx::TrigScintCluster> &clusters,
+    const std::vector<int> &trackClusters,
+    std::vector<int> &keepIndices) const {
+  // group the tracks by the centroid of their cluster in this pad, tracks
+  // without a cluster here don't overlap in it
+  std::vector<std::pair<float, int>> byCluster;
+  for (uint idx = 0; idx < trackClusters.size(); idx++) {
+    if (trackClusters[idx] < 0) continue;
+    byCluster.emplace_back(clusters[trackClusters[idx]].getCentroid(), idx);
+  }
+  std::sort(byCluster.begin(), byCluster.end());
+
+  for (auto group = byCluster.begin(); group != byCluster.end();) {
+    auto groupEnd = std::find_if(group, byCluster.end(), [&](const auto &t) {
+      return t.first != group->first;
+    });
+    // we have overlap downstream of the seeding pad. probably, one cluster in
+    // seeding pad is noise
+    for (auto it = group; it != groupEnd; ++it) {
+      for (auto itNext = std::next(it); itNext != groupEnd; ++itNext) {
+        int idxComp = it->second;
+        int idx = itNext->second;
+        const auto &track{tracks_[idx]};
+        const auto &prevTrack{tracks_[idxComp]};
+        // no need to compare tracks that are ridiculously far apart
+        if (!(track.getCentroid() - prevTrack.getCentroid() < 3 * maxDelta_))
+          continue;
+
+        if (verbose_ > 1) {
+          ldmx_log(debug) << "Found overlap! Tracks at index " << idx
+                          << " and " << idxComp;
+          track.Print();
+          prevTrack.Print();
+        }
+
+        if (track.getResidual() < prevTrack.getResidual()) {
+          // previous track (lower index) is a worse choice, remove its flag
+          // for keeping
+          keepIndices.at(idxComp) = 0;
+        } else  // prefer previous track over current. remove current track's
+                // keep flag
+          keepIndices.at(idx) = 0;
+      }  // over later tracks sharing the cluster
+    }    // over tracks sharing the cluster
+    group = groupEnd;
+  }  // over clusters shared by tracks
+}
+
 // std::vector<ldmx::TrigScintTrack>  TrigScintTrackProducer::matchXYTracks(
 void TrigScintTrackProducer::matchXYTracks(
     std::vector<ldmx::TrigScintTrack> &tracks) {
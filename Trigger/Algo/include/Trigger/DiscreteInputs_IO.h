@@ -1,6 +1,8 @@
 #ifndef DISCRETEINPUTS_IO
 #define DISCRETEINPUTS_IO
 
+#include <cassert>
+#include <iostream>
 #include <vector>
 
 #include "../../../Algo_HLS/Ecal/src/data.h"
@@ -0,0 +1,66 @@
+/**
+ * @file EcalTotalEnergy.h
+ * @brief Bit-exact emulation of the ECal total energy firmware
+ *
+ * The widths of the ECal trigger words are defined here once and the HLS
+ * project in Trigger/Algo_HLS/Ecal builds its ap types from them, so the
+ * synthesized kernel and this emulation can't drift apart. The kernel itself
+ * is a template over its types: the HLS top level instantiates it with the
+ * ap types and the producers with the integer types below.
+ *
+ * Only C++11 is used so that the header can be part of an HLS project.
+ */
+
+#ifndef TRIGGER_EMULATION_ECALTOTALENERGY_H
+#define TRIGGER_EMULATION_ECALTOTALENERGY_H
+
+#include "FixedPoint.h"
+
+namespace trigger {
+namespace emu {
+namespace ecal {
+
+/// bits of a trigger ID
+static const int TID_BITS = 20;
+/// bits of a trigger primitive
+static const int TP_BITS = 7;
+/// bits of an energy [MeV]
+static const int E_BITS = 16;
+/// integer bits of an energy, up to at least 8 GeV
+static const int E_INT_BITS = 14;
+/// primitives read by the total energy kernel
+static const int MAX_TPS = 100;
+
+typedef UInt<TID_BITS> tid_t;
+typedef UInt<TP_BITS> tp_t;
+typedef UFixed<E_BITS, E_INT_BITS> e_t;
+
+/// trigger primitive as the firmware sees it
+struct EcalTP {
+  tid_t tid;
+  tp_t tp;
+};
+
+/**
+ * Sum the primitives into the total energy
+ *
+ * This is the kernel of the firmware, the sum wraps to the width of the
+ * energy like it does in the FPGA.
+ *
+ * @param[in] tps the N primitives, the unused ones must be zero
+ * @param[out] energy total energy
+ */
+template <int N, class TP, class E>
+void totalEnergy(const TP tps[N], E& energy) {
+  energy = 0;
+  for (int i = 0; i < N; i++) {
+    // TODO add conversion to linear
+    energy += tps[i].tp;
+  }
+}
+
+}  // namespace ecal
+}  // namespace emu
+}  // namespace trigger
+
+#endif  // TRIGGER_EMULATION_ECALTOTALENERGY_H
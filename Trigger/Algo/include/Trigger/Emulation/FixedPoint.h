@@ -0,0 +1,131 @@
+/**
+ * @file FixedPoint.h
+ * @brief Plain integer emulation of the HLS arbitrary precision types
+ *
+ * These classes reproduce the bits of ap_uint<W> and of ap_ufixed<W,I> with
+ * its default quantization (AP_TRN, the bits below the LSB are dropped) and
+ * overflow (AP_WRAP, the bits above the MSB are dropped) modes for the
+ * operations the trigger kernels use. They are built on 64 bit integers, so
+ * they are much faster than the ap types in software while giving the same
+ * results; a kernel written as a template over its types can be synthesized
+ * with the ap types and run in a processor with these.
+ *
+ * Only C++11 is used so that the header can be part of an HLS project.
+ */
+
+#ifndef TRIGGER_EMULATION_FIXEDPOINT_H
+#define TRIGGER_EMULATION_FIXEDPOINT_H
+
+#include <math.h>
+#include <stdint.h>
+
+namespace trigger {
+namespace emu {
+
+/// mask of the lowest w bits
+constexpr uint64_t lowBits(int w) {
+  return w >= 64 ? ~uint64_t(0) : (uint64_t(1) << w) - 1;
+}
+
+/**
+ * @class UInt
+ * @brief Emulation of ap_uint<W>
+ */
+template <int W>
+class UInt {
+  static_assert(W > 0 and W <= 32, "UInt supports 1 to 32 bits");
+
+ public:
+  static const int width = W;
+
+  constexpr UInt() : raw_(0) {}
+
+  /// from an integer, keeping its lowest W bits like ap_uint does
+  constexpr UInt(uint64_t value) : raw_(value & lowBits(W)) {}
+
+  /// @return the bits of the number
+  constexpr uint64_t raw() const { return raw_; }
+
+  constexpr operator uint64_t() const { return raw_; }
+
+ private:
+  uint64_t raw_;
+};
+
+/**
+ * @class UFixed
+ * @brief Emulation of ap_ufixed<W, I> with AP_TRN and AP_WRAP
+ *
+ * The number is stored as its W bits, of which the lowest W-I are the
+ * fraction.
+ */
+template <int W, int I>
+class UFixed {
+  static_assert(W > 0 and W <= 32, "UFixed supports 1 to 32 bits");
+  static_assert(I >= 0 and I <= W, "UFixed needs 0 to W integer bits");
+
+ public:
+  static const int width = W;
+  static const int int_bits = I;
+  static const int frac_bits = W - I;
+
+  constexpr UFixed() : raw_(0) {}
+
+  /// from an integer, wrapped to the integer bits
+  constexpr UFixed(int value)
+      : raw_((uint64_t(int64_t(value)) << frac_bits) & lowBits(W)) {}
+
+  /// from a floating point number, truncated to the LSB and wrapped
+  explicit UFixed(double value)
+      : raw_(uint64_t(int64_t(floor(ldexp(value, frac_bits)))) &
+             lowBits(W)) {}
+
+  /// build from the bits of the number
+  static constexpr UFixed fromRaw(uint64_t raw) { return UFixed(raw, 0); }
+
+  /// @return the bits of the number
+  constexpr uint64_t raw() const { return raw_; }
+
+  /// @return the number, exactly
+  double toDouble() const { return ldexp(double(raw_), -frac_bits); }
+
+  /// to an integer type, dropping the fraction and wrapping to its width
+  template <int W2>
+  constexpr operator UInt<W2>() const {
+    return UInt<W2>(raw_ >> frac_bits);
+  }
+
+  UFixed& operator+=(UFixed other) {
+    raw_ = (raw_ + other.raw_) & lowBits(W);
+    return *this;
+  }
+
+  /// add an integer, as ap_ufixed += ap_uint
+  template <int W2>
+  UFixed& operator+=(UInt<W2> other) {
+    raw_ = (raw_ + (other.raw() << frac_bits)) & lowBits(W);
+    return *this;
+  }
+
+  constexpr bool operator==(UFixed other) const { return raw_ == other.raw_; }
+  constexpr bool operator!=(UFixed other) const { return raw_ != other.raw_; }
+
+ private:
+  /// from the bits, the second argument only picks this constructor
+  constexpr UFixed(uint64_t raw, int) : raw_(raw & lowBits(W)) {}
+
+  uint64_t raw_;
+};
+
+// checks of the wrapping and truncation at compile time
+static_assert(UInt<7>(130).raw() == 2, "UInt wraps to its width");
+static_assert(UFixed<16, 14>(3).raw() == 12, "UFixed keeps two fraction bits");
+static_assert(UFixed<16, 14>(20000).raw() == (20000u << 2 & 0xFFFFu),
+              "UFixed wraps to its integer bits");
+static_assert(UInt<7>(UFixed<16, 14>::fromRaw(13)).raw() == 3,
+              "UFixed to UInt drops the fraction");
+
+}  // namespace emu
+}  // namespace trigger
+
+#endif  // TRIGGER_EMULATION_FIXEDPOINT_H
@@ -5,6 +5,7 @@
 #include <cmath>
 #include <iostream>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 #include "TFitResult.h"
@@ -26,21 +27,31 @@ class ClusterGeometry {
   // TP ID to X,Y positions in mm
   std::map<int, std::pair<float, float> > positions;
 
-  // pairwise X,Y distances of all TPs
-  std::map<std::pair<int, int>, float> distances;
+  // dense index of each TP ID, in increasing ID order
+  std::unordered_map<int, int> index;
+  // TP ID and X,Y position of each dense index
+  std::vector<int> ids;
+  std::vector<float> xs;
+  std::vector<float> ys;
 
-  // list of neighbors associated to each TP
-  std::map<int, std::vector<int> > neighbors;
+  // dense indices of the neighbors of each dense index, in increasing order
+  std::vector<std::vector<int> > neighbors;
 
   int GetID(int cell_id, int module_id) {
     return reverse_id_map[std::make_pair(cell_id, module_id)];
   }
-  float GetDist(int id1, int id2) {
-    return distances[std::make_pair(id1, id2)];
+  float GetDist(int id1, int id2);
+
+  /// @return dense index of a TP ID, -1 if it isn't in the geometry
+  int GetIndex(int id) const {
+    auto it = index.find(id);
+    return it == index.end() ? -1 : it->second;
   }
+  /// @return number of TPs, only valid after Initialize
+  int NumTPs() const { return ids.size(); }
 
   void AddTP(int tid, int cell_id, int module_id, float x, float y);
-  void AddNeighbor(int id1, int id2);
+  void AddNeighbor(int i1, int i2);
   bool CheckNeighbor(int id1, int id2);
 
   void Initialize();
@@ -179,6 +190,10 @@ class IdealClusterBuilder {
 
   /* void BuildClusters(); */
   /* void Cluster2dHits(); */
+
+ private:
+  // position in the hits of the layer of each dense TP index, -1 if none
+  std::vector<int> slot_;
 };
 
 template <class T>
@@ -3,6 +3,7 @@
 
 #include "Framework/EventProcessor.h"
 #include "Framework/NtupleManager.h"
+#include "SimCore/Event/SimTrackerHit.h"
 #include "TFile.h"
 // #include "TTree.h"
 using std::vector;
@@ -30,6 +31,36 @@ class NtupleWriter : public framework::Producer {
   bool writeEle_{true};
   bool writeEcalSums_{true};
   bool writeHcalSums_{true};
+
+  template <typename T>
+  using Column = framework::NtupleManager::Column<T>;
+
+  /// columns of the variables of one truth scoring plane hit
+  struct TruthColumns {
+    Column<float> e, x, y, px, py, pz;
+    Column<int> pdgId;
+  };
+  TruthColumns truth_, truthEcal_;
+
+  /// columns of the energy sums after each layer
+  struct SumColumns {
+    Column<vector<float> > e_afterLayer;
+    Column<int> e_nLayer;
+  };
+  SumColumns ecalSums_, hcalSums_;
+
+  /// columns of the trigger electrons
+  Column<int> nElectron_, maxE_, maxPt_;
+  Column<vector<float> > ele_e_, ele_eClus_, ele_zClus_, ele_px_, ele_py_,
+      ele_pz_, ele_dx_, ele_dy_, ele_x_, ele_y_;
+  Column<vector<int> > ele_tp_, ele_depth_;
+
+  /// add the variables of a truth hit with names starting with coll
+  TruthColumns addTruth(const std::string& coll);
+  /// set the variables of a truth hit
+  void setTruth(const TruthColumns& c, const ldmx::SimTrackerHit& h);
+  /// add the energy sum variables of the detector det
+  SumColumns addSums(const std::string& det);
 };
 }  // namespace trigger
 
@@ -12,6 +12,7 @@
 #include "Framework/Configure/Parameters.h"  // Needed to import parameters from configuration file
 #include "Framework/Event.h"
 #include "Framework/EventProcessor.h"  //Needed to declare processor
+#include "IdealClusterBuilder.h"
 #include "TrigUtilities.h"
 #include "ap_fixed.h"
 #include "ap_int.h"
@@ -48,6 +49,12 @@ class TrigEcalClusterProducer : public framework::Producer {
   // name of collection for trigCluster to be output
   std::string clusterCollName_;
 
+  // conversion of the primitives to energy, kept to not rebuild its tables
+  ecalTpToE cvt_;
+
+  // positions and neighbors of the TPs, built on the first event
+  ClusterGeometry clusterGeo_;
+
   // From:
   // Tools/python/HgcrocEmulator.py
   // ECal/python/digi.py
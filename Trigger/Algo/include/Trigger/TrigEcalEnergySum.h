@@ -13,8 +13,7 @@
 #include "Framework/Event.h"
 #include "Framework/EventProcessor.h"  //Needed to declare processor
 #include "TrigUtilities.h"
-#include "ap_fixed.h"
-#include "ap_int.h"
+#include "Trigger/Emulation/EcalTotalEnergy.h"
 
 namespace trigger {
 
@@ -41,7 +40,7 @@ class TrigEcalEnergySum : public framework::Producer {
 
   virtual void onProcessEnd();
 
-  typedef ap_ufixed<16, 14> e_t;  // [MeV] (Up to at least 8 GeV)
+  typedef emu::ecal::e_t e_t;  // [MeV] (Up to at least 8 GeV)
 
  private:
   // specific verbosity of this producer
@@ -50,6 +49,9 @@ class TrigEcalEnergySum : public framework::Producer {
   // name of collection for trigHits to be passed as input
   std::string hitCollName_;
 
+  // conversion of the primitives to energy, kept to not rebuild its tables
+  ecalTpToE cvt_;
+
   // From:
   // Tools/python/HgcrocEmulator.py
   // ECal/python/digi.py
@@ -41,12 +41,36 @@ class TrigElectronProducer : public framework::Producer {
 
   virtual void onProcessEnd();
 
-  void setupMaps(bool isX);
-  float getP(bool isX, float e, float d);
-  float getPx(float e, float d) { return getP(true, e, d); }
-  float getPy(float e, float d) { return getP(false, e, d); }
+  /**
+   * Fit the propagation map in each energy bin and keep the inverted fits
+   *
+   * @param[in] prof propagation map, deflection vs p/e and energy
+   * @param[in] isX true for the map in x
+   */
+  void setupMaps(TProfile2D* prof, bool isX);
+  float getP(bool isX, float e, float d) const;
+  float getPx(float e, float d) const { return getP(true, e, d); }
+  float getPy(float e, float d) const { return getP(false, e, d); }
 
  private:
+  /**
+   * Linear fits of the propagation map inverted in closed form
+   *
+   * The deflection d in each energy bin is fit as d = p0 + p1 (p/e),
+   * which is kept as p/e = offset + slope * d so that the momentum is
+   * found with a multiply-add instead of a root-find.
+   */
+  struct PropMap {
+    /// lower edge of the first energy bin [MeV]
+    float eMin{0};
+    /// width of the energy bins [MeV]
+    float eWidth{1};
+    /// p/e at no deflection in each energy bin
+    std::vector<float> offset;
+    /// change in p/e per deflection in each energy bin [1/mm]
+    std::vector<float> slope;
+  };
+
   // specific verbosity of this producer
   int verbose_{0};
 
@@ -60,10 +84,8 @@ class TrigElectronProducer : public framework::Producer {
   std::string eleCollName_;
 
   std::string propMapName_;
-  TProfile2D* propMapx_{nullptr};
-  TProfile2D* propMapy_{nullptr};
-  std::vector<TF1*> fitsX_{};
-  std::vector<TF1*> fitsY_{};
+  PropMap mapX_;
+  PropMap mapY_;
 
   // From:
   // Tools/python/HgcrocEmulator.py
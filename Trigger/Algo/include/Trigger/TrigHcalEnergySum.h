@@ -12,6 +12,7 @@
 #include "Framework/Configure/Parameters.h"  // Needed to import parameters from configuration file
 #include "Framework/Event.h"
 #include "Framework/EventProcessor.h"  //Needed to declare processor
+#include "Recon/Event/CaloTrigPrim.h"
 #include "ap_fixed.h"
 #include "ap_int.h"
 
@@ -48,6 +49,13 @@ class TrigHcalEnergySum : public framework::Producer {
   std::string inProc_;
   std::string quadCollName_;
   std::string combinedQuadCollName_;
+
+  // summed two-ended primitive of each quad, by HcalTriggerGeometry::quadIndex
+  std::vector<ldmx::CaloTrigPrim> twoEndedQuadSums_;
+  // whether each quad has been filled in this event
+  std::vector<bool> quadFilled_;
+  // indices of the quads filled in this event
+  std::vector<int> filledQuads_;
 };
 }  // namespace trigger
 
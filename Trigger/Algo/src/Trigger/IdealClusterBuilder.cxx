@@ -8,48 +8,72 @@ void ClusterGeometry::AddTP(int tid, int cell_id, int module_id, float x,
   reverse_id_map[std::make_pair(cell_id, module_id)] = tid;
   positions[tid] = std::make_pair(x, y);
 }
-void ClusterGeometry::AddNeighbor(int id1, int id2) {
-  if (neighbors.count(id1))
-    neighbors[id1].push_back(id2);
-  else
-    neighbors[id1] = {id2};
-  if (neighbors.count(id2))
-    neighbors[id2].push_back(id1);
-  else
-    neighbors[id2] = {id1};
-  // cout << "Nbs: " << id1 << " " << id2 << endl;
+float ClusterGeometry::GetDist(int id1, int id2) {
+  int i1 = GetIndex(id1);
+  int i2 = GetIndex(id2);
+  if (i1 < 0 || i2 < 0 || i1 == i2) return 0;
+  return sqrt(pow(xs[i1] - xs[i2], 2) + pow(ys[i1] - ys[i2], 2));
+}
+void ClusterGeometry::AddNeighbor(int i1, int i2) {
+  neighbors[i1].push_back(i2);
+  neighbors[i2].push_back(i1);
+  // cout << "Nbs: " << ids[i1] << " " << ids[i2] << endl;
 }
 bool ClusterGeometry::CheckNeighbor(int id1, int id2) {
   // true if neighbors
-  auto &ns = neighbors[id1];
-  return std::find(ns.begin(), ns.end(), id2) != ns.end();
+  int i1 = GetIndex(id1);
+  int i2 = GetIndex(id2);
+  if (i1 < 0 || i2 < 0) return false;
+  auto &ns = neighbors[i1];
+  return std::binary_search(ns.begin(), ns.end(), i2);
 }
 void ClusterGeometry::Initialize() {
-  // calculate pairwise distances
-  distances.clear();
-  for (auto pair1 = id_map.begin(); pair1 != id_map.end(); pair1++) {
-    for (auto pair2 = pair1; pair2 != id_map.end(); pair2++) {
-      if (pair1 == pair2) continue;
-      auto &id1 = pair1->first;
-      auto &id2 = pair2->first;
-      auto &xy1 = positions[id1];
-      auto &xy2 = positions[id2];
-      float d =
-          sqrt(pow(xy1.first - xy2.first, 2) + pow(xy1.second - xy2.second, 2));
-      distances[std::make_pair(id1, id2)] = d;
-      distances[std::make_pair(id2, id1)] = d;
-    }
+  // dense indices in increasing ID order
+  index.clear();
+  ids.clear();
+  xs.clear();
+  ys.clear();
+  for (auto &pair : id_map) {
+    index[pair.first] = ids.size();
+    ids.push_back(pair.first);
+    auto &xy = positions[pair.first];
+    xs.push_back(xy.first);
+    ys.push_back(xy.second);
   }
+  neighbors.assign(ids.size(), {});
+  if (ids.empty()) return;
+
   // find neighbors
   float n_dist = 1.8 * GetDist(GetID(0, 0), GetID(1, 0));
   // float n_dist = 1.2*GetDist(GetID(0,0), GetID(1,0));
-  for (auto pair1 = id_map.begin(); pair1 != id_map.end(); pair1++) {
-    for (auto pair2 = pair1; pair2 != id_map.end(); pair2++) {
-      if (pair1 == pair2) continue;
-      if (GetDist(pair1->first, pair2->first) < n_dist)
-        AddNeighbor(pair1->first, pair2->first);
+
+  // bin the TPs in a grid a little coarser than the neighbor distance,
+  // so only the TPs in the surrounding bins need to be compared
+  float bin = 1.01 * n_dist;
+  if (bin <= 0) bin = 1;
+  float x0 = *std::min_element(xs.begin(), xs.end());
+  float y0 = *std::min_element(ys.begin(), ys.end());
+  int nx = 1 + int((*std::max_element(xs.begin(), xs.end()) - x0) / bin);
+  int ny = 1 + int((*std::max_element(ys.begin(), ys.end()) - y0) / bin);
+  std::vector<std::vector<int> > grid(nx * ny);
+  std::vector<int> bx(ids.size()), by(ids.size());
+  for (int i = 0; i < NumTPs(); i++) {
+    bx[i] = int((xs[i] - x0) / bin);
+    by[i] = int((ys[i] - y0) / bin);
+    grid[bx[i] * ny + by[i]].push_back(i);
+  }
+  for (int i = 0; i < NumTPs(); i++) {
+    for (int ix = std::max(0, bx[i] - 1); ix <= std::min(nx - 1, bx[i] + 1);
+         ix++) {
+      for (int iy = std::max(0, by[i] - 1);
+           iy <= std::min(ny - 1, by[i] + 1); iy++) {
+        for (int j : grid[ix * ny + iy]) {
+          if (j > i && GetDist(ids[i], ids[j]) < n_dist) AddNeighbor(i, j);
+        }
+      }
     }
   }
+  for (auto &ns : neighbors) std::sort(ns.begin(), ns.end());
   is_initialized = true;
 }
 
@@ -57,23 +81,51 @@ void ClusterGeometry::Initialize() {
 /* IdealClusterBuilder::Build2dClustersLayer(std::vector<Hit> hits){ */
 std::vector<Cluster> IdealClusterBuilder::Build2dClustersLayer(
     std::vector<Hit> hits) {
-  // Re-index by id
-  std::map<int, Hit> hits_by_id;
-  for (auto &hit : hits) hits_by_id[hit.id] = hit;
+  // Re-index by id, the last hit of a TP replacing the earlier ones
+  std::stable_sort(
+      hits.begin(), hits.end(),
+      [](const Hit &lhs, const Hit &rhs) { return lhs.id < rhs.id; });
+  std::vector<Hit> layer;
+  for (auto &hit : hits) {
+    if (!layer.empty() && layer.back().id == hit.id)
+      layer.back() = hit;
+    else
+      layer.push_back(hit);
+  }
+
+  // neighboring hits through the dense TP index of the geometry
+  if (slot_.size() != std::size_t(g->NumTPs())) slot_.assign(g->NumTPs(), -1);
+  std::vector<int> tps(layer.size());
+  for (std::size_t i = 0; i < layer.size(); i++) {
+    tps[i] = g->GetIndex(layer[i].id);
+    if (tps[i] >= 0) slot_[tps[i]] = i;
+  }
+  std::vector<std::vector<int> > hit_neighbors(layer.size());
+  for (std::size_t i = 0; i < layer.size(); i++) {
+    if (tps[i] < 0) continue;
+    for (auto n : g->neighbors[tps[i]]) {
+      if (slot_[n] >= 0) hit_neighbors[i].push_back(slot_[n]);
+    }
+  }
+  for (auto tp : tps) {
+    if (tp >= 0) slot_[tp] = -1;
+  }
 
   if (debug) {
     cout << "--------\nBuild2dClustersLayer Input Hits" << endl;
-    for (auto &hitpair : hits_by_id) hitpair.second.Print();
+    for (auto &hit : layer) hit.Print();
   }
 
   // Find seeds
   std::vector<Cluster> clusters;
-  for (auto &hitpair : hits_by_id) {
-    auto &hit = hitpair.second;
+  // positions in layer of the hits of each cluster
+  std::vector<std::vector<int> > cluster_hits;
+  for (std::size_t i = 0; i < layer.size(); i++) {
+    auto &hit = layer[i];
     bool isLocalMax = true;
-    for (auto n : g->neighbors[hit.id]) {
-      // cout << "  checking " << n << endl;
-      if (hits_by_id.count(n) && hits_by_id[n].e > hit.e) isLocalMax = false;
+    for (auto n : hit_neighbors[i]) {
+      // cout << "  checking " << layer[n].id << endl;
+      if (layer[n].e > hit.e) isLocalMax = false;
     }
     // if(debug) cout << hit.e << " " << hit.id << " "
     //  << hit.layer << " isMax=" << isLocalMax << endl;
@@ -89,62 +141,47 @@ std::vector<Cluster> IdealClusterBuilder::Build2dClustersLayer(
       c.module = g->id_map[hit.id].second;
       c.layer = hit.layer;
       clusters.push_back(c);
+      cluster_hits.push_back({int(i)});
     }
   }
 
   if (debug) {
     cout << "--------\nAfter seed-finding" << endl;
-    for (auto &hitpair : hits_by_id) hitpair.second.Print();
+    for (auto &hit : layer) hit.Print();
     for (auto &c : clusters) c.Print();
   }
 
   // Add neighbors up to the specified limit
   int i_neighbor = 0;
+  // clusters to which each hit is assoc, once per neighboring cluster hit
+  std::vector<std::vector<int> > assoc_hit2clusters(layer.size());
   while (i_neighbor < n_neighbors) {
     // find (unused) neighbors for all clusters
-    std::map<int, std::vector<int> > assoc_clus2hitIDs;
-    for (int iclus = 0; iclus < clusters.size(); iclus++) {
-      auto &clus = clusters[iclus];
-      std::vector<int> neighbors;
-      for (const auto &hit : clus.hits) {
-        for (auto n : g->neighbors[hit.id]) {
-          if (hits_by_id.count(n) && !hits_by_id[n].used &&
-              hits_by_id[n].e > neighb_thresh) {
-            neighbors.push_back(n);
+    for (auto &iclusters : assoc_hit2clusters) iclusters.clear();
+    for (std::size_t iclus = 0; iclus < clusters.size(); iclus++) {
+      for (auto ihit : cluster_hits[iclus]) {
+        for (auto n : hit_neighbors[ihit]) {
+          if (!layer[n].used && layer[n].e > neighb_thresh) {
+            assoc_hit2clusters[n].push_back(iclus);
           }
         }
       }
-      assoc_clus2hitIDs[iclus] = neighbors;
-    }
-
-    // check how many clusters to which each hit is assoc
-    std::map<int, std::vector<int> > assoc_hitID2clusters;
-    for (auto clus2hitID : assoc_clus2hitIDs) {
-      auto iclus = clus2hitID.first;
-      auto &hitIDs = clus2hitID.second;
-      for (const auto &hitID : hitIDs) {
-        if (assoc_hitID2clusters.count(hitID))
-          assoc_hitID2clusters[hitID].push_back(iclus);
-        else
-          assoc_hitID2clusters[hitID] = {iclus};
-      }
     }
 
     // add associated hits to clusters
     //   (w/ optional e-splitting)
-    for (auto hitID2clusters : assoc_hitID2clusters) {
-      auto hitID = hitID2clusters.first;
-      auto iclusters = hitID2clusters.second;
+    for (std::size_t ihit = 0; ihit < layer.size(); ihit++) {
+      auto &iclusters = assoc_hit2clusters[ihit];
+      if (iclusters.empty()) continue;
+      auto &hit = layer[ihit];
+      hit.used = true;
       if (iclusters.size() == 1) {
         // simply add cell to the cluster
-        auto &hit = hits_by_id[hitID];
         auto iclus = iclusters[0];
-        hit.used = true;
         clusters[iclus].hits.push_back(hit);
         clusters[iclus].e += hit.e;
+        cluster_hits[iclus].push_back(ihit);
       } else {
-        auto &hit = hits_by_id[hitID];
-        hit.used = true;
         float esum = 0;
         for (auto iclus : iclusters) {
           esum += clusters[iclus].e;
@@ -154,6 +191,7 @@ std::vector<Cluster> IdealClusterBuilder::Build2dClustersLayer(
           if (split_energy) newHit.e = hit.e * clusters[iclus].e / esum;
           clusters[iclus].hits.push_back(newHit);
           clusters[iclus].e += newHit.e;
+          cluster_hits[iclus].push_back(ihit);
         }
       }
     }
@@ -197,7 +235,7 @@ std::vector<Cluster> IdealClusterBuilder::Build2dClustersLayer(
 
     if (debug) {
       cout << "--------\nAfter " << i_neighbor << " neighbors" << endl;
-      for (auto &hitpair : hits_by_id) hitpair.second.Print();
+      for (auto &hit : layer) hit.Print();
       for (auto &c : clusters) c.Print();
     }
   }
@@ -207,23 +245,17 @@ std::vector<Cluster> IdealClusterBuilder::Build2dClustersLayer(
 
 void IdealClusterBuilder::Build2dClusters() {
   // first partition hits by layer
-  std::map<int, std::vector<Hit> > layer_hits;  // id(xy) to Hit
-  for (const auto hit : all_hits) {
-    auto l = hit.layer;
-    if (layer_hits.count(l)) {
-      layer_hits[l].push_back(hit);
-    } else {
-      layer_hits[l] = {hit};
-    }
-  }
+  std::vector<std::vector<Hit> > layer_hits(LAYER_MAX);
+  for (const auto &hit : all_hits) layer_hits[hit.layer].push_back(hit);
 
   // run clustering in each layer and add to the list
-  for (auto &pair : layer_hits) {
+  for (int l = 0; l < LAYER_MAX; l++) {
+    if (layer_hits[l].empty()) continue;
     if (debug) {
-      cout << "Found " << pair.second.size() << " hits in layer " << pair.first
+      cout << "Found " << layer_hits[l].size() << " hits in layer " << l
            << endl;
     }
-    auto clus = Build2dClustersLayer(pair.second);
+    auto clus = Build2dClustersLayer(layer_hits[l]);
     all_clusters.insert(all_clusters.end(), clus.begin(), clus.end());
   }
 }
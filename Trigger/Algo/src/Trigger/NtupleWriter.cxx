@@ -38,14 +38,7 @@ void NtupleWriter::produce(framework::Event& event) {
     }
     if (h.getPdgID() == 0)
       h = hMaxEle;  // save max energy in case track1 isn't found (A')
-    std::string coll = "Truth";
-    n.setVar(coll + "_e", prec(h.getEnergy()));
-    n.setVar(coll + "_x", prec(h.getPosition()[0]));
-    n.setVar(coll + "_y", prec(h.getPosition()[1]));
-    n.setVar(coll + "_px", prec(h.getMomentum()[0]));
-    n.setVar(coll + "_py", prec(h.getMomentum()[1]));
-    n.setVar(coll + "_pz", prec(h.getMomentum()[2]));
-    n.setVar(coll + "_pdgId", h.getPdgID());
+    setTruth(truth_, h);
   }
   inTag = "EcalScoringPlaneHits";
   if (writeTruth_ && event.exists(inTag)) {
@@ -64,14 +57,7 @@ void NtupleWriter::produce(framework::Event& event) {
     }
     if (h.getPdgID() == 0)
       h = hMaxEle;  // save max energy in case track1 isn't found (A')
-    std::string coll = "TruthEcal";
-    n.setVar(coll + "_e", prec(h.getEnergy()));
-    n.setVar(coll + "_x", prec(h.getPosition()[0]));
-    n.setVar(coll + "_y", prec(h.getPosition()[1]));
-    n.setVar(coll + "_px", prec(h.getMomentum()[0]));
-    n.setVar(coll + "_py", prec(h.getMomentum()[1]));
-    n.setVar(coll + "_pz", prec(h.getMomentum()[2]));
-    n.setVar(coll + "_pdgId", h.getPdgID());
+    setTruth(truthEcal_, h);
   }
 
   inTag = "ecalTrigSums";
@@ -87,8 +73,8 @@ void NtupleWriter::produce(framework::Event& event) {
         energyAfterLayer[i] += sum.energy();
       }
     }
-    n.setVar("Ecal_e_afterLayer", energyAfterLayer);
-    n.setVar("Ecal_e_nLayer", int(energyAfterLayer.size()));
+    n.setVar(ecalSums_.e_nLayer, int(energyAfterLayer.size()));
+    n.setVar(ecalSums_.e_afterLayer, std::move(energyAfterLayer));
   }
   inTag = "hcalTrigQuadsBackLayerSums";
   if (writeHcalSums_ && event.exists(inTag)) {
@@ -104,8 +90,8 @@ void NtupleWriter::produce(framework::Event& event) {
         energyAfterLayer[i] += sum.hwEnergy();
       }
     }
-    n.setVar("Hcal_e_afterLayer", energyAfterLayer);
-    n.setVar("Hcal_e_nLayer", int(energyAfterLayer.size()));
+    n.setVar(hcalSums_.e_nLayer, int(energyAfterLayer.size()));
+    n.setVar(hcalSums_.e_afterLayer, std::move(energyAfterLayer));
   }
 
   inTag = "trigElectrons";
@@ -150,22 +136,21 @@ void NtupleWriter::produce(framework::Event& event) {
       v_tp[i] = prec(eles[i].getClusTP());
       v_depth[i] = prec(eles[i].getClusDepth());
     }
-    std::string coll = "Electron";
-    n.setVar("n" + coll, nEle);
-    n.setVar("maxE", maxE);
-    n.setVar("maxPt", maxPt);
-    n.setVar(coll + "_e", v_e);
-    n.setVar(coll + "_eClus", v_eC);
-    n.setVar(coll + "_zClus", v_zC);
-    n.setVar(coll + "_px", v_px);
-    n.setVar(coll + "_py", v_py);
-    n.setVar(coll + "_pz", v_pz);
-    n.setVar(coll + "_dx", v_dx);
-    n.setVar(coll + "_dy", v_dy);
-    n.setVar(coll + "_x", v_x);
-    n.setVar(coll + "_y", v_y);
-    n.setVar(coll + "_tp", v_tp);
-    n.setVar(coll + "_depth", v_depth);
+    n.setVar(nElectron_, nEle);
+    n.setVar(maxE_, maxE);
+    n.setVar(maxPt_, maxPt);
+    n.setVar(ele_e_, std::move(v_e));
+    n.setVar(ele_eClus_, std::move(v_eC));
+    n.setVar(ele_zClus_, std::move(v_zC));
+    n.setVar(ele_px_, std::move(v_px));
+    n.setVar(ele_py_, std::move(v_py));
+    n.setVar(ele_pz_, std::move(v_pz));
+    n.setVar(ele_dx_, std::move(v_dx));
+    n.setVar(ele_dy_, std::move(v_dy));
+    n.setVar(ele_x_, std::move(v_x));
+    n.setVar(ele_y_, std::move(v_y));
+    n.setVar(ele_tp_, std::move(v_tp));
+    n.setVar(ele_depth_, std::move(v_depth));
   }
 }
 
@@ -180,46 +165,61 @@ void NtupleWriter::onProcessStart() {
 
   if (writeEle_) {
     std::string coll = "Electron";
-    n.addVar<int>(tag_, "n" + coll);
-    n.addVar<int>(tag_, "maxE");
-    n.addVar<int>(tag_, "maxPt");
-    n.addVar<vector<float> >(tag_, coll + "_e");
-    n.addVar<vector<float> >(tag_, coll + "_eClus");
-    n.addVar<vector<float> >(tag_, coll + "_zClus");
-    n.addVar<vector<float> >(tag_, coll + "_px");
-    n.addVar<vector<float> >(tag_, coll + "_py");
-    n.addVar<vector<float> >(tag_, coll + "_pz");
-    n.addVar<vector<float> >(tag_, coll + "_dx");
-    n.addVar<vector<float> >(tag_, coll + "_dy");
-    n.addVar<vector<float> >(tag_, coll + "_x");  // at target
-    n.addVar<vector<float> >(tag_, coll + "_y");
-    n.addVar<vector<int> >(tag_, coll + "_tp");
-    n.addVar<vector<int> >(tag_, coll + "_depth");
+    nElectron_ = n.addVar<int>(tag_, "n" + coll);
+    maxE_ = n.addVar<int>(tag_, "maxE");
+    maxPt_ = n.addVar<int>(tag_, "maxPt");
+    ele_e_ = n.addVar<vector<float> >(tag_, coll + "_e");
+    ele_eClus_ = n.addVar<vector<float> >(tag_, coll + "_eClus");
+    ele_zClus_ = n.addVar<vector<float> >(tag_, coll + "_zClus");
+    ele_px_ = n.addVar<vector<float> >(tag_, coll + "_px");
+    ele_py_ = n.addVar<vector<float> >(tag_, coll + "_py");
+    ele_pz_ = n.addVar<vector<float> >(tag_, coll + "_pz");
+    ele_dx_ = n.addVar<vector<float> >(tag_, coll + "_dx");
+    ele_dy_ = n.addVar<vector<float> >(tag_, coll + "_dy");
+    ele_x_ = n.addVar<vector<float> >(tag_, coll + "_x");  // at target
+    ele_y_ = n.addVar<vector<float> >(tag_, coll + "_y");
+    ele_tp_ = n.addVar<vector<int> >(tag_, coll + "_tp");
+    ele_depth_ = n.addVar<vector<int> >(tag_, coll + "_depth");
   }
   if (writeTruth_) {
-    n.addVar<float>(tag_, "Truth_x");
-    n.addVar<float>(tag_, "Truth_y");
-    n.addVar<float>(tag_, "Truth_px");
-    n.addVar<float>(tag_, "Truth_py");
-    n.addVar<float>(tag_, "Truth_pz");
-    n.addVar<float>(tag_, "Truth_e");
-    n.addVar<int>(tag_, "Truth_pdgId");
-    n.addVar<float>(tag_, "TruthEcal_x");
-    n.addVar<float>(tag_, "TruthEcal_y");
-    n.addVar<float>(tag_, "TruthEcal_px");
-    n.addVar<float>(tag_, "TruthEcal_py");
-    n.addVar<float>(tag_, "TruthEcal_pz");
-    n.addVar<float>(tag_, "TruthEcal_e");
-    n.addVar<int>(tag_, "TruthEcal_pdgId");
+    truth_ = addTruth("Truth");
+    truthEcal_ = addTruth("TruthEcal");
   }
-  if (writeEcalSums_) {
-    n.addVar<vector<float> >(tag_, "Ecal_e_afterLayer");
-    n.addVar<int>(tag_, "Ecal_e_nLayer");
-  };
-  if (writeHcalSums_) {
-    n.addVar<vector<float> >(tag_, "Hcal_e_afterLayer");
-    n.addVar<int>(tag_, "Hcal_e_nLayer");
-  };
+  if (writeEcalSums_) ecalSums_ = addSums("Ecal");
+  if (writeHcalSums_) hcalSums_ = addSums("Hcal");
+}
+
+NtupleWriter::TruthColumns NtupleWriter::addTruth(const std::string& coll) {
+  framework::NtupleManager& n{framework::NtupleManager::getInstance()};
+  TruthColumns c;
+  c.x = n.addVar<float>(tag_, coll + "_x");
+  c.y = n.addVar<float>(tag_, coll + "_y");
+  c.px = n.addVar<float>(tag_, coll + "_px");
+  c.py = n.addVar<float>(tag_, coll + "_py");
+  c.pz = n.addVar<float>(tag_, coll + "_pz");
+  c.e = n.addVar<float>(tag_, coll + "_e");
+  c.pdgId = n.addVar<int>(tag_, coll + "_pdgId");
+  return c;
+}
+
+void NtupleWriter::setTruth(const TruthColumns& c,
+                            const ldmx::SimTrackerHit& h) {
+  framework::NtupleManager& n{framework::NtupleManager::getInstance()};
+  n.setVar(c.e, prec(h.getEnergy()));
+  n.setVar(c.x, prec(h.getPosition()[0]));
+  n.setVar(c.y, prec(h.getPosition()[1]));
+  n.setVar(c.px, prec(h.getMomentum()[0]));
+  n.setVar(c.py, prec(h.getMomentum()[1]));
+  n.setVar(c.pz, prec(h.getMomentum()[2]));
+  n.setVar(c.pdgId, h.getPdgID());
+}
+
+NtupleWriter::SumColumns NtupleWriter::addSums(const std::string& det) {
+  framework::NtupleManager& n{framework::NtupleManager::getInstance()};
+  SumColumns c;
+  c.e_afterLayer = n.addVar<vector<float> >(tag_, det + "_e_afterLayer");
+  c.e_nLayer = n.addVar<int>(tag_, det + "_e_nLayer");
+  return c;
 }
 void NtupleWriter::onProcessEnd() {
   outFile_->Write();
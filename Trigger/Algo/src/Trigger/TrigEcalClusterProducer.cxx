@@ -22,14 +22,14 @@ void TrigEcalClusterProducer::produce(framework::Event& event) {
       ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME);
 
   if (!event.exists(hitCollName_)) return;
-  auto ecalTrigDigis{
+  const auto& ecalTrigDigis{
       event.getObject<ldmx::HgcrocTrigDigiCollection>(hitCollName_)};
 
   std::vector<Hit> hits{};
-  ecalTpToE cvt;
+  hits.reserve(ecalTrigDigis.size());
   for (const auto& trigDigi : ecalTrigDigis) {
     ldmx::EcalTriggerID tid(trigDigi.getId());
-    float e = cvt.calc(trigDigi.linearPrimitive(), tid.layer());
+    float e = cvt_.calc(trigDigi.linearPrimitive(), tid.layer());
 
     // float sie = hgc_compression_factor_ * trigDigi.linearPrimitive() *
     //             gain_ * mVtoMeV_;  // in MeV, before layer corrections
@@ -55,10 +55,12 @@ void TrigEcalClusterProducer::produce(framework::Event& event) {
     hits.push_back(hit);
   }
 
-  // move to once per run
-  ClusterGeometry myGeo;
+  // the trigger geometry is permanent, so the TP positions and neighbors
+  // only need to be found for the first event
+  ClusterGeometry& myGeo{clusterGeo_};
   if (!myGeo.is_initialized) {
-    for (int imod = 0; imod < 7; imod++) {
+    for (int imod = 0; imod < ldmx::EcalGeometry::MODULES_PER_LAYER;
+         imod++) {
       for (int icell = 0; icell < 48; icell++) {
         ldmx::EcalTriggerID id(0, imod, icell);
         auto [xx, yy, zz] = geom.globalPosition(id);
@@ -1,7 +1,5 @@
 #include "Trigger/TrigEcalEnergySum.h"
 
-#include "../../../Algo_HLS/Ecal/src/TotalEnergy.cpp"
-#include "../../../Algo_HLS/Ecal/src/data.h"
 #include "DetDescr/EcalGeometry.h"
 #include "Recon/Event/HgcrocDigiCollection.h"
 #include "Recon/Event/HgcrocTrigDigi.h"
@@ -16,30 +14,23 @@ void TrigEcalEnergySum::configure(framework::config::Parameters& ps) {
 void TrigEcalEnergySum::produce(framework::Event& event) {
   // std::cout << "c++ producing TrigEcalEnergySum" << std::endl;
 
-  const ecal::EcalTriggerGeometry& geom =
-      getCondition<ecal::EcalTriggerGeometry>(
-          ecal::EcalTriggerGeometry::CONDITIONS_OBJECT_NAME);
-  const ldmx::EcalGeometry& hexReadout = getCondition<ldmx::EcalGeometry>(
-      ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME);
-
   if (!event.exists(hitCollName_)) return;
-  auto ecalTrigDigis{
+  const auto& ecalTrigDigis{
       event.getObject<ldmx::HgcrocTrigDigiCollection>(hitCollName_)};
 
   // floating point algorithm
   float total_e = 0;
   // e_t total_e_trunc=0;
 
-  // run the firmware (hls) algorithm directly
-  EcalTP Input_TPs_hw[N_INPUT_TP];
+  // run the bit-exact emulation of the firmware (hls) algorithm
+  emu::ecal::EcalTP Input_TPs_hw[emu::ecal::MAX_TPS];
   e_t energy_hw;
   int iTP = 0;
-  ecalTpToE cvt;
   for (const auto& trigDigi : ecalTrigDigis) {
     // HgcrocTrigDigi
 
     ldmx::EcalTriggerID tid(trigDigi.getId());  // raw value
-    float e = cvt.calc(trigDigi.linearPrimitive(), tid.layer());
+    float e = cvt_.calc(trigDigi.linearPrimitive(), tid.layer());
     // // compressed ECal digis are 8xADCs (HCal will be 4x)
     // float sie = 8 * trigDigi.linearPrimitive() * gain *
     //             mVtoMeV;  // in MeV, before layer corrections
@@ -48,14 +39,14 @@ void TrigEcalEnergySum::produce(framework::Event& event) {
     total_e += e;
     // total_e_trunc = total_e_trunc + e_t(e);
 
-    if (iTP < N_INPUT_TP) {
+    if (iTP < emu::ecal::MAX_TPS) {
       Input_TPs_hw[iTP].tid = trigDigi.getId();
       Input_TPs_hw[iTP].tp = e_t(e);
     }
     iTP++;
   }
 
-  TotalEnergy_hw(Input_TPs_hw, energy_hw);
+  emu::ecal::totalEnergy<emu::ecal::MAX_TPS>(Input_TPs_hw, energy_hw);
 
   // std::cout << "Total ECal energy: " << total_e << " MeV (hw: " << energy_hw
   //           << " MeV)" << std::endl;
@@ -1,5 +1,8 @@
 #include "Trigger/TrigElectronProducer.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "SimCore/Event/SimTrackerHit.h"
 // #include "SimCore/Event/SimParticle.h"
 #include "DetDescr/EcalGeometry.h"
@@ -113,87 +116,79 @@ void TrigElectronProducer::onFileClose() {
 
   return;
 }
-void TrigElectronProducer::setupMaps(bool isX) {
-  TProfile2D* prof = isX ? propMapx_ : propMapy_;
+void TrigElectronProducer::setupMaps(TProfile2D* prof, bool isX) {
+  PropMap& map = isX ? mapX_ : mapY_;
   const int N = prof->GetXaxis()->GetNbins();
+  map.eMin = prof->GetXaxis()->GetXmin();
+  map.eWidth = prof->GetXaxis()->GetBinWidth(1);
+  map.offset.resize(N);
+  map.slope.resize(N);
+  TF1 func("func", "pol1", -20, 20);  // going to fit for px/e
   for (int i = 1; i <= N; i++) {
-    TF1* func = new TF1("func", "pol1", -20, 20);  // going to fit for px/e
     TProfile* proj = prof->ProfileY("h", i, i);
-    proj->Fit("func", "q", "", -1, 1);
+    proj->Fit(&func, "q", "", -1, 1);
     bool debug = false;
     if (debug) {
       TCanvas c("c", "");
       proj->Draw();
-      func->Draw("same");
+      func.Draw("same");
       c.SaveAs(TString::Format("debugFit_%d_%d.pdf", int(isX), i));
     }
     delete proj;
-    if (isX) {
-      fitsX_.push_back(func);
-    } else {
-      fitsY_.push_back(func);
-    }
+    // invert d = p0 + p1 (p/e), a flat fit never deflects
+    const double p0 = func.GetParameter(0), p1 = func.GetParameter(1);
+    map.offset[i - 1] = p1 != 0 ? -p0 / p1 : 0;
+    map.slope[i - 1] = p1 != 0 ? 1 / p1 : 0;
   }
   return;
 }
 
-float TrigElectronProducer::getP(bool isX, float e, float d) {
+float TrigElectronProducer::getP(bool isX, float e, float d) const {
   if (fabs(d) > 300) return 0;  // something has gone very wrong
-  const bool debug = false;
-  TProfile2D* prof = isX ? propMapx_ : propMapy_;
-  if (!prof) {
-    if (debug) std::cout << "null pointer" << std::endl;
-    return 0;
-  }
-  int bin1, bin2;
-  bin1 = prof->GetXaxis()->FindBin(e);
-  float frac = e - prof->GetXaxis()->GetBinCenter(bin1);
-  float diff = fabs(prof->GetXaxis()->GetBinCenter(bin1) -
-                    prof->GetXaxis()->GetBinCenter(bin2));
-  bin2 = diff > 0 ? bin1 + 1 : bin1 - 1;
-  bin1 = std::max(1, std::min(bin1, prof->GetXaxis()->GetNbins()));
-  bin2 = std::max(1, std::min(bin2, prof->GetXaxis()->GetNbins()));
-  float res1, res2;
-  if (isX) {
-    res1 = fitsX_[bin1 - 1]->GetX(d);
-    res2 = fitsX_[bin2 - 1]->GetX(d);
-  } else {
-    res1 = fitsY_[bin1 - 1]->GetX(d);
-    res2 = fitsY_[bin2 - 1]->GetX(d);
-  }
-
-  if (debug)
-    printf("%f %f %f %f :: %f %f %f \n", d, e,
-           prof->GetXaxis()->GetBinCenter(bin1),
-           prof->GetXaxis()->GetBinCenter(bin2), res1, res2,
-           abs(frac / diff) * res2 + (1 - abs(frac / diff)) * res1);
-  return e * (abs(frac / diff) * res2 + (1 - abs(frac / diff)) * res1);
+  const PropMap& map = isX ? mapX_ : mapY_;
+  const int N = map.slope.size();
+  if (N == 0) return 0;
+  // interpolate between the centers of the two closest energy bins
+  float u = (e - map.eMin) / map.eWidth - 0.5f;
+  int bin1 = std::floor(u + 0.5f);
+  float frac = u - bin1;
+  int bin2 = frac > 0 ? bin1 + 1 : bin1 - 1;
+  bin1 = std::max(0, std::min(bin1, N - 1));
+  bin2 = std::max(0, std::min(bin2, N - 1));
+  // p/e is limited to the range the fits were defined on
+  float res1 = std::clamp(map.offset[bin1] + map.slope[bin1] * d, -20.f, 20.f);
+  float res2 = std::clamp(map.offset[bin2] + map.slope[bin2] * d, -20.f, 20.f);
+  float w = fabs(frac);
+  return e * (w * res2 + (1 - w) * res1);
 }
 
 void TrigElectronProducer::onProcessStart() {
   ldmx_log(debug) << "Process starts!";
 
   auto d = gDirectory;
-  TFile* f = new TFile(propMapName_.c_str(), "read");
-  propMapx_ = (TProfile2D*)f->Get("profx");
-  propMapx_->SetDirectory(0);
-  propMapy_ = (TProfile2D*)f->Get("profy");
-  propMapy_->SetDirectory(0);
-  f->Close();
+  TFile f(propMapName_.c_str(), "read");
+  if (!f.IsOpen()) {
+    EXCEPTION_RAISE("FileError",
+                    "Unable to open propagation map '" + propMapName_ + "'.");
+  }
+  auto propMapx = (TProfile2D*)f.Get("profx");
+  auto propMapy = (TProfile2D*)f.Get("profy");
+  if (!propMapx || !propMapy) {
+    EXCEPTION_RAISE("FileError", "Propagation map '" + propMapName_ +
+                                     "' is missing 'profx' or 'profy'.");
+  }
 
-  setupMaps(0);  // X
-  setupMaps(1);  // Y
+  setupMaps(propMapx, true);   // X
+  setupMaps(propMapy, false);  // Y
 
+  f.Close();
+  d->cd();
   return;
 }
 
 void TrigElectronProducer::onProcessEnd() {
   ldmx_log(debug) << "Process ends!";
 
-  // free maps
-  for (int i = 0; i < fitsX_.size(); i++) delete fitsX_[i];
-  for (int i = 0; i < fitsY_.size(); i++) delete fitsY_[i];
-
   return;
 }
 
@@ -1,6 +1,8 @@
 #include "Trigger/TrigHcalEnergySum.h"
 
-#include "DetDescr/HcalGeometry.h"
+#include <algorithm>
+#include <array>
+
 #include "Hcal/HcalTriggerGeometry.h"
 #include "Recon/Event/CaloTrigPrim.h"
 #include "Recon/Event/CalorimeterHit.h"
@@ -35,8 +37,6 @@ void TrigHcalEnergySum::produce(framework::Event& event) {
   const float samp_frac = (em_samp_frac + 2 * had_samp_frac) / 3;  // 0.109813
   const float attenuation = exp(-1 / 5.);  // 5m attenuation length, 1m half-bar
 
-  const ldmx::HcalGeometry& hcalGeom = getCondition<ldmx::HcalGeometry>(
-      ldmx::HcalGeometry::CONDITIONS_OBJECT_NAME);
   const hcal::HcalTriggerGeometry& trigGeom =
       getCondition<hcal::HcalTriggerGeometry>(
           hcal::HcalTriggerGeometry::CONDITIONS_OBJECT_NAME);
@@ -52,27 +52,44 @@ void TrigHcalEnergySum::produce(framework::Event& event) {
 
   // auto
   // oneEndedQuads{event.getObject<ldmx::CaloTrigPrimCollection>(quadCollName_)};
-  const std::vector<ldmx::CaloTrigPrim> oneEndedQuads =
+  const std::vector<ldmx::CaloTrigPrim>& oneEndedQuads =
       event.getCollection<ldmx::CaloTrigPrim>(quadCollName_, inProc_);
 
+  // one sum per quad of the trigger geometry, which is valid for all time
+  if (twoEndedQuadSums_.size() != std::size_t(trigGeom.getNumQuads())) {
+    twoEndedQuadSums_.resize(trigGeom.getNumQuads());
+    quadFilled_.assign(trigGeom.getNumQuads(), false);
+  }
+
   //
   // sum bar ends to produce the combined quads
-  std::map<int, ldmx::CaloTrigPrim> twoEndedQuadMap;
+  //  the first end seen of each quad is copied and the other added to it
+  filledQuads_.clear();
   for (const auto& oneEndedQuad : oneEndedQuads) {
-    const ldmx::HcalTriggerID end_id(oneEndedQuad.getId());
-    ldmx::HcalTriggerID combo_id(end_id.section(), end_id.layer(),
-                                 end_id.superstrip(), 2);
-    auto ptr = twoEndedQuadMap.find(combo_id.raw());
-    if (ptr == twoEndedQuadMap.end()) {
-      twoEndedQuadMap[combo_id.raw()] = oneEndedQuad;
+    int iquad = trigGeom.quadIndex(ldmx::HcalTriggerID(oneEndedQuad.getId()));
+    if (iquad < 0) {
+      EXCEPTION_RAISE("BadTrigPrim",
+                      "Trigger primitive " +
+                          std::to_string(oneEndedQuad.getId()) +
+                          " is not a quad of the HcalTriggerGeometry.");
+    }
+    if (not quadFilled_[iquad]) {
+      quadFilled_[iquad] = true;
+      twoEndedQuadSums_[iquad] = oneEndedQuad;
+      filledQuads_.push_back(iquad);
     } else {
-      ptr->second.setPrimitive(ptr->second.getPrimitive() +
-                               oneEndedQuad.getPrimitive());
+      auto& sum = twoEndedQuadSums_[iquad];
+      sum.setPrimitive(sum.getPrimitive() + oneEndedQuad.getPrimitive());
     }
   }
+  // the quad indices are in the order of the combined IDs
+  std::sort(filledQuads_.begin(), filledQuads_.end());
   ldmx::CaloTrigPrimCollection twoEndedQuads;
-  for (auto p : twoEndedQuadMap) twoEndedQuads.push_back(p.second);
-  event.add(combinedQuadCollName_, twoEndedQuads);
+  twoEndedQuads.reserve(filledQuads_.size());
+  for (int iquad : filledQuads_) {
+    twoEndedQuads.push_back(twoEndedQuadSums_[iquad]);
+    quadFilled_[iquad] = false;
+  }
 
   //
   // Produce the layer-by-layer energy sums
@@ -86,9 +103,10 @@ void TrigHcalEnergySum::produce(framework::Event& event) {
   for (int i = 0; i < SideLayerMax; i++) sideLayerSums[i].setLayer(i);
 
   int total_adc = 0;
-  std::map<int, int> section_sum;
-  for (auto p : twoEndedQuadMap) {
-    auto tp = p.second;
+  // sections are three bits of the ID
+  std::array<int, 8> section_sum{};
+  std::array<bool, 8> section_filled{};
+  for (const auto& tp : twoEndedQuads) {
     int adc = tp.getPrimitive();
     total_adc += adc;
     ldmx::HcalTriggerID combo_id(tp.getId());
@@ -105,19 +123,17 @@ void TrigHcalEnergySum::produce(framework::Event& event) {
     else
       sideLayerSums[ilayer].setHwEnergy(adc + sideLayerSums[ilayer].hwEnergy());
 
-    auto ptr = section_sum.find(isec);
-    if (ptr == section_sum.end()) {
-      section_sum[isec] = adc;
-    } else {
-      section_sum[isec] += adc;
-    }
+    section_sum[isec] += adc;
+    section_filled[isec] = true;
   }
+  event.add(combinedQuadCollName_, twoEndedQuads);
   event.add(combinedQuadCollName_ + "BackLayerSums", backLayerSums);
   event.add(combinedQuadCollName_ + "SideLayerSums", sideLayerSums);
 
   trigger::TrigEnergySumCollection sectionSums;
-  for (auto p : section_sum) {
-    sectionSums.emplace_back(-1, p.first, p.second);
+  for (int isec = 0; isec < section_sum.size(); isec++) {
+    if (section_filled[isec])
+      sectionSums.emplace_back(-1, isec, section_sum[isec]);
   }
   event.add(combinedQuadCollName_ + "SectionSums", sectionSums);
 
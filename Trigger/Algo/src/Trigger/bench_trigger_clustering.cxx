@@ -0,0 +1,122 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "DetDescr/EcalGeometry.h"
+#include "DetDescr/EcalTriggerID.h"
+#include "Ecal/EcalTriggerGeometry.h"
+#include "Framework/Configure/Parameters.h"
+#include "Trigger/DiscreteInputs_IO.h"
+#include "Trigger/IdealClusterBuilder.h"
+
+/**
+ * @app bench-trigger-clustering
+ *
+ * Times the trigger clustering on the ECal TPs of a file written by the
+ * DumpFileWriter, without the simulation and the rest of the processing.
+ *
+ * Usage: bench-trigger-clustering <dump file> [repeats]
+ */
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " <dump file> [repeats]" << std::endl;
+    return 1;
+  }
+  int repeats = argc > 2 ? atoi(argv[2]) : 1;
+
+  // read all of the events first so only the clustering is timed
+  std::vector<trigger::EventDump> events;
+  {
+    trigger::DiscreteInputs inputs(argv[1]);
+    while (inputs.nextEvent()) events.push_back(inputs.event());
+  }
+
+  // These are the v12 parameters
+  //  all distances in mm
+  std::vector<double> ecalSensLayersZ = {
+      7.850,   13.300,  26.400,  33.500,  47.950,  56.550,  72.250,
+      81.350,  97.050,  106.150, 121.850, 130.950, 146.650, 155.750,
+      171.450, 180.550, 196.250, 205.350, 221.050, 230.150, 245.850,
+      254.950, 270.650, 279.750, 298.950, 311.550, 330.750, 343.350,
+      362.550, 375.150, 394.350, 406.950, 426.150, 438.750};
+  framework::config::Parameters params;
+  params.addParameter("layerZPositions", ecalSensLayersZ);
+  params.addParameter("ecalFrontZ", 220.);
+  params.addParameter("moduleMinR", 85.0);
+  params.addParameter("nCellRHeight", 35.3);
+  params.addParameter("gap", 1.5);
+  params.addParameter("cornersSideUp", false);
+  params.addParameter("layer_shift_x", 0.);
+  params.addParameter("layer_shift_y", 0.);
+  params.addParameter("layer_shift_odd", false);
+  params.addParameter("layer_shift_odd_bilayer", false);
+  params.addParameter("verbose", 0);
+  ldmx::EcalGeometry* geometry_ptr = ldmx::EcalGeometry::debugMake(params);
+
+  // in-plane and layers identical, as the conditions provider builds it
+  ecal::EcalTriggerGeometry geom(0x0101, geometry_ptr);
+
+  auto start = std::chrono::steady_clock::now();
+  trigger::ClusterGeometry myGeo;
+  for (int imod = 0; imod < 7; imod++) {
+    for (int icell = 0; icell < 48; icell++) {
+      ldmx::EcalTriggerID id(0, imod, icell);
+      auto [xx, yy, zz] = geom.globalPosition(id);
+      myGeo.AddTP(id.raw(), icell, imod, xx, yy);
+    }
+  }
+  myGeo.Initialize();
+  std::chrono::duration<double, std::micro> geo_time =
+      std::chrono::steady_clock::now() - start;
+
+  // the hits of each event, as TrigEcalClusterProducer builds them
+  std::vector<std::vector<trigger::Hit> > event_hits;
+  std::size_t n_tps = 0;
+  for (const auto& event : events) {
+    std::vector<trigger::Hit> hits;
+    for (const auto& tp : event.EcalTPs) {
+      ldmx::EcalTriggerID tid(tp.tid);
+      double x, y, z;
+      std::tie(x, y, z) = geom.globalPosition(tid);
+      trigger::Hit hit;
+      hit.e = tp.tp;  // the dump holds the linearized energy
+      hit.x = x;
+      hit.y = y;
+      hit.z = z;
+      hit.layer = tid.layer();
+      hit.cell_id = tid.getTriggerCellID();
+      hit.module_id = tid.module();
+      hit.idx = hits.size();
+      hits.push_back(hit);
+    }
+    n_tps += hits.size();
+    event_hits.push_back(hits);
+  }
+
+  std::size_t n_clusters = 0;
+  start = std::chrono::steady_clock::now();
+  for (int r = 0; r < repeats; r++) {
+    for (const auto& hits : event_hits) {
+      trigger::IdealClusterBuilder builder;
+      builder.SetClusterGeo(&myGeo);
+      for (const auto& h : hits) builder.AddHit(h);
+      builder.BuildClusters();
+      n_clusters += builder.GetClusters().size();
+    }
+  }
+  std::chrono::duration<double, std::micro> build_time =
+      std::chrono::steady_clock::now() - start;
+
+  std::size_t n_built = event_hits.size() * repeats;
+  std::cout << "Geometry: " << geo_time.count() << " us" << std::endl;
+  std::cout << "Clustered " << n_built << " events with " << n_tps
+            << " TPs per pass into " << n_clusters << " clusters" << std::endl;
+  if (n_built > 0) {
+    std::cout << "Clustering: " << build_time.count() / n_built
+              << " us per event" << std::endl;
+  }
+
+  delete geometry_ptr;
+  return 0;
+}
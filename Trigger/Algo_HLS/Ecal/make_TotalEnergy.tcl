@@ -1,9 +1,9 @@
 # open the project, don't forget to reset
 open_project -reset proj0
 set_top TotalEnergy_hw
-add_files src/TotalEnergy.cpp
-add_files -tb tb/TotalEnergy_test.cpp 
-add_files -tb ref/TotalEnergy_ref.cpp
+add_files src/TotalEnergy.cpp -cflags "-std=c++11"
+add_files -tb tb/TotalEnergy_test.cpp -cflags "-std=c++11"
+add_files -tb ref/TotalEnergy_ref.cpp -cflags "-std=c++11"
 add_files -tb data/test.dump
 
 # reset the solution
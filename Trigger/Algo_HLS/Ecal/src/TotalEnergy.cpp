@@ -1,13 +1,14 @@
 /*
   HLS implementation of the missing energy calculation
+
+  The kernel is shared with the software emulation in
+  Trigger/Algo/include/Trigger/Emulation/EcalTotalEnergy.h
 */
 #include "TotalEnergy.h"
 
-void TotalEnergy_hw(EcalTP Input_TPs[N_INPUT_TP], e_t &energy){
+static_assert(N_INPUT_TP == trigger::emu::ecal::MAX_TPS,
+              "the emulation reads as many TPs as the firmware");
 
-  energy=0;
-  for(int i=0;i<N_INPUT_TP;i++){
-    //TODO add conversion to linear
-    energy += Input_TPs[i].tp;
-  }
+void TotalEnergy_hw(EcalTP Input_TPs[N_INPUT_TP], e_t &energy){
+  trigger::emu::ecal::totalEnergy<N_INPUT_TP>(Input_TPs, energy);
 }
@@ -4,13 +4,18 @@
 #include "ap_fixed.h"
 #include "ap_int.h"
 
+// the widths are shared with the software emulation
+#include "../../../Algo/include/Trigger/Emulation/EcalTotalEnergy.h"
+
 // HGCROC trigger ID and primitive
-typedef ap_uint<20> tid_t;
-typedef ap_uint<7> tp_t;
+typedef ap_uint<trigger::emu::ecal::TID_BITS> tid_t;
+typedef ap_uint<trigger::emu::ecal::TP_BITS> tp_t;
 
 typedef ap_uint<18> lin_t;
 
-typedef ap_ufixed<16, 14> e_t;   // [MeV] (Up to at least 8 GeV)
+// [MeV] (Up to at least 8 GeV)
+typedef ap_ufixed<trigger::emu::ecal::E_BITS, trigger::emu::ecal::E_INT_BITS>
+    e_t;
 typedef ap_fixed<10, 9> xy_t;    // [mm] (-250 to 250, resolution = a few mm)
 typedef ap_fixed<16, 14> pxy_t;  // [MeV/c]
 
@@ -1,26 +1,48 @@
 #include "../src/TotalEnergy.h"
 #include "../../../Algo/include/Trigger/DiscreteInputs_IO.h"
+#include "../../../Algo/include/Trigger/Emulation/EcalTotalEnergy.h"
 
 #define NTEST 5
 
+namespace emu = trigger::emu::ecal;
+
 int main(){
 
     trigger::DiscreteInputs inputs("test.dump");
   //DiscreteInputs inputs("../../../../data/test.dump");
-    
+
+  int n_mismatch = 0;
   for (int test = 0; test < NTEST; test++) {
-        
+
     EcalTP Input_TPs[N_INPUT_TP];
+    emu::EcalTP Input_TPs_emu[N_INPUT_TP];
     e_t energy_hw ;
     e_t energy_ref;
+    emu::e_t energy_emu;
 
-    //std::vector<EcalTP> inputs;
-    if (!inputs.nextEvent( /*inputs*/ )) break;
+    if (!inputs.nextEvent()) break;
+
+    // the first TPs of the event, the rest are zero
+    const std::vector<trigger::ldmx_int::EcalTP> &tps = inputs.event().EcalTPs;
+    for (int i = 0; i < N_INPUT_TP; i++) {
+      uint32_t tid = i < int(tps.size()) ? tps[i].tid : 0;
+      uint32_t tp = i < int(tps.size()) ? tps[i].tp : 0;
+      Input_TPs[i].tid = tid;
+      Input_TPs[i].tp = tp;
+      Input_TPs_emu[i].tid = tid;
+      Input_TPs_emu[i].tp = tp;
+    }
 
     TotalEnergy_ref(Input_TPs, energy_ref);
     TotalEnergy_hw(Input_TPs,  energy_hw);
-        
-    printf( "total energy = %f %f \n", float(energy_ref), float(energy_hw) );
+    emu::totalEnergy<N_INPUT_TP>(Input_TPs_emu, energy_emu);
+
+    // the emulation has to agree with the firmware bit for bit
+    bool match = energy_hw.to_double() == energy_emu.toDouble();
+    if (!match) n_mismatch++;
+    printf( "total energy = %f %f %f %s\n", float(energy_ref), float(energy_hw),
+            energy_emu.toDouble(), match ? "" : "MISMATCH" );
   }
 
+  return n_mismatch == 0 ? 0 : 1;
 }
@@ -130,7 +130,7 @@ setup(
     #
     # For an analysis of "install_requires" vs pip's requirements files see:
     # https://packaging.python.org/discussions/install-requires-vs-requirements/
-    install_requires=["uproot", "pandas", "matplotlib", "mplhep"],  # Optional
+    install_requires=["uproot", "awkward", "pandas", "matplotlib", "mplhep"],  # Optional
     # List additional groups of dependencies here (e.g. development
     # dependencies). Users will be able to install these using the "extras"
     # syntax, for example:
@@ -2,6 +2,7 @@
 
 # standard
 import argparse
+import concurrent.futures
 import os
 import re
 import logging
@@ -20,6 +21,7 @@ plt.style.use(mplhep.style.ROOT)
 from ._differ import Differ
 from ._file import File
 from ._plotter import plotter
+from . import _columnar
 
 # guard incase someone imports this somehow
 if __name__ == '__main__' :
@@ -52,6 +54,13 @@ if __name__ == '__main__' :
                         help="""Specify the name of the root files directly (either
                         full/relative path or name of files in the input data directory)""")
 
+    parser.add_argument('--workers', type=int, default=1,
+                        help="""Number of processes to read the branches of the event
+                        files with, a chunk at a time""")
+    parser.add_argument('--step-size', type=str, default='100 MB',
+                        help="""Amount of a branch read at a time, as memory (e.g. '100 MB')
+                        or as a number of entries""")
+
     arg = parser.parse_args()
 
     numeric_level = getattr(logging, arg.log.upper(), None)
@@ -85,6 +94,10 @@ if __name__ == '__main__' :
 
     logging.debug(f'Deduced Args: label = {label} out_dir = {out_dir}')
 
+    _columnar.Settings.step_size = int(arg.step_size) if arg.step_size.isdigit() else arg.step_size
+    if arg.workers > 1 :
+        _columnar.Settings.executor = concurrent.futures.ProcessPoolExecutor(arg.workers)
+
     if arg.input_files:
         input_files = [os.path.join(data, f)
                        if not f.startswith(data)
@@ -0,0 +1,156 @@
+"""Histogram branches of event files without loading them into memory
+
+Only the requested branch is read, a chunk of entries at a time, and the
+counts of each chunk are added up, so the memory needed does not depend on
+the number of events. The chunks can be spread over several processes
+(or any other concurrent.futures.Executor, e.g. the one of a Dask client).
+
+Examples
+--------
+Histogram the energy of the ECal sim hits of several files with 8 processes
+
+    from concurrent.futures import ProcessPoolExecutor
+    from Validation import _columnar
+
+    with ProcessPoolExecutor(8) as pool :
+        counts, edges = _columnar.histogram(
+            ['a.root','b.root'], 'EcalSimHits_valid/EcalSimHits_valid.edep_',
+            bins = 50, range = (0,50), executor = pool)
+"""
+
+import numpy as np
+import uproot
+import awkward as ak
+
+class Settings :
+    """Defaults used when histogramming branches through File.plot1d
+
+    Attributes
+    ----------
+    step_size : int or str
+        entries (int) or memory (str, e.g. '100 MB') read at a time
+    executor : concurrent.futures.Executor
+        executor to spread the chunks over, None to read them one after the other
+    """
+    step_size = '100 MB'
+    executor = None
+
+def _edges(bins, range) :
+    """Deduce the bin edges from the arguments as given to numpy.histogram"""
+    if np.ndim(bins) == 1 :
+        return np.asarray(bins, dtype=float)
+    if range is None :
+        raise ValueError('A range is needed to histogram a branch in chunks'
+                         ' unless the bin edges are given.')
+    return np.linspace(range[0], range[1], int(bins)+1)
+
+def _flat(array, transform) :
+    """Flatten the entries of a chunk into a numpy array of values"""
+    values = ak.to_numpy(ak.flatten(array, axis=None))
+    if transform is not None :
+        values = transform(values)
+    return values
+
+def _branch(f, tree, branch) :
+    """Get a branch from an open file, the tree can be part of its name"""
+    return f[branch] if tree is None else f[f'{tree}/{branch}']
+
+def _fill(path, tree, branch, edges, entry_start, entry_stop, transform) :
+    """Histogram one chunk of the entries of a file
+
+    This is a module-level function so it can be sent to other processes.
+    """
+    with uproot.open(path) as f :
+        array = _branch(f, tree, branch).array(entry_start = entry_start,
+                entry_stop = entry_stop, library = 'ak')
+    counts, _ = np.histogram(_flat(array, transform), bins = edges)
+    return counts
+
+_units = { 'B' : 1, 'KB' : 1024, 'MB' : 1024**2, 'GB' : 1024**3 }
+
+def _entries_per_step(branch, step_size) :
+    """Number of entries of a branch to read at a time
+
+    A step size given as memory (e.g. '100 MB') is converted using the
+    average uncompressed size of the entries of the branch.
+    """
+    if not isinstance(step_size, str) :
+        return max(int(step_size), 1)
+    number, unit = step_size.upper().replace(' ','').rstrip('B') or '0', 'B'
+    for u in ('K','M','G') :
+        if number.endswith(u) :
+            number, unit = number[:-1], u+'B'
+    memory = float(number)*_units[unit]
+    per_entry = branch.uncompressed_bytes / max(branch.num_entries, 1)
+    return max(int(memory / max(per_entry, 1)), 1)
+
+def _chunks(path, tree, branch, step_size) :
+    """Split the entries of a file into chunks of the step size"""
+    with uproot.open(path) as f :
+        b = _branch(f, tree, branch)
+        n = b.num_entries
+        step = _entries_per_step(b, step_size)
+    return [(start, min(start+step, n)) for start in range(0, n, step)]
+
+def histogram(files, branch, bins = 10, range = None, tree = 'LDMX_Events',
+        step_size = None, executor = None, transform = None) :
+    """Histogram a branch of one or more event files in chunks
+
+    Parameters
+    ----------
+    files : str or list of str
+        paths to the event files
+    branch : str
+        full name of the branch in the tree (e.g. 'EcalSimHits_valid/EcalSimHits_valid.edep_')
+    bins : int or list of float
+        number of bins in the range or the bin edges
+    range : tuple of float
+        lower and upper edge of the bins if only their number is given
+    tree : str
+        name of the tree in the files, None if it is part of the branch name
+    step_size : int or str
+        entries (int) or memory (str, e.g. '100 MB') read at a time,
+        defaults to Settings.step_size
+    executor : concurrent.futures.Executor
+        executor to spread the chunks over, defaults to Settings.executor
+        which reads them one after the other if it isn't set
+    transform : function
+        function of the numpy array of values of a chunk returning the values
+        to histogram (e.g. decoding the layer from a raw ID), it needs to be
+        defined at module level to be used with a process pool
+
+    Returns
+    -------
+    counts, edges : numpy arrays
+        entries in each bin and the bin edges, like numpy.histogram
+    """
+    if isinstance(files, str) :
+        files = [files]
+    if step_size is None :
+        step_size = Settings.step_size
+    if executor is None :
+        executor = Settings.executor
+
+    edges = _edges(bins, range)
+    counts = np.zeros(len(edges)-1, dtype=np.int64)
+
+    if executor is None :
+        for path in files :
+            with uproot.open(path) as f :
+                b = _branch(f, tree, branch)
+                step = _entries_per_step(b, step_size)
+                for start in range(0, b.num_entries, step) :
+                    array = b.array(entry_start = start,
+                            entry_stop = min(start+step, b.num_entries), library = 'ak')
+                    c, _ = np.histogram(_flat(array, transform), bins = edges)
+                    counts += c
+        return counts, edges
+
+    futures = [
+        executor.submit(_fill, path, tree, branch, edges, start, stop, transform)
+        for path in files
+        for start, stop in _chunks(path, tree, branch, step_size)
+    ]
+    for future in futures :
+        counts += future.result()
+    return counts, edges
@@ -1,9 +1,12 @@
 """Wrap an uproot file for some extra help plotting"""
 
 import uproot
+import numpy as np
 import os
 import logging
 
+from . import _columnar
+
 class File :
     """File entry in Differ object
 
@@ -215,6 +218,14 @@ class File :
             hist_kwargs['bins'] = edges
             hist_kwargs['weights'] = uproot_obj.values()
             return ax.hist((edges[1:]+edges[:-1])/2, **hist_kwargs)
+        elif np.ndim(hist_kwargs['bins']) == 1 or (
+                isinstance(hist_kwargs['bins'], int) and 'range' in hist_kwargs) :
+            counts, edges = _columnar.histogram(self.path, uproot_obj_path,
+                    bins = hist_kwargs['bins'], range = hist_kwargs.pop('range', None),
+                    tree = None)
+            hist_kwargs['bins'] = edges
+            hist_kwargs['weights'] = counts
+            return ax.hist((edges[1:]+edges[:-1])/2, **hist_kwargs)
         else :
             return ax.hist(uproot_obj.array(library='pd').values, **hist_kwargs)
 
@@ -0,0 +1,201 @@
+"""Performance regression checks from the data written by performance::Tracker
+
+A run with logPerformance (and logResourceUsage) enabled writes the time and
+resources used by each processor on each event into the 'performance' directory
+of its histogram file. Here we summarize that into a few numbers per processor
+and compare them to a baseline recorded earlier with tolerance bands, so that a
+slowdown between releases is caught when it is made.
+
+The summaries and baselines are JSON so they can be kept in the repository next
+to the samples and read by other tools.
+
+Examples
+--------
+Record the baseline of a sample
+
+    python3 -m Validation.regression record hist.root --sample ecal_pn --baseline perf_baseline.json
+
+Check a new run of the sample against it
+
+    python3 -m Validation.regression compare hist.root --sample ecal_pn --baseline perf_baseline.json
+"""
+
+import argparse
+import json
+import logging
+import sys
+
+import numpy as np
+import uproot
+
+log = logging.getLogger('regression')
+
+ALL = '__ALL__'
+"""Name the Tracker uses for the whole sequence"""
+
+def summarize(hist_file, directory = 'performance') :
+    """Summarize the performance data of a histogram file
+
+    Parameters
+    ----------
+    hist_file : str
+        path to the histogram file of a run with logPerformance enabled
+    directory : str
+        directory the Tracker wrote to
+
+    Returns
+    -------
+    dict
+        'events' processed, 'throughput' in events per second and for each of the
+        'processors' (including __ALL__ for the whole sequence) the 'mean_time' and
+        'median_time' per event in seconds. If the resource usage was logged as well,
+        each processor also has the 'mean_cpu_time' per event in seconds, the
+        'allocs_per_event' and the 'rss_growth' over the run in kB.
+    """
+    with uproot.open(hist_file) as f :
+        tree = f[f'{directory}/by_event']
+        names = sorted({ k.split('/')[0][:-1] for k in tree.keys(filter_name = '*.duration_') })
+        processors = {}
+        for name in names :
+            if name.endswith('_usage') :
+                continue
+            duration = tree[f'{name}./{name}.duration_'].array(library = 'np')
+            summary = {
+                'mean_time' : float(np.mean(duration)) if len(duration) > 0 else 0.,
+                'median_time' : float(np.median(duration)) if len(duration) > 0 else 0.,
+            }
+            usage = f'{name}_usage.'
+            if usage in tree :
+                cpu = tree[f'{usage}/{usage}cpu_time_'].array(library = 'np')
+                allocs = tree[f'{usage}/{usage}n_allocs_'].array(library = 'np')
+                rss = tree[f'{usage}/{usage}rss_delta_'].array(library = 'np')
+                summary['mean_cpu_time'] = float(np.mean(cpu)) if len(cpu) > 0 else 0.
+                summary['allocs_per_event'] = float(np.mean(allocs)) if len(allocs) > 0 else 0.
+                summary['rss_growth'] = float(np.sum(rss))
+            processors[name] = summary
+
+        events = tree.num_entries
+        total = float(np.sum(tree[f'{ALL}./{ALL}.duration_'].array(library = 'np')))
+
+    return {
+        'events' : events,
+        'throughput' : events / total if total > 0 else 0.,
+        'processors' : processors
+    }
+
+class Tolerance :
+    """Relative tolerances of the quantities compared to the baseline
+
+    Parameters
+    ----------
+    time : float
+        fraction the times per event may grow by
+    memory : float
+        fraction the memory growth and allocations may grow by
+    min_time : float
+        processors faster than this per event [s] in the baseline are not compared,
+        their times are dominated by noise
+    """
+
+    def __init__(self, time = 0.1, memory = 0.2, min_time = 1e-4) :
+        self.time = time
+        self.memory = memory
+        self.min_time = min_time
+
+def compare(summary, baseline, tolerance = Tolerance()) :
+    """Compare a summary to its baseline
+
+    Parameters
+    ----------
+    summary : dict
+        summary of the new run, from summarize
+    baseline : dict
+        summary of the baseline run
+    tolerance : Tolerance
+        how much worse than the baseline the new run may be
+
+    Returns
+    -------
+    list of str
+        description of each quantity outside of its tolerance band, empty if none
+    """
+    regressions = []
+    def check(what, new, old, tol) :
+        if old > 0 and new > old*(1.+tol) :
+            regressions.append(f'{what} went from {old:.4g} to {new:.4g} (+{100*(new/old-1):.1f}%)')
+
+    if summary['throughput'] < baseline['throughput']*(1.-tolerance.time) :
+        old, new = baseline['throughput'], summary['throughput']
+        regressions.append(f'throughput went from {old:.4g} to {new:.4g} events/s ({100*(new/old-1):.1f}%)')
+
+    for name, old in baseline['processors'].items() :
+        new = summary['processors'].get(name)
+        if new is None :
+            log.warning(f'{name} is in the baseline but not in the new run')
+            continue
+        if old['mean_time'] >= tolerance.min_time :
+            check(f'{name} mean time per event [s]', new['mean_time'], old['mean_time'], tolerance.time)
+            check(f'{name} median time per event [s]', new['median_time'], old['median_time'], tolerance.time)
+            if 'mean_cpu_time' in old and 'mean_cpu_time' in new :
+                check(f'{name} mean CPU time per event [s]', new['mean_cpu_time'], old['mean_cpu_time'], tolerance.time)
+        if 'allocs_per_event' in old and 'allocs_per_event' in new :
+            check(f'{name} allocations per event', new['allocs_per_event'], old['allocs_per_event'], tolerance.memory)
+            check(f'{name} memory growth [kB]', new['rss_growth'], old['rss_growth'], tolerance.memory)
+
+    return regressions
+
+def _load(baseline_file) :
+    """Load the baselines of all samples, empty if there are none yet"""
+    try :
+        with open(baseline_file) as f :
+            return json.load(f)
+    except FileNotFoundError :
+        return {}
+
+if __name__ == '__main__' :
+    parser = argparse.ArgumentParser('python3 -m Validation.regression',
+        description="""
+        Record or check the performance of a run against its baseline.
+        The baseline file holds the summaries of several samples by name.
+        """)
+    parser.add_argument('action', choices=['record','compare','summarize'],
+        help='record the run as the baseline, compare it to the baseline or only print its summary')
+    parser.add_argument('hist_file', help='histogram file of a run with logPerformance enabled')
+    parser.add_argument('--sample', required=True, help='name of the sample in the baseline file')
+    parser.add_argument('--baseline', default='perf_baseline.json', help='JSON file with the baselines')
+    parser.add_argument('--time-tolerance', type=float, default=0.1,
+        help='fraction the times per event may grow by')
+    parser.add_argument('--memory-tolerance', type=float, default=0.2,
+        help='fraction the allocations and memory growth may grow by')
+    parser.add_argument('--min-time', type=float, default=1e-4,
+        help='time per event [s] below which processors are not compared')
+    parser.add_argument('--log', help='logging level', choices=['info','debug','warn','error'], default='warn')
+    arg = parser.parse_args()
+
+    logging.basicConfig(level=getattr(logging, arg.log.upper()))
+
+    summary = summarize(arg.hist_file)
+    if arg.action == 'summarize' :
+        print(json.dumps(summary, indent=2))
+        sys.exit(0)
+
+    baselines = _load(arg.baseline)
+    if arg.action == 'record' :
+        baselines[arg.sample] = summary
+        with open(arg.baseline, 'w') as f :
+            json.dump(baselines, f, indent=2, sort_keys=True)
+        print(f'Recorded the baseline of {arg.sample} in {arg.baseline}')
+        sys.exit(0)
+
+    if arg.sample not in baselines :
+        print(f'No baseline for {arg.sample} in {arg.baseline}, record one first.')
+        sys.exit(2)
+
+    regressions = compare(summary, baselines[arg.sample],
+        Tolerance(arg.time_tolerance, arg.memory_tolerance, arg.min_time))
+    if len(regressions) > 0 :
+        print(f'Performance of {arg.sample} regressed compared to {arg.baseline}')
+        for r in regressions :
+            print(f'  {r}')
+        sys.exit(1)
+    print(f'Performance of {arg.sample} is within the tolerances of {arg.baseline}')
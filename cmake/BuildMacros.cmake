@@ -386,6 +386,60 @@ macro(build_test)
   endforeach()
 endmacro()
 
+macro(setup_benchmark)
+
+  set(multiValueArgs dependencies sources)
+  cmake_parse_arguments(setup_benchmark "${options}" "${oneValueArgs}"
+                        "${multiValueArgs}" ${ARGN})
+
+  # Find all the benchmarks
+  if(DEFINED setup_benchmark_sources)
+    set(src_files ${setup_benchmark_sources})
+  else()
+    file(GLOB src_files CONFIGURE_DEPENDS ${PROJECT_SOURCE_DIR}/bench/[a-zA-Z]*.cxx)
+  endif()
+
+  if (src_files)
+    # Add all benchmarks to the global list of benchmark sources
+    set(benchmark_sources
+        ${benchmark_sources} ${src_files}
+        CACHE INTERNAL "benchmark_sources")
+
+    # Add all of the dependencies to the global list of dependencies
+    set(benchmark_dep
+        ${benchmark_dep} ${setup_benchmark_dependencies}
+        CACHE INTERNAL "benchmark_dep")
+  endif()
+
+endmacro()
+
+macro(build_benchmark)
+
+  # Attempt to find google benchmark.  If it isn't found, it will be
+  # downloaded locally.
+  find_package(benchmark QUIET)
+
+  if (NOT benchmark_FOUND)
+    include(FetchContent)
+    set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+    FetchContent_Declare(
+        benchmark
+        GIT_REPOSITORY https://github.com/google/benchmark.git
+        GIT_TAG v1.8.3
+    )
+    FetchContent_MakeAvailable(benchmark)
+  endif()
+
+  # Add the executable to run all benchmarks.  benchmark_sources is a cached
+  # variable that contains the benchmarks from the different modules.  The
+  # benchmarks are not run as part of the tests, their timings are only
+  # meaningful on a quiet machine.
+  add_executable(run_benchmark ${benchmark_sources})
+  target_link_libraries(run_benchmark PRIVATE benchmark::benchmark_main ${benchmark_dep})
+
+endmacro()
+
 macro(clear_cache_variables)
   unset(registered_targets CACHE)
   unset(dict CACHE)
@@ -395,4 +449,6 @@ macro(clear_cache_variables)
   unset(test_modules CACHE)
   unset(namespaces CACHE)
   unset(test_configs CACHE)
+  unset(benchmark_sources CACHE)
+  unset(benchmark_dep CACHE)
 endmacro()